@@ -5,6 +5,8 @@
 # The simulator is expected to send to TCP port 4560+i for i in [0, N-1]
 # For example gazebo can be run like this:
 #./Tools/gazebo_sitl_multiple_run.sh -n 10 -m iris
+# Use -s for large swarms: each instance only starts the GCS and offboard links and
+# only instance 0 logs (see PX4_SIM_SWARM in ROMFS/px4fmu_common/init.d-posix/rcS).
 
 function cleanup() {
 	pkill -x px4
@@ -13,17 +15,18 @@ function cleanup() {
 
 if [ "$1" == "-h" ] || [ "$1" == "--help" ]
 then
-	echo "Usage: $0 [-n <num_vehicles>] [-m <vehicle_model>]"
+	echo "Usage: $0 [-n <num_vehicles>] [-m <vehicle_model>] [-w <world>] [-s]"
 	exit 1
 fi
 
-while getopts n:m:w: option
+while getopts n:m:w:s option
 do
 	case "${option}"
 	in
 		n) NUM_VEHICLES=${OPTARG};;
 		m) VEHICLE_MODEL=${OPTARG};;
 		w) WORLD=${OPTARG};;
+		s) export PX4_SIM_SWARM=1;;
 	esac
 done
 
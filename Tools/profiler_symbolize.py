@@ -0,0 +1,146 @@
+#! /usr/bin/env python3
+
+"""
+Symbolize the program counter samples of the profiler module.
+
+The samples are read from the profiler_samples topic of a ULog file and
+attributed to the functions of the firmware ELF file, which must be the one
+that produced the log. Prints a flat profile (functions sorted by the number
+of samples).
+
+Example:
+    Tools/profiler_symbolize.py -e build/px4_fmu-v5_default/px4_fmu-v5_default.elf log.ulg
+"""
+
+from __future__ import print_function
+
+import argparse
+import bisect
+import collections
+import subprocess
+import sys
+
+try:
+    from pyulog import ULog
+except ImportError as e:
+    print("Failed to import pyulog: " + str(e))
+    print("")
+    print("You may need to install it with:")
+    print("    pip3 install --user pyulog")
+    print("")
+    sys.exit(1)
+
+
+def read_samples(ulog_file, pid_filter):
+    """ returns the list of sampled program counters and the task name filter used on the target """
+    ulog = ULog(ulog_file, ['profiler_samples'])
+
+    if not ulog.data_list:
+        raise RuntimeError('no profiler_samples in ' + ulog_file)
+
+    data = ulog.data_list[0].data
+    num_samples = len([key for key in data if key.startswith('pc[')])
+
+    task = ''
+    for i in range(24):
+        c = data.get('task[{:d}]'.format(i), [b'\0'])[0]
+        task += c.decode('ascii', 'replace') if isinstance(c, bytes) else chr(c)
+    task = task.split('\0')[0]
+
+    pcs = []
+    dropped = 0
+
+    for msg in range(len(data['timestamp'])):
+        for i in range(min(data['count'][msg], num_samples)):
+            if pid_filter is None or data['pid[{:d}]'.format(i)][msg] == pid_filter:
+                pcs.append(int(data['pc[{:d}]'.format(i)][msg]))
+
+        dropped = int(data['dropped'][msg])
+
+    return pcs, task, dropped
+
+
+def read_symbols(nm, elf_file):
+    """ returns the sorted start addresses, sizes and names of the functions in the ELF file """
+    output = subprocess.check_output([nm, '--defined-only', '--demangle', '--print-size',
+                                      '--numeric-sort', elf_file]).decode('utf-8', 'replace')
+    addresses = []
+    symbols = []
+
+    for line in output.splitlines():
+        fields = line.split(None, 3)
+
+        if len(fields) < 4 or fields[2] not in 'tTwW':
+            continue
+
+        address = int(fields[0], 16) & ~1 # clear the thumb bit
+        addresses.append(address)
+        symbols.append((int(fields[1], 16), fields[3]))
+
+    return addresses, symbols
+
+
+def symbolize(pc, addresses, symbols):
+    index = bisect.bisect_right(addresses, pc) - 1
+
+    if index < 0:
+        return '0x{:08x}'.format(pc)
+
+    size, name = symbols[index]
+
+    if size > 0 and pc >= addresses[index] + size:
+        return '0x{:08x}'.format(pc)
+
+    return name
+
+
+def source_lines(addr2line, elf_file, pcs):
+    """ returns a dict pc -> file:line for the given program counters """
+    output = subprocess.check_output([addr2line, '-e', elf_file] +
+                                     ['0x{:x}'.format(pc) for pc in pcs]).decode('utf-8', 'replace')
+    return dict(zip(pcs, output.splitlines()))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Symbolize the profiler samples of a ULog file')
+    parser.add_argument('ulog', help='ULog file containing the profiler_samples topic')
+    parser.add_argument('-e', '--elf', required=True, help='firmware ELF file')
+    parser.add_argument('-n', '--num', type=int, default=30, help='number of functions to print (default=30)')
+    parser.add_argument('-p', '--pid', type=int, default=None, help='only use samples of this pid')
+    parser.add_argument('-l', '--lines', action='store_true', help='also print the hottest source lines')
+    parser.add_argument('--toolchain', default='arm-none-eabi-',
+                        help='toolchain prefix of nm and addr2line (default=arm-none-eabi-)')
+    args = parser.parse_args()
+
+    pcs, task, dropped = read_samples(args.ulog, args.pid)
+
+    if not pcs:
+        print('no samples')
+        return 1
+
+    addresses, symbols = read_symbols(args.toolchain + 'nm', args.elf)
+
+    functions = collections.Counter(symbolize(pc, addresses, symbols) for pc in pcs)
+
+    print('{:d} samples, task: {:s}, dropped: {:d}'.format(len(pcs), task if task else '(all)', dropped))
+    print('')
+    print('{:>8s} {:>7s}  {:s}'.format('samples', '%', 'function'))
+
+    for name, count in functions.most_common(args.num):
+        print('{:8d} {:6.2f}%  {:s}'.format(count, 100.0 * count / len(pcs), name))
+
+    if args.lines:
+        hottest = collections.Counter(pcs).most_common(args.num)
+        lines = source_lines(args.toolchain + 'addr2line', args.elf, [pc for pc, _ in hottest])
+        print('')
+        print('{:>8s} {:>7s}  {:10s}  {:s}'.format('samples', '%', 'pc', 'line'))
+
+        for pc, count in hottest:
+            print('{:8d} {:6.2f}%  0x{:08x}  {:s} ({:s})'.format(count, 100.0 * count / len(pcs), pc,
+                                                               lines.get(pc, '?'), symbolize(pc, addresses, symbols)))
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -95,6 +95,7 @@ px4_add_board(
 		esc_calib
 		hardfault_log
 		i2cdetect
+		irqstat
 		led_control
 		mixer
 		motor_ramp
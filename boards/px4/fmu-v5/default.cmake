@@ -71,6 +71,7 @@ px4_add_board(
 		events
 		fw_att_control
 		fw_pos_control_l1
+		gyro_fft
 		land_detector
 		landing_target_estimator
 		load_mon
@@ -83,6 +84,7 @@ px4_add_board(
 		mc_rate_control
 		#micrortps_bridge
 		navigator
+		profiler
 		rc_update
 		rover_pos_control
 		sensors
@@ -99,6 +101,8 @@ px4_add_board(
 		hardfault_log
 		i2cdetect
 		led_control
+		memtrack
+		microbench
 		mixer
 		motor_ramp
 		motor_test
@@ -113,6 +117,7 @@ px4_add_board(
 		tests # tests and test runner
 		top
 		topic_listener
+		trace
 		tune_control
 		usb_connected
 		ver
@@ -9,6 +9,7 @@ px4_add_board(
 	ROMFSROOT px4fmu_common
 	IO px4_io-v2_default
 	TESTING
+	MALLOC_TRACKER
 	#UAVCAN_INTERFACES 2
 	SERIAL_PORTS
 		GPS1:/dev/ttyS0
@@ -98,6 +99,7 @@ px4_add_board(
 		hardfault_log
 		i2cdetect
 		led_control
+		memtrack
 		mixer
 		motor_ramp
 		motor_test
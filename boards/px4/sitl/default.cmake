@@ -25,11 +25,13 @@ px4_add_board(
 		attitude_estimator_q
 		camera_feedback
 		commander
+		control_allocator
 		dataman
 		ekf2
 		events
 		fw_att_control
 		fw_pos_control_l1
+		gyro_fft
 		land_detector
 		landing_target_estimator
 		#load_mon
@@ -57,6 +59,7 @@ px4_add_board(
 		dyn
 		esc_calib
 		led_control
+		microbench
 		mixer
 		motor_ramp
 		motor_test
@@ -70,6 +73,7 @@ px4_add_board(
 		tests # tests and test runner
 		#top
 		topic_listener
+		trace
 		tune_control
 		ver
 		work_queue
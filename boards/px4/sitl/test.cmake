@@ -97,5 +97,14 @@ if(REPLAY_FILE)
 	add_definitions(-DORB_USE_PUBLISHER_RULES)
 endif()
 
+# uORB shared memory export (muorb/shm) and its test. It needs the uORB communicator, which changes
+# the uORB build, so it is only built on request (make tests_uorb_shm).
+option(UORB_SHM "Build the uORB shared memory export (enables ORB_COMMUNICATOR)" OFF)
+if(UORB_SHM)
+	message(STATUS "Building with the uORB communicator for muorb/shm")
+	add_definitions(-DORB_COMMUNICATOR)
+	list(APPEND config_module_list modules/muorb/shm)
+endif()
+
 message(STATUS "Building without lockstep for test")
 set(ENABLE_LOCKSTEP_SCHEDULER no)
@@ -57,6 +57,10 @@
 #			[ SERIAL_PORTS <list> ]
 #			[ CONSTRAINED_FLASH ]
 #			[ TESTING ]
+#			[ UORB_INSTRUMENTATION ]
+#			[ UORB_STATIC_ARENA ]
+#			[ UORB_NO_VFS ]
+#			[ MALLOC_TRACKER ]
 #			[ LINKER_PREFIX <string> ]
 #			)
 #
@@ -79,6 +83,10 @@
 #		SERIAL_PORTS		: mapping of user configurable serial ports and param facing name
 #		CONSTRAINED_FLASH	: flag to enable constrained flash options (eg limit init script status text)
 #		TESTING			: flag to enable automatic inclusion of PX4 testing modules
+#		UORB_INSTRUMENTATION	: flag to enable per-topic uORB latency and queue instrumentation (uorb top -l)
+#		UORB_STATIC_ARENA	: flag to place all uORB topic buffers in a single static arena instead of the heap
+#		UORB_NO_VFS		: flag to not register uORB topics as device files (no orb_subscribe()/px4_poll() users allowed)
+#		MALLOC_TRACKER		: flag to track heap allocations per task and while armed (memtrack, NuttX only)
 #		LINKER_PREFIX	: optional to prefix on the Linker script.
 #
 #
@@ -153,6 +161,10 @@ function(px4_add_board)
 			BUILD_BOOTLOADER
 			CONSTRAINED_FLASH
 			TESTING
+			UORB_INSTRUMENTATION
+			UORB_STATIC_ARENA
+			UORB_NO_VFS
+			MALLOC_TRACKER
 		REQUIRED
 			PLATFORM
 			VENDOR
@@ -232,6 +244,27 @@ function(px4_add_board)
 		set(PX4_TESTING "1" CACHE INTERNAL "testing enabled" FORCE)
 	endif()
 
+	if(UORB_INSTRUMENTATION)
+		add_definitions(-DORB_INSTRUMENTATION)
+	endif()
+
+	if(UORB_STATIC_ARENA)
+		add_definitions(-DORB_STATIC_ARENA)
+	endif()
+
+	if(UORB_NO_VFS)
+		add_definitions(-DORB_NO_VFS)
+	endif()
+
+	if(MALLOC_TRACKER)
+		if(NOT ${PLATFORM} MATCHES "nuttx")
+			message(FATAL_ERROR "MALLOC_TRACKER is only supported on NuttX")
+		endif()
+
+		set(PX4_MALLOC_TRACKER "1" CACHE INTERNAL "malloc tracker enabled" FORCE)
+		add_definitions(-DPX4_MALLOC_TRACKER)
+	endif()
+
 	if(LINKER_PREFIX)
 		set(PX4_BOARD_LINKER_PREFIX ${LINKER_PREFIX} CACHE STRING "PX4 board linker prefix" FORCE)
 	else()
@@ -95,8 +95,7 @@ for field in spec.parsed_fields():
 @{
 
 def print_parsed_fields():
-    # sort fields (using a stable sort)
-    sorted_fields = sorted(spec.parsed_fields(), key=sizeof_field_type, reverse=True)
+    sorted_fields = sort_fields(spec.parsed_fields())
     struct_size, padding_end_size = add_padding_bytes(sorted_fields, search_path)
     # loop over all fields and print the type and name
     for field in sorted_fields:
@@ -10,6 +10,8 @@
 @#  - msgs (List) list of all msg files
 @#  - multi_topics (List) list of all multi-topic names
 @#  - ids (List) list of all RTPS msg ids
+@#  - topic_structs (Dict) msg name of every topic
+@#  - topic_queue_lengths (Dict) ORB_QUEUE_LENGTH of every topic
 @###############################################
 /****************************************************************************
  *
@@ -76,3 +78,64 @@ const struct orb_metadata *get_orb_meta(ORB_ID id)
 
 	return uorb_topics_list[static_cast<uint8_t>(id)];
 }
+
+#ifdef ORB_STATIC_ARENA
+
+#include <px4_platform_common/atomic.h>
+
+static constexpr size_t orb_arena_align(size_t size) { return (size + 7u) & ~static_cast<size_t>(7u); }
+
+// matches uORB::DeviceNode::allocate_buffer(): slot tags followed by the data slots
+static constexpr size_t orb_arena_instance_size(size_t size, size_t queue_length)
+{
+	return (size > ORB_SEQLOCK_MIN_SIZE) ?
+	       orb_arena_align(sizeof(px4::atomic<unsigned>) * (queue_length + 1)) + orb_arena_align(size * (queue_length + 1)) :
+	       orb_arena_align(size * queue_length);
+}
+
+static constexpr uint32_t uorb_arena_instance_size[ORB_TOPICS_COUNT] = {
+@[for idx, msg_name in enumerate(msg_names_all, 1)]@
+	orb_arena_instance_size(sizeof(@(topic_structs[msg_name])_s), @(topic_queue_lengths[msg_name]))@[if idx != msgs_count_all], @[end if]
+@[end for]
+};
+
+static constexpr size_t orb_arena_offset(size_t index)
+{
+	size_t offset = 0;
+
+	for (size_t i = 0; i < index; i++) {
+		offset += uorb_arena_instance_size[i] * ORB_MULTI_MAX_INSTANCES;
+	}
+
+	return offset;
+}
+
+static constexpr uint32_t uorb_arena_offsets[ORB_TOPICS_COUNT] = {
+@[for idx, msg_name in enumerate(msg_names_all)]@
+	orb_arena_offset(@(idx))@[if idx != msgs_count_all - 1], @[end if]
+@[end for]
+};
+
+alignas(8) static uint8_t uorb_arena[orb_arena_offset(ORB_TOPICS_COUNT)];
+
+void *orb_static_arena(ORB_ID id, uint8_t instance, size_t size)
+{
+	if (id == ORB_ID::INVALID || instance >= ORB_MULTI_MAX_INSTANCES) {
+		return nullptr;
+	}
+
+	const uint8_t index = static_cast<uint8_t>(id);
+
+	if (size > uorb_arena_instance_size[index]) {
+		return nullptr;
+	}
+
+	return &uorb_arena[uorb_arena_offsets[index] + uorb_arena_instance_size[index] * instance];
+}
+
+size_t orb_static_arena_size()
+{
+	return sizeof(uorb_arena);
+}
+
+#endif /* ORB_STATIC_ARENA */
@@ -10,6 +10,8 @@
 @#  - msgs (List) list of all msg files
 @#  - multi_topics (List) list of all multi-topic names
 @#  - ids (List) list of all RTPS msg ids
+@#  - topic_structs (Dict) msg name of every topic
+@#  - topic_queue_lengths (Dict) ORB_QUEUE_LENGTH of every topic
 @###############################################
 /****************************************************************************
  *
@@ -74,3 +76,22 @@ enum class ORB_ID : uint8_t {
 };
 
 const struct orb_metadata *get_orb_meta(ORB_ID id);
+
+#ifdef ORB_STATIC_ARENA
+/**
+ * Get the storage reserved for a topic instance in the static arena.
+ * Every topic instance gets room for ORB_QUEUE_LENGTH messages (plus the
+ * seqlock spare slot and slot tags for large topics).
+ *
+ * @param id topic
+ * @param instance topic instance
+ * @param size number of bytes needed
+ * @return the storage, or nullptr if size doesn't fit (e.g. a larger queue was requested)
+ */
+void *orb_static_arena(ORB_ID id, uint8_t instance, size_t size);
+
+/**
+ * Total size of the static arena in bytes.
+ */
+size_t orb_static_arena_size();
+#endif /* ORB_STATIC_ARENA */
@@ -89,16 +89,30 @@ void* send(void* /*unused*/)
     int loop = 0, read = 0;
     uint32_t length = 0;
     size_t header_length = 0;
+    size_t batch_length = 0; // length of the framed messages in data_buffer that are waiting to be sent
 
     /* subscribe to topics */
 @[for idx, topic in enumerate(send_topics)]@
     uORB::Subscription @(topic)_sub{ORB_ID(@(topic))};
 @[end for]@
 
-    // ucdrBuffer to serialize using the user defined buffer
+    // ucdrBuffer to serialize directly into the transmit buffer, behind the messages already batched
     ucdrBuffer writer;
     header_length = transport_node->get_header_length();
-    ucdr_init_buffer(&writer, reinterpret_cast<uint8_t*>(&data_buffer[header_length]), BUFFER_SIZE - header_length);
+
+    auto init_writer = [&]() {
+        ucdr_init_buffer(&writer, reinterpret_cast<uint8_t*>(&data_buffer[batch_length + header_length]),
+                         BUFFER_SIZE - batch_length - header_length);
+    };
+
+    // send all the batched messages with a single write
+    auto send_batch = [&]() {
+        if (batch_length > 0 && 0 < (read = transport_node->write_framed(data_buffer, batch_length))) {
+            total_sent += read;
+        }
+
+        batch_length = 0;
+    };
 
     struct timespec begin;
     px4_clock_gettime(CLOCK_REALTIME, &begin);
@@ -120,11 +134,19 @@ void* send(void* /*unused*/)
 
                 last_msg_seq++;
 @[end if]@
-                // copy raw data into local buffer. Payload is shifted by header length to make room for header
-                serialize_@(send_base_types[idx])(&writer, &@(topic)_data, &data_buffer[header_length], &length);
-                if (0 < (read = transport_node->write(static_cast<char>(@(rtps_message_id(ids, topic))), data_buffer, length)))
-                {
-                    total_sent += read;
+                // serialize behind the batched messages. Payload is shifted by header length to make room for header
+                init_writer();
+                serialize_@(send_base_types[idx])(&writer, &@(topic)_data, &data_buffer[batch_length + header_length], &length);
+
+                if (writer.error && batch_length > 0) {
+                    // the batch is full, send it and serialize again at the beginning of the buffer
+                    send_batch();
+                    init_writer();
+                    serialize_@(send_base_types[idx])(&writer, &@(topic)_data, &data_buffer[header_length], &length);
+                }
+
+                if (!writer.error) {
+                    batch_length += transport_node->frame(static_cast<char>(@(rtps_message_id(ids, topic))), &data_buffer[batch_length], length);
                     ++sent;
                 }
 @[if topic == 'Timesync' or topic == 'timesync']@
@@ -132,6 +154,9 @@ void* send(void* /*unused*/)
 @[end if]@
         }
 @[end for]@
+        // one write (and UDP datagram) for all the topics updated in this loop
+        send_batch();
+
         px4_usleep(_options.sleep_ms * 1000);
         ++loop;
     }
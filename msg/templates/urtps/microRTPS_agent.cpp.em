@@ -206,6 +206,53 @@ void t_send(void*)
     }
 }
 @[end if]@
+@[if send_topics]@
+
+// Messages read from the transport by the receive thread, published by the main loop.
+// Single producer / single consumer ring, each side only writes its own index.
+#define RX_QUEUE_LENGTH 64 // must be a power of 2
+
+struct rx_message {
+    uint8_t topic_ID;
+    int length;
+    char data[BUFFER_SIZE];
+};
+
+rx_message rx_queue[RX_QUEUE_LENGTH];
+std::atomic<uint32_t> rx_queue_head(0); // next slot written by the receive thread
+std::atomic<uint32_t> rx_queue_tail(0); // next slot read by the main loop
+std::atomic<uint32_t> rx_queue_full(0); // number of times the receive thread had to wait for the main loop
+std::atomic<bool> exit_receiver_thread(false);
+
+void t_receive(void*)
+{
+    while (running && !exit_receiver_thread.load())
+    {
+        const uint32_t head = rx_queue_head.load(std::memory_order_relaxed);
+
+        if (head - rx_queue_tail.load(std::memory_order_acquire) >= RX_QUEUE_LENGTH)
+        {
+            // leave the data in the transport (OS) buffer until the main loop caught up
+            ++rx_queue_full;
+            usleep(_options.sleep_us);
+            continue;
+        }
+
+        rx_message &msg = rx_queue[head & (RX_QUEUE_LENGTH - 1)];
+        msg.length = transport_node->read(&msg.topic_ID, msg.data, BUFFER_SIZE);
+
+        if (0 < msg.length)
+        {
+            rx_queue_head.store(head + 1, std::memory_order_release);
+        }
+        else if (options::eTransports::UART == _options.transport && 0 == _options.poll_ms)
+        {
+            // UART reads do not block without poll timeout
+            usleep(_options.sleep_us);
+        }
+    }
+}
+@[end if]@
 
 int main(int argc, char** argv)
 {
@@ -251,11 +298,9 @@ int main(int argc, char** argv)
     sleep(1);
 
 @[if send_topics]@
-    char data_buffer[BUFFER_SIZE] = {};
     int received = 0, loop = 0;
-    int length = 0, total_read = 0;
+    int total_read = 0;
     bool receiving = false;
-    uint8_t topic_ID = 255;
     std::chrono::time_point<std::chrono::steady_clock> start, end;
 @[end if]@
 
@@ -269,20 +314,33 @@ int main(int argc, char** argv)
 @[if recv_topics]@
     std::thread sender_thread(t_send, nullptr);
 @[end if]@
+@[if send_topics]@
+    std::thread receiver_thread(t_receive, nullptr);
+@[end if]@
 
     while (running)
     {
 @[if send_topics]@
         ++loop;
         if (!receiving) start = std::chrono::steady_clock::now();
-        // Publish messages received from UART
-        while (0 < (length = transport_node->read(&topic_ID, data_buffer, BUFFER_SIZE)))
+        // Publish the messages queued by the receive thread
+        uint32_t tail = rx_queue_tail.load(std::memory_order_relaxed);
+        const uint32_t head = rx_queue_head.load(std::memory_order_acquire);
+
+        if (tail == head)
         {
-            topics.publish(topic_ID, data_buffer, sizeof(data_buffer));
+            usleep(_options.sleep_us);
+        }
+
+        for (; tail != head; ++tail)
+        {
+            rx_message &msg = rx_queue[tail & (RX_QUEUE_LENGTH - 1)];
+            topics.publish(msg.topic_ID, msg.data, sizeof(msg.data));
             ++received;
-            total_read += length;
+            total_read += msg.length;
             receiving = true;
             end = std::chrono::steady_clock::now();
+            rx_queue_tail.store(tail + 1, std::memory_order_release);
         }
 
         if ((receiving && std::chrono::duration<double>(std::chrono::steady_clock::now() - end).count() > WAIT_CNST) ||
@@ -291,8 +349,9 @@ int main(int argc, char** argv)
             std::chrono::duration<double>  elapsed_secs = end - start;
             printf("\nSENT:     %lu messages - %lu bytes\n",
                     (unsigned long)sent, (unsigned long)total_sent);
-            printf("RECEIVED: %d messages - %d bytes; %d LOOPS - %.03f seconds - %.02fKB/s\n\n",
+            printf("RECEIVED: %d messages - %d bytes; %d LOOPS - %.03f seconds - %.02fKB/s\n",
                     received, total_read, loop, elapsed_secs.count(), (double)total_read/(1000*elapsed_secs.count()));
+            printf("RX QUEUE: full %lu times\n\n", (unsigned long)rx_queue_full.exchange(0));
             received = sent = total_read = total_sent = 0;
             receiving = false;
         }
@@ -300,6 +359,10 @@ int main(int argc, char** argv)
         usleep(_options.sleep_us);
 @[end if]@
     }
+@[if send_topics]@
+    exit_receiver_thread = true;
+    receiver_thread.join();
+@[end if]@
 @[if recv_topics]@
     exit_sender_thread = true;
     t_send_queue_cv.notify_one();
@@ -44,6 +44,7 @@
 #include "microRTPS_transport.h"
 
 #define DEFAULT_UART "/dev/ttyACM0"
+#define UDP_RCVBUF_SIZE (1024 * 1024)
 
 /** CRC table for the CRC-16. The poly is 0x8005 (x^16 + x^15 + x^2 + 1) */
 uint16_t const crc16_table[256] = {
@@ -113,24 +114,29 @@ ssize_t Transport_node::read(uint8_t *topic_ID, char out_buffer[], size_t buffer
 
 	*topic_ID = 255;
 
-	ssize_t len = node_read((void *)(rx_buffer + rx_buff_pos), sizeof(rx_buffer) - rx_buff_pos);
+	ssize_t len = 0;
 
-	if (len <= 0) {
-		int errsv = errno;
+	// several messages can arrive in one batch, only read new data once they have been consumed
+	if (!message_buffered()) {
+		len = node_read((void *)(rx_buffer + rx_buff_pos), sizeof(rx_buffer) - rx_buff_pos);
 
-		if (errsv && EAGAIN != errsv && ETIMEDOUT != errsv) {
+		if (len <= 0) {
+			int errsv = errno;
+
+			if (errsv && EAGAIN != errsv && ETIMEDOUT != errsv) {
 #ifndef PX4_ERR
-			printf("Read fail %d\n", errsv);
+				printf("Read fail %d\n", errsv);
 #else
-			PX4_ERR("Read fail %d", errsv);
+				PX4_ERR("Read fail %d", errsv);
 #endif /* PX4_ERR */
+			}
+
+			return len;
 		}
 
-		return len;
+		rx_buff_pos += len;
 	}
 
-	rx_buff_pos += len;
-
 	// We read some
 	size_t header_size = sizeof(struct Header);
 
@@ -213,17 +219,26 @@ ssize_t Transport_node::read(uint8_t *topic_ID, char out_buffer[], size_t buffer
 	return len;
 }
 
+bool Transport_node::message_buffered() const
+{
+	// read() drops everything in front of a start marker, so a buffered message starts at the beginning
+	if (rx_buff_pos < sizeof(struct Header) || memcmp(rx_buffer, ">>>", 3) != 0) {
+		return false;
+	}
+
+	const struct Header *header = (const struct Header *)rx_buffer;
+	uint32_t payload_len = ((uint32_t)header->payload_len_h << 8) | header->payload_len_l;
+
+	return rx_buff_pos >= sizeof(struct Header) + payload_len;
+}
+
 size_t Transport_node::get_header_length()
 {
     return sizeof(struct Header);
 }
 
-ssize_t Transport_node::write(const uint8_t topic_ID, char buffer[], size_t length)
+size_t Transport_node::frame(const uint8_t topic_ID, char buffer[], size_t length)
 {
-	if (!fds_OK()) {
-		return -1;
-	}
-
 	static struct Header header = {{'>', '>', '>'}, 0u, 0u, 0u, 0u, 0u, 0u};
 	static uint8_t seq = 0;
 
@@ -240,11 +255,31 @@ ssize_t Transport_node::write(const uint8_t topic_ID, char buffer[], size_t leng
 	/* Headroom for header is created in client */
 	/* Fill in the header in the same payload buffer to call a single node_write */
 	memcpy(buffer, &header, sizeof(header));
-	ssize_t len = node_write(buffer, length + sizeof(header));
-	if (len != ssize_t(length + sizeof(header))) {
+
+	return length + sizeof(header);
+}
+
+ssize_t Transport_node::write_framed(char buffer[], size_t length)
+{
+	if (!fds_OK()) {
+		return -1;
+	}
+
+	return node_write(buffer, length);
+}
+
+ssize_t Transport_node::write(const uint8_t topic_ID, char buffer[], size_t length)
+{
+	if (!fds_OK()) {
+		return -1;
+	}
+
+	const size_t framed_length = frame(topic_ID, buffer, length);
+	ssize_t len = node_write(buffer, framed_length);
+	if (len != ssize_t(framed_length)) {
 		return len;
 	}
-	return len + sizeof(header);
+	return len + get_header_length();
 }
 
 UART_node::UART_node(const char *_uart_name, uint32_t _baudrate, uint32_t _poll_ms):
@@ -561,6 +596,13 @@ int UDP_node::init_receiver(uint16_t udp_port)
 #endif /* PX4_ERR */
 		return -1;
 	}
+
+#ifndef __PX4_NUTTX
+	// absorb bursts of high rate topics while the reader is busy publishing
+	int rcvbuf_size = UDP_RCVBUF_SIZE;
+	setsockopt(receiver_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof(rcvbuf_size));
+#endif /* __PX4_NUTTX */
+
 #ifndef PX4_INFO
 	printf("- Trying to connect...");
 #else
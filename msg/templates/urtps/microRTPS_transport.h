@@ -62,6 +62,23 @@ public:
 	 */
 	ssize_t write(const uint8_t topic_ID, char buffer[], size_t length);
 
+	/**
+	 * frame a message in place without sending it, to send several messages with a single write_framed()
+	 * @param topic_ID
+	 * @param buffer buffer with the same layout as for write(): get_header_length() bytes free at the beginning
+	 * @param length buffer length excluding header length
+	 * @return length of the framed message (header and payload)
+	 */
+	size_t frame(const uint8_t topic_ID, char buffer[], size_t length);
+
+	/**
+	 * write one or several consecutive messages framed by frame() with a single write
+	 * @param buffer framed messages
+	 * @param length total length of the framed messages
+	 * @return length on success, <0 on error
+	 */
+	ssize_t write_framed(char buffer[], size_t length);
+
 	/** Get the Length of struct Header to make headroom for the size of struct Header along with payload */
 	size_t get_header_length();
 
@@ -72,6 +89,9 @@ protected:
 	uint16_t crc16_byte(uint16_t crc, const uint8_t data);
 	uint16_t crc16(uint8_t const *buffer, size_t len);
 
+	/** true if a complete message (e.g. the rest of a batch) is waiting in rx_buffer */
+	bool message_buffered() const;
+
 protected:
 	uint32_t rx_buff_pos;
 	char rx_buffer[1024] = {};
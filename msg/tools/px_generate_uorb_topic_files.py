@@ -39,6 +39,7 @@ message files
 """
 
 import os
+import re
 import shutil
 import filecmp
 import argparse
@@ -114,6 +115,33 @@ def get_multi_topics(filename):
     return result
 
 
+def get_queue_length(filename):
+    """
+    Get the ORB_QUEUE_LENGTH constant of a msg file (1 if not set)
+    """
+    with open(filename, 'r') as ofile:
+        for each_line in ofile.read().split('\n'):
+            match = re.match(r'^\s*uint8\s+ORB_QUEUE_LENGTH\s*=\s*(\d+)', each_line)
+            if match:
+                return int(match.group(1))
+    return 1
+
+
+def get_topics_storage(msg_filenames):
+    """
+    Map every topic name to its msg name and queue length (used for the static arena)
+    """
+    topic_structs = {}
+    topic_queue_lengths = {}
+    for msg_filename in msg_filenames:
+        msg_name = os.path.basename(msg_filename).replace(".msg", "")
+        queue_length = get_queue_length(msg_filename)
+        for topic_name in [msg_name] + get_multi_topics(msg_filename):
+            topic_structs[topic_name] = msg_name
+            topic_queue_lengths[topic_name] = queue_length
+    return topic_structs, topic_queue_lengths
+
+
 def get_msgs_list(msgdir):
     """
     Makes list of msg files in the given directory
@@ -456,7 +484,10 @@ def generate_topics_list_file(msgdir, outputdir, template_filename, templatedir)
     for msg in msgs:
         msg_filename = os.path.join(msgdir, msg)
         multi_topics.extend(get_multi_topics(msg_filename))
-    tl_globals = {"msgs": msgs, "multi_topics": multi_topics}
+    topic_structs, topic_queue_lengths = get_topics_storage(
+        [os.path.join(msgdir, msg) for msg in msgs])
+    tl_globals = {"msgs": msgs, "multi_topics": multi_topics,
+                  "topic_structs": topic_structs, "topic_queue_lengths": topic_queue_lengths}
     tl_template_file = os.path.join(templatedir, template_filename)
     tl_out_file = os.path.join(outputdir, template_filename.replace(".em", ""))
     generate_by_template(tl_out_file, tl_template_file, tl_globals)
@@ -469,7 +500,10 @@ def generate_topics_list_file_from_files(files, outputdir, template_filename, te
     multi_topics = []
     for msg_filename in files:
         multi_topics.extend(get_multi_topics(msg_filename))
-    tl_globals = {"msgs": filenames, "multi_topics": multi_topics}
+    topic_structs, topic_queue_lengths = get_topics_storage(
+        [p for p in files if os.path.basename(p).endswith(".msg")])
+    tl_globals = {"msgs": filenames, "multi_topics": multi_topics,
+                  "topic_structs": topic_structs, "topic_queue_lengths": topic_queue_lengths}
     tl_template_file = os.path.join(templatedir, template_filename)
     tl_out_file = os.path.join(outputdir, template_filename.replace(".em", ""))
     generate_by_template(tl_out_file, tl_template_file, tl_globals)
@@ -142,7 +142,26 @@ def sizeof_field_type(field):
     bare_name_str = bare_name(field.type)
     if bare_name_str in msgtype_size_map:
         return msgtype_size_map[bare_name_str]
-    return 0  # this is for non-builtin types: sort them at the end
+    return 0  # this is for non-builtin types (see field_alignment_sort_key)
+
+
+def field_alignment_sort_key(field):
+    """
+    Get the key to sort the fields of a struct by alignment (descending).
+    Embedded types go first: they are padded to a multiple of 8 bytes, so
+    placing them at the beginning avoids padding in front of them
+    """
+    if not field.is_builtin:
+        return 16
+    return sizeof_field_type(field)
+
+
+def sort_fields(fields):
+    """
+    Sort fields (using a stable sort) such that the struct needs padding only
+    at the end
+    """
+    return sorted(fields, key=field_alignment_sort_key, reverse=True)
 
 
 def get_children_fields(base_type, search_path):
@@ -150,9 +169,7 @@ def get_children_fields(base_type, search_path):
     tmp_msg_context = genmsg.msg_loader.MsgContext.create_default()
     spec_temp = genmsg.msg_loader.load_msg_by_type(
         tmp_msg_context, '%s/%s' % (package, name), search_path)
-    sorted_fields = sorted(spec_temp.parsed_fields(),
-                           key=sizeof_field_type, reverse=True)
-    return sorted_fields
+    return sort_fields(spec_temp.parsed_fields())
 
 
 def add_padding_bytes(fields, search_path):
@@ -43,7 +43,9 @@
 #include <px4_platform_common/px4_work_queue/WorkItemSingleShot.hpp>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/getopt.h>
+#include <px4_platform_common/px4_config.h>
 
+#include <math.h>
 #include <pthread.h>
 
 static List<I2CSPIInstance *> i2c_spi_module_instances; ///< list of currently running instances
@@ -611,6 +613,126 @@ void I2CSPIDriverBase::print_status()
 {
 	bool is_i2c_bus = _bus_option == I2CSPIBusOption::I2CExternal || _bus_option == I2CSPIBusOption::I2CInternal;
 	PX4_INFO("Running on %s Bus %i", is_i2c_bus ? "I2C" : "SPI", _bus);
+
+	if (_data_ready_gpio != 0) {
+		// copy to avoid inconsistent values while the interrupt keeps updating them
+		const uint32_t interval_count = _drdy_interval_count;
+		const uint64_t interval_sum = _drdy_interval_sum;
+		const uint64_t interval_sum_sq = _drdy_interval_sum_sq;
+
+		if (interval_count > 0) {
+			const double mean = (double)interval_sum / interval_count;
+			const double variance = (double)interval_sum_sq / interval_count - mean * mean;
+
+			PX4_INFO("DRDY: %u interrupts, interval avg: %.1f us, jitter (std dev): %.1f us, min: %u us, max: %u us",
+				 _drdy_count, mean, variance > 0. ? sqrt(variance) : 0., _drdy_interval_min, _drdy_interval_max);
+
+		} else {
+			PX4_INFO("DRDY: %u interrupts", _drdy_count);
+		}
+
+		if (_drdy_latency_count > 0) {
+			PX4_INFO("DRDY to run latency avg: %.1f us, max: %u us, runs without DRDY: %u",
+				 (double)_drdy_latency_sum / _drdy_latency_count, _drdy_latency_max, _drdy_fallback_runs);
+		}
+
+	} else if (_drdy_requested) {
+		PX4_INFO("DRDY interrupt not available, polling");
+	}
+}
+
+bool I2CSPIDriverBase::DataReadyInterruptConfigure(spi_drdy_gpio_t drdy_gpio, bool rising_edge, bool falling_edge)
+{
+	_drdy_requested = true;
+
+	if (drdy_gpio == 0) {
+		return false;
+	}
+
+	// disable a previous configuration before changing it
+	DataReadyInterruptDisable();
+
+	_drdy_timestamp = 0;
+	_drdy_scheduled.store(false);
+
+	if (px4_arch_gpiosetevent(drdy_gpio, rising_edge, falling_edge, true, &DataReadyInterruptCallback, this) == 0) {
+		_data_ready_gpio = drdy_gpio;
+		return true;
+	}
+
+	return false;
+}
+
+bool I2CSPIDriverBase::DataReadyInterruptDisable()
+{
+	if (_data_ready_gpio == 0) {
+		return false;
+	}
+
+	const bool ret = px4_arch_gpiosetevent(_data_ready_gpio, false, false, false, nullptr, nullptr) == 0;
+	_data_ready_gpio = 0;
+
+	return ret;
+}
+
+int I2CSPIDriverBase::DataReadyInterruptCallback(int irq, void *context, void *arg)
+{
+	static_cast<I2CSPIDriverBase *>(arg)->DataReadyInterrupt();
+	return 0;
+}
+
+void I2CSPIDriverBase::DataReadyInterrupt()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (_drdy_timestamp != 0) {
+		const uint32_t interval = math::min(now - _drdy_timestamp, (hrt_abstime)UINT32_MAX);
+
+		_drdy_interval_count++;
+		_drdy_interval_sum += interval;
+		_drdy_interval_sum_sq += (uint64_t)interval * interval;
+
+		if (interval < _drdy_interval_min) {
+			_drdy_interval_min = interval;
+		}
+
+		if (interval > _drdy_interval_max) {
+			_drdy_interval_max = interval;
+		}
+	}
+
+	_drdy_timestamp = now;
+	_drdy_count++;
+
+	if (DataReady(now)) {
+		_drdy_schedule_timestamp = now;
+		_drdy_scheduled.store(true);
+		ScheduleNow();
+	}
+}
+
+void I2CSPIDriverBase::DataReadyRunUpdate()
+{
+	if (_data_ready_gpio == 0) {
+		return;
+	}
+
+	bool scheduled = true;
+
+	if (_drdy_scheduled.compare_exchange(&scheduled, false)) {
+		const uint32_t latency = math::min(hrt_elapsed_time(&_drdy_schedule_timestamp), (hrt_abstime)UINT32_MAX);
+
+		_drdy_latency_count++;
+		_drdy_latency_sum += latency;
+
+		if (latency > _drdy_latency_max) {
+			_drdy_latency_max = latency;
+		}
+
+	} else {
+		// watchdog timeout or any other schedule not triggered by DRDY
+		_drdy_fallback_runs++;
+	}
 }
 
 void I2CSPIDriverBase::request_stop_and_wait()
@@ -168,7 +168,7 @@ public:
 	 */
 	inline bool compare_exchange(T *expected, T num)
 	{
-		return __atomic_compare_exchange(&_value, expected, num, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+		return __atomic_compare_exchange(&_value, expected, &num, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
 	}
 
 private:
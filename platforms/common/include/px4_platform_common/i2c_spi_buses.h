@@ -188,6 +188,13 @@ public:
 
 	using instantiate_method = I2CSPIDriverBase * (*)(const BusCLIArguments &cli, const BusInstanceIterator &iterator,
 				   int runtime_instance);
+
+	/**
+	 * Priority within the bus work queue (see WorkItem::SetQueuePriority()) for time-critical sensors.
+	 * All drivers on a bus share the same thread, so a sensor using it runs before slow devices
+	 * (rangefinders, smart batteries, ...) that are due at the same time.
+	 */
+	static constexpr uint8_t BUS_PRIORITY_SENSOR{100};
 protected:
 	virtual ~I2CSPIDriverBase() = default;
 
@@ -207,13 +214,67 @@ protected:
 	static int module_start(const BusCLIArguments &cli, BusInstanceIterator &iterator, void(*print_usage)(),
 				instantiate_method instantiate);
 
+	/**
+	 * Enable the data ready (DRDY) GPIO interrupt. On every interrupt DataReady() is called and
+	 * the work item is scheduled if it returns true.
+	 * @param drdy_gpio DRDY GPIO, 0 if the board has none
+	 * @param rising_edge trigger on the rising edge
+	 * @param falling_edge trigger on the falling edge
+	 * @return true on success, otherwise the driver is expected to fall back to polling
+	 */
+	bool DataReadyInterruptConfigure(spi_drdy_gpio_t drdy_gpio, bool rising_edge, bool falling_edge);
+
+	/**
+	 * Disable the DRDY interrupt, if enabled. A driver using it needs to call this from exit_and_cleanup().
+	 */
+	bool DataReadyInterruptDisable();
+
+	bool DataReadyInterruptEnabled() const { return _data_ready_gpio != 0; }
+
+	/**
+	 * Called on every DRDY interrupt (from interrupt context, keep it short).
+	 * @param timestamp_sample time of the interrupt
+	 * @return true to schedule the work item
+	 */
+	virtual bool DataReady(const hrt_abstime &timestamp_sample) { return true; }
+
+	/**
+	 * Update the DRDY scheduling statistics, called at the beginning of every run.
+	 */
+	void DataReadyRunUpdate();
+
 private:
 	static void custom_method_trampoline(void *argument);
 
+	static int DataReadyInterruptCallback(int irq, void *context, void *arg);
+	void DataReadyInterrupt();
+
 	void request_stop_and_wait();
 
 	px4::atomic_bool _task_should_exit{false};
 	px4::atomic_bool _task_exited{false};
+
+	// DRDY interrupt scheduling
+	spi_drdy_gpio_t _data_ready_gpio{0};
+	bool _drdy_requested{false};		///< the driver tried to enable the DRDY interrupt
+	px4::atomic_bool _drdy_scheduled{false};
+
+	hrt_abstime _drdy_timestamp{0};		///< last interrupt
+	hrt_abstime _drdy_schedule_timestamp{0};	///< last interrupt that scheduled a run
+
+	// interrupt interval, updated in interrupt context
+	uint32_t _drdy_count{0};
+	uint32_t _drdy_interval_count{0};
+	uint64_t _drdy_interval_sum{0};
+	uint64_t _drdy_interval_sum_sq{0};
+	uint32_t _drdy_interval_min{UINT32_MAX};
+	uint32_t _drdy_interval_max{0};
+
+	// interrupt to run latency and runs not triggered by DRDY (watchdog or polling)
+	uint32_t _drdy_latency_count{0};
+	uint64_t _drdy_latency_sum{0};
+	uint32_t _drdy_latency_max{0};
+	uint32_t _drdy_fallback_runs{0};
 };
 
 /**
@@ -239,6 +300,8 @@ protected:
 	// *INDENT-OFF* remove once there's astyle >3.1 in CI
 	void Run() final
 	{
+		DataReadyRunUpdate();
+
 		static_cast<T *>(this)->RunImpl();
 
 		if (should_exit()) {
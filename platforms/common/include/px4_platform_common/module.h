@@ -49,6 +49,7 @@
 
 #ifdef __cplusplus
 
+#include <cstdlib>
 #include <cstring>
 
 /**
@@ -110,6 +111,10 @@ extern pthread_mutex_t px4_modules_mutex;
  *              // set _task_id to task_id_is_work_queue and return 0
  *              // on error return != 0 (and _task_id must be -1)
  *      }
+ *
+ * Startup: 'start' does not need to wait for the module to be initialized. Modules started from
+ * the same script can then initialize concurrently, and a later step depending on a module uses
+ * 'command wait [timeout_ms]', which returns once the module is ready (_object is set).
  */
 template<class T>
 class ModuleBase
@@ -148,6 +153,10 @@ public:
 			return stop_command();
 		}
 
+		if (strcmp(argv[1], "wait") == 0) {
+			return wait_command(argc - 1, argv + 1);
+		}
+
 		lock_module(); // Lock here, as the method could access _object.
 		int ret = T::custom_command(argc - 1, argv + 1);
 		unlock_module();
@@ -291,6 +300,39 @@ public:
 		return ret;
 	}
 
+	/**
+	 * @brief Handle 'command wait [timeout_ms]': wait until the module is initialized (default timeout 1s).
+	 *        The module lock is not held while waiting, so that the module can finish its startup.
+	 * @return Returns 0 once the module is ready, -1 if it is not running or on timeout.
+	 */
+	static int wait_command(int argc, char *argv[])
+	{
+		const int timeout_us = ((argc > 1) ? strtol(argv[1], nullptr, 10) : 1000) * 1000;
+
+		for (int t = 0; ; t += 2500) {
+			lock_module();
+			const bool running = is_running();
+			const bool ready = (_object.load() != nullptr);
+			unlock_module();
+
+			if (ready) {
+				return 0;
+			}
+
+			if (!running) {
+				PX4_ERR("not running");
+				return -1;
+			}
+
+			if (t >= timeout_us) {
+				PX4_ERR("Timed out while waiting for the module to be ready");
+				return -1;
+			}
+
+			px4_usleep(2500);
+		}
+	}
+
 	/**
 	 * @brief Print the status if the module is running. This can be overridden by the module to provide
 	 * more specific information.
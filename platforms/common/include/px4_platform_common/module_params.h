@@ -82,7 +82,9 @@ protected:
 			child->updateParams();
 		}
 
+		const uint32_t instance = param_update_instance();
 		updateParamsImpl();
+		_params_update_instance = instance;
 	}
 
 	/**
@@ -90,6 +92,9 @@ protected:
 	 */
 	virtual void updateParamsImpl() {}
 
+	/** parameter_update instance of the last update, only parameters changed since then are read again */
+	uint32_t _params_update_instance{0};
+
 private:
 	/** @list _children The module parameter list of inheriting classes. */
 	List<ModuleParams *> _children;
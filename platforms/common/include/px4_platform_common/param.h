@@ -57,8 +57,9 @@ inline static param_t param_handle(px4::params p)
 #define _DEFINE_SINGLE_PARAMETER(x) \
 	do_not_explicitly_use_this_namespace::PAIR(x);
 
+// only read the parameters that might have changed since the last update
 #define _CALL_UPDATE(x) \
-	STRIP(x).update();
+	if (param_changed_since(STRIP(x).handle(), _params_update_instance)) { STRIP(x).update(); }
 
 // define the parameter update method, which will update all parameters.
 // It is marked as 'final', so that wrong usages lead to a compile error (see below)
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "WorkItem.hpp"
+
+#include <poll.h>
+
+namespace px4
+{
+
+/**
+ * @class PollWorkItem
+ * WorkItem that is scheduled when a file descriptor becomes ready, so modules that
+ * block in poll() (serial ports, sockets, pipes) can run on a shared work queue
+ * instead of a dedicated task.
+ *
+ * All registered file descriptors are polled by a single shared thread. After an
+ * event the file descriptor isn't polled again until PollRun() returned, so the
+ * item is scheduled once per event and has to consume the data (non-blocking).
+ *
+ * NOTE: on POSIX the file descriptor has to be a system file descriptor, not a
+ * px4_open() one (e.g. uORB).
+ */
+class PollWorkItem : public WorkItem
+{
+public:
+
+	/**
+	 * Start polling a file descriptor, replacing any previous one.
+	 *
+	 * @param fd		The file descriptor.
+	 * @param events	The poll events to wait for.
+	 * @return true on success
+	 */
+	bool PollFd(int fd, short events = POLLIN);
+
+	/**
+	 * Stop polling and clear any scheduled work.
+	 */
+	void PollClear();
+
+	static constexpr int MAX_POLL_ITEMS = 16;
+
+protected:
+
+	PollWorkItem(const char *name, const wq_config_t &config) : WorkItem(name, config) {}
+	virtual ~PollWorkItem() override;
+
+	/**
+	 * Called on the work queue for every poll event.
+	 *
+	 * @param revents	The returned poll events (0 if scheduled by other means, e.g. ScheduleNow()).
+	 */
+	virtual void PollRun(short revents) = 0;
+
+private:
+
+	friend class PollWorkItemPoller;
+
+	void Run() final;
+
+	int	_fd{-1};
+	short	_events{0};
+	short	_revents{0};	// set by the poller before scheduling
+	bool	_armed{false};	// polled by the poller (protected by the poller lock)
+	bool	*_deleted{nullptr};	// set while in PollRun() to detect deletion
+};
+
+} // namespace px4
@@ -59,6 +59,17 @@ public:
 	 */
 	void ScheduleOnInterval(uint32_t interval_us, uint32_t delay_us = 0);
 
+	/**
+	 * Schedule repeating run aligned to the hrt time base: runs happen at
+	 * t % interval_us == phase_us. Items on the same queue with harmonic
+	 * intervals (e.g. 1000 us and 4000 us) and different phases are staggered
+	 * deterministically instead of colliding at an arbitrary phase.
+	 *
+	 * @param interval_us		The interval in microseconds.
+	 * @param phase_us		The phase offset in microseconds (modulo interval_us).
+	 */
+	void ScheduleOnIntervalAligned(uint32_t interval_us, uint32_t phase_us = 0);
+
 	/**
 	 * Clear any scheduled work.
 	 */
@@ -71,6 +82,8 @@ protected:
 
 	virtual void print_run_status() const override;
 
+	virtual uint32_t deadline_us() const override;
+
 private:
 
 	virtual void Run() override = 0;
@@ -64,6 +64,17 @@ public:
 		}
 	}
 
+	/**
+	 * Run a scheduled item of the same WorkQueue right away from within this item's Run(),
+	 * instead of after it (saves one scheduling round trip when chaining work, e.g. a
+	 * uORB callback triggered by a publication of this item).
+	 *
+	 * @param item			The WorkItem to run.
+	 * @return			true if it was run, false if it stays scheduled or was not scheduled
+	 *				(see WorkQueue::RunInline()).
+	 */
+	bool RunInline(WorkItem *item) { return (_wq != nullptr) && _wq->RunInline(this, item); }
+
 	virtual void print_run_status() const;
 
 	/**
@@ -77,6 +88,24 @@ public:
 
 	const char *ItemName() const { return _item_name; }
 
+	/**
+	 * Set the deadline of a run (queue wait plus execution time) in microseconds.
+	 * Without a deadline, overruns are counted against the schedule interval
+	 * (ScheduledWorkItem) or the measured average interval.
+	 *
+	 * @param deadline_us		The deadline in microseconds (0 to disable).
+	 */
+	void SetDeadline(uint32_t deadline_us) { _deadline_us = deadline_us; }
+
+	/**
+	 * Set the priority within the WorkQueue. Items with a higher priority are
+	 * run before queued items with a lower priority, items with the same priority
+	 * run in the order they were scheduled.
+	 *
+	 * @param priority		0 (default, lowest) to 255.
+	 */
+	void SetQueuePriority(uint8_t priority) { _priority = priority; }
+
 protected:
 
 	explicit WorkItem(const char *name, const wq_config_t &config);
@@ -91,16 +120,24 @@ protected:
 	void ScheduleClear();
 protected:
 
-	void RunPreamble()
+	void RunPreamble(const hrt_abstime &now)
 	{
 		_run_count++;
 
 		if (_time_first_run == 0) {
-			_time_first_run = hrt_absolute_time();
+			_time_first_run = now;
 		}
 	}
 
-	friend void WorkQueue::Run();
+	/**
+	 * Record the timing of a completed run.
+	 *
+	 * @param wait_us		Time from being queued until the run started.
+	 * @param run_time_us		Execution time of Run().
+	 */
+	void RunPostamble(uint32_t wait_us, uint32_t run_time_us);
+
+	friend class WorkQueue;
 	virtual void Run() = 0;
 
 	/**
@@ -118,14 +155,36 @@ protected:
 	float average_rate() const;
 	float average_interval() const;
 
+	/**
+	 * Deadline used to count overruns in microseconds, 0 if none.
+	 */
+	virtual uint32_t deadline_us() const;
+
+	/**
+	 * Print execution time, queue wait and overruns (ends the status line).
+	 */
+	void print_run_statistics() const;
+
 	hrt_abstime	_time_first_run{0};
 	const char 	*_item_name;
 	uint32_t	_run_count{0};
+	uint32_t	_deadline_us{0};
 
 private:
 
 	WorkQueue	*_wq{nullptr};
 
+	// timing statistics, updated by the WorkQueue after every run
+	hrt_abstime	_time_queued{0};	// time the item was added to the runnable queue
+	uint64_t	_run_time_total_us{0};
+	uint64_t	_wait_total_us{0};
+	uint32_t	_run_time_min_us{UINT32_MAX};
+	uint32_t	_run_time_max_us{0};
+	uint32_t	_wait_max_us{0};
+	uint32_t	_deadline_overruns{0};
+
+	uint8_t		_priority{0};		// priority within the queue
+
 };
 
 } // namespace px4
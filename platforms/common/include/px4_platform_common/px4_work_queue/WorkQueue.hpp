@@ -66,12 +66,63 @@ public:
 
 	void Clear();
 
-	void Run();
+	/**
+	 * Run a scheduled item directly from within caller's Run() on the same worker thread,
+	 * instead of waiting for caller to return. The item is removed from the queue and counts
+	 * as running for the duration, so it is never run concurrently by another worker.
+	 *
+	 * @param caller		WorkItem of this queue currently in Run().
+	 * @param item			WorkItem of this queue to run.
+	 * @return			false if the item was not run (caller not running on this queue,
+	 *				item not attached, not scheduled or already running).
+	 */
+	bool RunInline(const WorkItem *caller, WorkItem *item);
+
+	/**
+	 * Process queued work. On a worker pool several threads run this concurrently,
+	 * a WorkItem is never run by two of them at the same time.
+	 *
+	 * @param worker		Index of the calling thread, 0 for the queue's own thread.
+	 */
+	void Run(unsigned worker = 0);
+
+	/**
+	 * Add a helper thread to the workers of this queue.
+	 *
+	 * @return		The worker index to pass to Run(), or -1 on failure.
+	 */
+	int AttachWorker();
+
+	/**
+	 * Remove a helper thread after its Run() returned.
+	 */
+	void DetachWorker() { _helpers_running.fetch_sub(1); }
 
 	void request_stop() { _should_exit.store(true); }
 
+	static constexpr unsigned MAX_WORKERS = 8;
+
 	void print_status(bool last = false);
 
+	/**
+	 * Get the stack size of the queue's thread and its high-water mark in bytes.
+	 * The high-water mark is only available on NuttX (0 otherwise).
+	 */
+	void stack_usage(unsigned &size, unsigned &used_max) const;
+
+	size_t num_items() { return _work_items.size(); }
+
+	/**
+	 * Get the run statistics of the attached WorkItems.
+	 * @return		The number of entries filled in.
+	 */
+	unsigned items_info(wq_item_info_t *items, unsigned max_items);
+
+	/**
+	 * @return		true if no WorkItem is queued or running.
+	 */
+	bool idle();
+
 private:
 
 	bool should_exit() const { return _should_exit.load(); }
@@ -90,7 +141,15 @@ private:
 	px4_sem_t _qlock;
 #endif
 
+	bool is_running(const WorkItem *item) const;
+
 	IntrusiveQueue<WorkItem *>	_q;
+	IntrusiveQueue<WorkItem *>	_rerun_q;	// items scheduled while running on another worker
+	WorkItem			*_running_items[MAX_WORKERS] {};	// item in Run() per worker (protected by work_lock)
+	WorkItem			*_inline_items[MAX_WORKERS] {};	// item run inline by _running_items per worker (protected by work_lock)
+	pid_t				_thread_pid{-1};	// thread of worker 0
+	px4::atomic_int			_num_workers{1};
+	px4::atomic_int			_helpers_running{0};
 	px4_sem_t			_process_lock;
 	const wq_config_t		&_config;
 	BlockingList<WorkItem *>	_work_items;
@@ -43,7 +43,20 @@ class WorkQueue; // forward declaration
 struct wq_config_t {
 	const char *name;
 	uint16_t stacksize;
-	int8_t relative_priority; // relative to max
+	int16_t relative_priority; // relative to max, limited to the minimum priority
+};
+
+struct wq_info_t {
+	const char *name;
+	unsigned stack_size;		// stack size of the thread in bytes
+	unsigned stack_used_max;	// stack high-water mark in bytes (NuttX only, 0 otherwise)
+	unsigned num_items;		// number of attached WorkItems
+};
+
+struct wq_item_info_t {
+	const char *name;
+	uint32_t run_count;		// number of runs
+	uint64_t run_time_total_us;	// accumulated execution time of Run()
 };
 
 namespace wq_configurations
@@ -68,6 +81,11 @@ static constexpr wq_config_t I2C4{"wq:I2C4", 1472, -12};
 static constexpr wq_config_t attitude_ctrl{"wq:attitude_ctrl", 1536, -13};
 static constexpr wq_config_t navigation_and_controllers{"wq:navigation_and_controllers", 7200, -14};
 
+// multi-EKF2, one estimator instance per queue (see ins_instance_to_wq())
+static constexpr wq_config_t INS0{"wq:INS0", 7200, -14};
+static constexpr wq_config_t INS1{"wq:INS1", 7200, -14};
+static constexpr wq_config_t INS2{"wq:INS2", 7200, -14};
+
 static constexpr wq_config_t hp_default{"wq:hp_default", 1900, -15};
 
 static constexpr wq_config_t uavcan{"wq:uavcan", 3000, -16};
@@ -85,6 +103,13 @@ static constexpr wq_config_t UART_UNKNOWN{"wq:UART_UNKNOWN", 1400, -26};
 
 static constexpr wq_config_t lp_default{"wq:lp_default", 1700, -50};
 
+// navigator blocks on dataman (SD card) access, keep it away from the other work queues.
+// -150 is the priority of the former navigator task on NuttX (SCHED_PRIORITY_NAVIGATION, 105)
+static constexpr wq_config_t navigator{"wq:navigator", 1900, -150};
+
+// POSIX only: worker pool shared by hp_default, lp_default and the UART queues (see PX4_WQ_POOL_THREADS)
+static constexpr wq_config_t pool{"wq:pool", 1900, -15};
+
 static constexpr wq_config_t test1{"wq:test1", 2000, 0};
 static constexpr wq_config_t test2{"wq:test2", 2000, 0};
 
@@ -92,6 +117,11 @@ static constexpr wq_config_t test2{"wq:test2", 2000, 0};
 
 /**
  * Start the work queue manager task.
+ *
+ * On Linux the threads of the work queues can be configured with environment variables,
+ * per queue (name without "wq:") or for all queues without their own setting:
+ *  - PX4_WQ_CPUS_<queue> / PX4_WQ_CPUS: CPU affinity, e.g. "3" or "0-2"
+ *  - PX4_WQ_POLICY_<queue> / PX4_WQ_POLICY: scheduling policy FIFO (default), RR or OTHER
  */
 int WorkQueueManagerStart();
 
@@ -105,13 +135,43 @@ int WorkQueueManagerStop();
  */
 int WorkQueueManagerStatus();
 
+/**
+ * Get stack and WorkItem information of a running work queue.
+ *
+ * @param index		The index of the work queue (from 0).
+ * @param info		The information of the work queue.
+ * @return		false if there is no work queue with this index.
+ */
+bool WorkQueueManagerInfo(unsigned index, wq_info_t &info);
+
+/**
+ * Get the run statistics of the WorkItems attached to a running work queue.
+ *
+ * @param index		The index of the work queue (from 0).
+ * @param items		Array of at least max_items entries.
+ * @param max_items	The maximum number of WorkItems to get.
+ * @return		The number of entries filled in, or -1 if there is no work queue with this index.
+ */
+int WorkQueueManagerItemsInfo(unsigned index, wq_item_info_t *items, unsigned max_items);
+
+/**
+ * Check if all work queues are idle, i.e. no WorkItem is queued or running.
+ * WorkItems triggered by a publication are queued before the publish call returns,
+ * so this can be used to wait until all processing caused by a publication is done.
+ */
+bool WorkQueueManagerIdle();
+
 /**
  * Create (or find) a work queue with a particular configuration.
  *
- * @param new_wq		The work queue configuration (see WorkQueueManager.hpp).
+ * On POSIX the non real-time queues (hp_default, lp_default, UARTx) are mapped
+ * to the shared worker pool if the environment variable PX4_WQ_POOL_THREADS is
+ * set to the number of pool threads (at least 2) when the manager starts.
+ *
+ * @param config		The work queue configuration (see WorkQueueManager.hpp).
  * @return		A pointer to the WorkQueue, or nullptr on failure.
  */
-WorkQueue *WorkQueueFindOrCreate(const wq_config_t &new_wq);
+WorkQueue *WorkQueueFindOrCreate(const wq_config_t &config);
 
 /**
  * Map a PX4 driver device id to a work queue (by sensor bus).
@@ -129,5 +189,13 @@ const wq_config_t &device_bus_to_wq(uint32_t device_id);
  */
 const wq_config_t &serial_port_to_wq(const char *serial);
 
+/**
+ * Map an estimator (INS) instance to a work queue.
+ *
+ * @param instance		The estimator instance (0 based).
+ * @return		A work queue configuration.
+ */
+const wq_config_t &ins_instance_to_wq(uint8_t instance);
+
 
 } // namespace px4
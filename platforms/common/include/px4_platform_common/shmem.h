@@ -39,6 +39,18 @@
 
 #define PARAM_BUFFER_SIZE (MAX_SHMEM_PARAMS / 8 + 1)
 
+/**
+ * Entry of a batched parameter transfer between the processors.
+ * A batch buffer holds the number of entries (uint32_t) followed by the entries.
+ */
+struct shmem_param_update {
+	uint32_t param;
+	union param_value_u value;
+};
+
+#define PARAM_UPDATE_BATCH_SIZE 64
+#define PARAM_UPDATE_BUFFER_SIZE (sizeof(uint32_t) + PARAM_UPDATE_BATCH_SIZE * sizeof(struct shmem_param_update))
+
 struct shmem_info {
 	union param_value_u params_val[MAX_SHMEM_PARAMS];
 	unsigned char krait_changed_index[MAX_SHMEM_PARAMS / 8 + 1]; /*bit map of all params changed by krait*/
@@ -78,5 +90,6 @@ void copy_params_to_shmem(const param_info_s *param_info_base);
 #endif
 
 void update_to_shmem(param_t param, union param_value_u value);
+void flush_updates_to_shmem(void);
 int update_from_shmem(param_t param, union param_value_u *value);
 void update_index_from_shmem(void);
@@ -4,6 +4,7 @@
 #include <sys/types.h>
 #include <time.h>
 #include <pthread.h>
+#include <stdbool.h>
 
 #if defined(__PX4_APPLE_LEGACY)
 #define clockid_t int
@@ -27,6 +28,11 @@ __EXPORT unsigned int px4_sleep(unsigned int seconds);
 __EXPORT int px4_pthread_cond_timedwait(pthread_cond_t *cond,
 					pthread_mutex_t *mutex,
 					const struct timespec *abstime);
+
+/**
+ * Check if all threads woken up by the last time update are waiting again.
+ */
+__EXPORT bool px4_lockstep_idle(void);
 __END_DECLS
 
 #else
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file trace.h
+ * Lightweight execution trace recorder.
+ *
+ * Records WorkItem start/stop, uORB publications and uORB callback scheduling
+ * into a fixed size ring buffer with hrt timestamps. Recording is disabled by
+ * default and costs a single atomic load per event in that case. Use the
+ * 'trace' systemcmd to start/stop recording and to export the buffer as a
+ * Chrome/Perfetto JSON trace.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/atomic.h>
+
+namespace px4
+{
+namespace trace
+{
+
+enum class Event : uint8_t {
+	WorkItemStart,    ///< name: WorkItem, context: work queue
+	WorkItemStop,     ///< name: WorkItem, context: work queue
+	Publish,          ///< name: topic
+	CallbackSchedule, ///< name: topic, context: scheduled WorkItem
+};
+
+struct Record {
+	hrt_abstime timestamp;
+	const char *name;    ///< must point to static storage (topic or WorkItem name)
+	const char *context; ///< must point to static storage (or nullptr)
+	Event event;
+};
+
+extern px4::atomic_bool recording;
+
+void record(Event event, const char *name, const char *context);
+
+/**
+ * Record an event if tracing is enabled.
+ */
+static inline void event(Event event, const char *name, const char *context = nullptr)
+{
+	if (recording.load()) {
+		record(event, name, context);
+	}
+}
+
+/**
+ * Start recording, the buffer is (re)allocated if the size changes and previous records are cleared.
+ * @param num_records ring buffer size (oldest records are overwritten)
+ * @return false on allocation failure
+ */
+bool start(unsigned num_records);
+
+/**
+ * Stop recording, the buffer is kept until the next start() so that it can be read.
+ */
+void stop();
+
+/**
+ * Number of valid records in the buffer
+ */
+unsigned count();
+
+/**
+ * Number of records overwritten since start()
+ */
+unsigned overwritten();
+
+/**
+ * Get a record (only while recording is stopped).
+ * @param index 0 is the oldest record
+ */
+bool get(unsigned index, Record &record);
+
+} // namespace trace
+} // namespace px4
+
+#endif /* __cplusplus */
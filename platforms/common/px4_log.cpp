@@ -41,6 +41,10 @@
 #endif
 
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/posix.h>
+#include <px4_platform_common/sem.h>
+#include <px4_platform_common/tasks.h>
 #if defined(__PX4_POSIX)
 #include <px4_daemon/server_io.h>
 #endif
@@ -51,6 +55,29 @@
 
 static orb_advert_t orb_log_message_pub = nullptr;
 
+/*
+ * Deferred output for PX4_INFO & PX4_WARN from threads above the default priority (work queues,
+ * drivers, controllers): the message is formatted into a lock-free queue (multiple producers, one
+ * consumer), and a low priority task prints and publishes it. This way the caller never blocks on
+ * the console. If the queue is full, the message is dropped and counted.
+ */
+static constexpr uint32_t DEFERRED_LOG_QUEUE_LENGTH = 16; // must be a power of 2
+
+struct deferred_log_entry_s {
+	px4::atomic<uint32_t> sequence; // == position + 1 when filled, == position when free
+	int level;
+	const char *module_name;
+	char text[sizeof(log_message_s::text)];
+};
+
+static deferred_log_entry_s deferred_log_queue[DEFERRED_LOG_QUEUE_LENGTH];
+static px4::atomic<uint32_t> deferred_log_head{0};
+static px4::atomic<uint32_t> deferred_log_dropped{0};
+static px4::atomic_bool deferred_log_running{false};
+static px4_sem_t deferred_log_sem;
+
+static int deferred_log_task_main(int argc, char *argv[]);
+
 __EXPORT const char *__px4_log_level_str[_PX4_LOG_LEVEL_PANIC + 1] = { "DEBUG", "INFO", "WARN", "ERROR", "PANIC" };
 __EXPORT const char *__px4_log_level_color[_PX4_LOG_LEVEL_PANIC + 1] =
 { PX4_ANSI_COLOR_GREEN, PX4_ANSI_COLOR_RESET, PX4_ANSI_COLOR_YELLOW, PX4_ANSI_COLOR_RED, PX4_ANSI_COLOR_RED };
@@ -71,10 +98,24 @@ void px4_log_initialize(void)
 	if (!orb_log_message_pub) {
 		PX4_ERR("failed to advertise log_message");
 	}
-}
 
+	for (uint32_t i = 0; i < DEFERRED_LOG_QUEUE_LENGTH; i++) {
+		deferred_log_queue[i].sequence.store(i);
+	}
+
+	px4_sem_init(&deferred_log_sem, 0, 0);
+	px4_sem_setprotocol(&deferred_log_sem, SEM_PRIO_NONE);
 
-__EXPORT void px4_log_modulename(int level, const char *moduleName, const char *fmt, ...)
+	if (px4_task_spawn_cmd("log_deferred", SCHED_DEFAULT, SCHED_PRIORITY_DEFAULT - 40, PX4_STACK_ADJUSTED(1500),
+			       deferred_log_task_main, nullptr) >= 0) {
+		deferred_log_running.store(true);
+	}
+}
+
+/**
+ * Print to the console and publish a log message
+ */
+static void log_output(int level, const char *moduleName, const char *fmt, va_list args)
 {
 	FILE *out = stdout;
 	bool use_color = true;
@@ -99,7 +140,7 @@ __EXPORT void px4_log_modulename(int level, const char *moduleName, const char *
 		if (use_color) { fputs(__px4_log_level_color[level], out); }
 
 		va_list argptr;
-		va_start(argptr, fmt);
+		va_copy(argptr, args);
 		vfprintf(out, fmt, argptr);
 		va_end(argptr);
 
@@ -129,7 +170,7 @@ __EXPORT void px4_log_modulename(int level, const char *moduleName, const char *
 		va_list argptr;
 
 		pos += snprintf((char *)log_message.text + pos, max_length_pub - pos, __px4__log_modulename_pfmt, moduleName);
-		va_start(argptr, fmt);
+		va_copy(argptr, args);
 		pos += vsnprintf((char *)log_message.text + pos, max_length_pub - pos, fmt, argptr);
 		va_end(argptr);
 		log_message.text[max_length_pub - 1] = 0; //ensure 0-termination
@@ -138,6 +179,113 @@ __EXPORT void px4_log_modulename(int level, const char *moduleName, const char *
 	}
 }
 
+static void log_output_fmt(int level, const char *moduleName, const char *fmt, ...)
+{
+	va_list argptr;
+	va_start(argptr, fmt);
+	log_output(level, moduleName, fmt, argptr);
+	va_end(argptr);
+}
+
+/**
+ * Check if a message of the calling thread is deferred (instead of printed directly)
+ */
+static bool log_deferred(int level)
+{
+	if ((level != _PX4_LOG_LEVEL_INFO && level != _PX4_LOG_LEVEL_WARN) || !deferred_log_running.load()) {
+		return false;
+	}
+
+	int policy;
+	struct sched_param param;
+
+	if (pthread_getschedparam(pthread_self(), &policy, &param) != 0) {
+		return false;
+	}
+
+	return param.sched_priority > SCHED_PRIORITY_DEFAULT;
+}
+
+/**
+ * Format a message into the deferred queue (called from any thread)
+ */
+static void log_defer(int level, const char *moduleName, const char *fmt, va_list args)
+{
+	uint32_t pos = deferred_log_head.load();
+	deferred_log_entry_s *entry;
+
+	// claim a free entry
+	while (true) {
+		entry = &deferred_log_queue[pos & (DEFERRED_LOG_QUEUE_LENGTH - 1)];
+		const int32_t diff = (int32_t)(entry->sequence.load() - pos);
+
+		if (diff == 0) {
+			if (deferred_log_head.compare_exchange(&pos, pos + 1)) {
+				break;
+			}
+
+		} else if (diff < 0) {
+			// full: the consumer did not free this entry yet
+			deferred_log_dropped.fetch_add(1);
+			return;
+
+		} else {
+			// another producer claimed it
+			pos = deferred_log_head.load();
+		}
+	}
+
+	entry->level = level;
+	entry->module_name = moduleName;
+	vsnprintf(entry->text, sizeof(entry->text), fmt, args);
+
+	entry->sequence.store(pos + 1);
+	px4_sem_post(&deferred_log_sem);
+}
+
+static int deferred_log_task_main(int argc, char *argv[])
+{
+	uint32_t tail = 0;
+
+	while (true) {
+		while (px4_sem_wait(&deferred_log_sem) != 0) {}
+
+		deferred_log_entry_s *entry = &deferred_log_queue[tail & (DEFERRED_LOG_QUEUE_LENGTH - 1)];
+
+		while (entry->sequence.load() == tail + 1) {
+			log_output_fmt(entry->level, entry->module_name, "%s", entry->text);
+
+			// free the entry for the next round
+			entry->sequence.store(tail + DEFERRED_LOG_QUEUE_LENGTH);
+			++tail;
+			entry = &deferred_log_queue[tail & (DEFERRED_LOG_QUEUE_LENGTH - 1)];
+		}
+
+		const uint32_t dropped = deferred_log_dropped.fetch_and(0);
+
+		if (dropped > 0) {
+			log_output_fmt(_PX4_LOG_LEVEL_WARN, "log", "%u messages dropped", (unsigned)dropped);
+		}
+	}
+
+	return 0;
+}
+
+__EXPORT void px4_log_modulename(int level, const char *moduleName, const char *fmt, ...)
+{
+	va_list argptr;
+	va_start(argptr, fmt);
+
+	if (log_deferred(level)) {
+		log_defer(level, moduleName, fmt, argptr);
+
+	} else {
+		log_output(level, moduleName, fmt, argptr);
+	}
+
+	va_end(argptr);
+}
+
 __EXPORT void px4_log_raw(int level, const char *fmt, ...)
 {
 	FILE *out = stdout;
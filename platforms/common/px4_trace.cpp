@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <px4_platform_common/trace.h>
+#include <px4_platform_common/time.h>
+
+namespace px4
+{
+namespace trace
+{
+
+px4::atomic_bool recording{false};
+
+static Record *_buffer{nullptr};
+static unsigned _size{0};
+static px4::atomic<unsigned> _next{0};
+
+void record(Event event, const char *name, const char *context)
+{
+	const unsigned index = _next.fetch_add(1);
+	Record &r = _buffer[index % _size];
+	r.timestamp = hrt_absolute_time();
+	r.name = name;
+	r.context = context;
+	r.event = event;
+}
+
+bool start(unsigned num_records)
+{
+	if (num_records == 0) {
+		return false;
+	}
+
+	recording.store(false);
+
+	if (num_records != _size) {
+		// give writers that already passed the recording check time to finish
+		px4_usleep(10000);
+
+		delete[] _buffer;
+		_buffer = new Record[num_records];
+
+		if (_buffer == nullptr) {
+			_size = 0;
+			return false;
+		}
+
+		_size = num_records;
+	}
+
+	_next.store(0);
+	recording.store(true);
+	return true;
+}
+
+void stop()
+{
+	recording.store(false);
+}
+
+unsigned count()
+{
+	const unsigned next = _next.load();
+	return next < _size ? next : _size;
+}
+
+unsigned overwritten()
+{
+	const unsigned next = _next.load();
+	return next > _size ? next - _size : 0;
+}
+
+bool get(unsigned index, Record &record)
+{
+	if ((_buffer == nullptr) || (index >= count())) {
+		return false;
+	}
+
+	record = _buffer[(overwritten() + index) % _size];
+	return true;
+}
+
+} // namespace trace
+} // namespace px4
@@ -0,0 +1,301 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <px4_platform_common/px4_work_queue/PollWorkItem.hpp>
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/tasks.h>
+#include <px4_platform_common/time.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+// shared thread polling the file descriptors of all PollWorkItems
+class PollWorkItemPoller
+{
+public:
+	static bool add(PollWorkItem *item, int fd, short events);
+	static void remove(PollWorkItem *item);
+	static void rearm(PollWorkItem *item);
+
+private:
+	static int run(int, char **);
+	static bool start_locked();
+	static bool registered_locked(const PollWorkItem *item);
+	static void wakeup();
+
+	static pthread_mutex_t _mutex;
+	static PollWorkItem *_items[PollWorkItem::MAX_POLL_ITEMS];
+	static int _wakeup_pipe[2];
+	static bool _running;
+};
+
+pthread_mutex_t PollWorkItemPoller::_mutex = PTHREAD_MUTEX_INITIALIZER;
+PollWorkItem *PollWorkItemPoller::_items[PollWorkItem::MAX_POLL_ITEMS] {};
+int PollWorkItemPoller::_wakeup_pipe[2] {-1, -1};
+bool PollWorkItemPoller::_running{false};
+
+bool PollWorkItemPoller::start_locked()
+{
+	if (_running) {
+		return true;
+	}
+
+	if (pipe(_wakeup_pipe) != 0) {
+		PX4_ERR("pipe failed (%i)", errno);
+		return false;
+	}
+
+	// never block the items waking up the poller
+	fcntl(_wakeup_pipe[1], F_SETFL, fcntl(_wakeup_pipe[1], F_GETFL) | O_NONBLOCK);
+
+	int task_id = px4_task_spawn_cmd("wq:poll", SCHED_DEFAULT, SCHED_PRIORITY_MAX - 1, 1024,
+					 (px4_main_t)&PollWorkItemPoller::run, nullptr);
+
+	if (task_id < 0) {
+		PX4_ERR("task start failed (%i)", task_id);
+		close(_wakeup_pipe[0]);
+		close(_wakeup_pipe[1]);
+		return false;
+	}
+
+	_running = true;
+	return true;
+}
+
+bool PollWorkItemPoller::registered_locked(const PollWorkItem *item)
+{
+	for (const auto registered : _items) {
+		if (registered == item) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void PollWorkItemPoller::wakeup()
+{
+	const char c = 0;
+
+	if (write(_wakeup_pipe[1], &c, 1) < 0) {
+		// the pipe is full, the poller is going to wake up anyway
+	}
+}
+
+bool PollWorkItemPoller::add(PollWorkItem *item, int fd, short events)
+{
+	bool added = false;
+
+	pthread_mutex_lock(&_mutex);
+
+	if (start_locked()) {
+		for (auto &registered : _items) {
+			if (registered == nullptr) {
+				registered = item;
+				item->_fd = fd;
+				item->_events = events;
+				item->_armed = true;
+				added = true;
+				break;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&_mutex);
+
+	if (added) {
+		wakeup();
+
+	} else {
+		PX4_ERR("%s: no free poll slot", item->ItemName());
+	}
+
+	return added;
+}
+
+void PollWorkItemPoller::remove(PollWorkItem *item)
+{
+	pthread_mutex_lock(&_mutex);
+
+	for (auto &registered : _items) {
+		if (registered == item) {
+			registered = nullptr;
+		}
+	}
+
+	item->_armed = false;
+	item->_fd = -1;
+
+	const bool running = _running;
+	pthread_mutex_unlock(&_mutex);
+
+	if (running) {
+		wakeup();
+	}
+}
+
+void PollWorkItemPoller::rearm(PollWorkItem *item)
+{
+	bool rearmed = false;
+
+	pthread_mutex_lock(&_mutex);
+
+	if (!item->_armed && registered_locked(item)) {
+		item->_armed = true;
+		rearmed = true;
+	}
+
+	pthread_mutex_unlock(&_mutex);
+
+	if (rearmed) {
+		wakeup();
+	}
+}
+
+int PollWorkItemPoller::run(int, char **)
+{
+	pollfd fds[PollWorkItem::MAX_POLL_ITEMS + 1];
+	PollWorkItem *items[PollWorkItem::MAX_POLL_ITEMS + 1];
+
+	for (;;) {
+		// poll the wakeup pipe and all armed items
+		pthread_mutex_lock(&_mutex);
+
+		fds[0].fd = _wakeup_pipe[0];
+		fds[0].events = POLLIN;
+		fds[0].revents = 0;
+		int num_fds = 1;
+
+		for (const auto item : _items) {
+			if ((item != nullptr) && item->_armed) {
+				fds[num_fds].fd = item->_fd;
+				fds[num_fds].events = item->_events;
+				fds[num_fds].revents = 0;
+				items[num_fds] = item;
+				num_fds++;
+			}
+		}
+
+		pthread_mutex_unlock(&_mutex);
+
+		int ret = ::poll(fds, num_fds, -1);
+
+		if (ret < 0) {
+			if (errno != EINTR) {
+				PX4_ERR("poll failed (%i)", errno);
+				px4_usleep(10000);
+			}
+
+			continue;
+		}
+
+		if (fds[0].revents & POLLIN) {
+			char buffer[16];
+
+			if (read(_wakeup_pipe[0], buffer, sizeof(buffer)) < 0) {
+				PX4_ERR("wakeup read failed (%i)", errno);
+			}
+		}
+
+		pthread_mutex_lock(&_mutex);
+
+		for (int i = 1; i < num_fds; i++) {
+			PollWorkItem *item = items[i];
+
+			// skip items that were removed (or changed their fd) in the meantime
+			if ((fds[i].revents != 0) && registered_locked(item) && item->_armed && (item->_fd == fds[i].fd)) {
+				// don't poll again until the item ran
+				item->_armed = false;
+				item->_revents = fds[i].revents;
+				item->ScheduleNow();
+			}
+		}
+
+		pthread_mutex_unlock(&_mutex);
+	}
+
+	return 0;
+}
+
+PollWorkItem::~PollWorkItem()
+{
+	if (_deleted != nullptr) {
+		// deleted from within PollRun()
+		*_deleted = true;
+	}
+
+	PollClear();
+}
+
+bool PollWorkItem::PollFd(int fd, short events)
+{
+	PollClear();
+
+	if (fd < 0) {
+		return false;
+	}
+
+	return PollWorkItemPoller::add(this, fd, events);
+}
+
+void PollWorkItem::PollClear()
+{
+	PollWorkItemPoller::remove(this);
+	ScheduleClear();
+}
+
+void PollWorkItem::Run()
+{
+	const short revents = _revents;
+	_revents = 0;
+
+	bool deleted = false;
+	_deleted = &deleted;
+
+	PollRun(revents);
+
+	if (!deleted) {
+		_deleted = nullptr;
+
+		// poll the file descriptor again
+		PollWorkItemPoller::rearm(this);
+	}
+}
+
+} // namespace px4
@@ -57,6 +57,20 @@ void ScheduledWorkItem::ScheduleOnInterval(uint32_t interval_us, uint32_t delay_
 	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
 }
 
+void ScheduledWorkItem::ScheduleOnIntervalAligned(uint32_t interval_us, uint32_t phase_us)
+{
+	if (interval_us == 0) {
+		ScheduleOnInterval(interval_us);
+		return;
+	}
+
+	// delay until the next multiple of the interval plus the phase, the periodic call keeps the phase
+	const uint32_t now_phase = hrt_absolute_time() % interval_us;
+	const uint32_t delay_us = ((phase_us % interval_us) + interval_us - now_phase) % interval_us;
+
+	hrt_call_every(&_call, delay_us, interval_us, (hrt_callout)&ScheduledWorkItem::schedule_trampoline, this);
+}
+
 void ScheduledWorkItem::ScheduleClear()
 {
 	// first clear any scheduled hrt call, then remove the item from the runnable queue
@@ -64,11 +78,22 @@ void ScheduledWorkItem::ScheduleClear()
 	WorkItem::ScheduleClear();
 }
 
+uint32_t ScheduledWorkItem::deadline_us() const
+{
+	// a run should complete within the schedule interval
+	if ((_deadline_us == 0) && (_call.period > 0)) {
+		return _call.period;
+	}
+
+	return WorkItem::deadline_us();
+}
+
 void ScheduledWorkItem::print_run_status() const
 {
 	if (_call.period > 0) {
-		PX4_INFO_RAW("%-26s %8.1f Hz %12.0f us (%" PRId64 " us)\n", _item_name, (double)average_rate(),
+		PX4_INFO_RAW("%-26s %8.1f Hz %12.0f us (%6" PRId64 " us)", _item_name, (double)average_rate(),
 			     (double)average_interval(), _call.period);
+		print_run_statistics();
 
 	} else {
 		WorkItem::print_run_status();
@@ -132,9 +132,60 @@ float WorkItem::average_interval() const
 	return 0.f;
 }
 
+uint32_t WorkItem::deadline_us() const
+{
+	if (_deadline_us > 0) {
+		return _deadline_us;
+	}
+
+	// fall back to the average interval once it has settled
+	if (_run_count > 10) {
+		return hrt_elapsed_time(&_time_first_run) / _run_count;
+	}
+
+	return 0;
+}
+
+void WorkItem::RunPostamble(uint32_t wait_us, uint32_t run_time_us)
+{
+	_run_time_total_us += run_time_us;
+	_wait_total_us += wait_us;
+
+	if (run_time_us < _run_time_min_us) {
+		_run_time_min_us = run_time_us;
+	}
+
+	if (run_time_us > _run_time_max_us) {
+		_run_time_max_us = run_time_us;
+	}
+
+	if (wait_us > _wait_max_us) {
+		_wait_max_us = wait_us;
+	}
+
+	const uint32_t deadline = deadline_us();
+
+	if ((deadline > 0) && (wait_us + run_time_us > deadline)) {
+		_deadline_overruns++;
+	}
+}
+
 void WorkItem::print_run_status() const
 {
-	PX4_INFO_RAW("%-26s %8.1f Hz %12.0f us\n", _item_name, (double)average_rate(), (double)average_interval());
+	PX4_INFO_RAW("%-26s %8.1f Hz %12.0f us            ", _item_name, (double)average_rate(), (double)average_interval());
+	print_run_statistics();
+}
+
+void WorkItem::print_run_statistics() const
+{
+	if (_run_count > 0) {
+		PX4_INFO_RAW(" %5u %5u %5u us %5u %5u us %6u\n",
+			     (unsigned)(_run_time_total_us / _run_count), (unsigned)_run_time_min_us, (unsigned)_run_time_max_us,
+			     (unsigned)(_wait_total_us / _run_count), (unsigned)_wait_max_us, (unsigned)_deadline_overruns);
+
+	} else {
+		PX4_INFO_RAW("\n");
+	}
 }
 
 } // namespace px4
@@ -38,8 +38,16 @@
 
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
+#include <px4_platform_common/trace.h>
 #include <drivers/drv_hrt.h>
 
+#if defined(__PX4_NUTTX)
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+extern "C" FAR struct tcb_s *sched_gettcb(pid_t pid);
+#endif /* __PX4_NUTTX */
+
 namespace px4
 {
 
@@ -91,6 +99,20 @@ void WorkQueue::Detach(WorkItem *item)
 	work_lock();
 
 	_work_items.remove(item);
+	_rerun_q.remove(item);
+
+	for (auto &running_item : _running_items) {
+		if (running_item == item) {
+			// the item is going away while (or right after) running, don't record its timing
+			running_item = nullptr;
+		}
+	}
+
+	for (auto &inline_item : _inline_items) {
+		if (inline_item == item) {
+			inline_item = nullptr;
+		}
+	}
 
 	if (_work_items.size() == 0) {
 		// shutdown, no active WorkItems
@@ -106,7 +128,41 @@ void WorkQueue::Detach(WorkItem *item)
 void WorkQueue::Add(WorkItem *item)
 {
 	work_lock();
-	_q.push(item);
+
+	if (item->_time_queued == 0) {
+		item->_time_queued = hrt_absolute_time();
+	}
+
+	if (_rerun_q.remove(item)) {
+		// already waiting for another worker to finish it, keep it there
+		_rerun_q.push(item);
+
+	} else if ((item->_priority == 0) || _q.empty()) {
+		_q.push(item);
+
+	} else {
+		// keep the queue ordered by priority (FIFO within the same priority)
+		WorkItem *prev = nullptr;
+
+		for (WorkItem *node : _q) {
+			if (node == item) {
+				// already queued
+				prev = item;
+				break;
+			}
+
+			if (node->_priority < item->_priority) {
+				break;
+			}
+
+			prev = node;
+		}
+
+		if (prev != item) {
+			_q.insert_after(prev, item);
+		}
+	}
+
 	work_unlock();
 
 	SignalWorkerThread();
@@ -125,6 +181,7 @@ void WorkQueue::Remove(WorkItem *item)
 {
 	work_lock();
 	_q.remove(item);
+	_rerun_q.remove(item);
 	work_unlock();
 }
 
@@ -136,11 +193,123 @@ void WorkQueue::Clear()
 		_q.pop();
 	}
 
+	while (!_rerun_q.empty()) {
+		_rerun_q.pop();
+	}
+
+	work_unlock();
+}
+
+int WorkQueue::AttachWorker()
+{
+	if (should_exit()) {
+		return -1;
+	}
+
+	_helpers_running.fetch_add(1);
+	const int worker = _num_workers.fetch_add(1);
+
+	if (worker >= (int)MAX_WORKERS) {
+		_helpers_running.fetch_sub(1);
+		return -1;
+	}
+
+	return worker;
+}
+
+bool WorkQueue::is_running(const WorkItem *item) const
+{
+	for (unsigned i = 0; i < MAX_WORKERS; i++) {
+		if ((_running_items[i] == item) || (_inline_items[i] == item)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool WorkQueue::idle()
+{
+	work_lock();
+
+	// taking an item off the queue and marking it as running happens under the same lock
+	bool idle = _q.empty() && _rerun_q.empty();
+
+	for (unsigned i = 0; (i < MAX_WORKERS) && idle; i++) {
+		idle = (_running_items[i] == nullptr) && (_inline_items[i] == nullptr);
+	}
+
+	work_unlock();
+
+	return idle;
+}
+
+bool WorkQueue::RunInline(const WorkItem *caller, WorkItem *item)
+{
+	work_lock();
+
+	int worker = -1;
+
+	for (unsigned i = 0; i < MAX_WORKERS; i++) {
+		if (_running_items[i] == caller) {
+			worker = i;
+			break;
+		}
+	}
+
+	bool attached = false;
+
+	for (WorkItem *work_item : _work_items) {
+		if (work_item == item) {
+			attached = true;
+			break;
+		}
+	}
+
+	// only run if scheduled (e.g. by a uORB callback), this run consumes the schedule
+	if ((worker < 0) || (_inline_items[worker] != nullptr) || !attached || is_running(item) || !_q.remove(item)) {
+		work_unlock();
+		return false;
+	}
+
+	const hrt_abstime time_queued = item->_time_queued;
+	item->_time_queued = 0;
+	_inline_items[worker] = item;
+
+	const char *item_name = item->ItemName();
+
+	work_unlock();
+	px4::trace::event(px4::trace::Event::WorkItemStart, item_name, _config.name);
+	const hrt_abstime start = hrt_absolute_time();
+	item->RunPreamble(start);
+	item->Run();
+	const hrt_abstime end = hrt_absolute_time();
+	px4::trace::event(px4::trace::Event::WorkItemStop, item_name, _config.name);
+	work_lock();
+
+	// Note: after Run() item might have been deleted, in that case Detach() cleared _inline_items
+	if (_inline_items[worker] == item) {
+		const uint32_t wait_us = (time_queued > 0) && (start > time_queued) ? start - time_queued : 0;
+		item->RunPostamble(wait_us, end - start);
+
+		if (_rerun_q.remove(item)) {
+			_q.push(item);
+		}
+	}
+
+	_inline_items[worker] = nullptr;
+
 	work_unlock();
+
+	return true;
 }
 
-void WorkQueue::Run()
+void WorkQueue::Run(unsigned worker)
 {
+	if (worker == 0) {
+		_thread_pid = getpid();
+	}
+
 	while (!should_exit()) {
 		// loop as the wait may be interrupted by a signal
 		do {} while (px4_sem_wait(&_process_lock) != 0);
@@ -151,23 +320,115 @@ void WorkQueue::Run()
 		while (!_q.empty()) {
 			WorkItem *work = _q.pop();
 
+			if (is_running(work)) {
+				// still running on another worker, which will requeue it when done
+				_rerun_q.push(work);
+				continue;
+			}
+
+			if (!_q.empty() && (_num_workers.load() > 1)) {
+				// wake another worker for the remaining items
+				SignalWorkerThread();
+			}
+
+			const hrt_abstime time_queued = work->_time_queued;
+			work->_time_queued = 0;
+			_running_items[worker] = work;
+
+			// the name stays valid for tracing even if the item deletes itself in Run()
+			const char *item_name = work->ItemName();
+
 			work_unlock(); // unlock work queue to run (item may requeue itself)
-			work->RunPreamble();
+			px4::trace::event(px4::trace::Event::WorkItemStart, item_name, _config.name);
+			const hrt_abstime start = hrt_absolute_time();
+			work->RunPreamble(start);
 			work->Run();
-			// Note: after Run() we cannot access work anymore, as it might have been deleted
+			const hrt_abstime end = hrt_absolute_time();
+			px4::trace::event(px4::trace::Event::WorkItemStop, item_name, _config.name);
 			work_lock(); // re-lock
+
+			// Note: after Run() work might have been deleted, in that case Detach() cleared _running_items
+			if (_running_items[worker] == work) {
+				const uint32_t wait_us = (time_queued > 0) && (start > time_queued) ? start - time_queued : 0;
+				work->RunPostamble(wait_us, end - start);
+
+				if (_rerun_q.remove(work)) {
+					_q.push(work);
+				}
+			}
+
+			_running_items[worker] = nullptr;
 		}
 
 		work_unlock();
 	}
 
+	// let the remaining workers see the exit request
+	SignalWorkerThread();
+
+	if (worker == 0) {
+		// the queue is owned by this thread, wait until the helper workers left
+		while (_helpers_running.load() > 0) {
+			SignalWorkerThread();
+			px4_usleep(1000);
+		}
+	}
+
 	PX4_DEBUG("%s: exiting", _config.name);
 }
 
+void WorkQueue::stack_usage(unsigned &size, unsigned &used_max) const
+{
+	size = _config.stacksize;
+	used_max = 0;
+
+#if defined(__PX4_NUTTX)
+	sched_lock();
+
+	FAR struct tcb_s *tcb = sched_gettcb(_thread_pid);
+
+	if (tcb != nullptr) {
+		size = tcb->adj_stack_size;
+		used_max = up_check_tcbstack(tcb);
+	}
+
+	sched_unlock();
+#endif /* __PX4_NUTTX */
+}
+
+unsigned WorkQueue::items_info(wq_item_info_t *items, unsigned max_items)
+{
+	// holding the list lock keeps the items from being detached (and freed)
+	LockGuard lg{_work_items.mutex()};
+	unsigned num_items = 0;
+
+	for (WorkItem *item : _work_items) {
+		if (num_items == max_items) {
+			break;
+		}
+
+		items[num_items].name = item->ItemName();
+		items[num_items].run_count = item->_run_count;
+		items[num_items].run_time_total_us = item->_run_time_total_us;
+		num_items++;
+	}
+
+	return num_items;
+}
+
 void WorkQueue::print_status(bool last)
 {
 	const size_t num_items = _work_items.size();
-	PX4_INFO_RAW("%-16s\n", get_name());
+	unsigned stack_size;
+	unsigned stack_used_max;
+	stack_usage(stack_size, stack_used_max);
+
+	if (stack_used_max > 0) {
+		PX4_INFO_RAW("%-16s (stack %u/%u bytes)\n", get_name(), stack_used_max, stack_size);
+
+	} else {
+		PX4_INFO_RAW("%-16s\n", get_name());
+	}
 	unsigned i = 0;
 
 	for (WorkItem *item : _work_items) {
@@ -46,6 +46,7 @@
 #include <lib/mathlib/mathlib.h>
 
 #include <limits.h>
+#include <stdlib.h>
 #include <string.h>
 
 using namespace time_literals;
@@ -61,6 +62,19 @@ static BlockingQueue<const wq_config_t *, 1> *_wq_manager_create_queue{nullptr};
 
 static px4::atomic_bool _wq_manager_should_exit{true};
 
+#if defined(__PX4_POSIX)
+// number of threads of the shared worker pool (PX4_WQ_POOL_THREADS), disabled if < 2
+static int _wq_pool_threads{0};
+
+static bool
+WorkQueueUsesPool(const wq_config_t &config)
+{
+	// real-time queues (rate_ctrl, SPI, I2C, controllers) stay on their own thread
+	return (strcmp(config.name, wq_configurations::hp_default.name) == 0)
+	       || (strcmp(config.name, wq_configurations::lp_default.name) == 0)
+	       || (strncmp(config.name, "wq:UART", 7) == 0);
+}
+#endif /* __PX4_POSIX */
 
 static WorkQueue *
 FindWorkQueueByName(const char *name)
@@ -83,13 +97,19 @@ FindWorkQueueByName(const char *name)
 }
 
 WorkQueue *
-WorkQueueFindOrCreate(const wq_config_t &new_wq)
+WorkQueueFindOrCreate(const wq_config_t &config)
 {
 	if (_wq_manager_create_queue == nullptr) {
 		PX4_ERR("not running");
 		return nullptr;
 	}
 
+#if defined(__PX4_POSIX)
+	const wq_config_t &new_wq = ((_wq_pool_threads > 1) && WorkQueueUsesPool(config)) ? wq_configurations::pool : config;
+#else
+	const wq_config_t &new_wq = config;
+#endif /* __PX4_POSIX */
+
 	// search list for existing work queue
 	WorkQueue *wq = FindWorkQueueByName(new_wq.name);
 
@@ -201,6 +221,22 @@ serial_port_to_wq(const char *serial)
 	return wq_configurations::UART_UNKNOWN;
 }
 
+const wq_config_t &
+ins_instance_to_wq(uint8_t instance)
+{
+	switch (instance) {
+	case 0: return wq_configurations::INS0;
+
+	case 1: return wq_configurations::INS1;
+
+	case 2: return wq_configurations::INS2;
+	}
+
+	PX4_DEBUG("no INS work queue for instance %d", instance);
+
+	return wq_configurations::navigation_and_controllers;
+}
+
 static void *
 WorkQueueRunner(void *context)
 {
@@ -218,6 +254,143 @@ WorkQueueRunner(void *context)
 	return nullptr;
 }
 
+#if defined(__PX4_POSIX)
+static void *
+WorkQueueHelperRunner(void *context)
+{
+	const wq_config_t *config = static_cast<const wq_config_t *>(context);
+
+#ifdef __PX4_DARWIN
+	pthread_setname_np(config->name);
+#else
+	pthread_setname_np(pthread_self(), config->name);
+#endif
+
+	// wait for the queue's own thread to create it
+	WorkQueue *wq = nullptr;
+
+	for (int i = 0; (i < 1000) && (wq == nullptr); i++) {
+		wq = FindWorkQueueByName(config->name);
+
+		if (wq == nullptr) {
+			px4_usleep(1_ms);
+		}
+	}
+
+	const int worker = (wq != nullptr) ? wq->AttachWorker() : -1;
+
+	if (worker > 0) {
+		wq->Run(worker);
+		wq->DetachWorker();
+
+	} else {
+		PX4_ERR("%s: failed to add worker", config->name);
+	}
+
+	return nullptr;
+}
+#endif /* __PX4_POSIX */
+
+#if defined(__PX4_LINUX)
+// get PX4_WQ_<setting>_<queue> (queue name without "wq:", e.g. PX4_WQ_CPUS_rate_ctrl) or PX4_WQ_<setting> for all others
+static const char *
+WorkQueueSetting(const char *setting, const wq_config_t &config)
+{
+	char name[64];
+	snprintf(name, sizeof(name), "PX4_WQ_%s_%s", setting, (strncmp(config.name, "wq:", 3) == 0) ? config.name + 3 : config.name);
+	const char *value = getenv(name);
+
+	if (value == nullptr) {
+		snprintf(name, sizeof(name), "PX4_WQ_%s", setting);
+		value = getenv(name);
+	}
+
+	return value;
+}
+
+// parse a CPU list like "3", "0-2" or "0,2-3"
+static bool
+ParseCpuList(const char *list, cpu_set_t &cpus)
+{
+	CPU_ZERO(&cpus);
+
+	while (*list != '\0') {
+		char *end;
+		const long first = strtol(list, &end, 10);
+		long last = first;
+
+		if (end == list) {
+			return false;
+		}
+
+		if (*end == '-') {
+			list = end + 1;
+			last = strtol(list, &end, 10);
+
+			if (end == list) {
+				return false;
+			}
+		}
+
+		for (long cpu = math::max(first, 0L); (cpu <= last) && (cpu < CPU_SETSIZE); cpu++) {
+			CPU_SET(cpu, &cpus);
+		}
+
+		if (*end == ',') {
+			end++;
+
+		} else if (*end != '\0') {
+			return false;
+		}
+
+		list = end;
+	}
+
+	return CPU_COUNT(&cpus) > 0;
+}
+
+static void
+WorkQueueConfigureThread(const wq_config_t &config, pthread_attr_t *attr, int &policy)
+{
+	// use the policy and priority of the queue instead of inheriting the ones of the manager task
+	pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED);
+
+	const char *policy_setting = WorkQueueSetting("POLICY", config);
+
+	if (policy_setting != nullptr) {
+		if (strcasecmp(policy_setting, "FIFO") == 0) {
+			policy = SCHED_FIFO;
+
+		} else if (strcasecmp(policy_setting, "RR") == 0) {
+			policy = SCHED_RR;
+
+		} else if (strcasecmp(policy_setting, "OTHER") == 0) {
+			policy = SCHED_OTHER;
+
+		} else {
+			PX4_ERR("%s: invalid policy %s", config.name, policy_setting);
+		}
+	}
+
+	const char *cpus_setting = WorkQueueSetting("CPUS", config);
+
+	if (cpus_setting != nullptr) {
+		cpu_set_t cpus;
+
+		if (ParseCpuList(cpus_setting, cpus)) {
+			int ret = pthread_attr_setaffinity_np(attr, sizeof(cpus), &cpus);
+
+			if (ret != 0) {
+				PX4_ERR("%s: setting CPU affinity %s failed (%i)", config.name, cpus_setting, ret);
+			}
+
+		} else {
+			PX4_ERR("%s: invalid CPU list %s", config.name, cpus_setting);
+		}
+	}
+}
+#endif /* __PX4_LINUX */
+
 static int
 WorkQueueManagerRun(int, char **)
 {
@@ -263,19 +436,33 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("setting stack size for %s failed (%i)", wq->name, ret_setstacksize);
 			}
 
+			int policy = SCHED_FIFO;
+
+#if defined(__PX4_LINUX)
+			// optional per queue scheduling policy and CPU affinity (PX4_WQ_POLICY_<queue>, PX4_WQ_CPUS_<queue>)
+			WorkQueueConfigureThread(*wq, &attr, policy);
+#endif /* __PX4_LINUX */
+
 #ifndef __PX4_QURT
 
-			// schedule policy FIFO
-			int ret_setschedpolicy = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+			// schedule policy (FIFO by default)
+			int ret_setschedpolicy = pthread_attr_setschedpolicy(&attr, policy);
 
 			if (ret_setschedpolicy != 0) {
-				PX4_ERR("failed to set sched policy SCHED_FIFO (%i)", ret_setschedpolicy);
+				PX4_ERR("failed to set sched policy %d (%i)", policy, ret_setschedpolicy);
 			}
 
 #endif // ! QuRT
 
-			// priority
-			param.sched_priority = sched_get_priority_max(SCHED_FIFO) + wq->relative_priority;
+			// priority, relative to the maximum but not below the minimum (e.g. wq:navigator on Linux)
+			if (policy == SCHED_FIFO || policy == SCHED_RR) {
+				param.sched_priority = math::max(sched_get_priority_max(policy) + wq->relative_priority,
+							 sched_get_priority_min(policy));
+
+			} else {
+				param.sched_priority = 0;
+			}
+
 			int ret_setschedparam = pthread_attr_setschedparam(&attr, &param);
 
 			if (ret_setschedparam != 0) {
@@ -286,6 +473,17 @@ WorkQueueManagerRun(int, char **)
 			pthread_t thread;
 			int ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
 
+#if defined(__PX4_LINUX)
+
+			if (ret_create == EPERM) {
+				// not allowed to set a real-time policy (not running as root), inherit it instead
+				PX4_WARN("%s: no permission for real-time scheduling", wq->name);
+				pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+				ret_create = pthread_create(&thread, &attr, WorkQueueRunner, (void *)wq);
+			}
+
+#endif /* __PX4_LINUX */
+
 			if (ret_create == 0) {
 				PX4_DEBUG("starting: %s, priority: %d, stack: %zu bytes", wq->name, param.sched_priority, stacksize);
 
@@ -293,6 +491,22 @@ WorkQueueManagerRun(int, char **)
 				PX4_ERR("failed to create thread for %s (%i): %s", wq->name, ret_create, strerror(ret_create));
 			}
 
+#if defined(__PX4_POSIX)
+
+			// additional workers of the shared pool
+			if ((ret_create == 0) && (strcmp(wq->name, wq_configurations::pool.name) == 0)) {
+				for (int i = 1; i < _wq_pool_threads; i++) {
+					pthread_t helper;
+					int ret_helper = pthread_create(&helper, &attr, WorkQueueHelperRunner, (void *)wq);
+
+					if (ret_helper != 0) {
+						PX4_ERR("failed to create worker %d for %s (%i)", i, wq->name, ret_helper);
+					}
+				}
+			}
+
+#endif /* __PX4_POSIX */
+
 			// destroy thread attributes
 			int ret_destroy = pthread_attr_destroy(&attr);
 
@@ -310,6 +524,15 @@ WorkQueueManagerStart()
 {
 	if (_wq_manager_should_exit.load() && (_wq_manager_create_queue == nullptr)) {
 
+#if defined(__PX4_POSIX)
+		const char *pool_threads = getenv("PX4_WQ_POOL_THREADS");
+
+		if (pool_threads != nullptr) {
+			_wq_pool_threads = math::constrain(atoi(pool_threads), 0, (int)WorkQueue::MAX_WORKERS);
+		}
+
+#endif /* __PX4_POSIX */
+
 		_wq_manager_should_exit.store(false);
 
 		int task_id = px4_task_spawn_cmd("wq:manager",
@@ -390,7 +613,8 @@ WorkQueueManagerStatus()
 	if (!_wq_manager_should_exit.load() && (_wq_manager_wqs_list != nullptr)) {
 
 		const size_t num_wqs = _wq_manager_wqs_list->size();
-		PX4_INFO_RAW("\nWork Queue: %-1zu threads                        RATE        INTERVAL\n", num_wqs);
+		PX4_INFO_RAW("\nWork Queue: %-1zu threads                        RATE        INTERVAL      (PERIOD)"
+			     "   RUN AVG/MIN/MAX     WAIT AVG/MAX  OVERRUN\n", num_wqs);
 
 		LockGuard lg{_wq_manager_wqs_list->mutex()};
 		size_t i = 0;
@@ -417,4 +641,63 @@ WorkQueueManagerStatus()
 	return PX4_OK;
 }
 
+bool
+WorkQueueManagerInfo(unsigned index, wq_info_t &info)
+{
+	if (_wq_manager_should_exit.load() || (_wq_manager_wqs_list == nullptr)) {
+		return false;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+	unsigned i = 0;
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		if (i++ == index) {
+			info.name = wq->get_name();
+			wq->stack_usage(info.stack_size, info.stack_used_max);
+			info.num_items = wq->num_items();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int
+WorkQueueManagerItemsInfo(unsigned index, wq_item_info_t *items, unsigned max_items)
+{
+	if (_wq_manager_should_exit.load() || (_wq_manager_wqs_list == nullptr)) {
+		return -1;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+	unsigned i = 0;
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		if (i++ == index) {
+			return wq->items_info(items, max_items);
+		}
+	}
+
+	return -1;
+}
+
+bool
+WorkQueueManagerIdle()
+{
+	if (_wq_manager_should_exit.load() || (_wq_manager_wqs_list == nullptr)) {
+		return true;
+	}
+
+	LockGuard lg{_wq_manager_wqs_list->mutex()};
+
+	for (WorkQueue *wq : *_wq_manager_wqs_list) {
+		if (!wq->idle()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 } // namespace px4
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file irq_monitor.h
+ *
+ * Interrupt latency monitoring: longest interrupts disabled section (entered
+ * via px4_enter_critical_section()) with its call site, and per IRQ handler
+ * durations.
+ *
+ * Only available if the board is built with CONFIG_SCHED_CRITMONITOR or
+ * CONFIG_SCHED_IRQMONITOR, which provide the cycle counter time source.
+ * The per IRQ statistics additionally require CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER.
+ */
+
+#pragma once
+
+#include <nuttx/config.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(CONFIG_SCHED_CRITMONITOR) || defined(CONFIG_SCHED_IRQMONITOR)
+#  define PX4_IRQ_MONITOR 1
+#endif
+
+__BEGIN_DECLS
+
+struct irq_monitor_csection_s {
+	uint32_t count;      ///< number of (outermost) critical sections
+	uint32_t max_us;     ///< longest critical section
+	uintptr_t max_caller; ///< address of the px4_enter_critical_section() call of the longest section
+};
+
+struct irq_monitor_irq_s {
+	uint16_t irq;
+	uintptr_t handler;
+	uint32_t count;      ///< number of handler invocations
+	uint32_t max_us;     ///< longest handler duration
+	uint32_t avg_us;     ///< average handler duration
+};
+
+#if defined(PX4_IRQ_MONITOR)
+/**
+ * Instrumented enter_critical_section()/leave_critical_section(), used by
+ * px4_enter_critical_section()/px4_leave_critical_section() if enabled.
+ */
+__EXPORT irqstate_t px4_irqmon_enter_critical_section(void);
+__EXPORT void px4_irqmon_leave_critical_section(irqstate_t flags);
+
+/**
+ * Called by the scheduler instrumentation when a task is suspended.
+ */
+__EXPORT void px4_irqmon_task_suspend(FAR struct tcb_s *tcb);
+#endif
+
+/**
+ * Get the critical section statistics since boot or the last reset.
+ */
+__EXPORT void px4_irqmon_csection(struct irq_monitor_csection_s *stats);
+
+/**
+ * Get the statistics of the slowest IRQ handlers, sorted by decreasing maximum duration.
+ * @param stats array of at least max_irqs entries
+ * @return number of entries filled in
+ */
+__EXPORT int px4_irqmon_slowest_irqs(struct irq_monitor_irq_s *stats, int max_irqs);
+
+/**
+ * Reset all statistics.
+ */
+__EXPORT void px4_irqmon_reset(void);
+
+__END_DECLS
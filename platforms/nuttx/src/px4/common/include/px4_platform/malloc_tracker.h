@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file malloc_tracker.h
+ *
+ * Heap allocation tracker: counts the allocations of each task after boot and
+ * records the allocations done while the vehicle is armed, so that allocations
+ * in the hot path can be found and eliminated.
+ *
+ * Enabled with the MALLOC_TRACKER board option, which wraps malloc(), calloc(),
+ * realloc(), zalloc(), memalign(), free() and operator new at link time.
+ */
+
+#pragma once
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#define MALLOC_TRACKER_ARMED_ALLOCS 16 ///< number of recorded allocations while armed
+
+__BEGIN_DECLS
+
+struct malloc_tracker_task_s {
+	pid_t pid;
+	uint32_t allocs;       ///< number of allocations
+	uint32_t frees;        ///< number of frees (counted for the task calling free)
+	uint32_t failed;       ///< number of failed allocations
+	uint32_t armed_allocs; ///< number of allocations while armed
+	uint32_t max_size;     ///< largest allocation [bytes]
+	uint64_t bytes;        ///< total allocated [bytes]
+};
+
+struct malloc_tracker_alloc_s {
+	uint64_t timestamp;
+	pid_t pid;
+	uint32_t size;
+	uintptr_t caller;      ///< return address of the allocation call (inside the caller)
+};
+
+#if defined(PX4_MALLOC_TRACKER)
+/**
+ * Set the armed state. Allocations while armed are counted separately and the most recent ones are recorded.
+ */
+__EXPORT void px4_malloc_tracker_set_armed(bool armed);
+
+/**
+ * Get the statistics of all tasks that allocated or freed memory since boot or the last reset.
+ * @param tasks array of at least max_tasks entries
+ * @return number of entries filled in
+ */
+__EXPORT int px4_malloc_tracker_tasks(struct malloc_tracker_task_s *tasks, int max_tasks);
+
+/**
+ * Get the most recent allocations while armed, most recent first.
+ * @param allocs array of at least max_allocs entries
+ * @return number of entries filled in
+ */
+__EXPORT int px4_malloc_tracker_armed_allocs(struct malloc_tracker_alloc_s *allocs, int max_allocs);
+
+/**
+ * Get the total number of allocations while armed since boot or the last reset.
+ */
+__EXPORT uint32_t px4_malloc_tracker_armed_count(void);
+
+/**
+ * Reset all statistics.
+ */
+__EXPORT void px4_malloc_tracker_reset(void);
+#endif
+
+__END_DECLS
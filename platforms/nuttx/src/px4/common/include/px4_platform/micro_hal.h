@@ -32,6 +32,7 @@
  ****************************************************************************/
 #pragma once
 
+#include <px4_platform/irq_monitor.h>
 
 __BEGIN_DECLS
 
@@ -45,8 +46,13 @@ __BEGIN_DECLS
 #define PX4_BUS_NUMBER_TO_PX4(x)        ((x)+PX4_BUS_OFFSET)  /* Use to define Zero based to match Nuttx Driver but provide 1 based to PX4 */
 #define PX4_BUS_NUMBER_FROM_PX4(x)      ((x)-PX4_BUS_OFFSET)  /* Use to map PX4 1 based to NuttX driver 0 based */
 
+#if defined(PX4_IRQ_MONITOR)
+#define px4_enter_critical_section()       px4_irqmon_enter_critical_section()
+#define px4_leave_critical_section(flags)  px4_irqmon_leave_critical_section(flags)
+#else
 #define px4_enter_critical_section()       enter_critical_section()
 #define px4_leave_critical_section(flags)  leave_critical_section(flags)
+#endif
 
 #include <arch/board/board.h>
 
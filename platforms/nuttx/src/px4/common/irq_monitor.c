@@ -0,0 +1,247 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file irq_monitor.c
+ *
+ * Interrupt latency monitoring, see px4_platform/irq_monitor.h.
+ */
+
+#include <px4_platform/irq_monitor.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+
+#include <string.h>
+#include <time.h>
+
+#if defined(PX4_IRQ_MONITOR)
+
+/* the critical section that is currently being measured */
+static struct {
+	FAR struct tcb_s *tcb;
+	uint32_t depth;
+	uint32_t start;
+	uintptr_t caller;
+} g_csection_current;
+
+static struct {
+	uint32_t count;
+	uint32_t max;
+	uintptr_t max_caller;
+} g_csection;
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+static struct {
+	uintptr_t handler;
+	uint32_t start;
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+} g_irq[NR_IRQS];
+#endif
+
+static uint32_t cycles_to_us(uint32_t cycles)
+{
+	struct timespec ts;
+	up_critmon_convert(cycles, &ts);
+	return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+irqstate_t px4_irqmon_enter_critical_section(void)
+{
+	irqstate_t flags = enter_critical_section();
+	FAR void *caller = __builtin_return_address(0);
+	FAR struct tcb_s *tcb = sched_self();
+
+	if (g_csection_current.depth > 0 && g_csection_current.tcb == tcb) {
+		g_csection_current.depth++;
+
+	} else {
+		/* outermost section, or the previous owner was suspended inside its section
+		 * (interrupts got enabled by the context switch) and its measurement is discarded */
+		g_csection_current.tcb = tcb;
+		g_csection_current.depth = 1;
+		g_csection_current.caller = (uintptr_t)caller;
+		g_csection_current.start = up_critmon_gettime();
+	}
+
+	return flags;
+}
+
+void px4_irqmon_leave_critical_section(irqstate_t flags)
+{
+	if (g_csection_current.depth > 0 && g_csection_current.tcb == sched_self()) {
+		if (--g_csection_current.depth == 0) {
+			const uint32_t elapsed = up_critmon_gettime() - g_csection_current.start;
+			g_csection.count++;
+
+			if (elapsed > g_csection.max) {
+				g_csection.max = elapsed;
+				g_csection.max_caller = g_csection_current.caller;
+			}
+		}
+	}
+
+	leave_critical_section(flags);
+}
+
+void px4_irqmon_task_suspend(FAR struct tcb_s *tcb)
+{
+	/* a task blocking inside a critical section does not keep interrupts disabled */
+	if (g_csection_current.tcb == tcb) {
+		g_csection_current.tcb = NULL;
+		g_csection_current.depth = 0;
+	}
+}
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+void sched_note_irqhandler(int irq, FAR void *handler, bool enter)
+{
+	if (irq < 0 || irq >= NR_IRQS) {
+		return;
+	}
+
+	if (enter) {
+		g_irq[irq].handler = (uintptr_t)handler;
+		g_irq[irq].start = up_critmon_gettime();
+
+	} else {
+		const uint32_t elapsed = up_critmon_gettime() - g_irq[irq].start;
+		g_irq[irq].count++;
+		g_irq[irq].total += elapsed;
+
+		if (elapsed > g_irq[irq].max) {
+			g_irq[irq].max = elapsed;
+		}
+	}
+}
+#endif /* CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER */
+
+void px4_irqmon_csection(struct irq_monitor_csection_s *stats)
+{
+	irqstate_t flags = enter_critical_section();
+	const uint32_t max = g_csection.max;
+	stats->count = g_csection.count;
+	stats->max_caller = g_csection.max_caller;
+	leave_critical_section(flags);
+
+	stats->max_us = cycles_to_us(max);
+}
+
+int px4_irqmon_slowest_irqs(struct irq_monitor_irq_s *stats, int max_irqs)
+{
+	int num = 0;
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+	uint32_t max_cycles[max_irqs];
+
+	for (int irq = 0; irq < NR_IRQS; irq++) {
+		irqstate_t flags = enter_critical_section();
+		const uint32_t count = g_irq[irq].count;
+		const uint32_t max = g_irq[irq].max;
+		const uint64_t total = g_irq[irq].total;
+		const uintptr_t handler = g_irq[irq].handler;
+		leave_critical_section(flags);
+
+		if (count == 0 || (num == max_irqs && max <= max_cycles[num - 1])) {
+			continue;
+		}
+
+		/* insertion sort by decreasing max, dropping the last entry if full */
+		int i = (num < max_irqs) ? num++ : num - 1;
+
+		for (; i > 0 && max_cycles[i - 1] < max; i--) {
+			max_cycles[i] = max_cycles[i - 1];
+			stats[i] = stats[i - 1];
+		}
+
+		max_cycles[i] = max;
+		stats[i].irq = irq;
+		stats[i].handler = handler;
+		stats[i].count = count;
+		stats[i].max_us = max;
+		stats[i].avg_us = total / count;
+	}
+
+	/* convert after sorting, the conversion is comparatively expensive */
+	for (int i = 0; i < num; i++) {
+		stats[i].max_us = cycles_to_us(stats[i].max_us);
+		stats[i].avg_us = cycles_to_us(stats[i].avg_us);
+	}
+
+#endif /* CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER */
+
+	return num;
+}
+
+void px4_irqmon_reset(void)
+{
+	irqstate_t flags = enter_critical_section();
+	memset(&g_csection, 0, sizeof(g_csection));
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+
+	for (int irq = 0; irq < NR_IRQS; irq++) {
+		/* keep the start time of a handler that is currently running */
+		g_irq[irq].count = 0;
+		g_irq[irq].max = 0;
+		g_irq[irq].total = 0;
+	}
+
+#endif
+	leave_critical_section(flags);
+}
+
+#else
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+void sched_note_irqhandler(int irq, FAR void *handler, bool enter)
+{
+}
+#endif
+
+void px4_irqmon_csection(struct irq_monitor_csection_s *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+}
+
+int px4_irqmon_slowest_irqs(struct irq_monitor_irq_s *stats, int max_irqs)
+{
+	return 0;
+}
+
+void px4_irqmon_reset(void)
+{
+}
+
+#endif /* PX4_IRQ_MONITOR */
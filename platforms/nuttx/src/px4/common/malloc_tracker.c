@@ -0,0 +1,236 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file malloc_tracker.c
+ *
+ * Heap allocation tracker, see px4_platform/malloc_tracker.h.
+ *
+ * The allocation functions are wrapped with the linker's --wrap option, so that
+ * every call to malloc() from PX4, NuttX libc and libxx ends up here first.
+ */
+
+#include <px4_platform/malloc_tracker.h>
+
+#include <drivers/drv_hrt.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(PX4_MALLOC_TRACKER)
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t elem_size);
+void *__real_realloc(void *ptr, size_t size);
+void *__real_zalloc(size_t size);
+void *__real_memalign(size_t alignment, size_t size);
+void __real_free(void *ptr);
+
+/* statistics by pid hash (unique among the running tasks, like the NuttX pid hash table) */
+static struct malloc_tracker_task_s g_tasks[CONFIG_MAX_TASKS];
+
+static struct malloc_tracker_alloc_s g_armed_allocs[MALLOC_TRACKER_ARMED_ALLOCS];
+static uint32_t g_armed_count;
+static volatile bool g_armed;
+
+/* must be called within a critical section */
+static struct malloc_tracker_task_s *task_stats(pid_t pid)
+{
+	struct malloc_tracker_task_s *task = &g_tasks[pid % CONFIG_MAX_TASKS];
+
+	if (task->pid != pid) {
+		// the previous task with this hash exited
+		memset(task, 0, sizeof(*task));
+		task->pid = pid;
+	}
+
+	return task;
+}
+
+static void *track_alloc(void *ptr, size_t size, FAR void *caller)
+{
+	const pid_t pid = sched_self()->pid;
+
+	irqstate_t flags = enter_critical_section();
+
+	struct malloc_tracker_task_s *task = task_stats(pid);
+
+	if (ptr == NULL && size > 0) {
+		task->failed++;
+
+	} else {
+		task->allocs++;
+		task->bytes += size;
+
+		if (size > task->max_size) {
+			task->max_size = size;
+		}
+	}
+
+	if (g_armed) {
+		struct malloc_tracker_alloc_s *alloc = &g_armed_allocs[g_armed_count % MALLOC_TRACKER_ARMED_ALLOCS];
+		alloc->timestamp = hrt_absolute_time();
+		alloc->pid = pid;
+		alloc->size = size;
+		alloc->caller = (uintptr_t)caller;
+		g_armed_count++;
+		task->armed_allocs++;
+	}
+
+	leave_critical_section(flags);
+
+	return ptr;
+}
+
+void *__wrap_malloc(size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_malloc(size), size, caller);
+}
+
+void *__wrap_calloc(size_t n, size_t elem_size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_calloc(n, elem_size), n * elem_size, caller);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_realloc(ptr, size), size, caller);
+}
+
+void *__wrap_zalloc(size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_zalloc(size), size, caller);
+}
+
+void *__wrap_memalign(size_t alignment, size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_memalign(alignment, size), size, caller);
+}
+
+/* operator new(size_t) and operator new[](size_t), so that the caller is the code using new */
+void *__wrap__Znwj(size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_malloc(size), size, caller);
+}
+
+void *__wrap__Znaj(size_t size)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_malloc(size), size, caller);
+}
+
+/* nothrow variants */
+void *__wrap__ZnwjRKSt9nothrow_t(size_t size, const void *nothrow)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_malloc(size), size, caller);
+}
+
+void *__wrap__ZnajRKSt9nothrow_t(size_t size, const void *nothrow)
+{
+	FAR void *caller = __builtin_return_address(0);
+	return track_alloc(__real_malloc(size), size, caller);
+}
+
+void __wrap_free(void *ptr)
+{
+	if (ptr != NULL) {
+		const pid_t pid = sched_self()->pid;
+		irqstate_t flags = enter_critical_section();
+		task_stats(pid)->frees++;
+		leave_critical_section(flags);
+	}
+
+	__real_free(ptr);
+}
+
+void px4_malloc_tracker_set_armed(bool armed)
+{
+	g_armed = armed;
+}
+
+int px4_malloc_tracker_tasks(struct malloc_tracker_task_s *tasks, int max_tasks)
+{
+	int num_tasks = 0;
+
+	for (int i = 0; i < CONFIG_MAX_TASKS && num_tasks < max_tasks; i++) {
+		irqstate_t flags = enter_critical_section();
+
+		if (g_tasks[i].allocs > 0 || g_tasks[i].frees > 0 || g_tasks[i].failed > 0) {
+			tasks[num_tasks++] = g_tasks[i];
+		}
+
+		leave_critical_section(flags);
+	}
+
+	return num_tasks;
+}
+
+int px4_malloc_tracker_armed_allocs(struct malloc_tracker_alloc_s *allocs, int max_allocs)
+{
+	irqstate_t flags = enter_critical_section();
+
+	int num_allocs = 0;
+
+	while (num_allocs < max_allocs && num_allocs < MALLOC_TRACKER_ARMED_ALLOCS && (uint32_t)num_allocs < g_armed_count) {
+		allocs[num_allocs] = g_armed_allocs[(g_armed_count - 1 - num_allocs) % MALLOC_TRACKER_ARMED_ALLOCS];
+		num_allocs++;
+	}
+
+	leave_critical_section(flags);
+
+	return num_allocs;
+}
+
+uint32_t px4_malloc_tracker_armed_count(void)
+{
+	return g_armed_count;
+}
+
+void px4_malloc_tracker_reset(void)
+{
+	irqstate_t flags = enter_critical_section();
+	memset(g_tasks, 0, sizeof(g_tasks));
+	g_armed_count = 0;
+	leave_critical_section(flags);
+}
+
+#endif /* PX4_MALLOC_TRACKER */
@@ -38,8 +38,10 @@
 #else
 
 #include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/log.h>
 #include <px4_platform_common/micro_hal.h>
 #include <stm32_dma.h>
+#include <stm32_gpio.h>
 #include <stm32_tim.h>
 #include <px4_arch/dshot.h>
 #include <px4_arch/io_timer.h>
@@ -63,10 +65,36 @@
 #define DSHOT_DMA_SCR (DMA_SCR_PRIHI | DMA_SCR_MSIZE_32BITS | DMA_SCR_PSIZE_32BITS | DMA_SCR_MINC | \
 		       DMA_SCR_DIR_M2P | DMA_SCR_TCIE | DMA_SCR_HTIE | DMA_SCR_TEIE | DMA_SCR_DMEIE)
 
+/* Bidirectional DShot: after each frame the ESCs answer on the same line with a 21 bit GCR encoded eRPM frame,
+ * sent at 5/4 of the DShot bit rate about 30us after the end of the command frame. The lines of a timer are
+ * sampled as GPIO inputs, with the timer update DMA reading the input data register of their port. */
+#define BDSHOT_OVERSAMPLE			3u
+#define BDSHOT_REPLY_BITS			21u
+#define BDSHOT_REPLY_DELAY_US		30u
+#define BDSHOT_REPLY_MARGIN_BITS	8u
+#define BDSHOT_CAPTURE_SAMPLES_MAX	256u
+
+#define DSHOT_BIDIRECTIONAL_DMA_SCR (DMA_SCR_PRIHI | DMA_SCR_MSIZE_32BITS | DMA_SCR_PSIZE_32BITS | DMA_SCR_MINC | \
+				     DMA_SCR_DIR_M2P | DMA_SCR_TCIE | DMA_SCR_TEIE | DMA_SCR_DMEIE)
+
+#define BDSHOT_CAPTURE_DMA_SCR (DMA_SCR_PRIHI | DMA_SCR_MSIZE_16BITS | DMA_SCR_PSIZE_16BITS | DMA_SCR_MINC | \
+				DMA_SCR_DIR_P2M | DMA_SCR_TCIE | DMA_SCR_TEIE | DMA_SCR_DMEIE)
+
+typedef enum {
+	BDSHOT_IDLE = 0,
+	BDSHOT_OUTPUT,	// command frame being sent
+	BDSHOT_CAPTURE,	// sampling the replies
+	BDSHOT_CAPTURED,	// replies ready to be decoded
+} bdshot_state_t;
+
 typedef struct dshot_handler_t {
 	bool			init;
 	DMA_HANDLE		dma_handle;
 	uint32_t		dma_size;
+	bool			bidirectional;		// replies are captured on this timer
+	uint32_t		capture_port_base;	// GPIO port the replies are sampled from
+	volatile bdshot_state_t	bdshot_state;
+	uint32_t		capture_overruns;	// capture still ongoing when the next frame was due
 } dshot_handler_t;
 
 #define DMA_BUFFER_MASK    (PX4_ARCH_DCACHE_LINESIZE - 1)
@@ -75,17 +103,309 @@ typedef struct dshot_handler_t {
 
 static dshot_handler_t dshot_handler[DSHOT_TIMERS] = {};
 static uint16_t *motor_buffer = NULL;
-static uint8_t dshot_burst_buffer_array[DSHOT_TIMERS * DSHOT_BURST_BUFFER_SIZE(MAX_NUM_CHANNELS_PER_TIMER)]
+
+// The burst buffers are double buffered: a new frame is prepared in one while the DMA may still read the other.
+#define DSHOT_BURST_BUFFERS			2u
+static uint8_t dshot_burst_buffer_array[DSHOT_BURST_BUFFERS][DSHOT_TIMERS * DSHOT_BURST_BUFFER_SIZE(
+			MAX_NUM_CHANNELS_PER_TIMER)]
 __attribute__((aligned(PX4_ARCH_DCACHE_LINESIZE))); // DMA buffer
-static uint32_t *dshot_burst_buffer[DSHOT_TIMERS] = {};
+static uint32_t *dshot_burst_buffer[DSHOT_BURST_BUFFERS][DSHOT_TIMERS] = {};
+static uint8_t dshot_burst_buffer_index = 0; // buffer the next frame is prepared in
 
 #ifdef BOARD_DSHOT_MOTOR_ASSIGNMENT
 static const uint8_t motor_assignment[MOTORS_NUMBER] = BOARD_DSHOT_MOTOR_ASSIGNMENT;
 #endif /* BOARD_DSHOT_MOTOR_ASSIGNMENT */
 
-void dshot_dmar_data_prepare(uint8_t timer, uint8_t first_motor, uint8_t motors_number);
+static bool bdshot_enabled = false;
+static unsigned bdshot_dshot_freq = 0;		// [Hz]
+static unsigned bdshot_sample_rate = 0;		// [Hz]
+static unsigned bdshot_capture_samples = 0;
+static uint16_t bdshot_capture_buffer[DSHOT_TIMERS][BDSHOT_CAPTURE_SAMPLES_MAX]
+__attribute__((aligned(PX4_ARCH_DCACHE_LINESIZE))); // DMA buffer
+static uint16_t bdshot_pin_mask[MOTORS_NUMBER] = {};	// pin of each motor in the sampled port, 0 if not captured
+static int bdshot_erpm[MOTORS_NUMBER] = {};
+static uint8_t bdshot_erpm_updated[MOTORS_NUMBER] = {};
+static uint32_t bdshot_decode_errors[MOTORS_NUMBER] = {};
+
+static const uint8_t bdshot_gcr_decode[32] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x9, 0xa, 0xb, 0xff, 0xd, 0xe, 0xf,
+	0xff, 0xff, 0x2, 0x3, 0xff, 0x5, 0x6, 0x7, 0xff, 0x0, 0x8, 0x1, 0xff, 0x4, 0xc, 0xff
+};
+
+void dshot_dmar_data_prepare(uint32_t *buffer, uint8_t first_motor, uint8_t motors_number);
+
+static void bdshot_output_complete(DMA_HANDLE handle, uint8_t status, void *arg);
+static void bdshot_capture_complete(DMA_HANDLE handle, uint8_t status, void *arg);
+
+static inline bool bdshot_timer_supported(uint8_t timer)
+{
+#if defined(CONFIG_ARCH_CHIP_STM32H7)
+	return true;
+#else
+	// only DMA2 can access the GPIO ports on F4/F7
+	return io_timers[timer].dshot.dma_base == STM32_DMA2_BASE;
+#endif
+}
+
+static inline uint32_t bdshot_input_pinset(uint32_t gpio_out)
+{
+	return (gpio_out & (GPIO_PORT_MASK | GPIO_PIN_MASK)) | GPIO_INPUT | GPIO_PULLUP;
+}
+
+/* index in timer_io_channels of the timer channel the burst at position burst_index writes to */
+static int bdshot_channel_index(uint8_t timer, unsigned burst_index)
+{
+	uint32_t first_channel_index = io_timers_channel_mapping.element[timer].first_channel_index;
+	uint32_t last_channel_index = first_channel_index + io_timers_channel_mapping.element[timer].channel_count;
+	unsigned lowest_timer_channel = 4;
+
+	for (unsigned chan_index = first_channel_index; chan_index < last_channel_index; chan_index++) {
+		if (timer_io_channels[chan_index].timer_channel < lowest_timer_channel) {
+			lowest_timer_channel = timer_io_channels[chan_index].timer_channel;
+		}
+	}
+
+	for (unsigned chan_index = first_channel_index; chan_index < last_channel_index; chan_index++) {
+		if (timer_io_channels[chan_index].timer_channel == lowest_timer_channel + burst_index) {
+			return chan_index;
+		}
+	}
+
+	return -1;
+}
+
+static void bdshot_init(unsigned dshot_pwm_freq)
+{
+	// the replies are sent at 5/4 of the DShot rate
+	bdshot_dshot_freq = dshot_pwm_freq;
+	bdshot_sample_rate = dshot_pwm_freq * 5 / 4 * BDSHOT_OVERSAMPLE;
+	bdshot_capture_samples = BDSHOT_OVERSAMPLE * (BDSHOT_REPLY_BITS + BDSHOT_REPLY_MARGIN_BITS)
+				 + (uint64_t)bdshot_sample_rate * BDSHOT_REPLY_DELAY_US / 1000000;
+
+	if (bdshot_capture_samples > BDSHOT_CAPTURE_SAMPLES_MAX) {
+		bdshot_capture_samples = BDSHOT_CAPTURE_SAMPLES_MAX;
+	}
+
+	uint8_t first_motor = 0;
+
+	for (uint8_t timer = 0; timer < DSHOT_TIMERS; timer++) {
+		if (!dshot_handler[timer].init) {
+			continue;
+		}
+
+		uint8_t motors_number = io_timers_channel_mapping.element[timer].channel_count;
+		dshot_handler[timer].bidirectional = bdshot_timer_supported(timer);
+		dshot_handler[timer].bdshot_state = BDSHOT_IDLE;
+
+		if (dshot_handler[timer].bidirectional) {
+			// all lines of a timer are sampled with one read, so only the ones on the port of the first are captured
+			int first_index = bdshot_channel_index(timer, 0);
+			uint32_t port = (timer_io_channels[first_index].gpio_out & GPIO_PORT_MASK) >> GPIO_PORT_SHIFT;
+			dshot_handler[timer].capture_port_base = g_gpiobase[port];
+
+			for (uint8_t i = 0; i < motors_number; i++) {
+				int chan_index = bdshot_channel_index(timer, i);
+				uint32_t gpio = timer_io_channels[chan_index].gpio_out;
+
+				if (((gpio & GPIO_PORT_MASK) >> GPIO_PORT_SHIFT) == port) {
+					bdshot_pin_mask[first_motor + i] = 1 << ((gpio & GPIO_PIN_MASK) >> GPIO_PIN_SHIFT);
+				}
+			}
+
+			// bidirectional frames are inverted, the line idles high
+			io_timer_set_dshot_polarity(timer, true);
+		}
+
+		first_motor += motors_number;
+	}
+}
 
-int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq)
+/* Decode the reply of one motor from the sampled port data, returns the eRPM or -1 if the reply is invalid */
+static int bdshot_decode(const uint16_t *samples, unsigned count, uint16_t pin_mask)
+{
+	unsigned start = 0;
+
+	// the start bit is the first low sample
+	while (start < count && (samples[start] & pin_mask)) {
+		start++;
+	}
+
+	if (start >= count) {
+		return -1;
+	}
+
+	// each bit with a transition is a 1, the run lengths give the number of bits in between
+	uint32_t value = 0;
+	unsigned bits = 0;
+	bool level = false;
+	unsigned run_start = start;
+
+	for (unsigned i = start + 1; (i < count) && (bits < BDSHOT_REPLY_BITS); i++) {
+		bool sample_level = (samples[i] & pin_mask) != 0;
+
+		if (sample_level != level) {
+			unsigned len = (i - run_start + BDSHOT_OVERSAMPLE / 2) / BDSHOT_OVERSAMPLE;
+
+			if (len == 0) {
+				len = 1;
+			}
+
+			bits += len;
+			value = (value << len) | (1u << (len - 1));
+			level = sample_level;
+			run_start = i;
+		}
+	}
+
+	if (bits > BDSHOT_REPLY_BITS) {
+		return -1;
+	}
+
+	// the last run is high like the idle line, its length is inferred
+	if (bits < BDSHOT_REPLY_BITS) {
+		unsigned len = BDSHOT_REPLY_BITS - bits;
+		value = (value << len) | (1u << (len - 1));
+	}
+
+	// drop the start bit and decode 4 GCR quintets into 4 nibbles
+	uint32_t decoded = 0;
+
+	for (unsigned nibble = 0; nibble < 4; nibble++) {
+		uint8_t gcr = bdshot_gcr_decode[(value >> (5 * nibble)) & 0x1f];
+
+		if (gcr == 0xff) {
+			return -1;
+		}
+
+		decoded |= (uint32_t)gcr << (4 * nibble);
+	}
+
+	uint32_t checksum = decoded ^ (decoded >> 8);
+	checksum ^= checksum >> 4;
+
+	if ((checksum & 0xf) != 0xf) {
+		return -1;
+	}
+
+	decoded >>= 4;
+
+	if (decoded == 0x0fff) {
+		return 0; // motor stopped
+	}
+
+	// eeem mmmm mmmm: period in us = m << e
+	uint32_t period_us = (decoded & 0x1ff) << (decoded >> 9);
+
+	if (period_us == 0) {
+		return -1;
+	}
+
+	return (60000000 + period_us / 2) / period_us;
+}
+
+static void bdshot_process_captures(void)
+{
+	uint8_t first_motor = 0;
+
+	for (uint8_t timer = 0; timer < DSHOT_TIMERS; timer++) {
+		if (!dshot_handler[timer].init) {
+			continue;
+		}
+
+		uint8_t motors_number = io_timers_channel_mapping.element[timer].channel_count;
+
+		if (dshot_handler[timer].bidirectional) {
+			if (dshot_handler[timer].bdshot_state == BDSHOT_CAPTURED) {
+				up_invalidate_dcache((uintptr_t)bdshot_capture_buffer[timer],
+						     (uintptr_t)bdshot_capture_buffer[timer] + sizeof(bdshot_capture_buffer[timer]));
+
+				for (uint8_t i = 0; i < motors_number; i++) {
+					uint8_t motor = first_motor + i;
+
+					if (bdshot_pin_mask[motor] != 0) {
+						int erpm = bdshot_decode(bdshot_capture_buffer[timer], bdshot_capture_samples, bdshot_pin_mask[motor]);
+
+						if (erpm >= 0) {
+							bdshot_erpm[motor] = erpm;
+							bdshot_erpm_updated[motor] = 1;
+
+						} else {
+							++bdshot_decode_errors[motor];
+						}
+					}
+				}
+
+			} else if (dshot_handler[timer].bdshot_state != BDSHOT_IDLE) {
+				// no time for the reply, abort and get the lines back for the next frame
+				irqstate_t flags = px4_enter_critical_section();
+				stm32_dmastop(dshot_handler[timer].dma_handle);
+				io_timer_update_dma_req(timer, false);
+				bdshot_capture_complete(dshot_handler[timer].dma_handle, 0, (void *)(uintptr_t)timer);
+				px4_leave_critical_section(flags);
+				++dshot_handler[timer].capture_overruns;
+			}
+
+			dshot_handler[timer].bdshot_state = BDSHOT_IDLE;
+		}
+
+		first_motor += motors_number;
+	}
+}
+
+/* DMA callback (interrupt context): the command frame is out, release the lines and sample the replies */
+static void bdshot_output_complete(DMA_HANDLE handle, uint8_t status, void *arg)
+{
+	uint8_t timer = (uint8_t)(uintptr_t)arg;
+
+	stm32_dmastop(handle);
+	io_timer_update_dma_req(timer, false);
+
+	if ((status & DMA_STATUS_TCIF) == 0) {
+		dshot_handler[timer].bdshot_state = BDSHOT_IDLE;
+		return;
+	}
+
+	uint32_t first_channel_index = io_timers_channel_mapping.element[timer].first_channel_index;
+	uint32_t last_channel_index = first_channel_index + io_timers_channel_mapping.element[timer].channel_count;
+
+	for (unsigned chan_index = first_channel_index; chan_index < last_channel_index; chan_index++) {
+		px4_arch_configgpio(bdshot_input_pinset(timer_io_channels[chan_index].gpio_out));
+	}
+
+	io_timer_set_dshot_capture_mode(timer, bdshot_sample_rate);
+
+	px4_stm32_dmasetup(handle,
+			   dshot_handler[timer].capture_port_base + STM32_GPIO_IDR_OFFSET,
+			   (uint32_t)bdshot_capture_buffer[timer],
+			   bdshot_capture_samples,
+			   BDSHOT_CAPTURE_DMA_SCR);
+
+	dshot_handler[timer].bdshot_state = BDSHOT_CAPTURE;
+	stm32_dmastart(handle, bdshot_capture_complete, arg, false);
+	io_timer_update_dma_req(timer, true);
+}
+
+/* DMA callback (interrupt context): the replies are sampled, give the lines back to the timer */
+static void bdshot_capture_complete(DMA_HANDLE handle, uint8_t status, void *arg)
+{
+	uint8_t timer = (uint8_t)(uintptr_t)arg;
+
+	stm32_dmastop(handle);
+	io_timer_update_dma_req(timer, false);
+
+	io_timer_set_dshot_mode(timer, bdshot_dshot_freq, io_timers_channel_mapping.element[timer].channel_count);
+
+	uint32_t first_channel_index = io_timers_channel_mapping.element[timer].first_channel_index;
+	uint32_t last_channel_index = first_channel_index + io_timers_channel_mapping.element[timer].channel_count;
+
+	for (unsigned chan_index = first_channel_index; chan_index < last_channel_index; chan_index++) {
+		px4_arch_configgpio(timer_io_channels[chan_index].gpio_out);
+	}
+
+	dshot_handler[timer].bdshot_state = (status & DMA_STATUS_TCIF) ? BDSHOT_CAPTURED : BDSHOT_IDLE;
+}
+
+int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bidirectional_dshot)
 {
 	// Alloc buffers if they do not exist. We don't use channel_mask so that potential future re-init calls can
 	// use the same buffer.
@@ -104,13 +424,16 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq)
 			break;
 		}
 
-		// we know the uint8_t* cast to uint32_t* is fine, since we're aligned to cache line size
+		for (unsigned i = 0; i < DSHOT_BURST_BUFFERS; i++) {
+			// we know the uint8_t* cast to uint32_t* is fine, since we're aligned to cache line size
 #pragma GCC diagnostic ignored "-Wcast-align"
-		dshot_burst_buffer[timer] = (uint32_t *)&dshot_burst_buffer_array[buffer_offset];
+			dshot_burst_buffer[i][timer] = (uint32_t *)&dshot_burst_buffer_array[i][buffer_offset];
 #pragma GCC diagnostic pop
+		}
+
 		buffer_offset += DSHOT_BURST_BUFFER_SIZE(io_timers_channel_mapping.element[timer].channel_count);
 
-		if (buffer_offset > sizeof(dshot_burst_buffer_array)) {
+		if (buffer_offset > sizeof(dshot_burst_buffer_array[0])) {
 			return -EINVAL; // something is wrong with the board configuration or some other logic
 		}
 	}
@@ -155,46 +478,82 @@ int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq)
 		}
 	}
 
+	bdshot_enabled = enable_bidirectional_dshot && (OK == ret_val);
+
+	if (bdshot_enabled) {
+		bdshot_init(dshot_pwm_freq);
+	}
+
 	return ret_val;
 }
 
 void up_dshot_trigger(void)
 {
+	if (bdshot_enabled) {
+		// decode the replies to the previous frames
+		bdshot_process_captures();
+	}
+
+	uint32_t **buffers = dshot_burst_buffer[dshot_burst_buffer_index];
 	uint8_t first_motor = 0;
 
+	// Prepare the frames of all timers first. The previous frames are in the other buffer, so they are not
+	// corrupted in case their transfer is still ongoing.
 	for (uint8_t timer = 0; (timer < DSHOT_TIMERS); timer++) {
 
 		if (true == dshot_handler[timer].init) {
 
 			uint8_t motors_number = io_timers_channel_mapping.element[timer].channel_count;
-			dshot_dmar_data_prepare(timer, first_motor, motors_number);
+			dshot_dmar_data_prepare(buffers[timer], first_motor, motors_number);
 
 			// Flush cache so DMA sees the data
-			up_clean_dcache((uintptr_t)dshot_burst_buffer[timer],
-					(uintptr_t)dshot_burst_buffer[timer] + DSHOT_BURST_BUFFER_SIZE(motors_number));
+			up_clean_dcache((uintptr_t)buffers[timer],
+					(uintptr_t)buffers[timer] + DSHOT_BURST_BUFFER_SIZE(motors_number));
 
 			first_motor += motors_number;
+		}
+	}
+
+	// Then start all transfers back to back, so the frames of all timers start at the same instant
+	irqstate_t flags = px4_enter_critical_section();
+
+	for (uint8_t timer = 0; (timer < DSHOT_TIMERS); timer++) {
+
+		if (true == dshot_handler[timer].init) {
+
+			const bool bidirectional = bdshot_enabled && dshot_handler[timer].bidirectional;
 
 			px4_stm32_dmasetup(dshot_handler[timer].dma_handle,
 					   io_timers[timer].base + STM32_GTIM_DMAR_OFFSET,
-					   (uint32_t)(dshot_burst_buffer[timer]),
+					   (uint32_t)(buffers[timer]),
 					   dshot_handler[timer].dma_size,
-					   DSHOT_DMA_SCR);
+					   bidirectional ? DSHOT_BIDIRECTIONAL_DMA_SCR : DSHOT_DMA_SCR);
 
 			// Clean UDE flag before DMA is started
 			io_timer_update_dma_req(timer, false);
-			// Trigger DMA (DShot Outputs)
-			stm32_dmastart(dshot_handler[timer].dma_handle, NULL, NULL, false);
-			io_timer_update_dma_req(timer, true);
 
+			// Trigger DMA (DShot Outputs), with bidirectional DShot the replies are captured once it completes
+			if (bidirectional) {
+				dshot_handler[timer].bdshot_state = BDSHOT_OUTPUT;
+				stm32_dmastart(dshot_handler[timer].dma_handle, bdshot_output_complete, (void *)(uintptr_t)timer, false);
+
+			} else {
+				stm32_dmastart(dshot_handler[timer].dma_handle, NULL, NULL, false);
+			}
+
+			io_timer_update_dma_req(timer, true);
 		}
 	}
+
+	px4_leave_critical_section(flags);
+
+	dshot_burst_buffer_index = (dshot_burst_buffer_index + 1) % DSHOT_BURST_BUFFERS;
 }
 
 /**
 * bits 	1-11	- throttle value (0-47 are reserved, 48-2047 give 2000 steps of throttle resolution)
 * bit 	12		- dshot telemetry enable/disable
-* bits 	13-16	- XOR checksum
+* bits 	13-16	- XOR checksum (inverted for bidirectional DShot)
 **/
 static void dshot_motor_data_set(uint32_t motor_number, uint16_t throttle, bool telemetry)
 {
@@ -219,6 +578,10 @@ static void dshot_motor_data_set(uint32_t motor_number, uint16_t throttle, bool
 		csum_data >>= NIBBLES_SIZE;
 	}
 
+	if (bdshot_enabled) {
+		checksum = ~checksum;
+	}
+
 	packet |= (checksum & 0x0F);
 
 	for (i = 0; i < ONE_MOTOR_DATA_SIZE; i++) {
@@ -240,10 +603,8 @@ void up_dshot_motor_command(unsigned channel, uint16_t command, bool telemetry)
 	dshot_motor_data_set(channel, command, telemetry);
 }
 
-void dshot_dmar_data_prepare(uint8_t timer, uint8_t first_motor, uint8_t motors_number)
+void dshot_dmar_data_prepare(uint32_t *buffer, uint8_t first_motor, uint8_t motors_number)
 {
-	uint32_t *buffer = dshot_burst_buffer[timer];
-
 	for (uint32_t motor_data_index = 0; motor_data_index < ONE_MOTOR_BUFF_SIZE ; motor_data_index++) {
 		for (uint32_t motor_index = 0; motor_index < motors_number; motor_index++) {
 			buffer[motor_data_index * motors_number + motor_index] = motor_buffer[(motor_index +
@@ -252,6 +613,43 @@ void dshot_dmar_data_prepare(uint8_t timer, uint8_t first_motor, uint8_t motors_
 	}
 }
 
+int up_bdshot_get_erpm(uint8_t channel, int *erpm)
+{
+#ifdef BOARD_DSHOT_MOTOR_ASSIGNMENT
+	channel = motor_assignment[channel];
+#endif /* BOARD_DSHOT_MOTOR_ASSIGNMENT */
+
+	if (!bdshot_enabled || channel >= MOTORS_NUMBER || !bdshot_erpm_updated[channel]) {
+		return -1;
+	}
+
+	*erpm = bdshot_erpm[channel];
+	bdshot_erpm_updated[channel] = 0;
+	return 0;
+}
+
+void up_bdshot_status(void)
+{
+	if (!bdshot_enabled) {
+		return;
+	}
+
+	for (uint8_t timer = 0; timer < DSHOT_TIMERS; timer++) {
+		if (dshot_handler[timer].init) {
+			PX4_INFO("Timer %u: bidirectional %s, capture overruns: %u", timer,
+				 dshot_handler[timer].bidirectional ? "yes" : "no (DMA can't read GPIO)",
+				 (unsigned)dshot_handler[timer].capture_overruns);
+		}
+	}
+
+	for (unsigned motor = 0; motor < MOTORS_NUMBER; motor++) {
+		if (bdshot_pin_mask[motor] != 0) {
+			PX4_INFO("Motor %u: eRPM %i, decode errors: %u", motor, bdshot_erpm[motor],
+				 (unsigned)bdshot_decode_errors[motor]);
+		}
+	}
+}
+
 int up_dshot_arm(bool armed)
 {
 	return io_timer_set_enable(armed, IOTimerChanMode_Dshot, IO_TIMER_ALL_MODES_CHANNELS);
@@ -152,6 +152,8 @@ __EXPORT extern void io_timer_trigger(void);
 __EXPORT void io_timer_update_dma_req(uint8_t timer, bool enable);
 
 __EXPORT extern int io_timer_set_dshot_mode(uint8_t timer, unsigned dshot_pwm_rate, uint8_t dma_burst_length);
+__EXPORT extern int io_timer_set_dshot_capture_mode(uint8_t timer, unsigned sample_rate);
+__EXPORT extern void io_timer_set_dshot_polarity(uint8_t timer, bool inverted);
 
 /**
  * Returns the pin configuration for a specific channel, to be used as GPIO output.
@@ -596,6 +596,35 @@ int io_timer_set_dshot_mode(uint8_t timer, unsigned dshot_pwm_freq, uint8_t dma_
 	return ret_val;
 }
 
+int io_timer_set_dshot_capture_mode(uint8_t timer, unsigned sample_rate)
+{
+	// free running at the sample rate, every update event requests a DMA transfer
+	rPSC(timer) = 0;
+	rARR(timer) = (io_timers[timer].clock_freq / sample_rate) - 1;
+	rEGR(timer) = ATIM_EGR_UG;
+	return OK;
+}
+
+void io_timer_set_dshot_polarity(uint8_t timer, bool inverted)
+{
+	uint32_t first_channel_index = io_timers_channel_mapping.element[timer].first_channel_index;
+	uint32_t last_channel_index = first_channel_index + io_timers_channel_mapping.element[timer].channel_count;
+	uint32_t ccer = rCCER(timer);
+
+	for (unsigned chan_index = first_channel_index; chan_index < last_channel_index; chan_index++) {
+		uint32_t polarity = GTIM_CCER_CC1P << ((timer_io_channels[chan_index].timer_channel - 1) * CCER_C1_NUM_BITS);
+
+		if (inverted) {
+			ccer |= polarity;
+
+		} else {
+			ccer &= ~polarity;
+		}
+	}
+
+	rCCER(timer) = ccer;
+}
+
 static inline void io_timer_set_PWM_mode(unsigned timer)
 {
 	rPSC(timer) = (io_timers[timer].clock_freq / BOARD_PWM_FREQ) - 1;
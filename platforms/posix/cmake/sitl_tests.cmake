@@ -108,6 +108,24 @@ if(NOT CMAKE_SYSTEM_NAME STREQUAL "CYGWIN")
 	sanitizer_fail_test_on_error(shutdown)
 endif()
 
+# uORB shared memory export test, only in builds with the module (ORB_COMMUNICATOR)
+if(TARGET modules__muorb__shm)
+	add_test(NAME uorb_shm
+		COMMAND ${PX4_SOURCE_DIR}/Tools/sitl_run.sh
+			$<TARGET_FILE:px4>
+			none
+			none
+			test_uorb_shm
+			none
+			${PX4_SOURCE_DIR}
+			${PX4_BINARY_DIR}
+		WORKING_DIRECTORY ${SITL_WORKING_DIR})
+
+	set_tests_properties(uorb_shm PROPERTIES FAIL_REGULAR_EXPRESSION "uorb_shm FAILED")
+	set_tests_properties(uorb_shm PROPERTIES PASS_REGULAR_EXPRESSION "uorb_shm PASSED")
+	sanitizer_fail_test_on_error(uorb_shm)
+endif()
+
 # Dynamic module loading test
 add_test(NAME dyn
 	COMMAND ${PX4_SOURCE_DIR}/Tools/sitl_run.sh
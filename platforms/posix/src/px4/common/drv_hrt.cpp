@@ -583,4 +583,9 @@ int px4_pthread_cond_timedwait(pthread_cond_t *cond,
 	const uint64_t scheduled = time_us + px4_timestart_monotonic;
 	return lockstep_scheduler->cond_timedwait(cond, mutex, scheduled);
 }
+
+bool px4_lockstep_idle()
+{
+	return LockstepScheduler::idle();
+}
 #endif
@@ -17,6 +17,13 @@ public:
 	int cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *lock, uint64_t time_us);
 	int usleep_until(uint64_t timed_us);
 
+	/**
+	 * Check if all threads woken up by a time step are waiting again (or exited).
+	 * Together with idle work queues this means nothing is left to do at the current time.
+	 * The count is process-wide, there is a single scheduler per process.
+	 */
+	static bool idle() { return _pending_wakeups.load() == 0; }
+
 private:
 	struct TimedWait {
 		~TimedWait()
@@ -36,6 +43,12 @@ private:
 				done = true;
 			}
 
+			if (wakeup_pending) {
+				// the thread exits without waiting again
+				wakeup_pending = false;
+				--_pending_wakeups;
+			}
+
 			// If a thread quickly exits after a cond_timedwait(), the
 			// thread_local object can still be in the linked list. In that case
 			// we need to wait until it's removed.
@@ -50,13 +63,21 @@ private:
 		bool timeout{false};
 		std::atomic<bool> done{false};
 		std::atomic<bool> removed{true};
+		std::atomic<bool> wakeup_pending{false}; ///< woken up by a time step and not waiting again yet
 
 		TimedWait *next{nullptr}; ///< linked list
 	};
 
 	std::atomic<uint64_t> _time_us{0};
 
+	// Earliest deadline of all pending waits. A time step before it has nothing to wake up, so
+	// set_absolute_time() can skip locking and walking the list (unless there is cleanup to do).
+	std::atomic<uint64_t> _next_deadline_us{UINT64_MAX};
+	std::atomic<bool> _cleanup_pending{false}; ///< a wait returned and its list entry can be removed
+
 	TimedWait *_timed_waits{nullptr}; ///< head of linked list
 	std::mutex _timed_waits_mutex;
 	std::atomic<bool> _setting_time{false}; ///< true if set_absolute_time() is currently being executed
+
+	static std::atomic<int> _pending_wakeups; ///< number of threads woken up by a time step and not waiting again yet
 };
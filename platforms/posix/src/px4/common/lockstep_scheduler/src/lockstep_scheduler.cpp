@@ -1,5 +1,7 @@
 #include <lockstep_scheduler/lockstep_scheduler.h>
 
+std::atomic<int> LockstepScheduler::_pending_wakeups{0};
+
 LockstepScheduler::~LockstepScheduler()
 {
 	// cleanup the linked list
@@ -16,9 +18,19 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 {
 	_time_us = time_us;
 
+	// Fast path: nothing due and nothing to clean up. This makes small (or many consecutive)
+	// time steps cheap. cond_timedwait() lowers _next_deadline_us before it reads _time_us, so
+	// either we see the new deadline here, or the waiting thread sees the new time and returns.
+	if (time_us < _next_deadline_us && !_cleanup_pending) {
+		return;
+	}
+
 	{
 		std::unique_lock<std::mutex> lock_timed_waits(_timed_waits_mutex);
 		_setting_time = true;
+		_cleanup_pending = false;
+
+		uint64_t next_deadline_us = UINT64_MAX;
 
 		TimedWait *timed_wait = _timed_waits;
 		TimedWait *timed_wait_prev = nullptr;
@@ -46,14 +58,24 @@ void LockstepScheduler::set_absolute_time(uint64_t time_us)
 				// has passed.
 				pthread_mutex_lock(timed_wait->passed_lock);
 				timed_wait->timeout = true;
+
+				if (!timed_wait->wakeup_pending) {
+					timed_wait->wakeup_pending = true;
+					++_pending_wakeups;
+				}
+
 				pthread_cond_broadcast(timed_wait->passed_cond);
 				pthread_mutex_unlock(timed_wait->passed_lock);
+
+			} else if (!timed_wait->timeout && timed_wait->time_us < next_deadline_us) {
+				next_deadline_us = timed_wait->time_us;
 			}
 
 			timed_wait_prev = timed_wait;
 			timed_wait = timed_wait->next;
 		}
 
+		_next_deadline_us = next_deadline_us;
 		_setting_time = false;
 	}
 }
@@ -63,9 +85,20 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 	// A TimedWait object might still be in timed_waits_ after we return, so its lifetime needs to be
 	// longer. And using thread_local is more efficient than malloc.
 	static thread_local TimedWait timed_wait;
+
+	if (timed_wait.wakeup_pending) {
+		// done with whatever the last time step woke us up for
+		timed_wait.wakeup_pending = false;
+		--_pending_wakeups;
+	}
+
 	{
 		std::lock_guard<std::mutex> lock_timed_waits(_timed_waits_mutex);
 
+		if (time_us < _next_deadline_us) {
+			_next_deadline_us = time_us;
+		}
+
 		// The time has already passed.
 		if (time_us <= _time_us) {
 			return ETIMEDOUT;
@@ -94,6 +127,7 @@ int LockstepScheduler::cond_timedwait(pthread_cond_t *cond, pthread_mutex_t *loc
 	}
 
 	timed_wait.done = true;
+	_cleanup_pending = true;
 
 	if (!timeout && _setting_time) {
 		// This is where it gets tricky: the timeout has not been triggered yet,
@@ -87,6 +87,40 @@ void test_condition_timing_out()
 
 }
 
+void test_many_small_time_steps()
+{
+	pthread_cond_t cond;
+	pthread_cond_init(&cond, NULL);
+
+	pthread_mutex_t lock;
+	pthread_mutex_init(&lock, NULL);
+
+	LockstepScheduler ls;
+	ls.set_absolute_time(some_time_us);
+
+	std::atomic<bool> should_have_timed_out{false};
+	pthread_mutex_lock(&lock);
+
+	TestThread thread([&ls, &cond, &lock, &should_have_timed_out]() {
+		EXPECT_EQ(ls.cond_timedwait(&cond, &lock, some_time_us + 1000), ETIMEDOUT);
+		EXPECT_TRUE(should_have_timed_out);
+		EXPECT_EQ(pthread_mutex_unlock(&lock), 0);
+	});
+
+	// Step in small increments up to the deadline, none of them should wake the thread.
+	for (uint64_t t = some_time_us + 10; t < some_time_us + 1000; t += 10) {
+		ls.set_absolute_time(t);
+	}
+
+	should_have_timed_out = true;
+	ls.set_absolute_time(some_time_us + 1000);
+
+	thread.join(ls);
+
+	pthread_mutex_destroy(&lock);
+	pthread_cond_destroy(&cond);
+}
+
 void test_locked_semaphore_getting_unlocked()
 {
 	// Create locked condition.
@@ -307,14 +341,61 @@ void test_usleep()
 	thread.join(ls);
 }
 
+void test_idle()
+{
+	LockstepScheduler ls;
+	ls.set_absolute_time(some_time_us);
+
+	// the main thread might still count as woken up by a previous test, waiting (for a passed time) clears it
+	EXPECT_EQ(ls.usleep_until(some_time_us), 0);
+
+	std::atomic<bool> started{false};
+	std::atomic<bool> woken_up{false};
+	std::atomic<bool> wait_again{false};
+
+	TestThread thread([&ls, &started, &woken_up, &wait_again]() {
+		started = true;
+		EXPECT_EQ(ls.usleep_until(some_time_us + 1000), 0);
+		woken_up = true;
+
+		WAIT_FOR(wait_again);
+
+		// waiting again marks the wakeup as handled
+		EXPECT_EQ(ls.usleep_until(some_time_us + 2000), 0);
+	});
+
+	EXPECT_TRUE(LockstepScheduler::idle());
+
+	// give the thread time to start waiting, otherwise it returns without being woken up
+	WAIT_FOR(started);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	ls.set_absolute_time(some_time_us + 1000);
+	WAIT_FOR(woken_up);
+
+	// the thread is busy with what it was woken up for
+	EXPECT_FALSE(LockstepScheduler::idle());
+
+	wait_again = true;
+	WAIT_FOR(LockstepScheduler::idle());
+
+	ls.set_absolute_time(some_time_us + 2000);
+	thread.join(ls);
+
+	// the thread exited
+	EXPECT_TRUE(LockstepScheduler::idle());
+}
+
 TEST(LockstepScheduler, All)
 {
 	for (unsigned iteration = 1; iteration <= 100; ++iteration) {
 		//std::cout << "Test iteration: " << iteration << "\n";
 		test_absolute_time();
 		test_condition_timing_out();
+		test_many_small_time_steps();
 		test_locked_semaphore_getting_unlocked();
 		test_usleep();
 		test_multiple_semaphores_waiting();
+		test_idle();
 	}
 }
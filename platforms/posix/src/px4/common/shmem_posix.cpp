@@ -41,6 +41,7 @@
 #include <systemlib/err.h>
 #include <errno.h>
 #include <semaphore.h>
+#include <pthread.h>
 
 #include <sys/stat.h>
 
@@ -56,7 +57,14 @@
 //#define SHMEM_DEBUG
 
 static uint64_t update_from_shmem_prev_time = 0, update_from_shmem_current_time = 0;
-extern unsigned char *adsp_changed_index;
+extern unsigned char *param_updates_to_adsp;
+extern unsigned char *param_updates_from_adsp;
+
+static pthread_mutex_t param_updates_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* params changed by the adsp, with their values received in the last batches */
+static unsigned char adsp_changed_index[PARAM_BUFFER_SIZE];
+static union param_value_u adsp_changed_values[MAX_SHMEM_PARAMS];
 
 struct param_wbuf_s {
 	union param_value_u val;
@@ -64,29 +72,108 @@ struct param_wbuf_s {
 	bool unsaved;
 };
 
-/*update value and param's change bit in shared memory*/
-void update_to_shmem(param_t param, union param_value_u value)
+static void flush_updates_to_shmem_locked(void)
 {
-	if (px4muorb_param_update_to_shmem(param, (unsigned char *) &value, sizeof(value))) {
-		PX4_ERR("krait update param %u failed", param);
+	uint32_t count;
+	memcpy(&count, param_updates_to_adsp, sizeof(count));
+
+	if (count == 0) {
+		return;
 	}
+
+	if (px4muorb_param_update_batch_to_shmem(param_updates_to_adsp, PARAM_UPDATE_BUFFER_SIZE)) {
+		PX4_ERR("krait update of %u params failed", count);
+	}
+
+	count = 0;
+	memcpy(param_updates_to_adsp, &count, sizeof(count));
 }
 
-void update_index_from_shmem(void)
+/*queue the value update, it is sent with the next batch*/
+void update_to_shmem(param_t param, union param_value_u value)
 {
-	if (!adsp_changed_index) {
+	if (!param_updates_to_adsp) {
 		PX4_ERR("%s no param buffer", __FUNCTION__);
 		return;
 	}
 
-	px4muorb_param_update_index_from_shmem(adsp_changed_index, PARAM_BUFFER_SIZE);
+	pthread_mutex_lock(&param_updates_mutex);
+
+	uint32_t count;
+	memcpy(&count, param_updates_to_adsp, sizeof(count));
+	shmem_param_update *updates = (shmem_param_update *)(param_updates_to_adsp + sizeof(count));
+
+	uint32_t i = 0;
+
+	// a param set multiple times is only sent once
+	while (i < count && updates[i].param != param) {
+		i++;
+	}
+
+	if (i == PARAM_UPDATE_BATCH_SIZE) {
+		flush_updates_to_shmem_locked();
+		i = 0;
+		count = 0;
+	}
+
+	updates[i].param = param;
+	updates[i].value = value;
+
+	if (i == count) {
+		count++;
+		memcpy(param_updates_to_adsp, &count, sizeof(count));
+	}
+
+	pthread_mutex_unlock(&param_updates_mutex);
+}
+
+void flush_updates_to_shmem(void)
+{
+	if (!param_updates_to_adsp) {
+		return;
+	}
+
+	pthread_mutex_lock(&param_updates_mutex);
+	flush_updates_to_shmem_locked();
+	pthread_mutex_unlock(&param_updates_mutex);
 }
 
-static void update_value_from_shmem(param_t param, union param_value_u *value)
+void update_index_from_shmem(void)
 {
-	if (px4muorb_param_update_value_from_shmem(param, (unsigned char *) value, sizeof(union param_value_u))) {
-		PX4_ERR("%s get param failed", __FUNCTION__);
+	if (!param_updates_from_adsp) {
+		PX4_ERR("%s no param buffer", __FUNCTION__);
+		return;
 	}
+
+	// send our pending changes with the same sync
+	flush_updates_to_shmem();
+
+	pthread_mutex_lock(&param_updates_mutex);
+
+	uint32_t count;
+
+	// fetch the changes in batches until all are received
+	do {
+		if (px4muorb_param_update_values_from_shmem(param_updates_from_adsp, PARAM_UPDATE_BUFFER_SIZE)) {
+			PX4_ERR("%s get params failed", __FUNCTION__);
+			break;
+		}
+
+		memcpy(&count, param_updates_from_adsp, sizeof(count));
+		const shmem_param_update *updates = (const shmem_param_update *)(param_updates_from_adsp + sizeof(count));
+
+		for (uint32_t i = 0; i < count && i < PARAM_UPDATE_BATCH_SIZE; i++) {
+			const uint32_t param = updates[i].param;
+
+			if (param < MAX_SHMEM_PARAMS) {
+				adsp_changed_values[param] = updates[i].value;
+				adsp_changed_index[param / 8] |= 1 << param % 8;
+			}
+		}
+
+	} while (count == PARAM_UPDATE_BATCH_SIZE);
+
+	pthread_mutex_unlock(&param_updates_mutex);
 }
 
 int update_from_shmem(param_t param, union param_value_u *value)
@@ -94,8 +181,7 @@ int update_from_shmem(param_t param, union param_value_u *value)
 	unsigned int byte_changed, bit_changed;
 	unsigned int retval = 0;
 
-	if (!adsp_changed_index) {
-		PX4_ERR("%s no param buffer", __FUNCTION__);
+	if (param >= MAX_SHMEM_PARAMS) {
 		return 0;
 	}
 
@@ -110,13 +196,15 @@ int update_from_shmem(param_t param, union param_value_u *value)
 	byte_changed = param / 8;
 	bit_changed = 1 << param % 8;
 
+	pthread_mutex_lock(&param_updates_mutex);
+
 	if (adsp_changed_index[byte_changed] & bit_changed) {
-		update_value_from_shmem(param, value);
+		*value = adsp_changed_values[param];
 		adsp_changed_index[byte_changed] &= ~bit_changed; //clear the bit
 		retval = 1;
 	}
 
-	//else {PX4_INFO("no change to param %s", param_name(param));}
+	pthread_mutex_unlock(&param_updates_mutex);
 
 	PX4_DEBUG("%s %d bit on adsp index[%d]",
 		  (retval) ? "cleared" : "unchanged", bit_changed, byte_changed);
@@ -234,34 +234,27 @@ void update_to_shmem(param_t param, union param_value_u value)
 
 }
 
+void flush_updates_to_shmem(void)
+{
+	// update_to_shmem() writes directly to the shared memory
+}
+
 void update_index_from_shmem(void)
 {
 	unsigned int i;
-	param_t params[MAX_SHMEM_PARAMS / 8 + 1];
+	unsigned char changed[MAX_SHMEM_PARAMS / 8 + 1];
 
 	if (get_shmem_lock(__FILE__, __LINE__) != 0) {
 		PX4_ERR("Could not get shmem lock\n");
 		return;
 	}
 
+	// take over all change bits set by krait at once, the values are read without the lock
+	// in update_from_shmem(), krait writes them before setting the bits
 	for (i = 0; i < MAX_SHMEM_PARAMS / 8 + 1; i++) {
-		// Check if any param has been changed.
-		if (krait_changed_index[i] != shmem_info_p->krait_changed_index[i]) {
-
-			// If a param has changed, we need to find out which one.
-			// From the byte and bit that is different, we can resolve the param number.
-			unsigned bit = log2_for_int(
-					       krait_changed_index[i]
-					       ^ shmem_info_p->krait_changed_index[i]);
-			param_t param_to_get = i * 8 + bit;
-
-			// Update our krait_changed_index as well.
-			krait_changed_index[i] = shmem_info_p->krait_changed_index[i];
-			params[i] = param_to_get;
-
-		} else {
-			params[i] = 0xFFFF;
-		}
+		changed[i] = shmem_info_p->krait_changed_index[i];
+		krait_changed_index[i] |= changed[i];
+		shmem_info_p->krait_changed_index[i] = 0;
 	}
 
 	release_shmem_lock(__FILE__, __LINE__);
@@ -269,46 +262,16 @@ void update_index_from_shmem(void)
 	// FIXME: this is a hack but it gets the param so that it gets added
 	// to the local list param_values in param_shmem.c.
 	for (i = 0; i < MAX_SHMEM_PARAMS / 8 + 1; i++) {
-		if (params[i] != 0xFFFF) {
+		while (changed[i] != 0) {
+			const unsigned bit = log2_for_int(changed[i]);
+			changed[i] &= ~(1 << bit);
+
 			int32_t dummy;
-			param_get(params[i], &dummy);
+			param_get(i * 8 + bit, &dummy);
 		}
 	}
 }
 
-static void update_value_from_shmem(param_t param, union param_value_u *value)
-{
-	unsigned int byte_changed, bit_changed;
-
-	if (get_shmem_lock(__FILE__, __LINE__) != 0) {
-		PX4_ERR("Could not get shmem lock\n");
-		return;
-	}
-
-	*value = shmem_info_p->params_val[param];
-
-	/*also clear the index since we are holding the lock*/
-	byte_changed = param / 8;
-	bit_changed = 1 << param % 8;
-	shmem_info_p->krait_changed_index[byte_changed] &= ~bit_changed;
-
-	release_shmem_lock(__FILE__, __LINE__);
-
-#ifdef SHMEM_DEBUG
-
-	if (param_type(param) == PARAM_TYPE_INT32) {
-		PX4_INFO("Got value %d for param %s from shmem, cleared krait index %d:%d\n", value->i, param_name(param), byte_changed,
-			 bit_changed);
-	}
-
-	else if (param_type(param) == PARAM_TYPE_FLOAT) {
-		PX4_INFO("Got value %f for param %s from shmem, cleared krait index %d:%d\n", value->f, param_name(param), byte_changed,
-			 bit_changed);
-	}
-
-#endif
-}
-
 int update_from_shmem(param_t param, union param_value_u *value)
 {
 	unsigned int byte_changed, bit_changed;
@@ -330,7 +293,7 @@ int update_from_shmem(param_t param, union param_value_u *value)
 	bit_changed = 1 << param % 8;
 
 	if (krait_changed_index[byte_changed] & bit_changed) {
-		update_value_from_shmem(param, value);
+		*value = shmem_info_p->params_val[param];
 		krait_changed_index[byte_changed] &= ~bit_changed;
 		retval = 1;
 	}
@@ -48,13 +48,9 @@ namespace camera_capture
 CameraCapture *g_camera_capture{nullptr};
 }
 
-struct work_s CameraCapture::_work_publisher;
-
 CameraCapture::CameraCapture() :
 	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default)
 {
-	memset(&_work_publisher, 0, sizeof(_work_publisher));
-
 	// Capture Parameters
 	_p_strobe_delay = param_find("CAM_CAP_DELAY");
 	param_get(_p_strobe_delay, &_strobe_delay);
@@ -68,21 +64,20 @@ CameraCapture::CameraCapture() :
 
 CameraCapture::~CameraCapture()
 {
-	/* free any existing reports */
-	delete _trig_buffer;
-
 	camera_capture::g_camera_capture = nullptr;
 }
 
 void
 CameraCapture::capture_callback(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow)
 {
-	_trigger.chan_index = chan_index;
-	_trigger.edge_time = edge_time;
-	_trigger.edge_state = edge_state;
-	_trigger.overflow = overflow;
+	// interrupt context: the edge time is latched by the timer capture, only queue it here
+	const _trig_s trig{chan_index, edge_time, edge_state, overflow};
+
+	if (!_trig_buffer.put(trig)) {
+		_capture_dropped++;
+	}
 
-	work_queue(HPWORK, &_work_publisher, (worker_t)&CameraCapture::publish_trigger_trampoline, this, 0);
+	ScheduleNow();
 }
 
 int
@@ -90,26 +85,13 @@ CameraCapture::gpio_interrupt_routine(int irq, void *context, void *arg)
 {
 	CameraCapture *dev = static_cast<CameraCapture *>(arg);
 
-	dev->_trigger.chan_index = 0;
-	dev->_trigger.edge_time = hrt_absolute_time();
-	dev->_trigger.edge_state = 0;
-	dev->_trigger.overflow = 0;
-
-	work_queue(HPWORK, &_work_publisher, (worker_t)&CameraCapture::publish_trigger_trampoline, dev, 0);
+	dev->capture_callback(0, hrt_absolute_time(), 0, 0);
 
 	return PX4_OK;
 }
 
 void
-CameraCapture::publish_trigger_trampoline(void *arg)
-{
-	CameraCapture *dev = static_cast<CameraCapture *>(arg);
-
-	dev->publish_trigger();
-}
-
-void
-CameraCapture::publish_trigger()
+CameraCapture::publish_trigger(const _trig_s &trig)
 {
 	bool publish = false;
 
@@ -117,32 +99,32 @@ CameraCapture::publish_trigger()
 
 	// MODES 1 and 2 are not fully tested
 	if (_camera_capture_mode == 0 || _gpio_capture) {
-		trigger.timestamp = _trigger.edge_time - uint64_t(1000 * _strobe_delay);
+		trigger.timestamp = trig.edge_time - uint64_t(1000 * _strobe_delay);
 		trigger.seq = _capture_seq++;
 		_last_trig_time = trigger.timestamp;
 		publish = true;
 
 	} else if (_camera_capture_mode == 1) { // Get timestamp of mid-exposure (active high)
-		if (_trigger.edge_state == 1) {
-			_last_trig_begin_time = _trigger.edge_time - uint64_t(1000 * _strobe_delay);
+		if (trig.edge_state == 1) {
+			_last_trig_begin_time = trig.edge_time - uint64_t(1000 * _strobe_delay);
 
-		} else if (_trigger.edge_state == 0 && _last_trig_begin_time > 0) {
-			trigger.timestamp = _trigger.edge_time - ((_trigger.edge_time - _last_trig_begin_time) / 2);
+		} else if (trig.edge_state == 0 && _last_trig_begin_time > 0) {
+			trigger.timestamp = trig.edge_time - ((trig.edge_time - _last_trig_begin_time) / 2);
 			trigger.seq = _capture_seq++;
-			_last_exposure_time = _trigger.edge_time - _last_trig_begin_time;
+			_last_exposure_time = trig.edge_time - _last_trig_begin_time;
 			_last_trig_time = trigger.timestamp;
 			publish = true;
 			_capture_seq++;
 		}
 
 	} else { // Get timestamp of mid-exposure (active low)
-		if (_trigger.edge_state == 0) {
-			_last_trig_begin_time = _trigger.edge_time - uint64_t(1000 * _strobe_delay);
+		if (trig.edge_state == 0) {
+			_last_trig_begin_time = trig.edge_time - uint64_t(1000 * _strobe_delay);
 
-		} else if (_trigger.edge_state == 1 && _last_trig_begin_time > 0) {
-			trigger.timestamp = _trigger.edge_time - ((_trigger.edge_time - _last_trig_begin_time) / 2);
+		} else if (trig.edge_state == 1 && _last_trig_begin_time > 0) {
+			trigger.timestamp = trig.edge_time - ((trig.edge_time - _last_trig_begin_time) / 2);
 			trigger.seq = _capture_seq++;
-			_last_exposure_time = _trigger.edge_time - _last_trig_begin_time;
+			_last_exposure_time = trig.edge_time - _last_trig_begin_time;
 			_last_trig_time = trigger.timestamp;
 			publish = true;
 		}
@@ -150,7 +132,7 @@ CameraCapture::publish_trigger()
 	}
 
 	trigger.feedback = true;
-	_capture_overflows = _trigger.overflow;
+	_capture_overflows = trig.overflow;
 
 	if (!publish) {
 		return;
@@ -169,6 +151,13 @@ CameraCapture::capture_trampoline(void *context, uint32_t chan_index, hrt_abstim
 void
 CameraCapture::Run()
 {
+	// Publish all edges captured since the last run
+	_trig_s trig;
+
+	while (_trig_buffer.get(trig)) {
+		publish_trigger(trig);
+	}
+
 	// Command handling
 	vehicle_command_s cmd{};
 
@@ -291,18 +280,12 @@ CameraCapture::reset_statistics(bool reset_seq)
 	_last_exposure_time = 0;
 	_last_trig_time = 0;
 	_capture_overflows = 0;
+	_capture_dropped = 0;
 }
 
 int
 CameraCapture::start()
 {
-	/* allocate basic report buffers */
-	_trig_buffer = new ringbuffer::RingBuffer(2, sizeof(_trig_s));
-
-	if (_trig_buffer == nullptr) {
-		return PX4_ERROR;
-	}
-
 	// run every 100 ms (10 Hz)
 	ScheduleOnInterval(100000, 10000);
 
@@ -314,8 +297,6 @@ CameraCapture::stop()
 {
 	ScheduleClear();
 
-	work_cancel(HPWORK, &_work_publisher);
-
 	if (camera_capture::g_camera_capture != nullptr) {
 		delete (camera_capture::g_camera_capture);
 	}
@@ -333,6 +314,7 @@ CameraCapture::status()
 	}
 
 	PX4_INFO("Number of overflows : %u", _capture_overflows);
+	PX4_INFO("Number of dropped captures : %u", _capture_dropped);
 }
 
 static int usage()
@@ -38,7 +38,7 @@
 
 #pragma once
 
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SPSCRingBuffer.hpp>
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_input_capture.h>
 #include <drivers/drv_pwm_output.h>
@@ -47,7 +47,6 @@
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/tasks.h>
-#include <px4_platform_common/workqueue.h>
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
@@ -96,16 +95,11 @@ public:
 
 	void			reset_statistics(bool reset_seq);
 
-	void			publish_trigger();
-
-
-	static struct work_s	_work_publisher;
-
 private:
 
 	// Publishers
 	uORB::PublicationQueued<vehicle_command_ack_s>	_command_ack_pub{ORB_ID(vehicle_command_ack)};
-	uORB::Publication<camera_trigger_s>		_trigger_pub{ORB_ID(camera_trigger)};
+	uORB::PublicationQueued<camera_trigger_s>	_trigger_pub{ORB_ID(camera_trigger)};
 
 	// Subscribers
 	uORB::Subscription				_command_sub{ORB_ID(vehicle_command)};
@@ -116,9 +110,10 @@ private:
 		hrt_abstime edge_time;
 		uint32_t edge_state;
 		uint32_t overflow;
-	} _trigger{};
+	};
 
-	ringbuffer::RingBuffer	*_trig_buffer{nullptr};
+	// Captured edges, filled in interrupt context and published in batches from Run()
+	ringbuffer::SPSCRingBuffer<_trig_s, 16>	_trig_buffer;
 
 	bool			_capture_enabled{false};
 	bool			_gpio_capture{false};
@@ -137,6 +132,7 @@ private:
 	hrt_abstime		_last_exposure_time{0};
 	hrt_abstime		_last_trig_time{0};
 	uint32_t 		_capture_overflows{0};
+	uint32_t		_capture_dropped{0};	///< edges lost because the buffer was full
 
 	// Signal capture callback
 	void			capture_callback(uint32_t chan_index, hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
@@ -145,6 +141,6 @@ private:
 	static int		gpio_interrupt_routine(int irq, void *context, void *arg);
 
 	// Signal capture publish
-	static void		publish_trigger_trampoline(void *arg);
+	void			publish_trigger(const _trig_s &trig);
 
 };
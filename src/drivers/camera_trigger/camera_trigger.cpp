@@ -328,10 +328,10 @@ CameraTrigger::CameraTrigger() :
 	struct camera_trigger_s trigger = {};
 
 	if (!_cam_cap_fback) {
-		_trigger_pub = orb_advertise(ORB_ID(camera_trigger), &trigger);
+		_trigger_pub = orb_advertise_queue(ORB_ID(camera_trigger), &trigger, camera_trigger_s::ORB_QUEUE_LENGTH);
 
 	} else {
-		_trigger_pub = orb_advertise(ORB_ID(camera_trigger_secondary), &trigger);
+		_trigger_pub = orb_advertise_queue(ORB_ID(camera_trigger_secondary), &trigger, camera_trigger_s::ORB_QUEUE_LENGTH);
 	}
 }
 
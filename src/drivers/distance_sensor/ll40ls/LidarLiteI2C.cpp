@@ -216,46 +216,46 @@ LidarLiteI2C::measure()
 	return OK;
 }
 
-int
+void
 LidarLiteI2C::reset_sensor()
 {
-	px4_usleep(15000);
-
-	int ret = write_reg(LL40LS_SIG_COUNT_VAL_REG, LL40LS_SIG_COUNT_VAL_MAX);
-
-	if (ret != PX4_OK) {
-		return ret;
+	if (_reset_step == 0) {
+		_reset_step = 1;
 	}
+}
 
-	px4_usleep(15000);
-	ret = write_reg(LL40LS_MEASURE_REG, LL40LS_MSRREG_RESET);
-
+uint32_t
+LidarLiteI2C::reset_sensor_step()
+{
+	switch (_reset_step++) {
+	case 1:
+		if (write_reg(LL40LS_SIG_COUNT_VAL_REG, LL40LS_SIG_COUNT_VAL_MAX) == PX4_OK) {
+			return LL40LS_RESET_STEP_INTERVAL;
+		}
 
-	if (ret != PX4_OK) {
-		uint8_t sig_cnt;
+		break;
 
-		px4_usleep(15000);
-		ret = read_reg(LL40LS_SIG_COUNT_VAL_REG, sig_cnt);
+	case 2:
+		// the sensor does not always acknowledge the reset command, continue in any case
+		write_reg(LL40LS_MEASURE_REG, LL40LS_MSRREG_RESET);
 
-		if ((ret != PX4_OK) || (sig_cnt != LL40LS_SIG_COUNT_VAL_DEFAULT)) {
-			PX4_INFO("Error: ll40ls reset failure. Exiting!\n");
-			return ret;
+		// wait for sensor reset to complete
+		return 50_ms;
 
+	case 3:
+		if (write_reg(LL40LS_SIG_COUNT_VAL_REG, LL40LS_SIG_COUNT_VAL_MAX) == PX4_OK) {
+			// wait for register write to complete
+			return 1_ms;
 		}
-	}
 
-	// wait for sensor reset to complete
-	px4_usleep(50000);
-	ret = write_reg(LL40LS_SIG_COUNT_VAL_REG, LL40LS_SIG_COUNT_VAL_MAX);
+		break;
 
-	if (ret != PX4_OK) {
-		return ret;
+	default:
+		break;
 	}
 
-	// wait for register write to complete
-	px4_usleep(1000);
-
-	return OK;
+	_reset_step = 0;
+	return 0;
 }
 
 void
@@ -339,7 +339,8 @@ LidarLiteI2C::collect()
 			_zero_counter = 0;
 			perf_end(_sample_perf);
 			perf_count(_sensor_zero_resets);
-			return reset_sensor();
+			reset_sensor();
+			return OK;
 		}
 
 	} else {
@@ -460,6 +461,18 @@ void LidarLiteI2C::start()
 
 void LidarLiteI2C::RunImpl()
 {
+	if (_reset_step != 0) {
+		const uint32_t delay = reset_sensor_step();
+
+		if (delay > 0) {
+			ScheduleDelayed(delay);
+			return;
+		}
+
+		// reset done, start over with a new measurement
+		_collect_phase = false;
+	}
+
 	/* collection phase? */
 	if (_collect_phase) {
 
@@ -490,6 +503,12 @@ void LidarLiteI2C::RunImpl()
 		}
 	}
 
+	if (_reset_step != 0) {
+		/* a reset was requested, give the sensor time before the first step */
+		ScheduleDelayed(LL40LS_RESET_STEP_INTERVAL);
+		return;
+	}
+
 	if (_collect_phase == false) {
 		/* measurement phase */
 		if (OK != measure()) {
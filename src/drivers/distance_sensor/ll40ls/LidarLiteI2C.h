@@ -90,6 +90,9 @@ static constexpr uint32_t LL40LS_CONVERSION_INTERVAL{50_ms};
 // Maximum time to wait for a conversion to complete.
 static constexpr uint32_t LL40LS_CONVERSION_TIMEOUT{100_ms};
 
+// Wait time between the register writes of a sensor reset.
+static constexpr uint32_t LL40LS_RESET_STEP_INTERVAL{15_ms};
+
 
 class LidarLiteI2C : public device::I2C, public I2CSPIDriver<LidarLiteI2C>
 {
@@ -135,8 +138,16 @@ protected:
 
 	/**
 	 * Reset the sensor to power on defaults plus additional configurations.
+	 * The reset is only requested here and then done in steps by RunImpl(), so that
+	 * waiting for the sensor does not block the other drivers on the bus.
 	 */
-	int reset_sensor();
+	void reset_sensor();
+
+	/**
+	 * Run the next step of a requested sensor reset.
+	 * @return time to wait before the next step [us], 0 if the reset is done
+	 */
+	uint32_t reset_sensor_step();
 
 	int probe() override;
 
@@ -174,6 +185,8 @@ private:
 	bool _is_v3hp{false};
 	bool _pause_measurements{false};
 
+	uint8_t _reset_step{0};
+
 	uint8_t _hw_version{0};
 	uint8_t _sw_version{0};
 
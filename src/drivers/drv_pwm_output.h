@@ -428,9 +428,24 @@ __EXPORT extern servo_position_t up_pwm_servo_get(unsigned channel);
  *			This allows some of the channels to remain configured
  *			as GPIOs or as another function.
  * @param	dshot_pwm_freq is frequency of DSHOT signal. Usually DSHOT1200, DSHOT600, DSHOT300 or DSHOT150
+ * @param	enable_bidirectional_dshot send inverted frames and capture the eRPM replies on the signal lines
  * @return	OK on success.
  */
-__EXPORT extern int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq);
+__EXPORT extern int up_dshot_init(uint32_t channel_mask, unsigned dshot_pwm_freq, bool enable_bidirectional_dshot);
+
+/**
+ * Get the latest eRPM of a channel received with bidirectional DShot.
+ *
+ * @param channel	The channel (motor) to get.
+ * @param erpm		Electrical RPM of the motor.
+ * @return	0 if a new value was received since the last call, -1 otherwise.
+ */
+__EXPORT extern int up_bdshot_get_erpm(uint8_t channel, int *erpm);
+
+/**
+ * Print the bidirectional DShot status.
+ */
+__EXPORT extern void up_bdshot_status(void);
 
 /**
  * Set the current dshot throttle value for a channel (motor).
@@ -195,6 +195,14 @@ private:
 	void initTelemetry(const char *device);
 	void handleNewTelemetryData(int motor_index, const DShotTelemetry::EscData &data);
 
+	/**
+	 * Publish the motor RPMs received with bidirectional DShot, called after every output update
+	 */
+	void publishBidirectionalDShotRpm(unsigned num_outputs);
+
+	bool _bidirectional_dshot{false};
+	uORB::PublicationData<esc_status_s> _bidirectional_dshot_esc_status_pub{ORB_ID(esc_status)};
+
 	int requestESCInfo();
 
 	MixingOutput _mixing_output{DIRECT_PWM_OUTPUT_CHANNELS, *this, MixingOutput::SchedulingPolicy::Auto, false, false};
@@ -221,6 +229,7 @@ private:
 	bool		_outputs_initialized{false};
 
 	perf_counter_t	_cycle_perf;
+	perf_counter_t	_output_latency_perf; ///< updateOutputs() until the DMA transfers of all timers are started
 
 	void		capture_callback(uint32_t chan_index,
 					 hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
@@ -237,7 +246,8 @@ private:
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::DSHOT_CONFIG>) _param_dshot_config,
 		(ParamFloat<px4::params::DSHOT_MIN>) _param_dshot_min,
-		(ParamInt<px4::params::MOT_POLE_COUNT>) _param_mot_pole_count
+		(ParamInt<px4::params::MOT_POLE_COUNT>) _param_mot_pole_count,
+		(ParamBool<px4::params::DSHOT_BIDIR_EN>) _param_dshot_bidir_en
 	)
 };
 
@@ -247,7 +257,8 @@ px4::atomic_bool DShotOutput::_request_telemetry_init{false};
 DShotOutput::DShotOutput() :
 	CDev("/dev/dshot"),
 	OutputModuleInterface(MODULE_NAME, px4::wq_configurations::hp_default),
-	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
+	_output_latency_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": output latency"))
 {
 	_mixing_output.setAllDisarmedValues(DISARMED_VALUE);
 	_mixing_output.setAllMinValues(DISARMED_VALUE + 1);
@@ -264,6 +275,7 @@ DShotOutput::~DShotOutput()
 	unregister_class_devname(PWM_OUTPUT_BASE_DEVICE_PATH, _class_instance);
 
 	perf_free(_cycle_perf);
+	perf_free(_output_latency_perf);
 	delete _telemetry;
 }
 
@@ -530,7 +542,9 @@ DShotOutput::update_dshot_out_state(bool on)
 			break;
 		}
 
-		int ret = up_dshot_init(_output_mask, dshot_frequency);
+		_bidirectional_dshot = _param_dshot_bidir_en.get();
+
+		int ret = up_dshot_init(_output_mask, dshot_frequency, _bidirectional_dshot);
 
 		if (ret != 0) {
 			PX4_ERR("up_dshot_init failed (%i)", ret);
@@ -583,19 +597,27 @@ void DShotOutput::initTelemetry(const char *device)
 
 void DShotOutput::handleNewTelemetryData(int motor_index, const DShotTelemetry::EscData &data)
 {
-	// fill in new motor data
-	esc_status_s &esc_status = _telemetry->esc_status_pub.get();
+	// fill in new motor data, with bidirectional DShot the RPM comes with every frame and is published from there
+	esc_status_s &esc_status = _bidirectional_dshot ? _bidirectional_dshot_esc_status_pub.get() :
+				   _telemetry->esc_status_pub.get();
 
 	if (motor_index < esc_status_s::CONNECTED_ESC_MAX) {
-		esc_status.esc_online_flags |= 1 << motor_index;
-		esc_status.esc[motor_index].timestamp = data.time;
-		esc_status.esc[motor_index].esc_rpm = ((int)data.erpm * 100) / (_param_mot_pole_count.get() / 2);
+		if (!_bidirectional_dshot) {
+			esc_status.esc_online_flags |= 1 << motor_index;
+			esc_status.esc[motor_index].timestamp = data.time;
+			esc_status.esc[motor_index].esc_rpm = ((int)data.erpm * 100) / (_param_mot_pole_count.get() / 2);
+		}
+
 		esc_status.esc[motor_index].esc_voltage = (float)data.voltage * 0.01f;
 		esc_status.esc[motor_index].esc_current = (float)data.current * 0.01f;
 		esc_status.esc[motor_index].esc_temperature = data.temperature;
 		// TODO: accumulate consumption and use for battery estimation
 	}
 
+	if (_bidirectional_dshot) {
+		return;
+	}
+
 	// publish when motor index wraps (which is robust against motor timeouts)
 	if (motor_index <= _telemetry->last_motor_index) {
 		esc_status.timestamp = hrt_absolute_time();
@@ -616,6 +638,45 @@ void DShotOutput::handleNewTelemetryData(int motor_index, const DShotTelemetry::
 	_telemetry->last_motor_index = motor_index;
 }
 
+void DShotOutput::publishBidirectionalDShotRpm(unsigned num_outputs)
+{
+	esc_status_s &esc_status = _bidirectional_dshot_esc_status_pub.get();
+	const hrt_abstime now = hrt_absolute_time();
+	const unsigned esc_count = math::min(num_outputs, (unsigned)esc_status_s::CONNECTED_ESC_MAX);
+	uint8_t online_flags = 0;
+
+	for (unsigned channel = 0; channel < esc_count; channel++) {
+		int erpm;
+
+		if (up_bdshot_get_erpm(channel, &erpm) == 0) {
+			// the outputs can be reordered, the ESC index is the motor index
+			unsigned motor_index = channel;
+
+			for (unsigned i = 0; i < esc_count; i++) {
+				if (_mixing_output.reorderedMotorIndex(i) == (int)channel) {
+					motor_index = i;
+					break;
+				}
+			}
+
+			esc_status.esc[motor_index].timestamp = now;
+			esc_status.esc[motor_index].esc_rpm = erpm / (_param_mot_pole_count.get() / 2);
+			online_flags |= 1 << motor_index;
+		}
+	}
+
+	if (online_flags != 0) {
+		esc_status.timestamp = now;
+		esc_status.esc_connectiontype = esc_status_s::ESC_CONNECTION_TYPE_DSHOT;
+		esc_status.esc_count = esc_count;
+		esc_status.esc_online_flags = online_flags;
+		esc_status.esc_armed_flags = (1 << esc_count) - 1;
+		++esc_status.counter;
+
+		_bidirectional_dshot_esc_status_pub.update();
+	}
+}
+
 int DShotOutput::sendCommandThreadSafe(dshot_command_t command, int num_repetitions, int motor_index)
 {
 	Command cmd;
@@ -692,6 +753,8 @@ bool DShotOutput::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS
 		return false;
 	}
 
+	perf_begin(_output_latency_perf);
+
 	int requested_telemetry_index = -1;
 
 	if (_telemetry) {
@@ -738,6 +801,14 @@ bool DShotOutput::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS
 
 	if (stop_motors || num_control_groups_updated > 0) {
 		up_dshot_trigger();
+		perf_end(_output_latency_perf);
+
+		if (_bidirectional_dshot) {
+			publishBidirectionalDShotRpm(num_outputs);
+		}
+
+	} else {
+		perf_cancel(_output_latency_perf);
 	}
 
 	return true;
@@ -1587,8 +1658,13 @@ int DShotOutput::print_status()
 	PX4_INFO("Outputs initialized: %s", _outputs_initialized ? "yes" : "no");
 	PX4_INFO("Outputs on: %s", _outputs_on ? "yes" : "no");
 	perf_print_counter(_cycle_perf);
+	perf_print_counter(_output_latency_perf);
 	_mixing_output.printStatus();
 
+	if (_bidirectional_dshot) {
+		up_bdshot_status();
+	}
+
 	if (_telemetry) {
 		PX4_INFO("telemetry on: %s", _telemetry_device);
 		_telemetry->handler.printStatus();
@@ -63,6 +63,7 @@
 #include "devices/src/emlid_reach.h"
 #include "devices/src/mtk.h"
 #include "devices/src/ubx.h"
+#include "rtcm_frame_buffer.h"
 
 #ifdef __PX4_LINUX
 #include <linux/spi/spidev.h>
@@ -70,6 +71,7 @@
 
 #define TIMEOUT_5HZ 500
 #define RATE_MEASUREMENT_PERIOD 5000000
+#define RTCM_FRAME_TIMEOUT 500000 ///< give up on an incomplete RTCM frame after this time (us)
 
 typedef enum {
 	GPS_DRIVER_MODE_NONE = 0,
@@ -162,12 +164,16 @@ private:
 	vehicle_gps_position_s		_report_gps_pos{};				///< uORB topic for gps position
 	satellite_info_s		*_p_report_sat_info{nullptr};			///< pointer to uORB topic for satellite info
 
-	uORB::PublicationMulti<vehicle_gps_position_s>	_report_gps_pos_pub{ORB_ID(vehicle_gps_position)};	///< uORB pub for gps position
+	uORB::PublicationMulti<vehicle_gps_position_s>	_report_gps_pos_pub{ORB_ID(sensor_gps)};	///< uORB pub for gps position
 	uORB::PublicationMulti<satellite_info_s>	_report_sat_info_pub{ORB_ID(satellite_info)};		///< uORB pub for satellite info
 
 	float				_rate{0.0f};					///< position update rate
 	float				_rate_rtcm_injection{0.0f};			///< RTCM message injection rate
-	unsigned			_last_rate_rtcm_injection_count{0}; 		///< counter for number of RTCM messages
+	unsigned			_last_rate_rtcm_injection_count{0}; 		///< counter for number of RTCM frames
+
+	RTCMFrameBuffer			_rtcm_buffer;					///< reassembles the injected fragments into RTCM frames
+	uint8_t				_rtcm_frame[RTCMFrameBuffer::MAX_FRAME_LENGTH];	///< frame to be written to the device
+	hrt_abstime			_rtcm_pending_since{0};				///< time since when an incomplete frame is buffered
 
 	const bool			_fake_gps;					///< fake gps output
 
@@ -375,27 +381,32 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 			/*
 			 * We are here because poll says there is some data, so this
 			 * won't block even on a blocking device. But don't read immediately
-			 * by 1-2 bytes, wait for some more data to save expensive read() calls.
+			 * by 1-2 bytes, wait for some more data to save expensive read() calls
+			 * and to hand the parser larger batches (with RX DMA the bytes arrive
+			 * in chunks anyway). Wait until the requested number of bytes should
+			 * be available, but at most max_wait_us to bound the latency.
 			 * If we have all requested data available, read it without waiting.
 			 * If more bytes are available, we'll go back to poll() again.
 			 */
-			const unsigned character_count = 32; // minimum bytes that we want to read
-			unsigned baudrate = _baudrate == 0 ? 115200 : _baudrate;
-			const unsigned sleeptime = character_count * 1000000 / (baudrate / 10);
+			const unsigned min_character_count = 32; // minimum bytes that we want to read
+			const unsigned max_wait_us = 5000;
+			const unsigned baudrate = _baudrate == 0 ? 115200 : _baudrate;
+			const unsigned character_count = math::max((unsigned)buf_length, min_character_count);
+			int bytes_available = 0;
 
 #ifdef __PX4_NUTTX
-			int err = 0;
-			int bytes_available = 0;
-			err = ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available);
 
-			if (err != 0 || bytes_available < (int)character_count) {
-				px4_usleep(sleeptime);
+			if (ioctl(_serial_fd, FIONREAD, (unsigned long)&bytes_available) != 0) {
+				bytes_available = 0;
 			}
 
-#else
-			px4_usleep(sleeptime);
 #endif
 
+			if (bytes_available < (int)character_count) {
+				const unsigned sleeptime = (character_count - bytes_available) * 1000000 / (baudrate / 10);
+				px4_usleep(math::min(sleeptime, max_wait_us));
+			}
+
 			ret = ::read(_serial_fd, buf, buf_length);
 
 		} else {
@@ -415,34 +426,46 @@ int GPS::pollOrRead(uint8_t *buf, size_t buf_length, int timeout)
 
 void GPS::handleInjectDataTopic()
 {
-	bool updated = false;
+	// Drain the whole queue into the frame buffer, so that a burst of corrections (usually 1-4 RTCM
+	// messages for GPS, Glonass, BeiDou, Galileo, each split into up to 4 fragments) is not
+	// overwritten in the uORB queue while we wait for the device.
+	gps_inject_data_s msg;
+
+	for (unsigned i = 0; i < gps_inject_data_s::ORB_QUEUE_LENGTH; i++) {
+		if (!_orb_inject_data_sub.update(&msg)) {
+			break;
+		}
 
-	// Limit maximum number of GPS injections to 6 since usually
-	// GPS injections should consist of 1-4 packets (GPS, Glonass, BeiDou, Galileo).
-	// Looking at 6 packets thus guarantees, that at least a full injection
-	// data set is evaluated.
-	const size_t max_num_injections = 6;
-	size_t num_injections = 0;
+		_rtcm_buffer.push(msg.data, msg.len);
+	}
 
-	do {
-		num_injections++;
-		updated = _orb_inject_data_sub.updated();
+	if (_rtcm_buffer.available() == 0) {
+		_rtcm_pending_since = 0;
+		return;
+	}
 
-		if (updated) {
-			gps_inject_data_s msg;
+	/* Write each complete frame with a single write, instead of one write per fragment.
+	 * As we don't write anywhere else to the device during operation, the frames are
+	 * not interleaved with other data.
+	 */
+	size_t frame_length;
 
-			if (_orb_inject_data_sub.copy(&msg)) {
+	while ((frame_length = _rtcm_buffer.nextFrame(_rtcm_frame, sizeof(_rtcm_frame))) > 0) {
+		injectData(_rtcm_frame, frame_length);
+		++_last_rate_rtcm_injection_count;
+		_rtcm_pending_since = 0;
+	}
 
-				/* Write the message to the gps device. Note that the message could be fragmented.
-				 * But as we don't write anywhere else to the device during operation, we don't
-				 * need to assemble the message first.
-				 */
-				injectData(msg.data, msg.len);
+	if (_rtcm_buffer.available() > 0) {
+		if (_rtcm_pending_since == 0) {
+			_rtcm_pending_since = hrt_absolute_time();
 
-				++_last_rate_rtcm_injection_count;
-			}
+		} else if (hrt_elapsed_time(&_rtcm_pending_since) > RTCM_FRAME_TIMEOUT) {
+			// the rest of the frame is not going to arrive (lost fragment)
+			_rtcm_buffer.resync();
+			_rtcm_pending_since = 0;
 		}
-	} while (updated && num_injections < max_num_injections);
+	}
 }
 
 bool GPS::injectData(uint8_t *data, size_t len)
@@ -895,6 +918,8 @@ GPS::print_status()
 		if (!_fake_gps) {
 			PX4_INFO("rate publication:\t\t%6.2f Hz", (double)_rate);
 			PX4_INFO("rate RTCM injection:\t%6.2f Hz", (double)_rate_rtcm_injection);
+			PX4_INFO("RTCM frames: %u, CRC errors: %u, dropped bytes: %u", (unsigned)_rtcm_buffer.frames(),
+				 (unsigned)_rtcm_buffer.crcErrors(), (unsigned)_rtcm_buffer.droppedBytes());
 		}
 
 		print_message(_report_gps_pos);
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file rtcm_frame_buffer.cpp
+ */
+
+#include "rtcm_frame_buffer.h"
+
+#include <string.h>
+
+static constexpr uint8_t RTCM3_PREAMBLE = 0xD3;
+
+size_t RTCMFrameBuffer::push(const uint8_t *data, size_t len)
+{
+	size_t dropped = 0;
+
+	if (len >= BUFFER_SIZE) {
+		// more new data than fits: keep only the newest part
+		dropped = available() + len - (BUFFER_SIZE - 1);
+		data += len - (BUFFER_SIZE - 1);
+		len = BUFFER_SIZE - 1;
+		reset();
+
+	} else {
+		// keep one slot free to distinguish full from empty
+		const size_t space = BUFFER_SIZE - 1 - available();
+
+		if (len > space) {
+			dropped = len - space;
+			drop(dropped);
+		}
+	}
+
+	_dropped_bytes += dropped;
+
+	// copy in at most two chunks (wrap around)
+	const size_t first = (len < BUFFER_SIZE - _head) ? len : BUFFER_SIZE - _head;
+	memcpy(&_buffer[_head], data, first);
+	memcpy(&_buffer[0], data + first, len - first);
+	_head = (_head + len) & (BUFFER_SIZE - 1);
+
+	return dropped;
+}
+
+size_t RTCMFrameBuffer::nextFrame(uint8_t *frame, size_t max_len)
+{
+	while (available() >= HEADER_LENGTH) {
+		// resync on the preamble, the 6 bits following it are reserved and 0
+		if (peek(0) != RTCM3_PREAMBLE || (peek(1) & 0xFC) != 0) {
+			drop(1);
+			_dropped_bytes++;
+			continue;
+		}
+
+		const size_t payload_length = ((size_t)(peek(1) & 0x03) << 8) | peek(2);
+		const size_t frame_length = HEADER_LENGTH + payload_length + CRC_LENGTH;
+
+		if (frame_length > max_len) {
+			drop(1);
+			_dropped_bytes++;
+			continue;
+		}
+
+		if (available() < frame_length) {
+			// wait for the remaining fragments
+			return 0;
+		}
+
+		for (size_t i = 0; i < frame_length; i++) {
+			frame[i] = peek(i);
+		}
+
+		const uint32_t crc = ((uint32_t)frame[frame_length - 3] << 16) | ((uint32_t)frame[frame_length - 2] << 8)
+				     | frame[frame_length - 1];
+
+		if (crc24q(frame, frame_length - CRC_LENGTH) != crc) {
+			// not a frame (or a frame missing a fragment), skip the preamble and resync
+			_crc_errors++;
+			drop(1);
+			_dropped_bytes++;
+			continue;
+		}
+
+		drop(frame_length);
+		_frames++;
+		return frame_length;
+	}
+
+	return 0;
+}
+
+void RTCMFrameBuffer::resync()
+{
+	if (available() > 0) {
+		drop(1);
+		_dropped_bytes++;
+	}
+}
+
+void RTCMFrameBuffer::drop(size_t len)
+{
+	_tail = (_tail + len) & (BUFFER_SIZE - 1);
+}
+
+uint32_t RTCMFrameBuffer::crc24q(const uint8_t *data, size_t len)
+{
+	uint32_t crc = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= (uint32_t)data[i] << 16;
+
+		for (int bit = 0; bit < 8; bit++) {
+			crc <<= 1;
+
+			if (crc & 0x1000000) {
+				crc ^= 0x1864CFB;
+			}
+		}
+	}
+
+	return crc & 0xFFFFFF;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file rtcm_frame_buffer.h
+ * Byte ring buffer reassembling a fragmented RTCM3 injection stream into complete frames
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class RTCMFrameBuffer
+{
+public:
+	/// RTCM3 frame: preamble, 10 bit length and 6 reserved bits, up to 1023 bytes payload, 24 bit CRC
+	static constexpr size_t HEADER_LENGTH = 3;
+	static constexpr size_t CRC_LENGTH = 3;
+	static constexpr size_t MAX_FRAME_LENGTH = HEADER_LENGTH + 1023 + CRC_LENGTH;
+
+	RTCMFrameBuffer() = default;
+	~RTCMFrameBuffer() = default;
+
+	/**
+	 * Append received (possibly fragmented) stream data.
+	 * If the buffer is full, the oldest data is dropped.
+	 * @return number of bytes that had to be dropped
+	 */
+	size_t push(const uint8_t *data, size_t len);
+
+	/**
+	 * Extract the next complete frame with a valid CRC. Data in front of the frame
+	 * (garbage or the remainder of a frame with a lost fragment) is discarded.
+	 * @param frame output buffer, should be at least MAX_FRAME_LENGTH bytes
+	 * @param max_len size of the output buffer
+	 * @return frame length, 0 if no complete frame is available yet
+	 */
+	size_t nextFrame(uint8_t *frame, size_t max_len);
+
+	/**
+	 * Give up on the frame at the front of the buffer (e.g. it is incomplete for too long because
+	 * a fragment got lost) so that the following frames can be extracted.
+	 */
+	void resync();
+
+	void reset() { _head = _tail = 0; }
+
+	size_t available() const { return (_head - _tail) & (BUFFER_SIZE - 1); }
+
+	uint32_t frames() const { return _frames; }
+	uint32_t crcErrors() const { return _crc_errors; }
+	uint32_t droppedBytes() const { return _dropped_bytes; }
+
+private:
+	static constexpr size_t BUFFER_SIZE = 2048; ///< must be a power of 2 and hold at least one maximum size frame
+
+	static uint32_t crc24q(const uint8_t *data, size_t len);
+
+	uint8_t peek(size_t offset) const { return _buffer[(_tail + offset) & (BUFFER_SIZE - 1)]; }
+	void drop(size_t len);
+
+	uint8_t _buffer[BUFFER_SIZE];
+	size_t _head{0};
+	size_t _tail{0};
+
+	uint32_t _frames{0};
+	uint32_t _crc_errors{0};
+	uint32_t _dropped_bytes{0};
+};
@@ -273,11 +273,8 @@ ADIS16477::write_reg16(uint8_t reg, uint16_t value)
 void
 ADIS16477::start()
 {
-	if (_drdy_gpio != 0) {
-		// Setup data ready on rising edge
-		px4_arch_gpiosetevent(_drdy_gpio, true, false, true, &ADIS16477::data_ready_interrupt, this);
-
-	} else {
+	// Setup data ready on rising edge
+	if (!DataReadyInterruptConfigure(_drdy_gpio, true, false)) {
 		// start polling at the specified rate
 		ScheduleOnInterval((1_s / ADIS16477_DEFAULT_RATE), 10000);
 	}
@@ -286,25 +283,12 @@ ADIS16477::start()
 void
 ADIS16477::exit_and_cleanup()
 {
-	if (_drdy_gpio != 0) {
-		// Disable data ready callback
-		px4_arch_gpiosetevent(_drdy_gpio, false, false, false, nullptr, nullptr);
-	}
+	// Disable data ready callback
+	DataReadyInterruptDisable();
 
 	I2CSPIDriverBase::exit_and_cleanup();
 }
 
-int
-ADIS16477::data_ready_interrupt(int irq, void *context, void *arg)
-{
-	ADIS16477 *dev = static_cast<ADIS16477 *>(arg);
-
-	// make another measurement
-	dev->ScheduleNow();
-
-	return PX4_OK;
-}
-
 void
 ADIS16477::RunImpl()
 {
@@ -379,11 +379,8 @@ ADIS16497::write_reg16(uint8_t reg, uint16_t value)
 void
 ADIS16497::start()
 {
-	if (_drdy_gpio != 0) {
-		// Setup data ready on rising edge
-		px4_arch_gpiosetevent(_drdy_gpio, true, false, true, &ADIS16497::data_ready_interrupt, this);
-
-	} else {
+	// Setup data ready on rising edge
+	if (!DataReadyInterruptConfigure(_drdy_gpio, true, false)) {
 		// start polling at the specified rate
 		ScheduleOnInterval((1_s / ADIS16497_DEFAULT_RATE), 10000);
 	}
@@ -392,25 +389,12 @@ ADIS16497::start()
 void
 ADIS16497::exit_and_cleanup()
 {
-	if (_drdy_gpio != 0) {
-		// Disable data ready callback
-		px4_arch_gpiosetevent(_drdy_gpio, false, false, false, nullptr, nullptr);
-	}
+	// Disable data ready callback
+	DataReadyInterruptDisable();
 
 	I2CSPIDriverBase::exit_and_cleanup();
 }
 
-int
-ADIS16497::data_ready_interrupt(int irq, void *context, void *arg)
-{
-	ADIS16497 *dev = static_cast<ADIS16497 *>(arg);
-
-	// make another measurement
-	dev->ScheduleNow();
-
-	return PX4_OK;
-}
-
 void
 ADIS16497::RunImpl()
 {
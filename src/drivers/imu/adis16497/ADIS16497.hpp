@@ -151,8 +151,6 @@ private:
 	 */
 	int			reset();
 
-	static int		data_ready_interrupt(int irq, void *context, void *arg);
-
 	/**
 	 * Fetch measurements from the sensor and update the report buffers.
 	 */
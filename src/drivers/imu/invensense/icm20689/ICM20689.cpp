@@ -48,6 +48,7 @@ ICM20689::ICM20689(I2CSPIBusOption bus_option, int bus, uint32_t device, enum Ro
 	_px4_accel(get_device_id(), ORB_PRIO_HIGH, rotation),
 	_px4_gyro(get_device_id(), ORB_PRIO_HIGH, rotation)
 {
+	_px4_accel.set_gyroscope(&_px4_gyro);
 	ConfigureSampleRate(_px4_gyro.get_max_rate_hz());
 }
 
@@ -59,7 +60,6 @@ ICM20689::~ICM20689()
 	perf_free(_fifo_empty_perf);
 	perf_free(_fifo_overflow_perf);
 	perf_free(_fifo_reset_perf);
-	perf_free(_drdy_interval_perf);
 }
 
 int ICM20689::init()
@@ -100,7 +100,6 @@ void ICM20689::print_status()
 	perf_print_counter(_fifo_empty_perf);
 	perf_print_counter(_fifo_overflow_perf);
 	perf_print_counter(_fifo_reset_perf);
-	perf_print_counter(_drdy_interval_perf);
 
 	_px4_accel.print_status();
 	_px4_gyro.print_status();
@@ -160,7 +159,8 @@ void ICM20689::RunImpl()
 			// if configure succeeded then start reading from FIFO
 			_state = STATE::FIFO_READ;
 
-			if (DataReadyInterruptConfigure()) {
+			// data ready on falling edge
+			if (DataReadyInterruptConfigure(_drdy_gpio, false, true)) {
 				_data_ready_interrupt_enabled = true;
 
 				// backup schedule as a watchdog timeout
@@ -203,14 +203,24 @@ void ICM20689::RunImpl()
 
 			bool failure = false;
 
-			// manually check FIFO count if no samples from DRDY or timestamp looks bogus
+			// no samples from DRDY or timestamp looks bogus
 			if (!_data_ready_interrupt_enabled || (samples == 0)
 			    || (hrt_elapsed_time(&timestamp_sample) > (_fifo_empty_interval_us / 2))) {
 
 				// use the time now roughly corresponding with the last sample we'll pull from the FIFO
 				timestamp_sample = hrt_absolute_time();
-				const uint16_t fifo_count = FIFOReadCount();
-				samples = (fifo_count / sizeof(FIFO::DATA) / SAMPLES_PER_TRANSFER) * SAMPLES_PER_TRANSFER; // round down to nearest
+
+				if (_force_fifo_count_check) {
+					const uint16_t fifo_count = FIFOReadCount();
+					samples = (fifo_count / sizeof(FIFO::DATA) / SAMPLES_PER_TRANSFER) * SAMPLES_PER_TRANSFER; // round down to nearest
+
+				} else {
+					// FIFO_COUNT comes with every FIFO transfer, skip the separate FIFO_COUNT read
+					samples = FIFOSamplesEstimate(timestamp_sample);
+
+					// the newest sample is held back
+					timestamp_sample -= static_cast<hrt_abstime>(FIFO_SAMPLE_DT);
+				}
 			}
 
 			if (samples > FIFO_MAX_SAMPLES) {
@@ -349,41 +359,16 @@ bool ICM20689::Configure()
 	return success;
 }
 
-int ICM20689::DataReadyInterruptCallback(int irq, void *context, void *arg)
+bool ICM20689::DataReady(const hrt_abstime &timestamp_sample)
 {
-	static_cast<ICM20689 *>(arg)->DataReady();
-	return 0;
-}
-
-void ICM20689::DataReady()
-{
-	perf_count(_drdy_interval_perf);
-
 	if (_data_ready_count.fetch_add(1) >= (_fifo_gyro_samples - 1)) {
 		_data_ready_count.store(0);
-		_fifo_watermark_interrupt_timestamp = hrt_absolute_time();
+		_fifo_watermark_interrupt_timestamp = timestamp_sample;
 		_fifo_read_samples.store(_fifo_gyro_samples);
-		ScheduleNow();
-	}
-}
-
-bool ICM20689::DataReadyInterruptConfigure()
-{
-	if (_drdy_gpio == 0) {
-		return false;
+		return true;
 	}
 
-	// Setup data ready on falling edge
-	return px4_arch_gpiosetevent(_drdy_gpio, false, true, true, &DataReadyInterruptCallback, this) == 0;
-}
-
-bool ICM20689::DataReadyInterruptDisable()
-{
-	if (_drdy_gpio == 0) {
-		return false;
-	}
-
-	return px4_arch_gpiosetevent(_drdy_gpio, false, false, false, nullptr, nullptr) == 0;
+	return false;
 }
 
 bool ICM20689::RegisterCheck(const register_config_t &reg_cfg, bool notify)
@@ -459,12 +444,29 @@ uint16_t ICM20689::FIFOReadCount()
 	return combine(fifo_count_buf[1], fifo_count_buf[2]);
 }
 
+uint8_t ICM20689::FIFOSamplesEstimate(const hrt_abstime &now) const
+{
+	// samples left after the last transfer plus the samples that arrived since
+	const uint32_t new_samples = static_cast<uint32_t>((now - _fifo_read_timestamp) / FIFO_SAMPLE_DT);
+	const uint32_t samples = math::min(_fifo_samples_remaining + new_samples, static_cast<uint32_t>(FIFO::SIZE / sizeof(FIFO::DATA)));
+
+	// keep one sample in reserve for the difference between the sensor and system clocks,
+	// reading past the end of the FIFO would misalign the data
+	if (samples > SAMPLES_PER_TRANSFER) {
+		return ((samples - 1) / SAMPLES_PER_TRANSFER) * SAMPLES_PER_TRANSFER; // round down to nearest
+	}
+
+	return 0;
+}
+
 bool ICM20689::FIFORead(const hrt_abstime &timestamp_sample, uint16_t samples)
 {
 	perf_begin(_transfer_perf);
 	FIFOTransferBuffer buffer{};
 	const size_t transfer_size = math::min(samples * sizeof(FIFO::DATA) + 3, FIFO::SIZE);
 
+	const hrt_abstime transfer_timestamp = hrt_absolute_time();
+
 	if (transfer((uint8_t *)&buffer, (uint8_t *)&buffer, transfer_size) != PX4_OK) {
 		perf_end(_transfer_perf);
 		perf_count(_bad_transfer_perf);
@@ -489,16 +491,20 @@ bool ICM20689::FIFORead(const hrt_abstime &timestamp_sample, uint16_t samples)
 
 	const uint16_t valid_samples = math::min(samples, fifo_count_samples);
 
+	// samples left in the FIFO, the next read without DRDY is estimated from this
+	_fifo_samples_remaining = fifo_count_samples - valid_samples;
+	_fifo_read_timestamp = transfer_timestamp;
+
 	if (fifo_count_samples < samples) {
 		// force check if there is somehow fewer samples actually in the FIFO (potentially a serious error)
 		_force_fifo_count_check = true;
 
-	} else if (fifo_count_samples >= samples + 2) {
+	} else if (_data_ready_interrupt_enabled && (fifo_count_samples >= samples + 2)) {
 		// if we're more than a couple samples behind force FIFO_COUNT check
 		_force_fifo_count_check = true;
 
 	} else {
-		// skip earlier FIFO_COUNT and trust DRDY count if we're in sync
+		// skip earlier FIFO_COUNT and trust DRDY count (or the estimate) if we're in sync
 		_force_fifo_count_check = false;
 	}
 
@@ -530,6 +536,7 @@ void ICM20689::FIFOReset()
 	_data_ready_count.store(0);
 	_fifo_watermark_interrupt_timestamp = 0;
 	_fifo_read_samples.store(0);
+	_force_fifo_count_check = true;
 
 	// FIFO_EN: enable both gyro and accel
 	// USER_CTRL: re-enable FIFO
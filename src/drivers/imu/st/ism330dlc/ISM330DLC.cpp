@@ -58,16 +58,11 @@ ISM330DLC::~ISM330DLC()
 	perf_free(_fifo_empty_perf);
 	perf_free(_fifo_overflow_perf);
 	perf_free(_fifo_reset_perf);
-	perf_free(_drdy_count_perf);
-	perf_free(_drdy_interval_perf);
 }
 
 void ISM330DLC::exit_and_cleanup()
 {
-	if (_drdy_gpio != 0) {
-		// Disable data ready callback
-		px4_arch_gpiosetevent(_drdy_gpio, false, false, false, nullptr, nullptr);
-
+	if (DataReadyInterruptDisable()) {
 		RegisterWrite(Register::INT1_CTRL, 0);
 	}
 
@@ -183,32 +178,20 @@ void ISM330DLC::RegisterClearBits(Register reg, uint8_t clearbits)
 	}
 }
 
-int ISM330DLC::DataReadyInterruptCallback(int irq, void *context, void *arg)
-{
-	ISM330DLC *dev = reinterpret_cast<ISM330DLC *>(arg);
-	dev->DataReady();
-	return 0;
-}
-
-void ISM330DLC::DataReady()
+bool ISM330DLC::DataReady(const hrt_abstime &timestamp_sample)
 {
-	_time_data_ready = hrt_absolute_time();
-
-	perf_count(_drdy_count_perf);
-	perf_count(_drdy_interval_perf);
+	_time_data_ready = timestamp_sample;
 
 	// make another measurement
-	ScheduleNow();
+	return true;
 }
 
 void ISM330DLC::Start()
 {
 	ResetFIFO();
 
-	if (_drdy_gpio != 0 && false) { // TODO: enable
-		// Setup data ready on rising edge
-		px4_arch_gpiosetevent(_drdy_gpio, true, true, false, &ISM330DLC::DataReadyInterruptCallback, this);
-
+	// Setup data ready on rising edge
+	if (false && DataReadyInterruptConfigure(_drdy_gpio, true, false)) { // TODO: enable
 		// FIFO threshold level setting
 		// FIFO_CTRL1: FTH_[7:0]
 		// FIFO_CTRL2: FTH_[10:8]
@@ -338,8 +321,6 @@ void ISM330DLC::print_status()
 	perf_print_counter(_fifo_empty_perf);
 	perf_print_counter(_fifo_overflow_perf);
 	perf_print_counter(_fifo_reset_perf);
-	perf_print_counter(_drdy_count_perf);
-	perf_print_counter(_drdy_interval_perf);
 
 	_px4_accel.print_status();
 	_px4_gyro.print_status();
@@ -56,6 +56,8 @@ AK09916::AK09916(I2CSPIBusOption bus_option, const int bus, int bus_frequency, e
 	_mag_overruns(perf_alloc(PC_COUNT, MODULE_NAME": mag_overruns")),
 	_mag_overflows(perf_alloc(PC_COUNT, MODULE_NAME": mag_overflows"))
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(external());
 	_px4_mag.set_scale(AK09916_MAG_RANGE_GA);
 }
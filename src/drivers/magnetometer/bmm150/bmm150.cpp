@@ -51,6 +51,8 @@ BMM150::BMM150(I2CSPIBusOption bus_option, const int bus, int bus_frequency, enu
 	_comms_errors(perf_alloc(PC_COUNT, MODULE_NAME": comms errors")),
 	_duplicates(perf_alloc(PC_COUNT, MODULE_NAME": duplicates"))
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(external());
 
 	// default range scale from uT to gauss
@@ -48,6 +48,8 @@ HMC5883::HMC5883(device::Device *interface, enum Rotation rotation, I2CSPIBusOpt
 	_temperature_counter(0),
 	_temperature_error_count(0)
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(_interface->external());
 }
 
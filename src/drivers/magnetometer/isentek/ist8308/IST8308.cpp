@@ -45,6 +45,8 @@ IST8308::IST8308(I2CSPIBusOption bus_option, int bus, enum Rotation rotation, in
 	I2CSPIDriver(MODULE_NAME, px4::device_bus_to_wq(get_device_id()), bus_option, bus),
 	_px4_mag(get_device_id(), external() ? ORB_PRIO_VERY_HIGH : ORB_PRIO_DEFAULT, rotation)
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(external());
 }
 
@@ -277,6 +277,8 @@ IST8310::IST8310(I2CSPIBusOption bus_option, int bus_number, int address, enum R
 	_range_errors(perf_alloc(PC_COUNT, MODULE_NAME": rng_err")),
 	_conf_errors(perf_alloc(PC_COUNT, MODULE_NAME": conf_err"))
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(external());
 
 	// default range scale from counts to gauss
@@ -52,6 +52,8 @@ LIS2MDL::LIS2MDL(device::Device *interface, enum Rotation rotation, I2CSPIBusOpt
 	_sample_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": read")),
 	_measure_interval(0)
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(_interface->external());
 	_px4_mag.set_scale(0.0015f); /* 49.152f / (2^15) */
 }
@@ -65,6 +65,8 @@ LIS3MDL::LIS3MDL(device::Device *interface, enum Rotation rotation, I2CSPIBusOpt
 	_temperature_counter(0),
 	_temperature_error_count(0)
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(_interface->external());
 }
 
@@ -54,6 +54,8 @@ RM3100::RM3100(device::Device *interface, enum Rotation rotation, I2CSPIBusOptio
 	_measure_interval(0),
 	_check_state_cnt(0)
 {
+	SetQueuePriority(BUS_PRIORITY_SENSOR);
+
 	_px4_mag.set_external(_interface->external());
 
 	_px4_mag.set_scale(1.f / (RM3100_SENSITIVITY * UTESLA_TO_GAUSS));
@@ -66,6 +66,14 @@ PAW3902::init()
 		}
 	}
 
+	param_t rate = param_find("SENS_FLOW_RATE");
+	float rate_hz = 0.f;
+
+	if ((rate != PARAM_INVALID) && (param_get(rate, &rate_hz) == PX4_OK) && (rate_hz > 0.f)) {
+		// the motion bursts are read at the frame rate, accumulate at least one frame per publication
+		_collect_time = math::constrain((uint32_t)(1e6f / rate_hz), SAMPLE_INTERVAL_MODE_0, (uint32_t)100_ms);
+	}
+
 	/* For devices competing with NuttX SPI drivers on a bus (Crazyflie SD Card expansion board) */
 	SPI::set_lockmode(LOCK_THREADS);
 
@@ -629,6 +637,7 @@ PAW3902::RunImpl()
 
 	_flow_sum_x += delta_x_raw;
 	_flow_sum_y += delta_y_raw;
+	_flow_quality_sum += buf.data.SQUAL;
 
 	// returns if the collect time has not been reached
 	if (_flow_dt_sum_usec < _collect_time) {
@@ -653,7 +662,7 @@ PAW3902::RunImpl()
 	report.integration_timespan = _flow_dt_sum_usec;	// microseconds
 
 	report.sensor_id = 0;
-	report.quality = buf.data.SQUAL;
+	report.quality = _flow_quality_sum / _frame_count_since_last;
 
 	/* No gyro on this board */
 	report.gyro_x_rate_integral = NAN;
@@ -671,6 +680,7 @@ PAW3902::RunImpl()
 	_flow_dt_sum_usec = 0;
 	_flow_sum_x = 0;
 	_flow_sum_y = 0;
+	_flow_quality_sum = 0;
 	_frame_count_since_last = 0;
 
 	perf_end(_sample_perf);
@@ -49,6 +49,7 @@
 #include <conversion/rotation.h>
 #include <lib/perf/perf_counter.h>
 #include <lib/parameters/param.h>
+#include <lib/mathlib/mathlib.h>
 #include <drivers/drv_hrt.h>
 #include <drivers/drv_range_finder.h>
 #include <uORB/PublicationMulti.hpp>
@@ -107,7 +108,7 @@ private:
 	perf_counter_t	_comms_errors;
 	perf_counter_t	_dupe_count_perf;
 
-	static constexpr uint64_t _collect_time{15000}; // 15 milliseconds, optical flow data publish rate
+	uint32_t	_collect_time{15000}; // optical flow data publish interval (SENS_FLOW_RATE)
 
 	uint64_t	_previous_collect_timestamp{0};
 	uint64_t	_flow_dt_sum_usec{0};
@@ -117,6 +118,7 @@ private:
 
 	int		_flow_sum_x{0};
 	int		_flow_sum_y{0};
+	unsigned	_flow_quality_sum{0};
 
 	Mode		_mode{Mode::LowLight};
 
@@ -218,6 +218,14 @@ PMW3901::init()
 		_yaw_rotation = (enum Rotation)val;
 	}
 
+	param_t rate = param_find("SENS_FLOW_RATE");
+	float rate_hz = 0.f;
+
+	if ((rate != PARAM_INVALID) && (param_get(rate, &rate_hz) == PX4_OK) && (rate_hz > 0.f)) {
+		_sample_interval = math::constrain((uint32_t)(1e6f / rate_hz), (uint32_t)PMW3901_SAMPLE_INTERVAL,
+						   (uint32_t)PMW3901_SAMPLE_INTERVAL_MAX);
+	}
+
 	/* For devices competing with NuttX SPI drivers on a bus (Crazyflie SD Card expansion board) */
 	SPI::set_lockmode(LOCK_THREADS);
 
@@ -319,11 +327,7 @@ PMW3901::RunImpl()
 		_flow_quality_sum += qual;
 	}
 
-	// returns if the collect time has not been reached
-	if (_flow_dt_sum_usec < _collect_time) {
-		return;
-	}
-
+	// the motion registers accumulate the motion since the last read, so every read is published
 	delta_x = (float)_flow_sum_x / 500.0f;		// proportional factor + convert from pixels to radians
 	delta_y = (float)_flow_sum_y / 500.0f;		// proportional factor + convert from pixels to radians
 
@@ -385,8 +389,10 @@ PMW3901::readMotionCount(int16_t &deltaX, int16_t &deltaY, uint8_t &qual)
 	deltaX = ((int16_t)data[5] << 8) | data[3];
 	deltaY = ((int16_t)data[9] << 8) | data[7];
 
-	// If the reported flow is impossibly large, we just got garbage from the SPI
-	if (deltaX > 240 || deltaY > 240 || deltaX < -240 || deltaY < -240) {
+	// If the reported flow is impossibly large (240 per 10 ms), we just got garbage from the SPI
+	const int16_t max_delta = 240 * _sample_interval / PMW3901_SAMPLE_INTERVAL;
+
+	if (deltaX > max_delta || deltaY > max_delta || deltaX < -max_delta || deltaY < -max_delta) {
 		qual = 0;
 
 	} else {
@@ -402,7 +408,7 @@ void
 PMW3901::start()
 {
 	// schedule a cycle to start things
-	ScheduleOnInterval(PMW3901_SAMPLE_INTERVAL, PMW3901_US);
+	ScheduleOnInterval(_sample_interval, PMW3901_US);
 }
 
 void
@@ -46,6 +46,7 @@
 #include <conversion/rotation.h>
 #include <lib/perf/perf_counter.h>
 #include <lib/parameters/param.h>
+#include <lib/mathlib/mathlib.h>
 #include <drivers/drv_hrt.h>
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/topics/optical_flow.h>
@@ -61,6 +62,7 @@
 /* PMW3901 Registers addresses */
 #define PMW3901_US 1000 /*   1 ms */
 #define PMW3901_SAMPLE_INTERVAL 10000 /*  10 ms */
+#define PMW3901_SAMPLE_INTERVAL_MAX 100000 /* 100 ms */
 
 class PMW3901 : public device::SPI, public I2CSPIDriver<PMW3901>
 {
@@ -85,7 +87,8 @@ protected:
 
 private:
 
-	const uint64_t _collect_time{15000}; // usecs, ensures flow data is published every second iteration of Run() (100Hz -> 50Hz)
+	// interval of the motion reads, one read per publication (SENS_FLOW_RATE), the sensor accumulates the motion in between
+	uint32_t _sample_interval{PMW3901_SAMPLE_INTERVAL};
 
 	uORB::PublicationMulti<optical_flow_s> _optical_flow_pub{ORB_ID(optical_flow)};
 
@@ -37,7 +37,8 @@ PWMOut::PWMOut() :
 	CDev(PX4FMU_DEVICE_PATH),
 	OutputModuleInterface(MODULE_NAME, px4::wq_configurations::hp_default),
 	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")),
-	_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": interval"))
+	_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": interval")),
+	_output_latency_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": output latency"))
 {
 	_mixing_output.setAllMinValues(PWM_DEFAULT_MIN);
 	_mixing_output.setAllMaxValues(PWM_DEFAULT_MAX);
@@ -54,6 +55,7 @@ PWMOut::~PWMOut()
 
 	perf_free(_cycle_perf);
 	perf_free(_interval_perf);
+	perf_free(_output_latency_perf);
 }
 
 int PWMOut::init()
@@ -543,7 +545,9 @@ bool PWMOut::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 		return false;
 	}
 
-	/* output to the servos */
+	perf_begin(_output_latency_perf);
+
+	/* output to the servos, the compare registers are preloaded and only latched on the next update event */
 	if (_pwm_initialized) {
 		for (size_t i = 0; i < num_outputs; i++) {
 			up_pwm_servo_set(i, outputs[i]);
@@ -555,6 +559,10 @@ bool PWMOut::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 	 */
 	if (num_control_groups_updated > 0) {
 		up_pwm_update();
+		perf_end(_output_latency_perf);
+
+	} else {
+		perf_cancel(_output_latency_perf);
 	}
 
 	return true;
@@ -2001,6 +2009,7 @@ int PWMOut::print_status()
 
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_interval_perf);
+	perf_print_counter(_output_latency_perf);
 	_mixing_output.printStatus();
 
 	return 0;
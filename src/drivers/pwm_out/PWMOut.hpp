@@ -182,6 +182,7 @@ private:
 
 	perf_counter_t	_cycle_perf;
 	perf_counter_t	_interval_perf;
+	perf_counter_t	_output_latency_perf; ///< updateOutputs() until the oneshot timers are triggered
 
 	void		capture_callback(uint32_t chan_index,
 					 hrt_abstime edge_time, uint32_t edge_state, uint32_t overflow);
@@ -113,7 +113,7 @@ static constexpr unsigned UPDATE_INTERVAL_MIN{2};	// 2 ms	-> 500 Hz
 static constexpr unsigned UPDATE_INTERVAL_MAX{100};	// 100 ms -> 10 Hz
 
 #define ORB_CHECK_INTERVAL		200000		// 200 ms -> 5 Hz
-#define IO_POLL_INTERVAL		20000		// 20 ms -> 50 Hz
+#define IO_POLL_INTERVAL		10000		// 10 ms -> 100 Hz
 
 using namespace time_literals;
 
@@ -337,6 +337,12 @@ private:
 	 */
 	int			io_get_status();
 
+	/**
+	 * Fetch status, alarms, RC input and servo outputs from IO in a single transfer
+	 * (PX4IO_PAGE_POLL) and publish them.
+	 */
+	int			io_poll();
+
 	/**
 	 * Disable RC input handling
 	 */
@@ -346,19 +352,21 @@ private:
 	 * Fetch RC inputs from IO.
 	 *
 	 * @param input_rc	Input structure to populate.
+	 * @param rc_regs	PX4IO_PAGE_RAW_RC_INPUT registers from PX4IO_P_RAW_RC_COUNT, including the
+	 *			first PX4IO_P_POLL_RAW_RC_CHANNELS channels (from the poll page).
 	 * @return		OK if data was returned.
 	 */
-	int			io_get_raw_rc_input(input_rc_s &input_rc);
+	int			io_get_raw_rc_input(input_rc_s &input_rc, const uint16_t *rc_regs);
 
 	/**
-	 * Fetch and publish raw RC input data.
+	 * Publish raw RC input data.
 	 */
-	int			io_publish_raw_rc();
+	int			io_publish_raw_rc(const uint16_t *rc_regs);
 
 	/**
-	 * Fetch and publish the PWM servo outputs.
+	 * Publish the PWM servo outputs and mixer status.
 	 */
-	int			io_publish_pwm_outputs();
+	int			io_publish_pwm_outputs(const uint16_t *servos, uint16_t mixer_status);
 
 	/**
 	 * write register(s)
@@ -979,14 +987,8 @@ PX4IO::task_main()
 			/* run at 50-250Hz */
 			poll_last = now;
 
-			/* pull status and alarms from IO */
-			io_get_status();
-
-			/* get raw R/C input from IO */
-			io_publish_raw_rc();
-
-			/* fetch PWM outputs from IO */
-			io_publish_pwm_outputs();
+			/* pull status, alarms, R/C input and PWM outputs from IO */
+			io_poll();
 
 			/* check updates on uORB topics and handle it */
 			bool updated = false;
@@ -1784,7 +1786,31 @@ PX4IO::io_get_status()
 }
 
 int
-PX4IO::io_get_raw_rc_input(input_rc_s &input_rc)
+PX4IO::io_poll()
+{
+	uint16_t regs[PX4IO_P_POLL_COUNT];
+
+	int ret = io_reg_get(PX4IO_PAGE_POLL, 0, &regs[0], PX4IO_P_POLL_COUNT);
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	/* same layout as the status page from STATUS_FLAGS */
+	const uint16_t *status = &regs[PX4IO_P_POLL_STATUS];
+
+	io_handle_status(status[PX4IO_P_STATUS_FLAGS - PX4IO_P_STATUS_FLAGS]);
+	io_handle_alarms(status[PX4IO_P_STATUS_ALARMS - PX4IO_P_STATUS_FLAGS]);
+	io_handle_vservo(status[PX4IO_P_STATUS_VSERVO - PX4IO_P_STATUS_FLAGS],
+			 status[PX4IO_P_STATUS_VRSSI - PX4IO_P_STATUS_FLAGS]);
+
+	io_publish_raw_rc(&regs[PX4IO_P_POLL_RAW_RC]);
+
+	return io_publish_pwm_outputs(&regs[PX4IO_P_POLL_SERVOS], status[PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS]);
+}
+
+int
+PX4IO::io_get_raw_rc_input(input_rc_s &input_rc, const uint16_t *rc_regs)
 {
 	uint32_t channel_count;
 	int	ret;
@@ -1796,15 +1822,12 @@ PX4IO::io_get_raw_rc_input(input_rc_s &input_rc)
 	uint16_t regs[input_rc_s::RC_INPUT_MAX_CHANNELS + prolog];
 
 	/*
-	 * Read the channel count and the first 9 channels.
+	 * The channel count and the first 9 channels come with the poll page.
 	 *
 	 * This should be the common case (9 channel R/C control being a reasonable upper bound).
 	 */
-	ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_COUNT, &regs[0], prolog + 9);
-
-	if (ret != OK) {
-		return ret;
-	}
+	memcpy(&regs[0], rc_regs, (prolog + PX4IO_P_POLL_RAW_RC_CHANNELS) * sizeof(regs[0]));
+	ret = OK;
 
 	/*
 	 * Get the channel count any any extra channels. This is no more expensive than reading the
@@ -1856,8 +1879,9 @@ PX4IO::io_get_raw_rc_input(input_rc_s &input_rc)
 	/* FIELDS NOT SET HERE */
 	/* input_rc.input_source is set after this call XXX we might want to mirror the flags in the RC struct */
 
-	if (channel_count > 9) {
-		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + 9, &regs[prolog + 9], channel_count - 9);
+	if (channel_count > PX4IO_P_POLL_RAW_RC_CHANNELS) {
+		ret = io_reg_get(PX4IO_PAGE_RAW_RC_INPUT, PX4IO_P_RAW_RC_BASE + PX4IO_P_POLL_RAW_RC_CHANNELS,
+				 &regs[prolog + PX4IO_P_POLL_RAW_RC_CHANNELS], channel_count - PX4IO_P_POLL_RAW_RC_CHANNELS);
 
 		if (ret != OK) {
 			return ret;
@@ -1887,7 +1911,7 @@ PX4IO::io_get_raw_rc_input(input_rc_s &input_rc)
 }
 
 int
-PX4IO::io_publish_raw_rc()
+PX4IO::io_publish_raw_rc(const uint16_t *rc_regs)
 {
 
 	/* fetch values from IO */
@@ -1896,7 +1920,7 @@ PX4IO::io_publish_raw_rc()
 	/* set the RC status flag ORDER MATTERS! */
 	rc_val.rc_lost = !(_status & PX4IO_P_STATUS_FLAGS_RC_OK);
 
-	int ret = io_get_raw_rc_input(rc_val);
+	int ret = io_get_raw_rc_input(rc_val, rc_regs);
 
 	if (ret != OK) {
 		return ret;
@@ -1931,38 +1955,26 @@ PX4IO::io_publish_raw_rc()
 }
 
 int
-PX4IO::io_publish_pwm_outputs()
+PX4IO::io_publish_pwm_outputs(const uint16_t *servos, uint16_t mixer_status)
 {
 	if (_hitl_mode) {
 		return OK;
 	}
 
-	/* get servo values from IO */
-	uint16_t ctl[_max_actuators];
-	int ret = io_reg_get(PX4IO_PAGE_SERVOS, 0, ctl, _max_actuators);
-
-	if (ret != OK) {
-		return ret;
-	}
-
 	actuator_outputs_s outputs = {};
 	outputs.timestamp = hrt_absolute_time();
-	outputs.noutputs = _max_actuators;
+	outputs.noutputs = math::min(_max_actuators, (unsigned)PX4IO_P_POLL_SERVO_COUNT);
 
 	/* convert from register format to float */
-	for (unsigned i = 0; i < _max_actuators; i++) {
-		outputs.output[i] = ctl[i];
+	for (unsigned i = 0; i < outputs.noutputs; i++) {
+		outputs.output[i] = servos[i];
 	}
 
 	_to_outputs.publish(outputs);
 
-	/* get mixer status flags from IO */
+	/* mixer status flags from IO */
 	MultirotorMixer::saturation_status saturation_status;
-	ret = io_reg_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_MIXER, &saturation_status.value, 1);
-
-	if (ret != OK) {
-		return ret;
-	}
+	saturation_status.value = mixer_status;
 
 	/* publish mixer status */
 	if (saturation_status.flags.valid) {
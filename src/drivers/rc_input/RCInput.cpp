@@ -46,7 +46,8 @@ constexpr char const *RCInput::RC_SCAN_STRING[];
 RCInput::RCInput(const char *device) :
 	ScheduledWorkItem(MODULE_NAME, px4::serial_port_to_wq(device)),
 	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time")),
-	_publish_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": publish interval"))
+	_publish_interval_perf(perf_alloc(PC_INTERVAL, MODULE_NAME": publish interval")),
+	_publish_latency_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": publish latency"))
 {
 	// rc input, published to ORB
 	_rc_in.input_source = input_rc_s::RC_INPUT_SOURCE_PX4FMU_PPM;
@@ -73,6 +74,7 @@ RCInput::~RCInput()
 
 	perf_free(_cycle_perf);
 	perf_free(_publish_interval_perf);
+	perf_free(_publish_latency_perf);
 }
 
 int
@@ -351,9 +353,12 @@ void RCInput::Run()
 		// int ret = poll(fds, sizeof(fds) / sizeof(fds[0]), 100);
 		// then update priority to SCHED_PRIORITY_FAST_DRIVER
 		// read all available data from the serial RC input UART
+		// (DMA buffered on most boards), the parser then processes it as one block
+		newBytes = ::read(_rcs_fd, &_rcs_buf[0], sizeof(_rcs_buf));
 
-		// read all available data from the serial RC input UART
-		newBytes = ::read(_rcs_fd, &_rcs_buf[0], SBUS_BUFFER_SIZE);
+		if (newBytes > 0 && _frame_start == 0) {
+			_frame_start = cycle_timestamp;
+		}
 
 		switch (_rc_scan_state) {
 		case RC_SCAN_SBUS:
@@ -594,11 +599,23 @@ void RCInput::Run()
 
 		perf_end(_cycle_perf);
 
+		if (_rc_scan_locked && (newBytes == (int)sizeof(_rcs_buf))) {
+			// locked on a protocol and there is more data pending, process the next block right away
+			ScheduleNow();
+		}
+
 		if (rc_updated) {
 			perf_count(_publish_interval_perf);
 
 			_to_input_rc.publish(_rc_in);
 
+			// frame reception (first bytes read) to publication
+			if (_frame_start != 0) {
+				perf_set_elapsed(_publish_latency_perf, hrt_elapsed_time(&_frame_start));
+			}
+
+			_frame_start = 0;
+
 		} else if (!rc_updated && ((hrt_absolute_time() - _rc_in.timestamp_last_signal) > 1_s)) {
 			_rc_scan_locked = false;
 		}
@@ -690,6 +707,7 @@ int RCInput::print_status()
 
 	perf_print_counter(_cycle_perf);
 	perf_print_counter(_publish_interval_perf);
+	perf_print_counter(_publish_latency_perf);
 
 	if (hrt_elapsed_time(&_rc_in.timestamp) < 1_s) {
 		print_message(_rc_in);
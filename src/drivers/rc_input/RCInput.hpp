@@ -126,15 +126,20 @@ private:
 	int		_rcs_fd{-1};
 	char		_device[20] {};					///< device / serial port path
 
-	uint8_t _rcs_buf[SBUS_BUFFER_SIZE] {};
+	static constexpr unsigned RC_MAX_BUFFER_SIZE{64}; ///< read block size, a full cycle of data at the protocol line rates
+
+	uint8_t _rcs_buf[RC_MAX_BUFFER_SIZE] {};
 
 	uint16_t _raw_rc_values[input_rc_s::RC_INPUT_MAX_CHANNELS] {};
 	uint16_t _raw_rc_count{};
 
 	CRSFTelemetry *_crsf_telemetry{nullptr};
 
+	hrt_abstime _frame_start{0};	///< cycle in which the first bytes of the frame being received were read
+
 	perf_counter_t      _cycle_perf;
 	perf_counter_t      _publish_interval_perf;
+	perf_counter_t      _publish_latency_perf;
 
 	void fill_rc_in(uint16_t raw_rc_count_local,
 			uint16_t raw_rc_values_local[input_rc_s::RC_INPUT_MAX_CHANNELS],
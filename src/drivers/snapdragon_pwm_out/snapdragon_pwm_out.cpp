@@ -213,6 +213,8 @@ void subscribe()
 	_controls_topics[1] = ORB_ID(actuator_controls_1);
 	_controls_topics[2] = ORB_ID(actuator_controls_2);
 	_controls_topics[3] = ORB_ID(actuator_controls_3);
+	_controls_topics[4] = ORB_ID(actuator_controls_4);
+	_controls_topics[5] = ORB_ID(actuator_controls_5);
 
 
 	/*
@@ -168,6 +168,8 @@ TAP_ESC::TAP_ESC(char const *const device, uint8_t channels_count):
 	_control_topics[1] = ORB_ID(actuator_controls_1);
 	_control_topics[2] = ORB_ID(actuator_controls_2);
 	_control_topics[3] = ORB_ID(actuator_controls_3);
+	_control_topics[4] = ORB_ID(actuator_controls_4);
+	_control_topics[5] = ORB_ID(actuator_controls_5);
 	memset(_controls, 0, sizeof(_controls));
 	memset(_poll_fds, 0, sizeof(_poll_fds));
 
@@ -53,16 +53,15 @@
 #include <string.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
-#include <poll.h>
 #include <fcntl.h>
 #include <unistd.h>
 
-#include <px4_platform_common/tasks.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/getopt.h>
-#include <systemlib/err.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <termios.h>
 #include <drivers/drv_hrt.h>
+#include <uORB/Subscription.hpp>
 #include <uORB/topics/vehicle_air_data.h>
 #include <math.h>	// NAN
 
@@ -72,24 +71,7 @@
 
 using namespace time_literals;
 
-/* thread state */
-static volatile bool thread_should_exit = false;
-static volatile bool thread_running = false;
-static int frsky_task;
 typedef enum { SCANNING, SPORT, SPORT_SINGLE_WIRE, DTYPE } frsky_state_t;
-static frsky_state_t frsky_state = SCANNING;
-
-static unsigned long int sentPackets = 0;
-/* Default values for arguments */
-const char *device_name = NULL;
-
-/* functions */
-static int sPort_open_uart(const char *uart_name, struct termios *uart_config, struct termios *uart_config_original);
-static int set_uart_speed(int uart, struct termios *uart_config, speed_t speed);
-static void usage(void);
-static int frsky_telemetry_thread_main(int argc, char *argv[]);
-
-extern "C" __EXPORT int frsky_telemetry_main(int argc, char *argv[]);
 
 uint16_t get_telemetry_flight_mode(int px4_flight_mode)
 {
@@ -129,64 +111,210 @@ uint16_t get_telemetry_flight_mode(int px4_flight_mode)
 	return -1;
 }
 
+/**
+ * FrSky telemetry driver, running on the work queue of its serial port.
+ * The UART is used in non-blocking mode: instead of blocking in poll() and usleep(),
+ * the work item reschedules itself at the interval required by the current protocol state.
+ */
+class FrskyTelemetry : public ModuleBase<FrskyTelemetry>, public px4::ScheduledWorkItem
+{
+public:
+	FrskyTelemetry(const char *device, frsky_state_t state, uint32_t scanning_timeout_ms);
+	~FrskyTelemetry() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	int init();
+
+private:
+	void Run() override;
+
+	void run_scanning(const hrt_abstime &now);
+	void run_sport(const hrt_abstime &now);
+	void run_dtype();
+
+	/**
+	 * Check the bytes received at the current scanning baud rate for a D-type host frame or S.Port poll frames.
+	 */
+	bool scan_detect();
+
+	/**
+	 * Switch to the next baud rate / wiring to try while scanning.
+	 */
+	void scan_next_baudrate(const hrt_abstime &now);
+
+	/**
+	 * Configure the UART for the detected (or selected) protocol and subscribe to its topics.
+	 */
+	bool start_protocol(frsky_state_t state);
+
+	/**
+	 * Answer an S.Port poll frame for the given sensor ID.
+	 */
+	void sport_reply(uint8_t id, const hrt_abstime &now);
+
+	static int set_uart_speed(int uart, struct termios *uart_config, speed_t speed);
+	static void set_uart_single_wire(int uart, bool single_wire);
+
+	static constexpr hrt_abstime SCAN_INTERVAL{10_ms};		///< polling interval while scanning
+	static constexpr hrt_abstime SCAN_FRAME_WAIT{50_ms};		///< long enough for 11 bytes at 9600 baud after the first byte
+	static constexpr hrt_abstime SCAN_LISTEN_TIMEOUT{1_s};		///< time to listen for traffic at each baud rate
+	static constexpr hrt_abstime SCAN_SETTLE_TIME{100_ms};		///< wait after a baud rate change before flushing the input
+	static constexpr hrt_abstime SPORT_POLL_INTERVAL{2_ms};		///< the receiver sends a poll frame every ~12 ms
+	static constexpr hrt_abstime SPORT_ID_WAIT{200_us};		///< ID byte following a start byte (~170 us at 57600 baud)
+	static constexpr hrt_abstime SPORT_REPLY_DELAY{500_us};		///< minimum delay between the poll frame and the reply
+	static constexpr hrt_abstime DTYPE_INTERVAL{100_ms};
+
+	char _device[20] {};
+	int _uart{-1};
+	struct termios _uart_config {};
+	struct termios _uart_config_original {};
+
+	frsky_state_t _state{SCANNING};
+	bool _protocol_initialized{false};
+	unsigned long int _sent_packets{0};
+
+	// scanning
+	const uint32_t _scanning_timeout_ms;
+	frsky_state_t _baudrate{DTYPE};
+	hrt_abstime _scan_start{0};
+	hrt_abstime _scan_listen_start{0};
+	hrt_abstime _scan_settle_until{0};
+	hrt_abstime _scan_traffic_time{0};
+
+	uint8_t _sbuf[20] {};
+	int _sbuf_len{0};
+
+	// S.Port
+	uORB::Subscription _vehicle_air_data_sub{ORB_ID(vehicle_air_data)};
+
+	bool _sport_header{false};	///< last received byte was a start byte, the sensor ID follows
+	bool _sport_reply_pending{false};
+	uint8_t _sport_reply_id{0};
+
+	float _filtered_alt{NAN};
+	float _last_baro_alt{0.f};
+
+	uint32_t _lastBATV_ms{0};
+	uint32_t _lastCUR_ms{0};
+	uint32_t _lastALT_ms{0};
+	uint32_t _lastSPD_ms{0};
+	uint32_t _lastFUEL_ms{0};
+	uint32_t _lastVSPD_ms{0};
+	uint32_t _lastGPS_ms{0};
+	uint32_t _lastNAV_STATE_ms{0};
+	uint32_t _lastGPS_FIX_ms{0};
+
+	int _gps_element{0};
+	int _sp2ur_element{0};
+
+	// D-type
+	int _iteration{0};
+};
+
+FrskyTelemetry::FrskyTelemetry(const char *device, frsky_state_t state, uint32_t scanning_timeout_ms) :
+	ScheduledWorkItem(MODULE_NAME, px4::serial_port_to_wq(device)),
+	_state(state),
+	_scanning_timeout_ms(scanning_timeout_ms)
+{
+	strncpy(_device, device, sizeof(_device) - 1);
+	_device[sizeof(_device) - 1] = '\0';
+
+	if (state != SCANNING) {
+		_baudrate = state;
+	}
+}
+
+FrskyTelemetry::~FrskyTelemetry()
+{
+	if (_protocol_initialized) {
+		if (_state == DTYPE) {
+			PX4_DEBUG("freeing frsky memory");
+			frsky_deinit();
+
+		} else {
+			PX4_DEBUG("freeing sPort memory");
+			sPort_deinit();
+		}
+	}
+
+	if (_uart >= 0) {
+		/* Reset the UART flags to original state */
+		tcsetattr(_uart, TCSANOW, &_uart_config_original);
+		close(_uart);
+	}
+}
+
 /**
  * Opens the UART device and sets all required serial parameters.
  */
-static int sPort_open_uart(const char *uart_name, struct termios *uart_config, struct termios *uart_config_original)
+int FrskyTelemetry::init()
 {
 	/* Open UART */
-	const int uart = open(uart_name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+	const int uart = open(_device, O_RDWR | O_NOCTTY | O_NONBLOCK);
 
 	if (uart < 0) {
-		PX4_ERR("Error opening port: %s (%i)", uart_name, errno);
+		PX4_ERR("Error opening port: %s (%i)", _device, errno);
 		return -1;
 	}
 
 	/* Back up the original UART configuration to restore it after exit */
 	int termios_state;
 
-	if ((termios_state = tcgetattr(uart, uart_config_original)) < 0) {
-		PX4_ERR("tcgetattr %s: %d\n", uart_name, termios_state);
+	if ((termios_state = tcgetattr(uart, &_uart_config_original)) < 0) {
+		PX4_ERR("tcgetattr %s: %d\n", _device, termios_state);
 		close(uart);
 		return -1;
 	}
 
 	/* Fill the struct for the new configuration */
-	tcgetattr(uart, uart_config);
+	tcgetattr(uart, &_uart_config);
 
 	/* Disable output post-processing */
-	uart_config->c_oflag &= ~OPOST;
+	_uart_config.c_oflag &= ~OPOST;
 
-	uart_config->c_cflag |= (CLOCAL | CREAD);    /* ignore modem controls */
-	uart_config->c_cflag &= ~CSIZE;
-	uart_config->c_cflag |= CS8;         /* 8-bit characters */
-	uart_config->c_cflag &= ~PARENB;     /* no parity bit */
-	uart_config->c_cflag &= ~CSTOPB;     /* only need 1 stop bit */
-	uart_config->c_cflag &= ~CRTSCTS;    /* no hardware flowcontrol */
+	_uart_config.c_cflag |= (CLOCAL | CREAD);    /* ignore modem controls */
+	_uart_config.c_cflag &= ~CSIZE;
+	_uart_config.c_cflag |= CS8;         /* 8-bit characters */
+	_uart_config.c_cflag &= ~PARENB;     /* no parity bit */
+	_uart_config.c_cflag &= ~CSTOPB;     /* only need 1 stop bit */
+	_uart_config.c_cflag &= ~CRTSCTS;    /* no hardware flowcontrol */
 
 	/* setup for non-canonical mode */
-	uart_config->c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
-	uart_config->c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+	_uart_config.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+	_uart_config.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
 
 	/* Set baud rate */
 	const speed_t speed = B9600;
 
-	if (cfsetispeed(uart_config, speed) < 0 || cfsetospeed(uart_config, speed) < 0) {
-		PX4_ERR("%s: %d (cfsetispeed, cfsetospeed)\n", uart_name, termios_state);
+	if (cfsetispeed(&_uart_config, speed) < 0 || cfsetospeed(&_uart_config, speed) < 0) {
+		PX4_ERR("%s: %d (cfsetispeed, cfsetospeed)\n", _device, termios_state);
 		close(uart);
 		return -1;
 	}
 
-	if ((termios_state = tcsetattr(uart, TCSANOW, uart_config)) < 0) {
-		PX4_ERR("%s (tcsetattr)\n", uart_name);
+	if ((termios_state = tcsetattr(uart, TCSANOW, &_uart_config)) < 0) {
+		PX4_ERR("%s (tcsetattr)\n", _device);
 		close(uart);
 		return -1;
 	}
 
-	return uart;
+	_uart = uart;
+
+	return 0;
 }
 
-static int set_uart_speed(int uart, struct termios *uart_config, speed_t speed)
+int FrskyTelemetry::set_uart_speed(int uart, struct termios *uart_config, speed_t speed)
 {
 
 	if (cfsetispeed(uart_config, speed) < 0) {
@@ -200,601 +328,583 @@ static int set_uart_speed(int uart, struct termios *uart_config, speed_t speed)
 	return uart;
 }
 
-static void set_uart_single_wire(int uart, bool single_wire)
+void FrskyTelemetry::set_uart_single_wire(int uart, bool single_wire)
 {
 	if (ioctl(uart, TIOCSSINGLEWIRE, single_wire ? SER_SINGLEWIRE_ENABLED : 0) < 0) {
 		PX4_WARN("setting TIOCSSINGLEWIRE failed");
 	}
 }
 
-/**
- * The daemon thread.
- */
-static int frsky_telemetry_thread_main(int argc, char *argv[])
+void FrskyTelemetry::Run()
 {
-	device_name = "/dev/ttyS6"; /* default USART8 */
-	unsigned scanning_timeout_ms = 0;
-	frsky_state = SCANNING;
-	frsky_state_t baudRate = DTYPE;
-
-	int myoptind = 1;
-	int ch;
-	const char *myoptarg = nullptr;
-
-	while ((ch = px4_getopt(argc, argv, "d:t:m:", &myoptind, &myoptarg)) != EOF) {
-		switch (ch) {
-		case 'd':
-			device_name = myoptarg;
-			break;
+	if (should_exit()) {
+		exit_and_cleanup();
+		return;
+	}
 
-		case 't':
-			scanning_timeout_ms = strtoul(myoptarg, nullptr, 10) * 1000;
-			break;
+	if (_uart < 0) {
+		// open the port from the work queue thread, file descriptors are not shared with the starting task
+		if (init() != 0) {
+			exit_and_cleanup();
+			return;
+		}
+	}
 
-		case 'm':
-			if (!strcmp(myoptarg, "sport")) {
-				frsky_state = baudRate = SPORT;
+	const hrt_abstime now = hrt_absolute_time();
 
-			} else if (!strcmp(myoptarg, "sport_single")) {
-				frsky_state = baudRate = SPORT_SINGLE_WIRE;
+	if (!_protocol_initialized) {
+		if (_state == SCANNING) {
+			run_scanning(now);
+			return;
+		}
 
-			} else if (!strcmp(myoptarg, "dtype")) {
-				frsky_state = baudRate = DTYPE;
+		if (!start_protocol(_state)) {
+			exit_and_cleanup();
+			return;
+		}
+	}
 
-			} else if (!strcmp(myoptarg, "auto")) {
-			} else {
-				usage();
-				return -1;
-			}
+	if (_state == DTYPE) {
+		run_dtype();
 
-			break;
+	} else {
+		run_sport(now);
+	}
+}
 
-		default:
-			usage();
-			return -1;
-			break;
-		}
+void FrskyTelemetry::run_scanning(const hrt_abstime &now)
+{
+	if (_scan_start == 0) {
+		_scan_start = now;
+		_scan_listen_start = now;
 	}
 
-	/* Open UART */
-	struct termios uart_config_original;
-	struct termios uart_config;
-	const int uart = sPort_open_uart(device_name, &uart_config, &uart_config_original);
+	if (_scan_settle_until != 0) {
+		if (now < _scan_settle_until) {
+			ScheduleDelayed(SCAN_INTERVAL);
+			return;
+		}
 
-	if (uart < 0) {
-		device_name = NULL;
-		return -1;
+		// flush buffer
+		read(_uart, &_sbuf[0], sizeof(_sbuf));
+		_scan_settle_until = 0;
+		_scan_listen_start = now;
 	}
 
-	/* poll descriptor */
-	struct pollfd fds[1];
-	fds[0].fd = uart;
-	fds[0].events = POLLIN;
-
-	thread_running = true;
+	/* 2 byte polling frames indicate SmartPort telemetry
+	 * 11 byte packets indicate D type telemetry
+	 */
+	const int nbytes = read(_uart, &_sbuf[_sbuf_len], sizeof(_sbuf) - _sbuf_len);
 
-	/* Main thread loop */
-	char sbuf[20];
+	if (nbytes > 0) {
+		if (_sbuf_len == 0) {
+			_scan_traffic_time = now;
+		}
 
-	const hrt_abstime start_time = hrt_absolute_time();
+		_sbuf_len += nbytes;
+	}
 
-	while (!thread_should_exit && frsky_state == SCANNING) {
-		/* 2 byte polling frames indicate SmartPort telemetry
-		 * 11 byte packets indicate D type telemetry
+	if (_sbuf_len > 0) {
+		/* traffic on the port, D type is 11 bytes per frame, SmartPort is only 2
+		 * Wait long enough for 11 bytes at 9600 baud
 		 */
-		int status = poll(fds, sizeof(fds) / sizeof(fds[0]), 1000);
-
-		if (status > 0) {
-			/* traffic on the port, D type is 11 bytes per frame, SmartPort is only 2
-			 * Wait long enough for 11 bytes at 9600 baud
-			 */
-			usleep(50_ms);
-			int nbytes = read(uart, &sbuf[0], sizeof(sbuf));
-			PX4_DEBUG("frsky input: %d bytes: %x %x, speed: %d", nbytes, sbuf[0], sbuf[1], baudRate);
-
-			// look for valid header byte
-			if (baudRate == DTYPE) {
-				if (nbytes > 10) {
-					// see if we got a valid D-type hostframe
-					struct adc_linkquality host_frame;
-
-					if (frsky_parse_host((uint8_t *)&sbuf[0], nbytes, &host_frame)) {
-						frsky_state = baudRate;
-						break;
-					}
-				}
-
-			} else {
-				if (nbytes > 1) {
-					// check for alternating S.port start bytes
-					int index = 0;
+		if (now - _scan_traffic_time >= SCAN_FRAME_WAIT || _sbuf_len == sizeof(_sbuf)) {
+			PX4_DEBUG("frsky input: %d bytes: %x %x, speed: %d", _sbuf_len, _sbuf[0], _sbuf[1], _baudrate);
 
-					while (index < 2 && sbuf[index] != 0x7E) { index++; }
+			if (scan_detect()) {
+				_state = _baudrate;
+				ScheduleNow();
+				return;
+			}
 
-					if (index < 2) {
+			scan_next_baudrate(now);
+		}
 
-						int success = 1;
+	} else if (now - _scan_listen_start > SCAN_LISTEN_TIMEOUT) {
+		scan_next_baudrate(now);
+	}
 
-						for (int i = index + 2; i < nbytes; i += 2) {
-							if (sbuf[i] != 0x7E) { success = 0; break; }
-						}
+	// check for a timeout
+	if (_scanning_timeout_ms > 0 && (now - _scan_start) / 1000 > _scanning_timeout_ms) {
+		PX4_INFO("Scanning timeout: exiting");
+		exit_and_cleanup();
+		return;
+	}
 
-						if (success) {
-							frsky_state = baudRate;
-							break;
-						}
-					}
-				}
+	ScheduleDelayed(SCAN_INTERVAL);
+}
 
+bool FrskyTelemetry::scan_detect()
+{
+	// look for valid header byte
+	if (_baudrate == DTYPE) {
+		if (_sbuf_len > 10) {
+			// see if we got a valid D-type hostframe
+			struct adc_linkquality host_frame;
+
+			if (frsky_parse_host(&_sbuf[0], _sbuf_len, &host_frame)) {
+				return true;
 			}
 		}
 
-		// alternate between S.port and D-type baud rates
-		if (baudRate == SPORT) {
-			PX4_DEBUG("setting baud rate to %d (single wire)", 57600);
-			set_uart_speed(uart, &uart_config, B57600);
-			// switch to single-wire (half-duplex) mode, because S.Port uses only a single wire
-			set_uart_single_wire(uart, true);
-			baudRate = SPORT_SINGLE_WIRE;
+	} else {
+		if (_sbuf_len > 1) {
+			// check for alternating S.port start bytes
+			int index = 0;
 
-		} else if (baudRate == SPORT_SINGLE_WIRE) {
-			PX4_DEBUG("setting baud rate to %d", 9600);
-			set_uart_speed(uart, &uart_config, B9600);
-			set_uart_single_wire(uart, false);
-			baudRate = DTYPE;
+			while (index < 2 && _sbuf[index] != 0x7E) { index++; }
 
-		} else {
-			PX4_DEBUG("setting baud rate to %d", 57600);
-			set_uart_speed(uart, &uart_config, B57600);
-			// in case S.Port is connected via external inverter (e.g. via Sipex 3232EE), we need to use duplex mode
-			set_uart_single_wire(uart, false);
-			baudRate = SPORT;
-		}
+			if (index < 2) {
 
-		usleep(100_ms);
-		// flush buffer
-		read(uart, &sbuf[0], sizeof(sbuf));
+				for (int i = index + 2; i < _sbuf_len; i += 2) {
+					if (_sbuf[i] != 0x7E) { return false; }
+				}
 
-		// check for a timeout
-		if (scanning_timeout_ms > 0 && (hrt_absolute_time() - start_time) / 1000 > scanning_timeout_ms) {
-			PX4_INFO("Scanning timeout: exiting");
-			break;
+				return true;
+			}
 		}
 	}
 
-	if (frsky_state == SPORT || frsky_state == SPORT_SINGLE_WIRE) {
-		set_uart_speed(uart, &uart_config, B57600);
-		set_uart_single_wire(uart, frsky_state == SPORT_SINGLE_WIRE);
+	return false;
+}
+
+void FrskyTelemetry::scan_next_baudrate(const hrt_abstime &now)
+{
+	// alternate between S.port and D-type baud rates
+	if (_baudrate == SPORT) {
+		PX4_DEBUG("setting baud rate to %d (single wire)", 57600);
+		set_uart_speed(_uart, &_uart_config, B57600);
+		// switch to single-wire (half-duplex) mode, because S.Port uses only a single wire
+		set_uart_single_wire(_uart, true);
+		_baudrate = SPORT_SINGLE_WIRE;
+
+	} else if (_baudrate == SPORT_SINGLE_WIRE) {
+		PX4_DEBUG("setting baud rate to %d", 9600);
+		set_uart_speed(_uart, &_uart_config, B9600);
+		set_uart_single_wire(_uart, false);
+		_baudrate = DTYPE;
+
+	} else {
+		PX4_DEBUG("setting baud rate to %d", 57600);
+		set_uart_speed(_uart, &_uart_config, B57600);
+		// in case S.Port is connected via external inverter (e.g. via Sipex 3232EE), we need to use duplex mode
+		set_uart_single_wire(_uart, false);
+		_baudrate = SPORT;
+	}
+
+	// let the line settle before flushing the input and listening again
+	_sbuf_len = 0;
+	_scan_settle_until = now + SCAN_SETTLE_TIME;
+}
+
+bool FrskyTelemetry::start_protocol(frsky_state_t state)
+{
+	if (state == SPORT || state == SPORT_SINGLE_WIRE) {
+		set_uart_speed(_uart, &_uart_config, B57600);
+		set_uart_single_wire(_uart, state == SPORT_SINGLE_WIRE);
 
 		/* Subscribe to topics */
 		if (!sPort_init()) {
 			PX4_ERR("could not allocate memory");
-			return -1;
+			return false;
 		}
 
 		PX4_INFO("sending FrSky SmartPort telemetry");
 
-		float filtered_alt = NAN;
-		float last_baro_alt = 0.f;
-		int airdata_sub = orb_subscribe(ORB_ID(vehicle_air_data));
-
-		uint32_t lastBATV_ms = 0;
-		uint32_t lastCUR_ms = 0;
-		uint32_t lastALT_ms = 0;
-		uint32_t lastSPD_ms = 0;
-		uint32_t lastFUEL_ms = 0;
-		uint32_t lastVSPD_ms = 0;
-		uint32_t lastGPS_ms = 0;
-		uint32_t lastNAV_STATE_ms = 0;
-		uint32_t lastGPS_FIX_ms = 0;
-
-		/* send S.port telemetry */
-		while (!thread_should_exit) {
-
-			/* wait for poll frame starting with value 0x7E
-			* note that only the bus master is supposed to put a 0x7E on the bus.
-			* slaves use byte stuffing to send 0x7E and 0x7D.
-			* we expect a poll frame every 12msec
-			*/
-			int status = poll(fds, sizeof(fds) / sizeof(fds[0]), 50);
-
-			if (status < 1) { continue; }
-
-			// read 1 byte
-			int newBytes = read(uart, &sbuf[0], 1);
-
-			if (newBytes < 1 || sbuf[0] != 0x7E) { continue; }
-
-			/* wait for ID byte */
-			status = poll(fds, sizeof(fds) / sizeof(fds[0]), 50);
-
-			if (status < 1) { continue; }
-
-			uint32_t now_ms = hrt_absolute_time() / 1000;
-
-			newBytes = read(uart, &sbuf[1], 1);
+	} else {
+		/* detected D type telemetry: reconfigure UART */
+		PX4_INFO("sending FrSky D type telemetry");
+		int status = set_uart_speed(_uart, &_uart_config, B9600);
+		set_uart_single_wire(_uart, false);
 
-			/* get a local copy of the current sensor values
-			 * in order to apply a lowpass filter to baro pressure.
-			 */
-			bool sensor_updated = false;
-			orb_check(airdata_sub, &sensor_updated);
+		if (status < 0) {
+			PX4_DEBUG("error setting speed for %s, quitting", _device);
+			return false;
+		}
 
-			if (sensor_updated) {
-				struct vehicle_air_data_s airdata;
-				orb_copy(ORB_ID(vehicle_air_data), airdata_sub, &airdata);
+		/* Subscribe to topics */
+		if (!frsky_init()) {
+			PX4_ERR("could not allocate memory");
+			return false;
+		}
+	}
 
-				if (isnan(filtered_alt)) {
-					filtered_alt = airdata.baro_alt_meter;
+	_protocol_initialized = true;
 
-				} else {
-					filtered_alt = .05f * airdata.baro_alt_meter + .95f * filtered_alt;
-				}
-			}
+	return true;
+}
 
-			// allow a minimum of 500usec before reply
-			usleep(500);
+void FrskyTelemetry::run_sport(const hrt_abstime &now)
+{
+	if (_sport_reply_pending) {
+		_sport_reply_pending = false;
+		sport_reply(_sport_reply_id, now);
+	}
 
-			sPort_update_topics();
+	/* wait for poll frame starting with value 0x7E
+	* note that only the bus master is supposed to put a 0x7E on the bus.
+	* slaves use byte stuffing to send 0x7E and 0x7D.
+	* we expect a poll frame every 12msec
+	*/
+	const int nbytes = read(_uart, &_sbuf[0], sizeof(_sbuf));
+	bool poll_frame = false;
 
-			switch (sbuf[1]) {
+	for (int i = 0; i < nbytes; i++) {
+		if (_sbuf[i] == 0x7E) {
+			_sport_header = true;
+			poll_frame = false;
 
-			case SMARTPORT_POLL_1:
+		} else if (_sport_header) {
+			_sport_header = false;
+			_sport_reply_id = _sbuf[i];
+			poll_frame = true;
 
-				/* report BATV at 1Hz */
-				if (now_ms - lastBATV_ms > 1000) {
-					lastBATV_ms = now_ms;
-					/* send battery voltage */
-					sPort_send_BATV(uart);
-					sentPackets++;
-				}
+		} else {
+			// replies of other sensors (or our own in single-wire mode): the bus is busy
+			poll_frame = false;
+		}
+	}
 
-				break;
+	if (poll_frame) {
+		// only answer the most recent poll frame, allow a minimum of 500usec before reply
+		_sport_reply_pending = true;
+		ScheduleDelayed(SPORT_REPLY_DELAY);
 
+	} else if (_sport_header) {
+		// wait for ID byte
+		ScheduleDelayed(SPORT_ID_WAIT);
 
-			case SMARTPORT_POLL_2:
+	} else {
+		ScheduleDelayed(SPORT_POLL_INTERVAL);
+	}
+}
 
-				/* report battery current at 5Hz */
-				if (now_ms - lastCUR_ms > 200) {
-					lastCUR_ms = now_ms;
-					/* send battery current */
-					sPort_send_CUR(uart);
-					sentPackets++;
-				}
+void FrskyTelemetry::sport_reply(uint8_t id, const hrt_abstime &now)
+{
+	const uint32_t now_ms = now / 1000;
+	const int uart = _uart;
 
-				break;
+	/* get a local copy of the current sensor values
+	 * in order to apply a lowpass filter to baro pressure.
+	 */
+	vehicle_air_data_s airdata;
 
+	if (_vehicle_air_data_sub.update(&airdata)) {
+		if (isnan(_filtered_alt)) {
+			_filtered_alt = airdata.baro_alt_meter;
 
-			case SMARTPORT_POLL_3:
+		} else {
+			_filtered_alt = .05f * airdata.baro_alt_meter + .95f * _filtered_alt;
+		}
+	}
 
-				/* report altitude at 5Hz */
-				if (now_ms - lastALT_ms > 200) {
-					lastALT_ms = now_ms;
-					/* send altitude */
-					sPort_send_ALT(uart);
-					sentPackets++;
-				}
+	sPort_update_topics();
 
-				break;
+	switch (id) {
 
+	case SMARTPORT_POLL_1:
 
-			case SMARTPORT_POLL_4:
+		/* report BATV at 1Hz */
+		if (now_ms - _lastBATV_ms > 1000) {
+			_lastBATV_ms = now_ms;
+			/* send battery voltage */
+			sPort_send_BATV(uart);
+			_sent_packets++;
+		}
 
-				/* report speed at 5Hz */
-				if (now_ms - lastSPD_ms > 200) {
-					lastSPD_ms = now_ms;
-					/* send speed */
-					sPort_send_SPD(uart);
-					sentPackets++;
-				}
+		break;
 
-				break;
 
-			case SMARTPORT_POLL_5:
+	case SMARTPORT_POLL_2:
 
-				/* report fuel at 1Hz */
-				if (now_ms - lastFUEL_ms > 1000) {
-					lastFUEL_ms = now_ms;
-					/* send fuel */
-					sPort_send_FUEL(uart);
-					sentPackets++;
-				}
+		/* report battery current at 5Hz */
+		if (now_ms - _lastCUR_ms > 200) {
+			_lastCUR_ms = now_ms;
+			/* send battery current */
+			sPort_send_CUR(uart);
+			_sent_packets++;
+		}
 
-				break;
+		break;
 
-			case SMARTPORT_POLL_6:
 
-				/* report vertical speed at 10Hz */
-				if (now_ms - lastVSPD_ms > 100) {
-					/* estimate vertical speed using first difference and delta t */
-					uint32_t dt = now_ms - lastVSPD_ms;
-					float speed  = (filtered_alt - last_baro_alt) / (1e-3f * (float)dt);
+	case SMARTPORT_POLL_3:
 
-					/* save current alt and timestamp */
-					last_baro_alt = filtered_alt;
-					lastVSPD_ms = now_ms;
+		/* report altitude at 5Hz */
+		if (now_ms - _lastALT_ms > 200) {
+			_lastALT_ms = now_ms;
+			/* send altitude */
+			sPort_send_ALT(uart);
+			_sent_packets++;
+		}
 
-					sPort_send_VSPD(uart, speed);
-					sentPackets++;
-				}
+		break;
 
-				break;
 
-			case SMARTPORT_POLL_7:
+	case SMARTPORT_POLL_4:
 
-				/* report GPS data elements at 5*5Hz */
-				if (now_ms - lastGPS_ms > 100) {
-					static int elementCount = 0;
+		/* report speed at 5Hz */
+		if (now_ms - _lastSPD_ms > 200) {
+			_lastSPD_ms = now_ms;
+			/* send speed */
+			sPort_send_SPD(uart);
+			_sent_packets++;
+		}
 
-					switch (elementCount) {
+		break;
 
-					case 0:
-						sPort_send_GPS_LON(uart);
-						elementCount++;
-						break;
+	case SMARTPORT_POLL_5:
 
-					case 1:
-						sPort_send_GPS_LAT(uart);
-						elementCount++;
-						break;
+		/* report fuel at 1Hz */
+		if (now_ms - _lastFUEL_ms > 1000) {
+			_lastFUEL_ms = now_ms;
+			/* send fuel */
+			sPort_send_FUEL(uart);
+			_sent_packets++;
+		}
 
-					case 2:
-						sPort_send_GPS_CRS(uart);
-						elementCount++;
-						break;
+		break;
 
-					case 3:
-						sPort_send_GPS_ALT(uart);
-						elementCount++;
-						break;
+	case SMARTPORT_POLL_6:
 
-					case 4:
-						sPort_send_GPS_SPD(uart);
-						elementCount++;
-						break;
+		/* report vertical speed at 10Hz */
+		if (now_ms - _lastVSPD_ms > 100) {
+			/* estimate vertical speed using first difference and delta t */
+			uint32_t dt = now_ms - _lastVSPD_ms;
+			float speed  = (_filtered_alt - _last_baro_alt) / (1e-3f * (float)dt);
 
-					case 5:
-						sPort_send_GPS_TIME(uart);
-						elementCount = 0;
-						sentPackets += elementCount;
-						break;
-					}
+			/* save current alt and timestamp */
+			_last_baro_alt = _filtered_alt;
+			_lastVSPD_ms = now_ms;
 
-				}
+			sPort_send_VSPD(uart, speed);
+			_sent_packets++;
+		}
 
-			/* FALLTHROUGH */
+		break;
 
-			case SMARTPORT_POLL_8:
+	case SMARTPORT_POLL_7:
 
-				/* report nav_state as DIY_NAVSTATE 2Hz */
-				if (now_ms - lastNAV_STATE_ms > 500) {
-					lastNAV_STATE_ms = now_ms;
-					/* send T1 */
-					sPort_send_NAV_STATE(uart);
-					sentPackets++;
-				}
+		/* report GPS data elements at 5*5Hz */
+		if (now_ms - _lastGPS_ms > 100) {
+			switch (_gps_element) {
 
-				/* report satcount and fix as DIY_GPSFIX at 2Hz */
-				else if (now_ms - lastGPS_FIX_ms > 500) {
-					lastGPS_FIX_ms = now_ms;
-					/* send T2 */
-					sPort_send_GPS_FIX(uart);
-					sentPackets++;
-				}
+			case 0:
+				sPort_send_GPS_LON(uart);
+				_gps_element++;
+				break;
 
+			case 1:
+				sPort_send_GPS_LAT(uart);
+				_gps_element++;
 				break;
 
-			case SMARTPORT_SENSOR_ID_SP2UR: {
-					static int elementCount = 0;
+			case 2:
+				sPort_send_GPS_CRS(uart);
+				_gps_element++;
+				break;
 
-					switch (elementCount++ % 2) {
-					case 0:
-						sPort_send_flight_mode(uart);
-						sentPackets++;
-						break;
+			case 3:
+				sPort_send_GPS_ALT(uart);
+				_gps_element++;
+				break;
 
-					default:
-						sPort_send_GPS_info(uart);
-						sentPackets++;
-						break;
-					}
-				}
+			case 4:
+				sPort_send_GPS_SPD(uart);
+				_gps_element++;
+				break;
 
+			case 5:
+				sPort_send_GPS_TIME(uart);
+				_gps_element = 0;
+				_sent_packets += _gps_element;
 				break;
 			}
-		}
-
-		PX4_DEBUG("freeing sPort memory");
-		sPort_deinit();
 
-		/* either no traffic on the port (0=>timeout), or D type packet */
+		}
 
-	} else if (frsky_state == DTYPE) {
-		/* detected D type telemetry: reconfigure UART */
-		PX4_INFO("sending FrSky D type telemetry");
-		int status = set_uart_speed(uart, &uart_config, B9600);
-		set_uart_single_wire(uart, false);
+	/* FALLTHROUGH */
 
-		if (status < 0) {
-			PX4_DEBUG("error setting speed for %s, quitting", device_name);
-			/* Reset the UART flags to original state */
-			tcsetattr(uart, TCSANOW, &uart_config_original);
-			close(uart);
+	case SMARTPORT_POLL_8:
 
-			thread_running = false;
-			return 0;
+		/* report nav_state as DIY_NAVSTATE 2Hz */
+		if (now_ms - _lastNAV_STATE_ms > 500) {
+			_lastNAV_STATE_ms = now_ms;
+			/* send T1 */
+			sPort_send_NAV_STATE(uart);
+			_sent_packets++;
 		}
 
-		int iteration = 0;
-
-		/* Subscribe to topics */
-		if (!frsky_init()) {
-			PX4_ERR("could not allocate memory");
-			return -1;
+		/* report satcount and fix as DIY_GPSFIX at 2Hz */
+		else if (now_ms - _lastGPS_FIX_ms > 500) {
+			_lastGPS_FIX_ms = now_ms;
+			/* send T2 */
+			sPort_send_GPS_FIX(uart);
+			_sent_packets++;
 		}
 
-		struct adc_linkquality host_frame;
-
-		/* send D8 mode telemetry */
-		while (!thread_should_exit) {
-
-			/* Sleep 100 ms */
-			usleep(100000);
-
-			/* parse incoming data */
-			int nbytes = read(uart, &sbuf[0], sizeof(sbuf));
-			bool new_input = frsky_parse_host((uint8_t *)&sbuf[0], nbytes, &host_frame);
-
-			/* the RSSI value could be useful */
-			if (new_input) {
-				PX4_DEBUG("host frame: ad1:%u, ad2: %u, rssi: %u",
-					  host_frame.ad1, host_frame.ad2, host_frame.linkq);
-			}
-
-			frsky_update_topics();
+		break;
 
-			/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
-			if (iteration % 2 == 0) {
-				frsky_send_frame1(uart);
-				sentPackets++;
-			}
-
-			/* Send frame 2 (every 1000ms): course, latitude, longitude, speed, altitude (GPS), fuel level */
-			if (iteration % 10 == 0) {
-				frsky_send_frame2(uart);
-				sentPackets++;
-			}
+	case SMARTPORT_SENSOR_ID_SP2UR: {
+			switch (_sp2ur_element++ % 2) {
+			case 0:
+				sPort_send_flight_mode(uart);
+				_sent_packets++;
+				break;
 
-			/* Send frame 3 (every 5000ms): date, time */
-			if (iteration % 50 == 0) {
-				frsky_send_frame3(uart);
-				sentPackets++;
-				iteration = 0;
+			default:
+				sPort_send_GPS_info(uart);
+				_sent_packets++;
+				break;
 			}
-
-			iteration++;
 		}
 
-//		/* TODO: flush the input buffer if in full duplex mode */
-//		read(uart, &sbuf[0], sizeof(sbuf));
-		PX4_DEBUG("freeing frsky memory");
-		frsky_deinit();
+		break;
+	}
+}
 
+void FrskyTelemetry::run_dtype()
+{
+	/* parse incoming data */
+	const int nbytes = read(_uart, &_sbuf[0], sizeof(_sbuf));
+	struct adc_linkquality host_frame;
+	bool new_input = frsky_parse_host(&_sbuf[0], nbytes, &host_frame);
+
+	/* the RSSI value could be useful */
+	if (new_input) {
+		PX4_DEBUG("host frame: ad1:%u, ad2: %u, rssi: %u",
+			  host_frame.ad1, host_frame.ad2, host_frame.linkq);
 	}
 
-	/* Reset the UART flags to original state */
-	tcsetattr(uart, TCSANOW, &uart_config_original);
+	frsky_update_topics();
+
+	/* Send frame 1 (every 200ms): acceleration values, altitude (vario), temperatures, current & voltages, RPM */
+	if (_iteration % 2 == 0) {
+		frsky_send_frame1(_uart);
+		_sent_packets++;
+	}
 
-	close(uart);
+	/* Send frame 2 (every 1000ms): course, latitude, longitude, speed, altitude (GPS), fuel level */
+	if (_iteration % 10 == 0) {
+		frsky_send_frame2(_uart);
+		_sent_packets++;
+	}
 
-	device_name = NULL;
+	/* Send frame 3 (every 5000ms): date, time */
+	if (_iteration % 50 == 0) {
+		frsky_send_frame3(_uart);
+		_sent_packets++;
+		_iteration = 0;
+	}
 
-	thread_running = false;
+	_iteration++;
 
-	return 0;
+	ScheduleDelayed(DTYPE_INTERVAL);
 }
 
-/**
- * The main command function.
- * Processes command line arguments and starts the daemon.
- */
-int frsky_telemetry_main(int argc, char *argv[])
+int FrskyTelemetry::task_spawn(int argc, char *argv[])
 {
+	const char *device_name = "/dev/ttyS6"; /* default USART8 */
+	uint32_t scanning_timeout_ms = 0;
+	frsky_state_t state = SCANNING;
 
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
 
-	if (argc < 2) {
-		PX4_ERR("missing command");
-		usage();
-		return -1;
-	}
-
-	if (!strcmp(argv[1], "start")) {
-
-		if (thread_running) {
-			PX4_INFO("frsky_telemetry already running");
-			return 0;
-		}
+	while ((ch = px4_getopt(argc, argv, "d:t:m:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			device_name = myoptarg;
+			break;
 
-		thread_should_exit = false;
-		frsky_task = px4_task_spawn_cmd("frsky_telemetry",
-						SCHED_DEFAULT,
-						SCHED_PRIORITY_DEFAULT + 4,
-						1400,
-						frsky_telemetry_thread_main,
-						(char *const *)argv);
+		case 't':
+			scanning_timeout_ms = strtoul(myoptarg, nullptr, 10) * 1000;
+			break;
 
-		while (!thread_running) {
-			usleep(200);
-		}
+		case 'm':
+			if (!strcmp(myoptarg, "sport")) {
+				state = SPORT;
 
-		return 0;
-	}
+			} else if (!strcmp(myoptarg, "sport_single")) {
+				state = SPORT_SINGLE_WIRE;
 
-	if (!strcmp(argv[1], "stop")) {
+			} else if (!strcmp(myoptarg, "dtype")) {
+				state = DTYPE;
 
-		if (!thread_running) {
-			PX4_WARN("frsky_telemetry already stopped");
-			return 0;
-		}
+			} else if (!strcmp(myoptarg, "auto")) {
+			} else {
+				print_usage("unknown mode");
+				return PX4_ERROR;
+			}
 
-		thread_should_exit = true;
+			break;
 
-		while (thread_running) {
-			usleep(1000000);
-			PX4_INFO(".");
+		default:
+			print_usage("unrecognized flag");
+			return PX4_ERROR;
 		}
-
-		PX4_INFO("terminated.");
-		device_name = NULL;
-		return 0;
 	}
 
-	if (!strcmp(argv[1], "status")) {
-		if (thread_running) {
-			switch (frsky_state) {
+	FrskyTelemetry *instance = new FrskyTelemetry(device_name, state, scanning_timeout_ms);
 
-			case SCANNING:
-				PX4_INFO("running: SCANNING");
-				PX4_INFO("port: %s", device_name);
-				break;
+	if (instance == nullptr) {
+		PX4_ERR("alloc failed");
+		return PX4_ERROR;
+	}
 
-			case SPORT:
-				PX4_INFO("running: SPORT");
-				PX4_INFO("port: %s", device_name);
-				PX4_INFO("packets sent: %ld", sentPackets);
-				break;
+	_object.store(instance);
+	_task_id = task_id_is_work_queue;
 
-			case SPORT_SINGLE_WIRE:
-				PX4_INFO("running: SPORT (single wire)");
-				PX4_INFO("port: %s", device_name);
-				PX4_INFO("packets sent: %ld", sentPackets);
-				break;
+	instance->ScheduleNow();
 
-			case DTYPE:
-				PX4_INFO("running: DTYPE");
-				PX4_INFO("port: %s", device_name);
-				PX4_INFO("packets sent: %ld", sentPackets);
-				break;
-			}
+	return PX4_OK;
+}
 
-			return 0;
+int FrskyTelemetry::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
 
-		} else {
-			PX4_INFO("not running");
-			return 0;
-		}
+int FrskyTelemetry::print_status()
+{
+	switch (_state) {
+	case SCANNING:
+		PX4_INFO("running: SCANNING");
+		PX4_INFO("port: %s", _device);
+		break;
+
+	case SPORT:
+		PX4_INFO("running: SPORT");
+		PX4_INFO("port: %s", _device);
+		PX4_INFO("packets sent: %ld", _sent_packets);
+		break;
+
+	case SPORT_SINGLE_WIRE:
+		PX4_INFO("running: SPORT (single wire)");
+		PX4_INFO("port: %s", _device);
+		PX4_INFO("packets sent: %ld", _sent_packets);
+		break;
+
+	case DTYPE:
+		PX4_INFO("running: DTYPE");
+		PX4_INFO("port: %s", _device);
+		PX4_INFO("packets sent: %ld", _sent_packets);
+		break;
 	}
 
-	PX4_ERR("unrecognized command");
-	usage();
 	return 0;
 }
 
 /**
  * Print command usage information
  */
-static void usage()
+int FrskyTelemetry::print_usage(const char *reason)
 {
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
 	PRINT_MODULE_DESCRIPTION("FrSky Telemetry support. Auto-detects D or S.PORT protocol.");
 
 	PRINT_MODULE_USAGE_NAME("frsky_telemetry", "communication");
@@ -803,6 +913,12 @@ static void usage()
 	PRINT_MODULE_USAGE_PARAM_INT('t', 0, 0, 60, "Scanning timeout [s] (default: no timeout)", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('m', "auto", "sport|sport_single|dtype", "Select protocol (default: auto-detect)",
 					true);
-	PRINT_MODULE_USAGE_COMMAND("stop");
-	PRINT_MODULE_USAGE_COMMAND("status");
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+extern "C" __EXPORT int frsky_telemetry_main(int argc, char *argv[])
+{
+	return FrskyTelemetry::main(argc, argv);
 }
@@ -56,7 +56,7 @@ open_uart(const char *device)
 
 	if (uart < 0) {
 		PX4_ERR("opening %s", device);
-		return 1;
+		return -1;
 	}
 
 	/* Back up the original uart configuration to restore it after exit */
@@ -66,7 +66,7 @@ open_uart(const char *device)
 	if ((termios_state = tcgetattr(uart, &uart_config_original)) < 0) {
 		close(uart);
 		PX4_ERR("%s: %d", device, termios_state);
-		return 1;
+		return -1;
 	}
 
 	/* Fill the struct for the new configuration */
@@ -80,13 +80,13 @@ open_uart(const char *device)
 	if (cfsetispeed(&uart_config, speed) < 0 || cfsetospeed(&uart_config, speed) < 0) {
 		close(uart);
 		PX4_ERR("%s: %d (cfsetispeed, cfsetospeed)", device, termios_state);
-		return 1;
+		return -1;
 	}
 
 	if ((termios_state = tcsetattr(uart, TCSANOW, &uart_config)) < 0) {
 		close(uart);
 		PX4_ERR("%s (tcsetattr)", device);
-		return 1;
+		return -1;
 	}
 
 	/* Activate single wire mode */
@@ -46,328 +46,411 @@
 #include <fcntl.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/tasks.h>
-#include <poll.h>
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <drivers/drv_hrt.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <sys/ioctl.h>
 #include <unistd.h>
-#include <systemlib/err.h>
 #include <perf/perf_counter.h>
 
 #include "../comms.h"
 #include "../messages.h"
 
-#define DEFAULT_UART "/dev/ttyS6";		/**< Serial4 */
+#define DEFAULT_UART "/dev/ttyS6"		/**< Serial4 */
 
-static int thread_should_exit = false;		/**< Deamon exit flag */
-static int thread_running = false;		/**< Deamon status flag */
-static int deamon_task;				/**< Handle of deamon task / thread */
-static const char daemon_name[] = "hott_telemetry";
-static const char commandline_usage[] =
-	"usage: hott_telemetry start|status|stop [-d <device>] [-t <timeout ms>] [-r <read delay us>] [-w <write delay us>]";
-
-static uint8_t read_log[16];
-
-static int timeout_ms = POLL_TIMEOUT_IN_MSECS;
-static int read_delay_us = POST_READ_DELAY_IN_USECS;
-static int write_delay_us = POST_WRITE_DELAY_IN_USECS;
-
-perf_counter_t	reqs_count;
-perf_counter_t	connect_count;
-perf_counter_t	recon_port;
-perf_counter_t	bin_reply;
-perf_counter_t	txt_reply;
-perf_counter_t	bad_reply;
-perf_counter_t	dead_reply;
+using namespace time_literals;
 
 /**
- * Deamon management function.
+ * HoTT telemetry driver, running on the work queue of its serial port.
+ * The UART is read non-blocking and the reply is sent byte by byte with the required
+ * pauses by rescheduling the work item, instead of sleeping in a dedicated task.
  */
-extern "C" __EXPORT int hott_telemetry_main(int argc, char *argv[]);
+class HottTelemetry : public ModuleBase<HottTelemetry>, public px4::ScheduledWorkItem
+{
+public:
+	HottTelemetry(const char *device, int timeout_ms, int read_delay_us, int write_delay_us);
+	~HottTelemetry() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+private:
+	void Run() override;
+
+	/**
+	 * Open the UART in non-blocking mode.
+	 * @return true on success
+	 */
+	bool open_port();
+
+	/**
+	 * Listen for a poll from the receiver and prepare the reply.
+	 */
+	void receive(const hrt_abstime &now);
+
+	/**
+	 * Send the next byte of the reply.
+	 */
+	void send();
+
+	/**
+	 * Build the reply for a polled sensor ID.
+	 * @return true if the sensor is supported and a reply is ready
+	 */
+	bool build_response(uint8_t id);
+
+	static constexpr hrt_abstime RECEIVE_INTERVAL{1_ms};	///< a request byte takes ~0.5 ms at 19200 baud
+
+	enum class State {
+		Receive,
+		Send,
+	} _state{State::Receive};
+
+	char _device[20] {};
+	int _uart{-1};
+
+	const int _timeout_ms;
+	const int _read_delay_us;
+	const int _write_delay_us;
+
+	uint8_t _read_log[16] {};
+
+	uint8_t _buffer[MAX_MESSAGE_BUFFER_SIZE] {};
+	size_t _size{0};
+	size_t _tx_index{0};
+
+	bool _mode_received{false};	///< binary mode request byte received, the sensor ID follows
+	bool _connected{true};
+	int _recon{0};
+	hrt_abstime _last_request{0};
+
+	perf_counter_t _connect_count{perf_alloc(PC_COUNT, MODULE_NAME": reconnects")};
+	perf_counter_t _recon_port{perf_alloc(PC_COUNT, MODULE_NAME": reopen port")};
+	perf_counter_t _reqs_count{perf_alloc(PC_COUNT, MODULE_NAME": requests")};
+	perf_counter_t _bin_reply{perf_alloc(PC_COUNT, MODULE_NAME": bin replies")};
+	perf_counter_t _txt_reply{perf_alloc(PC_COUNT, MODULE_NAME": text replies")};
+	perf_counter_t _bad_reply{perf_alloc(PC_COUNT, MODULE_NAME": unknown replies")};
+	perf_counter_t _dead_reply{perf_alloc(PC_COUNT, MODULE_NAME": dead replies")};
+};
+
+HottTelemetry::HottTelemetry(const char *device, int timeout_ms, int read_delay_us, int write_delay_us) :
+	ScheduledWorkItem(MODULE_NAME, px4::serial_port_to_wq(device)),
+	_timeout_ms(timeout_ms),
+	_read_delay_us(read_delay_us),
+	_write_delay_us(write_delay_us)
+{
+	strncpy(_device, device, sizeof(_device) - 1);
+	_device[sizeof(_device) - 1] = '\0';
+}
 
-/**
- * Mainloop of daemon.
- */
-int hott_telemetry_thread_main(int argc, char *argv[]);
+HottTelemetry::~HottTelemetry()
+{
+	if (_uart >= 0) {
+		close(_uart);
+	}
 
-static int recv_req_id(int uart, uint8_t *id);
-static int send_data(int uart, uint8_t *buffer, size_t size);
+	perf_free(_connect_count);
+	perf_free(_recon_port);
+	perf_free(_reqs_count);
+	perf_free(_bin_reply);
+	perf_free(_txt_reply);
+	perf_free(_bad_reply);
+	perf_free(_dead_reply);
+}
 
-int
-recv_req_id(int uart, uint8_t *id)
+bool HottTelemetry::open_port()
 {
-	uint8_t mode;
+	/* enable UART, writes potentially an empty buffer, but multiplexing is disabled */
+	_uart = open_uart(_device);
 
-	struct pollfd fds;
-	fds.fd = uart;
-	fds.events = POLLIN;
+	if (_uart < 0) {
+		return false;
+	}
 
-	if (poll(&fds, 1, timeout_ms) > 0) {
-		/* Get the mode: binary or text  */
-		read(uart, &mode, sizeof(mode));
+	fcntl(_uart, F_SETFL, fcntl(_uart, F_GETFL, 0) | O_NONBLOCK);
 
-		perf_count(reqs_count);
+	return true;
+}
 
-		// Debug log
-		for (int x = 15; x > 0; x--) {
-			read_log[x] = read_log[x - 1];
-		}
+void HottTelemetry::Run()
+{
+	if (should_exit()) {
+		exit_and_cleanup();
+		return;
+	}
 
-		read_log[0] = mode;
+	const hrt_abstime now = hrt_absolute_time();
 
-		/* if we have a binary mode request */
-		if (mode != BINARY_MODE_REQUEST_ID) {
-			return PX4_ERROR;
+	if (_uart < 0) {
+		// open the port and subscribe from the work queue thread, file descriptors are not shared with the starting task
+		if (!open_port()) {
+			PX4_ERR("Failed opening HoTT UART, exiting.");
+			exit_and_cleanup();
+			return;
 		}
 
-		/* Read the device ID being polled */
-		read(uart, id, sizeof(*id));
+		init_sub_messages();
+		_last_request = now;
+	}
+
+	if (_state == State::Send) {
+		send();
 
 	} else {
-		warnx("UART timeout on TX/RX port");
-		return PX4_ERROR;
+		receive(now);
 	}
-
-	return PX4_OK;
 }
 
-int
-send_data(int uart, uint8_t *buffer, size_t size)
+void HottTelemetry::receive(const hrt_abstime &now)
 {
-	usleep(read_delay_us);
+	uint8_t buf[8];
+	const int nbytes = read(_uart, &buf[0], sizeof(buf));
+
+	for (int i = 0; i < nbytes; i++) {
+		if (_mode_received) {
+			// Read the device ID being polled
+			_mode_received = false;
+			_last_request = now;
+			_connected = true;
+
+			if (build_response(buf[i])) {
+				// The receiver demands a period of silence after its request, the reply starts after the read delay
+				_state = State::Send;
+				_tx_index = 0;
+				ScheduleDelayed(_read_delay_us);
+				return;
+			}
 
-	uint16_t checksum = 0;
+			continue;
+		}
 
-	for (size_t i = 0; i < size; i++) {
-		if (i == size - 1) {
-			/* Set the checksum: the first uint8_t is taken as the checksum. */
-			buffer[i] = checksum & 0xff;
+		// Get the mode: binary or text
+		perf_count(_reqs_count);
 
-		} else {
-			checksum += buffer[i];
+		// Debug log
+		for (int x = 15; x > 0; x--) {
+			_read_log[x] = _read_log[x - 1];
 		}
 
-		write(uart, &buffer[i], sizeof(buffer[i]));
+		_read_log[0] = buf[i];
 
-		/* Sleep before sending the next byte. */
-		usleep(write_delay_us);
+		// only binary mode requests are answered
+		_mode_received = (buf[i] == BINARY_MODE_REQUEST_ID);
 	}
 
-	/* A hack the reads out what was written so the next read from the receiver doesn't get it. */
-	/* TODO: Fix this!! */
-	uint8_t dummy[size];
-	read(uart, &dummy, size);
-
-	return PX4_OK;
-}
+	if (now - _last_request > (hrt_abstime)_timeout_ms * 1000) {
+		PX4_WARN("UART timeout on TX/RX port");
+		_last_request = now;
+		_mode_received = false;
 
-int
-hott_telemetry_thread_main(int argc, char *argv[])
-{
-	connect_count = perf_alloc(PC_COUNT,	"reconnects       ");
-	recon_port = perf_alloc(PC_COUNT,		"reopen port      ");
-	reqs_count = perf_alloc(PC_COUNT,		"requests        ");
-	bin_reply = perf_alloc(PC_COUNT,		"bin replies     ");
-	txt_reply = perf_alloc(PC_COUNT,		"text replies    ");
-	bad_reply = perf_alloc(PC_COUNT,		"unknown replies ");
-	dead_reply = perf_alloc(PC_COUNT,		"dead replies    ");
+		if (_connected) {
+			_connected = false;
 
-	thread_running = true;
-
-	const char *device = DEFAULT_UART;
+		} else {
+			_recon++;
+		}
 
-	/* read commandline arguments */
-	for (int i = 0; i < argc && argv[i]; i++) {
-		if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--device") == 0) { //device set
-			if (argc > i + 1) {
-				device = argv[i + 1];
+		if (_recon > 100) {
+			perf_count(_recon_port);
+			_recon = 0;
+			close(_uart);
 
-			} else {
-				thread_running = false;
-				errx(1, "missing parameter to -d\n%s", commandline_usage);
+			if (!open_port()) {
+				PX4_ERR("Failed opening HoTT UART, exiting.");
+				exit_and_cleanup();
+				return;
 			}
+
+			perf_reset(_reqs_count);
+			perf_reset(_bin_reply);
+			perf_reset(_txt_reply);
+			perf_reset(_dead_reply);
+			perf_reset(_bad_reply);
 		}
 	}
 
-	/* enable UART, writes potentially an empty buffer, but multiplexing is disabled */
-	int uart = open_uart(device);
+	ScheduleDelayed(RECEIVE_INTERVAL);
+}
 
-	if (uart < 0) {
-		errx(1, "Failed opening HoTT UART, exiting.");
-		thread_running = false;
+bool HottTelemetry::build_response(uint8_t id)
+{
+	switch (id) {
+	case EAM_SENSOR_ID:
+		build_eam_response(_buffer, &_size);
+		perf_count(_bin_reply);
+		break;
+
+	case GAM_SENSOR_ID:
+		build_gam_response(_buffer, &_size);
+		perf_count(_bin_reply);
+		break;
+
+	case GPS_SENSOR_ID:
+		build_gps_response(_buffer, &_size);
+		perf_count(_bin_reply);
+		break;
+
+	case BINARY_MODE_REQUEST_ID:
+		perf_count(_dead_reply);
+		return false;
+
+	default:
+		perf_count(_bad_reply);
+		return false;	// Not a module we support.
 	}
 
-	init_sub_messages();
-
-	uint8_t buffer[MAX_MESSAGE_BUFFER_SIZE];
-	size_t size = 0;
-	uint8_t id = 0;
-
-	bool connected = true;
-	int recon = 0;
+	if (_size == 0 || _size > sizeof(_buffer)) {
+		return false;
+	}
 
-	while (!thread_should_exit) {
-		// Listen for and serve poll from the receiver.
-		if (recv_req_id(uart, &id) == PX4_OK) {
-			if (!connected) {
-				connected = true;
-			}
+	/* Set the checksum: the last uint8_t is the lower 8 bits of the sum of all other bytes. */
+	uint16_t checksum = 0;
 
-			switch (id) {
-			case EAM_SENSOR_ID:
-				build_eam_response(buffer, &size);
-				perf_count(bin_reply);
-				break;
-
-			case GAM_SENSOR_ID:
-				build_gam_response(buffer, &size);
-				perf_count(bin_reply);
-				break;
-
-			case GPS_SENSOR_ID:
-				build_gps_response(buffer, &size);
-				perf_count(bin_reply);
-				break;
-
-			case BINARY_MODE_REQUEST_ID:
-				perf_count(dead_reply);
-				break;
-
-			default:
-				perf_count(bad_reply);
-				continue;	// Not a module we support.
-			}
+	for (size_t i = 0; i < _size - 1; i++) {
+		checksum += _buffer[i];
+	}
 
-			send_data(uart, buffer, size);
+	_buffer[_size - 1] = checksum & 0xff;
 
-		} else {
-			if (connected) {
-				connected = false;
+	return true;
+}
 
-			} else {
-				recon++;
-			}
+void HottTelemetry::send()
+{
+	if (_tx_index < _size) {
+		write(_uart, &_buffer[_tx_index], sizeof(_buffer[_tx_index]));
+		_tx_index++;
 
-			if (recon > 100) {
-				perf_count(recon_port);
-				close(uart);
-				uart = open_uart(device);
-				perf_reset(reqs_count);
-				perf_reset(bin_reply);
-				perf_reset(txt_reply);
-				perf_reset(dead_reply);
-				perf_reset(bad_reply);
-			}
-		}
+		/* Pause before sending the next byte. */
+		ScheduleDelayed(_write_delay_us);
+		return;
 	}
 
-	warnx("exiting");
-
-	close(uart);
-
-	thread_running = false;
+	/* Read out what was written (single wire) so the next read from the receiver doesn't get it. */
+	uint8_t dummy[MAX_MESSAGE_BUFFER_SIZE];
 
-	perf_free(connect_count);
-	perf_free(recon_port);
-	perf_free(reqs_count);
-	perf_free(bin_reply);
-	perf_free(txt_reply);
-	perf_free(bad_reply);
-	perf_free(dead_reply);
+	while (read(_uart, &dummy[0], sizeof(dummy)) > 0) {}
 
-	return 0;
+	_state = State::Receive;
+	ScheduleDelayed(RECEIVE_INTERVAL);
 }
 
-/**
- * Process command line arguments and start the daemon.
- */
-int
-hott_telemetry_main(int argc, char *argv[])
+int HottTelemetry::task_spawn(int argc, char *argv[])
 {
-	if (argc < 2) {
-		errx(1, "missing command\n%s", commandline_usage);
+	const char *device = DEFAULT_UART;
+	int timeout_ms = POLL_TIMEOUT_IN_MSECS;
+	int read_delay_us = POST_READ_DELAY_IN_USECS;
+	int write_delay_us = POST_WRITE_DELAY_IN_USECS;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "d:t:r:w:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'd':
+			device = myoptarg;
+			break;
+
+		case 't':
+			timeout_ms = atoi(myoptarg);
+			break;
+
+		case 'r':
+			read_delay_us = atoi(myoptarg);
+			break;
+
+		case 'w':
+			write_delay_us = atoi(myoptarg);
+			break;
+
+		default:
+			print_usage("unrecognized flag");
+			return PX4_ERROR;
+		}
 	}
 
-	/* read commandline arguments */
-	for (int i = 0; i < argc && argv[i]; i++) {
-		if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--timeout") == 0) { //device set
-			if (argc > i + 1) {
-				timeout_ms = atoi(argv[i + 1]);
+	HottTelemetry *instance = new HottTelemetry(device, timeout_ms, read_delay_us, write_delay_us);
 
-			} else {
-				errx(1, "missing parameter to -t\n%s", commandline_usage);
-			}
-		}
-
-		if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--read-delay") == 0) { //device set
-			if (argc > i + 1) {
-				read_delay_us = atoi(argv[i + 1]);
+	if (instance == nullptr) {
+		PX4_ERR("alloc failed");
+		return PX4_ERROR;
+	}
 
-			} else {
-				errx(1, "missing parameter to -r\n%s", commandline_usage);
-			}
-		}
+	_object.store(instance);
+	_task_id = task_id_is_work_queue;
 
-		if (strcmp(argv[i], "-w") == 0 || strcmp(argv[i], "--write-delay") == 0) { //device set
-			if (argc > i + 1) {
-				write_delay_us = atoi(argv[i + 1]);
+	instance->ScheduleNow();
 
-			} else {
-				errx(1, "missing parameter to -w\n%s", commandline_usage);
-			}
-		}
-	}
+	return PX4_OK;
+}
 
-	if (!strcmp(argv[1], "start")) {
+int HottTelemetry::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
 
-		if (thread_running) {
-			warnx("already running");
-			exit(0);
-		}
+int HottTelemetry::print_status()
+{
+	PX4_INFO("port: %s", _device);
 
-		thread_should_exit = false;
-		deamon_task = px4_task_spawn_cmd(daemon_name,
-						 SCHED_DEFAULT,
-						 SCHED_PRIORITY_DEFAULT,
-						 1500,
-						 hott_telemetry_thread_main,
-						 (argv) ? (char *const *)&argv[2] : (char *const *)NULL);
-		exit(0);
+	for (int x = 15; x >= 0; x--) {
+		printf("%2x ", _read_log[x]);
 	}
 
-	if (!strcmp(argv[1], "stop")) {
-		thread_should_exit = true;
-		exit(0);
-	}
+	printf("\npoll timeout     : %i ms\n", _timeout_ms);
+	printf("post write delay : %i us\n", _write_delay_us);
+	printf("post read delay  : %i us\n", _read_delay_us);
+	perf_print_counter(_recon_port);
+	perf_print_counter(_connect_count);
+	perf_print_counter(_reqs_count);
+	perf_print_counter(_bin_reply);
+	perf_print_counter(_txt_reply);
+	perf_print_counter(_bad_reply);
+	perf_print_counter(_dead_reply);
 
-	if (!strcmp(argv[1], "status")) {
-		if (thread_running) {
-			warnx("is running");
+	return 0;
+}
 
+int HottTelemetry::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
 
-			for (int x = 15; x >= 0; x--) {
-				printf("%2x ", read_log[x]);
-			}
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Graupner HoTT telemetry. The HoTT receiver polls each device at a regular interval, at which point
+a data packet is returned for the emulated Electric Air, General Air and GPS modules.
 
-			printf("\npoll timeout     : %i ms\n", timeout_ms);
-			printf("post write delay : %i us\n", write_delay_us);
-			printf("post read delay  : %i us\n", read_delay_us);
-			perf_print_counter(recon_port);
-			perf_print_counter(connect_count);
-			perf_print_counter(reqs_count);
-			perf_print_counter(bin_reply);
-			perf_print_counter(txt_reply);
-			perf_print_counter(bad_reply);
-			perf_print_counter(dead_reply);
+)DESCR_STR");
 
-		} else {
-			warnx("not started");
-		}
+	PRINT_MODULE_USAGE_NAME("hott_telemetry", "communication");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_PARAM_STRING('d', DEFAULT_UART, "<file:dev>", "Select Serial Device", true);
+	PRINT_MODULE_USAGE_PARAM_INT('t', POLL_TIMEOUT_IN_MSECS, 0, 10000, "Poll timeout [ms]", true);
+	PRINT_MODULE_USAGE_PARAM_INT('r', POST_READ_DELAY_IN_USECS, 0, 10000, "Delay after a request before replying [us]",
+				     true);
+	PRINT_MODULE_USAGE_PARAM_INT('w', POST_WRITE_DELAY_IN_USECS, 0, 10000, "Delay between reply bytes [us]", true);
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
-		exit(0);
-	}
+	return 0;
+}
 
-	errx(1, "unrecognized command\n%s", commandline_usage);
+extern "C" __EXPORT int hott_telemetry_main(int argc, char *argv[])
+{
+	return HottTelemetry::main(argc, argv);
 }
@@ -52,10 +52,15 @@ UavcanEscController::UavcanEscController(uavcan::INode &node) :
 	_orb_timer(node)
 {
 	_uavcan_pub_raw_cmd.setPriority(UAVCAN_COMMAND_TRANSFER_PRIORITY);
+	pthread_mutex_init(&_pending_mutex, nullptr);
 }
 
 UavcanEscController::~UavcanEscController()
 {
+	pthread_mutex_destroy(&_pending_mutex);
+	perf_free(_cmd_interval_perf);
+	perf_free(_cmd_latency_perf);
+	perf_free(_cmd_deferred_perf);
 }
 
 int
@@ -77,7 +82,8 @@ UavcanEscController::init()
 }
 
 void
-UavcanEscController::update_outputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs)
+UavcanEscController::update_outputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+				    bool node_locked, hrt_abstime timestamp_sample)
 {
 	if (num_outputs > uavcan::equipment::esc::RawCommand::FieldTypes::cmd::MaxSize) {
 		num_outputs = uavcan::equipment::esc::RawCommand::FieldTypes::cmd::MaxSize;
@@ -132,11 +138,71 @@ UavcanEscController::update_outputs(bool stop_motors, uint16_t outputs[MAX_ACTUA
 
 	msg.cmd.resize(_max_number_of_nonzero_outputs);
 
+	if (!node_locked) {
+		// the node thread is spinning, hand the command over instead of waiting for it
+		pthread_mutex_lock(&_pending_mutex);
+		_pending_cmd = msg;
+		_pending_timestamp_sample = timestamp_sample;
+		_cmd_pending = true;
+		pthread_mutex_unlock(&_pending_mutex);
+		perf_count(_cmd_deferred_perf);
+		return;
+	}
+
+	// a newer command supersedes a deferred one
+	pthread_mutex_lock(&_pending_mutex);
+	_cmd_pending = false;
+	pthread_mutex_unlock(&_pending_mutex);
+
+	broadcast_command(msg, timestamp_sample);
+}
+
+void
+UavcanEscController::publish_pending()
+{
+	uavcan::equipment::esc::RawCommand msg;
+	hrt_abstime timestamp_sample = 0;
+	bool pending = false;
+
+	pthread_mutex_lock(&_pending_mutex);
+
+	if (_cmd_pending) {
+		msg = _pending_cmd;
+		timestamp_sample = _pending_timestamp_sample;
+		_cmd_pending = false;
+		pending = true;
+	}
+
+	pthread_mutex_unlock(&_pending_mutex);
+
+	if (pending) {
+		broadcast_command(msg, timestamp_sample);
+	}
+}
+
+void
+UavcanEscController::broadcast_command(const uavcan::equipment::esc::RawCommand &msg, hrt_abstime timestamp_sample)
+{
 	/*
 	 * Publish the command message to the bus
 	 * Note that for a quadrotor it takes one CAN frame
 	 */
 	_uavcan_pub_raw_cmd.broadcast(msg);
+
+	perf_count(_cmd_interval_perf);
+
+	if (timestamp_sample > 0) {
+		// controls sample to command on the bus (TX queue) latency
+		perf_set_elapsed(_cmd_latency_perf, hrt_elapsed_time(&timestamp_sample));
+	}
+}
+
+void
+UavcanEscController::print_status() const
+{
+	perf_print_counter(_cmd_interval_perf);
+	perf_print_counter(_cmd_latency_perf);
+	perf_print_counter(_cmd_deferred_perf);
 }
 
 void
@@ -53,6 +53,7 @@
 #include <uORB/topics/esc_status.h>
 #include <drivers/drv_hrt.h>
 #include <lib/mixer_module/mixer_module.hpp>
+#include <pthread.h>
 
 class UavcanEscController
 {
@@ -66,7 +67,21 @@ public:
 
 	int init();
 
-	void update_outputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs);
+	/**
+	 * Build the ESC command and broadcast it.
+	 * @param node_locked true if the caller holds the node mutex. Otherwise the command is kept pending
+	 *                    and broadcast by the node thread via publish_pending().
+	 * @param timestamp_sample sample time of the controls the outputs are based on (0 if unknown)
+	 */
+	void update_outputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
+			    bool node_locked = true, hrt_abstime timestamp_sample = 0);
+
+	/**
+	 * Broadcast a command deferred by update_outputs(), must be called with the node mutex held.
+	 */
+	void publish_pending();
+
+	void print_status() const;
 
 	/**
 	 * Sets the number of rotors
@@ -91,6 +106,8 @@ private:
 	 */
 	uint8_t check_escs_status();
 
+	void broadcast_command(const uavcan::equipment::esc::RawCommand &msg, hrt_abstime timestamp_sample);
+
 	static constexpr unsigned ESC_STATUS_UPDATE_RATE_HZ = 10;
 	static constexpr unsigned UAVCAN_COMMAND_TRANSFER_PRIORITY = 5;	///< 0..31, inclusive, 0 - highest, 31 - lowest
 
@@ -119,4 +136,16 @@ private:
 	 * ESC states
 	 */
 	uint8_t				_max_number_of_nonzero_outputs{0};
+
+	/*
+	 * Command deferred while the node was busy (fast path only)
+	 */
+	pthread_mutex_t					_pending_mutex;
+	uavcan::equipment::esc::RawCommand		_pending_cmd;
+	hrt_abstime					_pending_timestamp_sample{0};
+	bool						_cmd_pending{false};
+
+	perf_counter_t	_cmd_interval_perf{perf_alloc(PC_INTERVAL, "uavcan: esc cmd interval")};
+	perf_counter_t	_cmd_latency_perf{perf_alloc(PC_ELAPSED, "uavcan: esc cmd latency")};
+	perf_counter_t	_cmd_deferred_perf{perf_alloc(PC_COUNT, "uavcan: esc cmd deferred")};
 };
@@ -43,7 +43,7 @@
 const char *const UavcanAirspeedBridge::NAME = "airspeed";
 
 UavcanAirspeedBridge::UavcanAirspeedBridge(uavcan::INode &node) :
-	UavcanCDevSensorBridgeBase("uavcan_airspeed", "/dev/uavcan/airspeed", AIRSPEED_BASE_DEVICE_PATH, ORB_ID(airspeed)),
+	UavcanSensorBridgeBase("uavcan_airspeed", ORB_ID(airspeed)),
 	_sub_ias_data(node),
 	_sub_tas_data(node),
 	_sub_oat_data(node)
@@ -51,13 +51,7 @@ UavcanAirspeedBridge::UavcanAirspeedBridge(uavcan::INode &node) :
 
 int UavcanAirspeedBridge::init()
 {
-	int res = device::CDev::init();
-
-	if (res < 0) {
-		return res;
-	}
-
-	res = _sub_ias_data.start(IASCbBinder(this, &UavcanAirspeedBridge::ias_sub_cb));
+	int res = _sub_ias_data.start(IASCbBinder(this, &UavcanAirspeedBridge::ias_sub_cb));
 
 	if (res < 0) {
 		DEVICE_LOG("failed to start uavcan sub: %d", res);
@@ -44,24 +44,15 @@
 
 const char *const UavcanBarometerBridge::NAME = "baro";
 
-#define UAVCAN_BARO_BASE_DEVICE_PATH "/dev/uavcan/baro"
-
 UavcanBarometerBridge::UavcanBarometerBridge(uavcan::INode &node) :
-	UavcanCDevSensorBridgeBase("uavcan_baro", UAVCAN_BARO_BASE_DEVICE_PATH, UAVCAN_BARO_BASE_DEVICE_PATH,
-				   ORB_ID(sensor_baro)),
+	UavcanSensorBridgeBase("uavcan_baro", ORB_ID(sensor_baro)),
 	_sub_air_pressure_data(node),
 	_sub_air_temperature_data(node)
 { }
 
 int UavcanBarometerBridge::init()
 {
-	int res = device::CDev::init();
-
-	if (res < 0) {
-		return res;
-	}
-
-	res = _sub_air_pressure_data.start(AirPressureCbBinder(this, &UavcanBarometerBridge::air_pressure_sub_cb));
+	int res = _sub_air_pressure_data.start(AirPressureCbBinder(this, &UavcanBarometerBridge::air_pressure_sub_cb));
 
 	if (res < 0) {
 		DEVICE_LOG("failed to start uavcan sub: %d", res);
@@ -89,9 +80,7 @@ void
 UavcanBarometerBridge::air_pressure_sub_cb(const
 		uavcan::ReceivedDataStructure<uavcan::equipment::air_data::StaticPressure> &msg)
 {
-	lock();
 	uavcan_bridge::Channel *channel = get_channel_for_node(msg.getSrcNodeID().get());
-	unlock();
 
 	if (channel == nullptr) {
 		// Something went wrong - no channel to publish on; return
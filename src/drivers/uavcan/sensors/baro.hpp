@@ -43,7 +43,7 @@
 #include <uavcan/equipment/air_data/StaticPressure.hpp>
 #include <uavcan/equipment/air_data/StaticTemperature.hpp>
 
-class UavcanBarometerBridge : public UavcanCDevSensorBridgeBase
+class UavcanBarometerBridge : public UavcanSensorBridgeBase
 {
 public:
 	static const char *const NAME;
@@ -46,25 +46,17 @@
 const char *const UavcanDifferentialPressureBridge::NAME = "differential_pressure";
 
 UavcanDifferentialPressureBridge::UavcanDifferentialPressureBridge(uavcan::INode &node) :
-	UavcanCDevSensorBridgeBase("uavcan_differential_pressure", "/dev/uavcan/differential_pressure",
-				   AIRSPEED_BASE_DEVICE_PATH,
-				   ORB_ID(differential_pressure)),
+	UavcanSensorBridgeBase("uavcan_differential_pressure", ORB_ID(differential_pressure)),
 	_sub_air(node)
 {
 }
 
 int UavcanDifferentialPressureBridge::init()
 {
-	int res = device::CDev::init();
-
-	if (res < 0) {
-		return res;
-	}
-
 	// Initialize the calibration offset
 	param_get(param_find("SENS_DPRES_OFF"), &_diff_pres_offset);
 
-	res = _sub_air.start(AirCbBinder(this, &UavcanDifferentialPressureBridge::air_sub_cb));
+	int res = _sub_air.start(AirCbBinder(this, &UavcanDifferentialPressureBridge::air_sub_cb));
 
 	if (res < 0) {
 		DEVICE_LOG("failed to start uavcan sub: %d", res);
@@ -74,13 +66,28 @@ int UavcanDifferentialPressureBridge::init()
 	return 0;
 }
 
-int UavcanDifferentialPressureBridge::ioctl(struct file *filp, int cmd, unsigned long arg)
+UavcanDifferentialPressureBridge::ScaleInterface::~ScaleInterface()
+{
+	if (_class_instance >= 0) {
+		unregister_class_devname(AIRSPEED_BASE_DEVICE_PATH, _class_instance);
+	}
+}
+
+void UavcanDifferentialPressureBridge::ScaleInterface::register_class()
+{
+	if (!_registered) {
+		_class_instance = register_class_devname(AIRSPEED_BASE_DEVICE_PATH);
+		_registered = true;
+	}
+}
+
+int UavcanDifferentialPressureBridge::ScaleInterface::ioctl(cdev::file_t *filp, int cmd, unsigned long arg)
 {
 	switch (cmd) {
 
 	case AIRSPEEDIOCSSCALE: {
 			struct airspeed_scale *s = (struct airspeed_scale *)arg;
-			_diff_pres_offset = s->offset_pa;
+			_bridge._diff_pres_offset = s->offset_pa;
 			return PX4_OK;
 		}
 
@@ -110,4 +117,6 @@ void UavcanDifferentialPressureBridge::air_sub_cb(const
 	};
 
 	publish(msg.getSrcNodeID().get(), &report);
+
+	_scale_interface.register_class();
 }
@@ -45,7 +45,7 @@
 
 #include <uavcan/equipment/air_data/RawAirData.hpp>
 
-class UavcanDifferentialPressureBridge : public UavcanCDevSensorBridgeBase
+class UavcanDifferentialPressureBridge : public UavcanSensorBridgeBase
 {
 public:
 	static const char *const NAME;
@@ -57,11 +57,30 @@ public:
 	int init() override;
 
 private:
+	/**
+	 * Airspeed calibration interface (AIRSPEEDIOCSSCALE), registered as /dev/airspeedN once a sensor is seen.
+	 */
+	class ScaleInterface : public cdev::CDev
+	{
+	public:
+		ScaleInterface(UavcanDifferentialPressureBridge &bridge) : CDev(nullptr), _bridge(bridge) {}
+		~ScaleInterface() override;
+
+		int ioctl(cdev::file_t *filp, int cmd, unsigned long arg) override;
+
+		void register_class();
+
+	private:
+		UavcanDifferentialPressureBridge &_bridge;
+		int _class_instance{-1};
+		bool _registered{false};
+	};
+
 	float _diff_pres_offset {0.0f};
 
 	math::LowPassFilter2p _filter{10.f, 1.1f}; /// Adapted from MS5525 driver
 
-	int ioctl(struct file *filp, int cmd, unsigned long arg) override;
+	ScaleInterface _scale_interface{*this};
 
 	void air_sub_cb(const uavcan::ReceivedDataStructure<uavcan::equipment::air_data::RawAirData> &msg);
 
@@ -55,7 +55,7 @@
 
 #include "sensor_bridge.hpp"
 
-class UavcanGnssBridge : public UavcanCDevSensorBridgeBase
+class UavcanGnssBridge : public UavcanSensorBridgeBase
 {
 	static constexpr unsigned ORB_TO_UAVCAN_FREQUENCY_HZ = 10;
 
@@ -114,8 +114,8 @@ private:
 	float		_last_gnss_auxiliary_hdop{0.0f};
 	float		_last_gnss_auxiliary_vdop{0.0f};
 
-	uORB::PublicationMulti<vehicle_gps_position_s>	_gps_pub{ORB_ID(vehicle_gps_position), ORB_PRIO_DEFAULT};
-	uORB::Subscription				_orb_sub_gnss{ORB_ID(vehicle_gps_position)};
+	uORB::PublicationMulti<vehicle_gps_position_s>	_gps_pub{ORB_ID(sensor_gps), ORB_PRIO_DEFAULT};
+	uORB::Subscription				_orb_sub_gnss{ORB_ID(sensor_gps)};
 
 	int	_receiver_node_id{-1};
 	bool	_old_fix_subscriber_active{true};
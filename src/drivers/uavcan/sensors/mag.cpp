@@ -44,10 +44,8 @@
 
 const char *const UavcanMagnetometerBridge::NAME = "mag";
 
-#define UAVCAN_MAG_BASE_DEVICE_PATH "/dev/uavcan/mag"
-
 UavcanMagnetometerBridge::UavcanMagnetometerBridge(uavcan::INode &node) :
-	UavcanCDevSensorBridgeBase("uavcan_mag", UAVCAN_MAG_BASE_DEVICE_PATH, UAVCAN_MAG_BASE_DEVICE_PATH, ORB_ID(sensor_mag)),
+	UavcanSensorBridgeBase("uavcan_mag", ORB_ID(sensor_mag)),
 	_sub_mag(node),
 	_sub_mag2(node)
 {
@@ -56,13 +54,7 @@ UavcanMagnetometerBridge::UavcanMagnetometerBridge(uavcan::INode &node) :
 int
 UavcanMagnetometerBridge::init()
 {
-	int res = device::CDev::init();
-
-	if (res < 0) {
-		return res;
-	}
-
-	res = _sub_mag.start(MagCbBinder(this, &UavcanMagnetometerBridge::mag_sub_cb));
+	int res = _sub_mag.start(MagCbBinder(this, &UavcanMagnetometerBridge::mag_sub_cb));
 
 	if (res < 0) {
 		PX4_ERR("failed to start uavcan sub: %d", res);
@@ -79,17 +71,6 @@ UavcanMagnetometerBridge::init()
 	return 0;
 }
 
-int
-UavcanMagnetometerBridge::ioctl(struct file *filp, int cmd, unsigned long arg)
-{
-	switch (cmd) {
-
-	default: {
-			return CDev::ioctl(filp, cmd, arg);
-		}
-	}
-}
-
 void
 UavcanMagnetometerBridge::mag_sub_cb(const uavcan::ReceivedDataStructure<uavcan::equipment::ahrs::MagneticFieldStrength>
 				     &msg)
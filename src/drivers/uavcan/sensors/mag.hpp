@@ -44,7 +44,7 @@
 #include <uavcan/equipment/ahrs/MagneticFieldStrength.hpp>
 #include <uavcan/equipment/ahrs/MagneticFieldStrength2.hpp>
 
-class UavcanMagnetometerBridge : public UavcanCDevSensorBridgeBase
+class UavcanMagnetometerBridge : public UavcanSensorBridgeBase
 {
 public:
 	static const char *const NAME;
@@ -57,8 +57,6 @@ public:
 
 private:
 
-	int ioctl(struct file *filp, int cmd, unsigned long arg) override;
-
 	int init_driver(uavcan_bridge::Channel *channel) override;
 
 	void mag_sub_cb(const uavcan::ReceivedDataStructure<uavcan::equipment::ahrs::MagneticFieldStrength> &msg);
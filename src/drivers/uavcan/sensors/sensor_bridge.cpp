@@ -61,13 +61,15 @@ void IUavcanSensorBridge::make_all(uavcan::INode &node, List<IUavcanSensorBridge
 }
 
 /*
- * UavcanCDevSensorBridgeBase
+ * UavcanSensorBridgeBase
  */
-UavcanCDevSensorBridgeBase::~UavcanCDevSensorBridgeBase()
+UavcanSensorBridgeBase::~UavcanSensorBridgeBase()
 {
 	for (unsigned i = 0; i < _max_channels; i++) {
-		if (_channels[i].node_id >= 0) {
-			(void)unregister_class_devname(_class_devname, _channels[i].class_instance);
+		delete _channels[i].h_driver;
+
+		if (_channels[i].orb_advert != nullptr) {
+			(void)orb_unadvertise(_channels[i].orb_advert);
 		}
 	}
 
@@ -75,7 +77,7 @@ UavcanCDevSensorBridgeBase::~UavcanCDevSensorBridgeBase()
 }
 
 void
-UavcanCDevSensorBridgeBase::publish(const int node_id, const void *report)
+UavcanSensorBridgeBase::publish(const int node_id, const void *report)
 {
 	assert(report != nullptr);
 
@@ -115,32 +117,23 @@ UavcanCDevSensorBridgeBase::publish(const int node_id, const void *report)
 		// update device id as we now know our device node_id
 		_device_id.devid_s.address = static_cast<uint8_t>(node_id);
 
-		// Ask the CDev helper which class instance we can take
-		const int class_instance = register_class_devname(_class_devname);
-
-		if (class_instance < 0 || class_instance >= int(_max_channels)) {
-			_out_of_channels = true;
-			DEVICE_LOG("out of class instances");
-			(void)unregister_class_devname(_class_devname, class_instance);
-			return;
-		}
-
 		// Publish to the appropriate topic, abort on failure
-		channel->node_id        = node_id;
-		channel->class_instance = class_instance;
-		DEVICE_LOG("channel %d class instance %d ok", channel->node_id, channel->class_instance);
-
 		channel->orb_advert = orb_advertise_multi(_orb_topic, report, &channel->orb_instance, ORB_PRIO_VERY_HIGH);
 
 		if (channel->orb_advert == nullptr) {
 			DEVICE_LOG("uORB advertise failed. Out of instances?");
-			(void)unregister_class_devname(_class_devname, class_instance);
 			*channel = uavcan_bridge::Channel();
 			_out_of_channels = true;
 			return;
 		}
 
-		DEVICE_LOG("channel %d class instance %d ok", channel->node_id, channel->orb_instance);
+		// the uORB instance is the class instance, there is no device node per channel
+		channel->node_id        = node_id;
+		channel->class_instance = channel->orb_instance;
+		DEVICE_LOG("channel %d instance %d ok", channel->node_id, channel->orb_instance);
+
+		// the report was published by the advertisement
+		return;
 	}
 
 	assert(channel != nullptr);
@@ -148,7 +141,7 @@ UavcanCDevSensorBridgeBase::publish(const int node_id, const void *report)
 	(void)orb_publish(_orb_topic, channel->orb_advert, report);
 }
 
-uavcan_bridge::Channel *UavcanCDevSensorBridgeBase::get_channel_for_node(int node_id)
+uavcan_bridge::Channel *UavcanSensorBridgeBase::get_channel_for_node(int node_id)
 {
 	uavcan_bridge::Channel *channel = nullptr;
 
@@ -204,7 +197,7 @@ uavcan_bridge::Channel *UavcanCDevSensorBridgeBase::get_channel_for_node(int nod
 	return channel;
 }
 
-unsigned UavcanCDevSensorBridgeBase::get_num_redundant_channels() const
+unsigned UavcanSensorBridgeBase::get_num_redundant_channels() const
 {
 	unsigned out = 0;
 
@@ -217,7 +210,7 @@ unsigned UavcanCDevSensorBridgeBase::get_num_redundant_channels() const
 	return out;
 }
 
-int8_t UavcanCDevSensorBridgeBase::get_channel_index_for_node(int node_id)
+int8_t UavcanSensorBridgeBase::get_channel_index_for_node(int node_id)
 {
 	int8_t ch = -1;
 
@@ -231,13 +224,13 @@ int8_t UavcanCDevSensorBridgeBase::get_channel_index_for_node(int node_id)
 	return ch;
 }
 
-void UavcanCDevSensorBridgeBase::print_status() const
+void UavcanSensorBridgeBase::print_status() const
 {
-	printf("devname: %s\n", _class_devname);
+	printf("topic: %s\n", _orb_topic->o_name);
 
 	for (unsigned i = 0; i < _max_channels; i++) {
 		if (_channels[i].node_id >= 0) {
-			printf("channel %d: node id %d --> class instance %d\n",
+			printf("channel %d: node id %d --> instance %d\n",
 			       i, _channels[i].node_id, _channels[i].class_instance);
 
 		} else {
@@ -96,28 +96,31 @@ struct Channel {
 /**
  * This is the base class for redundant sensors with an independent ORB topic per each redundancy channel.
  * For example, sensor_mag0, sensor_mag1, etc.
+ * Measurements are published to uORB directly (or through the PX4 sensor driver class of the channel),
+ * there is no device node per bridge or per remote sensor.
  */
-class UavcanCDevSensorBridgeBase : public IUavcanSensorBridge, public device::CDev
+class UavcanSensorBridgeBase : public IUavcanSensorBridge
 {
-	const char *const _class_devname;
 	const orb_id_t _orb_topic;
 	uavcan_bridge::Channel *const _channels;
 	bool _out_of_channels = false;
 
 protected:
+	typedef device::Device::DeviceId DeviceId;
+
 	static constexpr unsigned DEFAULT_MAX_CHANNELS = ORB_MULTI_MAX_INSTANCES;
+	const char *const _name;
 	const unsigned _max_channels;
+	DeviceId _device_id{};
 
-	UavcanCDevSensorBridgeBase(const char *name, const char *devname, const char *class_devname,
-				   const orb_id_t orb_topic_sensor,
-				   const unsigned max_channels = DEFAULT_MAX_CHANNELS) :
-		device::CDev(name, devname),
-		_class_devname(class_devname),
+	UavcanSensorBridgeBase(const char *name, const orb_id_t orb_topic_sensor,
+			       const unsigned max_channels = DEFAULT_MAX_CHANNELS) :
 		_orb_topic(orb_topic_sensor),
 		_channels(new uavcan_bridge::Channel[max_channels]),
+		_name(name),
 		_max_channels(max_channels)
 	{
-		_device_id.devid_s.bus_type = DeviceBusType_UAVCAN;
+		_device_id.devid_s.bus_type = device::Device::DeviceBusType_UAVCAN;
 		_device_id.devid_s.bus = 0;
 	}
 
@@ -139,7 +142,7 @@ protected:
 	uavcan_bridge::Channel *get_channel_for_node(int node_id);
 
 public:
-	virtual ~UavcanCDevSensorBridgeBase();
+	virtual ~UavcanSensorBridgeBase();
 
 	unsigned get_num_redundant_channels() const override;
 
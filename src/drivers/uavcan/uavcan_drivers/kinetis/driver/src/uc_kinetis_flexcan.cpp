@@ -662,7 +662,13 @@ void CanIface::handleRxInterrupt(uavcan::uint32_t rx_iflags, uavcan::uint64_t ut
 		can_->IFLAG1 = flexcan::CAN_FIFO_WARN;
 	}
 
-	if (rx_iflags & flexcan::CAN_FIFO_NE) {
+	/*
+	 * Drain all pending messages of the hardware FIFO (up to 6) in one go, so that a burst
+	 * of frames costs a single interrupt entry and a single update event.
+	 */
+	bool received = false;
+
+	while (can_->IFLAG1 & flexcan::CAN_FIFO_NE) {
 		const flexcan::RxFiFoType &rf = can_->MB[flexcan::FiFo].fifo;
 
 		/*
@@ -698,12 +704,18 @@ void CanIface::handleRxInterrupt(uavcan::uint32_t rx_iflags, uavcan::uint64_t ut
 		can_->IFLAG1 = flexcan::CAN_FIFO_NE;
 
 		/*
-		 * Store with timeout into the FIFO buffer and signal update event
+		 * Store with timeout into the FIFO buffer
 		 */
 		rx_queue_.push(frame, utc_usec, 0);
+		received = true;
+	}
+
+	if (received) {
+		/*
+		 * Signal the update event once for the whole batch
+		 */
 		had_activity_ = true;
 		update_event_.signalFromInterrupt();
-
 	}
 
 	pollErrorFlagsFromISR();
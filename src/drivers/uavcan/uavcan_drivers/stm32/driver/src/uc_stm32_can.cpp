@@ -653,40 +653,51 @@ void CanIface::handleRxInterrupt(uavcan::uint8_t fifo_index, uavcan::uint64_t ut
 	}
 
 	/*
-	 * Read the frame contents
+	 * Drain all pending messages of the hardware FIFO (up to 3) in one go, so that a burst
+	 * of frames costs a single interrupt entry and a single update event.
 	 */
-	uavcan::CanFrame frame;
 	const bxcan::RxMailboxType &rf = can_->RxMailbox[fifo_index];
 
-	if ((rf.RIR & bxcan::RIR_IDE) == 0) {
-		frame.id = uavcan::CanFrame::MaskStdID & (rf.RIR >> 21);
+	while ((*rfr_reg & bxcan::RFR_FMP_MASK) != 0) {
+		/*
+		 * Read the frame contents
+		 */
+		uavcan::CanFrame frame;
 
-	} else {
-		frame.id = uavcan::CanFrame::MaskExtID & (rf.RIR >> 3);
-		frame.id |= uavcan::CanFrame::FlagEFF;
-	}
+		if ((rf.RIR & bxcan::RIR_IDE) == 0) {
+			frame.id = uavcan::CanFrame::MaskStdID & (rf.RIR >> 21);
 
-	if ((rf.RIR & bxcan::RIR_RTR) != 0) {
-		frame.id |= uavcan::CanFrame::FlagRTR;
-	}
+		} else {
+			frame.id = uavcan::CanFrame::MaskExtID & (rf.RIR >> 3);
+			frame.id |= uavcan::CanFrame::FlagEFF;
+		}
 
-	frame.dlc = rf.RDTR & 15;
+		if ((rf.RIR & bxcan::RIR_RTR) != 0) {
+			frame.id |= uavcan::CanFrame::FlagRTR;
+		}
+
+		frame.dlc = rf.RDTR & 15;
 
-	frame.data[0] = uavcan::uint8_t(0xFF & (rf.RDLR >> 0));
-	frame.data[1] = uavcan::uint8_t(0xFF & (rf.RDLR >> 8));
-	frame.data[2] = uavcan::uint8_t(0xFF & (rf.RDLR >> 16));
-	frame.data[3] = uavcan::uint8_t(0xFF & (rf.RDLR >> 24));
-	frame.data[4] = uavcan::uint8_t(0xFF & (rf.RDHR >> 0));
-	frame.data[5] = uavcan::uint8_t(0xFF & (rf.RDHR >> 8));
-	frame.data[6] = uavcan::uint8_t(0xFF & (rf.RDHR >> 16));
-	frame.data[7] = uavcan::uint8_t(0xFF & (rf.RDHR >> 24));
+		frame.data[0] = uavcan::uint8_t(0xFF & (rf.RDLR >> 0));
+		frame.data[1] = uavcan::uint8_t(0xFF & (rf.RDLR >> 8));
+		frame.data[2] = uavcan::uint8_t(0xFF & (rf.RDLR >> 16));
+		frame.data[3] = uavcan::uint8_t(0xFF & (rf.RDLR >> 24));
+		frame.data[4] = uavcan::uint8_t(0xFF & (rf.RDHR >> 0));
+		frame.data[5] = uavcan::uint8_t(0xFF & (rf.RDHR >> 8));
+		frame.data[6] = uavcan::uint8_t(0xFF & (rf.RDHR >> 16));
+		frame.data[7] = uavcan::uint8_t(0xFF & (rf.RDHR >> 24));
 
-	*rfr_reg = bxcan::RFR_RFOM | bxcan::RFR_FOVR | bxcan::RFR_FULL;  // Release FIFO entry we just read
+		*rfr_reg = bxcan::RFR_RFOM | bxcan::RFR_FOVR | bxcan::RFR_FULL;  // Release FIFO entry we just read
+
+		/*
+		 * Store with timeout into the FIFO buffer
+		 */
+		rx_queue_.push(frame, utc_usec, 0);
+	}
 
 	/*
-	 * Store with timeout into the FIFO buffer and signal update event
+	 * Signal the update event once for the whole batch
 	 */
-	rx_queue_.push(frame, utc_usec, 0);
 	had_activity_ = true;
 	update_event_.signalFromInterrupt();
 
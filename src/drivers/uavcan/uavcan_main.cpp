@@ -651,6 +651,13 @@ UavcanNode::init(uavcan::NodeID node_id, UAVCAN_DRIVER::BusEvent &bus_events)
 	param_get(param_find("UAVCAN_ESC_IDLT"), &_idle_throttle_when_armed_param);
 	enable_idle_throttle_when_armed(true);
 
+	int32_t esc_direct = 0;
+	param_get(param_find("UAVCAN_ESC_FAST"), &esc_direct);
+
+	if (esc_direct != 0) {
+		_mixing_interface.enableFastPath();
+	}
+
 	/*  Start the Node   */
 	return _node.start();
 }
@@ -751,6 +758,9 @@ UavcanNode::Run()
 
 	node_spin_once(); // expected to be non-blocking
 
+	// ESC command the fast path could not send while we were spinning
+	_esc_controller.publish_pending();
+
 	// Check arming state
 	const actuator_armed_s &armed = _mixing_interface.mixingOutput().armed();
 	enable_idle_throttle_when_armed(!armed.soft_stop);
@@ -885,12 +895,26 @@ UavcanNode::ioctl(file *filp, int cmd, unsigned long arg)
 bool UavcanMixingInterface::updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS], unsigned num_outputs,
 		unsigned num_control_groups_updated)
 {
-	_esc_controller.update_outputs(stop_motors, outputs, num_outputs);
+	_esc_controller.update_outputs(stop_motors, outputs, num_outputs, _node_locked,
+				       _mixing_output.controlsTimestampSample());
 	return true;
 }
 
 void UavcanMixingInterface::Run()
 {
+	if (_fast_path) {
+		// never block the rate controller on a node spin, the command is then sent by the node thread
+		_node_locked = (pthread_mutex_trylock(&_node_mutex) == 0);
+		_mixing_output.update();
+		_mixing_output.updateSubscriptions(true);
+
+		if (_node_locked) {
+			pthread_mutex_unlock(&_node_mutex);
+		}
+
+		return;
+	}
+
 	pthread_mutex_lock(&_node_mutex);
 	_mixing_output.update();
 	_mixing_output.updateSubscriptions(false);
@@ -952,6 +976,9 @@ UavcanNode::print_info()
 	// ESC mixer status
 	_mixing_interface.mixingOutput().printStatus();
 
+	printf("ESC fast path: %s\n", _mixing_interface.fastPath() ? "enabled" : "disabled");
+	_esc_controller.print_status();
+
 	printf("\n");
 
 	// Sensor bridges
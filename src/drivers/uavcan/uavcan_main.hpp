@@ -83,7 +83,11 @@ public:
 	UavcanMixingInterface(pthread_mutex_t &node_mutex, UavcanEscController &esc_controller)
 		: OutputModuleInterface(MODULE_NAME "-actuators", px4::wq_configurations::uavcan),
 		  _node_mutex(node_mutex),
-		  _esc_controller(esc_controller) {}
+		  _esc_controller(esc_controller)
+	{
+		// run ESC command updates ahead of queued node spins (RX processing bursts on a busy bus)
+		SetQueuePriority(200);
+	}
 
 	bool updateOutputs(bool stop_motors, uint16_t outputs[MAX_ACTUATORS],
 			   unsigned num_outputs, unsigned num_control_groups_updated) override;
@@ -92,12 +96,22 @@ public:
 
 	MixingOutput &mixingOutput() { return _mixing_output; }
 
+	/**
+	 * Enable the ESC command fast path (UAVCAN_ESC_FAST): mixing and the command broadcast
+	 * run on the rate_ctrl work queue, synchronized to the rate controller cycle.
+	 */
+	void enableFastPath() { _fast_path = true; }
+
+	bool fastPath() const { return _fast_path; }
+
 protected:
 	void Run() override;
 private:
 	friend class UavcanNode;
 	pthread_mutex_t &_node_mutex;
 	UavcanEscController &_esc_controller;
+	bool _fast_path{false};
+	bool _node_locked{true};
 	MixingOutput _mixing_output{MAX_ACTUATORS, *this, MixingOutput::SchedulingPolicy::Auto, false, false};
 };
 
@@ -85,3 +85,16 @@ PARAM_DEFINE_INT32(UAVCAN_BITRATE, 1000000);
  * @group UAVCAN
  */
 PARAM_DEFINE_INT32(UAVCAN_ESC_IDLT, 1);
+
+/**
+ * UAVCAN ESC command fast path.
+ *
+ * If enabled, the ESC outputs are mixed and broadcast on the rate controller work queue, right after
+ * the rate controller published (together with MOT_DIRECT_OUT within the same cycle), instead of
+ * on the UAVCAN work queue. If the node is busy the command is sent right after its spin.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group UAVCAN
+ */
+PARAM_DEFINE_INT32(UAVCAN_ESC_FAST, 0);
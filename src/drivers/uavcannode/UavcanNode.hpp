@@ -191,7 +191,7 @@ private:
 	};
 	uORB::SubscriptionCallbackWorkItem _sensor_baro_sub{this, ORB_ID(sensor_baro)};
 	uORB::SubscriptionCallbackWorkItem _sensor_mag_sub{this, ORB_ID(sensor_mag)};
-	uORB::SubscriptionCallbackWorkItem _vehicle_gps_position_sub{this, ORB_ID(vehicle_gps_position)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_gps_position_sub{this, ORB_ID(sensor_gps)};
 
 	perf_counter_t _cycle_perf;
 	perf_counter_t _interval_perf;
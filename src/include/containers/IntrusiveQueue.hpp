@@ -74,6 +74,35 @@ public:
 		_tail = newNode;
 	}
 
+	/**
+	 * Insert newNode after node, or at the front if node is nullptr.
+	 * node must be in this queue.
+	 */
+	void insert_after(T node, T newNode)
+	{
+		// error, node already queued or already inserted
+		if ((newNode->next_intrusive_queue_node() != nullptr) || (newNode == _tail)) {
+			return;
+		}
+
+		if (node == nullptr) {
+			newNode->set_next_intrusive_queue_node(_head);
+			_head = newNode;
+
+			if (_tail == nullptr) {
+				_tail = newNode;
+			}
+
+		} else {
+			newNode->set_next_intrusive_queue_node(node->next_intrusive_queue_node());
+			node->set_next_intrusive_queue_node(newNode);
+
+			if (node == _tail) {
+				_tail = newNode;
+			}
+		}
+	}
+
 	T pop()
 	{
 		T ret = _head;
@@ -47,16 +47,18 @@ AirspeedValidator::update_airspeed_validator(const airspeed_validator_update_dat
 	_IAS = input_data.airspeed_indicated_raw;
 
 	// to be able to detect missing data, save timestamp (used in data_missing check)
-	if (input_data.airspeed_timestamp != _previous_airspeed_timestamp && input_data.airspeed_timestamp > 0) {
+	const bool new_airspeed_data = (input_data.airspeed_timestamp != _previous_airspeed_timestamp
+					&& input_data.airspeed_timestamp > 0);
+
+	if (new_airspeed_data) {
 		_time_last_airspeed = input_data.timestamp;
 		_previous_airspeed_timestamp = input_data.airspeed_timestamp;
 	}
 
 	update_EAS_scale();
 	update_EAS_TAS(input_data.air_pressure_pa, input_data.air_temperature_celsius);
-	update_wind_estimator(input_data.timestamp, input_data.airspeed_true_raw, input_data.lpos_valid, input_data.lpos_vx,
-			      input_data.lpos_vy,
-			      input_data.lpos_vz, input_data.lpos_evh, input_data.lpos_evv, input_data.att_q);
+	update_wind_estimator(input_data.timestamp, input_data.airspeed_true_raw, new_airspeed_data, input_data.lpos_valid,
+			      input_data.vel_ned, input_data.vel_var_ne, input_data.att_q);
 	update_in_fixed_wing_flight(input_data.in_fixed_wing_flight);
 	check_airspeed_innovation(input_data.timestamp, input_data.vel_test_ratio, input_data.mag_test_ratio);
 	check_load_factor(input_data.accel_z);
@@ -64,9 +66,8 @@ AirspeedValidator::update_airspeed_validator(const airspeed_validator_update_dat
 }
 
 void
-AirspeedValidator::update_wind_estimator(const uint64_t time_now_usec, float airspeed_true_raw, bool lpos_valid,
-		float lpos_vx, float lpos_vy,
-		float lpos_vz, float lpos_evh, float lpos_evv, const float att_q[4])
+AirspeedValidator::update_wind_estimator(const uint64_t time_now_usec, float airspeed_true_raw, bool new_airspeed_data,
+		bool lpos_valid, const Vector3f &vel_ned, const Vector2f &vel_var_ne, const Quatf &att_q)
 {
 	bool att_valid = true; // att_valid could also be a input_data state
 
@@ -74,15 +75,13 @@ AirspeedValidator::update_wind_estimator(const uint64_t time_now_usec, float air
 
 	if (lpos_valid && att_valid && _in_fixed_wing_flight) {
 
-		Vector3f vI(lpos_vx, lpos_vy, lpos_vz);
-		Quatf q(att_q);
-
 		// sideslip fusion
-		_wind_estimator.fuse_beta(time_now_usec, vI, q);
+		_wind_estimator.fuse_beta(time_now_usec, vel_ned, att_q);
 
-		// airspeed fusion (with raw TAS)
-		const Vector3f vel_var{Dcmf(q) *Vector3f{lpos_evh, lpos_evh, lpos_evv}};
-		_wind_estimator.fuse_airspeed(time_now_usec, airspeed_true_raw, vI, Vector2f{vel_var(0), vel_var(1)});
+		// airspeed fusion (with raw TAS), only once per measurement
+		if (new_airspeed_data) {
+			_wind_estimator.fuse_airspeed(time_now_usec, airspeed_true_raw, vel_ned, vel_var_ne);
+		}
 	}
 }
 
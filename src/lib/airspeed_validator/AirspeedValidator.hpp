@@ -50,18 +50,19 @@ using matrix::Vector3f;
 
 using namespace time_literals;
 
+/**
+ * Input data of the validator. The vehicle state is the same for all sensor instances and is
+ * prepared once per update cycle by the caller (vel_ned, att_q, vel_var_ne).
+ */
 struct airspeed_validator_update_data {
 	uint64_t timestamp;
 	float airspeed_indicated_raw;
 	float airspeed_true_raw;
 	uint64_t airspeed_timestamp;
-	float lpos_vx;
-	float lpos_vy;
-	float lpos_vz;
+	Vector3f vel_ned;	///< local position velocity (NED) [m/s]
+	Vector2f vel_var_ne;	///< velocity variance for the airspeed fusion [m^2/s^2]
+	Quatf att_q;		///< vehicle attitude
 	bool lpos_valid;
-	float lpos_evh;
-	float lpos_evv;
-	float att_q[4];
 	float air_pressure_pa;
 	float air_temperature_celsius;
 	float accel_z;
@@ -158,10 +159,8 @@ private:
 
 	void update_in_fixed_wing_flight(bool in_fixed_wing_flight) { _in_fixed_wing_flight = in_fixed_wing_flight; }
 
-	void update_wind_estimator(const uint64_t timestamp, float airspeed_true_raw, bool lpos_valid, float lpos_vx,
-				   float lpos_vy,
-				   float lpos_vz,
-				   float lpos_evh, float lpos_evv, const float att_q[4]);
+	void update_wind_estimator(const uint64_t timestamp, float airspeed_true_raw, bool new_airspeed_data, bool lpos_valid,
+				   const Vector3f &vel_ned, const Vector2f &vel_var_ne, const Quatf &att_q);
 	void update_EAS_scale();
 	void update_EAS_TAS(float air_pressure_pa, float air_temperature_celsius);
 	void check_airspeed_innovation(uint64_t timestamp, float estimator_status_vel_test_ratio,
@@ -38,6 +38,8 @@
 #include "ObstacleAvoidance.hpp"
 #include "bezier/BezierN.hpp"
 
+#include <mathlib/mathlib.h>
+
 using namespace matrix;
 using namespace time_literals;
 
@@ -47,6 +49,12 @@ static constexpr uint64_t TRAJECTORY_STREAM_TIMEOUT_US = 500_ms;
 static constexpr uint64_t TIME_BEFORE_FAILSAFE = 500_ms;
 static constexpr uint64_t Z_PROGRESS_TIMEOUT_US = 2_s;
 
+/** End time of a bezier segment, the delta of the last control point is the duration of the segment */
+static hrt_abstime bezierEndTime(const vehicle_trajectory_bezier_s &segment)
+{
+	return segment.timestamp + hrt_abstime(segment.control_points[segment.bezier_order - 1].delta * 1e6f);
+}
+
 ObstacleAvoidance::ObstacleAvoidance(ModuleParams *parent) :
 	ModuleParams(parent)
 {
@@ -60,23 +68,24 @@ ObstacleAvoidance::ObstacleAvoidance(ModuleParams *parent) :
 void ObstacleAvoidance::injectAvoidanceSetpoints(Vector3f &pos_sp, Vector3f &vel_sp, float &yaw_sp,
 		float &yaw_speed_sp)
 {
+	const hrt_abstime now = hrt_absolute_time();
+
 	_sub_vehicle_status.update();
 	_sub_vehicle_trajectory_waypoint.update();
-	_sub_vehicle_trajectory_bezier.update();
+	_updateBezierHorizon(now);
 
 	const auto &wp_msg = _sub_vehicle_trajectory_waypoint.get();
-	const auto &bezier_msg = _sub_vehicle_trajectory_bezier.get();
 
+	// the bezier data only times out once the whole streamed horizon has been flown
 	const bool avoidance_data_timeout =
 		hrt_elapsed_time((hrt_abstime *)&wp_msg.timestamp) > TRAJECTORY_STREAM_TIMEOUT_US &&
-		hrt_elapsed_time((hrt_abstime *)&bezier_msg.timestamp) > hrt_abstime(bezier_msg.control_points[bezier_msg.bezier_order -
-							1].delta * 1e6f);
+		(_bezier_horizon_count == 0 || now > bezierEndTime(_bezier_horizon[_bezier_horizon_count - 1]));
 
 	const bool avoidance_point_valid = wp_msg.waypoints[vehicle_trajectory_waypoint_s::POINT_0].point_valid;
-	const bool avoidance_bezier_valid = bezier_msg.bezier_order > 0;
+	const bool avoidance_bezier_valid = _bezier_horizon_count > 0;
 
 	_avoidance_point_not_valid_hysteresis.set_state_and_update(!avoidance_point_valid
-			&& !avoidance_bezier_valid, hrt_absolute_time());
+			&& !avoidance_bezier_valid, now);
 
 	const bool avoidance_invalid = (avoidance_data_timeout || _avoidance_point_not_valid_hysteresis.get_state());
 
@@ -119,7 +128,7 @@ void ObstacleAvoidance::injectAvoidanceSetpoints(Vector3f &pos_sp, Vector3f &vel
 	} else if (avoidance_bezier_valid) {
 
 		float yaw = NAN, yaw_speed = NAN;
-		_generateBezierSetpoints(pos_sp, vel_sp, yaw, yaw_speed);
+		_generateBezierSetpoints(now, pos_sp, vel_sp, yaw, yaw_speed);
 
 		if (!_ext_yaw_active) {
 			// inject yaw setpoints only if weathervane isn't active
@@ -129,33 +138,86 @@ void ObstacleAvoidance::injectAvoidanceSetpoints(Vector3f &pos_sp, Vector3f &vel
 	}
 }
 
-void ObstacleAvoidance::_generateBezierSetpoints(matrix::Vector3f &position, matrix::Vector3f &velocity,
-		float &yaw, float &yaw_velocity)
+void ObstacleAvoidance::_updateBezierHorizon(const hrt_abstime now)
+{
+	vehicle_trajectory_bezier_s segment;
+
+	// the companion can stream several consecutive segments of its planned path ahead of time
+	while (_sub_vehicle_trajectory_bezier.update(&segment)) {
+		const bool segment_valid = segment.bezier_order > 0
+					   && segment.bezier_order <= vehicle_trajectory_bezier_s::NUMBER_POINTS
+					   && PX4_ISFINITE(segment.control_points[segment.bezier_order - 1].delta)
+					   && segment.control_points[segment.bezier_order - 1].delta > 0.f;
+
+		if (!segment_valid) {
+			// no (valid) bezier trajectory from the companion anymore
+			_bezier_horizon_count = 0;
+			continue;
+		}
+
+		// a segment replans the path from its start time on, drop the segments it replaces
+		while (_bezier_horizon_count > 0 && _bezier_horizon[_bezier_horizon_count - 1].timestamp >= segment.timestamp) {
+			_bezier_horizon_count--;
+		}
+
+		if (_bezier_horizon_count == BEZIER_HORIZON_SEGMENTS) {
+			_popBezierSegment();
+		}
+
+		_bezier_horizon[_bezier_horizon_count++] = segment;
+	}
+
+	// drop the segments superseded by a following segment that has already started
+	while (_bezier_horizon_count > 1 && _bezier_horizon[1].timestamp <= now) {
+		_popBezierSegment();
+	}
+}
+
+void ObstacleAvoidance::_popBezierSegment()
 {
-	const auto &msg =  _sub_vehicle_trajectory_bezier.get();
-	int bezier_order = msg.bezier_order;
-	matrix::Vector3f bezier_points[bezier_order];
-	float bezier_yaws[bezier_order];
+	for (int i = 1; i < _bezier_horizon_count; i++) {
+		_bezier_horizon[i - 1] = _bezier_horizon[i];
+	}
+
+	_bezier_horizon_count--;
+}
+
+void ObstacleAvoidance::_generateBezierSetpoints(const hrt_abstime now, matrix::Vector3f &position,
+		matrix::Vector3f &velocity, float &yaw, float &yaw_velocity)
+{
+	const auto &segment = _bezier_horizon[0];
+	const int bezier_order = segment.bezier_order;
+	matrix::Vector3f bezier_points[vehicle_trajectory_bezier_s::NUMBER_POINTS];
+	float bezier_yaws[vehicle_trajectory_bezier_s::NUMBER_POINTS];
 
 	for (int i = 0; i < bezier_order; i++) {
-		bezier_points[i] = Vector3f(msg.control_points[i].position);
-		bezier_yaws[i] = msg.control_points[i].yaw;
+		bezier_points[i] = Vector3f(segment.control_points[i].position);
+		bezier_yaws[i] = segment.control_points[i].yaw;
 	}
 
-	const float duration_s = msg.control_points[bezier_order - 1].delta;
-	const hrt_abstime now = hrt_absolute_time();
-	const hrt_abstime start = msg.timestamp;
-	const hrt_abstime end = start + hrt_abstime(duration_s * 1e6f);
+	const float duration_s = segment.control_points[bezier_order - 1].delta;
+	const hrt_abstime start = segment.timestamp;
+	const hrt_abstime end = bezierEndTime(segment);
+
+	// hold the start of a segment that hasn't started yet and the end of a segment that the next one doesn't follow directly
+	const bool hold = (now < start) || (now > end);
+	const hrt_abstime t = math::constrain(now, start, end);
 
 	float T = NAN;
 
-	if (bezier::calculateT(start, end, now, T) &&
+	if (bezier::calculateT(start, end, t, T) &&
 	    bezier::calculateBezierPosVel(bezier_points, bezier_order, T, position, velocity) &&
 	    bezier::calculateBezierYaw(bezier_yaws, bezier_order, T, yaw, yaw_velocity)
 	   ) {
-		// translate bezier velocities T [0;1] into real velocities m/s
-		yaw_velocity /= duration_s;
-		velocity /= duration_s;
+		if (hold) {
+			velocity.setZero();
+			yaw_velocity = 0.f;
+
+		} else {
+			// translate bezier velocities T [0;1] into real velocities m/s
+			yaw_velocity /= duration_s;
+			velocity /= duration_s;
+		}
 
 	} else {
 		PX4_WARN("Obstacle Avoidance system failed, bad trajectory");
@@ -116,12 +116,17 @@ public:
 
 protected:
 
-	uORB::SubscriptionData<vehicle_trajectory_bezier_s> _sub_vehicle_trajectory_bezier{ORB_ID(vehicle_trajectory_bezier)}; /**< vehicle trajectory waypoint subscription */
+	uORB::Subscription _sub_vehicle_trajectory_bezier{ORB_ID(vehicle_trajectory_bezier)}; /**< vehicle trajectory bezier subscription */
 	uORB::SubscriptionData<vehicle_trajectory_waypoint_s> _sub_vehicle_trajectory_waypoint{ORB_ID(vehicle_trajectory_waypoint)}; /**< vehicle trajectory waypoint subscription */
 	uORB::SubscriptionData<vehicle_status_s> _sub_vehicle_status{ORB_ID(vehicle_status)}; /**< vehicle status subscription */
 
 	vehicle_trajectory_waypoint_s _desired_waypoint{};  /**< desired vehicle trajectory waypoint to be sent to OA */
 
+	static constexpr int BEZIER_HORIZON_SEGMENTS = 4; /**< bezier segments that can be streamed ahead of time */
+
+	vehicle_trajectory_bezier_s _bezier_horizon[BEZIER_HORIZON_SEGMENTS] {}; /**< bezier segments sorted by start time */
+	int _bezier_horizon_count{0}; /**< number of valid segments in _bezier_horizon */
+
 	uORB::Publication<vehicle_trajectory_waypoint_s> _pub_traj_wp_avoidance_desired{ORB_ID(vehicle_trajectory_waypoint_desired)};	/**< trajectory waypoint desired publication */
 	uORB::Publication<position_controller_status_s> _pub_pos_control_status{ORB_ID(position_controller_status)};	/**< position controller status publication */
 	uORB::PublicationQueued<vehicle_command_s> _pub_vehicle_command{ORB_ID(vehicle_command)};	/**< vehicle command do publication */
@@ -141,7 +146,24 @@ protected:
 	 * Publishes vehicle command.
 	 */
 	void _publishVehicleCmdDoLoiter();
-	void _generateBezierSetpoints(matrix::Vector3f &position, matrix::Vector3f &velocity, float &yaw, float &yaw_velocity);
+
+	/**
+	 * Adds the newly received bezier segments to the horizon and drops the ones that have been flown.
+	 * @param now, current time
+	 */
+	void _updateBezierHorizon(const hrt_abstime now);
+
+	/**
+	 * Removes the first (oldest) segment of the bezier horizon.
+	 */
+	void _popBezierSegment();
+
+	/**
+	 * Evaluates the current segment of the bezier horizon.
+	 * @param now, current time
+	 */
+	void _generateBezierSetpoints(const hrt_abstime now, matrix::Vector3f &position, matrix::Vector3f &velocity,
+				      float &yaw, float &yaw_velocity);
 
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::NAV_MC_ALT_RAD>) _param_nav_mc_alt_rad    /**< Acceptance radius for multicopter altitude */
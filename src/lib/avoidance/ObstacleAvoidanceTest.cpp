@@ -37,6 +37,7 @@
 
 
 using namespace matrix;
+using namespace time_literals;
 // to run: make tests TESTFILTER=ObstacleAvoidance
 
 class ObstacleAvoidanceTest : public ::testing::Test
@@ -240,3 +241,49 @@ TEST_F(ObstacleAvoidanceTest, oa_desired)
 	EXPECT_TRUE(_sub_traj_wp_avoidance_desired.get().waypoints[vehicle_trajectory_waypoint_s::POINT_2].point_valid);
 
 }
+
+TEST_F(ObstacleAvoidanceTest, oa_enabled_healthy_bezier_horizon)
+{
+	// GIVEN: two consecutive bezier segments streamed at once, the second one starting at the end of the first one
+	TestObstacleAvoidance oa;
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	vehicle_trajectory_bezier_s first_segment {};
+	first_segment.timestamp = now;
+	first_segment.bezier_order = 2;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].position[0] = 2.6f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].position[1] = 2.4f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].position[2] = 2.7f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].yaw = 0.23f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].delta = NAN;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].position[0] = 2.6f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].position[1] = 2.4f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].position[2] = 3.7f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].yaw = 0.23f;
+	first_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].delta = 0.5f;
+
+	vehicle_trajectory_bezier_s second_segment = first_segment;
+	second_segment.timestamp = now + 500_ms;
+	second_segment.control_points[vehicle_trajectory_bezier_s::POINT_0].position[2] = 3.7f;
+	second_segment.control_points[vehicle_trajectory_bezier_s::POINT_1].position[2] = 4.7f;
+
+	uORB::PublicationQueued<vehicle_trajectory_bezier_s> vehicle_trajectory_bezier_pub{ORB_ID(vehicle_trajectory_bezier)};
+	vehicle_trajectory_bezier_pub.publish(first_segment);
+	vehicle_trajectory_bezier_pub.publish(second_segment);
+
+	vehicle_status_s vehicle_status{};
+	vehicle_status.nav_state = vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION;
+	uORB::Publication<vehicle_status_s> vehicle_status_pub{ORB_ID(vehicle_status)};
+	vehicle_status_pub.publish(vehicle_status);
+
+	// WHEN: we inject the bezier horizon in the interface
+	oa.injectAvoidanceSetpoints(pos_sp, vel_sp, yaw_sp, yaw_speed_sp);
+
+	// THEN: the first segment should be flown, the second one is kept for later
+	EXPECT_FLOAT_EQ(2.6f, pos_sp(0));
+	EXPECT_FLOAT_EQ(2.4f, pos_sp(1));
+	EXPECT_LT(2.7f, pos_sp(2));
+	EXPECT_GT(2.8f, pos_sp(2));
+	EXPECT_FLOAT_EQ(vel_sp(2), (3.7f - 2.7f) / 0.5f);
+}
@@ -87,6 +87,12 @@ CollisionPrevention::CollisionPrevention(ModuleParams *parent) :
 		_data_fov[i] = 0;
 		_obstacle_map_body_frame.distances[i] = UINT16_MAX;
 	}
+
+	// the bin directions are fixed in body frame, only the vehicle yaw needs to be applied at runtime
+	for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) {
+		const float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
+		_bin_directions[i] = Vector2f(cosf(angle), sinf(angle));
+	}
 }
 
 hrt_abstime CollisionPrevention::getTime()
@@ -199,7 +205,32 @@ CollisionPrevention::_updateObstacleMap()
 {
 	_sub_vehicle_attitude.update();
 
-	// add distance sensor data
+	if (_sub_obstacle_distance_rangefinder.advertised()) {
+		// distance sensors already binned into one message at a fixed rate (SENS_OBST_RATE)
+		obstacle_distance_s obstacle_distance;
+
+		if (_sub_obstacle_distance_rangefinder.update(&obstacle_distance)) {
+			_updateObstacleMap(obstacle_distance);
+		}
+
+	} else {
+		_addDistanceSensorUpdates();
+	}
+
+	// add obstacle distance data, merged from a consistent copy because the map can't be rolled back
+	obstacle_distance_s obstacle_distance;
+
+	if (_sub_obstacle_distance.update(&obstacle_distance)) {
+		_updateObstacleMap(obstacle_distance);
+	}
+
+	// publish fused obtacle distance message with data from offboard obstacle_distance and distance sensor
+	_obstacle_distance_pub.publish(_obstacle_map_body_frame);
+}
+
+void
+CollisionPrevention::_addDistanceSensorUpdates()
+{
 	for (unsigned i = 0; i < ORB_MULTI_MAX_INSTANCES; i++) {
 
 		// if a new distance sensor message has arrived
@@ -223,25 +254,21 @@ CollisionPrevention::_updateObstacleMap()
 			}
 		}
 	}
+}
 
-	// add obstacle distance data
-	if (_sub_obstacle_distance.update()) {
-		const obstacle_distance_s &obstacle_distance = _sub_obstacle_distance.get();
-
-		// Update map with obstacle data if the data is not stale
-		if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
-			//update message description
-			_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
-			_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
-								obstacle_distance.max_distance);
-			_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
-								obstacle_distance.min_distance);
-			_addObstacleSensorData(obstacle_distance, Quatf(_sub_vehicle_attitude.get().q));
-		}
+void
+CollisionPrevention::_updateObstacleMap(const obstacle_distance_s &obstacle_distance)
+{
+	// Update map with obstacle data if the data is not stale
+	if (getElapsedTime(&obstacle_distance.timestamp) < RANGE_STREAM_TIMEOUT_US && obstacle_distance.increment > 0.f) {
+		//update message description
+		_obstacle_map_body_frame.timestamp = math::max(_obstacle_map_body_frame.timestamp, obstacle_distance.timestamp);
+		_obstacle_map_body_frame.max_distance = math::max(_obstacle_map_body_frame.max_distance,
+							obstacle_distance.max_distance);
+		_obstacle_map_body_frame.min_distance = math::min(_obstacle_map_body_frame.min_distance,
+							obstacle_distance.min_distance);
+		_addObstacleSensorData(obstacle_distance, Quatf(_sub_vehicle_attitude.get().q));
 	}
-
-	// publish fused obtacle distance message with data from offboard obstacle_distance and distance sensor
-	_obstacle_distance_pub.publish(_obstacle_map_body_frame);
 }
 
 void
@@ -330,9 +357,13 @@ CollisionPrevention::_adaptSetpointDirection(Vector2f &setpoint_dir, int &setpoi
 
 	//only change setpoint direction if it was moved to a different bin
 	if (new_sp_index != setpoint_index) {
-		float angle = math::radians((float)new_sp_index * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-		angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
-		setpoint_dir = {cosf(angle), sinf(angle)};
+		// rotate the bin direction from body to local frame
+		const Vector2f &bin_direction = _bin_directions[new_sp_index];
+		const float cos_yaw = cosf(vehicle_yaw_angle_rad);
+		const float sin_yaw = sinf(vehicle_yaw_angle_rad);
+		setpoint_dir = {cos_yaw * bin_direction(0) - sin_yaw * bin_direction(1),
+				sin_yaw * bin_direction(0) + cos_yaw * bin_direction(1)
+			       };
 		setpoint_index = new_sp_index;
 	}
 }
@@ -419,6 +450,14 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 			// change setpoint direction slightly (max by _param_cp_guide_ang degrees) to help guide through narrow gaps
 			_adaptSetpointDirection(setpoint_dir, sp_index, vehicle_yaw_angle_rad);
 
+			// rotate the setpoint direction and the velocity into body frame once instead of every bin into local frame
+			const float cos_yaw = cosf(vehicle_yaw_angle_rad);
+			const float sin_yaw = sinf(vehicle_yaw_angle_rad);
+			const Vector2f setpoint_dir_body(cos_yaw * setpoint_dir(0) + sin_yaw * setpoint_dir(1),
+							 -sin_yaw * setpoint_dir(0) + cos_yaw * setpoint_dir(1));
+			const Vector2f curr_vel_body(cos_yaw * curr_vel(0) + sin_yaw * curr_vel(1),
+						     -sin_yaw * curr_vel(0) + cos_yaw * curr_vel(1));
+
 			// limit speed for safe flight
 			for (int i = 0; i < INTERNAL_MAP_USED_BINS; i++) { // disregard unused bins at the end of the message
 
@@ -431,13 +470,9 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 
 				const float distance = _obstacle_map_body_frame.distances[i] * 0.01f; // convert to meters
 				const float max_range = _data_maxranges[i] * 0.01f; // convert to meters
-				float angle = math::radians((float)i * INTERNAL_MAP_INCREMENT_DEG + _obstacle_map_body_frame.angle_offset);
-
-				// convert from body to local frame in the range [0, 2*pi]
-				angle = wrap_2pi(vehicle_yaw_angle_rad + angle);
 
-				// get direction of current bin
-				const Vector2f bin_direction = {cosf(angle), sinf(angle)};
+				// get direction of current bin (body frame)
+				const Vector2f &bin_direction = _bin_directions[i];
 
 				//count number of bins in the field of valid_new
 				if (_obstacle_map_body_frame.distances[i] < UINT16_MAX) {
@@ -447,9 +482,11 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 				if (_obstacle_map_body_frame.distances[i] > _obstacle_map_body_frame.min_distance
 				    && _obstacle_map_body_frame.distances[i] < UINT16_MAX) {
 
-					if (setpoint_dir.dot(bin_direction) > 0) {
+					const float projection = bin_direction.dot(setpoint_dir_body);
+
+					if (projection > 0) {
 						// calculate max allowed velocity with a P-controller (same gain as in the position controller)
-						const float curr_vel_parallel = math::max(0.f, curr_vel.dot(bin_direction));
+						const float curr_vel_parallel = math::max(0.f, curr_vel_body.dot(bin_direction));
 						float delay_distance = curr_vel_parallel * col_prev_dly;
 
 						if (distance < max_range) {
@@ -460,7 +497,6 @@ CollisionPrevention::_calculateConstrainedSetpoint(Vector2f &setpoint, const Vec
 						const float vel_max_posctrl = xy_p * stop_distance;
 
 						const float vel_max_smooth = math::trajectory::computeMaxSpeedFromDistance(max_jerk, max_accel, stop_distance, 0.f);
-						const float projection = bin_direction.dot(setpoint_dir);
 						float vel_max_bin = vel_max;
 
 						if (projection > 0.01f) {
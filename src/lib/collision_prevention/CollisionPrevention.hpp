@@ -88,6 +88,8 @@ protected:
 	uint64_t _data_timestamps[sizeof(_obstacle_map_body_frame.distances) / sizeof(_obstacle_map_body_frame.distances[0])];
 	uint16_t _data_maxranges[sizeof(_obstacle_map_body_frame.distances) / sizeof(
 										    _obstacle_map_body_frame.distances[0])]; /**< in cm */
+	matrix::Vector2f _bin_directions[sizeof(_obstacle_map_body_frame.distances) / sizeof(
+						 _obstacle_map_body_frame.distances[0])]; /**< unit vector of each bin in body frame */
 
 	void _addDistanceSensorData(distance_sensor_s &distance_sensor, const matrix::Quatf &vehicle_attitude);
 
@@ -97,6 +99,12 @@ protected:
 	 */
 	void _addObstacleSensorData(const obstacle_distance_s &obstacle, const matrix::Quatf &vehicle_attitude);
 
+	/**
+	 * Updates the obstacle map with an offboard obstacle_distance message if it is not stale
+	 * @param obstacle_distance, received obstacle_distance message
+	 */
+	void _updateObstacleMap(const obstacle_distance_s &obstacle_distance);
+
 	/**
 	 * Computes an adaption to the setpoint direction to guide towards free space
 	 * @param setpoint_dir, setpoint direction before collision prevention intervention
@@ -130,7 +138,8 @@ private:
 	uORB::Publication<obstacle_distance_s>		_obstacle_distance_pub{ORB_ID(obstacle_distance_fused)};	/**< obstacle_distance publication */
 	uORB::PublicationQueued<vehicle_command_s>	_vehicle_command_pub{ORB_ID(vehicle_command)};			/**< vehicle command do publication */
 
-	uORB::SubscriptionData<obstacle_distance_s> _sub_obstacle_distance{ORB_ID(obstacle_distance)}; /**< obstacle distances received form a range sensor */
+	uORB::Subscription _sub_obstacle_distance{ORB_ID(obstacle_distance)}; /**< obstacle distances received form a range sensor */
+	uORB::Subscription _sub_obstacle_distance_rangefinder{ORB_ID(obstacle_distance_rangefinder)}; /**< distance sensors binned by the sensors module */
 	uORB::Subscription _sub_distance_sensor[ORB_MULTI_MAX_INSTANCES] {{ORB_ID(distance_sensor), 0}, {ORB_ID(distance_sensor), 1}, {ORB_ID(distance_sensor), 2}, {ORB_ID(distance_sensor), 3}}; /**< distance data received from onboard rangefinders */
 	uORB::SubscriptionData<vehicle_attitude_s> _sub_vehicle_attitude{ORB_ID(vehicle_attitude)};
 
@@ -184,6 +193,12 @@ private:
 	 */
 	void _updateObstacleMap();
 
+	/**
+	 * Adds the new samples of each distance sensor instance to the internal obstacle map,
+	 * used when the sensors module does not bin them (SENS_OBST_RATE = 0)
+	 */
+	void _addDistanceSensorUpdates();
+
 	/**
 	 * Publishes vehicle command.
 	 */
@@ -0,0 +1,364 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file StaticBlocks.hpp
+ *
+ * Compile-time composed controller blocks.
+ *
+ * Counterparts of the basic controllib blocks whose parameters are bound at compile time
+ * through px4::params instead of being looked up by name, and that are composed by
+ * value instead of being linked into a runtime parent/child list. setDt() and updateParams()
+ * of a StaticSuperBlock are resolved at compile time and inlined, there are no virtual calls
+ * and no list traversals. Filter coefficients are only recomputed when dt or a parameter changes.
+ */
+
+#pragma once
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/param.h>
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <mathlib/math/Limits.hpp>
+
+#include "matrix/math.hpp"
+
+namespace control
+{
+
+/**
+ * Read a float parameter bound at compile time
+ */
+template<px4::params P>
+static inline float staticParamGet()
+{
+	float value = 0.f;
+	param_get(param_handle(P), &value);
+	return value;
+}
+
+/**
+ * A low pass filter, see BlockLowPass.
+ * Type can be float or a matrix::Vector.
+ */
+template<typename Type, px4::params FCUT>
+class StaticLowPass
+{
+public:
+	StaticLowPass() { param_set_used(param_handle(FCUT)); updateParams(); }
+
+	void setDt(float dt)
+	{
+		if (dt != _dt) {
+			_dt = dt;
+			updateCoefficient();
+		}
+	}
+
+	void updateParams()
+	{
+		_fcut = staticParamGet<FCUT>();
+		updateCoefficient();
+	}
+
+	const Type &update(const Type &input)
+	{
+		if (!_initialized) {
+			_state = input;
+			_initialized = true;
+		}
+
+		_state = _state + (input - _state) * _alpha;
+		return _state;
+	}
+
+	const Type &getState() const { return _state; }
+	float getFCut() const { return _fcut; }
+	float getDt() const { return _dt; }
+	void setState(const Type &state) { _state = state; _initialized = true; }
+	void reset() { _initialized = false; }
+
+private:
+	void updateCoefficient()
+	{
+		const float b = 2.f * M_PI_F * _fcut * _dt;
+		_alpha = b / (1.f + b);
+	}
+
+	Type _state{};
+	bool _initialized{false};
+	float _fcut{0.f};
+	float _dt{0.f};
+	float _alpha{0.f};
+};
+
+/**
+ * A high pass filter, see BlockHighPass
+ */
+template<px4::params FCUT>
+class StaticHighPass
+{
+public:
+	StaticHighPass() { param_set_used(param_handle(FCUT)); updateParams(); }
+
+	void setDt(float dt)
+	{
+		if (dt != _dt) {
+			_dt = dt;
+			updateCoefficient();
+		}
+	}
+
+	void updateParams()
+	{
+		_fcut = staticParamGet<FCUT>();
+		updateCoefficient();
+	}
+
+	float update(float input)
+	{
+		_y = _alpha * (_y + input - _u);
+		_u = input;
+		return _y;
+	}
+
+	float getU() const { return _u; }
+	float getY() const { return _y; }
+	float getFCut() const { return _fcut; }
+	float getDt() const { return _dt; }
+	void setU(float u) { _u = u; }
+	void setY(float y) { _y = y; }
+
+private:
+	void updateCoefficient()
+	{
+		_alpha = 1.f / (1.f + 2.f * M_PI_F * _fcut * _dt);
+	}
+
+	float _u{0.f}; /**< previous input */
+	float _y{0.f}; /**< previous output */
+	float _fcut{0.f};
+	float _dt{0.f};
+	float _alpha{1.f};
+};
+
+/**
+ * An integral with symmetric saturation of the state, see BlockIntegral
+ */
+template<px4::params MAX>
+class StaticIntegral
+{
+public:
+	StaticIntegral() { param_set_used(param_handle(MAX)); updateParams(); }
+
+	void setDt(float dt) { _dt = dt; }
+	void updateParams() { _max = staticParamGet<MAX>(); }
+
+	float update(float input)
+	{
+		_y = math::constrain(_y + input * _dt, -_max, _max);
+		return _y;
+	}
+
+	float getY() const { return _y; }
+	float getMax() const { return _max; }
+	float getDt() const { return _dt; }
+	void setY(float y) { _y = y; }
+
+private:
+	float _y{0.f}; /**< previous output */
+	float _max{0.f};
+	float _dt{0.f};
+};
+
+/**
+ * A low pass filtered derivative of the input, see BlockDerivative
+ */
+template<px4::params LP>
+class StaticDerivative
+{
+public:
+	void setDt(float dt)
+	{
+		_dt = dt;
+		_dt_inv = (dt > FLT_EPSILON) ? 1.f / dt : 0.f;
+		_low_pass.setDt(dt);
+	}
+
+	void updateParams() { _low_pass.updateParams(); }
+
+	float update(float input)
+	{
+		float output = 0.f;
+
+		if (_initialized) {
+			output = _low_pass.update((input - _u) * _dt_inv);
+
+		} else {
+			// no valid derivative on the first call, assume the input isn't changing
+			_low_pass.update(0.f);
+			_initialized = true;
+		}
+
+		_u = input;
+		return output;
+	}
+
+	float getU() const { return _u; }
+	float getLP() const { return _low_pass.getFCut(); }
+	float getO() const { return _low_pass.getState(); }
+	float getDt() const { return _dt; }
+	void setU(float u) { _u = u; }
+	void reset() { _initialized = false; }
+
+private:
+	float _u{0.f}; /**< previous input */
+	float _dt{0.f};
+	float _dt_inv{0.f};
+	bool _initialized{false};
+	StaticLowPass<float, LP> _low_pass;
+};
+
+/**
+ * A proportional-integral-derivative controller, see BlockPID
+ */
+template<px4::params KP, px4::params KI, px4::params KD, px4::params I_MAX, px4::params D_LP>
+class StaticPID
+{
+public:
+	StaticPID()
+	{
+		param_set_used(param_handle(KP));
+		param_set_used(param_handle(KI));
+		param_set_used(param_handle(KD));
+		updateGains();
+	}
+
+	void setDt(float dt)
+	{
+		_integral.setDt(dt);
+		_derivative.setDt(dt);
+	}
+
+	void updateParams()
+	{
+		updateGains();
+		_integral.updateParams();
+		_derivative.updateParams();
+	}
+
+	float update(float input)
+	{
+		return _kp * input + _ki * _integral.update(input) + _kd * _derivative.update(input);
+	}
+
+	float getKP() const { return _kp; }
+	float getKI() const { return _ki; }
+	float getKD() const { return _kd; }
+	float getDt() const { return _integral.getDt(); }
+	StaticIntegral<I_MAX> &getIntegral() { return _integral; }
+	StaticDerivative<D_LP> &getDerivative() { return _derivative; }
+
+private:
+	void updateGains()
+	{
+		_kp = staticParamGet<KP>();
+		_ki = staticParamGet<KI>();
+		_kd = staticParamGet<KD>();
+	}
+
+	float _kp{0.f};
+	float _ki{0.f};
+	float _kd{0.f};
+	StaticIntegral<I_MAX> _integral;
+	StaticDerivative<D_LP> _derivative;
+};
+
+/**
+ * Composition of static blocks.
+ *
+ * Owns the blocks by value, setDt() and updateParams() are forwarded to all of them.
+ * The blocks are accessed by their index with get<I>().
+ */
+template<typename... Blocks>
+class StaticSuperBlock;
+
+template<>
+class StaticSuperBlock<>
+{
+public:
+	void setDt(float) {}
+	void updateParams() {}
+};
+
+template<typename First, typename... Rest>
+class StaticSuperBlock<First, Rest...>
+{
+public:
+	void setDt(float dt)
+	{
+		_first.setDt(dt);
+		_rest.setDt(dt);
+	}
+
+	void updateParams()
+	{
+		_first.updateParams();
+		_rest.updateParams();
+	}
+
+	template<size_t I>
+	auto &get() { return Element<I>::get(*this); }
+
+	First &first() { return _first; }
+	StaticSuperBlock<Rest...> &rest() { return _rest; }
+
+private:
+	template<size_t I, typename Dummy = void>
+	struct Element {
+		template<typename Super>
+		static auto &get(Super &super) { return super.rest().template get<I - 1>(); }
+	};
+
+	template<typename Dummy>
+	struct Element<0, Dummy> {
+		template<typename Super>
+		static auto &get(Super &super) { return super.first(); }
+	};
+
+	First _first;
+	StaticSuperBlock<Rest...> _rest;
+};
+
+} // namespace control
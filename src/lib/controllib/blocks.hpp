@@ -57,3 +57,4 @@
 #include "BlockRandGauss.hpp"
 #include "BlockRandUniform.hpp"
 #include "BlockStats.hpp"
+#include "StaticBlocks.hpp"
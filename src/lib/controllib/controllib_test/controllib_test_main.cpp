@@ -66,6 +66,7 @@ int blockRandUniformTest();
 int blockRandGaussTest();
 int blockStatsTest();
 int blockDelayTest();
+int staticBlocksTest();
 
 int basicBlocksTest()
 {
@@ -87,6 +88,7 @@ int basicBlocksTest()
 	failed = failed || blockRandGaussTest() < 0;
 	failed = failed || blockStatsTest() < 0;
 	failed = failed || blockDelayTest() < 0;
+	failed = failed || staticBlocksTest() < 0;
 	return failed ? -1 : 0;
 }
 
@@ -527,6 +529,43 @@ int blockDelayTest()
 	return 0;
 }
 
+int staticBlocksTest()
+{
+	printf("Test StaticBlocks\t\t: ");
+	// same results as the runtime composed blocks
+	StaticLowPass<float, px4::params::TEST_LP> lowPass;
+	lowPass.setDt(0.1f);
+	lowPass.setState(1.0f);
+	ASSERT_CL(equal(10.0f, lowPass.getFCut()));
+	ASSERT_CL(equal(1.8626974f, lowPass.update(2.0f)));
+
+	StaticHighPass<px4::params::TEST_HP> highPass;
+	highPass.setDt(0.1f);
+	highPass.setU(1.0f);
+	highPass.setY(1.0f);
+	ASSERT_CL(equal(0.2746051f, highPass.update(2.0f)));
+
+	StaticPID<px4::params::TEST_P, px4::params::TEST_I, px4::params::TEST_D, px4::params::TEST_I_MAX,
+		  px4::params::TEST_D_LP> blockPID;
+	blockPID.setDt(0.1f);
+	ASSERT_CL(equal(0.2f, blockPID.getKP()));
+	ASSERT_CL(equal(1.0f, blockPID.getIntegral().getMax()));
+	blockPID.getDerivative().setU(1.0f);
+	blockPID.getDerivative().update(1.0f);
+	blockPID.getIntegral().setY(0.1f);
+	ASSERT_CL(equal(0.5162697f, blockPID.update(2.0f)));
+
+	// dt and parameter updates reach all composed blocks
+	StaticSuperBlock<StaticLowPass<float, px4::params::TEST_LP>, StaticIntegral<px4::params::TEST_I_MAX>> superBlock;
+	superBlock.setDt(0.1f);
+	superBlock.updateParams();
+	ASSERT_CL(equal(0.1f, superBlock.get<0>().getDt()));
+	ASSERT_CL(equal(0.1f, superBlock.get<1>().getDt()));
+	ASSERT_CL(equal(1.0f, superBlock.get<1>().update(20.0f)));
+	printf("PASS\n");
+	return 0;
+}
+
 extern "C" __EXPORT int controllib_test_main(int argc, char *argv[]);
 
 int controllib_test_main(int argc, char *argv[])
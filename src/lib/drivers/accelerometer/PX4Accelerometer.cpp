@@ -279,10 +279,50 @@ void PX4Accelerometer::updateFIFO(const FIFOSample &sample)
 		_integrator_samples += 1;
 		_integrator_fifo_samples += N;
 
-		// trapezoidal integration (equally spaced, scaled by dt later)
-		_integration_raw(0) += (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1));
-		_integration_raw(1) += (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1));
-		_integration_raw(2) += (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1));
+		// trapezoidal integration (equally spaced, scaled by dt later), accumulated
+		//  in integer at twice the value so the raw data is only converted once per integration interval
+		_integration_raw[0] += _last_sample[0] + sample.x[N - 1] + 2 * sum(sample.x, N - 1);
+		_integration_raw[1] += _last_sample[1] + sample.y[N - 1] + 2 * sum(sample.y, N - 1);
+		_integration_raw[2] += _last_sample[2] + sample.z[N - 1] + 2 * sum(sample.z, N - 1);
+
+		// sculling correction on the full FIFO data, requires gyro data from the same FIFO transfer
+		if (_gyro != nullptr) {
+			const PX4Gyroscope::FIFODeltaAngle &gyro = _gyro->fifo_delta_angle();
+
+			if ((gyro.timestamp_sample == sample.timestamp_sample) && (gyro.samples >= N) && (gyro.samples % N == 0)) {
+				// gyro samples per accel sample
+				const int R = gyro.samples / N;
+
+				for (int n = 0; n < N; n++) {
+					float x = 0.5f * ((n == 0 ? _last_sample[0] : sample.x[n - 1]) + sample.x[n]);
+					float y = 0.5f * ((n == 0 ? _last_sample[1] : sample.y[n - 1]) + sample.y[n]);
+					float z = 0.5f * ((n == 0 ? _last_sample[2] : sample.z[n - 1]) + sample.z[n]);
+					rotate_3f(_rotation, x, y, z);
+
+					const Vector3f delta_nu{((Vector3f{x, y, z} * _scale) - _calibration_offset).emult(_calibration_scale) * 1e-6f * dt};
+
+					Vector3f delta_alpha{};
+
+					for (int r = 0; r < R; r++) {
+						delta_alpha += gyro.delta_angle[n * R + r];
+					}
+
+					// Savage (1998) Strapdown Inertial Navigation Integration Algorithm Design Part 2, eq. 7.2.2.2.2-15
+					//  sculling += 1/2 ((alpha + 1/6 delta_alpha_prev) x delta_nu + (nu + 1/6 delta_nu_prev) x delta_alpha)
+					_sculling += ((_sculling_alpha + _sculling_delta_alpha_prev * (1.f / 6.f)) % delta_nu
+						      + (_sculling_nu + _sculling_delta_nu_prev * (1.f / 6.f)) % delta_alpha) * 0.5f;
+
+					_sculling_alpha += delta_alpha;
+					_sculling_nu += delta_nu;
+					_sculling_delta_alpha_prev = delta_alpha;
+					_sculling_delta_nu_prev = delta_nu;
+				}
+
+			} else {
+				_sculling_valid = false;
+			}
+		}
+
 		_last_sample[0] = sample.x[N - 1];
 		_last_sample[1] = sample.y[N - 1];
 		_last_sample[2] = sample.z[N - 1];
@@ -290,14 +330,16 @@ void PX4Accelerometer::updateFIFO(const FIFOSample &sample)
 
 		if (_integrator_fifo_samples > 0 && (_integrator_samples >= _integrator_reset_samples)) {
 
+			Vector3f integration_raw{0.5f * _integration_raw[0], 0.5f * _integration_raw[1], 0.5f * _integration_raw[2]};
+
 			// Apply rotation (before scaling)
-			rotate_3f(_rotation, _integration_raw(0), _integration_raw(1), _integration_raw(2));
+			rotate_3f(_rotation, integration_raw(0), integration_raw(1), integration_raw(2));
 
 			// scale calibration offset to number of samples
 			const Vector3f offset{_calibration_offset * _integrator_fifo_samples};
 
 			// Apply calibration and scale to seconds
-			const Vector3f delta_velocity{((_integration_raw * _scale) - offset).emult(_calibration_scale) * 1e-6f * dt};
+			const Vector3f delta_velocity{((integration_raw * _scale) - offset).emult(_calibration_scale) * 1e-6f * dt};
 
 			// fill sensor_accel_integrated and publish
 			sensor_accel_integrated_s report;
@@ -305,7 +347,14 @@ void PX4Accelerometer::updateFIFO(const FIFOSample &sample)
 			report.timestamp_sample = sample.timestamp_sample;
 			report.error_count = _error_count;
 			report.device_id = _device_id;
-			delta_velocity.copyTo(report.delta_velocity);
+			if ((_gyro != nullptr) && _sculling_valid) {
+				// rotation and sculling correction, referenced to the body frame at the start of the integration interval
+				const Vector3f delta_velocity_corrected{delta_velocity + (_sculling_alpha % delta_velocity) * 0.5f + _sculling};
+				delta_velocity_corrected.copyTo(report.delta_velocity);
+
+			} else {
+				delta_velocity.copyTo(report.delta_velocity);
+			}
 			report.dt = _integrator_fifo_samples * dt; // time span in microseconds
 			report.samples = _integrator_fifo_samples;
 
@@ -376,9 +425,18 @@ void PX4Accelerometer::ResetIntegrator()
 {
 	_integrator_samples = 0;
 	_integrator_fifo_samples = 0;
-	_integration_raw.zero();
+	_integration_raw[0] = 0;
+	_integration_raw[1] = 0;
+	_integration_raw[2] = 0;
 	_integrator_clipping.zero();
 
+	_sculling_alpha.zero();
+	_sculling_nu.zero();
+	_sculling_delta_alpha_prev.zero();
+	_sculling_delta_nu_prev.zero();
+	_sculling.zero();
+	_sculling_valid = true;
+
 	_timestamp_sample_prev = 0;
 }
 
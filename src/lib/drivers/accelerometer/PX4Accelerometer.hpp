@@ -38,6 +38,7 @@
 #include <lib/cdev/CDev.hpp>
 #include <lib/conversion/rotation.h>
 #include <lib/drivers/device/integrator.h>
+#include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
 #include <lib/ecl/geo/geo.h>
 #include <px4_platform_common/module_params.h>
 #include <uORB/PublicationMulti.hpp>
@@ -59,6 +60,7 @@ public:
 
 	void set_device_id(uint32_t device_id) { _device_id = device_id; }
 	void set_device_type(uint8_t devtype);
+	void set_gyroscope(const PX4Gyroscope *gyro) { _gyro = gyro; }
 	void set_error_count(uint64_t error_count) { _error_count = error_count; }
 	void increase_error_count() { _error_count++; }
 	void set_range(float range) { _range = range; UpdateClipLimit(); }
@@ -126,13 +128,22 @@ private:
 
 	// integrator
 	hrt_abstime		_timestamp_sample_prev{0};
-	matrix::Vector3f	_integration_raw{};
+	int32_t			_integration_raw[3] {};	// 2x trapezoidal sum, at most 255 samples of int16 can't overflow
 	matrix::Vector3f	_integrator_clipping{};
 	int16_t			_last_sample[3] {};
 	uint8_t			_integrator_reset_samples{4};
 	uint8_t			_integrator_samples{0};
 	uint8_t			_integrator_fifo_samples{0};
 
+	// sculling correction, using the delta angles from the gyro of the same IMU
+	const PX4Gyroscope	*_gyro{nullptr};
+	matrix::Vector3f	_sculling_alpha{};		// delta angle accumulated over the integration interval
+	matrix::Vector3f	_sculling_nu{};			// delta velocity accumulated over the integration interval
+	matrix::Vector3f	_sculling_delta_alpha_prev{};
+	matrix::Vector3f	_sculling_delta_nu_prev{};
+	matrix::Vector3f	_sculling{};			// accumulated sculling correction
+	bool			_sculling_valid{true};		// all samples of the integration interval had matching gyro data
+
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::IMU_INTEG_RATE>) _param_imu_integ_rate
 	)
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SPSCRingBuffer.hpp
+ *
+ * Typed single producer, single consumer ring buffer without locking.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <px4_platform_common/atomic.h>
+
+namespace ringbuffer
+{
+
+/**
+ * Fixed size ring buffer for one producer and one consumer context (e.g. an interrupt
+ * handler and a work queue item), which can run concurrently without further locking.
+ *
+ * The head is only written by the producer (put*()), the tail only by the consumer (get*(), flush()).
+ * The indices run freely and are masked with the power-of-two capacity, so all N items can be used.
+ *
+ * Items are copied with memcpy(), T needs to be trivially copyable.
+ *
+ * @tparam T	item type
+ * @tparam N	capacity in items, a power of two
+ */
+template<typename T, size_t N>
+class SPSCRingBuffer
+{
+	static_assert((N > 0) && ((N & (N - 1)) == 0), "N must be a power of two");
+	static_assert(N <= (UINT32_MAX / 2), "N too large");
+
+public:
+	SPSCRingBuffer() = default;
+	~SPSCRingBuffer() = default;
+
+	// no copy, assignment, move, move assignment
+	SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+	SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+	SPSCRingBuffer(SPSCRingBuffer &&) = delete;
+	SPSCRingBuffer &operator=(SPSCRingBuffer &&) = delete;
+
+	/**
+	 * Put an item into the buffer (producer).
+	 *
+	 * @param item		Item to put
+	 * @return		true if the item was put, false if the buffer is full
+	 */
+	bool put(const T &item) { return put_n(&item, 1) == 1; }
+
+	/**
+	 * Put up to n items into the buffer (producer), with at most two copies.
+	 *
+	 * @param items		Items to put
+	 * @param n		Number of items
+	 * @return		Number of items put, less than n if the buffer is full
+	 */
+	size_t put_n(const T *items, size_t n)
+	{
+		const uint32_t head = _head.load();
+		const size_t space_left = N - (head - _tail.load());
+
+		if (n > space_left) {
+			n = space_left;
+		}
+
+		copy_in(head, items, n);
+
+		// publish the items to the consumer
+		_head.store(head + n);
+		return n;
+	}
+
+	/**
+	 * Get an item from the buffer (consumer).
+	 *
+	 * @param item		Item that was gotten
+	 * @return		true if an item was got, false if the buffer was empty
+	 */
+	bool get(T &item) { return get_n(&item, 1) == 1; }
+
+	/**
+	 * Get up to n items from the buffer (consumer), with at most two copies.
+	 *
+	 * @param items		Buffer for at least n items
+	 * @param n		Maximum number of items to get
+	 * @return		Number of items got
+	 */
+	size_t get_n(T *items, size_t n)
+	{
+		const uint32_t tail = _tail.load();
+		const size_t available = _head.load() - tail;
+
+		if (n > available) {
+			n = available;
+		}
+
+		copy_out(tail, items, n);
+
+		// release the slots to the producer
+		_tail.store(tail + n);
+		return n;
+	}
+
+	/**
+	 * Remove all items (consumer).
+	 */
+	void flush() { _tail.store(_head.load()); }
+
+	/**
+	 * Number of items that can be got before the buffer is empty.
+	 */
+	size_t count() const { return _head.load() - _tail.load(); }
+
+	/**
+	 * Number of items that can be put before the buffer is full.
+	 */
+	size_t space() const { return N - count(); }
+
+	bool empty() const { return count() == 0; }
+	bool full() const { return count() == N; }
+
+	static constexpr size_t size() { return N; }
+
+private:
+	static constexpr uint32_t MASK{N - 1};
+
+	void copy_in(uint32_t head, const T *items, size_t n)
+	{
+		const size_t index = head & MASK;
+		const size_t first = (n < N - index) ? n : N - index;
+
+		memcpy(&_items[index], items, first * sizeof(T));
+		memcpy(&_items[0], items + first, (n - first) * sizeof(T));
+	}
+
+	void copy_out(uint32_t tail, T *items, size_t n) const
+	{
+		const size_t index = tail & MASK;
+		const size_t first = (n < N - index) ? n : N - index;
+
+		memcpy(items, &_items[index], first * sizeof(T));
+		memcpy(items + first, &_items[0], (n - first) * sizeof(T));
+	}
+
+	T _items[N] {};
+
+	px4::atomic<uint32_t> _head{0};	///< insertion index (free running), written by the producer
+	px4::atomic<uint32_t> _tail{0};	///< removal index (free running), written by the consumer
+};
+
+} // namespace ringbuffer
@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SPSCRingBufferTest.cpp
+ * Tests for the typed single producer, single consumer ring buffer.
+ */
+
+#include <gtest/gtest.h>
+
+#include <pthread.h>
+
+#include "SPSCRingBuffer.hpp"
+
+using ringbuffer::SPSCRingBuffer;
+
+TEST(SPSCRingBufferTest, Empty)
+{
+	SPSCRingBuffer<uint32_t, 8> buffer;
+
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_FALSE(buffer.full());
+	EXPECT_EQ(buffer.count(), 0u);
+	EXPECT_EQ(buffer.space(), 8u);
+	EXPECT_EQ(buffer.size(), 8u);
+
+	uint32_t value = 0;
+	EXPECT_FALSE(buffer.get(value));
+}
+
+TEST(SPSCRingBufferTest, PutGet)
+{
+	SPSCRingBuffer<uint32_t, 4> buffer;
+
+	// the whole capacity can be used
+	for (uint32_t i = 0; i < 4; i++) {
+		EXPECT_TRUE(buffer.put(i));
+	}
+
+	EXPECT_TRUE(buffer.full());
+	EXPECT_FALSE(buffer.put(4));
+
+	for (uint32_t i = 0; i < 4; i++) {
+		uint32_t value = 0;
+		EXPECT_TRUE(buffer.get(value));
+		EXPECT_EQ(value, i);
+	}
+
+	EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCRingBufferTest, BulkWrapAround)
+{
+	SPSCRingBuffer<uint8_t, 16> buffer;
+	uint8_t in[16];
+	uint8_t out[16];
+	uint8_t next_in = 0;
+	uint8_t next_out = 0;
+
+	// odd sized chunks, so the copies are split at the end of the buffer
+	for (int iteration = 0; iteration < 100; iteration++) {
+		const size_t put_len = 1 + iteration % 11;
+
+		for (size_t i = 0; i < put_len; i++) {
+			in[i] = next_in + i;
+		}
+
+		const size_t space = buffer.space();
+		const size_t put = buffer.put_n(in, put_len);
+		EXPECT_EQ(put, put_len < space ? put_len : space);
+		next_in += put;
+
+		const size_t get_len = 1 + iteration % 7;
+		const size_t count = buffer.count();
+		const size_t got = buffer.get_n(out, get_len);
+		EXPECT_EQ(got, get_len < count ? get_len : count);
+
+		for (size_t i = 0; i < got; i++) {
+			EXPECT_EQ(out[i], next_out++);
+		}
+	}
+
+	buffer.flush();
+	EXPECT_TRUE(buffer.empty());
+	EXPECT_EQ(buffer.get_n(out, sizeof(out)), 0u);
+}
+
+TEST(SPSCRingBufferTest, Struct)
+{
+	struct item_s {
+		uint64_t timestamp;
+		float value;
+	};
+
+	SPSCRingBuffer<item_s, 2> buffer;
+
+	EXPECT_TRUE(buffer.put(item_s{1, 1.5f}));
+	EXPECT_TRUE(buffer.put(item_s{2, 2.5f}));
+	EXPECT_FALSE(buffer.put(item_s{3, 3.5f}));
+
+	item_s item{};
+	EXPECT_TRUE(buffer.get(item));
+	EXPECT_EQ(item.timestamp, 1u);
+	EXPECT_FLOAT_EQ(item.value, 1.5f);
+}
+
+static constexpr uint32_t THREAD_TEST_ITEMS = 10000;
+
+static void *producer(void *arg)
+{
+	auto *buffer = static_cast<SPSCRingBuffer<uint32_t, 64> *>(arg);
+	uint32_t next = 0;
+	uint32_t chunk[5];
+
+	while (next < THREAD_TEST_ITEMS) {
+		size_t len = 0;
+
+		while (len < 5 && next + len < THREAD_TEST_ITEMS) {
+			chunk[len] = next + len;
+			len++;
+		}
+
+		// a partially put chunk is continued in the next iteration
+		next += buffer->put_n(chunk, len);
+	}
+
+	return nullptr;
+}
+
+TEST(SPSCRingBufferTest, ConcurrentProducerConsumer)
+{
+	SPSCRingBuffer<uint32_t, 64> buffer;
+
+	pthread_t thread;
+	ASSERT_EQ(pthread_create(&thread, nullptr, producer, &buffer), 0);
+
+	uint32_t expected = 0;
+	uint32_t chunk[7];
+	bool in_order = true;
+
+	while (expected < THREAD_TEST_ITEMS) {
+		const size_t got = buffer.get_n(chunk, 7);
+
+		for (size_t i = 0; i < got; i++) {
+			in_order = in_order && (chunk[i] == expected);
+			expected++;
+		}
+	}
+
+	pthread_join(thread, nullptr);
+
+	EXPECT_TRUE(in_order);
+	EXPECT_TRUE(buffer.empty());
+}
@@ -278,10 +278,34 @@ void PX4Gyroscope::updateFIFO(const FIFOSample &sample)
 		_integrator_samples += 1;
 		_integrator_fifo_samples += N;
 
-		// trapezoidal integration (equally spaced, scaled by dt later)
-		_integration_raw(0) += (0.5f * (_last_sample[0] + sample.x[N - 1]) + sum(sample.x, N - 1));
-		_integration_raw(1) += (0.5f * (_last_sample[1] + sample.y[N - 1]) + sum(sample.y, N - 1));
-		_integration_raw(2) += (0.5f * (_last_sample[2] + sample.z[N - 1]) + sum(sample.z, N - 1));
+		// trapezoidal integration (equally spaced, scaled by dt later), accumulated
+		//  in integer at twice the value so the raw data is only converted once per integration interval
+		_integration_raw[0] += _last_sample[0] + sample.x[N - 1] + 2 * sum(sample.x, N - 1);
+		_integration_raw[1] += _last_sample[1] + sample.y[N - 1] + 2 * sum(sample.y, N - 1);
+		_integration_raw[2] += _last_sample[2] + sample.z[N - 1] + 2 * sum(sample.z, N - 1);
+
+		// coning correction on the full FIFO data
+		//  calibrated delta angle of every sample (board frame)
+		_fifo_delta_angle.timestamp_sample = sample.timestamp_sample;
+		_fifo_delta_angle.samples = N;
+
+		for (int n = 0; n < N; n++) {
+			float x = 0.5f * ((n == 0 ? _last_sample[0] : sample.x[n - 1]) + sample.x[n]);
+			float y = 0.5f * ((n == 0 ? _last_sample[1] : sample.y[n - 1]) + sample.y[n]);
+			float z = 0.5f * ((n == 0 ? _last_sample[2] : sample.z[n - 1]) + sample.z[n]);
+			rotate_3f(_rotation, x, y, z);
+
+			const Vector3f delta_alpha{((Vector3f{x, y, z} * _scale) - _calibration_offset) * 1e-6f * dt};
+
+			// Savage (1998) Strapdown Inertial Navigation Integration Algorithm Design Part 1, eq. 7.1.1.1-11
+			//  beta += 1/2 (alpha + 1/6 delta_alpha_prev) x delta_alpha
+			_coning_beta += (_coning_alpha + _coning_delta_alpha_prev * (1.f / 6.f)) % delta_alpha * 0.5f;
+			_coning_alpha += delta_alpha;
+			_coning_delta_alpha_prev = delta_alpha;
+
+			_fifo_delta_angle.delta_angle[n] = delta_alpha;
+		}
+
 		_last_sample[0] = sample.x[N - 1];
 		_last_sample[1] = sample.y[N - 1];
 		_last_sample[2] = sample.z[N - 1];
@@ -289,14 +313,16 @@ void PX4Gyroscope::updateFIFO(const FIFOSample &sample)
 
 		if (_integrator_fifo_samples > 0 && (_integrator_samples >= _integrator_reset_samples)) {
 
+			Vector3f integration_raw{0.5f * _integration_raw[0], 0.5f * _integration_raw[1], 0.5f * _integration_raw[2]};
+
 			// Apply rotation (before scaling)
-			rotate_3f(_rotation, _integration_raw(0), _integration_raw(1), _integration_raw(2));
+			rotate_3f(_rotation, integration_raw(0), integration_raw(1), integration_raw(2));
 
 			// scale calibration offset to number of samples
 			const Vector3f offset{_calibration_offset * _integrator_fifo_samples};
 
 			// Apply calibration and scale to seconds
-			const Vector3f delta_angle{((_integration_raw * _scale) - offset) * 1e-6f * dt};
+			const Vector3f delta_angle{((integration_raw * _scale) - offset) * 1e-6f * dt};
 
 			// fill sensor_gyro_integrated and publish
 			sensor_gyro_integrated_s report;
@@ -304,7 +330,9 @@ void PX4Gyroscope::updateFIFO(const FIFOSample &sample)
 			report.timestamp_sample = sample.timestamp_sample;
 			report.error_count = _error_count;
 			report.device_id = _device_id;
-			delta_angle.copyTo(report.delta_angle);
+			// rotation vector with coning correction
+			const Vector3f delta_angle_corrected{delta_angle + _coning_beta};
+			delta_angle_corrected.copyTo(report.delta_angle);
 			report.dt = _integrator_fifo_samples * dt; // time span in microseconds
 			report.samples = _integrator_fifo_samples;
 
@@ -328,21 +356,29 @@ void PX4Gyroscope::updateFIFO(const FIFOSample &sample)
 		_timestamp_sample_prev = sample.timestamp_sample;
 	}
 
-	// publish sensor fifo
-	sensor_gyro_fifo_s fifo{};
+	// publish sensor fifo, filled in place in the uORB queue
+	sensor_gyro_fifo_s *fifo = _sensor_fifo_pub.loan();
 
-	fifo.device_id = _device_id;
-	fifo.timestamp_sample = sample.timestamp_sample;
-	fifo.dt = dt;
-	fifo.scale = _scale;
-	fifo.samples = N;
+	if (fifo != nullptr) {
+		fifo->device_id = _device_id;
+		fifo->timestamp_sample = sample.timestamp_sample;
+		fifo->dt = dt;
+		fifo->scale = _scale;
+		fifo->samples = N;
 
-	memcpy(fifo.x, sample.x, sizeof(sample.x[0]) * N);
-	memcpy(fifo.y, sample.y, sizeof(sample.y[0]) * N);
-	memcpy(fifo.z, sample.z, sizeof(sample.z[0]) * N);
+		memcpy(fifo->x, sample.x, sizeof(sample.x[0]) * N);
+		memcpy(fifo->y, sample.y, sizeof(sample.y[0]) * N);
+		memcpy(fifo->z, sample.z, sizeof(sample.z[0]) * N);
 
-	fifo.timestamp = hrt_absolute_time();
-	_sensor_fifo_pub.publish(fifo);
+		// the slot is reused, clear any stale samples
+		const size_t unused = sizeof(fifo->x) - sizeof(sample.x[0]) * N;
+		memset(&fifo->x[N], 0, unused);
+		memset(&fifo->y[N], 0, unused);
+		memset(&fifo->z[N], 0, unused);
+
+		fifo->timestamp = hrt_absolute_time();
+		_sensor_fifo_pub.commit();
+	}
 
 
 	PublishStatus();
@@ -376,9 +412,15 @@ void PX4Gyroscope::ResetIntegrator()
 {
 	_integrator_samples = 0;
 	_integrator_fifo_samples = 0;
-	_integration_raw.zero();
+	_integration_raw[0] = 0;
+	_integration_raw[1] = 0;
+	_integration_raw[2] = 0;
 	_integrator_clipping.zero();
 
+	_coning_alpha.zero();
+	_coning_beta.zero();
+	_coning_delta_alpha_prev.zero();
+
 	_timestamp_sample_prev = 0;
 }
 
@@ -86,6 +86,18 @@ public:
 
 	void updateFIFO(const FIFOSample &sample);
 
+	// calibrated delta angles (rad) of every sample from the last FIFO update
+	struct FIFODeltaAngle {
+		hrt_abstime timestamp_sample{0};
+		uint8_t samples{0};
+		matrix::Vector3f delta_angle[32] {};
+	};
+
+	/**
+	 * Delta angles of the last FIFO update, used by the PX4Accelerometer of the same IMU for the sculling correction.
+	 */
+	const FIFODeltaAngle &fifo_delta_angle() const { return _fifo_delta_angle; }
+
 private:
 
 	void PublishStatus();
@@ -127,13 +139,20 @@ private:
 
 	// integrator
 	hrt_abstime		_timestamp_sample_prev{0};
-	matrix::Vector3f	_integration_raw{};
+	int32_t			_integration_raw[3] {};	// 2x trapezoidal sum, at most 255 samples of int16 can't overflow
 	matrix::Vector3f	_integrator_clipping{};
 	int16_t			_last_sample[3] {};
 	uint8_t			_integrator_reset_samples{4};
 	uint8_t			_integrator_samples{0};
 	uint8_t			_integrator_fifo_samples{0};
 
+	// coning correction
+	matrix::Vector3f	_coning_alpha{};		// delta angle accumulated over the integration interval
+	matrix::Vector3f	_coning_beta{};			// accumulated coning correction
+	matrix::Vector3f	_coning_delta_alpha_prev{};	// delta angle of the previous FIFO sample
+
+	FIFODeltaAngle		_fifo_delta_angle{};
+
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::IMU_GYRO_RATEMAX>) _param_imu_gyro_rate_max,
 		(ParamInt<px4::params::IMU_INTEG_RATE>) _param_imu_integ_rate
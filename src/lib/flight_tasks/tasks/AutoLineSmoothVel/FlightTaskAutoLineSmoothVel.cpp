@@ -388,11 +388,9 @@ void FlightTaskAutoLineSmoothVel::_generateTrajectory()
 
 	_updateTrajConstraints();
 
-	for (int i = 0; i < 3; ++i) {
-		_trajectory[i].updateDurations(_velocity_setpoint(i));
-	}
-
-	VelocitySmoothing::timeSynchronization(_trajectory, 3);
+	// only solves for new durations if the velocity setpoint or the constraints changed
+	const float vel_sp[3] = {_velocity_setpoint(0), _velocity_setpoint(1), _velocity_setpoint(2)};
+	VelocitySmoothing::updateDurationsSynchronized(_trajectory, vel_sp, 3);
 
 	_jerk_setpoint = jerk_sp_smooth;
 	_acceleration_setpoint = accel_sp_smooth;
@@ -10,6 +10,12 @@ const ekf_reset_counters_s FlightTask::zero_reset_counters = {};
 const vehicle_constraints_s FlightTask::empty_constraints = {0, NAN, NAN, NAN, NAN, NAN, NAN, NAN, false, {}};
 const landing_gear_s FlightTask::empty_landing_gear_default_keep = {0, landing_gear_s::GEAR_KEEP, {}};
 
+FlightTaskSubscriptions &FlightTask::subscriptions()
+{
+	static FlightTaskSubscriptions subscriptions;
+	return subscriptions;
+}
+
 bool FlightTask::activate(vehicle_local_position_setpoint_s last_setpoint)
 {
 	_resetSetpoints();
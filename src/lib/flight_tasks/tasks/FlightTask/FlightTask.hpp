@@ -46,6 +46,8 @@
 #include <matrix/matrix/math.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/topics/landing_gear.h>
+#include <uORB/topics/manual_control_setpoint.h>
+#include <uORB/topics/position_setpoint_triplet.h>
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_local_position_setpoint.h>
 #include <uORB/topics/vehicle_command.h>
@@ -53,6 +55,7 @@
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_trajectory_waypoint.h>
 #include <uORB/topics/home_position.h>
+#include <uORB/topics/vehicle_status.h>
 #include <lib/weather_vane/WeatherVane.hpp>
 
 struct ekf_reset_counters_s {
@@ -63,6 +66,20 @@ struct ekf_reset_counters_s {
 	uint8_t quat;
 };
 
+/**
+ * Subscriptions shared by all tasks.
+ * Only one task is active at a time and tasks are constructed on every switch. The subscriptions outlive the tasks,
+ * so a switch doesn't subscribe to the topics again and the new task has the latest data right away.
+ */
+struct FlightTaskSubscriptions {
+	uORB::SubscriptionData<vehicle_local_position_s> vehicle_local_position{ORB_ID(vehicle_local_position)};
+	uORB::SubscriptionData<vehicle_attitude_s> attitude{ORB_ID(vehicle_attitude)};
+	uORB::SubscriptionData<home_position_s> home_position{ORB_ID(home_position)};
+	uORB::SubscriptionData<manual_control_setpoint_s> manual_control_setpoint{ORB_ID(manual_control_setpoint)};
+	uORB::SubscriptionData<position_setpoint_triplet_s> triplet_setpoint{ORB_ID(position_setpoint_triplet)};
+	uORB::SubscriptionData<vehicle_status_s> vehicle_status{ORB_ID(vehicle_status)};
+};
+
 class FlightTask : public ModuleParams
 {
 public:
@@ -188,9 +205,12 @@ public:
 	}
 
 protected:
-	uORB::SubscriptionData<vehicle_local_position_s> _sub_vehicle_local_position{ORB_ID(vehicle_local_position)};
-	uORB::SubscriptionData<vehicle_attitude_s> _sub_attitude{ORB_ID(vehicle_attitude)};
-	uORB::SubscriptionData<home_position_s> _sub_home_position{ORB_ID(home_position)};
+	/** @return the subscriptions shared by all tasks, subscribed on first use */
+	static FlightTaskSubscriptions &subscriptions();
+
+	uORB::SubscriptionData<vehicle_local_position_s> &_sub_vehicle_local_position{subscriptions().vehicle_local_position};
+	uORB::SubscriptionData<vehicle_attitude_s> &_sub_attitude{subscriptions().attitude};
+	uORB::SubscriptionData<home_position_s> &_sub_home_position{subscriptions().home_position};
 
 	/** Reset all setpoints to NAN */
 	void _resetSetpoints();
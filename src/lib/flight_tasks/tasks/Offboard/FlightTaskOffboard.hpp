@@ -52,7 +52,7 @@ public:
 	bool updateInitialize() override;
 
 protected:
-	uORB::SubscriptionData<position_setpoint_triplet_s> _sub_triplet_setpoint{ORB_ID(position_setpoint_triplet)};
+	uORB::SubscriptionData<position_setpoint_triplet_s> &_sub_triplet_setpoint{subscriptions().triplet_setpoint};
 
 private:
 	matrix::Vector3f _position_lock{};
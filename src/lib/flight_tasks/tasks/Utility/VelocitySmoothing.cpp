@@ -53,6 +53,7 @@ void VelocitySmoothing::reset(float accel, float vel, float pos)
 	_state.x = pos;
 
 	_state_init = _state;
+	_plan_valid = false;
 }
 
 float VelocitySmoothing::saturateT1ForAccel(float a0, float j_max, float T1, float a_max)
@@ -177,6 +178,20 @@ void VelocitySmoothing::updateDurations(float vel_setpoint)
 	} else {
 		_T1 = _T2 = _T3 = 0.f;
 	}
+
+	_plan_max_jerk = _max_jerk;
+	_plan_max_accel = _max_accel;
+	_plan_max_vel = _max_vel;
+	_plan_valid = true;
+}
+
+bool VelocitySmoothing::isPlanValid(float vel_setpoint) const
+{
+	return _plan_valid
+	       && (fabsf(math::constrain(vel_setpoint, -_max_vel, _max_vel) - _vel_sp) < VEL_SP_TOLERANCE)
+	       && (fabsf(_max_jerk - _plan_max_jerk) < FLT_EPSILON)
+	       && (fabsf(_max_accel - _plan_max_accel) < FLT_EPSILON)
+	       && (fabsf(_max_vel - _plan_max_vel) < FLT_EPSILON);
 }
 
 int VelocitySmoothing::computeDirection()
@@ -289,6 +304,27 @@ void VelocitySmoothing::timeSynchronization(VelocitySmoothing *traj, int n_traj)
 	}
 }
 
+bool VelocitySmoothing::updateDurationsSynchronized(VelocitySmoothing *traj, const float *vel_setpoint, int n_traj)
+{
+	bool plan_valid = true;
+
+	for (int i = 0; i < n_traj; i++) {
+		plan_valid = plan_valid && traj[i].isPlanValid(vel_setpoint[i]);
+	}
+
+	if (plan_valid) {
+		return false;
+	}
+
+	for (int i = 0; i < n_traj; i++) {
+		traj[i].updateDurations(vel_setpoint[i]);
+	}
+
+	timeSynchronization(traj, n_traj);
+
+	return true;
+}
+
 void VelocitySmoothing::updateDurationsGivenTotalTime(float T123)
 {
 	float jerk_max_T1 = _direction * _max_jerk;
@@ -100,11 +100,11 @@ public:
 	void setMaxVel(float max_vel) { _max_vel = max_vel; }
 
 	float getCurrentJerk() const { return _state.j; }
-	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; }
+	void setCurrentAcceleration(const float accel) { _state.a = _state_init.a = accel; _plan_valid = false; }
 	float getCurrentAcceleration() const { return _state.a; }
-	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; }
+	void setCurrentVelocity(const float vel) { _state.v = _state_init.v = vel; _plan_valid = false; }
 	float getCurrentVelocity() const { return _state.v; }
-	void setCurrentPosition(const float pos) { _state.x = _state_init.x = pos; }
+	void setCurrentPosition(const float pos) { _state.x = _state_init.x = pos; _plan_valid = false; }
 	float getCurrentPosition() const { return _state.x; }
 
 	float getVelSp() const { return _vel_sp; }
@@ -123,8 +123,26 @@ public:
 	 */
 	static void timeSynchronization(VelocitySmoothing *traj, int n_traj);
 
+	/**
+	 * Compute T1, T2, T3 of several trajectories and synchronize them (updateDurations() and timeSynchronization()).
+	 * The durations are only computed again if a velocity setpoint or a constraint changed or a state was set
+	 * since they were computed: otherwise the trajectories continue on their current plan, which is where
+	 * replanning from the current state would lead as well, and updateTraj() only evaluates the polynomials.
+	 * @param traj an array of VelocitySmoothing objects
+	 * @param vel_setpoint an array of n_traj velocity setpoints
+	 * @param n_traj the number of trajectories to be synchronized
+	 * @return true if the durations were computed again
+	 */
+	static bool updateDurationsSynchronized(VelocitySmoothing *traj, const float *vel_setpoint, int n_traj);
+
 private:
 
+	/**
+	 * @return true if the current durations were computed for this velocity setpoint and the current constraints
+	 * and the state wasn't set since
+	 */
+	bool isPlanValid(float vel_setpoint) const;
+
 	/**
 	 * Compute T1, T2, T3 depending on the current state and velocity setpoint.
 	 * Minimize the total time of the trajectory
@@ -212,4 +230,12 @@ private:
 	float _T3 = 0.f; ///< Decreasing acceleration [s]
 
 	float _local_time = 0.f; ///< Current local time
+
+	/* Constraints the durations were computed with */
+	float _plan_max_jerk = 0.f;
+	float _plan_max_accel = 0.f;
+	float _plan_max_vel = 0.f;
+	bool _plan_valid = false;
+
+	static constexpr float VEL_SP_TOLERANCE = 1e-3f; ///< velocity setpoint change that requires a new plan [m/s]
 };
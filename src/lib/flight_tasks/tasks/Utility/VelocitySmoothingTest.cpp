@@ -178,3 +178,46 @@ TEST_F(VelocitySmoothingTest, testZeroSetpoint)
 		EXPECT_FLOAT_EQ(_trajectories[i].getCurrentPosition(), 0.f);
 	}
 }
+
+TEST_F(VelocitySmoothingTest, testSynchronizedPlanReuse)
+{
+	// GIVEN: A set of constraints
+	const float j_max = 55.2f;
+	const float a_max = 6.f;
+	const float v_max = 6.f;
+
+	setConstraints(j_max, a_max, v_max);
+
+	// AND: A set of initial conditions
+	Vector3f a0(0.f, 0.f, 0.f);
+	Vector3f v0(0.f, 0.f, 0.f);
+	Vector3f x0(0.f, 0.f, 0.f);
+
+	setInitialConditions(a0, v0, x0);
+
+	// WHEN: We plan the trajectories once
+	const float velocity_setpoints[3] = {-3.f, 1.5f, -0.7f};
+	EXPECT_TRUE(VelocitySmoothing::updateDurationsSynchronized(_trajectories, velocity_setpoints, 3));
+
+	// THEN: The plan should be kept as long as the setpoints and the constraints don't change
+	const float dt = 0.01f;
+	const int nb_steps = ceil(_trajectories[0].getTotalTime() / dt);
+
+	for (int i = 0; i < nb_steps; i++) {
+		for (int j = 0; j < 3; j++) {
+			_trajectories[j].updateTraj(dt);
+		}
+
+		EXPECT_FALSE(VelocitySmoothing::updateDurationsSynchronized(_trajectories, velocity_setpoints, 3));
+	}
+
+	// AND: All the trajectories should have reached the desired velocity with zero acceleration
+	for (int i = 0; i < 3; i++) {
+		EXPECT_LE(fabsf(_trajectories[i].getCurrentVelocity() - velocity_setpoints[i]), 0.01f);
+		EXPECT_LE(fabsf(_trajectories[i].getCurrentAcceleration()), 0.0001f);
+	}
+
+	// AND: A constraint change should trigger a new plan
+	_trajectories[2].setMaxAccel(a_max / 2.f);
+	EXPECT_TRUE(VelocitySmoothing::updateDurationsSynchronized(_trajectories, velocity_setpoints, 3));
+}
@@ -45,9 +45,33 @@ MagCompensator::MagCompensator(ModuleParams *parent):
 
 }
 
-void MagCompensator::calculate_mag_corrected(matrix::Vector3f &mag, const matrix::Vector3f &param_vect)
+void MagCompensator::set_coefficients(int instance, const Coefficients &coefficients)
 {
-	if (_armed) {
-		mag = mag + param_vect * _power;
+	if (instance >= 0 && instance < MAG_COUNT_MAX) {
+		_coefficients[instance] = coefficients;
+		update_compensation(instance);
+	}
+}
+
+void MagCompensator::update_power(float power)
+{
+	Power p{};
+	p(0) = power;
+	update_power(p);
+}
+
+void MagCompensator::update_power(const Power &power)
+{
+	_power = power;
+
+	for (int instance = 0; instance < MAG_COUNT_MAX; instance++) {
+		update_compensation(instance);
+	}
+}
+
+void MagCompensator::calculate_mag_corrected(int instance, matrix::Vector3f &mag) const
+{
+	if (_armed && instance >= 0 && instance < MAG_COUNT_MAX) {
+		mag += _compensation[instance];
 	}
 }
@@ -47,17 +47,37 @@
 class MagCompensator : public ModuleParams
 {
 public:
+	static constexpr int MAG_COUNT_MAX = 4;
+	static constexpr int POWER_COUNT_MAX = 4; ///< throttle/current scalar or current of up to 4 motors
+
+	using Coefficients = matrix::Matrix<float, 3, POWER_COUNT_MAX>;
+	using Power = matrix::Vector<float, POWER_COUNT_MAX>;
+
 	MagCompensator(ModuleParams *parent);
 
 	~MagCompensator() = default;
 
 	void update_armed_flag(bool armed) { _armed = armed; }
 
-	void update_power(float power) { _power = power; }
+	/**
+	 * Set the compensation coefficients of a magnetometer, one column per power input (throttle, current or motor current).
+	 */
+	void set_coefficients(int instance, const Coefficients &coefficients);
 
-	void calculate_mag_corrected(matrix::Vector3f &mag, const matrix::Vector3f &param_vect);
+	/**
+	 * Update the power input(s), the compensation of every magnetometer is recomputed here once,
+	 * not for every sample.
+	 */
+	void update_power(float power);
+	void update_power(const Power &power);
+
+	void calculate_mag_corrected(int instance, matrix::Vector3f &mag) const;
 
 private:
-	float _power{0};
+	void update_compensation(int instance) { _compensation[instance] = _coefficients[instance] * _power; }
+
+	Coefficients _coefficients[MAG_COUNT_MAX] {};
+	matrix::Vector3f _compensation[MAG_COUNT_MAX] {}; ///< coefficients * power
+	Power _power{};
 	bool _armed{false};
 };
@@ -37,6 +37,7 @@
  * @value 1 Throttle-based compensation
  * @value 2 Current-based compensation (battery_status instance 0)
  * @value 3 Current-based compensation (battery_status instance 1)
+ * @value 4 Current-based compensation per motor (esc_status, motors 1-4)
  *
  * @category system
  * @group Sensor Calibration
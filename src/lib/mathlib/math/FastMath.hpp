@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file FastMath.hpp
+ *
+ * Polynomial and bit-level approximations of the trigonometric and square root functions
+ * used in the inner control loops, for targets where the libm versions are too slow.
+ * The maximum errors over the documented domains are covered by unit tests.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <px4_platform_common/defines.h>
+#include <matrix/matrix/math.hpp>
+
+namespace math
+{
+
+/**
+ * Reciprocal square root, bit-level initial guess refined by two Newton-Raphson iterations
+ * @param x > 0
+ * @return 1 / sqrt(x), relative error < 1e-5
+ */
+inline float fastRsqrt(const float x)
+{
+	uint32_t i;
+	memcpy(&i, &x, sizeof(i));
+	i = 0x5f3759df - (i >> 1);
+
+	float y;
+	memcpy(&y, &i, sizeof(y));
+
+	const float half_x = 0.5f * x;
+	y = y * (1.5f - half_x * y * y);
+	y = y * (1.5f - half_x * y * y);
+	return y;
+}
+
+/**
+ * Sine, odd minimax polynomial of degree 7 after folding the argument into [-pi/2, pi/2]
+ * @param x [-pi, pi]
+ * @return sin(x), absolute error < 1e-6
+ */
+inline float fastSin(float x)
+{
+	if (x > M_PI_2_F) {
+		x = M_PI_F - x;
+
+	} else if (x < -M_PI_2_F) {
+		x = -M_PI_F - x;
+	}
+
+	const float x2 = x * x;
+	return x * (0.99999660f + x2 * (-0.16664824f + x2 * (0.0083062861f + x2 * -0.00018362749f)));
+}
+
+/**
+ * Cosine, evaluated as the sine of the complementary angle
+ * @param x [-pi, pi]
+ * @return cos(x), absolute error < 1e-6
+ */
+inline float fastCos(const float x)
+{
+	return fastSin(M_PI_2_F - fabsf(x));
+}
+
+/**
+ * Arc cosine, Abramowitz and Stegun 4.4.45
+ * @param x [-1, 1]
+ * @return acos(x), absolute error < 1e-4
+ */
+inline float fastAcos(const float x)
+{
+	const float x_abs = fabsf(x);
+	const float result = sqrtf(1.f - x_abs) * (1.5707288f + x_abs * (-0.2121144f + x_abs * (0.0742610f + x_abs * -0.0187293f)));
+	return (x < 0.f) ? M_PI_F - result : result;
+}
+
+/**
+ * Arc sine, evaluated as the complement of the arc cosine
+ * @param x [-1, 1]
+ * @return asin(x), absolute error < 1e-4
+ */
+inline float fastAsin(const float x)
+{
+	return M_PI_2_F - fastAcos(x);
+}
+
+/**
+ * Normalize a quaternion using the reciprocal square root approximation
+ * @param q quaternion with non-zero norm
+ * @return q with norm 1 up to a relative error of 1e-5
+ */
+inline matrix::Quatf fastNormalized(const matrix::Quatf &q)
+{
+	const float scale = fastRsqrt(q.dot(q));
+	return matrix::Quatf(q(0) * scale, q(1) * scale, q(2) * scale, q(3) * scale);
+}
+
+} // namespace math
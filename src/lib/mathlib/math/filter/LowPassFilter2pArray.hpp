@@ -52,11 +52,12 @@ public:
 	}
 
 	/**
-	 * Add a new raw value to the filter
+	 * Add new raw values to the filter (int16_t raw FIFO data or already filtered float samples)
 	 *
-	 * @return retrieve the filtered result
+	 * @return retrieve the filtered result of the last sample
 	 */
-	inline float apply(const int16_t samples[], uint8_t num_samples)
+	template<typename T>
+	inline float apply(const T samples[], uint8_t num_samples)
 	{
 		float output = 0.0f;
 
@@ -82,6 +83,101 @@ public:
 		return output;
 	}
 
+	/**
+	 * Filter equally sized blocks of several independent channels (e.g. x, y, z) in one pass,
+	 * interleaving the channels to keep the FPU pipeline busy and the filter state in registers.
+	 *
+	 * @param output filtered result of the last sample of each channel
+	 */
+	template<int CHANNELS, typename T>
+	static inline void apply(LowPassFilter2pArray (&filters)[CHANNELS], T *const (&samples)[CHANNELS],
+				 uint8_t num_samples, float (&output)[CHANNELS])
+	{
+		float a1[CHANNELS], a2[CHANNELS];
+		float delay_element_1[CHANNELS], delay_element_2[CHANNELS];
+
+		for (int c = 0; c < CHANNELS; c++) {
+			a1[c] = filters[c]._a1;
+			a2[c] = filters[c]._a2;
+			delay_element_1[c] = filters[c]._delay_element_1;
+			delay_element_2[c] = filters[c]._delay_element_2;
+			output[c] = 0.0f;
+		}
+
+		for (int n = 0; n < num_samples; n++) {
+			for (int c = 0; c < CHANNELS; c++) {
+				const float delay_element_0 = samples[c][n] - delay_element_1[c] * a1[c] - delay_element_2[c] * a2[c];
+
+				if (n == num_samples - 1) {
+					output[c] = delay_element_0 * filters[c]._b0 + delay_element_1[c] * filters[c]._b1
+						    + delay_element_2[c] * filters[c]._b2;
+				}
+
+				delay_element_2[c] = delay_element_1[c];
+				delay_element_1[c] = delay_element_0;
+			}
+		}
+
+		for (int c = 0; c < CHANNELS; c++) {
+			filters[c]._delay_element_1 = delay_element_1[c];
+			filters[c]._delay_element_2 = delay_element_2[c];
+
+			// don't allow bad values to propagate via the filter
+			if ((num_samples > 0) && !PX4_ISFINITE(output[c])) {
+				filters[c].reset(samples[c][num_samples - 1]);
+				output[c] = samples[c][num_samples - 1];
+			}
+		}
+	}
+
+	/**
+	 * Filter equally sized blocks of several independent channels (e.g. x, y, z) in place,
+	 * every sample is replaced by its filtered result.
+	 */
+	template<int CHANNELS>
+	static inline void applyInPlace(LowPassFilter2pArray (&filters)[CHANNELS], float *const (&samples)[CHANNELS],
+					uint8_t num_samples)
+	{
+		if (num_samples == 0) {
+			return;
+		}
+
+		float a1[CHANNELS], a2[CHANNELS];
+		float delay_element_1[CHANNELS], delay_element_2[CHANNELS];
+		float last_sample[CHANNELS];
+
+		for (int c = 0; c < CHANNELS; c++) {
+			a1[c] = filters[c]._a1;
+			a2[c] = filters[c]._a2;
+			delay_element_1[c] = filters[c]._delay_element_1;
+			delay_element_2[c] = filters[c]._delay_element_2;
+			last_sample[c] = samples[c][num_samples - 1];
+		}
+
+		for (int n = 0; n < num_samples; n++) {
+			for (int c = 0; c < CHANNELS; c++) {
+				const float delay_element_0 = samples[c][n] - delay_element_1[c] * a1[c] - delay_element_2[c] * a2[c];
+
+				samples[c][n] = delay_element_0 * filters[c]._b0 + delay_element_1[c] * filters[c]._b1
+						+ delay_element_2[c] * filters[c]._b2;
+
+				delay_element_2[c] = delay_element_1[c];
+				delay_element_1[c] = delay_element_0;
+			}
+		}
+
+		for (int c = 0; c < CHANNELS; c++) {
+			filters[c]._delay_element_1 = delay_element_1[c];
+			filters[c]._delay_element_2 = delay_element_2[c];
+
+			// don't allow bad values to propagate via the filter
+			if (!PX4_ISFINITE(samples[c][num_samples - 1])) {
+				filters[c].reset(last_sample[c]);
+				samples[c][num_samples - 1] = last_sample[c];
+			}
+		}
+	}
+
 };
 
 } // namespace math
@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file MedianFilter.hpp
+ *
+ * @brief Implementation of a median filter over a sliding window.
+ *
+ * Rejects single sample outliers (spikes) that a linear low-pass filter would smear
+ * into the output. The window is sorted on every call, so it is only intended for
+ * small windows.
+ */
+
+#pragma once
+
+#include <px4_platform_common/defines.h>
+
+#include <stdint.h>
+
+namespace math
+{
+
+template<typename T, int WINDOW = 3>
+class MedianFilter
+{
+public:
+	static_assert(WINDOW >= 3, "MedianFilter window must be at least 3");
+	static_assert(WINDOW % 2 == 1, "MedianFilter window must be odd");
+
+	MedianFilter() = default;
+	~MedianFilter() = default;
+
+	/**
+	 * Add a new raw value to the filter
+	 *
+	 * @return retrieve the filtered result
+	 */
+	inline T apply(const T &sample)
+	{
+		insert(sample);
+		return median();
+	}
+
+	void insert(const T &sample)
+	{
+		if (!PX4_ISFINITE(sample)) {
+			// don't allow bad values into the window
+			return;
+		}
+
+		_buffer[_head] = sample;
+		_head = (_head + 1) % WINDOW;
+
+		if (_count < WINDOW) {
+			_count++;
+		}
+	}
+
+	/**
+	 * Median of the samples currently in the window (the upper median while the
+	 * window is only partially filled with an even number of samples)
+	 */
+	T median() const
+	{
+		if (_count == 0) {
+			return T{};
+		}
+
+		T sorted[WINDOW];
+
+		// insertion sort, the window is small
+		for (int i = 0; i < _count; i++) {
+			const T value = _buffer[i];
+			int j = i;
+
+			while ((j > 0) && (sorted[j - 1] > value)) {
+				sorted[j] = sorted[j - 1];
+				j--;
+			}
+
+			sorted[j] = value;
+		}
+
+		return sorted[_count / 2];
+	}
+
+	void reset()
+	{
+		_head = 0;
+		_count = 0;
+	}
+
+	int count() const { return _count; }
+
+private:
+	T _buffer[WINDOW] {};
+
+	int _head{0};
+	int _count{0};
+};
+
+} // namespace math
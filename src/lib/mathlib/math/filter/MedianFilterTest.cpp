@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * Test code for the Median filter
+ * Run this test only using make tests TESTFILTER=MedianFilter
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "MedianFilter.hpp"
+
+using namespace math;
+
+TEST(MedianFilterTest, empty)
+{
+	MedianFilter<float, 5> median_filter;
+	EXPECT_EQ(median_filter.count(), 0);
+	EXPECT_EQ(median_filter.median(), 0.f);
+}
+
+TEST(MedianFilterTest, partialWindow)
+{
+	MedianFilter<float, 5> median_filter;
+	EXPECT_EQ(median_filter.apply(3.f), 3.f);
+	EXPECT_EQ(median_filter.apply(1.f), 3.f);
+	EXPECT_EQ(median_filter.apply(2.f), 2.f);
+	EXPECT_EQ(median_filter.count(), 3);
+}
+
+TEST(MedianFilterTest, rejectSpikes)
+{
+	MedianFilter<float, 5> median_filter;
+
+	for (int i = 0; i < 5; i++) {
+		median_filter.apply(100.f);
+	}
+
+	// up to (WINDOW - 1) / 2 consecutive outliers are rejected completely
+	EXPECT_EQ(median_filter.apply(1000.f), 100.f);
+	EXPECT_EQ(median_filter.apply(-1000.f), 100.f);
+	EXPECT_EQ(median_filter.apply(101.f), 100.f);
+	EXPECT_EQ(median_filter.apply(102.f), 101.f);
+}
+
+TEST(MedianFilterTest, slidingWindow)
+{
+	MedianFilter<float, 3> median_filter;
+	const float input[] {5.f, 1.f, 4.f, 2.f, 3.f, 9.f, 8.f};
+	const float expected[] {5.f, 5.f, 4.f, 2.f, 3.f, 3.f, 8.f};
+
+	for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++) {
+		EXPECT_EQ(median_filter.apply(input[i]), expected[i]);
+	}
+
+	EXPECT_EQ(median_filter.count(), 3);
+}
+
+TEST(MedianFilterTest, ignoreNonFinite)
+{
+	MedianFilter<float, 3> median_filter;
+	median_filter.apply(1.f);
+	median_filter.apply(2.f);
+	EXPECT_EQ(median_filter.apply(NAN), 2.f);
+	EXPECT_EQ(median_filter.count(), 2);
+
+	median_filter.reset();
+	EXPECT_EQ(median_filter.count(), 0);
+}
@@ -141,6 +141,17 @@ public:
 
 	T reset(const T &sample);
 
+	/**
+	 * Reset the Direct Form I state to the steady state of a constant input (the notch has unity DC gain)
+	 */
+	void resetDF1(const T &sample)
+	{
+		_delay_element_1 = sample;
+		_delay_element_2 = sample;
+		_delay_element_output_1 = sample;
+		_delay_element_output_2 = sample;
+	}
+
 	void update(float sample_freq, float notch_freq, float bandwidth);
 
 protected:
@@ -95,8 +95,8 @@ public:
 	inline void applyDF1(T samples[], uint8_t num_samples)
 	{
 		for (int n = 0; n < num_samples; n++) {
-			// Direct Form II implementation
-			const T output = _b0 * samples[n] + _b1 * _delay_element_1 + _b2 * _delay_element_2 - _a1 * _delay_element_output_1 -
+			// Direct Form I implementation
+			T output = _b0 * samples[n] + _b1 * _delay_element_1 + _b2 * _delay_element_2 - _a1 * _delay_element_output_1 -
 					 _a2 * _delay_element_output_2;
 
 			// don't allow bad values to propagate via the filter
@@ -116,6 +116,105 @@ public:
 			samples[n] = output;
 		}
 	}
+
+	/**
+	 * Filter equally sized blocks of several independent channels (e.g. x, y, z) using the Direct form II.
+	 *
+	 * The per sample recurrence can't be vectorized in time, interleaving the channels instead
+	 * keeps the FPU pipeline busy and the whole filter state in registers.
+	 */
+	template<int CHANNELS>
+	static inline void apply(NotchFilterArray<T> (&filters)[CHANNELS], T *const (&samples)[CHANNELS], uint8_t num_samples)
+	{
+		float a1[CHANNELS], a2[CHANNELS], b0[CHANNELS], b1[CHANNELS], b2[CHANNELS];
+		T delay_element_1[CHANNELS], delay_element_2[CHANNELS];
+
+		for (int c = 0; c < CHANNELS; c++) {
+			a1[c] = filters[c]._a1;
+			a2[c] = filters[c]._a2;
+			b0[c] = filters[c]._b0;
+			b1[c] = filters[c]._b1;
+			b2[c] = filters[c]._b2;
+			delay_element_1[c] = filters[c]._delay_element_1;
+			delay_element_2[c] = filters[c]._delay_element_2;
+		}
+
+		for (int n = 0; n < num_samples; n++) {
+			for (int c = 0; c < CHANNELS; c++) {
+				T delay_element_0{samples[c][n] - delay_element_1[c] * a1[c] - delay_element_2[c] * a2[c]};
+
+				// don't allow bad values to propagate via the filter
+				if (!isFinite(delay_element_0)) {
+					delay_element_0 = samples[c][n];
+				}
+
+				samples[c][n] = delay_element_0 * b0[c] + delay_element_1[c] * b1[c] + delay_element_2[c] * b2[c];
+
+				delay_element_2[c] = delay_element_1[c];
+				delay_element_1[c] = delay_element_0;
+			}
+		}
+
+		for (int c = 0; c < CHANNELS; c++) {
+			filters[c]._delay_element_1 = delay_element_1[c];
+			filters[c]._delay_element_2 = delay_element_2[c];
+		}
+	}
+
+	/**
+	 * Filter equally sized blocks of several independent channels (e.g. x, y, z) using the Direct form I.
+	 *
+	 * @see apply(NotchFilterArray<T> (&filters)[CHANNELS], T *const (&samples)[CHANNELS], uint8_t num_samples)
+	 */
+	template<int CHANNELS>
+	static inline void applyDF1(NotchFilterArray<T> (&filters)[CHANNELS], T *const (&samples)[CHANNELS],
+				    uint8_t num_samples)
+	{
+		float a1[CHANNELS], a2[CHANNELS], b0[CHANNELS], b1[CHANNELS], b2[CHANNELS];
+		T delay_element_1[CHANNELS], delay_element_2[CHANNELS];
+		T delay_element_output_1[CHANNELS], delay_element_output_2[CHANNELS];
+
+		for (int c = 0; c < CHANNELS; c++) {
+			a1[c] = filters[c]._a1;
+			a2[c] = filters[c]._a2;
+			b0[c] = filters[c]._b0;
+			b1[c] = filters[c]._b1;
+			b2[c] = filters[c]._b2;
+			delay_element_1[c] = filters[c]._delay_element_1;
+			delay_element_2[c] = filters[c]._delay_element_2;
+			delay_element_output_1[c] = filters[c]._delay_element_output_1;
+			delay_element_output_2[c] = filters[c]._delay_element_output_2;
+		}
+
+		for (int n = 0; n < num_samples; n++) {
+			for (int c = 0; c < CHANNELS; c++) {
+				const T sample{samples[c][n]};
+
+				T output = b0[c] * sample + b1[c] * delay_element_1[c] + b2[c] * delay_element_2[c]
+					   - a1[c] * delay_element_output_1[c] - a2[c] * delay_element_output_2[c];
+
+				// don't allow bad values to propagate via the filter
+				if (!isFinite(output)) {
+					output = sample;
+				}
+
+				delay_element_2[c] = delay_element_1[c];
+				delay_element_1[c] = sample;
+
+				delay_element_output_2[c] = delay_element_output_1[c];
+				delay_element_output_1[c] = output;
+
+				samples[c][n] = output;
+			}
+		}
+
+		for (int c = 0; c < CHANNELS; c++) {
+			filters[c]._delay_element_1 = delay_element_1[c];
+			filters[c]._delay_element_2 = delay_element_2[c];
+			filters[c]._delay_element_output_1 = delay_element_output_1[c];
+			filters[c]._delay_element_output_2 = delay_element_output_2[c];
+		}
+	}
 };
 
 } // namespace math
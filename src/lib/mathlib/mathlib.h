@@ -43,6 +43,7 @@
 
 #include "math/Limits.hpp"
 #include "math/Functions.hpp"
+#include "math/FastMath.hpp"
 #include "math/matrix_alg.h"
 #include "math/SearchMin.hpp"
 #include "math/TrajMath.hpp"
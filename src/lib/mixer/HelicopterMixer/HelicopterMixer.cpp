@@ -54,6 +54,80 @@ HelicopterMixer::HelicopterMixer(ControlCallback control_cb, uintptr_t cb_handle
 	Mixer(control_cb, cb_handle),
 	_mixer_info(mixer_info)
 {
+	_throttle_curve.set(_mixer_info.throttle_curve);
+	_pitch_curve.set(_mixer_info.pitch_curve);
+
+	// the swash plate geometry is constant, the servo angles are only evaluated once
+	for (unsigned i = 0; i < _mixer_info.control_count; i++) {
+		const mixer_heli_servo_s &servo = _mixer_info.servos[i];
+		_swash_matrix[i][COLLECTIVE] = servo.scale;
+		_swash_matrix[i][ROLL] = -sinf(servo.angle) * servo.arm_length * servo.scale;
+		_swash_matrix[i][PITCH] = cosf(servo.angle) * servo.arm_length * servo.scale;
+	}
+}
+
+void
+HelicopterMixer::Curve::set(const float points[HELI_CURVES_NR_POINTS])
+{
+	const float step = 1.f / (HELI_CURVES_NR_POINTS - 1);
+
+	for (unsigned i = 0; i < HELI_CURVES_NR_POINTS - 1; i++) {
+		gradient[i] = (points[i + 1] - points[i]) / step;
+		offset[i] = points[i] - gradient[i] * i * step;
+	}
+}
+
+float
+HelicopterMixer::Curve::interpolate(float x) const
+{
+	/* Find the segment, the first and last one are extrapolated */
+	int idx = x * (HELI_CURVES_NR_POINTS - 1);
+
+	if (idx < 0) {
+		idx = 0;
+
+	} else if (idx > HELI_CURVES_NR_POINTS - 2) {
+		idx = HELI_CURVES_NR_POINTS - 2;
+	}
+
+	return gradient[idx] * x + offset[idx];
+}
+
+void
+HelicopterMixer::set_rpm_governor(float rpm_setpoint, float p_gain, float i_gain)
+{
+	if (rpm_setpoint != _governor.rpm_setpoint) {
+		_governor.integral = 0.f;
+		_governor.correction = 0.f;
+	}
+
+	_governor.rpm_setpoint = rpm_setpoint > 0.f ? rpm_setpoint : 0.f;
+	_governor.p_gain = p_gain;
+	_governor.i_gain = i_gain;
+}
+
+void
+HelicopterMixer::set_rotor_rpm(float rpm, float dt)
+{
+	// only govern a spinning rotor with a valid measurement, otherwise fly the throttle curve
+	if (_governor.rpm_setpoint <= 0.f || !PX4_ISFINITE(rpm) || _throttle_feedforward <= 0.f) {
+		_governor.integral = 0.f;
+		_governor.correction = 0.f;
+		return;
+	}
+
+	const float error = (_governor.rpm_setpoint - rpm) / _governor.rpm_setpoint;
+
+	// stop integrating into the saturation (anti-windup)
+	const float throttle = _throttle_feedforward + _governor.correction;
+
+	if (!((throttle >= 1.f && error > 0.f) || (throttle <= 0.f && error < 0.f))) {
+		_governor.integral = constrain(_governor.integral + _governor.i_gain * error * constrain(dt, 0.f, 0.1f),
+					       -GOVERNOR_CORRECTION_MAX, GOVERNOR_CORRECTION_MAX);
+	}
+
+	_governor.correction = constrain(_governor.p_gain * error + _governor.integral,
+					 -GOVERNOR_CORRECTION_MAX, GOVERNOR_CORRECTION_MAX);
 }
 
 HelicopterMixer *
@@ -199,41 +273,23 @@ HelicopterMixer::mix(float *outputs, unsigned space)
 		return 0;
 	}
 
-	/* Find index to use for curves */
-	float thrust_cmd = get_control(0, 3);
-	int idx = (thrust_cmd / 0.25f);
-
-	/* Make sure idx is in range */
-	if (idx < 0) {
-		idx = 0;
-
-	} else if (idx > HELI_CURVES_NR_POINTS - 2) {
-		/* We access idx + 1 below, so max legal index is (size - 2) */
-		idx = HELI_CURVES_NR_POINTS - 2;
-	}
-
-	/* Local throttle curve gradient and offset */
-	float tg = (_mixer_info.throttle_curve[idx + 1] - _mixer_info.throttle_curve[idx]) / 0.25f;
-	float to = (_mixer_info.throttle_curve[idx]) - (tg * idx * 0.25f);
-	float throttle = constrain(2.0f * (tg * thrust_cmd + to) - 1.0f, -1.0f, 1.0f);
+	const float thrust_cmd = get_control(0, 3);
 
-	/* Local pitch curve gradient and offset */
-	float pg = (_mixer_info.pitch_curve[idx + 1] - _mixer_info.pitch_curve[idx]) / 0.25f;
-	float po = (_mixer_info.pitch_curve[idx]) - (pg * idx * 0.25f);
-	float collective_pitch = constrain((pg * thrust_cmd + po), -0.5f, 0.5f);
+	_throttle_feedforward = _throttle_curve.interpolate(thrust_cmd);
+	const float throttle = constrain(2.0f * (_throttle_feedforward + _governor.correction) - 1.0f, -1.0f, 1.0f);
+	const float collective_pitch = constrain(_pitch_curve.interpolate(thrust_cmd), -0.5f, 0.5f);
 
-	float roll_cmd = get_control(0, 0);
-	float pitch_cmd = get_control(0, 1);
+	const float roll_cmd = get_control(0, 0);
+	const float pitch_cmd = get_control(0, 1);
 
 	outputs[0] = throttle;
 
 	for (unsigned i = 0; i < _mixer_info.control_count; i++) {
-		outputs[i + 1] = collective_pitch
-				 + cosf(_mixer_info.servos[i].angle) * pitch_cmd * _mixer_info.servos[i].arm_length
-				 - sinf(_mixer_info.servos[i].angle) * roll_cmd * _mixer_info.servos[i].arm_length;
-		outputs[i + 1] *= _mixer_info.servos[i].scale;
-		outputs[i + 1] += _mixer_info.servos[i].offset;
-		outputs[i + 1] = constrain(outputs[i + 1], _mixer_info.servos[i].min_output, _mixer_info.servos[i].max_output);
+		const float output = _swash_matrix[i][COLLECTIVE] * collective_pitch
+				     + _swash_matrix[i][ROLL] * roll_cmd
+				     + _swash_matrix[i][PITCH] * pitch_cmd
+				     + _mixer_info.servos[i].offset;
+		outputs[i + 1] = constrain(output, _mixer_info.servos[i].min_output, _mixer_info.servos[i].max_output);
 	}
 
 	return _mixer_info.control_count + 1;
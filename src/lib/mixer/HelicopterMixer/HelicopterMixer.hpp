@@ -106,6 +106,44 @@ public:
 	unsigned			set_trim(float trim) override { return 4; }
 	unsigned			get_trim(float *trim) override { return 4; }
 
+	void				set_rpm_governor(float rpm_setpoint, float p_gain, float i_gain) override;
+	void				set_rotor_rpm(float rpm, float dt) override;
+
 private:
+	/** piecewise linear curve, as gradient and offset of each segment */
+	struct Curve {
+		float gradient[HELI_CURVES_NR_POINTS - 1];
+		float offset[HELI_CURVES_NR_POINTS - 1];
+
+		void set(const float points[HELI_CURVES_NR_POINTS]);
+		float interpolate(float x) const;
+	};
+
+	enum SwashInput {
+		COLLECTIVE = 0,
+		ROLL,
+		PITCH,
+		SWASH_INPUT_COUNT
+	};
+
+	struct Governor {
+		float rpm_setpoint{0.f};	/**< 0 if disabled */
+		float p_gain{0.f};
+		float i_gain{0.f};
+		float integral{0.f};
+		float correction{0.f};		/**< throttle added to the throttle curve */
+	};
+
+	static constexpr float GOVERNOR_CORRECTION_MAX = 0.5f;
+
 	mixer_heli_s			_mixer_info;
+
+	Curve				_throttle_curve;
+	Curve				_pitch_curve;
+
+	/** servo outputs from collective, roll and pitch, including servo angle, arm length and scale */
+	float				_swash_matrix[4][SWASH_INPUT_COUNT];
+
+	Governor			_governor;
+	float				_throttle_feedforward{0.f};	/**< last throttle curve output */
 };
@@ -129,6 +129,14 @@
 #include <containers/List.hpp>
 #include <mathlib/mathlib.h>
 
+struct mixer_scaler_s;
+
+/** input of a linear mixer reading its control value directly, see Mixer::compile_linear() */
+struct mixer_linear_input_s {
+	const float		*control;	/**< control value the input reads */
+	const mixer_scaler_s	*scaler;	/**< scaling applied to the input before use */
+};
+
 /**
  * Abstract class defining a mixer mixing zero or more inputs to
  * one or more outputs.
@@ -229,6 +237,37 @@ public:
 
 	virtual unsigned		get_multirotor_count()  { return 0; }
 
+	/**
+	 * @brief Configure the rotor RPM governor, only implemented for HelicopterMixer.
+	 *
+	 * @param[in]  rpm_setpoint   Rotor RPM setpoint, 0 disables the governor
+	 * @param[in]  p_gain         Throttle per relative RPM error
+	 * @param[in]  i_gain         Throttle per relative RPM error and second
+	 */
+	virtual void			set_rpm_governor(float rpm_setpoint, float p_gain, float i_gain) {}
+
+	/**
+	 * @brief Update the rotor RPM governor with a new measurement, only implemented for HelicopterMixer.
+	 *
+	 * @param[in]  rpm   Measured rotor RPM, NAN if the measurement timed out
+	 * @param[in]  dt    Time since the last measurement [s]
+	 */
+	virtual void			set_rotor_rpm(float rpm, float dt) {}
+
+	/**
+	 * @brief Describe the mixer as a single output computed from a linear sum of directly read
+	 *        control values (used by MixerGroup::compile()).
+	 *
+	 * @param controls		Control values, group_size values for each of num_groups groups.
+	 * @param num_groups		Number of control groups in controls.
+	 * @param group_size		Number of control values per group.
+	 * @param inputs		Filled with the inputs of the mixer, or nullptr to only count them.
+	 * @param output_scaler		Set to the scaling of the output.
+	 * @return the number of inputs, or -1 if the mixer cannot be expressed this way
+	 */
+	virtual int			compile_linear(const float *controls, unsigned num_groups, unsigned group_size,
+			mixer_linear_input_s *inputs, const mixer_scaler_s *&output_scaler) const { return -1; }
+
 protected:
 
 	/** client-supplied callback used when fetching control values */
@@ -52,6 +52,10 @@
 unsigned
 MixerGroup::mix(float *outputs, unsigned space)
 {
+	if (_plan != nullptr) {
+		return mix_plan(outputs, space);
+	}
+
 	unsigned index = 0;
 
 	for (auto mixer : _mixers) {
@@ -65,6 +69,106 @@ MixerGroup::mix(float *outputs, unsigned space)
 	return index;
 }
 
+unsigned
+MixerGroup::mix_plan(float *outputs, unsigned space)
+{
+	unsigned index = 0;
+
+	for (unsigned i = 0; i < _plan_steps && index < space; i++) {
+		const PlanStep &step = _plan[i];
+
+		if (step.mixer != nullptr) {
+			index += step.mixer->mix(outputs + index, space - index);
+			continue;
+		}
+
+		const mixer_linear_input_s *input = &_plan_inputs[step.first_input];
+		const mixer_linear_input_s *const input_end = input + step.input_count;
+		float sum = 0.0f;
+
+		for (; input != input_end; input++) {
+			sum += SimpleMixer::scale(*input->scaler, *input->control);
+		}
+
+		outputs[index++] = SimpleMixer::scale(*step.output_scaler, sum);
+	}
+
+	return index;
+}
+
+bool
+MixerGroup::compile(const float *controls, unsigned num_groups, unsigned group_size)
+{
+	clear_plan();
+
+	const unsigned steps = _mixers.size();
+
+	if (controls == nullptr || steps == 0) {
+		return false;
+	}
+
+	// first pass: count the inputs of all linear outputs
+	unsigned input_count = 0;
+	unsigned linear_count = 0;
+
+	for (auto mixer : _mixers) {
+		const mixer_scaler_s *output_scaler = nullptr;
+		const int count = mixer->compile_linear(controls, num_groups, group_size, nullptr, output_scaler);
+
+		if (count >= 0) {
+			input_count += count;
+			linear_count++;
+		}
+	}
+
+	if (linear_count == 0 || input_count > UINT16_MAX) {
+		// nothing to flatten
+		return false;
+	}
+
+	_plan = new PlanStep[steps];
+	_plan_inputs = (input_count > 0) ? new mixer_linear_input_s[input_count] : nullptr;
+
+	if (_plan == nullptr || (input_count > 0 && _plan_inputs == nullptr)) {
+		clear_plan();
+		return false;
+	}
+
+	// second pass: fill in the plan
+	unsigned input_index = 0;
+
+	for (auto mixer : _mixers) {
+		PlanStep &step = _plan[_plan_steps++];
+		step.output_scaler = nullptr;
+		const int count = mixer->compile_linear(controls, num_groups, group_size, &_plan_inputs[input_index],
+				  step.output_scaler);
+
+		if (count >= 0) {
+			step.mixer = nullptr;
+			step.first_input = input_index;
+			step.input_count = count;
+			input_index += count;
+
+		} else {
+			step.mixer = mixer;
+			step.first_input = 0;
+			step.input_count = 0;
+		}
+	}
+
+	return true;
+}
+
+void
+MixerGroup::clear_plan()
+{
+	delete[] _plan;
+	_plan = nullptr;
+	delete[] _plan_inputs;
+	_plan_inputs = nullptr;
+	_plan_steps = 0;
+}
+
 /*
  * set_trims() has no effect except for the SimpleMixer implementation for which set_trim()
  * always returns the value one.
@@ -135,6 +239,22 @@ MixerGroup::set_airmode(Mixer::Airmode airmode)
 	}
 }
 
+void
+MixerGroup::set_rpm_governor(float rpm_setpoint, float p_gain, float i_gain)
+{
+	for (auto mixer : _mixers) {
+		mixer->set_rpm_governor(rpm_setpoint, p_gain, i_gain);
+	}
+}
+
+void
+MixerGroup::set_rotor_rpm(float rpm, float dt)
+{
+	for (auto mixer : _mixers) {
+		mixer->set_rotor_rpm(rpm, dt);
+	}
+}
+
 unsigned
 MixerGroup::get_multirotor_count()
 {
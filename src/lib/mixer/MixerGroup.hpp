@@ -55,8 +55,31 @@ public:
 	MixerGroup(MixerGroup &&) = delete;
 	MixerGroup &operator=(MixerGroup &&) = delete;
 
+	/**
+	 * Mix all outputs of the group, using the evaluation plan if the group is compiled.
+	 */
 	unsigned			mix(float *outputs, unsigned space);
 
+	/**
+	 * Compile the group into a single evaluation plan.
+	 *
+	 * Mixers that compute a single output from a linear sum of control values (simple mixers)
+	 * are flattened into a list of (control, scaler) inputs read directly from the controls
+	 * array, which mix() then evaluates in one loop without invoking the control callback.
+	 * All other mixers keep being evaluated through their own mix() method within the plan.
+	 *
+	 * The controls array must outlive the plan and hold the values the control callback
+	 * would return, i.e. already limited and post-processed by the caller.
+	 * Adding or removing mixers drops the plan, compile() needs to be called again afterwards.
+	 *
+	 * @param controls		Control values, group_size values for each of num_groups groups.
+	 * @param num_groups		Number of control groups in controls.
+	 * @param group_size		Number of control values per group.
+	 * @return			true if the plan was compiled, false otherwise (mixing falls back to
+	 *				the mixer list).
+	 */
+	bool				compile(const float *controls, unsigned num_groups, unsigned group_size);
+
 	uint16_t			get_saturation_status();
 
 	void				groups_required(uint32_t &groups);
@@ -66,12 +89,12 @@ public:
 	 *
 	 * @param mixer			The mixer to be added.
 	 */
-	void				add_mixer(Mixer *mixer) { _mixers.add(mixer); }
+	void				add_mixer(Mixer *mixer) { clear_plan(); _mixers.add(mixer); }
 
 	/**
 	 * Remove all the mixers from the group.
 	 */
-	void				reset() { _mixers.clear(); }
+	void				reset() { clear_plan(); _mixers.clear(); }
 
 	/**
 	 * Count the mixers in the group.
@@ -165,6 +188,26 @@ public:
 
 	unsigned			get_multirotor_count();
 
+	void				set_rpm_governor(float rpm_setpoint, float p_gain, float i_gain);
+	void				set_rotor_rpm(float rpm, float dt);
+
 private:
+
+	/** step of the evaluation plan, producing the outputs of one mixer */
+	struct PlanStep {
+		Mixer			*mixer;		/**< mixer evaluated through mix(), nullptr for a linear output */
+		const mixer_scaler_s	*output_scaler;	/**< output scaling of a linear output */
+		uint16_t		first_input;	/**< index of the first input of a linear output in _plan_inputs */
+		uint16_t		input_count;	/**< number of inputs of a linear output */
+	};
+
+	unsigned			mix_plan(float *outputs, unsigned space);
+
+	void				clear_plan();
+
 	List<Mixer *>			_mixers;	/**< linked list of mixers */
+
+	PlanStep			*_plan{nullptr};		/**< evaluation plan, one step per mixer */
+	mixer_linear_input_s		*_plan_inputs{nullptr};	/**< inputs of all linear outputs of the plan */
+	unsigned			_plan_steps{0};
 };
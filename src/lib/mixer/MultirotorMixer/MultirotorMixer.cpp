@@ -95,17 +95,38 @@ MultirotorMixer::MultirotorMixer(ControlCallback control_cb, uintptr_t cb_handle
 	_rotor_count(rotor_count),
 	_rotors(rotors),
 	_outputs_prev(new float[_rotor_count]),
-	_tmp_array(new float[_rotor_count])
+	_allocation(new float[_rotor_count * AXIS_COUNT])
 {
 	for (unsigned i = 0; i < _rotor_count; ++i) {
 		_outputs_prev[i] = _idle_speed;
 	}
+
+	// precompute the column-major allocation matrix from the rotor table
+	for (unsigned i = 0; i < _rotor_count; ++i) {
+		_allocation[ROLL * _rotor_count + i] = _rotors[i].roll_scale;
+		_allocation[PITCH * _rotor_count + i] = _rotors[i].pitch_scale;
+		_allocation[YAW * _rotor_count + i] = _rotors[i].yaw_scale;
+		_allocation[THRUST * _rotor_count + i] = _rotors[i].thrust_scale;
+	}
+
+	// uniform columns (typically thrust) allow closed-form desaturation
+	for (int axis = 0; axis < AXIS_COUNT; axis++) {
+		const float *column = allocation_column((Axis)axis);
+		_allocation_uniform[axis] = (_rotor_count > 0);
+
+		for (unsigned i = 1; i < _rotor_count; ++i) {
+			if (column[i] != column[0]) {
+				_allocation_uniform[axis] = false;
+				break;
+			}
+		}
+	}
 }
 
 MultirotorMixer::~MultirotorMixer()
 {
 	delete[] _outputs_prev;
-	delete[] _tmp_array;
+	delete[] _allocation;
 }
 
 MultirotorMixer *
@@ -203,10 +224,68 @@ MultirotorMixer::compute_desaturation_gain(const float *desaturation_vector, con
 	return k_min + k_max;
 }
 
+float
+MultirotorMixer::compute_desaturation_gain_uniform(float desaturation_value, float output_min, float output_max,
+		saturation_status &sat_status, float min_output, float max_output)
+{
+	// Avoid division by zero, there's nothing we can do to unsaturate anyway
+	if (fabsf(desaturation_value) < FLT_EPSILON) {
+		return 0.f;
+	}
+
+	// With all entries equal the gains of the most saturated outputs on either side are the extremes
+	float k = 0.f;
+
+	if (output_min < min_output) {
+		k += (min_output - output_min) / desaturation_value;
+		sat_status.flags.motor_neg = true;
+	}
+
+	if (output_max > max_output) {
+		k += (max_output - output_max) / desaturation_value;
+		sat_status.flags.motor_pos = true;
+	}
+
+	return k;
+}
+
 void
-MultirotorMixer::minimize_saturation(const float *desaturation_vector, float *outputs,
+MultirotorMixer::minimize_saturation(Axis axis, float *outputs,
 				     saturation_status &sat_status, float min_output, float max_output, bool reduce_only) const
 {
+	const float *desaturation_vector = allocation_column(axis);
+
+	if (_allocation_uniform[axis]) {
+		// closed form: a single pass to find the output range, both gains follow from it
+		const float desaturation_value = desaturation_vector[0];
+		float output_min = outputs[0];
+		float output_max = outputs[0];
+
+		for (unsigned i = 1; i < _rotor_count; i++) {
+			output_min = math::min(output_min, outputs[i]);
+			output_max = math::max(output_max, outputs[i]);
+		}
+
+		const float k1 = compute_desaturation_gain_uniform(desaturation_value, output_min, output_max, sat_status,
+				 min_output, max_output);
+
+		if (reduce_only && k1 > 0.f) {
+			return;
+		}
+
+		// the output range is shifted by the same amount as every output
+		const float delta1 = k1 * desaturation_value;
+		const float k2 = 0.5f * compute_desaturation_gain_uniform(desaturation_value, output_min + delta1, output_max + delta1,
+				 sat_status, min_output, max_output);
+		const float delta2 = k2 * desaturation_value;
+
+		for (unsigned i = 0; i < _rotor_count; i++) {
+			outputs[i] = (outputs[i] + delta1) + delta2;
+		}
+
+		return;
+	}
+
 	float k1 = compute_desaturation_gain(desaturation_vector, outputs, sat_status, min_output, max_output);
 
 	if (reduce_only && k1 > 0.f) {
@@ -227,22 +306,33 @@ MultirotorMixer::minimize_saturation(const float *desaturation_vector, float *ou
 	}
 }
 
+void
+MultirotorMixer::mix_allocation(float roll, float pitch, float yaw, float thrust, float *outputs) const
+{
+	const float *roll_scale = allocation_column(ROLL);
+	const float *pitch_scale = allocation_column(PITCH);
+	const float *yaw_scale = allocation_column(YAW);
+	const float *thrust_scale = allocation_column(THRUST);
+
+	// contiguous columns and no dependency between rotors, the compiler can vectorize this
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		outputs[i] = roll * roll_scale[i] +
+			     pitch * pitch_scale[i] +
+			     yaw * yaw_scale[i] +
+			     thrust * thrust_scale[i];
+	}
+}
+
 void
 MultirotorMixer::mix_airmode_rp(float roll, float pitch, float yaw, float thrust, float *outputs)
 {
 	// Airmode for roll and pitch, but not yaw
 
 	// Mix without yaw
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] = roll * _rotors[i].roll_scale +
-			     pitch * _rotors[i].pitch_scale +
-			     thrust * _rotors[i].thrust_scale;
-
-		// Thrust will be used to unsaturate if needed
-		_tmp_array[i] = _rotors[i].thrust_scale;
-	}
+	mix_allocation(roll, pitch, 0.f, thrust, outputs);
 
-	minimize_saturation(_tmp_array, outputs, _saturation_status);
+	// Thrust will be used to unsaturate if needed
+	minimize_saturation(THRUST, outputs, _saturation_status);
 
 	// Mix yaw independently
 	mix_yaw(yaw, outputs);
@@ -254,25 +344,14 @@ MultirotorMixer::mix_airmode_rpy(float roll, float pitch, float yaw, float thrus
 	// Airmode for roll, pitch and yaw
 
 	// Do full mixing
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] = roll * _rotors[i].roll_scale +
-			     pitch * _rotors[i].pitch_scale +
-			     yaw * _rotors[i].yaw_scale +
-			     thrust * _rotors[i].thrust_scale;
+	mix_allocation(roll, pitch, yaw, thrust, outputs);
 
-		// Thrust will be used to unsaturate if needed
-		_tmp_array[i] = _rotors[i].thrust_scale;
-	}
-
-	minimize_saturation(_tmp_array, outputs, _saturation_status);
+	// Thrust will be used to unsaturate if needed
+	minimize_saturation(THRUST, outputs, _saturation_status);
 
 	// Unsaturate yaw (in case upper and lower bounds are exceeded)
 	// to prioritize roll/pitch over yaw.
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		_tmp_array[i] = _rotors[i].yaw_scale;
-	}
-
-	minimize_saturation(_tmp_array, outputs, _saturation_status);
+	minimize_saturation(YAW, outputs, _saturation_status);
 }
 
 void
@@ -281,30 +360,15 @@ MultirotorMixer::mix_airmode_disabled(float roll, float pitch, float yaw, float
 	// Airmode disabled: never allow to increase the thrust to unsaturate a motor
 
 	// Mix without yaw
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] = roll * _rotors[i].roll_scale +
-			     pitch * _rotors[i].pitch_scale +
-			     thrust * _rotors[i].thrust_scale;
-
-		// Thrust will be used to unsaturate if needed
-		_tmp_array[i] = _rotors[i].thrust_scale;
-	}
+	mix_allocation(roll, pitch, 0.f, thrust, outputs);
 
-	// only reduce thrust
-	minimize_saturation(_tmp_array, outputs, _saturation_status, 0.f, 1.f, true);
+	// Thrust will be used to unsaturate if needed, only reduce thrust
+	minimize_saturation(THRUST, outputs, _saturation_status, 0.f, 1.f, true);
 
 	// Reduce roll/pitch acceleration if needed to unsaturate
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		_tmp_array[i] = _rotors[i].roll_scale;
-	}
+	minimize_saturation(ROLL, outputs, _saturation_status);
 
-	minimize_saturation(_tmp_array, outputs, _saturation_status);
-
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		_tmp_array[i] = _rotors[i].pitch_scale;
-	}
-
-	minimize_saturation(_tmp_array, outputs, _saturation_status);
+	minimize_saturation(PITCH, outputs, _saturation_status);
 
 	// Mix yaw independently
 	mix_yaw(yaw, outputs);
@@ -313,23 +377,19 @@ MultirotorMixer::mix_airmode_disabled(float roll, float pitch, float yaw, float
 void MultirotorMixer::mix_yaw(float yaw, float *outputs)
 {
 	// Add yaw to outputs
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		outputs[i] += yaw * _rotors[i].yaw_scale;
+	const float *yaw_scale = allocation_column(YAW);
 
-		// Yaw will be used to unsaturate if needed
-		_tmp_array[i] = _rotors[i].yaw_scale;
+	for (unsigned i = 0; i < _rotor_count; i++) {
+		outputs[i] += yaw * yaw_scale[i];
 	}
 
-	// Change yaw acceleration to unsaturate the outputs if needed (do not change roll/pitch),
+	// Yaw will be used to unsaturate if needed:
+	// change yaw acceleration to unsaturate the outputs if needed (do not change roll/pitch),
 	// and allow some yaw response at maximum thrust
-	minimize_saturation(_tmp_array, outputs, _saturation_status, 0.f, 1.15f);
-
-	for (unsigned i = 0; i < _rotor_count; i++) {
-		_tmp_array[i] = _rotors[i].thrust_scale;
-	}
+	minimize_saturation(YAW, outputs, _saturation_status, 0.f, 1.15f);
 
 	// reduce thrust only
-	minimize_saturation(_tmp_array, outputs, _saturation_status, 0.f, 1.f, true);
+	minimize_saturation(THRUST, outputs, _saturation_status, 0.f, 1.f, true);
 }
 
 unsigned
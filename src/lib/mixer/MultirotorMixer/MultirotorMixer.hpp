@@ -168,6 +168,19 @@ public:
 	};
 
 private:
+	/**
+	 * Columns of the control allocation matrix, each one can be used as desaturation vector.
+	 */
+	enum Axis {
+		ROLL = 0,
+		PITCH,
+		YAW,
+		THRUST,
+		AXIS_COUNT
+	};
+
+	const float *allocation_column(Axis axis) const { return &_allocation[axis * _rotor_count]; }
+
 	/**
 	 * Computes the gain k by which desaturation_vector has to be multiplied
 	 * in order to unsaturate the output that has the greatest saturation.
@@ -178,6 +191,15 @@ private:
 	float compute_desaturation_gain(const float *desaturation_vector, const float *outputs, saturation_status &sat_status,
 					float min_output, float max_output) const;
 
+	/**
+	 * Closed form of compute_desaturation_gain() for a desaturation vector with the same value
+	 * on all rotors (typically thrust), which only depends on the smallest and largest output.
+	 *
+	 * @return desaturation gain
+	 */
+	static float compute_desaturation_gain_uniform(float desaturation_value, float output_min, float output_max,
+			saturation_status &sat_status, float min_output, float max_output);
+
 	/**
 	 * Minimize the saturation of the actuators by adding or substracting a fraction of desaturation_vector.
 	 * desaturation_vector is the vector that added to the output outputs, modifies the thrust or angular
@@ -189,16 +211,21 @@ private:
 	 * Note that as we only slide along the given axis, in extreme cases outputs can still contain values
 	 * outside of [min_output, max_output].
 	 *
-	 * @param desaturation_vector vector that is added to the outputs, e.g. thrust_scale
+	 * @param axis allocation matrix column that is added to the outputs, e.g. THRUST
 	 * @param outputs output vector that is modified
 	 * @param sat_status saturation status output
 	 * @param min_output minimum desired value in outputs
 	 * @param max_output maximum desired value in outputs
 	 * @param reduce_only if true, only allow to reduce (substract) a fraction of desaturation_vector
 	 */
-	void minimize_saturation(const float *desaturation_vector, float *outputs, saturation_status &sat_status,
+	void minimize_saturation(Axis axis, float *outputs, saturation_status &sat_status,
 				 float min_output = 0.f, float max_output = 1.f, bool reduce_only = false) const;
 
+	/**
+	 * Set the outputs vector from the allocation matrix: outputs = A * [roll pitch yaw thrust]^T
+	 */
+	inline void mix_allocation(float roll, float pitch, float yaw, float thrust, float *outputs) const;
+
 	/**
 	 * Mix roll, pitch, yaw, thrust and set the outputs vector.
 	 *
@@ -256,5 +283,7 @@ private:
 	const Rotor			*_rotors;
 
 	float 				*_outputs_prev{nullptr};
-	float 				*_tmp_array{nullptr};
+
+	float 				*_allocation{nullptr};	///< control allocation matrix, column-major (one column per Axis)
+	bool				_allocation_uniform[AXIS_COUNT] {};	///< all rotors have the same scale on this axis
 };
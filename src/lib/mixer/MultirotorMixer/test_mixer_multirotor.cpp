@@ -34,11 +34,18 @@
 /**
  * testing binary that runs the multirotor mixer through test cases given
  * via file or stdin and compares the mixer output against expected values.
+ *
+ * Usage: test_mixer_multirotor [<file>] [--benchmark <iterations>]
+ * With --benchmark, the mixer read from the test input is timed afterwards
+ * on a deterministic sweep of control inputs.
  */
 
 #include "MultirotorMixer.hpp"
 
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <math.h>
 
 static const unsigned output_max = 16;
@@ -56,12 +63,56 @@ mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, f
 	return 0;
 }
 
+static void benchmark(MultirotorMixer &mixer, unsigned rotor_count, int iterations)
+{
+	float actuator_outputs[output_max];
+	volatile float sink = 0.f;
+
+	// pseudo random control inputs (LCG), including saturating ones
+	uint32_t seed = 1;
+	static constexpr int num_inputs = 256;
+	float controls[num_inputs][4];
+
+	for (int n = 0; n < num_inputs; n++) {
+		for (int i = 0; i < 4; i++) {
+			seed = seed * 1664525u + 1013904223u;
+			controls[n][i] = (seed >> 8) / (float)(1 << 24) * 2.4f - 1.2f;
+		}
+
+		controls[n][3] = fabsf(controls[n][3]);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int k = 0; k < iterations; k++) {
+		memcpy(actuator_controls, controls[k % num_inputs], sizeof(controls[0]));
+		mixer.mix(actuator_outputs, output_max);
+		sink = sink + actuator_outputs[0];
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	const double elapsed_ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+	printf("benchmark: %u rotors, %i iterations, %.1f ns per mix\n", rotor_count, iterations,
+	       iterations > 0 ? elapsed_ns / iterations : 0.0);
+}
+
 int main(int argc, char *argv[])
 {
 	FILE *file_in = stdin;
+	int benchmark_iterations = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--benchmark") && (i + 1 < argc)) {
+			benchmark_iterations = atoi(argv[++i]);
 
-	if (argc > 1) {
-		file_in = fopen(argv[1], "r");
+		} else {
+			file_in = fopen(argv[i], "r");
+		}
+	}
+
+	if (file_in == nullptr) {
+		return -1;
 	}
 
 	unsigned rotor_count = 0;
@@ -164,5 +215,9 @@ int main(int argc, char *argv[])
 		fclose(file_in);
 	}
 
+	if (benchmark_iterations > 0) {
+		benchmark(mixer, rotor_count, benchmark_iterations);
+	}
+
 	return num_failed > 0 ? -1 : 0;
 }
@@ -265,6 +265,31 @@ SimpleMixer::mix(float *outputs, unsigned space)
 	return 1;
 }
 
+int
+SimpleMixer::compile_linear(const float *controls, unsigned num_groups, unsigned group_size,
+			    mixer_linear_input_s *inputs, const mixer_scaler_s *&output_scaler) const
+{
+	if (_pinfo == nullptr) {
+		return -1;
+	}
+
+	for (unsigned i = 0; i < _pinfo->control_count; i++) {
+		const mixer_control_s &control = _pinfo->controls[i];
+
+		if (control.control_group >= num_groups || control.control_index >= group_size) {
+			return -1;
+		}
+
+		if (inputs != nullptr) {
+			inputs[i].control = &controls[control.control_group * group_size + control.control_index];
+			inputs[i].scaler = &control.scaler;
+		}
+	}
+
+	output_scaler = &_pinfo->output_scaler;
+	return _pinfo->control_count;
+}
+
 void
 SimpleMixer::groups_required(uint32_t &groups)
 {
@@ -120,7 +120,8 @@ public:
 	unsigned			set_trim(float trim) override;
 	unsigned			get_trim(float *trim) override;
 
-private:
+	int				compile_linear(const float *controls, unsigned num_groups, unsigned group_size,
+			mixer_linear_input_s *inputs, const mixer_scaler_s *&output_scaler) const override;
 
 	/**
 	 * Perform simpler linear scaling.
@@ -131,6 +132,8 @@ private:
 	 */
 	static float			scale(const mixer_scaler_s &scaler, float input);
 
+private:
+
 	/**
 	 * Validate a scaler
 	 *
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ThrustCurve.hpp
+ *
+ * Motor thrust linearization with precomputed lookup tables.
+ *
+ * Each motor has a table with the motor command required for equidistant
+ * normalized thrust values in [0, 1], so the per-cycle cost is a single
+ * table lookup and a linear interpolation.
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <lib/mathlib/mathlib.h>
+#include <px4_platform_common/defines.h>
+
+class ThrustCurve
+{
+public:
+	static constexpr int NUM_POINTS = 33; ///< table size, thrust resolution is 1 / (NUM_POINTS - 1)
+	static constexpr int MAX_MOTORS = 12;
+
+	ThrustCurve() { setQuadraticModel(0.f); }
+	~ThrustCurve() = default;
+
+	/**
+	 * Set the tables of all motors from the thrust model used by the multirotor mixer:
+	 * thrust = (1 - factor) * command + factor * command^2
+	 * @param thrust_factor model factor in [0, 1], 0 is linear
+	 */
+	void setQuadraticModel(float thrust_factor)
+	{
+		const float factor = math::constrain(thrust_factor, 0.f, 1.f);
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			const float thrust = (float)i / (NUM_POINTS - 1);
+			float command = thrust;
+
+			if (factor > 0.f) {
+				command = -(1.f - factor) / (2.f * factor) + sqrtf((1.f - factor) * (1.f - factor) / (4.f * factor * factor)
+						+ thrust / factor);
+			}
+
+			_table[0][i] = math::constrain(command, 0.f, 1.f);
+		}
+
+		for (int motor = 1; motor < MAX_MOTORS; motor++) {
+			memcpy(_table[motor], _table[0], sizeof(_table[0]));
+		}
+	}
+
+	/**
+	 * Set the table of a motor from a measured thrust curve.
+	 * @param motor motor index, or -1 for all motors
+	 * @param thrust measured thrust (any unit) at equidistant commands from 0 to 1, strictly increasing
+	 * @param num_points number of measurements, at least 2
+	 * @return false if the curve is invalid (the table is not changed)
+	 */
+	bool setMeasuredCurve(int motor, const float thrust[], int num_points)
+	{
+		if (motor < -1 || motor >= MAX_MOTORS || num_points < 2) {
+			return false;
+		}
+
+		for (int k = 0; k < num_points - 1; k++) {
+			if (!PX4_ISFINITE(thrust[k]) || !PX4_ISFINITE(thrust[k + 1]) || thrust[k + 1] <= thrust[k]) {
+				return false;
+			}
+		}
+
+		// invert the piecewise linear curve at the table thrust values
+		const float thrust_min = thrust[0];
+		const float thrust_range = thrust[num_points - 1] - thrust[0];
+		float table[NUM_POINTS];
+		int k = 0;
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			const float target = thrust_min + thrust_range * i / (NUM_POINTS - 1);
+
+			while (k < num_points - 2 && thrust[k + 1] < target) {
+				k++;
+			}
+
+			const float segment = (target - thrust[k]) / (thrust[k + 1] - thrust[k]);
+			table[i] = math::constrain((k + segment) / (num_points - 1), 0.f, 1.f);
+		}
+
+		for (int m = 0; m < MAX_MOTORS; m++) {
+			if (motor == -1 || motor == m) {
+				memcpy(_table[m], table, sizeof(table));
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Get the motor command for a normalized thrust
+	 * @param motor motor index in [0, MAX_MOTORS)
+	 * @param thrust normalized thrust, constrained to [0, 1]
+	 * @return motor command in [0, 1]
+	 */
+	float linearize(int motor, float thrust) const
+	{
+		const float x = math::constrain(thrust, 0.f, 1.f) * (NUM_POINTS - 1);
+		const int index = math::min((int)x, NUM_POINTS - 2);
+		const float *table = _table[motor];
+		return table[index] + (x - index) * (table[index + 1] - table[index]);
+	}
+
+	/**
+	 * Linearize mixer outputs in place
+	 * @param outputs mixer outputs in [-1, 1], non-finite (disabled) outputs are left unchanged
+	 * @param num_motors number of motor outputs, starting at index 0
+	 */
+	void apply(float outputs[], unsigned num_motors) const
+	{
+		num_motors = math::min(num_motors, (unsigned)MAX_MOTORS);
+
+		for (unsigned i = 0; i < num_motors; i++) {
+			if (PX4_ISFINITE(outputs[i])) {
+				outputs[i] = linearize(i, (outputs[i] + 1.f) * 0.5f) * 2.f - 1.f;
+			}
+		}
+	}
+
+private:
+	float _table[MAX_MOTORS][NUM_POINTS]; ///< motor command at thrust i / (NUM_POINTS - 1)
+};
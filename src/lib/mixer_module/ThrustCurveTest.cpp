@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the thrust curve lookup tables
+ * Run this test only using make tests TESTFILTER=ThrustCurve
+ */
+
+#include <gtest/gtest.h>
+
+#include "ThrustCurve.hpp"
+
+TEST(ThrustCurveTest, LinearByDefault)
+{
+	ThrustCurve curve;
+
+	for (float thrust = 0.f; thrust <= 1.f; thrust += 0.01f) {
+		EXPECT_NEAR(curve.linearize(0, thrust), thrust, 1e-6f);
+	}
+
+	EXPECT_FLOAT_EQ(curve.linearize(0, -0.5f), 0.f);
+	EXPECT_FLOAT_EQ(curve.linearize(0, 1.5f), 1.f);
+}
+
+TEST(ThrustCurveTest, QuadraticModel)
+{
+	// the table has to match the sqrt based thrust model of the multirotor mixer
+	const float factor = 0.3f;
+	ThrustCurve curve;
+	curve.setQuadraticModel(factor);
+
+	for (float thrust = 0.f; thrust <= 1.f; thrust += 0.01f) {
+		const float command = -(1.f - factor) / (2.f * factor) + sqrtf((1.f - factor) * (1.f - factor) /
+				      (4.f * factor * factor) + thrust / factor);
+		EXPECT_NEAR(curve.linearize(0, thrust), command, 1e-3f);
+		EXPECT_NEAR(curve.linearize(ThrustCurve::MAX_MOTORS - 1, thrust), command, 1e-3f);
+	}
+}
+
+TEST(ThrustCurveTest, MeasuredCurvePerMotor)
+{
+	// thrust in grams at 0, 25, 50, 75 and 100% command
+	const float thrust[] = {0.f, 125.f, 250.f, 500.f, 1000.f};
+	ThrustCurve curve;
+	EXPECT_TRUE(curve.setMeasuredCurve(1, thrust, 5));
+
+	// the measurement points are reproduced exactly
+	EXPECT_NEAR(curve.linearize(1, 0.f), 0.f, 1e-6f);
+	EXPECT_NEAR(curve.linearize(1, 0.125f), 0.25f, 1e-6f);
+	EXPECT_NEAR(curve.linearize(1, 0.25f), 0.5f, 1e-6f);
+	EXPECT_NEAR(curve.linearize(1, 0.5f), 0.75f, 1e-6f);
+	EXPECT_NEAR(curve.linearize(1, 1.f), 1.f, 1e-6f);
+
+	// monotonic in between
+	float previous = 0.f;
+
+	for (float t = 0.01f; t <= 1.f; t += 0.01f) {
+		const float command = curve.linearize(1, t);
+		EXPECT_GE(command, previous);
+		previous = command;
+	}
+
+	// other motors are not affected
+	EXPECT_NEAR(curve.linearize(0, 0.3f), 0.3f, 1e-6f);
+	EXPECT_NEAR(curve.linearize(2, 0.3f), 0.3f, 1e-6f);
+}
+
+TEST(ThrustCurveTest, InvalidMeasuredCurve)
+{
+	const float not_increasing[] = {0.f, 0.5f, 0.4f, 1.f};
+	const float valid[] = {0.f, 0.5f, 1.f};
+	ThrustCurve curve;
+
+	EXPECT_FALSE(curve.setMeasuredCurve(-1, not_increasing, 4));
+	EXPECT_FALSE(curve.setMeasuredCurve(-1, valid, 1));
+	EXPECT_FALSE(curve.setMeasuredCurve(ThrustCurve::MAX_MOTORS, valid, 3));
+	EXPECT_NEAR(curve.linearize(0, 0.3f), 0.3f, 1e-6f);
+}
+
+TEST(ThrustCurveTest, ApplyOutputs)
+{
+	// thrust is quadratic in the command, interpolated linearly between the measurements
+	const float thrust[] = {0.f, 0.0625f, 0.25f, 0.5625f, 1.f};
+	ThrustCurve curve;
+	curve.setMeasuredCurve(-1, thrust, 5);
+
+	float outputs[] = {-1.f, 0.f, 1.f, NAN, 0.f};
+	curve.apply(outputs, 4);
+
+	EXPECT_FLOAT_EQ(outputs[0], -1.f);
+	EXPECT_NEAR(outputs[1], 2.f * 0.7f - 1.f, 1e-5f);
+	EXPECT_FLOAT_EQ(outputs[2], 1.f);
+	EXPECT_FALSE(PX4_ISFINITE(outputs[3]));
+	EXPECT_FLOAT_EQ(outputs[4], 0.f); // not a motor
+}
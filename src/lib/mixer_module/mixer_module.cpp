@@ -40,6 +40,7 @@
 
 using namespace time_literals;
 
+px4::atomic<px4::WorkItem *> MixingOutput::_direct_output{nullptr};
 
 MixingOutput::MixingOutput(uint8_t max_num_outputs, OutputModuleInterface &interface,
 			   SchedulingPolicy scheduling_policy,
@@ -49,13 +50,16 @@ MixingOutput::MixingOutput(uint8_t max_num_outputs, OutputModuleInterface &inter
 	{&interface, ORB_ID(actuator_controls_0)},
 	{&interface, ORB_ID(actuator_controls_1)},
 	{&interface, ORB_ID(actuator_controls_2)},
-	{&interface, ORB_ID(actuator_controls_3)}
+	{&interface, ORB_ID(actuator_controls_3)},
+	{&interface, ORB_ID(actuator_controls_4)},
+	{&interface, ORB_ID(actuator_controls_5)}
 },
 _scheduling_policy(scheduling_policy),
 _support_esc_calibration(support_esc_calibration),
 _max_num_outputs(max_num_outputs < MAX_ACTUATORS ? max_num_outputs : MAX_ACTUATORS),
 _interface(interface),
-_control_latency_perf(perf_alloc(PC_ELAPSED, "control latency"))
+_control_latency_perf(perf_alloc(PC_ELAPSED, "control latency")),
+_mix_perf(perf_alloc(PC_ELAPSED_CYCLES, "mix"))
 {
 	output_limit_init(&_output_limit);
 	_output_limit.ramp_up = ramp_up;
@@ -80,15 +84,20 @@ _control_latency_perf(perf_alloc(PC_ELAPSED, "control latency"))
 MixingOutput::~MixingOutput()
 {
 	perf_free(_control_latency_perf);
+	perf_free(_mix_perf);
 	delete _mixers;
+	delete _thrust_curve;
 	px4_sem_destroy(&_lock);
 }
 
 void MixingOutput::printStatus() const
 {
 	perf_print_counter(_control_latency_perf);
+	perf_print_counter(_mix_perf);
 	PX4_INFO("Switched to rate_ctrl work queue: %i", (int)_wq_switched);
+	PX4_INFO("Direct output: %i", (int)(_direct_output.load() == &_interface));
 	PX4_INFO("Mixer loaded: %s", _mixers ? "yes" : "no");
+	PX4_INFO("Thrust curve: %s", _thrust_curve ? "yes" : "no");
 	PX4_INFO("Driver instance: %i", _driver_instance);
 
 	PX4_INFO("Channel Configuration:");
@@ -110,8 +119,63 @@ void MixingOutput::updateParams()
 			_mixers->set_max_delta_out_once(0.f);
 		}
 
-		_mixers->set_thrust_factor(_param_thr_mdl_fac.get());
 		_mixers->set_airmode((Mixer::Airmode)_param_mc_airmode.get());
+		_mixers->set_rpm_governor(_param_heli_gov_rpm.get(), _param_heli_gov_p.get(), _param_heli_gov_i.get());
+	}
+
+	updateThrustCurve();
+	updateDirectOutput();
+}
+
+void MixingOutput::updateRpmGovernor()
+{
+	rpm_s rpm;
+
+	if (_rpm_sub.update(&rpm)) {
+		const float dt = _time_last_rpm != 0 ? (rpm.timestamp - _time_last_rpm) * 1e-6f : 0.f;
+		_time_last_rpm = rpm.timestamp;
+		_mixers->set_rotor_rpm(rpm.indicated_frequency_rpm, dt);
+
+	} else if (_time_last_rpm != 0 && hrt_elapsed_time(&_time_last_rpm) > 500_ms) {
+		// measurement timed out: fall back to the throttle curve
+		_time_last_rpm = 0;
+		_mixers->set_rotor_rpm(NAN, 0.f);
+	}
+}
+
+void MixingOutput::updateThrustCurve()
+{
+	const ThrustCurveMode mode = (ThrustCurveMode)_param_mot_thr_crv.get();
+
+	if (mode == ThrustCurveMode::Model || mode == ThrustCurveMode::Measured) {
+		if (_thrust_curve == nullptr) {
+			_thrust_curve = new ThrustCurve();
+		}
+
+		if (_thrust_curve) {
+			if (mode == ThrustCurveMode::Measured) {
+				const float thrust[] = {0.f, _param_mot_thr_p1.get(), _param_mot_thr_p2.get(), _param_mot_thr_p3.get(),
+							_param_mot_thr_p4.get(), _param_mot_thr_p5.get(), _param_mot_thr_p6.get(), _param_mot_thr_p7.get(), 1.f
+						       };
+
+				if (!_thrust_curve->setMeasuredCurve(-1, thrust, sizeof(thrust) / sizeof(thrust[0]))) {
+					PX4_ERR("invalid thrust curve (MOT_THR_P*), using THR_MDL_FAC");
+					_thrust_curve->setQuadraticModel(_param_thr_mdl_fac.get());
+				}
+
+			} else {
+				_thrust_curve->setQuadraticModel(_param_thr_mdl_fac.get());
+			}
+		}
+
+	} else if (_thrust_curve) {
+		delete _thrust_curve;
+		_thrust_curve = nullptr;
+	}
+
+	if (_mixers) {
+		// the thrust model is either applied by the mixer or by the table
+		_mixers->set_thrust_factor(_thrust_curve ? 0.f : _param_thr_mdl_fac.get());
 	}
 }
 
@@ -163,6 +227,7 @@ bool MixingOutput::updateSubscriptions(bool allow_wq_switch)
 
 	_groups_subscribed = _groups_required;
 	setMaxTopicUpdateRate(_max_topic_update_interval_us);
+	updateDirectOutput();
 
 	PX4_DEBUG("_groups_required 0x%08x", _groups_required);
 	PX4_DEBUG("_groups_subscribed 0x%08x", _groups_subscribed);
@@ -181,6 +246,39 @@ void MixingOutput::setMaxTopicUpdateRate(unsigned max_topic_update_interval_us)
 			_control_subs[i].set_interval_us(_max_topic_update_interval_us);
 		}
 	}
+
+	updateDirectOutput();
+}
+
+void MixingOutput::updateDirectOutput()
+{
+	// only when running on the publisher's work queue (rate_ctrl), scheduled by the actuator_controls_0 callback
+	const bool direct_output = _param_mot_direct_out.get()
+				   && (_scheduling_policy == SchedulingPolicy::Auto) && _wq_switched
+				   && (_groups_subscribed & (1 << actuator_controls_s::GROUP_INDEX_ATTITUDE));
+
+	px4::WorkItem *interface = &_interface;
+
+	if (direct_output) {
+		// first output module wins, others are scheduled through uORB
+		px4::WorkItem *expected = nullptr;
+		_direct_output.compare_exchange(&expected, interface);
+
+	} else {
+		_direct_output.compare_exchange(&interface, nullptr);
+	}
+}
+
+bool MixingOutput::runDirectOutput(px4::WorkItem &publisher)
+{
+	px4::WorkItem *output = _direct_output.load();
+
+	if (output == nullptr) {
+		return false;
+	}
+
+	// only runs if the uORB callback scheduled the output module (respecting the topic rate limit)
+	return publisher.RunInline(output);
 }
 
 void MixingOutput::setAllMinValues(uint16_t value)
@@ -216,6 +314,9 @@ void MixingOutput::unregister()
 	for (auto &control_sub : _control_subs) {
 		control_sub.unregisterCallback();
 	}
+
+	px4::WorkItem *interface = &_interface;
+	_direct_output.compare_exchange(&interface, nullptr);
 }
 
 void MixingOutput::updateOutputSlewrate()
@@ -361,9 +462,21 @@ bool MixingOutput::update()
 		}
 	}
 
+	updateMixerInputs();
+
+	if (_param_heli_gov_rpm.get() > 0.f) {
+		updateRpmGovernor();
+	}
+
 	/* do mixing */
 	float outputs[MAX_ACTUATORS] {};
+	perf_begin(_mix_perf);
 	const unsigned mixed_num_outputs = _mixers->mix(outputs, _max_num_outputs);
+	perf_end(_mix_perf);
+
+	if (_thrust_curve) {
+		_thrust_curve->apply(outputs, math::min(_mixers->get_multirotor_count(), mixed_num_outputs));
+	}
 
 	/* the output limit call takes care of out of band errors, NaN and constrains */
 	output_limit_calc(_throttle_armed, armNoThrottle(), mixed_num_outputs, _reverse_output_mask,
@@ -393,6 +506,7 @@ bool MixingOutput::update()
 	/* now return the outputs to the driver */
 	if (_interface.updateOutputs(stop_motors, _current_output_value, mixed_num_outputs, n_updates)) {
 		actuator_outputs_s actuator_outputs{};
+		actuator_outputs.timestamp_sample = controlsTimestampSample();
 		setAndPublishActuatorOutputs(mixed_num_outputs, actuator_outputs);
 
 		publishMixerStatus(actuator_outputs);
@@ -432,8 +546,8 @@ MixingOutput::publishMixerStatus(const actuator_outputs_s &actuator_outputs)
 	}
 }
 
-void
-MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
+hrt_abstime
+MixingOutput::controlsTimestampSample() const
 {
 	// use first valid timestamp_sample for latency tracking
 	for (int i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; i++) {
@@ -441,10 +555,20 @@ MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_output
 		const hrt_abstime &timestamp_sample = _controls[i].timestamp_sample;
 
 		if (required && (timestamp_sample > 0)) {
-			perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - timestamp_sample);
-			break;
+			return timestamp_sample;
 		}
 	}
+
+	return 0;
+}
+
+void
+MixingOutput::updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs)
+{
+	// sensor sample to output latency (the outputs are already written to the hardware at this point)
+	if ((actuator_outputs.timestamp_sample > 0) && (actuator_outputs.timestamp >= actuator_outputs.timestamp_sample)) {
+		perf_set_elapsed(_control_latency_perf, actuator_outputs.timestamp - actuator_outputs.timestamp_sample);
+	}
 }
 
 void
@@ -496,39 +620,41 @@ int MixingOutput::controlCallback(uintptr_t handle, uint8_t control_group, uint8
 {
 	const MixingOutput *output = (const MixingOutput *)handle;
 
-	input = output->_controls[control_group].control[control_index];
+	input = output->_mixer_inputs[control_group][control_index];
 
-	/* limit control input */
-	if (input > 1.0f) {
-		input = 1.0f;
+	return 0;
+}
 
-	} else if (input < -1.0f) {
-		input = -1.0f;
+void MixingOutput::updateMixerInputs()
+{
+	for (unsigned group = 0; group < actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS; group++) {
+		if (_groups_subscribed & (1 << group)) {
+			for (unsigned index = 0; index < actuator_controls_s::NUM_ACTUATOR_CONTROLS; index++) {
+				/* limit control input */
+				_mixer_inputs[group][index] = math::constrain(_controls[group].control[index], -1.f, 1.f);
+			}
+		}
 	}
 
-	/* motor spinup phase - lock throttle to zero */
-	if (output->_output_limit.state == OUTPUT_LIMIT_STATE_RAMP) {
-		if ((control_group == actuator_controls_s::GROUP_INDEX_ATTITUDE ||
-		     control_group == actuator_controls_s::GROUP_INDEX_ATTITUDE_ALTERNATE) &&
-		    control_index == actuator_controls_s::INDEX_THROTTLE) {
+	const uint8_t throttle_groups[] {actuator_controls_s::GROUP_INDEX_ATTITUDE, actuator_controls_s::GROUP_INDEX_ATTITUDE_ALTERNATE};
+
+	for (uint8_t group : throttle_groups) {
+		float &throttle = _mixer_inputs[group][actuator_controls_s::INDEX_THROTTLE];
+
+		/* motor spinup phase - lock throttle to zero */
+		if (_output_limit.state == OUTPUT_LIMIT_STATE_RAMP) {
 			/* limit the throttle output to zero during motor spinup,
 			 * as the motors cannot follow any demand yet
 			 */
-			input = 0.0f;
+			throttle = 0.0f;
 		}
-	}
 
-	/* throttle not arming - mark throttle input as invalid */
-	if (output->armNoThrottle() && !output->_armed.in_esc_calibration_mode) {
-		if ((control_group == actuator_controls_s::GROUP_INDEX_ATTITUDE ||
-		     control_group == actuator_controls_s::GROUP_INDEX_ATTITUDE_ALTERNATE) &&
-		    control_index == actuator_controls_s::INDEX_THROTTLE) {
+		/* throttle not arming - mark throttle input as invalid */
+		if (armNoThrottle() && !_armed.in_esc_calibration_mode) {
 			/* set the throttle to an invalid value */
-			input = NAN;
+			throttle = NAN;
 		}
 	}
-
-	return 0;
 }
 
 void MixingOutput::resetMixer()
@@ -566,6 +692,10 @@ int MixingOutput::loadMixer(const char *buf, unsigned len)
 	_mixers->groups_required(_groups_required);
 	PX4_DEBUG("loaded mixers \n%s\n", buf);
 
+	/* flatten the mixers into a plan reading _mixer_inputs directly */
+	_mixers->compile(&_mixer_inputs[0][0], actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS,
+			 actuator_controls_s::NUM_ACTUATOR_CONTROLS);
+
 	updateParams();
 	_interface.mixerChanged();
 	return ret;
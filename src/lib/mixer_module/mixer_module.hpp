@@ -33,6 +33,8 @@
 
 #pragma once
 
+#include "ThrustCurve.hpp"
+
 #include <board_config.h>
 #include <drivers/drv_pwm_output.h>
 #include <lib/mixer/MixerGroup.hpp>
@@ -50,6 +52,7 @@
 #include <uORB/topics/actuator_outputs.h>
 #include <uORB/topics/multirotor_motor_limits.h>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/rpm.h>
 #include <uORB/topics/test_motor.h>
 
 /**
@@ -135,6 +138,17 @@ public:
 
 	void setMaxTopicUpdateRate(unsigned max_topic_update_interval_us);
 
+	/**
+	 * Direct output fast path (MOT_DIRECT_OUT): called by the publisher of actuator_controls_0
+	 * from its Run() right after publishing. If an output module on the same (rate_ctrl) work queue
+	 * registered for it, the output module is run inline, so mixing and the output update happen
+	 * within the publisher's cycle instead of after another scheduling round trip.
+	 * Otherwise the regular uORB callback schedules the output module.
+	 * @param publisher WorkItem of the actuator_controls_0 publisher (currently in Run())
+	 * @return true if an output module was run
+	 */
+	static bool runDirectOutput(px4::WorkItem &publisher);
+
 	/**
 	 * Reset (unload) the complete mixer, called from another thread.
 	 * This is thread-safe, as long as only one other thread at a time calls this.
@@ -177,6 +191,12 @@ public:
 
 	void setIgnoreLockdown(bool ignore_lockdown) { _ignore_lockdown = ignore_lockdown; }
 
+	/**
+	 * Get the timestamp_sample of the controls used for the last mix (for latency tracking)
+	 * @return first valid timestamp_sample of the required control groups, 0 if none
+	 */
+	hrt_abstime controlsTimestampSample() const;
+
 protected:
 	void updateParams() override;
 
@@ -191,6 +211,10 @@ private:
 	unsigned motorTest();
 
 	void updateOutputSlewrate();
+	void updateDirectOutput();
+	void updateThrustCurve();
+	void updateRpmGovernor();
+	void updateMixerInputs();
 	void setAndPublishActuatorOutputs(unsigned num_outputs, actuator_outputs_s &actuator_outputs);
 	void publishMixerStatus(const actuator_outputs_s &actuator_outputs);
 	void updateLatencyPerfCounter(const actuator_outputs_s &actuator_outputs);
@@ -202,6 +226,12 @@ private:
 		Betaflight = 1
 	};
 
+	enum class ThrustCurveMode : int32_t {
+		Disabled = 0,
+		Model = 1,    ///< table from THR_MDL_FAC
+		Measured = 2  ///< table from MOT_THR_P*
+	};
+
 	struct Command {
 		enum class Type : int {
 			None,
@@ -235,21 +265,26 @@ private:
 	output_limit_t _output_limit;
 
 	uORB::Subscription _armed_sub{ORB_ID(actuator_armed)};
+	uORB::Subscription _rpm_sub{ORB_ID(rpm)};
 	uORB::SubscriptionCallbackWorkItem _control_subs[actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS];
 
 	uORB::PublicationMulti<actuator_outputs_s> _outputs_pub{ORB_ID(actuator_outputs), ORB_PRIO_DEFAULT};
 	uORB::PublicationMulti<multirotor_motor_limits_s> _to_mixer_status{ORB_ID(multirotor_motor_limits), ORB_PRIO_DEFAULT}; 	///< mixer status flags
 
 	actuator_controls_s _controls[actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS] {};
+	/** limited control values as seen by the mixers (read by controlCallback() and the compiled mixer plan) */
+	float _mixer_inputs[actuator_controls_s::NUM_ACTUATOR_CONTROL_GROUPS][actuator_controls_s::NUM_ACTUATOR_CONTROLS] {};
 	actuator_armed_s _armed{};
 
 	hrt_abstime _time_last_mix{0};
+	hrt_abstime _time_last_rpm{0}; ///< timestamp of the last rotor RPM measurement passed to the governor
 	unsigned _max_topic_update_interval_us{0}; ///< max _control_subs topic update interval (0=unlimited)
 
 	bool _throttle_armed{false};
 	bool _ignore_lockdown{false}; ///< if true, ignore the _armed.lockdown flag (for HIL outputs)
 
 	MixerGroup *_mixers{nullptr};
+	ThrustCurve *_thrust_curve{nullptr}; ///< motor output linearization (replaces the mixer thrust model if set)
 	uint32_t _groups_required{0};
 	uint32_t _groups_subscribed{1u << 31}; ///< initialize to a different value than _groups_required and outside of (1 << NUM_ACTUATOR_CONTROL_GROUPS)
 
@@ -257,6 +292,8 @@ private:
 	const bool _support_esc_calibration;
 
 	bool _wq_switched{false};
+
+	static px4::atomic<px4::WorkItem *> _direct_output; ///< output module run inline by the actuator_controls_0 publisher
 	uint8_t _driver_instance{0}; ///< for boards that supports multiple outputs (e.g. PX4IO + FMU)
 	const uint8_t _max_num_outputs;
 
@@ -270,12 +307,25 @@ private:
 	OutputModuleInterface &_interface;
 
 	perf_counter_t _control_latency_perf;
+	perf_counter_t _mix_perf;
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::MC_AIRMODE>) _param_mc_airmode,   ///< multicopter air-mode
 		(ParamFloat<px4::params::MOT_SLEW_MAX>) _param_mot_slew_max,
 		(ParamFloat<px4::params::THR_MDL_FAC>) _param_thr_mdl_fac, ///< thrust to motor control signal modelling factor
-		(ParamInt<px4::params::MOT_ORDERING>) _param_mot_ordering
+		(ParamInt<px4::params::MOT_ORDERING>) _param_mot_ordering,
+		(ParamBool<px4::params::MOT_DIRECT_OUT>) _param_mot_direct_out,
+		(ParamInt<px4::params::MOT_THR_CRV>) _param_mot_thr_crv,
+		(ParamFloat<px4::params::MOT_THR_P1>) _param_mot_thr_p1,
+		(ParamFloat<px4::params::MOT_THR_P2>) _param_mot_thr_p2,
+		(ParamFloat<px4::params::MOT_THR_P3>) _param_mot_thr_p3,
+		(ParamFloat<px4::params::MOT_THR_P4>) _param_mot_thr_p4,
+		(ParamFloat<px4::params::MOT_THR_P5>) _param_mot_thr_p5,
+		(ParamFloat<px4::params::MOT_THR_P6>) _param_mot_thr_p6,
+		(ParamFloat<px4::params::MOT_THR_P7>) _param_mot_thr_p7,
+		(ParamFloat<px4::params::HELI_GOV_RPM>) _param_heli_gov_rpm,
+		(ParamFloat<px4::params::HELI_GOV_P>) _param_heli_gov_p,
+		(ParamFloat<px4::params::HELI_GOV_I>) _param_heli_gov_i
 
 	)
 };
@@ -33,3 +33,171 @@ PARAM_DEFINE_INT32(MC_AIRMODE, 0);
  * @group Mixer Output
  */
 PARAM_DEFINE_INT32(MOT_ORDERING, 0);
+
+/**
+ * Run the output module directly from the rate controller
+ *
+ * If enabled, the output module driving actuator control group 0 is run by the
+ * rate controller right after it published the actuator controls (both run on the
+ * rate_ctrl work queue), instead of being scheduled through the uORB callback.
+ * This saves one scheduling latency per control cycle.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Mixer Output
+ */
+PARAM_DEFINE_INT32(MOT_DIRECT_OUT, 0);
+
+/**
+ * Motor thrust curve
+ *
+ * Linearizes the motor thrust with a lookup table applied to the multirotor mixer
+ * outputs. This replaces the thrust model of the mixer (THR_MDL_FAC applied on the
+ * mixer output before the idle speed), the curve spans the full motor command range.
+ *
+ * @value 0 Disabled (thrust model in the mixer)
+ * @value 1 From THR_MDL_FAC
+ * @value 2 Measured (MOT_THR_P1 - MOT_THR_P7)
+ * @group Mixer Output
+ */
+PARAM_DEFINE_INT32(MOT_THR_CRV, 0);
+
+/**
+ * Measured motor thrust at 12.5% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P1, 0.125f);
+
+/**
+ * Measured motor thrust at 25% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P2, 0.25f);
+
+/**
+ * Measured motor thrust at 37.5% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P3, 0.375f);
+
+/**
+ * Measured motor thrust at 50% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P4, 0.5f);
+
+/**
+ * Measured motor thrust at 62.5% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P5, 0.625f);
+
+/**
+ * Measured motor thrust at 75% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P6, 0.75f);
+
+/**
+ * Measured motor thrust at 87.5% command
+ *
+ * Thrust normalized by the thrust at full command (e.g. from a thrust stand),
+ * used if MOT_THR_CRV is set to measured. The values must be increasing.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @decimal 3
+ * @increment 0.01
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(MOT_THR_P7, 0.875f);
+
+/**
+ * Helicopter rotor RPM governor setpoint
+ *
+ * If set, the helicopter mixer adds a PI correction to the throttle curve
+ * to hold the rotor at this RPM. Requires a rotor RPM measurement (rpm topic),
+ * without it the throttle curve is used as is.
+ *
+ * @min 0
+ * @max 10000
+ * @unit rpm
+ * @decimal 0
+ * @increment 10
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(HELI_GOV_RPM, 0.0f);
+
+/**
+ * Helicopter rotor RPM governor proportional gain
+ *
+ * Throttle correction per relative RPM error.
+ *
+ * @min 0.0
+ * @max 10.0
+ * @decimal 2
+ * @increment 0.05
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(HELI_GOV_P, 1.0f);
+
+/**
+ * Helicopter rotor RPM governor integral gain
+ *
+ * Throttle correction per relative RPM error and second.
+ *
+ * @min 0.0
+ * @max 10.0
+ * @decimal 2
+ * @increment 0.05
+ * @group Mixer Output
+ */
+PARAM_DEFINE_FLOAT(HELI_GOV_I, 0.5f);
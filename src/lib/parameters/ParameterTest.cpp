@@ -77,6 +77,55 @@ TEST_F(ParameterTest, testParamReadWrite)
 	EXPECT_FLOAT_EQ(42.f, value2);
 }
 
+TEST_F(ParameterTest, testParamReset)
+{
+	// GIVEN a parameter set to a value
+	param_t param = param_handle(px4::params::CP_DIST);
+	float value = 42.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it is modified and not saved yet
+	EXPECT_FALSE(param_value_is_default(param));
+	EXPECT_TRUE(param_value_unsaved(param));
+
+	// WHEN: we set it to the default value
+	value = -1.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it is still modified (it will be saved)
+	EXPECT_FALSE(param_value_is_default(param));
+
+	// WHEN: we reset the parameter
+	EXPECT_EQ(0, param_reset(param));
+
+	// THEN: it should have the default value again
+	float value2 = -1999.f;
+	EXPECT_EQ(0, param_get(param, &value2));
+	EXPECT_FLOAT_EQ(-1.f, value2);
+	EXPECT_TRUE(param_value_is_default(param));
+	EXPECT_FALSE(param_value_unsaved(param));
+}
+
+TEST_F(ParameterTest, testParamChangedSince)
+{
+	// GIVEN a parameter read after the last notification
+	param_t param = param_handle(px4::params::CP_DIST);
+	float value = 42.f;
+	EXPECT_EQ(0, param_set(param, &value));
+	const uint32_t instance = param_update_instance();
+
+	// THEN: it is not reported as changed
+	EXPECT_FALSE(param_changed_since(param, instance));
+
+	// WHEN: we set the parameter
+	value = 43.f;
+	EXPECT_EQ(0, param_set(param, &value));
+
+	// THEN: it is reported as changed
+	EXPECT_TRUE(param_changed_since(param, instance));
+	EXPECT_GT(param_update_instance(), instance);
+}
+
 
 TEST_F(ParameterTest, testUorbSendReceive)
 {
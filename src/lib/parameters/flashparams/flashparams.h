@@ -49,18 +49,19 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <sys/types.h>
-#include "systemlib/uthash/utarray.h"
 
 __BEGIN_DECLS
 
 /*
  * When using the flash based parameter store we have to force
- * the param_values and 2 functions to be global
+ * the access to the parameter values to be global
  */
 
-__EXPORT extern UT_array        *param_values;
 __EXPORT int param_set_external(param_t param, const void *val, bool mark_saved, bool notify_changes);
 __EXPORT const void *param_get_value_ptr_external(param_t param);
+__EXPORT bool param_modified_external(param_t param);
+/* clears the unsaved flag of a parameter, returns the previous state */
+__EXPORT bool param_mark_saved_external(param_t param);
 
 /* The interface hooks to the Flash based storage. The caller is responsible for locking */
 __EXPORT int flash_param_save(bool only_unsaved);
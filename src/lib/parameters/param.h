@@ -276,6 +276,29 @@ __EXPORT int		param_set_no_notification(param_t param, const void *val);
  */
 __EXPORT void		param_notify_changes(void);
 
+/**
+ * Number of buckets used to track parameter changes (param_t % PARAM_CHANGE_BUCKETS),
+ * matches the size of the parameter_update changed bitmask.
+ */
+#define PARAM_CHANGE_BUCKETS 128
+
+/**
+ * Get the instance of the next parameter_update notification.
+ *
+ * @return		The instance to pass to param_changed_since() after reading parameters.
+ */
+__EXPORT uint32_t	param_update_instance(void);
+
+/**
+ * Check whether a parameter might have changed since a parameter_update instance.
+ * Changes are tracked per bucket, so this can also return true for an unchanged parameter.
+ *
+ * @param param		A handle returned by param_find or passed by param_foreach.
+ * @param instance	Value of param_update_instance() taken before the parameter was last read.
+ * @return		true if the parameter needs to be read again.
+ */
+__EXPORT bool		param_changed_since(param_t param, uint32_t instance);
+
 /**
  * Reset a parameter to its default value.
  *
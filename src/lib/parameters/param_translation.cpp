@@ -60,6 +60,23 @@ bool param_modify_on_import(bson_node_t node)
 		}
 	}
 
+	// migrate EKF2_GPS_MASK -> SENS_GPS_MASK, EKF2_GPS_TAU -> SENS_GPS_TAU (2020-06-01). This can be removed after the next release (current release=1.10)
+	if (node->type == BSON_INT32) {
+		if (strcmp("EKF2_GPS_MASK", node->name) == 0) {
+			strcpy(node->name, "SENS_GPS_MASK");
+			PX4_INFO("param migrating EKF2_GPS_MASK (removed) -> SENS_GPS_MASK: value=%d", (int)node->i);
+			return true;
+		}
+	}
+
+	if (node->type == BSON_DOUBLE) {
+		if (strcmp("EKF2_GPS_TAU", node->name) == 0) {
+			strcpy(node->name, "SENS_GPS_TAU");
+			PX4_INFO("param migrating EKF2_GPS_TAU (removed) -> SENS_GPS_TAU: value=%.3f", node->d);
+			return true;
+		}
+	}
+
 
 	// translate (SPI) calibration ID parameters. This can be removed after the next release (current release=1.10)
 
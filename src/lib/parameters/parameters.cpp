@@ -50,6 +50,7 @@
 #include <crc32.h>
 #include <float.h>
 #include <math.h>
+#include <sys/stat.h>
 
 #include <drivers/drv_hrt.h>
 #include <lib/perf/perf_counter.h>
@@ -58,7 +59,6 @@
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/sem.h>
 #include <px4_platform_common/shutdown.h>
-#include <systemlib/uthash/utarray.h>
 
 using namespace time_literals;
 
@@ -94,22 +94,22 @@ static struct work_s autosave_work {};
 static volatile bool autosave_scheduled = false;
 static bool autosave_disabled = false;
 
+/*
+ * Journaled saving to the parameter file: a save normally appends a record with only the unsaved
+ * parameters to the file, and the whole file is rewritten (compacted) only occasionally.
+ * A record is param_journal_marker followed by a BSON document, they are applied in order on load.
+ */
+static constexpr uint32_t param_journal_marker = 0x4c4e524a; ///< "JRNL"
+static constexpr int param_journal_max_records = 32; ///< number of appended records before the file is compacted
+static int param_journal_records = 0; ///< records appended since the file was last written completely
+static bool param_journal_compact = true; ///< the file does not match the saved parameters, the next save rewrites it
+
 /**
  * Array of static parameter info.
  */
 static const param_info_s *param_info_base = (const param_info_s *) &px4_parameters;
 #define	param_info_count px4_parameters.param_count
 
-/**
- * Storage for modified parameters.
- */
-struct param_wbuf_s {
-	union param_value_u	val;
-	param_t			param;
-	bool			unsaved;
-};
-
-
 uint8_t  *param_changed_storage = nullptr;
 int size_param_changed_storage_bytes = 0;
 const int bits_per_allocation_unit  = (sizeof(*param_changed_storage) * 8);
@@ -135,20 +135,32 @@ get_param_info_count()
 	return param_info_count;
 }
 
-/** flexible array holding modified parameter values */
-UT_array *param_values{nullptr};
+/**
+ * Current values of all parameters, indexed by param_t and initialized with the defaults.
+ * Struct parameters point to allocated storage once modified.
+ */
+static union param_value_u *param_values{nullptr};
+
+/** bits of the parameters with a value set (which can still be equal to the default) */
+static uint8_t *param_modified_bits{nullptr};
 
-/** array info for the modified parameters array */
-const UT_icd param_icd = {sizeof(param_wbuf_s), nullptr, nullptr, nullptr};
+/** bits of the modified parameters not saved yet */
+static uint8_t *param_unsaved_bits{nullptr};
 
 /** parameter update topic handle */
 static orb_advert_t param_topic = nullptr;
-static unsigned int param_instance = 0;
+static uint32_t param_instance = 0; ///< instance of the next parameter_update
+
+static uint32_t param_changed_mask[PARAM_CHANGE_BUCKETS / 32] {}; ///< buckets changed since the last parameter_update
+static uint32_t param_bucket_instance[PARAM_CHANGE_BUCKETS] {}; ///< parameter_update instance with the last change of each bucket
 
 static void param_set_used_internal(param_t param);
 
 static param_t param_find_internal(const char *name, bool notification);
 
+static int param_import_internal(int fd, bool mark_saved, int *journal_records);
+static int param_export_internal(int fd, bool only_unsaved, bool journal_record);
+
 // the following implements an RW-lock using 2 semaphores (used as mutexes). It gives
 // priority to readers, meaning a writer could suffer from starvation, but in our use-case
 // we only have short periods of reads and writes are rare.
@@ -158,6 +170,7 @@ static px4_sem_t reader_lock_holders_lock; ///< this protects against concurrent
 
 static perf_counter_t param_export_perf;
 static perf_counter_t param_find_perf;
+static perf_counter_t param_import_perf;
 static perf_counter_t param_get_perf;
 static perf_counter_t param_set_perf;
 
@@ -228,8 +241,30 @@ param_init()
 
 	param_export_perf = perf_alloc(PC_ELAPSED, "param_export");
 	param_find_perf = perf_alloc(PC_ELAPSED, "param_find");
+	param_import_perf = perf_alloc(PC_ELAPSED, "param_import");
 	param_get_perf = perf_alloc(PC_ELAPSED, "param_get");
 	param_set_perf = perf_alloc(PC_ELAPSED, "param_set");
+
+	/* one value slot per parameter, so that get and set are a direct index access */
+	const unsigned count = get_param_info_count();
+	param_values = (union param_value_u *)malloc(count * sizeof(union param_value_u));
+	param_modified_bits = (uint8_t *)calloc(size_param_changed_storage_bytes, 1);
+	param_unsaved_bits = (uint8_t *)calloc(size_param_changed_storage_bytes, 1);
+
+	if (param_values == nullptr || param_modified_bits == nullptr || param_unsaved_bits == nullptr) {
+		PX4_ERR("failed to allocate parameter storage");
+		free(param_values);
+		free(param_modified_bits);
+		free(param_unsaved_bits);
+		param_values = nullptr;
+		param_modified_bits = nullptr;
+		param_unsaved_bits = nullptr;
+		return;
+	}
+
+	for (param_t param = 0; param < count; param++) {
+		param_values[param] = param_info_base[param].val;
+	}
 }
 
 /**
@@ -245,49 +280,91 @@ handle_in_range(param_t param)
 	return (count && param < count);
 }
 
+static inline bool
+param_bit_get(const uint8_t *bits, param_t param)
+{
+	return bits[param / bits_per_allocation_unit] & (1 << param % bits_per_allocation_unit);
+}
+
+static inline void
+param_bit_set(uint8_t *bits, param_t param, bool value)
+{
+	if (value) {
+		bits[param / bits_per_allocation_unit] |= (1 << param % bits_per_allocation_unit);
+
+	} else {
+		bits[param / bits_per_allocation_unit] &= ~(1 << param % bits_per_allocation_unit);
+	}
+}
+
 /**
- * Compare two modifid parameter structures to determine ordering.
+ * Test whether a parameter has been modified (a value has been set).
  *
- * This function is suitable for passing to qsort or bsearch.
+ * @param param			The parameter, the handle must be in range.
+ * @return			True if the parameter has been modified.
  */
-static int
-param_compare_values(const void *a, const void *b)
+static bool
+param_modified(param_t param)
 {
-	struct param_wbuf_s *pa = (struct param_wbuf_s *)a;
-	struct param_wbuf_s *pb = (struct param_wbuf_s *)b;
+	param_assert_locked();
 
-	if (pa->param < pb->param) {
-		return -1;
-	}
+	return param_modified_bits != nullptr && param_bit_get(param_modified_bits, param);
+}
 
-	if (pa->param > pb->param) {
-		return 1;
-	}
+/*
+ * Int32 and float values are a single aligned 32 bit word in their slot, which always holds a
+ * complete value. Writers (holding the writer lock) publish a new value with one atomic store,
+ * so param_get() can load it without taking the reader lock and sees either the previous or
+ * the new value. Struct parameters are copied from allocated storage and still need the lock.
+ */
+static inline int32_t
+param_value_load(const union param_value_u *v)
+{
+	return __atomic_load_n(&v->i, __ATOMIC_ACQUIRE);
+}
 
-	return 0;
+static inline void
+param_value_store(union param_value_u *v, int32_t bits)
+{
+	__atomic_store_n(&v->i, bits, __ATOMIC_RELEASE);
 }
 
 /**
- * Locate the modified parameter structure for a parameter, if it exists.
- *
- * @param param			The parameter being searched.
- * @return			The structure holding the modified value, or
- *				nullptr if the parameter has not been modified.
+ * Track a parameter change for the next parameter_update notification.
  */
-static param_wbuf_s *
-param_find_changed(param_t param)
+static void
+param_mark_changed(param_t param)
 {
-	param_wbuf_s	*s = nullptr;
+	param_assert_locked();
 
+	const unsigned bucket = param % PARAM_CHANGE_BUCKETS;
+	param_changed_mask[bucket / 32] |= 1u << (bucket % 32);
+	__atomic_store_n(&param_bucket_instance[bucket], __atomic_load_n(&param_instance, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+/**
+ * Restore the default value of a modified parameter, freeing the storage of struct parameters.
+ */
+static void
+param_restore_default(param_t param)
+{
 	param_assert_locked();
 
-	if (param_values != nullptr) {
-		param_wbuf_s key{};
-		key.param = param;
-		s = (param_wbuf_s *)utarray_find(param_values, &key, param_compare_values);
+	if (param_info_base[param].type >= PARAM_TYPE_STRUCT && param_info_base[param].type <= PARAM_TYPE_STRUCT_MAX) {
+		free(param_values[param].p);
+		param_values[param] = param_info_base[param].val;
+
+	} else {
+		param_value_store(&param_values[param], param_info_base[param].val.i);
 	}
 
-	return s;
+	param_bit_set(param_modified_bits, param, false);
+	param_bit_set(param_unsaved_bits, param, false);
+
+	// a journal record can only set values, so the file needs to be rewritten
+	param_journal_compact = true;
+
+	param_mark_changed(param);
 }
 
 static void
@@ -295,7 +372,24 @@ _param_notify_changes()
 {
 	parameter_update_s pup = {};
 	pup.timestamp = hrt_absolute_time();
-	pup.instance = param_instance++;
+
+	param_lock_writer();
+	pup.instance = param_instance;
+	bool changes_tracked = false;
+
+	for (unsigned i = 0; i < PARAM_CHANGE_BUCKETS / 32; i++) {
+		pup.changed[i] = param_changed_mask[i];
+		param_changed_mask[i] = 0;
+		changes_tracked |= pup.changed[i] != 0;
+	}
+
+	__atomic_store_n(&param_instance, param_instance + 1, __ATOMIC_RELEASE);
+	param_unlock_writer();
+
+	if (!changes_tracked) {
+		// explicit notification, e.g. after external changes: assume everything changed
+		memset(pup.changed, 0xff, sizeof(pup.changed));
+	}
 
 	/*
 	 * If we don't have a handle to our topic, create one now; otherwise
@@ -315,39 +409,54 @@ param_notify_changes()
 	_param_notify_changes();
 }
 
-param_t
-param_find_internal(const char *name, bool notification)
+uint32_t
+param_update_instance()
 {
-	perf_begin(param_find_perf);
+	return __atomic_load_n(&param_instance, __ATOMIC_ACQUIRE);
+}
 
-	param_t middle;
-	param_t front = 0;
-	param_t last = get_param_info_count();
+bool
+param_changed_since(param_t param, uint32_t instance)
+{
+	if (!handle_in_range(param)) {
+		return false;
+	}
 
-	/* perform a binary search of the known parameters */
+	return __atomic_load_n(&param_bucket_instance[param % PARAM_CHANGE_BUCKETS], __ATOMIC_ACQUIRE) >= instance;
+}
 
-	while (front <= last) {
-		middle = front + (last - front) / 2;
-		int ret = strcmp(name, param_info_base[middle].name);
+/**
+ * 32 bit FNV-1a hash of a parameter name, must match param_name_hash() in px_generate_params.py
+ */
+static inline uint32_t
+param_name_hash(const char *name, uint32_t seed)
+{
+	uint32_t hash = 2166136261u ^ seed;
 
-		if (ret == 0) {
-			if (notification) {
-				param_set_used_internal(middle);
-			}
+	while (*name != '\0') {
+		hash ^= (uint8_t) * name++;
+		hash *= 16777619u;
+	}
 
-			perf_end(param_find_perf);
-			return middle;
+	return hash;
+}
 
-		} else if (middle == front) {
-			/* An end point has been hit, but there has been no match */
-			break;
+param_t
+param_find_internal(const char *name, bool notification)
+{
+	perf_begin(param_find_perf);
 
-		} else if (ret < 0) {
-			last = middle;
+	/* look up the only candidate in the generated perfect hash table */
+	const uint16_t seed = px4_parameters_hash_seeds[param_name_hash(name, 0) % PX4_PARAMETERS_HASH_SEEDS_COUNT];
+	const param_t param = px4_parameters_hash_slots[param_name_hash(name, seed) % PX4_PARAMETERS_HASH_SLOTS_COUNT];
 
-		} else {
-			front = middle;
+	if (param < get_param_info_count() && strcmp(name, param_info_base[param].name) == 0) {
+		if (notification) {
+			param_set_used_internal(param);
 		}
+
+		perf_end(param_find_perf);
+		return param;
 	}
 
 	perf_end(param_find_perf);
@@ -487,20 +596,17 @@ param_is_volatile(param_t param)
 bool
 param_value_is_default(param_t param)
 {
-	struct param_wbuf_s *s;
 	param_lock_reader();
-	s = param_find_changed(param);
+	bool ret = !handle_in_range(param) || !param_modified(param);
 	param_unlock_reader();
-	return s == nullptr;
+	return ret;
 }
 
 bool
 param_value_unsaved(param_t param)
 {
-	struct param_wbuf_s *s;
 	param_lock_reader();
-	s = param_find_changed(param);
-	bool ret = s && s->unsaved;
+	bool ret = handle_in_range(param) && param_modified(param) && param_bit_get(param_unsaved_bits, param);
 	param_unlock_reader();
 	return ret;
 }
@@ -550,17 +656,8 @@ param_get_value_ptr(param_t param)
 
 	if (handle_in_range(param)) {
 
-		const union param_value_u *v;
-
-		/* work out whether we're fetching the default or a written value */
-		struct param_wbuf_s *s = param_find_changed(param);
-
-		if (s != nullptr) {
-			v = &s->val;
-
-		} else {
-			v = &param_info_base[param].val;
-		}
+		/* the value table holds the default until a value is written */
+		const union param_value_u *v = param_values ? &param_values[param] : &param_info_base[param].val;
 
 		if (param_type(param) >= PARAM_TYPE_STRUCT &&
 		    param_type(param) <= PARAM_TYPE_STRUCT_MAX) {
@@ -580,18 +677,34 @@ param_get(param_t param, void *val)
 {
 	int result = -1;
 
-	param_lock_reader();
+	if (val == nullptr || !handle_in_range(param)) {
+		return result;
+	}
+
 	perf_begin(param_get_perf);
 
-	const void *v = param_get_value_ptr(param);
+	const param_type_t type = param_type(param);
 
-	if (val && v) {
-		memcpy(val, v, param_size(param));
+	if ((type == PARAM_TYPE_INT32 || type == PARAM_TYPE_FLOAT) && param_values != nullptr) {
+		// lock-free read of the current value
+		const int32_t bits = param_value_load(&param_values[param]);
+		memcpy(val, &bits, sizeof(bits));
 		result = 0;
+
+	} else {
+		param_lock_reader();
+
+		const void *v = param_get_value_ptr(param);
+
+		if (v) {
+			memcpy(val, v, param_size(param));
+			result = 0;
+		}
+
+		param_unlock_reader();
 	}
 
 	perf_end(param_get_perf);
-	param_unlock_reader();
 
 	return result;
 }
@@ -688,65 +801,46 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 	perf_begin(param_set_perf);
 
 	if (param_values == nullptr) {
-		utarray_new(param_values, &param_icd);
-	}
-
-	if (param_values == nullptr) {
-		PX4_ERR("failed to allocate modified values array");
+		PX4_ERR("no parameter storage");
 		goto out;
 	}
 
 	if (handle_in_range(param)) {
 
-		param_wbuf_s *s = param_find_changed(param);
-
-		if (s == nullptr) {
-
-			/* construct a new parameter */
-			param_wbuf_s buf = {};
-			buf.param = param;
-
-			params_changed = true;
-
-			/* add it to the array and sort */
-			utarray_push_back(param_values, &buf);
-			utarray_sort(param_values, param_compare_values);
-
-			/* find it after sorting */
-			s = param_find_changed(param);
-		}
+		const bool modified = param_modified(param);
+		union param_value_u *v = &param_values[param];
 
-		/* update the changed value */
+		/* update the value in place */
 		switch (param_type(param)) {
 
 		case PARAM_TYPE_INT32:
-			params_changed = params_changed || s->val.i != *(int32_t *)val;
-			s->val.i = *(int32_t *)val;
+			params_changed = !modified || v->i != *(int32_t *)val;
+			param_value_store(v, *(int32_t *)val);
 			break;
 
-		case PARAM_TYPE_FLOAT:
-			params_changed = params_changed || fabsf(s->val.f - * (float *)val) > FLT_EPSILON;
-			s->val.f = *(float *)val;
+		case PARAM_TYPE_FLOAT: {
+				params_changed = !modified || fabsf(v->f - * (float *)val) > FLT_EPSILON;
+				int32_t bits;
+				memcpy(&bits, val, sizeof(bits));
+				param_value_store(v, bits);
+			}
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX:
-			if (s->val.p == nullptr) {
+			if (!modified) {
+				/* the default points to the static data, allocate the storage on the first write */
 				size_t psize = param_size(param);
+				void *p = psize > 0 ? malloc(psize) : nullptr;
 
-				if (psize > 0) {
-					s->val.p = malloc(psize);
-
-				} else {
-					s->val.p = nullptr;
-				}
-
-				if (s->val.p == nullptr) {
+				if (p == nullptr) {
 					PX4_ERR("failed to allocate parameter storage");
 					goto out;
 				}
+
+				v->p = p;
 			}
 
-			memcpy(s->val.p, val, param_size(param));
+			memcpy(v->p, val, param_size(param));
 			params_changed = true;
 			break;
 
@@ -754,9 +848,14 @@ param_set_internal(param_t param, const void *val, bool mark_saved, bool notify_
 			goto out;
 		}
 
-		s->unsaved = !mark_saved;
+		param_bit_set(param_modified_bits, param, true);
+		param_bit_set(param_unsaved_bits, param, !mark_saved);
 		result = 0;
 
+		if (params_changed) {
+			param_mark_changed(param);
+		}
+
 		if (!mark_saved) { // this is false when importing parameters
 			param_autosave();
 		}
@@ -787,6 +886,18 @@ const void *param_get_value_ptr_external(param_t param)
 {
 	return param_get_value_ptr(param);
 }
+
+bool param_modified_external(param_t param)
+{
+	return handle_in_range(param) && param_modified(param);
+}
+
+bool param_mark_saved_external(param_t param)
+{
+	const bool unsaved = param_bit_get(param_unsaved_bits, param);
+	param_bit_set(param_unsaved_bits, param, false);
+	return unsaved;
+}
 #endif
 
 int
@@ -835,20 +946,18 @@ void param_set_used_internal(param_t param)
 int
 param_reset(param_t param)
 {
-	param_wbuf_s *s = nullptr;
+	bool param_modified_before = false;
 	bool param_found = false;
 
 	param_lock_writer();
 
 	if (handle_in_range(param)) {
 
-		/* look for a saved value */
-		s = param_find_changed(param);
+		/* if it has a value set, go back to the default */
+		param_modified_before = param_modified(param);
 
-		/* if we found one, erase it */
-		if (s != nullptr) {
-			int pos = utarray_eltidx(param_values, s);
-			utarray_erase(param_values, pos, 1);
+		if (param_modified_before) {
+			param_restore_default(param);
 		}
 
 		param_found = true;
@@ -858,7 +967,7 @@ param_reset(param_t param)
 
 	param_unlock_writer();
 
-	if (s != nullptr) {
+	if (param_modified_before) {
 		_param_notify_changes();
 	}
 
@@ -870,12 +979,13 @@ param_reset_all_internal(bool auto_save)
 	param_lock_writer();
 
 	if (param_values != nullptr) {
-		utarray_free(param_values);
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (param_modified(param)) {
+				param_restore_default(param);
+			}
+		}
 	}
 
-	/* mark as reset / deleted */
-	param_values = nullptr;
-
 	if (auto_save) {
 		param_autosave();
 	}
@@ -949,37 +1059,63 @@ param_get_default_file()
 	return (param_user_file != nullptr) ? param_user_file : param_default_file;
 }
 
-int param_save_default()
+/**
+ * Append a journal record with the unsaved parameters to the parameter file.
+ */
+static int
+param_journal_append(const char *filename)
 {
-	int res = PX4_ERROR;
+	bool unsaved = false;
 
-	const char *filename = param_get_default_file();
+	param_lock_reader();
 
-	if (!filename) {
-		perf_begin(param_export_perf);
-		param_lock_writer();
-		res = flash_param_save(false);
-		param_unlock_writer();
-		perf_end(param_export_perf);
-		return res;
+	for (param_t param = 0; handle_in_range(param) && !unsaved; param++) {
+		unsaved = param_modified(param) && param_bit_get(param_unsaved_bits, param);
 	}
 
-	int shutdown_lock_ret = px4_shutdown_lock();
+	param_unlock_reader();
 
-	if (shutdown_lock_ret) {
-		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
+	if (!unsaved) {
+		return PX4_OK;
 	}
 
-	/* write parameters to temp file */
-	int fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT, PX4_O_MODE_666);
+	int fd = PARAM_OPEN(filename, O_WRONLY | O_APPEND);
 
 	if (fd < 0) {
-		PX4_ERR("failed to open param file: %s", filename);
+		return PX4_ERROR;
+	}
 
-		if (shutdown_lock_ret == 0) {
-			px4_shutdown_unlock();
-		}
+	int res = param_export_internal(fd, true, true);
+
+	PARAM_CLOSE(fd);
+
+	param_lock_writer();
+
+	if (res == PX4_OK) {
+		param_journal_records++;
+
+	} else {
+		// the record might be incomplete
+		param_journal_compact = true;
+	}
+
+	param_unlock_writer();
+
+	return res;
+}
+
+/**
+ * Rewrite the parameter file with all modified parameters, dropping the journal.
+ */
+static int
+param_journal_compact_file(const char *filename)
+{
+	int res = PX4_ERROR;
 
+	int fd = PARAM_OPEN(filename, O_WRONLY | O_CREAT | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("failed to open param file: %s", filename);
 		return PX4_ERROR;
 	}
 
@@ -1001,6 +1137,53 @@ int param_save_default()
 
 	PARAM_CLOSE(fd);
 
+	if (res == OK) {
+		param_lock_writer();
+		param_journal_records = 0;
+		param_journal_compact = false;
+		param_unlock_writer();
+	}
+
+	return res;
+}
+
+int param_save_default()
+{
+	int res = PX4_ERROR;
+
+	const char *filename = param_get_default_file();
+
+	if (!filename) {
+		perf_begin(param_export_perf);
+		param_lock_writer();
+		res = flash_param_save(false);
+		param_unlock_writer();
+		perf_end(param_export_perf);
+		return res;
+	}
+
+	int shutdown_lock_ret = px4_shutdown_lock();
+
+	if (shutdown_lock_ret) {
+		PX4_ERR("px4_shutdown_lock() failed (%i)", shutdown_lock_ret);
+	}
+
+	param_lock_reader();
+	const bool compact = param_journal_compact || param_journal_records >= param_journal_max_records;
+	param_unlock_reader();
+
+	if (!compact) {
+		res = param_journal_append(filename);
+
+		if (res != PX4_OK) {
+			PX4_WARN("param journal append failed, rewriting %s", filename);
+		}
+	}
+
+	if (res != PX4_OK) {
+		res = param_journal_compact_file(filename);
+	}
+
 	if (shutdown_lock_ret == 0) {
 		px4_shutdown_unlock();
 	}
@@ -1033,7 +1216,9 @@ param_load_default()
 		return 1;
 	}
 
-	int result = param_load(fd_load);
+	int journal_records = 0;
+	param_reset_all_internal(false);
+	int result = param_import_internal(fd_load, true, &journal_records);
 	PARAM_CLOSE(fd_load);
 
 	if (result != 0) {
@@ -1041,11 +1226,28 @@ param_load_default()
 		return -2;
 	}
 
+	// the loaded values are in the file now, unless the journal is damaged
+	param_lock_writer();
+	param_journal_records = journal_records;
+	param_journal_compact = (journal_records < 0);
+	param_unlock_writer();
+
 	return res;
 }
 
 int
 param_export(int fd, bool only_unsaved)
+{
+	return param_export_internal(fd, only_unsaved, false);
+}
+
+/**
+ * Export the parameters to a file.
+ * @param journal_record prefix the document with the journal marker, written under the same lock so concurrent
+ *                       saves cannot interleave their records
+ */
+static int
+param_export_internal(int fd, bool only_unsaved, bool journal_record)
 {
 	int	result = -1;
 	perf_begin(param_export_perf);
@@ -1059,7 +1261,6 @@ param_export(int fd, bool only_unsaved)
 		return result;
 	}
 
-	param_wbuf_s *s = nullptr;
 	struct bson_encoder_s encoder;
 
 	int shutdown_lock_ret = px4_shutdown_lock();
@@ -1071,37 +1272,48 @@ param_export(int fd, bool only_unsaved)
 	// take the file lock
 	do {} while (px4_sem_wait(&param_sem_save) != 0);
 
+	if (!only_unsaved) {
+		// the unsaved parameters get written to this file only, so they
+		// can't be appended to the journal of the default file anymore
+		param_journal_compact = true;
+	}
+
 	param_lock_reader();
 
+	if (journal_record && write(fd, &param_journal_marker, sizeof(param_journal_marker)) != sizeof(param_journal_marker)) {
+		PX4_ERR("param journal marker write failed");
+		goto out;
+	}
+
 	uint8_t bson_buffer[256];
 	bson_encoder_init_buf_file(&encoder, fd, &bson_buffer, sizeof(bson_buffer));
 
-	/* no modified parameters -> we are done */
-	if (param_values == nullptr) {
-		result = 0;
-		goto out;
-	}
+	for (param_t param = 0; handle_in_range(param); param++) {
+		/* only modified parameters are stored */
+		if (!param_modified(param)) {
+			continue;
+		}
 
-	while ((s = (struct param_wbuf_s *)utarray_next(param_values, s)) != nullptr) {
 		/*
 		 * If we are only saving values changed since last save, and this
 		 * one hasn't, then skip it
 		 */
-		if (only_unsaved && !s->unsaved) {
+		if (only_unsaved && !param_bit_get(param_unsaved_bits, param)) {
 			continue;
 		}
 
-		s->unsaved = false;
+		param_bit_set(param_unsaved_bits, param, false);
 
-		const char *name = param_name(s->param);
-		const size_t size = param_size(s->param);
+		const union param_value_u *v = &param_values[param];
+		const char *name = param_name(param);
+		const size_t size = param_size(param);
 
 		/* append the appropriate BSON type object */
-		switch (param_type(s->param)) {
+		switch (param_type(param)) {
 
 		case PARAM_TYPE_INT32: {
-				const int32_t i = s->val.i;
-				PX4_DEBUG("exporting: %s (%d) size: %lu val: %d", name, s->param, (long unsigned int)size, i);
+				const int32_t i = v->i;
+				PX4_DEBUG("exporting: %s (%d) size: %lu val: %d", name, param, (long unsigned int)size, i);
 
 				if (bson_encoder_append_int(&encoder, name, i)) {
 					PX4_ERR("BSON append failed for '%s'", name);
@@ -1111,8 +1323,8 @@ param_export(int fd, bool only_unsaved)
 			break;
 
 		case PARAM_TYPE_FLOAT: {
-				const double f = (double)s->val.f;
-				PX4_DEBUG("exporting: %s (%d) size: %lu val: %.3f", name, s->param, (long unsigned int)size, (double)f);
+				const double f = (double)v->f;
+				PX4_DEBUG("exporting: %s (%d) size: %lu val: %.3f", name, param, (long unsigned int)size, (double)f);
 
 				if (bson_encoder_append_double(&encoder, name, f)) {
 					PX4_ERR("BSON append failed for '%s'", name);
@@ -1122,7 +1334,7 @@ param_export(int fd, bool only_unsaved)
 			break;
 
 		case PARAM_TYPE_STRUCT ... PARAM_TYPE_STRUCT_MAX: {
-				const void *value_ptr = param_get_value_ptr(s->param);
+				const void *value_ptr = param_get_value_ptr(param);
 
 				/* lock as short as possible */
 				if (bson_encoder_append_binary(&encoder,
@@ -1299,24 +1511,162 @@ out:
 	return result;
 }
 
+/**
+ * Decode all nodes of a BSON document.
+ * @return 0 when the document is complete, -1 on error
+ */
 static int
-param_import_internal(int fd, bool mark_saved)
+param_import_document(bson_decoder_t decoder)
+{
+	int result;
+
+	do {
+		result = bson_decoder_next(decoder);
+
+	} while (result > 0);
+
+	return result;
+}
+
+/**
+ * Import the parameters from a buffer holding the file content, including the journal records following the first document.
+ * @param journal_records set to the number of journal records, or -1 if a record is damaged
+ */
+static int
+param_import_buffer(uint8_t *buf, size_t size, param_import_state *state, int *journal_records)
+{
+	bson_decoder_s decoder;
+
+	if (bson_decoder_init_buf(&decoder, buf, size, param_import_callback, state)) {
+		PX4_ERR("decoder init failed");
+		return PX4_ERROR;
+	}
+
+	if (param_import_document(&decoder) != 0) {
+		return PX4_ERROR;
+	}
+
+	size_t offset = decoder.bufpos;
+	uint32_t marker = 0;
+
+	while (size - offset >= sizeof(marker)) {
+		memcpy(&marker, buf + offset, sizeof(marker));
+
+		if (marker != param_journal_marker) {
+			break;
+		}
+
+		offset += sizeof(marker);
+
+		if (bson_decoder_init_buf(&decoder, buf + offset, size - offset, param_import_callback, state)
+		    || param_import_document(&decoder) != 0) {
+			// an interrupted append, the values up to here are applied
+			PX4_WARN("param journal record %i damaged", *journal_records);
+			*journal_records = -1;
+			break;
+		}
+
+		offset += decoder.bufpos;
+		(*journal_records)++;
+	}
+
+	if (offset != size && *journal_records >= 0) {
+		// a partial marker or garbage, appending after it would never be read back
+		PX4_WARN("param journal: unexpected data after record %i", *journal_records);
+		*journal_records = -1;
+	}
+
+	return 0;
+}
+
+/**
+ * Import the parameters from a file, decoding directly from the file descriptor.
+ * @param journal_records set to the number of journal records, or -1 if a record is damaged
+ */
+static int
+param_import_file(int fd, param_import_state *state, int *journal_records)
 {
 	bson_decoder_s decoder;
-	param_import_state state;
-	int result = -1;
 
-	if (bson_decoder_init_file(&decoder, fd, param_import_callback, &state)) {
+	if (bson_decoder_init_file(&decoder, fd, param_import_callback, state)) {
 		PX4_ERR("decoder init failed");
 		return PX4_ERROR;
 	}
 
+	if (param_import_document(&decoder) != 0) {
+		return PX4_ERROR;
+	}
+
+	uint32_t marker = 0;
+	ssize_t nread;
+
+	while ((nread = read(fd, &marker, sizeof(marker))) != 0) {
+		if (nread != sizeof(marker) || marker != param_journal_marker) {
+			// a partial marker or garbage, appending after it would never be read back
+			PX4_WARN("param journal: unexpected data after record %i", *journal_records);
+			*journal_records = -1;
+			break;
+		}
+
+		if (bson_decoder_init_file(&decoder, fd, param_import_callback, state)
+		    || param_import_document(&decoder) != 0) {
+			// an interrupted append, the values up to here are applied
+			PX4_WARN("param journal record %i damaged", *journal_records);
+			*journal_records = -1;
+			break;
+		}
+
+		(*journal_records)++;
+	}
+
+	return 0;
+}
+
+/**
+ * Import the parameters of a file, including the journal records following the first document.
+ * @param journal_records if not nullptr, set to the number of journal records, or -1 if a record is damaged
+ */
+static int
+param_import_internal(int fd, bool mark_saved, int *journal_records)
+{
+	perf_begin(param_import_perf);
+
+	param_import_state state;
 	state.mark_saved = mark_saved;
 
-	do {
-		result = bson_decoder_next(&decoder);
+	int records = 0;
+	int result = PX4_ERROR;
 
-	} while (result > 0);
+	// read the rest of the file at once and parse it in memory, the file decoder needs read() calls for every field
+	struct stat st;
+	const off_t start = lseek(fd, 0, SEEK_CUR);
+	uint8_t *buf = nullptr;
+	size_t size = 0;
+
+	if (start >= 0 && fstat(fd, &st) == 0 && st.st_size > start) {
+		size = st.st_size - start;
+		buf = (uint8_t *)malloc(size);
+	}
+
+	if (buf != nullptr && read(fd, buf, size) == (ssize_t)size) {
+		result = param_import_buffer(buf, size, &state, &records);
+
+	} else {
+		// not enough memory or the size is unknown
+		if (buf != nullptr) {
+			lseek(fd, start, SEEK_SET);
+		}
+
+		result = param_import_file(fd, &state, &records);
+	}
+
+	free(buf);
+
+	if (journal_records != nullptr) {
+		*journal_records = records;
+	}
+
+	perf_end(param_import_perf);
 
 	return result;
 }
@@ -1328,7 +1678,7 @@ param_import(int fd)
 		return flash_param_import();
 	}
 
-	return param_import_internal(fd, false);
+	return param_import_internal(fd, false, nullptr);
 }
 
 int
@@ -1339,7 +1689,7 @@ param_load(int fd)
 	}
 
 	param_reset_all_internal(false);
-	return param_import_internal(fd, true);
+	return param_import_internal(fd, true, nullptr);
 }
 
 void
@@ -1350,7 +1700,7 @@ param_foreach(void (*func)(void *arg, param_t param), void *arg, bool only_chang
 	for (param = 0; handle_in_range(param); param++) {
 
 		/* if requested, skip unchanged values */
-		if (only_changed && (param_find_changed(param) == nullptr)) {
+		if (only_changed && !param_modified(param)) {
 			continue;
 		}
 
@@ -1399,8 +1749,16 @@ void param_print_status()
 #endif /* FLASH_BASED_PARAMS */
 
 	if (param_values != nullptr) {
-		PX4_INFO("storage array: %d/%d elements (%zu bytes total)",
-			 utarray_len(param_values), param_values->n, param_values->n * sizeof(UT_icd));
+		unsigned modified = 0;
+
+		for (param_t param = 0; handle_in_range(param); param++) {
+			if (param_bit_get(param_modified_bits, param)) {
+				modified++;
+			}
+		}
+
+		PX4_INFO("storage: %u modified, %zu bytes total", modified,
+			 param_count() * sizeof(union param_value_u) + 2 * size_param_changed_storage_bytes);
 	}
 
 	PX4_INFO("auto save: %s", autosave_disabled ? "off" : "on");
@@ -1411,6 +1769,7 @@ void param_print_status()
 
 	perf_print_counter(param_export_perf);
 	perf_print_counter(param_find_perf);
+	perf_print_counter(param_import_perf);
 	perf_print_counter(param_get_perf);
 	perf_print_counter(param_set_perf);
 }
@@ -324,6 +324,12 @@ _param_notify_changes()
 	pup.timestamp = hrt_absolute_time();
 	pup.instance = param_instance++;
 
+	// changes are not tracked per parameter
+	memset(pup.changed, 0xff, sizeof(pup.changed));
+
+	// send the batched updates to the other processor
+	flush_updates_to_shmem();
+
 	/*
 	 * If we don't have a handle to our topic, create one now; otherwise
 	 * just publish.
@@ -342,6 +348,18 @@ param_notify_changes()
 	_param_notify_changes();
 }
 
+uint32_t
+param_update_instance()
+{
+	return param_instance;
+}
+
+bool
+param_changed_since(param_t param, uint32_t instance)
+{
+	return handle_in_range(param);
+}
+
 param_t
 param_find_internal(const char *name, bool notification)
 {
@@ -1394,6 +1412,8 @@ param_import_internal(int fd, bool mark_saved)
 
 	} while (result > 0);
 
+	flush_updates_to_shmem();
+
 	return result;
 }
 
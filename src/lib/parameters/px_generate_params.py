@@ -20,6 +20,51 @@ except ImportError as e:
 
 import os
 
+def param_name_hash(name, seed):
+    """
+    32 bit FNV-1a hash of a parameter name, must match param_name_hash() in parameters.cpp.
+    """
+    h = (2166136261 ^ seed) & 0xffffffff
+    for c in name.encode('ascii'):
+        h ^= c
+        h = (h * 16777619) & 0xffffffff
+    return h
+
+def perfect_hash(names):
+    """
+    Build a minimal perfect hash (hash and displace) for the sorted parameter names.
+
+    A name is first hashed with seed 0 to select a bucket, then with the seed
+    stored for that bucket to select its slot. The slot holds the parameter index.
+
+    @return (seeds, slots)
+    """
+    num_slots = max(1, len(names))
+    buckets = [[] for _ in range(max(1, (len(names) + 3) // 4))]
+    for index, name in enumerate(names):
+        buckets[param_name_hash(name, 0) % len(buckets)].append(index)
+
+    seeds = [0] * len(buckets)
+    slots = [None] * num_slots
+
+    # place the largest buckets first while most slots are still free
+    for bucket in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+        if not buckets[bucket]:
+            continue
+        seed = 1
+        while True:
+            positions = [param_name_hash(names[i], seed) % num_slots for i in buckets[bucket]]
+            if len(set(positions)) == len(positions) and all(slots[p] is None for p in positions):
+                break
+            seed += 1
+            if seed > 0xffff:
+                raise RuntimeError("failed to generate parameter hash table")
+        seeds[bucket] = seed
+        for index, position in zip(buckets[bucket], positions):
+            slots[position] = index
+
+    return seeds, [0 if s is None else s for s in slots]
+
 def generate(xml_file, dest='.'):
     """
     Generate px4 param source from xml.
@@ -40,6 +85,8 @@ def generate(xml_file, dest='.'):
 
     params = sorted(params, key=lambda name: name.attrib["name"])
 
+    hash_seeds, hash_slots = perfect_hash([param.attrib["name"] for param in params])
+
     script_path = os.path.dirname(os.path.realpath(__file__))
 
     # for jinja docs see: http://jinja.pocoo.org/docs/2.9/api/
@@ -58,7 +105,8 @@ def generate(xml_file, dest='.'):
         template = env.get_template(template_file)
         with open(os.path.join(
                 dest, template_file.replace('.jinja','')), 'w') as fid:
-            fid.write(template.render(params=params))
+            fid.write(template.render(params=params,
+                hash_seeds=hash_seeds, hash_slots=hash_slots))
 
 if __name__ == "__main__":
     arg_parser = argparse.ArgumentParser()
@@ -44,7 +44,11 @@
 #include <drivers/drv_hrt.h>
 #include <math.h>
 #include <pthread.h>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/time.h>
 #include <systemlib/err.h>
+#include <time.h>
 
 #include "perf_counter.h"
 
@@ -96,6 +100,137 @@ struct perf_ctr_interval : public perf_ctr_header {
 	float			M2{0.0f};
 };
 
+/**
+ * Time source for PC_ELAPSED_CYCLES: the DWT cycle counter on STM32 (ARMv7-M), the raw monotonic
+ * clock in ns on POSIX. Both are cheaper and more precise than hrt_absolute_time(), which masks
+ * interrupts to read the timer and has 1us resolution. Other platforms fall back to the hrt.
+ */
+#if defined(__PX4_NUTTX) && (defined(CONFIG_ARCH_CORTEXM4) || defined(CONFIG_ARCH_CORTEXM7)) && defined(STM32_SYSCLK_FREQUENCY)
+
+typedef uint32_t perf_cycles_t; // wraps after 2^32 cycles (~20s at 216MHz)
+
+#define PERF_DWT_CTRL		(*(volatile uint32_t *)0xE0001000)
+#define PERF_DWT_CYCCNT		(*(volatile uint32_t *)0xE0001004)
+#define PERF_DWT_LAR		(*(volatile uint32_t *)0xE0001FB0)
+#define PERF_DEMCR		(*(volatile uint32_t *)0xE000EDFC)
+
+static void perf_cycles_init()
+{
+	PERF_DEMCR |= (1 << 24);	// DEMCR_TRCENA
+	PERF_DWT_LAR = 0xC5ACCE55;	// unlock the DWT registers (Cortex-M7)
+	PERF_DWT_CTRL |= 1;		// DWT_CTRL_CYCCNTENA
+}
+
+static inline perf_cycles_t perf_cycles_now()
+{
+	return PERF_DWT_CYCCNT;
+}
+
+static constexpr double PERF_CYCLES_PER_US = STM32_SYSCLK_FREQUENCY / 1e6;
+
+#elif defined(__PX4_POSIX) && defined(CLOCK_MONOTONIC_RAW)
+
+typedef uint64_t perf_cycles_t;
+
+static void perf_cycles_init() {}
+
+static inline perf_cycles_t perf_cycles_now()
+{
+	// not px4_clock_gettime(), this measures real time also with lockstep
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static constexpr double PERF_CYCLES_PER_US = 1e3;
+
+#else
+
+typedef uint64_t perf_cycles_t;
+
+static void perf_cycles_init() {}
+
+static inline perf_cycles_t perf_cycles_now()
+{
+	return hrt_absolute_time();
+}
+
+static constexpr double PERF_CYCLES_PER_US = 1.;
+
+#endif
+
+/**
+ * PC_ELAPSED_CYCLES counter.
+ */
+struct perf_ctr_elapsed_cycles : public perf_ctr_header {
+	uint64_t		event_count{0};
+	uint64_t		cycles_total{0};
+	perf_cycles_t		cycles_start{0};
+	perf_cycles_t		cycles_least{0};
+	perf_cycles_t		cycles_most{0};
+	bool			started{false};
+};
+
+/**
+ * PC_HISTOGRAM counter.
+ *
+ * The histogram buckets are logarithmic with 4 sub-buckets per power of 2: values below 4us
+ * have their own bucket, above that the bucket width is 1/4 of the power of 2 below the value.
+ * This keeps the relative error below 25% while covering up to ~1s with 80 buckets.
+ * The event count, min/max and buckets are updated atomically, so the counter can be read
+ * while it is updated and the distribution stays consistent even if events are ended
+ * concurrently from several threads (only the total time used for the average is not atomic).
+ */
+static constexpr int PERF_HISTOGRAM_BUCKETS = 80;
+
+struct perf_ctr_histogram : public perf_ctr_header {
+	uint64_t		time_start{0};
+	px4::atomic<uint32_t>	event_count{0};
+	px4::atomic<uint32_t>	time_least{0};
+	px4::atomic<uint32_t>	time_most{0};
+	px4::atomic<uint32_t>	buckets[PERF_HISTOGRAM_BUCKETS] {};
+	uint64_t		time_total{0};
+};
+
+static int histogram_bucket(uint32_t elapsed)
+{
+	if (elapsed < 4) {
+		return elapsed;
+	}
+
+	const int msb = 31 - __builtin_clz(elapsed);
+	const int bucket = (msb - 1) * 4 + ((elapsed >> (msb - 2)) & 3);
+	return bucket < PERF_HISTOGRAM_BUCKETS ? bucket : PERF_HISTOGRAM_BUCKETS - 1;
+}
+
+/** smallest value that falls into a bucket */
+static uint32_t histogram_bucket_lower(int bucket)
+{
+	if (bucket < 4) {
+		return bucket;
+	}
+
+	const int msb = bucket / 4 + 1;
+	return (uint32_t)(4 + bucket % 4) << (msb - 2);
+}
+
+static void histogram_add(struct perf_ctr_histogram *pch, uint32_t elapsed)
+{
+	pch->buckets[histogram_bucket(elapsed)].fetch_add(1);
+	pch->time_total += elapsed;
+
+	uint32_t least = pch->time_least.load();
+
+	while ((least > elapsed || least == 0) && !pch->time_least.compare_exchange(&least, elapsed)) {}
+
+	uint32_t most = pch->time_most.load();
+
+	while (most < elapsed && !pch->time_most.compare_exchange(&most, elapsed)) {}
+
+	// count last, so that readers never see more events than bucket entries
+	pch->event_count.fetch_add(1);
+}
+
 /**
  * List of all known counters.
  */
@@ -105,6 +240,12 @@ static sq_queue_t	perf_counters = { nullptr, nullptr };
  * mutex protecting access to the perf_counters linked list (which is read from & written to by different threads)
  */
 pthread_mutex_t perf_counters_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * number of threads iterating the perf_counters list without holding the mutex. Counters are
+ * only unlinked while this is non-zero, deleting them waits until all iterations finished.
+ */
+static px4::atomic<int> perf_counters_readers{0};
 // FIXME: the mutex does **not** protect against access to/from the perf
 // counter's data. It can still happen that a counter is updated while it is
 // printed. This can lead to inconsistent output, or completely bogus values
@@ -131,6 +272,15 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr = new perf_ctr_interval();
 		break;
 
+	case PC_HISTOGRAM:
+		ctr = new perf_ctr_histogram();
+		break;
+
+	case PC_ELAPSED_CYCLES:
+		perf_cycles_init();
+		ctr = new perf_ctr_elapsed_cycles();
+		break;
+
 	default:
 		break;
 	}
@@ -139,7 +289,15 @@ perf_alloc(enum perf_counter_type type, const char *name)
 		ctr->type = type;
 		ctr->name = name;
 		pthread_mutex_lock(&perf_counters_mutex);
-		sq_addfirst(&ctr->link, &perf_counters);
+
+		// publish the fully linked counter with a single store for lock-free readers
+		ctr->link.flink = perf_counters.head;
+
+		if (perf_counters.head == nullptr) {
+			perf_counters.tail = &ctr->link;
+		}
+
+		__atomic_store_n(&perf_counters.head, &ctr->link, __ATOMIC_RELEASE);
 		pthread_mutex_unlock(&perf_counters_mutex);
 	}
 
@@ -183,9 +341,37 @@ perf_free(perf_counter_t handle)
 	}
 
 	pthread_mutex_lock(&perf_counters_mutex);
-	sq_rem(&handle->link, &perf_counters);
+
+	// unlink with single stores and keep the link of the removed counter, so that a concurrent
+	// perf_iterate_all() on it continues with the rest of the list
+	sq_entry_t *prev = nullptr;
+	sq_entry_t *entry = perf_counters.head;
+
+	while (entry != nullptr && entry != &handle->link) {
+		prev = entry;
+		entry = entry->flink;
+	}
+
+	if (entry != nullptr) {
+		if (prev == nullptr) {
+			__atomic_store_n(&perf_counters.head, entry->flink, __ATOMIC_RELEASE);
+
+		} else {
+			__atomic_store_n(&prev->flink, entry->flink, __ATOMIC_RELEASE);
+		}
+
+		if (perf_counters.tail == entry) {
+			perf_counters.tail = prev;
+		}
+	}
+
 	pthread_mutex_unlock(&perf_counters_mutex);
 
+	// a concurrent perf_iterate_all() might still be on this counter
+	while (perf_counters_readers.load() > 0) {
+		px4_usleep(1000);
+	}
+
 	delete handle;
 }
 
@@ -222,6 +408,17 @@ perf_begin(perf_counter_t handle)
 		((struct perf_ctr_elapsed *)handle)->time_start = hrt_absolute_time();
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = hrt_absolute_time();
+		break;
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			pcc->cycles_start = perf_cycles_now();
+			pcc->started = true;
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -267,6 +464,42 @@ perf_end(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+
+			if (pch->time_start != 0) {
+				int64_t elapsed = hrt_absolute_time() - pch->time_start;
+
+				if (elapsed >= 0) {
+					histogram_add(pch, elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed);
+					pch->time_start = 0;
+				}
+			}
+		}
+		break;
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+
+			if (pcc->started) {
+				const perf_cycles_t elapsed = perf_cycles_now() - pcc->cycles_start;
+
+				pcc->event_count++;
+				pcc->cycles_total += elapsed;
+
+				if ((pcc->cycles_least > elapsed) || (pcc->event_count == 1)) {
+					pcc->cycles_least = elapsed;
+				}
+
+				if (pcc->cycles_most < elapsed) {
+					pcc->cycles_most = elapsed;
+				}
+
+				pcc->started = false;
+			}
+		}
+		break;
+
 	default:
 		break;
 	}
@@ -308,6 +541,13 @@ perf_set_elapsed(perf_counter_t handle, int64_t elapsed)
 		}
 		break;
 
+	case PC_HISTOGRAM:
+		if (elapsed >= 0) {
+			histogram_add((struct perf_ctr_histogram *)handle, elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed);
+		}
+
+		break;
+
 	default:
 		break;
 	}
@@ -401,6 +641,14 @@ perf_cancel(perf_counter_t handle)
 		}
 		break;
 
+	case PC_HISTOGRAM:
+		((struct perf_ctr_histogram *)handle)->time_start = 0;
+		break;
+
+	case PC_ELAPSED_CYCLES:
+		((struct perf_ctr_elapsed_cycles *)handle)->started = false;
+		break;
+
 	default:
 		break;
 	}
@@ -438,6 +686,31 @@ perf_reset(perf_counter_t handle)
 			pci->time_most = 0;
 			break;
 		}
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			pch->event_count.store(0);
+			pch->time_start = 0;
+			pch->time_total = 0;
+			pch->time_least.store(0);
+			pch->time_most.store(0);
+
+			for (auto &bucket : pch->buckets) {
+				bucket.store(0);
+			}
+
+			break;
+		}
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			pcc->event_count = 0;
+			pcc->cycles_total = 0;
+			pcc->cycles_least = 0;
+			pcc->cycles_most = 0;
+			pcc->started = false;
+			break;
+		}
 	}
 }
 
@@ -493,6 +766,34 @@ perf_print_counter_fd(int fd, perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const uint32_t event_count = pch->event_count.load();
+
+			dprintf(fd, "%s: %llu events, %.2fus avg, min %lluus max %lluus, p50 %lluus p90 %lluus p99 %lluus p99.9 %lluus\n",
+				handle->name,
+				(unsigned long long)event_count,
+				(event_count == 0) ? 0 : (double)pch->time_total / (double)event_count,
+				(unsigned long long)pch->time_least.load(),
+				(unsigned long long)pch->time_most.load(),
+				(unsigned long long)perf_percentile(handle, 50.f),
+				(unsigned long long)perf_percentile(handle, 90.f),
+				(unsigned long long)perf_percentile(handle, 99.f),
+				(unsigned long long)perf_percentile(handle, 99.9f));
+			break;
+		}
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			dprintf(fd, "%s: %llu events, %.3fus avg, min %.3fus max %.3fus\n",
+				handle->name,
+				(unsigned long long)pcc->event_count,
+				(pcc->event_count == 0) ? 0 : (double)pcc->cycles_total / PERF_CYCLES_PER_US / (double)pcc->event_count,
+				(double)pcc->cycles_least / PERF_CYCLES_PER_US,
+				(double)pcc->cycles_most / PERF_CYCLES_PER_US);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -543,6 +844,35 @@ perf_print_counter_buffer(char *buffer, int length, perf_counter_t handle)
 			break;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const uint32_t event_count = pch->event_count.load();
+
+			num_written = snprintf(buffer, length,
+					       "%s: %llu events, %.2fus avg, min %lluus max %lluus, p50 %lluus p90 %lluus p99 %lluus p99.9 %lluus",
+					       handle->name,
+					       (unsigned long long)event_count,
+					       (event_count == 0) ? 0 : (double)pch->time_total / (double)event_count,
+					       (unsigned long long)pch->time_least.load(),
+					       (unsigned long long)pch->time_most.load(),
+					       (unsigned long long)perf_percentile(handle, 50.f),
+					       (unsigned long long)perf_percentile(handle, 90.f),
+					       (unsigned long long)perf_percentile(handle, 99.f),
+					       (unsigned long long)perf_percentile(handle, 99.9f));
+			break;
+		}
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			num_written = snprintf(buffer, length, "%s: %llu events, %.3fus avg, min %.3fus max %.3fus",
+					       handle->name,
+					       (unsigned long long)pcc->event_count,
+					       (pcc->event_count == 0) ? 0 : (double)pcc->cycles_total / PERF_CYCLES_PER_US / (double)pcc->event_count,
+					       (double)pcc->cycles_least / PERF_CYCLES_PER_US,
+					       (double)pcc->cycles_most / PERF_CYCLES_PER_US);
+			break;
+		}
+
 	default:
 		break;
 	}
@@ -572,6 +902,12 @@ perf_event_count(perf_counter_t handle)
 			return pci->event_count;
 		}
 
+	case PC_HISTOGRAM:
+		return ((struct perf_ctr_histogram *)handle)->event_count.load();
+
+	case PC_ELAPSED_CYCLES:
+		return ((struct perf_ctr_elapsed_cycles *)handle)->event_count;
+
 	default:
 		break;
 	}
@@ -597,6 +933,17 @@ perf_mean(perf_counter_t handle)
 			return pci->mean;
 		}
 
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			const uint32_t event_count = pch->event_count.load();
+			return (event_count == 0) ? 0.f : pch->time_total / 1e6f / event_count;
+		}
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			return (pcc->event_count == 0) ? 0.f : (float)(pcc->cycles_total / PERF_CYCLES_PER_US / 1e6 / pcc->event_count);
+		}
+
 	default:
 		break;
 	}
@@ -605,31 +952,133 @@ perf_mean(perf_counter_t handle)
 }
 
 void
-perf_iterate_all(perf_callback cb, void *user)
+perf_get_stats(perf_counter_t handle, struct perf_counter_stats *stats)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	memset(stats, 0, sizeof(*stats));
 
-	while (handle != nullptr) {
-		cb(handle, user);
-		handle = (perf_counter_t)sq_next(&handle->link);
+	if (handle == nullptr) {
+		return;
 	}
 
-	pthread_mutex_unlock(&perf_counters_mutex);
+	stats->type = handle->type;
+	stats->name = handle->name;
+	stats->event_count = perf_event_count(handle);
+
+	switch (handle->type) {
+	case PC_ELAPSED: {
+			struct perf_ctr_elapsed *pce = (struct perf_ctr_elapsed *)handle;
+
+			if (pce->event_count > 0) {
+				stats->avg_us = (float)pce->time_total / pce->event_count;
+				stats->min_us = pce->time_least;
+				stats->max_us = pce->time_most;
+			}
+
+			if (pce->event_count > 1) {
+				stats->rms_us = 1e6f * sqrtf(pce->M2 / (pce->event_count - 1));
+			}
+
+			break;
+		}
+
+	case PC_INTERVAL: {
+			struct perf_ctr_interval *pci = (struct perf_ctr_interval *)handle;
+
+			if (pci->event_count > 0) {
+				stats->avg_us = (float)(pci->time_last - pci->time_first) / pci->event_count;
+				stats->min_us = pci->time_least;
+				stats->max_us = pci->time_most;
+			}
+
+			if (pci->event_count > 1) {
+				stats->rms_us = 1e6f * sqrtf(pci->M2 / (pci->event_count - 1));
+			}
+
+			break;
+		}
+
+	case PC_HISTOGRAM: {
+			struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+			stats->avg_us = 1e6f * perf_mean(handle);
+			stats->min_us = pch->time_least.load();
+			stats->max_us = pch->time_most.load();
+			stats->p99_us = perf_percentile(handle, 99.f);
+			break;
+		}
+
+	case PC_ELAPSED_CYCLES: {
+			struct perf_ctr_elapsed_cycles *pcc = (struct perf_ctr_elapsed_cycles *)handle;
+			stats->avg_us = 1e6f * perf_mean(handle);
+			stats->min_us = (float)(pcc->cycles_least / PERF_CYCLES_PER_US);
+			stats->max_us = (float)(pcc->cycles_most / PERF_CYCLES_PER_US);
+			break;
+		}
+
+	default:
+		break;
+	}
+}
+
+uint32_t
+perf_percentile(perf_counter_t handle, float percentile)
+{
+	if (handle == nullptr || handle->type != PC_HISTOGRAM) {
+		return 0;
+	}
+
+	struct perf_ctr_histogram *pch = (struct perf_ctr_histogram *)handle;
+	const uint32_t event_count = pch->event_count.load();
+
+	if (event_count == 0) {
+		return 0;
+	}
+
+	// rank of the event at the percentile, counted from 1
+	uint32_t rank = (uint32_t)ceilf(percentile / 100.f * event_count);
+
+	if (rank < 1) {
+		rank = 1;
+	}
+
+	const uint32_t time_most = pch->time_most.load();
+	uint32_t cumulative = 0;
+
+	for (int i = 0; i < PERF_HISTOGRAM_BUCKETS - 1; i++) {
+		cumulative += pch->buckets[i].load();
+
+		if (cumulative >= rank) {
+			const uint32_t upper = histogram_bucket_lower(i + 1) - 1;
+			return upper < time_most ? upper : time_most;
+		}
+	}
+
+	return time_most;
 }
 
 void
-perf_print_all(int fd)
+perf_iterate_all(perf_callback cb, void *user)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
+	perf_counters_readers.fetch_add(1);
+	perf_counter_t handle = (perf_counter_t)__atomic_load_n(&perf_counters.head, __ATOMIC_ACQUIRE);
 
 	while (handle != nullptr) {
-		perf_print_counter_fd(fd, handle);
-		handle = (perf_counter_t)sq_next(&handle->link);
+		cb(handle, user);
+		handle = (perf_counter_t)__atomic_load_n(&handle->link.flink, __ATOMIC_ACQUIRE);
 	}
 
-	pthread_mutex_unlock(&perf_counters_mutex);
+	perf_counters_readers.fetch_sub(1);
+}
+
+static void
+perf_print_callback(perf_counter_t handle, void *user)
+{
+	perf_print_counter_fd(*(int *)user, handle);
+}
+
+void
+perf_print_all(int fd)
+{
+	perf_iterate_all(perf_print_callback, &fd);
 }
 
 void
@@ -645,18 +1094,16 @@ perf_print_latency(int fd)
 	dprintf(fd, " >%4i : %i\n", latency_buckets[latency_bucket_count - 1], latency_counters[latency_bucket_count]);
 }
 
+static void
+perf_reset_callback(perf_counter_t handle, void *user)
+{
+	perf_reset(handle);
+}
+
 void
 perf_reset_all(void)
 {
-	pthread_mutex_lock(&perf_counters_mutex);
-	perf_counter_t handle = (perf_counter_t)sq_peek(&perf_counters);
-
-	while (handle != nullptr) {
-		perf_reset(handle);
-		handle = (perf_counter_t)sq_next(&handle->link);
-	}
-
-	pthread_mutex_unlock(&perf_counters_mutex);
+	perf_iterate_all(perf_reset_callback, nullptr);
 
 	for (int i = 0; i <= latency_bucket_count; i++) {
 		latency_counters[i] = 0;
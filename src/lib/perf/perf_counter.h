@@ -48,12 +48,28 @@
 enum perf_counter_type {
 	PC_COUNT,		/**< count the number of times an event occurs */
 	PC_ELAPSED,		/**< measure the time elapsed performing an event */
-	PC_INTERVAL		/**< measure the interval between instances of an event */
+	PC_INTERVAL,		/**< measure the interval between instances of an event */
+	PC_HISTOGRAM,		/**< measure the time elapsed performing an event, with a latency distribution */
+	PC_ELAPSED_CYCLES	/**< measure the time elapsed performing a short event with the CPU cycle counter */
 };
 
 struct perf_ctr_header;
 typedef struct perf_ctr_header	*perf_counter_t;
 
+/**
+ * Statistics of a counter.
+ */
+struct perf_counter_stats {
+	enum perf_counter_type	type;
+	const char		*name;
+	uint64_t		event_count;
+	float			avg_us;		/**< average elapsed time or interval */
+	float			min_us;
+	float			max_us;
+	float			rms_us;		/**< standard deviation, 0 if not available */
+	float			p99_us;		/**< 99th percentile, PC_HISTOGRAM only */
+};
+
 __BEGIN_DECLS
 
 /**
@@ -97,7 +113,7 @@ __EXPORT extern void		perf_count(perf_counter_t handle);
 /**
  * Begin a performance event.
  *
- * This call applies to counters that operate over ranges of time; PC_ELAPSED etc.
+ * This call applies to counters that operate over ranges of time; PC_ELAPSED, PC_HISTOGRAM etc.
  *
  * @param handle		The handle returned from perf_alloc.
  */
@@ -205,9 +221,9 @@ typedef void (*perf_callback)(perf_counter_t handle, void *user);
 /**
  * Iterate over all performance counters using a callback.
  *
- * Caution: This will aquire the mutex, so do not call any other perf_* method
- * that aquire the mutex as well from the callback (If this is needed, configure
- * the mutex to be reentrant).
+ * This does not lock the list of counters, so counters can be allocated from the
+ * callback. Counters freed concurrently are only deleted after the iteration
+ * finished, which means the callback must not free a counter itself.
  *
  * @param cb callback method
  * @param user custom argument for the callback
@@ -242,6 +258,27 @@ __EXPORT extern uint64_t	perf_event_count(perf_counter_t handle);
  */
 __EXPORT extern float		perf_mean(perf_counter_t handle);
 
+/**
+ * Get the statistics of a counter
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param stats			Filled with the statistics. Fields not applicable to the counter type are 0.
+ */
+__EXPORT extern void		perf_get_stats(perf_counter_t handle, struct perf_counter_stats *stats);
+
+/**
+ * Return a percentile of the measured times
+ *
+ * This call applies to counters of type PC_HISTOGRAM. The result is the upper
+ * bound of the histogram bucket containing the percentile (at most 25% above
+ * the exact value), limited to the maximum measured time.
+ *
+ * @param handle		The handle returned from perf_alloc.
+ * @param percentile		Percentile in [0, 100]
+ * @return			time in us, 0 if no events were recorded
+ */
+__EXPORT extern uint32_t	perf_percentile(perf_counter_t handle, float percentile);
+
 __END_DECLS
 
 #endif
@@ -145,6 +145,9 @@ void sched_note_stop(FAR struct tcb_s *tcb)
 
 void sched_note_suspend(FAR struct tcb_s *tcb)
 {
+#if defined(PX4_IRQ_MONITOR)
+	px4_irqmon_task_suspend(tcb);
+#endif
 
 	if (system_load.initialized) {
 		uint64_t new_time = hrt_absolute_time();
@@ -302,19 +302,17 @@ AirspeedModule::Run()
 		bool fixed_wing = !_vtol_vehicle_status.vtol_in_rw_mode;
 		bool in_air = !_vehicle_land_detected.landed;
 
-		/* Prepare data for airspeed_validator */
+		/* Prepare data for airspeed_validator, the vehicle state is computed once for all sensor instances */
 		struct airspeed_validator_update_data input_data = {};
 		input_data.timestamp = _time_now_usec;
-		input_data.lpos_vx = _vehicle_local_position.vx;
-		input_data.lpos_vy = _vehicle_local_position.vy;
-		input_data.lpos_vz = _vehicle_local_position.vz;
+		input_data.vel_ned = Vector3f{_vehicle_local_position.vx, _vehicle_local_position.vy, _vehicle_local_position.vz};
+		input_data.att_q = Quatf{_vehicle_attitude.q};
 		input_data.lpos_valid = _vehicle_local_position_valid;
-		input_data.lpos_evh = _vehicle_local_position.evh;
-		input_data.lpos_evv = _vehicle_local_position.evv;
-		input_data.att_q[0] = _vehicle_attitude.q[0];
-		input_data.att_q[1] = _vehicle_attitude.q[1];
-		input_data.att_q[2] = _vehicle_attitude.q[2];
-		input_data.att_q[3] = _vehicle_attitude.q[3];
+
+		const Vector3f vel_var{Dcmf(input_data.att_q) *Vector3f{_vehicle_local_position.evh, _vehicle_local_position.evh,
+						_vehicle_local_position.evv}};
+		input_data.vel_var_ne = Vector2f{vel_var(0), vel_var(1)};
+
 		input_data.air_pressure_pa = _vehicle_air_data.baro_pressure_pa;
 		input_data.accel_z = _accel.xyz[2];
 		input_data.vel_test_ratio = _estimator_status.vel_test_ratio;
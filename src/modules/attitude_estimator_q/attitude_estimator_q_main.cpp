@@ -59,6 +59,7 @@
 #include <uORB/topics/sensor_combined.h>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_gps_position.h>
+#include <uORB/topics/vehicle_imu.h>
 #include <uORB/topics/vehicle_local_position.h>
 #include <uORB/topics/vehicle_magnetometer.h>
 #include <uORB/topics/vehicle_odometry.h>
@@ -95,6 +96,9 @@ private:
 
 	void update_parameters(bool force = false);
 
+	// switch from sensor_combined to the vehicle_imu with the device id ATT_IMU_ID once it's published
+	void select_imu();
+
 	bool init_attq();
 
 	bool update(float dt);
@@ -109,6 +113,16 @@ private:
 
 	uORB::SubscriptionCallbackWorkItem _sensors_sub{this, ORB_ID(sensor_combined)};
 
+	static constexpr int MAX_SENSOR_COUNT = 3;
+	uORB::SubscriptionCallbackWorkItem _vehicle_imu_subs[MAX_SENSOR_COUNT] {
+		{this, ORB_ID(vehicle_imu), 0},
+		{this, ORB_ID(vehicle_imu), 1},
+		{this, ORB_ID(vehicle_imu), 2}
+	};
+
+	int		_imu_sub_index{-1};		///< vehicle_imu instance in use, -1 for sensor_combined
+	hrt_abstime	_last_imu_select{0};
+
 	uORB::Subscription		_parameter_update_sub{ORB_ID(parameter_update)};
 	uORB::Subscription		_gps_sub{ORB_ID(vehicle_gps_position)};
 	uORB::Subscription		_local_position_sub{ORB_ID(vehicle_local_position)};
@@ -157,7 +171,8 @@ private:
 		(ParamInt<px4::params::ATT_EXT_HDG_M>) _param_att_ext_hdg_m,
 		(ParamInt<px4::params::ATT_ACC_COMP>) _param_att_acc_comp,
 		(ParamFloat<px4::params::ATT_BIAS_MAX>) _param_att_bias_mas,
-		(ParamInt<px4::params::SYS_HAS_MAG>) _param_sys_has_mag
+		(ParamInt<px4::params::SYS_HAS_MAG>) _param_sys_has_mag,
+		(ParamInt<px4::params::ATT_IMU_ID>) _param_att_imu_id
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 		, (ParamInt<px4::params::SYS_MC_EST_GROUP>) _param_est_group
 #endif
@@ -201,34 +216,72 @@ AttitudeEstimatorQ::Run()
 {
 	if (should_exit()) {
 		_sensors_sub.unregisterCallback();
+
+		for (auto &sub : _vehicle_imu_subs) {
+			sub.unregisterCallback();
+		}
+
 		exit_and_cleanup();
 		return;
 	}
 
-	sensor_combined_s sensors;
+	if ((_imu_sub_index < 0) && (_param_att_imu_id.get() != 0) && (hrt_elapsed_time(&_last_imu_select) > 1_s)) {
+		select_imu();
+	}
 
-	if (_sensors_sub.update(&sensors)) {
+	bool updated = false;
+	hrt_abstime timestamp = 0;
+	float imu_dt = 0.f; // integration period of the vehicle_imu data, 0 for sensor_combined
 
-		update_parameters();
-
-		// Feed validator with recent sensor data
-		if (sensors.timestamp > 0) {
-			_gyro(0) = sensors.gyro_rad[0];
-			_gyro(1) = sensors.gyro_rad[1];
-			_gyro(2) = sensors.gyro_rad[2];
-		}
+	if (_imu_sub_index >= 0) {
+		vehicle_imu_s imu;
 
-		if (sensors.accelerometer_timestamp_relative != sensor_combined_s::RELATIVE_TIMESTAMP_INVALID) {
-			_accel(0) = sensors.accelerometer_m_s2[0];
-			_accel(1) = sensors.accelerometer_m_s2[1];
-			_accel(2) = sensors.accelerometer_m_s2[2];
+		if (_vehicle_imu_subs[_imu_sub_index].update(&imu) && (imu.dt > 0)) {
+			// the estimator uses the average rates over the integration period
+			imu_dt = imu.dt * 1e-6f;
+			_gyro = Vector3f{imu.delta_angle} / imu_dt;
+			_accel = Vector3f{imu.delta_velocity} / imu_dt;
 
 			if (_accel.length() < 0.01f) {
 				PX4_ERR("degenerate accel!");
 				return;
 			}
+
+			timestamp = imu.timestamp_sample;
+			updated = true;
 		}
 
+	} else {
+		sensor_combined_s sensors;
+
+		if (_sensors_sub.update(&sensors)) {
+			// Feed validator with recent sensor data
+			if (sensors.timestamp > 0) {
+				_gyro(0) = sensors.gyro_rad[0];
+				_gyro(1) = sensors.gyro_rad[1];
+				_gyro(2) = sensors.gyro_rad[2];
+			}
+
+			if (sensors.accelerometer_timestamp_relative != sensor_combined_s::RELATIVE_TIMESTAMP_INVALID) {
+				_accel(0) = sensors.accelerometer_m_s2[0];
+				_accel(1) = sensors.accelerometer_m_s2[1];
+				_accel(2) = sensors.accelerometer_m_s2[2];
+
+				if (_accel.length() < 0.01f) {
+					PX4_ERR("degenerate accel!");
+					return;
+				}
+			}
+
+			timestamp = sensors.timestamp;
+			updated = true;
+		}
+	}
+
+	if (updated) {
+
+		update_parameters();
+
 		// Update magnetometer
 		if (_magnetometer_sub.updated()) {
 			vehicle_magnetometer_s magnetometer;
@@ -350,14 +403,14 @@ AttitudeEstimatorQ::Run()
 			}
 		}
 
-		/* time from previous iteration */
+		/* time from previous iteration, or the IMU integration period */
 		hrt_abstime now = hrt_absolute_time();
-		const float dt = math::constrain((now - _last_time) / 1e6f, _dt_min, _dt_max);
+		const float dt = math::constrain((imu_dt > 0.f) ? imu_dt : (now - _last_time) / 1e6f, _dt_min, _dt_max);
 		_last_time = now;
 
 		if (update(dt)) {
 			vehicle_attitude_s att = {};
-			att.timestamp = sensors.timestamp;
+			att.timestamp = timestamp;
 			_q.copyTo(att.q);
 
 			/* the instance count is not used here */
@@ -412,6 +465,27 @@ AttitudeEstimatorQ::update_parameters(bool force)
 	}
 }
 
+void
+AttitudeEstimatorQ::select_imu()
+{
+	_last_imu_select = hrt_absolute_time();
+
+	const uint32_t device_id = _param_att_imu_id.get();
+
+	for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+		vehicle_imu_s imu{};
+
+		if (_vehicle_imu_subs[i].copy(&imu) && (imu.accel_device_id > 0) && (imu.accel_device_id == device_id)) {
+			if (_vehicle_imu_subs[i].registerCallback()) {
+				PX4_INFO("subscribed to vehicle_imu:%d (%d)", i, device_id);
+				_sensors_sub.unregisterCallback();
+				_imu_sub_index = i;
+				return;
+			}
+		}
+	}
+}
+
 bool
 AttitudeEstimatorQ::init_attq()
 {
@@ -624,6 +698,9 @@ AttitudeEstimatorQ::print_usage(const char *reason)
 ### Description
 Attitude estimator q.
 
+The estimator runs on sensor_combined, or, if ATT_IMU_ID is set, directly on the integrated data of that IMU
+(vehicle_imu) at the IMU integration rate.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("AttitudeEstimatorQ", "estimator");
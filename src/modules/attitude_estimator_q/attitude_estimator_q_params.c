@@ -134,3 +134,17 @@ PARAM_DEFINE_INT32(ATT_ACC_COMP, 1);
  * @decimal 3
  */
 PARAM_DEFINE_FLOAT(ATT_BIAS_MAX, 0.05f);
+
+/**
+ * Device id of IMU
+ *
+ * Set to 0 to use the system selected (sensor_combined) IMU,
+ * otherwise set to the accelerometer device id of the desired IMU (vehicle_imu).
+ * The estimator then runs on the integrated IMU data directly at the IMU integration rate (IMU_INTEG_RATE).
+ *
+ * @group Attitude Q estimator
+ * @value 0 System Primary
+ * @category Developer
+ * @reboot_required true
+ */
+PARAM_DEFINE_INT32(ATT_IMU_ID, 0);
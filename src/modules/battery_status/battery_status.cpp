@@ -106,6 +106,9 @@ private:
 	static constexpr uint32_t SAMPLE_FREQUENCY_HZ = 100;
 	static constexpr uint32_t SAMPLE_INTERVAL_US  = 1_s / SAMPLE_FREQUENCY_HZ;
 
+	static constexpr uint32_t ESTIMATE_FREQUENCY_HZ = 10;
+	static constexpr uint32_t ESTIMATE_INTERVAL_US  = 1_s / ESTIMATE_FREQUENCY_HZ;
+
 	AnalogBattery _battery1;
 
 #if BOARD_NUMBER_BRICKS > 1
@@ -119,6 +122,14 @@ private:
 #endif
 	}; // End _analogBatteries
 
+	/* Raw ADC readings per brick, summed at the sample rate and averaged at the estimation rate */
+	int32_t		_bat_voltage_raw_sum[BOARD_NUMBER_BRICKS] {};
+	int32_t		_bat_current_raw_sum[BOARD_NUMBER_BRICKS] {};
+	uint32_t	_raw_sample_count{0};
+	float		_adc_volts_per_lsb{0.f};
+
+	hrt_abstime	_last_estimate{0};
+
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
 	/**
@@ -127,20 +138,24 @@ private:
 	void 		parameter_update_poll(bool forced = false);
 
 	/**
-	 * Poll the ADC and update readings to suit.
-	 *
-	 * @param raw			Combined sensor data structure into which
-	 *				data should be returned.
+	 * Poll the ADC and accumulate the raw battery channel readings.
 	 */
 	void		adc_poll();
+
+	/**
+	 * Update the battery estimation with the averaged readings since the last call.
+	 *
+	 * @param now			Current time
+	 */
+	void		update_batteries(hrt_abstime now);
 };
 
 BatteryStatus::BatteryStatus() :
 	ModuleParams(nullptr),
-	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::hp_default),
-	_battery1(1, this, SAMPLE_INTERVAL_US),
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default),
+	_battery1(1, this, ESTIMATE_INTERVAL_US),
 #if BOARD_NUMBER_BRICKS > 1
-	_battery2(2, this, SAMPLE_INTERVAL_US),
+	_battery2(2, this, ESTIMATE_INTERVAL_US),
 #endif
 	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME))
 {
@@ -169,69 +184,60 @@ BatteryStatus::parameter_update_poll(bool forced)
 void
 BatteryStatus::adc_poll()
 {
-	/* For legacy support we publish the battery_status for the Battery that is
-	* associated with the Brick that is the selected source for VDD_5V_IN
-	* Selection is done in HW ala a LTC4417 or similar, or may be hard coded
-	* Like in the FMUv4
-	*/
-
-	/* Per Brick readings with default unread channels at 0 */
-	float bat_current_adc_readings[BOARD_NUMBER_BRICKS] {};
-	float bat_voltage_adc_readings[BOARD_NUMBER_BRICKS] {};
-
-	int selected_source = -1;
-
 	adc_report_s adc_report;
 
 	if (_adc_report_sub.update(&adc_report)) {
 
-		/* Read add channels we got */
+		/* Sum the raw readings of the battery channels, they are only scaled once per estimation */
 		for (unsigned i = 0; i < PX4_MAX_ADC_CHANNELS; ++i) {
 			for (int b = 0; b < BOARD_NUMBER_BRICKS; b++) {
 
-				/* Once we have subscriptions, Do this once for the lowest (highest priority
-				 * supply on power controller) that is valid.
-				 */
-				if (selected_source < 0 && _analogBatteries[b]->is_valid()) {
-					/* Indicate the lowest brick (highest priority supply on power controller)
-					 * that is valid as the one that is the selected source for the
-					 * VDD_5V_IN
-					 */
-					selected_source = b;
-				}
-
-				/* look for specific channels and process the raw voltage to measurement data */
-
 				if (adc_report.channel_id[i] == _analogBatteries[b]->get_voltage_channel()) {
-					/* Voltage in volts */
-					bat_voltage_adc_readings[b] = adc_report.raw_data[i] *
-								      adc_report.v_ref /
-								      adc_report.resolution;
+					_bat_voltage_raw_sum[b] += adc_report.raw_data[i];
 
 				} else if (adc_report.channel_id[i] == _analogBatteries[b]->get_current_channel()) {
-					bat_current_adc_readings[b] = adc_report.raw_data[i] *
-								      adc_report.v_ref /
-								      adc_report.resolution;
+					_bat_current_raw_sum[b] += adc_report.raw_data[i];
 				}
-
 			}
 		}
 
-		for (int b = 0; b < BOARD_NUMBER_BRICKS; b++) {
+		_adc_volts_per_lsb = adc_report.v_ref / adc_report.resolution;
+		_raw_sample_count++;
+	}
+}
 
-			actuator_controls_s ctrl{};
-			_actuator_ctrl_0_sub.copy(&ctrl);
+void
+BatteryStatus::update_batteries(hrt_abstime now)
+{
+	/* For legacy support we publish the battery_status for the Battery that is
+	* associated with the Brick that is the selected source for VDD_5V_IN
+	* Selection is done in HW ala a LTC4417 or similar, or may be hard coded
+	* Like in the FMUv4
+	*/
 
-			_analogBatteries[b]->updateBatteryStatusADC(
-				hrt_absolute_time(),
-				bat_voltage_adc_readings[b],
-				bat_current_adc_readings[b],
-				battery_status_s::BATTERY_SOURCE_POWER_MODULE,
-				b,
-				ctrl.control[actuator_controls_s::INDEX_THROTTLE]
-			);
-		}
+	actuator_controls_s ctrl{};
+	_actuator_ctrl_0_sub.copy(&ctrl);
+
+	const float volts_per_lsb = _adc_volts_per_lsb / _raw_sample_count;
+
+	for (int b = 0; b < BOARD_NUMBER_BRICKS; b++) {
+
+		/* Per Brick averaged readings in volts, unread channels are at 0 */
+		_analogBatteries[b]->updateBatteryStatusADC(
+			now,
+			_bat_voltage_raw_sum[b] * volts_per_lsb,
+			_bat_current_raw_sum[b] * volts_per_lsb,
+			battery_status_s::BATTERY_SOURCE_POWER_MODULE,
+			b,
+			ctrl.control[actuator_controls_s::INDEX_THROTTLE]
+		);
+
+		_bat_voltage_raw_sum[b] = 0;
+		_bat_current_raw_sum[b] = 0;
 	}
+
+	_raw_sample_count = 0;
+	_last_estimate = now;
 }
 
 void
@@ -250,6 +256,12 @@ BatteryStatus::Run()
 	/* check battery voltage */
 	adc_poll();
 
+	const hrt_abstime now = hrt_absolute_time();
+
+	if ((_raw_sample_count > 0) && (now - _last_estimate >= ESTIMATE_INTERVAL_US)) {
+		update_batteries(now);
+	}
+
 	perf_end(_loop_perf);
 }
 
@@ -305,7 +317,8 @@ The provided functionality includes:
 
 
 ### Implementation
-It runs in its own thread and polls on the currently selected gyro topic.
+It runs on the low priority work queue. The raw ADC readings are accumulated at 100 Hz and the battery
+estimation (filtering, state of charge and warnings) is updated with their average at 10 Hz.
 
 )DESCR_STR");
 
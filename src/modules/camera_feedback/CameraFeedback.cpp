@@ -59,23 +59,27 @@ CameraFeedback::Run()
 		return;
 	}
 
-	camera_trigger_s trig{};
+	// update geotagging subscriptions
+	vehicle_global_position_s gpos{};
+	_gpos_sub.copy(&gpos);
+
+	vehicle_local_position_s lpos{};
+	_lpos_sub.copy(&lpos);
 
-	if (_trigger_sub.update(&trig)) {
+	vehicle_attitude_s att{};
+	_att_sub.copy(&att);
 
-		// update geotagging subscriptions
-		vehicle_global_position_s gpos{};
-		_gpos_sub.copy(&gpos);
+	camera_trigger_s trig{};
 
-		vehicle_attitude_s att{};
-		_att_sub.copy(&att);
+	// triggers are queued, handle all captures since the last run
+	while (_trigger_sub.update(&trig)) {
 
 		if (trig.timestamp == 0 ||
 		    gpos.timestamp == 0 ||
 		    att.timestamp == 0) {
 
 			// reject until we have valid data
-			return;
+			continue;
 		}
 
 		camera_capture_s capture{};
@@ -92,6 +96,19 @@ CameraFeedback::Run()
 		capture.lon = gpos.lon;
 		capture.alt = gpos.alt;
 
+		// Move the position estimate to the capture time using the estimated velocity
+		const float dt = (static_cast<int64_t>(trig.timestamp) - static_cast<int64_t>(gpos.timestamp)) * 1e-6f;
+
+		if (lpos.timestamp != 0 && fabsf(dt) < POSITION_INTERPOLATION_MAX) {
+			if (lpos.v_xy_valid) {
+				add_vector_to_global_position(gpos.lat, gpos.lon, lpos.vx * dt, lpos.vy * dt, &capture.lat, &capture.lon);
+			}
+
+			if (lpos.v_z_valid) {
+				capture.alt -= lpos.vz * dt;
+			}
+		}
+
 		if (gpos.terrain_alt_valid) {
 			capture.ground_distance = gpos.alt - gpos.terrain_alt;
 
@@ -40,6 +40,7 @@
 
 #pragma once
 
+#include <lib/ecl/geo/geo.h>
 #include <lib/mathlib/mathlib.h>
 #include <lib/parameters/param.h>
 #include <px4_platform_common/px4_config.h>
@@ -55,6 +56,7 @@
 #include <uORB/topics/camera_trigger.h>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_local_position.h>
 
 class CameraFeedback : public ModuleBase<CameraFeedback>, public ModuleParams, public px4::WorkItem
 {
@@ -77,12 +79,15 @@ private:
 
 	void Run() override;
 
+	static constexpr float POSITION_INTERPOLATION_MAX{0.5f};	///< maximum time between position estimate and capture for the velocity correction [s]
+
 	uORB::SubscriptionCallbackWorkItem _trigger_sub{this, ORB_ID(camera_trigger)};
 
 	uORB::Subscription	_gpos_sub{ORB_ID(vehicle_global_position)};
+	uORB::Subscription	_lpos_sub{ORB_ID(vehicle_local_position)};
 	uORB::Subscription	_att_sub{ORB_ID(vehicle_attitude)};
 
-	uORB::Publication<camera_capture_s>	_capture_pub{ORB_ID(camera_capture)};
+	uORB::PublicationQueued<camera_capture_s>	_capture_pub{ORB_ID(camera_capture)};
 
 	DEFINE_PARAMETERS(
 		(ParamBool<px4::params::CAM_CAP_FBACK>) _param_camera_capture_feedback
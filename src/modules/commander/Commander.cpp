@@ -1203,6 +1203,59 @@ Commander::set_home_position_alt_only()
 	return false;
 }
 
+void
+Commander::update_prearm_check()
+{
+	// compare the inputs without their timestamps
+	vehicle_status_flags_s flags = status_flags;
+	flags.timestamp = _prearm_check_status_flags.timestamp;
+	safety_s safety = _safety;
+	safety.timestamp = _prearm_check_safety.timestamp;
+
+	const bool inputs_changed = memcmp(&flags, &_prearm_check_status_flags, sizeof(flags)) != 0
+				    || memcmp(&safety, &_prearm_check_safety, sizeof(safety)) != 0
+				    || memcmp(&_arm_requirements, &_prearm_check_arm_requirements, sizeof(_arm_requirements)) != 0
+				    || status.arming_state != _prearm_check_arming_state
+				    || status.hil_state != _prearm_check_hil_state;
+
+	if (!inputs_changed && hrt_elapsed_time(&_prearm_check_time) < PREARM_CHECK_INTERVAL) {
+		return;
+	}
+
+	bool preflight_check_res = PreFlightCheck::preflightCheck(nullptr, status, status_flags, true, false, true, 30_s);
+	bool prearm_check_res = PreFlightCheck::preArmCheck(nullptr, status_flags, _safety, _arm_requirements, status, false);
+	set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_PREARM_CHECK, true, true, (preflight_check_res
+			 && prearm_check_res), status);
+
+	// the checks can update the status flags themselves
+	_prearm_check_status_flags = status_flags;
+	_prearm_check_safety = _safety;
+	_prearm_check_arm_requirements = _arm_requirements;
+	_prearm_check_arming_state = status.arming_state;
+	_prearm_check_hil_state = status.hil_state;
+	_prearm_check_time = hrt_absolute_time();
+}
+
+void
+Commander::wait_for_next_tick()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	// keep a fixed tick rate independent of the duration of an iteration,
+	// restart the schedule after an overrun instead of catching up
+	if (now >= _next_tick) {
+		_next_tick += COMMANDER_MONITORING_INTERVAL;
+
+		if (_next_tick <= now) {
+			_next_tick = now + COMMANDER_MONITORING_INTERVAL;
+		}
+	}
+
+	// a new command is handled immediately (the iteration doesn't move the tick schedule)
+	vehicle_command_s cmd;
+	_cmd_wakeup_sub.updateBlocking(cmd, (uint32_t)math::max(_next_tick - now, (hrt_abstime)1));
+}
+
 void
 Commander::run()
 {
@@ -2319,10 +2372,7 @@ Commander::run()
 
 			// Evaluate current prearm status
 			if (!armed.armed && !status_flags.condition_calibration_enabled) {
-				bool preflight_check_res = PreFlightCheck::preflightCheck(nullptr, status, status_flags, true, false, true, 30_s);
-				bool prearm_check_res = PreFlightCheck::preArmCheck(nullptr, status_flags, _safety, _arm_requirements, status, false);
-				set_health_flags(subsystem_info_s::SUBSYSTEM_TYPE_PREARM_CHECK, true, true, (preflight_check_res
-						 && prearm_check_res), status);
+				update_prearm_check();
 			}
 
 			_vehicle_status_flags_pub.publish(status_flags);
@@ -2396,7 +2446,7 @@ Commander::run()
 
 		arm_auth_update(now, params_updated || param_init_forced);
 
-		px4_usleep(COMMANDER_MONITORING_INTERVAL);
+		wait_for_next_tick();
 	}
 
 	thread_should_exit = true;
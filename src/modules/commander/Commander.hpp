@@ -56,6 +56,7 @@
 
 // subscriptions
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionBlocking.hpp>
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/airspeed.h>
 #include <uORB/topics/battery_status.h>
@@ -168,6 +169,17 @@ private:
 
 	bool shutdown_if_allowed();
 
+	/**
+	 * Update the prearm health flag, the checks are only evaluated again if their inputs changed
+	 * or PREARM_CHECK_INTERVAL has passed (for the sensor and estimator health)
+	 */
+	void update_prearm_check();
+
+	/**
+	 * Sleep until the next monitoring tick, vehicle commands end the sleep early
+	 */
+	void wait_for_next_tick();
+
 	bool stabilization_required();
 
 	DEFINE_PARAMETERS(
@@ -273,6 +285,8 @@ private:
 	static constexpr uint64_t COMMANDER_MONITORING_INTERVAL{10_ms};
 	static constexpr float COMMANDER_MONITORING_LOOPSPERMSEC{1 / (COMMANDER_MONITORING_INTERVAL / 1000.0f)};
 
+	static constexpr uint64_t PREARM_CHECK_INTERVAL{1_s};
+
 	static constexpr float STICK_ON_OFF_LIMIT{0.9f};
 
 	static constexpr uint64_t HOTPLUG_SENS_TIMEOUT{8_s};	/**< wait for hotplug sensors to come online for upto 8 seconds */
@@ -357,6 +371,15 @@ private:
 	hrt_abstime	_timestamp_engine_healthy{0}; ///< absolute time when engine was healty
 
 	uint32_t	_counter{0};
+	hrt_abstime	_next_tick{0};		///< start time of the next monitoring iteration
+
+	// inputs of the last prearm check evaluation
+	hrt_abstime			_prearm_check_time{0};
+	vehicle_status_flags_s		_prearm_check_status_flags{};
+	safety_s			_prearm_check_safety{};
+	PreFlightCheck::arm_requirements_t	_prearm_check_arm_requirements{};
+	uint8_t				_prearm_check_arming_state{0};
+	uint8_t				_prearm_check_hil_state{0};
 
 	bool		_status_changed{true};
 	bool		_arm_tune_played{false};
@@ -392,6 +415,7 @@ private:
 	};
 #endif
 	uORB::Subscription					_cmd_sub {ORB_ID(vehicle_command)};
+	uORB::SubscriptionBlocking<vehicle_command_s>		_cmd_wakeup_sub{ORB_ID(vehicle_command)};	///< only wakes up the main loop
 	uORB::Subscription					_cpuload_sub{ORB_ID(cpuload)};
 	uORB::Subscription					_sub_distance_sensor[ORB_MULTI_MAX_INSTANCES] {{ORB_ID(distance_sensor), 0}, {ORB_ID(distance_sensor), 1}, {ORB_ID(distance_sensor), 2}, {ORB_ID(distance_sensor), 3}}; /**< distance data received from onboard rangefinders */
 	uORB::Subscription					_esc_status_sub{ORB_ID(esc_status)};
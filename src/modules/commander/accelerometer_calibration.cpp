@@ -146,6 +146,8 @@
 #include <systemlib/err.h>
 #include <systemlib/mavlink_log.h>
 #include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/sensor_accel_fifo.h>
+#include <uORB/topics/sensor_accel_status.h>
 #include <uORB/topics/sensor_correction.h>
 #include <uORB/Subscription.hpp>
 
@@ -161,6 +163,7 @@ static int32_t device_id_primary = 0;
 calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub,
 		float (&accel_offs)[max_accel_sens][3], float (&accel_T)[max_accel_sens][3][3], unsigned *active_sensors);
 calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[max_accel_sens],
+					int (&fifo_subs)[max_accel_sens], const enum Rotation (&fifo_rotation)[max_accel_sens],
 					float (&accel_avg)[max_accel_sens][detect_orientation_side_count][3], unsigned orient, unsigned samples_num);
 int mat_invert3(float src[3][3], float dst[3][3]);
 calibrate_return calculate_calibration_values(unsigned sensor,
@@ -172,6 +175,8 @@ typedef struct  {
 	orb_advert_t	*mavlink_log_pub;
 	unsigned	done_count;
 	int		subs[max_accel_sens];
+	int		fifo_subs[max_accel_sens];		///< raw FIFO subscriptions, -1 to fall back to sensor_accel
+	enum Rotation	fifo_rotation[max_accel_sens];		///< sensor rotation of the raw FIFO data
 	float		accel_ref[max_accel_sens][detect_orientation_side_count][3];
 	int		sensor_correction_sub;
 } accel_worker_data_t;
@@ -464,8 +469,8 @@ static calibrate_return accel_calibration_worker(detect_orientation_return orien
 	calibration_log_info(worker_data->mavlink_log_pub, "[cal] Hold still, measuring %s side",
 			     detect_orientation_str(orientation));
 
-	read_accelerometer_avg(worker_data->sensor_correction_sub, worker_data->subs, worker_data->accel_ref, orientation,
-			       samples_num);
+	read_accelerometer_avg(worker_data->sensor_correction_sub, worker_data->subs, worker_data->fifo_subs,
+			       worker_data->fifo_rotation, worker_data->accel_ref, orientation, samples_num);
 
 	calibration_log_info(worker_data->mavlink_log_pub, "[cal] %s side result: [%8.4f %8.4f %8.4f]",
 			     detect_orientation_str(orientation),
@@ -479,6 +484,49 @@ static calibrate_return accel_calibration_worker(detect_orientation_return orien
 	return calibrate_return_ok;
 }
 
+/*
+ * Find the raw FIFO topic of an accelerometer. The FIFO carries every sample the sensor produced
+ * (unrotated, unscaled), so averaging it gets to the required number of samples much faster
+ * than the decimated sensor_accel topic. The rotation comes from the matching sensor_accel_status.
+ */
+static void subscribe_accel_fifo(int32_t devid, int &fifo_sub, enum Rotation &rotation)
+{
+	fifo_sub = -1;
+
+	bool have_rotation = false;
+	const unsigned status_count = orb_group_count(ORB_ID(sensor_accel_status));
+
+	for (unsigned i = 0; i < status_count && !have_rotation; i++) {
+		sensor_accel_status_s status{};
+		int status_sub = orb_subscribe_multi(ORB_ID(sensor_accel_status), i);
+
+		if (orb_copy(ORB_ID(sensor_accel_status), status_sub, &status) == PX4_OK && status.device_id == (uint32_t)devid) {
+			rotation = static_cast<enum Rotation>(status.rotation);
+			have_rotation = true;
+		}
+
+		orb_unsubscribe(status_sub);
+	}
+
+	if (!have_rotation) {
+		return;
+	}
+
+	const unsigned fifo_count = orb_group_count(ORB_ID(sensor_accel_fifo));
+
+	for (unsigned i = 0; i < fifo_count; i++) {
+		sensor_accel_fifo_s fifo{};
+		int sub = orb_subscribe_multi(ORB_ID(sensor_accel_fifo), i);
+
+		if (orb_copy(ORB_ID(sensor_accel_fifo), sub, &fifo) == PX4_OK && fifo.device_id == (uint32_t)devid) {
+			fifo_sub = sub;
+			return;
+		}
+
+		orb_unsubscribe(sub);
+	}
+}
+
 calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub,
 		float (&accel_offs)[max_accel_sens][3], float (&accel_T)[max_accel_sens][3][3], unsigned *active_sensors)
 {
@@ -499,6 +547,8 @@ calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub
 	// Initialize subs to error condition so we know which ones are open and which are not
 	for (size_t i = 0; i < max_accel_sens; i++) {
 		worker_data.subs[i] = -1;
+		worker_data.fifo_subs[i] = -1;
+		worker_data.fifo_rotation[i] = ROTATION_NONE;
 	}
 
 	uint64_t timestamps[max_accel_sens] = {};
@@ -569,6 +619,8 @@ calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub
 			result = calibrate_return_error;
 			break;
 		}
+
+		subscribe_accel_fifo(device_id[cur_accel], worker_data.fifo_subs[cur_accel], worker_data.fifo_rotation[cur_accel]);
 	}
 
 	if (result == calibrate_return_ok) {
@@ -591,6 +643,10 @@ calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub
 
 			px4_close(worker_data.subs[i]);
 		}
+
+		if (worker_data.fifo_subs[i] >= 0) {
+			orb_unsubscribe(worker_data.fifo_subs[i]);
+		}
 	}
 
 	orb_unsubscribe(worker_data.sensor_correction_sub);
@@ -612,8 +668,10 @@ calibrate_return do_accel_calibration_measurements(orb_advert_t *mavlink_log_pub
 
 /*
  * Read specified number of accelerometer samples, calculate average and dispersion.
+ * All sensors are read concurrently, from the raw FIFO where available.
  */
 calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[max_accel_sens],
+					int (&fifo_subs)[max_accel_sens], const enum Rotation (&fifo_rotation)[max_accel_sens],
 					float (&accel_avg)[max_accel_sens][detect_orientation_side_count][3], unsigned orient, unsigned samples_num)
 {
 	/* get total sensor board rotation matrix */
@@ -640,7 +698,7 @@ calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[m
 	px4_pollfd_struct_t fds[max_accel_sens];
 
 	for (unsigned i = 0; i < max_accel_sens; i++) {
-		fds[i].fd = subs[i];
+		fds[i].fd = (fifo_subs[i] >= 0) ? fifo_subs[i] : subs[i];
 		fds[i].events = POLLIN;
 	}
 
@@ -662,6 +720,14 @@ calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[m
 		}
 	}
 
+	/* drop the samples queued while the vehicle was being turned */
+	for (unsigned s = 0; s < max_accel_sens; s++) {
+		if (fifo_subs[s] >= 0) {
+			sensor_accel_fifo_s fifo;
+			orb_copy(ORB_ID(sensor_accel_fifo), fifo_subs[s], &fifo);
+		}
+	}
+
 	/* use the first sensor to pace the readout, but do per-sensor counts */
 	while (counts[0] < samples_num) {
 		int poll_ret = px4_poll(&fds[0], max_accel_sens, 1000);
@@ -670,35 +736,37 @@ calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[m
 
 			for (unsigned s = 0; s < max_accel_sens; s++) {
 				bool changed;
-				orb_check(subs[s], &changed);
+				orb_check(fds[s].fd, &changed);
 
-				if (changed) {
+				if (!changed) {
+					continue;
+				}
 
-					sensor_accel_s arp;
-					orb_copy(ORB_ID(sensor_accel), subs[s], &arp);
+				if (fifo_subs[s] >= 0) {
+					sensor_accel_fifo_s fifo;
+					orb_copy(ORB_ID(sensor_accel_fifo), fifo_subs[s], &fifo);
 
-					// Apply thermal offset corrections in sensor/board frame
-					if (s == 0) {
-						accel_sum[s][0] += (arp.x - sensor_correction.accel_offset_0[0]);
-						accel_sum[s][1] += (arp.y - sensor_correction.accel_offset_0[1]);
-						accel_sum[s][2] += (arp.z - sensor_correction.accel_offset_0[2]);
-
-					} else if (s == 1) {
-						accel_sum[s][0] += (arp.x - sensor_correction.accel_offset_1[0]);
-						accel_sum[s][1] += (arp.y - sensor_correction.accel_offset_1[1]);
-						accel_sum[s][2] += (arp.z - sensor_correction.accel_offset_1[2]);
-
-					} else if (s == 2) {
-						accel_sum[s][0] += (arp.x - sensor_correction.accel_offset_2[0]);
-						accel_sum[s][1] += (arp.y - sensor_correction.accel_offset_2[1]);
-						accel_sum[s][2] += (arp.z - sensor_correction.accel_offset_2[2]);
-
-					} else {
-						accel_sum[s][0] += arp.x;
-						accel_sum[s][1] += arp.y;
-						accel_sum[s][2] += arp.z;
+					// sum the whole FIFO in integer, the rotation and scale are applied to the average
+					int32_t sum[3] {};
+
+					for (unsigned n = 0; n < fifo.samples && n < (sizeof(fifo.x) / sizeof(fifo.x[0])); n++) {
+						sum[0] += fifo.x[n];
+						sum[1] += fifo.y[n];
+						sum[2] += fifo.z[n];
 					}
 
+					accel_sum[s][0] += sum[0] * fifo.scale;
+					accel_sum[s][1] += sum[1] * fifo.scale;
+					accel_sum[s][2] += sum[2] * fifo.scale;
+					counts[s] += fifo.samples;
+
+				} else {
+					sensor_accel_s arp;
+					orb_copy(ORB_ID(sensor_accel), subs[s], &arp);
+
+					accel_sum[s][0] += arp.x;
+					accel_sum[s][1] += arp.y;
+					accel_sum[s][2] += arp.z;
 					counts[s]++;
 				}
 			}
@@ -713,19 +781,34 @@ calibrate_return read_accelerometer_avg(int sensor_correction_sub, int (&subs)[m
 		}
 	}
 
-	// rotate sensor measurements from sensor to body frame using board rotation matrix
-	for (unsigned i = 0; i < max_accel_sens; i++) {
-		Vector3f accel_sum_vec(&accel_sum[i][0]);
-		accel_sum_vec = board_rotation * accel_sum_vec;
+	for (unsigned s = 0; s < max_accel_sens; s++) {
+		if (counts[s] == 0) {
+			continue;
+		}
 
-		for (size_t j = 0; j < 3; j++) {
-			accel_sum[i][j] = accel_sum_vec(j);
+		Vector3f accel_mean{accel_sum[s][0] / counts[s], accel_sum[s][1] / counts[s], accel_sum[s][2] / counts[s]};
+
+		if (fifo_subs[s] >= 0) {
+			// raw FIFO data is in the sensor frame
+			rotate_3f(fifo_rotation[s], accel_mean(0), accel_mean(1), accel_mean(2));
 		}
-	}
 
-	for (unsigned s = 0; s < max_accel_sens; s++) {
+		// Apply thermal offset corrections in sensor/board frame
+		if (s == 0) {
+			accel_mean -= Vector3f(sensor_correction.accel_offset_0);
+
+		} else if (s == 1) {
+			accel_mean -= Vector3f(sensor_correction.accel_offset_1);
+
+		} else if (s == 2) {
+			accel_mean -= Vector3f(sensor_correction.accel_offset_2);
+		}
+
+		// rotate sensor measurements from sensor to body frame using board rotation matrix
+		accel_mean = board_rotation * accel_mean;
+
 		for (unsigned i = 0; i < 3; i++) {
-			accel_avg[s][orient][i] = accel_sum[s][i] / counts[s];
+			accel_avg[s][orient][i] = accel_mean(i);
 		}
 	}
 
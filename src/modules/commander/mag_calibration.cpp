@@ -59,6 +59,7 @@
 #include <systemlib/mavlink_log.h>
 #include <parameters/param.h>
 #include <systemlib/err.h>
+#include <lib/mathlib/mathlib.h>
 #include <uORB/topics/sensor_combined.h>
 
 static const char *sensor_name = "mag";
@@ -427,6 +428,13 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 	uint64_t calibration_deadline = hrt_absolute_time() + worker_data->calibration_interval_perside_useconds;
 	unsigned poll_errcount = 0;
 
+	// every mag collects its own samples for this side, a rejected sample of one mag no longer discards the others
+	unsigned int side_start[max_mags];
+
+	for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
+		side_start[cur_mag] = worker_data->calibration_counter_total[cur_mag];
+	}
+
 	calibration_counter_side = 0;
 
 	while (hrt_absolute_time() < calibration_deadline &&
@@ -453,51 +461,50 @@ static calibrate_return mag_calibration_worker(detect_orientation_return orienta
 
 		if (poll_ret > 0) {
 
-			int prev_count[max_mags];
-			bool rejected = false;
+			// the side is as far as the slowest mag
+			unsigned int side_count_min = worker_data->calibration_points_perside;
 
 			for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
 
-				prev_count[cur_mag] = worker_data->calibration_counter_total[cur_mag];
+				if (worker_data->sub_mag[cur_mag] < 0 || device_ids[cur_mag] == 0) {
+					continue;
+				}
 
-				if (worker_data->sub_mag[cur_mag] >= 0) {
-					sensor_mag_s mag{};
+				unsigned int &count = worker_data->calibration_counter_total[cur_mag];
+				bool updated = false;
+				orb_check(worker_data->sub_mag[cur_mag], &updated);
 
+				if (updated && (count - side_start[cur_mag] < worker_data->calibration_points_perside)) {
+					sensor_mag_s mag{};
 					orb_copy(ORB_ID(sensor_mag), worker_data->sub_mag[cur_mag], &mag);
 
 					// Check if this measurement is good to go in
-					rejected = rejected || reject_sample(mag.x, mag.y, mag.z,
-									     worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
-									     worker_data->calibration_counter_total[cur_mag],
-									     calibration_sides * worker_data->calibration_points_perside);
-
-					worker_data->x[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.x;
-					worker_data->y[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.y;
-					worker_data->z[cur_mag][worker_data->calibration_counter_total[cur_mag]] = mag.z;
-					worker_data->calibration_counter_total[cur_mag]++;
+					if (!reject_sample(mag.x, mag.y, mag.z,
+							   worker_data->x[cur_mag], worker_data->y[cur_mag], worker_data->z[cur_mag],
+							   count, calibration_sides * worker_data->calibration_points_perside)) {
+
+						worker_data->x[cur_mag][count] = mag.x;
+						worker_data->y[cur_mag][count] = mag.y;
+						worker_data->z[cur_mag][count] = mag.z;
+						count++;
+					}
 				}
-			}
 
-			// Keep calibration of all mags in lockstep
-			if (rejected) {
-				// Reset counts, since one of the mags rejected the measurement
-				for (size_t cur_mag = 0; cur_mag < max_mags; cur_mag++) {
-					worker_data->calibration_counter_total[cur_mag] = prev_count[cur_mag];
-				}
+				side_count_min = math::min(side_count_min, count - side_start[cur_mag]);
+			}
 
-			} else {
-				calibration_counter_side++;
+			if (side_count_min > calibration_counter_side) {
+				calibration_counter_side = side_count_min;
 
 				unsigned new_progress = progress_percentage(worker_data) +
 							(unsigned)((100 / calibration_sides) * ((float)calibration_counter_side / (float)
 									worker_data->calibration_points_perside));
 
 				if (new_progress - _last_mag_progress > 3) {
-					// Progress indicator for side
+					// Progress indicator for side, the log is queued so there is no need to wait for it here
 					calibration_log_info(worker_data->mavlink_log_pub,
 							     "[cal] %s side calibration: progress <%u>",
 							     detect_orientation_str(orientation), new_progress);
-					px4_usleep(20000);
 
 					_last_mag_progress = new_progress;
 				}
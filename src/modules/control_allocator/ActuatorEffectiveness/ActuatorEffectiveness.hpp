@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ActuatorEffectiveness.hpp
+ *
+ * Interface for Actuator Effectiveness
+ *
+ * The effectiveness matrix maps actuator setpoints to the control vector
+ * (roll, pitch, yaw torque, then x, y, z thrust, see ControlAllocation::ControlAxis).
+ */
+
+#pragma once
+
+#include <ControlAllocation.hpp>
+
+#include <matrix/matrix/math.hpp>
+
+class ActuatorEffectiveness
+{
+public:
+	ActuatorEffectiveness() = default;
+	virtual ~ActuatorEffectiveness() = default;
+
+	static constexpr uint8_t NUM_ACTUATORS = ControlAllocation::NUM_ACTUATORS;
+	static constexpr uint8_t NUM_AXES = ControlAllocation::NUM_AXES;
+
+	typedef matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> EffectivenessMatrix;
+	typedef matrix::Vector<float, NUM_ACTUATORS> ActuatorVector;
+
+	/**
+	 * Get the control effectiveness matrix if updated
+	 *
+	 * Only the columns that changed since the last call are written, the
+	 * caller is expected to keep passing in the same matrix.
+	 *
+	 * @param effectiveness Effectiveness matrix, updated in place
+	 *
+	 * @return true if the effectiveness matrix has changed
+	 */
+	virtual bool getEffectivenessMatrix(EffectivenessMatrix &effectiveness) = 0;
+
+	/**
+	 * Reload the parameters the effectiveness depends on
+	 */
+	virtual void updateParameters() {}
+
+	/**
+	 * Get the actuator trims
+	 *
+	 * @return Actuator trims
+	 */
+	const ActuatorVector &getActuatorTrim() const { return _trim; }
+
+	/**
+	 * Get the number of actuators in use, the remaining columns of the effectiveness matrix are zero
+	 */
+	int numActuators() const { return _num_actuators; }
+
+protected:
+	ActuatorVector _trim;			///< Actuator trim
+	int _num_actuators{0};
+};
@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ActuatorEffectivenessMultirotor.cpp
+ *
+ * Actuator effectiveness computed from rotors position and orientation
+ */
+
+#include "ActuatorEffectivenessMultirotor.hpp"
+
+#include <float.h>
+#include <stdio.h>
+
+ActuatorEffectivenessMultirotor::ActuatorEffectivenessMultirotor():
+	ModuleParams(nullptr)
+{
+	for (int i = 0; i < NUM_ROTORS_MAX; i++) {
+		char buffer[17];
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_PX", i);
+		_param_handles[i].position_x = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_PY", i);
+		_param_handles[i].position_y = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_PZ", i);
+		_param_handles[i].position_z = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_AX", i);
+		_param_handles[i].axis_x = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_AY", i);
+		_param_handles[i].axis_y = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_AZ", i);
+		_param_handles[i].axis_z = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_CT", i);
+		_param_handles[i].thrust_coef = param_find(buffer);
+		snprintf(buffer, sizeof(buffer), "CA_MC_R%d_KM", i);
+		_param_handles[i].moment_ratio = param_find(buffer);
+	}
+
+	updateParams();
+}
+
+void
+ActuatorEffectivenessMultirotor::updateParams()
+{
+	ModuleParams::updateParams();
+
+	_num_actuators = 0;
+
+	for (int i = 0; i < NUM_ROTORS_MAX; i++) {
+		RotorGeometry &rotor = _geometry[i];
+
+		param_get(_param_handles[i].position_x, &rotor.position(0));
+		param_get(_param_handles[i].position_y, &rotor.position(1));
+		param_get(_param_handles[i].position_z, &rotor.position(2));
+		param_get(_param_handles[i].axis_x, &rotor.axis(0));
+		param_get(_param_handles[i].axis_y, &rotor.axis(1));
+		param_get(_param_handles[i].axis_z, &rotor.axis(2));
+		param_get(_param_handles[i].thrust_coef, &rotor.thrust_coef);
+		param_get(_param_handles[i].moment_ratio, &rotor.moment_ratio);
+
+		const float axis_norm = rotor.axis.norm();
+
+		if (axis_norm > FLT_EPSILON) {
+			rotor.axis /= axis_norm;
+
+		} else {
+			// invalid axis, default to thrust pointing up
+			rotor.axis = matrix::Vector3f(0.f, 0.f, -1.f);
+		}
+
+		if (rotor.thrust_coef > FLT_EPSILON) {
+			_num_actuators = i + 1;
+		}
+	}
+
+	_updated = true;
+}
+
+void
+ActuatorEffectivenessMultirotor::setRotorEffectiveness(EffectivenessMatrix &effectiveness, int index,
+		const RotorGeometry &rotor, const matrix::Vector3f &axis)
+{
+	const matrix::Vector3f thrust = rotor.thrust_coef * axis;
+	const matrix::Vector3f moment = rotor.position.cross(thrust) - rotor.moment_ratio * thrust;
+
+	for (int j = 0; j < 3; j++) {
+		effectiveness(ControlAllocation::ROLL + j, index) = moment(j);
+		effectiveness(ControlAllocation::THRUST_X + j, index) = thrust(j);
+	}
+}
+
+bool
+ActuatorEffectivenessMultirotor::getEffectivenessMatrix(EffectivenessMatrix &effectiveness)
+{
+	if (!_updated) {
+		return false;
+	}
+
+	effectiveness.setZero();
+
+	for (int i = 0; i < _num_actuators; i++) {
+		setRotorEffectiveness(effectiveness, i, _geometry[i], _geometry[i].axis);
+	}
+
+	_updated = false;
+	return true;
+}
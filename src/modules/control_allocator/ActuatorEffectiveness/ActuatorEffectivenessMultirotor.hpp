@@ -0,0 +1,100 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ActuatorEffectivenessMultirotor.hpp
+ *
+ * Actuator effectiveness computed from rotors position and orientation
+ *
+ * The geometry is configured with the CA_MC_R* parameters. Coaxial pairs are
+ * described by two rotors with the same position and opposite moment ratio.
+ */
+
+#pragma once
+
+#include "ActuatorEffectiveness.hpp"
+
+#include <px4_platform_common/module_params.h>
+
+class ActuatorEffectivenessMultirotor: public ModuleParams, public ActuatorEffectiveness
+{
+public:
+	ActuatorEffectivenessMultirotor();
+	virtual ~ActuatorEffectivenessMultirotor() = default;
+
+	static constexpr int NUM_ROTORS_MAX = 8;
+
+	struct RotorGeometry {
+		matrix::Vector3f position;	///< rotor position in body frame [m]
+		matrix::Vector3f axis;		///< unit vector along the rotor thrust in body frame
+		float thrust_coef;		///< thrust coefficient, 0 if the rotor is not used
+		float moment_ratio;		///< moment coefficient to thrust coefficient ratio, positive for CCW rotors
+	};
+
+	bool getEffectivenessMatrix(EffectivenessMatrix &effectiveness) override;
+
+	void updateParameters() override { updateParams(); }
+
+	/**
+	 * Write the effectiveness of a single rotor into a column of the effectiveness matrix
+	 *
+	 * @param effectiveness Effectiveness matrix
+	 * @param index Column index
+	 * @param rotor Rotor geometry
+	 * @param axis Rotor axis to use instead of rotor.axis (e.g. tilted), unit vector
+	 */
+	static void setRotorEffectiveness(EffectivenessMatrix &effectiveness, int index, const RotorGeometry &rotor,
+					  const matrix::Vector3f &axis);
+
+protected:
+	void updateParams() override;
+
+	RotorGeometry _geometry[NUM_ROTORS_MAX] {};
+
+	bool _updated{true};			///< geometry changed, the full effectiveness matrix needs to be recomputed
+
+private:
+	struct ParamHandles {
+		param_t position_x;
+		param_t position_y;
+		param_t position_z;
+		param_t axis_x;
+		param_t axis_y;
+		param_t axis_z;
+		param_t thrust_coef;
+		param_t moment_ratio;
+	};
+
+	ParamHandles _param_handles[NUM_ROTORS_MAX];
+};
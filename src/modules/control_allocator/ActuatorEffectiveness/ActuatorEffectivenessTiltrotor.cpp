@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ActuatorEffectivenessTiltrotor.cpp
+ *
+ * Actuator effectiveness for multirotors with tilting rotors
+ */
+
+#include "ActuatorEffectivenessTiltrotor.hpp"
+
+#include <mathlib/math/Functions.hpp>
+#include <mathlib/math/Limits.hpp>
+#include <px4_platform_common/defines.h>
+
+matrix::Vector3f
+ActuatorEffectivenessTiltrotor::tiltedAxis(const matrix::Vector3f &axis, float tilt)
+{
+	return matrix::Dcmf(matrix::Eulerf(0.f, -tilt, 0.f)) * axis;
+}
+
+bool
+ActuatorEffectivenessTiltrotor::getEffectivenessMatrix(EffectivenessMatrix &effectiveness)
+{
+	actuator_controls_s actuator_controls;
+
+	if (_actuator_controls_1_sub.update(&actuator_controls)) {
+		const float tilt_control = actuator_controls.control[4];
+
+		if (PX4_ISFINITE(tilt_control)) {
+			_tilt_sp = math::constrain(tilt_control, 0.f, 1.f) * math::radians(_param_ca_tilt_max.get());
+		}
+	}
+
+	const bool tilt_changed = fabsf(_tilt_sp - _tilt) > TILT_UPDATE_THRESHOLD;
+
+	if (!_updated && !tilt_changed) {
+		return false;
+	}
+
+	if (_updated) {
+		effectiveness.setZero();
+	}
+
+	_tilt = _tilt_sp;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		const bool tilted = _param_ca_tilt_mask.get() & (1 << i);
+
+		if (tilted) {
+			setRotorEffectiveness(effectiveness, i, _geometry[i], tiltedAxis(_geometry[i].axis, _tilt));
+
+		} else if (_updated) {
+			setRotorEffectiveness(effectiveness, i, _geometry[i], _geometry[i].axis);
+		}
+	}
+
+	_updated = false;
+	return true;
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ActuatorEffectivenessTiltrotor.hpp
+ *
+ * Actuator effectiveness for multirotors with tilting rotors
+ *
+ * The rotors selected with CA_TILT_MASK are tilted forward by the tilt servo
+ * setpoint of the VTOL controller (actuator_controls_1[4], 0: up, 1: CA_TILT_MAX).
+ * Only the columns of the tilted rotors are recomputed when the tilt changes.
+ */
+
+#pragma once
+
+#include "ActuatorEffectivenessMultirotor.hpp"
+
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/actuator_controls.h>
+
+class ActuatorEffectivenessTiltrotor: public ActuatorEffectivenessMultirotor
+{
+public:
+	ActuatorEffectivenessTiltrotor() = default;
+	virtual ~ActuatorEffectivenessTiltrotor() = default;
+
+	bool getEffectivenessMatrix(EffectivenessMatrix &effectiveness) override;
+
+private:
+	static constexpr float TILT_UPDATE_THRESHOLD = 0.01f;	///< minimum tilt change to recompute the effectiveness [rad]
+
+	/**
+	 * Rotate the rotor axis forward (from -z towards +x) about the body y axis
+	 */
+	static matrix::Vector3f tiltedAxis(const matrix::Vector3f &axis, float tilt);
+
+	uORB::Subscription _actuator_controls_1_sub{ORB_ID(actuator_controls_1)};
+
+	float _tilt_sp{0.f};		///< tilt setpoint [rad]
+	float _tilt{0.f};		///< tilt the effectiveness matrix was computed for [rad]
+
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::CA_TILT_MASK>) _param_ca_tilt_mask,
+		(ParamFloat<px4::params::CA_TILT_MAX>) _param_ca_tilt_max
+	)
+};
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocation.cpp
+ *
+ * Interface for Control Allocation Algorithms
+ */
+
+#include "ControlAllocation.hpp"
+
+void
+ControlAllocation::setEffectivenessMatrix(const matrix::Matrix<float, NUM_AXES, NUM_ACTUATORS> &effectiveness,
+		const ActuatorVector &actuator_trim, int num_actuators)
+{
+	_effectiveness = effectiveness;
+	_actuator_trim = actuator_trim;
+	clipActuatorSetpoint(_actuator_trim);
+	_control_trim = _effectiveness * _actuator_trim;
+	_num_actuators = num_actuators;
+}
+
+void
+ControlAllocation::setActuatorSetpoint(const ActuatorVector &actuator_sp)
+{
+	// Set actuator setpoint
+	_actuator_sp = actuator_sp;
+
+	// Clip
+	clipActuatorSetpoint(_actuator_sp);
+
+	// Compute achieved control
+	_control_allocated = _effectiveness * _actuator_sp;
+}
+
+void
+ControlAllocation::clipActuatorSetpoint(ActuatorVector &actuator) const
+{
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_actuator_max(i) < _actuator_min(i)) {
+			actuator(i) = _actuator_trim(i);
+
+		} else if (actuator(i) < _actuator_min(i)) {
+			actuator(i) = _actuator_min(i);
+
+		} else if (actuator(i) > _actuator_max(i)) {
+			actuator(i) = _actuator_max(i);
+		}
+	}
+}
+
+ControlAllocation::ActuatorVector
+ControlAllocation::normalizeActuatorSetpoint(const ActuatorVector &actuator) const
+{
+	ActuatorVector actuator_normalized;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		if (_actuator_min(i) < _actuator_max(i)) {
+			actuator_normalized(i) = -1.0f + 2.0f * (actuator(i) - _actuator_min(i)) / (_actuator_max(i) - _actuator_min(i));
+
+		} else {
+			// invalid range, the actuator is held at trim (see clipActuatorSetpoint())
+			actuator_normalized(i) = 0.0f;
+		}
+	}
+
+	return actuator_normalized;
+}
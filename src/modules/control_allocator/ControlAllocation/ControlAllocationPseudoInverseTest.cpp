@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationPseudoInverseTest.cpp
+ *
+ * Tests for Control Allocation Algorithms
+ */
+
+#include <gtest/gtest.h>
+#include <ControlAllocationPseudoInverse.hpp>
+
+using namespace matrix;
+
+namespace
+{
+
+// quad x: roll, pitch, yaw torque and z thrust of each rotor
+Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> quadEffectiveness()
+{
+	Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS> effectiveness;
+	const float rotors[4][4] = {
+		{-1.f,  1.f,  1.f, -1.f},
+		{ 1.f, -1.f,  1.f, -1.f},
+		{ 1.f, -1.f, -1.f,  1.f},
+		{ 1.f,  1.f,  1.f,  1.f},
+	};
+
+	for (int i = 0; i < 4; i++) {
+		effectiveness(ControlAllocation::ROLL, i) = rotors[0][i];
+		effectiveness(ControlAllocation::PITCH, i) = rotors[1][i];
+		effectiveness(ControlAllocation::YAW, i) = rotors[2][i];
+		effectiveness(ControlAllocation::THRUST_Z, i) = -rotors[3][i];
+	}
+
+	return effectiveness;
+}
+
+void setupQuad(ControlAllocationPseudoInverse &method)
+{
+	ControlAllocation::ActuatorVector actuator_min;
+	ControlAllocation::ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+	method.setActuatorMin(actuator_min);
+	method.setActuatorMax(actuator_max);
+	method.setEffectivenessMatrix(quadEffectiveness(), ControlAllocation::ActuatorVector(), 4);
+}
+
+}
+
+TEST(ControlAllocationTest, AllZeroCase)
+{
+	ControlAllocationPseudoInverse method;
+
+	method.setEffectivenessMatrix(Matrix<float, ControlAllocation::NUM_AXES, ControlAllocation::NUM_ACTUATORS>(),
+				      ControlAllocation::ActuatorVector(), ControlAllocation::NUM_ACTUATORS);
+	method.setControlSetpoint(Vector<float, ControlAllocation::NUM_AXES>());
+	method.allocate();
+
+	EXPECT_EQ(method.getActuatorSetpoint(), ControlAllocation::ActuatorVector());
+	EXPECT_EQ(method.getAllocatedControl(), (Vector<float, ControlAllocation::NUM_AXES>()));
+}
+
+TEST(ControlAllocationTest, QuadHover)
+{
+	ControlAllocationPseudoInverse method;
+	setupQuad(method);
+
+	Vector<float, ControlAllocation::NUM_AXES> control_sp;
+	control_sp(ControlAllocation::THRUST_Z) = -2.f;
+	method.setControlSetpoint(control_sp);
+	method.allocate();
+
+	const ControlAllocation::ActuatorVector &actuator_sp = method.getActuatorSetpoint();
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NEAR(actuator_sp(i), 0.5f, 1e-5f);
+	}
+
+	for (int i = 4; i < ControlAllocation::NUM_ACTUATORS; i++) {
+		EXPECT_FLOAT_EQ(actuator_sp(i), 0.f);
+	}
+
+	EXPECT_TRUE(isEqual(method.getAllocatedControl(), control_sp));
+
+	// normalized to [-1, 1]
+	const ControlAllocation::ActuatorVector actuator_normalized = method.normalizeActuatorSetpoint(actuator_sp);
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NEAR(actuator_normalized(i), 0.f, 1e-5f);
+	}
+}
+
+TEST(ControlAllocationTest, QuadSaturationClipped)
+{
+	ControlAllocationPseudoInverse method;
+	setupQuad(method);
+
+	// full thrust with a roll demand saturates two of the rotors
+	Vector<float, ControlAllocation::NUM_AXES> control_sp;
+	control_sp(ControlAllocation::ROLL) = 1.f;
+	control_sp(ControlAllocation::THRUST_Z) = -4.f;
+	method.setControlSetpoint(control_sp);
+	method.allocate();
+
+	const ControlAllocation::ActuatorVector &actuator_sp = method.getActuatorSetpoint();
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_LE(actuator_sp(i), 1.f);
+		EXPECT_GE(actuator_sp(i), 0.f);
+	}
+
+	// the setpoint cannot be achieved
+	EXPECT_FALSE(isEqual(method.getAllocatedControl(), control_sp));
+}
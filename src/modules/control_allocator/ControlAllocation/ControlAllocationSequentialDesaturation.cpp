@@ -0,0 +1,245 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocationSequentialDesaturation.cpp
+ *
+ * Control Allocation Algorithm which sequentially modifies control demands in order to
+ * eliminate the saturation of the actuator setpoint vector.
+ */
+
+#include "ControlAllocationSequentialDesaturation.hpp"
+
+#include <float.h>
+#include <math.h>
+
+void
+ControlAllocationSequentialDesaturation::allocate()
+{
+	//Compute new gains if needed
+	updatePseudoInverse();
+
+	switch (_param_mc_airmode.get()) {
+	case 1:
+		mixAirmodeRP();
+		break;
+
+	case 2:
+		mixAirmodeRPY();
+		break;
+
+	default:
+		mixAirmodeDisabled();
+		break;
+	}
+
+	// Clip
+	clipActuatorSetpoint(_actuator_sp);
+
+	// Compute achieved control
+	_control_allocated = _effectiveness * _actuator_sp;
+}
+
+void
+ControlAllocationSequentialDesaturation::updateParameters()
+{
+	updateParams();
+}
+
+void
+ControlAllocationSequentialDesaturation::desaturateActuators(ActuatorVector &actuator_sp,
+		const ActuatorVector &desaturation_vector, bool reduce_only)
+{
+	float gain = computeDesaturationGain(desaturation_vector, actuator_sp);
+
+	if (reduce_only && gain > 0.f) {
+		return;
+	}
+
+	for (int i = 0; i < _num_actuators; i++) {
+		actuator_sp(i) += gain * desaturation_vector(i);
+	}
+
+	// Compute the desaturation gain again based on the updated outputs.
+	// In most cases it will be zero. It won't be if max(outputs) - min(outputs) > max_output - min_output.
+	// In that case adding 0.5 of the gain will equilibrate saturations.
+	gain = 0.5f * computeDesaturationGain(desaturation_vector, actuator_sp);
+
+	for (int i = 0; i < _num_actuators; i++) {
+		actuator_sp(i) += gain * desaturation_vector(i);
+	}
+}
+
+float
+ControlAllocationSequentialDesaturation::computeDesaturationGain(const ActuatorVector &desaturation_vector,
+		const ActuatorVector &actuator_sp)
+{
+	float k_min = 0.f;
+	float k_max = 0.f;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		// Avoid division by zero. If desaturation_vector(i) is zero, there's nothing we can do to unsaturate anyway
+		if (fabsf(desaturation_vector(i)) < FLT_EPSILON) {
+			continue;
+		}
+
+		if (actuator_sp(i) < _actuator_min(i)) {
+			float k = (_actuator_min(i) - actuator_sp(i)) / desaturation_vector(i);
+
+			if (k < k_min) { k_min = k; }
+
+			if (k > k_max) { k_max = k; }
+		}
+
+		if (actuator_sp(i) > _actuator_max(i)) {
+			float k = (_actuator_max(i) - actuator_sp(i)) / desaturation_vector(i);
+
+			if (k < k_min) { k_min = k; }
+
+			if (k > k_max) { k_max = k; }
+		}
+	}
+
+	// Reduce the saturation as much as possible
+	return k_min + k_max;
+}
+
+ControlAllocation::ActuatorVector
+ControlAllocationSequentialDesaturation::getDesaturationVector(DesaturationAxis axis) const
+{
+	ActuatorVector desaturation_vector;
+
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		switch (axis) {
+		case DesaturationAxis::ROLL:
+			desaturation_vector(i) = _mix(i, ROLL);
+			break;
+
+		case DesaturationAxis::PITCH:
+			desaturation_vector(i) = _mix(i, PITCH);
+			break;
+
+		case DesaturationAxis::YAW:
+			desaturation_vector(i) = _mix(i, YAW);
+			break;
+
+		case DesaturationAxis::THRUST:
+			// the thrust setpoint points up (negative z), with a positive gain increasing the collective thrust
+			desaturation_vector(i) = -_mix(i, THRUST_Z);
+			break;
+		}
+	}
+
+	return desaturation_vector;
+}
+
+void
+ControlAllocationSequentialDesaturation::mixAirmodeRP()
+{
+	// Airmode for roll and pitch, but not yaw
+
+	// Mix without yaw
+	matrix::Vector<float, NUM_AXES> control_sp = _control_sp;
+	control_sp(YAW) = _control_trim(YAW);
+	_actuator_sp = _actuator_trim + _mix * (control_sp - _control_trim);
+
+	// Thrust will be used to unsaturate if needed
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::THRUST));
+
+	// Mix yaw independently
+	mixYaw();
+}
+
+void
+ControlAllocationSequentialDesaturation::mixAirmodeRPY()
+{
+	// Airmode for roll, pitch and yaw
+
+	// Do full mixing
+	_actuator_sp = _actuator_trim + _mix * (_control_sp - _control_trim);
+
+	// Thrust will be used to unsaturate if needed
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::THRUST));
+
+	// Unsaturate yaw (in case upper and lower bounds are exceeded)
+	// to prioritize roll/pitch over yaw.
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::YAW));
+}
+
+void
+ControlAllocationSequentialDesaturation::mixAirmodeDisabled()
+{
+	// Airmode disabled: never allow to increase the thrust to unsaturate a motor
+
+	// Mix without yaw
+	matrix::Vector<float, NUM_AXES> control_sp = _control_sp;
+	control_sp(YAW) = _control_trim(YAW);
+	_actuator_sp = _actuator_trim + _mix * (control_sp - _control_trim);
+
+	// Thrust will be used to unsaturate if needed, only reduce thrust
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::THRUST), true);
+
+	// Reduce roll/pitch acceleration if needed to unsaturate
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::ROLL));
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::PITCH));
+
+	// Mix yaw independently
+	mixYaw();
+}
+
+void
+ControlAllocationSequentialDesaturation::mixYaw()
+{
+	// Add yaw to outputs
+	const ActuatorVector yaw = getDesaturationVector(DesaturationAxis::YAW);
+	const float yaw_sp = _control_sp(YAW) - _control_trim(YAW);
+
+	for (int i = 0; i < _num_actuators; i++) {
+		_actuator_sp(i) += yaw_sp * yaw(i);
+	}
+
+	// Change yaw acceleration to unsaturate the outputs if needed (do not change roll/pitch),
+	// and allow some yaw response at maximum thrust
+	const ActuatorVector actuator_max = _actuator_max;
+
+	for (int i = 0; i < _num_actuators; i++) {
+		_actuator_max(i) += 0.15f * (actuator_max(i) - _actuator_min(i));
+	}
+
+	desaturateActuators(_actuator_sp, yaw);
+	_actuator_max = actuator_max;
+
+	// reduce thrust only
+	desaturateActuators(_actuator_sp, getDesaturationVector(DesaturationAxis::THRUST), true);
+}
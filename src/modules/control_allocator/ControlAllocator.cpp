@@ -0,0 +1,444 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file ControlAllocator.cpp
+ *
+ * Control allocator.
+ */
+
+#include "ControlAllocator.hpp"
+
+#include <drivers/drv_hrt.h>
+
+#include <float.h>
+
+using namespace matrix;
+
+ControlAllocator::ControlAllocator() :
+	ModuleParams(nullptr),
+	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
+	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+{
+	parameters_updated();
+}
+
+ControlAllocator::~ControlAllocator()
+{
+	delete _control_allocation;
+	delete _actuator_effectiveness;
+
+	perf_free(_loop_perf);
+}
+
+bool
+ControlAllocator::init()
+{
+	if (!_vehicle_torque_setpoint_sub.registerCallback()) {
+		PX4_ERR("vehicle_torque_setpoint callback registration failed!");
+		return false;
+	}
+
+	return true;
+}
+
+void
+ControlAllocator::parameters_updated()
+{
+	update_effectiveness_source();
+	update_allocation_method();
+
+	if (_actuator_effectiveness != nullptr) {
+		_actuator_effectiveness->updateParameters();
+	}
+
+	if (_control_allocation != nullptr) {
+		_control_allocation->updateParameters();
+	}
+}
+
+void
+ControlAllocator::update_allocation_method()
+{
+	const AllocationMethod method = static_cast<AllocationMethod>(_param_ca_method.get());
+
+	if (_allocation_method_id == method) {
+		return;
+	}
+
+	ControlAllocation *tmp = nullptr;
+
+	switch (method) {
+	case AllocationMethod::PSEUDO_INVERSE:
+		tmp = new ControlAllocationPseudoInverse();
+		break;
+
+	case AllocationMethod::SEQUENTIAL_DESATURATION:
+		tmp = new ControlAllocationSequentialDesaturation();
+		break;
+
+	default:
+		PX4_ERR("Unknown allocation method");
+		return;
+	}
+
+	if (tmp == nullptr) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	// motors only: actuator setpoint between 0 (idle) and 1 (full thrust)
+	ControlAllocation::ActuatorVector actuator_min;
+	ControlAllocation::ActuatorVector actuator_max;
+	actuator_max.setAll(1.f);
+	tmp->setActuatorMin(actuator_min);
+	tmp->setActuatorMax(actuator_max);
+
+	if (_actuator_effectiveness != nullptr) {
+		tmp->setEffectivenessMatrix(_effectiveness, _actuator_effectiveness->getActuatorTrim(),
+					    _actuator_effectiveness->numActuators());
+	}
+
+	// continue from the previous actuator setpoint
+	if (_control_allocation != nullptr) {
+		tmp->setActuatorSetpoint(_control_allocation->getActuatorSetpoint());
+	}
+
+	delete _control_allocation;
+	_control_allocation = tmp;
+	_allocation_method_id = method;
+}
+
+void
+ControlAllocator::update_effectiveness_source()
+{
+	const EffectivenessSource source = static_cast<EffectivenessSource>(_param_ca_airframe.get());
+
+	if (_effectiveness_source_id == source) {
+		return;
+	}
+
+	ActuatorEffectiveness *tmp = nullptr;
+
+	switch (source) {
+	case EffectivenessSource::MULTIROTOR:
+		tmp = new ActuatorEffectivenessMultirotor();
+		break;
+
+	case EffectivenessSource::TILTROTOR:
+		tmp = new ActuatorEffectivenessTiltrotor();
+		break;
+
+	default:
+		PX4_ERR("Unknown airframe");
+		return;
+	}
+
+	if (tmp == nullptr) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	// the new source reports its full effectiveness matrix on the next update
+	delete _actuator_effectiveness;
+	_actuator_effectiveness = tmp;
+	_effectiveness_source_id = source;
+}
+
+void
+ControlAllocator::update_effectiveness_matrix_if_needed()
+{
+	if (_actuator_effectiveness->getEffectivenessMatrix(_effectiveness)) {
+		_control_allocation->setEffectivenessMatrix(_effectiveness, _actuator_effectiveness->getActuatorTrim(),
+				_actuator_effectiveness->numActuators());
+	}
+}
+
+void
+ControlAllocator::Run()
+{
+	if (should_exit()) {
+		_vehicle_torque_setpoint_sub.unregisterCallback();
+		exit_and_cleanup();
+		return;
+	}
+
+	perf_begin(_loop_perf);
+
+	// Check if parameters have changed
+	if (_parameter_update_sub.updated()) {
+		// clear update
+		parameter_update_s param_update;
+		_parameter_update_sub.copy(&param_update);
+
+		updateParams();
+		parameters_updated();
+	}
+
+	if (_control_allocation == nullptr || _actuator_effectiveness == nullptr) {
+		perf_end(_loop_perf);
+		return;
+	}
+
+	vehicle_torque_setpoint_s vehicle_torque_setpoint;
+
+	if (_vehicle_torque_setpoint_sub.update(&vehicle_torque_setpoint)) {
+		_torque_sp = Vector3f(vehicle_torque_setpoint.xyz);
+		_timestamp_sample = vehicle_torque_setpoint.timestamp_sample;
+
+		// the rate controller publishes the thrust setpoint before the torque setpoint
+		vehicle_thrust_setpoint_s vehicle_thrust_setpoint;
+
+		if (_vehicle_thrust_setpoint_sub.update(&vehicle_thrust_setpoint)) {
+			_thrust_sp = Vector3f(vehicle_thrust_setpoint.xyz);
+		}
+
+		update_effectiveness_matrix_if_needed();
+
+		// Set control setpoint vector
+		Vector<float, NUM_AXES> c;
+		c(ControlAllocation::ROLL) = _torque_sp(0);
+		c(ControlAllocation::PITCH) = _torque_sp(1);
+		c(ControlAllocation::YAW) = _torque_sp(2);
+		c(ControlAllocation::THRUST_X) = _thrust_sp(0);
+		c(ControlAllocation::THRUST_Y) = _thrust_sp(1);
+		c(ControlAllocation::THRUST_Z) = _thrust_sp(2);
+		_control_allocation->setControlSetpoint(c);
+
+		// Do allocation
+		_control_allocation->allocate();
+
+		// Publish actuator setpoint and allocator status
+		publish_actuator_setpoint();
+		publish_control_allocator_status();
+	}
+
+	perf_end(_loop_perf);
+}
+
+void
+ControlAllocator::publish_actuator_setpoint()
+{
+	const ControlAllocation::ActuatorVector actuator_sp_normalized =
+		_control_allocation->normalizeActuatorSetpoint(_control_allocation->getActuatorSetpoint());
+
+	vehicle_actuator_setpoint_s vehicle_actuator_setpoint{};
+	vehicle_actuator_setpoint.timestamp_sample = _timestamp_sample;
+
+	for (int i = 0; i < NUM_ACTUATORS; i++) {
+		vehicle_actuator_setpoint.actuator[i] = actuator_sp_normalized(i);
+	}
+
+	vehicle_actuator_setpoint.timestamp = hrt_absolute_time();
+	_vehicle_actuator_setpoint_pub.publish(vehicle_actuator_setpoint);
+
+	publish_legacy_actuator_controls(vehicle_actuator_setpoint);
+}
+
+void
+ControlAllocator::publish_control_allocator_status()
+{
+	control_allocator_status_s control_allocator_status{};
+
+	// Allocated control
+	const Vector<float, NUM_AXES> &allocated_control = _control_allocation->getAllocatedControl();
+
+	// Unallocated control
+	const Vector<float, NUM_AXES> unallocated_control = _control_allocation->getControlSetpoint() - allocated_control;
+
+	float unallocated_torque_sq = 0.f;
+	float unallocated_thrust_sq = 0.f;
+
+	for (int i = 0; i < 3; i++) {
+		control_allocator_status.allocated_torque[i] = allocated_control(ControlAllocation::ROLL + i);
+		control_allocator_status.allocated_thrust[i] = allocated_control(ControlAllocation::THRUST_X + i);
+		control_allocator_status.unallocated_torque[i] = unallocated_control(ControlAllocation::ROLL + i);
+		control_allocator_status.unallocated_thrust[i] = unallocated_control(ControlAllocation::THRUST_X + i);
+
+		unallocated_torque_sq += unallocated_control(ControlAllocation::ROLL + i) * unallocated_control(ControlAllocation::ROLL + i);
+		unallocated_thrust_sq += unallocated_control(ControlAllocation::THRUST_X + i) * unallocated_control(
+						 ControlAllocation::THRUST_X + i);
+	}
+
+	control_allocator_status.torque_setpoint_achieved = unallocated_torque_sq < FLT_EPSILON;
+	control_allocator_status.thrust_setpoint_achieved = unallocated_thrust_sq < FLT_EPSILON;
+
+	// Actuator saturation
+	const ControlAllocation::ActuatorVector &actuator_sp = _control_allocation->getActuatorSetpoint();
+	const ControlAllocation::ActuatorVector &actuator_min = _control_allocation->getActuatorMin();
+	const ControlAllocation::ActuatorVector &actuator_max = _control_allocation->getActuatorMax();
+
+	for (int i = 0; i < _control_allocation->numConfiguredActuators(); i++) {
+		if (actuator_sp(i) > (actuator_max(i) - FLT_EPSILON)) {
+			control_allocator_status.actuator_saturation[i] = control_allocator_status_s::ACTUATOR_SATURATION_UPPER;
+
+		} else if (actuator_sp(i) < (actuator_min(i) + FLT_EPSILON)) {
+			control_allocator_status.actuator_saturation[i] = control_allocator_status_s::ACTUATOR_SATURATION_LOWER;
+		}
+	}
+
+	control_allocator_status.timestamp = hrt_absolute_time();
+	_control_allocator_status_pub.publish(control_allocator_status);
+}
+
+void
+ControlAllocator::publish_legacy_actuator_controls(const vehicle_actuator_setpoint_s &actuator_sp)
+{
+	// the first 8 actuators go to GROUP_INDEX_ALLOCATED_PART1, the next 8 to GROUP_INDEX_ALLOCATED_PART2
+	actuator_controls_s actuator_controls_4{};
+	actuator_controls_s actuator_controls_5{};
+	actuator_controls_4.timestamp_sample = actuator_sp.timestamp_sample;
+	actuator_controls_5.timestamp_sample = actuator_sp.timestamp_sample;
+
+	for (int i = 0; i < actuator_controls_s::NUM_ACTUATOR_CONTROLS; i++) {
+		actuator_controls_4.control[i] = actuator_sp.actuator[i];
+		actuator_controls_5.control[i] = actuator_sp.actuator[actuator_controls_s::NUM_ACTUATOR_CONTROLS + i];
+	}
+
+	actuator_controls_4.timestamp = hrt_absolute_time();
+	_actuator_controls_4_pub.publish(actuator_controls_4);
+
+	if (_control_allocation->numConfiguredActuators() > actuator_controls_s::NUM_ACTUATOR_CONTROLS) {
+		actuator_controls_5.timestamp = hrt_absolute_time();
+		_actuator_controls_5_pub.publish(actuator_controls_5);
+	}
+}
+
+int ControlAllocator::task_spawn(int argc, char *argv[])
+{
+	ControlAllocator *instance = new ControlAllocator();
+
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (instance->init()) {
+			return PX4_OK;
+		}
+
+	} else {
+		PX4_ERR("alloc failed");
+	}
+
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
+}
+
+int ControlAllocator::print_status()
+{
+	PX4_INFO("Running");
+
+	// Print current allocation method
+	switch (_allocation_method_id) {
+	case AllocationMethod::NONE:
+		PX4_INFO("Method: None");
+		break;
+
+	case AllocationMethod::PSEUDO_INVERSE:
+		PX4_INFO("Method: Pseudo-inverse");
+		break;
+
+	case AllocationMethod::SEQUENTIAL_DESATURATION:
+		PX4_INFO("Method: Sequential desaturation");
+		break;
+	}
+
+	// Print current airframe
+	switch (_effectiveness_source_id) {
+	case EffectivenessSource::NONE:
+		PX4_INFO("EffectivenessSource: None");
+		break;
+
+	case EffectivenessSource::MULTIROTOR:
+		PX4_INFO("EffectivenessSource: MC parameters");
+		break;
+
+	case EffectivenessSource::TILTROTOR:
+		PX4_INFO("EffectivenessSource: Tiltrotor");
+		break;
+	}
+
+	// Print current effectiveness matrix
+	if (_control_allocation != nullptr) {
+		const ActuatorEffectiveness::EffectivenessMatrix &effectiveness = _control_allocation->getEffectivenessMatrix();
+		PX4_INFO("Effectiveness.T =");
+		effectiveness.T().print();
+		PX4_INFO("Configured actuators: %i", _control_allocation->numConfiguredActuators());
+	}
+
+	// Print perf
+	perf_print_counter(_loop_perf);
+
+	return 0;
+}
+
+int ControlAllocator::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
+
+int ControlAllocator::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+This implements control allocation. It takes torque and thrust setpoints
+as inputs and outputs actuator setpoint messages.
+
+The effectiveness matrix of the airframe (CA_AIRFRAME) is computed at startup from
+the rotor geometry (CA_MC_R* parameters). For tilt-rotors only the columns of the
+tilting rotors are recomputed when the tilt changes.
+
+The actuator setpoints are published on `vehicle_actuator_setpoint` and on
+`actuator_controls_4` / `actuator_controls_5` for the output drivers.
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("control_allocator", "controller");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+extern "C" __EXPORT int control_allocator_main(int argc, char *argv[])
+{
+	return ControlAllocator::main(argc, argv);
+}
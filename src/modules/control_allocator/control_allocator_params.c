@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file control_allocator_params.c
+ *
+ * Parameters for the control allocator.
+ */
+
+/**
+ * Airframe ID
+ *
+ * This is used to retrieve pre-computed control effectiveness matrix
+ *
+ * @min 0
+ * @max 1
+ * @value 0 Multirotor
+ * @value 1 Tiltrotor
+ * @group Control Allocation
+ */
+PARAM_DEFINE_INT32(CA_AIRFRAME, 0);
+
+/**
+ * Control allocation method
+ *
+ * @value 0 Pseudo-inverse with output clipping
+ * @value 1 Pseudo-inverse with sequential desaturation technique
+ * @min 0
+ * @max 1
+ * @group Control Allocation
+ */
+PARAM_DEFINE_INT32(CA_METHOD, 1);
+
+/**
+ * Tilting rotors
+ *
+ * Rotors that are tilted forward by the tilt servo (Tiltrotor airframe only).
+ *
+ * @min 0
+ * @max 255
+ * @bit 0 Rotor 0
+ * @bit 1 Rotor 1
+ * @bit 2 Rotor 2
+ * @bit 3 Rotor 3
+ * @bit 4 Rotor 4
+ * @bit 5 Rotor 5
+ * @bit 6 Rotor 6
+ * @bit 7 Rotor 7
+ * @group Control Allocation
+ */
+PARAM_DEFINE_INT32(CA_TILT_MASK, 0);
+
+/**
+ * Maximum rotor tilt angle
+ *
+ * Rotor tilt at full tilt servo setpoint (Tiltrotor airframe only).
+ *
+ * @unit deg
+ * @min 0
+ * @max 120
+ * @decimal 1
+ * @increment 1
+ * @group Control Allocation
+ */
+PARAM_DEFINE_FLOAT(CA_TILT_MAX, 90.0f);
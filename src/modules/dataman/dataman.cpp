@@ -47,6 +47,8 @@
 #include <px4_platform_common/posix.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/getopt.h>
+#include <px4_platform_common/time.h>
+#include <limits.h>
 #include <drivers/drv_hrt.h>
 #include <lib/parameters/param.h>
 #include <lib/perf/perf_counter.h>
@@ -58,6 +60,13 @@
 #include <nuttx/progmem.h>
 #endif
 
+#if defined(__PX4_LINUX) || defined(__PX4_DARWIN)
+#define MMAP_BASED_DATAMAN
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 __BEGIN_DECLS
 __EXPORT int dataman_main(int argc, char *argv[]);
 __END_DECLS
@@ -72,6 +81,11 @@ static int  _file_clear(dm_item_t item);
 static int  _file_restart(dm_reset_reason reason);
 static int _file_initialize(unsigned max_offset);
 static void _file_shutdown();
+static int _file_wait(px4_sem_t *sem);
+
+/* Write-back cache of the file backend */
+#define FILE_CACHE_SLOTS 16
+#define FILE_CACHE_FLUSH_TIMEOUT_USEC USEC_PER_SEC
 
 /* Private Ram based Operations */
 static ssize_t _ram_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
@@ -96,6 +110,20 @@ static void _ram_flash_shutdown();
 static int _ram_flash_wait(px4_sem_t *sem);
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+/* Private memory mapped file based Operations */
+#define MMAP_FLUSH_TIMEOUT_USEC USEC_PER_SEC
+
+static ssize_t _mmap_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf,
+			   size_t count);
+static ssize_t _mmap_read(dm_item_t item, unsigned index, void *buf, size_t count);
+static int  _mmap_clear(dm_item_t item);
+static int  _mmap_restart(dm_reset_reason reason);
+static int _mmap_initialize(unsigned max_offset);
+static void _mmap_shutdown();
+static int _mmap_wait(px4_sem_t *sem);
+#endif
+
 typedef struct dm_operations_t {
 	ssize_t (*write)(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count);
 	ssize_t (*read)(dm_item_t item, unsigned index, void *buf, size_t count);
@@ -113,7 +141,7 @@ static constexpr dm_operations_t dm_file_operations = {
 	.restart = _file_restart,
 	.initialize = _file_initialize,
 	.shutdown = _file_shutdown,
-	.wait = px4_sem_wait,
+	.wait = _file_wait,
 };
 
 static constexpr dm_operations_t dm_ram_operations = {
@@ -138,12 +166,28 @@ static constexpr dm_operations_t dm_ram_flash_operations = {
 };
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+static constexpr dm_operations_t dm_mmap_operations = {
+	.write   = _mmap_write,
+	.read    = _mmap_read,
+	.clear   = _mmap_clear,
+	.restart = _mmap_restart,
+	.initialize = _mmap_initialize,
+	.shutdown = _mmap_shutdown,
+	.wait = _mmap_wait,
+};
+#endif
+
 static const dm_operations_t *g_dm_ops;
 
 static struct {
 	union {
 		struct {
 			int fd;
+			struct dm_file_cache_slot_s *cache;
+			uint32_t access_count;
+			unsigned cache_hits;
+			timespec flush_timeout;
 		} file;
 		struct {
 			uint8_t *data;
@@ -156,6 +200,16 @@ static struct {
 			/* sync above with RAM backend */
 			timespec flush_timeout;
 		} ram_flash;
+#endif
+#if defined(MMAP_BASED_DATAMAN)
+		struct {
+			uint8_t *data;
+			uint8_t *data_end;
+			/* sync above with RAM backend */
+			int fd;
+			size_t size;
+			timespec flush_timeout;
+		} mapped;
 #endif
 	};
 	bool running;
@@ -167,6 +221,8 @@ typedef enum {
 	dm_read_func,
 	dm_clear_func,
 	dm_restart_func,
+	dm_write_batch_func,
+	dm_read_batch_func,
 	dm_number_of_funcs
 } dm_function_t;
 
@@ -191,6 +247,21 @@ typedef struct {
 			void *buf;
 			size_t count;
 		} read_params;
+		struct {
+			dm_item_t item;
+			unsigned index;
+			dm_persitence_t persistence;
+			const void *buf;
+			size_t item_size;
+			unsigned num_items;
+		} write_batch_params;
+		struct {
+			dm_item_t item;
+			unsigned index;
+			void *buf;
+			size_t item_size;
+			unsigned num_items;
+		} read_batch_params;
 		struct {
 			dm_item_t item;
 		} clear_params;
@@ -229,6 +300,25 @@ static constexpr size_t g_per_item_size[DM_KEY_NUM_KEYS] = {
 	sizeof(struct dataman_compat_s) + DM_SECTOR_HDR_SIZE
 };
 
+static constexpr size_t max_item_size()
+{
+	size_t size = 0;
+
+	for (size_t item_size : g_per_item_size) {
+		size = item_size > size ? item_size : size;
+	}
+
+	return size;
+}
+
+/* Cached item of the file backend, data holds the header and the user data as stored in the file */
+typedef struct dm_file_cache_slot_s {
+	int offset;		/* file offset of the item, -1 if the slot is unused */
+	uint32_t last_used;	/* access counter value of the last access, for LRU replacement */
+	bool dirty;		/* needs to be written to the file */
+	uint8_t data[max_item_size()];
+} dm_file_cache_slot_t;
+
 /* Table of offset for index 0 of each item type */
 static unsigned int g_key_offsets[DM_KEY_NUM_KEYS];
 
@@ -248,12 +338,20 @@ static char *k_data_manager_device_path = nullptr;
 static const dm_sector_descriptor_t *k_dataman_flash_sector = nullptr;
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+/* Readers access the mapping directly from the calling thread, the worker thread holds it exclusively for changes */
+static pthread_rwlock_t g_mmap_lock = PTHREAD_RWLOCK_INITIALIZER;
+#endif
+
 static enum {
 	BACKEND_NONE = 0,
 	BACKEND_FILE,
 	BACKEND_RAM,
 #if defined(FLASH_BASED_DATAMAN)
 	BACKEND_RAM_FLASH,
+#endif
+#if defined(MMAP_BASED_DATAMAN)
+	BACKEND_MMAP,
 #endif
 	BACKEND_LAST
 } backend = BACKEND_NONE;
@@ -485,12 +583,143 @@ static ssize_t _ram_write(dm_item_t item, unsigned index, dm_persitence_t persis
 	return count;
 }
 
-/* write to the data manager file */
+/* Set an absolute timeout from now, used for delayed flushes */
+static void
+set_flush_timeout(timespec &abstime, uint64_t timeout_usec)
+{
+#if defined(__PX4_NUTTX)
+	const int ret = clock_gettime(CLOCK_REALTIME, &abstime);
+#else
+	// px4_sem_timedwait() uses the monotonic clock
+	const int ret = px4_clock_gettime(CLOCK_MONOTONIC, &abstime);
+#endif
+
+	if (ret == 0) {
+		const unsigned billion = 1000 * 1000 * 1000;
+		uint64_t nsecs = abstime.tv_nsec + timeout_usec * 1000;
+		abstime.tv_sec += nsecs / billion;
+		nsecs -= (nsecs / billion) * billion;
+		abstime.tv_nsec = nsecs;
+	}
+}
+
+/* Write a cached item to the file */
+static int
+_file_cache_write_back(dm_file_cache_slot_t *slot)
+{
+	const ssize_t len = slot->data[0] + DM_SECTOR_HDR_SIZE;
+
+	if (lseek(dm_operations_data.file.fd, slot->offset, SEEK_SET) != slot->offset) {
+		return -1;
+	}
+
+	if (write(dm_operations_data.file.fd, slot->data, len) != len) {
+		return -1;
+	}
+
+	slot->dirty = false;
+	return 0;
+}
+
+/* Write all modified items to the file */
+static int
+_file_cache_flush()
+{
+	int result = 0;
+	bool written = false;
+
+	/* reset the timeout even in error cases to avoid looping forever on a failing SD card */
+	dm_operations_data.file.flush_timeout.tv_sec = 0;
+	dm_operations_data.file.flush_timeout.tv_nsec = 0;
+
+	for (unsigned i = 0; i < FILE_CACHE_SLOTS; i++) {
+		dm_file_cache_slot_t *slot = &dm_operations_data.file.cache[i];
+
+		if (slot->offset >= 0 && slot->dirty) {
+			if (_file_cache_write_back(slot) != 0) {
+				PX4_WARN("cache write back failed at %d", slot->offset);
+				result = -1;
+			}
+
+			written = true;
+		}
+	}
+
+	/* Make sure data is written to physical media */
+	if (written) {
+		fsync(dm_operations_data.file.fd);
+	}
+
+	return result;
+}
+
+/* Drop the cached items with an offset in [start, end), without writing them */
+static void
+_file_cache_invalidate(int start, int end)
+{
+	for (unsigned i = 0; i < FILE_CACHE_SLOTS; i++) {
+		dm_file_cache_slot_t *slot = &dm_operations_data.file.cache[i];
+
+		if (slot->offset >= start && slot->offset < end) {
+			slot->offset = -1;
+			slot->dirty = false;
+		}
+	}
+}
+
+/* Get the cache slot of an item, replacing the least recently used item if it is not cached */
+static dm_file_cache_slot_t *
+_file_cache_get(dm_item_t item, int offset, bool load)
+{
+	dm_file_cache_slot_t *victim = nullptr;
+
+	for (unsigned i = 0; i < FILE_CACHE_SLOTS; i++) {
+		dm_file_cache_slot_t *slot = &dm_operations_data.file.cache[i];
+
+		if (slot->offset == offset) {
+			slot->last_used = ++dm_operations_data.file.access_count;
+			dm_operations_data.file.cache_hits++;
+			return slot;
+		}
+
+		if (victim == nullptr || (victim->offset >= 0 && (slot->offset < 0 || slot->last_used < victim->last_used))) {
+			victim = slot;
+		}
+	}
+
+	if (victim->offset >= 0 && victim->dirty && _file_cache_write_back(victim) != 0) {
+		return nullptr;
+	}
+
+	victim->offset = -1;
+
+	if (load) {
+		if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
+			return nullptr;
+		}
+
+		const int len = read(dm_operations_data.file.fd, victim->data, g_per_item_size[item]);
+
+		if (len < 0) {
+			return nullptr;
+		}
+
+		/* A zero length entry is a empty entry (the file can be shorter than the item) */
+		if (len < DM_SECTOR_HDR_SIZE) {
+			victim->data[0] = 0;
+		}
+	}
+
+	victim->offset = offset;
+	victim->dirty = false;
+	victim->last_used = ++dm_operations_data.file.access_count;
+	return victim;
+}
+
+/* write to the data manager file (cache) */
 static ssize_t
 _file_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
 {
-	unsigned char buffer[g_per_item_size[item]];
-
 	/* Get the offset for this item */
 	const int offset = calculate_offset(item, index);
 
@@ -504,7 +733,14 @@ _file_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const v
 		return -E2BIG;
 	}
 
+	dm_file_cache_slot_t *slot = _file_cache_get(item, offset, false);
+
+	if (slot == nullptr) {
+		return -1;
+	}
+
 	/* Write out the data, prefixed with length and persistence level */
+	uint8_t *buffer = slot->data;
 	buffer[0] = count;
 	buffer[1] = persistence;
 	buffer[2] = 0;
@@ -514,36 +750,22 @@ _file_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const v
 		memcpy(buffer + DM_SECTOR_HDR_SIZE, buf, count);
 	}
 
-	count += DM_SECTOR_HDR_SIZE;
+	/* It is written to the file with the next flush */
+	slot->dirty = true;
 
-	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) != offset) {
-		return -1;
+	if (dm_operations_data.file.flush_timeout.tv_sec == 0) {
+		set_flush_timeout(dm_operations_data.file.flush_timeout, FILE_CACHE_FLUSH_TIMEOUT_USEC);
 	}
 
-	if ((write(dm_operations_data.file.fd, buffer, count)) != (ssize_t)count) {
-		return -1;
-	}
-
-	/* Make sure data is written to physical media */
-	fsync(dm_operations_data.file.fd);
-
 	/* All is well... return the number of user data written */
-	return count - DM_SECTOR_HDR_SIZE;
+	return count;
 }
 
 #if defined(FLASH_BASED_DATAMAN)
 static void
 _ram_flash_update_flush_timeout()
 {
-	timespec &abstime = dm_operations_data.ram_flash.flush_timeout;
-
-	if (clock_gettime(CLOCK_REALTIME, &abstime) == 0) {
-		const unsigned billion = 1000 * 1000 * 1000;
-		uint64_t nsecs = abstime.tv_nsec + (uint64_t)RAM_FLASH_FLUSH_TIMEOUT_USEC * 1000;
-		abstime.tv_sec += nsecs / billion;
-		nsecs -= (nsecs / billion) * billion;
-		abstime.tv_nsec = nsecs;
-	}
+	set_flush_timeout(dm_operations_data.ram_flash.flush_timeout, RAM_FLASH_FLUSH_TIMEOUT_USEC);
 }
 
 static ssize_t
@@ -602,7 +824,7 @@ static ssize_t _ram_read(dm_item_t item, unsigned index, void *buf, size_t count
 	return buffer[0];
 }
 
-/* Retrieve from the data manager file */
+/* Retrieve from the data manager file (cache) */
 static ssize_t
 _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 {
@@ -610,8 +832,6 @@ _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 		return -1;
 	}
 
-	unsigned char buffer[g_per_item_size[item]];
-
 	/* Get the offset for this item */
 	int offset = calculate_offset(item, index);
 
@@ -626,21 +846,14 @@ _file_read(dm_item_t item, unsigned index, void *buf, size_t count)
 	}
 
 	/* Read the prefix and data */
-	int len = -1;
-
-	if (lseek(dm_operations_data.file.fd, offset, SEEK_SET) == offset) {
-		len = read(dm_operations_data.file.fd, buffer, count + DM_SECTOR_HDR_SIZE);
-	}
+	dm_file_cache_slot_t *slot = _file_cache_get(item, offset, true);
 
 	/* Check for read error */
-	if (len < 0) {
-		return -errno;
+	if (slot == nullptr) {
+		return errno > 0 ? -errno : -1;
 	}
 
-	/* A zero length entry is a empty entry */
-	if (len == 0) {
-		buffer[0] = 0;
-	}
+	const uint8_t *buffer = slot->data;
 
 	/* See if we got data */
 	if (buffer[0] > 0) {
@@ -707,6 +920,9 @@ _file_clear(dm_item_t item)
 		return -1;
 	}
 
+	/* Cached items of this type don't need to be written anymore */
+	_file_cache_invalidate(offset, offset + g_per_item_max_index[item] * g_per_item_size[item]);
+
 	/* Clear all items of this type */
 	for (i = 0; (unsigned)i < g_per_item_max_index[item]; i++) {
 		char buf[1];
@@ -804,6 +1020,11 @@ _file_restart(dm_reset_reason reason)
 {
 	int offset = 0;
 	int result = 0;
+
+	/* Write back and drop the cache, the file is modified directly */
+	_file_cache_flush();
+	_file_cache_invalidate(0, INT_MAX);
+
 	/* We need to scan the entire file and invalidate and data that should not persist after the last reset */
 
 	/* Loop through all of the data segments and delete those that are not persistent */
@@ -882,6 +1103,24 @@ _ram_flash_restart(dm_reset_reason reason)
 static int
 _file_initialize(unsigned max_offset)
 {
+	dm_operations_data.file.cache = (dm_file_cache_slot_t *)malloc(FILE_CACHE_SLOTS * sizeof(dm_file_cache_slot_t));
+
+	if (dm_operations_data.file.cache == nullptr) {
+		PX4_WARN("Could not allocate the data manager cache");
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	dm_operations_data.file.access_count = 0;
+	dm_operations_data.file.cache_hits = 0;
+	dm_operations_data.file.flush_timeout.tv_sec = 0;
+	dm_operations_data.file.flush_timeout.tv_nsec = 0;
+
+	for (unsigned i = 0; i < FILE_CACHE_SLOTS; i++) {
+		dm_operations_data.file.cache[i].offset = -1;
+		dm_operations_data.file.cache[i].dirty = false;
+	}
+
 	/* See if the data manage file exists and is a multiple of the sector size */
 	dm_operations_data.file.fd = open(k_data_manager_device_path, O_RDONLY | O_BINARY);
 
@@ -899,6 +1138,7 @@ _file_initialize(unsigned max_offset)
 		}
 
 		close(dm_operations_data.file.fd);
+		_file_cache_invalidate(0, INT_MAX);
 
 		if (incompat) {
 			unlink(k_data_manager_device_path);
@@ -910,12 +1150,14 @@ _file_initialize(unsigned max_offset)
 
 	if (dm_operations_data.file.fd < 0) {
 		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		free(dm_operations_data.file.cache);
 		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
 		return -1;
 	}
 
 	if ((unsigned)lseek(dm_operations_data.file.fd, max_offset, SEEK_SET) != max_offset) {
 		close(dm_operations_data.file.fd);
+		free(dm_operations_data.file.cache);
 		PX4_WARN("Could not seek data manager file %s", k_data_manager_device_path);
 		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
 		return -1;
@@ -930,7 +1172,7 @@ _file_initialize(unsigned max_offset)
 		PX4_ERR("Failed writing compat: %d", ret);
 	}
 
-	fsync(dm_operations_data.file.fd);
+	_file_cache_flush();
 	dm_operations_data.running = true;
 
 	return 0;
@@ -996,10 +1238,34 @@ _ram_flash_initialize(unsigned max_offset)
 static void
 _file_shutdown()
 {
+	_file_cache_flush();
 	close(dm_operations_data.file.fd);
+	free(dm_operations_data.file.cache);
+	dm_operations_data.file.cache = nullptr;
 	dm_operations_data.running = false;
 }
 
+static int
+_file_wait(px4_sem_t *sem)
+{
+	if (!dm_operations_data.file.flush_timeout.tv_sec) {
+		px4_sem_wait(sem);
+		return 0;
+	}
+
+	int ret;
+
+	while ((ret = px4_sem_timedwait(sem, &dm_operations_data.file.flush_timeout)) == -1 && errno == EINTR);
+
+	if (ret == 0) {
+		/* a work was queued before timeout */
+		return 0;
+	}
+
+	_file_cache_flush();
+	return 0;
+}
+
 static void
 _ram_shutdown()
 {
@@ -1067,6 +1333,169 @@ _ram_flash_wait(px4_sem_t *sem)
 }
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+static ssize_t
+_mmap_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
+{
+	pthread_rwlock_wrlock(&g_mmap_lock);
+	ssize_t ret = dm_ram_operations.write(item, index, persistence, buf, count);
+	pthread_rwlock_unlock(&g_mmap_lock);
+
+	/* Only items which survive a power on reset need to reach the file soon */
+	if (ret > 0 && persistence == DM_PERSIST_POWER_ON_RESET && dm_operations_data.mapped.flush_timeout.tv_sec == 0) {
+		set_flush_timeout(dm_operations_data.mapped.flush_timeout, MMAP_FLUSH_TIMEOUT_USEC);
+	}
+
+	return ret;
+}
+
+/* Called from the worker thread and directly from dm_read() */
+static ssize_t
+_mmap_read(dm_item_t item, unsigned index, void *buf, size_t count)
+{
+	pthread_rwlock_rdlock(&g_mmap_lock);
+	ssize_t ret = -1;
+
+	if (dm_operations_data.mapped.data != nullptr) {
+		ret = dm_ram_operations.read(item, index, buf, count);
+	}
+
+	pthread_rwlock_unlock(&g_mmap_lock);
+	return ret;
+}
+
+static void
+_mmap_flush()
+{
+	/* reset the timeout even in error cases to avoid looping forever */
+	dm_operations_data.mapped.flush_timeout.tv_sec = 0;
+	dm_operations_data.mapped.flush_timeout.tv_nsec = 0;
+
+	if (msync(dm_operations_data.mapped.data, dm_operations_data.mapped.size, MS_SYNC) != 0) {
+		PX4_WARN("msync failed (%i)", errno);
+	}
+}
+
+static int
+_mmap_clear(dm_item_t item)
+{
+	pthread_rwlock_wrlock(&g_mmap_lock);
+	int ret = dm_ram_operations.clear(item);
+	pthread_rwlock_unlock(&g_mmap_lock);
+
+	_mmap_flush();
+	return ret;
+}
+
+static int
+_mmap_restart(dm_reset_reason reason)
+{
+	pthread_rwlock_wrlock(&g_mmap_lock);
+	int ret = dm_ram_operations.restart(reason);
+	pthread_rwlock_unlock(&g_mmap_lock);
+
+	_mmap_flush();
+	return ret;
+}
+
+static int
+_mmap_initialize(unsigned max_offset)
+{
+	dm_operations_data.mapped.flush_timeout.tv_sec = 0;
+	dm_operations_data.mapped.flush_timeout.tv_nsec = 0;
+
+	/* The layout is the same as the one of the file backend, so both can use the same file */
+	dm_operations_data.mapped.fd = open(k_data_manager_device_path, O_RDWR | O_CREAT | O_BINARY, PX4_O_MODE_666);
+
+	if (dm_operations_data.mapped.fd < 0) {
+		PX4_WARN("Could not open data manager file %s", k_data_manager_device_path);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	/* Grow the file if needed, the new part reads as empty items */
+	struct stat st;
+
+	if (fstat(dm_operations_data.mapped.fd, &st) != 0
+	    || ((unsigned)st.st_size < max_offset && ftruncate(dm_operations_data.mapped.fd, max_offset) != 0)) {
+		PX4_WARN("Could not resize data manager file %s", k_data_manager_device_path);
+		close(dm_operations_data.mapped.fd);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	void *data = mmap(nullptr, max_offset, PROT_READ | PROT_WRITE, MAP_SHARED, dm_operations_data.mapped.fd, 0);
+
+	if (data == MAP_FAILED) {
+		PX4_WARN("Could not map data manager file %s (%i)", k_data_manager_device_path, errno);
+		close(dm_operations_data.mapped.fd);
+		px4_sem_post(&g_init_sema); /* Don't want to hang startup */
+		return -1;
+	}
+
+	dm_operations_data.mapped.data = (uint8_t *)data;
+	dm_operations_data.mapped.data_end = &dm_operations_data.mapped.data[max_offset - 1];
+	dm_operations_data.mapped.size = max_offset;
+
+	struct dataman_compat_s compat_state;
+	ssize_t ret = g_dm_ops->read(DM_KEY_COMPAT, 0, &compat_state, sizeof(compat_state));
+
+	if (ret != sizeof(compat_state) || compat_state.key != DM_COMPAT_KEY) {
+		/* Not compatible: clear everything and write the current compat info */
+		memset(dm_operations_data.mapped.data, 0, max_offset);
+
+		compat_state.key = DM_COMPAT_KEY;
+		ret = g_dm_ops->write(DM_KEY_COMPAT, 0, DM_PERSIST_POWER_ON_RESET, &compat_state, sizeof(compat_state));
+
+		if (ret != sizeof(compat_state)) {
+			PX4_ERR("Failed writing compat: %d", (int)ret);
+		}
+
+		_mmap_flush();
+	}
+
+	dm_operations_data.running = true;
+
+	return 0;
+}
+
+static void
+_mmap_shutdown()
+{
+	_mmap_flush();
+
+	pthread_rwlock_wrlock(&g_mmap_lock);
+	munmap(dm_operations_data.mapped.data, dm_operations_data.mapped.size);
+	dm_operations_data.mapped.data = nullptr;
+	dm_operations_data.mapped.data_end = nullptr;
+	pthread_rwlock_unlock(&g_mmap_lock);
+
+	close(dm_operations_data.mapped.fd);
+	dm_operations_data.running = false;
+}
+
+static int
+_mmap_wait(px4_sem_t *sem)
+{
+	if (!dm_operations_data.mapped.flush_timeout.tv_sec) {
+		px4_sem_wait(sem);
+		return 0;
+	}
+
+	int ret;
+
+	while ((ret = px4_sem_timedwait(sem, &dm_operations_data.mapped.flush_timeout)) == -1 && errno == EINTR);
+
+	if (ret == 0) {
+		/* a work was queued before timeout */
+		return 0;
+	}
+
+	_mmap_flush();
+	return 0;
+}
+#endif
+
 /** Write to the data manager file */
 __EXPORT ssize_t
 dm_write(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t count)
@@ -1112,6 +1541,18 @@ dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
 
 	perf_begin(_dm_read_perf);
 
+#if defined(MMAP_BASED_DATAMAN)
+
+	/* Items are read directly from the mapping, without a round trip through the worker thread */
+	if (backend == BACKEND_MMAP) {
+		g_func_counts[dm_read_func]++;
+		ssize_t ret = _mmap_read(item, index, buf, count);
+		perf_end(_dm_read_perf);
+		return ret;
+	}
+
+#endif
+
 	/* get a work item and queue up a read request */
 	if ((work = create_work_item()) == nullptr) {
 		perf_end(_dm_read_perf);
@@ -1130,6 +1571,90 @@ dm_read(dm_item_t item, unsigned index, void *buf, size_t count)
 	return ret;
 }
 
+/** Write consecutive items to the data manager file */
+__EXPORT ssize_t
+dm_write_batch(dm_item_t item, unsigned index, dm_persitence_t persistence, const void *buf, size_t item_size,
+	       unsigned num_items)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	perf_begin(_dm_write_perf);
+
+	/* get a work item and queue up a write request */
+	if ((work = create_work_item()) == nullptr) {
+		perf_end(_dm_write_perf);
+		return -1;
+	}
+
+	work->func = dm_write_batch_func;
+	work->write_batch_params.item = item;
+	work->write_batch_params.index = index;
+	work->write_batch_params.persistence = persistence;
+	work->write_batch_params.buf = buf;
+	work->write_batch_params.item_size = item_size;
+	work->write_batch_params.num_items = num_items;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	ssize_t ret = (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	perf_end(_dm_write_perf);
+	return ret;
+}
+
+/** Retrieve consecutive items from the data manager file */
+__EXPORT ssize_t
+dm_read_batch(dm_item_t item, unsigned index, void *buf, size_t item_size, unsigned num_items)
+{
+	work_q_item_t *work;
+
+	/* Make sure data manager has been started and is not shutting down */
+	if (!is_running() || g_task_should_exit) {
+		return -1;
+	}
+
+	perf_begin(_dm_read_perf);
+
+#if defined(MMAP_BASED_DATAMAN)
+
+	if (backend == BACKEND_MMAP) {
+		g_func_counts[dm_read_batch_func]++;
+		unsigned i;
+
+		for (i = 0; i < num_items; i++) {
+			if (_mmap_read(item, index + i, (uint8_t *)buf + i * item_size, item_size) != (ssize_t)item_size) {
+				break;
+			}
+		}
+
+		perf_end(_dm_read_perf);
+		return (i == 0 && num_items > 0) ? -1 : (ssize_t)i;
+	}
+
+#endif
+
+	/* get a work item and queue up a read request */
+	if ((work = create_work_item()) == nullptr) {
+		perf_end(_dm_read_perf);
+		return -1;
+	}
+
+	work->func = dm_read_batch_func;
+	work->read_batch_params.item = item;
+	work->read_batch_params.index = index;
+	work->read_batch_params.buf = buf;
+	work->read_batch_params.item_size = item_size;
+	work->read_batch_params.num_items = num_items;
+
+	/* Enqueue the item on the work queue and wait for the worker thread to complete processing it */
+	ssize_t ret = (ssize_t)enqueue_work_item_and_wait_for_result(work);
+	perf_end(_dm_read_perf);
+	return ret;
+}
+
 /** Clear a data Item */
 __EXPORT int
 dm_clear(dm_item_t item)
@@ -1247,6 +1772,45 @@ dm_flash_sector_description_set(const dm_sector_descriptor_t *description)
 }
 #endif
 
+/* Write consecutive items in the worker thread, returns the number of items written or -1 if none */
+static ssize_t
+write_batch(const work_q_item_t *work)
+{
+	const uint8_t *buf = (const uint8_t *)work->write_batch_params.buf;
+	unsigned i;
+
+	for (i = 0; i < work->write_batch_params.num_items; i++) {
+		ssize_t ret = g_dm_ops->write(work->write_batch_params.item, work->write_batch_params.index + i,
+					      work->write_batch_params.persistence, buf + i * work->write_batch_params.item_size,
+					      work->write_batch_params.item_size);
+
+		if (ret != (ssize_t)work->write_batch_params.item_size) {
+			break;
+		}
+	}
+
+	return (i == 0 && work->write_batch_params.num_items > 0) ? -1 : (ssize_t)i;
+}
+
+/* Read consecutive items in the worker thread, returns the number of complete items read or -1 if none */
+static ssize_t
+read_batch(const work_q_item_t *work)
+{
+	uint8_t *buf = (uint8_t *)work->read_batch_params.buf;
+	unsigned i;
+
+	for (i = 0; i < work->read_batch_params.num_items; i++) {
+		ssize_t ret = g_dm_ops->read(work->read_batch_params.item, work->read_batch_params.index + i,
+					     buf + i * work->read_batch_params.item_size, work->read_batch_params.item_size);
+
+		if (ret != (ssize_t)work->read_batch_params.item_size) {
+			break;
+		}
+	}
+
+	return (i == 0 && work->read_batch_params.num_items > 0) ? -1 : (ssize_t)i;
+}
+
 static int
 task_main(int argc, char *argv[])
 {
@@ -1267,6 +1831,13 @@ task_main(int argc, char *argv[])
 		break;
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+
+	case BACKEND_MMAP:
+		g_dm_ops = &dm_mmap_operations;
+		break;
+#endif
+
 	default:
 		PX4_WARN("No valid backend set.");
 		return -1;
@@ -1358,6 +1929,14 @@ task_main(int argc, char *argv[])
 		break;
 #endif
 
+#if defined(MMAP_BASED_DATAMAN)
+
+	case BACKEND_MMAP:
+		PX4_INFO("%s, data manager mapped file '%s' size is %d bytes",
+			 restart_type_str, k_data_manager_device_path, max_offset);
+		break;
+#endif
+
 	default:
 		break;
 	}
@@ -1393,6 +1972,16 @@ task_main(int argc, char *argv[])
 					g_dm_ops->read(work->read_params.item, work->read_params.index, work->read_params.buf, work->read_params.count);
 				break;
 
+			case dm_write_batch_func:
+				g_func_counts[dm_write_batch_func]++;
+				work->result = write_batch(work);
+				break;
+
+			case dm_read_batch_func:
+				g_func_counts[dm_read_batch_func]++;
+				work->result = read_batch(work);
+				break;
+
 			case dm_clear_func:
 				g_func_counts[dm_clear_func]++;
 				work->result = g_dm_ops->clear(work->clear_params.item);
@@ -1482,6 +2071,12 @@ status()
 	PX4_INFO("Reads    %d", g_func_counts[dm_read_func]);
 	PX4_INFO("Clears   %d", g_func_counts[dm_clear_func]);
 	PX4_INFO("Restarts %d", g_func_counts[dm_restart_func]);
+	PX4_INFO("Batch writes %d", g_func_counts[dm_write_batch_func]);
+	PX4_INFO("Batch reads  %d", g_func_counts[dm_read_batch_func]);
+
+	if (backend == BACKEND_FILE && dm_operations_data.file.cache != nullptr) {
+		PX4_INFO("Cache hits %u", dm_operations_data.file.cache_hits);
+	}
 	PX4_INFO("Max Q lengths work %d, free %d", g_work_q.max_size, g_free_q.max_size);
 	perf_print_counter(_dm_read_perf);
 	perf_print_counter(_dm_write_perf);
@@ -1504,6 +2099,7 @@ usage()
 Module to provide persistent storage for the rest of the system in form of a simple database through a C API.
 Multiple backends are supported:
 - a file (eg. on the SD card)
+- a memory mapped file (POSIX only), readers access the items without going through the worker thread
 - FLASH (if the board supports it)
 - FRAM
 - RAM (this is obviously not persistent)
@@ -1527,6 +2123,7 @@ check for geofence violations.
 	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Storage file", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('r', "Use RAM backend (NOT persistent)", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('i', "Use FLASH backend", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('m', "Memory map the storage file (POSIX only)", true);
 	PRINT_MODULE_USAGE_PARAM_COMMENT("The options -f, -r and -i are mutually exclusive. If nothing is specified, a file 'dataman' is used");
 
 	PRINT_MODULE_USAGE_COMMAND_DESCR("poweronrestart", "Restart dataman (on power on)");
@@ -1566,7 +2163,11 @@ dataman_main(int argc, char *argv[])
 
 		/* jump over start and look at options first */
 
-		while ((ch = px4_getopt(argc, argv, "f:ri", &dmoptind, &dmoptarg)) != EOF) {
+#if defined(MMAP_BASED_DATAMAN)
+		bool use_mmap = false;
+#endif
+
+		while ((ch = px4_getopt(argc, argv, "f:rim", &dmoptind, &dmoptarg)) != EOF) {
 			switch (ch) {
 			case 'f':
 				if (backend_check()) {
@@ -1604,6 +2205,15 @@ dataman_main(int argc, char *argv[])
 				return -1;
 #endif
 
+			case 'm':
+#if defined(MMAP_BASED_DATAMAN)
+				use_mmap = true;
+				break;
+#else
+				PX4_WARN("Memory mapped backend is not available");
+				return -1;
+#endif
+
 			//no break
 			default:
 				usage();
@@ -1616,6 +2226,20 @@ dataman_main(int argc, char *argv[])
 			k_data_manager_device_path = strdup(default_device_path);
 		}
 
+#if defined(MMAP_BASED_DATAMAN)
+
+		if (use_mmap) {
+			if (backend != BACKEND_FILE) {
+				PX4_WARN("-m can only be used with a storage file");
+				usage();
+				return -1;
+			}
+
+			backend = BACKEND_MMAP;
+		}
+
+#endif
+
 		start();
 
 		if (!is_running()) {
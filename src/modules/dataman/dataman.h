@@ -125,6 +125,33 @@ dm_write(
 	size_t buflen			/* Length in bytes of data to retrieve */
 );
 
+/**
+ * Retrieve consecutive items of a type from the data manager store with a single request.
+ * @return the number of items read with exactly item_size bytes (reading stops at the first item that is not), -1 on error
+ */
+__EXPORT ssize_t
+dm_read_batch(
+	dm_item_t item,			/* The item type to retrieve */
+	unsigned index,			/* The index of the first item */
+	void *buffer,			/* Pointer to caller data buffer, num_items * item_size bytes */
+	size_t item_size,		/* Length in bytes of each item */
+	unsigned num_items		/* Number of items to retrieve */
+);
+
+/**
+ * Write consecutive items of a type to the data manager store with a single request.
+ * @return the number of items written (writing stops at the first failure), -1 on error
+ */
+__EXPORT ssize_t
+dm_write_batch(
+	dm_item_t  item,		/* The item type to store */
+	unsigned index,			/* The index of the first item */
+	dm_persitence_t persistence,	/* The persistence level of the items */
+	const void *buffer,		/* Pointer to caller data buffer, num_items * item_size bytes */
+	size_t item_size,		/* Length in bytes of each item */
+	unsigned num_items		/* Number of items to store */
+);
+
 /**
  * Lock all items of a type. Can be used for atomic updates of multiple items (single items are always updated
  * atomically).
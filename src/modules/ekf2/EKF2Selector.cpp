@@ -0,0 +1,302 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "EKF2Selector.hpp"
+
+using matrix::Quatf;
+
+EKF2Selector::EKF2Selector() :
+	ScheduledWorkItem("ekf2_selector", px4::wq_configurations::navigation_and_controllers)
+{
+}
+
+EKF2Selector::~EKF2Selector()
+{
+	Stop();
+}
+
+bool EKF2Selector::Start()
+{
+	// the callbacks of the selected instance trigger the republishing, the interval is a watchdog for the
+	// health checks in case the selected instance stops publishing altogether
+	ScheduleOnInterval(FILTER_UPDATE_PERIOD);
+	return true;
+}
+
+void EKF2Selector::Stop()
+{
+	for (auto &inst : _instance) {
+		inst.estimator_attitude_sub.unregisterCallback();
+		inst.estimator_local_position_sub.unregisterCallback();
+	}
+
+	ScheduleClear();
+}
+
+void EKF2Selector::SelectInstance(uint8_t instance)
+{
+	if (instance == _selected_instance) {
+		return;
+	}
+
+	if (_selected_instance != INVALID_INSTANCE) {
+		_instance[_selected_instance].estimator_attitude_sub.unregisterCallback();
+		_instance[_selected_instance].estimator_local_position_sub.unregisterCallback();
+
+		PX4_WARN("primary EKF changed %d -> %d", _selected_instance, instance);
+		_instance_changed_count++;
+	}
+
+	_instance[instance].estimator_attitude_sub.registerCallback();
+	_instance[instance].estimator_local_position_sub.registerCallback();
+
+	_selected_instance = instance;
+	_candidate_instance = INVALID_INSTANCE;
+	_candidate_since = 0;
+
+	_attitude_switched = true;
+	_local_position_switched = true;
+	_global_position_switched = true;
+}
+
+void EKF2Selector::UpdateErrorScores(const hrt_abstime &now)
+{
+	for (auto &inst : _instance) {
+		inst.estimator_status_sub.update(&inst.estimator_status);
+
+		const estimator_status_s &status = inst.estimator_status;
+
+		const bool tilt_aligned = status.control_mode_flags & (1 << estimator_status_s::CS_TILT_ALIGN);
+
+		inst.healthy = (status.timestamp != 0) && (now < status.timestamp + STATUS_TIMEOUT)
+			       && (status.filter_fault_flags == 0) && tilt_aligned;
+
+		inst.combined_test_ratio = math::max(math::max(status.vel_test_ratio, status.pos_test_ratio),
+						     math::max(status.hgt_test_ratio, status.mag_test_ratio));
+	}
+}
+
+void EKF2Selector::Run()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	UpdateErrorScores(now);
+
+	// best healthy instance (lowest error score)
+	uint8_t best = INVALID_INSTANCE;
+
+	for (uint8_t i = 0; i < MAX_INSTANCES; i++) {
+		if (_instance[i].healthy
+		    && ((best == INVALID_INSTANCE) || (_instance[i].combined_test_ratio < _instance[best].combined_test_ratio))) {
+			best = i;
+		}
+	}
+
+	if ((_selected_instance == INVALID_INSTANCE) || !_instance[_selected_instance].healthy) {
+		// switch immediately away from a failed instance
+		if (best != INVALID_INSTANCE) {
+			SelectInstance(best);
+		}
+
+	} else if ((best != _selected_instance)
+		   && (_instance[best].combined_test_ratio + SWITCH_HYSTERESIS < _instance[_selected_instance].combined_test_ratio)) {
+		// only switch to a better instance if it stays better
+		if (best != _candidate_instance) {
+			_candidate_instance = best;
+			_candidate_since = now;
+
+		} else if (now > _candidate_since + SWITCH_DELAY) {
+			SelectInstance(best);
+		}
+
+	} else {
+		_candidate_instance = INVALID_INSTANCE;
+		_candidate_since = 0;
+	}
+
+	if (_selected_instance != INVALID_INSTANCE) {
+		PublishVehicleAttitude();
+		PublishVehicleLocalPosition();
+		PublishVehicleGlobalPosition();
+		PublishVehicleOdometry();
+	}
+}
+
+void EKF2Selector::PublishVehicleAttitude()
+{
+	vehicle_attitude_s attitude;
+
+	if (_instance[_selected_instance].estimator_attitude_sub.update(&attitude)) {
+		if (_attitude_switched) {
+			// report the instance change as a reset, so that the consumers don't see a step
+			if (_attitude_last.timestamp != 0) {
+				const Quatf delta_q = Quatf(attitude.q) * Quatf(_attitude_last.q).inversed();
+				delta_q.copyTo(attitude.delta_q_reset);
+				_quat_reset_counter++;
+			}
+
+			_attitude_switched = false;
+
+		} else if (attitude.quat_reset_counter != _instance_quat_reset_counter) {
+			// reset of the selected instance itself
+			_quat_reset_counter++;
+		}
+
+		_instance_quat_reset_counter = attitude.quat_reset_counter;
+		attitude.quat_reset_counter = _quat_reset_counter;
+
+		_attitude_last = attitude;
+		_vehicle_attitude_pub.publish(attitude);
+	}
+}
+
+void EKF2Selector::PublishVehicleLocalPosition()
+{
+	vehicle_local_position_s local_position;
+
+	if (_instance[_selected_instance].estimator_local_position_sub.update(&local_position)) {
+		if (_local_position_switched) {
+			if (_local_position_last.timestamp != 0) {
+				local_position.delta_xy[0] = local_position.x - _local_position_last.x;
+				local_position.delta_xy[1] = local_position.y - _local_position_last.y;
+				_xy_reset_counter++;
+
+				local_position.delta_z = local_position.z - _local_position_last.z;
+				_z_reset_counter++;
+
+				local_position.delta_vxy[0] = local_position.vx - _local_position_last.vx;
+				local_position.delta_vxy[1] = local_position.vy - _local_position_last.vy;
+				_vxy_reset_counter++;
+
+				local_position.delta_vz = local_position.vz - _local_position_last.vz;
+				_vz_reset_counter++;
+			}
+
+			_local_position_switched = false;
+
+		} else {
+			if (local_position.xy_reset_counter != _instance_xy_reset_counter) {
+				_xy_reset_counter++;
+			}
+
+			if (local_position.z_reset_counter != _instance_z_reset_counter) {
+				_z_reset_counter++;
+			}
+
+			if (local_position.vxy_reset_counter != _instance_vxy_reset_counter) {
+				_vxy_reset_counter++;
+			}
+
+			if (local_position.vz_reset_counter != _instance_vz_reset_counter) {
+				_vz_reset_counter++;
+			}
+		}
+
+		_instance_xy_reset_counter = local_position.xy_reset_counter;
+		_instance_z_reset_counter = local_position.z_reset_counter;
+		_instance_vxy_reset_counter = local_position.vxy_reset_counter;
+		_instance_vz_reset_counter = local_position.vz_reset_counter;
+
+		local_position.xy_reset_counter = _xy_reset_counter;
+		local_position.z_reset_counter = _z_reset_counter;
+		local_position.vxy_reset_counter = _vxy_reset_counter;
+		local_position.vz_reset_counter = _vz_reset_counter;
+
+		_local_position_last = local_position;
+		_vehicle_local_position_pub.publish(local_position);
+	}
+}
+
+void EKF2Selector::PublishVehicleGlobalPosition()
+{
+	vehicle_global_position_s global_position;
+
+	if (_instance[_selected_instance].estimator_global_position_sub.update(&global_position)) {
+		if (_global_position_switched) {
+			if (_global_position_last.timestamp != 0) {
+				_lat_lon_reset_counter++;
+
+				global_position.delta_alt = global_position.alt - _global_position_last.alt;
+				_alt_reset_counter++;
+			}
+
+			_global_position_switched = false;
+
+		} else {
+			if (global_position.lat_lon_reset_counter != _instance_lat_lon_reset_counter) {
+				_lat_lon_reset_counter++;
+			}
+
+			if (global_position.alt_reset_counter != _instance_alt_reset_counter) {
+				_alt_reset_counter++;
+			}
+		}
+
+		_instance_lat_lon_reset_counter = global_position.lat_lon_reset_counter;
+		_instance_alt_reset_counter = global_position.alt_reset_counter;
+
+		global_position.lat_lon_reset_counter = _lat_lon_reset_counter;
+		global_position.alt_reset_counter = _alt_reset_counter;
+
+		_global_position_last = global_position;
+		_vehicle_global_position_pub.publish(global_position);
+	}
+}
+
+void EKF2Selector::PublishVehicleOdometry()
+{
+	vehicle_odometry_s odometry;
+
+	if (_instance[_selected_instance].estimator_odometry_sub.update(&odometry)) {
+		_vehicle_odometry_pub.publish(odometry);
+	}
+
+	if (_instance[_selected_instance].estimator_visual_odometry_aligned_sub.update(&odometry)) {
+		_vehicle_visual_odometry_aligned_pub.publish(odometry);
+	}
+}
+
+void EKF2Selector::PrintStatus()
+{
+	PX4_INFO("selected instance: %d, changes: %u", (_selected_instance != INVALID_INSTANCE) ? _selected_instance : -1,
+		 _instance_changed_count);
+
+	for (uint8_t i = 0; i < MAX_INSTANCES; i++) {
+		const EstimatorInstance &inst = _instance[i];
+
+		if (inst.estimator_status.timestamp != 0) {
+			PX4_INFO("%d: %s, test ratio: %.3f, filter faults: 0x%x", i, inst.healthy ? "healthy" : "unhealthy",
+				 (double)inst.combined_test_ratio, inst.estimator_status.filter_fault_flags);
+		}
+	}
+}
@@ -0,0 +1,155 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file EKF2Selector.hpp
+ * Selects the healthiest of several parallel EKF2 instances and republishes its outputs
+ * as vehicle_attitude, vehicle_local_position, vehicle_global_position and vehicle_odometry.
+ */
+
+#pragma once
+
+#include <lib/mathlib/mathlib.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <px4_platform_common/time.h>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/estimator_status.h>
+#include <uORB/topics/vehicle_attitude.h>
+#include <uORB/topics/vehicle_global_position.h>
+#include <uORB/topics/vehicle_local_position.h>
+#include <uORB/topics/vehicle_odometry.h>
+
+using namespace time_literals;
+
+class EKF2Selector : public px4::ScheduledWorkItem
+{
+public:
+	static constexpr uint8_t MAX_INSTANCES{3};
+
+	EKF2Selector();
+	~EKF2Selector() override;
+
+	bool Start();
+	void Stop();
+
+	void PrintStatus();
+
+private:
+	static constexpr uint8_t INVALID_INSTANCE{UINT8_MAX};
+
+	static constexpr hrt_abstime FILTER_UPDATE_PERIOD{10_ms};	///< health check interval without new attitude data
+	static constexpr hrt_abstime STATUS_TIMEOUT{100_ms};		///< estimator_status is published on every filter update
+	static constexpr float SWITCH_HYSTERESIS{0.2f};			///< test ratio margin a better instance needs ...
+	static constexpr hrt_abstime SWITCH_DELAY{1_s};			///< ... continuously for this long before switching
+
+	void Run() override;
+
+	void UpdateErrorScores(const hrt_abstime &now);
+	void SelectInstance(uint8_t instance);
+
+	void PublishVehicleAttitude();
+	void PublishVehicleLocalPosition();
+	void PublishVehicleGlobalPosition();
+	void PublishVehicleOdometry();
+
+	struct EstimatorInstance {
+		EstimatorInstance(EKF2Selector *selector, uint8_t i) :
+			estimator_attitude_sub{selector, ORB_ID(estimator_attitude), i},
+			estimator_local_position_sub{selector, ORB_ID(estimator_local_position), i},
+			estimator_global_position_sub{ORB_ID(estimator_global_position), i},
+			estimator_odometry_sub{ORB_ID(estimator_odometry), i},
+			estimator_visual_odometry_aligned_sub{ORB_ID(estimator_visual_odometry_aligned), i},
+			estimator_status_sub{ORB_ID(estimator_status), i}
+		{}
+
+		uORB::SubscriptionCallbackWorkItem estimator_attitude_sub;
+		uORB::SubscriptionCallbackWorkItem estimator_local_position_sub;
+		uORB::Subscription estimator_global_position_sub;
+		uORB::Subscription estimator_odometry_sub;
+		uORB::Subscription estimator_visual_odometry_aligned_sub;
+		uORB::Subscription estimator_status_sub;
+
+		estimator_status_s estimator_status{};
+
+		float combined_test_ratio{0.f};		///< largest innovation test ratio, the error score (lower is better)
+		bool healthy{false};
+	};
+
+	EstimatorInstance _instance[MAX_INSTANCES] {
+		{this, 0},
+		{this, 1},
+		{this, 2},
+	};
+
+	uint8_t _selected_instance{INVALID_INSTANCE};
+	uint8_t _candidate_instance{INVALID_INSTANCE};
+	hrt_abstime _candidate_since{0};	///< time the candidate became better than the selected instance
+	unsigned _instance_changed_count{0};
+
+	// an instance change is reported to the consumers as an estimator reset
+	bool _attitude_switched{false};
+	bool _local_position_switched{false};
+	bool _global_position_switched{false};
+
+	// last published output and reset counters of the selected instance (to detect its own resets)
+	vehicle_attitude_s _attitude_last{};
+	vehicle_local_position_s _local_position_last{};
+	vehicle_global_position_s _global_position_last{};
+
+	uint8_t _instance_quat_reset_counter{0};
+	uint8_t _instance_xy_reset_counter{0};
+	uint8_t _instance_z_reset_counter{0};
+	uint8_t _instance_vxy_reset_counter{0};
+	uint8_t _instance_vz_reset_counter{0};
+	uint8_t _instance_lat_lon_reset_counter{0};
+	uint8_t _instance_alt_reset_counter{0};
+
+	// reset counters as published
+	uint8_t _quat_reset_counter{0};
+	uint8_t _xy_reset_counter{0};
+	uint8_t _z_reset_counter{0};
+	uint8_t _vxy_reset_counter{0};
+	uint8_t _vz_reset_counter{0};
+	uint8_t _lat_lon_reset_counter{0};
+	uint8_t _alt_reset_counter{0};
+
+	uORB::Publication<vehicle_attitude_s>		_vehicle_attitude_pub{ORB_ID(vehicle_attitude)};
+	uORB::Publication<vehicle_local_position_s>	_vehicle_local_position_pub{ORB_ID(vehicle_local_position)};
+	uORB::Publication<vehicle_global_position_s>	_vehicle_global_position_pub{ORB_ID(vehicle_global_position)};
+	uORB::Publication<vehicle_odometry_s>		_vehicle_odometry_pub{ORB_ID(vehicle_odometry)};
+	uORB::Publication<vehicle_odometry_s>		_vehicle_visual_odometry_aligned_pub{ORB_ID(vehicle_visual_odometry_aligned)};
+};
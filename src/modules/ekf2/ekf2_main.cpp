@@ -58,7 +58,6 @@
 #include <uORB/topics/distance_sensor.h>
 #include <uORB/topics/ekf2_timestamps.h>
 #include <uORB/topics/ekf_gps_drift.h>
-#include <uORB/topics/ekf_gps_position.h>
 #include <uORB/topics/estimator_innovations.h>
 #include <uORB/topics/estimator_sensor_bias.h>
 #include <uORB/topics/estimator_status.h>
@@ -80,24 +79,22 @@
 #include <uORB/topics/wind_estimate.h>
 #include <uORB/topics/yaw_estimator_status.h>
 
+#include "EKF2Selector.hpp"
 #include "Utility/PreFlightChecker.hpp"
 
-// defines used to specify the mask position for use of different accuracy metrics in the GPS blending algorithm
-#define BLEND_MASK_USE_SPD_ACC      1
-#define BLEND_MASK_USE_HPOS_ACC     2
-#define BLEND_MASK_USE_VPOS_ACC     4
-
-// define max number of GPS receivers supported and 0 base instance used to access virtual 'blended' GPS solution
-#define GPS_MAX_RECEIVERS 2
-#define GPS_BLENDED_INSTANCE 2
-
 using math::constrain;
 using namespace time_literals;
 
+class Ekf2;
+
+// multi-EKF: the additional instances (instance 0 is the module object) and the output selector
+static Ekf2 *_ekf2_instances[EKF2Selector::MAX_INSTANCES] {};
+static EKF2Selector *_ekf2_selector{nullptr};
+
 class Ekf2 final : public ModuleBase<Ekf2>, public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
-	explicit Ekf2(bool replay_mode = false);
+	Ekf2(bool multi_mode, uint8_t instance, const px4::wq_config_t &config, bool replay_mode = false);
 	~Ekf2() override;
 
 	/** @see ModuleBase */
@@ -113,9 +110,20 @@ public:
 
 	int print_status() override;
 
+	bool exited() const { return _exited.load(); }
+
+protected:
+	void request_stop() override;
+
 private:
 	void Run() override;
 
+	/**
+	 * Stop and delete the additional multi-EKF instances and the selector.
+	 * Called from the command line thread with the module lock held.
+	 */
+	static void stop_multi_instances();
+
 	int getRangeSubIndex(); ///< get subscription index of first downward-facing range sensor
 	void fillGpsMsgWithVehicleGpsPosData(gps_message &msg, const vehicle_gps_position_s &data);
 
@@ -135,38 +143,6 @@ private:
 	void publish_wind_estimate(const hrt_abstime &timestamp);
 	void publish_yaw_estimator_status(const hrt_abstime &timestamp);
 
-	/*
-	 * Update the internal state estimate for a blended GPS solution that is a weighted average of the phsyical
-	 * receiver solutions. This internal state cannot be used directly by estimators because if physical receivers
-	 * have significant position differences, variation in receiver estimated accuracy will cause undesirable
-	 * variation in the position solution.
-	*/
-	bool blend_gps_data();
-
-	/*
-	 * Calculate internal states used to blend GPS data from multiple receivers using weightings calculated
-	 * by calc_blend_weights()
-	 * States are written to _gps_state and _gps_blended_state class variables
-	 */
-	void update_gps_blend_states();
-
-	/*
-	 * The location in _gps_blended_state will move around as the relative accuracy changes.
-	 * To mitigate this effect a low-pass filtered offset from each GPS location to the blended location is
-	 * calculated.
-	*/
-	void update_gps_offsets();
-
-	/*
-	 * Apply the steady state physical receiver offsets calculated by update_gps_offsets().
-	*/
-	void apply_gps_offsets();
-
-	/*
-	 Calculate GPS output that is a blend of the offset corrected physical receiver data
-	*/
-	void calc_gps_blend_output();
-
 	/*
 	 * Calculate filtered WGS84 height from estimated AMSL height
 	 */
@@ -175,6 +151,10 @@ private:
 	inline float sq(float x) { return x * x; };
 
 	const bool 	_replay_mode;			///< true when we use replay data from a log
+	const bool	_multi_mode;			///< true when running as one of several instances (see EKF2_MULTI_IMU)
+	const uint8_t	_instance;			///< instance index, equal to the vehicle_imu and estimator_* topic instances
+
+	px4::atomic_bool _exited{false};		///< set by an additional multi-EKF instance once it stopped
 
 	// time slip monitoring
 	uint64_t _integrated_time_us = 0;	///< integral of gyro delta time from start (uSec)
@@ -183,8 +163,14 @@ private:
 
 	perf_counter_t _ekf_update_perf;
 
+	// diagnostic topics (innovations, sensor bias, wind, yaw estimator) are published at a reduced rate,
+	// the outputs used for control and estimator_status on every filter update
+	static constexpr hrt_abstime DIAGNOSTICS_PUBLISH_INTERVAL{100_ms};
+	hrt_abstime _last_diagnostics_publish{0};
+
 	// Initialise time stamps used to send sensor data to the EKF and for logging
 	uint8_t _invalid_mag_id_count = 0;	///< number of times an invalid magnetomer device ID has been detected
+	uint32_t _mag_device_id{0};		///< device ID of the magnetometer currently used, from vehicle_magnetometer
 
 	// Used to check, save and use learned magnetometer biases
 	hrt_abstime _last_magcal_us = 0;	///< last time the EKF was operating a mode that estimates magnetomer biases (uSec)
@@ -203,28 +189,11 @@ private:
 	static constexpr float eo_max_std_dev = 100.0f;	///< Maximum permissible standard deviation for estimated orientation
 	//static constexpr float ev_max_std_dev = 100.0f;	///< Maximum permissible standard deviation for estimated velocity
 
-	// GPS blending and switching
-	gps_message _gps_state[GPS_MAX_RECEIVERS] {}; ///< internal state data for the physical GPS
-	gps_message _gps_blended_state{};		///< internal state data for the blended GPS
-	gps_message _gps_output[GPS_MAX_RECEIVERS + 1] {}; ///< output state data for the physical and blended GPS
-	Vector2f _NE_pos_offset_m[GPS_MAX_RECEIVERS] = {}; ///< Filtered North,East position offset from GPS instance to blended solution in _output_state.location (m)
-	float _hgt_offset_mm[GPS_MAX_RECEIVERS] = {};	///< Filtered height offset from GPS instance relative to blended solution in _output_state.location (mm)
-	Vector3f _blended_antenna_offset = {};		///< blended antenna offset
-	float _blend_weights[GPS_MAX_RECEIVERS] = {};	///< blend weight for each GPS. The blend weights must sum to 1.0 across all instances.
-	uint64_t _time_prev_us[GPS_MAX_RECEIVERS] = {};	///< the previous value of time_us for that GPS instance - used to detect new data.
-	uint8_t _gps_best_index = 0;			///< index of the physical receiver with the lowest reported error
-	uint8_t _gps_select_index = 0;			///< 0 = GPS1, 1 = GPS2, 2 = blended
-	uint8_t _gps_time_ref_index =
-		0;		///< index of the receiver that is used as the timing reference for the blending update
-	uint8_t _gps_oldest_index = 0;			///< index of the physical receiver with the oldest data
-	uint8_t _gps_newest_index = 0;			///< index of the physical receiver with the newest data
-	uint8_t _gps_slowest_index = 0;			///< index of the physical receiver with the slowest update rate
-	float _gps_dt[GPS_MAX_RECEIVERS] = {};		///< average time step in seconds.
-	bool  _gps_new_output_data = false;		///< true if there is new output data for the EKF
 	bool _had_valid_terrain = false;		///< true if at any time there was a valid terrain estimate
 
-	int32_t _gps_alttitude_ellipsoid[GPS_MAX_RECEIVERS] {};	///< altitude in 1E-3 meters (millimeters) above ellipsoid
-	uint64_t _gps_alttitude_ellipsoid_previous_timestamp[GPS_MAX_RECEIVERS] {}; ///< storage for previous timestamp to compute dt
+	uint64_t _gps_time_usec{0};			///< timestamp of the last vehicle_gps_position sample
+	int32_t _gps_alttitude_ellipsoid{0};	///< altitude in 1E-3 meters (millimeters) above ellipsoid
+	uint64_t _gps_alttitude_ellipsoid_previous_timestamp{0}; ///< storage for previous timestamp to compute dt
 	float   _wgs84_hgt_offset = 0;  ///< height offset between AMSL and WGS84
 
 	bool _imu_bias_reset_request{false};
@@ -259,27 +228,27 @@ private:
 	uORB::Subscription _range_finder_subs[MAX_RNG_SENSOR_COUNT] {{ORB_ID(distance_sensor), 0}, {ORB_ID(distance_sensor), 1}, {ORB_ID(distance_sensor), 2}, {ORB_ID(distance_sensor), 3}};
 	int _range_finder_sub_index = -1; // index for downward-facing range finder subscription
 
-	// because we can have multiple GPS instances
-	uORB::Subscription _gps_subs[GPS_MAX_RECEIVERS] {{ORB_ID(vehicle_gps_position), 0}, {ORB_ID(vehicle_gps_position), 1}};
+	uORB::Subscription _vehicle_gps_position_sub{ORB_ID(vehicle_gps_position)};
 
 	sensor_selection_s		_sensor_selection{};
 	vehicle_land_detected_s		_vehicle_land_detected{};
 	vehicle_status_s		_vehicle_status{};
 
-	uORB::Publication<ekf2_timestamps_s>			_ekf2_timestamps_pub{ORB_ID(ekf2_timestamps)};
-	uORB::Publication<ekf_gps_drift_s>			_ekf_gps_drift_pub{ORB_ID(ekf_gps_drift)};
-	uORB::Publication<ekf_gps_position_s>			_blended_gps_pub{ORB_ID(ekf_gps_position)};
-	uORB::Publication<estimator_innovations_s>		_estimator_innovation_test_ratios_pub{ORB_ID(estimator_innovation_test_ratios)};
-	uORB::Publication<estimator_innovations_s>		_estimator_innovation_variances_pub{ORB_ID(estimator_innovation_variances)};
-	uORB::Publication<estimator_innovations_s>		_estimator_innovations_pub{ORB_ID(estimator_innovations)};
-	uORB::Publication<estimator_sensor_bias_s>		_estimator_sensor_bias_pub{ORB_ID(estimator_sensor_bias)};
-	uORB::Publication<estimator_status_s>			_estimator_status_pub{ORB_ID(estimator_status)};
-	uORB::Publication<vehicle_attitude_s>			_att_pub{ORB_ID(vehicle_attitude)};
-	uORB::Publication<vehicle_odometry_s>			_vehicle_odometry_pub{ORB_ID(vehicle_odometry)};
-	uORB::Publication<yaw_estimator_status_s>		_yaw_est_pub{ORB_ID(yaw_estimator_status)};
-	uORB::PublicationData<vehicle_global_position_s>	_vehicle_global_position_pub{ORB_ID(vehicle_global_position)};
-	uORB::PublicationData<vehicle_local_position_s>		_vehicle_local_position_pub{ORB_ID(vehicle_local_position)};
-	uORB::PublicationData<vehicle_odometry_s>		_vehicle_visual_odometry_aligned_pub{ORB_ID(vehicle_visual_odometry_aligned)};
+	// all estimator outputs are multi-instance topics, in multi mode every EKF instance publishes its own
+	// estimator_* instance and the EKF2Selector republishes the vehicle_* topics of the selected one
+	uORB::PublicationMulti<ekf2_timestamps_s>		_ekf2_timestamps_pub{ORB_ID(ekf2_timestamps)};
+	uORB::PublicationMulti<ekf_gps_drift_s>			_ekf_gps_drift_pub{ORB_ID(ekf_gps_drift)};
+	uORB::PublicationMulti<estimator_innovations_s>		_estimator_innovation_test_ratios_pub{ORB_ID(estimator_innovation_test_ratios)};
+	uORB::PublicationMulti<estimator_innovations_s>		_estimator_innovation_variances_pub{ORB_ID(estimator_innovation_variances)};
+	uORB::PublicationMulti<estimator_innovations_s>		_estimator_innovations_pub{ORB_ID(estimator_innovations)};
+	uORB::PublicationMultiData<estimator_sensor_bias_s>	_estimator_sensor_bias_pub{ORB_ID(estimator_sensor_bias)};
+	uORB::PublicationMulti<estimator_status_s>		_estimator_status_pub{ORB_ID(estimator_status)};
+	uORB::PublicationMulti<vehicle_attitude_s>		_att_pub;
+	uORB::PublicationMulti<vehicle_odometry_s>		_vehicle_odometry_pub;
+	uORB::PublicationMulti<yaw_estimator_status_s>		_yaw_est_pub{ORB_ID(yaw_estimator_status)};
+	uORB::PublicationMultiData<vehicle_global_position_s>	_vehicle_global_position_pub;
+	uORB::PublicationMultiData<vehicle_local_position_s>	_vehicle_local_position_pub;
+	uORB::PublicationMultiData<vehicle_odometry_s>		_vehicle_visual_odometry_aligned_pub;
 	uORB::PublicationMulti<wind_estimate_s>			_wind_pub{ORB_ID(wind_estimate)};
 
 	Ekf _ekf;
@@ -519,12 +488,6 @@ private:
 		(ParamExtFloat<px4::params::EKF2_PCOEF_Z>)
 		_param_ekf2_pcoef_z,	///< static pressure position error coefficient along the Z body axis
 
-		// GPS blending
-		(ParamInt<px4::params::EKF2_GPS_MASK>)
-		_param_ekf2_gps_mask,	///< mask defining when GPS accuracy metrics are used to calculate the blend ratio
-		(ParamFloat<px4::params::EKF2_GPS_TAU>)
-		_param_ekf2_gps_tau,		///< time constant controlling how rapidly the offset used to bring GPS solutions together is allowed to change (sec)
-
 		// Test used to determine if the vehicle is static or moving
 		(ParamExtFloat<px4::params::EKF2_MOVE_TEST>)
 		_param_ekf2_move_test,	///< scaling applied to IMU data thresholds used to determine if the vehicle is static or moving.
@@ -540,11 +503,19 @@ private:
 
 };
 
-Ekf2::Ekf2(bool replay_mode):
+Ekf2::Ekf2(bool multi_mode, uint8_t instance, const px4::wq_config_t &config, bool replay_mode):
 	ModuleParams(nullptr),
-	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::navigation_and_controllers),
+	ScheduledWorkItem(MODULE_NAME, config),
 	_replay_mode(replay_mode),
+	_multi_mode(multi_mode),
+	_instance(instance),
 	_ekf_update_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": update")),
+	_att_pub(multi_mode ? ORB_ID(estimator_attitude) : ORB_ID(vehicle_attitude)),
+	_vehicle_odometry_pub(multi_mode ? ORB_ID(estimator_odometry) : ORB_ID(vehicle_odometry)),
+	_vehicle_global_position_pub(multi_mode ? ORB_ID(estimator_global_position) : ORB_ID(vehicle_global_position)),
+	_vehicle_local_position_pub(multi_mode ? ORB_ID(estimator_local_position) : ORB_ID(vehicle_local_position)),
+	_vehicle_visual_odometry_aligned_pub(multi_mode ? ORB_ID(estimator_visual_odometry_aligned) :
+					     ORB_ID(vehicle_visual_odometry_aligned)),
 	_params(_ekf.getParamHandle()),
 	_param_ekf2_min_obs_dt(_params->sensor_interval_min_ms),
 	_param_ekf2_mag_delay(_params->mag_delay_ms),
@@ -663,6 +634,35 @@ Ekf2::~Ekf2()
 
 bool Ekf2::init()
 {
+	if (_multi_mode) {
+		// advertise all multi-instance outputs up front, the instances are initialised in order from task_spawn(),
+		// so the estimator_* topic instances match the EKF instance
+		_att_pub.advertise();
+		_vehicle_local_position_pub.advertise();
+		_vehicle_global_position_pub.advertise();
+		_vehicle_odometry_pub.advertise();
+		_vehicle_visual_odometry_aligned_pub.advertise();
+		_estimator_status_pub.advertise();
+		_estimator_sensor_bias_pub.advertise();
+		_estimator_innovations_pub.advertise();
+		_estimator_innovation_variances_pub.advertise();
+		_estimator_innovation_test_ratios_pub.advertise();
+		_ekf_gps_drift_pub.advertise();
+		_ekf2_timestamps_pub.advertise();
+		_yaw_est_pub.advertise();
+
+		// each instance runs on vehicle_imu with the same index
+		if (_vehicle_imu_subs[_instance].registerCallback()) {
+			PX4_INFO("%d: subscribed to vehicle_imu:%d", _instance, _instance);
+			_imu_sub_index = _instance;
+			_callback_registered = true;
+			return true;
+		}
+
+		ScheduleDelayed(1_s); // retry in 1 second
+		return true;
+	}
+
 	const uint32_t device_id = _param_ekf2_imu_id.get();
 
 	// if EKF2_IMU_ID is non-zero we use the corresponding IMU, otherwise the voted primary (sensor_combined)
@@ -699,6 +699,10 @@ bool Ekf2::init()
 
 int Ekf2::print_status()
 {
+	if (_multi_mode) {
+		PX4_INFO("instance: %d (vehicle_imu:%d)", _instance, _imu_sub_index);
+	}
+
 	PX4_INFO("local position: %s", (_ekf.local_position_is_valid()) ? "valid" : "invalid");
 	PX4_INFO("global position: %s", (_ekf.global_position_is_valid()) ? "valid" : "invalid");
 
@@ -706,9 +710,54 @@ int Ekf2::print_status()
 
 	perf_print_counter(_ekf_update_perf);
 
+	if (_multi_mode && (_instance == 0)) {
+		for (Ekf2 *inst : _ekf2_instances) {
+			if (inst) {
+				inst->print_status();
+			}
+		}
+
+		if (_ekf2_selector) {
+			_ekf2_selector->PrintStatus();
+		}
+	}
+
 	return 0;
 }
 
+void Ekf2::request_stop()
+{
+	if (_instance == 0) {
+		stop_multi_instances();
+	}
+
+	ModuleBase::request_stop();
+}
+
+void Ekf2::stop_multi_instances()
+{
+	if (_ekf2_selector) {
+		_ekf2_selector->Stop();
+		delete _ekf2_selector;
+		_ekf2_selector = nullptr;
+	}
+
+	for (Ekf2 *&inst : _ekf2_instances) {
+		if (inst) {
+			inst->ModuleBase::request_stop();
+			inst->ScheduleNow();
+
+			// wait at most 1 second for the instance to leave its work queue
+			for (int i = 0; (i < 100) && !inst->exited(); i++) {
+				px4_usleep(10000);
+			}
+
+			delete inst;
+			inst = nullptr;
+		}
+	}
+}
+
 template<typename Param>
 void Ekf2::update_mag_bias(Param &mag_bias_param, int axis_index)
 {
@@ -752,7 +801,15 @@ void Ekf2::Run()
 			i.unregisterCallback();
 		}
 
-		exit_and_cleanup();
+		if (_instance == 0) {
+			exit_and_cleanup();
+
+		} else {
+			// additional instances are deleted by stop_multi_instances()
+			ScheduleClear();
+			_exited.store(true);
+		}
+
 		return;
 	}
 
@@ -882,12 +939,14 @@ void Ekf2::Run()
 			vehicle_magnetometer_s magnetometer;
 
 			if (_magnetometer_sub.copy(&magnetometer)) {
+				_mag_device_id = magnetometer.device_id;
+
 				// Reset learned bias parameters if there has been a persistant change in magnetometer ID
 				// Do not reset parmameters when armed to prevent potential time slips casued by parameter set
 				// and notification events
 				// Check if there has been a persistant change in magnetometer ID
-				if (_sensor_selection.mag_device_id != 0
-				    && (_sensor_selection.mag_device_id != (uint32_t)_param_ekf2_magbias_id.get())) {
+				if (_mag_device_id != 0
+				    && (_mag_device_id != (uint32_t)_param_ekf2_magbias_id.get())) {
 
 					if (_invalid_mag_id_count < 200) {
 						_invalid_mag_id_count++;
@@ -908,7 +967,7 @@ void Ekf2::Run()
 					_param_ekf2_magbias_y.commit_no_notification();
 					_param_ekf2_magbias_z.set(0.f);
 					_param_ekf2_magbias_z.commit_no_notification();
-					_param_ekf2_magbias_id.set(_sensor_selection.mag_device_id);
+					_param_ekf2_magbias_id.set(_mag_device_id);
 					_param_ekf2_magbias_id.commit();
 
 					_invalid_mag_id_count = 0;
@@ -941,87 +1000,17 @@ void Ekf2::Run()
 			}
 		}
 
-		// read gps1 data if available
-		bool gps1_updated = _gps_subs[0].updated();
-
-		if (gps1_updated) {
+		// read gps data if available
+		if (_vehicle_gps_position_sub.updated()) {
 			vehicle_gps_position_s gps;
 
-			if (_gps_subs[0].copy(&gps)) {
-				fillGpsMsgWithVehicleGpsPosData(_gps_state[0], gps);
-				_gps_alttitude_ellipsoid[0] = gps.alt_ellipsoid;
-			}
-		}
-
-		// check for second GPS receiver data
-		bool gps2_updated = _gps_subs[1].updated();
-
-		if (gps2_updated) {
-			vehicle_gps_position_s gps;
-
-			if (_gps_subs[1].copy(&gps)) {
-				fillGpsMsgWithVehicleGpsPosData(_gps_state[1], gps);
-				_gps_alttitude_ellipsoid[1] = gps.alt_ellipsoid;
-			}
-		}
-
-		if ((_param_ekf2_gps_mask.get() == 0) && gps1_updated) {
-			// When GPS blending is disabled we always use the first receiver instance
-			_ekf.setGpsData(_gps_state[0]);
-
-		} else if ((_param_ekf2_gps_mask.get() > 0) && (gps1_updated || gps2_updated)) {
-			// blend dual receivers if available
-
-			// calculate blending weights
-			if (!blend_gps_data()) {
-				// handle case where the blended states cannot be updated
-				// Only use selected receiver data if it has been updated
-				_gps_new_output_data = (gps1_updated && _gps_select_index == 0) ||
-						       (gps2_updated && _gps_select_index == 1);
-
-				// Reset relative position offsets to zero
-				_NE_pos_offset_m[0].zero();
-				_NE_pos_offset_m[1].zero();
-				_hgt_offset_mm[0] = _hgt_offset_mm[1] = 0.0f;
-			}
-
-			if (_gps_new_output_data) {
-				// correct the _gps_state data for steady state offsets and write to _gps_output
-				apply_gps_offsets();
+			if (_vehicle_gps_position_sub.copy(&gps)) {
+				gps_message gps_msg{};
+				fillGpsMsgWithVehicleGpsPosData(gps_msg, gps);
+				_ekf.setGpsData(gps_msg);
 
-				// calculate a blended output from the offset corrected receiver data
-				if (_gps_select_index == 2) {
-					calc_gps_blend_output();
-				}
-
-				// write selected GPS to EKF
-				_ekf.setGpsData(_gps_output[_gps_select_index]);
-
-				// log blended solution as a third GPS instance
-				ekf_gps_position_s gps;
-				gps.timestamp = _gps_output[_gps_select_index].time_usec;
-				gps.lat = _gps_output[_gps_select_index].lat;
-				gps.lon = _gps_output[_gps_select_index].lon;
-				gps.alt = _gps_output[_gps_select_index].alt;
-				gps.fix_type = _gps_output[_gps_select_index].fix_type;
-				gps.eph = _gps_output[_gps_select_index].eph;
-				gps.epv = _gps_output[_gps_select_index].epv;
-				gps.s_variance_m_s = _gps_output[_gps_select_index].sacc;
-				gps.vel_m_s = _gps_output[_gps_select_index].vel_m_s;
-				gps.vel_n_m_s = _gps_output[_gps_select_index].vel_ned(0);
-				gps.vel_e_m_s = _gps_output[_gps_select_index].vel_ned(1);
-				gps.vel_d_m_s = _gps_output[_gps_select_index].vel_ned(2);
-				gps.vel_ned_valid = _gps_output[_gps_select_index].vel_ned_valid;
-				gps.satellites_used = _gps_output[_gps_select_index].nsats;
-				gps.heading = _gps_output[_gps_select_index].yaw;
-				gps.heading_offset = _gps_output[_gps_select_index].yaw_offset;
-				gps.selected = _gps_select_index;
-
-				// Publish to the EKF blended GPS topic
-				_blended_gps_pub.publish(gps);
-
-				// clear flag to avoid re-use of the same data
-				_gps_new_output_data = false;
+				_gps_time_usec = gps_msg.time_usec;
+				_gps_alttitude_ellipsoid = gps.alt_ellipsoid;
 			}
 		}
 
@@ -1231,6 +1220,13 @@ void Ekf2::Run()
 			filter_control_status_u control_status;
 			_ekf.get_control_mode(&control_status.value);
 
+			const hrt_abstime diagnostics_due = _last_diagnostics_publish + DIAGNOSTICS_PUBLISH_INTERVAL;
+			const bool publish_diagnostics = _replay_mode || (now >= diagnostics_due);
+
+			// state variances, used by vehicle_odometry and estimator_status
+			float covariances[24];
+			_ekf.covariances_diagonal().copyTo(covariances);
+
 			// only publish position after successful alignment
 			if (control_status.flags.tilt_align) {
 				// generate vehicle local position data
@@ -1378,20 +1374,7 @@ void Ekf2::Run()
 					lpos.hagl_max = INFINITY;
 				}
 
-				// Get covariances to vehicle odometry
-				float covariances[24];
-				_ekf.covariances_diagonal().copyTo(covariances);
-
-				// get the covariance matrix size
-				const size_t POS_URT_SIZE = sizeof(odom.pose_covariance) / sizeof(odom.pose_covariance[0]);
-				const size_t VEL_URT_SIZE = sizeof(odom.velocity_covariance) / sizeof(odom.velocity_covariance[0]);
-
-				// initially set pose covariances to 0
-				for (size_t i = 0; i < POS_URT_SIZE; i++) {
-					odom.pose_covariance[i] = 0.0;
-				}
-
-				// set the position variances
+				// set the position variances (the other covariances are 0 from the initialisation of odom)
 				odom.pose_covariance[odom.COVARIANCE_MATRIX_X_VARIANCE] = covariances[7];
 				odom.pose_covariance[odom.COVARIANCE_MATRIX_Y_VARIANCE] = covariances[8];
 				odom.pose_covariance[odom.COVARIANCE_MATRIX_Z_VARIANCE] = covariances[9];
@@ -1399,11 +1382,6 @@ void Ekf2::Run()
 				// TODO: implement propagation from quaternion covariance to Euler angle covariance
 				// by employing the covariance law
 
-				// initially set velocity covariances to 0
-				for (size_t i = 0; i < VEL_URT_SIZE; i++) {
-					odom.velocity_covariance[i] = 0.0;
-				}
-
 				// set the linear velocity variances
 				odom.velocity_covariance[odom.COVARIANCE_MATRIX_VX_VARIANCE] = covariances[4];
 				odom.velocity_covariance[odom.COVARIANCE_MATRIX_VY_VARIANCE] = covariances[5];
@@ -1499,25 +1477,33 @@ void Ekf2::Run()
 
 			{
 				// publish all corrected sensor readings and bias estimates after mag calibration is updated above
-				bias.timestamp = now;
-
 				// take device ids from sensor_selection_s if not using specific vehicle_imu_s
 				if (_imu_sub_index < 0) {
 					bias.gyro_device_id = _sensor_selection.gyro_device_id;
 					bias.accel_device_id = _sensor_selection.accel_device_id;
 				}
 
-				bias.mag_device_id = _sensor_selection.mag_device_id;
+				bias.mag_device_id = _mag_device_id;
+
+				// the biases change slowly, but the consumers need to know immediately about a sensor change
+				const estimator_sensor_bias_s &bias_last = _estimator_sensor_bias_pub.get();
+				const bool device_ids_changed = (bias.gyro_device_id != bias_last.gyro_device_id)
+								|| (bias.accel_device_id != bias_last.accel_device_id)
+								|| (bias.mag_device_id != bias_last.mag_device_id);
 
-				// In-run bias estimates
-				_ekf.getGyroBias().copyTo(bias.gyro_bias);
-				_ekf.getAccelBias().copyTo(bias.accel_bias);
+				if (publish_diagnostics || device_ids_changed) {
+					bias.timestamp = now;
 
-				bias.mag_bias[0] = _last_valid_mag_cal[0];
-				bias.mag_bias[1] = _last_valid_mag_cal[1];
-				bias.mag_bias[2] = _last_valid_mag_cal[2];
+					// In-run bias estimates
+					_ekf.getGyroBias().copyTo(bias.gyro_bias);
+					_ekf.getAccelBias().copyTo(bias.accel_bias);
 
-				_estimator_sensor_bias_pub.publish(bias);
+					bias.mag_bias[0] = _last_valid_mag_cal[0];
+					bias.mag_bias[1] = _last_valid_mag_cal[1];
+					bias.mag_bias[2] = _last_valid_mag_cal[2];
+
+					_estimator_sensor_bias_pub.update(bias);
+				}
 			}
 
 			// publish estimator status
@@ -1525,7 +1511,9 @@ void Ekf2::Run()
 			status.timestamp = now;
 			_ekf.getStateAtFusionHorizonAsVector().copyTo(status.states);
 			status.n_states = 24;
-			_ekf.covariances_diagonal().copyTo(status.covariances);
+			static_assert(sizeof(status.covariances) == sizeof(covariances),
+				      "estimator_status_s::covariances wrong size");
+			memcpy(status.covariances, covariances, sizeof(covariances));
 			_ekf.getOutputTrackingError().copyTo(status.output_tracking_error);
 			_ekf.get_gps_check_status(&status.gps_check_fail_flags);
 			// only report enabled GPS check failures (the param indexes are shifted by 1 bit, because they don't include
@@ -1627,10 +1615,11 @@ void Ekf2::Run()
 					}
 				}
 
-				// Check and save the last valid calibration when we are disarmed
-				if ((_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
+				// Check and save the last valid calibration when we are disarmed (only one instance writes parameters)
+				if ((_instance == 0)
+				    && (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)
 				    && (status.filter_fault_flags == 0)
-				    && (_sensor_selection.mag_device_id == (uint32_t)_param_ekf2_magbias_id.get())) {
+				    && (_mag_device_id == (uint32_t)_param_ekf2_magbias_id.get())) {
 
 					update_mag_bias(_param_ekf2_magbias_x, 0);
 					update_mag_bias(_param_ekf2_magbias_y, 1);
@@ -1642,15 +1631,20 @@ void Ekf2::Run()
 
 			}
 
-			publish_wind_estimate(now);
-
-			publish_yaw_estimator_status(now);
+			if (publish_diagnostics) {
+				publish_wind_estimate(now);
+				publish_yaw_estimator_status(now);
+			}
 
-			if (!_mag_decl_saved && (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)) {
+			if (!_mag_decl_saved && (_instance == 0)
+			    && (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY)) {
 				_mag_decl_saved = update_mag_decl(_param_ekf2_mag_decl);
 			}
 
-			{
+			// the pre-flight checks need the innovations on every update, otherwise only fill them to publish
+			const bool standby = (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY);
+
+			if (publish_diagnostics || standby) {
 				// publish estimator innovation data
 				estimator_innovations_s innovations;
 				innovations.timestamp = now;
@@ -1672,53 +1666,8 @@ void Ekf2::Run()
 				innovations.fake_hpos[0] = innovations.fake_hpos[1] = innovations.fake_vpos = NAN;
 				innovations.fake_hvel[0] = innovations.fake_hvel[1] = innovations.fake_vvel = NAN;
 
-				// publish estimator innovation variance data
-				estimator_innovations_s innovation_var;
-				innovation_var.timestamp = now;
-				_ekf.getGpsVelPosInnovVar(&innovation_var.gps_hvel[0], innovation_var.gps_vvel, &innovation_var.gps_hpos[0],
-							  innovation_var.gps_vpos);
-				_ekf.getEvVelPosInnovVar(&innovation_var.ev_hvel[0], innovation_var.ev_vvel, &innovation_var.ev_hpos[0],
-							 innovation_var.ev_vpos);
-				_ekf.getBaroHgtInnovVar(innovation_var.baro_vpos);
-				_ekf.getRngHgtInnovVar(innovation_var.rng_vpos);
-				_ekf.getAuxVelInnovVar(&innovation_var.aux_hvel[0]);
-				_ekf.getFlowInnovVar(&innovation_var.flow[0]);
-				_ekf.getHeadingInnovVar(innovation_var.heading);
-				_ekf.getMagInnovVar(&innovation_var.mag_field[0]);
-				_ekf.getDragInnovVar(&innovation_var.drag[0]);
-				_ekf.getAirspeedInnovVar(innovation_var.airspeed);
-				_ekf.getBetaInnovVar(innovation_var.beta);
-				_ekf.getHaglInnovVar(innovation_var.hagl);
-				// Not yet supported
-				innovation_var.aux_vvel = NAN;
-				innovation_var.fake_hpos[0] = innovation_var.fake_hpos[1] = innovation_var.fake_vpos = NAN;
-				innovation_var.fake_hvel[0] = innovation_var.fake_hvel[1] = innovation_var.fake_vvel = NAN;
-
-
-				// publish estimator innovation test ratio data
-				estimator_innovations_s test_ratios;
-				test_ratios.timestamp = now;
-				_ekf.getGpsVelPosInnovRatio(test_ratios.gps_hvel[0], test_ratios.gps_vvel, test_ratios.gps_hpos[0],
-							    test_ratios.gps_vpos);
-				_ekf.getEvVelPosInnovRatio(test_ratios.ev_hvel[0], test_ratios.ev_vvel, test_ratios.ev_hpos[0],
-							   test_ratios.ev_vpos);
-				_ekf.getBaroHgtInnovRatio(test_ratios.baro_vpos);
-				_ekf.getRngHgtInnovRatio(test_ratios.rng_vpos);
-				_ekf.getAuxVelInnovRatio(test_ratios.aux_hvel[0]);
-				_ekf.getFlowInnovRatio(test_ratios.flow[0]);
-				_ekf.getHeadingInnovRatio(test_ratios.heading);
-				_ekf.getMagInnovRatio(test_ratios.mag_field[0]);
-				_ekf.getDragInnovRatio(&test_ratios.drag[0]);
-				_ekf.getAirspeedInnovRatio(test_ratios.airspeed);
-				_ekf.getBetaInnovRatio(test_ratios.beta);
-				_ekf.getHaglInnovRatio(test_ratios.hagl);
-				// Not yet supported
-				test_ratios.aux_vvel = NAN;
-				test_ratios.fake_hpos[0] = test_ratios.fake_hpos[1] = test_ratios.fake_vpos = NAN;
-				test_ratios.fake_hvel[0] = test_ratios.fake_hvel[1] = test_ratios.fake_vvel = NAN;
-
 				// calculate noise filtered velocity innovations which are used for pre-flight checking
-				if (_vehicle_status.arming_state == vehicle_status_s::ARMING_STATE_STANDBY) {
+				if (standby) {
 					float dt_seconds = imu_sample_new.delta_ang_dt;
 					runPreFlightChecks(dt_seconds, control_status, _vehicle_status, innovations);
 
@@ -1726,10 +1675,66 @@ void Ekf2::Run()
 					resetPreFlightChecks();
 				}
 
-				_estimator_innovations_pub.publish(innovations);
-				_estimator_innovation_variances_pub.publish(innovation_var);
-				_estimator_innovation_test_ratios_pub.publish(test_ratios);
+				if (publish_diagnostics) {
+					// publish estimator innovation variance data
+					estimator_innovations_s innovation_var;
+					innovation_var.timestamp = now;
+					_ekf.getGpsVelPosInnovVar(&innovation_var.gps_hvel[0], innovation_var.gps_vvel,
+								  &innovation_var.gps_hpos[0], innovation_var.gps_vpos);
+					_ekf.getEvVelPosInnovVar(&innovation_var.ev_hvel[0], innovation_var.ev_vvel,
+								 &innovation_var.ev_hpos[0], innovation_var.ev_vpos);
+					_ekf.getBaroHgtInnovVar(innovation_var.baro_vpos);
+					_ekf.getRngHgtInnovVar(innovation_var.rng_vpos);
+					_ekf.getAuxVelInnovVar(&innovation_var.aux_hvel[0]);
+					_ekf.getFlowInnovVar(&innovation_var.flow[0]);
+					_ekf.getHeadingInnovVar(innovation_var.heading);
+					_ekf.getMagInnovVar(&innovation_var.mag_field[0]);
+					_ekf.getDragInnovVar(&innovation_var.drag[0]);
+					_ekf.getAirspeedInnovVar(innovation_var.airspeed);
+					_ekf.getBetaInnovVar(innovation_var.beta);
+					_ekf.getHaglInnovVar(innovation_var.hagl);
+					// Not yet supported
+					innovation_var.aux_vvel = NAN;
+					innovation_var.fake_hpos[0] = innovation_var.fake_hpos[1] = NAN;
+					innovation_var.fake_vpos = NAN;
+					innovation_var.fake_hvel[0] = innovation_var.fake_hvel[1] = NAN;
+					innovation_var.fake_vvel = NAN;
+
+					// publish estimator innovation test ratio data
+					estimator_innovations_s test_ratios;
+					test_ratios.timestamp = now;
+					_ekf.getGpsVelPosInnovRatio(test_ratios.gps_hvel[0], test_ratios.gps_vvel,
+								    test_ratios.gps_hpos[0], test_ratios.gps_vpos);
+					_ekf.getEvVelPosInnovRatio(test_ratios.ev_hvel[0], test_ratios.ev_vvel,
+								   test_ratios.ev_hpos[0], test_ratios.ev_vpos);
+					_ekf.getBaroHgtInnovRatio(test_ratios.baro_vpos);
+					_ekf.getRngHgtInnovRatio(test_ratios.rng_vpos);
+					_ekf.getAuxVelInnovRatio(test_ratios.aux_hvel[0]);
+					_ekf.getFlowInnovRatio(test_ratios.flow[0]);
+					_ekf.getHeadingInnovRatio(test_ratios.heading);
+					_ekf.getMagInnovRatio(test_ratios.mag_field[0]);
+					_ekf.getDragInnovRatio(&test_ratios.drag[0]);
+					_ekf.getAirspeedInnovRatio(test_ratios.airspeed);
+					_ekf.getBetaInnovRatio(test_ratios.beta);
+					_ekf.getHaglInnovRatio(test_ratios.hagl);
+					// Not yet supported
+					test_ratios.aux_vvel = NAN;
+					test_ratios.fake_hpos[0] = test_ratios.fake_hpos[1] = NAN;
+					test_ratios.fake_vpos = NAN;
+					test_ratios.fake_hvel[0] = test_ratios.fake_hvel[1] = NAN;
+					test_ratios.fake_vvel = NAN;
+
+					_estimator_innovations_pub.publish(innovations);
+					_estimator_innovation_variances_pub.publish(innovation_var);
+					_estimator_innovation_test_ratios_pub.publish(test_ratios);
+				}
+
+			} else {
+				resetPreFlightChecks();
+			}
 
+			if (publish_diagnostics) {
+				_last_diagnostics_publish = now;
 			}
 		}
 
@@ -1859,572 +1864,21 @@ void Ekf2::publish_wind_estimate(const hrt_abstime &timestamp)
 	}
 }
 
-bool Ekf2::blend_gps_data()
-{
-	// zero the blend weights
-	memset(&_blend_weights, 0, sizeof(_blend_weights));
-
-	/*
-	 * If both receivers have the same update rate, use the oldest non-zero time.
-	 * If two receivers with different update rates are used, use the slowest.
-	 * If time difference is excessive, use newest to prevent a disconnected receiver
-	 * from blocking updates.
-	 */
-
-	// Calculate the time step for each receiver with some filtering to reduce the effects of jitter
-	// Find the largest and smallest time step.
-	float dt_max = 0.0f;
-	float dt_min = 0.3f;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		float raw_dt = 1e-6f * (float)(_gps_state[i].time_usec - _time_prev_us[i]);
-
-		if (raw_dt > 0.0f && raw_dt < 0.3f) {
-			_gps_dt[i] = 0.1f * raw_dt + 0.9f * _gps_dt[i];
-		}
-
-		if (_gps_dt[i] > dt_max) {
-			dt_max = _gps_dt[i];
-			_gps_slowest_index = i;
-		}
-
-		if (_gps_dt[i] < dt_min) {
-			dt_min = _gps_dt[i];
-		}
-	}
-
-	// Find the receiver that is last be updated
-	uint64_t max_us = 0; // newest non-zero system time of arrival of a GPS message
-	uint64_t min_us = -1; // oldest non-zero system time of arrival of a GPS message
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		// Find largest and smallest times
-		if (_gps_state[i].time_usec > max_us) {
-			max_us = _gps_state[i].time_usec;
-			_gps_newest_index = i;
-		}
-
-		if ((_gps_state[i].time_usec < min_us) && (_gps_state[i].time_usec > 0)) {
-			min_us = _gps_state[i].time_usec;
-			_gps_oldest_index = i;
-		}
-	}
-
-	if ((max_us - min_us) > 300000) {
-		// A receiver has timed out so fall out of blending
-		if (_gps_state[0].time_usec > _gps_state[1].time_usec) {
-			_gps_select_index = 0;
-
-		} else {
-			_gps_select_index = 1;
-		}
-
-		return false;
-	}
-
-	// One receiver has lost 3D fix, fall out of blending
-	if (_gps_state[0].fix_type > 2 && _gps_state[1].fix_type < 3) {
-		_gps_select_index = 0;
-		return false;
-
-	} else if (_gps_state[1].fix_type > 2 && _gps_state[0].fix_type < 3) {
-		_gps_select_index = 1;
-		return false;
-	}
-
-	/*
-	 * If the largest dt is less than 20% greater than the smallest, then we have  receivers
-	 * running at the same rate then we wait until we have two messages with an arrival time
-	 * difference that is less than 50% of the smallest time step and use the time stamp from
-	 * the newest data.
-	 * Else we have two receivers at different update rates and use the slowest receiver
-	 * as the timing reference.
-	 */
-
-	if ((dt_max - dt_min) < 0.2f * dt_min) {
-		// both receivers assumed to be running at the same rate
-		if ((max_us - min_us) < (uint64_t)(5e5f * dt_min)) {
-			// data arrival within a short time window enables the two measurements to be blended
-			_gps_time_ref_index = _gps_newest_index;
-			_gps_new_output_data = true;
-		}
-
-	} else {
-		// both receivers running at different rates
-		_gps_time_ref_index = _gps_slowest_index;
-
-		if (_gps_state[_gps_time_ref_index].time_usec > _time_prev_us[_gps_time_ref_index]) {
-			// blend data at the rate of the slower receiver
-			_gps_new_output_data = true;
-		}
-	}
-
-	if (_gps_new_output_data) {
-		_gps_blended_state.time_usec = _gps_state[_gps_time_ref_index].time_usec;
-
-		// calculate the sum squared speed accuracy across all GPS sensors
-		float speed_accuracy_sum_sq = 0.0f;
-
-		if (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_SPD_ACC) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].sacc > 0.0f) {
-					speed_accuracy_sum_sq += _gps_state[i].sacc * _gps_state[i].sacc;
-
-				} else {
-					// not all receivers support this metric so set it to zero and don't use it
-					speed_accuracy_sum_sq = 0.0f;
-					break;
-				}
-			}
-		}
-
-		// calculate the sum squared horizontal position accuracy across all GPS sensors
-		float horizontal_accuracy_sum_sq = 0.0f;
-
-		if (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_HPOS_ACC) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 2 && _gps_state[i].eph > 0.0f) {
-					horizontal_accuracy_sum_sq += _gps_state[i].eph * _gps_state[i].eph;
-
-				} else {
-					// not all receivers support this metric so set it to zero and don't use it
-					horizontal_accuracy_sum_sq = 0.0f;
-					break;
-				}
-			}
-		}
-
-		// calculate the sum squared vertical position accuracy across all GPS sensors
-		float vertical_accuracy_sum_sq = 0.0f;
-
-		if (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_VPOS_ACC) {
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].epv > 0.0f) {
-					vertical_accuracy_sum_sq += _gps_state[i].epv * _gps_state[i].epv;
-
-				} else {
-					// not all receivers support this metric so set it to zero and don't use it
-					vertical_accuracy_sum_sq = 0.0f;
-					break;
-				}
-			}
-		}
-
-		// Check if we can do blending using reported accuracy
-		bool can_do_blending = (horizontal_accuracy_sum_sq > 0.0f || vertical_accuracy_sum_sq > 0.0f
-					|| speed_accuracy_sum_sq > 0.0f);
-
-		// if we can't do blending using reported accuracy, return false and hard switch logic will be used instead
-		if (!can_do_blending) {
-			return false;
-		}
-
-		float sum_of_all_weights = 0.0f;
-
-		// calculate a weighting using the reported speed accuracy
-		float spd_blend_weights[GPS_MAX_RECEIVERS] = {};
-
-		if (speed_accuracy_sum_sq > 0.0f && (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_SPD_ACC)) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_spd_weights = 0.0f;
-
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].sacc >= 0.001f) {
-					spd_blend_weights[i] = 1.0f / (_gps_state[i].sacc * _gps_state[i].sacc);
-					sum_of_spd_weights += spd_blend_weights[i];
-				}
-			}
-
-			// normalise the weights
-			if (sum_of_spd_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-					spd_blend_weights[i] = spd_blend_weights[i] / sum_of_spd_weights;
-				}
-
-				sum_of_all_weights += 1.0f;
-			}
-		}
-
-		// calculate a weighting using the reported horizontal position
-		float hpos_blend_weights[GPS_MAX_RECEIVERS] = {};
-
-		if (horizontal_accuracy_sum_sq > 0.0f && (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_HPOS_ACC)) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_hpos_weights = 0.0f;
-
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 2 && _gps_state[i].eph >= 0.001f) {
-					hpos_blend_weights[i] = horizontal_accuracy_sum_sq / (_gps_state[i].eph * _gps_state[i].eph);
-					sum_of_hpos_weights += hpos_blend_weights[i];
-				}
-			}
-
-			// normalise the weights
-			if (sum_of_hpos_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-					hpos_blend_weights[i] = hpos_blend_weights[i] / sum_of_hpos_weights;
-				}
-
-				sum_of_all_weights += 1.0f;
-			}
-		}
-
-		// calculate a weighting using the reported vertical position accuracy
-		float vpos_blend_weights[GPS_MAX_RECEIVERS] = {};
-
-		if (vertical_accuracy_sum_sq > 0.0f && (_param_ekf2_gps_mask.get() & BLEND_MASK_USE_VPOS_ACC)) {
-			// calculate the weights using the inverse of the variances
-			float sum_of_vpos_weights = 0.0f;
-
-			for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-				if (_gps_state[i].fix_type >= 3 && _gps_state[i].epv >= 0.001f) {
-					vpos_blend_weights[i] = vertical_accuracy_sum_sq / (_gps_state[i].epv * _gps_state[i].epv);
-					sum_of_vpos_weights += vpos_blend_weights[i];
-				}
-			}
-
-			// normalise the weights
-			if (sum_of_vpos_weights > 0.0f) {
-				for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-					vpos_blend_weights[i] = vpos_blend_weights[i] / sum_of_vpos_weights;
-				}
-
-				sum_of_all_weights += 1.0f;
-			};
-		}
-
-		// calculate an overall weight
-		for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-			_blend_weights[i] = (hpos_blend_weights[i] + vpos_blend_weights[i] + spd_blend_weights[i]) / sum_of_all_weights;
-		}
-
-		// With updated weights we can calculate a blended GPS solution and
-		// offsets for each physical receiver
-		update_gps_blend_states();
-		update_gps_offsets();
-		_gps_select_index = 2;
-
-	}
-
-	return true;
-}
-
-/*
- * Update the internal state estimate for a blended GPS solution that is a weighted average of the phsyical receiver solutions
- * with weights are calculated in calc_gps_blend_weights(). This internal state cannot be used directly by estimators
- * because if physical receivers have significant position differences,  variation in receiver estimated accuracy will
- * cause undesirable variation in the position solution.
-*/
-void Ekf2::update_gps_blend_states()
-{
-	// initialise the blended states so we can accumulate the results using the weightings for each GPS receiver.
-	_gps_blended_state.time_usec = 0;
-	_gps_blended_state.lat = 0;
-	_gps_blended_state.lon = 0;
-	_gps_blended_state.alt = 0;
-	_gps_blended_state.fix_type = 0;
-	_gps_blended_state.eph = FLT_MAX;
-	_gps_blended_state.epv = FLT_MAX;
-	_gps_blended_state.sacc = FLT_MAX;
-	_gps_blended_state.vel_m_s = 0.0f;
-	_gps_blended_state.vel_ned.setZero();
-	_gps_blended_state.vel_ned_valid = true;
-	_gps_blended_state.nsats = 0;
-	_gps_blended_state.pdop = FLT_MAX;
-
-	_blended_antenna_offset.zero();
-
-	// combine the the GPS states into a blended solution using the weights calculated in calc_blend_weights()
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		// blend the timing data
-		_gps_blended_state.time_usec += (uint64_t)((double)_gps_state[i].time_usec * (double)_blend_weights[i]);
-
-		// use the highest status
-		if (_gps_state[i].fix_type > _gps_blended_state.fix_type) {
-			_gps_blended_state.fix_type = _gps_state[i].fix_type;
-		}
-
-		// calculate a blended average speed and velocity vector
-		_gps_blended_state.vel_m_s += _gps_state[i].vel_m_s * _blend_weights[i];
-		_gps_blended_state.vel_ned += _gps_state[i].vel_ned * _blend_weights[i];
-
-		// Assume blended error magnitude, DOP and sat count is equal to the best value from contributing receivers
-		// If any receiver contributing has an invalid velocity, then report blended velocity as invalid
-		if (_blend_weights[i] > 0.0f) {
-
-			if (_gps_state[i].eph > 0.0f
-			    && _gps_state[i].eph < _gps_blended_state.eph) {
-				_gps_blended_state.eph = _gps_state[i].eph;
-			}
-
-			if (_gps_state[i].epv > 0.0f
-			    && _gps_state[i].epv < _gps_blended_state.epv) {
-				_gps_blended_state.epv = _gps_state[i].epv;
-			}
-
-			if (_gps_state[i].sacc > 0.0f
-			    && _gps_state[i].sacc < _gps_blended_state.sacc) {
-				_gps_blended_state.sacc = _gps_state[i].sacc;
-			}
-
-			if (_gps_state[i].pdop > 0
-			    && _gps_state[i].pdop < _gps_blended_state.pdop) {
-				_gps_blended_state.pdop = _gps_state[i].pdop;
-			}
-
-			if (_gps_state[i].nsats > 0
-			    && _gps_state[i].nsats > _gps_blended_state.nsats) {
-				_gps_blended_state.nsats = _gps_state[i].nsats;
-			}
-
-			if (!_gps_state[i].vel_ned_valid) {
-				_gps_blended_state.vel_ned_valid = false;
-			}
-
-		}
-
-		// TODO read parameters for individual GPS antenna positions and blend
-		// Vector3f temp_antenna_offset = _antenna_offset[i];
-		// temp_antenna_offset *= _blend_weights[i];
-		// _blended_antenna_offset += temp_antenna_offset;
-
-	}
-
-	/*
-	 * Calculate the instantaneous weighted average location using  available GPS instances and store in  _gps_state.
-	 * This is statistically the most likely location, but may not be stable enough for direct use by the EKF.
-	*/
-
-	// Use the GPS with the highest weighting as the reference position
-	float best_weight = 0.0f;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		if (_blend_weights[i] > best_weight) {
-			best_weight = _blend_weights[i];
-			_gps_best_index = i;
-			_gps_blended_state.lat = _gps_state[i].lat;
-			_gps_blended_state.lon = _gps_state[i].lon;
-			_gps_blended_state.alt = _gps_state[i].alt;
-		}
-	}
-
-	// Convert each GPS position to a local NEU offset relative to the reference position
-	Vector2f blended_NE_offset_m;
-	blended_NE_offset_m.zero();
-	float blended_alt_offset_mm = 0.0f;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		if ((_blend_weights[i] > 0.0f) && (i != _gps_best_index)) {
-			// calculate the horizontal offset
-			Vector2f horiz_offset{};
-			get_vector_to_next_waypoint((_gps_blended_state.lat / 1.0e7),
-						    (_gps_blended_state.lon / 1.0e7), (_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
-						    &horiz_offset(0), &horiz_offset(1));
-
-			// sum weighted offsets
-			blended_NE_offset_m += horiz_offset * _blend_weights[i];
-
-			// calculate vertical offset
-			float vert_offset = (float)(_gps_state[i].alt - _gps_blended_state.alt);
-
-			// sum weighted offsets
-			blended_alt_offset_mm += vert_offset * _blend_weights[i];
-		}
-	}
-
-	// Add the sum of weighted offsets to the reference position to obtain the blended position
-	double lat_deg_now = (double)_gps_blended_state.lat * 1.0e-7;
-	double lon_deg_now = (double)_gps_blended_state.lon * 1.0e-7;
-	double lat_deg_res, lon_deg_res;
-	add_vector_to_global_position(lat_deg_now, lon_deg_now, blended_NE_offset_m(0), blended_NE_offset_m(1), &lat_deg_res,
-				      &lon_deg_res);
-	_gps_blended_state.lat = (int32_t)(1.0E7 * lat_deg_res);
-	_gps_blended_state.lon = (int32_t)(1.0E7 * lon_deg_res);
-	_gps_blended_state.alt += (int32_t)blended_alt_offset_mm;
-
-	// Take GPS heading from the highest weighted receiver that is publishing a valid .heading value
-	uint8_t gps_best_yaw_index = 0;
-	best_weight = 0.0f;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		if (PX4_ISFINITE(_gps_state[i].yaw) && (_blend_weights[i] > best_weight)) {
-			best_weight = _blend_weights[i];
-			gps_best_yaw_index = i;
-		}
-	}
-
-	_gps_blended_state.yaw = _gps_state[gps_best_yaw_index].yaw;
-	_gps_blended_state.yaw_offset = _gps_state[gps_best_yaw_index].yaw_offset;
-}
-
-/*
- * The location in _gps_blended_state will move around as the relative accuracy changes.
- * To mitigate this effect a low-pass filtered offset from each GPS location to the blended location is
- * calculated.
-*/
-void Ekf2::update_gps_offsets()
-{
-
-	// Calculate filter coefficients to be applied to the offsets for each GPS position and height offset
-	// A weighting of 1 will make the offset adjust the slowest, a weighting of 0 will make it adjust with zero filtering
-	float alpha[GPS_MAX_RECEIVERS] = {};
-	float omega_lpf = 1.0f / fmaxf(_param_ekf2_gps_tau.get(), 1.0f);
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		if (_gps_state[i].time_usec - _time_prev_us[i] > 0) {
-			// calculate the filter coefficient that achieves the time constant specified by the user adjustable parameter
-			alpha[i] = constrain(omega_lpf * 1e-6f * (float)(_gps_state[i].time_usec - _time_prev_us[i]),
-					     0.0f, 1.0f);
-
-			_time_prev_us[i] = _gps_state[i].time_usec;
-		}
-	}
-
-	// Calculate a filtered position delta for each GPS relative to the blended solution state
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		Vector2f offset;
-		get_vector_to_next_waypoint((_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
-					    (_gps_blended_state.lat / 1.0e7), (_gps_blended_state.lon / 1.0e7), &offset(0), &offset(1));
-		_NE_pos_offset_m[i] = offset * alpha[i] + _NE_pos_offset_m[i] * (1.0f - alpha[i]);
-		_hgt_offset_mm[i] = (float)(_gps_blended_state.alt - _gps_state[i].alt) *  alpha[i] +
-				    _hgt_offset_mm[i] * (1.0f - alpha[i]);
-	}
-
-	// calculate offset limits from the largest difference between receivers
-	Vector2f max_ne_offset{};
-	float max_alt_offset = 0;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		for (uint8_t j = i; j < GPS_MAX_RECEIVERS; j++) {
-			if (i != j) {
-				Vector2f offset;
-				get_vector_to_next_waypoint((_gps_state[i].lat / 1.0e7), (_gps_state[i].lon / 1.0e7),
-							    (_gps_state[j].lat / 1.0e7), (_gps_state[j].lon / 1.0e7), &offset(0), &offset(1));
-				max_ne_offset(0) = fmaxf(max_ne_offset(0), fabsf(offset(0)));
-				max_ne_offset(1) = fmaxf(max_ne_offset(1), fabsf(offset(1)));
-				max_alt_offset = fmaxf(max_alt_offset, fabsf((float)(_gps_state[i].alt - _gps_state[j].alt)));
-			}
-		}
-	}
-
-	// apply offset limits
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		_NE_pos_offset_m[i](0) = constrain(_NE_pos_offset_m[i](0), -max_ne_offset(0), max_ne_offset(0));
-		_NE_pos_offset_m[i](1) = constrain(_NE_pos_offset_m[i](1), -max_ne_offset(1), max_ne_offset(1));
-		_hgt_offset_mm[i] = constrain(_hgt_offset_mm[i], -max_alt_offset, max_alt_offset);
-	}
-
-}
-
-
-/*
- * Apply the steady state physical receiver offsets calculated by update_gps_offsets().
-*/
-void Ekf2::apply_gps_offsets()
-{
-	// calculate offset corrected output for each physical GPS.
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		// Add the sum of weighted offsets to the reference position to obtain the blended position
-		double lat_deg_now = (double)_gps_state[i].lat * 1.0e-7;
-		double lon_deg_now = (double)_gps_state[i].lon * 1.0e-7;
-		double lat_deg_res, lon_deg_res;
-		add_vector_to_global_position(lat_deg_now, lon_deg_now, _NE_pos_offset_m[i](0), _NE_pos_offset_m[i](1), &lat_deg_res,
-					      &lon_deg_res);
-		_gps_output[i].lat = (int32_t)(1.0E7 * lat_deg_res);
-		_gps_output[i].lon = (int32_t)(1.0E7 * lon_deg_res);
-		_gps_output[i].alt = _gps_state[i].alt + (int32_t)_hgt_offset_mm[i];
-
-		// other receiver data is used uncorrected
-		_gps_output[i].time_usec	= _gps_state[i].time_usec;
-		_gps_output[i].fix_type		= _gps_state[i].fix_type;
-		_gps_output[i].vel_m_s		= _gps_state[i].vel_m_s;
-		_gps_output[i].vel_ned		= _gps_state[i].vel_ned;
-		_gps_output[i].eph		= _gps_state[i].eph;
-		_gps_output[i].epv		= _gps_state[i].epv;
-		_gps_output[i].sacc		= _gps_state[i].sacc;
-		_gps_output[i].pdop		= _gps_state[i].pdop;
-		_gps_output[i].nsats		= _gps_state[i].nsats;
-		_gps_output[i].vel_ned_valid	= _gps_state[i].vel_ned_valid;
-		_gps_output[i].yaw		= _gps_state[i].yaw;
-		_gps_output[i].yaw_offset	= _gps_state[i].yaw_offset;
-
-	}
-}
-
-/*
- Calculate GPS output that is a blend of the offset corrected physical receiver data
-*/
-void Ekf2::calc_gps_blend_output()
-{
-	// Convert each GPS position to a local NEU offset relative to the reference position
-	// which is defined as the positon of the blended solution calculated from non offset corrected data
-	Vector2f blended_NE_offset_m;
-	blended_NE_offset_m.zero();
-	float blended_alt_offset_mm = 0.0f;
-
-	for (uint8_t i = 0; i < GPS_MAX_RECEIVERS; i++) {
-		if (_blend_weights[i] > 0.0f) {
-			// calculate the horizontal offset
-			Vector2f horiz_offset{};
-			get_vector_to_next_waypoint((_gps_blended_state.lat / 1.0e7),
-						    (_gps_blended_state.lon / 1.0e7),
-						    (_gps_output[i].lat / 1.0e7),
-						    (_gps_output[i].lon / 1.0e7),
-						    &horiz_offset(0),
-						    &horiz_offset(1));
-
-			// sum weighted offsets
-			blended_NE_offset_m += horiz_offset * _blend_weights[i];
-
-			// calculate vertical offset
-			float vert_offset = (float)(_gps_output[i].alt - _gps_blended_state.alt);
-
-			// sum weighted offsets
-			blended_alt_offset_mm += vert_offset * _blend_weights[i];
-		}
-	}
-
-	// Add the sum of weighted offsets to the reference position to obtain the blended position
-	double lat_deg_now = (double)_gps_blended_state.lat * 1.0e-7;
-	double lon_deg_now = (double)_gps_blended_state.lon * 1.0e-7;
-	double lat_deg_res, lon_deg_res;
-	add_vector_to_global_position(lat_deg_now, lon_deg_now, blended_NE_offset_m(0), blended_NE_offset_m(1), &lat_deg_res,
-				      &lon_deg_res);
-	_gps_output[GPS_BLENDED_INSTANCE].lat = (int32_t)(1.0E7 * lat_deg_res);
-	_gps_output[GPS_BLENDED_INSTANCE].lon = (int32_t)(1.0E7 * lon_deg_res);
-	_gps_output[GPS_BLENDED_INSTANCE].alt = _gps_blended_state.alt + (int32_t)blended_alt_offset_mm;
-
-	// Copy remaining data from internal states to output
-	_gps_output[GPS_BLENDED_INSTANCE].time_usec	= _gps_blended_state.time_usec;
-	_gps_output[GPS_BLENDED_INSTANCE].fix_type	= _gps_blended_state.fix_type;
-	_gps_output[GPS_BLENDED_INSTANCE].vel_m_s	= _gps_blended_state.vel_m_s;
-	_gps_output[GPS_BLENDED_INSTANCE].vel_ned	= _gps_blended_state.vel_ned;
-	_gps_output[GPS_BLENDED_INSTANCE].eph		= _gps_blended_state.eph;
-	_gps_output[GPS_BLENDED_INSTANCE].epv		= _gps_blended_state.epv;
-	_gps_output[GPS_BLENDED_INSTANCE].sacc		= _gps_blended_state.sacc;
-	_gps_output[GPS_BLENDED_INSTANCE].pdop		= _gps_blended_state.pdop;
-	_gps_output[GPS_BLENDED_INSTANCE].nsats		= _gps_blended_state.nsats;
-	_gps_output[GPS_BLENDED_INSTANCE].vel_ned_valid	= _gps_blended_state.vel_ned_valid;
-	_gps_output[GPS_BLENDED_INSTANCE].yaw		= _gps_blended_state.yaw;
-	_gps_output[GPS_BLENDED_INSTANCE].yaw_offset	= _gps_blended_state.yaw_offset;
-
-}
-
 float Ekf2::filter_altitude_ellipsoid(float amsl_hgt)
 {
 
-	float height_diff = static_cast<float>(_gps_alttitude_ellipsoid[0]) * 1e-3f - amsl_hgt;
+	float height_diff = static_cast<float>(_gps_alttitude_ellipsoid) * 1e-3f - amsl_hgt;
 
-	if (_gps_alttitude_ellipsoid_previous_timestamp[0] == 0) {
+	if (_gps_alttitude_ellipsoid_previous_timestamp == 0) {
 
 		_wgs84_hgt_offset = height_diff;
-		_gps_alttitude_ellipsoid_previous_timestamp[0] = _gps_state[0].time_usec;
+		_gps_alttitude_ellipsoid_previous_timestamp = _gps_time_usec;
 
-	} else if (_gps_state[0].time_usec != _gps_alttitude_ellipsoid_previous_timestamp[0]) {
+	} else if (_gps_time_usec != _gps_alttitude_ellipsoid_previous_timestamp) {
 
 		// apply a 10 second first order low pass filter to baro offset
-		float dt = 1e-6f * static_cast<float>(_gps_state[0].time_usec - _gps_alttitude_ellipsoid_previous_timestamp[0]);
-		_gps_alttitude_ellipsoid_previous_timestamp[0] = _gps_state[0].time_usec;
+		float dt = 1e-6f * static_cast<float>(_gps_time_usec - _gps_alttitude_ellipsoid_previous_timestamp);
+		_gps_alttitude_ellipsoid_previous_timestamp = _gps_time_usec;
 		float offset_rate_correction = 0.1f * (height_diff - _wgs84_hgt_offset);
 		_wgs84_hgt_offset += dt * math::constrain(offset_rate_correction, -0.1f, 0.1f);
 	}
@@ -2446,13 +1900,44 @@ int Ekf2::task_spawn(int argc, char *argv[])
 		replay_mode = true;
 	}
 
-	Ekf2 *instance = new Ekf2(replay_mode);
+	// multi-EKF: one instance per IMU, each on its own work queue (not supported in replay)
+	int32_t multi_imu = 0;
+	param_get(param_find("EKF2_MULTI_IMU"), &multi_imu);
+
+	const uint8_t instances = constrain(multi_imu, (int32_t)0, (int32_t)EKF2Selector::MAX_INSTANCES);
+	const bool multi_mode = (instances > 1) && !replay_mode;
+
+	Ekf2 *instance = new Ekf2(multi_mode, 0,
+				  multi_mode ? px4::ins_instance_to_wq(0) : px4::wq_configurations::navigation_and_controllers,
+				  replay_mode);
 
 	if (instance) {
 		_object.store(instance);
 		_task_id = task_id_is_work_queue;
 
 		if (instance->init()) {
+			if (multi_mode) {
+				// initialised in order, so that the estimator_* topic instances match the EKF instances
+				for (uint8_t i = 1; i < instances; i++) {
+					Ekf2 *ekf2_inst = new Ekf2(true, i, px4::ins_instance_to_wq(i), false);
+
+					if (ekf2_inst && ekf2_inst->init()) {
+						_ekf2_instances[i] = ekf2_inst;
+
+					} else {
+						PX4_ERR("instance %d alloc failed", i);
+						delete ekf2_inst;
+						break;
+					}
+				}
+
+				_ekf2_selector = new EKF2Selector();
+
+				if ((_ekf2_selector == nullptr) || !_ekf2_selector->Start()) {
+					PX4_ERR("selector start failed");
+				}
+			}
+
 			return PX4_OK;
 		}
 
@@ -2483,6 +1968,11 @@ The documentation can be found on the [ECL/EKF Overview & Tuning](https://docs.p
 ekf2 can be started in replay mode (`-r`): in this mode it does not access the system time, but only uses the
 timestamps from the sensor topics.
 
+With EKF2_MULTI_IMU set to 2 or more, one estimator instance runs per IMU (vehicle_imu), each on its own work queue
+and publishing the estimator_* topic instance with the same index. A lightweight selector republishes the outputs
+of the healthiest instance as vehicle_attitude, vehicle_local_position, vehicle_global_position and vehicle_odometry
+and reports an instance change as an estimator reset.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("ekf2", "estimator");
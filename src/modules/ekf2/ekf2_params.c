@@ -833,6 +833,22 @@ PARAM_DEFINE_FLOAT(EKF2_TERR_GRAD, 0.5f);
  */
 PARAM_DEFINE_INT32(EKF2_IMU_ID, 0);
 
+/**
+ * Multi-EKF IMUs
+ *
+ * Number of IMUs (vehicle_imu instances) to run a separate EKF instance on, each on its own work queue.
+ * The outputs of the healthiest instance are republished as vehicle_attitude, vehicle_local_position,
+ * vehicle_global_position and vehicle_odometry.
+ * Set to 0 or 1 to run a single instance on the IMU selected by EKF2_IMU_ID.
+ *
+ * @group EKF2
+ * @min 0
+ * @max 3
+ * @reboot_required true
+ * @category Developer
+ */
+PARAM_DEFINE_INT32(EKF2_MULTI_IMU, 0);
+
 /**
  * X position of IMU in body frame (forward axis with origin relative to vehicle centre of gravity)
  *
@@ -1375,37 +1391,6 @@ PARAM_DEFINE_FLOAT(EKF2_ABL_GYRLIM, 3.0f);
  */
 PARAM_DEFINE_FLOAT(EKF2_ABL_TAU, 0.5f);
 
-/**
- * Multi GPS Blending Control Mask.
- *
- * Set bits in the following positions to set which GPS accuracy metrics will be used to calculate the blending weight. Set to zero to disable and always used first GPS instance.
- * 0 : Set to true to use speed accuracy
- * 1 : Set to true to use horizontal position accuracy
- * 2 : Set to true to use vertical position accuracy
- *
- * @group EKF2
- * @min 0
- * @max 7
- * @bit 0 use speed accuracy
- * @bit 1 use hpos accuracy
- * @bit 2 use vpos accuracy
- */
-PARAM_DEFINE_INT32(EKF2_GPS_MASK, 0);
-
-/**
- * Multi GPS Blending Time Constant
- *
- * Sets the longest time constant that will be applied to the calculation of GPS position and height offsets used to correct data from multiple GPS data for steady state position differences.
- *
- *
- * @group EKF2
- * @min 1.0
- * @max 100.0
- * @unit s
- * @decimal 1
- */
-PARAM_DEFINE_FLOAT(EKF2_GPS_TAU, 10.0f);
-
 /**
  * Vehicle movement test threshold
  *
@@ -73,7 +73,7 @@ private:
 
 	uORB::Subscription _parameter_update_sub{ORB_ID(parameter_update)};
 	uORB::Subscription _actuator_ctrl_0_sub{ORB_ID(actuator_controls_0)};
-	uORB::SubscriptionCallbackWorkItem _esc_status_sub{this, ORB_ID(esc_status)};
+	uORB::SubscriptionCallbackWorkItemDeferred _esc_status_sub{this, ORB_ID(esc_status)};
 
 	static constexpr uint32_t ESC_BATTERY_INTERVAL_US = 20_ms; // assume higher frequency esc feedback than 50Hz
 	Battery _battery;
@@ -547,6 +547,9 @@ FixedwingPositionControl::control_position(const Vector2f &curr_pos, const Vecto
 
 	_control_position_last_called = hrt_absolute_time();
 
+	// set by tecs_update_pitch_throttle() if called with the inputs of this iteration
+	_tecs_input.valid = false;
+
 	_l1_control.set_dt(dt);
 
 	/* only run position controller in fixed-wing mode and during transitions for VTOL */
@@ -1002,6 +1005,15 @@ FixedwingPositionControl::control_position(const Vector2f &curr_pos, const Vecto
 		_att_sp.pitch_body = get_tecs_pitch();
 	}
 
+	// the fast loop can only take over for setpoints which only depend on TECS in between guidance updates
+	const bool tecs_only_setpoint = (_control_mode_current == FW_POSCTRL_MODE_AUTO
+					 && (pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_POSITION
+					     || pos_sp_curr.type == position_setpoint_s::SETPOINT_TYPE_LOITER))
+					|| _control_mode_current == FW_POSCTRL_MODE_POSITION
+					|| _control_mode_current == FW_POSCTRL_MODE_ALTITUDE;
+
+	_tecs_input.valid &= tecs_only_setpoint && use_tecs_pitch;
+
 	if (_control_mode.flag_control_position_enabled) {
 		_last_manual = false;
 
@@ -1543,6 +1555,10 @@ FixedwingPositionControl::Run()
 		_alt_reset_counter = _local_pos.vz_reset_counter;
 		_pos_reset_counter = _local_pos.vxy_reset_counter;
 
+		// a new setpoint, mode or vehicle state always triggers a guidance update
+		const bool guidance_inputs_updated = _pos_sp_triplet_sub.updated() || _control_mode_sub.updated() ||
+						     _vehicle_status_sub.updated() || _vehicle_land_detected_sub.updated();
+
 		airspeed_poll();
 		_manual_control_sub.update(&_manual);
 		_pos_sp_triplet_sub.update(&_pos_sp_triplet);
@@ -1569,11 +1585,24 @@ FixedwingPositionControl::Run()
 			}
 		}
 
-		/*
-		 * Attempt to control position, on success (= sensors present and not in manual mode),
-		 * publish setpoint.
-		 */
-		if (control_position(curr_pos, ground_speed, _pos_sp_triplet.previous, _pos_sp_triplet.current, _pos_sp_triplet.next)) {
+		bool publish_setpoint = true;
+
+		if (guidance_update_required(guidance_inputs_updated)) {
+			/*
+			 * Attempt to control position, on success (= sensors present and not in manual mode),
+			 * publish setpoint.
+			 */
+			publish_setpoint = control_position(curr_pos, ground_speed,
+							    _pos_sp_triplet.previous, _pos_sp_triplet.current, _pos_sp_triplet.next);
+
+			_last_guidance_update = _control_position_last_called;
+			_att_sp_roll_guidance = _att_sp.roll_body;
+
+		} else {
+			control_tecs_only();
+		}
+
+		if (publish_setpoint) {
 			_att_sp.timestamp = hrt_absolute_time();
 
 			// add attitude setpoint offsets
@@ -1611,6 +1640,41 @@ FixedwingPositionControl::Run()
 	}
 }
 
+bool
+FixedwingPositionControl::guidance_update_required(bool guidance_inputs_updated)
+{
+	if (_param_fw_guid_rate.get() < FLT_EPSILON || guidance_inputs_updated || !_tecs_input.valid) {
+		return true;
+	}
+
+	const hrt_abstime guidance_interval = static_cast<hrt_abstime>(1e6f / _param_fw_guid_rate.get());
+
+	return hrt_elapsed_time(&_last_guidance_update) >= guidance_interval;
+}
+
+void
+FixedwingPositionControl::control_tecs_only()
+{
+	tecs_update_pitch_throttle(_tecs_input.alt_sp, _tecs_input.airspeed_sp,
+				   _tecs_input.pitch_min_rad, _tecs_input.pitch_max_rad,
+				   _tecs_input.throttle_min, _tecs_input.throttle_max, _tecs_input.throttle_cruise,
+				   _tecs_input.climbout_mode, _tecs_input.climbout_pitch_min_rad,
+				   _tecs_input.mode);
+
+	if (_vehicle_land_detected.landed) {
+		// when we are landed state we want the motor to spin at idle speed
+		_att_sp.thrust_body[0] = min(_param_fw_thr_idle.get(), _tecs_input.throttle_max);
+
+	} else {
+		_att_sp.thrust_body[0] = min(get_tecs_thrust(), _tecs_input.throttle_max);
+	}
+
+	_att_sp.pitch_body = get_tecs_pitch();
+
+	// the roll setpoint is held from the last guidance update (the offset is added again before publishing)
+	_att_sp.roll_body = _att_sp_roll_guidance;
+}
+
 void
 FixedwingPositionControl::reset_takeoff_state(bool force)
 {
@@ -1656,6 +1720,18 @@ FixedwingPositionControl::tecs_update_pitch_throttle(float alt_sp, float airspee
 		bool climbout_mode, float climbout_pitch_min_rad,
 		uint8_t mode)
 {
+	_tecs_input.alt_sp = alt_sp;
+	_tecs_input.airspeed_sp = airspeed_sp;
+	_tecs_input.pitch_min_rad = pitch_min_rad;
+	_tecs_input.pitch_max_rad = pitch_max_rad;
+	_tecs_input.throttle_min = throttle_min;
+	_tecs_input.throttle_max = throttle_max;
+	_tecs_input.throttle_cruise = throttle_cruise;
+	_tecs_input.climbout_mode = climbout_mode;
+	_tecs_input.climbout_pitch_min_rad = climbout_pitch_min_rad;
+	_tecs_input.mode = mode;
+	_tecs_input.valid = true;
+
 	float dt = 0.01f; // prevent division with 0
 
 	if (_last_tecs_update > 0) {
@@ -248,6 +248,24 @@ private:
 	bool _is_tecs_running{false};
 	hrt_abstime _last_tecs_update{0};
 
+	/* fast TECS loop in between guidance updates (FW_GUID_RATE) */
+	struct {
+		float alt_sp;
+		float airspeed_sp;
+		float pitch_min_rad;
+		float pitch_max_rad;
+		float throttle_min;
+		float throttle_max;
+		float throttle_cruise;
+		bool climbout_mode;
+		float climbout_pitch_min_rad;
+		uint8_t mode;
+		bool valid;					///< inputs can be reused by the fast loop
+	} _tecs_input{};						///< TECS inputs of the last guidance update
+
+	float _att_sp_roll_guidance{0.0f};			///< roll setpoint of the last guidance update
+	hrt_abstime _last_guidance_update{0};			///< last run of the guidance (control_position)
+
 	float _asp_after_transition{0.0f};
 	bool _was_in_transition{false};
 
@@ -335,6 +353,17 @@ private:
 	float		get_tecs_pitch();
 	float		get_tecs_thrust();
 
+	/**
+	 * Check if the guidance (control_position()) has to run in this iteration,
+	 * otherwise only TECS is updated with the inputs of the last guidance update.
+	 */
+	bool		guidance_update_required(bool guidance_inputs_updated);
+
+	/**
+	 * Update TECS with the inputs of the last guidance update and set thrust and pitch setpoints.
+	 */
+	void		control_tecs_only();
+
 	float		get_demanded_airspeed();
 	float		calculate_target_airspeed(float airspeed_demand, const Vector2f &ground_speed);
 
@@ -368,6 +397,7 @@ private:
 		(ParamFloat<px4::params::FW_L1_DAMPING>) _param_fw_l1_damping,
 		(ParamFloat<px4::params::FW_L1_PERIOD>) _param_fw_l1_period,
 		(ParamFloat<px4::params::FW_L1_R_SLEW_MAX>) _param_fw_l1_r_slew_max,
+		(ParamFloat<px4::params::FW_GUID_RATE>) _param_fw_guid_rate,
 		(ParamFloat<px4::params::FW_R_LIM>) _param_fw_r_lim,
 
 		(ParamFloat<px4::params::FW_LND_AIRSPD_SC>) _param_fw_lnd_airspd_sc,
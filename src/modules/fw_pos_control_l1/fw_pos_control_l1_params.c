@@ -85,6 +85,25 @@ PARAM_DEFINE_FLOAT(FW_L1_DAMPING, 0.75f);
  */
 PARAM_DEFINE_FLOAT(FW_L1_R_SLEW_MAX, 90.0f);
 
+/**
+ * Guidance update rate
+ *
+ * Rate at which the L1 guidance, landing and takeoff logic is updated. In between, TECS and the
+ * thrust and pitch setpoints are still updated at the rate of the position estimate, using
+ * the altitude and airspeed setpoints of the last guidance update.
+ * Only used for position and loiter waypoints and in position and altitude control mode.
+ *
+ * The default value of 0 updates the guidance with every position estimate.
+ *
+ * @unit Hz
+ * @min 0
+ * @max 100
+ * @decimal 0
+ * @increment 1
+ * @group FW L1 Control
+ */
+PARAM_DEFINE_FLOAT(FW_GUID_RATE, 0.0f);
+
 /**
  * Cruise throttle
  *
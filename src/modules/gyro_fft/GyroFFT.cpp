@@ -0,0 +1,549 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "GyroFFT.hpp"
+
+#include <float.h>
+#include <math.h>
+
+GyroFFT::GyroFFT() :
+	ModuleParams(nullptr),
+	WorkItem(MODULE_NAME, px4::wq_configurations::lp_default)
+{
+}
+
+GyroFFT::~GyroFFT()
+{
+	FreeBuffers();
+
+	perf_free(_cycle_perf);
+	perf_free(_fft_perf);
+	perf_free(_gap_perf);
+}
+
+bool GyroFFT::init()
+{
+	const int fft_length = _param_imu_gyro_fft_len.get();
+
+	if ((fft_length != 256) && (fft_length != 512) && (fft_length != 1024)) {
+		PX4_ERR("invalid IMU_GYRO_FFT_LEN %d", fft_length);
+		return false;
+	}
+
+	if (!AllocateBuffers(fft_length)) {
+		PX4_ERR("failed to allocate buffers (FFT length %d)", fft_length);
+		return false;
+	}
+
+	if (!_sensor_selection_sub.registerCallback()) {
+		PX4_ERR("sensor_selection callback registration failed!");
+		return false;
+	}
+
+	ScheduleNow();
+
+	return true;
+}
+
+bool GyroFFT::AllocateBuffers(int fft_length)
+{
+	FreeBuffers();
+
+	const int half_length = fft_length / 2;
+
+	for (auto &buffer : _sample_buffer) {
+		buffer = new float[fft_length];
+	}
+
+	_cos_table = new float[half_length];
+	_sin_table = new float[half_length];
+	_fft_re = new float[half_length];
+	_fft_im = new float[half_length];
+	_power = new float[half_length];
+
+	bool allocated = _cos_table && _sin_table && _fft_re && _fft_im && _power;
+
+	for (auto &buffer : _sample_buffer) {
+		allocated = allocated && buffer;
+	}
+
+	if (!allocated) {
+		FreeBuffers();
+		return false;
+	}
+
+	for (int k = 0; k < half_length; k++) {
+		const float angle = 2.f * M_PI_F * k / fft_length;
+		_cos_table[k] = cosf(angle);
+		_sin_table[k] = sinf(angle);
+	}
+
+	_fft_length = fft_length;
+	ResetBuffers();
+
+	return true;
+}
+
+void GyroFFT::FreeBuffers()
+{
+	for (auto &buffer : _sample_buffer) {
+		delete[] buffer;
+		buffer = nullptr;
+	}
+
+	delete[] _cos_table;
+	delete[] _sin_table;
+	delete[] _fft_re;
+	delete[] _fft_im;
+	delete[] _power;
+
+	_cos_table = nullptr;
+	_sin_table = nullptr;
+	_fft_re = nullptr;
+	_fft_im = nullptr;
+	_power = nullptr;
+
+	_fft_length = 0;
+}
+
+void GyroFFT::ResetBuffers()
+{
+	_buffer_index = 0;
+	_buffer_filled = false;
+	_samples_since_fft = 0;
+	_fft_axis = 0;
+	_timestamp_sample_last = 0;
+
+	_sensor_gyro_fft = {};
+}
+
+bool GyroFFT::SensorSelectionUpdate(bool force)
+{
+	if (_sensor_selection_sub.updated() || (_selected_sensor_device_id == 0) || force) {
+		sensor_selection_s sensor_selection{};
+		_sensor_selection_sub.copy(&sensor_selection);
+
+		if ((sensor_selection.gyro_device_id != 0) && (_selected_sensor_device_id != sensor_selection.gyro_device_id)) {
+			for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+				sensor_gyro_fifo_s sensor_gyro_fifo{};
+
+				if (_sensor_gyro_fifo_sub[i].copy(&sensor_gyro_fifo)
+				    && (sensor_gyro_fifo.device_id == sensor_selection.gyro_device_id)
+				    && _sensor_gyro_fifo_sub[i].registerCallback()) {
+
+					for (int j = 0; j < MAX_SENSOR_COUNT; j++) {
+						if (j != i) {
+							_sensor_gyro_fifo_sub[j].unregisterCallback();
+						}
+					}
+
+					PX4_DEBUG("selected sensor changed %d -> %d", _selected_sensor_sub_index, i);
+					_selected_sensor_sub_index = i;
+					_selected_sensor_device_id = sensor_selection.gyro_device_id;
+
+					_sample_rate_hz = 0.f;
+					ResetBuffers();
+
+					return true;
+				}
+			}
+
+			// the selected gyro has no FIFO data (yet), wake up on any FIFO publication to try again
+			for (auto &sub : _sensor_gyro_fifo_sub) {
+				sub.registerCallback();
+			}
+
+			_selected_sensor_device_id = 0;
+			_selected_sensor_sub_index = -1;
+		}
+	}
+
+	return false;
+}
+
+void GyroFFT::ComputePowerSpectrum(int axis)
+{
+	const int N = _fft_length;
+	const int M = N / 2;
+	const float *x = _sample_buffer[axis];
+
+	float mean = 0.f;
+
+	for (int n = 0; n < N; n++) {
+		mean += x[n];
+	}
+
+	mean /= N;
+
+	// pack the real input (oldest sample first) as M = N/2 complex samples z[m] = x[2m] + i x[2m+1],
+	// applying the mean removal and the Hann window w[n] = 0.5 (1 - cos(2 pi n / N))
+	for (int m = 0; m < M; m++) {
+		const int n_even = 2 * m;
+		const int n_odd = 2 * m + 1;
+
+		const float w_even = (n_even < M) ? 0.5f * (1.f - _cos_table[n_even]) : 0.5f * (1.f + _cos_table[n_even - M]);
+		const float w_odd = (n_odd < M) ? 0.5f * (1.f - _cos_table[n_odd]) : 0.5f * (1.f + _cos_table[n_odd - M]);
+
+		_fft_re[m] = w_even * (x[(_buffer_index + n_even) & (N - 1)] - mean);
+		_fft_im[m] = w_odd * (x[(_buffer_index + n_odd) & (N - 1)] - mean);
+	}
+
+	// in place radix-2 complex FFT of length M, bit reversal permutation first
+	for (int i = 1, j = 0; i < M; i++) {
+		int bit = M >> 1;
+
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+
+		j ^= bit;
+
+		if (i < j) {
+			const float re = _fft_re[i];
+			const float im = _fft_im[i];
+			_fft_re[i] = _fft_re[j];
+			_fft_im[i] = _fft_im[j];
+			_fft_re[j] = re;
+			_fft_im[j] = im;
+		}
+	}
+
+	for (int len = 2; len <= M; len <<= 1) {
+		const int half = len / 2;
+		const int table_step = N / len; // W_len^j = W_N^(j N / len)
+
+		for (int i = 0; i < M; i += len) {
+			for (int j = 0; j < half; j++) {
+				const float wr = _cos_table[j * table_step];
+				const float wi = -_sin_table[j * table_step];
+
+				const int a = i + j;
+				const int b = a + half;
+
+				const float tr = _fft_re[b] * wr - _fft_im[b] * wi;
+				const float ti = _fft_re[b] * wi + _fft_im[b] * wr;
+
+				_fft_re[b] = _fft_re[a] - tr;
+				_fft_im[b] = _fft_im[a] - ti;
+				_fft_re[a] += tr;
+				_fft_im[a] += ti;
+			}
+		}
+	}
+
+	// split the complex result into the spectrum of the real input
+	//  X[k] = E[k] + W_N^k O[k], E[k] = (Z[k] + Z*[M-k]) / 2, O[k] = -i (Z[k] - Z*[M-k]) / 2
+	// and scale to the single sided power of a sinusoid, (2 / sum(w))^2 with sum(w) = N / 2 for the Hann window
+	const float scale = 16.f / ((float)N * (float)N);
+
+	_power[0] = (_fft_re[0] + _fft_im[0]) * (_fft_re[0] + _fft_im[0]) * scale;
+
+	for (int k = 1; k < M; k++) {
+		const float er = 0.5f * (_fft_re[k] + _fft_re[M - k]);
+		const float ei = 0.5f * (_fft_im[k] - _fft_im[M - k]);
+		const float o_r = 0.5f * (_fft_im[k] + _fft_im[M - k]);
+		const float o_i = -0.5f * (_fft_re[k] - _fft_re[M - k]);
+
+		const float c = _cos_table[k];
+		const float s = _sin_table[k];
+
+		const float xr = er + c * o_r + s * o_i;
+		const float xi = ei + c * o_i - s * o_r;
+
+		_power[k] = (xr * xr + xi * xi) * scale;
+	}
+}
+
+void GyroFFT::FindPeaks(float resolution_hz, float peak_frequencies[MAX_NUM_PEAKS]) const
+{
+	const int bins = _fft_length / 2;
+	const int k_min = math::max(1, (int)ceilf(_param_imu_gyro_fft_min.get() / resolution_hz));
+	const int k_max = math::min(bins - 2, (int)(_param_imu_gyro_fft_max.get() / resolution_hz));
+
+	for (int i = 0; i < MAX_NUM_PEAKS; i++) {
+		peak_frequencies[i] = 0.f;
+	}
+
+	if (k_max <= k_min) {
+		return;
+	}
+
+	float mean = 0.f;
+
+	for (int k = k_min; k <= k_max; k++) {
+		mean += _power[k];
+	}
+
+	mean /= (k_max - k_min + 1);
+
+	const float threshold = mean * powf(10.f, _param_imu_gyro_fft_snr.get() / 10.f);
+
+	// strongest local maxima above the threshold, sorted by power
+	int peak_index[MAX_NUM_PEAKS] {};
+	float peak_power[MAX_NUM_PEAKS] {};
+
+	for (int k = k_min; k <= k_max; k++) {
+		const float p = _power[k];
+
+		if ((p > threshold) && (p > _power[k - 1]) && (p >= _power[k + 1])) {
+			for (int i = 0; i < MAX_NUM_PEAKS; i++) {
+				if (p > peak_power[i]) {
+					for (int j = MAX_NUM_PEAKS - 1; j > i; j--) {
+						peak_power[j] = peak_power[j - 1];
+						peak_index[j] = peak_index[j - 1];
+					}
+
+					peak_power[i] = p;
+					peak_index[i] = k;
+					break;
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < MAX_NUM_PEAKS; i++) {
+		if (peak_power[i] > 0.f) {
+			const int k = peak_index[i];
+
+			// quadratic interpolation of the magnitude around the peak bin for sub bin resolution
+			const float a = sqrtf(_power[k - 1]);
+			const float b = sqrtf(_power[k]);
+			const float c = sqrtf(_power[k + 1]);
+			const float denominator = a - 2.f * b + c;
+
+			float delta = 0.f;
+
+			if (denominator < -FLT_EPSILON) {
+				delta = math::constrain(0.5f * (a - c) / denominator, -0.5f, 0.5f);
+			}
+
+			peak_frequencies[i] = (k + delta) * resolution_hz;
+		}
+	}
+}
+
+void GyroFFT::CompressSpectrum(float resolution_hz, uint8_t spectrum[SPECTRUM_BANDS]) const
+{
+	const int bins = _fft_length / 2;
+	const int k_max = math::min(bins - 1, (int)(_param_imu_gyro_fft_max.get() / resolution_hz));
+
+	// bins 1..k_max split into equal bands (DC excluded), strongest bin per band
+	for (int band = 0; band < SPECTRUM_BANDS; band++) {
+		const int k_start = 1 + (band * k_max) / SPECTRUM_BANDS;
+		const int k_end = 1 + ((band + 1) * k_max) / SPECTRUM_BANDS;
+
+		float power_max = 0.f;
+
+		for (int k = k_start; k < k_end; k++) {
+			power_max = math::max(power_max, _power[k]);
+		}
+
+		if (power_max > 0.f) {
+			// 0.5 dB per LSB, 0 = -100 dB
+			const float db = 10.f * log10f(power_max);
+			spectrum[band] = (uint8_t)math::constrain((db + 100.f) * 2.f, 0.f, 255.f);
+
+		} else {
+			spectrum[band] = 0;
+		}
+	}
+}
+
+void GyroFFT::Run()
+{
+	if (should_exit()) {
+		_sensor_selection_sub.unregisterCallback();
+
+		for (auto &sub : _sensor_gyro_fifo_sub) {
+			sub.unregisterCallback();
+		}
+
+		exit_and_cleanup();
+		return;
+	}
+
+	perf_begin(_cycle_perf);
+
+	// Check if parameters have changed
+	if (_parameter_update_sub.updated()) {
+		// clear update
+		parameter_update_s param_update;
+		_parameter_update_sub.copy(&param_update);
+
+		updateParams();
+	}
+
+	SensorSelectionUpdate();
+
+	if (_selected_sensor_sub_index < 0) {
+		perf_end(_cycle_perf);
+		return;
+	}
+
+	float *const peak_frequencies[3] {_sensor_gyro_fft.peak_frequencies_x, _sensor_gyro_fft.peak_frequencies_y, _sensor_gyro_fft.peak_frequencies_z};
+	uint8_t *const spectrum[3] {_sensor_gyro_fft.spectrum_x, _sensor_gyro_fft.spectrum_y, _sensor_gyro_fft.spectrum_z};
+
+	sensor_gyro_fifo_s sensor_gyro_fifo;
+
+	while (_sensor_gyro_fifo_sub[_selected_sensor_sub_index].update(&sensor_gyro_fifo)) {
+		if ((sensor_gyro_fifo.device_id != _selected_sensor_device_id) || (sensor_gyro_fifo.dt <= 0.f)) {
+			continue;
+		}
+
+		const float sample_rate_hz = 1e6f / sensor_gyro_fifo.dt;
+		const int samples = math::min((int)sensor_gyro_fifo.samples, (int)(sizeof(sensor_gyro_fifo.x) / sizeof(sensor_gyro_fifo.x[0])));
+
+		if (fabsf(sample_rate_hz - _sample_rate_hz) > 0.01f * _sample_rate_hz) {
+			PX4_DEBUG("sample rate changed %.1f -> %.1f Hz", (double)_sample_rate_hz, (double)sample_rate_hz);
+			_sample_rate_hz = sample_rate_hz;
+			ResetBuffers();
+
+		} else if ((_timestamp_sample_last != 0)
+			   && (sensor_gyro_fifo.timestamp_sample - _timestamp_sample_last > 2.f * samples * sensor_gyro_fifo.dt)) {
+			// missed FIFO data, the window would no longer be contiguous
+			perf_count(_gap_perf);
+			ResetBuffers();
+		}
+
+		_timestamp_sample_last = sensor_gyro_fifo.timestamp_sample;
+
+		for (int n = 0; n < samples; n++) {
+			_sample_buffer[0][_buffer_index] = sensor_gyro_fifo.x[n] * sensor_gyro_fifo.scale;
+			_sample_buffer[1][_buffer_index] = sensor_gyro_fifo.y[n] * sensor_gyro_fifo.scale;
+			_sample_buffer[2][_buffer_index] = sensor_gyro_fifo.z[n] * sensor_gyro_fifo.scale;
+
+			if (++_buffer_index >= _fft_length) {
+				_buffer_index = 0;
+				_buffer_filled = true;
+			}
+		}
+
+		_samples_since_fft += samples;
+
+		// one axis per FFT to spread the load, every axis is refreshed after half the FFT length (50% overlap)
+		if (_buffer_filled && (_samples_since_fft >= _fft_length / (2 * 3))) {
+			_samples_since_fft = 0;
+
+			perf_begin(_fft_perf);
+			const float resolution_hz = _sample_rate_hz / _fft_length;
+			ComputePowerSpectrum(_fft_axis);
+			FindPeaks(resolution_hz, peak_frequencies[_fft_axis]);
+			CompressSpectrum(resolution_hz, spectrum[_fft_axis]);
+			perf_end(_fft_perf);
+
+			if (_fft_axis == 2) {
+				_sensor_gyro_fft.timestamp_sample = sensor_gyro_fifo.timestamp_sample;
+				_sensor_gyro_fft.device_id = _selected_sensor_device_id;
+				_sensor_gyro_fft.sensor_sample_rate_hz = _sample_rate_hz;
+				_sensor_gyro_fft.resolution_hz = resolution_hz;
+				_sensor_gyro_fft.timestamp = hrt_absolute_time();
+				_sensor_gyro_fft_pub.publish(_sensor_gyro_fft);
+			}
+
+			_fft_axis = (_fft_axis + 1) % 3;
+		}
+	}
+
+	perf_end(_cycle_perf);
+}
+
+int GyroFFT::print_status()
+{
+	PX4_INFO("selected sensor: %d (%d), FFT length: %d, sample rate: %.1f Hz, resolution: %.2f Hz",
+		 _selected_sensor_device_id, _selected_sensor_sub_index, _fft_length, (double)_sample_rate_hz,
+		 (_fft_length > 0) ? (double)(_sample_rate_hz / _fft_length) : 0.0);
+
+	perf_print_counter(_cycle_perf);
+	perf_print_counter(_fft_perf);
+	perf_print_counter(_gap_perf);
+
+	return 0;
+}
+
+int GyroFFT::task_spawn(int argc, char *argv[])
+{
+	GyroFFT *instance = new GyroFFT();
+
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (instance->init()) {
+			return PX4_OK;
+		}
+
+	} else {
+		PX4_ERR("alloc failed");
+	}
+
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
+}
+
+int GyroFFT::custom_command(int argc, char *argv[])
+{
+	return print_usage("unknown command");
+}
+
+int GyroFFT::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Onboard spectral analysis of the selected gyro: runs a windowed real FFT over the raw `sensor_gyro_fifo`
+samples of each axis and publishes the strongest peak frequencies and a compressed spectrum as `sensor_gyro_fft`.
+
+### Implementation
+Each axis is transformed with a Hann window and 50% overlap. Only one axis is processed per FIFO update
+to spread the load, the work item runs on the low priority work queue.
+
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("gyro_fft", "system");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
+}
+
+extern "C" __EXPORT int gyro_fft_main(int argc, char *argv[])
+{
+	return GyroFFT::main(argc, argv);
+}
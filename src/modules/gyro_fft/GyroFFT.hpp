@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/math/Limits.hpp>
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/sensor_gyro_fft.h>
+#include <uORB/topics/sensor_gyro_fifo.h>
+#include <uORB/topics/sensor_selection.h>
+
+using namespace time_literals;
+
+class GyroFFT : public ModuleBase<GyroFFT>, public ModuleParams, public px4::WorkItem
+{
+public:
+	GyroFFT();
+	~GyroFFT() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	bool init();
+
+private:
+	static constexpr int MAX_SENSOR_COUNT = 3;
+	static constexpr int MAX_NUM_PEAKS = sizeof(sensor_gyro_fft_s::peak_frequencies_x) / sizeof(
+			sensor_gyro_fft_s::peak_frequencies_x[0]);
+	static constexpr int SPECTRUM_BANDS = sizeof(sensor_gyro_fft_s::spectrum_x) / sizeof(sensor_gyro_fft_s::spectrum_x[0]);
+
+	void Run() override;
+
+	bool AllocateBuffers(int fft_length);
+	void FreeBuffers();
+	void ResetBuffers();
+
+	bool SensorSelectionUpdate(bool force = false);
+
+	/**
+	 * Windowed real FFT of the latest _fft_length samples of one axis,
+	 * leaves the single sided power spectrum in _power.
+	 */
+	void ComputePowerSpectrum(int axis);
+
+	void FindPeaks(float resolution_hz, float peak_frequencies[MAX_NUM_PEAKS]) const;
+	void CompressSpectrum(float resolution_hz, uint8_t spectrum[SPECTRUM_BANDS]) const;
+
+	uORB::Publication<sensor_gyro_fft_s> _sensor_gyro_fft_pub{ORB_ID(sensor_gyro_fft)};
+
+	uORB::Subscription _parameter_update_sub{ORB_ID(parameter_update)};
+
+	uORB::SubscriptionCallbackWorkItem _sensor_selection_sub{this, ORB_ID(sensor_selection)};
+
+	uORB::SubscriptionCallbackWorkItem _sensor_gyro_fifo_sub[MAX_SENSOR_COUNT] {
+		{this, ORB_ID(sensor_gyro_fifo), 0},
+		{this, ORB_ID(sensor_gyro_fifo), 1},
+		{this, ORB_ID(sensor_gyro_fifo), 2}
+	};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
+	perf_counter_t _fft_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": fft")};
+	perf_counter_t _gap_perf{perf_alloc(PC_COUNT, MODULE_NAME": gap")};
+
+	uint32_t _selected_sensor_device_id{0};
+	int _selected_sensor_sub_index{-1};
+
+	int _fft_length{0};
+
+	// per axis sample ring buffers (_fft_length)
+	float *_sample_buffer[3] {};
+
+	// cos(2*pi*k/N), sin(2*pi*k/N) for k < N/2, also used to generate the Hann window
+	float *_cos_table{nullptr};
+	float *_sin_table{nullptr};
+
+	// N/2 point complex FFT work buffers and resulting power spectrum (N/2 bins)
+	float *_fft_re{nullptr};
+	float *_fft_im{nullptr};
+	float *_power{nullptr};
+
+	int _buffer_index{0};
+	bool _buffer_filled{false};
+	int _samples_since_fft{0};
+	int _fft_axis{0};
+
+	float _sample_rate_hz{0.f};
+	hrt_abstime _timestamp_sample_last{0};
+
+	sensor_gyro_fft_s _sensor_gyro_fft{};
+
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::IMU_GYRO_FFT_LEN>) _param_imu_gyro_fft_len,
+		(ParamFloat<px4::params::IMU_GYRO_FFT_MIN>) _param_imu_gyro_fft_min,
+		(ParamFloat<px4::params::IMU_GYRO_FFT_MAX>) _param_imu_gyro_fft_max,
+		(ParamFloat<px4::params::IMU_GYRO_FFT_SNR>) _param_imu_gyro_fft_snr
+	)
+};
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * IMU gyro FFT enable.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(IMU_GYRO_FFT_EN, 0);
+
+/**
+ * IMU gyro FFT length.
+ *
+ * Number of gyro FIFO samples per FFT. Longer FFTs give a finer frequency
+ * resolution at the cost of memory, CPU time and a slower response.
+ *
+ * @value 256 256
+ * @value 512 512
+ * @value 1024 1024
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_INT32(IMU_GYRO_FFT_LEN, 512);
+
+/**
+ * IMU gyro FFT minimum frequency.
+ *
+ * Lower bound of the peak search.
+ *
+ * @min 1
+ * @max 1000
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_MIN, 30.f);
+
+/**
+ * IMU gyro FFT maximum frequency.
+ *
+ * Upper bound of the peak search and of the published compressed spectrum.
+ *
+ * @min 1
+ * @max 1000
+ * @unit Hz
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_MAX, 200.f);
+
+/**
+ * IMU gyro FFT peak SNR threshold.
+ *
+ * A spectral peak is only reported if its power exceeds the mean power
+ * of the searched frequency range by at least this amount.
+ *
+ * @min 1
+ * @max 30
+ * @unit dB
+ * @decimal 1
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(IMU_GYRO_FFT_SNR, 10.f);
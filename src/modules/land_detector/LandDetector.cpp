@@ -58,18 +58,24 @@ LandDetector::~LandDetector()
 void LandDetector::start()
 {
 	_update_params();
-	ScheduleOnInterval(LAND_DETECTOR_UPDATE_INTERVAL);
+
+	_vehicle_local_position_sub.set_interval_us(LAND_DETECTOR_UPDATE_INTERVAL);
+	_vehicle_local_position_sub.registerCallback();
+
+	ScheduleDelayed(LAND_DETECTOR_TIMEOUT);
 }
 
 void LandDetector::Run()
 {
+	// backup schedule in case vehicle_local_position stops
+	ScheduleDelayed(LAND_DETECTOR_TIMEOUT);
+
 	perf_begin(_cycle_perf);
 
 	if (_parameter_update_sub.updated()) {
 		_update_params();
 	}
 
-	_actuator_armed_sub.update(&_actuator_armed);
 	_update_topics();
 	_update_state();
 
@@ -129,6 +135,7 @@ void LandDetector::Run()
 	perf_end(_cycle_perf);
 
 	if (should_exit()) {
+		_vehicle_local_position_sub.unregisterCallback();
 		ScheduleClear();
 		exit_and_cleanup();
 	}
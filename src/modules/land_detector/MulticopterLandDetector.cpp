@@ -100,6 +100,7 @@ void MulticopterLandDetector::_update_topics()
 
 		if (_hover_thrust_estimate_sub.update(&hte)) {
 			_params.hoverThrottle = hte.hover_thrust;
+			_update_thrust_thresholds();
 		}
 	}
 }
@@ -128,6 +129,31 @@ void MulticopterLandDetector::_update_params()
 		// TODO: this can be removed once HTE runs in all modes
 		_hover_thrust_initialized = true;
 	}
+
+	_update_thresholds();
+	_update_thrust_thresholds();
+}
+
+void MulticopterLandDetector::_update_thresholds()
+{
+	_land_speed_threshold = 0.9f * math::max(_params.landSpeed, 0.1f);
+
+	// Adjust max_climb_rate if land_speed is lower than 2x max_climb_rate
+	_max_climb_rate = math::min(0.5f * _land_speed_threshold, _param_lndmc_z_vel_max.get());
+
+	_xy_vel_max_sq = _param_lndmc_xy_vel_max.get() * _param_lndmc_xy_vel_max.get();
+	_max_rotation = math::radians(_param_lndmc_rot_max.get());
+}
+
+void MulticopterLandDetector::_update_thrust_thresholds()
+{
+	// 30% of throttle range between min and hover
+	_low_thrust_threshold = _params.minThrottle + (_params.hoverThrottle - _params.minThrottle) *
+				_param_lndmc_low_t_thr.get();
+
+	// 10% of throttle range between min and hover once we entered ground contact
+	_minimal_thrust_threshold = _params.minThrottle + (_params.hoverThrottle - _params.minThrottle) * 0.1f;
+	_minimal_thrust_threshold_manual = _params.minManThrottle + 0.01f;
 }
 
 bool MulticopterLandDetector::_get_freefall_state()
@@ -155,9 +181,6 @@ bool MulticopterLandDetector::_get_ground_contact_state()
 		return true;
 	}
 
-	// land speed threshold
-	float land_speed_threshold = 0.9f * math::max(_params.landSpeed, 0.1f);
-
 	// Check if we are moving vertically - this might see a spike after arming due to
 	// throttle-up vibration. If accelerating fast the throttle thresholds will still give
 	// an accurate in-air indication.
@@ -170,20 +193,17 @@ bool MulticopterLandDetector::_get_ground_contact_state()
 		vertical_movement = fabsf(_vehicle_local_position.vz) > _param_lndmc_z_vel_max.get()  * 2.5f;
 
 	} else {
-		// Adjust max_climb_rate if land_speed is lower than 2x max_climb_rate
-		float max_climb_rate = ((land_speed_threshold * 0.5f) < _param_lndmc_z_vel_max.get()) ? (0.5f * land_speed_threshold) :
-				       _param_lndmc_z_vel_max.get();
-		vertical_movement = fabsf(_vehicle_local_position.vz) > max_climb_rate;
+		vertical_movement = fabsf(_vehicle_local_position.vz) > _max_climb_rate;
 	}
 
 	// Check if we are moving horizontally.
-	_horizontal_movement = sqrtf(_vehicle_local_position.vx * _vehicle_local_position.vx
-				     + _vehicle_local_position.vy * _vehicle_local_position.vy) > _param_lndmc_xy_vel_max.get();
+	_horizontal_movement = (_vehicle_local_position.vx * _vehicle_local_position.vx
+				+ _vehicle_local_position.vy * _vehicle_local_position.vy) > _xy_vel_max_sq;
 
 	// if we have a valid velocity setpoint and the vehicle is demanded to go down but no vertical movement present,
 	// we then can assume that the vehicle hit ground
 	_in_descend = _is_climb_rate_enabled()
-		      && (_vehicle_local_position_setpoint.vz >= land_speed_threshold);
+		      && (_vehicle_local_position_setpoint.vz >= _land_speed_threshold);
 	bool hit_ground = _in_descend && !vertical_movement;
 
 	// TODO: we need an accelerometer based check for vertical movement for flying without GPS
@@ -215,7 +235,7 @@ bool MulticopterLandDetector::_get_maybe_landed_state()
 	}
 
 	// Next look if all rotation angles are not moving.
-	float max_rotation_scaled = math::radians(_param_lndmc_rot_max.get()) * landThresholdFactor;
+	float max_rotation_scaled = _max_rotation * landThresholdFactor;
 
 	bool rotating = (fabsf(_vehicle_angular_velocity.xyz[0]) > max_rotation_scaled) ||
 			(fabsf(_vehicle_angular_velocity.xyz[1]) > max_rotation_scaled) ||
@@ -298,23 +318,15 @@ bool MulticopterLandDetector::_is_climb_rate_enabled()
 
 bool MulticopterLandDetector::_has_low_thrust()
 {
-	// 30% of throttle range between min and hover
-	float sys_min_throttle = _params.minThrottle + (_params.hoverThrottle - _params.minThrottle) *
-				 _param_lndmc_low_t_thr.get();
-
 	// Check if thrust output is less than the minimum auto throttle param.
-	return _actuator_controls.control[actuator_controls_s::INDEX_THROTTLE] <= sys_min_throttle;
+	return _actuator_controls.control[actuator_controls_s::INDEX_THROTTLE] <= _low_thrust_threshold;
 }
 
 bool MulticopterLandDetector::_has_minimal_thrust()
 {
-	// 10% of throttle range between min and hover once we entered ground contact
-	float sys_min_throttle = _params.minThrottle + (_params.hoverThrottle - _params.minThrottle) * 0.1f;
-
 	// Determine the system min throttle based on flight mode
-	if (!_vehicle_control_mode.flag_control_climb_rate_enabled) {
-		sys_min_throttle = (_params.minManThrottle + 0.01f);
-	}
+	const float sys_min_throttle = _vehicle_control_mode.flag_control_climb_rate_enabled ? _minimal_thrust_threshold :
+				       _minimal_thrust_threshold_manual;
 
 	// Check if thrust output is less than the minimum auto throttle param.
 	return _actuator_controls.control[actuator_controls_s::INDEX_THROTTLE] <= sys_min_throttle;
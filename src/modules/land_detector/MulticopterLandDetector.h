@@ -79,6 +79,16 @@ private:
 	/** Get control mode dependent pilot throttle threshold with which we should quit landed state and take off. */
 	float _get_takeoff_throttle();
 
+	/**
+	 * Recompute the cached velocity and rotation thresholds, called on parameter updates.
+	 */
+	void _update_thresholds();
+
+	/**
+	 * Recompute the cached throttle thresholds, called on parameter and hover thrust updates.
+	 */
+	void _update_thrust_thresholds();
+
 	bool _has_low_thrust();
 	bool _has_minimal_thrust();
 	bool _has_altitude_lock();
@@ -116,10 +126,8 @@ private:
 
 	uORB::Subscription _actuator_controls_sub{ORB_ID(actuator_controls_0)};
 	uORB::Subscription _battery_sub{ORB_ID(battery_status)};
-	uORB::Subscription _vehicle_acceleration_sub{ORB_ID(vehicle_acceleration)};
 	uORB::Subscription _vehicle_angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
 	uORB::Subscription _vehicle_control_mode_sub{ORB_ID(vehicle_control_mode)};
-	uORB::Subscription _vehicle_local_position_sub{ORB_ID(vehicle_local_position)};
 	uORB::Subscription _vehicle_local_position_setpoint_sub{ORB_ID(vehicle_local_position_setpoint)};
 	uORB::Subscription _hover_thrust_estimate_sub{ORB_ID(hover_thrust_estimate)};
 
@@ -131,6 +139,15 @@ private:
 
 	bool _hover_thrust_initialized{false};
 
+	// thresholds derived from the parameters (and the hover thrust)
+	float _land_speed_threshold{0.f};	///< vertical velocity setpoint of a descend [m/s]
+	float _max_climb_rate{0.f};		///< max vertical velocity for ground contact [m/s]
+	float _xy_vel_max_sq{0.f};		///< max squared horizontal velocity for ground contact [m^2/s^2]
+	float _max_rotation{0.f};		///< max angular rate for maybe landed [rad/s]
+	float _low_thrust_threshold{0.f};	///< throttle below which there's ground contact
+	float _minimal_thrust_threshold{0.f};	///< throttle below which the vehicle is maybe landed (climb rate control)
+	float _minimal_thrust_threshold_manual{0.f}; ///< throttle below which the vehicle is maybe landed (manual)
+
 	hrt_abstime _min_trust_start{0};	///< timestamp when minimum trust was applied first
 	hrt_abstime _landed_time{0};
 
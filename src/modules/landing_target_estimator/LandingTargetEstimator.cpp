@@ -51,7 +51,8 @@
 namespace landing_target_estimator
 {
 
-LandingTargetEstimator::LandingTargetEstimator()
+LandingTargetEstimator::LandingTargetEstimator() :
+	WorkItem(MODULE_NAME, px4::wq_configurations::hp_default)
 {
 	_paramHandle.acc_unc = param_find("LTEST_ACC_UNC");
 	_paramHandle.meas_unc = param_find("LTEST_MEAS_UNC");
@@ -64,20 +65,68 @@ LandingTargetEstimator::LandingTargetEstimator()
 	_check_params(true);
 }
 
-void LandingTargetEstimator::update()
+bool LandingTargetEstimator::init()
 {
+	if (!_irlockReportSub.registerCallback()) {
+		PX4_ERR("irlock_report callback registration failed!");
+		return false;
+	}
+
+	return true;
+}
+
+void LandingTargetEstimator::request_stop()
+{
+	ModuleBase::request_stop();
+
+	// measurements might not arrive (anymore), run once to exit
+	ScheduleNow();
+}
+
+int LandingTargetEstimator::print_status()
+{
+	PX4_INFO("target %s, fused %u, out of sequence %u", _estimator_initialized ? "tracked" : "not tracked",
+		 _fused_count, _out_of_sequence_count);
+	return 0;
+}
+
+void LandingTargetEstimator::Run()
+{
+	if (should_exit()) {
+		_irlockReportSub.unregisterCallback();
+		exit_and_cleanup();
+		return;
+	}
+
 	_check_params(false);
 
 	_update_topics();
 
+	if (_irlockReportSub.update(&_irlockReport)) {
+		_update_state();
+	}
+}
+
+void LandingTargetEstimator::_update_state()
+{
+	// the filter state is kept at the time of the last measurement, so that delayed
+	// measurements are fused at the time they were taken
+	const hrt_abstime t_meas = (_irlockReport.timestamp != 0) ? _irlockReport.timestamp : hrt_absolute_time();
+
 	/* predict */
 	if (_estimator_initialized) {
-		if (hrt_absolute_time() - _last_update > landing_target_estimator_TIMEOUT_US) {
+		if (t_meas <= _last_predict) {
+			// out of sequence: older than the filter state, e.g. from a second source with more latency
+			_out_of_sequence_count++;
+			return;
+		}
+
+		if (t_meas - _last_update > landing_target_estimator_TIMEOUT_US) {
 			PX4_WARN("Timeout");
 			_estimator_initialized = false;
 
 		} else {
-			float dt = (hrt_absolute_time() - _last_predict) / SEC2USEC;
+			float dt = (t_meas - _last_predict) / SEC2USEC;
 
 			// predict target position with the help of accel data
 			matrix::Vector3f a{_vehicle_acceleration.xyz};
@@ -94,18 +143,10 @@ void LandingTargetEstimator::update()
 			_kalman_filter_x.predict(dt, -a(0), _params.acc_unc);
 			_kalman_filter_y.predict(dt, -a(1), _params.acc_unc);
 
-			_last_predict = hrt_absolute_time();
+			_last_predict = t_meas;
 		}
 	}
 
-	if (!_new_irlockReport) {
-		// nothing to do
-		return;
-	}
-
-	// mark this sensor measurement as consumed
-	_new_irlockReport = false;
-
 	if (!_vehicleAttitude_valid || !_vehicleLocalPosition_valid || !_vehicleLocalPosition.dist_bottom_valid) {
 		// don't have the data needed for an update
 		return;
@@ -147,8 +188,8 @@ void LandingTargetEstimator::update()
 		_kalman_filter_y.init(_rel_pos(1), vy_init, _params.pos_unc_init, _params.vel_unc_init);
 
 		_estimator_initialized = true;
-		_last_update = hrt_absolute_time();
-		_last_predict = _last_update;
+		_last_update = t_meas;
+		_last_predict = t_meas;
 
 	} else {
 		// update
@@ -205,8 +246,8 @@ void LandingTargetEstimator::update()
 
 			_targetPosePub.publish(_target_pose);
 
-			_last_update = hrt_absolute_time();
-			_last_predict = _last_update;
+			_last_update = t_meas;
+			_fused_count++;
 		}
 
 		float innov_x, innov_cov_x, innov_y, innov_cov_y;
@@ -239,11 +280,15 @@ void LandingTargetEstimator::_check_params(const bool force)
 
 void LandingTargetEstimator::_update_topics()
 {
-	_vehicleLocalPosition_valid = _vehicleLocalPositionSub.update(&_vehicleLocalPosition);
-	_vehicleAttitude_valid = _attitudeSub.update(&_vehicleAttitude);
-	_vehicle_acceleration_valid = _vehicle_acceleration_sub.update(&_vehicle_acceleration);
-
-	_new_irlockReport = _irlockReportSub.update(&_irlockReport);
+	// measurements can arrive faster than the vehicle state is published, use the latest state unless it is stale
+	_vehicleLocalPositionSub.update(&_vehicleLocalPosition);
+	_attitudeSub.update(&_vehicleAttitude);
+	_vehicle_acceleration_sub.update(&_vehicle_acceleration);
+
+	const hrt_abstime now = hrt_absolute_time();
+	_vehicleLocalPosition_valid = (now < _vehicleLocalPosition.timestamp + landing_target_estimator_STATE_TIMEOUT_US);
+	_vehicleAttitude_valid = (now < _vehicleAttitude.timestamp + landing_target_estimator_STATE_TIMEOUT_US);
+	_vehicle_acceleration_valid = (now < _vehicle_acceleration.timestamp + landing_target_estimator_STATE_TIMEOUT_US);
 }
 
 void LandingTargetEstimator::_update_params()
@@ -42,11 +42,13 @@
 
 #pragma once
 
-#include <px4_platform_common/workqueue.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
 #include <drivers/drv_hrt.h>
 #include <parameters/param.h>
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/vehicle_acceleration.h>
 #include <uORB/topics/vehicle_attitude.h>
 #include <uORB/topics/vehicle_local_position.h>
@@ -63,20 +65,37 @@
 namespace landing_target_estimator
 {
 
-class LandingTargetEstimator
+class LandingTargetEstimator : public ModuleBase<LandingTargetEstimator>, public px4::WorkItem
 {
 public:
 
 	LandingTargetEstimator();
-	virtual ~LandingTargetEstimator() = default;
+	~LandingTargetEstimator() override = default;
 
-	/*
-	 * Get new measurements and update the state estimate
-	 */
-	void update();
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	/** @see ModuleBase::request_stop() */
+	void request_stop() override;
+
+	bool init();
 
 protected:
 
+	/*
+	 * Get the new measurement and update the state estimate, triggered by irlock_report
+	 */
+	void Run() override;
+
 	/*
 	 * Update uORB topics.
 	 */
@@ -90,6 +109,9 @@ protected:
 	/* timeout after which filter is reset if target not seen */
 	static constexpr uint32_t landing_target_estimator_TIMEOUT_US = 2000000;
 
+	/* maximum age of the vehicle state used with a measurement */
+	static constexpr uint32_t landing_target_estimator_STATE_TIMEOUT_US = 500000;
+
 	uORB::Publication<landing_target_pose_s> _targetPosePub{ORB_ID(landing_target_pose)};
 	landing_target_pose_s _target_pose{};
 
@@ -131,7 +153,7 @@ private:
 	uORB::Subscription _vehicleLocalPositionSub{ORB_ID(vehicle_local_position)};
 	uORB::Subscription _attitudeSub{ORB_ID(vehicle_attitude)};
 	uORB::Subscription _vehicle_acceleration_sub{ORB_ID(vehicle_acceleration)};
-	uORB::Subscription _irlockReportSub{ORB_ID(irlock_report)};
+	uORB::SubscriptionCallbackWorkItem _irlockReportSub{this, ORB_ID(irlock_report)};
 
 	vehicle_local_position_s	_vehicleLocalPosition{};
 	vehicle_attitude_s		_vehicleAttitude{};
@@ -142,7 +164,6 @@ private:
 	bool _vehicleLocalPosition_valid{false};
 	bool _vehicleAttitude_valid{false};
 	bool _vehicle_acceleration_valid{false};
-	bool _new_irlockReport{false};
 	bool _estimator_initialized{false};
 	// keep track of whether last measurement was rejected
 	bool _faulty{false};
@@ -151,11 +172,17 @@ private:
 	matrix::Vector2f _rel_pos;
 	KalmanFilter _kalman_filter_x;
 	KalmanFilter _kalman_filter_y;
-	hrt_abstime _last_predict{0}; // timestamp of last filter prediction
+	hrt_abstime _last_predict{0}; // measurement timestamp the filter state refers to
 	hrt_abstime _last_update{0}; // timestamp of last filter update (used to check timeout)
 
+	uint32_t _fused_count{0};
+	uint32_t _out_of_sequence_count{0}; // measurements older than the filter state, dropped
+
 	void _check_params(const bool force);
 
+	/*
+	 * Predict the filter to the time of the new measurement and fuse it
+	 */
 	void _update_state();
 };
 
@@ -42,15 +42,7 @@
 
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/tasks.h>
-#include <px4_platform_common/posix.h>
-#include <unistd.h>
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <errno.h>
-#include <drivers/drv_hrt.h>
-#include <systemlib/err.h>
+#include <px4_platform_common/log.h>
 
 #include "LandingTargetEstimator.h"
 
@@ -58,96 +50,67 @@
 namespace landing_target_estimator
 {
 
-static bool thread_should_exit = false;	/**< daemon exit flag */
-static bool thread_running = false;		/**< daemon status flag */
-static int daemon_task;			/**< Handle of daemon task / thread */
-
-/* Run main loop at this rate in Hz. */
-static constexpr uint32_t landing_target_estimator_UPDATE_RATE_HZ = 50;
-
-/**
- * Landing target position estimator app start / stop handling function
- * This makes the module accessible from the nuttx shell
- * @ingroup apps
- */
-extern "C" __EXPORT int landing_target_estimator_main(int argc, char *argv[]);
-
-/**
- * Mainloop of daemon.
- */
-int landing_target_estimator_thread_main(int argc, char *argv[]);
-
-/**
-* Main entry point for this module
-**/
-int landing_target_estimator_main(int argc, char *argv[])
+int LandingTargetEstimator::task_spawn(int argc, char *argv[])
 {
+	LandingTargetEstimator *instance = new LandingTargetEstimator();
 
-	if (argc < 2) {
-		goto exiterr;
-	}
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
 
-	if (argc >= 2 && !strcmp(argv[1], "start")) {
-		if (thread_running) {
-			PX4_INFO("already running");
-			/* this is not an error */
-			return 0;
+		if (instance->init()) {
+			return PX4_OK;
 		}
 
-		thread_should_exit = false;
-		daemon_task = px4_task_spawn_cmd("landing_target_estimator",
-						 SCHED_DEFAULT,
-						 SCHED_PRIORITY_DEFAULT,
-						 2000,
-						 landing_target_estimator_thread_main,
-						 (argv) ? (char *const *)&argv[2] : nullptr);
-		return 0;
+	} else {
+		PX4_ERR("alloc failed");
 	}
 
-	if (!strcmp(argv[1], "stop")) {
-		thread_should_exit = true;
-
-		if (!thread_running) {
-			PX4_WARN("landing_target_estimator not running");
-		}
-
-		return 0;
-	}
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
 
-	if (!strcmp(argv[1], "status")) {
-		if (thread_running) {
-			PX4_INFO("running");
-
-		} else {
-			PX4_INFO("not started");
-		}
-
-		return 0;
-	}
-
-exiterr:
-	PX4_WARN("usage: landing_target_estimator {start|stop|status}");
-	return 1;
+	return PX4_ERROR;
 }
 
-int landing_target_estimator_thread_main(int argc, char *argv[])
+int LandingTargetEstimator::custom_command(int argc, char *argv[])
 {
-	PX4_DEBUG("starting");
+	return print_usage("unknown command");
+}
 
-	thread_running = true;
+int LandingTargetEstimator::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
 
-	LandingTargetEstimator est;
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Estimates the position of a landing target relative to the vehicle from `irlock_report` measurements
+and publishes it as `landing_target_pose`.
 
-	while (!thread_should_exit) {
-		est.update();
-		px4_usleep(1000000 / landing_target_estimator_UPDATE_RATE_HZ);
-	}
+The estimator runs for every new measurement, so faster sensors (e.g. vision at 200 Hz) reduce the
+latency of the estimate. The filter is predicted to the timestamp of each measurement, measurements
+older than the last fused one are dropped.
 
-	PX4_DEBUG("exiting");
+)DESCR_STR");
 
-	thread_running = false;
+	PRINT_MODULE_USAGE_NAME("landing_target_estimator", "estimator");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
 	return 0;
 }
 
+} // namespace landing_target_estimator
+
+/**
+ * Landing target position estimator app start / stop handling function
+ * This makes the module accessible from the nuttx shell
+ * @ingroup apps
+ */
+extern "C" __EXPORT int landing_target_estimator_main(int argc, char *argv[])
+{
+	return landing_target_estimator::LandingTargetEstimator::main(argc, argv);
 }
@@ -48,8 +48,18 @@
 #include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <systemlib/cpuload.h>
 #include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/actuator_armed.h>
 #include <uORB/topics/cpuload.h>
+#include <uORB/topics/irq_stats.h>
+#include <uORB/topics/perf_counters.h>
 #include <uORB/topics/task_stack_info.h>
+#include <uORB/topics/thread_load.h>
+#include <uORB/topics/work_queue_info.h>
+
+#if defined(PX4_MALLOC_TRACKER)
+#  include <px4_platform/malloc_tracker.h>
+#endif
 
 #if defined(__PX4_NUTTX) && !defined(CONFIG_SCHED_INSTRUMENTATION)
 #  error load_mon support requires CONFIG_SCHED_INSTRUMENTATION
@@ -95,7 +105,53 @@ private:
 	/** Calculate the memory usage */
 	float _ram_used();
 
+	/** Publish the stack usage of one work queue per cycle */
+	void _work_queue_info();
+
+	unsigned _work_queue_index{0};
+	uORB::PublicationQueued<work_queue_info_s> _work_queue_info_pub{ORB_ID(work_queue_info)};
+
+	/** Publish the statistics of the next timing perf counters (up to the queue length per cycle) */
+	void _perf_counters();
+
+	static void _perf_counters_callback(perf_counter_t handle, void *user);
+
+	unsigned _perf_counter_index{0}; ///< index of the next timing counter to publish
+	unsigned _perf_counter_iterated{0};
+	unsigned _perf_counters_published{0};
+	uORB::PublicationQueued<perf_counters_s> _perf_counters_pub{ORB_ID(perf_counters)};
+
+	/** Publish the CPU usage of all threads and WorkItems (one snapshot per cycle) */
+	void _thread_load();
+	void _thread_load_add(uint8_t type, const char *name, uint16_t pid, float load, uint64_t runtime_us,
+			      uint16_t stack_free);
+	void _thread_load_publish(bool last);
+
+	static constexpr unsigned MAX_WORK_QUEUE_ITEMS = 32; ///< per work queue
+	static constexpr unsigned MAX_WORK_ITEMS = 64; ///< in total (for the load calculation)
+
+	struct WorkItemRuntime {
+		const char *name;
+		uint64_t run_time_us;
+	};
+
+	px4::wq_item_info_t _work_queue_items[MAX_WORK_QUEUE_ITEMS] {};
+	WorkItemRuntime _work_item_runtime[MAX_WORK_ITEMS] {}; ///< of the previous snapshot, by position
+	hrt_abstime _thread_load_time{0}; ///< time of the last snapshot
+	unsigned _thread_load_entries{0};
+	thread_load_s _thread_load_msg{};
+	uORB::PublicationQueued<thread_load_s> _thread_load_pub{ORB_ID(thread_load)};
+
 #ifdef __PX4_NUTTX
+	struct TaskRuntime {
+		uint64_t runtime_us;
+		pid_t pid;
+		pid_t stack_pid;
+		uint16_t stack_free;
+	};
+
+	TaskRuntime _task_runtime[CONFIG_MAX_TASKS] {}; ///< of the previous snapshot, by system_load index
+
 	/* Calculate stack usage */
 	void _stack_usage();
 
@@ -103,6 +159,21 @@ private:
 	uORB::PublicationQueued<task_stack_info_s> _task_stack_info_pub{ORB_ID(task_stack_info)};
 #endif
 
+#if defined(PX4_IRQ_MONITOR)
+	/* Publish the interrupt latency statistics */
+	void _irq_stats();
+
+	uORB::Publication<irq_stats_s> _irq_stats_pub{ORB_ID(irq_stats)};
+#endif
+
+#if defined(PX4_MALLOC_TRACKER)
+	/* Pass the armed state to the allocation tracker and warn about allocations while armed */
+	void _malloc_tracker();
+
+	uORB::Subscription _actuator_armed_sub{ORB_ID(actuator_armed)};
+	uint32_t _armed_allocs{0};
+#endif
+
 	DEFINE_PARAMETERS(
 		(ParamBool<px4::params::SYS_STCK_EN>) _param_sys_stck_en
 	)
@@ -156,6 +227,9 @@ LoadMon::start()
 void LoadMon::Run()
 {
 	_cpuload();
+	_work_queue_info();
+	_thread_load();
+	_perf_counters();
 
 #ifdef __PX4_NUTTX
 
@@ -165,6 +239,14 @@ void LoadMon::Run()
 
 #endif
 
+#if defined(PX4_IRQ_MONITOR)
+	_irq_stats();
+#endif
+
+#if defined(PX4_MALLOC_TRACKER)
+	_malloc_tracker();
+#endif
+
 	if (should_exit()) {
 		ScheduleClear();
 		exit_and_cleanup();
@@ -218,6 +300,230 @@ float LoadMon::_ram_used()
 #endif
 }
 
+void LoadMon::_work_queue_info()
+{
+	px4::wq_info_t info{};
+
+	if (!px4::WorkQueueManagerInfo(_work_queue_index, info)) {
+		// start over
+		_work_queue_index = 0;
+
+		if (!px4::WorkQueueManagerInfo(_work_queue_index, info)) {
+			return;
+		}
+	}
+
+	_work_queue_index++;
+
+	work_queue_info_s work_queue_info{};
+	work_queue_info.stack_size = info.stack_size;
+	work_queue_info.stack_used_max = info.stack_used_max;
+	work_queue_info.num_items = info.num_items;
+	strncpy((char *)work_queue_info.name, info.name, sizeof(work_queue_info.name) - 1);
+	work_queue_info.timestamp = hrt_absolute_time();
+
+	_work_queue_info_pub.publish(work_queue_info);
+}
+
+void LoadMon::_thread_load()
+{
+	const hrt_abstime now = hrt_absolute_time();
+	const bool first = (_thread_load_time == 0);
+	const float interval_us = now - _thread_load_time;
+	_thread_load_time = now;
+
+	_thread_load_entries = 0;
+	_thread_load_msg = thread_load_s{};
+
+#ifdef __PX4_NUTTX
+
+	for (int i = 0; i < CONFIG_MAX_TASKS; i++) {
+		sched_lock();
+
+		if (!system_load.tasks[i].valid) {
+			sched_unlock();
+			continue;
+		}
+
+		const pid_t pid = system_load.tasks[i].tcb->pid;
+		const uint64_t runtime_us = system_load.tasks[i].total_runtime;
+		char name[CONFIG_TASK_NAME_SIZE + 1];
+		strncpy(name, system_load.tasks[i].tcb->name, CONFIG_TASK_NAME_SIZE);
+		name[CONFIG_TASK_NAME_SIZE] = '\0';
+
+		sched_unlock();
+
+		TaskRuntime &last = _task_runtime[i];
+		float load = 0.f;
+
+		if (!first && (last.pid == pid) && (runtime_us >= last.runtime_us)) {
+			load = (runtime_us - last.runtime_us) / interval_us;
+		}
+
+		last.pid = pid;
+		last.runtime_us = runtime_us;
+
+		if (!first) {
+			_thread_load_add(thread_load_s::TYPE_THREAD, name, pid, load, runtime_us,
+					 (last.stack_pid == pid) ? last.stack_free : 0);
+		}
+	}
+
+#endif
+
+	unsigned position = 0;
+
+	for (unsigned wq = 0; ; wq++) {
+		px4::wq_info_t info{};
+
+		if (!px4::WorkQueueManagerInfo(wq, info)) {
+			break;
+		}
+
+		const int num_items = px4::WorkQueueManagerItemsInfo(wq, _work_queue_items, MAX_WORK_QUEUE_ITEMS);
+
+		if (num_items < 0) {
+			break;
+		}
+
+		float item_load[MAX_WORK_QUEUE_ITEMS];
+		float wq_load = 0.f;
+		uint64_t wq_runtime_us = 0;
+
+		for (int i = 0; i < num_items; i++) {
+			const px4::wq_item_info_t &item = _work_queue_items[i];
+			item_load[i] = 0.f;
+
+			// the load is only known if the same item was at this position in the previous snapshot
+			if (position < MAX_WORK_ITEMS) {
+				WorkItemRuntime &last = _work_item_runtime[position];
+
+				if (!first && (last.name == item.name) && (item.run_time_total_us >= last.run_time_us)) {
+					item_load[i] = (item.run_time_total_us - last.run_time_us) / interval_us;
+				}
+
+				last.name = item.name;
+				last.run_time_us = item.run_time_total_us;
+			}
+
+			position++;
+			wq_load += item_load[i];
+			wq_runtime_us += item.run_time_total_us;
+		}
+
+		if (!first) {
+			_thread_load_add(thread_load_s::TYPE_WORK_QUEUE, info.name, 0, wq_load, wq_runtime_us, 0);
+
+			for (int i = 0; i < num_items; i++) {
+				_thread_load_add(thread_load_s::TYPE_WORK_ITEM, _work_queue_items[i].name, 0, item_load[i],
+						 _work_queue_items[i].run_time_total_us, 0);
+			}
+		}
+	}
+
+	if (_thread_load_msg.count > 0) {
+		_thread_load_publish(true);
+	}
+}
+
+void LoadMon::_thread_load_add(uint8_t type, const char *name, uint16_t pid, float load, uint64_t runtime_us,
+			       uint16_t stack_free)
+{
+	// more would be dropped from the queue before the logger gets them
+	if (_thread_load_entries >= thread_load_s::MAX_ENTRIES * thread_load_s::ORB_QUEUE_LENGTH) {
+		return;
+	}
+
+	if (_thread_load_msg.count == thread_load_s::MAX_ENTRIES) {
+		_thread_load_publish(false);
+	}
+
+	const int i = _thread_load_msg.count;
+	_thread_load_msg.type[i] = type;
+	_thread_load_msg.pid[i] = pid;
+	_thread_load_msg.load[i] = load;
+	_thread_load_msg.runtime_ms[i] = runtime_us / 1000;
+	_thread_load_msg.stack_free[i] = stack_free;
+	strncpy((char *)&_thread_load_msg.name[i * thread_load_s::NAME_LENGTH], name, thread_load_s::NAME_LENGTH);
+
+	_thread_load_msg.count++;
+	_thread_load_entries++;
+}
+
+void LoadMon::_thread_load_publish(bool last)
+{
+	_thread_load_msg.last = last;
+	_thread_load_msg.timestamp = _thread_load_time;
+	_thread_load_pub.publish(_thread_load_msg);
+
+	_thread_load_msg = thread_load_s{};
+	_thread_load_msg.first_entry = _thread_load_entries;
+}
+
+void LoadMon::_perf_counters()
+{
+	_perf_counter_iterated = 0;
+	_perf_counters_published = 0;
+	perf_iterate_all(_perf_counters_callback, this);
+
+	if (_perf_counters_published < perf_counters_s::ORB_QUEUE_LENGTH) {
+		// reached the end, start over
+		_perf_counter_index = 0;
+
+	} else {
+		_perf_counter_index += _perf_counters_published;
+	}
+}
+
+void LoadMon::_perf_counters_callback(perf_counter_t handle, void *user)
+{
+	LoadMon *self = (LoadMon *)user;
+
+	perf_counter_stats stats;
+	perf_get_stats(handle, &stats);
+
+	perf_counters_s perf_counters{};
+
+	switch (stats.type) {
+	case PC_ELAPSED:
+		perf_counters.type = perf_counters_s::TYPE_ELAPSED;
+		break;
+
+	case PC_INTERVAL:
+		perf_counters.type = perf_counters_s::TYPE_INTERVAL;
+		break;
+
+	case PC_HISTOGRAM:
+		perf_counters.type = perf_counters_s::TYPE_HISTOGRAM;
+		break;
+
+	case PC_ELAPSED_CYCLES:
+		perf_counters.type = perf_counters_s::TYPE_ELAPSED_CYCLES;
+		break;
+
+	default:
+		// event counts are not timing related
+		return;
+	}
+
+	if (self->_perf_counter_iterated++ < self->_perf_counter_index
+	    || self->_perf_counters_published >= perf_counters_s::ORB_QUEUE_LENGTH) {
+		return;
+	}
+
+	perf_counters.event_count = stats.event_count;
+	perf_counters.avg_us = stats.avg_us;
+	perf_counters.min_us = stats.min_us;
+	perf_counters.max_us = stats.max_us;
+	perf_counters.rms_us = stats.rms_us;
+	perf_counters.p99_us = stats.p99_us;
+	strncpy((char *)perf_counters.name, stats.name, sizeof(perf_counters.name) - 1);
+	perf_counters.timestamp = hrt_absolute_time();
+
+	self->_perf_counters_pub.publish(perf_counters);
+	self->_perf_counters_published++;
+}
+
 #ifdef __PX4_NUTTX
 void LoadMon::_stack_usage()
 {
@@ -240,6 +546,7 @@ void LoadMon::_stack_usage()
 		if (system_load.tasks[task_index].valid && (system_load.tasks[task_index].tcb->pid > 0)) {
 
 			stack_free = up_check_tcbstack_remain(system_load.tasks[task_index].tcb);
+			_task_runtime[task_index].stack_pid = system_load.tasks[task_index].tcb->pid;
 
 			static_assert(sizeof(task_stack_info.task_name) == CONFIG_TASK_NAME_SIZE,
 				      "task_stack_info.task_name must match NuttX CONFIG_TASK_NAME_SIZE");
@@ -271,6 +578,8 @@ void LoadMon::_stack_usage()
 
 		if (checked_task) {
 
+			_task_runtime[task_index].stack_free = stack_free;
+
 			task_stack_info.stack_free = stack_free;
 			task_stack_info.timestamp = hrt_absolute_time();
 
@@ -303,6 +612,57 @@ void LoadMon::_stack_usage()
 }
 #endif
 
+#if defined(PX4_IRQ_MONITOR)
+void LoadMon::_irq_stats()
+{
+	irq_stats_s irq_stats{};
+
+	irq_monitor_csection_s csection;
+	px4_irqmon_csection(&csection);
+	irq_stats.csection_count = csection.count;
+	irq_stats.csection_max_us = csection.max_us;
+	irq_stats.csection_max_caller = csection.max_caller;
+
+	irq_monitor_irq_s irqs[irq_stats_s::MAX_IRQS];
+	irq_stats.irq_count = px4_irqmon_slowest_irqs(irqs, irq_stats_s::MAX_IRQS);
+
+	for (int i = 0; i < irq_stats.irq_count; i++) {
+		irq_stats.irq[i] = irqs[i].irq;
+		irq_stats.irq_handler[i] = irqs[i].handler;
+		irq_stats.irq_events[i] = irqs[i].count;
+		irq_stats.irq_max_us[i] = irqs[i].max_us;
+		irq_stats.irq_avg_us[i] = irqs[i].avg_us;
+	}
+
+	irq_stats.timestamp = hrt_absolute_time();
+	_irq_stats_pub.publish(irq_stats);
+}
+#endif
+
+#if defined(PX4_MALLOC_TRACKER)
+void LoadMon::_malloc_tracker()
+{
+	actuator_armed_s actuator_armed;
+
+	if (_actuator_armed_sub.update(&actuator_armed)) {
+		px4_malloc_tracker_set_armed(actuator_armed.armed);
+	}
+
+	const uint32_t armed_allocs = px4_malloc_tracker_armed_count();
+
+	if (armed_allocs > _armed_allocs) {
+		malloc_tracker_alloc_s alloc;
+
+		if (px4_malloc_tracker_armed_allocs(&alloc, 1) == 1) {
+			PX4_WARN("%u allocations while armed, last: %u B by pid %i at 0x%08x", (unsigned)(armed_allocs - _armed_allocs),
+				 (unsigned)alloc.size, (int)alloc.pid, (unsigned)alloc.caller);
+		}
+	}
+
+	_armed_allocs = armed_allocs;
+}
+#endif
+
 int LoadMon::print_usage(const char *reason)
 {
 	if (reason) {
@@ -317,6 +677,21 @@ usage and publish the `cpuload` topic.
 
 On NuttX it also checks the stack usage of each process and if it falls below 300 bytes, a warning is output,
 which will also appear in the log file.
+
+It also publishes the stack size, stack high-water mark (NuttX) and number of WorkItems of each work queue
+(`work_queue_info`, one queue per cycle).
+
+Every cycle a snapshot of the CPU usage of all threads (NuttX) and of each work queue and its WorkItems is
+published as `thread_load` (split into messages of a few entries).
+
+The statistics of the timing perf counters are published as `perf_counters` (a few counters per cycle), so that they
+are logged continuously.
+
+On builds with interrupt monitoring (critmonitor and irqmonitor board variants) the longest critical section and the
+slowest interrupt handlers are published as `irq_stats`.
+
+On builds with the MALLOC_TRACKER board option it passes the armed state to the heap allocation tracker and warns
+about allocations while armed (see `memtrack`).
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("load_mon", "system");
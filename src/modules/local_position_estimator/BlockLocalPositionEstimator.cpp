@@ -27,10 +27,6 @@ BlockLocalPositionEstimator::BlockLocalPositionEstimator() :
 	// map projection
 	_map_ref(),
 
-	// flow gyro
-	_flow_gyro_x_high_pass(this, "FGYRO_HP"),
-	_flow_gyro_y_high_pass(this, "FGYRO_HP"),
-
 	// stats
 	_baroStats(this, ""),
 	_sonarStats(this, ""),
@@ -40,12 +36,6 @@ BlockLocalPositionEstimator::BlockLocalPositionEstimator() :
 	_mocapStats(this, ""),
 	_gpsStats(this, ""),
 
-	// low pass
-	_xLowPass(this, "X_LP"),
-
-	// use same lp constant for agl
-	_aglLowPass(this, "X_LP"),
-
 	// delay
 	_xDelay(this, ""),
 	_tDelay(this, ""),
@@ -187,6 +177,7 @@ void BlockLocalPositionEstimator::Run()
 
 	// set dt for all child blocks
 	setDt(dt);
+	_filters.setDt(dt);
 
 	// auto-detect connected rangefinders while not armed
 	_sub_armed.update();
@@ -241,8 +232,8 @@ void BlockLocalPositionEstimator::Run()
 	//      _x(X_tz) = _x(X_z);
 
 	//      // reset lowpass filter as well
-	//      _xLowPass.setState(_x);
-	//      _aglLowPass.setState(0);
+	//      _filters.get<X_LOW_PASS>().setState(_x);
+	//      _filters.get<AGL_LOW_PASS>().setState(0);
 	// }
 
 	_lastArmedState = armedState;
@@ -274,6 +265,7 @@ void BlockLocalPositionEstimator::Run()
 	// update parameters
 	if (paramsUpdated) {
 		SuperBlock::updateParams();
+		_filters.updateParams();
 		ModuleParams::updateParams();
 		updateSSParams();
 	}
@@ -549,7 +541,7 @@ bool BlockLocalPositionEstimator::landed()
 
 void BlockLocalPositionEstimator::publishLocalPos()
 {
-	const Vector<float, n_x> &xLP = _xLowPass.getState();
+	const Vector<float, n_x> &xLP = _filters.get<X_LOW_PASS>().getState();
 
 	// lie about eph/epv to allow visual odometry only navigation when velocity est. good
 	float evh = sqrtf(m_P(X_vx, X_vx) + m_P(X_vy, X_vy));
@@ -585,7 +577,7 @@ void BlockLocalPositionEstimator::publishLocalPos()
 		_pub_lpos.get().y = xLP(X_y);	// east
 
 		if (_param_lpe_fusion.get() & FUSE_PUB_AGL_Z) {
-			_pub_lpos.get().z = -_aglLowPass.getState();	// agl
+			_pub_lpos.get().z = -_filters.get<AGL_LOW_PASS>().getState();	// agl
 
 		} else {
 			_pub_lpos.get().z = xLP(X_z);	// down
@@ -610,7 +602,7 @@ void BlockLocalPositionEstimator::publishLocalPos()
 		_pub_lpos.get().ref_lat = _map_ref.lat_rad * 180 / M_PI;
 		_pub_lpos.get().ref_lon = _map_ref.lon_rad * 180 / M_PI;
 		_pub_lpos.get().ref_alt = _altOrigin;
-		_pub_lpos.get().dist_bottom = _aglLowPass.getState();
+		_pub_lpos.get().dist_bottom = _filters.get<AGL_LOW_PASS>().getState();
 		// we estimate agl even when we don't have terrain info
 		// if you are in terrain following mode this is important
 		// so that if terrain estimation fails there isn't a
@@ -630,7 +622,7 @@ void BlockLocalPositionEstimator::publishLocalPos()
 
 void BlockLocalPositionEstimator::publishOdom()
 {
-	const Vector<float, n_x> &xLP = _xLowPass.getState();
+	const Vector<float, n_x> &xLP = _filters.get<X_LOW_PASS>().getState();
 
 	// publish vehicle odometry
 	if (PX4_ISFINITE(_x(X_x)) && PX4_ISFINITE(_x(X_y)) && PX4_ISFINITE(_x(X_z)) &&
@@ -645,7 +637,7 @@ void BlockLocalPositionEstimator::publishOdom()
 		_pub_odom.get().y = xLP(X_y);	// east
 
 		if (_param_lpe_fusion.get() & FUSE_PUB_AGL_Z) {
-			_pub_odom.get().z = -_aglLowPass.getState();	// agl
+			_pub_odom.get().z = -_filters.get<AGL_LOW_PASS>().getState();	// agl
 
 		} else {
 			_pub_odom.get().z = xLP(X_z);	// down
@@ -776,7 +768,7 @@ void BlockLocalPositionEstimator::publishGlobalPos()
 	// publish global position
 	double lat = 0;
 	double lon = 0;
-	const Vector<float, n_x> &xLP = _xLowPass.getState();
+	const Vector<float, n_x> &xLP = _filters.get<X_LOW_PASS>().getState();
 	map_projection_reproject(&_map_ref, xLP(X_x), xLP(X_y), &lat, &lon);
 	float alt = -xLP(X_z) + _altOrigin;
 
@@ -970,8 +962,27 @@ void BlockLocalPositionEstimator::predict(const sensor_combined_s &imu)
 
 	// propagate
 	_x += dx;
-	Matrix<float, n_x, n_x> dP = (m_A * m_P + m_P * m_A.transpose() +
-				      m_B * m_R * m_B.transpose() + m_Q) * getDt();
+
+	// A only has non-zero entries in the position rows (velocity) and the velocity rows (-R_att for the bias),
+	// all other rows of A * P are zero, and P * A' = (A * P)' as P is symmetric
+	Matrix<float, n_x, n_x> AP;
+	AP.setZero();
+
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < n_x; j++) {
+			AP(X_x + i, j) = m_A(X_x + i, X_vx + i) * m_P(X_vx + i, j);
+			AP(X_vx + i, j) = m_A(X_vx + i, X_bx) * m_P(X_bx, j) +
+					  m_A(X_vx + i, X_by) * m_P(X_by, j) +
+					  m_A(X_vx + i, X_bz) * m_P(X_bz, j);
+		}
+	}
+
+	Matrix<float, n_x, n_x> dP = (AP + AP.transpose() + m_Q) * getDt();
+
+	// B * R * B', B maps the acceleration input directly onto the velocity states
+	for (size_t i = 0; i < n_u; i++) {
+		dP(X_vx + i, X_vx + i) += m_R(U_ax + i, U_ax + i) * getDt();
+	}
 
 	// covariance propagation logic
 	for (size_t i = 0; i < n_x; i++) {
@@ -987,8 +998,8 @@ void BlockLocalPositionEstimator::predict(const sensor_combined_s &imu)
 	}
 
 	m_P += dP;
-	_xLowPass.update(_x);
-	_aglLowPass.update(agl());
+	_filters.get<X_LOW_PASS>().update(_x);
+	_filters.get<AGL_LOW_PASS>().update(agl());
 }
 
 int BlockLocalPositionEstimator::getDelayPeriods(float delay, uint8_t *periods)
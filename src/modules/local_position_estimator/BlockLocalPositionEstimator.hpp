@@ -185,6 +185,52 @@ private:
 	// predict the next state
 	void predict(const sensor_combined_s &imu);
 
+	// kalman filter correction helpers, the measurement matrices C only
+	// have a few non-zero entries, so only those are used:
+	//
+	// residual covariance C * P * C', also returns P * C' for the correction
+	template<size_t n_y>
+	Matrix<float, n_y, n_y> residualCovariance(const Matrix<float, n_y, n_x> &C, Matrix<float, n_x, n_y> &PCt) const
+	{
+		PCt.setZero();
+
+		for (size_t k = 0; k < n_y; k++) {
+			for (size_t j = 0; j < n_x; j++) {
+				if (fabsf(C(k, j)) > 0) {
+					for (size_t i = 0; i < n_x; i++) {
+						PCt(i, k) += m_P(i, j) * C(k, j);
+					}
+				}
+			}
+		}
+
+		Matrix<float, n_y, n_y> S;
+		S.setZero();
+
+		for (size_t k = 0; k < n_y; k++) {
+			for (size_t j = 0; j < n_x; j++) {
+				if (fabsf(C(k, j)) > 0) {
+					for (size_t l = 0; l < n_y; l++) {
+						S(k, l) += C(k, j) * PCt(j, l);
+					}
+				}
+			}
+		}
+
+		return S;
+	}
+
+	// x += K * r, P -= K * C * P with K = P * C' * S_I,
+	// C * P = (P * C')' as P is symmetric
+	template<size_t n_y>
+	void kalmanCorrect(const Matrix<float, n_x, n_y> &PCt, const Matrix<float, n_y, n_y> &S_I,
+			   const Matrix<float, n_y, 1> &r)
+	{
+		const Matrix<float, n_x, n_y> K = PCt * S_I;
+		_x += K * r;
+		m_P -= K * PCt.transpose();
+	}
+
 	// lidar
 	int  lidarMeasure(Vector<float, n_y_lidar> &y);
 	void lidarCorrect();
@@ -300,9 +346,18 @@ private:
 		Target_Stationary = 1
 	};
 
-	// flow gyro filter
-	BlockHighPass _flow_gyro_x_high_pass;
-	BlockHighPass _flow_gyro_y_high_pass;
+	// parameterized filters, composed at compile time so that dt and parameter updates are inlined
+	enum StaticBlockIndex {
+		FLOW_GYRO_X_HIGH_PASS = 0,
+		FLOW_GYRO_Y_HIGH_PASS,
+		X_LOW_PASS,
+		AGL_LOW_PASS // same lp constant as the state
+	};
+
+	StaticSuperBlock<StaticHighPass<px4::params::LPE_FGYRO_HP>,
+			 StaticHighPass<px4::params::LPE_FGYRO_HP>,
+			 StaticLowPass<Vector<float, n_x>, px4::params::LPE_X_LP>,
+			 StaticLowPass<float, px4::params::LPE_X_LP>> _filters;
 
 	// stats
 	BlockStats<float, n_y_baro> _baroStats;
@@ -314,10 +369,6 @@ private:
 	BlockStats<double, n_y_gps> _gpsStats;
 	uint16_t _landCount;
 
-	// low pass
-	BlockLowPassVector<float, n_x> _xLowPass;
-	BlockLowPass _aglLowPass;
-
 	// delay blocks
 	BlockDelay<float, n_x, 1, HIST_LEN> _xDelay;
 	BlockDelay<uint64_t, 1, 1, HIST_LEN> _tDelay;
@@ -74,9 +74,9 @@ int BlockLocalPositionEstimator::flowMeasure(Vector<float, n_y_flow> &y)
 	float gyro_y_rad = 0;
 
 	if (_param_lpe_fusion.get() & FUSE_FLOW_GYRO_COMP) {
-		gyro_x_rad = _flow_gyro_x_high_pass.update(
+		gyro_x_rad = _filters.get<FLOW_GYRO_X_HIGH_PASS>().update(
 				     _sub_flow.get().gyro_x_rate_integral);
-		gyro_y_rad = _flow_gyro_y_high_pass.update(
+		gyro_y_rad = _filters.get<FLOW_GYRO_Y_HIGH_PASS>().update(
 				     _sub_flow.get().gyro_y_rate_integral);
 	}
 
@@ -169,7 +169,8 @@ void BlockLocalPositionEstimator::flowCorrect()
 	Vector<float, 2> r = y - C * _x;
 
 	// residual covariance
-	Matrix<float, n_y_flow, n_y_flow> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_x, n_y_flow> PCt;
+	Matrix<float, n_y_flow, n_y_flow> S = residualCovariance(C, PCt) + R;
 
 	// publish innovations
 	_pub_innov.get().flow[0] = r(0);
@@ -195,11 +196,7 @@ void BlockLocalPositionEstimator::flowCorrect()
 	}
 
 	if (!(_sensorFault & SENSOR_FLOW)) {
-		Matrix<float, n_x, n_y_flow> K =
-			m_P * C.transpose() * S_I;
-		Vector<float, n_x> dx = K * r;
-		_x += dx;
-		m_P -= K * C * m_P;
+		kalmanCorrect(PCt, S_I, r);
 	}
 }
 
@@ -186,7 +186,8 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	Vector<float, n_y_gps> r = y - C * x0;
 
 	// residual covariance
-	Matrix<float, n_y_gps, n_y_gps> S = C * m_P * C.transpose() + R;
+	Matrix<float, n_x, n_y_gps> PCt;
+	Matrix<float, n_y_gps, n_y_gps> S = residualCovariance(C, PCt) + R;
 
 	// publish innovations
 	_pub_innov.get().gps_hpos[0] = r(0);
@@ -227,10 +228,7 @@ void BlockLocalPositionEstimator::gpsCorrect()
 	}
 
 	// kalman filter correction always for GPS
-	Matrix<float, n_x, n_y_gps> K = m_P * C.transpose() * S_I;
-	Vector<float, n_x> dx = K * r;
-	_x += dx;
-	m_P -= K * C * m_P;
+	kalmanCorrect(PCt, S_I, r);
 }
 
 void BlockLocalPositionEstimator::gpsCheckTimeout()
@@ -81,8 +81,9 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 	Vector<float, n_y_target> r = y - C * _x;
 
 	// residual covariance, (inverse)
+	Matrix<float, n_x, n_y_target> PCt;
 	Matrix<float, n_y_target, n_y_target> S_I =
-		inv<float, n_y_target>(C * m_P * C.transpose() + R);
+		inv<float, n_y_target>(residualCovariance(C, PCt) + R);
 
 	// fault detection
 	float beta = (r.transpose()  * (S_I * r))(0, 0);
@@ -102,11 +103,7 @@ void BlockLocalPositionEstimator::landingTargetCorrect()
 	}
 
 	// kalman filter correction
-	Matrix<float, n_x, n_y_target> K =
-		m_P * C.transpose() * S_I;
-	Vector<float, n_x> dx = K * r;
-	_x += dx;
-	m_P -= K * C * m_P;
+	kalmanCorrect(PCt, S_I, r);
 
 }
 
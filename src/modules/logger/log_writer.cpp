@@ -56,6 +56,18 @@ LogWriter::LogWriter(Backend configured_backend, size_t file_buffer_size)
 			PX4_ERR("LogWriterMavlink allocation failed");
 		}
 	}
+
+#if defined(__PX4_POSIX)
+
+	if (configured_backend & BackendUdp) {
+		_log_writer_udp_for_write = _log_writer_udp = new LogWriterUdp();
+
+		if (!_log_writer_udp) {
+			PX4_ERR("LogWriterUdp allocation failed");
+		}
+	}
+
+#endif
 }
 
 bool LogWriter::init()
@@ -81,6 +93,17 @@ bool LogWriter::init()
 		}
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp) {
+		if (!_log_writer_udp->init()) {
+			PX4_ERR("udp init failed");
+			return false;
+		}
+	}
+
+#endif
+
 	return true;
 }
 
@@ -93,6 +116,14 @@ LogWriter::~LogWriter()
 	if (_log_writer_mavlink) {
 		delete (_log_writer_mavlink);
 	}
+
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp) {
+		delete (_log_writer_udp);
+	}
+
+#endif
 }
 
 bool LogWriter::is_started(LogType type) const
@@ -107,6 +138,14 @@ bool LogWriter::is_started(LogType type) const
 		ret = ret || _log_writer_mavlink->is_started();
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp && type == LogType::Full) {
+		ret = ret || _log_writer_udp->is_started();
+	}
+
+#endif
+
 	return ret;
 }
 
@@ -120,6 +159,14 @@ bool LogWriter::is_started(LogType type, Backend query_backend) const
 		return _log_writer_mavlink->is_started();
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (query_backend == BackendUdp && _log_writer_udp && type == LogType::Full) {
+		return _log_writer_udp->is_started();
+	}
+
+#endif
+
 	return false;
 }
 
@@ -151,6 +198,41 @@ void LogWriter::stop_log_mavlink()
 	}
 }
 
+bool LogWriter::set_udp_destination(const char *destination)
+{
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp) {
+		return _log_writer_udp->set_destination(destination);
+	}
+
+#endif
+
+	return false;
+}
+
+void LogWriter::start_log_udp()
+{
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp) {
+		_log_writer_udp->start_log();
+	}
+
+#endif
+}
+
+void LogWriter::stop_log_udp()
+{
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp) {
+		_log_writer_udp->stop_log();
+	}
+
+#endif
+}
+
 void LogWriter::thread_stop()
 {
 	if (_log_writer_file) {
@@ -170,6 +252,14 @@ int LogWriter::write_message(LogType type, void *ptr, size_t size, uint64_t drop
 		ret_mavlink = _log_writer_mavlink_for_write->write_message(ptr, size);
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_log_writer_udp_for_write && type == LogType::Full) {
+		_log_writer_udp_for_write->write_message(ptr, size);
+	}
+
+#endif
+
 	// file backend errors takes precedence
 	if (ret_file != 0) {
 		return ret_file;
@@ -193,6 +283,17 @@ void LogWriter::select_write_backend(Backend sel_backend)
 	} else {
 		_log_writer_mavlink_for_write = nullptr;
 	}
+
+#if defined(__PX4_POSIX)
+
+	if (sel_backend & BackendUdp) {
+		_log_writer_udp_for_write = _log_writer_udp;
+
+	} else {
+		_log_writer_udp_for_write = nullptr;
+	}
+
+#endif
 }
 
 }
@@ -35,6 +35,9 @@
 
 #include "log_writer_file.h"
 #include "log_writer_mavlink.h"
+#if defined(__PX4_POSIX)
+#include "log_writer_udp.h"
+#endif
 
 namespace px4
 {
@@ -54,6 +57,7 @@ public:
 	static constexpr Backend BackendFile = 1 << 0;
 	static constexpr Backend BackendMavlink = 1 << 1;
 	static constexpr Backend BackendAll = BackendFile | BackendMavlink;
+	static constexpr Backend BackendUdp = 1 << 2; ///< raw UDP stream of the full log (POSIX only, in addition to the others)
 
 	LogWriter(Backend configured_backend, size_t file_buffer_size);
 	~LogWriter();
@@ -73,6 +77,16 @@ public:
 
 	void stop_log_mavlink();
 
+	/**
+	 * set the destination of the UDP backend ("<ip>[:<port>]"), must be called before init()
+	 * @return false if the UDP backend is not enabled or the destination is invalid
+	 */
+	bool set_udp_destination(const char *destination);
+
+	void start_log_udp();
+
+	void stop_log_udp();
+
 	/**
 	 * whether logging is currently active or not (any of the selected backends).
 	 */
@@ -84,7 +98,8 @@ public:
 	bool is_started(LogType type, Backend query_backend) const;
 
 	/**
-	 * Write a single ulog message (including header). The caller must call lock() before calling this.
+	 * Write a single ulog message (including header). Must only be called from a single thread (the logger),
+	 * the file backend buffer is a single-producer/single-consumer ring shared with the writer thread.
 	 * @param dropout_start timestamp when lastest dropout occured. 0 if no dropout at the moment.
 	 * @return 0 on success (or if no logging started),
 	 *         -1 if not enough space in the buffer left (file backend), -2 mavlink backend failed
@@ -98,23 +113,20 @@ public:
 	 * @param backend
 	 */
 	void select_write_backend(Backend sel_backend);
-	void unselect_write_backend() { select_write_backend(BackendAll); }
+	void unselect_write_backend() { select_write_backend(BackendAll | BackendUdp); }
 
 	/* file logging methods */
 
-	void lock()
-	{
-		if (_log_writer_file) { _log_writer_file->lock(); }
-	}
-
-	void unlock()
-	{
-		if (_log_writer_file) { _log_writer_file->unlock(); }
-	}
-
 	void notify()
 	{
 		if (_log_writer_file) { _log_writer_file->notify(); }
+
+#if defined(__PX4_POSIX)
+
+		// the UDP backend is written from the logger thread, so this is where a partial datagram is sent
+		if (_log_writer_udp) { _log_writer_udp->flush(); }
+
+#endif
 	}
 
 	size_t get_total_written_file(LogType type) const
@@ -138,6 +150,23 @@ public:
 		return 0;
 	}
 
+	uint64_t get_total_write_time_us_file(LogType type) const
+	{
+		if (_log_writer_file) { return _log_writer_file->get_total_write_time_us(type); }
+
+		return 0;
+	}
+
+	void set_aligned_writes_file(bool aligned)
+	{
+		if (_log_writer_file) { _log_writer_file->set_aligned_writes(aligned); }
+	}
+
+	void set_preallocation_file(size_t size)
+	{
+		if (_log_writer_file) { _log_writer_file->set_preallocation(size); }
+	}
+
 	pthread_t thread_id_file() const
 	{
 		if (_log_writer_file) { return _log_writer_file->thread_id(); }
@@ -155,6 +184,12 @@ public:
 		if (_log_writer_file) { _log_writer_file->set_need_reliable_transfer(need_reliable); }
 
 		if (_log_writer_mavlink) { _log_writer_mavlink->set_need_reliable_transfer(need_reliable); }
+
+#if defined(__PX4_POSIX)
+
+		if (_log_writer_udp) { _log_writer_udp->set_need_reliable_transfer(need_reliable); }
+
+#endif
 	}
 
 	bool need_reliable_transfer() const
@@ -163,9 +198,20 @@ public:
 
 		if (_log_writer_mavlink) { return _log_writer_mavlink->need_reliable_transfer(); }
 
+#if defined(__PX4_POSIX)
+
+		if (_log_writer_udp) { return _log_writer_udp->need_reliable_transfer(); }
+
+#endif
+
 		return false;
 	}
 
+#if defined(__PX4_POSIX)
+	/** UDP backend, nullptr if not enabled */
+	const LogWriterUdp *log_writer_udp() const { return _log_writer_udp; }
+#endif
+
 private:
 
 	LogWriterFile *_log_writer_file = nullptr;
@@ -175,6 +221,11 @@ private:
 		nullptr; ///< pointer that is used for writing, to temporarily select write backends
 	LogWriterMavlink *_log_writer_mavlink_for_write = nullptr;
 
+#if defined(__PX4_POSIX)
+	LogWriterUdp *_log_writer_udp = nullptr;
+	LogWriterUdp *_log_writer_udp_for_write = nullptr;
+#endif
+
 	const Backend _backend;
 };
 
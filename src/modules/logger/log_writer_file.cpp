@@ -37,6 +37,7 @@
 #include <fcntl.h>
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include <mathlib/mathlib.h>
 #include <px4_platform_common/posix.h>
@@ -63,7 +64,12 @@ LogWriterFile::LogWriterFile(size_t buffer_size)
 
 	{
 		300, // buffer size for the mission log (can be kept fairly small)
-		perf_alloc(PC_ELAPSED, "logger_sd_write_mission"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_mission")}
+		perf_alloc(PC_ELAPSED, "logger_sd_write_mission"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_mission")},
+
+	{
+		// only allocated when the high-rate log is started
+		math::max(buffer_size, _min_write_chunk + 300),
+		perf_alloc(PC_ELAPSED, "logger_sd_write_high_rate"), perf_alloc(PC_ELAPSED, "logger_sd_fsync_high_rate")}
 }
 {
 	pthread_mutex_init(&_mtx, nullptr);
@@ -107,9 +113,27 @@ void LogWriterFile::start_log(LogType type, const char *filename)
 		}
 	}
 
-	if (_buffers[(int)type].start_log(filename)) {
+	if (type == LogType::HighRate && !_high_rate_thread_started) {
+		int ret = thread_start(&_high_rate_thread, &LogWriterFile::run_high_rate_helper, 1170);
+
+		if (ret) {
+			PX4_ERR("failed to create high-rate writer thread (%i)", ret);
+			return;
+		}
+
+		_high_rate_thread_started = true;
+	}
+
+	// the writer thread does not access the buffer while the file is closed, but it scans the
+	// buffers under the lock
+	lock();
+	const bool started = _buffers[(int)type].start_log(filename, _aligned_writes && type != LogType::Mission,
+			     type != LogType::Mission ? _preallocation_size : 0);
+	unlock();
+
+	if (started) {
 		PX4_INFO("Opened %s log file: %s", log_type_str(type), filename);
-		notify();
+		wakeup();
 	}
 }
 
@@ -148,10 +172,15 @@ int LogWriterFile::hardfault_store_filename(const char *log_file)
 void LogWriterFile::stop_log(LogType type)
 {
 	_buffers[(int)type]._should_run = false;
-	notify();
+	wakeup();
 }
 
 int LogWriterFile::thread_start()
+{
+	return thread_start(&_thread, &LogWriterFile::run_helper, 1170);
+}
+
+int LogWriterFile::thread_start(pthread_t *thread, void *(*helper)(void *), size_t stack_size)
 {
 	pthread_attr_t thr_attr;
 	pthread_attr_init(&thr_attr);
@@ -161,9 +190,9 @@ int LogWriterFile::thread_start()
 	param.sched_priority = SCHED_PRIORITY_DEFAULT - 40;
 	(void)pthread_attr_setschedparam(&thr_attr, &param);
 
-	pthread_attr_setstacksize(&thr_attr, PX4_STACK_ADJUSTED(1170));
+	pthread_attr_setstacksize(&thr_attr, PX4_STACK_ADJUSTED(stack_size));
 
-	int ret = pthread_create(&_thread, &thr_attr, &LogWriterFile::run_helper, this);
+	int ret = pthread_create(thread, &thr_attr, helper, this);
 	pthread_attr_destroy(&thr_attr);
 
 	return ret;
@@ -173,29 +202,52 @@ void LogWriterFile::thread_stop()
 {
 	// this will terminate the main loop of the writer thread
 	_exit_thread = true;
-	_buffers[0]._should_run = _buffers[1]._should_run = false;
 
-	notify();
+	for (int i = 0; i < (int)LogType::Count; ++i) {
+		_buffers[i]._should_run = false;
+	}
+
+	wakeup();
 
-	// wait for thread to complete
+	// wait for thread(s) to complete
 	int ret = pthread_join(_thread, nullptr);
 
 	if (ret) {
 		PX4_WARN("join failed: %d", ret);
 	}
 
+	if (_high_rate_thread_started) {
+		ret = pthread_join(_high_rate_thread, nullptr);
+
+		if (ret) {
+			PX4_WARN("join failed: %d", ret);
+		}
+
+		_high_rate_thread_started = false;
+	}
 }
 
 void *LogWriterFile::run_helper(void *context)
 {
 	px4_prctl(PR_SET_NAME, "log_writer_file", px4_getpid());
 
-	static_cast<LogWriterFile *>(context)->run();
+	static_cast<LogWriterFile *>(context)->run(LogType::Full, LogType::Mission);
+	return nullptr;
+}
+
+void *LogWriterFile::run_high_rate_helper(void *context)
+{
+	px4_prctl(PR_SET_NAME, "log_writer_hr", px4_getpid());
+
+	static_cast<LogWriterFile *>(context)->run(LogType::HighRate, LogType::HighRate);
 	return nullptr;
 }
 
-void LogWriterFile::run()
+void LogWriterFile::run(LogType first_type, LogType last_type)
 {
+	const int first = (int)first_type;
+	const int last = (int)last_type;
+
 	while (!_exit_thread) {
 		// Outer endless loop
 		// Wait for _should_run flag
@@ -203,7 +255,11 @@ void LogWriterFile::run()
 			bool start = false;
 			pthread_mutex_lock(&_mtx);
 			pthread_cond_wait(&_cv, &_mtx);
-			start = _buffers[0]._should_run || _buffers[1]._should_run;
+
+			for (int i = first; i <= last; ++i) {
+				start = start || _buffers[i]._should_run;
+			}
+
 			pthread_mutex_unlock(&_mtx);
 
 			if (start) {
@@ -235,17 +291,41 @@ void LogWriterFile::run()
 
 			constexpr size_t min_available[(int)LogType::Count] = {
 				_min_write_chunk,
-				1 // For the mission log, write as soon as there is data available
+				1, // For the mission log, write as soon as there is data available
+				_min_write_chunk
 			};
 
 			/* Check all buffers for available data. Mission log is first to avoid drops */
-			int i = (int)LogType::Count - 1;
+			int i = last;
 
-			while (i >= 0) {
+			while (i >= first) {
 				void *read_ptr;
 				bool is_part;
 				LogFileBuffer &buffer = _buffers[i];
-				size_t available = buffer.get_read_ptr(&read_ptr, &is_part);
+
+				if (buffer.fd() < 0) {
+					// not logging, or closed after a write error (the logger might still be writing)
+					--i;
+					continue;
+				}
+
+				if (buffer.needs_preallocation()) {
+					// the file is only closed by this thread
+					pthread_mutex_unlock(&_mtx);
+					buffer.preallocate();
+					pthread_mutex_lock(&_mtx);
+				}
+
+				size_t available;
+
+				if (buffer.aligned() && buffer._should_run) {
+					// only write whole chunks, the remaining tail is written on the next iteration
+					available = buffer.get_aligned_read_ptr(&read_ptr, _min_write_chunk);
+					is_part = false;
+
+				} else {
+					available = buffer.get_read_ptr(&read_ptr, &is_part);
+				}
 
 				/* if sufficient data available or partial read or terminating, write data */
 				if (available >= min_available[i] || is_part || (!buffer._should_run && available > 0)) {
@@ -287,8 +367,14 @@ void LogWriterFile::run()
 			}
 
 
-			if (_buffers[0].fd() < 0 && _buffers[1].fd() < 0) {
-				// stop when both files are closed
+			bool all_closed = true;
+
+			for (int j = first; j <= last; ++j) {
+				all_closed = all_closed && _buffers[j].fd() < 0;
+			}
+
+			if (all_closed) {
+				// stop when all files are closed
 				break;
 			}
 
@@ -298,7 +384,7 @@ void LogWriterFile::run()
 			 * not an issue because notify() is called regularly.
 			 * If the logger was switched off in the meantime, do not wait for data, instead run this loop
 			 * once more to write remaining data and close the file. */
-			if (_buffers[0]._should_run) {
+			if (_buffers[first]._should_run) {
 				pthread_cond_wait(&_cv, &_mtx);
 			}
 		}
@@ -316,10 +402,8 @@ int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t
 		// if there's a dropout, write it first (because we might split the message)
 		if (dropout_start) {
 			while ((ret = write(type, ptr, 0, dropout_start)) == -1) {
-				unlock();
-				notify();
+				wakeup();
 				px4_usleep(3000);
-				lock();
 			}
 		}
 
@@ -330,10 +414,8 @@ int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t
 			size_t write_size = math::min(size, _buffers[(int)type].buffer_size());
 
 			while ((ret = write(type, uptr, write_size, 0)) == -1) {
-				unlock();
-				notify();
+				wakeup();
 				px4_usleep(3000);
-				lock();
 			}
 
 			uptr += write_size;
@@ -346,6 +428,20 @@ int LogWriterFile::write_message(LogType type, void *ptr, size_t size, uint64_t
 	return write(type, ptr, size, dropout_start);
 }
 
+void LogWriterFile::notify()
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (_buffers[(int)LogType::Full].count() >= _min_write_chunk
+	    || _buffers[(int)LogType::Mission].count() > 0 // the mission log is written as soon as there is data
+	    || _buffers[(int)LogType::HighRate].count() >= _min_write_chunk
+	    || now - _last_wakeup > 500_ms) {
+
+		_last_wakeup = now;
+		wakeup();
+	}
+}
+
 int LogWriterFile::write(LogType type, void *ptr, size_t size, uint64_t dropout_start)
 {
 	if (!is_started(type)) {
@@ -383,6 +479,8 @@ const char *log_type_str(LogType type)
 
 	case LogType::Mission: return "mission";
 
+	case LogType::HighRate: return "high-rate";
+
 	case LogType::Count: break;
 	}
 
@@ -402,6 +500,7 @@ LogWriterFile::LogFileBuffer::~LogFileBuffer()
 	}
 
 	delete[] _buffer;
+	delete[] _block;
 
 	perf_free(_perf_write);
 	perf_free(_perf_fsync);
@@ -426,28 +525,52 @@ void LogWriterFile::LogFileBuffer::write_no_check(void *ptr, size_t size)
 	size_t p = size - n;	// number of bytes to write
 	memcpy(&(_buffer[_head]), &(buffer_c[n]), p);
 	_head = (_head + p) % _buffer_size;
-	_count += size;
+
+	// publish the data to the writer thread
+	_count.fetch_add(size);
 }
 
 size_t LogWriterFile::LogFileBuffer::get_read_ptr(void **ptr, bool *is_part)
 {
 	// bytes available to read
-	int read_ptr = _head - _count;
+	const size_t count = _count.load();
+	const size_t n = _buffer_size - _tail; // bytes to the end of the buffer
+
+	*ptr = &_buffer[_tail];
 
-	if (read_ptr < 0) {
-		read_ptr += _buffer_size;
-		*ptr = &_buffer[read_ptr];
+	if (count > n) {
 		*is_part = true;
-		return _buffer_size - read_ptr;
+		return n;
 
 	} else {
-		*ptr = &_buffer[read_ptr];
 		*is_part = false;
-		return _count;
+		return count;
+	}
+}
+
+size_t LogWriterFile::LogFileBuffer::get_aligned_read_ptr(void **ptr, size_t chunk_size)
+{
+	bool is_part;
+	void *read_ptr;
+	const size_t available = get_read_ptr(&read_ptr, &is_part);
+
+	if (available >= chunk_size) {
+		*ptr = read_ptr;
+		return available - (available % chunk_size);
+	}
+
+	if (is_part && count() >= chunk_size) {
+		// gather the end of the ring buffer and the beginning into one block
+		memcpy(_block, read_ptr, available);
+		memcpy(_block + available, _buffer, chunk_size - available);
+		*ptr = _block;
+		return chunk_size;
 	}
+
+	return 0;
 }
 
-bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
+bool LogWriterFile::LogFileBuffer::start_log(const char *filename, bool aligned, size_t preallocation_size)
 {
 	_fd = ::open(filename, O_CREAT | O_WRONLY, PX4_O_MODE_666);
 
@@ -467,10 +590,25 @@ bool LogWriterFile::LogFileBuffer::start_log(const char *filename)
 		}
 	}
 
+	_aligned = aligned;
+	_preallocation_size = preallocation_size;
+	_preallocation_done = false;
+	_preallocated = false;
+
+	if (_aligned && _block == nullptr) {
+		_block = new uint8_t[_min_write_chunk];
+
+		if (_block == nullptr) {
+			PX4_WARN("Can't create block buffer, aligned writes disabled");
+		}
+	}
+
 	// Clear buffer and counters
 	_head = 0;
-	_count = 0;
+	_tail = 0;
+	_count.store(0);
 	_total_written = 0;
+	_total_write_time_us = 0;
 
 	_should_run = true;
 
@@ -484,10 +622,12 @@ void LogWriterFile::LogFileBuffer::fsync() const
 	perf_end(_perf_fsync);
 }
 
-ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync) const
+ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t size, bool call_fsync)
 {
 	perf_begin(_perf_write);
+	const hrt_abstime write_start = hrt_absolute_time();
 	ssize_t ret = ::write(_fd, buffer, size);
+	_total_write_time_us += hrt_elapsed_time(&write_start);
 	perf_end(_perf_write);
 
 	if (call_fsync) {
@@ -497,12 +637,37 @@ ssize_t LogWriterFile::LogFileBuffer::write_to_file(const void *buffer, size_t s
 	return ret;
 }
 
-void LogWriterFile::LogFileBuffer::close_file()
+void LogWriterFile::LogFileBuffer::preallocate()
 {
-	_head = 0;
-	_count = 0;
+	_preallocation_done = true;
+
+	const hrt_abstime start = hrt_absolute_time();
 
+#if defined(__PX4_LINUX)
+	// ftruncate() creates a sparse file on most Linux file systems
+	int ret = posix_fallocate(_fd, 0, _preallocation_size);
+#else
+	// FAT allocates the clusters of the extended file (the file position is not changed)
+	int ret = ftruncate(_fd, _preallocation_size) == 0 ? 0 : errno;
+#endif
+
+	if (ret == 0) {
+		_preallocated = true;
+		PX4_INFO("preallocated %zu KiB in %.3f s", _preallocation_size / 1024, (double)(hrt_elapsed_time(&start) * 1e-6f));
+
+	} else {
+		PX4_WARN("log file preallocation failed (%i)", ret);
+	}
+}
+
+void LogWriterFile::LogFileBuffer::close_file()
+{
+	// the buffer state is reset in start_log(): after a write error the logger thread might still be writing
 	if (_fd >= 0) {
+		if (_preallocated && ftruncate(_fd, _total_written) != 0) {
+			PX4_WARN("truncating log file failed (%i)", errno);
+		}
+
 		int res = close(_fd);
 		_fd = -1;
 
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <stdint.h>
 #include <pthread.h>
@@ -51,6 +52,7 @@ namespace logger
 enum class LogType {
 	Full = 0, //!< Normal, full size log
 	Mission,  //!< reduced mission log (e.g. for geotagging)
+	HighRate, //!< separate log of the high-rate topics (e.g. on onboard flash), written by its own thread
 
 	Count
 };
@@ -60,6 +62,13 @@ const char *log_type_str(LogType type);
 /**
  * @class LogWriterFile
  * Writes logging data to a file
+ *
+ * The logger thread writes messages into a ring buffer per log type, which is drained by the
+ * writer thread. Each buffer is a single-producer/single-consumer ring: the data path does not
+ * take a lock, only start/stop and the writer thread's wakeups use the mutex.
+ *
+ * The high-rate log is drained by a second writer thread (started with its first log file), so that
+ * a slow device does not block the other one.
  */
 class LogWriterFile
 {
@@ -86,20 +95,11 @@ public:
 	/** @see LogWriter::write_message() */
 	int write_message(LogType type, void *ptr, size_t size, uint64_t dropout_start = 0);
 
-	void lock()
-	{
-		pthread_mutex_lock(&_mtx);
-	}
-
-	void unlock()
-	{
-		pthread_mutex_unlock(&_mtx);
-	}
-
-	void notify()
-	{
-		pthread_cond_broadcast(&_cv);
-	}
+	/**
+	 * Notify the writer thread about new data. Wakeups are batched: the thread is only woken up
+	 * if there is enough data for a write (or after a timeout, so that fsync is still called regularly).
+	 */
+	void notify();
 
 	size_t get_total_written(LogType type) const
 	{
@@ -116,6 +116,29 @@ public:
 		return _buffers[(int)type].count();
 	}
 
+	/**
+	 * Time spent in write() calls since the log was started
+	 */
+	uint64_t get_total_write_time_us(LogType type) const
+	{
+		return _buffers[(int)type].total_write_time_us();
+	}
+
+	/**
+	 * Enable writing the full log in whole multiples of _min_write_chunk only, so that every write
+	 * starts at an aligned file offset. Data that wraps around the end of the ring buffer is gathered
+	 * into a separate block, and a partial tail is held back until more data arrives or the log stops.
+	 * Takes effect for the next log file.
+	 */
+	void set_aligned_writes(bool aligned) { _aligned_writes = aligned; }
+
+	/**
+	 * Reserve size bytes for the full and high-rate log files when they are opened (0 to disable),
+	 * so that the file system does not need to allocate clusters while logging. The file is
+	 * truncated to the written size when it is closed. Takes effect for the next log file.
+	 */
+	void set_preallocation(size_t size) { _preallocation_size = size; }
+
 	void set_need_reliable_transfer(bool need_reliable)
 	{
 		_need_reliable_transfer = need_reliable;
@@ -130,8 +153,34 @@ public:
 
 private:
 	static void *run_helper(void *);
+	static void *run_high_rate_helper(void *);
 
-	void run();
+	void lock()
+	{
+		pthread_mutex_lock(&_mtx);
+	}
+
+	void unlock()
+	{
+		pthread_mutex_unlock(&_mtx);
+	}
+
+	/**
+	 * Wake up the writer thread unconditionally
+	 */
+	void wakeup()
+	{
+		lock();
+		pthread_cond_broadcast(&_cv);
+		unlock();
+	}
+
+	/**
+	 * writer thread main loop, handling the buffers of the log types [first_type, last_type]
+	 */
+	void run(LogType first_type, LogType last_type);
+
+	int thread_start(pthread_t *thread, void *(*helper)(void *), size_t stack_size);
 
 	/**
 	 * permanently store the ulog file name for the hardfault crash handler, so that it can
@@ -156,30 +205,55 @@ private:
 
 		~LogFileBuffer();
 
-		bool start_log(const char *filename);
+		bool start_log(const char *filename, bool aligned, size_t preallocation_size);
+
+		/**
+		 * Reserve the file space requested in start_log() (writer thread only, might block for a while)
+		 */
+		void preallocate();
+
+		bool needs_preallocation() const { return _preallocation_size > 0 && !_preallocation_done; }
 
 		void close_file();
 
 		size_t get_read_ptr(void **ptr, bool *is_part);
 
 		/**
-		 * Write to the buffer but assuming there is enough space
+		 * Get data to write in whole multiples of chunk_size. If the contiguous part up to the end of
+		 * the ring buffer is shorter than one chunk, a single chunk is assembled in the block buffer.
+		 * @return number of bytes at *ptr, 0 if less than one chunk is buffered
+		 */
+		size_t get_aligned_read_ptr(void **ptr, size_t chunk_size);
+
+		bool aligned() const { return _block != nullptr && _aligned; }
+
+		/**
+		 * Write to the buffer but assuming there is enough space (logger thread only)
 		 */
 		inline void write_no_check(void *ptr, size_t size);
 
-		size_t available() const { return _buffer_size - _count; }
+		size_t available() const { return _buffer_size - _count.load(); }
 
 		int fd() const { return _fd; }
 
-		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync) const;
+		inline ssize_t write_to_file(const void *buffer, size_t size, bool call_fsync);
 
 		inline void fsync() const;
 
-		void mark_read(size_t n) { _count -= n; _total_written += n; }
+		/**
+		 * Release n bytes after get_read_ptr() (writer thread only)
+		 */
+		void mark_read(size_t n)
+		{
+			_tail = (_tail + n) % _buffer_size;
+			_total_written += n;
+			_count.fetch_sub(n);
+		}
 
 		size_t total_written() const { return _total_written; }
 		size_t buffer_size() const { return _buffer_size; }
-		size_t count() const { return _count; }
+		size_t count() const { return _count.load(); }
+		uint64_t total_write_time_us() const { return _total_write_time_us; }
 
 		bool _should_run = false;
 
@@ -187,9 +261,16 @@ private:
 		const size_t _buffer_size;
 		int	_fd = -1;
 		uint8_t *_buffer = nullptr;
-		size_t _head = 0; ///< next position to write to
-		size_t _count = 0; ///< number of bytes in _buffer to be written
+		uint8_t *_block = nullptr; ///< block buffer for aligned writes of wrapped data
+		bool _aligned = false;
+		size_t _preallocation_size = 0;
+		bool _preallocation_done = false;
+		bool _preallocated = false; ///< file is larger than the written data and needs truncation
+		size_t _head = 0; ///< next position to write to (only used by the logger thread)
+		size_t _tail = 0; ///< next position to read from (only used by the writer thread)
+		px4::atomic<size_t> _count{0}; ///< number of bytes in _buffer to be written
 		size_t _total_written = 0;
+		uint64_t _total_write_time_us = 0;
 		perf_counter_t _perf_write;
 		perf_counter_t _perf_fsync;
 	};
@@ -198,9 +279,14 @@ private:
 
 	bool 		_exit_thread = false;
 	bool		_need_reliable_transfer = false;
+	bool		_aligned_writes = false;
+	size_t		_preallocation_size = 0;
 	pthread_mutex_t		_mtx;
 	pthread_cond_t		_cv;
 	pthread_t _thread = 0;
+	pthread_t _high_rate_thread = 0;
+	bool _high_rate_thread_started = false;
+	hrt_abstime _last_wakeup{0};
 };
 
 }
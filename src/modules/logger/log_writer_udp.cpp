@@ -0,0 +1,210 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "log_writer_udp.h"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace px4
+{
+namespace logger
+{
+
+LogWriterUdp::~LogWriterUdp()
+{
+	if (_fd >= 0) {
+		close(_fd);
+	}
+}
+
+bool LogWriterUdp::set_destination(const char *destination)
+{
+	char host[sizeof(_destination_str)];
+	strncpy(host, destination, sizeof(host) - 1);
+	host[sizeof(host) - 1] = '\0';
+
+	unsigned long port = DEFAULT_PORT;
+	char *port_str = strchr(host, ':');
+
+	if (port_str) {
+		*port_str++ = '\0';
+		char *end = nullptr;
+		port = strtoul(port_str, &end, 10);
+
+		if (end == port_str || *end != '\0' || port == 0 || port > UINT16_MAX) {
+			return false;
+		}
+	}
+
+	_destination.sin_family = AF_INET;
+	_destination.sin_port = htons((uint16_t)port);
+
+	if (inet_pton(AF_INET, host, &_destination.sin_addr) != 1) {
+		return false;
+	}
+
+	snprintf(_destination_str, sizeof(_destination_str), "%s:%lu", host, port);
+	return true;
+}
+
+bool LogWriterUdp::init()
+{
+	if (_destination.sin_family != AF_INET) {
+		PX4_ERR("no UDP destination");
+		return false;
+	}
+
+	_fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+	if (_fd < 0) {
+		PX4_ERR("socket failed (%i)", errno);
+		return false;
+	}
+
+	// the logger thread must never block on the network
+	int flags = fcntl(_fd, F_GETFL, 0);
+
+	if (flags < 0 || fcntl(_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		PX4_ERR("fcntl failed (%i)", errno);
+		close(_fd);
+		_fd = -1;
+		return false;
+	}
+
+	// a larger send buffer to absorb bursts (e.g. the parameters at the start)
+	int send_buffer_size = 256 * 1024;
+	setsockopt(_fd, SOL_SOCKET, SO_SNDBUF, &send_buffer_size, sizeof(send_buffer_size));
+
+	return true;
+}
+
+void LogWriterUdp::start_log()
+{
+	_buffer_fill = 0;
+	_total_sent = 0;
+	_dropped = 0;
+	_is_started = true;
+}
+
+void LogWriterUdp::stop_log()
+{
+	flush();
+	_is_started = false;
+}
+
+int LogWriterUdp::write_message(void *ptr, size_t size)
+{
+	if (!is_started()) {
+		return 0;
+	}
+
+	if (_buffer_fill + size > sizeof(_buffer)) {
+		send_buffer();
+	}
+
+	if (size > sizeof(_buffer)) {
+		// does not fit into a single datagram: drop it, as a fragment is of no use to the receiver
+		_dropped += size;
+		return 0;
+	}
+
+	memcpy(_buffer + _buffer_fill, ptr, size);
+	_buffer_fill += size;
+	return 0;
+}
+
+void LogWriterUdp::flush()
+{
+	if (_buffer_fill > 0) {
+		send_buffer();
+	}
+}
+
+void LogWriterUdp::set_need_reliable_transfer(bool need_reliable)
+{
+	if (!need_reliable && _need_reliable_transfer) {
+		// make sure to send previous data while waiting for socket space
+		flush();
+	}
+
+	_need_reliable_transfer = need_reliable;
+}
+
+void LogWriterUdp::send_buffer()
+{
+	if (_fd < 0) {
+		_dropped += _buffer_fill;
+		_buffer_fill = 0;
+		return;
+	}
+
+	int tries = _need_reliable_transfer ? 100 : 1;
+
+	while (tries-- > 0) {
+		ssize_t ret = sendto(_fd, _buffer, _buffer_fill, 0, (struct sockaddr *)&_destination, sizeof(_destination));
+
+		if (ret >= 0) {
+			_total_sent += _buffer_fill;
+			_buffer_fill = 0;
+			return;
+		}
+
+		if ((errno != EAGAIN && errno != EWOULDBLOCK) || tries == 0) {
+			break;
+		}
+
+		// the header has to be complete: block for a moment (only happens at the start of a log)
+		struct pollfd fds {};
+		fds.fd = _fd;
+		fds.events = POLLOUT;
+		poll(&fds, 1, 10);
+	}
+
+	_dropped += _buffer_fill;
+	_buffer_fill = 0;
+}
+
+}
+}
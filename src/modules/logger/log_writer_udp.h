@@ -0,0 +1,114 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <netinet/in.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class LogWriterUdp
+ * Streams the ULog data as raw byte stream via UDP to a single destination (POSIX only).
+ * Datagrams only contain complete ULog messages, so that a receiver can continue parsing
+ * after a lost datagram. Concatenating all datagrams results in the same data as a log file.
+ */
+class LogWriterUdp
+{
+public:
+	LogWriterUdp() = default;
+	~LogWriterUdp();
+
+	/**
+	 * set the destination, must be called before init()
+	 * @param destination "<ip>[:<port>]"
+	 * @return false if it cannot be parsed
+	 */
+	bool set_destination(const char *destination);
+
+	bool init();
+
+	void start_log();
+
+	void stop_log();
+
+	bool is_started() const { return _is_started; }
+
+	/**
+	 * @see LogWriter::write_message()
+	 * This is best-effort: data that cannot be sent is counted in dropped() and 0 is returned.
+	 */
+	int write_message(void *ptr, size_t size);
+
+	/** send buffered data */
+	void flush();
+
+	void set_need_reliable_transfer(bool need_reliable);
+
+	bool need_reliable_transfer() const { return _need_reliable_transfer; }
+
+	const char *destination() const { return _destination_str; }
+
+	size_t total_sent() const { return _total_sent; }
+	size_t dropped() const { return _dropped; }
+
+	static constexpr uint16_t DEFAULT_PORT = 14560;
+
+	/** maximum datagram payload that avoids IP fragmentation on ethernet */
+	static constexpr size_t MAX_DATAGRAM_SIZE = 1472;
+
+private:
+	/** send the buffer, wait for socket space if a reliable transfer is needed */
+	void send_buffer();
+
+	int _fd{-1};
+	sockaddr_in _destination{};
+	char _destination_str[32] {};
+
+	uint8_t _buffer[MAX_DATAGRAM_SIZE];
+	size_t _buffer_fill{0};
+
+	size_t _total_sent{0};
+	size_t _dropped{0}; ///< bytes that could not be sent
+	bool _need_reliable_transfer{false};
+	bool _is_started{false};
+};
+
+}
+}
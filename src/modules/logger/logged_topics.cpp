@@ -52,34 +52,40 @@ void LoggedTopics::add_default_topics()
 	add_topic("camera_trigger");
 	add_topic("camera_trigger_secondary");
 	add_topic("cellular_status", 200);
+	add_topic("control_allocator_status", 200);
 	add_topic("cpuload");
 	add_topic("ekf_gps_drift");
-	add_topic("esc_status", 250);
-	add_topic("estimator_innovation_test_ratios", 200);
-	add_topic("estimator_innovation_variances", 200);
-	add_topic("estimator_innovations", 200);
+	add_low_priority_topic("esc_status", 250);
+	add_low_priority_topic("estimator_innovation_test_ratios", 200);
+	add_low_priority_topic("estimator_innovation_variances", 200);
+	add_low_priority_topic("estimator_innovations", 200);
 	add_topic("estimator_sensor_bias", 1000);
-	add_topic("estimator_status", 200);
 	add_topic("home_position");
 	add_topic("hover_thrust_estimate", 100);
 	add_topic("input_rc", 200);
+	add_topic("irq_stats");
 	add_topic("manual_control_setpoint", 200);
 	add_topic("mission");
 	add_topic("mission_result");
 	add_topic("offboard_control_mode", 1000);
+	add_topic("perf_counters");
+	add_topic("profiler_samples");
 	add_topic("position_controller_status", 500);
 	add_topic("position_setpoint_triplet", 200);
 	add_topic("radio_status");
-	add_topic("rate_ctrl_status", 200);
+	add_low_priority_topic("rate_ctrl_status", 200);
 	add_topic("rpm", 500);
 	add_topic("safety", 1000);
 	add_topic("sensor_combined", 100);
 	add_topic("sensor_correction", 1000);
+	add_topic("sensor_gyro_fft", 50);
 	add_topic("sensor_preflight", 200);
 	add_topic("sensor_selection");
 	add_topic("system_power", 500);
 	add_topic("tecs_status", 200);
+	add_topic("thread_load");
 	add_topic("trajectory_setpoint", 200);
+	add_topic("vehicle_actuator_setpoint", 20);
 	add_topic("vehicle_air_data", 200);
 	add_topic("vehicle_angular_velocity", 20);
 	add_topic("vehicle_attitude", 50);
@@ -94,11 +100,17 @@ void LoggedTopics::add_default_topics()
 	add_topic("vehicle_roi", 1000);
 	add_topic("vehicle_status", 200);
 	add_topic("vehicle_status_flags");
+	add_topic("vehicle_thrust_setpoint", 20);
+	add_topic("vehicle_torque_setpoint", 20);
 	add_topic("vtol_vehicle_status", 200);
-	add_topic("yaw_estimator_status", 200);
+	add_topic("work_queue_info");
+	add_low_priority_topic("yaw_estimator_status", 200);
 
 	// multi topics
 	add_topic_multi("actuator_outputs", 100);
+	add_topic_multi("estimator_attitude", 500);
+	add_topic_multi("estimator_local_position", 500);
+	add_topic_multi("estimator_status", 200);
 	add_topic_multi("logger_status");
 	add_topic_multi("multirotor_motor_limits", 1000);
 	add_topic_multi("telemetry_status", 1000);
@@ -109,13 +121,14 @@ void LoggedTopics::add_default_topics()
 	add_topic_multi("differential_pressure", 1000);
 	add_topic_multi("distance_sensor", 1000);
 	add_topic_multi("optical_flow", 1000);
-	add_topic_multi("sensor_accel", 1000);
-	add_topic_multi("sensor_accel_status", 1000);
-	add_topic_multi("sensor_baro", 1000);
-	add_topic_multi("sensor_gyro", 1000);
-	add_topic_multi("sensor_gyro_status", 1000);
-	add_topic_multi("sensor_mag", 1000);
-	add_topic_multi("vehicle_gps_position", 1000);
+	add_low_priority_topic_multi("sensor_accel", 1000);
+	add_low_priority_topic_multi("sensor_accel_status", 1000);
+	add_low_priority_topic_multi("sensor_baro", 1000);
+	add_topic_multi("sensor_gps", 1000);
+	add_low_priority_topic_multi("sensor_gyro", 1000);
+	add_low_priority_topic_multi("sensor_gyro_status", 1000);
+	add_low_priority_topic_multi("sensor_mag", 1000);
+	add_topic("vehicle_gps_position", 1000);
 
 #ifdef CONFIG_ARCH_BOARD_PX4_SITL
 	add_topic("actuator_controls_virtual_fw");
@@ -139,7 +152,7 @@ void LoggedTopics::add_high_rate_topics()
 	add_topic("manual_control_setpoint");
 	add_topic("rate_ctrl_status", 20);
 	add_topic("sensor_combined");
-	add_topic("vehicle_angular_acceleration");
+	add_low_priority_topic("vehicle_angular_acceleration");
 	add_topic("vehicle_angular_velocity");
 	add_topic("vehicle_attitude");
 	add_topic("vehicle_attitude_setpoint");
@@ -158,7 +171,6 @@ void LoggedTopics::add_estimator_replay_topics()
 {
 	// for estimator replay (need to be at full rate)
 	add_topic("ekf2_timestamps");
-	add_topic("ekf_gps_position");
 
 	// current EKF2 subscriptions
 	add_topic("airspeed");
@@ -166,13 +178,13 @@ void LoggedTopics::add_estimator_replay_topics()
 	add_topic("sensor_combined");
 	add_topic("sensor_selection");
 	add_topic("vehicle_air_data");
+	add_topic("vehicle_gps_position");
 	add_topic("vehicle_land_detected");
 	add_topic("vehicle_magnetometer");
 	add_topic("vehicle_status");
 	add_topic("vehicle_visual_odometry");
 	add_topic("vehicle_visual_odometry_aligned");
 	add_topic_multi("distance_sensor");
-	add_topic_multi("vehicle_gps_position");
 }
 
 void LoggedTopics::add_thermal_calibration_topics()
@@ -283,6 +295,68 @@ void LoggedTopics::add_mission_topic(const char *name, uint16_t interval_ms)
 	}
 }
 
+void LoggedTopics::initialize_trigger_topics()
+{
+	// raw high-rate IMU data around anomalies
+	add_trigger_topic_multi("sensor_accel_fifo");
+	add_trigger_topic_multi("sensor_gyro_fifo");
+	add_trigger_topic_multi("sensor_accel");
+	add_trigger_topic_multi("sensor_gyro");
+}
+
+void LoggedTopics::add_trigger_topic_multi(const char *name)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		if (strcmp(name, topics[i]->o_name) == 0) {
+			for (uint8_t instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+				bool already_added = false;
+
+				for (int j = 0; j < _subscriptions.count; ++j) {
+					if (_subscriptions.sub[j].id == static_cast<ORB_ID>(topics[i]->o_id) &&
+					    _subscriptions.sub[j].instance == instance) {
+						already_added = true;
+						break;
+					}
+				}
+
+				if (!already_added && add_topic(topics[i], 0, instance)) {
+					++_num_trigger_subs;
+				}
+			}
+
+			break;
+		}
+	}
+}
+
+void LoggedTopics::initialize_high_rate_topics()
+{
+	add_high_rate_topic_multi("sensor_accel_fifo");
+	add_high_rate_topic_multi("sensor_gyro_fifo");
+	add_high_rate_topic_multi("sensor_accel");
+	add_high_rate_topic_multi("sensor_gyro");
+	add_high_rate_topic_multi("vehicle_angular_velocity");
+}
+
+void LoggedTopics::add_high_rate_topic_multi(const char *name)
+{
+	const orb_metadata *const *topics = orb_get_topics();
+
+	for (size_t i = 0; i < orb_topics_count(); i++) {
+		if (strcmp(name, topics[i]->o_name) == 0) {
+			for (uint8_t instance = 0; instance < ORB_MULTI_MAX_INSTANCES; instance++) {
+				if (add_topic(topics[i], 0, instance)) {
+					++_num_high_rate_subs;
+				}
+			}
+
+			break;
+		}
+	}
+}
+
 bool LoggedTopics::add_topic(const orb_metadata *topic, uint16_t interval_ms, uint8_t instance)
 {
 	size_t fields_len = strlen(topic->o_fields) + strlen(topic->o_name) + 1; //1 for ':'
@@ -299,6 +373,7 @@ bool LoggedTopics::add_topic(const orb_metadata *topic, uint16_t interval_ms, ui
 		return false;
 	}
 
+	_subscriptions.low_priority.set(_subscriptions.count, _add_low_priority);
 	RequestedSubscription &sub = _subscriptions.sub[_subscriptions.count++];
 	sub.interval_ms = interval_ms;
 	sub.instance = instance;
@@ -324,6 +399,7 @@ bool LoggedTopics::add_topic(const char *name, uint16_t interval_ms, uint8_t ins
 						  topics[i]->o_name, instance, interval_ms);
 
 					_subscriptions.sub[j].interval_ms = interval_ms;
+					_subscriptions.low_priority.set(j, _add_low_priority);
 					success = true;
 					already_added = true;
 					break;
@@ -351,6 +427,21 @@ bool LoggedTopics::add_topic_multi(const char *name, uint16_t interval_ms)
 	return true;
 }
 
+bool LoggedTopics::add_low_priority_topic(const char *name, uint16_t interval_ms)
+{
+	_add_low_priority = true;
+	bool ret = add_topic(name, interval_ms);
+	_add_low_priority = false;
+	return ret;
+}
+
+bool LoggedTopics::add_low_priority_topic_multi(const char *name, uint16_t interval_ms)
+{
+	_add_low_priority = true;
+	bool ret = add_topic_multi(name, interval_ms);
+	_add_low_priority = false;
+	return ret;
+}
 
 bool LoggedTopics::initialize_logged_topics(SDLogProfileMask profile)
 {
@@ -35,6 +35,7 @@
 
 #include <stdint.h>
 
+#include <containers/Bitset.hpp>
 #include <uORB/uORB.h>
 #include <uORB/topics/uORBTopics.hpp>
 
@@ -81,6 +82,7 @@ public:
 	};
 	struct RequestedSubscriptionArray {
 		RequestedSubscription sub[MAX_TOPICS_NUM];
+		px4::Bitset<MAX_TOPICS_NUM> low_priority; ///< rate might be reduced when the write buffer fills up
 		int count{0};
 	};
 
@@ -95,8 +97,23 @@ public:
 
 	bool initialize_logged_topics(SDLogProfileMask profile);
 
+	/**
+	 * Add the high-rate topics that are only logged around trigger events (see SDLOG_TRIG_PRE).
+	 * Topics that are already part of the configured set are skipped.
+	 * Must be called after initialize_logged_topics(), the topics are added at the end.
+	 */
+	void initialize_trigger_topics();
+
+	/**
+	 * Add the topics of the separate high-rate log (LogType::HighRate). They are independent of the
+	 * other logged topics (a topic can be in both). Must be called last, the topics are added at the end.
+	 */
+	void initialize_high_rate_topics();
+
 	const RequestedSubscriptionArray &subscriptions() const { return _subscriptions; }
 	int numMissionSubscriptions() const { return _num_mission_subs; }
+	int numTriggerSubscriptions() const { return _num_trigger_subs; }
+	int numHighRateSubscriptions() const { return _num_high_rate_subs; }
 
 private:
 
@@ -110,6 +127,14 @@ private:
 	bool add_topic(const char *name, uint16_t interval_ms = 0, uint8_t instance = 0);
 	bool add_topic_multi(const char *name, uint16_t interval_ms = 0);
 
+	/**
+	 * Add a low-priority topic: its logging rate is reduced when the logger cannot keep up
+	 * writing, before any data is dropped. As for the interval, the last profile adding a topic
+	 * determines its priority.
+	 */
+	bool add_low_priority_topic(const char *name, uint16_t interval_ms = 0);
+	bool add_low_priority_topic_multi(const char *name, uint16_t interval_ms = 0);
+
 	/**
 	 * Parse a file containing a list of uORB topics to log, calling add_topic for each
 	 * @param fname name of file
@@ -126,6 +151,19 @@ private:
 	 */
 	void add_mission_topic(const char *name, uint16_t interval_ms = 0);
 
+	/**
+	 * Add all instances of a topic that is only logged around trigger events (at full rate).
+	 * Instances that are already logged are skipped.
+	 * @param name topic name
+	 */
+	void add_trigger_topic_multi(const char *name);
+
+	/**
+	 * Add all instances of a topic to the high-rate log (at full rate).
+	 * @param name topic name
+	 */
+	void add_high_rate_topic_multi(const char *name);
+
 	/**
 	 * Add topic subscriptions based on the profile configuration
 	 */
@@ -147,6 +185,9 @@ private:
 
 	RequestedSubscriptionArray _subscriptions;
 	int _num_mission_subs{0};
+	int _num_trigger_subs{0};
+	int _num_high_rate_subs{0};
+	bool _add_low_priority{false}; ///< priority of topics that are currently added
 };
 
 } //namespace logger
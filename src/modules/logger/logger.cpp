@@ -36,6 +36,7 @@
 #include "logged_topics.h"
 #include "logger.h"
 #include "messages.h"
+#include "ulog_delta.h"
 #include "watchdog.h"
 
 #include <dirent.h>
@@ -153,6 +154,11 @@ int Logger::custom_command(int argc, char *argv[])
 		return 0;
 	}
 
+	if (!strcmp(argv[0], "trigger")) {
+		get_instance()->request_trigger();
+		return 0;
+	}
+
 	return print_usage("unknown command");
 }
 
@@ -193,15 +199,38 @@ int Logger::print_status()
 		is_logging = true;
 	}
 
+	if (_writer.is_started(LogType::HighRate, LogWriter::BackendFile)) {
+		PX4_INFO("High-rate File Logging Running:");
+		print_statistics(LogType::HighRate);
+		is_logging = true;
+	}
+
 	if (_writer.is_started(LogType::Full, LogWriter::BackendMavlink)) {
 		PX4_INFO("Mavlink Logging Running (Full log)");
 		is_logging = true;
 	}
 
+#if defined(__PX4_POSIX)
+
+	if (_writer.is_started(LogType::Full, LogWriter::BackendUdp)) {
+		const LogWriterUdp *udp = _writer.log_writer_udp();
+		PX4_INFO("UDP Log Stream Running (Full log) to %s:", udp->destination());
+		PX4_INFO("\tSent: %.2f MiB, dropped: %.2f KiB", (double)udp->total_sent() / 1024. / 1024.,
+			 (double)udp->dropped() / 1024.);
+		is_logging = true;
+	}
+
+#endif
+
 	if (!is_logging) {
 		PX4_INFO("Not logging");
 	}
 
+	if (_trigger_buffer.valid()) {
+		PX4_INFO("Pre-trigger buffer: %zu / %zu B, dropped msgs: %zu, window %s", _trigger_buffer.count(),
+			 _trigger_buffer.size(), _trigger_buffer.dropped(), _trigger_window_end != 0 ? "active" : "inactive");
+	}
+
 	return 0;
 }
 
@@ -218,7 +247,7 @@ void Logger::print_statistics(LogType type)
 	float mebibytes = kibibytes / 1024.0f;
 	float seconds = ((float)(hrt_absolute_time() - stats.start_time_file)) / 1000000.0f;
 
-	PX4_INFO("Log file: %s/%s/%s", LOG_ROOT[(int)type], _file_name[(int)type].log_dir, _file_name[(int)type].log_file_name);
+	PX4_INFO("Log file: %s/%s/%s", log_root(type), _file_name[(int)type].log_dir, _file_name[(int)type].log_file_name);
 
 	if (mebibytes < 0.1f) {
 		PX4_INFO("Wrote %4.2f KiB (avg %5.2f KiB/s)", (double)kibibytes, (double)(kibibytes / seconds));
@@ -227,6 +256,13 @@ void Logger::print_statistics(LogType type)
 		PX4_INFO("Wrote %4.2f MiB (avg %5.2f KiB/s)", (double)mebibytes, (double)(kibibytes / seconds));
 	}
 
+	const uint64_t write_time_us = _writer.get_total_write_time_us_file(type);
+
+	if (write_time_us > 0) {
+		PX4_INFO("SD write throughput: %.2f MB/s",
+			 (double)(_writer.get_total_written_file(type) / (write_time_us * 1e-6) / (1024. * 1024.)));
+	}
+
 	PX4_INFO("Since last status: dropouts: %zu (max len: %.3f s), max used buffer: %zu / %zu B",
 		 stats.write_dropouts, (double)stats.max_dropout_duration, stats.high_water, _writer.get_buffer_size_file(type));
 	stats.high_water = 0;
@@ -243,12 +279,14 @@ Logger *Logger::instantiate(int argc, char *argv[])
 	bool log_name_timestamp = false;
 	LogWriter::Backend backend = LogWriter::BackendAll;
 	const char *poll_topic = nullptr;
+	const char *high_rate_log_root = nullptr;
+	const char *udp_destination = nullptr;
 
 	int myoptind = 1;
 	int ch;
 	const char *myoptarg = nullptr;
 
-	while ((ch = px4_getopt(argc, argv, "r:b:etfm:p:x", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "r:b:etfm:p:s:u:x", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'r': {
 				unsigned long r = strtoul(myoptarg, nullptr, 10);
@@ -315,6 +353,19 @@ Logger *Logger::instantiate(int argc, char *argv[])
 			poll_topic = myoptarg;
 			break;
 
+		case 's':
+			high_rate_log_root = myoptarg;
+			break;
+
+		case 'u':
+#if defined(__PX4_POSIX)
+			udp_destination = myoptarg;
+#else
+			PX4_ERR("UDP streaming not supported");
+			error_flag = true;
+#endif
+			break;
+
 		case '?':
 			error_flag = true;
 			break;
@@ -330,6 +381,10 @@ Logger *Logger::instantiate(int argc, char *argv[])
 		return nullptr;
 	}
 
+	if (udp_destination) {
+		backend |= LogWriter::BackendUdp;
+	}
+
 	Logger *logger = new Logger(backend, log_buffer_size, log_interval, poll_topic, log_mode, log_name_timestamp);
 
 #if defined(DBGPRINT) && defined(__PX4_NUTTX)
@@ -352,6 +407,16 @@ Logger *Logger::instantiate(int argc, char *argv[])
 
 #endif /* __PX4_NUTTX */
 
+		if (high_rate_log_root) {
+			logger->setHighRateLogRoot(high_rate_log_root);
+		}
+
+		if (udp_destination && !logger->setUdpDestination(udp_destination)) {
+			PX4_ERR("invalid UDP destination: %s", udp_destination);
+			delete logger;
+			return nullptr;
+		}
+
 	}
 
 	return logger;
@@ -387,8 +452,15 @@ Logger::~Logger()
 		free(_replay_file_name);
 	}
 
+	if (_high_rate_log_root) {
+		free(_high_rate_log_root);
+	}
+
 	delete[](_msg_buffer);
-	delete[](_subscriptions);
+	delete[](_delta_msg_buffer);
+	delete[](_delta_refs);
+	delete[](_subscriptions); // unregisters the callbacks before the dirty flags are freed
+	delete[](_dirty_topics);
 }
 
 void Logger::update_params()
@@ -425,7 +497,7 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 
 	} else if (try_to_subscribe) {
 		if (sub.subscribe()) {
-			write_add_logged_msg(LogType::Full, sub);
+			write_add_logged_msg(sub_idx >= first_subscription(LogType::HighRate) ? LogType::HighRate : LogType::Full, sub);
 
 			if (sub_idx < _num_mission_subs) {
 				write_add_logged_msg(LogType::Mission, sub);
@@ -439,9 +511,66 @@ bool Logger::copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe)
 	return updated;
 }
 
+void Logger::write_topic_data(int sub_idx, bool try_to_subscribe, hrt_abstime loop_time, uint32_t &total_bytes)
+{
+	LoggerSubscription &sub = _subscriptions[sub_idx];
+
+	/* if this topic has been updated, copy the new data into the message buffer
+	 * and write a message to the log
+	 */
+	if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_header_s), try_to_subscribe)) {
+		// each message consists of a header followed by an orb data object
+		const size_t msg_size = sizeof(ulog_message_data_header_s) + sub.get_topic()->o_size_no_padding;
+		const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
+		const uint16_t write_msg_id = sub.msg_id;
+
+		//write one byte after another (necessary because of alignment)
+		_msg_buffer[0] = (uint8_t)write_msg_size;
+		_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+		_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
+		_msg_buffer[3] = (uint8_t)write_msg_id;
+		_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+
+		// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
+
+		// full log (trigger topics only go to the pre-trigger buffer)
+		if (sub.triggered) {
+			_trigger_buffer.push(_msg_buffer, msg_size);
+
+		} else if (sub_idx >= first_subscription(LogType::HighRate)) {
+			write_message(LogType::HighRate, _msg_buffer, msg_size);
+
+		} else if (write_data_message_full(sub, msg_size)) {
+
+#ifdef DBGPRINT
+			total_bytes += msg_size;
+#endif /* DBGPRINT */
+		}
+
+		// mission log
+		if (sub_idx < _num_mission_subs) {
+			if (_writer.is_started(LogType::Mission)) {
+				if (_mission_subscriptions[sub_idx].next_write_time < (loop_time / 100000)) {
+					unsigned delta_time = _mission_subscriptions[sub_idx].min_delta_ms;
+
+					if (delta_time > 0) {
+						_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
+					}
+
+					write_message(LogType::Mission, _msg_buffer, msg_size);
+				}
+			}
+		}
+
+	} else if (_dirty_topics && sub.valid() && sub.pending()) {
+		// not written yet because of the interval: visit again in the next iteration
+		sub.call();
+	}
+}
+
 const char *Logger::configured_backend_mode() const
 {
-	switch (_writer.backend()) {
+	switch (_writer.backend() & ~LogWriter::BackendUdp) {
 	case LogWriter::BackendFile: return "file";
 
 	case LogWriter::BackendMavlink: return "mavlink";
@@ -490,6 +619,22 @@ bool Logger::initialize_topics()
 		return false;
 	}
 
+	if (_param_sdlog_trig_pre.get() > 0.f && (_writer.backend() & LogWriter::BackendFile)) {
+		logged_topics.initialize_trigger_topics();
+
+		if (logged_topics.numTriggerSubscriptions() > 0 && !_trigger_buffer.allocate(_param_sdlog_trig_buf.get() * 1024)) {
+			PX4_ERR("failed to alloc pre-trigger buffer");
+		}
+	}
+
+	if (_high_rate_log_root) {
+		logged_topics.initialize_high_rate_topics();
+	}
+
+	_num_high_rate_subs = logged_topics.numHighRateSubscriptions();
+	const int first_high_rate_sub = logged_topics.subscriptions().count - _num_high_rate_subs;
+	const int first_trigger_sub = first_high_rate_sub - logged_topics.numTriggerSubscriptions();
+
 	delete[](_subscriptions);
 	_subscriptions = nullptr;
 
@@ -506,11 +651,30 @@ bool Logger::initialize_topics()
 			// if we poll on a topic, we don't use the interval and let the polled topic define the maximum interval
 			uint16_t interval_ms = _polling_topic_meta ? 0 : sub.interval_ms;
 			_subscriptions[i] = LoggerSubscription(sub.id, interval_ms, sub.instance);
+			_subscriptions[i].triggered = i >= first_trigger_sub && i < first_high_rate_sub;
+			_subscriptions[i].low_priority = logged_topics.subscriptions().low_priority[i];
 			_subscriptions[i].subscribe();
 		}
 	}
 
 	_num_subscriptions = logged_topics.subscriptions().count;
+
+	delete[](_dirty_topics);
+	_dirty_topics = nullptr;
+
+	if (_param_sdlog_upd_cb.get() && _num_subscriptions > 0) {
+		_dirty_topics = new px4::atomic<uint32_t>[dirty_topics_words()];
+
+		if (!_dirty_topics) {
+			PX4_ERR("alloc failed");
+			return false;
+		}
+
+		for (int i = 0; i < _num_subscriptions; ++i) {
+			_subscriptions[i].set_dirty_flag(&_dirty_topics[i / 32], i % 32);
+		}
+	}
+
 	return true;
 }
 
@@ -536,10 +700,24 @@ void Logger::run()
 					   _file_name[(int)LogType::Full].sess_dir_index) == 1) {
 			return;
 		}
+
+		if (_high_rate_log_root) {
+			int ret = mkdir(_high_rate_log_root, S_IRWXU | S_IRWXG | S_IRWXO);
+
+			if ((ret != 0 && errno != EEXIST)
+			    || util::check_free_space(_high_rate_log_root, _param_sdlog_dirs_max.get(), _mavlink_log_pub,
+						      _file_name[(int)LogType::HighRate].sess_dir_index) == 1) {
+				PX4_ERR("disabling high-rate log (%s)", _high_rate_log_root);
+				free(_high_rate_log_root);
+				_high_rate_log_root = nullptr;
+			}
+		}
 	}
 
 	uORB::Subscription parameter_update_sub(ORB_ID(parameter_update));
 
+	_vehicle_command_sub.registerCallback();
+
 	if (!initialize_topics()) {
 		return;
 	}
@@ -645,6 +823,8 @@ void Logger::run()
 		/* check for logging command from MAVLink (start/stop streaming) */
 		handle_vehicle_command_update();
 
+		check_trigger_events();
+
 		if (timer_callback_data.watchdog_triggered) {
 			timer_callback_data.watchdog_triggered = false;
 			initialize_load_output(PrintLoadReason::Watchdog);
@@ -653,7 +833,11 @@ void Logger::run()
 
 		const hrt_abstime loop_time = hrt_absolute_time();
 
-		if (_writer.is_started(LogType::Full)) { // mission log only runs when full log is also started
+		if (_file_log_start_state != FileLogStartState::Done) {
+			// topic data can only follow once all the definitions of the full log are written
+			write_file_log_start();
+
+		} else if (_writer.is_started(LogType::Full)) { // mission log only runs when full log is also started
 
 			/* check if we need to output the process load */
 			if (_next_load_print != 0 && loop_time >= _next_load_print) {
@@ -674,60 +858,50 @@ void Logger::run()
 					parameter_update_s pupdate;
 					parameter_update_sub.copy(&pupdate);
 
-					write_changed_parameters(LogType::Full);
-				}
-			}
-
-			/* wait for lock on log buffer */
-			_writer.lock();
-
-			for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
-				LoggerSubscription &sub = _subscriptions[sub_idx];
-				/* if this topic has been updated, copy the new data into the message buffer
-				 * and write a message to the log
-				 */
-				const bool try_to_subscribe = (sub_idx == next_subscribe_topic_index);
+					if (_changed_params_index < 0) {
+						_changed_params_index = 0;
 
-				if (copy_if_updated(sub_idx, _msg_buffer + sizeof(ulog_message_data_header_s), try_to_subscribe)) {
-					// each message consists of a header followed by an orb data object
-					const size_t msg_size = sizeof(ulog_message_data_header_s) + sub.get_topic()->o_size_no_padding;
-					const uint16_t write_msg_size = static_cast<uint16_t>(msg_size - ULOG_MSG_HEADER_LEN);
-					const uint16_t write_msg_id = sub.msg_id;
+					} else {
+						// already checking, start over afterwards to catch changes of already checked parameters
+						_changed_params_rescan = true;
+					}
+				}
 
-					//write one byte after another (necessary because of alignment)
-					_msg_buffer[0] = (uint8_t)write_msg_size;
-					_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
-					_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA);
-					_msg_buffer[3] = (uint8_t)write_msg_id;
-					_msg_buffer[4] = (uint8_t)(write_msg_id >> 8);
+				// check a limited number of parameters per iteration
+				if (_changed_params_index >= 0) {
+					_changed_params_index = write_parameters(LogType::Full, _changed_params_index, 64, true);
 
-					// PX4_INFO("topic: %s, size = %zu, out_size = %zu", sub.get_topic()->o_name, sub.get_topic()->o_size, msg_size);
+					if (_changed_params_index < 0 && _changed_params_rescan) {
+						_changed_params_rescan = false;
+						_changed_params_index = 0;
+					}
+				}
+			}
 
-					// full log
-					if (write_message(LogType::Full, _msg_buffer, msg_size)) {
+			if (_dirty_topics) {
+				// only visit the topics that were published since the last iteration
+				for (int word = 0; word < dirty_topics_words(); ++word) {
+					uint32_t dirty = _dirty_topics[word].fetch_and(0);
 
-#ifdef DBGPRINT
-						total_bytes += msg_size;
-#endif /* DBGPRINT */
+					while (dirty != 0) {
+						const int sub_idx = word * 32 + __builtin_ctz(dirty);
+						dirty &= dirty - 1;
+						write_topic_data(sub_idx, false, loop_time, total_bytes);
 					}
+				}
 
-					// mission log
-					if (sub_idx < _num_mission_subs) {
-						if (_writer.is_started(LogType::Mission)) {
-							if (_mission_subscriptions[sub_idx].next_write_time < (loop_time / 100000)) {
-								unsigned delta_time = _mission_subscriptions[sub_idx].min_delta_ms;
-
-								if (delta_time > 0) {
-									_mission_subscriptions[sub_idx].next_write_time = (loop_time / 100000) + delta_time / 100;
-								}
+				if (next_subscribe_topic_index != -1 && !_subscriptions[next_subscribe_topic_index].valid()) {
+					write_topic_data(next_subscribe_topic_index, true, loop_time, total_bytes);
+				}
 
-								write_message(LogType::Mission, _msg_buffer, msg_size);
-							}
-						}
-					}
+			} else {
+				for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
+					write_topic_data(sub_idx, sub_idx == next_subscribe_topic_index, loop_time, total_bytes);
 				}
 			}
 
+			write_trigger_buffer(loop_time);
+
 			// check for new logging message(s)
 			log_message_s log_message;
 
@@ -767,6 +941,11 @@ void Logger::run()
 				_msg_buffer[10] = 0x12;
 
 				write_message(LogType::Full, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+
+				if (_writer.is_started(LogType::HighRate)) {
+					write_message(LogType::HighRate, _msg_buffer, write_msg_size + ULOG_MSG_HEADER_LEN);
+				}
+
 				_last_sync_time = loop_time;
 			}
 
@@ -777,6 +956,10 @@ void Logger::run()
 				}
 			}
 
+			if (_param_sdlog_throttle.get()) {
+				update_backpressure(loop_time);
+			}
+
 
 #ifndef ORB_USE_PUBLISHER_RULES
 
@@ -814,9 +997,6 @@ void Logger::run()
 
 #endif // !ORB_USE_PUBLISHER_RULES
 
-			/* release the log buffer */
-			_writer.unlock();
-
 			/* notify the writer thread */
 			_writer.notify();
 
@@ -1009,7 +1189,7 @@ void Logger::handle_vehicle_command_update()
 {
 	vehicle_command_s command;
 
-	if (_vehicle_command_sub.update(&command)) {
+	while (_vehicle_command_sub.pop(command)) {
 
 		if (command.command == vehicle_command_s::VEHICLE_CMD_LOGGING_START) {
 
@@ -1027,10 +1207,230 @@ void Logger::handle_vehicle_command_update()
 		} else if (command.command == vehicle_command_s::VEHICLE_CMD_LOGGING_STOP) {
 			stop_log_mavlink();
 			ack_vehicle_command(&command, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+
+		} else if (command.command == vehicle_command_s::VEHICLE_CMD_LOGGING_TRIGGER) {
+			if (_trigger_buffer.valid()) {
+				trigger_window("command");
+				ack_vehicle_command(&command, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+
+			} else {
+				ack_vehicle_command(&command, vehicle_command_s::VEHICLE_CMD_RESULT_DENIED);
+			}
 		}
 	}
 }
 
+void Logger::update_backpressure(hrt_abstime now)
+{
+	const size_t buffer_size = _writer.get_buffer_size_file(LogType::Full);
+	const size_t fill = _writer.get_buffer_fill_count_file(LogType::Full);
+	bool active = _backpressure_active;
+
+	if (buffer_size == 0 || !_writer.is_started(LogType::Full, LogWriter::BackendFile)) {
+		// do not carry the reduced rates over to the next log
+		active = false;
+
+	} else if (!active && fill > buffer_size / 2) {
+		active = true;
+
+	} else if (active && fill < buffer_size / 4 && now - _backpressure_change_time > 1_s) {
+		// hold the reduced rate for a while to avoid toggling with periodic write stalls
+		active = false;
+	}
+
+	if (active == _backpressure_active) {
+		return;
+	}
+
+	for (int sub_idx = 0; sub_idx < _num_subscriptions; ++sub_idx) {
+		if (_subscriptions[sub_idx].low_priority) {
+			_subscriptions[sub_idx].set_throttled(active);
+		}
+	}
+
+	_backpressure_active = active;
+	_backpressure_change_time = now;
+
+	if (active) {
+		PX4_WARN("log buffer %i%% full, reducing low-priority topic rates", (int)(fill * 100 / buffer_size));
+
+	} else {
+		PX4_INFO("restoring low-priority topic rates");
+	}
+}
+
+void Logger::check_trigger_events()
+{
+	if (!_trigger_buffer.valid()) {
+		return;
+	}
+
+	if (_trigger_requested.load()) {
+		_trigger_requested.store(false);
+		trigger_window("request");
+	}
+
+	vehicle_status_s vehicle_status;
+
+	if (_trigger_vehicle_status_sub.update(&vehicle_status)) {
+		// trigger on newly set failure flags only
+		if (vehicle_status.failure_detector_status & ~_last_failure_detector_status) {
+			trigger_window("failure detector");
+		}
+
+		_last_failure_detector_status = vehicle_status.failure_detector_status;
+	}
+
+	const float innovation_threshold = _param_sdlog_trig_innov.get();
+	estimator_status_s estimator_status;
+
+	if (innovation_threshold > 0.f && _estimator_status_sub.update(&estimator_status)) {
+		const bool innovation_exceeded = estimator_status.mag_test_ratio > innovation_threshold
+						 || estimator_status.vel_test_ratio > innovation_threshold
+						 || estimator_status.pos_test_ratio > innovation_threshold
+						 || estimator_status.hgt_test_ratio > innovation_threshold;
+
+		if (innovation_exceeded && !_estimator_innovation_triggered) {
+			trigger_window("estimator innovation");
+		}
+
+		_estimator_innovation_triggered = innovation_exceeded;
+	}
+}
+
+void Logger::trigger_window(const char *reason)
+{
+	if (!_writer.is_started(LogType::Full, LogWriter::BackendFile)) {
+		return;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+
+	if (_trigger_window_end == 0) {
+		const hrt_abstime pre_trigger = _param_sdlog_trig_pre.get() * 1e6f;
+		_trigger_window_start = now > pre_trigger ? now - pre_trigger : 0;
+		PX4_INFO("log trigger (%s)", reason);
+	}
+
+	_trigger_window_end = now + (hrt_abstime)(_param_sdlog_trig_post.get() * 1e6f);
+}
+
+void Logger::write_trigger_buffer(hrt_abstime loop_time)
+{
+	if (_trigger_window_end == 0) {
+		return;
+	}
+
+	if (loop_time > _trigger_window_end) {
+		// data that could not be written yet stays in the buffer as pre-trigger data of the next event
+		_trigger_window_end = 0;
+		return;
+	}
+
+	// leave at least half of the write buffer to the regular topics
+	const size_t max_fill = _writer.get_buffer_size_file(LogType::Full) / 2;
+	size_t msg_size;
+
+	while ((msg_size = _trigger_buffer.next_size()) > 0
+	       && _writer.get_buffer_fill_count_file(LogType::Full) + msg_size < max_fill) {
+
+		const bool too_old = _trigger_buffer.next_timestamp() < _trigger_window_start;
+
+		if (_trigger_buffer.pop(_msg_buffer, _msg_buffer_len) == 0) {
+			// cannot happen, all messages fit into _msg_buffer
+			_trigger_buffer.reset();
+			break;
+		}
+
+		if (!too_old) {
+			write_message(LogType::Full, _msg_buffer, msg_size);
+		}
+	}
+}
+
+bool Logger::init_delta_encoding()
+{
+	if (!_delta_refs) {
+		size_t total_size = 0;
+
+		for (int sub = 0; sub < _num_subscriptions; ++sub) {
+			total_size += _subscriptions[sub].get_topic()->o_size_no_padding;
+		}
+
+		_delta_refs = new uint8_t[total_size];
+		_delta_msg_buffer = new uint8_t[_msg_buffer_len];
+
+		if (!_delta_refs || !_delta_msg_buffer) {
+			PX4_ERR("failed to alloc delta encoding buffers");
+			delete[](_delta_refs);
+			delete[](_delta_msg_buffer);
+			_delta_refs = nullptr;
+			_delta_msg_buffer = nullptr;
+			return false;
+		}
+
+		uint8_t *ref = _delta_refs;
+
+		for (int sub = 0; sub < _num_subscriptions; ++sub) {
+			_subscriptions[sub].delta_ref = ref;
+			ref += _subscriptions[sub].get_topic()->o_size_no_padding;
+		}
+	}
+
+	// the first sample of every topic is written unencoded
+	for (int sub = 0; sub < _num_subscriptions; ++sub) {
+		_subscriptions[sub].delta_ref_valid = false;
+	}
+
+	return true;
+}
+
+bool Logger::write_data_message_full(LoggerSubscription &sub, size_t msg_size)
+{
+	if (!_delta_encoding) {
+		return write_message(LogType::Full, _msg_buffer, msg_size);
+	}
+
+	const uint8_t *data = _msg_buffer + sizeof(ulog_message_data_header_s);
+	const size_t data_size = msg_size - sizeof(ulog_message_data_header_s);
+	size_t delta_size = 0;
+
+	// mavlink and UDP clients receive the same messages but do not decode them, so only encode for a file-only log
+	if (sub.delta_ref_valid && !_writer.is_started(LogType::Full, LogWriter::BackendMavlink)
+	    && !_writer.is_started(LogType::Full, LogWriter::BackendUdp)) {
+		// only use the encoding if it is smaller
+		delta_size = ulog_delta_encode(data, sub.delta_ref, data_size,
+					       _delta_msg_buffer + sizeof(ulog_message_data_delta_header_s), data_size - 1);
+	}
+
+	bool written;
+
+	if (delta_size > 0) {
+		const size_t delta_msg_size = sizeof(ulog_message_data_delta_header_s) + delta_size;
+		const uint16_t write_msg_size = static_cast<uint16_t>(delta_msg_size - ULOG_MSG_HEADER_LEN);
+
+		_delta_msg_buffer[0] = (uint8_t)write_msg_size;
+		_delta_msg_buffer[1] = (uint8_t)(write_msg_size >> 8);
+		_delta_msg_buffer[2] = static_cast<uint8_t>(ULogMessageType::DATA_DELTA);
+		_delta_msg_buffer[3] = _msg_buffer[3]; // msg_id
+		_delta_msg_buffer[4] = _msg_buffer[4];
+
+		written = write_message(LogType::Full, _delta_msg_buffer, delta_msg_size);
+
+	} else {
+		written = write_message(LogType::Full, _msg_buffer, msg_size);
+	}
+
+	// after a dropout the reader does not have the reference, so the next sample is written unencoded
+	if (written) {
+		memcpy(sub.delta_ref, data, data_size);
+	}
+
+	sub.delta_ref_valid = written;
+
+	return written;
+}
+
 bool Logger::write_message(LogType type, void *ptr, size_t size)
 {
 	Statistics &stats = _statistics[(int)type];
@@ -1064,7 +1464,7 @@ int Logger::create_log_dir(LogType type, tm *tt, char *log_dir, int log_dir_len)
 	LogFileName &file_name = _file_name[(int)type];
 
 	/* create dir on sdcard if needed */
-	int n = snprintf(log_dir, log_dir_len, "%s/", LOG_ROOT[(int)type]);
+	int n = snprintf(log_dir, log_dir_len, "%s/", log_root(type));
 
 	if (n >= log_dir_len) {
 		PX4_ERR("log path too long");
@@ -1190,8 +1590,26 @@ void Logger::setReplayFile(const char *file_name)
 	_replay_file_name = strdup(file_name);
 }
 
+void Logger::setHighRateLogRoot(const char *log_root)
+{
+	if (_high_rate_log_root) {
+		free(_high_rate_log_root);
+	}
+
+	_high_rate_log_root = strdup(log_root);
+}
+
+bool Logger::setUdpDestination(const char *destination)
+{
+	return _writer.set_udp_destination(destination);
+}
+
 void Logger::start_log_file(LogType type)
 {
+	if (type == LogType::Full) {
+		start_log_udp();
+	}
+
 	if (_writer.is_started(type, LogWriter::BackendFile) || (_writer.backend() & LogWriter::BackendFile) == 0) {
 		return;
 	}
@@ -1210,48 +1628,168 @@ void Logger::start_log_file(LogType type)
 		mavlink_log_info(&_mavlink_log_pub, "[logger] %s", file_name);
 	}
 
+	if (type == LogType::Full) {
+		_delta_encoding = _param_sdlog_delta.get() && init_delta_encoding();
+
+		// pre-trigger data from a previous log is not useful
+		_trigger_buffer.reset();
+		_trigger_window_end = 0;
+	}
+
+	_writer.set_aligned_writes_file(_param_sdlog_aligned.get());
+	_writer.set_preallocation_file((size_t)_param_sdlog_prealloc.get() * 1024 * 1024);
 	_writer.start_log_file(type, file_name);
 	_writer.select_write_backend(LogWriter::BackendFile);
 	_writer.set_need_reliable_transfer(true);
-	write_header(type);
+	write_header(type, type == LogType::Full && _delta_encoding);
 	write_version(type);
-	write_formats(type);
 
 	if (type == LogType::Full) {
-		write_parameters(type);
-		write_perf_data(true);
-		write_console_output();
+		// the remaining definitions are written from the logger loop, spread over several iterations
+		_file_log_start_state = FileLogStartState::Formats;
+		_file_log_start_index = first_subscription(type);
+		_file_log_written_formats = WrittenFormats{};
+
+		// all parameters are written anyway
+		_changed_params_index = -1;
+		_changed_params_rescan = false;
+
+	} else {
+		write_formats(type);
+		write_all_add_logged_msg(type);
 	}
 
-	write_all_add_logged_msg(type);
 	_writer.set_need_reliable_transfer(false);
 	_writer.unselect_write_backend();
 	_writer.notify();
 
-	if (type == LogType::Full) {
-		/* reset performance counters to get in-flight min and max values in post flight log */
-		perf_reset_all();
+	_statistics[(int)type].start_time_file = hrt_absolute_time();
 
-		initialize_load_output(PrintLoadReason::Preflight);
+	if (type == LogType::Full && _num_high_rate_subs > 0) {
+		start_log_file(LogType::HighRate);
 	}
+}
 
-	_statistics[(int)type].start_time_file = hrt_absolute_time();
+void Logger::write_file_log_start()
+{
+	// both of these are large and thus we need to be careful in terms of stack size requirements
+	ulog_message_format_s msg;
+
+	const size_t buffer_size = _writer.get_buffer_size_file(LogType::Full);
+	bool wait_for_writer = false;
 
+	_writer.select_write_backend(LogWriter::BackendFile);
+	_writer.set_need_reliable_transfer(true);
+
+	// only fill up half of the buffer, so that we never have to wait for the writer thread
+	while (_file_log_start_state != FileLogStartState::Done && !wait_for_writer
+	       && _writer.get_buffer_fill_count_file(LogType::Full) < buffer_size / 2) {
+
+		switch (_file_log_start_state) {
+		case FileLogStartState::Formats:
+			if (_file_log_start_index < end_subscription(LogType::Full)) {
+				const LoggerSubscription &sub = _subscriptions[_file_log_start_index];
+				write_format(LogType::Full, *sub.get_topic(), _file_log_written_formats, msg, _file_log_start_index);
+				++_file_log_start_index;
+
+			} else {
+				_file_log_start_state = FileLogStartState::Parameters;
+				_file_log_start_index = 0;
+			}
+
+			break;
+
+		case FileLogStartState::Parameters:
+			_file_log_start_index = write_parameters(LogType::Full, _file_log_start_index, 16, false);
+
+			if (_file_log_start_index < 0) {
+				_file_log_start_state = FileLogStartState::PerfAndConsole;
+			}
+
+			break;
+
+		case FileLogStartState::PerfAndConsole:
+
+			// these are written at once, so wait until the buffer is (almost) empty
+			if (_writer.get_buffer_fill_count_file(LogType::Full) > buffer_size / 8) {
+				wait_for_writer = true;
+				break;
+			}
+
+			write_perf_data(true);
+			write_console_output();
+
+			/* reset performance counters to get in-flight min and max values in post flight log */
+			perf_reset_all();
+
+			_file_log_start_state = FileLogStartState::AddLoggedMessages;
+			_file_log_start_index = first_subscription(LogType::Full);
+			break;
+
+		case FileLogStartState::AddLoggedMessages:
+			if (_file_log_start_index < end_subscription(LogType::Full)) {
+				LoggerSubscription &sub = _subscriptions[_file_log_start_index];
+
+				if (sub.valid()) {
+					write_add_logged_msg(LogType::Full, sub);
+				}
+
+				++_file_log_start_index;
+
+			} else {
+				_file_log_start_state = FileLogStartState::Done;
+
+				bool added_subscriptions = false;
+
+				for (int i = first_subscription(LogType::Full); i < end_subscription(LogType::Full); ++i) {
+					added_subscriptions = added_subscriptions || _subscriptions[i].valid();
+				}
+
+				if (!added_subscriptions) {
+					PX4_ERR("No subscriptions added"); // this results in invalid log files
+				}
+
+				initialize_load_output(PrintLoadReason::Preflight);
+			}
+
+			break;
+
+		case FileLogStartState::Done:
+			break;
+		}
+	}
+
+	_writer.set_need_reliable_transfer(false);
+	_writer.unselect_write_backend();
+	_writer.notify();
 }
 
 void Logger::stop_log_file(LogType type)
 {
+	if (type == LogType::Full) {
+		stop_log_udp();
+	}
+
 	if (!_writer.is_started(type, LogWriter::BackendFile)) {
 		return;
 	}
 
 	if (type == LogType::Full) {
+		_file_log_start_state = FileLogStartState::Done;
+
 		_writer.set_need_reliable_transfer(true);
 		write_perf_data(false);
 		_writer.set_need_reliable_transfer(false);
+		_delta_encoding = false;
+
+		stop_log_file(LogType::HighRate);
 	}
 
 	_writer.stop_log_file(type);
+
+	if (type == LogType::Full) {
+		update_backpressure(hrt_absolute_time());
+	}
 }
 
 void Logger::start_log_mavlink()
@@ -1286,6 +1824,38 @@ void Logger::stop_log_mavlink()
 	_writer.stop_log_mavlink();
 }
 
+void Logger::start_log_udp()
+{
+	if (!(_writer.backend() & LogWriter::BackendUdp) || _writer.is_started(LogType::Full, LogWriter::BackendUdp)) {
+		return;
+	}
+
+	PX4_INFO("Start UDP log stream");
+
+	// the stream gets its own header, so that it can start independently from the file log
+	_writer.start_log_udp();
+	_writer.select_write_backend(LogWriter::BackendUdp);
+	_writer.set_need_reliable_transfer(true);
+	write_header(LogType::Full);
+	write_version(LogType::Full);
+	write_formats(LogType::Full);
+	write_parameters(LogType::Full);
+	write_all_add_logged_msg(LogType::Full);
+	_writer.set_need_reliable_transfer(false);
+	_writer.unselect_write_backend();
+	_writer.notify();
+}
+
+void Logger::stop_log_udp()
+{
+	if (!_writer.is_started(LogType::Full, LogWriter::BackendUdp)) {
+		return;
+	}
+
+	PX4_INFO("Stop UDP log stream");
+	_writer.stop_log_udp();
+}
+
 struct perf_callback_data_t {
 	Logger *logger;
 	int counter;
@@ -1431,7 +2001,7 @@ void Logger::write_format(LogType type, const orb_metadata &meta, WrittenFormats
 		}
 	}
 
-	for (int i = 0; i < subscription_index; ++i) {
+	for (int i = first_subscription(type); i < subscription_index; ++i) {
 		if (_subscriptions[i].get_topic() == &meta) {
 			PX4_DEBUG("already in _subscriptions: %s", meta.o_name);
 			return;
@@ -1527,40 +2097,22 @@ void Logger::write_format(LogType type, const orb_metadata &meta, WrittenFormats
 
 void Logger::write_formats(LogType type)
 {
-	_writer.lock();
-
 	// both of these are large and thus we need to be careful in terms of stack size requirements
 	ulog_message_format_s msg;
 	WrittenFormats written_formats;
 
 	// write all subscribed formats
-	int sub_count = _num_subscriptions;
-
-	if (type == LogType::Mission) {
-		sub_count = _num_mission_subs;
-	}
-
-	for (int i = 0; i < sub_count; ++i) {
+	for (int i = first_subscription(type); i < end_subscription(type); ++i) {
 		const LoggerSubscription &sub = _subscriptions[i];
 		write_format(type, *sub.get_topic(), written_formats, msg, i);
 	}
-
-	_writer.unlock();
 }
 
 void Logger::write_all_add_logged_msg(LogType type)
 {
-	_writer.lock();
-
-	int sub_count = _num_subscriptions;
-
-	if (type == LogType::Mission) {
-		sub_count = _num_mission_subs;
-	}
-
 	bool added_subscriptions = false;
 
-	for (int i = 0; i < sub_count; ++i) {
+	for (int i = first_subscription(type); i < end_subscription(type); ++i) {
 		LoggerSubscription &sub = _subscriptions[i];
 
 		if (sub.valid()) {
@@ -1569,8 +2121,6 @@ void Logger::write_all_add_logged_msg(LogType type)
 		}
 	}
 
-	_writer.unlock();
-
 	if (!added_subscriptions) {
 		PX4_ERR("No subscriptions added"); // this results in invalid log files
 	}
@@ -1608,7 +2158,6 @@ void Logger::write_add_logged_msg(LogType type, LoggerSubscription &subscription
 
 void Logger::write_info(LogType type, const char *name, const char *value)
 {
-	_writer.lock();
 	ulog_message_info_header_s msg = {};
 	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
 	msg.msg_type = static_cast<uint8_t>(ULogMessageType::INFO);
@@ -1627,13 +2176,10 @@ void Logger::write_info(LogType type, const char *name, const char *value)
 
 		write_message(type, buffer, msg_size);
 	}
-
-	_writer.unlock();
 }
 
 void Logger::write_info_multiple(LogType type, const char *name, const char *value, bool is_continued)
 {
-	_writer.lock();
 	ulog_message_info_multiple_header_s msg;
 	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
 	msg.msg_type = static_cast<uint8_t>(ULogMessageType::INFO_MULTIPLE);
@@ -1656,8 +2202,6 @@ void Logger::write_info_multiple(LogType type, const char *name, const char *val
 	} else {
 		PX4_ERR("info_multiple str too long (%i), key=%s", msg.key_len, msg.key);
 	}
-
-	_writer.unlock();
 }
 
 void Logger::write_info(LogType type, const char *name, int32_t value)
@@ -1674,7 +2218,6 @@ void Logger::write_info(LogType type, const char *name, uint32_t value)
 template<typename T>
 void Logger::write_info_template(LogType type, const char *name, T value, const char *type_str)
 {
-	_writer.lock();
 	ulog_message_info_header_s msg = {};
 	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
 	msg.msg_type = static_cast<uint8_t>(ULogMessageType::INFO);
@@ -1690,11 +2233,9 @@ void Logger::write_info_template(LogType type, const char *name, T value, const
 	msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
 
 	write_message(type, buffer, msg_size);
-
-	_writer.unlock();
 }
 
-void Logger::write_header(LogType type)
+void Logger::write_header(LogType type, bool delta_encoded)
 {
 	ulog_file_header_s header = {};
 	header.magic[0] = 'U';
@@ -1706,7 +2247,6 @@ void Logger::write_header(LogType type)
 	header.magic[6] = 0x35;
 	header.magic[7] = 0x01; //file version 1
 	header.timestamp = hrt_absolute_time();
-	_writer.lock();
 	write_message(type, &header, sizeof(header));
 
 	// write the Flags message: this MUST be written right after the ulog header
@@ -1715,9 +2255,11 @@ void Logger::write_header(LogType type)
 	flag_bits.msg_size = sizeof(flag_bits) - ULOG_MSG_HEADER_LEN;
 	flag_bits.msg_type = static_cast<uint8_t>(ULogMessageType::FLAG_BITS);
 
-	write_message(type, &flag_bits, sizeof(flag_bits));
+	if (delta_encoded) {
+		flag_bits.incompat_flags[0] |= ULOG_INCOMPAT_FLAG0_DATA_DELTA_MASK;
+	}
 
-	_writer.unlock();
+	write_message(type, &flag_bits, sizeof(flag_bits));
 }
 
 void Logger::write_version(LogType type)
@@ -1793,147 +2335,90 @@ void Logger::write_version(LogType type)
 
 	if (type == LogType::Mission) {
 		write_info(type, "log_type", "mission");
+
+	} else if (type == LogType::HighRate) {
+		write_info(type, "log_type", "high_rate");
 	}
 }
 
-void Logger::write_parameters(LogType type)
+bool Logger::write_parameter(LogType type, param_t param)
 {
-	_writer.lock();
 	ulog_message_parameter_header_s msg = {};
 	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
 
 	msg.msg_type = static_cast<uint8_t>(ULogMessageType::PARAMETER);
-	int param_idx = 0;
-	param_t param = 0;
-
-	do {
-		// skip over all parameters which are not invalid and not used
-		do {
-			param = param_for_index(param_idx);
-			++param_idx;
-		} while (param != PARAM_INVALID && !param_used(param));
-
-		// save parameters which are valid AND used
-		if (param != PARAM_INVALID) {
-			// get parameter type and size
-			const char *type_str;
-			param_type_t ptype = param_type(param);
-			size_t value_size = 0;
-
-			switch (ptype) {
-			case PARAM_TYPE_INT32:
-				type_str = "int32_t";
-				value_size = sizeof(int32_t);
-				break;
 
-			case PARAM_TYPE_FLOAT:
-				type_str = "float";
-				value_size = sizeof(float);
-				break;
+	// get parameter type and size
+	const char *type_str;
+	param_type_t ptype = param_type(param);
+	size_t value_size = 0;
 
-			default:
-				continue;
-			}
+	switch (ptype) {
+	case PARAM_TYPE_INT32:
+		type_str = "int32_t";
+		value_size = sizeof(int32_t);
+		break;
 
-			// format parameter key (type and name)
-			msg.key_len = snprintf(msg.key, sizeof(msg.key), "%s %s", type_str, param_name(param));
-			size_t msg_size = sizeof(msg) - sizeof(msg.key) + msg.key_len;
+	case PARAM_TYPE_FLOAT:
+		type_str = "float";
+		value_size = sizeof(float);
+		break;
 
-			// copy parameter value directly to buffer
-			switch (ptype) {
-			case PARAM_TYPE_INT32:
-				param_get(param, (int32_t *)&buffer[msg_size]);
-				break;
+	default:
+		return false;
+	}
 
-			case PARAM_TYPE_FLOAT:
-				param_get(param, (float *)&buffer[msg_size]);
-				break;
+	// format parameter key (type and name)
+	msg.key_len = snprintf(msg.key, sizeof(msg.key), "%s %s", type_str, param_name(param));
+	size_t msg_size = sizeof(msg) - sizeof(msg.key) + msg.key_len;
 
-			default:
-				continue;
-			}
+	// copy parameter value directly to buffer
+	switch (ptype) {
+	case PARAM_TYPE_INT32:
+		param_get(param, (int32_t *)&buffer[msg_size]);
+		break;
 
-			msg_size += value_size;
+	case PARAM_TYPE_FLOAT:
+		param_get(param, (float *)&buffer[msg_size]);
+		break;
 
-			msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+	default:
+		return false;
+	}
 
-			write_message(type, buffer, msg_size);
-		}
-	} while ((param != PARAM_INVALID) && (param_idx < (int) param_count()));
+	msg_size += value_size;
 
-	_writer.unlock();
-	_writer.notify();
+	// msg_size is now 1 (msg_type) + 2 (msg_size) + 1 (key_len) + key_len + value_size
+	msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+
+	return write_message(type, buffer, msg_size);
 }
 
-void Logger::write_changed_parameters(LogType type)
+void Logger::write_parameters(LogType type)
 {
-	_writer.lock();
-	ulog_message_parameter_header_s msg = {};
-	uint8_t *buffer = reinterpret_cast<uint8_t *>(&msg);
-
-	msg.msg_type = static_cast<uint8_t>(ULogMessageType::PARAMETER);
-	int param_idx = 0;
-	param_t param = 0;
-
-	do {
-		// skip over all parameters which are not invalid and not used
-		do {
-			param = param_for_index(param_idx);
-			++param_idx;
-		} while (param != PARAM_INVALID && !param_used(param));
-
-		// log parameters which are valid AND used AND unsaved
-		if ((param != PARAM_INVALID) && param_value_unsaved(param)) {
-
-			// get parameter type and size
-			const char *type_str;
-			param_type_t ptype = param_type(param);
-			size_t value_size = 0;
-
-			switch (ptype) {
-			case PARAM_TYPE_INT32:
-				type_str = "int32_t";
-				value_size = sizeof(int32_t);
-				break;
-
-			case PARAM_TYPE_FLOAT:
-				type_str = "float";
-				value_size = sizeof(float);
-				break;
-
-			default:
-				continue;
-			}
-
-			// format parameter key (type and name)
-			msg.key_len = snprintf(msg.key, sizeof(msg.key), "%s %s", type_str, param_name(param));
-			size_t msg_size = sizeof(msg) - sizeof(msg.key) + msg.key_len;
-
-			// copy parameter value directly to buffer
-			switch (ptype) {
-			case PARAM_TYPE_INT32:
-				param_get(param, (int32_t *)&buffer[msg_size]);
-				break;
-
-			case PARAM_TYPE_FLOAT:
-				param_get(param, (float *)&buffer[msg_size]);
-				break;
+	write_parameters(type, 0, param_count(), false);
+	_writer.notify();
+}
 
-			default:
-				continue;
-			}
+int Logger::write_parameters(LogType type, int param_idx, int max_count, bool changed_only)
+{
+	const int num_params = param_count();
+	const int end_idx = math::min(param_idx + max_count, num_params);
 
-			msg_size += value_size;
+	for (; param_idx < end_idx; ++param_idx) {
+		const param_t param = param_for_index(param_idx);
 
-			// msg_size is now 1 (msg_type) + 2 (msg_size) + 1 (key_len) + key_len + value_size
-			msg.msg_size = msg_size - ULOG_MSG_HEADER_LEN;
+		if (param == PARAM_INVALID) {
+			return -1;
+		}
 
-			write_message(type, buffer, msg_size);
+		// save parameters which are valid AND used (AND unsaved if only changed ones are requested)
+		if (param_used(param) && (!changed_only || param_value_unsaved(param))) {
+			write_parameter(type, param);
 		}
-	} while ((param != PARAM_INVALID) && (param_idx < (int) param_count()));
+	}
 
-	_writer.unlock();
-	_writer.notify();
+	return param_idx < num_params ? param_idx : -1;
 }
 
 void Logger::ack_vehicle_command(vehicle_command_s *cmd, uint32_t result)
@@ -1968,16 +2453,26 @@ It supports 2 backends:
 
 Both backends can be enabled and used at the same time.
 
+On POSIX, the full log can additionally be streamed via UDP (-u) at full rate for live analysis.
+The stream starts and stops with the full log (it gets its own header), and each datagram only
+contains complete ULog messages. There is no flow control, so a lost datagram means lost data.
+
 The file backend supports 2 types of log files: full (the normal log) and a mission
 log. The mission log is a reduced ulog file and can be used for example for geotagging or
 vehicle management. It can be enabled and configured via SDLOG_MISSION parameter.
 The normal log is always a superset of the mission log.
+With -s, the raw high-rate IMU topics are additionally written to a separate log file in another
+directory, which can be on a different storage device (e.g. onboard flash).
+
+High-rate raw IMU topics can be captured into a RAM buffer and only written around trigger
+events (e.g. a failure detector flag), including the data before the event. It can be enabled
+via SDLOG_TRIG_PRE parameter.
 
 ### Implementation
 The implementation uses two threads:
 - The main thread, running at a fixed rate (or polling on a topic if started with -p) and checking for
   data updates
-- The writer thread, writing data to the file
+- The writer thread, writing data to the file (and a second one for the high-rate log, if enabled)
 
 In between there is a write buffer with configurable size (and another fixed-size buffer for
 the mission log). It should be large to avoid dropouts.
@@ -2001,8 +2496,13 @@ $ logger on
 	PRINT_MODULE_USAGE_PARAM_INT('b', 12, 4, 10000, "Log buffer size in KiB", true);
 	PRINT_MODULE_USAGE_PARAM_STRING('p', nullptr, "<topic_name>",
 					 "Poll on a topic instead of running with fixed rate (Log rate and topic intervals are ignored if this is set)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('s', nullptr, "<dir>",
+					 "Write the high-rate IMU topics to a separate log in this directory (e.g. on onboard flash)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('u', nullptr, "<ip>[:<port>]",
+					 "Additionally stream the full log as raw ULog via UDP while logging (POSIX only, default port 14560)", true);
 	PRINT_MODULE_USAGE_COMMAND_DESCR("on", "start logging now, override arming (logger must be running)");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("off", "stop logging now, override arming (logger must be running)");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("trigger", "trigger an event-triggered high-rate logging window (SDLOG_TRIG_PRE)");
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
 	return 0;
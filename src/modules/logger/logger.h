@@ -35,8 +35,10 @@
 
 #include "log_writer.h"
 #include "messages.h"
+#include "pre_trigger_buffer.h"
 #include <containers/Array.hpp>
 #include "util.h"
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/defines.h>
 #include <drivers/drv_hrt.h>
 #include <version/version.h>
@@ -47,7 +49,10 @@
 
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/SubscriptionInterval.hpp>
+#include <uORB/SubscriptionQueued.hpp>
+#include <uORB/topics/estimator_status.h>
 #include <uORB/topics/logger_status.h>
 #include <uORB/topics/log_message.h>
 #include <uORB/topics/manual_control_setpoint.h>
@@ -67,15 +72,94 @@ namespace logger
 
 static constexpr uint8_t MSG_ID_INVALID = UINT8_MAX;
 
-struct LoggerSubscription : public uORB::SubscriptionInterval {
+struct LoggerSubscription : public uORB::SubscriptionCallback {
 
 	uint8_t msg_id{MSG_ID_INVALID};
 
-	LoggerSubscription() = default;
+	uint8_t *delta_ref{nullptr}; ///< last written sample (for delta encoding)
+	bool delta_ref_valid{false};
+
+	bool triggered{false}; ///< only logged around trigger events (through the pre-trigger buffer)
+
+	bool low_priority{false}; ///< rate is reduced under backpressure (see set_throttled())
+
+	LoggerSubscription() : uORB::SubscriptionCallback(nullptr) {}
 
 	LoggerSubscription(ORB_ID id, uint32_t interval_ms = 0, uint8_t instance = 0) :
-		uORB::SubscriptionInterval(id, interval_ms * 1000, instance)
+		uORB::SubscriptionCallback(get_orb_meta(id), interval_ms * 1000, instance)
 	{}
+
+	/**
+	 * set the flag that is raised on each publication (only used if the logger runs with SDLOG_UPD_CB).
+	 * The callback is registered once the topic is subscribed.
+	 */
+	void set_dirty_flag(px4::atomic<uint32_t> *word, int bit)
+	{
+		_dirty = word;
+		_dirty_mask = 1u << bit;
+
+		if (valid()) {
+			register_dirty_callback();
+		}
+	}
+
+	bool subscribe()
+	{
+		if (!uORB::SubscriptionCallback::subscribe()) {
+			return false;
+		}
+
+		if (_dirty) {
+			register_dirty_callback();
+		}
+
+		return true;
+	}
+
+	/**
+	 * reduce the logging rate (a low-priority topic while the write buffer is filling up)
+	 * or restore the configured interval
+	 */
+	void set_throttled(bool throttled)
+	{
+		if (throttled == _throttled) {
+			return;
+		}
+
+		if (throttled) {
+			_nominal_interval_us = _interval_us;
+			_interval_us = math::max(_interval_us * 4, (uint32_t)100000); // at most 10 Hz
+
+		} else {
+			_interval_us = _nominal_interval_us;
+		}
+
+		_throttled = throttled;
+	}
+
+	/** new data is available, ignoring the interval */
+	bool pending() { return _subscription.updated(); }
+
+	void call() override
+	{
+		if (_dirty) {
+			_dirty->fetch_or(_dirty_mask);
+		}
+	}
+
+private:
+	void register_dirty_callback()
+	{
+		if (!_registered && registerCallback()) {
+			call(); // visit existing data once
+		}
+	}
+
+	px4::atomic<uint32_t> *_dirty{nullptr};
+	uint32_t _dirty_mask{0};
+
+	uint32_t _nominal_interval_us{0}; ///< interval while not throttled
+	bool _throttled{false};
 };
 
 class Logger : public ModuleBase<Logger>, public ModuleParams
@@ -118,6 +202,20 @@ public:
 	 */
 	void setReplayFile(const char *file_name);
 
+	/**
+	 * Enable the separate high-rate log (LogType::HighRate), written to another directory / device.
+	 * This must be called before starting the logger.
+	 * @param log_root root directory of the high-rate logs. Will be copied.
+	 */
+	void setHighRateLogRoot(const char *log_root);
+
+	/**
+	 * Set the destination of the UDP log stream (logger started with BackendUdp).
+	 * This must be called before starting the logger.
+	 * @return false if invalid
+	 */
+	bool setUdpDestination(const char *destination);
+
 	/**
 	 * request the logger thread to stop (this method does not block).
 	 * @return true if the logger is stopped, false if (still) running
@@ -128,6 +226,11 @@ public:
 
 	void set_arm_override(bool override) { _manually_logging_override = override; }
 
+	/**
+	 * request an event-triggered logging window (thread-safe)
+	 */
+	void request_trigger() { _trigger_requested.store(true); }
+
 private:
 
 	enum class PrintLoadReason {
@@ -140,9 +243,15 @@ private:
 	static constexpr unsigned	MAX_NO_LOGFILE = 999;	/**< Maximum number of log files */
 	static constexpr const char	*LOG_ROOT[(int)LogType::Count] = {
 		PX4_STORAGEDIR "/log",
-		PX4_STORAGEDIR "/mission_log"
+		PX4_STORAGEDIR "/mission_log",
+		nullptr // high-rate log: configured with -s
 	};
 
+	const char *log_root(LogType type) const
+	{
+		return type == LogType::HighRate ? _high_rate_log_root : LOG_ROOT[(int)type];
+	}
+
 	struct LogFileName {
 		char log_dir[12];           ///< e.g. "2018-01-01" or "sess001"
 		int sess_dir_index{1};      ///< search starting index for 'sess<i>' directory name
@@ -175,7 +284,6 @@ private:
 
 	/**
 	 * Write an ADD_LOGGED_MSG to the log for a given subscription and instance.
-	 * _writer.lock() must be held when calling this.
 	 */
 	void write_add_logged_msg(LogType type, LoggerSubscription &subscription);
 
@@ -202,6 +310,11 @@ private:
 
 	void stop_log_mavlink();
 
+	/** start/stop the UDP stream of the full log (if enabled), together with the full log */
+	void start_log_udp();
+
+	void stop_log_udp();
+
 	/** check if mavlink logging can be started */
 	bool can_start_mavlink_log() const
 	{
@@ -215,7 +328,19 @@ private:
 	/**
 	 * write the file header with file magic and timestamp.
 	 */
-	void write_header(LogType type);
+	void write_header(LogType type, bool delta_encoded = false);
+
+	/**
+	 * allocate the reference samples for delta encoding of the full log (if not done yet) and reset them
+	 * @return true on success
+	 */
+	bool init_delta_encoding();
+
+	/**
+	 * write a data message in _msg_buffer to the full log, delta encoded if enabled
+	 * @return true on success (as write_message())
+	 */
+	bool write_data_message_full(LoggerSubscription &sub, size_t msg_size);
 
 	/// Array to store written formats for nested definitions (only)
 	using WrittenFormats = Array < const orb_metadata *, 20 >;
@@ -224,6 +349,21 @@ private:
 			  int subscription_index, int level = 1);
 	void write_formats(LogType type);
 
+	/**
+	 * write the next part of the definitions of a starting full file log (formats, parameters, perf counters and
+	 * subscriptions), as long as there is room in the write buffer.
+	 * Topic data must only be written once _file_log_start_state is Done.
+	 */
+	void write_file_log_start();
+
+	enum class FileLogStartState : uint8_t {
+		Done = 0,
+		Formats,
+		Parameters,
+		PerfAndConsole,
+		AddLoggedMessages
+	};
+
 	/**
 	 * write performance counters
 	 * @param preflight preflight if true, postflight otherwise
@@ -256,15 +396,54 @@ private:
 	template<typename T>
 	void write_info_template(LogType type, const char *name, T value, const char *type_str);
 
+	/**
+	 * write a single parameter
+	 * @return true on success (as write_message())
+	 */
+	bool write_parameter(LogType type, param_t param);
+
+	/** write all used parameters */
 	void write_parameters(LogType type);
 
-	void write_changed_parameters(LogType type);
+	/**
+	 * write the used parameters with an index in [param_idx, param_idx + max_count)
+	 * @param changed_only only write parameters with an unsaved value
+	 * @return the index to continue with, or -1 if all parameters have been visited
+	 */
+	int write_parameters(LogType type, int param_idx, int max_count, bool changed_only);
 
 	inline bool copy_if_updated(int sub_idx, void *buffer, bool try_to_subscribe);
 
+	/**
+	 * write the data of a subscription to the log(s) if it has been updated
+	 * @param total_bytes incremented by the number of bytes written to the full log (only with DBGPRINT)
+	 */
+	void write_topic_data(int sub_idx, bool try_to_subscribe, hrt_abstime loop_time, uint32_t &total_bytes);
+
+	int dirty_topics_words() const { return (_num_subscriptions + 31) / 32; }
+
+	/**
+	 * range of the subscriptions that are logged to a log type: [first_subscription(), end_subscription())
+	 */
+	int first_subscription(LogType type) const
+	{
+		return type == LogType::HighRate ? _num_subscriptions - _num_high_rate_subs : 0;
+	}
+
+	int end_subscription(LogType type) const
+	{
+		switch (type) {
+		case LogType::Mission: return _num_mission_subs;
+
+		case LogType::Full: return _num_subscriptions - _num_high_rate_subs;
+
+		default: return _num_subscriptions;
+		}
+	}
+
 	/**
 	 * Write exactly one ulog message to the logger and handle dropouts.
-	 * Must be called with _writer.lock() held.
+	 * Must only be called from the logger thread.
 	 * @return true if data written, false otherwise (on overflow)
 	 */
 	bool write_message(LogType type, void *ptr, size_t size);
@@ -290,6 +469,28 @@ private:
 	bool start_stop_logging();
 
 	void handle_vehicle_command_update();
+
+	/**
+	 * check the trigger sources (failure detector, estimator innovations, trigger requests)
+	 */
+	void check_trigger_events();
+
+	/**
+	 * check the full log write buffer fill level and reduce the rate of the low-priority topics
+	 * while it is getting full (or restore it once the writer caught up), before we start to drop data
+	 */
+	void update_backpressure(hrt_abstime now);
+
+	/**
+	 * start an event-triggered logging window, or extend it if one is active
+	 */
+	void trigger_window(const char *reason);
+
+	/**
+	 * write the pre-trigger buffer to the full log while a trigger window is active,
+	 * as far as the write buffer allows
+	 */
+	void write_trigger_buffer(hrt_abstime loop_time);
 	void ack_vehicle_command(vehicle_command_s *cmd, uint32_t result);
 
 	/**
@@ -313,6 +514,10 @@ private:
 	uint8_t						*_msg_buffer{nullptr};
 	int						_msg_buffer_len{0};
 
+	uint8_t						*_delta_msg_buffer{nullptr}; ///< delta encoded message (same size as _msg_buffer)
+	uint8_t						*_delta_refs{nullptr}; ///< reference samples of all subscriptions
+	bool						_delta_encoding{false}; ///< delta encoding enabled for the current full log file
+
 	LogFileName					_file_name[(int)LogType::Count];
 
 	bool						_prev_state{false}; ///< previous state depending on logging mode (arming or aux1 state)
@@ -324,10 +529,30 @@ private:
 	LogMode						_log_mode;
 	const bool					_log_name_timestamp;
 
-	LoggerSubscription	 			*_subscriptions{nullptr}; ///< all subscriptions for full & mission log (in front)
+	LoggerSubscription	 			*_subscriptions{nullptr}; ///< all subscriptions: mission (in front), full, high-rate log (at the end)
 	int						_num_subscriptions{0};
+	px4::atomic<uint32_t>				*_dirty_topics{nullptr}; ///< bitmap of updated subscriptions (SDLOG_UPD_CB only)
 	MissionSubscription 				_mission_subscriptions[MAX_MISSION_TOPICS_NUM] {}; ///< additional data for mission subscriptions
 	int						_num_mission_subs{0};
+	int						_num_high_rate_subs{0}; ///< subscriptions of the high-rate log (at the end)
+	char						*_high_rate_log_root{nullptr};
+
+	PreTriggerBuffer				_trigger_buffer; ///< high-rate data of the trigger topics (only allocated if enabled)
+	hrt_abstime					_trigger_window_start{0}; ///< older pre-trigger data is discarded
+	hrt_abstime					_trigger_window_end{0}; ///< end of the active trigger window (0 if none)
+	px4::atomic_bool				_trigger_requested{false};
+	uint8_t						_last_failure_detector_status{0};
+	bool						_estimator_innovation_triggered{false};
+
+	bool						_backpressure_active{false}; ///< low-priority topics are throttled
+
+	FileLogStartState				_file_log_start_state{FileLogStartState::Done};
+	int						_file_log_start_index{0}; ///< subscription or parameter index of the current state
+	WrittenFormats					_file_log_written_formats;
+
+	int						_changed_params_index{-1}; ///< next parameter to check for changes (-1 if not checking)
+	bool						_changed_params_rescan{false};
+	hrt_abstime					_backpressure_change_time{0};
 
 	LogWriter					_writer;
 	uint32_t					_log_interval{0};
@@ -341,15 +566,17 @@ private:
 	hrt_abstime					_next_load_print{0}; ///< timestamp when to print the process load
 	PrintLoadReason					_print_load_reason {PrintLoadReason::Preflight};
 
-	uORB::PublicationMulti<logger_status_s>		_logger_status_pub[2] { ORB_ID(logger_status), ORB_ID(logger_status) };
+	uORB::PublicationMulti<logger_status_s>		_logger_status_pub[(int)LogType::Count] { ORB_ID(logger_status), ORB_ID(logger_status), ORB_ID(logger_status) };
 
 #ifndef ORB_USE_PUBLISHER_RULES // don't publish logger_status when building for replay
 	hrt_abstime					_logger_status_last {0};
 #endif
 
 	uORB::Subscription				_manual_control_sp_sub{ORB_ID(manual_control_setpoint)};
-	uORB::Subscription				_vehicle_command_sub{ORB_ID(vehicle_command)};
+	uORB::SubscriptionQueued<vehicle_command_s, 4>	_vehicle_command_sub{ORB_ID(vehicle_command)}; // don't miss logging commands in bursts
 	uORB::Subscription				_vehicle_status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription				_trigger_vehicle_status_sub{ORB_ID(vehicle_status)};
+	uORB::Subscription				_estimator_status_sub{ORB_ID(estimator_status)};
 	uORB::SubscriptionInterval		_log_message_sub{ORB_ID(log_message), 20};
 	uORB::Subscription 				_parameter_update_sub{ORB_ID(parameter_update)};
 
@@ -359,7 +586,16 @@ private:
 		(ParamInt<px4::params::SDLOG_PROFILE>) _param_sdlog_profile,
 		(ParamInt<px4::params::SDLOG_MISSION>) _param_sdlog_mission,
 		(ParamBool<px4::params::SDLOG_BOOT_BAT>) _param_sdlog_boot_bat,
-		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid
+		(ParamBool<px4::params::SDLOG_UUID>) _param_sdlog_uuid,
+		(ParamBool<px4::params::SDLOG_ALIGNED>) _param_sdlog_aligned,
+		(ParamBool<px4::params::SDLOG_DELTA>) _param_sdlog_delta,
+		(ParamFloat<px4::params::SDLOG_TRIG_PRE>) _param_sdlog_trig_pre,
+		(ParamFloat<px4::params::SDLOG_TRIG_POST>) _param_sdlog_trig_post,
+		(ParamInt<px4::params::SDLOG_TRIG_BUF>) _param_sdlog_trig_buf,
+		(ParamFloat<px4::params::SDLOG_TRIG_INNOV>) _param_sdlog_trig_innov,
+		(ParamBool<px4::params::SDLOG_UPD_CB>) _param_sdlog_upd_cb,
+		(ParamInt<px4::params::SDLOG_PREALLOC>) _param_sdlog_prealloc,
+		(ParamBool<px4::params::SDLOG_THROTTLE>) _param_sdlog_throttle
 	)
 };
 
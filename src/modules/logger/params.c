@@ -169,3 +169,145 @@ PARAM_DEFINE_INT32(SDLOG_DIRS_MAX, 0);
  * @group SD Logging
  */
 PARAM_DEFINE_INT32(SDLOG_UUID, 1);
+
+/**
+ * Aligned block writes
+ *
+ * If enabled, the full log is written to the SD card in whole 4 KB blocks only (a partial
+ * block is held back until more data is available). This avoids read-modify-write cycles
+ * on the card for unaligned writes, but increases the buffer usage slightly.
+ *
+ * The achieved write throughput is shown in 'logger status' and can be compared to 'sd_bench'.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_ALIGNED, 0);
+
+/**
+ * Delta encoded data
+ *
+ * If enabled, data messages in the full log file are written as the difference to the
+ * previous sample of the same topic (ULog DATA_DELTA messages), which typically reduces
+ * the log size of high-rate topics several times. Samples are written unencoded while
+ * mavlink log streaming is active.
+ *
+ * Note: such logs can only be read by tools that support the DATA_DELTA ULog extension
+ * (the log sets an incompatible flag bit, so other tools refuse to parse it).
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_DELTA, 0);
+
+/**
+ * Pre-trigger duration of event-triggered logging
+ *
+ * If set, raw high-rate IMU topics (sensor_gyro_fifo, sensor_accel_fifo and the
+ * sensor_gyro/sensor_accel instances that are not otherwise logged) are continuously
+ * captured into a RAM buffer, and only written to the log around trigger events:
+ * the last SDLOG_TRIG_PRE seconds before the event and the following SDLOG_TRIG_POST
+ * seconds.
+ *
+ * Trigger events are: a new failure detector flag, an estimator innovation test ratio
+ * above SDLOG_TRIG_INNOV, the logger trigger vehicle command and 'logger trigger'.
+ *
+ * The pre-trigger duration is also limited by the buffer size (SDLOG_TRIG_BUF).
+ *
+ * Set to 0 to disable.
+ *
+ * @unit s
+ * @min 0
+ * @max 10
+ * @decimal 1
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_FLOAT(SDLOG_TRIG_PRE, 0.0f);
+
+/**
+ * Post-trigger duration of event-triggered logging
+ *
+ * Time after a trigger event during which the trigger topics are logged at full rate.
+ * A new event within the window extends it.
+ *
+ * @unit s
+ * @min 0
+ * @max 60
+ * @decimal 1
+ * @group SD Logging
+ */
+PARAM_DEFINE_FLOAT(SDLOG_TRIG_POST, 2.0f);
+
+/**
+ * Buffer size of event-triggered logging
+ *
+ * RAM buffer size of the pre-trigger data. Only used if SDLOG_TRIG_PRE is set.
+ *
+ * @unit KB
+ * @min 4
+ * @max 1024
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_TRIG_BUF, 32);
+
+/**
+ * Estimator innovation trigger of event-triggered logging
+ *
+ * Trigger a logging window when one of the estimator innovation test ratios
+ * (estimator_status) exceeds this value. Set to 0 to disable.
+ *
+ * @min 0
+ * @max 10
+ * @decimal 1
+ * @group SD Logging
+ */
+PARAM_DEFINE_FLOAT(SDLOG_TRIG_INNOV, 1.0f);
+
+/**
+ * Only visit updated topics
+ *
+ * If enabled, the logger registers a publication callback for each logged topic and
+ * only checks the topics that got published since the last logger iteration, instead
+ * of checking all of them. This reduces the logger CPU load with many logged topics,
+ * at the cost of a callback per publication and a callback table for each logged topic.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_UPD_CB, 0);
+
+/**
+ * Log file preallocation
+ *
+ * If set, this amount of space is reserved for the full log file (and the high-rate log)
+ * when it is opened, so that the file system does not have to allocate clusters while
+ * logging, which otherwise causes write latency spikes. The file is truncated to the
+ * written size when logging stops.
+ *
+ * Make sure the log fits, otherwise it grows as usual afterwards. Note that after a crash
+ * (no regular stop), the file keeps the preallocated size with unused data at the end.
+ *
+ * Set to 0 to disable.
+ *
+ * @unit MB
+ * @min 0
+ * @max 1024
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_PREALLOC, 0);
+
+/**
+ * Reduce logging rate under backpressure
+ *
+ * If enabled, the logging rate of low-priority topics (such as estimator innovations or the
+ * low-rate raw sensor data) is temporarily reduced when the log buffer fills up because the
+ * storage cannot keep up, so that dropouts of the remaining data are avoided.
+ * The reduction is released again once the writer caught up.
+ *
+ * @boolean
+ * @group SD Logging
+ */
+PARAM_DEFINE_INT32(SDLOG_THROTTLE, 1);
@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "pre_trigger_buffer.h"
+#include "messages.h"
+
+#include <string.h>
+
+namespace px4
+{
+namespace logger
+{
+
+PreTriggerBuffer::~PreTriggerBuffer()
+{
+	delete[](_buffer);
+}
+
+bool PreTriggerBuffer::allocate(size_t size)
+{
+	delete[](_buffer);
+	_buffer = new uint8_t[size];
+	_size = _buffer ? size : 0;
+	_dropped = 0;
+	reset();
+	return _buffer != nullptr;
+}
+
+void PreTriggerBuffer::read(size_t offset, uint8_t *dst, size_t len) const
+{
+	size_t start = (_tail + offset) % _size;
+	size_t first = _size - start;
+
+	if (first >= len) {
+		memcpy(dst, _buffer + start, len);
+
+	} else {
+		memcpy(dst, _buffer + start, first);
+		memcpy(dst + first, _buffer, len - first);
+	}
+}
+
+size_t PreTriggerBuffer::next_size() const
+{
+	if (_count < ULOG_MSG_HEADER_LEN) {
+		return 0;
+	}
+
+	uint8_t msg_size[2];
+	read(0, msg_size, sizeof(msg_size));
+	return (msg_size[0] | (msg_size[1] << 8)) + ULOG_MSG_HEADER_LEN;
+}
+
+hrt_abstime PreTriggerBuffer::next_timestamp() const
+{
+	// all uORB topics start with the timestamp
+	hrt_abstime timestamp;
+	read(sizeof(ulog_message_data_header_s), (uint8_t *)&timestamp, sizeof(timestamp));
+	return timestamp;
+}
+
+void PreTriggerBuffer::drop_oldest()
+{
+	size_t msg_size = next_size();
+	_tail = (_tail + msg_size) % _size;
+	_count -= msg_size;
+	++_dropped;
+}
+
+bool PreTriggerBuffer::push(const uint8_t *msg, size_t msg_size)
+{
+	if (msg_size > _size) {
+		return false;
+	}
+
+	while (_size - _count < msg_size) {
+		drop_oldest();
+	}
+
+	size_t head = (_tail + _count) % _size;
+	size_t first = _size - head;
+
+	if (first >= msg_size) {
+		memcpy(_buffer + head, msg, msg_size);
+
+	} else {
+		memcpy(_buffer + head, msg, first);
+		memcpy(_buffer, msg + first, msg_size - first);
+	}
+
+	_count += msg_size;
+	return true;
+}
+
+size_t PreTriggerBuffer::pop(uint8_t *buf, size_t buf_size)
+{
+	size_t msg_size = next_size();
+
+	if (msg_size == 0 || msg_size > buf_size) {
+		return 0;
+	}
+
+	read(0, buf, msg_size);
+	_tail = (_tail + msg_size) % _size;
+	_count -= msg_size;
+	return msg_size;
+}
+
+} //namespace logger
+} //namespace px4
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+
+namespace px4
+{
+namespace logger
+{
+
+/**
+ * @class PreTriggerBuffer
+ * RAM ring of complete ULog data messages for the topics that are only logged around trigger events.
+ * When full, the oldest messages are dropped, so the buffer always contains the most recent data.
+ * Only used from the logger thread (no locking).
+ */
+class PreTriggerBuffer
+{
+public:
+	PreTriggerBuffer() = default;
+	~PreTriggerBuffer();
+
+	/**
+	 * allocate the buffer (discards any existing content)
+	 * @return true on success
+	 */
+	bool allocate(size_t size);
+
+	bool valid() const { return _buffer != nullptr; }
+
+	/**
+	 * store a ULog data message (header included), dropping the oldest messages if needed
+	 * @return false if the message is larger than the buffer
+	 */
+	bool push(const uint8_t *msg, size_t msg_size);
+
+	/**
+	 * @return size of the oldest message (header included), or 0 if empty
+	 */
+	size_t next_size() const;
+
+	/**
+	 * @return timestamp of the oldest message (must not be empty)
+	 */
+	hrt_abstime next_timestamp() const;
+
+	/**
+	 * remove the oldest message and copy it to buf
+	 * @return message size, or 0 if empty or buf is too small
+	 */
+	size_t pop(uint8_t *buf, size_t buf_size);
+
+	void reset() { _tail = 0; _count = 0; }
+
+	size_t size() const { return _size; }
+	size_t count() const { return _count; }
+	size_t dropped() const { return _dropped; }
+
+private:
+	void read(size_t offset, uint8_t *dst, size_t len) const;
+	void drop_oldest();
+
+	uint8_t *_buffer{nullptr};
+	size_t _size{0};
+	size_t _tail{0};	///< start of the oldest message
+	size_t _count{0};	///< number of used bytes
+	size_t _dropped{0};	///< number of messages dropped because the buffer was full
+};
+
+} //namespace logger
+} //namespace px4
@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file ulog_delta.h
+ * Delta encoding for ULog data messages (ULogMessageType::DATA_DELTA).
+ *
+ * A sample is encoded against the previous sample of the same msg_id as a sequence of tokens:
+ * - 0x80 | (n - 1): n (1..128) bytes unchanged from the previous sample
+ * - 0x00 | (n - 1): n (1..128) literal bytes follow
+ *
+ * Slowly changing fields (timestamps, counters, mostly constant flags and the high bytes of floats)
+ * become short runs of unchanged bytes, typically reducing high-rate topics to a fraction of their size.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+static constexpr uint8_t ULOG_DELTA_UNCHANGED_FLAG = 0x80;
+static constexpr size_t ULOG_DELTA_MAX_RUN = 128;
+
+/**
+ * Encode a sample against the previous one.
+ * @param data current sample
+ * @param prev previous sample (same size)
+ * @param size sample size in bytes
+ * @param out output buffer
+ * @param out_size output buffer size
+ * @return encoded size, 0 if the encoding does not fit into out_size (write the raw sample instead)
+ */
+static inline size_t ulog_delta_encode(const uint8_t *data, const uint8_t *prev, size_t size, uint8_t *out,
+				       size_t out_size)
+{
+	size_t in = 0;
+	size_t n_out = 0;
+
+	while (in < size) {
+		// unchanged run
+		size_t run = 0;
+
+		while ((in + run < size) && (run < ULOG_DELTA_MAX_RUN) && (data[in + run] == prev[in + run])) {
+			run++;
+		}
+
+		// a single unchanged byte within changed data is cheaper as a literal
+		if (run >= 2 || (run == 1 && in + run == size)) {
+			if (n_out + 1 > out_size) {
+				return 0;
+			}
+
+			out[n_out++] = ULOG_DELTA_UNCHANGED_FLAG | (uint8_t)(run - 1);
+			in += run;
+			continue;
+		}
+
+		// literal run, until the next unchanged run of at least 2 bytes
+		size_t literal = 0;
+
+		while ((in + literal < size) && (literal < ULOG_DELTA_MAX_RUN)) {
+			if ((in + literal + 1 < size) && (data[in + literal] == prev[in + literal])
+			    && (data[in + literal + 1] == prev[in + literal + 1])) {
+				break;
+			}
+
+			literal++;
+		}
+
+		if (n_out + 1 + literal > out_size) {
+			return 0;
+		}
+
+		out[n_out++] = (uint8_t)(literal - 1);
+		memcpy(&out[n_out], &data[in], literal);
+		n_out += literal;
+		in += literal;
+	}
+
+	return n_out;
+}
+
+/**
+ * Decode a sample in place.
+ * @param in encoded data
+ * @param in_size encoded size
+ * @param data previous sample, replaced with the decoded sample
+ * @param size sample size in bytes
+ * @return true if the encoded data is valid and covers exactly size bytes
+ */
+static inline bool ulog_delta_decode(const uint8_t *in, size_t in_size, uint8_t *data, size_t size)
+{
+	size_t pos = 0;
+	size_t i = 0;
+
+	while (i < in_size) {
+		const uint8_t token = in[i++];
+		const size_t n = (token & ~ULOG_DELTA_UNCHANGED_FLAG) + 1;
+
+		if (pos + n > size) {
+			return false;
+		}
+
+		if (!(token & ULOG_DELTA_UNCHANGED_FLAG)) {
+			if (i + n > in_size) {
+				return false;
+			}
+
+			memcpy(&data[pos], &in[i], n);
+			i += n;
+		}
+
+		pos += n;
+	}
+
+	return pos == size;
+}
@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * Test code for the ULog delta encoding
+ * Run this test only using make tests TESTFILTER=ulog_delta
+ */
+
+#include <gtest/gtest.h>
+
+#include "ulog_delta.h"
+
+static constexpr size_t SIZE = 300; // more than two runs of ULOG_DELTA_MAX_RUN
+
+class ULogDeltaTest : public ::testing::Test
+{
+public:
+	void SetUp() override
+	{
+		for (size_t i = 0; i < SIZE; i++) {
+			prev[i] = (uint8_t)i;
+			data[i] = prev[i];
+		}
+	}
+
+	// encode data against prev, decode it into a copy of prev and compare with data
+	size_t roundTrip(size_t size)
+	{
+		const size_t encoded_size = ulog_delta_encode(data, prev, size, encoded, sizeof(encoded));
+		EXPECT_GT(encoded_size, 0u);
+
+		uint8_t decoded[SIZE];
+		memcpy(decoded, prev, size);
+		EXPECT_TRUE(ulog_delta_decode(encoded, encoded_size, decoded, size));
+		EXPECT_EQ(memcmp(decoded, data, size), 0);
+
+		return encoded_size;
+	}
+
+	uint8_t prev[SIZE];
+	uint8_t data[SIZE];
+	uint8_t encoded[2 * SIZE];
+};
+
+TEST_F(ULogDeltaTest, unchangedRunLimits)
+{
+	// 128 + 128 + 44 unchanged bytes
+	EXPECT_EQ(roundTrip(SIZE), 3u);
+	EXPECT_EQ(encoded[0], ULOG_DELTA_UNCHANGED_FLAG | 127);
+	EXPECT_EQ(encoded[1], ULOG_DELTA_UNCHANGED_FLAG | 127);
+	EXPECT_EQ(encoded[2], ULOG_DELTA_UNCHANGED_FLAG | 43);
+
+	// exactly one maximum run
+	EXPECT_EQ(roundTrip(ULOG_DELTA_MAX_RUN), 1u);
+	EXPECT_EQ(encoded[0], ULOG_DELTA_UNCHANGED_FLAG | 127);
+}
+
+TEST_F(ULogDeltaTest, literalRunLimits)
+{
+	for (size_t i = 0; i < SIZE; i++) {
+		data[i] = ~prev[i];
+	}
+
+	// 128 + 128 + 44 literal bytes, each run with its token
+	EXPECT_EQ(roundTrip(SIZE), SIZE + 3);
+	EXPECT_EQ(encoded[0], 127);
+	EXPECT_EQ(encoded[1 + 128], 127);
+	EXPECT_EQ(encoded[2 + 256], 43);
+
+	EXPECT_EQ(roundTrip(ULOG_DELTA_MAX_RUN), ULOG_DELTA_MAX_RUN + 1);
+	EXPECT_EQ(encoded[0], 127);
+}
+
+TEST_F(ULogDeltaTest, singleUnchangedByte)
+{
+	// a single unchanged byte between changed ones stays in the literal run
+	data[0] = ~prev[0];
+	data[2] = ~prev[2];
+
+	EXPECT_EQ(roundTrip(3), 4u);
+	EXPECT_EQ(encoded[0], 2);
+	EXPECT_EQ(encoded[2], prev[1]);
+
+	// a sample of a single changed or unchanged byte
+	EXPECT_EQ(roundTrip(1), 2u);
+	data[0] = prev[0];
+	EXPECT_EQ(roundTrip(1), 1u);
+	EXPECT_EQ(encoded[0], ULOG_DELTA_UNCHANGED_FLAG);
+}
+
+TEST_F(ULogDeltaTest, unchangedTail)
+{
+	data[0] = ~prev[0];
+	data[1] = ~prev[1];
+
+	// literal run of 2, then 10 unchanged bytes
+	EXPECT_EQ(roundTrip(12), 4u);
+	EXPECT_EQ(encoded[0], 1);
+	EXPECT_EQ(encoded[3], ULOG_DELTA_UNCHANGED_FLAG | 9);
+
+	// an unchanged run directly at the end of a literal run
+	data[3] = ~prev[3];
+	EXPECT_EQ(roundTrip(6), 6u);
+	EXPECT_EQ(encoded[0], 3);
+	EXPECT_EQ(encoded[5], ULOG_DELTA_UNCHANGED_FLAG | 1);
+}
+
+TEST_F(ULogDeltaTest, outSizeOverflow)
+{
+	data[0] = ~prev[0];
+	data[1] = ~prev[1];
+
+	// literal run of 2 and unchanged run of 10 need 4 bytes
+	EXPECT_EQ(ulog_delta_encode(data, prev, 12, encoded, 4), 4u);
+	EXPECT_EQ(ulog_delta_encode(data, prev, 12, encoded, 3), 0u); // no room for the unchanged token
+	EXPECT_EQ(ulog_delta_encode(data, prev, 12, encoded, 2), 0u); // literal run doesn't fit
+	EXPECT_EQ(ulog_delta_encode(data, prev, 12, encoded, 0), 0u);
+
+	// unchanged only
+	EXPECT_EQ(ulog_delta_encode(prev, prev, SIZE, encoded, 2), 0u);
+}
+
+TEST_F(ULogDeltaTest, decodeInvalid)
+{
+	data[0] = ~prev[0];
+	data[1] = ~prev[1];
+	const size_t encoded_size = ulog_delta_encode(data, prev, 12, encoded, sizeof(encoded));
+	ASSERT_EQ(encoded_size, 4u);
+
+	uint8_t decoded[SIZE];
+
+	// truncated: the unchanged token is missing, the sample is not covered
+	memcpy(decoded, prev, 12);
+	EXPECT_FALSE(ulog_delta_decode(encoded, encoded_size - 1, decoded, 12));
+
+	// truncated within the literal run
+	memcpy(decoded, prev, 12);
+	EXPECT_FALSE(ulog_delta_decode(encoded, 2, decoded, 12));
+
+	// over-long: one more token than the sample size
+	encoded[encoded_size] = ULOG_DELTA_UNCHANGED_FLAG;
+	memcpy(decoded, prev, 12);
+	EXPECT_FALSE(ulog_delta_decode(encoded, encoded_size + 1, decoded, 12));
+
+	// a run exceeding the sample size
+	memcpy(decoded, prev, 12);
+	EXPECT_FALSE(ulog_delta_decode(encoded, encoded_size, decoded, 11));
+
+	// empty input doesn't cover a non-empty sample
+	EXPECT_FALSE(ulog_delta_decode(encoded, 0, decoded, 12));
+}
@@ -65,9 +65,28 @@ MavlinkCommandSender::~MavlinkCommandSender()
 	px4_sem_destroy(&_lock);
 }
 
+void MavlinkCommandSender::update_next_timeout()
+{
+	uint32_t num_pending = 0;
+	hrt_abstime oldest_sent = 0;
+
+	_commands.reset_to_start();
+
+	while (command_item_t *item = _commands.get_next()) {
+		if (num_pending == 0 || item->last_time_sent_us < oldest_sent) {
+			oldest_sent = item->last_time_sent_us;
+		}
+
+		num_pending++;
+	}
+
+	// the deadline is published before the count, check_timeout() reads them in reverse order
+	_next_timeout_ms.store((uint32_t)((oldest_sent + TIMEOUT_US) / 1000));
+	_num_pending.store(num_pending);
+}
+
 int MavlinkCommandSender::handle_vehicle_command(const struct vehicle_command_s &command, mavlink_channel_t channel)
 {
-	lock();
 	CMD_DEBUG("new command: %d (channel: %d)", command.command, channel);
 
 	mavlink_command_long_t msg = {};
@@ -82,8 +101,12 @@ int MavlinkCommandSender::handle_vehicle_command(const struct vehicle_command_s
 	msg.param5 = command.param5;
 	msg.param6 = command.param6;
 	msg.param7 = command.param7;
+
+	// the channel has its own send lock, don't hold up the other instances while writing
 	mavlink_msg_command_long_send_struct(channel, &msg);
 
+	lock();
+
 	bool already_existing = false;
 	_commands.reset_to_start();
 
@@ -107,6 +130,8 @@ int MavlinkCommandSender::handle_vehicle_command(const struct vehicle_command_s
 		_commands.put(new_item);
 	}
 
+	update_next_timeout();
+
 	unlock();
 	return 0;
 }
@@ -136,12 +161,27 @@ void MavlinkCommandSender::handle_mavlink_command_ack(const mavlink_command_ack_
 
 void MavlinkCommandSender::check_timeout(mavlink_channel_t channel)
 {
+	if (_num_pending.load() == 0) {
+		return;
+	}
+
+	if ((int32_t)((uint32_t)(hrt_absolute_time() / 1000) - _next_timeout_ms.load()) < 0) {
+		// nothing due yet
+		return;
+	}
+
+	// retransmissions are sent after releasing the lock
+	mavlink_command_long_t retransmit[COMMAND_QUEUE_SIZE];
+	int num_retransmit = 0;
+
 	lock();
 
+	const hrt_abstime now = hrt_absolute_time();
+
 	_commands.reset_to_start();
 
 	while (command_item_t *item = _commands.get_next()) {
-		if (hrt_elapsed_time(&item->last_time_sent_us) <= TIMEOUT_US) {
+		if (now - item->last_time_sent_us <= TIMEOUT_US) {
 			// We keep waiting for the timeout.
 			continue;
 		}
@@ -190,7 +230,7 @@ void MavlinkCommandSender::check_timeout(mavlink_channel_t channel)
 		if (item->num_sent_per_channel[channel] < max_sent && item->num_sent_per_channel[channel] != -1) {
 			// We are behind and need to do a retransmission.
 			item->command.confirmation = ++item->num_sent_per_channel[channel];
-			mavlink_msg_command_long_send_struct(channel, &item->command);
+			retransmit[num_retransmit++] = item->command;
 
 			CMD_DEBUG("command %d sent (not first, retries: %d/%d, channel: %d)",
 				  item->command.command,
@@ -211,9 +251,9 @@ void MavlinkCommandSender::check_timeout(mavlink_channel_t channel)
 
 			// We are the first of a new retransmission series.
 			item->command.confirmation = ++item->num_sent_per_channel[channel];
-			mavlink_msg_command_long_send_struct(channel, &item->command);
+			retransmit[num_retransmit++] = item->command;
 			// Therefore, we are the ones setting the timestamp of this retry round.
-			item->last_time_sent_us = hrt_absolute_time();
+			item->last_time_sent_us = now;
 
 			CMD_DEBUG("command %d sent (first, retries: %d/%d, channel: %d)",
 				  item->command.command,
@@ -228,5 +268,11 @@ void MavlinkCommandSender::check_timeout(mavlink_channel_t channel)
 		}
 	}
 
+	update_next_timeout();
+
 	unlock();
+
+	for (int i = 0; i < num_retransmit; i++) {
+		mavlink_msg_command_long_send_struct(channel, &retransmit[i]);
+	}
 }
@@ -40,6 +40,7 @@
 
 #pragma once
 
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/sem.h>
 #include <drivers/drv_hrt.h>
@@ -73,6 +74,8 @@ public:
 
 	/**
 	 * Check timeouts to verify if an commands need retransmission.
+	 * This is called by every instance in every loop, so it returns without
+	 * taking the lock as long as no command is pending or due.
 	 * thread-safe
 	 */
 	void check_timeout(mavlink_channel_t channel);
@@ -99,6 +102,11 @@ private:
 		px4_sem_post(&_lock);
 	}
 
+	/**
+	 * Update _num_pending and _next_timeout_ms from the queue, must be called with the lock held.
+	 */
+	void update_next_timeout();
+
 	static MavlinkCommandSender *_instance;
 	static px4_sem_t _lock;
 
@@ -112,7 +120,13 @@ private:
 		int8_t num_sent_per_channel[MAX_MAVLINK_CHANNEL] = {-1, -1, -1, -1}; // -1: channel did not request this command to be sent, -2: channel got an ack for this command
 	} command_item_t;
 
-	TimestampedList<command_item_t> _commands{3};
+	static constexpr int COMMAND_QUEUE_SIZE = 3;
+
+	TimestampedList<command_item_t> _commands{COMMAND_QUEUE_SIZE};
+
+	// written with the lock held, read without it by check_timeout()
+	px4::atomic<uint32_t> _num_pending{0};
+	px4::atomic<uint32_t> _next_timeout_ms{0}; ///< earliest point in time when a queued command times out [ms]
 
 	bool _debug_enabled = false;
 	static constexpr uint8_t RETRIES = 3;
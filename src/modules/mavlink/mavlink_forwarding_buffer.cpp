@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_forwarding_buffer.cpp
+ * Shared buffer for the messages forwarded between mavlink instances.
+ */
+
+#include "mavlink_forwarding_buffer.h"
+
+MavlinkForwardingBuffer &MavlinkForwardingBuffer::instance()
+{
+	static MavlinkForwardingBuffer forwarding_buffer;
+	return forwarding_buffer;
+}
+
+MavlinkForwardingBuffer::MavlinkForwardingBuffer()
+{
+	pthread_mutex_init(&_mutex, nullptr);
+}
+
+MavlinkForwardingBuffer::~MavlinkForwardingBuffer()
+{
+	delete[] _slots;
+	pthread_mutex_destroy(&_mutex);
+}
+
+int MavlinkForwardingBuffer::allocate(const mavlink_message_t *msg, int num_references)
+{
+	if (num_references <= 0) {
+		return -1;
+	}
+
+	int slot = -1;
+
+	// references only drop to 0 outside of the lock, so a free slot found here stays free
+	pthread_mutex_lock(&_mutex);
+
+	if (_slots == nullptr) {
+		_slots = new Slot[NUM_SLOTS];
+	}
+
+	if (_slots != nullptr) {
+		for (int i = 0; i < NUM_SLOTS; ++i) {
+			if (_slots[i].references.load() == 0) {
+				_slots[i].references.store(num_references);
+				slot = i;
+				break;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&_mutex);
+
+	if (slot >= 0) {
+		// serialize once, without changing the sequence number and CRC (like a resend)
+		_slots[slot].length = mavlink_msg_to_send_buffer(_slots[slot].data, msg);
+	}
+
+	return slot;
+}
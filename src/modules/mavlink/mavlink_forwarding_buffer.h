@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_forwarding_buffer.h
+ * Shared buffer for the messages forwarded between mavlink instances.
+ */
+
+#pragma once
+
+#include "mavlink_bridge_header.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <px4_platform_common/atomic.h>
+
+/**
+ * @class MavlinkForwardingBuffer
+ * A pool of serialized messages shared by all mavlink instances: a forwarded message is serialized once
+ * into a slot, and every target instance only queues the slot index and sends the data from there.
+ * A slot is reference counted (one reference per target) and can be reused once all targets sent it.
+ */
+class MavlinkForwardingBuffer
+{
+public:
+#if defined(__PX4_NUTTX)
+	static constexpr int NUM_SLOTS = 8;
+#else
+	static constexpr int NUM_SLOTS = 32;
+#endif
+
+	static MavlinkForwardingBuffer &instance();
+
+	/**
+	 * Serialize a message into a free slot
+	 * @param num_references number of targets that will release the slot
+	 * @return slot index, or -1 if no slot is available
+	 */
+	int allocate(const mavlink_message_t *msg, int num_references);
+
+	/**
+	 * Release a reference to a slot (after sending it or if it could not be queued)
+	 */
+	void release(int slot) { _slots[slot].references.fetch_sub(1); }
+
+	const uint8_t *data(int slot) const { return _slots[slot].data; }
+	uint16_t length(int slot) const { return _slots[slot].length; }
+
+private:
+	MavlinkForwardingBuffer();
+	~MavlinkForwardingBuffer();
+
+	struct Slot {
+		px4::atomic<int> references{0};
+		uint16_t length{0};
+		uint8_t data[MAVLINK_MAX_PACKET_LEN];
+	};
+
+	Slot *_slots{nullptr}; ///< allocated on first use, so that there is no overhead without forwarding
+	pthread_mutex_t _mutex;
+};
@@ -42,6 +42,8 @@
 #include <errno.h>
 #include <cstring>
 
+#include <parameters/param.h>
+
 #include "mavlink_ftp.h"
 #include "mavlink_tests/mavlink_ftp_test.h"
 
@@ -57,12 +59,18 @@ constexpr const char MavlinkFTP::_root_dir[];
 MavlinkFTP::MavlinkFTP(Mavlink *mavlink) :
 	_mavlink(mavlink)
 {
-	// initialize session
-	_session_info.fd = -1;
+	// initialize sessions
+	for (SessionInfo &session : _sessions) {
+		session.fd = -1;
+	}
 }
 
 MavlinkFTP::~MavlinkFTP()
 {
+	for (SessionInfo &session : _sessions) {
+		_closeSession(session);
+	}
+
 	delete[] _work_buffer1;
 	delete[] _work_buffer2;
 }
@@ -70,12 +78,13 @@ MavlinkFTP::~MavlinkFTP()
 unsigned
 MavlinkFTP::get_size()
 {
-	if (_session_info.stream_download) {
-		return MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
-
-	} else {
-		return 0;
+	for (const SessionInfo &session : _sessions) {
+		if (session.stream_download) {
+			return MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+		}
 	}
+
+	return 0;
 }
 
 #ifdef MAVLINK_FTP_UNIT_TEST
@@ -499,13 +508,35 @@ MavlinkFTP::_workList(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 {
-	if (_session_info.fd >= 0) {
+	int session_index = -1;
+
+	for (int i = 0; i < kMaxSessions; i++) {
+		if (_sessions[i].fd < 0) {
+			session_index = i;
+			break;
+		}
+	}
+
+	if (session_index < 0) {
 		PX4_ERR("FTP: Open failed - out of sessions\n");
 		return kErrNoSessionsAvailable;
 	}
 
-	strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
-	strncpy(_work_buffer1 + _root_dir_len, _data_as_cstring(payload), _work_buffer1_len - _root_dir_len);
+	const char *path = _data_as_cstring(payload);
+
+	if (strncmp(path, kParamPackedFile, strlen(kParamPackedFile)) == 0 && (oflag & (O_WRONLY | O_RDWR)) == 0) {
+		// virtual file: snapshot the parameters into a temporary file that is then read like any other file
+		if (_writePackedParams(kParamPackedTmpFile) != 0) {
+			return kErrFailErrno;
+		}
+
+		strncpy(_work_buffer1, kParamPackedTmpFile, _work_buffer1_len);
+		_work_buffer1[_work_buffer1_len - 1] = '\0';
+
+	} else {
+		strncpy(_work_buffer1, _root_dir, _work_buffer1_len);
+		strncpy(_work_buffer1 + _root_dir_len, path, _work_buffer1_len - _root_dir_len);
+	}
 
 #ifdef MAVLINK_FTP_DEBUG
 	PX4_INFO("FTP: open '%s'", _work_buffer1);
@@ -533,22 +564,198 @@ MavlinkFTP::_workOpen(PayloadHeader *payload, int oflag)
 		return kErrFailErrno;
 	}
 
-	_session_info.fd = fd;
-	_session_info.file_size = fileSize;
-	_session_info.stream_download = false;
+	SessionInfo &session = _sessions[session_index];
+	session.fd = fd;
+	session.file_size = fileSize;
+	session.stream_download = false;
+	session.read_buffer_len = 0;
 
-	payload->session = 0;
+	payload->session = session_index;
 	payload->size = sizeof(uint32_t);
 	std::memcpy(payload->data, &fileSize, payload->size);
 
 	return kErrNone;
 }
 
+MavlinkFTP::SessionInfo *
+MavlinkFTP::_getSession(PayloadHeader *payload)
+{
+	if (payload->session >= kMaxSessions || _sessions[payload->session].fd < 0) {
+		return nullptr;
+	}
+
+	return &_sessions[payload->session];
+}
+
+void
+MavlinkFTP::_closeSession(SessionInfo &session)
+{
+	if (session.fd >= 0) {
+		::close(session.fd);
+		session.fd = -1;
+	}
+
+	session.stream_download = false;
+
+	delete[] session.read_buffer;
+	session.read_buffer = nullptr;
+	session.read_buffer_len = 0;
+}
+
+int
+MavlinkFTP::_readSession(SessionInfo &session, uint32_t offset, uint8_t *dst, unsigned len)
+{
+	if (session.read_buffer == nullptr) {
+		if (lseek(session.fd, offset, SEEK_SET) < 0) {
+			return -1;
+		}
+
+		return ::read(session.fd, dst, len);
+	}
+
+	const uint32_t buffer_end = session.read_buffer_offset + session.read_buffer_len;
+
+	// refill if the offset is outside of the buffer, or if the request is cut off at its end and it's not EOF
+	if (offset < session.read_buffer_offset || offset >= buffer_end
+	    || (offset + len > buffer_end && session.read_buffer_len == kReadAheadSize)) {
+
+		if (lseek(session.fd, offset, SEEK_SET) < 0) {
+			session.read_buffer_len = 0;
+			return -1;
+		}
+
+		int bytes_read = ::read(session.fd, session.read_buffer, kReadAheadSize);
+
+		if (bytes_read < 0) {
+			session.read_buffer_len = 0;
+			return -1;
+		}
+
+		session.read_buffer_offset = offset;
+		session.read_buffer_len = bytes_read;
+	}
+
+	const uint32_t available = session.read_buffer_offset + session.read_buffer_len - offset;
+	const unsigned bytes_copied = (len < available) ? len : available;
+	memcpy(dst, &session.read_buffer[offset - session.read_buffer_offset], bytes_copied);
+
+	return bytes_copied;
+}
+
+/// @brief Writes all used parameters to path in the packed format of @PARAM/param.pck.
+///
+/// The file starts with a header {uint16 magic, uint16 num_params, uint16 total_params}, followed by one
+/// entry per parameter: {uint8 type | flags << 4, uint8 common_len | (name_len - 1) << 4, name, value}.
+/// The names are sorted, so only the part that differs from the previous name (after common_len
+/// characters) is stored. This is the format used by other autopilots, so ground stations can
+/// fetch all parameters in a single FTP download instead of one PARAM_VALUE per parameter.
+int
+MavlinkFTP::_writePackedParams(const char *path)
+{
+	int fd = ::open(path, O_CREAT | O_TRUNC | O_WRONLY, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		return -1;
+	}
+
+	uint8_t *buf = reinterpret_cast<uint8_t *>(_work_buffer2);
+	unsigned buf_pos = sizeof(ParamPackedHeader);
+	bool ok = true;
+
+	const unsigned param_count = param_count_used();
+	uint16_t num_params = 0;
+	char last_name[kParamPackedMaxNameLen + 1] {};
+
+	for (unsigned i = 0; i < param_count && ok; i++) {
+		param_t param = param_for_used_index(i);
+
+		if (param == PARAM_INVALID) {
+			continue;
+		}
+
+		const char *name = param_name(param);
+		unsigned name_len = strlen(name);
+
+		if (name_len > kParamPackedMaxNameLen) {
+			name_len = kParamPackedMaxNameLen;
+		}
+
+		uint8_t type;
+
+		if (param_type(param) == PARAM_TYPE_INT32) {
+			type = kParamPackedTypeInt32;
+
+		} else if (param_type(param) == PARAM_TYPE_FLOAT) {
+			type = kParamPackedTypeFloat;
+
+		} else {
+			continue;
+		}
+
+		union {
+			int32_t i;
+			float f;
+		} value;
+
+		if (param_get(param, &value) != PX4_OK) {
+			continue;
+		}
+
+		// common prefix with the previous name: at most 15 characters, and at least one character must remain
+		unsigned common_len = 0;
+
+		while (common_len < 15 && common_len + 1 < name_len && name[common_len] == last_name[common_len]) {
+			common_len++;
+		}
+
+		const unsigned entry_len = 2 + (name_len - common_len) + sizeof(value);
+
+		if (buf_pos + entry_len > (unsigned)_work_buffer2_len) {
+			ok = ::write(fd, buf, buf_pos) == (ssize_t)buf_pos;
+			buf_pos = 0;
+		}
+
+		buf[buf_pos++] = type;
+		buf[buf_pos++] = common_len | ((name_len - common_len - 1) << 4);
+		memcpy(&buf[buf_pos], &name[common_len], name_len - common_len);
+		buf_pos += name_len - common_len;
+		memcpy(&buf[buf_pos], &value, sizeof(value));
+		buf_pos += sizeof(value);
+
+		strncpy(last_name, name, kParamPackedMaxNameLen);
+		last_name[kParamPackedMaxNameLen] = '\0';
+		num_params++;
+	}
+
+	if (ok && buf_pos > 0) {
+		ok = ::write(fd, buf, buf_pos) == (ssize_t)buf_pos;
+	}
+
+	// the header goes in last, once the number of parameters written is known
+	ParamPackedHeader header{kParamPackedMagic, num_params, num_params};
+
+	if (ok) {
+		ok = lseek(fd, 0, SEEK_SET) == 0 && ::write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header);
+	}
+
+	int r_errno = errno;
+	::close(fd);
+
+	if (!ok) {
+		errno = r_errno;
+		return -1;
+	}
+
+	return 0;
+}
+
 /// @brief Responds to a Read command
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workRead(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
@@ -557,17 +764,12 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 #endif
 
 	// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-	if (payload->offset >= _session_info.file_size) {
+	if (payload->offset >= session->file_size) {
 		PX4_ERR("request past EOF");
 		return kErrEOF;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-		PX4_ERR("seek fail");
-		return kErrFailErrno;
-	}
-
-	int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+	int bytes_read = _readSession(*session, payload->offset, &payload->data[0], kMaxDataLength);
 
 	if (bytes_read < 0) {
 		// Negative return indicates error other than eof
@@ -584,20 +786,39 @@ MavlinkFTP::_workRead(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t target_component_id)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
 #ifdef MAVLINK_FTP_DEBUG
-	PX4_INFO("FTP: burst offset:%d", payload->offset);
+	PX4_INFO("FTP: burst session:%d offset:%d", payload->session, payload->offset);
 #endif
+
+	// read ahead from the file in large blocks instead of seeking and reading for every packet
+	if (session->read_buffer == nullptr) {
+		session->read_buffer = new uint8_t[kReadAheadSize];
+		session->read_buffer_len = 0;
+	}
+
+	param_t param_burst = param_find("MAV_FTP_BURST");
+
+	if (param_burst != PARAM_INVALID) {
+		int32_t burst_window_kb = 0;
+
+		if (param_get(param_burst, &burst_window_kb) == PX4_OK && burst_window_kb > 0) {
+			_burst_window = burst_window_kb * 1024;
+		}
+	}
+
 	// Setup for streaming sends
-	_session_info.stream_download = true;
-	_session_info.stream_offset = payload->offset;
-	_session_info.stream_chunk_transmitted = 0;
-	_session_info.stream_seq_number = payload->seq_number + 1;
-	_session_info.stream_target_system_id = target_system_id;
-	_session_info.stream_target_component_id = target_component_id;
+	session->stream_download = true;
+	session->stream_offset = payload->offset;
+	session->stream_chunk_transmitted = 0;
+	session->stream_seq_number = payload->seq_number + 1;
+	session->stream_target_system_id = target_system_id;
+	session->stream_target_component_id = target_component_id;
 
 	return kErrNone;
 }
@@ -606,17 +827,22 @@ MavlinkFTP::_workBurst(PayloadHeader *payload, uint8_t target_system_id, uint8_t
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workWrite(PayloadHeader *payload)
 {
-	if (payload->session != 0 && _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
-	if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
+	if (lseek(session->fd, payload->offset, SEEK_SET) < 0) {
 		// Unable to see to the specified location
 		PX4_ERR("seek fail");
 		return kErrFailErrno;
 	}
 
-	int bytes_written = ::write(_session_info.fd, &payload->data[0], payload->size);
+	// the read-ahead buffer is stale once the file is modified
+	session->read_buffer_len = 0;
+
+	int bytes_written = ::write(session->fd, &payload->data[0], payload->size);
 
 	if (bytes_written < 0) {
 		// Negative return indicates error other than eof
@@ -746,13 +972,13 @@ MavlinkFTP::_workTruncateFile(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workTerminate(PayloadHeader *payload)
 {
-	if (payload->session != 0 || _session_info.fd < 0) {
+	SessionInfo *session = _getSession(payload);
+
+	if (session == nullptr) {
 		return kErrInvalidSession;
 	}
 
-	::close(_session_info.fd);
-	_session_info.fd = -1;
-	_session_info.stream_download = false;
+	_closeSession(*session);
 
 	payload->size = 0;
 
@@ -763,10 +989,8 @@ MavlinkFTP::_workTerminate(PayloadHeader *payload)
 MavlinkFTP::ErrorCode
 MavlinkFTP::_workReset(PayloadHeader *payload)
 {
-	if (_session_info.fd != -1) {
-		::close(_session_info.fd);
-		_session_info.fd = -1;
-		_session_info.stream_download = false;
+	for (SessionInfo &session : _sessions) {
+		_closeSession(session);
 	}
 
 	payload->size = 0;
@@ -974,7 +1198,7 @@ void MavlinkFTP::send(const hrt_abstime t)
 	}
 
 	// Anything to stream?
-	if (!_session_info.stream_download) {
+	if (get_size() == 0) {
 		return;
 	}
 
@@ -989,106 +1213,134 @@ void MavlinkFTP::send(const hrt_abstime t)
 		return;
 	}
 
+#else
+	unsigned max_bytes_to_send = 0;
 #endif
 
-	// Send stream packets until buffer is full
+	// Send stream packets until buffer is full, interleaving the packets of all sessions with an active burst
 
 	bool more_data;
 
 	do {
 		more_data = false;
 
-		ErrorCode error_code = kErrNone;
+		for (int i = 0; i < kMaxSessions; i++) {
+			SessionInfo &session = _sessions[(_stream_session_next + i) % kMaxSessions];
 
-		mavlink_file_transfer_protocol_t ftp_msg;
-		PayloadHeader *payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
+			if (session.stream_download && _sendBurstPacket(session, max_bytes_to_send)) {
+				more_data = true;
+			}
+		}
 
-		payload->seq_number = _session_info.stream_seq_number;
-		payload->session = 0;
-		payload->opcode = kRspAck;
-		payload->req_opcode = kCmdBurstReadFile;
-		payload->offset = _session_info.stream_offset;
-		_session_info.stream_seq_number++;
+	} while (more_data);
+
+	// the next send() starts with another session so a single session can't take the whole buffer
+	_stream_session_next = (_stream_session_next + 1) % kMaxSessions;
+}
+
+bool
+MavlinkFTP::_sendBurstPacket(SessionInfo &session, unsigned &max_bytes_to_send)
+{
+	const unsigned packet_size = MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+
+#ifndef MAVLINK_FTP_UNIT_TEST
+
+	if (max_bytes_to_send < packet_size) {
+		return false;
+	}
 
-#ifdef MAVLINK_FTP_DEBUG
-		PX4_INFO("stream send: offset %d", _session_info.stream_offset);
 #endif
 
-		// We have to test seek past EOF ourselves, lseek will allow seek past EOF
-		if (_session_info.stream_offset >= _session_info.file_size) {
-			error_code = kErrEOF;
+	bool more_data = false;
+
+	ErrorCode error_code = kErrNone;
+
+	mavlink_file_transfer_protocol_t ftp_msg;
+	PayloadHeader *payload = reinterpret_cast<PayloadHeader *>(&ftp_msg.payload[0]);
+
+	payload->seq_number = session.stream_seq_number;
+	payload->session = &session - &_sessions[0];
+	payload->opcode = kRspAck;
+	payload->req_opcode = kCmdBurstReadFile;
+	payload->offset = session.stream_offset;
+	session.stream_seq_number++;
+
 #ifdef MAVLINK_FTP_DEBUG
-			PX4_INFO("stream download: sending Nak EOF");
+	PX4_INFO("stream send: offset %d", session.stream_offset);
 #endif
-		}
 
-		if (error_code == kErrNone) {
-			if (lseek(_session_info.fd, payload->offset, SEEK_SET) < 0) {
-				error_code = kErrFailErrno;
+	// We have to test seek past EOF ourselves, lseek will allow seek past EOF
+	if (session.stream_offset >= session.file_size) {
+		error_code = kErrEOF;
 #ifdef MAVLINK_FTP_DEBUG
-				PX4_WARN("stream download: seek fail");
+		PX4_INFO("stream download: sending Nak EOF");
 #endif
-			}
-		}
+	}
 
-		if (error_code == kErrNone) {
-			int bytes_read = ::read(_session_info.fd, &payload->data[0], kMaxDataLength);
+	if (error_code == kErrNone) {
+		int bytes_read = _readSession(session, payload->offset, &payload->data[0], kMaxDataLength);
 
-			if (bytes_read < 0) {
-				// Negative return indicates error other than eof
-				error_code = kErrFailErrno;
+		if (bytes_read < 0) {
+			// Negative return indicates error other than eof
+			error_code = kErrFailErrno;
 #ifdef MAVLINK_FTP_DEBUG
-				PX4_WARN("stream download: read fail");
+			PX4_WARN("stream download: read fail");
 #endif
 
-			} else {
-				payload->size = bytes_read;
-				_session_info.stream_offset += bytes_read;
-				_session_info.stream_chunk_transmitted += bytes_read;
-			}
+		} else {
+			payload->size = bytes_read;
+			session.stream_offset += bytes_read;
+			session.stream_chunk_transmitted += bytes_read;
 		}
+	}
 
-		if (error_code != kErrNone) {
-			payload->opcode = kRspNak;
-			payload->size = 1;
-			uint8_t *pData = &payload->data[0];
-			*pData = error_code; // Straight reference to data[0] is causing bogus gcc array subscript error
+	if (error_code != kErrNone) {
+		payload->opcode = kRspNak;
+		payload->size = 1;
+		uint8_t *pData = &payload->data[0];
+		*pData = error_code; // Straight reference to data[0] is causing bogus gcc array subscript error
 
-			if (error_code == kErrFailErrno) {
-				int r_errno = errno;
-				payload->size = 2;
-				payload->data[1] = r_errno;
-			}
+		if (error_code == kErrFailErrno) {
+			int r_errno = errno;
+			payload->size = 2;
+			payload->data[1] = r_errno;
+		}
 
-			_session_info.stream_download = false;
+		session.stream_download = false;
 
-		} else {
+	} else {
 #ifndef MAVLINK_FTP_UNIT_TEST
 
-			if (max_bytes_to_send < (get_size() * 2)) {
-				more_data = false;
+		if (max_bytes_to_send < (packet_size * 2)) {
+			more_data = false;
 
-				/* perform transfers in 35K chunks - this is determined empirical */
-				if (_session_info.stream_chunk_transmitted > 35000) {
-					payload->burst_complete = true;
-					_session_info.stream_download = false;
-					_session_info.stream_chunk_transmitted = 0;
-				}
+			/* perform transfers in chunks of the burst window (MAV_FTP_BURST) */
+			if (session.stream_chunk_transmitted > (unsigned)_burst_window) {
+				payload->burst_complete = true;
+				session.stream_download = false;
+				session.stream_chunk_transmitted = 0;
+			}
 
-			} else {
+		} else {
 #endif
-				more_data = true;
-				payload->burst_complete = false;
+			more_data = true;
+			payload->burst_complete = false;
 #ifndef MAVLINK_FTP_UNIT_TEST
-				max_bytes_to_send -= get_size();
-			}
+		}
 
 #endif
-		}
+	}
 
-		ftp_msg.target_system = _session_info.stream_target_system_id;
-		ftp_msg.target_network = 0;
-		ftp_msg.target_component = _session_info.stream_target_component_id;
-		_reply(&ftp_msg);
-	} while (more_data);
+#ifndef MAVLINK_FTP_UNIT_TEST
+	max_bytes_to_send -= packet_size;
+#else
+	(void)packet_size;
+#endif
+
+	ftp_msg.target_system = session.stream_target_system_id;
+	ftp_msg.target_network = 0;
+	ftp_msg.target_component = session.stream_target_component_id;
+	_reply(&ftp_msg);
+
+	return more_data;
 }
@@ -151,6 +151,8 @@ private:
 	ErrorCode	_workRename(PayloadHeader *payload);
 	ErrorCode	_workCalcFileCRC32(PayloadHeader *payload);
 
+	int		_writePackedParams(const char *path);
+
 	uint8_t _getServerSystemId(void);
 	uint8_t _getServerComponentId(void);
 	uint8_t _getServerChannel(void);
@@ -165,9 +167,31 @@ private:
 	static const char	kDirentDir = 'D';	///< Identifies Directory returned from List command
 	static const char	kDirentSkip = 'S';	///< Identifies Skipped entry from List command
 
+	/// Virtual file containing all parameters, the snapshot is written to kParamPackedTmpFile on open
+	static constexpr const char *kParamPackedFile = "@PARAM/param.pck";
+	static constexpr const char *kParamPackedTmpFile = PX4_STORAGEDIR "/.param.pck";
+	static constexpr uint16_t kParamPackedMagic = 0x671b;
+	static constexpr uint8_t kParamPackedTypeInt32 = 3;
+	static constexpr uint8_t kParamPackedTypeFloat = 4;
+	static constexpr unsigned kParamPackedMaxNameLen = 16;
+
+	struct __attribute__((__packed__)) ParamPackedHeader {
+		uint16_t magic;
+		uint16_t num_params;
+		uint16_t total_params;
+	};
+
 	/// @brief Maximum data size in RequestHeader::data
 	static const uint8_t	kMaxDataLength = MAVLINK_MSG_FILE_TRANSFER_PROTOCOL_FIELD_PAYLOAD_LEN - sizeof(PayloadHeader);
 
+#if defined(__PX4_NUTTX)
+	static constexpr int kMaxSessions = 2;		///< Maximum number of concurrently open files
+	static constexpr unsigned kReadAheadSize = 2048;	///< Size of the per session read-ahead buffer for burst reads
+#else
+	static constexpr int kMaxSessions = 4;
+	static constexpr unsigned kReadAheadSize = 16384;
+#endif
+
 	struct SessionInfo {
 		int		fd;
 		uint32_t	file_size;
@@ -177,8 +201,33 @@ private:
 		uint8_t		stream_target_system_id;
 		uint8_t         stream_target_component_id;
 		unsigned	stream_chunk_transmitted;
+		uint8_t		*read_buffer;		///< read-ahead buffer, allocated when a burst starts
+		uint32_t	read_buffer_offset;	///< file offset of read_buffer[0]
+		uint32_t	read_buffer_len;	///< number of valid bytes in read_buffer
 	};
-	struct SessionInfo _session_info {};	///< Session info, fd=-1 for no active session
+	struct SessionInfo _sessions[kMaxSessions] {};	///< Session info, fd=-1 for no active session
+	int _stream_session_next{0};			///< session served first in the next send(), to interleave bursts
+
+	int32_t _burst_window{35000};			///< Number of bytes sent per burst before it is completed, see MAV_FTP_BURST
+
+	/**
+	 * @return session addressed by the request, nullptr if the session is invalid or not open
+	 */
+	SessionInfo *_getSession(PayloadHeader *payload);
+
+	void _closeSession(SessionInfo &session);
+
+	/**
+	 * Read from a session at the given offset, through its read-ahead buffer if allocated
+	 * @return number of bytes read, -1 on failure (errno set)
+	 */
+	int _readSession(SessionInfo &session, uint32_t offset, uint8_t *dst, unsigned len);
+
+	/**
+	 * Send the next burst packet of a session
+	 * @return true if the session can send more data in this iteration
+	 */
+	bool _sendBurstPacket(SessionInfo &session, unsigned &max_bytes_to_send);
 
 	ReceiveMessageFunc_t	_utRcvMsgFunc{};	///< Unit test override for mavlink message sending
 	void			*_worker_data{nullptr};	///< Additional parameter to _utRcvMsgFunc;
@@ -68,12 +68,12 @@ public:
 		return MavlinkStreamHighLatency2::get_name_static();
 	}
 
-	static const char *get_name_static()
+	static constexpr const char *get_name_static()
 	{
 		return "HIGH_LATENCY2";
 	}
 
-	static uint16_t get_id_static()
+	static constexpr uint16_t get_id_static()
 	{
 		return MAVLINK_MSG_ID_HIGH_LATENCY2;
 	}
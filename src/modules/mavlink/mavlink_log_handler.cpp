@@ -148,7 +148,7 @@ MavlinkLogHandler::_log_request_list(const mavlink_message_t *msg)
 		//-- Is this a new request?
 		if ((request.end - request.start) > _log_count) {
 			_current_status = LogHandlerState::Inactive;
-			_close_and_unlink_files();
+			_close_files();
 
 		} else {
 			_current_status = LogHandlerState::Idle;
@@ -157,10 +157,17 @@ MavlinkLogHandler::_log_request_list(const mavlink_message_t *msg)
 	}
 
 	if (_current_status == LogHandlerState::Inactive) {
-		//-- Prepare new request
+		//-- Prepare new request, only rescan the logs if they changed since the last list
+
+		const uint32_t signature = _get_list_signature();
+
+		if (!_list_cached || signature != _list_signature) {
+			_reset_list_helper();
+			_init_list_helper();
+			_list_signature = signature;
+			_list_cached = true;
+		}
 
-		_reset_list_helper();
-		_init_list_helper();
 		_current_status = LogHandlerState::Idle;
 	}
 
@@ -215,6 +222,9 @@ MavlinkLogHandler::_log_request_data(const mavlink_message_t *msg)
 			return;
 		}
 
+		// the list might be cached, get the current size (the log might still be written)
+		stat_file(_current_log_filename, nullptr, &_current_log_size);
+
 		_open_for_transmit();
 	}
 
@@ -257,7 +267,7 @@ MavlinkLogHandler::_log_request_end(const mavlink_message_t * /*msg*/)
 	PX4LOG_WARN("MavlinkLogHandler::_log_request_end");
 
 	_current_status = LogHandlerState::Inactive;
-	_close_and_unlink_files();
+	_close_files();
 }
 
 //-------------------------------------------------------------------
@@ -320,16 +330,37 @@ MavlinkLogHandler::_log_send_data()
 }
 
 //-------------------------------------------------------------------
-void MavlinkLogHandler::_close_and_unlink_files()
+void MavlinkLogHandler::_close_files()
 {
 	if (_current_log_filep) {
 		::fclose(_current_log_filep);
-		_reset_list_helper();
+		_current_log_filep = nullptr;
+	}
+
+	if (_list_filep) {
+		::fclose(_list_filep);
+		_list_filep = nullptr;
 	}
 
+	delete[] _read_buffer;
+	_read_buffer = nullptr;
+	_read_buffer_len = 0;
+
+	_current_log_index = UINT16_MAX;
+	_current_log_data_offset = 0;
+	_current_log_data_remaining = 0;
+}
+
+//-------------------------------------------------------------------
+void MavlinkLogHandler::_close_and_unlink_files()
+{
+	_close_files();
+	_reset_list_helper();
+
 	// Remove log data files (if any)
 	unlink(kLogData);
 	unlink(kTmpData);
+	_list_cached = false;
 }
 
 //-------------------------------------------------------------------
@@ -339,36 +370,49 @@ MavlinkLogHandler::_get_entry(int idx, uint32_t &size, uint32_t &date, char *fil
 	//-- Find log file in log list file created during init()
 	size = 0;
 	date = 0;
-	bool result = false;
-	//-- Open list of log files
-	FILE *f = ::fopen(kLogData, "r");
-
-	if (f) {
-		//--- Find requested entry
-		char line[160];
-		int count = 0;
-
-		while (fgets(line, sizeof(line), f)) {
-			//-- Found our "index"
-			if (count++ == idx) {
-				char file[160];
-
-				if (sscanf(line, "%u %u %s", &date, &size, file) == 3) {
-					if (filename && filename_len > 0) {
-						strncpy(filename, file, filename_len);
-						filename[filename_len - 1] = 0; // ensure null-termination
-					}
 
-					result = true;
-					break;
+	//-- The list file is kept open and read sequentially, so listing all entries doesn't
+	//   rescan the file from the start for every entry. Only reopen it to go backwards.
+	if (_list_filep && idx < _list_file_entry) {
+		::fclose(_list_filep);
+		_list_filep = nullptr;
+	}
+
+	if (!_list_filep) {
+		//-- Open list of log files
+		_list_filep = ::fopen(kLogData, "r");
+		_list_file_entry = 0;
+
+		if (!_list_filep) {
+			return false;
+		}
+	}
+
+	//--- Find requested entry
+	char line[160];
+
+	while (fgets(line, sizeof(line), _list_filep)) {
+		//-- Found our "index"
+		if (_list_file_entry++ == idx) {
+			char file[160];
+
+			if (sscanf(line, "%u %u %s", &date, &size, file) == 3) {
+				if (filename && filename_len > 0) {
+					strncpy(filename, file, filename_len);
+					filename[filename_len - 1] = 0; // ensure null-termination
 				}
+
+				return true;
 			}
-		}
 
-		fclose(f);
+			return false;
+		}
 	}
 
-	return result;
+	::fclose(_list_filep);
+	_list_filep = nullptr;
+
+	return false;
 }
 
 //-------------------------------------------------------------------
@@ -381,6 +425,7 @@ MavlinkLogHandler::_open_for_transmit()
 	}
 
 	_current_log_filep = ::fopen(_current_log_filename, "rb");
+	_read_buffer_len = 0;
 
 	if (!_current_log_filep) {
 		PX4LOG_WARN("MavlinkLogHandler::open_for_transmit Could not open %s", _current_log_filename);
@@ -403,16 +448,42 @@ MavlinkLogHandler::_get_log_data(uint8_t len, uint8_t *buffer)
 		return 0;
 	}
 
-	long int offset = _current_log_data_offset - ftell(_current_log_filep);
+	if (!_read_buffer) {
+		_read_buffer = new uint8_t[READ_AHEAD_SIZE];
+		_read_buffer_len = 0;
 
-	if (offset && fseek(_current_log_filep, offset, SEEK_CUR)) {
-		fclose(_current_log_filep);
-		_current_log_filep = nullptr;
-		PX4LOG_WARN("MavlinkLogHandler::get_log_data Seek error in %s", _current_log_filename);
+		if (!_read_buffer) {
+			return 0;
+		}
+	}
+
+	//-- Refill the read-ahead buffer if the requested data is not (completely) in it
+	if (_current_log_data_offset < _read_buffer_offset
+	    || _current_log_data_offset + len > _read_buffer_offset + _read_buffer_len) {
+
+		if (fseek(_current_log_filep, _current_log_data_offset, SEEK_SET)) {
+			fclose(_current_log_filep);
+			_current_log_filep = nullptr;
+			_read_buffer_len = 0;
+			PX4LOG_WARN("MavlinkLogHandler::get_log_data Seek error in %s", _current_log_filename);
+			return 0;
+		}
+
+		_read_buffer_offset = _current_log_data_offset;
+		_read_buffer_len = fread(_read_buffer, 1, READ_AHEAD_SIZE, _current_log_filep);
+	}
+
+	if (_current_log_data_offset >= _read_buffer_offset + _read_buffer_len) {
 		return 0;
 	}
 
-	size_t result = fread(buffer, 1, len, _current_log_filep);
+	size_t result = _read_buffer_offset + _read_buffer_len - _current_log_data_offset;
+
+	if (result > len) {
+		result = len;
+	}
+
+	memcpy(buffer, &_read_buffer[_current_log_data_offset - _read_buffer_offset], result);
 	return result;
 }
 
@@ -427,7 +498,6 @@ MavlinkLogHandler::_reset_list_helper()
 	_current_log_size = 0;
 	_current_log_data_offset = 0;
 	_current_log_data_remaining = 0;
-	_current_log_filep = nullptr;
 }
 
 void
@@ -442,6 +512,11 @@ MavlinkLogHandler::_init_list_helper()
 
 	_current_log_filename[0] = 0;
 
+	if (_list_filep) {
+		::fclose(_list_filep);
+		_list_filep = nullptr;
+	}
+
 	// Remove old log data file (if any)
 	unlink(kLogData);
 	// Open log directory
@@ -489,6 +564,60 @@ MavlinkLogHandler::_init_list_helper()
 	}
 }
 
+//-------------------------------------------------------------------
+static uint32_t
+hash_name(uint32_t hash, const char *name)
+{
+	// FNV-1a
+	while (*name) {
+		hash = (hash ^ (uint8_t)*name++) * 16777619u;
+	}
+
+	return (hash ^ '/') * 16777619u;
+}
+
+uint32_t
+MavlinkLogHandler::_get_list_signature()
+{
+	uint32_t hash = 2166136261u;
+
+	DIR *dp = opendir(kLogRoot);
+
+	if (dp == nullptr) {
+		return hash;
+	}
+
+	struct dirent *result = nullptr;
+
+	while ((result = readdir(dp))) {
+		if (result->d_type == PX4LOG_DIRECTORY && result->d_name[0] != '.') {
+			hash = hash_name(hash, result->d_name);
+
+			char log_path[128];
+			int ret = snprintf(log_path, sizeof(log_path), "%s/%s", kLogRoot, result->d_name);
+			bool path_is_ok = (ret > 0) && (ret < (int)sizeof(log_path));
+
+			DIR *session_dp = path_is_ok ? opendir(log_path) : nullptr;
+
+			if (session_dp) {
+				struct dirent *session_result = nullptr;
+
+				while ((session_result = readdir(session_dp))) {
+					if (session_result->d_type == PX4LOG_REGULAR_FILE) {
+						hash = hash_name(hash, session_result->d_name);
+					}
+				}
+
+				closedir(session_dp);
+			}
+		}
+	}
+
+	closedir(dp);
+
+	return hash;
+}
+
 //-------------------------------------------------------------------
 bool
 MavlinkLogHandler::_get_session_date(const char *path, const char *dir, time_t &date)
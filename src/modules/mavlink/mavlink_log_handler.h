@@ -79,6 +79,12 @@ private:
 
 	void _reset_list_helper();
 	void _init_list_helper();
+
+	/**
+	 * Hash over the names of all session directories and log files. This only reads the directories
+	 * (no stat() per file), and is used to decide if the cached log list is still valid.
+	 */
+	static uint32_t _get_list_signature();
 	bool _get_session_date(const char *path, const char *dir, time_t &date);
 	void _scan_logs(FILE *f, const char *dir, time_t &date);
 	bool _get_log_time_size(const char *path, const char *file, time_t &date, uint32_t &size);
@@ -86,6 +92,7 @@ private:
 	bool _get_entry(int idx, uint32_t &size, uint32_t &date, char *filename = 0, int filename_len = 0);
 	bool _open_for_transmit();
 	size_t _get_log_data(uint8_t len, uint8_t *buffer);
+	void _close_files();
 	void _close_and_unlink_files();
 
 	size_t _log_send_listing();
@@ -104,4 +111,19 @@ private:
 	uint32_t    _current_log_data_remaining{0};
 	FILE       *_current_log_filep{nullptr};
 	char        _current_log_filename[128]; //TODO: consider to allocate on runtime
+
+	FILE       *_list_filep{nullptr};        ///< open list file, read sequentially while listing
+	int         _list_file_entry{0};         ///< index of the next entry in _list_filep
+	bool        _list_cached{false};         ///< list file exists and matches _list_signature
+	uint32_t    _list_signature{0};
+
+	// log data is read in large blocks instead of one fseek/fread per LOG_DATA message
+#if defined(__PX4_NUTTX)
+	static constexpr uint32_t READ_AHEAD_SIZE = 4096;
+#else
+	static constexpr uint32_t READ_AHEAD_SIZE = 65536;
+#endif
+	uint8_t    *_read_buffer{nullptr};
+	uint32_t    _read_buffer_offset{0};      ///< log file offset of _read_buffer[0]
+	uint32_t    _read_buffer_len{0};         ///< number of valid bytes in _read_buffer
 };
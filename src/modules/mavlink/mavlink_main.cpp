@@ -447,40 +447,69 @@ Mavlink::serial_instance_exists(const char *device_name, Mavlink *self)
 void
 Mavlink::forward_message(const mavlink_message_t *msg, Mavlink *self)
 {
+	const mavlink_msg_entry_t *meta = mavlink_get_msg_entry(msg->msgid);
+
+	int target_system_id = 0;
+	int target_component_id = 0;
+
+	// might be nullptr if message is unknown
+	if (meta) {
+		// Extract target system and target component if set
+		if (meta->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM) {
+			target_system_id = (_MAV_PAYLOAD(msg))[meta->target_system_ofs];
+		}
+
+		if (meta->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT) {
+			target_component_id = (_MAV_PAYLOAD(msg))[meta->target_component_ofs];
+		}
+	}
+
+	// If it's a message only for us, we keep it, otherwise, we forward it.
+	const bool targeted_only_at_us =
+		(target_system_id == self->get_system_id() &&
+		 target_component_id == self->get_component_id());
+
+	// We don't forward heartbeats unless it's specifically enabled.
+	const bool heartbeat_check_ok =
+		(msg->msgid != MAVLINK_MSG_ID_HEARTBEAT || self->forward_heartbeats_enabled());
+
+	if (targeted_only_at_us || !heartbeat_check_ok) {
+		return;
+	}
+
 	Mavlink *inst;
-	LL_FOREACH(_mavlink_instances, inst) {
-		if (inst != self) {
-			const mavlink_msg_entry_t *meta = mavlink_get_msg_entry(msg->msgid);
+	int num_targets = 0;
 
-			int target_system_id = 0;
-			int target_component_id = 0;
+	LL_FOREACH(_mavlink_instances, inst) {
+		if (inst != self && inst->get_forwarding_on()) {
+			++num_targets;
+		}
+	}
 
-			// might be nullptr if message is unknown
-			if (meta) {
-				// Extract target system and target component if set
-				if (meta->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_SYSTEM) {
-					target_system_id = (_MAV_PAYLOAD(msg))[meta->target_system_ofs];
-				}
+	// serialize once, all targets send it from the same buffer
+	MavlinkForwardingBuffer &forwarding_buffer = MavlinkForwardingBuffer::instance();
+	const int slot = forwarding_buffer.allocate(msg, num_targets);
 
-				if (meta->flags & MAV_MSG_ENTRY_FLAG_HAVE_TARGET_COMPONENT) {
-					target_component_id = (_MAV_PAYLOAD(msg))[meta->target_component_ofs];
-				}
-			}
+	if (slot < 0) {
+		return;
+	}
 
-			// If it's a message only for us, we keep it, otherwise, we forward it.
-			const bool targeted_only_at_us =
-				(target_system_id == self->get_system_id() &&
-				 target_component_id == self->get_component_id());
+	int num_passed = 0;
 
-			// We don't forward heartbeats unless it's specifically enabled.
-			const bool heartbeat_check_ok =
-				(msg->msgid != MAVLINK_MSG_ID_HEARTBEAT || self->forward_heartbeats_enabled());
+	LL_FOREACH(_mavlink_instances, inst) {
+		if (inst != self && inst->get_forwarding_on() && num_passed < num_targets) {
+			++num_passed;
 
-			if (!targeted_only_at_us && heartbeat_check_ok) {
-				inst->pass_message(msg);
+			if (!inst->pass_message(slot)) {
+				forwarding_buffer.release(slot);
 			}
 		}
 	}
+
+	// in case an instance went away in the meantime
+	for (; num_passed < num_targets; ++num_passed) {
+		forwarding_buffer.release(slot);
+	}
 }
 
 int
@@ -814,39 +843,14 @@ void Mavlink::send_finish()
 #if defined(MAVLINK_UDP)
 
 	else if (get_protocol() == Protocol::UDP) {
+		// the packet is sent with the next flush_udp_tx(). It is counted as sent already
+		// (and corrected if sending fails), so that the stream data rate accounting works
+		udp_tx_append();
+		count_txbytes(_buf_fill);
 
-# if defined(CONFIG_NET)
-
-		if (_src_addr_initialized) {
-# endif // CONFIG_NET
-			ret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_src_addr, sizeof(_src_addr));
-# if defined(CONFIG_NET)
-		}
-
-# endif // CONFIG_NET
-
-		if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
-		    (!get_client_source_initialized() || (hrt_elapsed_time(&_tstatus.heartbeat_time) > 3_s))) {
-
-			if (!_broadcast_address_found) {
-				find_broadcast_address();
-			}
-
-			if (_broadcast_address_found && _buf_fill > 0) {
-
-				int bret = sendto(_socket_fd, _buf, _buf_fill, 0, (struct sockaddr *)&_bcast_addr, sizeof(_bcast_addr));
-
-				if (bret <= 0) {
-					if (!_broadcast_failed_warned) {
-						PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
-						_broadcast_failed_warned = true;
-					}
-
-				} else {
-					_broadcast_failed_warned = false;
-				}
-			}
-		}
+		_buf_fill = 0;
+		pthread_mutex_unlock(&_send_mutex);
+		return;
 	}
 
 #endif // MAVLINK_UDP
@@ -878,6 +882,145 @@ void Mavlink::send_bytes(const uint8_t *buf, unsigned packet_len)
 }
 
 #ifdef MAVLINK_UDP
+void Mavlink::udp_tx_append()
+{
+	if (_udp_tx_count == 0 || _udp_tx_len[_udp_tx_count - 1] + _buf_fill > UDP_TX_DATAGRAM_SIZE) {
+		if (_udp_tx_count == UDP_TX_MAX_DATAGRAMS) {
+			udp_tx_send();
+		}
+
+		_udp_tx_len[_udp_tx_count++] = 0;
+	}
+
+	memcpy(&_udp_tx_buf[_udp_tx_count - 1][_udp_tx_len[_udp_tx_count - 1]], _buf, _buf_fill);
+	_udp_tx_len[_udp_tx_count - 1] += _buf_fill;
+}
+
+void Mavlink::flush_udp_tx()
+{
+	pthread_mutex_lock(&_send_mutex);
+	udp_tx_send();
+	pthread_mutex_unlock(&_send_mutex);
+}
+
+void Mavlink::udp_tx_send()
+{
+	if (_udp_tx_count == 0) {
+		return;
+	}
+
+	// destinations: the client and the broadcast address (if enabled)
+	const sockaddr_in *destinations[2] {};
+	int num_destinations = 0;
+
+# if defined(CONFIG_NET)
+
+	if (_src_addr_initialized)
+# endif // CONFIG_NET
+	{
+		destinations[num_destinations++] = &_src_addr;
+	}
+
+	const int num_client_destinations = num_destinations;
+
+	if ((_mode != MAVLINK_MODE_ONBOARD) && broadcast_enabled() &&
+	    (!get_client_source_initialized() || (hrt_elapsed_time(&_tstatus.heartbeat_time) > 3_s))) {
+
+		if (!_broadcast_address_found) {
+			find_broadcast_address();
+		}
+
+		if (_broadcast_address_found) {
+			destinations[num_destinations++] = &_bcast_addr;
+		}
+	}
+
+	size_t client_bytes_failed = 0;
+	bool broadcast_failed = false;
+
+#if defined(__PX4_LINUX)
+	mmsghdr msgs[UDP_TX_MAX_DATAGRAMS * 2] {};
+	iovec iovecs[UDP_TX_MAX_DATAGRAMS] {};
+	int num_msgs = 0;
+
+	for (int i = 0; i < _udp_tx_count; ++i) {
+		iovecs[i].iov_base = _udp_tx_buf[i];
+		iovecs[i].iov_len = _udp_tx_len[i];
+	}
+
+	for (int d = 0; d < num_destinations; ++d) {
+		for (int i = 0; i < _udp_tx_count; ++i) {
+			msgs[num_msgs].msg_hdr.msg_name = (void *)destinations[d];
+			msgs[num_msgs].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			msgs[num_msgs].msg_hdr.msg_iov = &iovecs[i];
+			msgs[num_msgs].msg_hdr.msg_iovlen = 1;
+			++num_msgs;
+		}
+	}
+
+	int sent = num_msgs > 0 ? sendmmsg(_socket_fd, msgs, num_msgs, 0) : 0;
+
+	if (sent < 0) {
+		sent = 0;
+	}
+
+	for (int m = sent; m < num_msgs; ++m) {
+		if (m < num_client_destinations * _udp_tx_count) {
+			client_bytes_failed += msgs[m].msg_hdr.msg_iov->iov_len;
+
+		} else {
+			broadcast_failed = true;
+		}
+	}
+
+#else
+
+	for (int d = 0; d < num_destinations; ++d) {
+		for (int i = 0; i < _udp_tx_count; ++i) {
+			int ret = sendto(_socket_fd, _udp_tx_buf[i], _udp_tx_len[i], 0, (struct sockaddr *)destinations[d],
+					 sizeof(sockaddr_in));
+
+			if (ret != (int)_udp_tx_len[i]) {
+				if (d < num_client_destinations) {
+					client_bytes_failed += _udp_tx_len[i];
+
+				} else {
+					broadcast_failed = true;
+				}
+			}
+		}
+	}
+
+#endif
+
+	if (num_client_destinations == 0) {
+		// nowhere to send to (yet)
+		for (int i = 0; i < _udp_tx_count; ++i) {
+			client_bytes_failed += _udp_tx_len[i];
+		}
+	}
+
+	if (client_bytes_failed > 0) {
+		_bytes_tx -= math::min((unsigned)client_bytes_failed, _bytes_tx);
+		count_txerrbytes(client_bytes_failed);
+
+	} else {
+		_last_write_success_time = _last_write_try_time;
+	}
+
+	if (broadcast_failed) {
+		if (!_broadcast_failed_warned) {
+			PX4_ERR("sending broadcast failed, errno: %d: %s", errno, strerror(errno));
+			_broadcast_failed_warned = true;
+		}
+
+	} else if (num_destinations > num_client_destinations) {
+		_broadcast_failed_warned = false;
+	}
+
+	_udp_tx_count = 0;
+}
+
 void Mavlink::find_broadcast_address()
 {
 #if defined(__PX4_LINUX) || defined(__PX4_DARWIN) || defined(__PX4_CYGWIN)
@@ -1119,12 +1262,43 @@ Mavlink::handle_message(const mavlink_message_t *msg)
 	 *  NOTE: this is called from the receiver thread
 	 */
 
+	if (msg->msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+		if (_sign_control.handle_setup_signing(msg)) {
+			/* the key is shared by all links */
+			Mavlink *inst;
+			LL_FOREACH(::_mavlink_instances, inst) {
+				if (inst != this) {
+					inst->_sign_control.load_key();
+				}
+			}
+		}
+
+		/* never forward the secret key to other links */
+		return;
+	}
+
 	if (get_forwarding_on()) {
 		/* forward any messages to other mavlink instances */
 		Mavlink::forward_message(msg, this);
 	}
 }
 
+bool
+Mavlink::accept_unsigned(const mavlink_status_t *status, uint32_t message_id)
+{
+	/*
+	 *  NOTE: this is called by the parser from the receiver thread
+	 */
+	Mavlink *inst;
+	LL_FOREACH(::_mavlink_instances, inst) {
+		if (inst->get_status() == status) {
+			return inst->_sign_control.accept_unsigned(message_id);
+		}
+	}
+
+	return false;
+}
+
 void
 Mavlink::send_statustext_info(const char *string)
 {
@@ -1315,119 +1489,119 @@ Mavlink::configure_stream_threadsafe(const char *stream_name, const float rate)
 	}
 }
 
-int
-Mavlink::message_buffer_init(int size)
+bool
+Mavlink::pass_message(int slot)
 {
-	_message_buffer.size = size;
-	_message_buffer.write_ptr = 0;
-	_message_buffer.read_ptr = 0;
-	_message_buffer.data = (char *)malloc(_message_buffer.size);
+	if (!_forwarding_on) {
+		return false;
+	}
 
-	int ret;
+	bool queued = false;
 
-	if (_message_buffer.data == nullptr) {
-		ret = PX4_ERROR;
-		_message_buffer.size = 0;
+	pthread_mutex_lock(&_message_buffer_mutex);
 
-	} else {
-		ret = OK;
+	const int next_write = (_forward_queue_write + 1) % FORWARD_QUEUE_SIZE;
+
+	if (next_write != _forward_queue_read) {
+		_forward_queue[_forward_queue_write] = slot;
+		_forward_queue_write = next_write;
+		queued = true;
 	}
 
-	return ret;
+	pthread_mutex_unlock(&_message_buffer_mutex);
+
+	return queued;
 }
 
 void
-Mavlink::message_buffer_destroy()
+Mavlink::send_forwarded_messages()
 {
-	_message_buffer.size = 0;
-	_message_buffer.write_ptr = 0;
-	_message_buffer.read_ptr = 0;
-	free(_message_buffer.data);
-}
+	MavlinkForwardingBuffer &forwarding_buffer = MavlinkForwardingBuffer::instance();
 
-int
-Mavlink::message_buffer_count()
-{
-	int n = _message_buffer.write_ptr - _message_buffer.read_ptr;
+	while (true) {
+		pthread_mutex_lock(&_message_buffer_mutex);
+		const bool empty = _forward_queue_read == _forward_queue_write;
+		const int slot = _forward_queue[_forward_queue_read];
+		pthread_mutex_unlock(&_message_buffer_mutex);
 
-	if (n < 0) {
-		n += _message_buffer.size;
-	}
+		if (empty) {
+			break;
+		}
 
-	return n;
-}
+		const uint16_t length = forwarding_buffer.length(slot);
 
-bool
-Mavlink::message_buffer_write(const void *ptr, int size)
-{
-	// bytes available to write
-	int available = _message_buffer.read_ptr - _message_buffer.write_ptr - 1;
+		if (get_free_tx_buf() < length) {
+			// keep it for the next iteration
+			break;
+		}
 
-	if (available < 0) {
-		available += _message_buffer.size;
-	}
+		// send the already serialized message as is (like resend_message())
+		send_start(length);
+		send_bytes(forwarding_buffer.data(slot), length);
+		send_finish();
 
-	if (size > available) {
-		// buffer overflow
-		return false;
-	}
+		pthread_mutex_lock(&_message_buffer_mutex);
+		_forward_queue_read = (_forward_queue_read + 1) % FORWARD_QUEUE_SIZE;
+		pthread_mutex_unlock(&_message_buffer_mutex);
 
-	char *c = (char *) ptr;
-	int n = _message_buffer.size - _message_buffer.write_ptr;	// bytes to end of the buffer
+		forwarding_buffer.release(slot);
+	}
+}
 
-	if (n < size) {
-		// message goes over end of the buffer
-		memcpy(&(_message_buffer.data[_message_buffer.write_ptr]), c, n);
-		_message_buffer.write_ptr = 0;
+void
+Mavlink::clear_forwarded_messages()
+{
+	pthread_mutex_lock(&_message_buffer_mutex);
 
-	} else {
-		n = 0;
+	while (_forward_queue_read != _forward_queue_write) {
+		MavlinkForwardingBuffer::instance().release(_forward_queue[_forward_queue_read]);
+		_forward_queue_read = (_forward_queue_read + 1) % FORWARD_QUEUE_SIZE;
 	}
 
-	// now: n = bytes already written
-	int p = size - n;	// number of bytes to write
-	memcpy(&(_message_buffer.data[_message_buffer.write_ptr]), &(c[n]), p);
-	_message_buffer.write_ptr = (_message_buffer.write_ptr + p) % _message_buffer.size;
-	return true;
+	pthread_mutex_unlock(&_message_buffer_mutex);
 }
 
-int
-Mavlink::message_buffer_get_ptr(void **ptr, bool *is_part)
+void
+Mavlink::send_shell_output()
 {
-	// bytes available to read
-	int available = _message_buffer.write_ptr - _message_buffer.read_ptr;
+	static constexpr unsigned message_size = MAVLINK_MSG_ID_SERIAL_CONTROL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+	static constexpr size_t payload_size = sizeof(mavlink_serial_control_t::data);
 
-	if (available == 0) {
-		return 0;	// buffer is empty
-	}
+	// the shell may use up to half of the data rate, but always at least one message per iteration
+	const unsigned bytes_per_iteration = (unsigned)(((uint64_t)_datarate * _main_loop_delay) / 1000000 / 2);
+	const unsigned max_messages = math::max(bytes_per_iteration / message_size, 1u);
 
-	int n = 0;
+	const bool bulk_mode = _mavlink_shell->bulk_mode();
 
-	if (available > 0) {
-		// read pointer is before write pointer, all available bytes can be read
-		n = available;
-		*is_part = false;
+	for (unsigned i = 0; i < max_messages; i++) {
+		const size_t available = _mavlink_shell->available();
 
-	} else {
-		// read pointer is after write pointer, read bytes from read_ptr to end of the buffer
-		n = _message_buffer.size - _message_buffer.read_ptr;
-		*is_part = _message_buffer.write_ptr > 0;
-	}
+		if (available == 0) {
+			break;
+		}
 
-	*ptr = &(_message_buffer.data[_message_buffer.read_ptr]);
-	return n;
-}
+		// in bulk mode, wait for a full message as long as the shell is still writing
+		if (bulk_mode && available < payload_size && available != _mavlink_shell_available_prev) {
+			break;
+		}
 
-void
-Mavlink::pass_message(const mavlink_message_t *msg)
-{
-	if (_forwarding_on) {
-		/* size is 8 bytes plus variable payload */
-		int size = MAVLINK_NUM_NON_PAYLOAD_BYTES + msg->len;
-		pthread_mutex_lock(&_message_buffer_mutex);
-		message_buffer_write(msg, size);
-		pthread_mutex_unlock(&_message_buffer_mutex);
+		// the first message only needs space for itself, the others leave space for the streams
+		const unsigned free_tx_buf = get_free_tx_buf();
+
+		if (free_tx_buf < message_size || (i > 0 && free_tx_buf < 2 * message_size)) {
+			break;
+		}
+
+		mavlink_serial_control_t msg;
+		msg.baudrate = 0;
+		msg.flags = SERIAL_CONTROL_FLAG_REPLY;
+		msg.timeout = 0;
+		msg.device = SERIAL_CONTROL_DEV_SHELL;
+		msg.count = _mavlink_shell->read(msg.data, sizeof(msg.data));
+		mavlink_msg_serial_control_send_struct(get_channel(), &msg);
 	}
+
+	_mavlink_shell_available_prev = _mavlink_shell->available();
 }
 
 MavlinkShell *
@@ -1467,14 +1641,27 @@ Mavlink::update_rate_mult()
 {
 	float const_rate = 0.0f;
 	float rate = 0.0f;
+	float data_limited_rate = 0.0f;
 
 	/* scale down rates if their theoretical bandwidth is exceeding the link bandwidth */
 	for (const auto &stream : _streams) {
+		const float stream_rate = (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+
 		if (stream->const_rate()) {
-			const_rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			const_rate += stream_rate;
 
 		} else {
-			rate += (stream->get_interval() > 0) ? stream->get_size_avg() * 1000000.0f / stream->get_interval() : 0;
+			// A stream that sends clearly less than it is allowed to (e.g. because its topic updates slower or not
+			// at all) is limited by its data and not by the multiplier: reserve only what it actually sends, so
+			// that the remaining budget is redistributed to the other streams.
+			const float measured_rate = stream->get_datarate();
+
+			if (measured_rate >= 0.0f && measured_rate < 0.8f * _rate_mult * stream_rate) {
+				data_limited_rate += measured_rate;
+
+			} else {
+				rate += stream_rate;
+			}
 		}
 	}
 
@@ -1485,7 +1672,11 @@ Mavlink::update_rate_mult()
 	}
 
 	/* scale up and down as the link permits */
-	float bandwidth_mult = (float)(_datarate * mavlink_ulog_streaming_rate_inv - const_rate) / rate;
+	float bandwidth_mult = 1.0f;
+
+	if (rate > 0.0f) {
+		bandwidth_mult = (float)(_datarate * mavlink_ulog_streaming_rate_inv - const_rate - data_limited_rate) / rate;
+	}
 
 	/* if we do not have flow control, limit to the set data rate */
 	if (!get_flow_control_enabled()) {
@@ -1522,6 +1713,42 @@ Mavlink::update_rate_mult()
 	_rate_mult = math::constrain(_rate_mult, 0.05f, 1.0f);
 }
 
+void
+Mavlink::update_streams(const hrt_abstime &t)
+{
+	using Priority = MavlinkStream::Priority;
+
+	for (int prio = (int)Priority::High; prio <= (int)Priority::Low; ++prio) {
+		// first pass: the deferred (most overdue) streams, second pass: all others
+		for (int pass = 0; pass < 2; ++pass) {
+			for (const auto &stream : _streams) {
+				if ((int)stream->priority() != prio || stream->last_update() == t || (pass == 0 && !stream->deferred())) {
+					continue;
+				}
+
+				// only check the buffer for due messages, as this might require an ioctl
+				const bool can_send = (prio == (int)Priority::High) || !stream->due(t)
+						      || (get_free_tx_buf() >= stream->get_size());
+
+				stream->update(t, can_send);
+
+				if (!_first_heartbeat_sent) {
+					if (_mode == MAVLINK_MODE_IRIDIUM) {
+						if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
+							_first_heartbeat_sent = stream->first_message_sent();
+						}
+
+					} else {
+						if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
+							_first_heartbeat_sent = stream->first_message_sent();
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
 void
 Mavlink::update_radio_status(const radio_status_s &radio_status)
 {
@@ -2105,16 +2332,7 @@ Mavlink::task_main(int argc, char *argv[])
 
 	/* if we are passing on mavlink messages, we need to prepare a buffer for this instance */
 	if (_forwarding_on) {
-		/* initialize message buffer if multiplexing is on.
-		 * make space for two messages plus off-by-one space as we use the empty element
-		 * marker ring buffer approach.
-		 */
-		if (OK != message_buffer_init(2 * sizeof(mavlink_message_t) + 1)) {
-			PX4_ERR("msg buf alloc fail");
-			return 1;
-		}
-
-		/* initialize message buffer mutex */
+		/* initialize message buffer mutex (the forwarded messages are kept in MavlinkForwardingBuffer) */
 		pthread_mutex_init(&_message_buffer_mutex, nullptr);
 	}
 
@@ -2201,6 +2419,10 @@ Mavlink::task_main(int argc, char *argv[])
 
 #endif // MAVLINK_UDP
 
+	/* MAVLink 2 signing, before anything is sent */
+	_sign_control.start(_instance_id, get_status(), (MavlinkSignControl::SignMode)_param_mav_sign_cfg.get(),
+			    _is_usb_uart, &Mavlink::accept_unsigned);
+
 	/* if the protocol is serial, we send the system version blindly */
 	if (get_protocol() == Protocol::SERIAL) {
 		send_autopilot_capabilites();
@@ -2333,41 +2555,18 @@ Mavlink::task_main(int argc, char *argv[])
 		mavlink_log_s mavlink_log;
 
 		if (mavlink_log_sub.update(&mavlink_log)) {
-			_logbuffer.put(&mavlink_log);
+			_logbuffer.put(mavlink_log);
 		}
 
 		/* check for shell output */
-		if (_mavlink_shell && _mavlink_shell->available() > 0) {
-			if (get_free_tx_buf() >= MAVLINK_MSG_ID_SERIAL_CONTROL_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES) {
-				mavlink_serial_control_t msg;
-				msg.baudrate = 0;
-				msg.flags = SERIAL_CONTROL_FLAG_REPLY;
-				msg.timeout = 0;
-				msg.device = SERIAL_CONTROL_DEV_SHELL;
-				msg.count = _mavlink_shell->read(msg.data, sizeof(msg.data));
-				mavlink_msg_serial_control_send_struct(get_channel(), &msg);
-			}
+		if (_mavlink_shell) {
+			send_shell_output();
 		}
 
 		check_requested_subscriptions();
 
 		/* update streams */
-		for (const auto &stream : _streams) {
-			stream->update(t);
-
-			if (!_first_heartbeat_sent) {
-				if (_mode == MAVLINK_MODE_IRIDIUM) {
-					if (stream->get_id() == MAVLINK_MSG_ID_HIGH_LATENCY2) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-
-				} else {
-					if (stream->get_id() == MAVLINK_MSG_ID_HEARTBEAT) {
-						_first_heartbeat_sent = stream->first_message_sent();
-					}
-				}
-			}
-		}
+		update_streams(t);
 
 		/* check for ulog streaming messages */
 		if (_mavlink_ulog) {
@@ -2396,52 +2595,17 @@ Mavlink::task_main(int argc, char *argv[])
 
 		/* pass messages from other UARTs */
 		if (_forwarding_on) {
+			send_forwarded_messages();
+		}
 
-			bool is_part;
-			uint8_t *read_ptr;
-			uint8_t *write_ptr;
-
-			pthread_mutex_lock(&_message_buffer_mutex);
-			int available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-			pthread_mutex_unlock(&_message_buffer_mutex);
-
-			if (available > 0) {
-				// Reconstruct message from buffer
-
-				mavlink_message_t msg;
-				write_ptr = (uint8_t *)&msg;
-
-				// Pull a single message from the buffer
-				size_t read_count = available;
-
-				if (read_count > sizeof(mavlink_message_t)) {
-					read_count = sizeof(mavlink_message_t);
-				}
-
-				memcpy(write_ptr, read_ptr, read_count);
-
-				// We hold the mutex until after we complete the second part of the buffer. If we don't
-				// we may end up breaking the empty slot overflow detection semantics when we mark the
-				// possibly partial read below.
-				pthread_mutex_lock(&_message_buffer_mutex);
-
-				message_buffer_mark_read(read_count);
-
-				/* write second part of buffer if there is some */
-				if (is_part && read_count < sizeof(mavlink_message_t)) {
-					write_ptr += read_count;
-					available = message_buffer_get_ptr((void **)&read_ptr, &is_part);
-					read_count = sizeof(mavlink_message_t) - read_count;
-					memcpy(write_ptr, read_ptr, read_count);
-					message_buffer_mark_read(available);
-				}
-
-				pthread_mutex_unlock(&_message_buffer_mutex);
+#if defined(MAVLINK_UDP)
 
-				resend_message(&msg);
-			}
+		if (get_protocol() == Protocol::UDP) {
+			flush_udp_tx();
 		}
 
+#endif // MAVLINK_UDP
+
 		/* update TX/RX rates*/
 		if (t > _bytes_timestamp + 1000000) {
 			if (_bytes_timestamp != 0) {
@@ -2454,6 +2618,10 @@ Mavlink::task_main(int argc, char *argv[])
 				_bytes_tx = 0;
 				_bytes_txerr = 0;
 				_bytes_rx = 0;
+
+				for (const auto &stream : _streams) {
+					stream->update_datarate(dt / 1000.0f);
+				}
 			}
 
 			_bytes_timestamp = t;
@@ -2468,7 +2636,9 @@ Mavlink::task_main(int argc, char *argv[])
 	}
 
 	/* first wait for threads to complete before tearing down anything */
-	pthread_join(_receive_thread, nullptr);
+	MavlinkReceiver::receive_stop(_receive_thread, this);
+
+	_sign_control.stop();
 
 	delete _subscribe_to_stream;
 	_subscribe_to_stream = nullptr;
@@ -2487,7 +2657,7 @@ Mavlink::task_main(int argc, char *argv[])
 	}
 
 	if (_forwarding_on) {
-		message_buffer_destroy();
+		clear_forwarded_messages();
 		pthread_mutex_destroy(&_message_buffer_mutex);
 	}
 
@@ -2778,6 +2948,10 @@ Mavlink::display_status()
 	printf("\tmode: %s\n", mavlink_mode_str(_mode));
 	printf("\tMAVLink version: %i\n", _protocol_version);
 
+	if (_sign_control.enabled()) {
+		printf("\tsigning: %s\n", _sign_control.key_valid() ? "active" : "no key");
+	}
+
 	printf("\ttransport protocol: ");
 
 	switch (_protocol) {
@@ -2813,7 +2987,8 @@ Mavlink::display_status()
 void
 Mavlink::display_status_streams()
 {
-	printf("\t%-20s%-16s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]");
+	printf("\t%-20s%-16s %s %s %s %s %s\n", "Name", "Rate Config (current) [Hz]", "Message Size (if active) [B]",
+	       "Sent [B/s]", "Send time [us/s]", "Sent total [kB]", "Deferred");
 
 	const float rate_mult = _rate_mult;
 
@@ -2836,11 +3011,23 @@ Mavlink::display_status_streams()
 		printf("\t%-30s%-16s", stream->get_name(), rate_str);
 
 		if (size > 0) {
-			printf(" %3i\n", size);
+			printf(" %3i", size);
 
 		} else {
-			printf("\n");
+			printf("    ");
 		}
+
+		const float datarate = stream->get_datarate();
+
+		if (datarate >= 0.0f) {
+			printf("%32.1f", (double)datarate);
+
+		} else {
+			printf("%32s", "-");
+		}
+
+		printf(" %16.1f %15.1f %8u\n", (double)stream->get_send_load(), (double)(stream->get_bytes_total() / 1024.0),
+		       (unsigned)stream->get_deferred_count());
 	}
 }
 
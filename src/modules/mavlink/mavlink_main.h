@@ -59,7 +59,7 @@
 #endif
 
 #include <containers/List.hpp>
-#include <drivers/device/ringbuffer.h>
+#include <drivers/device/SPSCRingBuffer.hpp>
 #include <parameters/param.h>
 #include <perf/perf_counter.h>
 #include <px4_platform_common/cli.h>
@@ -78,8 +78,10 @@
 #include <uORB/topics/telemetry_status.h>
 
 #include "mavlink_command_sender.h"
+#include "mavlink_forwarding_buffer.h"
 #include "mavlink_messages.h"
 #include "mavlink_shell.h"
+#include "mavlink_sign_control.h"
 #include "mavlink_ulog.h"
 
 #define DEFAULT_BAUD_RATE       57600
@@ -163,6 +165,11 @@ public:
 
 	static void		forward_message(const mavlink_message_t *msg, Mavlink *self);
 
+	/**
+	 * Signing callback of the parser: decide if an unsigned message is accepted on the link with this status
+	 */
+	static bool		accept_unsigned(const mavlink_status_t *status, uint32_t message_id);
+
 	int			get_uart_fd() const { return _uart_fd; }
 
 	/**
@@ -407,15 +414,18 @@ public:
 	bool			get_wait_to_transmit() { return _wait_to_transmit; }
 	bool			should_transmit() { return (_transmitting_enabled && _boot_complete && (!_wait_to_transmit || (_wait_to_transmit && _received_messages))); }
 
-	bool			message_buffer_write(const void *ptr, int size);
-
 	void			lockMessageBufferMutex(void) { pthread_mutex_lock(&_message_buffer_mutex); }
 	void			unlockMessageBufferMutex(void) { pthread_mutex_unlock(&_message_buffer_mutex); }
 
 	/**
 	 * Count transmitted bytes
 	 */
-	void			count_txbytes(unsigned n) { _bytes_tx += n; };
+	void			count_txbytes(unsigned n) { _bytes_tx += n; _bytes_tx_total += n; };
+
+	/**
+	 * Get the total number of transmitted bytes (wraps around)
+	 */
+	uint32_t		get_bytes_tx_total() const { return _bytes_tx_total; }
 
 	/**
 	 * Count bytes not transmitted because of errors
@@ -436,7 +446,7 @@ public:
 
 	void			update_radio_status(const radio_status_s &radio_status);
 
-	ringbuffer::RingBuffer	*get_logbuffer() { return &_logbuffer; }
+	ringbuffer::SPSCRingBuffer<mavlink_log_s, 8> *get_logbuffer() { return &_logbuffer; }
 
 	unsigned		get_system_type() { return _param_mav_type.get(); }
 
@@ -460,6 +470,11 @@ public:
 	void			set_client_source_initialized() { _src_addr_initialized = true; }
 
 	bool			get_client_source_initialized() { return _src_addr_initialized; }
+
+	/**
+	 * Send out the UDP datagrams coalesced since the last call (called once per main loop iteration)
+	 */
+	void			flush_udp_tx();
 #endif
 
 	uint64_t		get_start_time() { return _mavlink_start_time; }
@@ -554,6 +569,7 @@ private:
 	List<MavlinkStream *>		_streams;
 
 	MavlinkShell		*_mavlink_shell{nullptr};
+	size_t			_mavlink_shell_available_prev{0};	///< shell output pending in the last iteration (bulk mode)
 	MavlinkULog		*_mavlink_ulog{nullptr};
 
 	volatile bool		_mavlink_ulog_stop_requested{false};
@@ -562,7 +578,7 @@ private:
 
 	mavlink_channel_t	_channel{MAVLINK_COMM_0};
 
-	ringbuffer::RingBuffer	_logbuffer{5, sizeof(mavlink_log_s)};
+	ringbuffer::SPSCRingBuffer<mavlink_log_s, 8> _logbuffer{};
 
 	pthread_t		_receive_thread {};
 
@@ -603,6 +619,7 @@ private:
 
 	unsigned		_bytes_tx{0};
 	unsigned		_bytes_txerr{0};
+	uint32_t		_bytes_tx_total{0};
 	unsigned		_bytes_rx{0};
 	uint64_t		_bytes_timestamp{0};
 
@@ -618,6 +635,31 @@ private:
 
 	unsigned short		_network_port{14556};
 	unsigned short		_remote_port{DEFAULT_REMOTE_PORT_UDP};
+
+	/*
+	 * UDP packets are coalesced into datagrams (up to the ethernet MTU) and sent once per loop iteration,
+	 * on Linux all of them (to all destinations) with a single sendmmsg() call.
+	 */
+	static constexpr unsigned UDP_TX_DATAGRAM_SIZE = 1472;
+#if defined(__PX4_LINUX)
+	static constexpr int UDP_TX_MAX_DATAGRAMS = 8;
+#else
+	static constexpr int UDP_TX_MAX_DATAGRAMS = 1;
+#endif
+
+	uint8_t			_udp_tx_buf[UDP_TX_MAX_DATAGRAMS][UDP_TX_DATAGRAM_SIZE];
+	uint16_t		_udp_tx_len[UDP_TX_MAX_DATAGRAMS] {};
+	int			_udp_tx_count{0}; ///< number of used datagrams (the last one is being filled)
+
+	/**
+	 * Append the current packet (_buf) to the UDP datagrams
+	 */
+	void			udp_tx_append();
+
+	/**
+	 * Send the coalesced datagrams (_send_mutex must be locked)
+	 */
+	void			udp_tx_send();
 #endif // MAVLINK_UDP
 
 	uint8_t			_buf[MAVLINK_MAX_PACKET_LEN] {};
@@ -635,14 +677,11 @@ private:
 
 	ping_statistics_s	_ping_stats {};
 
-	struct mavlink_message_buffer {
-		int write_ptr;
-		int read_ptr;
-		int size;
-		char *data;
-	};
-
-	mavlink_message_buffer	_message_buffer {};
+	/* ring of MavlinkForwardingBuffer slot indices of the messages to forward (one element is kept empty) */
+	static constexpr int	FORWARD_QUEUE_SIZE = MavlinkForwardingBuffer::NUM_SLOTS + 1;
+	uint8_t			_forward_queue[FORWARD_QUEUE_SIZE] {};
+	int			_forward_queue_read{0};
+	int			_forward_queue_write{0};
 
 	pthread_mutex_t		_message_buffer_mutex {};
 	pthread_mutex_t		_send_mutex {};
@@ -662,9 +701,12 @@ private:
 		(ParamBool<px4::params::MAV_HB_FORW_EN>) _param_mav_hb_forw_en,
 		(ParamBool<px4::params::MAV_ODOM_LP>) _param_mav_odom_lp,
 		(ParamInt<px4::params::MAV_RADIO_TOUT>)      _param_mav_radio_timeout,
+		(ParamInt<px4::params::MAV_SIGN_CFG>) _param_mav_sign_cfg,
 		(ParamInt<px4::params::SYS_HITL>) _param_sys_hitl
 	)
 
+	MavlinkSignControl	_sign_control{};
+
 	perf_counter_t _loop_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": tx run elapsed")};                      /**< loop performance counter */
 	perf_counter_t _loop_interval_perf{perf_alloc(PC_INTERVAL, MODULE_NAME": tx run interval")};           /**< loop interval performance counter */
 	perf_counter_t _send_byte_error_perf{perf_alloc(PC_COUNT, MODULE_NAME": send_bytes error")};           /**< send bytes error count */
@@ -698,19 +740,22 @@ private:
 	 */
 	int configure_streams_to_default(const char *configure_single_stream = nullptr);
 
-	int message_buffer_init(int size);
-
-	void message_buffer_destroy();
-
-	int message_buffer_count();
-
-	int message_buffer_is_empty() const { return (_message_buffer.read_ptr == _message_buffer.write_ptr); }
-
-	int message_buffer_get_ptr(void **ptr, bool *is_part);
+	/**
+	 * Queue a forwarded message for sending (called from the receiver thread of another instance)
+	 * @param slot MavlinkForwardingBuffer slot with a reference for this instance
+	 * @return false if the queue is full (the reference is not taken over)
+	 */
+	bool pass_message(int slot);
 
-	void message_buffer_mark_read(int n) { _message_buffer.read_ptr = (_message_buffer.read_ptr + n) % _message_buffer.size; }
+	/**
+	 * Send the queued forwarded messages (as long as they fit into the tx buffer) and release them
+	 */
+	void send_forwarded_messages();
 
-	void pass_message(const mavlink_message_t *msg);
+	/**
+	 * Release all queued forwarded messages
+	 */
+	void clear_forwarded_messages();
 
 	void publish_telemetry_status();
 
@@ -729,6 +774,20 @@ private:
 	 */
 	void update_rate_mult();
 
+	/**
+	 * Forward the shell output in SERIAL_CONTROL messages. Several messages are sent per iteration,
+	 * limited by half of the configured data rate and the free tx buffer, so that the streams are not starved.
+	 */
+	void send_shell_output();
+
+	/**
+	 * Update all streams, ordered by priority and urgency: the high priority streams first, then the others, and
+	 * within each priority the streams that got deferred in a previous iteration. Streams that are not high priority
+	 * are only sent if their message fits into the tx buffer, otherwise they are deferred (instead of getting dropped
+	 * in send_start() and starving the remaining streams).
+	 */
+	void update_streams(const hrt_abstime &t);
+
 #if defined(MAVLINK_UDP)
 	void find_broadcast_address();
 
@@ -326,6 +326,11 @@ public:
 		return MAVLINK_MSG_ID_HEARTBEAT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::High;
+	}
+
 	bool const_rate() override
 	{
 		return true;
@@ -410,7 +415,7 @@ protected:
 
 			mavlink_log_s mavlink_log{};
 
-			if (_mavlink->get_logbuffer()->get(&mavlink_log)) {
+			if (_mavlink->get_logbuffer()->get(mavlink_log)) {
 
 				mavlink_statustext_t msg{};
 				const char *text = mavlink_log.text;
@@ -553,6 +558,11 @@ public:
 		return MAVLINK_MSG_ID_SYS_STATUS_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::High;
+	}
+
 private:
 	uORB::Subscription _status_sub{ORB_ID(vehicle_status)};
 	uORB::Subscription _cpuload_sub{ORB_ID(cpuload)};
@@ -956,12 +966,12 @@ public:
 		mavlink_msg_scaled_pressure_send_struct(channel, msg);
 	}
 
-	static const char *get_name_static()
+	static constexpr const char *get_name_static()
 	{
 		return "SCALED_PRESSURE";
 	}
 
-	static uint16_t get_id_static()
+	static constexpr uint16_t get_id_static()
 	{
 		return MAVLINK_MSG_ID_SCALED_PRESSURE;
 	}
@@ -986,12 +996,12 @@ public:
 		mavlink_msg_scaled_pressure2_send_struct(channel, msg);
 	}
 
-	static const char *get_name_static()
+	static constexpr const char *get_name_static()
 	{
 		return "SCALED_PRESSURE2";
 	}
 
-	static uint16_t get_id_static()
+	static constexpr uint16_t get_id_static()
 	{
 		return MAVLINK_MSG_ID_SCALED_PRESSURE2;
 	}
@@ -1016,12 +1026,12 @@ public:
 		mavlink_msg_scaled_pressure3_send_struct(channel, msg);
 	}
 
-	static const char *get_name_static()
+	static constexpr const char *get_name_static()
 	{
 		return "SCALED_PRESSURE3";
 	}
 
-	static uint16_t get_id_static()
+	static constexpr uint16_t get_id_static()
 	{
 		return MAVLINK_MSG_ID_SCALED_PRESSURE3;
 	}
@@ -1040,12 +1050,12 @@ public:
 		return MavlinkStreamScaledIMU::get_name_static();
 	}
 
-	static const char *get_name_static()
+	static constexpr const char *get_name_static()
 	{
 		return "SCALED_IMU";
 	}
 
-	static uint16_t get_id_static()
+	static constexpr uint16_t get_id_static()
 	{
 		return MAVLINK_MSG_ID_SCALED_IMU;
 	}
@@ -1335,6 +1345,11 @@ public:
 		return _att_sub.advertised() ? MAVLINK_MSG_ID_ATTITUDE_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::High;
+	}
+
 private:
 	uORB::Subscription _att_sub{ORB_ID(vehicle_attitude)};
 	uORB::Subscription _angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
@@ -1411,6 +1426,11 @@ public:
 		return _att_sub.advertised() ? MAVLINK_MSG_ID_ATTITUDE_QUATERNION_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::High;
+	}
+
 private:
 	uORB::Subscription _att_sub{ORB_ID(vehicle_attitude)};
 	uORB::Subscription _angular_velocity_sub{ORB_ID(vehicle_angular_velocity)};
@@ -1701,7 +1721,7 @@ public:
 	}
 
 private:
-	uORB::Subscription _gps2_sub{ORB_ID(vehicle_gps_position), 1};
+	uORB::Subscription _gps2_sub{ORB_ID(sensor_gps), 1};
 
 	/* do not allow top copying this class */
 	MavlinkStreamGPS2Raw(MavlinkStreamGPS2Raw &) = delete;
@@ -2416,6 +2436,11 @@ public:
 		return _gpos_sub.advertised() ? MAVLINK_MSG_ID_GLOBAL_POSITION_INT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::High;
+	}
+
 private:
 	uORB::Subscription _gpos_sub{ORB_ID(vehicle_global_position)};
 	uORB::Subscription _lpos_sub{ORB_ID(vehicle_local_position)};
@@ -4057,6 +4082,11 @@ public:
 		return _debug_sub.advertised() ? MAVLINK_MSG_ID_NAMED_VALUE_FLOAT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::Low;
+	}
+
 private:
 	uORB::Subscription _debug_sub{ORB_ID(debug_key_value)};
 
@@ -4123,6 +4153,11 @@ public:
 		return _debug_sub.advertised() ? MAVLINK_MSG_ID_DEBUG_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::Low;
+	}
+
 private:
 	uORB::Subscription _debug_sub{ORB_ID(debug_value)};
 
@@ -4186,6 +4221,11 @@ public:
 		return _debug_sub.advertised() ? MAVLINK_MSG_ID_DEBUG_VECT_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::Low;
+	}
+
 private:
 	uORB::Subscription _debug_sub{ORB_ID(debug_vect)};
 
@@ -4254,6 +4294,11 @@ public:
 		return _debug_array_sub.advertised() ? MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY_LEN + MAVLINK_NUM_NON_PAYLOAD_BYTES : 0;
 	}
 
+	Priority priority() const override
+	{
+		return Priority::Low;
+	}
+
 private:
 	uORB::Subscription _debug_array_sub{ORB_ID(debug_array)};
 
@@ -5199,7 +5244,7 @@ protected:
 	}
 };
 
-static const StreamListItem streams_list[] = {
+static constexpr StreamListItem streams_list[] = {
 	create_stream_list_item<MavlinkStreamHeartbeat>(),
 	create_stream_list_item<MavlinkStreamStatustext>(),
 	create_stream_list_item<MavlinkStreamCommandLong>(),
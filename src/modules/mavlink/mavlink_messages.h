@@ -43,6 +43,12 @@
 
 #include "mavlink_stream.h"
 
+/**
+ * Entry of the table of supported streams. The table is constexpr so that it
+ * is placed in flash; stream instances (and with them their uORB subscriptions)
+ * are only created when a stream is configured with a non-zero rate and are
+ * deleted again when the stream is disabled.
+ */
 class StreamListItem
 {
 
@@ -51,17 +57,17 @@ public:
 	const char *name;
 	uint16_t id;
 
-	StreamListItem(MavlinkStream * (*inst)(Mavlink *mavlink), const char *_name, uint16_t _id) :
+	constexpr StreamListItem(MavlinkStream * (*inst)(Mavlink *mavlink), const char *_name, uint16_t _id) :
 		new_instance(inst),
 		name(_name),
 		id(_id) {}
 
-	const char *get_name() const { return name; }
-	uint16_t get_id() const { return id; }
+	constexpr const char *get_name() const { return name; }
+	constexpr uint16_t get_id() const { return id; }
 };
 
 template <class T>
-static StreamListItem create_stream_list_item()
+static constexpr StreamListItem create_stream_list_item()
 {
 	return StreamListItem(&T::new_instance, T::get_name_static(), T::get_id_static());
 }
@@ -416,6 +416,18 @@ MavlinkMissionManager::current_item_count()
 	return _count[_mission_type];
 }
 
+void
+MavlinkMissionManager::send_mission_requests()
+{
+	if (_transfer_requested_seq < _transfer_seq) {
+		_transfer_requested_seq = _transfer_seq;
+	}
+
+	while (_transfer_requested_seq < _transfer_count && _transfer_requested_seq < _transfer_seq + _transfer_window) {
+		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_requested_seq++);
+	}
+}
+
 void
 MavlinkMissionManager::send_mission_request(uint8_t sysid, uint8_t compid, uint16_t seq)
 {
@@ -523,8 +535,9 @@ MavlinkMissionManager::send(const hrt_abstime now)
 	if (_state == MAVLINK_WPM_STATE_GETLIST && (_time_last_sent > 0)
 	    && hrt_elapsed_time(&_time_last_sent) > MAVLINK_MISSION_RETRY_TIMEOUT_DEFAULT) {
 
-		// try to request item again after timeout
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		// try to request the outstanding items again after timeout
+		_transfer_requested_seq = _transfer_seq;
+		send_mission_requests();
 
 	} else if (_state != MAVLINK_WPM_STATE_IDLE && (_time_last_recv > 0)
 		   && hrt_elapsed_time(&_time_last_recv) > MAVLINK_MISSION_PROTOCOL_TIMEOUT_DEFAULT) {
@@ -621,14 +634,9 @@ MavlinkMissionManager::handle_mission_ack(const mavlink_message_t *msg)
 				// INT or float mode is not supported
 				if (wpa.type == MAV_MISSION_UNSUPPORTED) {
 
-					if (_int_mode) {
-						_int_mode = false;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-
-					} else {
-						_int_mode = true;
-						send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
-					}
+					_int_mode = !_int_mode;
+					_transfer_requested_seq = _transfer_seq;
+					send_mission_requests();
 
 				} else if (wpa.type == MAV_MISSION_OPERATION_CANCELLED) {
 					PX4_DEBUG("WPM: MISSION_ACK CANCELLED, switch to state IDLE");
@@ -914,6 +922,14 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 
 			_state = MAVLINK_WPM_STATE_GETLIST;
 			_transfer_seq = 0;
+			_transfer_window = 1;
+
+			param_t param_window = param_find("MAV_MIS_WINDOW");
+			int32_t window = 1;
+
+			if (param_window != PARAM_INVALID && param_get(param_window, &window) == PX4_OK) {
+				_transfer_window = math::constrain(window, (int32_t)1, (int32_t)MAX_TRANSFER_WINDOW);
+			}
 			_transfer_partner_sysid = msg->sysid;
 			_transfer_partner_compid = msg->compid;
 			_transfer_count = wpc.count;
@@ -960,7 +976,8 @@ MavlinkMissionManager::handle_mission_count(const mavlink_message_t *msg)
 			return;
 		}
 
-		send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+		_transfer_requested_seq = _transfer_seq;
+		send_mission_requests();
 	}
 }
 
@@ -1026,8 +1043,13 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			if (wp.seq != _transfer_seq) {
 				PX4_DEBUG("WPM: MISSION_ITEM ERROR: seq %u was not the expected %u", wp.seq, _transfer_seq);
 
-				/* request next item again */
-				send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+				if (_transfer_window == 1) {
+					/* request next item again */
+					send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
+				}
+
+				// with multiple requests in flight, this is a duplicate or an item after a lost one:
+				// ignore it, the retry timeout requests the window again from the expected item
 				return;
 			}
 
@@ -1069,6 +1091,10 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			return;
 		}
 
+		// request the next items before writing this one, so the round trip to the GCS overlaps with the dataman write
+		_transfer_seq = wp.seq + 1;
+		send_mission_requests();
+
 		bool write_failed = false;
 		bool check_failed = false;
 
@@ -1168,8 +1194,6 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 
 		PX4_DEBUG("WPM: MISSION_ITEM seq %u received", wp.seq);
 
-		_transfer_seq = wp.seq + 1;
-
 		if (_transfer_seq == _transfer_count) {
 			/* got all new mission items successfully */
 			PX4_DEBUG("WPM: MISSION_ITEM got all %u items, current_seq=%u, changing state to MAVLINK_WPM_STATE_IDLE",
@@ -1207,10 +1231,6 @@ MavlinkMissionManager::handle_mission_item_both(const mavlink_message_t *msg)
 			}
 
 			_transfer_in_progress = false;
-
-		} else {
-			/* request next item */
-			send_mission_request(_transfer_partner_sysid, _transfer_partner_compid, _transfer_seq);
 		}
 	}
 }
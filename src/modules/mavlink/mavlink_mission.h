@@ -118,6 +118,10 @@ private:
 
 	uint16_t		_transfer_count{0};			///< Items count in current transmission
 	uint16_t		_transfer_seq{0};			///< Item sequence in current transmission
+	uint16_t		_transfer_requested_seq{0};		///< Next item sequence to request in current transmission
+	uint8_t			_transfer_window{1};			///< Number of item requests in flight, see MAV_MIS_WINDOW
+
+	static constexpr uint8_t	MAX_TRANSFER_WINDOW = 16;
 
 	int32_t			_transfer_current_seq{-1};		///< Current item ID for current transmission (-1 means not initialized)
 
@@ -195,6 +199,11 @@ private:
 
 	void send_mission_request(uint8_t sysid, uint8_t compid, uint16_t seq);
 
+	/**
+	 * Request the items after the last received one, keeping up to _transfer_window requests in flight
+	 */
+	void send_mission_requests();
+
 	/**
 	 *  @brief emits a message that a waypoint reached
 	 *
@@ -189,3 +189,61 @@ PARAM_DEFINE_INT32(MAV_ODOM_LP, 0);
  * @max 250
  */
 PARAM_DEFINE_INT32(MAV_RADIO_TOUT, 5);
+
+/**
+ * Shared receive thread
+ *
+ * If enabled, all MAVLink instances are serviced by a single receive thread
+ * waiting on all links with epoll, and UDP datagrams are read in batches.
+ * This reduces the number of threads and wakeups with many instances.
+ * Only supported on Linux, ignored otherwise.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group MAVLink
+ */
+PARAM_DEFINE_INT32(MAV_RX_SHARED, 0);
+
+/**
+ * MAVLink 2 message signing
+ *
+ * If enabled and a key was set with SETUP_SIGNING, all outgoing messages are
+ * signed and unsigned incoming messages are rejected (except RADIO_STATUS).
+ * The key is stored on the vehicle, setting an all-zero key removes it.
+ * SETUP_SIGNING is only accepted on USB and while signing is enabled.
+ *
+ * @value 0 Disabled
+ * @value 1 Enabled, except on USB
+ * @value 2 Enabled on all links
+ * @reboot_required true
+ * @group MAVLink
+ */
+PARAM_DEFINE_INT32(MAV_SIGN_CFG, 0);
+
+/**
+ * MAVLink FTP burst window
+ *
+ * Number of bytes sent in one burst of a FTP burst read, before the
+ * burst is completed and the ground station has to request the next one.
+ * Larger values increase the download speed on high bandwidth links.
+ *
+ * @group MAVLink
+ * @unit KB
+ * @min 1
+ * @max 4096
+ */
+PARAM_DEFINE_INT32(MAV_FTP_BURST, 34);
+
+/**
+ * Mission upload request window
+ *
+ * Number of MISSION_REQUEST(_INT) messages sent ahead during a mission upload,
+ * instead of requesting one item after the other. Larger values speed up
+ * uploads over high latency links, but require a ground station that answers
+ * multiple outstanding requests. Set to 1 for the standard protocol behavior.
+ *
+ * @group MAVLink
+ * @min 1
+ * @max 16
+ */
+PARAM_DEFINE_INT32(MAV_MIS_WINDOW, 1);
@@ -71,6 +71,7 @@
 #include "mavlink_command_sender.h"
 #include "mavlink_main.h"
 #include "mavlink_receiver.h"
+#include "mavlink_receiver_shared.h"
 
 #ifdef CONFIG_NET
 #define MAVLINK_RECEIVER_NET_ADDED_STACK 1360
@@ -87,6 +88,8 @@ MavlinkReceiver::~MavlinkReceiver()
 	delete _px4_baro;
 	delete _px4_gyro;
 	delete _px4_mag;
+
+	perf_free(_offboard_sp_latency_perf);
 }
 
 MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
@@ -98,6 +101,7 @@ MavlinkReceiver::MavlinkReceiver(Mavlink *parent) :
 	_parameters_manager(parent),
 	_mavlink_timesync(parent)
 {
+	init_message_dispatch();
 }
 
 void
@@ -114,214 +118,169 @@ MavlinkReceiver::acknowledge(uint8_t sysid, uint8_t compid, uint16_t command, ui
 	_cmd_ack_pub.publish(command_ack);
 }
 
-void
-MavlinkReceiver::handle_message(mavlink_message_t *msg)
+const MavlinkReceiver::MessageDispatch MavlinkReceiver::_message_dispatch[] = {
+	{MAVLINK_MSG_ID_COMMAND_LONG,                        &MavlinkReceiver::handle_message_command_long,                        0},
+	{MAVLINK_MSG_ID_COMMAND_INT,                         &MavlinkReceiver::handle_message_command_int,                         0},
+	{MAVLINK_MSG_ID_COMMAND_ACK,                         &MavlinkReceiver::handle_message_command_ack,                         0},
+	{MAVLINK_MSG_ID_OPTICAL_FLOW_RAD,                    &MavlinkReceiver::handle_message_optical_flow_rad,                    0},
+	{MAVLINK_MSG_ID_PING,                                &MavlinkReceiver::handle_message_ping,                                0},
+	{MAVLINK_MSG_ID_SET_MODE,                            &MavlinkReceiver::handle_message_set_mode,                            0},
+	{MAVLINK_MSG_ID_ATT_POS_MOCAP,                       &MavlinkReceiver::handle_message_att_pos_mocap,                       0},
+	{MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED,       &MavlinkReceiver::handle_message_set_position_target_local_ned,       0},
+	{MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT,      &MavlinkReceiver::handle_message_set_position_target_global_int,      0},
+	{MAVLINK_MSG_ID_SET_ATTITUDE_TARGET,                 &MavlinkReceiver::handle_message_set_attitude_target,                 0},
+	{MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET,         &MavlinkReceiver::handle_message_set_actuator_control_target,         0},
+	{MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE,            &MavlinkReceiver::handle_message_vision_position_estimate,            0},
+	{MAVLINK_MSG_ID_ODOMETRY,                            &MavlinkReceiver::handle_message_odometry,                            0},
+	{MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN,                   &MavlinkReceiver::handle_message_gps_global_origin,                   0},
+	{MAVLINK_MSG_ID_RADIO_STATUS,                        &MavlinkReceiver::handle_message_radio_status,                        0},
+	{MAVLINK_MSG_ID_MANUAL_CONTROL,                      &MavlinkReceiver::handle_message_manual_control,                      0},
+	{MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE,                &MavlinkReceiver::handle_message_rc_channels_override,                0},
+	{MAVLINK_MSG_ID_HEARTBEAT,                           &MavlinkReceiver::handle_message_heartbeat,                           0},
+	{MAVLINK_MSG_ID_DISTANCE_SENSOR,                     &MavlinkReceiver::handle_message_distance_sensor,                     0},
+	{MAVLINK_MSG_ID_FOLLOW_TARGET,                       &MavlinkReceiver::handle_message_follow_target,                       0},
+	{MAVLINK_MSG_ID_LANDING_TARGET,                      &MavlinkReceiver::handle_message_landing_target,                      0},
+	{MAVLINK_MSG_ID_CELLULAR_STATUS,                     &MavlinkReceiver::handle_message_cellular_status,                     0},
+	{MAVLINK_MSG_ID_ADSB_VEHICLE,                        &MavlinkReceiver::handle_message_adsb_vehicle,                        0},
+	{MAVLINK_MSG_ID_UTM_GLOBAL_POSITION,                 &MavlinkReceiver::handle_message_utm_global_position,                 0},
+	{MAVLINK_MSG_ID_COLLISION,                           &MavlinkReceiver::handle_message_collision,                           0},
+	{MAVLINK_MSG_ID_GPS_RTCM_DATA,                       &MavlinkReceiver::handle_message_gps_rtcm_data,                       0},
+	{MAVLINK_MSG_ID_BATTERY_STATUS,                      &MavlinkReceiver::handle_message_battery_status,                      0},
+	{MAVLINK_MSG_ID_SERIAL_CONTROL,                      &MavlinkReceiver::handle_message_serial_control,                      0},
+	{MAVLINK_MSG_ID_LOGGING_ACK,                         &MavlinkReceiver::handle_message_logging_ack,                         0},
+	{MAVLINK_MSG_ID_PLAY_TUNE,                           &MavlinkReceiver::handle_message_play_tune,                           0},
+	{MAVLINK_MSG_ID_PLAY_TUNE_V2,                        &MavlinkReceiver::handle_message_play_tune_v2,                        0},
+	{MAVLINK_MSG_ID_OBSTACLE_DISTANCE,                   &MavlinkReceiver::handle_message_obstacle_distance,                   0},
+	{MAVLINK_MSG_ID_TRAJECTORY_REPRESENTATION_BEZIER,    &MavlinkReceiver::handle_message_trajectory_representation_bezier,    0},
+	{MAVLINK_MSG_ID_TRAJECTORY_REPRESENTATION_WAYPOINTS, &MavlinkReceiver::handle_message_trajectory_representation_waypoints, 0},
+	{MAVLINK_MSG_ID_NAMED_VALUE_FLOAT,                   &MavlinkReceiver::handle_message_named_value_float,                   0},
+	{MAVLINK_MSG_ID_DEBUG,                               &MavlinkReceiver::handle_message_debug,                               0},
+	{MAVLINK_MSG_ID_DEBUG_VECT,                          &MavlinkReceiver::handle_message_debug_vect,                          0},
+	{MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY,                   &MavlinkReceiver::handle_message_debug_float_array,                   0},
+	{MAVLINK_MSG_ID_ONBOARD_COMPUTER_STATUS,             &MavlinkReceiver::handle_message_onboard_computer_status,             0},
+	{MAVLINK_MSG_ID_STATUSTEXT,                          &MavlinkReceiver::handle_message_statustext,                          0},
+	{MAVLINK_MSG_ID_HIL_SENSOR,                          &MavlinkReceiver::handle_message_hil_sensor,                          ROUTE_HIL},
+	{MAVLINK_MSG_ID_HIL_STATE_QUATERNION,                &MavlinkReceiver::handle_message_hil_state_quaternion,                ROUTE_HIL},
+	{MAVLINK_MSG_ID_HIL_OPTICAL_FLOW,                    &MavlinkReceiver::handle_message_hil_optical_flow,                    ROUTE_HIL},
+	{MAVLINK_MSG_ID_HIL_GPS,                             &MavlinkReceiver::handle_message_hil_gps,                             ROUTE_HIL_GPS},
+	{MAVLINK_MSG_ID_MISSION_ACK,                         nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_SET_CURRENT,                 nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_REQUEST_LIST,                nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_REQUEST,                     nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_REQUEST_INT,                 nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_COUNT,                       nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_ITEM,                        nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_ITEM_INT,                    nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_MISSION_CLEAR_ALL,                   nullptr,                                                              ROUTE_MISSION},
+	{MAVLINK_MSG_ID_PARAM_REQUEST_LIST,                  nullptr,                                                              ROUTE_PARAMETERS},
+	{MAVLINK_MSG_ID_PARAM_SET,                           nullptr,                                                              ROUTE_PARAMETERS},
+	{MAVLINK_MSG_ID_PARAM_REQUEST_READ,                  nullptr,                                                              ROUTE_PARAMETERS},
+	{MAVLINK_MSG_ID_PARAM_MAP_RC,                        nullptr,                                                              ROUTE_PARAMETERS},
+	{MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL,              nullptr,                                                              ROUTE_FTP},
+	{MAVLINK_MSG_ID_LOG_REQUEST_LIST,                    nullptr,                                                              ROUTE_LOG},
+	{MAVLINK_MSG_ID_LOG_REQUEST_DATA,                    nullptr,                                                              ROUTE_LOG},
+	{MAVLINK_MSG_ID_LOG_ERASE,                           nullptr,                                                              ROUTE_LOG},
+	{MAVLINK_MSG_ID_LOG_REQUEST_END,                     nullptr,                                                              ROUTE_LOG},
+	{MAVLINK_MSG_ID_TIMESYNC,                            nullptr,                                                              ROUTE_TIMESYNC},
+	{MAVLINK_MSG_ID_SYSTEM_TIME,                         nullptr,                                                              ROUTE_TIMESYNC},
+};
+
+const unsigned MavlinkReceiver::_message_dispatch_count = sizeof(_message_dispatch) / sizeof(_message_dispatch[0]);
+
+static inline unsigned message_dispatch_hash(uint32_t msgid)
 {
-	switch (msg->msgid) {
-	case MAVLINK_MSG_ID_COMMAND_LONG:
-		handle_message_command_long(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_INT:
-		handle_message_command_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COMMAND_ACK:
-		handle_message_command_ack(msg);
-		break;
-
-	case MAVLINK_MSG_ID_OPTICAL_FLOW_RAD:
-		handle_message_optical_flow_rad(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PING:
-		handle_message_ping(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_MODE:
-		handle_message_set_mode(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ATT_POS_MOCAP:
-		handle_message_att_pos_mocap(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
-		handle_message_set_position_target_local_ned(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT:
-		handle_message_set_position_target_global_int(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
-		handle_message_set_attitude_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET:
-		handle_message_set_actuator_control_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE:
-		handle_message_vision_position_estimate(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ODOMETRY:
-		handle_message_odometry(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GPS_GLOBAL_ORIGIN:
-		handle_message_gps_global_origin(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RADIO_STATUS:
-		handle_message_radio_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_MANUAL_CONTROL:
-		handle_message_manual_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
-		handle_message_rc_channels_override(msg);
-		break;
-
-	case MAVLINK_MSG_ID_HEARTBEAT:
-		handle_message_heartbeat(msg);
-		break;
-
-	case MAVLINK_MSG_ID_DISTANCE_SENSOR:
-		handle_message_distance_sensor(msg);
-		break;
-
-	case MAVLINK_MSG_ID_FOLLOW_TARGET:
-		handle_message_follow_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LANDING_TARGET:
-		handle_message_landing_target(msg);
-		break;
-
-	case MAVLINK_MSG_ID_CELLULAR_STATUS:
-		handle_message_cellular_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_ADSB_VEHICLE:
-		handle_message_adsb_vehicle(msg);
-		break;
-
-	case MAVLINK_MSG_ID_UTM_GLOBAL_POSITION:
-		handle_message_utm_global_position(msg);
-		break;
-
-	case MAVLINK_MSG_ID_COLLISION:
-		handle_message_collision(msg);
-		break;
-
-	case MAVLINK_MSG_ID_GPS_RTCM_DATA:
-		handle_message_gps_rtcm_data(msg);
-		break;
-
-	case MAVLINK_MSG_ID_BATTERY_STATUS:
-		handle_message_battery_status(msg);
-		break;
-
-	case MAVLINK_MSG_ID_SERIAL_CONTROL:
-		handle_message_serial_control(msg);
-		break;
-
-	case MAVLINK_MSG_ID_LOGGING_ACK:
-		handle_message_logging_ack(msg);
-		break;
-
-	case MAVLINK_MSG_ID_PLAY_TUNE:
-		handle_message_play_tune(msg);
-		break;
+	// Fibonacci hashing, msgids are small and clustered
+	return (msgid * 2654435761u) >> 25;
+}
 
-	case MAVLINK_MSG_ID_PLAY_TUNE_V2:
-		handle_message_play_tune_v2(msg);
-		break;
+void
+MavlinkReceiver::init_message_dispatch()
+{
+	static_assert((MESSAGE_DISPATCH_HASH_SIZE & (MESSAGE_DISPATCH_HASH_SIZE - 1)) == 0, "hash size must be a power of two");
+	static_assert((1u << (32 - 25)) == MESSAGE_DISPATCH_HASH_SIZE, "hash shift does not match hash size");
 
-	case MAVLINK_MSG_ID_OBSTACLE_DISTANCE:
-		handle_message_obstacle_distance(msg);
-		break;
+	memset(_message_dispatch_hash, MESSAGE_DISPATCH_EMPTY, sizeof(_message_dispatch_hash));
 
-	case MAVLINK_MSG_ID_TRAJECTORY_REPRESENTATION_BEZIER:
-		handle_message_trajectory_representation_bezier(msg);
-		break;
+	for (unsigned i = 0; i < _message_dispatch_count && i < MESSAGE_DISPATCH_EMPTY; i++) {
+		unsigned slot = message_dispatch_hash(_message_dispatch[i].msgid);
 
-	case MAVLINK_MSG_ID_TRAJECTORY_REPRESENTATION_WAYPOINTS:
-		handle_message_trajectory_representation_waypoints(msg);
-		break;
+		while (_message_dispatch_hash[slot] != MESSAGE_DISPATCH_EMPTY) {
+			slot = (slot + 1) & (MESSAGE_DISPATCH_HASH_SIZE - 1);
+		}
 
-	case MAVLINK_MSG_ID_NAMED_VALUE_FLOAT:
-		handle_message_named_value_float(msg);
-		break;
+		_message_dispatch_hash[slot] = i;
+	}
+}
 
-	case MAVLINK_MSG_ID_DEBUG:
-		handle_message_debug(msg);
-		break;
+const MavlinkReceiver::MessageDispatch *
+MavlinkReceiver::find_message_dispatch(uint32_t msgid) const
+{
+	unsigned slot = message_dispatch_hash(msgid);
 
-	case MAVLINK_MSG_ID_DEBUG_VECT:
-		handle_message_debug_vect(msg);
-		break;
+	// the table is at most half full, so there is always an empty slot terminating the probe
+	while (_message_dispatch_hash[slot] != MESSAGE_DISPATCH_EMPTY) {
+		const MessageDispatch &entry = _message_dispatch[_message_dispatch_hash[slot]];
 
-	case MAVLINK_MSG_ID_DEBUG_FLOAT_ARRAY:
-		handle_message_debug_float_array(msg);
-		break;
+		if (entry.msgid == msgid) {
+			return &entry;
+		}
 
-	case MAVLINK_MSG_ID_ONBOARD_COMPUTER_STATUS:
-		handle_message_onboard_computer_status(msg);
-		break;
+		slot = (slot + 1) & (MESSAGE_DISPATCH_HASH_SIZE - 1);
+	}
 
-	case MAVLINK_MSG_ID_STATUSTEXT:
-		handle_message_statustext(msg);
-		break;
+	return nullptr;
+}
 
-	default:
-		break;
-	}
+void
+MavlinkReceiver::handle_message(mavlink_message_t *msg)
+{
+	const MessageDispatch *entry = find_message_dispatch(msg->msgid);
+
+	if (entry != nullptr) {
+		if (entry->handler != nullptr) {
+			/*
+			 * Only decode hil messages in HIL mode.
+			 *
+			 * The HIL mode is enabled by the HIL bit flag
+			 * in the system mode. Either send a set mode
+			 * COMMAND_LONG message or a SET_MODE message
+			 *
+			 * Accept HIL GPS messages if use_hil_gps flag is true.
+			 * This allows to provide fake gps measurements to the system.
+			 */
+			bool allowed = true;
 
-	/*
-	 * Only decode hil messages in HIL mode.
-	 *
-	 * The HIL mode is enabled by the HIL bit flag
-	 * in the system mode. Either send a set mode
-	 * COMMAND_LONG message or a SET_MODE message
-	 *
-	 * Accept HIL GPS messages if use_hil_gps flag is true.
-	 * This allows to provide fake gps measurements to the system.
-	 */
-	if (_mavlink->get_hil_enabled()) {
-		switch (msg->msgid) {
-		case MAVLINK_MSG_ID_HIL_SENSOR:
-			handle_message_hil_sensor(msg);
-			break;
+			if (entry->routes & ROUTE_HIL) {
+				allowed = _mavlink->get_hil_enabled();
 
-		case MAVLINK_MSG_ID_HIL_STATE_QUATERNION:
-			handle_message_hil_state_quaternion(msg);
-			break;
+			} else if (entry->routes & ROUTE_HIL_GPS) {
+				allowed = _mavlink->get_hil_enabled() || (_mavlink->get_use_hil_gps() && msg->sysid == mavlink_system.sysid);
+			}
 
-		case MAVLINK_MSG_ID_HIL_OPTICAL_FLOW:
-			handle_message_hil_optical_flow(msg);
-			break;
+			if (allowed) {
+				(this->*entry->handler)(msg);
+			}
+		}
 
-		default:
-			break;
+		if (entry->routes & ROUTE_MISSION) {
+			_mission_manager.handle_message(msg);
 		}
-	}
 
+		if (entry->routes & ROUTE_PARAMETERS) {
+			_parameters_manager.handle_message(msg);
+		}
 
-	if (_mavlink->get_hil_enabled() || (_mavlink->get_use_hil_gps() && msg->sysid == mavlink_system.sysid)) {
-		switch (msg->msgid) {
-		case MAVLINK_MSG_ID_HIL_GPS:
-			handle_message_hil_gps(msg);
-			break;
+		if ((entry->routes & ROUTE_FTP) && _mavlink->ftp_enabled()) {
+			_mavlink_ftp.handle_message(msg);
+		}
 
-		default:
-			break;
+		if (entry->routes & ROUTE_LOG) {
+			_mavlink_log_handler.handle_message(msg);
 		}
 
+		if (entry->routes & ROUTE_TIMESYNC) {
+			_mavlink_timesync.handle_message(msg);
+		}
 	}
 
 	/* If we've received a valid message, mark the flag indicating so.
@@ -849,17 +808,15 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 		bool is_loiter_sp = (bool)(set_position_target_local_ned.type_mask & 0x3000);
 		bool is_idle_sp = (bool)(set_position_target_local_ned.type_mask & 0x4000);
 
-		offboard_control_mode.timestamp = hrt_absolute_time();
-		_offboard_control_mode_pub.publish(offboard_control_mode);
+		publish_offboard_control_mode(offboard_control_mode);
 
 		/* If we are in offboard control mode and offboard control loop through is enabled
 		 * also publish the setpoint topic which is read by the controller */
 		if (_mavlink->get_forward_externalsp()) {
 
-			vehicle_control_mode_s control_mode{};
-			_control_mode_sub.copy(&control_mode);
+			update_offboard_state();
 
-			if (control_mode.flag_control_offboard_enabled) {
+			if (_control_mode.flag_control_offboard_enabled) {
 				if (is_force_sp && offboard_control_mode.ignore_position &&
 				    offboard_control_mode.ignore_velocity) {
 
@@ -963,6 +920,7 @@ MavlinkReceiver::handle_message_set_position_target_local_ned(mavlink_message_t
 
 					//XXX handle global pos setpoints (different MAV frames)
 					_pos_sp_triplet_pub.publish(pos_sp_triplet);
+					count_offboard_setpoint_latency();
 				}
 			}
 		}
@@ -1020,17 +978,15 @@ MavlinkReceiver::handle_message_set_position_target_global_int(mavlink_message_t
 
 		bool is_force_sp = (bool)(set_position_target_global_int.type_mask & (1 << 9));
 
-		offboard_control_mode.timestamp = hrt_absolute_time();
-		_offboard_control_mode_pub.publish(offboard_control_mode);
+		publish_offboard_control_mode(offboard_control_mode);
 
 		/* If we are in offboard control mode and offboard control loop through is enabled
 		 * also publish the setpoint topic which is read by the controller */
 		if (_mavlink->get_forward_externalsp()) {
 
-			vehicle_control_mode_s control_mode{};
-			_control_mode_sub.copy(&control_mode);
+			update_offboard_state();
 
-			if (control_mode.flag_control_offboard_enabled) {
+			if (_control_mode.flag_control_offboard_enabled) {
 				if (is_force_sp && offboard_control_mode.ignore_position &&
 				    offboard_control_mode.ignore_velocity) {
 
@@ -1140,6 +1096,7 @@ MavlinkReceiver::handle_message_set_position_target_global_int(mavlink_message_t
 					}
 
 					_pos_sp_triplet_pub.publish(pos_sp_triplet);
+					count_offboard_setpoint_latency();
 				}
 			}
 		}
@@ -1188,15 +1145,12 @@ MavlinkReceiver::handle_message_set_actuator_control_target(mavlink_message_t *m
 		offboard_control_mode.ignore_velocity           = ignore_setpoints;
 		offboard_control_mode.ignore_acceleration_force = ignore_setpoints;
 
-		offboard_control_mode.timestamp = hrt_absolute_time();
-
-		_offboard_control_mode_pub.publish(offboard_control_mode);
+		publish_offboard_control_mode(offboard_control_mode);
 
 		/* If we are in offboard control mode, publish the actuator controls */
-		vehicle_control_mode_s control_mode{};
-		_control_mode_sub.copy(&control_mode);
+		update_offboard_state();
 
-		if (control_mode.flag_control_offboard_enabled) {
+		if (_control_mode.flag_control_offboard_enabled) {
 
 			actuator_controls_s actuator_controls{};
 			actuator_controls.timestamp = hrt_absolute_time();
@@ -1487,20 +1441,16 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 		offboard_control_mode.ignore_velocity = true;
 		offboard_control_mode.ignore_acceleration_force = true;
 
-		offboard_control_mode.timestamp = hrt_absolute_time();
-
-		_offboard_control_mode_pub.publish(offboard_control_mode);
+		publish_offboard_control_mode(offboard_control_mode);
 
 		/* If we are in offboard control mode and offboard control loop through is enabled
 		 * also publish the setpoint topic which is read by the controller */
 		if (_mavlink->get_forward_externalsp()) {
 
-			vehicle_control_mode_s control_mode{};
-			_control_mode_sub.copy(&control_mode);
+			update_offboard_state();
 
-			if (control_mode.flag_control_offboard_enabled) {
-				vehicle_status_s vehicle_status{};
-				_vehicle_status_sub.copy(&vehicle_status);
+			if (_control_mode.flag_control_offboard_enabled) {
+				const vehicle_status_s &vehicle_status = _vehicle_status;
 
 				/* Publish attitude setpoint if attitude and thrust ignore bits are not set */
 				if (!(offboard_control_mode.ignore_attitude)) {
@@ -1532,6 +1482,8 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 					} else {
 						_att_sp_pub.publish(att_sp);
 					}
+
+					count_offboard_setpoint_latency();
 				}
 
 				/* Publish attitude rate setpoint if bodyrate and thrust ignore bits are not set */
@@ -1561,12 +1513,44 @@ MavlinkReceiver::handle_message_set_attitude_target(mavlink_message_t *msg)
 					}
 
 					_rates_sp_pub.publish(rates_sp);
+					count_offboard_setpoint_latency();
 				}
 			}
 		}
 	}
 }
 
+void
+MavlinkReceiver::update_offboard_state()
+{
+	_control_mode_sub.update(&_control_mode);
+	_vehicle_status_sub.update(&_vehicle_status);
+}
+
+void
+MavlinkReceiver::publish_offboard_control_mode(offboard_control_mode_s &offboard_control_mode)
+{
+	const hrt_abstime now = hrt_absolute_time();
+
+	const bool changed =
+		offboard_control_mode.ignore_thrust != _offboard_control_mode.ignore_thrust ||
+		offboard_control_mode.ignore_attitude != _offboard_control_mode.ignore_attitude ||
+		offboard_control_mode.ignore_bodyrate_x != _offboard_control_mode.ignore_bodyrate_x ||
+		offboard_control_mode.ignore_bodyrate_y != _offboard_control_mode.ignore_bodyrate_y ||
+		offboard_control_mode.ignore_bodyrate_z != _offboard_control_mode.ignore_bodyrate_z ||
+		offboard_control_mode.ignore_position != _offboard_control_mode.ignore_position ||
+		offboard_control_mode.ignore_velocity != _offboard_control_mode.ignore_velocity ||
+		offboard_control_mode.ignore_acceleration_force != _offboard_control_mode.ignore_acceleration_force ||
+		offboard_control_mode.ignore_alt_hold != _offboard_control_mode.ignore_alt_hold;
+
+	offboard_control_mode.timestamp = now;
+
+	if (changed || (now - _offboard_control_mode.timestamp) >= OFFBOARD_CONTROL_MODE_INTERVAL) {
+		_offboard_control_mode_pub.publish(offboard_control_mode);
+		_offboard_control_mode = offboard_control_mode;
+	}
+}
+
 void
 MavlinkReceiver::handle_message_radio_status(mavlink_message_t *msg)
 {
@@ -1720,6 +1704,8 @@ MavlinkReceiver::handle_message_serial_control(mavlink_message_t *msg)
 
 	if (shell) {
 		// we ignore the timeout, EXCLUSIVE & BLOCKING flags of the SERIAL_CONTROL message
+		shell->set_bulk_mode(serial_control_mavlink.flags & SERIAL_CONTROL_FLAG_MULTI);
+
 		if (serial_control_mavlink.count > 0) {
 			shell->write(serial_control_mavlink.data, serial_control_mavlink.count);
 		}
@@ -2786,6 +2772,128 @@ void MavlinkReceiver::handle_message_statustext(mavlink_message_t *msg)
 /**
  * Receive data from UART/UDP
  */
+bool
+MavlinkReceiver::boot_complete()
+{
+	// make sure mavlink app has booted before we start processing anything (parameter sync, etc)
+	if (!_mavlink->boot_complete()) {
+		if (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s) {
+			PX4_ERR("system boot did not complete in 20 seconds");
+			_mavlink->set_boot_complete();
+
+		} else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#if defined(MAVLINK_UDP)
+void
+MavlinkReceiver::update_client_source(const sockaddr_in &srcaddr)
+{
+	if (_mavlink->get_protocol() != Protocol::UDP) {
+		return;
+	}
+
+	struct sockaddr_in &srcaddr_last = _mavlink->get_client_source_address();
+
+	int localhost = (127 << 24) + 1;
+
+	if (!_mavlink->get_client_source_initialized()) {
+
+		// set the address either if localhost or if 3 seconds have passed
+		// this ensures that a GCS running on localhost can get a hold of
+		// the system within the first N seconds
+		hrt_abstime stime = _mavlink->get_start_time();
+
+		if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
+		    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
+
+			srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
+			srcaddr_last.sin_port = srcaddr.sin_port;
+
+			_mavlink->set_client_source_initialized();
+
+			PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
+		}
+	}
+}
+#endif // MAVLINK_UDP
+
+void
+MavlinkReceiver::handle_received(const uint8_t *buf, ssize_t nread)
+{
+#if defined(MAVLINK_UDP)
+
+	// only start accepting messages on UDP once we're sure who we talk to
+	if (_mavlink->get_protocol() == Protocol::UDP && !_mavlink->get_client_source_initialized()) {
+		return;
+	}
+
+#endif // MAVLINK_UDP
+
+	_rx_time = hrt_absolute_time();
+
+	mavlink_message_t msg;
+
+	/* if read failed, this loop won't execute */
+	for (ssize_t i = 0; i < nread; i++) {
+		if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &_status)) {
+
+			/* check if we received version 2 and request a switch. */
+			if (!(_mavlink->get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)) {
+				/* this will only switch to proto version 2 if allowed in settings */
+				_mavlink->set_proto_version(2);
+			}
+
+			/* handle generic messages and commands, and route to the interested components */
+			handle_message(&msg);
+
+			/* handle packet with parent object */
+			_mavlink->handle_message(&msg);
+		}
+	}
+
+	/* count received bytes (nread will be -1 on read error) */
+	if (nread > 0) {
+		_mavlink->count_rxbytes(nread);
+	}
+}
+
+void
+MavlinkReceiver::update(const hrt_abstime &t)
+{
+	// check for parameter updates
+	if (_parameter_update_sub.updated()) {
+		// clear update
+		parameter_update_s pupdate;
+		_parameter_update_sub.copy(&pupdate);
+
+		// update parameters from storage
+		updateParams();
+	}
+
+	if (t - _last_send_update > SEND_INTERVAL) {
+		_mission_manager.check_active_mission();
+		_mission_manager.send(t);
+
+		_parameters_manager.send(t);
+
+		if (_mavlink->ftp_enabled()) {
+			_mavlink_ftp.send(t);
+		}
+
+		_mavlink_log_handler.send(t);
+		_last_send_update = t;
+	}
+
+	if (_tune_publisher != nullptr) {
+		_tune_publisher->publish_next_tune(t);
+	}
+}
+
 void
 MavlinkReceiver::Run()
 {
@@ -2796,18 +2904,12 @@ MavlinkReceiver::Run()
 		px4_prctl(PR_SET_NAME, thread_name, px4_getpid());
 	}
 
-	// make sure mavlink app has booted before we start processing anything (parameter sync, etc)
-	while (!_mavlink->boot_complete()) {
-		if (hrt_elapsed_time(&_mavlink->get_first_start_time()) > 20_s) {
-			PX4_ERR("system boot did not complete in 20 seconds");
-			_mavlink->set_boot_complete();
-		}
-
+	while (!boot_complete()) {
 		px4_usleep(100000);
 	}
 
 	// poll timeout in ms. Also defines the max update frequency of the mission & param manager, etc.
-	const int timeout = 10;
+	const int timeout = static_cast<int>(SEND_INTERVAL / 1000);
 
 #if defined(__PX4_POSIX)
 	/* 1500 is the Wifi MTU, so we make sure to fit a full packet */
@@ -2819,7 +2921,6 @@ MavlinkReceiver::Run()
 	/* the serial port buffers internally as well, we just need to fit a small chunk */
 	uint8_t buf[64];
 #endif
-	mavlink_message_t msg;
 
 	struct pollfd fds[1] = {};
 
@@ -2839,24 +2940,13 @@ MavlinkReceiver::Run()
 
 #endif // MAVLINK_UDP
 
-	ssize_t nread = 0;
-	hrt_abstime last_send_update = 0;
-
 	while (!_mavlink->_task_should_exit) {
 
-		// check for parameter updates
-		if (_parameter_update_sub.updated()) {
-			// clear update
-			parameter_update_s pupdate;
-			_parameter_update_sub.copy(&pupdate);
-
-			// update parameters from storage
-			updateParams();
-		}
-
 		int ret = poll(&fds[0], 1, timeout);
 
 		if (ret > 0) {
+			ssize_t nread = 0;
+
 			if (_mavlink->get_protocol() == Protocol::SERIAL) {
 				/* non-blocking read. read may return negative values */
 				nread = ::read(fds[0].fd, buf, sizeof(buf));
@@ -2873,103 +2963,18 @@ MavlinkReceiver::Run()
 					nread = recvfrom(_mavlink->get_socket_fd(), buf, sizeof(buf), 0, (struct sockaddr *)&srcaddr, &addrlen);
 				}
 
-				struct sockaddr_in &srcaddr_last = _mavlink->get_client_source_address();
-
-				int localhost = (127 << 24) + 1;
-
-				if (!_mavlink->get_client_source_initialized()) {
-
-					// set the address either if localhost or if 3 seconds have passed
-					// this ensures that a GCS running on localhost can get a hold of
-					// the system within the first N seconds
-					hrt_abstime stime = _mavlink->get_start_time();
-
-					if ((stime != 0 && (hrt_elapsed_time(&stime) > 3_s))
-					    || (srcaddr_last.sin_addr.s_addr == htonl(localhost))) {
-
-						srcaddr_last.sin_addr.s_addr = srcaddr.sin_addr.s_addr;
-						srcaddr_last.sin_port = srcaddr.sin_port;
-
-						_mavlink->set_client_source_initialized();
-
-						PX4_INFO("partner IP: %s", inet_ntoa(srcaddr.sin_addr));
-					}
-				}
+				update_client_source(srcaddr);
 			}
 
-			// only start accepting messages on UDP once we're sure who we talk to
-			if (_mavlink->get_protocol() != Protocol::UDP || _mavlink->get_client_source_initialized()) {
 #endif // MAVLINK_UDP
 
-				/* if read failed, this loop won't execute */
-				for (ssize_t i = 0; i < nread; i++) {
-					if (mavlink_parse_char(_mavlink->get_channel(), buf[i], &msg, &_status)) {
-
-						/* check if we received version 2 and request a switch. */
-						if (!(_mavlink->get_status()->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1)) {
-							/* this will only switch to proto version 2 if allowed in settings */
-							_mavlink->set_proto_version(2);
-						}
-
-						/* handle generic messages and commands */
-						handle_message(&msg);
-
-						/* handle packet with mission manager */
-						_mission_manager.handle_message(&msg);
-
-
-						/* handle packet with parameter component */
-						_parameters_manager.handle_message(&msg);
-
-						if (_mavlink->ftp_enabled()) {
-							/* handle packet with ftp component */
-							_mavlink_ftp.handle_message(&msg);
-						}
-
-						/* handle packet with log component */
-						_mavlink_log_handler.handle_message(&msg);
-
-						/* handle packet with timesync component */
-						_mavlink_timesync.handle_message(&msg);
-
-						/* handle packet with parent object */
-						_mavlink->handle_message(&msg);
-					}
-				}
-
-				/* count received bytes (nread will be -1 on read error) */
-				if (nread > 0) {
-					_mavlink->count_rxbytes(nread);
-				}
-
-#if defined(MAVLINK_UDP)
-			}
-
-#endif // MAVLINK_UDP
+			handle_received(buf, nread);
 
 		} else if (ret == -1) {
 			usleep(10000);
 		}
 
-		hrt_abstime t = hrt_absolute_time();
-
-		if (t - last_send_update > timeout * 1000) {
-			_mission_manager.check_active_mission();
-			_mission_manager.send(t);
-
-			_parameters_manager.send(t);
-
-			if (_mavlink->ftp_enabled()) {
-				_mavlink_ftp.send(t);
-			}
-
-			_mavlink_log_handler.send(t);
-			last_send_update = t;
-		}
-
-		if (_tune_publisher != nullptr) {
-			_tune_publisher->publish_next_tune(t);
-		}
+		update(hrt_absolute_time());
 	}
 }
 
@@ -2985,6 +2990,16 @@ MavlinkReceiver::start_helper(void *context)
 void
 MavlinkReceiver::receive_start(pthread_t *thread, Mavlink *parent)
 {
+#if defined(MAVLINK_SHARED_RECEIVER)
+	int32_t shared = 0;
+	param_get(param_find("MAV_RX_SHARED"), &shared);
+
+	if (shared != 0 && MavlinkSharedReceiver::add(parent)) {
+		return;
+	}
+
+#endif // MAVLINK_SHARED_RECEIVER
+
 	pthread_attr_t receiveloop_attr;
 	pthread_attr_init(&receiveloop_attr);
 
@@ -3000,3 +3015,17 @@ MavlinkReceiver::receive_start(pthread_t *thread, Mavlink *parent)
 
 	pthread_attr_destroy(&receiveloop_attr);
 }
+
+void
+MavlinkReceiver::receive_stop(pthread_t thread, Mavlink *parent)
+{
+#if defined(MAVLINK_SHARED_RECEIVER)
+
+	if (MavlinkSharedReceiver::remove(parent)) {
+		return;
+	}
+
+#endif // MAVLINK_SHARED_RECEIVER
+
+	pthread_join(thread, nullptr);
+}
@@ -52,6 +52,7 @@
 #include <lib/drivers/barometer/PX4Barometer.hpp>
 #include <lib/drivers/gyroscope/PX4Gyroscope.hpp>
 #include <lib/drivers/magnetometer/PX4Magnetometer.hpp>
+#include <lib/perf/perf_counter.h>
 #include <px4_platform_common/module_params.h>
 #include <uORB/Publication.hpp>
 #include <uORB/PublicationMulti.hpp>
@@ -104,6 +105,7 @@
 #include <uORB/topics/vehicle_trajectory_waypoint.h>
 
 class Mavlink;
+struct sockaddr_in;
 
 class MavlinkReceiver : public ModuleParams
 {
@@ -116,9 +118,35 @@ public:
 	 */
 	static void receive_start(pthread_t *thread, Mavlink *parent);
 
+	/**
+	 * Stop the receiver and wait for it to exit
+	 */
+	static void receive_stop(pthread_t thread, Mavlink *parent);
+
 	static void *start_helper(void *context);
 
 private:
+	friend class MavlinkSharedReceiver;
+
+	/**
+	 * @return true once the mavlink instance has booted and messages can be processed
+	 */
+	bool boot_complete();
+
+	/**
+	 * Latch the partner address of a UDP link from the source of a received datagram.
+	 */
+	void update_client_source(const sockaddr_in &srcaddr);
+
+	/**
+	 * Parse and handle bytes read from the link.
+	 */
+	void handle_received(const uint8_t *buf, ssize_t nread);
+
+	/**
+	 * Parameter updates and periodic sending of the mission, parameter, ftp and log components.
+	 */
+	void update(const hrt_abstime &t);
 
 	void acknowledge(uint8_t sysid, uint8_t compid, uint16_t command, uint8_t result);
 
@@ -129,8 +157,45 @@ private:
 	void handle_message_command_both(mavlink_message_t *msg, const T &cmd_mavlink,
 					 const vehicle_command_s &vehicle_command);
 
+	/**
+	 * Dispatch a message to the receiver handler and the components registered for its msgid.
+	 */
 	void handle_message(mavlink_message_t *msg);
 
+	/**
+	 * Components a message is routed to in addition to (or instead of) a receiver handler.
+	 */
+	enum MessageRoute : uint8_t {
+		ROUTE_MISSION    = (1 << 0),
+		ROUTE_PARAMETERS = (1 << 1),
+		ROUTE_FTP        = (1 << 2),
+		ROUTE_LOG        = (1 << 3),
+		ROUTE_TIMESYNC   = (1 << 4),
+		ROUTE_HIL        = (1 << 5), ///< receiver handler only runs in HIL mode
+		ROUTE_HIL_GPS    = (1 << 6), ///< receiver handler only runs in HIL mode or with use_hil_gps
+	};
+
+	using MessageHandler = void (MavlinkReceiver::*)(mavlink_message_t *msg);
+
+	struct MessageDispatch {
+		uint32_t msgid;
+		MessageHandler handler; ///< receiver handler, nullptr if the message is only routed to components
+		uint8_t routes;         ///< MessageRoute bitmask
+	};
+
+	static const MessageDispatch _message_dispatch[];
+	static const unsigned _message_dispatch_count;
+
+	/**
+	 * Build the open addressing lookup from msgid into _message_dispatch.
+	 */
+	void init_message_dispatch();
+
+	/**
+	 * @return dispatch entry for msgid, nullptr if no handler is registered
+	 */
+	const MessageDispatch *find_message_dispatch(uint32_t msgid) const;
+
 	void handle_message_adsb_vehicle(mavlink_message_t *msg);
 	void handle_message_att_pos_mocap(mavlink_message_t *msg);
 	void handle_message_battery_status(mavlink_message_t *msg);
@@ -209,6 +274,23 @@ private:
 
 	void fill_thrust(float *thrust_body_array, uint8_t vehicle_type, float thrust);
 
+	/**
+	 * Offboard fast path: refresh the cached vehicle control mode and status,
+	 * which are only copied when commander published a change.
+	 */
+	void update_offboard_state();
+
+	/**
+	 * Publish offboard_control_mode (the offboard heartbeat for commander).
+	 * Unchanged flags are republished at most every OFFBOARD_CONTROL_MODE_INTERVAL.
+	 */
+	void publish_offboard_control_mode(offboard_control_mode_s &offboard_control_mode);
+
+	/**
+	 * Count the time from reading the message until publishing its setpoint.
+	 */
+	void count_offboard_setpoint_latency() { perf_set_elapsed(_offboard_sp_latency_perf, hrt_absolute_time() - _rx_time); }
+
 	void schedule_tune(const char *tune);
 
 	/**
@@ -226,6 +308,10 @@ private:
 
 	mavlink_status_t		_status{}; ///< receiver status, used for mavlink_parse_char()
 
+	static constexpr unsigned MESSAGE_DISPATCH_HASH_SIZE = 128; ///< power of two, at least twice the number of entries
+	static constexpr uint8_t MESSAGE_DISPATCH_EMPTY = UINT8_MAX;
+	uint8_t				_message_dispatch_hash[MESSAGE_DISPATCH_HASH_SIZE]; ///< index into _message_dispatch
+
 	// ORB publications
 	uORB::Publication<actuator_controls_s>			_actuator_controls_pubs[4] {ORB_ID(actuator_controls_0), ORB_ID(actuator_controls_1), ORB_ID(actuator_controls_2), ORB_ID(actuator_controls_3)};
 	uORB::Publication<airspeed_s>				_airspeed_pub{ORB_ID(airspeed)};
@@ -250,13 +336,12 @@ private:
 	uORB::Publication<vehicle_attitude_setpoint_s>		_mc_virtual_att_sp_pub{ORB_ID(mc_virtual_attitude_setpoint)};
 	uORB::Publication<vehicle_attitude_setpoint_s>		_fw_virtual_att_sp_pub{ORB_ID(fw_virtual_attitude_setpoint)};
 	uORB::Publication<vehicle_global_position_s>		_global_pos_pub{ORB_ID(vehicle_global_position)};
-	uORB::Publication<vehicle_gps_position_s>		_gps_pub{ORB_ID(vehicle_gps_position)};
+	uORB::Publication<vehicle_gps_position_s>		_gps_pub{ORB_ID(sensor_gps)};
 	uORB::Publication<vehicle_land_detected_s>		_land_detector_pub{ORB_ID(vehicle_land_detected)};
 	uORB::Publication<vehicle_local_position_s>		_local_pos_pub{ORB_ID(vehicle_local_position)};
 	uORB::Publication<vehicle_odometry_s>			_mocap_odometry_pub{ORB_ID(vehicle_mocap_odometry)};
 	uORB::Publication<vehicle_odometry_s>			_visual_odometry_pub{ORB_ID(vehicle_visual_odometry)};
 	uORB::Publication<vehicle_rates_setpoint_s>		_rates_sp_pub{ORB_ID(vehicle_rates_setpoint)};
-	uORB::Publication<vehicle_trajectory_bezier_s>	_trajectory_bezier_pub{ORB_ID(vehicle_trajectory_bezier)};
 	uORB::Publication<vehicle_trajectory_waypoint_s>	_trajectory_waypoint_pub{ORB_ID(vehicle_trajectory_waypoint)};
 
 	// ORB publications (multi)
@@ -272,6 +357,7 @@ private:
 	uORB::PublicationQueued<transponder_report_s>	_transponder_report_pub{ORB_ID(transponder_report)};
 	uORB::PublicationQueued<vehicle_command_ack_s>	_cmd_ack_pub{ORB_ID(vehicle_command_ack)};
 	uORB::PublicationQueued<vehicle_command_s>	_cmd_pub{ORB_ID(vehicle_command)};
+	uORB::PublicationQueued<vehicle_trajectory_bezier_s>	_trajectory_bezier_pub{ORB_ID(vehicle_trajectory_bezier)};
 
 	// ORB subscriptions
 	uORB::Subscription	_actuator_armed_sub{ORB_ID(actuator_armed)};
@@ -299,9 +385,22 @@ private:
 
 	hrt_abstime			_last_utm_global_pos_com{0};
 
+	// offboard fast path
+	vehicle_control_mode_s		_control_mode{};
+	vehicle_status_s		_vehicle_status{};
+	offboard_control_mode_s		_offboard_control_mode{}; ///< last published offboard_control_mode
+
+	static constexpr hrt_abstime	OFFBOARD_CONTROL_MODE_INTERVAL{20000}; ///< 20 ms, well below COM_OF_LOSS_T
+
+	hrt_abstime			_rx_time{0}; ///< time when the data of the message being handled was read
+	perf_counter_t			_offboard_sp_latency_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": offboard sp latency")};
+
 	// Allocated if needed.
 	TunePublisher *_tune_publisher{nullptr};
 
+	static constexpr hrt_abstime SEND_INTERVAL{10000}; ///< 10 ms, max update interval of the mission & param manager, etc.
+	hrt_abstime _last_send_update{0};
+
 	DEFINE_PARAMETERS(
 		(ParamFloat<px4::params::BAT_CRIT_THR>)     _param_bat_crit_thr,
 		(ParamFloat<px4::params::BAT_EMERGEN_THR>)  _param_bat_emergen_thr,
@@ -0,0 +1,315 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+
+/**
+ * @file mavlink_receiver_shared.cpp
+ * Single receive thread servicing all mavlink instances (Linux only).
+ */
+
+#include "mavlink_receiver_shared.h"
+
+#if defined(MAVLINK_SHARED_RECEIVER)
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <px4_platform_common/tasks.h>
+
+#include "mavlink_main.h"
+#include "mavlink_receiver.h"
+
+MavlinkSharedReceiver &MavlinkSharedReceiver::instance()
+{
+	static MavlinkSharedReceiver shared_receiver;
+	return shared_receiver;
+}
+
+bool MavlinkSharedReceiver::add(Mavlink *parent)
+{
+	MavlinkSharedReceiver &self = instance();
+
+	int fd = -1;
+	bool udp = false;
+
+	if (parent->get_protocol() == Protocol::SERIAL) {
+		fd = parent->get_uart_fd();
+
+	} else if (parent->get_protocol() == Protocol::UDP) {
+		fd = parent->get_socket_fd();
+		udp = true;
+	}
+
+	if (fd < 0) {
+		return false;
+	}
+
+	pthread_mutex_lock(&self._lifecycle_mutex);
+
+	if (!self._running) {
+		self._epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+
+		if (self._epoll_fd < 0) {
+			PX4_ERR("epoll_create1 failed (%i)", errno);
+			pthread_mutex_unlock(&self._lifecycle_mutex);
+			return false;
+		}
+
+		for (unsigned i = 0; i < RECV_BATCH; i++) {
+			self._iovecs[i].iov_base = self._buf[i];
+			self._iovecs[i].iov_len = RECV_SIZE;
+		}
+
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+
+		struct sched_param param;
+		(void)pthread_attr_getschedparam(&attr, &param);
+		param.sched_priority = SCHED_PRIORITY_MAX - 80;
+		(void)pthread_attr_setschedparam(&attr, &param);
+
+		// the message handlers run on this stack, like on a dedicated receive thread
+		pthread_attr_setstacksize(&attr, PX4_STACK_ADJUSTED(8192));
+
+		self._should_exit = false;
+
+		if (pthread_create(&self._thread, &attr, &MavlinkSharedReceiver::thread_main, &self) != 0) {
+			PX4_ERR("failed to start shared receive thread");
+			pthread_attr_destroy(&attr);
+			close(self._epoll_fd);
+			self._epoll_fd = -1;
+			pthread_mutex_unlock(&self._lifecycle_mutex);
+			return false;
+		}
+
+		pthread_attr_destroy(&attr);
+		self._running = true;
+	}
+
+	bool added = false;
+
+	pthread_mutex_lock(&self._mutex);
+
+	if (self._num_entries < MAX_RECEIVERS) {
+		MavlinkReceiver *receiver = new MavlinkReceiver(parent);
+
+		if (receiver != nullptr) {
+			Entry &entry = self._entries[self._num_entries++];
+			entry.parent = parent;
+			entry.receiver = receiver;
+			entry.fd = fd;
+			entry.udp = udp;
+			entry.booted = false;
+			entry.in_epoll = false;
+			entry.retry_time = 0;
+			added = true;
+		}
+	}
+
+	pthread_mutex_unlock(&self._mutex);
+
+	const bool stop = self._running && self._num_entries == 0;
+
+	pthread_mutex_unlock(&self._lifecycle_mutex);
+
+	if (stop) {
+		// nothing registered (first add failed), don't leave an idle thread behind
+		remove(nullptr);
+	}
+
+	return added;
+}
+
+bool MavlinkSharedReceiver::remove(Mavlink *parent)
+{
+	MavlinkSharedReceiver &self = instance();
+
+	pthread_mutex_lock(&self._lifecycle_mutex);
+
+	bool removed = false;
+
+	// the thread holds _mutex while servicing the receivers, so once we own it the receiver is idle
+	pthread_mutex_lock(&self._mutex);
+
+	Entry *entry = parent ? self.find(parent) : nullptr;
+
+	if (entry != nullptr) {
+		if (entry->in_epoll) {
+			epoll_ctl(self._epoll_fd, EPOLL_CTL_DEL, entry->fd, nullptr);
+		}
+
+		delete entry->receiver;
+
+		*entry = self._entries[--self._num_entries];
+		removed = true;
+	}
+
+	const bool stop = self._running && self._num_entries == 0;
+
+	pthread_mutex_unlock(&self._mutex);
+
+	if (stop) {
+		self._should_exit = true;
+		pthread_join(self._thread, nullptr);
+		close(self._epoll_fd);
+		self._epoll_fd = -1;
+		self._running = false;
+	}
+
+	pthread_mutex_unlock(&self._lifecycle_mutex);
+
+	return removed;
+}
+
+MavlinkSharedReceiver::Entry *MavlinkSharedReceiver::find(Mavlink *parent)
+{
+	for (int i = 0; i < _num_entries; i++) {
+		if (_entries[i].parent == parent) {
+			return &_entries[i];
+		}
+	}
+
+	return nullptr;
+}
+
+void *MavlinkSharedReceiver::thread_main(void *context)
+{
+	static_cast<MavlinkSharedReceiver *>(context)->run();
+	return nullptr;
+}
+
+void MavlinkSharedReceiver::update_epoll(Entry &entry, const hrt_abstime &now)
+{
+	// like the dedicated thread, only start reading once the instance has booted
+	if (!entry.booted) {
+		entry.booted = entry.receiver->boot_complete();
+	}
+
+	if (!entry.booted || entry.in_epoll || now < entry.retry_time) {
+		return;
+	}
+
+	struct epoll_event event {};
+	event.events = EPOLLIN;
+	event.data.ptr = entry.parent;
+
+	if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, entry.fd, &event) == 0) {
+		entry.in_epoll = true;
+
+	} else {
+		entry.retry_time = now + 100_ms;
+	}
+}
+
+void MavlinkSharedReceiver::receive(Entry &entry, uint32_t events)
+{
+	if (entry.udp) {
+		// read everything that queued up since the last wakeup, RECV_BATCH datagrams per call
+		int received = 0;
+
+		do {
+			for (unsigned i = 0; i < RECV_BATCH; i++) {
+				_msgs[i].msg_hdr = {};
+				_msgs[i].msg_hdr.msg_name = &_srcaddrs[i];
+				_msgs[i].msg_hdr.msg_namelen = sizeof(_srcaddrs[i]);
+				_msgs[i].msg_hdr.msg_iov = &_iovecs[i];
+				_msgs[i].msg_hdr.msg_iovlen = 1;
+				_msgs[i].msg_len = 0;
+			}
+
+			received = recvmmsg(entry.fd, _msgs, RECV_BATCH, MSG_DONTWAIT, nullptr);
+
+			for (int i = 0; i < received; i++) {
+				entry.receiver->update_client_source(_srcaddrs[i]);
+				entry.receiver->handle_received(_buf[i], _msgs[i].msg_len);
+			}
+
+		} while (received == (int)RECV_BATCH);
+
+		return;
+	}
+
+	ssize_t nread = ::read(entry.fd, &_buf[0][0], sizeof(_buf));
+
+	if (nread > 0) {
+		entry.receiver->handle_received(_buf[0], nread);
+
+	} else if ((nread == -1 && errno == ENOTCONN) || (events & (EPOLLHUP | EPOLLERR))) {
+		// Not connected (can happen for USB): stop waiting on the fd for a while instead of spinning
+		epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, entry.fd, nullptr);
+		entry.in_epoll = false;
+		entry.retry_time = hrt_absolute_time() + 100_ms;
+	}
+}
+
+void MavlinkSharedReceiver::run()
+{
+	px4_prctl(PR_SET_NAME, "mavlink_rcv", px4_getpid());
+
+	struct epoll_event events[MAX_RECEIVERS];
+
+	while (!_should_exit) {
+		const int num_events = epoll_wait(_epoll_fd, events, MAX_RECEIVERS, POLL_TIMEOUT_MS);
+
+		pthread_mutex_lock(&_mutex);
+
+		for (int i = 0; i < num_events; i++) {
+			// the instance might have been removed while waiting
+			Entry *entry = find(static_cast<Mavlink *>(events[i].data.ptr));
+
+			if (entry != nullptr && entry->in_epoll) {
+				receive(*entry, events[i].events);
+			}
+		}
+
+		const hrt_abstime now = hrt_absolute_time();
+
+		for (int i = 0; i < _num_entries; i++) {
+			update_epoll(_entries[i], now);
+
+			if (_entries[i].booted) {
+				_entries[i].receiver->update(now);
+			}
+		}
+
+		pthread_mutex_unlock(&_mutex);
+
+		if (num_events < 0 && errno != EINTR) {
+			px4_usleep(10000);
+		}
+	}
+}
+
+#endif // MAVLINK_SHARED_RECEIVER
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+
+/**
+ * @file mavlink_receiver_shared.h
+ * Single receive thread servicing all mavlink instances (Linux only).
+ */
+
+#pragma once
+
+#if defined(__PX4_LINUX)
+
+#define MAVLINK_SHARED_RECEIVER
+
+#include <pthread.h>
+#include <stdint.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <drivers/drv_hrt.h>
+
+class Mavlink;
+class MavlinkReceiver;
+
+/**
+ * @class MavlinkSharedReceiver
+ * Instead of one receive thread per instance polling a single fd, all registered instances
+ * are waited on with one epoll set from a single thread, and UDP datagrams are read in
+ * batches with recvmmsg(). This reduces the number of threads and wakeups when running
+ * many instances (MAV_RX_SHARED).
+ */
+class MavlinkSharedReceiver
+{
+public:
+	static constexpr int MAX_RECEIVERS = 8;
+
+	/**
+	 * Create a receiver for a mavlink instance and service it from the shared thread.
+	 * The thread is started with the first instance.
+	 * @return false if the instance cannot be serviced, the caller then starts a dedicated thread
+	 */
+	static bool add(Mavlink *parent);
+
+	/**
+	 * Stop servicing a mavlink instance and delete its receiver.
+	 * The thread is stopped with the last instance.
+	 * @return false if the instance was not registered
+	 */
+	static bool remove(Mavlink *parent);
+
+private:
+	MavlinkSharedReceiver() = default;
+	~MavlinkSharedReceiver() = default;
+
+	static MavlinkSharedReceiver &instance();
+
+	static void *thread_main(void *context);
+	void run();
+
+	struct Entry {
+		Mavlink *parent;
+		MavlinkReceiver *receiver;
+		int fd;
+		bool udp;
+		bool booted;
+		bool in_epoll;         ///< fd is in the epoll set (only once the instance has booted)
+		hrt_abstime retry_time; ///< re-add the fd after a read error (e.g. USB not connected)
+	};
+
+	Entry *find(Mavlink *parent);
+	void update_epoll(Entry &entry, const hrt_abstime &now);
+	void receive(Entry &entry, uint32_t events);
+
+	static constexpr int POLL_TIMEOUT_MS = 10;
+	static constexpr unsigned RECV_BATCH = 16;
+	static constexpr size_t RECV_SIZE = 1600; ///< 1500 is the Wifi MTU, so we make sure to fit a full packet
+
+	Entry _entries[MAX_RECEIVERS] {};
+	int _num_entries{0};
+
+	pthread_mutex_t _mutex = PTHREAD_MUTEX_INITIALIZER; ///< protects _entries, held while servicing them
+	pthread_mutex_t _lifecycle_mutex = PTHREAD_MUTEX_INITIALIZER; ///< serializes add() and remove()
+
+	pthread_t _thread{};
+	bool _running{false};
+	volatile bool _should_exit{false};
+	int _epoll_fd{-1};
+
+	uint8_t _buf[RECV_BATCH][RECV_SIZE];
+	struct mmsghdr _msgs[RECV_BATCH];
+	struct iovec _iovecs[RECV_BATCH];
+	struct sockaddr_in _srcaddrs[RECV_BATCH];
+};
+
+#endif // __PX4_LINUX
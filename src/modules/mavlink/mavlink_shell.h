@@ -41,6 +41,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <px4_platform_common/atomic.h>
 #include <px4_platform_common/tasks.h>
 
 #pragma once
@@ -77,6 +78,13 @@ public:
 	 */
 	size_t available();
 
+	/**
+	 * Bulk mode, requested by the client with SERIAL_CONTROL_FLAG_MULTI: the output is drained with
+	 * completely filled messages where possible, instead of forwarding each write of the shell immediately.
+	 */
+	void set_bulk_mode(bool bulk_mode) { _bulk_mode.store(bulk_mode); }
+	bool bulk_mode() const { return _bulk_mode.load(); }
+
 private:
 
 	int _to_shell_fd = -1; /** fd to write to the shell */
@@ -84,6 +92,8 @@ private:
 	int _shell_fds[2] = { -1, -1}; /** stdin & out used by the shell */
 	px4_task_t _task;
 
+	px4::atomic_bool _bulk_mode{false}; /** set from the receiver thread */
+
 	static int shell_start_thread(int argc, char *argv[]);
 
 	/* do not allow copying this class */
@@ -0,0 +1,226 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_sign_control.cpp
+ * MAVLink 2 message signing: key storage and the policy for unsigned messages.
+ */
+
+#include "mavlink_sign_control.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+// 32 bytes secret key followed by the 64 bit timestamp
+static const char *KEY_FILE = PX4_STORAGEDIR "/.mavlink_key";
+
+// start of the MAVLink signing time base (1.1.2015) in seconds since the UNIX epoch
+static constexpr time_t SIGNING_EPOCH = 1420070400;
+
+void MavlinkSignControl::start(uint8_t link_id, mavlink_status_t *status, SignMode mode, bool is_usb,
+			       mavlink_accept_unsigned_t accept_unsigned_callback)
+{
+	_mode = mode;
+	_is_usb = is_usb;
+
+	if (_mode == SignMode::Disabled) {
+		return;
+	}
+
+	_signing.link_id = link_id;
+	_signing.accept_unsigned_callback = accept_unsigned_callback;
+
+	load_key();
+
+	status->signing = &_signing;
+	status->signing_streams = &_signing_streams;
+}
+
+void MavlinkSignControl::stop()
+{
+	if (!enabled() || !_key_valid) {
+		return;
+	}
+
+	// all instances share the file, keep the largest timestamp
+	uint8_t key[KEY_LEN];
+	uint64_t timestamp = 0;
+
+	if (read_key_file(key, timestamp) && memcmp(key, _signing.secret_key, KEY_LEN) == 0
+	    && timestamp >= _signing.timestamp) {
+		return;
+	}
+
+	write_key_file(_signing.secret_key, _signing.timestamp);
+}
+
+void MavlinkSignControl::load_key()
+{
+	uint8_t key[KEY_LEN];
+	uint64_t timestamp = 0;
+
+	if (!read_key_file(key, timestamp)) {
+		_key_valid = false;
+		_signing.flags = 0;
+		return;
+	}
+
+	// the timestamp must never go backwards, otherwise the other side rejects our messages as replays
+	const uint64_t now = realtime_timestamp();
+
+	if (now > timestamp) {
+		timestamp = now;
+	}
+
+	if (_signing.timestamp > timestamp) {
+		timestamp = _signing.timestamp;
+	}
+
+	memcpy(_signing.secret_key, key, KEY_LEN);
+	_signing.timestamp = timestamp;
+	_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+	_key_valid = true;
+}
+
+bool MavlinkSignControl::handle_setup_signing(const mavlink_message_t *msg)
+{
+	// the key is sent in cleartext, only accept it on USB and only if signing is configured
+	if (!enabled() || !_is_usb) {
+		return false;
+	}
+
+	mavlink_setup_signing_t setup_signing;
+	mavlink_msg_setup_signing_decode(msg, &setup_signing);
+
+	if (setup_signing.target_system != mavlink_system.sysid ||
+	    (setup_signing.target_component != mavlink_system.compid && setup_signing.target_component != 0)) {
+		return false;
+	}
+
+	bool key_zero = true;
+
+	for (int i = 0; i < KEY_LEN; i++) {
+		if (setup_signing.secret_key[i] != 0) {
+			key_zero = false;
+			break;
+		}
+	}
+
+	if (key_zero) {
+		unlink(KEY_FILE);
+		PX4_INFO("signing key removed");
+
+	} else if (write_key_file(setup_signing.secret_key, setup_signing.initial_timestamp)) {
+		PX4_INFO("signing key updated");
+
+	} else {
+		return false;
+	}
+
+	load_key();
+	return true;
+}
+
+bool MavlinkSignControl::accept_unsigned(uint32_t message_id) const
+{
+	if (!_key_valid || _mode == SignMode::Disabled) {
+		return true;
+	}
+
+	if (_mode == SignMode::NonUsb && _is_usb) {
+		return true;
+	}
+
+	// injected by SiK radios, which cannot sign
+	return message_id == MAVLINK_MSG_ID_RADIO_STATUS;
+}
+
+uint64_t MavlinkSignControl::realtime_timestamp()
+{
+	timespec ts{};
+	px4_clock_gettime(CLOCK_REALTIME, &ts);
+
+	if (ts.tv_sec <= SIGNING_EPOCH) {
+		return 0;
+	}
+
+	return (uint64_t)(ts.tv_sec - SIGNING_EPOCH) * 100000ULL + (uint64_t)ts.tv_nsec / 10000ULL;
+}
+
+bool MavlinkSignControl::read_key_file(uint8_t key[KEY_LEN], uint64_t &timestamp)
+{
+	int fd = ::open(KEY_FILE, O_RDONLY);
+
+	if (fd < 0) {
+		return false;
+	}
+
+	uint8_t buf[KEY_LEN + sizeof(uint64_t)];
+	const bool ok = ::read(fd, buf, sizeof(buf)) == (ssize_t)sizeof(buf);
+	::close(fd);
+
+	if (!ok) {
+		PX4_ERR("invalid signing key file");
+		return false;
+	}
+
+	memcpy(key, buf, KEY_LEN);
+	memcpy(&timestamp, &buf[KEY_LEN], sizeof(timestamp));
+	return true;
+}
+
+bool MavlinkSignControl::write_key_file(const uint8_t key[KEY_LEN], uint64_t timestamp)
+{
+	int fd = ::open(KEY_FILE, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_600);
+
+	if (fd < 0) {
+		PX4_ERR("cannot write signing key file");
+		return false;
+	}
+
+	uint8_t buf[KEY_LEN + sizeof(uint64_t)];
+	memcpy(buf, key, KEY_LEN);
+	memcpy(&buf[KEY_LEN], &timestamp, sizeof(timestamp));
+
+	const bool ok = ::write(fd, buf, sizeof(buf)) == (ssize_t)sizeof(buf);
+	::close(fd);
+
+	return ok;
+}
@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file mavlink_sign_control.h
+ * MAVLink 2 message signing: key storage and the policy for unsigned messages.
+ */
+
+#pragma once
+
+#include "mavlink_bridge_header.h"
+
+#include <stdint.h>
+
+/**
+ * @class MavlinkSignControl
+ * Per-instance signing state. The secret key and the last signing timestamp are stored in a file
+ * shared by all instances and can be set with SETUP_SIGNING. The signing itself (SHA-256 over each
+ * packet) is done by the MAVLink library once the state is attached to the channel status.
+ */
+class MavlinkSignControl
+{
+public:
+	enum class SignMode : int32_t {
+		Disabled = 0,	///< no signing
+		NonUsb = 1,	///< sign outgoing messages and require signed incoming messages, except on USB
+		Always = 2	///< sign outgoing messages and require signed incoming messages on all links
+	};
+
+	MavlinkSignControl() = default;
+	~MavlinkSignControl() = default;
+
+	/**
+	 * Load the key and attach the signing state to the channel status (unless signing is disabled).
+	 * @param link_id signing link id of this instance
+	 */
+	void start(uint8_t link_id, mavlink_status_t *status, SignMode mode, bool is_usb,
+		   mavlink_accept_unsigned_t accept_unsigned_callback);
+
+	/**
+	 * Store the current signing timestamp, so it keeps increasing after a reboot.
+	 */
+	void stop();
+
+	/**
+	 * (Re)load key and timestamp from storage.
+	 */
+	void load_key();
+
+	/**
+	 * Handle SETUP_SIGNING: store the new key (an all-zero key removes it and disables signing).
+	 * Only accepted on USB and if signing is enabled (MAV_SIGN_CFG).
+	 * @return true if the message was addressed to this system and the key was updated
+	 */
+	bool handle_setup_signing(const mavlink_message_t *msg);
+
+	/**
+	 * @return true if the unsigned message with the given id is accepted
+	 */
+	bool accept_unsigned(uint32_t message_id) const;
+
+	bool enabled() const { return _mode != SignMode::Disabled; }
+	bool key_valid() const { return _key_valid; }
+
+private:
+	static constexpr int KEY_LEN = sizeof(mavlink_signing_t::secret_key);
+
+	/**
+	 * @return signing timestamp (10 us units since 1.1.2015) from the realtime clock, 0 if the clock is not set
+	 */
+	static uint64_t realtime_timestamp();
+
+	static bool read_key_file(uint8_t key[KEY_LEN], uint64_t &timestamp);
+	static bool write_key_file(const uint8_t key[KEY_LEN], uint64_t timestamp);
+
+	mavlink_signing_t _signing{};
+	mavlink_signing_streams_t _signing_streams{};
+
+	SignMode _mode{SignMode::Disabled};
+	bool _is_usb{false};
+	bool _key_valid{false};
+};
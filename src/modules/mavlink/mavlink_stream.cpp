@@ -54,9 +54,77 @@ MavlinkStream::MavlinkStream(Mavlink *mavlink) :
  * Update subscriptions and send message if necessary
  */
 int
-MavlinkStream::update(const hrt_abstime &t)
+MavlinkStream::current_interval()
+{
+	int interval = (_interval > 0) ? _interval : 0;
+
+	if (!const_rate()) {
+		interval /= _mavlink->get_rate_mult();
+	}
+
+	return interval;
+}
+
+bool
+MavlinkStream::due(const hrt_abstime &t)
+{
+	if (_last_sent == 0) {
+		return true;
+	}
+
+	if (_last_sent > t) {
+		return false;
+	}
+
+	// see update()
+	const int interval = current_interval();
+	return interval == 0 || ((int64_t)(t - _last_sent) > (interval - (_mavlink->get_main_loop_delay() / 10) * 3));
+}
+
+bool
+MavlinkStream::send_counted(const hrt_abstime t)
+{
+	// the messages are written out directly, so the difference is what this stream sent
+	const uint32_t bytes_tx_before = _mavlink->get_bytes_tx_total();
+	const hrt_abstime send_start = hrt_absolute_time();
+	const bool sent = send(t);
+	_send_time += hrt_absolute_time() - send_start;
+	const uint32_t bytes_sent = _mavlink->get_bytes_tx_total() - bytes_tx_before;
+	_bytes_sent += bytes_sent;
+	_bytes_total += bytes_sent;
+	return sent;
+}
+
+void
+MavlinkStream::update_datarate(float dt)
+{
+	if (dt > 0.f) {
+		_datarate = _deferred_in_period ? -1.f : _bytes_sent / dt;
+		_send_load = _send_time / dt;
+	}
+
+	_bytes_sent = 0;
+	_send_time = 0;
+	_deferred_in_period = false;
+}
+
+int
+MavlinkStream::update(const hrt_abstime &t, bool can_send)
 {
 	update_data();
+	_last_update = t;
+
+	if (!can_send) {
+		if (!_deferred && due(t)) {
+			_deferred = true;
+			_deferred_count++;
+		}
+
+		_deferred_in_period = _deferred_in_period || _deferred;
+		return -1;
+	}
+
+	_deferred = false;
 
 	// If the message has never been sent before we want
 	// to send it immediately and can return right away
@@ -64,7 +132,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// this will give different messages on the same run a different
 		// initial timestamp which will help spacing them out
 		// on the link scheduling
-		if (send(t)) {
+		if (send_counted(t)) {
 			_last_sent = hrt_absolute_time();
 
 			if (!_first_message_sent) {
@@ -82,11 +150,7 @@ MavlinkStream::update(const hrt_abstime &t)
 	}
 
 	int64_t dt = t - _last_sent;
-	int interval = (_interval > 0) ? _interval : 0;
-
-	if (!const_rate()) {
-		interval /= _mavlink->get_rate_mult();
-	}
+	int interval = current_interval();
 
 	// Send the message if it is due or
 	// if it will overrun the next scheduled send interval
@@ -105,7 +169,7 @@ MavlinkStream::update(const hrt_abstime &t)
 		// do not use the actual time but increment at a fixed rate, so that processing delays do not
 		// distort the average rate. The check of the maximum interval is done to ensure that after a
 		// long time not sending anything, sending multiple messages in a short time is avoided.
-		if (send(t)) {
+		if (send_counted(t)) {
 			_last_sent = ((interval > 0) && ((int64_t)(1.5f * interval) > dt)) ? _last_sent + interval : t;
 
 			if (!_first_message_sent) {
@@ -52,6 +52,15 @@ class MavlinkStream : public ListNode<MavlinkStream *>
 
 public:
 
+	/**
+	 * Scheduling priority, see Mavlink::update_streams()
+	 */
+	enum class Priority : uint8_t {
+		High = 0,	///< control relevant, always updated first and never deferred
+		Normal,
+		Low		///< e.g. debug output, sent after everything else
+	};
+
 	MavlinkStream(Mavlink *mavlink);
 	virtual ~MavlinkStream() = default;
 
@@ -76,9 +85,59 @@ public:
 	int get_interval() { return _interval; }
 
 	/**
+	 * @param can_send if false, only the data is updated and a due message is deferred: it keeps its deadline
+	 * and is sent as soon as possible in a later update()
 	 * @return 0 if updated / sent, -1 if unchanged
 	 */
-	int update(const hrt_abstime &t);
+	int update(const hrt_abstime &t, bool can_send = true);
+
+	/**
+	 * @return true if a message is due at time t
+	 */
+	bool due(const hrt_abstime &t);
+
+	/**
+	 * @return true if a due message could not be sent in the last update()
+	 */
+	bool deferred() const { return _deferred; }
+
+	/**
+	 * @return time passed to the last update()
+	 */
+	hrt_abstime last_update() const { return _last_update; }
+
+	virtual Priority priority() const { return Priority::Normal; }
+
+	/**
+	 * Get the data rate this stream actually sent, measured over the last period (see update_datarate())
+	 *
+	 * @return the rate in bytes/s, or -1 if unknown or if the stream was deferred in that period
+	 *         (i.e. the rate was limited by the link and not by the stream itself)
+	 */
+	float get_datarate() const { return _datarate; }
+
+	/**
+	 * Update the measured data rate with the bytes sent since the last call
+	 *
+	 * @param dt time since the last call in seconds
+	 */
+	void update_datarate(float dt);
+
+	/**
+	 * @return time spent in send(), measured over the last period (see update_datarate()), in us per second
+	 */
+	float get_send_load() const { return _send_load; }
+
+	/**
+	 * @return total number of bytes sent by this stream
+	 */
+	uint64_t get_bytes_total() const { return _bytes_total; }
+
+	/**
+	 * @return number of times a due message was deferred because the TX buffer was full
+	 */
+	uint32_t get_deferred_count() const { return _deferred_count; }
+
 	virtual const char *get_name() const = 0;
 	virtual uint16_t get_id() = 0;
 
@@ -135,8 +194,29 @@ protected:
 	virtual void update_data() { }
 
 private:
+	/**
+	 * @return the current interval in microseconds, taking the rate multiplier into account (0 = unlimited)
+	 */
+	int current_interval();
+
+	/**
+	 * send() and count the sent bytes and the time spent
+	 */
+	bool send_counted(const hrt_abstime t);
+
 	hrt_abstime _last_sent{0};
+	hrt_abstime _last_update{0};
 	bool _first_message_sent{false};
+	bool _deferred{false};
+	bool _deferred_in_period{false};
+
+	uint32_t _bytes_sent{0}; ///< since the last update_datarate()
+	float _datarate{-1.f};
+
+	uint32_t _send_time{0}; ///< time spent in send() since the last update_datarate() [us]
+	float _send_load{0.f};
+	uint64_t _bytes_total{0};
+	uint32_t _deferred_count{0};
 };
 
 
@@ -38,6 +38,7 @@
 #include <crc32.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <parameters/param.h>
 
 #include "mavlink_ftp_test.h"
 #include "../mavlink_ftp.h"
@@ -693,6 +694,138 @@ bool MavlinkFtpTest::_read_badsession_test()
 	return true;
 }
 
+/// @brief Tests for correct reponse to Read commands on two concurrently open sessions.
+bool MavlinkFtpTest::_concurrent_sessions_test()
+{
+	MavlinkFTP::PayloadHeader		payload;
+	const MavlinkFTP::PayloadHeader		*reply;
+	uint8_t					sessions[2];
+
+	for (int i = 0; i < 2; i++) {
+		const char *file = _rgDownloadTestCases[i].file;
+
+		payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+		payload.offset = 0;
+
+		bool success = _send_receive_msg(&payload,		// FTP payload header
+						 strlen(file) + 1,	// size in bytes of data
+						 (uint8_t *)file,	// Data to start into FTP message payload
+						 &reply);		// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		sessions[i] = reply->session;
+	}
+
+	ut_assert("Sessions are not distinct", sessions[0] != sessions[1]);
+
+	// read in reverse order of opening, each session must return its own file
+	for (int i = 1; i >= 0; i--) {
+		const DownloadTestCase *test = &_rgDownloadTestCases[i];
+
+		payload.opcode = MavlinkFTP::kCmdReadFile;
+		payload.session = sessions[i];
+		payload.offset = 0;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 0,		// size in bytes of data
+						 nullptr,	// Data to start into FTP message payload
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+		ut_compare("Payload size incorrect", reply->size, test->length);
+	}
+
+	for (int i = 0; i < 2; i++) {
+		payload.opcode = MavlinkFTP::kCmdTerminateSession;
+		payload.session = sessions[i];
+		payload.size = 0;
+
+		bool success = _send_receive_msg(&payload,	// FTP payload header
+						 0,		// size in bytes of data
+						 nullptr,	// Data to start into FTP message payload
+						 &reply);	// Payload inside FTP message response
+
+		if (!success) {
+			return false;
+		}
+
+		ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+	}
+
+	return true;
+}
+
+/// @brief Tests the virtual parameter file: it must open and start with a valid header.
+bool MavlinkFtpTest::_param_packed_test()
+{
+	MavlinkFTP::PayloadHeader		payload;
+	const MavlinkFTP::PayloadHeader		*reply;
+	const char				*file = "@PARAM/param.pck";
+
+	payload.opcode = MavlinkFTP::kCmdOpenFileRO;
+	payload.offset = 0;
+
+	bool success = _send_receive_msg(&payload,		// FTP payload header
+					 strlen(file) + 1,	// size in bytes of data
+					 (uint8_t *)file,	// Data to start into FTP message payload
+					 &reply);		// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	uint32_t file_size;
+	memcpy(&file_size, reply->data, sizeof(file_size));
+	ut_assert("File too small", file_size >= sizeof(MavlinkFTP::ParamPackedHeader));
+
+	payload.opcode = MavlinkFTP::kCmdReadFile;
+	payload.session = reply->session;
+	payload.offset = 0;
+
+	success = _send_receive_msg(&payload,	// FTP payload header
+				    0,		// size in bytes of data
+				    nullptr,	// Data to start into FTP message payload
+				    &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	MavlinkFTP::ParamPackedHeader header;
+	memcpy(&header, reply->data, sizeof(header));
+	ut_compare("Magic incorrect", header.magic, MavlinkFTP::kParamPackedMagic);
+	ut_compare("Parameter count incorrect", header.num_params, param_count_used());
+
+	payload.opcode = MavlinkFTP::kCmdTerminateSession;
+	payload.session = reply->session;
+	payload.size = 0;
+
+	success = _send_receive_msg(&payload,	// FTP payload header
+				    0,		// size in bytes of data
+				    nullptr,	// Data to start into FTP message payload
+				    &reply);	// Payload inside FTP message response
+
+	if (!success) {
+		return false;
+	}
+
+	ut_compare("Didn't get Ack back", reply->opcode, MavlinkFTP::kRspAck);
+
+	return true;
+}
+
 bool MavlinkFtpTest::_removedirectory_test()
 {
 	MavlinkFTP::PayloadHeader		payload;
@@ -1012,6 +1145,8 @@ bool MavlinkFtpTest::run_tests()
 	ut_run_test(_read_test);
 	ut_run_test(_read_badsession_test);
 	ut_run_test(_burst_test);
+	ut_run_test(_concurrent_sessions_test);
+	ut_run_test(_param_packed_test);
 	ut_run_test(_removedirectory_test);
 	ut_run_test(_createdirectory_test);
 	ut_run_test(_removefile_test);
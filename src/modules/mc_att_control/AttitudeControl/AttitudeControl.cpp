@@ -38,9 +38,28 @@
 #include <AttitudeControl.hpp>
 
 #include <mathlib/math/Functions.hpp>
+#include <mathlib/math/FastMath.hpp>
 
 using namespace matrix;
 
+namespace
+{
+#if defined(ATTITUDE_CONTROL_FAST_MATH)
+// polynomial approximations for boards where the libm functions are too slow for the attitude loop rate
+inline Quatf normalized(const Quatf &q) { return math::fastNormalized(q); }
+inline float arccos(float x) { return math::fastAcos(x); }
+inline float arcsin(float x) { return math::fastAsin(x); }
+inline float cosine(float x) { return math::fastCos(x); }
+inline float sine(float x) { return math::fastSin(x); }
+#else
+inline Quatf normalized(Quatf q) { q.normalize(); return q; }
+inline float arccos(float x) { return acosf(x); }
+inline float arcsin(float x) { return asinf(x); }
+inline float cosine(float x) { return cosf(x); }
+inline float sine(float x) { return sinf(x); }
+#endif
+} // namespace
+
 void AttitudeControl::setProportionalGain(const matrix::Vector3f &proportional_gain, const float yaw_weight)
 {
 	_proportional_gain = proportional_gain;
@@ -54,11 +73,9 @@ void AttitudeControl::setProportionalGain(const matrix::Vector3f &proportional_g
 
 matrix::Vector3f AttitudeControl::update(matrix::Quatf q) const
 {
-	Quatf qd = _attitude_setpoint_q;
-
-	// ensure input quaternions are exactly normalized because acosf(1.00001) == NaN
-	q.normalize();
-	qd.normalize();
+	// ensure input quaternions are normalized because acosf(1.00001) == NaN, remaining errors are constrained below
+	q = normalized(q);
+	Quatf qd = normalized(_attitude_setpoint_q);
 
 	// calculate reduced desired attitude neglecting vehicle's yaw to prioritize roll and pitch
 	const Vector3f e_z = q.dcm_z();
@@ -82,7 +99,7 @@ matrix::Vector3f AttitudeControl::update(matrix::Quatf q) const
 	// catch numerical problems with the domain of acosf and asinf
 	q_mix(0) = math::constrain(q_mix(0), -1.f, 1.f);
 	q_mix(3) = math::constrain(q_mix(3), -1.f, 1.f);
-	qd = qd_red * Quatf(cosf(_yaw_w * acosf(q_mix(0))), 0, 0, sinf(_yaw_w * asinf(q_mix(3))));
+	qd = qd_red * Quatf(cosine(_yaw_w * arccos(q_mix(0))), 0, 0, sine(_yaw_w * arcsin(q_mix(3))));
 
 	// quaternion attitude control law, qe is rotation from q to qd
 	const Quatf qe = q.inversed() * qd;
@@ -34,6 +34,7 @@
 #include <gtest/gtest.h>
 #include <AttitudeControl.hpp>
 #include <mathlib/math/Functions.hpp>
+#include <mathlib/math/FastMath.hpp>
 
 using namespace matrix;
 
@@ -138,3 +139,65 @@ TEST(AttitudeControlTest, YawWeightScaling)
 	// THEN: no actuation (also no NAN)
 	EXPECT_EQ(rate_setpoint, Vector3f());
 }
+
+TEST(AttitudeControlTest, FastMathAccuracy)
+{
+	// the approximations used with ATTITUDE_CONTROL_FAST_MATH stay within their documented bounds over the full domain
+	float error_sin = 0.f;
+	float error_cos = 0.f;
+	float error_acos = 0.f;
+	float error_asin = 0.f;
+	float error_rsqrt = 0.f;
+
+	for (int i = -1000; i <= 1000; i++) {
+		const float angle = i * M_PI_F / 1000.f;
+		error_sin = math::max(error_sin, fabsf(math::fastSin(angle) - sinf(angle)));
+		error_cos = math::max(error_cos, fabsf(math::fastCos(angle) - cosf(angle)));
+
+		const float x = math::constrain(i / 1000.f, -1.f, 1.f);
+		error_acos = math::max(error_acos, fabsf(math::fastAcos(x) - acosf(x)));
+		error_asin = math::max(error_asin, fabsf(math::fastAsin(x) - asinf(x)));
+	}
+
+	for (int i = 1; i <= 1000; i++) {
+		const float x = i * 0.01f;
+		error_rsqrt = math::max(error_rsqrt, fabsf(math::fastRsqrt(x) * sqrtf(x) - 1.f));
+	}
+
+	EXPECT_LT(error_sin, 1e-6f);
+	EXPECT_LT(error_cos, 1e-6f);
+	EXPECT_LT(error_acos, 1e-4f);
+	EXPECT_LT(error_asin, 1e-4f);
+	EXPECT_LT(error_rsqrt, 1e-5f);
+
+	// exact domain limits don't produce NAN
+	EXPECT_FLOAT_EQ(math::fastAcos(1.f), 0.f);
+	EXPECT_NEAR(math::fastAcos(-1.f), M_PI_F, 1e-4f);
+	EXPECT_NEAR(math::fastAsin(1.f), M_PI_2_F, 1e-4f);
+	EXPECT_NEAR(math::fastAsin(-1.f), -M_PI_2_F, 1e-4f);
+}
+
+TEST(AttitudeControlTest, FastMathQuaternion)
+{
+	// normalization
+	const Quatf q(0.698f, 0.024f, -0.681f, -0.220f);
+	const Quatf q_fast = math::fastNormalized(Quatf(3.f * q(0), 3.f * q(1), 3.f * q(2), 3.f * q(3)));
+	Quatf q_exact = q;
+	q_exact.normalize();
+
+	for (int i = 0; i < 4; i++) {
+		EXPECT_NEAR(q_fast(i), q_exact(i), 1e-5f);
+	}
+
+	// yaw weight reduction of the mixed attitude as computed in AttitudeControl::update()
+	for (int i = 0; i <= 100; i++) {
+		const float yaw = i * M_PI_F / 100.f;
+		const float q_mix_w = cosf(yaw / 2.f);
+		const float q_mix_z = sinf(yaw / 2.f);
+
+		for (float yaw_weight : {0.f, .4f, 1.f}) {
+			EXPECT_NEAR(math::fastCos(yaw_weight * math::fastAcos(q_mix_w)), cosf(yaw_weight * acosf(q_mix_w)), 1e-4f);
+			EXPECT_NEAR(math::fastSin(yaw_weight * math::fastAsin(q_mix_z)), sinf(yaw_weight * asinf(q_mix_z)), 1e-4f);
+		}
+	}
+}
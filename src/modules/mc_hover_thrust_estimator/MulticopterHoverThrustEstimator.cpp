@@ -56,7 +56,15 @@ MulticopterHoverThrustEstimator::~MulticopterHoverThrustEstimator()
 
 bool MulticopterHoverThrustEstimator::init()
 {
-	if (!_vehicle_local_position_setpoint_sub.registerCallback()) {
+	_use_vehicle_acceleration = _param_hte_vacc_en.get();
+
+	if (_use_vehicle_acceleration) {
+		if (!_vehicle_acceleration_sub.registerCallback()) {
+			PX4_ERR("vehicle_acceleration callback registration failed!");
+			return false;
+		}
+
+	} else if (!_vehicle_local_position_setpoint_sub.registerCallback()) {
 		PX4_ERR("vehicle_local_position_setpoint callback registration failed!");
 		return false;
 	}
@@ -89,6 +97,7 @@ void MulticopterHoverThrustEstimator::Run()
 {
 	if (should_exit()) {
 		_vehicle_local_position_setpoint_sub.unregisterCallback();
+		_vehicle_acceleration_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
@@ -125,30 +134,70 @@ void MulticopterHoverThrustEstimator::Run()
 		_in_air = local_pos.dist_bottom > 1.f;
 	}
 
+	if (_use_vehicle_acceleration) {
+		_vehicle_attitude_sub.update();
+
+		vehicle_acceleration_s vehicle_acceleration;
+
+		if (_vehicle_acceleration_sub.update(&vehicle_acceleration) && (_vehicle_attitude_sub.get().timestamp != 0)) {
+			// the accelerometer measures the specific force, rotate it into the earth frame
+			// and add gravity to get the vertical acceleration (positive acceleration is up)
+			const matrix::Quatf q{_vehicle_attitude_sub.get().q};
+			const float acc_up = -q.conjugate(matrix::Vector3f{vehicle_acceleration.xyz})(2) - CONSTANTS_ONE_G;
+			_hover_thrust_ekf.accumulateAccZ(acc_up);
+		}
+	}
+
+	vehicle_local_position_setpoint_s local_pos_sp;
+	const bool local_pos_sp_updated = _vehicle_local_position_setpoint_sub.update(&local_pos_sp);
+
+	if (_use_vehicle_acceleration && !local_pos_sp_updated) {
+		// the accumulated acceleration is fused when the thrust setpoint changes
+		perf_end(_cycle_perf);
+		return;
+	}
+
 	ZeroOrderHoverThrustEkf::status status{};
+	bool fused = false;
 
 	if (_armed && !_landed && _in_air) {
-		vehicle_local_position_setpoint_s local_pos_sp;
-
-		if (_vehicle_local_position_setpoint_sub.update(&local_pos_sp)) {
+		if (local_pos_sp_updated) {
 
 			const hrt_abstime now = hrt_absolute_time();
 			const float dt = math::constrain((now - _timestamp_last) / 1e6f, 0.002f, 0.2f);
+			_timestamp_last = now;
 
 			_hover_thrust_ekf.predict(dt);
 
-			if (PX4_ISFINITE(local_pos.az) && PX4_ISFINITE(local_pos_sp.thrust[2])) {
+			if (_use_vehicle_acceleration) {
+				// fuse the mean acceleration measured while the previous thrust setpoint was applied
+				if (PX4_ISFINITE(_thrust_up_last)) {
+					fused = _hover_thrust_ekf.fuseAccumulatedAccZ(_thrust_up_last, status);
+
+				} else {
+					_hover_thrust_ekf.resetAccZAccumulator();
+				}
+
+				_thrust_up_last = -local_pos_sp.thrust[2];
+
+			} else if (PX4_ISFINITE(local_pos.az) && PX4_ISFINITE(local_pos_sp.thrust[2])) {
 				// Inform the hover thrust estimator about the measured vertical
 				// acceleration (positive acceleration is up) and the current thrust (positive thrust is up)
 				_hover_thrust_ekf.fuseAccZ(-local_pos.az, -local_pos_sp.thrust[2], status);
+				fused = true;
 			}
 		}
 
 	} else {
+		_hover_thrust_ekf.resetAccZAccumulator();
+		_thrust_up_last = NAN;
+
 		if (!_armed) {
 			reset();
 		}
+	}
 
+	if (!fused) {
 		status.hover_thrust = _hover_thrust_ekf.getHoverThrustEstimate();
 		status.hover_thrust_var = _hover_thrust_ekf.getHoverThrustEstimateVar();
 		status.accel_noise_var = _hover_thrust_ekf.getAccelNoiseVar();
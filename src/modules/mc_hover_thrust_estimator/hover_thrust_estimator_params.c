@@ -81,3 +81,17 @@ PARAM_DEFINE_FLOAT(HTE_ACC_GATE, 3.0);
  * @group Hover Thrust Estimator
  */
 PARAM_DEFINE_FLOAT(HTE_HT_ERR_INIT, 0.1);
+
+/**
+ * Use the vehicle acceleration
+ *
+ * If enabled, the vertical acceleration is computed from the
+ * vehicle_acceleration topic at IMU rate and averaged between two
+ * thrust setpoint updates instead of using the vertical acceleration
+ * of the local position estimate.
+ *
+ * @boolean
+ * @reboot_required true
+ * @group Hover Thrust Estimator
+ */
+PARAM_DEFINE_INT32(HTE_VACC_EN, 0);
@@ -78,6 +78,18 @@ void ZeroOrderHoverThrustEkf::fuseAccZ(const float acc_z, const float thrust, st
 	status_return = packStatus(innov, innov_var, innov_test_ratio);
 }
 
+bool ZeroOrderHoverThrustEkf::fuseAccumulatedAccZ(const float thrust, status &status_return)
+{
+	if (_acc_z_count == 0) {
+		return false;
+	}
+
+	fuseAccZ(_acc_z_sum / _acc_z_count, thrust, status_return);
+	resetAccZAccumulator();
+
+	return true;
+}
+
 inline float ZeroOrderHoverThrustEkf::computeH(const float thrust) const
 {
 	return -CONSTANTS_ONE_G * thrust / (_hover_thr * _hover_thr);
@@ -87,6 +87,17 @@ public:
 	void predict(float _dt);
 	void fuseAccZ(float acc_z, float thrust, status &status_return);
 
+	/*
+	 * Batched measurement update: the vertical acceleration can be accumulated
+	 * at a higher rate (e.g.: IMU rate) than the thrust setpoint updates and
+	 * its mean is fused as a single measurement for the thrust applied during
+	 * that time. The averaging reduces the measurement noise learned by the
+	 * filter and therefore speeds up the convergence.
+	 */
+	void accumulateAccZ(float acc_z) { _acc_z_sum += acc_z; _acc_z_count++; }
+	bool fuseAccumulatedAccZ(float thrust, status &status_return);
+	void resetAccZAccumulator() { _acc_z_sum = 0.f; _acc_z_count = 0; }
+
 	void setHoverThrust(float hover_thrust) { _hover_thr = math::constrain(hover_thrust, 0.1f, 0.9f); }
 	void setProcessNoiseStdDev(float process_noise) { _process_var = process_noise * process_noise; }
 	void setMeasurementNoiseStdDev(float measurement_noise) { _acc_var = measurement_noise * measurement_noise; }
@@ -109,6 +120,9 @@ private:
 	float _residual_lpf{}; ///< used to remove the constant bias of the residual
 	float _signed_innov_test_ratio_lpf{}; ///< used as a delay to trigger the recovery logic
 
+	float _acc_z_sum{0.f}; ///< sum of the accumulated vertical acceleration samples
+	unsigned _acc_z_count{0}; ///< number of accumulated vertical acceleration samples
+
 	float computeH(float thrust) const;
 	float computeInnovVar(float H) const;
 	float computePredictedAccZ(float thrust) const;
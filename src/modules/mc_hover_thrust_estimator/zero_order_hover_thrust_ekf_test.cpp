@@ -54,6 +54,8 @@ public:
 	float computeAccelFromThrustAndHoverThrust(float thrust, float hover_thrust);
 	ZeroOrderHoverThrustEkf::status runEkf(float hover_thrust_true, float thrust, float time, float accel_noise = 0.f,
 					       float thr_noise = 0.f);
+	ZeroOrderHoverThrustEkf::status runEkfBatched(float hover_thrust_true, float thrust, float time, float accel_noise,
+			int samples_per_update);
 
 private:
 	ZeroOrderHoverThrustEkf _ekf{};
@@ -87,6 +89,26 @@ ZeroOrderHoverThrustEkf::status ZeroOrderHoverThrustEkfTest::runEkf(float hover_
 	return status;
 }
 
+ZeroOrderHoverThrustEkf::status ZeroOrderHoverThrustEkfTest::runEkfBatched(float hover_thrust_true, float thrust,
+		float time, float accel_noise, int samples_per_update)
+{
+	ZeroOrderHoverThrustEkf::status status{};
+
+	for (float t = 0.f; t <= time; t += _dt) {
+		_ekf.predict(_dt);
+
+		// accelerations sampled at a higher rate than the thrust updates
+		for (int i = 0; i < samples_per_update; i++) {
+			float accel_theory = computeAccelFromThrustAndHoverThrust(thrust, hover_thrust_true);
+			_ekf.accumulateAccZ(accel_theory + accel_noise * _standard_normal_distribution(_random_generator));
+		}
+
+		_ekf.fuseAccumulatedAccZ(thrust, status);
+	}
+
+	return status;
+}
+
 TEST_F(ZeroOrderHoverThrustEkfTest, testStaticCase)
 {
 	// GIVEN: a vehicle at hover, (the estimator starting at the true value)
@@ -203,3 +225,24 @@ TEST_F(ZeroOrderHoverThrustEkfTest, testHoverThrustJump)
 	// After a recovery, the noise variance estimate takes more time to converge back to the true value
 	EXPECT_NEAR(status.accel_noise_var, accel_var, 2.f * accel_var);
 }
+
+TEST_F(ZeroOrderHoverThrustEkfTest, testBatchedAccelNoise)
+{
+	// GIVEN: a vehicle at hover, the estimator starts with the wrong estimate and the measurements are noisy
+	// but available at a higher rate than the thrust updates
+	const float sigma_noise = 3.f;
+	const float noise_var = sigma_noise * sigma_noise;
+	const int samples_per_update = 5;
+	const float thrust = 0.72f;
+	const float hover_thrust_true = 0.72f;
+	const float t_sim = 10.f;
+
+	// WHEN: we input the noisy accel data in batches and run the filter
+	ZeroOrderHoverThrustEkf::status status = runEkfBatched(hover_thrust_true, thrust, t_sim, sigma_noise,
+			samples_per_update);
+
+	// THEN: the estimate should converge and the accel noise variance should be the one of the averaged measurements
+	EXPECT_NEAR(status.hover_thrust, hover_thrust_true, 2e-2f);
+	EXPECT_NEAR(status.hover_thrust_var, 0.f, 1e-3f);
+	EXPECT_NEAR(status.accel_noise_var, noise_var / samples_per_update, 0.3f * noise_var / samples_per_update);
+}
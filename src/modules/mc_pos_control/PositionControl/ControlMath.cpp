@@ -51,12 +51,20 @@ void thrustToAttitude(const Vector3f &thr_sp, const float yaw_sp, vehicle_attitu
 }
 
 void limitTilt(Vector3f &body_unit, const Vector3f &world_unit, const float max_angle)
+{
+	limitTilt(body_unit, world_unit, cosf(max_angle), sinf(max_angle));
+}
+
+void limitTilt(Vector3f &body_unit, const Vector3f &world_unit, const float cos_max_angle, const float sin_max_angle)
 {
 	// determine tilt
 	const float dot_product_unit = body_unit.dot(world_unit);
-	float angle = acosf(dot_product_unit);
-	// limit tilt
-	angle = math::min(angle, max_angle);
+
+	// within the limit, nothing to do
+	if (dot_product_unit >= cos_max_angle) {
+		return;
+	}
+
 	Vector3f rejection = body_unit - (dot_product_unit * world_unit);
 
 	// corner case exactly parallel vectors
@@ -64,7 +72,8 @@ void limitTilt(Vector3f &body_unit, const Vector3f &world_unit, const float max_
 		rejection(0) = 1.f;
 	}
 
-	body_unit = cosf(angle) * world_unit + sinf(angle) * rejection.unit();
+	// limit tilt
+	body_unit = cos_max_angle * world_unit + sin_max_angle * rejection.unit();
 }
 
 void bodyzToAttitude(Vector3f body_z, const float yaw_sp, vehicle_attitude_setpoint_s &att_sp)
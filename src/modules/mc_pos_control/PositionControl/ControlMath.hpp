@@ -61,6 +61,17 @@ void thrustToAttitude(const matrix::Vector3f &thr_sp, const float yaw_sp, vehicl
  */
 void limitTilt(matrix::Vector3f &body_unit, const matrix::Vector3f &world_unit, const float max_angle);
 
+/**
+ * Limits the tilt angle between two unit vectors
+ * Same as above with the trigonometry of the maximum angle precomputed by the caller
+ * @param body_unit unit vector that will get adjusted if angle is too big
+ * @param world_unit fixed vector to measure the angle against
+ * @param cos_max_angle cosine of the maximum tilt angle
+ * @param sin_max_angle sine of the maximum tilt angle
+ */
+void limitTilt(matrix::Vector3f &body_unit, const matrix::Vector3f &world_unit, const float cos_max_angle,
+	       const float sin_max_angle);
+
 /**
  * Converts a body z vector and yaw set-point to a desired attitude.
  * @param body_z a world frame 3D vector in direction of the desired body z axis
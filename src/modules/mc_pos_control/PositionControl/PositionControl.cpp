@@ -49,6 +49,9 @@ void PositionControl::setVelocityGains(const Vector3f &P, const Vector3f &I, con
 	_gain_vel_p = P;
 	_gain_vel_i = I;
 	_gain_vel_d = D;
+
+	// tracking anti-windup gain, see _velocityControl()
+	_arw_gain = 2.f / _gain_vel_p(0);
 }
 
 void PositionControl::setVelocityLimits(const float vel_horizontal, const float vel_up, const float vel_down)
@@ -63,6 +66,14 @@ void PositionControl::setThrustLimits(const float min, const float max)
 	// make sure there's always enough thrust vector length to infer the attitude
 	_lim_thr_min = math::max(min, 10e-4f);
 	_lim_thr_max = max;
+	_lim_thr_max_squared = max * max;
+}
+
+void PositionControl::setHoverThrust(const float hover_thrust)
+{
+	_hover_thrust = hover_thrust;
+	_hover_thrust_per_acc = hover_thrust / CONSTANTS_ONE_G;
+	_acc_per_hover_thrust = CONSTANTS_ONE_G / hover_thrust;
 }
 
 void PositionControl::updateHoverThrust(const float hover_thrust_new)
@@ -106,6 +117,13 @@ void PositionControl::setConstraints(const vehicle_constraints_s &constraints)
 		_constraints.speed_down = _lim_vel_down;
 	}
 
+	// the tilt constraint rarely changes, only recompute its trigonometry if it does
+	if (fabsf(_constraints.tilt - _tilt_cached) > FLT_EPSILON) {
+		_tilt_cached = _constraints.tilt;
+		_tilt_cos = cosf(_tilt_cached);
+		_tilt_sin = sinf(_tilt_cached);
+	}
+
 	// ignore _constraints.speed_xy TODO: remove it completely as soon as no task uses it anymore to avoid confusion
 }
 
@@ -162,9 +180,8 @@ void PositionControl::_velocityControl(const float dt)
 	_thr_sp(2) = math::max(_thr_sp(2), -_lim_thr_max);
 
 	// Get allowed horizontal thrust after prioritizing vertical control
-	const float thrust_max_squared = _lim_thr_max * _lim_thr_max;
 	const float thrust_z_squared = _thr_sp(2) * _thr_sp(2);
-	float thrust_max_xy = sqrtf(thrust_max_squared - thrust_z_squared);
+	float thrust_max_xy = sqrtf(_lim_thr_max_squared - thrust_z_squared);
 
 	// Saturate thrust in horizontal direction
 	const Vector2f thrust_sp_xy(_thr_sp);
@@ -176,9 +193,8 @@ void PositionControl::_velocityControl(const float dt)
 
 	// Use tracking Anti-Windup for horizontal direction: during saturation, the integrator is used to unsaturate the output
 	// see Anti-Reset Windup for PID controllers, L.Rundqwist, 1990
-	const Vector2f acc_sp_xy_limited = Vector2f(_thr_sp) * (CONSTANTS_ONE_G / _hover_thrust);
-	const float arw_gain = 2.f / _gain_vel_p(0);
-	vel_error.xy() = Vector2f(vel_error) - (arw_gain * (Vector2f(_acc_sp) - acc_sp_xy_limited));
+	const Vector2f acc_sp_xy_limited = Vector2f(_thr_sp) * _acc_per_hover_thrust;
+	vel_error.xy() = Vector2f(vel_error) - (_arw_gain * (Vector2f(_acc_sp) - acc_sp_xy_limited));
 
 	// Make sure integral doesn't get NAN
 	ControlMath::setZeroIfNanVector3f(vel_error);
@@ -193,9 +209,9 @@ void PositionControl::_accelerationControl()
 {
 	// Assume standard acceleration due to gravity in vertical direction for attitude generation
 	Vector3f body_z = Vector3f(-_acc_sp(0), -_acc_sp(1), CONSTANTS_ONE_G).normalized();
-	ControlMath::limitTilt(body_z, Vector3f(0, 0, 1), _constraints.tilt);
+	ControlMath::limitTilt(body_z, Vector3f(0, 0, 1), _tilt_cos, _tilt_sin);
 	// Scale thrust assuming hover thrust produces standard gravity
-	float collective_thrust = _acc_sp(2) * (_hover_thrust / CONSTANTS_ONE_G) - _hover_thrust;
+	float collective_thrust = _acc_sp(2) * _hover_thrust_per_acc - _hover_thrust;
 	// Project thrust to planned body attitude
 	collective_thrust /= (Vector3f(0, 0, 1).dot(body_z));
 	collective_thrust = math::min(collective_thrust, -_lim_thr_min);
@@ -117,7 +117,7 @@ public:
 	 * Set the normalized hover thrust
 	 * @param thrust [0,1] with which the vehicle hovers not acelerating down or up with level orientation
 	 */
-	void setHoverThrust(const float hover_thrust) { _hover_thrust = hover_thrust; }
+	void setHoverThrust(const float hover_thrust);
 
 	/**
 	 * Update the hover thrust without immediately affecting the output
@@ -202,6 +202,15 @@ private:
 
 	float _hover_thrust{}; ///< Thrust [0,1] with which the vehicle hovers not accelerating down or up with level orientation
 
+	// Values derived from the gains and limits, only recomputed when those change
+	float _arw_gain{}; ///< horizontal tracking anti-windup gain
+	float _lim_thr_max_squared{}; ///< squared maximum collective thrust
+	float _hover_thrust_per_acc{}; ///< thrust per m/s^2 assuming hover thrust produces standard gravity
+	float _acc_per_hover_thrust{}; ///< m/s^2 per thrust assuming hover thrust produces standard gravity
+	float _tilt_cached{0.f}; ///< tilt constraint the trigonometry below was computed for
+	float _tilt_cos{1.f}; ///< cosine of the tilt constraint
+	float _tilt_sin{0.f}; ///< sine of the tilt constraint
+
 	// States
 	matrix::Vector3f _pos; /**< current position */
 	matrix::Vector3f _vel; /**< current velocity */
@@ -0,0 +1,262 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file PositionControlMPC.cpp
+ */
+
+#include "PositionControlMPC.hpp"
+
+#include <mathlib/mathlib.h>
+#include <px4_platform_common/defines.h>
+
+using namespace matrix;
+
+PositionControlMPC::PositionControlMPC()
+{
+	// FISTA momentum sequence, only depends on the iteration count
+	float t = 1.f;
+
+	for (int i = 0; i < ITERATIONS; i++) {
+		const float t_next = (1.f + sqrtf(1.f + 4.f * t * t)) / 2.f;
+		_momentum[i] = (t - 1.f) / t_next;
+		t = t_next;
+	}
+
+	updateMatrices();
+}
+
+void PositionControlMPC::setHorizonStep(const float dt)
+{
+	if (dt > FLT_EPSILON && fabsf(dt - _dt) > FLT_EPSILON) {
+		_dt = dt;
+		updateMatrices();
+	}
+}
+
+void PositionControlMPC::setWeights(const float position, const float velocity, const float acceleration,
+				    const float jerk)
+{
+	_weight_position = math::max(position, 0.f);
+	_weight_velocity = math::max(velocity, 0.f);
+	_weight_acceleration = math::max(acceleration, 0.f);
+	_weight_jerk = math::max(jerk, 0.f);
+	updateMatrices();
+}
+
+void PositionControlMPC::setLimits(const float horizontal, const float up, const float down, const float jerk)
+{
+	_lim_acc_horizontal = horizontal;
+	_lim_acc_up = up;
+	_lim_acc_down = down;
+	_lim_jerk = jerk;
+}
+
+void PositionControlMPC::reset()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		_plan[axis].setZero();
+		_controlled[axis] = false;
+	}
+
+	_acc_prev.setZero();
+}
+
+void PositionControlMPC::updateMatrices()
+{
+	// double integrator: p_k+1 = p_k + dt v_k + dt^2/2 a_k, v_k+1 = v_k + dt a_k
+	// row k is the state after step k + 1, column i the contribution of acceleration a_i
+	_gamma_position.setZero();
+	_gamma_velocity.setZero();
+
+	for (int k = 0; k < HORIZON; k++) {
+		for (int i = 0; i <= k; i++) {
+			_gamma_position(k, i) = _dt * _dt * (k - i + 0.5f);
+			_gamma_velocity(k, i) = _dt;
+		}
+	}
+
+	// acceleration effort and jerk (differences of consecutive accelerations, the first one against the applied acceleration)
+	MatrixN effort;
+	effort.setZero();
+
+	for (int i = 0; i < HORIZON; i++) {
+		effort(i, i) = _weight_acceleration + _weight_jerk * ((i < HORIZON - 1) ? 2.f : 1.f);
+
+		if (i < HORIZON - 1) {
+			effort(i, i + 1) = -_weight_jerk;
+			effort(i + 1, i) = -_weight_jerk;
+		}
+	}
+
+	_hessian_velocity = _gamma_velocity.transpose() * _gamma_velocity * _weight_velocity + effort;
+	_hessian_position = _gamma_position.transpose() * _gamma_position * _weight_position + _hessian_velocity;
+
+	_step_position = lipschitzStep(_hessian_position);
+	_step_velocity = lipschitzStep(_hessian_velocity);
+}
+
+float PositionControlMPC::lipschitzStep(const MatrixN &hessian)
+{
+	// the largest eigenvalue is bounded by the largest absolute row sum (Gershgorin)
+	float lipschitz = 0.f;
+
+	for (int i = 0; i < HORIZON; i++) {
+		float row_sum = 0.f;
+
+		for (int j = 0; j < HORIZON; j++) {
+			row_sum += fabsf(hessian(i, j));
+		}
+
+		lipschitz = math::max(lipschitz, row_sum);
+	}
+
+	return (lipschitz > FLT_EPSILON) ? 1.f / lipschitz : 0.f;
+}
+
+void PositionControlMPC::solve(const MatrixN &hessian, const float step, const VectorN &gradient, const float lower,
+			       const float upper, VectorN &a) const
+{
+	VectorN y = a;
+
+	for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+		const VectorN a_prev = a;
+
+		// projected gradient step
+		a = y - (hessian * y + gradient) * step;
+
+		for (int i = 0; i < HORIZON; i++) {
+			a(i) = math::constrain(a(i), lower, upper);
+		}
+
+		// momentum
+		y = a + (a - a_prev) * _momentum[iteration];
+	}
+}
+
+void PositionControlMPC::update(const PositionControlStates &states, vehicle_local_position_setpoint_s &setpoint,
+				const float dt)
+{
+	float *const position_sp[3] {&setpoint.x, &setpoint.y, &setpoint.z};
+	float *const velocity_sp[3] {&setpoint.vx, &setpoint.vy, &setpoint.vz};
+
+	Vector3f acc;
+
+	for (int axis = 0; axis < 3; axis++) {
+		const bool track_position = PX4_ISFINITE(*position_sp[axis]) && PX4_ISFINITE(states.position(axis));
+		const bool track_velocity = PX4_ISFINITE(*velocity_sp[axis]);
+
+		if ((!track_position && !track_velocity) || !PX4_ISFINITE(states.velocity(axis))) {
+			_controlled[axis] = false;
+			continue;
+		}
+
+		if (!_controlled[axis]) {
+			// start from the current acceleration setpoint if there is one
+			const float acc_sp = PX4_ISFINITE(setpoint.acceleration[axis]) ? setpoint.acceleration[axis] : 0.f;
+			_plan[axis].setAll(acc_sp);
+			_acc_prev(axis) = acc_sp;
+			_controlled[axis] = true;
+		}
+
+		const float velocity = states.velocity(axis);
+		const float velocity_ref = track_velocity ? *velocity_sp[axis] : 0.f;
+
+		// unforced prediction errors
+		VectorN velocity_error;
+		velocity_error.setAll(velocity - velocity_ref);
+		VectorN gradient = _gamma_velocity.transpose() * velocity_error * _weight_velocity;
+
+		if (track_position) {
+			VectorN position_error;
+
+			for (int k = 0; k < HORIZON; k++) {
+				position_error(k) = states.position(axis) + (k + 1) * _dt * velocity - *position_sp[axis];
+			}
+
+			gradient += _gamma_position.transpose() * position_error * _weight_position;
+		}
+
+		// jerk of the first planned step against the applied acceleration
+		gradient(0) -= _weight_jerk * _acc_prev(axis);
+
+		// NED frame: up is negative
+		const float lower = (axis < 2) ? -_lim_acc_horizontal : -_lim_acc_up;
+		const float upper = (axis < 2) ? _lim_acc_horizontal : _lim_acc_down;
+
+		// warm start with the previous plan shifted by one step
+		VectorN &plan = _plan[axis];
+
+		for (int i = 0; i < HORIZON - 1; i++) {
+			plan(i) = math::constrain(plan(i + 1), lower, upper);
+		}
+
+		plan(HORIZON - 1) = plan(HORIZON - 2);
+
+		if (track_position) {
+			solve(_hessian_position, _step_position, gradient, lower, upper, plan);
+
+		} else {
+			solve(_hessian_velocity, _step_velocity, gradient, lower, upper, plan);
+		}
+
+		acc(axis) = plan(0);
+	}
+
+	// the horizontal limit applies to the norm
+	if (_controlled[0] && _controlled[1]) {
+		const Vector2f acc_xy(acc(0), acc(1));
+		const float acc_xy_norm = acc_xy.norm();
+
+		if (acc_xy_norm > _lim_acc_horizontal) {
+			acc(0) *= _lim_acc_horizontal / acc_xy_norm;
+			acc(1) *= _lim_acc_horizontal / acc_xy_norm;
+		}
+	}
+
+	// hard jerk limit on the applied acceleration, after the norm limit so it can't be undone by the scaling
+	const float acc_delta_max = _lim_jerk * dt;
+
+	for (int axis = 0; axis < 3; axis++) {
+		if (_controlled[axis]) {
+			acc(axis) = math::constrain(acc(axis), _acc_prev(axis) - acc_delta_max, _acc_prev(axis) + acc_delta_max);
+			_acc_prev(axis) = acc(axis);
+
+			// velocity reached with the applied acceleration at the next update
+			*position_sp[axis] = NAN;
+			*velocity_sp[axis] = states.velocity(axis) + acc(axis) * dt;
+			setpoint.acceleration[axis] = acc(axis);
+		}
+	}
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file PositionControlMPC.hpp
+ *
+ * Model-predictive position and velocity setpoint tracking for MC.
+ */
+
+#pragma once
+
+#include "PositionControl.hpp"
+
+#include <matrix/matrix/math.hpp>
+#include <uORB/topics/vehicle_local_position_setpoint.h>
+
+/**
+ * 	Model-predictive acceleration planning for MC, an alternative to the
+ * 	position and velocity P-loops of PositionControl.
+ *
+ * 	Every axis is modeled as a double integrator with the acceleration as input.
+ * 	Over a fixed horizon the acceleration sequence minimizes the position and velocity
+ * 	tracking errors plus acceleration and jerk effort, subject to acceleration limits.
+ * 	The resulting box constrained QP has a fixed size, all matrices are precomputed when
+ * 	the parameters change and it is solved with a fixed number of accelerated projected
+ * 	gradient iterations (FISTA) warm started from the previous solution, so the
+ * 	computation time is bounded.
+ *
+ * 	The first step of the plan replaces the setpoint of each controlled axis with a
+ * 	velocity and acceleration feed-forward setpoint for PositionControl, whose velocity
+ * 	PID then only compensates for disturbances and model errors.
+ */
+class PositionControlMPC
+{
+public:
+	static constexpr int HORIZON = 10; ///< number of planned steps
+	static constexpr int ITERATIONS = 20; ///< fixed number of solver iterations per axis
+
+	PositionControlMPC();
+	~PositionControlMPC() = default;
+
+	/**
+	 * Set the time step of the planning horizon
+	 * @param dt step in seconds, the horizon covers HORIZON * dt
+	 */
+	void setHorizonStep(const float dt);
+
+	/**
+	 * Set the cost function weights
+	 * @param position weight of the squared position error
+	 * @param velocity weight of the squared velocity error
+	 * @param acceleration weight of the squared acceleration
+	 * @param jerk weight of the squared acceleration change between steps
+	 */
+	void setWeights(const float position, const float velocity, const float acceleration, const float jerk);
+
+	/**
+	 * Set the acceleration and jerk limits
+	 * @param horizontal maximum horizontal acceleration in m/s^2
+	 * @param up maximum upwards acceleration in m/s^2
+	 * @param down maximum downwards acceleration in m/s^2
+	 * @param jerk maximum change of the applied acceleration in m/s^3
+	 */
+	void setLimits(const float horizontal, const float up, const float down, const float jerk);
+
+	/**
+	 * Forget the previous plan, e.g. when the controller was not running
+	 */
+	void reset();
+
+	/**
+	 * Plan the acceleration for all axes with a position or velocity setpoint and replace
+	 * their setpoints by the first step of the plan (velocity and acceleration feed-forward).
+	 * Axes without setpoint or with invalid states are left untouched.
+	 * @param states current vehicle states
+	 * @param setpoint input setpoint, modified in place
+	 * @param dt time since the last update in seconds
+	 */
+	void update(const PositionControlStates &states, vehicle_local_position_setpoint_s &setpoint, const float dt);
+
+private:
+	using VectorN = matrix::Vector<float, HORIZON>;
+	using MatrixN = matrix::SquareMatrix<float, HORIZON>;
+
+	void updateMatrices();
+
+	/**
+	 * Solve the box constrained QP min 1/2 a'Ha + g'a s.t. lower <= a <= upper
+	 * @param hessian H
+	 * @param step inverse of the Lipschitz constant of the gradient
+	 * @param a warm start on input, solution on output
+	 */
+	void solve(const MatrixN &hessian, const float step, const VectorN &gradient, const float lower, const float upper,
+		   VectorN &a) const;
+
+	static float lipschitzStep(const MatrixN &hessian);
+
+	// Parameters
+	float _dt{0.1f};
+	float _weight_position{1.f};
+	float _weight_velocity{0.5f};
+	float _weight_acceleration{0.05f};
+	float _weight_jerk{0.1f};
+	float _lim_acc_horizontal{5.f};
+	float _lim_acc_up{4.f};
+	float _lim_acc_down{3.f};
+	float _lim_jerk{8.f};
+
+	// Precomputed problem matrices
+	MatrixN _gamma_position; ///< planned positions as linear function of the accelerations
+	MatrixN _gamma_velocity; ///< planned velocities as linear function of the accelerations
+	MatrixN _hessian_position; ///< hessian when tracking a position
+	MatrixN _hessian_velocity; ///< hessian when tracking a velocity only
+	float _step_position{0.f};
+	float _step_velocity{0.f};
+	float _momentum[ITERATIONS] {}; ///< FISTA momentum coefficients
+
+	// States
+	VectorN _plan[3]; ///< last planned accelerations per axis, warm start of the next solution
+	matrix::Vector3f _acc_prev; ///< last applied acceleration
+	bool _controlled[3] {};
+};
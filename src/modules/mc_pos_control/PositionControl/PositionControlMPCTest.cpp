@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ *   Copyright (C) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <PositionControlMPC.hpp>
+#include <px4_defines.h>
+
+#include <chrono>
+#include <cstdio>
+
+using namespace matrix;
+
+class PositionControlMPCTest : public ::testing::Test
+{
+public:
+	PositionControlMPCTest()
+	{
+		_mpc.setHorizonStep(0.1f);
+		_mpc.setWeights(1.f, 0.5f, 0.05f, 0.1f);
+		_mpc.setLimits(5.f, 4.f, 3.f, 8.f);
+
+		_states.position = Vector3f(0.f, 0.f, 0.f);
+		_states.velocity = Vector3f(0.f, 0.f, 0.f);
+		_states.acceleration = Vector3f(0.f, 0.f, 0.f);
+		_states.yaw = 0.f;
+	}
+
+	vehicle_local_position_setpoint_s positionSetpoint(const Vector3f &position)
+	{
+		vehicle_local_position_setpoint_s setpoint{};
+		setpoint.x = position(0);
+		setpoint.y = position(1);
+		setpoint.z = position(2);
+		setpoint.vx = setpoint.vy = setpoint.vz = NAN;
+		Vector3f(NAN, NAN, NAN).copyTo(setpoint.acceleration);
+		return setpoint;
+	}
+
+	// simulate a perfect double integrator following the acceleration setpoint
+	Vector3f step(const vehicle_local_position_setpoint_s &setpoint)
+	{
+		const Vector3f acc(setpoint.acceleration);
+		_states.position += _states.velocity * _dt + acc * (_dt * _dt / 2.f);
+		_states.velocity += acc * _dt;
+		return acc;
+	}
+
+	PositionControlMPC _mpc;
+	PositionControlStates _states{};
+	const float _dt{0.02f};
+};
+
+TEST_F(PositionControlMPCTest, NoSetpointUntouched)
+{
+	vehicle_local_position_setpoint_s setpoint = positionSetpoint(Vector3f(NAN, NAN, NAN));
+	_mpc.update(_states, setpoint, _dt);
+	EXPECT_FALSE(PX4_ISFINITE(setpoint.vx));
+	EXPECT_FALSE(PX4_ISFINITE(setpoint.acceleration[0]));
+	EXPECT_FALSE(PX4_ISFINITE(setpoint.acceleration[2]));
+}
+
+TEST_F(PositionControlMPCTest, ConvergesWithinLimits)
+{
+	const Vector3f target(10.f, -5.f, -3.f);
+	Vector3f acc_prev;
+
+	for (int i = 0; i < 1000; i++) {
+		vehicle_local_position_setpoint_s setpoint = positionSetpoint(target);
+		_mpc.update(_states, setpoint, _dt);
+
+		// position setpoints are replaced by velocity and acceleration feed-forward
+		EXPECT_FALSE(PX4_ISFINITE(setpoint.x));
+		EXPECT_TRUE(PX4_ISFINITE(setpoint.vx));
+
+		const Vector3f acc = step(setpoint);
+
+		// acceleration and jerk limits hold
+		EXPECT_LE(Vector2f(acc(0), acc(1)).norm(), 5.f + 1e-4f);
+		EXPECT_GE(acc(2), -4.f - 1e-4f);
+		EXPECT_LE(acc(2), 3.f + 1e-4f);
+
+		for (int axis = 0; axis < 3; axis++) {
+			EXPECT_LE(fabsf(acc(axis) - acc_prev(axis)), 8.f * _dt + 1e-4f);
+		}
+
+		acc_prev = acc;
+	}
+
+	// after 20 seconds the target is reached
+	EXPECT_LT((_states.position - target).norm(), 0.1f);
+	EXPECT_LT(_states.velocity.norm(), 0.1f);
+}
+
+TEST_F(PositionControlMPCTest, VelocityTracking)
+{
+	for (int i = 0; i < 500; i++) {
+		vehicle_local_position_setpoint_s setpoint = positionSetpoint(Vector3f(NAN, NAN, NAN));
+		setpoint.vx = 3.f;
+		setpoint.vy = 0.f;
+		_mpc.update(_states, setpoint, _dt);
+		step(setpoint);
+	}
+
+	EXPECT_NEAR(_states.velocity(0), 3.f, 0.05f);
+	EXPECT_NEAR(_states.velocity(1), 0.f, 0.05f);
+}
+
+TEST_F(PositionControlMPCTest, Benchmark)
+{
+	static constexpr int iterations = 1000;
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++) {
+		vehicle_local_position_setpoint_s setpoint = positionSetpoint(Vector3f(10.f, -5.f, -3.f));
+		_mpc.update(_states, setpoint, _dt);
+		step(setpoint);
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+	// the solver runs a fixed number of iterations, the time per update is bounded
+	printf("PositionControlMPC::update: %.1f ns per iteration\n", ns / iterations);
+	EXPECT_TRUE(PX4_ISFINITE(_states.position(0)));
+}
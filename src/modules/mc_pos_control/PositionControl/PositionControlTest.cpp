@@ -35,6 +35,9 @@
 #include <PositionControl.hpp>
 #include <px4_defines.h>
 
+#include <chrono>
+#include <cstdio>
+
 using namespace matrix;
 
 TEST(PositionControlTest, EmptySetpoint)
@@ -388,3 +391,31 @@ TEST_F(PositionControlBasicTest, UpdateHoverThrust)
 	// the output is still the same
 	EXPECT_EQ(_output_setpoint.thrust[2], -hover_thrust);
 }
+
+TEST_F(PositionControlBasicTest, Benchmark)
+{
+	// GIVEN: a position setpoint outside of the velocity and tilt limits
+	_input_setpoint.x = 10.f;
+	_input_setpoint.y = 10.f;
+	_input_setpoint.z = -10.f;
+
+	static constexpr int iterations = 10000;
+	bool all_valid = true;
+
+	// WHEN: we run the full controller cycle (including the attitude setpoint) many times
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++) {
+		all_valid = runController() && all_valid;
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+	printf("PositionControl cycle: %.1f ns per iteration\n", ns / iterations);
+
+	// THEN: the output stays valid and within the tilt limit
+	EXPECT_TRUE(all_valid);
+	const Vector3f body_z = Quatf(_attitude.q_d).dcm_z();
+	EXPECT_LE(acosf(body_z.dot(Vector3f(0.f, 0.f, 1.f))), 1.0001f);
+}
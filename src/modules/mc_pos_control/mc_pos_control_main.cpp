@@ -69,6 +69,7 @@
 #include <uORB/topics/hover_thrust_estimate.h>
 
 #include "PositionControl/PositionControl.hpp"
+#include "PositionControl/PositionControlMPC.hpp"
 #include "Takeoff/Takeoff.hpp"
 
 #include <float.h>
@@ -176,7 +177,19 @@ private:
 		(ParamInt<px4::params::MPC_ALT_MODE>) _param_mpc_alt_mode,
 		(ParamFloat<px4::params::MPC_TILTMAX_LND>) _param_mpc_tiltmax_lnd, /**< maximum tilt for landing and smooth takeoff */
 		(ParamFloat<px4::params::MPC_THR_MIN>) _param_mpc_thr_min,
-		(ParamFloat<px4::params::MPC_THR_MAX>) _param_mpc_thr_max
+		(ParamFloat<px4::params::MPC_THR_MAX>) _param_mpc_thr_max,
+
+		// Model-predictive position control
+		(ParamBool<px4::params::MPC_MPC_EN>) _param_mpc_mpc_en,
+		(ParamFloat<px4::params::MPC_MPC_DT>) _param_mpc_mpc_dt,
+		(ParamFloat<px4::params::MPC_MPC_W_POS>) _param_mpc_mpc_w_pos,
+		(ParamFloat<px4::params::MPC_MPC_W_VEL>) _param_mpc_mpc_w_vel,
+		(ParamFloat<px4::params::MPC_MPC_W_ACC>) _param_mpc_mpc_w_acc,
+		(ParamFloat<px4::params::MPC_MPC_W_JRK>) _param_mpc_mpc_w_jrk,
+		(ParamFloat<px4::params::MPC_ACC_HOR_MAX>) _param_mpc_acc_hor_max,
+		(ParamFloat<px4::params::MPC_ACC_UP_MAX>) _param_mpc_acc_up_max,
+		(ParamFloat<px4::params::MPC_ACC_DOWN_MAX>) _param_mpc_acc_down_max,
+		(ParamFloat<px4::params::MPC_JERK_MAX>) _param_mpc_jerk_max
 	);
 
 	control::BlockDerivative _vel_x_deriv; /**< velocity derivative in x */
@@ -185,6 +198,7 @@ private:
 
 	FlightTasks _flight_tasks; /**< class generating position controller setpoints depending on vehicle task */
 	PositionControl _control; /**< class for core PID position control */
+	PositionControlMPC _mpc; /**< model-predictive setpoint tracking in front of _control (MPC_MPC_EN) */
 	PositionControlStates _states{}; /**< structure containing vehicle state information for position control */
 
 	hrt_abstime _last_warn = 0; /**< timer when the last warn message was sent out */
@@ -210,6 +224,7 @@ private:
 	Vector3f _wv_dcm_z_sp_prev{0, 0, 1};
 
 	perf_counter_t _cycle_perf;
+	perf_counter_t _mpc_perf; /**< model-predictive planning time, the maximum is the worst case */
 
 	/**
 	 * Update our local parameter cache.
@@ -288,7 +303,8 @@ MulticopterPositionControl::MulticopterPositionControl(bool vtol) :
 	_vel_x_deriv(this, "VELD"),
 	_vel_y_deriv(this, "VELD"),
 	_vel_z_deriv(this, "VELD"),
-	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time"))
+	_cycle_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle time")),
+	_mpc_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": mpc"))
 {
 	if (vtol) {
 		// if vehicle is a VTOL we want to enable weathervane capabilities
@@ -307,6 +323,7 @@ MulticopterPositionControl::~MulticopterPositionControl()
 	delete _wv_controller;
 
 	perf_free(_cycle_perf);
+	perf_free(_mpc_perf);
 }
 
 bool
@@ -391,6 +408,12 @@ MulticopterPositionControl::parameters_update(bool force)
 			mavlink_log_critical(&_mavlink_log_pub, "Hover thrust has been constrained by min/max");
 		}
 
+		_mpc.setHorizonStep(_param_mpc_mpc_dt.get());
+		_mpc.setWeights(_param_mpc_mpc_w_pos.get(), _param_mpc_mpc_w_vel.get(), _param_mpc_mpc_w_acc.get(),
+				_param_mpc_mpc_w_jrk.get());
+		_mpc.setLimits(_param_mpc_acc_hor_max.get(), _param_mpc_acc_up_max.get(), _param_mpc_acc_down_max.get(),
+			       _param_mpc_jerk_max.get());
+
 		if (!_param_mpc_use_hte.get() || !_hover_thrust_initialized) {
 			_control.setHoverThrust(_param_mpc_thr_hover.get());
 			_hover_thrust_initialized = true;
@@ -526,6 +549,10 @@ MulticopterPositionControl::print_status()
 
 	perf_print_counter(_cycle_perf);
 
+	if (_param_mpc_mpc_en.get()) {
+		perf_print_counter(_mpc_perf);
+	}
+
 	return 0;
 }
 
@@ -658,6 +685,13 @@ MulticopterPositionControl::Run()
 				_flight_tasks.reActivate();
 			}
 
+			if (_param_mpc_mpc_en.get()) {
+				// plan the acceleration, the PID loops only compensate for disturbances
+				perf_begin(_mpc_perf);
+				_mpc.update(_states, setpoint, _dt);
+				perf_end(_mpc_perf);
+			}
+
 			// Run position control
 			_control.setState(_states);
 			_control.setConstraints(constraints);
@@ -721,6 +755,7 @@ MulticopterPositionControl::Run()
 			_vel_x_deriv.reset();
 			_vel_y_deriv.reset();
 			_vel_z_deriv.reset();
+			_mpc.reset();
 		}
 	}
 
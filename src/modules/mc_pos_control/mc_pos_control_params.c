@@ -763,3 +763,74 @@ PARAM_DEFINE_FLOAT(MPC_SPOOLUP_TIME, 1.0f);
  * @group Mission
  */
 PARAM_DEFINE_INT32(MPC_YAW_MODE, 0);
+
+/**
+ * Model-predictive position control
+ *
+ * If enabled, the position and velocity setpoints are tracked by a model-predictive
+ * planner (fixed horizon of 10 steps of MPC_MPC_DT) that respects the acceleration limits
+ * MPC_ACC_HOR_MAX, MPC_ACC_UP_MAX, MPC_ACC_DOWN_MAX and the jerk limit MPC_JERK_MAX,
+ * instead of the position P-loop. The velocity PID only compensates for disturbances.
+ *
+ * @boolean
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_INT32(MPC_MPC_EN, 0);
+
+/**
+ * Model-predictive position control horizon step
+ *
+ * The planning horizon covers 10 steps.
+ *
+ * @unit s
+ * @min 0.02
+ * @max 0.5
+ * @decimal 2
+ * @increment 0.01
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_FLOAT(MPC_MPC_DT, 0.1f);
+
+/**
+ * Model-predictive position control position error weight
+ *
+ * @min 0.0
+ * @max 100.0
+ * @decimal 2
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_FLOAT(MPC_MPC_W_POS, 1.0f);
+
+/**
+ * Model-predictive position control velocity error weight
+ *
+ * @min 0.0
+ * @max 100.0
+ * @decimal 2
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_FLOAT(MPC_MPC_W_VEL, 0.5f);
+
+/**
+ * Model-predictive position control acceleration weight
+ *
+ * Higher values lead to less aggressive acceleration.
+ *
+ * @min 0.0
+ * @max 10.0
+ * @decimal 3
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_FLOAT(MPC_MPC_W_ACC, 0.05f);
+
+/**
+ * Model-predictive position control jerk weight
+ *
+ * Higher values lead to smoother acceleration changes.
+ *
+ * @min 0.0
+ * @max 10.0
+ * @decimal 3
+ * @group Multicopter Position Control
+ */
+PARAM_DEFINE_FLOAT(MPC_MPC_W_JRK, 0.1f);
@@ -46,8 +46,12 @@ MulticopterRateControl::MulticopterRateControl(bool vtol) :
 	ModuleParams(nullptr),
 	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
 	_actuators_0_pub(vtol ? ORB_ID(actuator_controls_virtual_mc) : ORB_ID(actuator_controls_0)),
-	_loop_perf(perf_alloc(PC_ELAPSED, MODULE_NAME": cycle"))
+	_direct_output(!vtol),
+	_loop_perf(perf_alloc(PC_HISTOGRAM, MODULE_NAME": cycle"))
 {
+	// latency critical, run ahead of other work on the rate_ctrl queue
+	SetQueuePriority(200);
+
 	_vehicle_status.vehicle_type = vehicle_status_s::VEHICLE_TYPE_ROTARY_WING;
 
 	parameters_updated();
@@ -61,7 +65,15 @@ MulticopterRateControl::~MulticopterRateControl()
 bool
 MulticopterRateControl::init()
 {
-	if (!_vehicle_angular_velocity_sub.registerCallback()) {
+	_fifo_rate_control = _param_imu_gyro_fifo_rc.get();
+
+	if (_fifo_rate_control) {
+		if (!_vehicle_angular_velocity_fifo_sub.registerCallback()) {
+			PX4_ERR("vehicle_angular_velocity_fifo callback registration failed!");
+			return false;
+		}
+
+	} else if (!_vehicle_angular_velocity_sub.registerCallback()) {
 		PX4_ERR("vehicle_angular_velocity callback registration failed!");
 		return false;
 	}
@@ -125,30 +137,54 @@ MulticopterRateControl::Run()
 {
 	if (should_exit()) {
 		_vehicle_angular_velocity_sub.unregisterCallback();
+		_vehicle_angular_velocity_fifo_sub.unregisterCallback();
 		exit_and_cleanup();
 		return;
 	}
 
 	perf_begin(_loop_perf);
 
+	// check all polled topics for updates in one pass
+	_subscriptions.updated();
+
 	// Check if parameters have changed
-	if (_parameter_update_sub.updated()) {
+	if (_subscriptions.updated(SUB_PARAMETER_UPDATE)) {
 		// clear update
 		parameter_update_s param_update;
-		_parameter_update_sub.copy(&param_update);
+		_subscriptions.copy(SUB_PARAMETER_UPDATE, &param_update);
 
 		updateParams();
 		parameters_updated();
 	}
 
 	/* run controller on gyro changes */
-	vehicle_angular_velocity_s angular_velocity;
+	vehicle_angular_velocity_s angular_velocity{};
+	vehicle_angular_velocity_fifo_s angular_velocity_fifo{};
+	bool gyro_updated = false;
+
+	if (_fifo_rate_control) {
+		if (_vehicle_angular_velocity_fifo_sub.update(&angular_velocity_fifo) && (angular_velocity_fifo.samples > 0)) {
+			// the last sample of the block stands for the whole block outside of the rate controller
+			const int last = angular_velocity_fifo.samples - 1;
+			angular_velocity.timestamp_sample = angular_velocity_fifo.timestamp_sample;
+			angular_velocity.xyz[0] = angular_velocity_fifo.x[last];
+			angular_velocity.xyz[1] = angular_velocity_fifo.y[last];
+			angular_velocity.xyz[2] = angular_velocity_fifo.z[last];
+			gyro_updated = true;
+		}
 
-	if (_vehicle_angular_velocity_sub.update(&angular_velocity)) {
+	} else {
+		gyro_updated = _vehicle_angular_velocity_sub.update(&angular_velocity);
+	}
+
+	if (gyro_updated) {
 
 		// grab corresponding vehicle_angular_acceleration immediately after vehicle_angular_velocity copy
 		vehicle_angular_acceleration_s v_angular_acceleration{};
-		_vehicle_angular_acceleration_sub.copy(&v_angular_acceleration);
+
+		if (!_fifo_rate_control) {
+			_subscriptions.copy(SUB_VEHICLE_ANGULAR_ACCELERATION, &v_angular_acceleration);
+		}
 
 		const hrt_abstime now = hrt_absolute_time();
 
@@ -160,20 +196,20 @@ MulticopterRateControl::Run()
 		const Vector3f rates{angular_velocity.xyz};
 
 		/* check for updates in other topics */
-		_v_control_mode_sub.update(&_v_control_mode);
+		_subscriptions.update(SUB_VEHICLE_CONTROL_MODE, &_v_control_mode);
 
-		if (_vehicle_land_detected_sub.updated()) {
+		if (_subscriptions.updated(SUB_VEHICLE_LAND_DETECTED)) {
 			vehicle_land_detected_s vehicle_land_detected;
 
-			if (_vehicle_land_detected_sub.copy(&vehicle_land_detected)) {
+			if (_subscriptions.copy(SUB_VEHICLE_LAND_DETECTED, &vehicle_land_detected)) {
 				_landed = vehicle_land_detected.landed;
 				_maybe_landed = vehicle_land_detected.maybe_landed;
 			}
 		}
 
-		_vehicle_status_sub.update(&_vehicle_status);
+		_subscriptions.update(SUB_VEHICLE_STATUS, &_vehicle_status);
 
-		const bool manual_control_updated = _manual_control_sp_sub.update(&_manual_control_sp);
+		const bool manual_control_updated = _subscriptions.update(SUB_MANUAL_CONTROL_SETPOINT, &_manual_control_sp);
 
 		// generate the rate setpoint from sticks?
 		bool manual_rate_sp = false;
@@ -204,7 +240,7 @@ MulticopterRateControl::Run()
 			}
 
 		} else {
-			_landing_gear_sub.update(&_landing_gear);
+			_subscriptions.update(SUB_LANDING_GEAR, &_landing_gear);
 		}
 
 		if (manual_rate_sp) {
@@ -236,7 +272,7 @@ MulticopterRateControl::Run()
 			// use rates setpoint topic
 			vehicle_rates_setpoint_s v_rates_sp;
 
-			if (_v_rates_sp_sub.update(&v_rates_sp)) {
+			if (_subscriptions.update(SUB_VEHICLE_RATES_SETPOINT, &v_rates_sp)) {
 				_rates_sp(0) = v_rates_sp.roll;
 				_rates_sp(1) = v_rates_sp.pitch;
 				_rates_sp(2) = v_rates_sp.yaw;
@@ -253,10 +289,10 @@ MulticopterRateControl::Run()
 			}
 
 			// update saturation status from mixer feedback
-			if (_motor_limits_sub.updated()) {
+			if (_subscriptions.updated(SUB_MOTOR_LIMITS)) {
 				multirotor_motor_limits_s motor_limits;
 
-				if (_motor_limits_sub.copy(&motor_limits)) {
+				if (_subscriptions.copy(SUB_MOTOR_LIMITS, &motor_limits)) {
 					MultirotorMixer::saturation_status saturation_status;
 					saturation_status.value = motor_limits.saturation_status;
 
@@ -265,7 +301,21 @@ MulticopterRateControl::Run()
 			}
 
 			// run rate controller
-			const Vector3f att_control = _rate_control.update(rates, _rates_sp, angular_accel, dt, _maybe_landed || _landed);
+			Vector3f att_control;
+
+			if (_fifo_rate_control) {
+				// one control step per gyro sample, the result of the last sample is published
+				const float sample_dt = angular_velocity_fifo.dt * 1e-6f;
+
+				for (int n = 0; n < angular_velocity_fifo.samples; n++) {
+					const Vector3f sample_rates{angular_velocity_fifo.x[n], angular_velocity_fifo.y[n], angular_velocity_fifo.z[n]};
+					const Vector3f sample_accel{angular_velocity_fifo.accel_x[n], angular_velocity_fifo.accel_y[n], angular_velocity_fifo.accel_z[n]};
+					att_control = _rate_control.update(sample_rates, _rates_sp, sample_accel, sample_dt, _maybe_landed || _landed);
+				}
+
+			} else {
+				att_control = _rate_control.update(rates, _rates_sp, angular_accel, dt, _maybe_landed || _landed);
+			}
 
 			// publish rate controller status
 			rate_ctrl_status_s rate_ctrl_status{};
@@ -284,10 +334,10 @@ MulticopterRateControl::Run()
 
 			// scale effort by battery status if enabled
 			if (_param_mc_bat_scale_en.get()) {
-				if (_battery_status_sub.updated()) {
+				if (_subscriptions.updated(SUB_BATTERY_STATUS)) {
 					battery_status_s battery_status;
 
-					if (_battery_status_sub.copy(&battery_status)) {
+					if (_subscriptions.copy(SUB_BATTERY_STATUS, &battery_status)) {
 						_battery_status_scale = battery_status.scale;
 					}
 				}
@@ -302,6 +352,25 @@ MulticopterRateControl::Run()
 			actuators.timestamp = hrt_absolute_time();
 			_actuators_0_pub.publish(actuators);
 
+			if (_direct_output) {
+				MixingOutput::runDirectOutput(*this);
+			}
+
+			// torque and thrust setpoints for the control_allocator, thrust first as the allocator runs on the torque update
+			vehicle_thrust_setpoint_s vehicle_thrust_setpoint{};
+			vehicle_thrust_setpoint.timestamp_sample = actuators.timestamp_sample;
+			vehicle_thrust_setpoint.xyz[2] = -actuators.control[actuator_controls_s::INDEX_THROTTLE];
+			vehicle_thrust_setpoint.timestamp = hrt_absolute_time();
+			_vehicle_thrust_setpoint_pub.publish(vehicle_thrust_setpoint);
+
+			vehicle_torque_setpoint_s vehicle_torque_setpoint{};
+			vehicle_torque_setpoint.timestamp_sample = actuators.timestamp_sample;
+			vehicle_torque_setpoint.xyz[0] = actuators.control[actuator_controls_s::INDEX_ROLL];
+			vehicle_torque_setpoint.xyz[1] = actuators.control[actuator_controls_s::INDEX_PITCH];
+			vehicle_torque_setpoint.xyz[2] = actuators.control[actuator_controls_s::INDEX_YAW];
+			vehicle_torque_setpoint.timestamp = hrt_absolute_time();
+			_vehicle_torque_setpoint_pub.publish(vehicle_torque_setpoint);
+
 		} else if (_v_control_mode.flag_control_termination_enabled) {
 			if (!_vehicle_status.is_vtol) {
 				// publish actuator controls
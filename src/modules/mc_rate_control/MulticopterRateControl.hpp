@@ -36,6 +36,7 @@
 #include <RateControl.hpp>
 
 #include <lib/matrix/matrix/math.hpp>
+#include <lib/mixer_module/mixer_module.hpp>
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/module.h>
@@ -46,6 +47,7 @@
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
+#include <uORB/SubscriptionGroup.hpp>
 #include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/battery_status.h>
 #include <uORB/topics/landing_gear.h>
@@ -58,7 +60,10 @@
 #include <uORB/topics/vehicle_control_mode.h>
 #include <uORB/topics/vehicle_land_detected.h>
 #include <uORB/topics/vehicle_rates_setpoint.h>
+#include <uORB/topics/vehicle_angular_velocity_fifo.h>
 #include <uORB/topics/vehicle_status.h>
+#include <uORB/topics/vehicle_thrust_setpoint.h>
+#include <uORB/topics/vehicle_torque_setpoint.h>
 
 class MulticopterRateControl : public ModuleBase<MulticopterRateControl>, public ModuleParams, public px4::WorkItem
 {
@@ -93,23 +98,43 @@ private:
 
 	RateControl _rate_control; ///< class for rate control calculations
 
-	uORB::Subscription _battery_status_sub{ORB_ID(battery_status)};
-	uORB::Subscription _landing_gear_sub{ORB_ID(landing_gear)};
-	uORB::Subscription _manual_control_sp_sub{ORB_ID(manual_control_setpoint)};
-	uORB::Subscription _motor_limits_sub{ORB_ID(multirotor_motor_limits)};
-	uORB::Subscription _parameter_update_sub{ORB_ID(parameter_update)};
-	uORB::Subscription _v_control_mode_sub{ORB_ID(vehicle_control_mode)};
-	uORB::Subscription _v_rates_sp_sub{ORB_ID(vehicle_rates_setpoint)};
-	uORB::Subscription _vehicle_angular_acceleration_sub{ORB_ID(vehicle_angular_acceleration)};
-	uORB::Subscription _vehicle_land_detected_sub{ORB_ID(vehicle_land_detected)};
-	uORB::Subscription _vehicle_status_sub{ORB_ID(vehicle_status)};
+	// topics polled once per cycle, indices into _subscriptions
+	enum SubscriptionIndex : uint8_t {
+		SUB_BATTERY_STATUS,
+		SUB_LANDING_GEAR,
+		SUB_MANUAL_CONTROL_SETPOINT,
+		SUB_MOTOR_LIMITS,
+		SUB_PARAMETER_UPDATE,
+		SUB_VEHICLE_CONTROL_MODE,
+		SUB_VEHICLE_RATES_SETPOINT,
+		SUB_VEHICLE_ANGULAR_ACCELERATION,
+		SUB_VEHICLE_LAND_DETECTED,
+		SUB_VEHICLE_STATUS,
+		SUB_COUNT
+	};
+
+	uORB::SubscriptionGroup<SUB_COUNT> _subscriptions {
+		ORB_ID(battery_status),
+		ORB_ID(landing_gear),
+		ORB_ID(manual_control_setpoint),
+		ORB_ID(multirotor_motor_limits),
+		ORB_ID(parameter_update),
+		ORB_ID(vehicle_control_mode),
+		ORB_ID(vehicle_rates_setpoint),
+		ORB_ID(vehicle_angular_acceleration),
+		ORB_ID(vehicle_land_detected),
+		ORB_ID(vehicle_status)
+	};
 
 	uORB::SubscriptionCallbackWorkItem _vehicle_angular_velocity_sub{this, ORB_ID(vehicle_angular_velocity)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_angular_velocity_fifo_sub{this, ORB_ID(vehicle_angular_velocity_fifo)};
 
 	uORB::Publication<actuator_controls_s>		_actuators_0_pub;
 	uORB::PublicationMulti<rate_ctrl_status_s>	_controller_status_pub{ORB_ID(rate_ctrl_status), ORB_PRIO_DEFAULT};	/**< controller status publication */
 	uORB::Publication<landing_gear_s>		_landing_gear_pub{ORB_ID(landing_gear)};
 	uORB::Publication<vehicle_rates_setpoint_s>	_v_rates_sp_pub{ORB_ID(vehicle_rates_setpoint)};			/**< rate setpoint publication */
+	uORB::Publication<vehicle_thrust_setpoint_s>	_vehicle_thrust_setpoint_pub{ORB_ID(vehicle_thrust_setpoint)};		/**< thrust setpoint publication (control_allocator input) */
+	uORB::Publication<vehicle_torque_setpoint_s>	_vehicle_torque_setpoint_pub{ORB_ID(vehicle_torque_setpoint)};		/**< torque setpoint publication (control_allocator input) */
 
 	landing_gear_s 			_landing_gear{};
 	manual_control_setpoint_s	_manual_control_sp{};
@@ -117,6 +142,8 @@ private:
 	vehicle_status_s		_vehicle_status{};
 
 	bool _actuators_0_circuit_breaker_enabled{false};	/**< circuit breaker to suppress output */
+	const bool _direct_output;				/**< publishing actuator_controls_0, run the output module inline (MOT_DIRECT_OUT) */
+	bool _fifo_rate_control{false};				/**< one control step per gyro FIFO sample (IMU_GYRO_FIFO_RC) */
 	bool _landed{true};
 	bool _maybe_landed{true};
 
@@ -168,7 +195,9 @@ private:
 
 		(ParamBool<px4::params::MC_BAT_SCALE_EN>) _param_mc_bat_scale_en,
 
-		(ParamInt<px4::params::CBRK_RATE_CTRL>) _param_cbrk_rate_ctrl
+		(ParamInt<px4::params::CBRK_RATE_CTRL>) _param_cbrk_rate_ctrl,
+
+		(ParamBool<px4::params::IMU_GYRO_FIFO_RC>) _param_imu_gyro_fifo_rc
 	)
 
 	matrix::Vector3f _acro_rate_max;	/**< max attitude rates in acro mode */
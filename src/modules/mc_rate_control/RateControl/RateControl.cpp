@@ -42,50 +42,55 @@ using namespace matrix;
 
 void RateControl::setGains(const Vector3f &P, const Vector3f &I, const Vector3f &D)
 {
-	_gain_p = P;
-	_gain_i = I;
-	_gain_d = D;
+	setLanes(_gain_p, P);
+	setLanes(_gain_i, I);
+	setLanes(_gain_d, D);
 }
 
 void RateControl::setSaturationStatus(const MultirotorMixer::saturation_status &status)
 {
-	_mixer_saturation_positive[0] = status.flags.roll_pos;
-	_mixer_saturation_positive[1] = status.flags.pitch_pos;
-	_mixer_saturation_positive[2] = status.flags.yaw_pos;
-	_mixer_saturation_negative[0] = status.flags.roll_neg;
-	_mixer_saturation_negative[1] = status.flags.pitch_neg;
-	_mixer_saturation_negative[2] = status.flags.yaw_neg;
+	const bool saturation_positive[3] {status.flags.roll_pos, status.flags.pitch_pos, status.flags.yaw_pos};
+	const bool saturation_negative[3] {status.flags.roll_neg, status.flags.pitch_neg, status.flags.yaw_neg};
+
+	for (int i = 0; i < 3; i++) {
+		// prevent further positive/negative control saturation
+		_integral_error_max[i] = saturation_positive[i] ? 0.f : INFINITY;
+		_integral_error_min[i] = saturation_negative[i] ? 0.f : -INFINITY;
+	}
 }
 
 Vector3f RateControl::update(const Vector3f &rate, const Vector3f &rate_sp, const Vector3f &angular_accel,
 			     const float dt, const bool landed)
 {
-	// angular rates error
-	Vector3f rate_error = rate_sp - rate;
+	alignas(16) const float rate_lanes[LANES] {rate(0), rate(1), rate(2), 0.f};
+	alignas(16) const float rate_sp_lanes[LANES] {rate_sp(0), rate_sp(1), rate_sp(2), 0.f};
+	alignas(16) const float angular_accel_lanes[LANES] {angular_accel(0), angular_accel(1), angular_accel(2), 0.f};
+
+	alignas(16) float rate_error[LANES];
+	alignas(16) float torque[LANES];
 
-	// PID control with feed forward
-	const Vector3f torque = _gain_p.emult(rate_error) + _rate_int - _gain_d.emult(angular_accel) + _gain_ff.emult(rate_sp);
+	for (int i = 0; i < LANES; i++) {
+		// angular rates error
+		rate_error[i] = rate_sp_lanes[i] - rate_lanes[i];
+
+		// PID control with feed forward
+		torque[i] = _gain_p[i] * rate_error[i] + _rate_int[i] - _gain_d[i] * angular_accel_lanes[i]
+			    + _gain_ff[i] * rate_sp_lanes[i];
+	}
 
 	// update integral only if we are not landed
 	if (!landed) {
 		updateIntegral(rate_error, dt);
 	}
 
-	return torque;
+	return Vector3f(torque[0], torque[1], torque[2]);
 }
 
-void RateControl::updateIntegral(Vector3f &rate_error, const float dt)
+void RateControl::updateIntegral(const float rate_error[LANES], const float dt)
 {
-	for (int i = 0; i < 3; i++) {
-		// prevent further positive control saturation
-		if (_mixer_saturation_positive[i]) {
-			rate_error(i) = math::min(rate_error(i), 0.f);
-		}
-
-		// prevent further negative control saturation
-		if (_mixer_saturation_negative[i]) {
-			rate_error(i) = math::max(rate_error(i), 0.f);
-		}
+	for (int i = 0; i < LANES; i++) {
+		// prevent further control saturation
+		const float error = math::constrain(rate_error[i], _integral_error_min[i], _integral_error_max[i]);
 
 		// I term factor: reduce the I gain with increasing rate error.
 		// This counteracts a non-linear effect where the integral builds up quickly upon a large setpoint
@@ -93,22 +98,20 @@ void RateControl::updateIntegral(Vector3f &rate_error, const float dt)
 		// The formula leads to a gradual decrease w/o steps, while only affecting the cases where it should:
 		// with the parameter set to 400 degrees, up to 100 deg rate error, i_factor is almost 1 (having no effect),
 		// and up to 200 deg error leads to <25% reduction of I.
-		float i_factor = rate_error(i) / math::radians(400.f);
+		float i_factor = error / math::radians(400.f);
 		i_factor = math::max(0.0f, 1.f - i_factor * i_factor);
 
 		// Perform the integration using a first order method
-		float rate_i = _rate_int(i) + i_factor * _gain_i(i) * rate_error(i) * dt;
+		const float rate_i = _rate_int[i] + i_factor * _gain_i[i] * error * dt;
 
 		// do not propagate the result if out of range or invalid
-		if (PX4_ISFINITE(rate_i)) {
-			_rate_int(i) = math::constrain(rate_i, -_lim_int(i), _lim_int(i));
-		}
+		_rate_int[i] = PX4_ISFINITE(rate_i) ? math::constrain(rate_i, -_lim_int[i], _lim_int[i]) : _rate_int[i];
 	}
 }
 
 void RateControl::getRateControlStatus(rate_ctrl_status_s &rate_ctrl_status)
 {
-	rate_ctrl_status.rollspeed_integ = _rate_int(0);
-	rate_ctrl_status.pitchspeed_integ = _rate_int(1);
-	rate_ctrl_status.yawspeed_integ = _rate_int(2);
+	rate_ctrl_status.rollspeed_integ = _rate_int[0];
+	rate_ctrl_status.pitchspeed_integ = _rate_int[1];
+	rate_ctrl_status.yawspeed_integ = _rate_int[2];
 }
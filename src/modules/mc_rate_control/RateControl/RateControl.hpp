@@ -63,14 +63,14 @@ public:
 	 * Set the mximum absolute value of the integrator for all axes
 	 * @param integrator_limit limit value for all axes x, y, z
 	 */
-	void setIntegratorLimit(const matrix::Vector3f &integrator_limit) { _lim_int = integrator_limit; };
+	void setIntegratorLimit(const matrix::Vector3f &integrator_limit) { setLanes(_lim_int, integrator_limit); };
 
 	/**
 	 * Set direct rate to torque feed forward gain
 	 * @see _gain_ff
 	 * @param FF 3D vector of feed forward gains for body x,y,z axis
 	 */
-	void setFeedForwardGain(const matrix::Vector3f &FF) { _gain_ff = FF; };
+	void setFeedForwardGain(const matrix::Vector3f &FF) { setLanes(_gain_ff, FF); };
 
 	/**
 	 * Set saturation status
@@ -92,7 +92,7 @@ public:
 	 * Set the integral term to 0 to prevent windup
 	 * @see _rate_int
 	 */
-	void resetIntegral() { _rate_int.zero(); }
+	void resetIntegral() { setLanes(_rate_int, matrix::Vector3f()); }
 
 	/**
 	 * Get status message of controller for logging/debugging
@@ -101,18 +101,34 @@ public:
 	void getRateControlStatus(rate_ctrl_status_s &rate_ctrl_status);
 
 private:
-	void updateIntegral(matrix::Vector3f &rate_error, const float dt);
+	/**
+	 * The x, y, z axes are processed as 4 lanes (lane 3 is padding and stays 0),
+	 * so that all per axis loops are branch-free over a fixed count of aligned floats
+	 * and can be vectorized or fully unrolled by the compiler.
+	 */
+	static constexpr int LANES = 4;
+
+	static void setLanes(float lanes[LANES], const matrix::Vector3f &v)
+	{
+		lanes[0] = v(0);
+		lanes[1] = v(1);
+		lanes[2] = v(2);
+		lanes[3] = 0.f;
+	}
+
+	void updateIntegral(const float rate_error[LANES], const float dt);
 
 	// Gains
-	matrix::Vector3f _gain_p; ///< rate control proportional gain for all axes x, y, z
-	matrix::Vector3f _gain_i; ///< rate control integral gain
-	matrix::Vector3f _gain_d; ///< rate control derivative gain
-	matrix::Vector3f _lim_int; ///< integrator term maximum absolute value
-	matrix::Vector3f _gain_ff; ///< direct rate to torque feed forward gain only useful for helicopters
+	alignas(16) float _gain_p[LANES] {}; ///< rate control proportional gain for all axes x, y, z
+	alignas(16) float _gain_i[LANES] {}; ///< rate control integral gain
+	alignas(16) float _gain_d[LANES] {}; ///< rate control derivative gain
+	alignas(16) float _lim_int[LANES] {}; ///< integrator term maximum absolute value
+	alignas(16) float _gain_ff[LANES] {}; ///< direct rate to torque feed forward gain only useful for helicopters
 
 	// States
-	matrix::Vector3f _rate_int; ///< integral term of the rate controller
+	alignas(16) float _rate_int[LANES] {}; ///< integral term of the rate controller
 
-	bool _mixer_saturation_positive[3] {};
-	bool _mixer_saturation_negative[3] {};
+	// rate error limits applied to the integration to prevent further mixer saturation (0 if saturated, infinite otherwise)
+	alignas(16) float _integral_error_min[LANES] {-INFINITY, -INFINITY, -INFINITY, -INFINITY};
+	alignas(16) float _integral_error_max[LANES] {INFINITY, INFINITY, INFINITY, INFINITY};
 };
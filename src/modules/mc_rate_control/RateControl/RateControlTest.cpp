@@ -34,6 +34,10 @@
 #include <gtest/gtest.h>
 #include <RateControl.hpp>
 
+#include <chrono>
+#include <cstdio>
+#include <px4_platform_common/defines.h>
+
 using namespace matrix;
 
 TEST(RateControlTest, AllZeroCase)
@@ -42,3 +46,87 @@ TEST(RateControlTest, AllZeroCase)
 	Vector3f torque = rate_control.update(Vector3f(), Vector3f(), Vector3f(), 0.f, false);
 	EXPECT_EQ(torque, Vector3f());
 }
+
+TEST(RateControlTest, PidFeedForward)
+{
+	RateControl rate_control;
+	rate_control.setGains(Vector3f(0.15f, 0.15f, 0.2f), Vector3f(0.2f, 0.2f, 0.1f), Vector3f(0.003f, 0.003f, 0.f));
+	rate_control.setFeedForwardGain(Vector3f(0.f, 0.f, 0.1f));
+	rate_control.setIntegratorLimit(Vector3f(0.3f, 0.3f, 0.3f));
+
+	const Vector3f rate(0.1f, -0.2f, 0.3f);
+	const Vector3f rate_sp(0.5f, 0.5f, -0.5f);
+	const Vector3f angular_accel(1.f, -2.f, 3.f);
+	const Vector3f rate_error = rate_sp - rate;
+
+	// first update: integral still zero
+	const Vector3f torque = rate_control.update(rate, rate_sp, angular_accel, 0.01f, false);
+	const Vector3f expected = Vector3f(0.15f, 0.15f, 0.2f).emult(rate_error)
+				  - Vector3f(0.003f, 0.003f, 0.f).emult(angular_accel)
+				  + Vector3f(0.f, 0.f, 0.1f).emult(rate_sp);
+	EXPECT_TRUE(isEqual(torque, expected));
+
+	// integral got updated and is applied on the second update
+	rate_ctrl_status_s status{};
+	rate_control.getRateControlStatus(status);
+	EXPECT_GT(status.rollspeed_integ, 0.f);
+	EXPECT_GT(status.pitchspeed_integ, 0.f);
+	EXPECT_LT(status.yawspeed_integ, 0.f);
+
+	const Vector3f torque2 = rate_control.update(rate, rate_sp, angular_accel, 0.01f, false);
+	EXPECT_TRUE(isEqual(torque2 - torque, Vector3f(status.rollspeed_integ, status.pitchspeed_integ,
+			    status.yawspeed_integ)));
+}
+
+TEST(RateControlTest, IntegratorSaturation)
+{
+	RateControl rate_control;
+	rate_control.setGains(Vector3f(), Vector3f(1.f, 1.f, 1.f), Vector3f());
+	rate_control.setIntegratorLimit(Vector3f(0.1f, 0.1f, 0.1f));
+
+	// roll saturated positive, pitch saturated negative
+	MultirotorMixer::saturation_status saturation_status{};
+	saturation_status.flags.roll_pos = true;
+	saturation_status.flags.pitch_neg = true;
+	rate_control.setSaturationStatus(saturation_status);
+
+	for (int i = 0; i < 100; i++) {
+		rate_control.update(Vector3f(), Vector3f(1.f, -1.f, 1.f), Vector3f(), 0.01f, false);
+	}
+
+	rate_ctrl_status_s status{};
+	rate_control.getRateControlStatus(status);
+	EXPECT_FLOAT_EQ(status.rollspeed_integ, 0.f);
+	EXPECT_FLOAT_EQ(status.pitchspeed_integ, 0.f);
+	EXPECT_FLOAT_EQ(status.yawspeed_integ, 0.1f);
+
+	// no integration when landed
+	rate_control.resetIntegral();
+	rate_control.update(Vector3f(), Vector3f(1.f, 1.f, 1.f), Vector3f(), 0.01f, true);
+	rate_control.getRateControlStatus(status);
+	EXPECT_FLOAT_EQ(status.yawspeed_integ, 0.f);
+}
+
+TEST(RateControlTest, Benchmark)
+{
+	RateControl rate_control;
+	rate_control.setGains(Vector3f(0.15f, 0.15f, 0.2f), Vector3f(0.2f, 0.2f, 0.1f), Vector3f(0.003f, 0.003f, 0.f));
+	rate_control.setIntegratorLimit(Vector3f(0.3f, 0.3f, 0.3f));
+
+	static constexpr int iterations = 100000;
+	Vector3f rate;
+	Vector3f torque_sum;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < iterations; i++) {
+		rate(i % 3) = 0.001f * (i % 100);
+		torque_sum += rate_control.update(rate, Vector3f(0.1f, 0.2f, 0.3f), rate, 1.f / 8000.f, false);
+	}
+
+	const auto end = std::chrono::steady_clock::now();
+	const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+	printf("RateControl::update: %.1f ns per iteration\n", ns / iterations);
+	EXPECT_TRUE(PX4_ISFINITE(torque_sum(0)) && PX4_ISFINITE(torque_sum(1)) && PX4_ISFINITE(torque_sum(2)));
+}
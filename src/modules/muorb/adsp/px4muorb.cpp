@@ -43,6 +43,7 @@
 #include <parameters/param.h>
 #include <px4_platform_common/shmem.h>
 #include <px4_platform_common/log.h>
+#include <string.h>
 
 __BEGIN_DECLS
 extern int dspal_main(int argc, char *argv[]);
@@ -79,37 +80,23 @@ int px4muorb_get_absolute_time(uint64_t *time_us)
 	return 0;
 }
 
-/*update value and param's change bit in shared memory*/
-int px4muorb_param_update_to_shmem(uint32_t param, const uint8_t *value,
-				   int data_len_in_bytes)
+/*update values and the params' change bits in shared memory*/
+int px4muorb_param_update_batch_to_shmem(const uint8_t *data, int data_len_in_bytes)
 {
-	unsigned int byte_changed, bit_changed;
-	union param_value_u *param_value = (union param_value_u *) value;
+	uint32_t count;
 
-	if (!shmem_info_p) {
-		init_shared_memory();
-	}
-
-	if (get_shmem_lock(__FILE__, __LINE__) != 0) {
-		PX4_INFO("Could not get shmem lock\n");
+	if (data_len_in_bytes < (int)sizeof(count)) {
 		return -1;
 	}
 
-	shmem_info_p->params_val[param] = *param_value;
-
-	byte_changed = param / 8;
-	bit_changed = 1 << param % 8;
-	shmem_info_p->krait_changed_index[byte_changed] |= bit_changed;
+	memcpy(&count, data, sizeof(count));
 
-	release_shmem_lock(__FILE__, __LINE__);
-
-	return 0;
-}
+	if (count > PARAM_UPDATE_BATCH_SIZE || data_len_in_bytes < (int)(sizeof(count) + count * sizeof(shmem_param_update))) {
+		return -1;
+	}
 
-int px4muorb_param_update_index_from_shmem(unsigned char *data, int data_len_in_bytes)
-{
 	if (!shmem_info_p) {
-		return -1;
+		init_shared_memory();
 	}
 
 	if (get_shmem_lock(__FILE__, __LINE__) != 0) {
@@ -117,8 +104,15 @@ int px4muorb_param_update_index_from_shmem(unsigned char *data, int data_len_in_
 		return -1;
 	}
 
-	for (int i = 0; i < data_len_in_bytes; i++) {
-		data[i] = shmem_info_p->adsp_changed_index[i];
+	const shmem_param_update *updates = (const shmem_param_update *)(data + sizeof(count));
+
+	for (uint32_t i = 0; i < count; i++) {
+		const uint32_t param = updates[i].param;
+
+		if (param < MAX_SHMEM_PARAMS) {
+			shmem_info_p->params_val[param] = updates[i].value;
+			shmem_info_p->krait_changed_index[param / 8] |= 1 << param % 8;
+		}
 	}
 
 	release_shmem_lock(__FILE__, __LINE__);
@@ -126,13 +120,12 @@ int px4muorb_param_update_index_from_shmem(unsigned char *data, int data_len_in_
 	return 0;
 }
 
-int px4muorb_param_update_value_from_shmem(uint32_t param, const uint8_t *value,
-		int data_len_in_bytes)
+/*get the values of the params changed by the adsp and clear their change bits*/
+int px4muorb_param_update_values_from_shmem(uint8_t *data, int data_len_in_bytes)
 {
-	unsigned int byte_changed, bit_changed;
-	union param_value_u *param_value = (union param_value_u *) value;
+	uint32_t count = 0;
 
-	if (!shmem_info_p) {
+	if (!shmem_info_p || data_len_in_bytes < (int)PARAM_UPDATE_BUFFER_SIZE) {
 		return -1;
 	}
 
@@ -141,15 +134,27 @@ int px4muorb_param_update_value_from_shmem(uint32_t param, const uint8_t *value,
 		return -1;
 	}
 
-	*param_value = shmem_info_p->params_val[param];
+	shmem_param_update *updates = (shmem_param_update *)(data + sizeof(count));
+
+	// only the changed bytes of the index need to be looked at, params that don't fit into
+	// this batch keep their change bit and are returned with the next call
+	for (int i = 0; i < PARAM_BUFFER_SIZE && count < PARAM_UPDATE_BATCH_SIZE; i++) {
+		while (shmem_info_p->adsp_changed_index[i] != 0 && count < PARAM_UPDATE_BATCH_SIZE) {
+			const unsigned bit = __builtin_ctz(shmem_info_p->adsp_changed_index[i]);
+			const uint32_t param = i * 8 + bit;
+
+			updates[count].param = param;
+			updates[count].value = shmem_info_p->params_val[param];
+			count++;
 
-	/*also clear the index since we are holding the lock*/
-	byte_changed = param / 8;
-	bit_changed = 1 << param % 8;
-	shmem_info_p->adsp_changed_index[byte_changed] &= ~bit_changed;
+			shmem_info_p->adsp_changed_index[i] &= ~(1 << bit);
+		}
+	}
 
 	release_shmem_lock(__FILE__, __LINE__);
 
+	memcpy(data, &count, sizeof(count));
+
 	return 0;
 }
 
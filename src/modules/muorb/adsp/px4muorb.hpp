@@ -42,11 +42,9 @@ extern "C" {
 
 	int px4muorb_get_absolute_time(uint64_t *time_us) __EXPORT;
 
-	int px4muorb_param_update_to_shmem(uint32_t param, const uint8_t *value, int data_len_in_bytes) __EXPORT;
+	int px4muorb_param_update_batch_to_shmem(const uint8_t *data, int data_len_in_bytes) __EXPORT;
 
-	int px4muorb_param_update_index_from_shmem(unsigned char *data, int data_len_in_bytes) __EXPORT;
-
-	int px4muorb_param_update_value_from_shmem(uint32_t param, const uint8_t *value, int data_len_in_bytes) __EXPORT;
+	int px4muorb_param_update_values_from_shmem(uint8_t *data, int data_len_in_bytes) __EXPORT;
 
 	int px4muorb_topic_advertised(const char *name) __EXPORT;
 
@@ -67,7 +67,9 @@ static const uint32_t _MAX_BULK_TRANSFER_BUFFER_SIZE =
 	_MAX_TOPIC_DATA_BUFFER_SIZE * _MAX_TOPICS;
 static uint8_t *_BulkTransferBuffer = 0;
 
-unsigned char *adsp_changed_index = 0;
+// batched parameter transfers to and from the adsp
+unsigned char *param_updates_to_adsp = 0;
+unsigned char *param_updates_from_adsp = 0;
 
 // The DSP timer can be read from this file.
 #define DSP_TIMER_FILE "/sys/kernel/boot_adsp/qdsp_qtimer"
@@ -204,16 +206,19 @@ bool px4muorb::KraitRpcWrapper::Initialize()
 		PX4_DEBUG("%s rpcmem_alloc passed for data_buffer", __FUNCTION__);
 	}
 
-	adsp_changed_index = (uint8_t *) rpcmem_alloc(MUORB_KRAIT_FASTRPC_HEAP_ID,
-			     MUORB_KRAIT_FASTRPC_MEM_FLAGS, PARAM_BUFFER_SIZE * sizeof(uint8_t));
+	param_updates_to_adsp = (uint8_t *) rpcmem_alloc(MUORB_KRAIT_FASTRPC_HEAP_ID,
+				MUORB_KRAIT_FASTRPC_MEM_FLAGS, PARAM_UPDATE_BUFFER_SIZE);
+	param_updates_from_adsp = (uint8_t *) rpcmem_alloc(MUORB_KRAIT_FASTRPC_HEAP_ID,
+				  MUORB_KRAIT_FASTRPC_MEM_FLAGS, PARAM_UPDATE_BUFFER_SIZE);
 
-	rc = (adsp_changed_index != NULL) ? true : false;
+	rc = (param_updates_to_adsp != NULL && param_updates_from_adsp != NULL) ? true : false;
 
 	if (!rc) {
-		PX4_ERR("%s rpcmem_alloc failed! for adsp_changed_index", __FUNCTION__);
+		PX4_ERR("%s rpcmem_alloc failed! for param update buffers", __FUNCTION__);
 
 	} else {
-		memset(adsp_changed_index, 0, PARAM_BUFFER_SIZE * sizeof(uint8_t));
+		memset(param_updates_to_adsp, 0, PARAM_UPDATE_BUFFER_SIZE);
+		memset(param_updates_from_adsp, 0, PARAM_UPDATE_BUFFER_SIZE);
 	}
 
 	int32_t time_diff_us;
@@ -265,9 +270,14 @@ bool px4muorb::KraitRpcWrapper::Terminate()
 		_DataBuffer = 0;
 	}
 
-	if (adsp_changed_index != NULL) {
-		rpcmem_free(adsp_changed_index);
-		adsp_changed_index = 0;
+	if (param_updates_to_adsp != NULL) {
+		rpcmem_free(param_updates_to_adsp);
+		param_updates_to_adsp = 0;
+	}
+
+	if (param_updates_from_adsp != NULL) {
+		rpcmem_free(param_updates_from_adsp);
+		param_updates_from_adsp = 0;
 	}
 
 	_Initialized = false;
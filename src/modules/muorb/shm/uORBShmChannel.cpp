@@ -0,0 +1,268 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "uORBShmChannel.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/sem.hpp>
+#include <px4_platform_common/time.h>
+
+uORB::ShmChannel *uORB::ShmChannel::_InstancePtr = nullptr;
+
+uORB::ShmChannel::ShmChannel()
+{
+	px4_sem_init(&_lock, 0, 1);
+	px4_sem_init(&_add_lock, 0, 1);
+}
+
+uORB::ShmChannel::~ShmChannel()
+{
+	Stop();
+	px4_sem_destroy(&_lock);
+	px4_sem_destroy(&_add_lock);
+}
+
+int uORB::ShmChannel::Start()
+{
+	SmartLock smart_lock(_lock);
+
+	if (_segment.load() != nullptr) {
+		return 0;
+	}
+
+	// always start from a clean segment
+	shm_unlink(UORB_SHM_SEGMENT_NAME);
+
+	int fd = shm_open(UORB_SHM_SEGMENT_NAME, O_CREAT | O_RDWR, 0644);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", UORB_SHM_SEGMENT_NAME, errno);
+		return -1;
+	}
+
+	if (ftruncate(fd, sizeof(uorb_shm_segment)) != 0) {
+		PX4_ERR("ftruncate failed (%i)", errno);
+		close(fd);
+		shm_unlink(UORB_SHM_SEGMENT_NAME);
+		return -1;
+	}
+
+	void *mem = mmap(nullptr, sizeof(uorb_shm_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (mem == MAP_FAILED) {
+		PX4_ERR("mmap failed (%i)", errno);
+		shm_unlink(UORB_SHM_SEGMENT_NAME);
+		return -1;
+	}
+
+	memset(_name_cache, 0, sizeof(_name_cache));
+	memset(_instance_cache, 0, sizeof(_instance_cache));
+
+	uorb_shm_segment *segment = (uorb_shm_segment *)mem;
+	segment->version = UORB_SHM_VERSION;
+	segment->topic_count = 0;
+	segment->data_used = 0;
+	__atomic_store_n(&segment->magic, UORB_SHM_MAGIC, __ATOMIC_RELEASE);
+
+	_segment.store(segment);
+
+	return 0;
+}
+
+void uORB::ShmChannel::Stop()
+{
+	SmartLock smart_lock(_lock);
+
+	uorb_shm_segment *segment = _segment.load();
+
+	if (segment != nullptr) {
+		_segment.store(nullptr);
+
+		// publishers that picked up the segment before it was cleared are still writing,
+		// they never wait for _lock
+		while (_writers.load() > 0) {
+			px4_usleep(1000);
+		}
+
+		__atomic_store_n(&segment->magic, 0, __ATOMIC_RELEASE);
+		munmap(segment, sizeof(uorb_shm_segment));
+
+		shm_unlink(UORB_SHM_SEGMENT_NAME);
+	}
+}
+
+void uORB::ShmChannel::print_status()
+{
+	SmartLock smart_lock(_lock);
+
+	const uorb_shm_segment *segment = _segment.load();
+
+	if (segment == nullptr) {
+		PX4_INFO("not running");
+		return;
+	}
+
+	PX4_INFO("segment %s: %i topics, %i/%i bytes used, %i messages not exported", UORB_SHM_SEGMENT_NAME,
+		 (int)segment->topic_count, (int)segment->data_used, UORB_SHM_DATA_SIZE, (int)_dropped_messages.load());
+
+	for (uint32_t i = 0; i < segment->topic_count; i++) {
+		const uorb_shm_topic &topic = segment->topics[i];
+		PX4_INFO_RAW("  %-40s instance: %i, size: %4i, published: %i\n", topic.name, (int)topic.instance,
+			     (int)topic.size, (int)__atomic_load_n(&topic.generation, __ATOMIC_RELAXED));
+	}
+}
+
+int uORB::ShmChannel::find_topic(const uorb_shm_segment *segment, const char *messageName, uint8_t instance) const
+{
+	// entries and their cached name and instance are complete before topic_count includes them
+	const uint32_t count = __atomic_load_n(&segment->topic_count, __ATOMIC_ACQUIRE);
+
+	// uORB always passes the same name pointer for a topic
+	for (uint32_t i = 0; i < count; i++) {
+		if ((_name_cache[i] == messageName) && (_instance_cache[i] == instance)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int uORB::ShmChannel::find_or_add_topic(uorb_shm_segment *segment, const char *messageName, uint8_t instance,
+		int32_t length)
+{
+	const uint32_t count = segment->topic_count;
+
+	for (uint32_t i = 0; i < count; i++) {
+		if ((_instance_cache[i] == instance) && ((_name_cache[i] == messageName)
+				|| (strncmp(segment->topics[i].name, messageName, UORB_SHM_NAME_LEN) == 0))) {
+			return i;
+		}
+	}
+
+	// add a new entry
+	const uint32_t data_size = (((uint32_t)length * UORB_SHM_SLOTS) + 7u) & ~7u;
+
+	if ((count >= UORB_SHM_MAX_TOPICS) || (segment->data_used + data_size > UORB_SHM_DATA_SIZE)) {
+		return -1;
+	}
+
+	uorb_shm_topic &topic = segment->topics[count];
+	strncpy(topic.name, messageName, UORB_SHM_NAME_LEN - 1);
+	topic.name[UORB_SHM_NAME_LEN - 1] = '\0';
+	topic.instance = instance;
+	topic.size = length;
+	topic.data_offset = segment->data_used;
+	topic.generation = 0;
+
+	for (int slot = 0; slot < UORB_SHM_SLOTS; slot++) {
+		// tag of a generation that is never read from this slot
+		topic.slot_tag[slot] = 1;
+	}
+
+	segment->data_used += data_size;
+	_name_cache[count] = messageName;
+	_instance_cache[count] = instance;
+
+	// publish the entry to readers and to find_topic()
+	__atomic_store_n(&segment->topic_count, count + 1, __ATOMIC_RELEASE);
+
+	return count;
+}
+
+int16_t uORB::ShmChannel::topic_advertised(const char *messageName)
+{
+	// entries are created with the first message, when the size is known
+	return 0;
+}
+
+int16_t uORB::ShmChannel::send_message(const char *messageName, int32_t length, uint8_t *data)
+{
+	return send_message(messageName, 0, length, data);
+}
+
+int16_t uORB::ShmChannel::send_message(const char *messageName, uint8_t instance, int32_t length, uint8_t *data)
+{
+	if ((messageName == nullptr) || (data == nullptr) || (length <= 0)) {
+		return -1;
+	}
+
+	// register before picking up the segment, so Stop() can't unmap it while in use
+	_writers.fetch_add(1);
+
+	uorb_shm_segment *segment = _segment.load();
+
+	if (segment != nullptr) {
+		int index = find_topic(segment, messageName, instance);
+
+		if (index < 0) {
+			SmartLock smart_lock(_add_lock);
+			index = find_or_add_topic(segment, messageName, instance, length);
+		}
+
+		bool expected = false;
+
+		// not an error for the publisher, the message is simply not exported
+		if ((index < 0) || (segment->topics[index].size != (uint32_t)length)) {
+			_dropped_messages.fetch_add(1);
+
+		} else if (!_writing[index].compare_exchange(&expected, true)) {
+			// another publisher of the same topic is writing right now
+			_dropped_messages.fetch_add(1);
+
+		} else {
+			uorb_shm_topic &topic = segment->topics[index];
+
+			const uint32_t generation = topic.generation;
+			const uint32_t slot = generation % UORB_SHM_SLOTS;
+
+			// mark the slot busy, copy and only then make the new generation visible
+			__atomic_store_n(&topic.slot_tag[slot], (generation << 1) | 1, __ATOMIC_RELAXED);
+			__atomic_thread_fence(__ATOMIC_RELEASE);
+			memcpy(&segment->data[topic.data_offset + slot * topic.size], data, length);
+			__atomic_store_n(&topic.slot_tag[slot], generation << 1, __ATOMIC_RELEASE);
+			__atomic_store_n(&topic.generation, generation + 1, __ATOMIC_RELEASE);
+
+			_writing[index].store(false);
+		}
+	}
+
+	_writers.fetch_sub(1);
+
+	return 0;
+}
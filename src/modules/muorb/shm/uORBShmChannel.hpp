@@ -0,0 +1,133 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/sem.h>
+#include <uORB/uORBCommunicator.hpp>
+
+#include "uORBShmLayout.h"
+
+namespace uORB
+{
+class ShmChannel;
+}
+
+/**
+ * uORBCommunicator channel exporting all published topics into a POSIX shared
+ * memory segment (see uORBShmLayout.h), so that external processes on the same
+ * host can read them without serialization.
+ *
+ * Entries are keyed by topic name and instance, so every instance of a
+ * multi-instance topic is exported. External processes are read-only, there is
+ * no receive path.
+ *
+ * Publishing is lock-free once a topic has an entry, only adding an entry takes
+ * the lock. If two publishers of the same topic write at the same time, one of the
+ * messages is not exported.
+ */
+class uORB::ShmChannel : public uORBCommunicator::IChannel
+{
+public:
+	static ShmChannel *GetInstance()
+	{
+		if (_InstancePtr == nullptr) {
+			_InstancePtr = new ShmChannel();
+		}
+
+		return _InstancePtr;
+	}
+
+	static bool isInstance() { return (_InstancePtr != nullptr); }
+
+	/**
+	 * Create and map the shared memory segment.
+	 * @return 0 on success
+	 */
+	int Start();
+
+	/**
+	 * Unmap and remove the shared memory segment.
+	 */
+	void Stop();
+
+	void print_status();
+
+	int16_t topic_advertised(const char *messageName) override;
+
+	int16_t add_subscription(const char *messageName, int32_t msgRateInHz) override { return 0; }
+
+	int16_t remove_subscription(const char *messageName) override { return 0; }
+
+	int16_t register_handler(uORBCommunicator::IChannelRxHandler *handler) override { return 0; }
+
+	int16_t send_message(const char *messageName, int32_t length, uint8_t *data) override;
+
+	int16_t send_message(const char *messageName, uint8_t instance, int32_t length, uint8_t *data) override;
+
+private:
+	ShmChannel();
+	~ShmChannel();
+
+	/**
+	 * Find the segment entry of a topic instance without locking.
+	 * @return entry index or -1 if the topic instance has no entry yet
+	 */
+	int find_topic(const uorb_shm_segment *segment, const char *messageName, uint8_t instance) const;
+
+	/**
+	 * Find the segment entry of a topic instance, adding it if necessary.
+	 * _add_lock must be held.
+	 * @return entry index or -1 if the segment is full
+	 */
+	int find_or_add_topic(uorb_shm_segment *segment, const char *messageName, uint8_t instance, int32_t length);
+
+	static ShmChannel *_InstancePtr;
+
+	px4::atomic<uorb_shm_segment *> _segment{nullptr};
+	px4::atomic_int _writers{0}; /**< publishers currently accessing the segment, Stop() waits for them */
+
+	/**< topic name pointers for a fast lookup (uORB passes the stable orb_metadata::o_name) */
+	const char *_name_cache[UORB_SHM_MAX_TOPICS] {};
+	uint8_t _instance_cache[UORB_SHM_MAX_TOPICS] {};
+
+	px4::atomic_bool _writing[UORB_SHM_MAX_TOPICS] {}; /**< a publisher is writing the topic */
+
+	px4::atomic<uint32_t> _dropped_messages{0}; /**< messages not exported (segment full or concurrent publishers) */
+
+	px4_sem_t _lock; /**< serializes Start(), Stop() and print_status() */
+	px4_sem_t _add_lock; /**< serializes adding topic entries */
+};
@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file uORBShmLayout.h
+ *
+ * Layout of the POSIX shared memory segment exported by the uorb_shm module.
+ *
+ * This header is self-contained C so that external processes can include it
+ * directly: open the segment with shm_open(UORB_SHM_SEGMENT_NAME, O_RDONLY),
+ * mmap() sizeof(struct uorb_shm_segment) bytes, look a topic instance up with
+ * uorb_shm_find() and poll it with uorb_shm_copy().
+ *
+ * Every instance of a multi-instance topic has its own entry, keyed by the topic
+ * name and the instance.
+ *
+ * PX4 is the only writer. Every topic has UORB_SHM_SLOTS message slots, each
+ * tagged with (generation << 1) | busy, so readers never block the writer and
+ * retry if a slot was overwritten while copying (seqlock).
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define UORB_SHM_SEGMENT_NAME	"/px4_uorb"
+#define UORB_SHM_MAGIC		0x55345850u	/* "PX4U" */
+#define UORB_SHM_VERSION	2u
+
+#define UORB_SHM_MAX_TOPICS	128
+#define UORB_SHM_NAME_LEN	64
+#define UORB_SHM_SLOTS		4
+#define UORB_SHM_DATA_SIZE	(1024 * 1024)
+
+struct uorb_shm_topic {
+	char name[UORB_SHM_NAME_LEN];		/**< topic name (orb_metadata::o_name) */
+	uint32_t instance;			/**< topic instance */
+	uint32_t size;				/**< message size in bytes */
+	uint32_t data_offset;			/**< offset of the first slot in uorb_shm_segment::data */
+	uint32_t generation;			/**< number of published messages */
+	uint32_t slot_tag[UORB_SHM_SLOTS];	/**< (generation << 1) | busy of each slot */
+};
+
+struct uorb_shm_segment {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t topic_count;			/**< number of valid entries in topics, only ever grows */
+	uint32_t data_used;			/**< bytes of data allocated */
+	struct uorb_shm_topic topics[UORB_SHM_MAX_TOPICS];
+	uint8_t data[UORB_SHM_DATA_SIZE] __attribute__((aligned(8)));
+};
+
+/**
+ * Find an exported topic instance.
+ * @return the topic or NULL if PX4 didn't publish it (yet)
+ */
+static inline const struct uorb_shm_topic *uorb_shm_find(const struct uorb_shm_segment *segment, const char *name,
+		uint32_t instance)
+{
+	const uint32_t count = __atomic_load_n(&segment->topic_count, __ATOMIC_ACQUIRE);
+
+	for (uint32_t i = 0; i < count && i < UORB_SHM_MAX_TOPICS; i++) {
+		if ((segment->topics[i].instance == instance)
+		    && (strncmp(segment->topics[i].name, name, UORB_SHM_NAME_LEN) == 0)) {
+			return &segment->topics[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Copy the latest message of a topic if there is a new one.
+ * @param generation the generation last seen by the caller (initialize with 0), updated on success
+ * @param dst buffer of at least topic->size bytes
+ * @return 1 if a new message was copied, 0 if there is no new message
+ */
+static inline int uorb_shm_copy(const struct uorb_shm_segment *segment, const struct uorb_shm_topic *topic,
+				void *dst, uint32_t *generation)
+{
+	for (;;) {
+		const uint32_t current_generation = __atomic_load_n(&topic->generation, __ATOMIC_ACQUIRE);
+
+		if (current_generation == *generation) {
+			return 0;
+		}
+
+		const uint32_t read_generation = current_generation - 1;
+		const uint32_t slot = read_generation % UORB_SHM_SLOTS;
+		const uint32_t tag = read_generation << 1;
+
+		if (__atomic_load_n(&topic->slot_tag[slot], __ATOMIC_ACQUIRE) == tag) {
+			memcpy(dst, &segment->data[topic->data_offset + slot * topic->size], topic->size);
+
+			/* the data reads must complete before the tag is checked again */
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (__atomic_load_n(&topic->slot_tag[slot], __ATOMIC_RELAXED) == tag) {
+				*generation = current_generation;
+				return 1;
+			}
+		}
+
+		/* the writer lapped us, retry with the latest message */
+	}
+}
@@ -0,0 +1,188 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <uORB/Publication.hpp>
+#include <uORB/uORBManager.hpp>
+#include <uORB/topics/orb_test.h>
+
+#include "uORBShmChannel.hpp"
+
+extern "C" __EXPORT int uorb_shm_main(int argc, char *argv[]);
+
+/**
+ * Publish orb_test messages and read them back through a read-only mapping of the segment,
+ * the same way an external process does.
+ */
+static int test()
+{
+	int fd = shm_open(UORB_SHM_SEGMENT_NAME, O_RDONLY, 0);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", UORB_SHM_SEGMENT_NAME, errno);
+		PX4_ERR("uorb_shm FAILED");
+		return 1;
+	}
+
+	void *mem = mmap(nullptr, sizeof(uorb_shm_segment), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (mem == MAP_FAILED) {
+		PX4_ERR("mmap failed (%i)", errno);
+		PX4_ERR("uorb_shm FAILED");
+		return 1;
+	}
+
+	const uorb_shm_segment *segment = (const uorb_shm_segment *)mem;
+	bool passed = (__atomic_load_n(&segment->magic, __ATOMIC_ACQUIRE) == UORB_SHM_MAGIC)
+		      && (segment->version == UORB_SHM_VERSION);
+
+	uORB::Publication<orb_test_s> orb_test_pub{ORB_ID(orb_test)};
+	uint32_t generation = 0;
+
+	for (int i = 0; (i < 10) && passed; i++) {
+		orb_test_s orb_test{};
+		orb_test.val = i;
+		orb_test.timestamp = hrt_absolute_time();
+		orb_test_pub.publish(orb_test);
+
+		const uorb_shm_topic *topic = uorb_shm_find(segment, "orb_test", 0);
+		orb_test_s received{};
+
+		passed = (topic != nullptr) && (topic->size == sizeof(received))
+			 && (uorb_shm_copy(segment, topic, &received, &generation) == 1)
+			 && (received.val == i) && (received.timestamp == orb_test.timestamp);
+
+		// nothing new until the next publication
+		passed = passed && (uorb_shm_copy(segment, topic, &received, &generation) == 0);
+	}
+
+	munmap(mem, sizeof(uorb_shm_segment));
+
+	if (!passed) {
+		PX4_ERR("uorb_shm FAILED");
+		return 1;
+	}
+
+	PX4_INFO("uorb_shm PASSED");
+	return 0;
+}
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Exports all published uORB topics into the POSIX shared memory segment `/px4_uorb`,
+so that other processes on the same host (e.g. a perception stack) can read them
+with microsecond latency and without serialization. The segment layout and a small
+reader API are in `src/modules/muorb/shm/uORBShmLayout.h`.
+
+Requires a POSIX build with `ORB_COMMUNICATOR` defined (e.g. px4_sitl_test with `UORB_SHM=ON`,
+see `make tests_uorb_shm`). Topics are keyed by name and instance, so every instance of
+a multi-instance topic is exported.
+
+### Example
+$ uorb_shm start
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("uorb_shm", "communication");
+	PRINT_MODULE_USAGE_COMMAND("start");
+	PRINT_MODULE_USAGE_COMMAND("stop");
+	PRINT_MODULE_USAGE_COMMAND("status");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("test", "publish test messages and read them back from the segment");
+}
+
+int uorb_shm_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return 1;
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (uORB::ShmChannel::isInstance() && uORB::Manager::get_instance()->get_uorb_communicator()) {
+			PX4_WARN("already running");
+			return 0;
+		}
+
+		if (uORB::ShmChannel::GetInstance()->Start() != 0) {
+			return 1;
+		}
+
+		uORB::Manager::get_instance()->set_uorb_communicator(uORB::ShmChannel::GetInstance());
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "stop")) {
+		if (uORB::ShmChannel::isInstance()) {
+			uORB::ShmChannel::GetInstance()->Stop();
+
+		} else {
+			PX4_WARN("not running");
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "status")) {
+		if (uORB::ShmChannel::isInstance()) {
+			uORB::ShmChannel::GetInstance()->print_status();
+
+		} else {
+			PX4_INFO("not running");
+		}
+
+		return 0;
+	}
+
+	if (!strcmp(argv[1], "test")) {
+		if (!uORB::ShmChannel::isInstance() || !uORB::Manager::get_instance()->get_uorb_communicator()) {
+			PX4_ERR("not running");
+			PX4_ERR("uorb_shm FAILED");
+			return 1;
+		}
+
+		return test();
+	}
+
+	usage();
+	return 1;
+}
@@ -46,6 +46,7 @@
 #include <dataman/dataman.h>
 #include <drivers/drv_hrt.h>
 #include <lib/ecl/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
 #include <systemlib/mavlink_log.h>
 
 #include "navigator.h"
@@ -66,6 +67,10 @@ Geofence::~Geofence()
 	if (_polygons) {
 		delete[](_polygons);
 	}
+
+	delete[](_vertices);
+	delete[](_local_vertices);
+	delete[](_grid_polygons);
 }
 
 void Geofence::updateFence()
@@ -175,6 +180,259 @@ void Geofence::_updateFence()
 
 	}
 
+	if (!loadVertices()) {
+		_num_polygons = 0;
+		return;
+	}
+
+	// project around home if it is known, otherwise around the first vertex
+	double reference_lat = _num_vertices > 0 ? _vertices[0].lat : 0.;
+	double reference_lon = _num_vertices > 0 ? _vertices[0].lon : 0.;
+
+	if (_navigator->home_position_valid()) {
+		reference_lat = _navigator->get_home_position()->lat;
+		reference_lon = _navigator->get_home_position()->lon;
+	}
+
+	if (!projectFence(reference_lat, reference_lon)) {
+		_num_polygons = 0;
+	}
+}
+
+bool Geofence::loadVertices()
+{
+	delete[](_vertices);
+	_vertices = nullptr;
+	delete[](_local_vertices);
+	_local_vertices = nullptr;
+	_num_vertices = 0;
+	_has_inclusion_areas = false;
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		const PolygonInfo &polygon = _polygons[polygon_idx];
+		const bool is_circle = polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+				       || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION;
+		_num_vertices += is_circle ? 1 : polygon.vertex_count;
+	}
+
+	if (_num_vertices == 0) {
+		return true;
+	}
+
+	_vertices = new FenceVertex[_num_vertices];
+	_local_vertices = new LocalVertex[_num_vertices];
+
+	if (!_vertices || !_local_vertices) {
+		_num_vertices = 0;
+		PX4_ERR("alloc failed");
+		return false;
+	}
+
+	static constexpr unsigned vertex_batch_size = 8;
+	mission_fence_point_s fence_points[vertex_batch_size];
+	int vertex_index = 0;
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		PolygonInfo &polygon = _polygons[polygon_idx];
+		const bool is_circle = polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+				       || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION;
+		const unsigned vertex_count = is_circle ? 1 : polygon.vertex_count;
+		bool frame_supported = true;
+
+		polygon.vertex_index = vertex_index;
+
+		if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+		    || polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
+			_has_inclusion_areas = true;
+		}
+
+		for (unsigned first = 0; first < vertex_count; first += vertex_batch_size) {
+			const unsigned num_points = math::min(vertex_batch_size, vertex_count - first);
+
+			if (dm_read_batch(DM_KEY_FENCE_POINTS, polygon.dataman_index + first, fence_points,
+					  sizeof(mission_fence_point_s), num_points) != (ssize_t)num_points) {
+				PX4_ERR("dm_read failed");
+				return false;
+			}
+
+			for (unsigned k = 0; k < num_points; k++) {
+				const mission_fence_point_s &fence_point = fence_points[k];
+
+				if (fence_point.frame != NAV_FRAME_GLOBAL && fence_point.frame != NAV_FRAME_GLOBAL_INT
+				    && fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
+				    && fence_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
+					// TODO: handle different frames
+					PX4_ERR("Frame type %i not supported", (int)fence_point.frame);
+					frame_supported = false;
+				}
+
+				_vertices[vertex_index].lat = fence_point.lat;
+				_vertices[vertex_index].lon = fence_point.lon;
+				++vertex_index;
+			}
+		}
+
+		polygon.frame_supported = frame_supported;
+	}
+
+	return true;
+}
+
+bool Geofence::projectFence(double reference_lat, double reference_lon)
+{
+	map_projection_init(&_projection_reference, reference_lat, reference_lon);
+	_projection_lat = reference_lat;
+	_projection_lon = reference_lon;
+
+	for (int i = 0; i < _num_vertices; ++i) {
+		map_projection_project(&_projection_reference, _vertices[i].lat, _vertices[i].lon,
+				       &_local_vertices[i].x, &_local_vertices[i].y);
+	}
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		PolygonInfo &polygon = _polygons[polygon_idx];
+		const LocalVertex *vertices = &_local_vertices[polygon.vertex_index];
+
+		if (!polygon.frame_supported) {
+			// an empty bounding box: the point is never inside
+			polygon.x_min = polygon.y_min = 1.f;
+			polygon.x_max = polygon.y_max = -1.f;
+
+		} else if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+			   || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
+			polygon.x_min = vertices[0].x - polygon.circle_radius;
+			polygon.x_max = vertices[0].x + polygon.circle_radius;
+			polygon.y_min = vertices[0].y - polygon.circle_radius;
+			polygon.y_max = vertices[0].y + polygon.circle_radius;
+
+		} else {
+			polygon.x_min = polygon.x_max = vertices[0].x;
+			polygon.y_min = polygon.y_max = vertices[0].y;
+
+			for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
+				LocalVertex &vertex = _local_vertices[polygon.vertex_index + i];
+				const LocalVertex &previous = vertices[j];
+				const float dy = vertex.y - previous.y;
+				vertex.slope = fabsf(dy) > FLT_EPSILON ? (vertex.x - previous.x) / dy : 0.f;
+
+				polygon.x_min = math::min(polygon.x_min, vertex.x);
+				polygon.x_max = math::max(polygon.x_max, vertex.x);
+				polygon.y_min = math::min(polygon.y_min, vertex.y);
+				polygon.y_max = math::max(polygon.y_max, vertex.y);
+			}
+		}
+	}
+
+	return buildGrid();
+}
+
+void Geofence::updateProjection()
+{
+	if (_num_polygons == 0 || !_navigator->home_position_valid()) {
+		return;
+	}
+
+	const home_position_s &home = *_navigator->get_home_position();
+
+	if (home.lat != _projection_lat || home.lon != _projection_lon) {
+		if (!projectFence(home.lat, home.lon)) {
+			_num_polygons = 0;
+		}
+	}
+}
+
+bool Geofence::buildGrid()
+{
+	delete[](_grid_polygons);
+	_grid_polygons = nullptr;
+	memset(_grid_offsets, 0, sizeof(_grid_offsets));
+
+	// grid extent: union of all (non-empty) bounding boxes
+	float x_min = FLT_MAX, x_max = -FLT_MAX, y_min = FLT_MAX, y_max = -FLT_MAX;
+
+	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+		const PolygonInfo &polygon = _polygons[polygon_idx];
+
+		if (polygon.x_min <= polygon.x_max) {
+			x_min = math::min(x_min, polygon.x_min);
+			x_max = math::max(x_max, polygon.x_max);
+			y_min = math::min(y_min, polygon.y_min);
+			y_max = math::max(y_max, polygon.y_max);
+		}
+	}
+
+	if (x_min > x_max) {
+		// nothing to index
+		return true;
+	}
+
+	_grid_x_min = x_min;
+	_grid_y_min = y_min;
+	_grid_x_step = math::max((x_max - x_min) / GRID_SIZE, 0.01f);
+	_grid_y_step = math::max((y_max - y_min) / GRID_SIZE, 0.01f);
+
+	// two passes: count the polygons per cell, then fill in the polygon indices
+	int num_entries = 0;
+
+	for (int pass = 0; pass < 2; ++pass) {
+		uint16_t cell_fill[GRID_SIZE * GRID_SIZE] {};
+
+		for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
+			const PolygonInfo &polygon = _polygons[polygon_idx];
+
+			if (polygon.x_min > polygon.x_max) {
+				continue;
+			}
+
+			const int i_min = math::constrain((int)((polygon.x_min - _grid_x_min) / _grid_x_step), 0, GRID_SIZE - 1);
+			const int i_max = math::constrain((int)((polygon.x_max - _grid_x_min) / _grid_x_step), 0, GRID_SIZE - 1);
+			const int j_min = math::constrain((int)((polygon.y_min - _grid_y_min) / _grid_y_step), 0, GRID_SIZE - 1);
+			const int j_max = math::constrain((int)((polygon.y_max - _grid_y_min) / _grid_y_step), 0, GRID_SIZE - 1);
+
+			for (int i = i_min; i <= i_max; ++i) {
+				for (int j = j_min; j <= j_max; ++j) {
+					const int cell = i * GRID_SIZE + j;
+
+					if (pass == 0) {
+						++_grid_offsets[cell + 1];
+						++num_entries;
+
+					} else {
+						_grid_polygons[_grid_offsets[cell] + cell_fill[cell]++] = polygon_idx;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (int cell = 0; cell < GRID_SIZE * GRID_SIZE; ++cell) {
+				_grid_offsets[cell + 1] += _grid_offsets[cell];
+			}
+
+			_grid_polygons = new uint16_t[num_entries];
+
+			if (!_grid_polygons) {
+				memset(_grid_offsets, 0, sizeof(_grid_offsets));
+				PX4_ERR("alloc failed");
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int Geofence::gridCell(float x, float y) const
+{
+	const float i = (x - _grid_x_min) / _grid_x_step;
+	const float j = (y - _grid_y_min) / _grid_y_step;
+
+	if (!(i >= 0.f && i <= GRID_SIZE && j >= 0.f && j <= GRID_SIZE)) {
+		return -1;
+	}
+
+	// the maximum of the extent belongs to the last cell
+	return math::min((int)i, GRID_SIZE - 1) * GRID_SIZE + math::min((int)j, GRID_SIZE - 1);
 }
 
 bool Geofence::checkAll(const struct vehicle_global_position_s &global_position)
@@ -280,8 +538,8 @@ bool Geofence::checkAll(double lat, double lon, float altitude)
 
 bool Geofence::checkPolygons(double lat, double lon, float altitude)
 {
-	// the following uses dm_read, so first we try to lock all items. If that fails, it (most likely) means
-	// the data is currently being updated (via a mavlink geofence transfer), and we do not check for a violation now
+	// the fence data is only read when it was updated, so first we try to lock all items. If that fails, it (most likely)
+	// means the data is currently being updated (via a mavlink geofence transfer), and we do not check for a violation now
 	if (dm_trylock(DM_KEY_FENCE_POINTS) != 0) {
 		return true;
 	}
@@ -294,8 +552,12 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 		_updateFence();
 	}
 
+	// the checks below only use the RAM copy
+	dm_unlock(DM_KEY_FENCE_POINTS);
+
+	updateProjection();
+
 	if (isEmpty()) {
-		dm_unlock(DM_KEY_FENCE_POINTS);
 		/* Empty fence -> accept all points */
 		return true;
 	}
@@ -303,58 +565,52 @@ bool Geofence::checkPolygons(double lat, double lon, float altitude)
 	/* Vertical check */
 	if (_altitude_max > _altitude_min) { // only enable vertical check if configured properly
 		if (altitude > _altitude_max || altitude < _altitude_min) {
-			dm_unlock(DM_KEY_FENCE_POINTS);
 			return false;
 		}
 	}
 
 
-	/* Horizontal check: iterate all polygons & circles */
+	/* Horizontal check: only the polygons & circles of the grid cell, with the point inside their bounding box */
 	bool outside_exclusion = true;
 	bool inside_inclusion = false;
-	bool had_inclusion_areas = false;
+	float x, y;
+	map_projection_project(&_projection_reference, lat, lon, &x, &y);
+	const int cell = gridCell(x, y);
 
-	for (int polygon_idx = 0; polygon_idx < _num_polygons; ++polygon_idx) {
-		if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION) {
-			bool inside = insideCircle(_polygons[polygon_idx], lat, lon, altitude);
+	if (cell >= 0) {
+		for (uint32_t k = _grid_offsets[cell]; k < _grid_offsets[cell + 1] && outside_exclusion; ++k) {
+			const PolygonInfo &polygon = _polygons[_grid_polygons[k]];
 
-			if (inside) {
-				inside_inclusion = true;
+			if (x < polygon.x_min || x > polygon.x_max || y < polygon.y_min || y > polygon.y_max) {
+				continue;
 			}
 
-			had_inclusion_areas = true;
+			bool inside;
 
-		} else if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
-			bool inside = insideCircle(_polygons[polygon_idx], lat, lon, altitude);
+			if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+			    || polygon.fence_type == NAV_CMD_FENCE_CIRCLE_EXCLUSION) {
+				inside = insideCircle(polygon, x, y);
 
-			if (inside) {
-				outside_exclusion = false;
+			} else { // it's a polygon
+				inside = insidePolygon(polygon, x, y);
 			}
 
-		} else { // it's a polygon
-			bool inside = insidePolygon(_polygons[polygon_idx], lat, lon, altitude);
-
-			if (_polygons[polygon_idx].fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
-				if (inside) {
+			if (inside) {
+				if (polygon.fence_type == NAV_CMD_FENCE_CIRCLE_INCLUSION
+				    || polygon.fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
 					inside_inclusion = true;
-				}
 
-				had_inclusion_areas = true;
-
-			} else { // exclusion
-				if (inside) {
+				} else { // exclusion
 					outside_exclusion = false;
 				}
 			}
 		}
 	}
 
-	dm_unlock(DM_KEY_FENCE_POINTS);
-
-	return (!had_inclusion_areas || inside_inclusion) && outside_exclusion;
+	return (!_has_inclusion_areas || inside_inclusion) && outside_exclusion;
 }
 
-bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude)
+bool Geofence::insidePolygon(const PolygonInfo &polygon, float x, float y) const
 {
 
 	/* Adaptation of algorithm originally presented as
@@ -363,32 +619,14 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 	 * Only supports non-complex polygons (not self intersecting)
 	 */
 
-	mission_fence_point_s temp_vertex_i;
-	mission_fence_point_s temp_vertex_j;
+	const LocalVertex *vertices = &_local_vertices[polygon.vertex_index];
 	bool c = false;
 
 	for (unsigned i = 0, j = polygon.vertex_count - 1; i < polygon.vertex_count; j = i++) {
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + i, &temp_vertex_i,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
+		const LocalVertex &vertex_i = vertices[i];
 
-		if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index + j, &temp_vertex_j,
-			    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-			break;
-		}
-
-		if (temp_vertex_i.frame != NAV_FRAME_GLOBAL && temp_vertex_i.frame != NAV_FRAME_GLOBAL_INT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-		    && temp_vertex_i.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-			// TODO: handle different frames
-			PX4_ERR("Frame type %i not supported", (int)temp_vertex_i.frame);
-			break;
-		}
-
-		if (((double)temp_vertex_i.lon >= lon) != ((double)temp_vertex_j.lon >= lon) &&
-		    (lat <= (double)(temp_vertex_j.lat - temp_vertex_i.lat) * (lon - (double)temp_vertex_i.lon) /
-		     (double)(temp_vertex_j.lon - temp_vertex_i.lon) + (double)temp_vertex_i.lat)) {
+		// the edge slope is precomputed, it is only used if the edge crosses y
+		if ((vertex_i.y >= y) != (vertices[j].y >= y) && (x <= vertex_i.slope * (y - vertex_i.y) + vertex_i.x)) {
 			c = !c;
 		}
 	}
@@ -396,34 +634,11 @@ bool Geofence::insidePolygon(const PolygonInfo &polygon, double lat, double lon,
 	return c;
 }
 
-bool Geofence::insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude)
+bool Geofence::insideCircle(const PolygonInfo &polygon, float x, float y) const
 {
-
-	mission_fence_point_s circle_point;
-
-	if (dm_read(DM_KEY_FENCE_POINTS, polygon.dataman_index, &circle_point,
-		    sizeof(mission_fence_point_s)) != sizeof(mission_fence_point_s)) {
-		PX4_ERR("dm_read failed");
-		return false;
-	}
-
-	if (circle_point.frame != NAV_FRAME_GLOBAL && circle_point.frame != NAV_FRAME_GLOBAL_INT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT
-	    && circle_point.frame != NAV_FRAME_GLOBAL_RELATIVE_ALT_INT) {
-		// TODO: handle different frames
-		PX4_ERR("Frame type %i not supported", (int)circle_point.frame);
-		return false;
-	}
-
-	if (!map_projection_initialized(&_projection_reference)) {
-		map_projection_init(&_projection_reference, lat, lon);
-	}
-
-	float x1, y1, x2, y2;
-	map_projection_project(&_projection_reference, lat, lon, &x1, &y1);
-	map_projection_project(&_projection_reference, circle_point.lat, circle_point.lon, &x2, &y2);
-	float dx = x1 - x2, dy = y1 - y2;
-	return dx * dx + dy * dy < circle_point.circle_radius * circle_point.circle_radius;
+	const LocalVertex &center = _local_vertices[polygon.vertex_index];
+	const float dx = x - center.x, dy = y - center.y;
+	return dx * dx + dy * dy < polygon.circle_radius * polygon.circle_radius;
 }
 
 bool
@@ -577,12 +792,10 @@ bool Geofence::isHomeRequired()
 
 void Geofence::printStatus()
 {
-	int num_inclusion_polygons = 0, num_exclusion_polygons = 0, total_num_vertices = 0;
+	int num_inclusion_polygons = 0, num_exclusion_polygons = 0;
 	int num_inclusion_circles = 0, num_exclusion_circles = 0;
 
 	for (int i = 0; i < _num_polygons; ++i) {
-		total_num_vertices += _polygons[i].vertex_count;
-
 		if (_polygons[i].fence_type == NAV_CMD_FENCE_POLYGON_VERTEX_INCLUSION) {
 			++num_inclusion_polygons;
 		}
@@ -602,5 +815,5 @@ void Geofence::printStatus()
 
 	PX4_INFO("Geofence: %i inclusion, %i exclusion polygons, %i inclusion, %i exclusion circles, %i total vertices",
 		 num_inclusion_polygons, num_exclusion_polygons, num_inclusion_circles, num_exclusion_circles,
-		 total_num_vertices);
+		 _num_vertices);
 }
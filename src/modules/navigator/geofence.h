@@ -41,6 +41,7 @@
 #pragma once
 
 #include <float.h>
+#include <math.h>
 
 #include <px4_platform_common/module_params.h>
 #include <drivers/drv_hrt.h>
@@ -147,15 +148,47 @@ private:
 	struct PolygonInfo {
 		uint16_t fence_type; ///< one of MAV_CMD_NAV_FENCE_* (can also be a circular region)
 		uint16_t dataman_index;
+		uint16_t vertex_index; ///< index of the first vertex (or the circle center) in _vertices
 		union {
 			uint16_t vertex_count;
 			float circle_radius;
 		};
+		bool frame_supported; ///< if false, the polygon never contains a point
+		float x_min, x_max, y_min, y_max; ///< local bounding box, empty if the polygon cannot be checked
 	};
 	PolygonInfo *_polygons{nullptr};
 	int _num_polygons{0};
+	bool _has_inclusion_areas{false};
 
-	map_projection_reference_s _projection_reference = {}; ///< reference to convert (lon, lat) to local [m]
+	struct FenceVertex {
+		double lat;
+		double lon;
+	};
+	FenceVertex *_vertices{nullptr}; ///< RAM copy of all vertices and circle centers, loaded on fence updates
+	int _num_vertices{0};
+
+	struct LocalVertex {
+		float x; ///< North [m]
+		float y; ///< East [m]
+		float slope; ///< dx/dy of the edge from the previous vertex, 0 for horizontal edges
+	};
+	LocalVertex *_local_vertices{nullptr}; ///< _vertices projected with _projection_reference
+	double _projection_lat{NAN}; ///< latitude of the projection reference, home if it is valid
+	double _projection_lon{NAN};
+
+	/*
+	 * Uniform grid over the bounding box of all polygons: each cell lists the polygons
+	 * overlapping it, so a check only tests the polygons of the cell containing the point.
+	 */
+	static constexpr int GRID_SIZE = 8; ///< number of cells per axis
+	float _grid_x_min{0.f};
+	float _grid_y_min{0.f};
+	float _grid_x_step{1.f};
+	float _grid_y_step{1.f};
+	uint32_t _grid_offsets[GRID_SIZE * GRID_SIZE + 1] {}; ///< polygons of cell i: _grid_polygons[_grid_offsets[i]..[i + 1])
+	uint16_t *_grid_polygons{nullptr};
+
+	map_projection_reference_s _projection_reference = {}; ///< reference to convert (lon, lat) to the local fence frame [m]
 
 	DEFINE_PARAMETERS(
 		(ParamInt<px4::params::GF_ACTION>) _param_gf_action,
@@ -176,6 +209,35 @@ private:
 	 */
 	void _updateFence();
 
+	/**
+	 * Load the vertices of all polygons into RAM
+	 * @return false on error
+	 */
+	bool loadVertices();
+
+	/**
+	 * Project the vertices into the local frame of a new reference, and compute the edge
+	 * coefficients and bounding boxes.
+	 * @return false on error
+	 */
+	bool projectFence(double reference_lat, double reference_lon);
+
+	/**
+	 * Re-project the fence if home changed
+	 */
+	void updateProjection();
+
+	/**
+	 * Build the grid index from the polygon bounding boxes
+	 * @return false on error
+	 */
+	bool buildGrid();
+
+	/**
+	 * @return grid cell index of a point, -1 if outside of the grid
+	 */
+	int gridCell(float x, float y) const;
+
 	/**
 	 * Check if a point passes the Geofence test.
 	 * This takes all polygons and minimum & maximum altitude into account
@@ -201,14 +263,16 @@ private:
 
 	/**
 	 * Check if a single point is within a polygon
+	 * @param x, y point in the local fence frame [m]
 	 * @return true if within polygon
 	 */
-	bool insidePolygon(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	bool insidePolygon(const PolygonInfo &polygon, float x, float y) const;
 
 	/**
 	 * Check if a single point is within a circle
 	 * @param polygon must be a circle!
+	 * @param x, y point in the local fence frame [m]
 	 * @return true if within polygon the circle
 	 */
-	bool insideCircle(const PolygonInfo &polygon, double lat, double lon, float altitude);
+	bool insideCircle(const PolygonInfo &polygon, float x, float y) const;
 };
@@ -48,6 +48,7 @@
 #include "mission.h"
 #include "navigator.h"
 
+#include <limits.h>
 #include <string.h>
 #include <drivers/drv_hrt.h>
 #include <dataman/dataman.h>
@@ -61,7 +62,8 @@
 
 Mission::Mission(Navigator *navigator) :
 	MissionBlock(navigator),
-	ModuleParams(navigator)
+	ModuleParams(navigator),
+	_feasibility_checker(navigator)
 {
 }
 
@@ -73,6 +75,8 @@ Mission::on_inactive()
 	 * is used for missions such as RTL. */
 	_navigator->set_cruising_speed();
 
+	advance_mission_check(MISSION_CHECK_ITEMS_PER_ITERATION);
+
 	/* Without home a mission can't be valid yet anyway, let's wait. */
 	if (!_navigator->home_position_valid()) {
 		return;
@@ -148,6 +152,9 @@ Mission::on_inactivation()
 void
 Mission::on_activation()
 {
+	// the mission is about to be executed, finish checking it now
+	advance_mission_check(UINT_MAX);
+
 	if (_mission_waypoints_changed) {
 		// do not set the closest mission item in the normal mission mode
 		if (_mission_execution_mode != mission_result_s::MISSION_EXECUTION_MODE_NORMAL) {
@@ -174,6 +181,8 @@ Mission::on_activation()
 void
 Mission::on_active()
 {
+	advance_mission_check(UINT_MAX);
+
 	if (_work_item_type == WORK_ITEM_TYPE_PRECISION_LAND) {
 		// switch out of precision land once landed
 		if (_navigator->get_land_detected()->landed) {
@@ -270,6 +279,8 @@ Mission::on_active()
 
 		do_abort_landing();
 	}
+
+	prefetch_mission_items();
 }
 
 bool
@@ -452,8 +463,6 @@ void
 Mission::update_mission()
 {
 
-	bool failed = true;
-
 	/* Reset vehicle_roi
 	 * Missions that do not explicitly configure ROI would not override
 	 * an existing ROI setting from previous missions */
@@ -461,6 +470,8 @@ Mission::update_mission()
 
 	const mission_s old_mission = _mission;
 
+	invalidate_item_cache();
+
 	if (_mission_sub.copy(&_mission)) {
 		/* determine current index */
 		if (_mission.current_seq >= 0 && _mission.current_seq < (int)_mission.count) {
@@ -479,23 +490,6 @@ Mission::update_mission()
 			/* otherwise, just leave it */
 		}
 
-		check_mission_valid(true);
-
-		failed = !_navigator->get_mission_result()->valid;
-
-		if (!failed) {
-			/* reset mission failure if we have an updated valid mission */
-			_navigator->get_mission_result()->failure = false;
-
-			/* reset sequence info as well */
-			_navigator->get_mission_result()->seq_reached = -1;
-			_navigator->get_mission_result()->seq_total = _mission.count;
-
-			/* reset work item if new mission has been accepted */
-			_work_item_type = WORK_ITEM_TYPE_DEFAULT;
-			_mission_changed = true;
-		}
-
 		/* check if the mission waypoints changed while the vehicle is in air
 		 * TODO add a flag to mission_s which actually tracks if the position of the waypoint changed */
 		if (((_mission.count != old_mission.count) ||
@@ -504,11 +498,35 @@ Mission::update_mission()
 			_mission_waypoints_changed = true;
 		}
 
+		// the landing of the new mission is not known before the check is finished
+		_land_start_available = false;
+
+		// the update is finished by update_mission_finished() once the mission is checked
+		_mission_update_pending = true;
+		check_mission_valid(true);
+
 	} else {
 		PX4_ERR("mission update failed");
+		update_mission_finished(false);
 	}
+}
 
-	if (failed) {
+void
+Mission::update_mission_finished(bool valid)
+{
+	if (valid) {
+		/* reset mission failure if we have an updated valid mission */
+		_navigator->get_mission_result()->failure = false;
+
+		/* reset sequence info as well */
+		_navigator->get_mission_result()->seq_reached = -1;
+		_navigator->get_mission_result()->seq_total = _mission.count;
+
+		/* reset work item if new mission has been accepted */
+		_work_item_type = WORK_ITEM_TYPE_DEFAULT;
+		_mission_changed = true;
+
+	} else {
 		// only warn if the check failed on merit
 		if ((int)_mission.count > 0) {
 			PX4_WARN("mission check failed");
@@ -1575,8 +1593,8 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 		/* read mission item to temp storage first to not overwrite current mission item if data damaged */
 		struct mission_item_s mission_item_tmp;
 
-		/* read mission item from datamanager */
-		if (dm_read(dm_item, *mission_index_ptr, &mission_item_tmp, len) != len) {
+		/* read mission item from the lookahead cache (datamanager) */
+		if (!read_cached_mission_item(*mission_index_ptr, &mission_item_tmp)) {
 			/* not supposed to happen unless the datamanager can't access the SD card, etc. */
 			mavlink_log_critical(_navigator->get_mavlink_log_pub(), "Waypoint could not be read.");
 			return false;
@@ -1598,9 +1616,15 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 					if (dm_write(dm_item, *mission_index_ptr, DM_PERSIST_POWER_ON_RESET, &mission_item_tmp, len) != len) {
 						/* not supposed to happen unless the datamanager can't access the dataman */
 						mavlink_log_critical(_navigator->get_mavlink_log_pub(), "DO JUMP waypoint could not be written.");
+						invalidate_item_cache();
 						return false;
 					}
 
+					/* keep the cached copy in sync */
+					if (*mission_index_ptr >= _item_cache_first && *mission_index_ptr < _item_cache_first + _item_cache_count) {
+						_item_cache[*mission_index_ptr - _item_cache_first] = mission_item_tmp;
+					}
+
 					report_do_jump_mission_changed(*mission_index_ptr, mission_item_tmp.do_jump_repeat_count);
 				}
 
@@ -1634,6 +1658,78 @@ Mission::read_mission_item(int offset, struct mission_item_s *mission_item)
 	return false;
 }
 
+bool
+Mission::read_cached_mission_item(int index, struct mission_item_s *mission_item)
+{
+	if (_item_cache_dataman_id != _mission.dataman_id
+	    || index < _item_cache_first || index >= _item_cache_first + _item_cache_count) {
+
+		if (!fill_item_cache(index)) {
+			return false;
+		}
+	}
+
+	*mission_item = _item_cache[index - _item_cache_first];
+	return true;
+}
+
+bool
+Mission::fill_item_cache(int index)
+{
+	invalidate_item_cache();
+
+	if (index < 0 || index >= (int)_mission.count) {
+		return false;
+	}
+
+	/* read ahead in the direction the mission is executed */
+	int first = index;
+
+	if (_mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_REVERSE) {
+		first = math::max(index - ITEM_CACHE_SIZE + 1, 0);
+	}
+
+	const int num_items = math::min(ITEM_CACHE_SIZE, (int)_mission.count - first);
+	const ssize_t ret = dm_read_batch((dm_item_t)_mission.dataman_id, first, _item_cache, sizeof(mission_item_s),
+					  num_items);
+
+	if (ret <= index - first) {
+		/* not supposed to happen unless the datamanager can't access the SD card, etc. */
+		return false;
+	}
+
+	_item_cache_first = first;
+	_item_cache_count = ret;
+	_item_cache_dataman_id = _mission.dataman_id;
+	return true;
+}
+
+void
+Mission::prefetch_mission_items()
+{
+	if (_mission.count == 0 || _current_mission_index < 0 || _current_mission_index >= (int)_mission.count) {
+		return;
+	}
+
+	/* the current item and at least half a cache of lookahead should be cached */
+	int lookahead;
+
+	if (_mission_execution_mode == mission_result_s::MISSION_EXECUTION_MODE_REVERSE) {
+		lookahead = math::max(_current_mission_index - ITEM_CACHE_SIZE / 2, 0);
+
+	} else {
+		lookahead = math::min(_current_mission_index + ITEM_CACHE_SIZE / 2, (int)_mission.count - 1);
+	}
+
+	const int cache_end = _item_cache_first + _item_cache_count;
+
+	if (_item_cache_dataman_id != _mission.dataman_id
+	    || _current_mission_index < _item_cache_first || _current_mission_index >= cache_end
+	    || lookahead < _item_cache_first || lookahead >= cache_end) {
+		fill_item_cache(_current_mission_index);
+	}
+}
+
 void
 Mission::save_mission_state()
 {
@@ -1724,19 +1820,41 @@ Mission::check_mission_valid(bool force)
 {
 	if ((!_home_inited && _navigator->home_position_valid()) || force) {
 
-		MissionFeasibilityChecker _missionFeasibilityChecker(_navigator);
+		_feasibility_checker.start(_mission,
+					   _param_mis_dist_1wp.get(),
+					   _param_mis_dist_wps.get(),
+					   _navigator->mission_landing_required());
 
-		_navigator->get_mission_result()->valid =
-			_missionFeasibilityChecker.checkMissionFeasible(_mission,
-					_param_mis_dist_1wp.get(),
-					_param_mis_dist_wps.get(),
-					_navigator->mission_landing_required());
-
-		_navigator->get_mission_result()->seq_total = _mission.count;
-		_navigator->increment_mission_instance_count();
-		_navigator->set_mission_result_updated();
+		// the mission can't be used before the check is finished
+		_navigator->get_mission_result()->valid = false;
 		_home_inited = _navigator->home_position_valid();
 
+		// check the first items right away: small missions are done immediately, an executed mission entirely
+		advance_mission_check(_navigator->is_planned_mission() ? UINT_MAX : MISSION_CHECK_ITEMS_PER_ITERATION);
+	}
+}
+
+void
+Mission::advance_mission_check(unsigned max_items)
+{
+	if (_feasibility_checker.running() && _feasibility_checker.advance(max_items)) {
+		mission_check_finished(_feasibility_checker.feasible());
+	}
+}
+
+void
+Mission::mission_check_finished(bool valid)
+{
+	_navigator->get_mission_result()->valid = valid;
+	_navigator->get_mission_result()->seq_total = _mission.count;
+	_navigator->increment_mission_instance_count();
+	_navigator->set_mission_result_updated();
+
+	if (_mission_update_pending) {
+		_mission_update_pending = false;
+		update_mission_finished(valid);
+
+	} else {
 		// find and store landing start marker (if available)
 		find_mission_land_start();
 	}
@@ -1790,6 +1908,9 @@ Mission::reset_mission(struct mission_s &mission)
 	}
 
 	dm_unlock(DM_KEY_MISSION_STATE);
+
+	/* the jump counters changed */
+	invalidate_item_cache();
 }
 
 bool
@@ -188,6 +188,27 @@ private:
 	 */
 	bool read_mission_item(int offset, struct mission_item_s *mission_item);
 
+	/**
+	 * Read a mission item through the lookahead cache, a miss reads a batch of items from the dataman
+	 *
+	 * @return true if successful
+	 */
+	bool read_cached_mission_item(int index, struct mission_item_s *mission_item);
+
+	/**
+	 * Fill the lookahead cache with the items following (or preceding, in reverse mode) index
+	 *
+	 * @return true if the item at index is cached
+	 */
+	bool fill_item_cache(int index);
+
+	/**
+	 * Refill the lookahead cache ahead of time, so that the next waypoint transitions don't need dataman reads
+	 */
+	void prefetch_mission_items();
+
+	void invalidate_item_cache() { _item_cache_count = 0; }
+
 	/**
 	 * Save current mission state to dataman
 	 */
@@ -209,10 +230,27 @@ private:
 	void set_current_mission_item();
 
 	/**
-	 * Check whether a mission is ready to go
+	 * Check whether a mission is ready to go.
+	 * Large missions are checked over several navigator iterations while the mission is not active.
 	 */
 	void check_mission_valid(bool force);
 
+	/**
+	 * Continue a running mission feasibility check
+	 * @param max_items maximum number of mission items to check in this call
+	 */
+	void advance_mission_check(unsigned max_items);
+
+	/**
+	 * Publish the result of a finished mission feasibility check
+	 */
+	void mission_check_finished(bool valid);
+
+	/**
+	 * Accept or reject an updated mission once it is checked
+	 */
+	void update_mission_finished(bool valid);
+
 	/**
 	 * Reset mission
 	 */
@@ -250,6 +288,17 @@ private:
 	uORB::Subscription	_mission_sub{ORB_ID(mission)};		/**< mission subscription */
 	mission_s		_mission {};
 
+	static constexpr unsigned MISSION_CHECK_ITEMS_PER_ITERATION = 20; ///< items checked per iteration while inactive
+
+	MissionFeasibilityChecker _feasibility_checker;
+
+	static constexpr int ITEM_CACHE_SIZE = 8; ///< number of mission items read ahead
+	mission_item_s _item_cache[ITEM_CACHE_SIZE] {}; ///< lookahead cache of the mission items [_item_cache_first, + _item_cache_count)
+	int _item_cache_first{0};
+	int _item_cache_count{0};
+	uint8_t _item_cache_dataman_id{0};
+	bool _mission_update_pending{false}; ///< an updated mission is being checked
+
 	int32_t _current_mission_index{-1};
 
 	// track location of planned mission landing
@@ -766,6 +766,27 @@ MissionBlock::set_vtol_transition_item(struct mission_item_s *item, const uint8_
 void
 MissionBlock::mission_apply_limitation(mission_item_s &item)
 {
+	/*
+	 * Keep the minimum clearance above the terrain, except for takeoff and landing
+	 */
+
+	const float terrain_clearance = _navigator->get_terrain_clearance();
+
+	if (terrain_clearance > 0.0f && item_contains_position(item)
+	    && item.nav_cmd != NAV_CMD_TAKEOFF && item.nav_cmd != NAV_CMD_VTOL_TAKEOFF
+	    && item.nav_cmd != NAV_CMD_LAND && item.nav_cmd != NAV_CMD_VTOL_LAND) {
+
+		float terrain_alt;
+
+		if (_navigator->get_terrain().getElevation(item.lat, item.lon, terrain_alt)
+		    && get_absolute_altitude_for_item(item) < terrain_alt + terrain_clearance) {
+
+			item.altitude = item.altitude_is_relative ?
+					terrain_alt + terrain_clearance - _navigator->get_home_position()->alt :
+					terrain_alt + terrain_clearance;
+		}
+	}
+
 	/*
 	 * Limit altitude
 	 */
@@ -43,38 +43,84 @@
 #pragma once
 
 #include <dataman/dataman.h>
+#include <uORB/Subscription.hpp>
 #include <uORB/topics/mission.h>
+#include <uORB/topics/position_controller_landing_status.h>
+
+#include "navigation.h"
 
 class Geofence;
 class Navigator;
 
+/**
+ * Mission feasibility check, done in a single pass over the mission items.
+ * The check can be spread over several calls of advance(), so that large missions
+ * do not block the navigator.
+ */
 class MissionFeasibilityChecker
 {
 private:
 	Navigator *_navigator{nullptr};
 
-	/* Checks for all airframes */
-	bool checkGeofence(const mission_s &mission, float home_alt, bool home_valid);
-
-	bool checkHomePositionAltitude(const mission_s &mission, float home_alt, bool home_alt_valid, bool throw_error);
-
-	bool checkMissionItemValidity(const mission_s &mission);
-
-	bool checkDistanceToFirstWaypoint(const mission_s &mission, float max_distance);
-	bool checkDistancesBetweenWaypoints(const mission_s &mission, float max_distance);
-
-	bool checkTakeoff(const mission_s &mission, float home_alt);
+	/* Inputs of the current check */
+	mission_s _mission{};
+	float _max_distance_to_1st_waypoint{0.f};
+	float _max_distance_between_waypoints{0.f};
+	bool _land_start_req{false};
+	float _home_alt{0.f};
+	bool _home_valid{false};
+	double _home_lat{0.};
+	double _home_lon{0.};
+
+	enum class Airframe {
+		FixedWing,
+		RotaryWing,
+		VTOL
+	} _airframe{Airframe::RotaryWing};
+
+	uORB::SubscriptionData<position_controller_landing_status_s> _landing_status{ORB_ID(position_controller_landing_status)};
+
+	/* Progress */
+	bool _running{false};
+	bool _feasible{false};
+	size_t _index{0}; ///< next mission item to check
+	mission_item_s _previous_item{};
+
+	/* State of the checks which depend on more than one item */
+	bool _first_waypoint_checked{false};
+	bool _home_altitude_checked{false};
+	double _last_lat{NAN};
+	double _last_lon{NAN};
+	int _last_cmd{0};
+	bool _has_takeoff{false};
+	bool _takeoff_first{false};
+	bool _later_takeoff_found{false};
+	bool _land_start_found{false};
+	bool _landing_valid{false};
+	size_t _do_land_start_index{0};
+	size_t _landing_approach_index{0};
+
+	void finish(bool feasible);
+
+	/* Checks of a single item, false if the mission is not feasible */
+	bool checkItem(const mission_item_s &item, size_t index);
+
+	bool checkMissionItemValidity(const mission_item_s &item, size_t index);
+	bool checkDistanceToFirstWaypoint(const mission_item_s &item);
+	bool checkDistanceToPreviousWaypoint(const mission_item_s &item);
+	bool checkGeofence(const mission_item_s &item, size_t index);
+	void checkHomePositionAltitude(const mission_item_s &item, size_t index);
+	bool checkTakeoff(const mission_item_s &item, size_t index);
 
 	/* Checks specific to fixedwing airframes */
-	bool checkFixedwing(const mission_s &mission, float home_alt, bool land_start_req);
-	bool checkFixedWingLanding(const mission_s &mission, bool land_start_req);
-
-	/* Checks specific to rotarywing airframes */
-	bool checkRotarywing(const mission_s &mission, float home_alt);
+	bool checkFixedWingLanding(const mission_item_s &item, size_t index);
 
 	/* Checks specific to VTOL airframes */
-	bool checkVTOL(const mission_s &mission, float home_alt, bool land_start_req);
-	bool checkVTOLLanding(const mission_s &mission, bool land_start_req);
+	bool checkVTOLLanding(const mission_item_s &item, size_t index);
+
+	/* Checks after the last item, false if the mission is not feasible */
+	bool checkTakeoffResult();
+	bool checkLandingResult();
 
 public:
 	MissionFeasibilityChecker(Navigator *navigator) : _navigator(navigator) {}
@@ -83,11 +129,25 @@ public:
 	MissionFeasibilityChecker(const MissionFeasibilityChecker &) = delete;
 	MissionFeasibilityChecker &operator=(const MissionFeasibilityChecker &) = delete;
 
+	/**
+	 * Start checking a mission, any running check is aborted.
+	 * The items are checked by advance().
+	 */
+	void start(const mission_s &mission, float max_distance_to_1st_waypoint, float max_distance_between_waypoints,
+		   bool land_start_req);
+
+	/**
+	 * Continue the running check
+	 * @param max_items maximum number of mission items to check in this call
+	 * @return true if the check is finished, see feasible()
+	 */
+	bool advance(unsigned max_items);
+
+	bool running() const { return _running; }
+
 	/*
-	 * Returns true if mission is feasible and false otherwise
+	 * Returns true if the last finished check found the mission feasible
 	 */
-	bool checkMissionFeasible(const mission_s &mission,
-				  float max_distance_to_1st_waypoint, float max_distance_between_waypoints,
-				  bool land_start_req);
+	bool feasible() const { return _feasible; }
 
 };
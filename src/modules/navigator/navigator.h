@@ -52,14 +52,19 @@
 #include "navigator_mode.h"
 #include "rtl.h"
 #include "takeoff.h"
+#include "terrain_tiles.h"
+#include "traffic_table.h"
 
 #include "navigation.h"
 
 #include <lib/perf/perf_counter.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/collision_report.h>
 #include <uORB/topics/geofence_result.h>
 #include <uORB/topics/home_position.h>
 #include <uORB/topics/mission.h>
@@ -84,7 +89,7 @@
 #define NAVIGATOR_MODE_ARRAY_SIZE 9
 
 
-class Navigator : public ModuleBase<Navigator>, public ModuleParams
+class Navigator : public ModuleBase<Navigator>, public ModuleParams, public px4::ScheduledWorkItem
 {
 public:
 	Navigator();
@@ -96,17 +101,13 @@ public:
 	/** @see ModuleBase */
 	static int task_spawn(int argc, char *argv[]);
 
-	/** @see ModuleBase */
-	static Navigator *instantiate(int argc, char *argv[]);
-
 	/** @see ModuleBase */
 	static int custom_command(int argc, char *argv[]);
 
 	/** @see ModuleBase */
 	static int print_usage(const char *reason = nullptr);
 
-	/** @see ModuleBase::run() */
-	void run() override;
+	bool init();
 
 	/** @see ModuleBase::print_status() */
 	int print_status() override;
@@ -137,6 +138,11 @@ public:
 	 */
 	void		check_traffic();
 
+	/**
+	 * Report a traffic conflict and execute the avoidance action (NAV_TRAFF_AVOID)
+	 */
+	void		report_traffic_conflict(const TrafficTable::Entry &entry);
+
 	/**
 	 * Setters
 	 */
@@ -166,9 +172,13 @@ public:
 
 	Geofence	&get_geofence() { return _geofence; }
 
+	TerrainTiles	&get_terrain() { return _terrain; }
+
 	bool		get_can_loiter_at_sp() { return _can_loiter_at_sp; }
 	float		get_loiter_radius() { return _param_nav_loiter_rad.get(); }
 
+	float		get_terrain_clearance() const { return _param_nav_terr_clr.get(); }
+
 	/**
 	 * Returns the default acceptance radius defined by the parameter
 	 */
@@ -311,6 +321,7 @@ private:
 		(ParamInt<px4::params::NAV_TRAFF_AVOID>) _param_nav_traff_avoid,	/**< avoiding other aircraft is enabled */
 		(ParamFloat<px4::params::NAV_TRAFF_A_RADU>) _param_nav_traff_a_radu,	/**< avoidance Distance Unmanned*/
 		(ParamFloat<px4::params::NAV_TRAFF_A_RADM>) _param_nav_traff_a_radm,	/**< avoidance Distance Manned*/
+		(ParamFloat<px4::params::NAV_TERR_CLR>) _param_nav_terr_clr,	/**< minimum clearance above the terrain */
 
 		// non-navigator parameters
 		// Mission (MIS_*)
@@ -321,8 +332,12 @@ private:
 		(ParamFloat<px4::params::MIS_YAW_ERR>) _param_mis_yaw_err
 	)
 
-	int		_local_pos_sub{-1};		/**< local position subscription */
-	int		_vehicle_status_sub{-1};	/**< local position subscription */
+	void Run() override;
+
+	// topics that trigger a navigator iteration
+	uORB::SubscriptionCallbackWorkItem _local_pos_sub{this, ORB_ID(vehicle_local_position)};	/**< local position subscription */
+	uORB::SubscriptionCallbackWorkItem _vehicle_status_sub{this, ORB_ID(vehicle_status)};	/**< vehicle status subscription */
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub{this, ORB_ID(vehicle_command)};	/**< vehicle commands (onboard and offboard) */
 
 	uORB::Subscription _global_pos_sub{ORB_ID(vehicle_global_position)};	/**< global position subscription */
 	uORB::Subscription _gps_pos_sub{ORB_ID(vehicle_gps_position)};		/**< gps position subscription */
@@ -331,10 +346,10 @@ private:
 	uORB::Subscription _parameter_update_sub{ORB_ID(parameter_update)};	/**< param update subscription */
 	uORB::Subscription _pos_ctrl_landing_status_sub{ORB_ID(position_controller_landing_status)};	/**< position controller landing status subscription */
 	uORB::Subscription _traffic_sub{ORB_ID(transponder_report)};		/**< traffic subscription */
-	uORB::Subscription _vehicle_command_sub{ORB_ID(vehicle_command)};	/**< vehicle commands (onboard and offboard) */
 
 	uORB::SubscriptionData<position_controller_status_s>	_position_controller_status_sub{ORB_ID(position_controller_status)};
 
+	uORB::Publication<collision_report_s>		_collision_report_pub{ORB_ID(collision_report)};
 	uORB::Publication<geofence_result_s>		_geofence_result_pub{ORB_ID(geofence_result)};
 	uORB::Publication<mission_result_s>		_mission_result_pub{ORB_ID(mission_result)};
 	uORB::Publication<position_setpoint_triplet_s>	_pos_sp_triplet_pub{ORB_ID(position_setpoint_triplet)};
@@ -366,7 +381,11 @@ private:
 	perf_counter_t	_loop_perf;			/**< loop performance counter */
 
 	Geofence	_geofence;			/**< class that handles the geofence */
+	TerrainTiles	_terrain;			/**< terrain elevation lookup */
+	TrafficTable	_traffic_table;			/**< traffic reported by transponders */
 	bool		_geofence_violation_warning_sent{false}; /**< prevents spaming to mavlink */
+	bool		_have_geofence_position_data{false};	/**< new position data since the last geofence check */
+	hrt_abstime	_last_geofence_check{0};
 
 	bool		_can_loiter_at_sp{false};			/**< flags if current position SP can be used to loiter */
 	bool		_pos_sp_triplet_updated{false};		/**< flags if position SP triplet needs to be published */
@@ -76,6 +76,7 @@ Navigator	*g_navigator;
 
 Navigator::Navigator() :
 	ModuleParams(nullptr),
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::navigator),
 	_loop_perf(perf_alloc(PC_ELAPSED, "navigator")),
 	_geofence(this),
 	_mission(this),
@@ -102,17 +103,12 @@ Navigator::Navigator() :
 	_handle_back_trans_dec_mss = param_find("VT_B_DEC_MSS");
 	_handle_reverse_delay = param_find("VT_B_REV_DEL");
 
-	_local_pos_sub = orb_subscribe(ORB_ID(vehicle_local_position));
-	_vehicle_status_sub = orb_subscribe(ORB_ID(vehicle_status));
-
 	reset_triplets();
 }
 
 Navigator::~Navigator()
 {
 	perf_free(_loop_perf);
-	orb_unsubscribe(_local_pos_sub);
-	orb_unsubscribe(_vehicle_status_sub);
 }
 
 void
@@ -129,11 +125,9 @@ Navigator::params_update()
 	}
 }
 
-void
-Navigator::run()
+bool
+Navigator::init()
 {
-	bool have_geofence_position_data = false;
-
 	/* Try to load the geofence:
 	 * if /fs/microsd/etc/geofence.txt load from this file */
 	struct stat buffer;
@@ -145,620 +139,608 @@ Navigator::run()
 
 	params_update();
 
-	/* wakeup source(s) */
-	px4_pollfd_struct_t fds[2] {};
+	if (!_local_pos_sub.registerCallback() || !_vehicle_status_sub.registerCallback()
+	    || !_vehicle_command_sub.registerCallback()) {
+		PX4_ERR("callback registration failed");
+		return false;
+	}
 
-	/* Setup of loop */
-	fds[0].fd = _local_pos_sub;
-	fds[0].events = POLLIN;
-	fds[1].fd = _vehicle_status_sub;
-	fds[1].events = POLLIN;
+	/* rate-limit position updates to 20 Hz / 50 ms */
+	_local_pos_sub.set_interval_ms(50);
 
-	/* rate-limit position subscription to 20 Hz / 50 ms */
-	orb_set_interval(_local_pos_sub, 50);
+	ScheduleNow();
 
-	hrt_abstime last_geofence_check = 0;
+	return true;
+}
 
-	while (!should_exit()) {
+void
+Navigator::Run()
+{
+	if (should_exit()) {
+		_local_pos_sub.unregisterCallback();
+		_vehicle_status_sub.unregisterCallback();
+		_vehicle_command_sub.unregisterCallback();
+		exit_and_cleanup();
+		return;
+	}
 
-		/* wait for up to 1000ms for data */
-		int pret = px4_poll(&fds[0], (sizeof(fds) / sizeof(fds[0])), 1000);
+	perf_begin(_loop_perf);
 
-		if (pret == 0) {
-			/* Let the loop run anyway, don't do `continue` here. */
+	_local_pos_sub.update(&_local_pos);
+	_vehicle_status_sub.update(&_vstatus);
 
-		} else if (pret < 0) {
-			/* this is undesirable but not much we can do - might want to flag unhappy status */
-			PX4_ERR("poll error %d, %d", pret, errno);
-			px4_usleep(10000);
-			continue;
+	/* gps updated */
+	if (_gps_pos_sub.updated()) {
+		_gps_pos_sub.copy(&_gps_pos);
 
-		} else {
-			if (fds[0].revents & POLLIN) {
-				/* success, local pos is available */
-				orb_copy(ORB_ID(vehicle_local_position), _local_pos_sub, &_local_pos);
-			}
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
+			_have_geofence_position_data = true;
 		}
+	}
 
-		perf_begin(_loop_perf);
+	/* global position updated */
+	if (_global_pos_sub.updated()) {
+		_global_pos_sub.copy(&_global_pos);
 
-		orb_copy(ORB_ID(vehicle_status), _vehicle_status_sub, &_vstatus);
+		if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
+			_have_geofence_position_data = true;
+		}
+	}
 
-		/* gps updated */
-		if (_gps_pos_sub.updated()) {
-			_gps_pos_sub.copy(&_gps_pos);
+	// check for parameter updates
+	if (_parameter_update_sub.updated()) {
+		// clear update
+		parameter_update_s pupdate;
+		_parameter_update_sub.copy(&pupdate);
 
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GPS) {
-				have_geofence_position_data = true;
-			}
-		}
+		// update parameters from storage
+		params_update();
+	}
 
-		/* global position updated */
-		if (_global_pos_sub.updated()) {
-			_global_pos_sub.copy(&_global_pos);
+	_land_detected_sub.update(&_land_detected);
+	_position_controller_status_sub.update();
+	_home_pos_sub.update(&_home_pos);
 
-			if (_geofence.getSource() == Geofence::GF_SOURCE_GLOBALPOS) {
-				have_geofence_position_data = true;
-			}
-		}
+	if (_vehicle_command_sub.updated()) {
+		vehicle_command_s cmd{};
+		_vehicle_command_sub.copy(&cmd);
 
-		// check for parameter updates
-		if (_parameter_update_sub.updated()) {
-			// clear update
-			parameter_update_s pupdate;
-			_parameter_update_sub.copy(&pupdate);
+		if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_GO_AROUND) {
 
-			// update parameters from storage
-			params_update();
-		}
+			// DO_GO_AROUND is currently handled by the position controller (unacknowledged)
+			// TODO: move DO_GO_AROUND handling to navigator
+			publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-		_land_detected_sub.update(&_land_detected);
-		_position_controller_status_sub.update();
-		_home_pos_sub.update(&_home_pos);
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_REPOSITION) {
 
-		if (_vehicle_command_sub.updated()) {
-			vehicle_command_s cmd{};
-			_vehicle_command_sub.copy(&cmd);
+			bool reposition_valid = true;
 
-			if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_GO_AROUND) {
+			if (_have_geofence_position_data &&
+			    ((_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
+			     (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_WARN))) {
 
-				// DO_GO_AROUND is currently handled by the position controller (unacknowledged)
-				// TODO: move DO_GO_AROUND handling to navigator
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
+				if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_REPOSITION) {
+					vehicle_global_position_s test_reposition_validity {};
+					test_reposition_validity.lat = cmd.param5;
+					test_reposition_validity.lon = cmd.param6;
 
-				bool reposition_valid = true;
+					if (PX4_ISFINITE(cmd.param7)) {
+						test_reposition_validity.alt = cmd.param7;
 
-				if (have_geofence_position_data &&
-				    ((_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
-				     (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_WARN))) {
+					} else {
+						test_reposition_validity.alt = get_global_position()->alt;
+					}
 
-					if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+					reposition_valid = _geofence.check(test_reposition_validity, _gps_pos, _home_pos,
+									   home_position_valid());
+				}
+			}
 
-						vehicle_global_position_s test_reposition_validity {};
-						test_reposition_validity.lat = cmd.param5;
-						test_reposition_validity.lon = cmd.param6;
+			if (reposition_valid) {
+				position_setpoint_triplet_s *rep = get_reposition_triplet();
+				position_setpoint_triplet_s *curr = get_position_setpoint_triplet();
 
-						if (PX4_ISFINITE(cmd.param7)) {
-							test_reposition_validity.alt = cmd.param7;
+				// store current position as previous position and goal as next
+				rep->previous.yaw = get_global_position()->yaw;
+				rep->previous.lat = get_global_position()->lat;
+				rep->previous.lon = get_global_position()->lon;
+				rep->previous.alt = get_global_position()->alt;
 
-						} else {
-							test_reposition_validity.alt = get_global_position()->alt;
-						}
+				rep->current.loiter_radius = get_loiter_radius();
+				rep->current.loiter_direction = 1;
+				rep->current.type = position_setpoint_s::SETPOINT_TYPE_LOITER;
 
-						reposition_valid = _geofence.check(test_reposition_validity, _gps_pos, _home_pos,
-										   home_position_valid());
-					}
+				// If no argument for ground speed, use default value.
+				if (cmd.param1 <= 0 || !PX4_ISFINITE(cmd.param1)) {
+					rep->current.cruising_speed = get_cruising_speed();
+
+				} else {
+					rep->current.cruising_speed = cmd.param1;
 				}
 
-				if (reposition_valid) {
-					position_setpoint_triplet_s *rep = get_reposition_triplet();
-					position_setpoint_triplet_s *curr = get_position_setpoint_triplet();
+				rep->current.cruising_throttle = get_cruising_throttle();
+				rep->current.acceptance_radius = get_acceptance_radius();
 
-					// store current position as previous position and goal as next
-					rep->previous.yaw = get_global_position()->yaw;
-					rep->previous.lat = get_global_position()->lat;
-					rep->previous.lon = get_global_position()->lon;
-					rep->previous.alt = get_global_position()->alt;
+				// Go on and check which changes had been requested
+				if (PX4_ISFINITE(cmd.param4)) {
+					rep->current.yaw = cmd.param4;
+					rep->current.yaw_valid = true;
 
-					rep->current.loiter_radius = get_loiter_radius();
-					rep->current.loiter_direction = 1;
-					rep->current.type = position_setpoint_s::SETPOINT_TYPE_LOITER;
+				} else {
+					rep->current.yaw = NAN;
+					rep->current.yaw_valid = false;
+				}
 
-					// If no argument for ground speed, use default value.
-					if (cmd.param1 <= 0 || !PX4_ISFINITE(cmd.param1)) {
-						rep->current.cruising_speed = get_cruising_speed();
+				if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+
+					// Position change with optional altitude change
+					rep->current.lat = cmd.param5;
+					rep->current.lon = cmd.param6;
+
+					if (PX4_ISFINITE(cmd.param7)) {
+						rep->current.alt = cmd.param7;
 
 					} else {
-						rep->current.cruising_speed = cmd.param1;
+						rep->current.alt = get_global_position()->alt;
 					}
 
-					rep->current.cruising_throttle = get_cruising_throttle();
-					rep->current.acceptance_radius = get_acceptance_radius();
+				} else if (PX4_ISFINITE(cmd.param7)) {
 
-					// Go on and check which changes had been requested
-					if (PX4_ISFINITE(cmd.param4)) {
-						rep->current.yaw = cmd.param4;
-						rep->current.yaw_valid = true;
+					// Altitude without position change
+					// This condition is necessary for altitude changes just after takeoff where lat and lon are still nan
+					if (curr->current.valid && PX4_ISFINITE(curr->current.lat) && PX4_ISFINITE(curr->current.lon)) {
+						rep->current.lat = curr->current.lat;
+						rep->current.lon = curr->current.lon;
 
 					} else {
-						rep->current.yaw = NAN;
-						rep->current.yaw_valid = false;
+						rep->current.lat = get_global_position()->lat;
+						rep->current.lon = get_global_position()->lon;
 					}
 
-					if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+					rep->current.alt = cmd.param7;
 
-						// Position change with optional altitude change
-						rep->current.lat = cmd.param5;
-						rep->current.lon = cmd.param6;
+				} else {
+					// All three set to NaN - hold in current position
+					rep->current.lat = get_global_position()->lat;
+					rep->current.lon = get_global_position()->lon;
+					rep->current.alt = get_global_position()->alt;
+				}
 
-						if (PX4_ISFINITE(cmd.param7)) {
-							rep->current.alt = cmd.param7;
+				rep->previous.valid = true;
+				rep->previous.timestamp = hrt_absolute_time();
 
-						} else {
-							rep->current.alt = get_global_position()->alt;
-						}
+				rep->current.valid = true;
+				rep->current.timestamp = hrt_absolute_time();
 
-					} else if (PX4_ISFINITE(cmd.param7)) {
+				rep->next.valid = false;
 
-						// Altitude without position change
-						// This condition is necessary for altitude changes just after takeoff where lat and lon are still nan
-						if (curr->current.valid && PX4_ISFINITE(curr->current.lat) && PX4_ISFINITE(curr->current.lon)) {
-							rep->current.lat = curr->current.lat;
-							rep->current.lon = curr->current.lon;
+			} else {
+				mavlink_log_critical(&_mavlink_log_pub, "Reposition is outside geofence");
+			}
 
-						} else {
-							rep->current.lat = get_global_position()->lat;
-							rep->current.lon = get_global_position()->lon;
-						}
+			// CMD_DO_REPOSITION is acknowledged by commander
 
-						rep->current.alt = cmd.param7;
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_TAKEOFF) {
+			position_setpoint_triplet_s *rep = get_takeoff_triplet();
 
-					} else {
-						// All three set to NaN - hold in current position
-						rep->current.lat = get_global_position()->lat;
-						rep->current.lon = get_global_position()->lon;
-						rep->current.alt = get_global_position()->alt;
-					}
+			// store current position as previous position and goal as next
+			rep->previous.yaw = get_local_position()->yaw;
+			rep->previous.lat = get_global_position()->lat;
+			rep->previous.lon = get_global_position()->lon;
+			rep->previous.alt = get_global_position()->alt;
 
-					rep->previous.valid = true;
-					rep->previous.timestamp = hrt_absolute_time();
+			rep->current.loiter_radius = get_loiter_radius();
+			rep->current.loiter_direction = 1;
+			rep->current.type = position_setpoint_s::SETPOINT_TYPE_TAKEOFF;
 
-					rep->current.valid = true;
-					rep->current.timestamp = hrt_absolute_time();
+			if (home_position_valid()) {
+				rep->current.yaw = cmd.param4;
 
-					rep->next.valid = false;
+				rep->previous.valid = true;
+				rep->previous.timestamp = hrt_absolute_time();
 
-				} else {
-					mavlink_log_critical(&_mavlink_log_pub, "Reposition is outside geofence");
-				}
+			} else {
+				rep->current.yaw = get_local_position()->yaw;
+				rep->previous.valid = false;
+			}
 
-				// CMD_DO_REPOSITION is acknowledged by commander
+			if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
+				rep->current.lat = cmd.param5;
+				rep->current.lon = cmd.param6;
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_TAKEOFF) {
-				position_setpoint_triplet_s *rep = get_takeoff_triplet();
+			} else {
+				// If one of them is non-finite, reset both
+				rep->current.lat = (double)NAN;
+				rep->current.lon = (double)NAN;
+			}
 
-				// store current position as previous position and goal as next
-				rep->previous.yaw = get_local_position()->yaw;
-				rep->previous.lat = get_global_position()->lat;
-				rep->previous.lon = get_global_position()->lon;
-				rep->previous.alt = get_global_position()->alt;
+			rep->current.alt = cmd.param7;
 
-				rep->current.loiter_radius = get_loiter_radius();
-				rep->current.loiter_direction = 1;
-				rep->current.type = position_setpoint_s::SETPOINT_TYPE_TAKEOFF;
+			rep->current.valid = true;
+			rep->current.timestamp = hrt_absolute_time();
 
-				if (home_position_valid()) {
-					rep->current.yaw = cmd.param4;
+			rep->next.valid = false;
 
-					rep->previous.valid = true;
-					rep->previous.timestamp = hrt_absolute_time();
+			// CMD_NAV_TAKEOFF is acknowledged by commander
 
-				} else {
-					rep->current.yaw = get_local_position()->yaw;
-					rep->previous.valid = false;
-				}
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_LAND_START) {
 
-				if (PX4_ISFINITE(cmd.param5) && PX4_ISFINITE(cmd.param6)) {
-					rep->current.lat = cmd.param5;
-					rep->current.lon = cmd.param6;
+			/* find NAV_CMD_DO_LAND_START in the mission and
+			 * use MAV_CMD_MISSION_START to start the mission there
+			 */
+			if (_mission.land_start()) {
+				vehicle_command_s vcmd = {};
+				vcmd.command = vehicle_command_s::VEHICLE_CMD_MISSION_START;
+				vcmd.param1 = _mission.get_land_start_index();
+				publish_vehicle_cmd(&vcmd);
 
-				} else {
-					// If one of them is non-finite, reset both
-					rep->current.lat = (double)NAN;
-					rep->current.lon = (double)NAN;
-				}
+			} else {
+				PX4_WARN("planned mission landing not available");
+			}
 
-				rep->current.alt = cmd.param7;
+			publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-				rep->current.valid = true;
-				rep->current.timestamp = hrt_absolute_time();
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_MISSION_START) {
+			if (_mission_result.valid && PX4_ISFINITE(cmd.param1) && (cmd.param1 >= 0)) {
+				if (!_mission.set_current_mission_index(cmd.param1)) {
+					PX4_WARN("CMD_MISSION_START failed");
+				}
+			}
 
-				rep->next.valid = false;
+			// CMD_MISSION_START is acknowledged by commander
 
-				// CMD_NAV_TAKEOFF is acknowledged by commander
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_CHANGE_SPEED) {
+			if (cmd.param2 > FLT_EPSILON) {
+				// XXX not differentiating ground and airspeed yet
+				set_cruising_speed(cmd.param2);
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_LAND_START) {
+			} else {
+				set_cruising_speed();
 
-				/* find NAV_CMD_DO_LAND_START in the mission and
-				 * use MAV_CMD_MISSION_START to start the mission there
-				 */
-				if (_mission.land_start()) {
-					vehicle_command_s vcmd = {};
-					vcmd.command = vehicle_command_s::VEHICLE_CMD_MISSION_START;
-					vcmd.param1 = _mission.get_land_start_index();
-					publish_vehicle_cmd(&vcmd);
+				/* if no speed target was given try to set throttle */
+				if (cmd.param3 > FLT_EPSILON) {
+					set_cruising_throttle(cmd.param3 / 100);
 
 				} else {
-					PX4_WARN("planned mission landing not available");
+					set_cruising_throttle();
 				}
+			}
 
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
-
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_MISSION_START) {
-				if (_mission_result.valid && PX4_ISFINITE(cmd.param1) && (cmd.param1 >= 0)) {
-					if (!_mission.set_current_mission_index(cmd.param1)) {
-						PX4_WARN("CMD_MISSION_START failed");
-					}
-				}
+			// TODO: handle responses for supported DO_CHANGE_SPEED options?
+			publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 
-				// CMD_MISSION_START is acknowledged by commander
+		} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI
+			   || cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_ROI
+			   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION
+			   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET
+			   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE) {
+			_vroi = {};
 
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_CHANGE_SPEED) {
-				if (cmd.param2 > FLT_EPSILON) {
-					// XXX not differentiating ground and airspeed yet
-					set_cruising_speed(cmd.param2);
+			switch (cmd.command) {
+			case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI:
+			case vehicle_command_s::VEHICLE_CMD_NAV_ROI:
+				_vroi.mode = cmd.param1;
+				break;
 
-				} else {
-					set_cruising_speed();
+			case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION:
+				_vroi.mode = vehicle_command_s::VEHICLE_ROI_LOCATION;
+				_vroi.lat = cmd.param5;
+				_vroi.lon = cmd.param6;
+				_vroi.alt = cmd.param7;
+				break;
 
-					/* if no speed target was given try to set throttle */
-					if (cmd.param3 > FLT_EPSILON) {
-						set_cruising_throttle(cmd.param3 / 100);
+			case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET:
+				_vroi.mode = vehicle_command_s::VEHICLE_ROI_WPNEXT;
+				_vroi.pitch_offset = (float)cmd.param5 * M_DEG_TO_RAD_F;
+				_vroi.roll_offset = (float)cmd.param6 * M_DEG_TO_RAD_F;
+				_vroi.yaw_offset = (float)cmd.param7 * M_DEG_TO_RAD_F;
+				break;
 
-					} else {
-						set_cruising_throttle();
-					}
-				}
+			case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE:
+				_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
+				break;
 
-				// TODO: handle responses for supported DO_CHANGE_SPEED options?
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
-
-			} else if (cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_NAV_ROI
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET
-				   || cmd.command == vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE) {
-				_vroi = {};
-
-				switch (cmd.command) {
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI:
-				case vehicle_command_s::VEHICLE_CMD_NAV_ROI:
-					_vroi.mode = cmd.param1;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_LOCATION:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_LOCATION;
-					_vroi.lat = cmd.param5;
-					_vroi.lon = cmd.param6;
-					_vroi.alt = cmd.param7;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_WPNEXT_OFFSET:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_WPNEXT;
-					_vroi.pitch_offset = (float)cmd.param5 * M_DEG_TO_RAD_F;
-					_vroi.roll_offset = (float)cmd.param6 * M_DEG_TO_RAD_F;
-					_vroi.yaw_offset = (float)cmd.param7 * M_DEG_TO_RAD_F;
-					break;
-
-				case vehicle_command_s::VEHICLE_CMD_DO_SET_ROI_NONE:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
-					break;
-
-				default:
-					_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
-					break;
-				}
+			default:
+				_vroi.mode = vehicle_command_s::VEHICLE_ROI_NONE;
+				break;
+			}
 
-				_vroi.timestamp = hrt_absolute_time();
+			_vroi.timestamp = hrt_absolute_time();
 
-				_vehicle_roi_pub.publish(_vroi);
+			_vehicle_roi_pub.publish(_vroi);
 
-				publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
-			}
+			publish_vehicle_command_ack(cmd, vehicle_command_s::VEHICLE_CMD_RESULT_ACCEPTED);
 		}
+	}
 
-		/* Check for traffic */
-		check_traffic();
-
-		/* Check geofence violation */
-		if (have_geofence_position_data &&
-		    (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
-		    (hrt_elapsed_time(&last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
+	/* Check for traffic */
+	check_traffic();
 
-			bool inside = _geofence.check(_global_pos, _gps_pos, _home_pos,
-						      home_position_valid());
-			last_geofence_check = hrt_absolute_time();
-			have_geofence_position_data = false;
+	/* Check geofence violation */
+	if (_have_geofence_position_data &&
+	    (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_NONE) &&
+	    (hrt_elapsed_time(&_last_geofence_check) > GEOFENCE_CHECK_INTERVAL)) {
 
-			_geofence_result.timestamp = hrt_absolute_time();
-			_geofence_result.geofence_action = _geofence.getGeofenceAction();
-			_geofence_result.home_required = _geofence.isHomeRequired();
+		bool inside = _geofence.check(_global_pos, _gps_pos, _home_pos,
+					      home_position_valid());
+		_last_geofence_check = hrt_absolute_time();
+		_have_geofence_position_data = false;
 
-			if (!inside) {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = true;
+		_geofence_result.timestamp = hrt_absolute_time();
+		_geofence_result.geofence_action = _geofence.getGeofenceAction();
+		_geofence_result.home_required = _geofence.isHomeRequired();
 
-				/* Issue a warning about the geofence violation once */
-				if (!_geofence_violation_warning_sent) {
-					mavlink_log_critical(&_mavlink_log_pub, "Geofence violation");
+		if (!inside) {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = true;
 
-					/* If we are already in loiter it is very likely that we are doing a reposition
-					 * so we should block that by repositioning in the current location */
-					if (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_WARN
-					    && get_vstatus()->nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER) {
-						position_setpoint_triplet_s *rep = get_reposition_triplet();
+			/* Issue a warning about the geofence violation once */
+			if (!_geofence_violation_warning_sent) {
+				mavlink_log_critical(&_mavlink_log_pub, "Geofence violation");
 
-						rep->current.yaw = get_global_position()->yaw;
-						rep->current.lat = get_global_position()->lat;
-						rep->current.lon = get_global_position()->lon;
-						rep->current.alt = get_global_position()->alt;
-						rep->current.valid = true;
+				/* If we are already in loiter it is very likely that we are doing a reposition
+				 * so we should block that by repositioning in the current location */
+				if (_geofence.getGeofenceAction() != geofence_result_s::GF_ACTION_WARN
+				    && get_vstatus()->nav_state == vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER) {
+					position_setpoint_triplet_s *rep = get_reposition_triplet();
 
-						_pos_sp_triplet_updated = true;
-					}
+					rep->current.yaw = get_global_position()->yaw;
+					rep->current.lat = get_global_position()->lat;
+					rep->current.lon = get_global_position()->lon;
+					rep->current.alt = get_global_position()->alt;
+					rep->current.valid = true;
 
-					_geofence_violation_warning_sent = true;
+					_pos_sp_triplet_updated = true;
 				}
 
-			} else {
-				/* inform other apps via the mission result */
-				_geofence_result.geofence_violated = false;
-
-				/* Reset the _geofence_violation_warning_sent field */
-				_geofence_violation_warning_sent = false;
+				_geofence_violation_warning_sent = true;
 			}
 
-			_geofence_result_pub.publish(_geofence_result);
+		} else {
+			/* inform other apps via the mission result */
+			_geofence_result.geofence_violated = false;
+
+			/* Reset the _geofence_violation_warning_sent field */
+			_geofence_violation_warning_sent = false;
 		}
 
-		/* Do stuff according to navigation state set by commander */
-		NavigatorMode *navigation_mode_new{nullptr};
+		_geofence_result_pub.publish(_geofence_result);
+	}
 
-		switch (_vstatus.nav_state) {
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
-			_pos_sp_triplet_published_invalid_once = false;
+	/* Do stuff according to navigation state set by commander */
+	NavigatorMode *navigation_mode_new{nullptr};
 
-			_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_NORMAL);
-			navigation_mode_new = &_mission;
+	switch (_vstatus.nav_state) {
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_MISSION:
+		_pos_sp_triplet_published_invalid_once = false;
 
-			break;
+		_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_NORMAL);
+		navigation_mode_new = &_mission;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_loiter;
-			break;
+		break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL: {
-				_pos_sp_triplet_published_invalid_once = false;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LOITER:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_loiter;
+		break;
 
-				const bool rtl_activated = _previous_nav_state != vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_RTL: {
+			_pos_sp_triplet_published_invalid_once = false;
 
-				switch (rtl_type()) {
-				case RTL::RTL_LAND: // use mission landing
-				case RTL::RTL_CLOSEST:
-					if (rtl_activated) {
-						if (rtl_type() == RTL::RTL_LAND) {
-							mavlink_log_info(get_mavlink_log_pub(), "RTL LAND activated");
+			const bool rtl_activated = _previous_nav_state != vehicle_status_s::NAVIGATION_STATE_AUTO_RTL;
 
-						} else {
-							mavlink_log_info(get_mavlink_log_pub(), "RTL Closest landing point activated");
-						}
+			switch (rtl_type()) {
+			case RTL::RTL_LAND: // use mission landing
+			case RTL::RTL_CLOSEST:
+				if (rtl_activated) {
+					if (rtl_type() == RTL::RTL_LAND) {
+						mavlink_log_info(get_mavlink_log_pub(), "RTL LAND activated");
 
+					} else {
+						mavlink_log_info(get_mavlink_log_pub(), "RTL Closest landing point activated");
 					}
 
-					// if RTL is set to use a mission landing and mission has a planned landing, then use MISSION to fly there directly
-					if (on_mission_landing() && !get_land_detected()->landed) {
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
-						navigation_mode_new = &_mission;
+				}
 
-					} else {
-						navigation_mode_new = &_rtl;
-					}
+				// if RTL is set to use a mission landing and mission has a planned landing, then use MISSION to fly there directly
+				if (on_mission_landing() && !get_land_detected()->landed) {
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
+					navigation_mode_new = &_mission;
 
-					break;
+				} else {
+					navigation_mode_new = &_rtl;
+				}
 
-				case RTL::RTL_MISSION:
-					if (_mission.get_land_start_available() && !get_land_detected()->landed) {
-						// the mission contains a landing spot
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
+				break;
 
-						if (_navigation_mode != &_mission) {
-							if (_navigation_mode == nullptr) {
-								// switching from an manual mode, go to landing if not already landing
-								if (!on_mission_landing()) {
-									start_mission_landing();
-								}
+			case RTL::RTL_MISSION:
+				if (_mission.get_land_start_available() && !get_land_detected()->landed) {
+					// the mission contains a landing spot
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_FAST_FORWARD);
 
-							} else {
-								// switching from an auto mode, continue the mission from the closest item
-								_mission.set_closest_item_as_current();
+					if (_navigation_mode != &_mission) {
+						if (_navigation_mode == nullptr) {
+							// switching from an manual mode, go to landing if not already landing
+							if (!on_mission_landing()) {
+								start_mission_landing();
 							}
-						}
 
-						if (rtl_activated) {
-							mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, continue mission");
+						} else {
+							// switching from an auto mode, continue the mission from the closest item
+							_mission.set_closest_item_as_current();
 						}
+					}
 
-						navigation_mode_new = &_mission;
+					if (rtl_activated) {
+						mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, continue mission");
+					}
 
-					} else {
-						// fly the mission in reverse if switching from a non-manual mode
-						_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_REVERSE);
-
-						if ((_navigation_mode != nullptr && (_navigation_mode != &_rtl || _mission.get_mission_changed())) &&
-						    (! _mission.get_mission_finished()) &&
-						    (!get_land_detected()->landed)) {
-							// determine the closest mission item if switching from a non-mission mode, and we are either not already
-							// mission mode or the mission waypoints changed.
-							// The seconds condition is required so that when no mission was uploaded and one is available the closest
-							// mission item is determined and also that if the user changes the active mission index while rtl is active
-							// always that waypoint is tracked first.
-							if ((_navigation_mode != &_mission) && (rtl_activated || _mission.get_mission_waypoints_changed())) {
-								_mission.set_closest_item_as_current();
-							}
+					navigation_mode_new = &_mission;
 
-							if (rtl_activated) {
-								mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly mission in reverse");
-							}
+				} else {
+					// fly the mission in reverse if switching from a non-manual mode
+					_mission.set_execution_mode(mission_result_s::MISSION_EXECUTION_MODE_REVERSE);
+
+					if ((_navigation_mode != nullptr && (_navigation_mode != &_rtl || _mission.get_mission_changed())) &&
+					    (! _mission.get_mission_finished()) &&
+					    (!get_land_detected()->landed)) {
+						// determine the closest mission item if switching from a non-mission mode, and we are either not already
+						// mission mode or the mission waypoints changed.
+						// The seconds condition is required so that when no mission was uploaded and one is available the closest
+						// mission item is determined and also that if the user changes the active mission index while rtl is active
+						// always that waypoint is tracked first.
+						if ((_navigation_mode != &_mission) && (rtl_activated || _mission.get_mission_waypoints_changed())) {
+							_mission.set_closest_item_as_current();
+						}
 
-							navigation_mode_new = &_mission;
+						if (rtl_activated) {
+							mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly mission in reverse");
+						}
 
-						} else {
-							if (rtl_activated) {
-								mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly to home");
-							}
+						navigation_mode_new = &_mission;
 
-							navigation_mode_new = &_rtl;
+					} else {
+						if (rtl_activated) {
+							mavlink_log_info(get_mavlink_log_pub(), "RTL Mission activated, fly to home");
 						}
-					}
 
-					break;
-
-				default:
-					if (rtl_activated) {
-						mavlink_log_info(get_mavlink_log_pub(), "RTL HOME activated");
+						navigation_mode_new = &_rtl;
 					}
+				}
 
-					navigation_mode_new = &_rtl;
-					break;
+				break;
 
+			default:
+				if (rtl_activated) {
+					mavlink_log_info(get_mavlink_log_pub(), "RTL HOME activated");
 				}
 
+				navigation_mode_new = &_rtl;
 				break;
-			}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_takeoff;
-			break;
-
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LAND:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_land;
-			break;
+			}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_precland;
-			_precland.set_mode(PrecLandMode::Required);
 			break;
+		}
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_engineFailure;
-			break;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_TAKEOFF:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_takeoff;
+		break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_gpsFailure;
-			break;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LAND:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_land;
+		break;
 
-		case vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET:
-			_pos_sp_triplet_published_invalid_once = false;
-			navigation_mode_new = &_follow_target;
-			break;
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_PRECLAND:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_precland;
+		_precland.set_mode(PrecLandMode::Required);
+		break;
 
-		case vehicle_status_s::NAVIGATION_STATE_MANUAL:
-		case vehicle_status_s::NAVIGATION_STATE_ACRO:
-		case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
-		case vehicle_status_s::NAVIGATION_STATE_POSCTL:
-		case vehicle_status_s::NAVIGATION_STATE_DESCEND:
-		case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
-		case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
-		case vehicle_status_s::NAVIGATION_STATE_STAB:
-		default:
-			navigation_mode_new = nullptr;
-			_can_loiter_at_sp = false;
-			break;
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDENGFAIL:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_engineFailure;
+		break;
 
-		// Do not execute any state machine while we are disarmed
-		if (_vstatus.arming_state != vehicle_status_s::ARMING_STATE_ARMED) {
-			navigation_mode_new = nullptr;
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_LANDGPSFAIL:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_gpsFailure;
+		break;
 
-		// update the vehicle status
-		_previous_nav_state = _vstatus.nav_state;
-
-		/* we have a new navigation mode: reset triplet */
-		if (_navigation_mode != navigation_mode_new) {
-			// We don't reset the triplet if we just did an auto-takeoff and are now
-			// going to loiter. Otherwise, we lose the takeoff altitude and end up lower
-			// than where we wanted to go.
-			//
-			// FIXME: a better solution would be to add reset where they are needed and remove
-			//        this general reset here.
-			if (!(_navigation_mode == &_takeoff &&
-			      navigation_mode_new == &_loiter)) {
-				reset_triplets();
-			}
-		}
+	case vehicle_status_s::NAVIGATION_STATE_AUTO_FOLLOW_TARGET:
+		_pos_sp_triplet_published_invalid_once = false;
+		navigation_mode_new = &_follow_target;
+		break;
 
-		_navigation_mode = navigation_mode_new;
+	case vehicle_status_s::NAVIGATION_STATE_MANUAL:
+	case vehicle_status_s::NAVIGATION_STATE_ACRO:
+	case vehicle_status_s::NAVIGATION_STATE_ALTCTL:
+	case vehicle_status_s::NAVIGATION_STATE_POSCTL:
+	case vehicle_status_s::NAVIGATION_STATE_DESCEND:
+	case vehicle_status_s::NAVIGATION_STATE_TERMINATION:
+	case vehicle_status_s::NAVIGATION_STATE_OFFBOARD:
+	case vehicle_status_s::NAVIGATION_STATE_STAB:
+	default:
+		navigation_mode_new = nullptr;
+		_can_loiter_at_sp = false;
+		break;
+	}
 
-		/* iterate through navigation modes and set active/inactive for each */
-		for (unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
-			if (_navigation_mode_array[i]) {
-				_navigation_mode_array[i]->run(_navigation_mode == _navigation_mode_array[i]);
-			}
-		}
+	// Do not execute any state machine while we are disarmed
+	if (_vstatus.arming_state != vehicle_status_s::ARMING_STATE_ARMED) {
+		navigation_mode_new = nullptr;
+	}
 
-		/* if nothing is running, set position setpoint triplet invalid once */
-		if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
-			_pos_sp_triplet_published_invalid_once = true;
+	// update the vehicle status
+	_previous_nav_state = _vstatus.nav_state;
+
+	/* we have a new navigation mode: reset triplet */
+	if (_navigation_mode != navigation_mode_new) {
+		// We don't reset the triplet if we just did an auto-takeoff and are now
+		// going to loiter. Otherwise, we lose the takeoff altitude and end up lower
+		// than where we wanted to go.
+		//
+		// FIXME: a better solution would be to add reset where they are needed and remove
+		//        this general reset here.
+		if (!(_navigation_mode == &_takeoff &&
+		      navigation_mode_new == &_loiter)) {
 			reset_triplets();
 		}
+	}
 
-		if (_pos_sp_triplet_updated) {
-			publish_position_setpoint_triplet();
-		}
+	_navigation_mode = navigation_mode_new;
 
-		if (_mission_result_updated) {
-			publish_mission_result();
+	/* iterate through navigation modes and set active/inactive for each */
+	for (unsigned int i = 0; i < NAVIGATOR_MODE_ARRAY_SIZE; i++) {
+		if (_navigation_mode_array[i]) {
+			_navigation_mode_array[i]->run(_navigation_mode == _navigation_mode_array[i]);
 		}
+	}
 
-		perf_end(_loop_perf);
+	/* if nothing is running, set position setpoint triplet invalid once */
+	if (_navigation_mode == nullptr && !_pos_sp_triplet_published_invalid_once) {
+		_pos_sp_triplet_published_invalid_once = true;
+		reset_triplets();
 	}
-}
 
-int Navigator::task_spawn(int argc, char *argv[])
-{
-	_task_id = px4_task_spawn_cmd("navigator",
-				      SCHED_DEFAULT,
-				      SCHED_PRIORITY_NAVIGATION,
-				      1800,
-				      (px4_main_t)&run_trampoline,
-				      (char *const *)argv);
-
-	if (_task_id < 0) {
-		_task_id = -1;
-		return -errno;
+	if (_pos_sp_triplet_updated) {
+		publish_position_setpoint_triplet();
 	}
 
-	return 0;
+	if (_mission_result_updated) {
+		publish_mission_result();
+	}
+
+	perf_end(_loop_perf);
+
+	/* run at least once per second, even without any update */
+	ScheduleDelayed(1_s);
 }
 
-Navigator *Navigator::instantiate(int argc, char *argv[])
+int Navigator::task_spawn(int argc, char *argv[])
 {
 	Navigator *instance = new Navigator();
 
-	if (instance == nullptr) {
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
+
+		if (instance->init()) {
+			return PX4_OK;
+		}
+
+	} else {
 		PX4_ERR("alloc failed");
 	}
 
-	return instance;
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
+
+	return PX4_ERROR;
 }
 
 int
@@ -767,6 +749,7 @@ Navigator::print_status()
 	PX4_INFO("Running");
 
 	_geofence.printStatus();
+	_terrain.printStatus();
 	return 0;
 }
 
@@ -968,6 +951,12 @@ void Navigator::fake_traffic(const char *callsign, float distance, float directi
 	transponder_report_s tr{};
 	tr.timestamp = hrt_absolute_time();
 	tr.icao_address = 1234;
+
+	// distinct address per callsign, so that the fake participants are tracked separately
+	for (const char *c = callsign; *c != '\0'; c++) {
+		tr.icao_address = tr.icao_address * 31 + *c;
+	}
+
 	tr.lat = lat; // Latitude, expressed as degrees
 	tr.lon = lon; // Longitude, expressed as degrees
 	tr.altitude_type = 0;
@@ -1007,160 +996,126 @@ void Navigator::fake_traffic(const char *callsign, float distance, float directi
 
 void Navigator::check_traffic()
 {
-	double lat = get_global_position()->lat;
-	double lon = get_global_position()->lon;
-	float alt = get_global_position()->alt;
-
-	// TODO for non-multirotors predicting the future
-	// position as accurately as possible will become relevant
-	// float vel_n = get_global_position()->vel_n;
-	// float vel_e = get_global_position()->vel_e;
-	// float vel_d = get_global_position()->vel_d;
-
-	bool changed = _traffic_sub.updated();
+	// only update the table per report, the prediction runs once for all participants
+	transponder_report_s tr;
 
-	char uas_id[11]; //GUID of incoming UTM messages
+	while (_traffic_sub.update(&tr)) {
+		_traffic_table.update(tr);
+	}
 
-	float NAVTrafficAvoidUnmanned = _param_nav_traff_a_radu.get();
-	float NAVTrafficAvoidManned = _param_nav_traff_a_radm.get();
-	float horizontal_separation = NAVTrafficAvoidManned;
-	float vertical_separation = NAVTrafficAvoidManned;
+	if (_traffic_table.size() == 0) {
+		return;
+	}
 
-	while (changed) {
+	const hrt_abstime now = hrt_absolute_time();
 
-		//vehicle_status_s vs{};
-		transponder_report_s tr{};
-		_traffic_sub.copy(&tr);
+	// the own vehicle is assumed to be stationary if the velocity estimate is not valid
+	const float vel_north = _local_pos.v_xy_valid ? _local_pos.vx : 0.f;
+	const float vel_east = _local_pos.v_xy_valid ? _local_pos.vy : 0.f;
+	const float vel_up = _local_pos.v_z_valid ? -_local_pos.vz : 0.f;
 
-		uint16_t required_flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS |
-					  transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING |
-					  transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY | transponder_report_s::PX4_ADSB_FLAGS_VALID_ALTITUDE;
+	_traffic_table.predictConflicts(now, get_global_position()->lat, get_global_position()->lon,
+					get_global_position()->alt, vel_north, vel_east, vel_up,
+					_param_nav_traff_a_radm.get(), _param_nav_traff_a_radu.get());
 
-		if ((tr.flags & required_flags) != required_flags) {
-			changed = _traffic_sub.updated();
-			continue;
-		}
+	for (int i = 0; i < _traffic_table.size(); i++) {
+		const TrafficTable::Entry &entry = _traffic_table.entry(i);
 
-		//convert UAS_id byte array to char array for User Warning
-		for (int i = 0; i < 5; i++) {
-			snprintf(&uas_id[i * 2], sizeof(uas_id) - i * 2, "%02x", tr.uas_id[PX4_GUID_BYTE_LENGTH - 5 + i]);
+		if (entry.alert) {
+			report_traffic_conflict(entry);
+			_traffic_table.alertSent(i, now);
 		}
+	}
+}
 
-		//Manned/Unmanned Vehicle Seperation Distance
-		if (tr.emitter_type == transponder_report_s::ADSB_EMITTER_TYPE_UAV) {
-			horizontal_separation = NAVTrafficAvoidUnmanned;
-			vertical_separation = NAVTrafficAvoidUnmanned;
-		}
-
-		float d_hor, d_vert;
-		get_distance_to_point_global_wgs84(lat, lon, alt,
-						   tr.lat, tr.lon, tr.altitude, &d_hor, &d_vert);
-
-
-		// predict final altitude (positive is up) in prediction time frame
-		float end_alt = tr.altitude + (d_vert / tr.hor_velocity) * tr.ver_velocity;
-
-		// Predict until the vehicle would have passed this system at its current speed
-		float prediction_distance = d_hor + 1000.0f;
-
-		// If the altitude is not getting close to us, do not calculate
-		// the horizontal separation.
-		// Since commercial flights do most of the time keep flight levels
-		// check for the current and for the predicted flight level.
-		// we also make the implicit assumption that this system is on the lowest
-		// flight level close to ground in the
-		// (end_alt - horizontal_separation < alt) condition. If this system should
-		// ever be used in normal airspace this implementation would anyway be
-		// inappropriate as it should be replaced with a TCAS compliant solution.
-
-		if ((fabsf(alt - tr.altitude) < vertical_separation) || ((end_alt - horizontal_separation) < alt)) {
+void Navigator::report_traffic_conflict(const TrafficTable::Entry &entry)
+{
+	char uas_id[11]; //GUID of incoming UTM messages
 
-			double end_lat, end_lon;
-			waypoint_from_heading_and_distance(tr.lat, tr.lon, tr.heading, prediction_distance, &end_lat, &end_lon);
+	//convert UAS_id byte array to char array for User Warning
+	for (int i = 0; i < 5; i++) {
+		snprintf(&uas_id[i * 2], sizeof(uas_id) - i * 2, "%02x", entry.uas_id[PX4_GUID_BYTE_LENGTH - 5 + i]);
+	}
 
-			struct crosstrack_error_s cr;
+	const char *traffic_name = (entry.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN) ? entry.callsign : uas_id;
 
-			if (!get_distance_to_line(&cr, lat, lon, tr.lat, tr.lon, end_lat, end_lon)) {
+	// direction of traffic in human-readable 0..360 degree in earth frame
+	int traffic_direction = math::degrees(entry.heading) + 180;
+	int traffic_seperation = (int)entry.cpa_horizontal_distance;
 
-				if (!cr.past_end && (fabsf(cr.distance) < horizontal_separation)) {
+	collision_report_s collision_report{};
+	collision_report.src = collision_report_s::SRC_ADSB;
+	collision_report.id = entry.icao_address;
+	collision_report.threat_level = collision_report_s::THREAT_LEVEL_HIGH;
+	collision_report.time_to_minimum_delta = entry.cpa_time;
+	collision_report.altitude_minimum_delta = entry.cpa_vertical_distance;
+	collision_report.horizontal_minimum_delta = entry.cpa_horizontal_distance;
 
-					// direction of traffic in human-readable 0..360 degree in earth frame
-					int traffic_direction = math::degrees(tr.heading) + 180;
-					int traffic_seperation = (int)fabsf(cr.distance);
+	switch (_param_nav_traff_avoid.get()) {
 
-					switch (_param_nav_traff_avoid.get()) {
+	case 0: {
+			/* Ignore */
+			PX4_WARN("TRAFFIC %s! dst %d, hdg %d", traffic_name, traffic_seperation, traffic_direction);
+			collision_report.action = collision_report_s::ACTION_NONE;
+			break;
+		}
 
-					case 0: {
-							/* Ignore */
-							PX4_WARN("TRAFFIC %s! dst %d, hdg %d",
-								 tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-								 traffic_seperation,
-								 traffic_direction);
-							break;
-						}
+	case 1: {
+			/* Warn only */
+			mavlink_log_critical(&_mavlink_log_pub, "Warning TRAFFIC %s! dst %d, hdg %d", traffic_name, traffic_seperation,
+					     traffic_direction);
+			collision_report.action = collision_report_s::ACTION_REPORT;
+			break;
+		}
 
-					case 1: {
-							/* Warn only */
-							mavlink_log_critical(&_mavlink_log_pub, "Warning TRAFFIC %s! dst %d, hdg %d",
-									     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-									     traffic_seperation,
-									     traffic_direction);
-							break;
-						}
+	case 2: {
+			/* RTL Mode */
+			mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Returning home! dst %d, hdg %d", traffic_name,
+					     traffic_seperation, traffic_direction);
+			collision_report.action = collision_report_s::ACTION_RTL;
 
-					case 2: {
-							/* RTL Mode */
-							mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Returning home! dst %d, hdg %d",
-									     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-									     traffic_seperation,
-									     traffic_direction);
-
-							// set the return altitude to minimum
-							_rtl.set_return_alt_min(true);
-
-							// ask the commander to execute an RTL
-							vehicle_command_s vcmd = {};
-							vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_RETURN_TO_LAUNCH;
-							publish_vehicle_cmd(&vcmd);
-							break;
-						}
+			// set the return altitude to minimum
+			_rtl.set_return_alt_min(true);
 
-					case 3: {
-							/* Land Mode */
-							mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Landing! dst %d, hdg % d",
-									     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-									     traffic_seperation,
-									     traffic_direction);
+			// ask the commander to execute an RTL
+			vehicle_command_s vcmd = {};
+			vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_RETURN_TO_LAUNCH;
+			publish_vehicle_cmd(&vcmd);
+			break;
+		}
 
-							// ask the commander to land
-							vehicle_command_s vcmd = {};
-							vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LAND;
-							publish_vehicle_cmd(&vcmd);
-							break;
+	case 3: {
+			/* Land Mode */
+			mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Landing! dst %d, hdg % d", traffic_name,
+					     traffic_seperation, traffic_direction);
+			// there is no landing collision action
+			collision_report.action = collision_report_s::ACTION_REPORT;
+
+			// ask the commander to land
+			vehicle_command_s vcmd = {};
+			vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LAND;
+			publish_vehicle_cmd(&vcmd);
+			break;
 
-						}
+		}
 
-					case 4: {
-							/* Position hold */
-							mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Holding position! dst %d, hdg %d",
-									     tr.flags & transponder_report_s::PX4_ADSB_FLAGS_VALID_CALLSIGN ? tr.callsign : uas_id,
-									     traffic_seperation,
-									     traffic_direction);
+	case 4: {
+			/* Position hold */
+			mavlink_log_critical(&_mavlink_log_pub, "TRAFFIC: %s Holding position! dst %d, hdg %d", traffic_name,
+					     traffic_seperation, traffic_direction);
+			collision_report.action = collision_report_s::ACTION_HOVER;
 
-							// ask the commander to Loiter
-							vehicle_command_s vcmd = {};
-							vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LOITER_UNLIM;
-							publish_vehicle_cmd(&vcmd);
-							break;
+			// ask the commander to Loiter
+			vehicle_command_s vcmd = {};
+			vcmd.command = vehicle_command_s::VEHICLE_CMD_NAV_LOITER_UNLIM;
+			publish_vehicle_cmd(&vcmd);
+			break;
 
-						}
-					}
-				}
-			}
 		}
-
-		changed = _traffic_sub.updated();
 	}
+
+	collision_report.timestamp = hrt_absolute_time();
+	_collision_report_pub.publish(collision_report);
 }
 
 bool
@@ -1316,6 +1271,10 @@ The member `_navigation_mode` contains the current active mode.
 Navigator publishes position setpoint triplets (`position_setpoint_triplet_s`), which are then used by the position
 controller.
 
+The navigator runs on its own low priority work queue, as it blocks on dataman (SD card) access. An iteration
+is triggered by updates of `vehicle_local_position` (at most 20 Hz), `vehicle_status` and `vehicle_command`,
+and runs at least once per second.
+
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("navigator", "controller");
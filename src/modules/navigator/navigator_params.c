@@ -154,6 +154,24 @@ PARAM_DEFINE_FLOAT(NAV_TRAFF_A_RADM, 500);
  */
 PARAM_DEFINE_FLOAT(NAV_TRAFF_A_RADU, 10);
 
+/**
+ * Minimum terrain clearance
+ *
+ * Mission, loiter and return waypoints are raised to keep at least this height above the terrain.
+ * The return altitude is raised to keep the clearance along the direct return path.
+ * The terrain elevation is read from the terrain files in the terrain directory on the SD card,
+ * positions without terrain data are not changed.
+ * Takeoff and landing items are not changed. Set to 0 to disable.
+ *
+ * @unit m
+ * @min 0
+ * @max 1000
+ * @decimal 1
+ * @increment 1
+ * @group Mission
+ */
+PARAM_DEFINE_FLOAT(NAV_TERR_CLR, 0.0f);
+
 /**
  * Airfield home Lat
  *
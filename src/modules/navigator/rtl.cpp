@@ -515,5 +515,15 @@ float RTL::calculate_return_alt_from_cone_half_angle(float cone_half_angle_deg)
 	// always demand altitude which is higher or equal the RTL descend altitude
 	rtl_altitude = math::max(rtl_altitude, _destination.alt + _param_rtl_descend_alt.get());
 
+	// keep the minimum clearance above the terrain along the direct return path
+	const float terrain_clearance = _navigator->get_terrain_clearance();
+	float terrain_alt_max;
+
+	if (terrain_clearance > 0.0f
+	    && _navigator->get_terrain().getMaxElevationAlongPath(gpos.lat, gpos.lon, _destination.lat, _destination.lon,
+		    terrain_alt_max)) {
+		rtl_altitude = math::max(rtl_altitude, terrain_alt_max + terrain_clearance);
+	}
+
 	return rtl_altitude;
 }
@@ -0,0 +1,287 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file terrain_tiles.cpp
+ * Terrain elevation lookup from tiles stored on the SD card
+ */
+
+#include "terrain_tiles.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(MMAP_BASED_TERRAIN)
+#include <sys/mman.h>
+#endif
+
+#include <lib/ecl/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
+#include <px4_platform_common/log.h>
+
+static constexpr double DEG_TO_M = CONSTANTS_RADIUS_OF_EARTH * M_PI / 180.0;
+static constexpr size_t BLOCK_BYTES = TerrainTiles::BLOCK_SAMPLES * TerrainTiles::BLOCK_SAMPLES * sizeof(int16_t);
+
+TerrainTiles::~TerrainTiles()
+{
+	closeFile();
+}
+
+bool TerrainTiles::getElevation(double lat, double lon, float &elevation)
+{
+	if (!PX4_ISFINITE(lat) || !PX4_ISFINITE(lon) || fabs(lat) >= 90.0) {
+		return false;
+	}
+
+	const int lat_deg = (int)floor(lat);
+	const int lon_deg = (int)floor(lon);
+
+	if (!openFile(lat_deg, lon_deg)) {
+		return false;
+	}
+
+	_num_lookups++;
+
+	// position in samples from the file origin
+	const double north = (lat - lat_deg) * DEG_TO_M / _header.spacing;
+	const double east = (lon - lon_deg) * DEG_TO_M * cos(math::radians(lat)) / _header.spacing;
+
+	const int rows = _header.blocks_north * BLOCK_STRIDE + 1;
+	const int columns = _header.blocks_east * BLOCK_STRIDE + 1;
+
+	if (north < 0.0 || east < 0.0 || north > rows - 1 || east > columns - 1) {
+		return false;
+	}
+
+	const int block_row = math::min((int)north / BLOCK_STRIDE, _header.blocks_north - 1);
+	const int block_column = math::min((int)east / BLOCK_STRIDE, _header.blocks_east - 1);
+
+	const CachedBlock *block = getBlock(block_row * _header.blocks_east + block_column);
+
+	if (block == nullptr) {
+		return false;
+	}
+
+	// position within the block, in [0, BLOCK_STRIDE]
+	const float y = (float)(north - block_row * BLOCK_STRIDE);
+	const float x = (float)(east - block_column * BLOCK_STRIDE);
+	const int row = math::min((int)y, BLOCK_SAMPLES - 2);
+	const int column = math::min((int)x, BLOCK_SAMPLES - 2);
+
+	const int16_t *samples = &block->samples[row * BLOCK_SAMPLES + column];
+	const int16_t south_west = samples[0];
+	const int16_t south_east = samples[1];
+	const int16_t north_west = samples[BLOCK_SAMPLES];
+	const int16_t north_east = samples[BLOCK_SAMPLES + 1];
+
+	if (south_west == INT16_MIN || south_east == INT16_MIN || north_west == INT16_MIN || north_east == INT16_MIN) {
+		return false;
+	}
+
+	const float fy = y - row;
+	const float fx = x - column;
+	const float south = south_west + fx * (south_east - south_west);
+	const float north_elevation = north_west + fx * (north_east - north_west);
+	elevation = south + fy * (north_elevation - south);
+	return true;
+}
+
+bool TerrainTiles::getMaxElevationAlongPath(double lat_start, double lon_start, double lat_end, double lon_end,
+		float &max_elevation)
+{
+	// the first lookup opens the file and thus gives the sample spacing
+	if (!getElevation(lat_start, lon_start, max_elevation)) {
+		return false;
+	}
+
+	const float distance = get_distance_to_next_waypoint(lat_start, lon_start, lat_end, lon_end);
+	const int num_steps = math::constrain((int)ceilf(distance / _header.spacing), 1, MAX_PATH_SAMPLES - 1);
+
+	for (int i = 1; i <= num_steps; i++) {
+		const double t = (double)i / num_steps;
+		float elevation;
+
+		if (!getElevation(lat_start + t * (lat_end - lat_start), lon_start + t * (lon_end - lon_start), elevation)) {
+			return false;
+		}
+
+		max_elevation = math::max(max_elevation, elevation);
+	}
+
+	return true;
+}
+
+bool TerrainTiles::openFile(int lat_deg, int lon_deg)
+{
+	if (_fd >= 0 && _header.lat_deg == lat_deg && _header.lon_deg == lon_deg) {
+		return true;
+	}
+
+	if (lat_deg == _missing_lat_deg && lon_deg == _missing_lon_deg
+	    && hrt_elapsed_time(&_missing_time) < MISSING_FILE_RETRY_INTERVAL) {
+		return false;
+	}
+
+	closeFile();
+
+	char path[64];
+	snprintf(path, sizeof(path), "%s/%c%02d%c%03d.DAT", TERRAIN_DIRECTORY, lat_deg < 0 ? 'S' : 'N', abs(lat_deg),
+		 lon_deg < 0 ? 'W' : 'E', abs(lon_deg));
+
+	_fd = ::open(path, O_RDONLY);
+
+	bool valid = false;
+
+	if (_fd >= 0) {
+		struct stat st;
+
+		valid = ::read(_fd, &_header, sizeof(_header)) == sizeof(_header)
+			&& _header.magic == FILE_MAGIC && _header.version == FILE_VERSION && _header.spacing > 0
+			&& _header.lat_deg == lat_deg && _header.lon_deg == lon_deg
+			&& _header.blocks_north > 0 && _header.blocks_east > 0
+			&& fstat(_fd, &st) == 0
+			&& (size_t)st.st_size >= sizeof(_header) + (size_t)_header.blocks_north * _header.blocks_east * BLOCK_BYTES;
+
+		if (!valid) {
+			PX4_ERR("invalid terrain file %s", path);
+		}
+
+#if defined(MMAP_BASED_TERRAIN)
+
+		if (valid) {
+			_map_size = st.st_size;
+			_map = mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, _fd, 0);
+
+			if (_map == MAP_FAILED) {
+				PX4_ERR("mmap %s failed (%i)", path, errno);
+				_map = nullptr;
+				valid = false;
+			}
+		}
+
+#endif // MMAP_BASED_TERRAIN
+	}
+
+	if (!valid) {
+		closeFile();
+		_missing_lat_deg = lat_deg;
+		_missing_lon_deg = lon_deg;
+		_missing_time = hrt_absolute_time();
+	}
+
+	return valid;
+}
+
+void TerrainTiles::closeFile()
+{
+#if defined(MMAP_BASED_TERRAIN)
+
+	if (_map) {
+		munmap(_map, _map_size);
+		_map = nullptr;
+		_map_size = 0;
+	}
+
+#endif // MMAP_BASED_TERRAIN
+
+	if (_fd >= 0) {
+		::close(_fd);
+		_fd = -1;
+	}
+}
+
+const TerrainTiles::CachedBlock *TerrainTiles::getBlock(uint32_t index)
+{
+	CachedBlock *least_recently_used = &_blocks[0];
+
+	for (CachedBlock &block : _blocks) {
+		if (block.last_used != 0 && block.lat_deg == _header.lat_deg && block.lon_deg == _header.lon_deg
+		    && block.index == index) {
+			block.last_used = ++_use_counter;
+			return &block;
+		}
+
+		if (block.last_used < least_recently_used->last_used) {
+			least_recently_used = &block;
+		}
+	}
+
+	least_recently_used->last_used = 0;
+
+	if (!readBlock(index, least_recently_used->samples)) {
+		return nullptr;
+	}
+
+	least_recently_used->lat_deg = _header.lat_deg;
+	least_recently_used->lon_deg = _header.lon_deg;
+	least_recently_used->index = index;
+	least_recently_used->last_used = ++_use_counter;
+	_num_block_loads++;
+	return least_recently_used;
+}
+
+bool TerrainTiles::readBlock(uint32_t index, int16_t *samples)
+{
+	const size_t offset = sizeof(_header) + index * BLOCK_BYTES;
+
+#if defined(MMAP_BASED_TERRAIN)
+	memcpy(samples, (const uint8_t *)_map + offset, BLOCK_BYTES);
+	return true;
+#else
+
+	if (lseek(_fd, offset, SEEK_SET) != (off_t)offset) {
+		return false;
+	}
+
+	return ::read(_fd, samples, BLOCK_BYTES) == (ssize_t)BLOCK_BYTES;
+#endif // MMAP_BASED_TERRAIN
+}
+
+void TerrainTiles::printStatus()
+{
+	if (_fd >= 0) {
+		PX4_INFO("Terrain file %c%02d%c%03d, spacing %u m, %u x %u blocks", _header.lat_deg < 0 ? 'S' : 'N',
+			 abs(_header.lat_deg), _header.lon_deg < 0 ? 'W' : 'E', abs(_header.lon_deg), _header.spacing,
+			 _header.blocks_north, _header.blocks_east);
+
+	} else {
+		PX4_INFO("No terrain file loaded");
+	}
+
+	PX4_INFO("Terrain lookups: %u, block loads: %u", _num_lookups, _num_block_loads);
+}
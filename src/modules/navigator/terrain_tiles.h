@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file terrain_tiles.h
+ * Terrain elevation lookup from tiles stored on the SD card
+ *
+ * The terrain is stored in one file per 1x1 degree area, named after its south-west corner,
+ * e.g. PX4_STORAGEDIR/terrain/N47E008.DAT. A file starts with a TerrainFileHeader, followed by
+ * blocks_north x blocks_east blocks (row major, starting in the south-west) of
+ * BLOCK_SAMPLES x BLOCK_SAMPLES int16 elevations in meters AMSL (row major, first row south),
+ * little endian. Neighbouring blocks overlap by one sample, so that the interpolation never
+ * needs more than one block. INT16_MIN marks a sample without data.
+ *
+ * Sample (row, column) of the whole file is at (row * spacing) meters north and
+ * (column * spacing) meters east of the file origin, where the east distance is measured
+ * along the latitude circle of the sample: east = (lon - lon_origin) * deg_to_m * cos(lat).
+ *
+ * The most recently used blocks are kept in RAM, on POSIX the files are memory mapped.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/defines.h>
+
+using namespace time_literals;
+
+#if defined(__PX4_LINUX) || defined(__PX4_DARWIN)
+#define MMAP_BASED_TERRAIN
+#endif
+
+#define TERRAIN_DIRECTORY PX4_STORAGEDIR"/terrain"
+
+class TerrainTiles
+{
+public:
+	TerrainTiles() = default;
+	~TerrainTiles();
+
+	TerrainTiles(const TerrainTiles &) = delete;
+	TerrainTiles &operator=(const TerrainTiles &) = delete;
+
+	static constexpr int BLOCK_SAMPLES = 32; ///< samples per block side
+	static constexpr int BLOCK_CACHE_SIZE = 4; ///< number of blocks kept in RAM
+
+	static constexpr uint32_t FILE_MAGIC = 0x52545850; ///< "PXTR"
+	static constexpr uint16_t FILE_VERSION = 1;
+
+	struct TerrainFileHeader {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t spacing; ///< sample spacing [m]
+		int16_t lat_deg; ///< latitude of the south-west corner [deg]
+		int16_t lon_deg; ///< longitude of the south-west corner [deg]
+		uint16_t blocks_north;
+		uint16_t blocks_east;
+	};
+
+	/**
+	 * Get the terrain elevation at a position, bilinearly interpolated
+	 * @param elevation terrain elevation [m AMSL]
+	 * @return false if there is no terrain data for the position
+	 */
+	bool getElevation(double lat, double lon, float &elevation);
+
+	/**
+	 * Get the highest terrain elevation along the straight line between two positions,
+	 * sampled at the grid spacing (at most MAX_PATH_SAMPLES samples)
+	 * @param max_elevation highest terrain elevation [m AMSL]
+	 * @return false if terrain data is missing for any part of the path
+	 */
+	bool getMaxElevationAlongPath(double lat_start, double lon_start, double lat_end, double lon_end,
+				      float &max_elevation);
+
+	void printStatus();
+
+private:
+	static constexpr int BLOCK_STRIDE = BLOCK_SAMPLES - 1; ///< blocks overlap by one sample
+	static constexpr int MAX_PATH_SAMPLES = 200;
+	static constexpr hrt_abstime MISSING_FILE_RETRY_INTERVAL = 5_s;
+
+	struct CachedBlock {
+		int16_t lat_deg;
+		int16_t lon_deg;
+		uint32_t index; ///< block index within the file
+		uint32_t last_used; ///< value of _use_counter at the last access, 0 if unused
+		int16_t samples[BLOCK_SAMPLES * BLOCK_SAMPLES];
+	};
+
+	/**
+	 * Open the file covering the 1x1 degree area with the given south-west corner
+	 * @return false if the file is missing or invalid
+	 */
+	bool openFile(int lat_deg, int lon_deg);
+	void closeFile();
+
+	/**
+	 * Get a block of the open file from the cache, load it on a miss (evicting the least recently used block)
+	 * @return nullptr if the block could not be read
+	 */
+	const CachedBlock *getBlock(uint32_t index);
+
+	bool readBlock(uint32_t index, int16_t *samples);
+
+	CachedBlock _blocks[BLOCK_CACHE_SIZE] {};
+	uint32_t _use_counter{0};
+
+	int _fd{-1};
+	TerrainFileHeader _header{};
+
+#if defined(MMAP_BASED_TERRAIN)
+	void *_map {nullptr};
+	size_t _map_size{0};
+#endif
+
+	int _missing_lat_deg{INT16_MAX}; ///< last area without (valid) file, INT16_MAX if none
+	int _missing_lon_deg{INT16_MAX};
+	hrt_abstime _missing_time{0};
+
+	uint32_t _num_lookups{0};
+	uint32_t _num_block_loads{0};
+};
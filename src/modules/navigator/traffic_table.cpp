@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file traffic_table.cpp
+ * Table of the traffic reported by transponders, with closest approach prediction
+ */
+
+#include "traffic_table.h"
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+#include <lib/ecl/geo/geo.h>
+#include <lib/mathlib/mathlib.h>
+
+static constexpr double DEG_TO_M = CONSTANTS_RADIUS_OF_EARTH * M_PI / 180.0;
+
+bool TrafficTable::update(const transponder_report_s &report)
+{
+	const uint16_t required_flags = transponder_report_s::PX4_ADSB_FLAGS_VALID_COORDS |
+					transponder_report_s::PX4_ADSB_FLAGS_VALID_HEADING |
+					transponder_report_s::PX4_ADSB_FLAGS_VALID_VELOCITY | transponder_report_s::PX4_ADSB_FLAGS_VALID_ALTITUDE;
+
+	if ((report.flags & required_flags) != required_flags) {
+		return false;
+	}
+
+	Entry *entry = nullptr;
+	Entry *oldest = &_entries[0];
+
+	for (int i = 0; i < _num_entries; i++) {
+		if (_entries[i].icao_address == report.icao_address
+		    && memcmp(_entries[i].uas_id, report.uas_id, sizeof(report.uas_id)) == 0) {
+			entry = &_entries[i];
+			break;
+		}
+
+		if (_entries[i].timestamp < oldest->timestamp) {
+			oldest = &_entries[i];
+		}
+	}
+
+	if (entry == nullptr) {
+		// new participant, replace the one with the oldest report if the table is full
+		entry = (_num_entries < MAX_ENTRIES) ? &_entries[_num_entries++] : oldest;
+		*entry = {};
+		entry->icao_address = report.icao_address;
+		memcpy(entry->uas_id, report.uas_id, sizeof(report.uas_id));
+	}
+
+	memcpy(entry->callsign, report.callsign, sizeof(entry->callsign));
+	entry->callsign[sizeof(entry->callsign) - 1] = '\0';
+	entry->flags = report.flags;
+	entry->emitter_type = report.emitter_type;
+	entry->lat = report.lat;
+	entry->lon = report.lon;
+	entry->altitude = report.altitude;
+	entry->heading = report.heading;
+	entry->vel_north = report.hor_velocity * cosf(report.heading);
+	entry->vel_east = report.hor_velocity * sinf(report.heading);
+	entry->vel_up = report.ver_velocity;
+	entry->timestamp = report.timestamp;
+	return true;
+}
+
+void TrafficTable::predictConflicts(hrt_abstime now, double lat, double lon, float altitude, float vel_north,
+				    float vel_east, float vel_up, float separation_manned, float separation_unmanned)
+{
+	const float cos_lat = cosf((float)math::radians(lat));
+
+	for (int i = 0; i < _num_entries; i++) {
+		Entry &entry = _entries[i];
+
+		if (now > entry.timestamp + ENTRY_TIMEOUT) {
+			// expired, the order of the entries does not matter
+			_entries[i--] = _entries[--_num_entries];
+			continue;
+		}
+
+		const float separation = (entry.emitter_type == transponder_report_s::ADSB_EMITTER_TYPE_UAV) ?
+					 separation_unmanned : separation_manned;
+
+		// relative position now (dead reckoning since the report) and relative velocity
+		const float dt = (now > entry.timestamp) ? (now - entry.timestamp) * 1e-6f : 0.f;
+		const float north = (float)((entry.lat - lat) * DEG_TO_M) + entry.vel_north * dt;
+		const float east = (float)((entry.lon - lon) * DEG_TO_M) * cos_lat + entry.vel_east * dt;
+		const float up = entry.altitude - altitude + entry.vel_up * dt;
+		const float rel_vel_north = entry.vel_north - vel_north;
+		const float rel_vel_east = entry.vel_east - vel_east;
+		const float rel_vel_up = entry.vel_up - vel_up;
+
+		// skip participants that can not come within the separation during the prediction horizon
+		const float reach_horizontal = separation + (fabsf(rel_vel_north) + fabsf(rel_vel_east)) * PREDICTION_HORIZON;
+		const float reach_vertical = separation + fabsf(rel_vel_up) * PREDICTION_HORIZON;
+
+		bool conflict = false;
+
+		if (fabsf(north) < reach_horizontal && fabsf(east) < reach_horizontal && fabsf(up) < reach_vertical) {
+			// time of the closest horizontal approach, assuming constant velocities
+			const float rel_speed_sq = rel_vel_north * rel_vel_north + rel_vel_east * rel_vel_east;
+			float t = 0.f;
+
+			if (rel_speed_sq > FLT_EPSILON) {
+				t = math::constrain(-(north * rel_vel_north + east * rel_vel_east) / rel_speed_sq, 0.f, PREDICTION_HORIZON);
+			}
+
+			const float cpa_north = north + rel_vel_north * t;
+			const float cpa_east = east + rel_vel_east * t;
+
+			entry.cpa_time = t;
+			entry.cpa_horizontal_distance = sqrtf(cpa_north * cpa_north + cpa_east * cpa_east);
+			entry.cpa_vertical_distance = fabsf(up + rel_vel_up * t);
+
+			conflict = entry.cpa_horizontal_distance < separation && entry.cpa_vertical_distance < separation;
+
+		} else {
+			entry.cpa_time = NAN;
+			entry.cpa_horizontal_distance = NAN;
+			entry.cpa_vertical_distance = NAN;
+		}
+
+		entry.alert = conflict && (!entry.conflict || now > entry.last_alert + ALERT_INTERVAL);
+		entry.conflict = conflict;
+	}
+}
+
+void TrafficTable::alertSent(int i, hrt_abstime now)
+{
+	_entries[i].alert = false;
+	_entries[i].last_alert = now;
+}
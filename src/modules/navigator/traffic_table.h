@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+/**
+ * @file traffic_table.h
+ * Table of the traffic reported by transponders, with closest approach prediction
+ *
+ * Transponder reports only update the state of their traffic participant. The closest
+ * approaches to the own vehicle are predicted once per navigator iteration for all
+ * participants, in a local frame around the own vehicle, skipping participants that
+ * can not come close within the prediction horizon.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/defines.h>
+#include <uORB/topics/transponder_report.h>
+
+using namespace time_literals;
+
+class TrafficTable
+{
+public:
+	static constexpr int MAX_ENTRIES = 32;
+	static constexpr hrt_abstime ENTRY_TIMEOUT = 10_s; ///< participants without report for this long are removed
+	static constexpr float PREDICTION_HORIZON = 60.f; ///< [s]
+	static constexpr hrt_abstime ALERT_INTERVAL = 10_s; ///< minimum time between alerts for an ongoing conflict
+
+	struct Entry {
+		uint32_t icao_address;
+		uint8_t uas_id[PX4_GUID_BYTE_LENGTH];
+		char callsign[sizeof(transponder_report_s::callsign)];
+		uint16_t flags;
+		uint8_t emitter_type;
+
+		double lat; ///< at timestamp [deg]
+		double lon;
+		float altitude; ///< [m AMSL]
+		float heading; ///< [rad]
+		float vel_north; ///< [m/s]
+		float vel_east;
+		float vel_up;
+		hrt_abstime timestamp;
+
+		// prediction of the last predictConflicts() call
+		float cpa_time; ///< time to the closest approach [s]
+		float cpa_horizontal_distance; ///< [m]
+		float cpa_vertical_distance; ///< absolute [m]
+		bool conflict; ///< closest approach within the separation
+		bool alert; ///< conflict started or still ongoing after ALERT_INTERVAL, to be reported
+		hrt_abstime last_alert;
+	};
+
+	/**
+	 * Insert or update the participant of a transponder report
+	 * @return false if the report does not contain a position, altitude and velocity
+	 */
+	bool update(const transponder_report_s &report);
+
+	/**
+	 * Remove expired participants and predict the closest approach of all others to the own vehicle
+	 * @param vel_north, vel_east, vel_up own velocity [m/s]
+	 * @param separation_manned horizontal and vertical separation from manned traffic [m]
+	 * @param separation_unmanned horizontal and vertical separation from unmanned traffic [m]
+	 */
+	void predictConflicts(hrt_abstime now, double lat, double lon, float altitude, float vel_north, float vel_east,
+			      float vel_up, float separation_manned, float separation_unmanned);
+
+	int size() const { return _num_entries; }
+	const Entry &entry(int i) const { return _entries[i]; }
+
+	/**
+	 * Mark the alert of an entry as reported
+	 */
+	void alertSent(int i, hrt_abstime now);
+
+private:
+	Entry _entries[MAX_ENTRIES] {};
+	int _num_entries{0};
+};
@@ -0,0 +1,328 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file profiler.cpp
+ *
+ * Statistical sampling profiler: records the interrupted program counter from
+ * a high resolution timer callout and publishes the samples for logging.
+ */
+
+#include <drivers/drv_hrt.h>
+#include <lib/mathlib/math/Limits.hpp>
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/topics/profiler_samples.h>
+
+#include <string.h>
+
+#if defined(__PX4_NUTTX)
+#  include <nuttx/sched.h>
+#  include <up_internal.h>
+#else
+#  error profiler requires NuttX (the sample is taken from the interrupted register context)
+#endif
+
+using namespace time_literals;
+
+namespace profiler
+{
+
+extern "C" __EXPORT int profiler_main(int argc, char *argv[]);
+
+// a prime period so that the samples do not lock to the phase of periodic (e.g. 1 kHz) tasks
+static constexpr uint32_t DEFAULT_INTERVAL_US = 997;
+static constexpr uint32_t MIN_INTERVAL_US = 100;
+
+static constexpr uint32_t RING_SIZE = 256; ///< number of buffered samples, must be a power of 2
+static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of 2");
+
+class Profiler : public ModuleBase<Profiler>, public px4::ScheduledWorkItem
+{
+public:
+	Profiler(const char *task, uint32_t interval_us);
+	~Profiler() override;
+
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
+
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[])
+	{
+		return print_usage("unknown command");
+	}
+
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
+
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
+
+	void start();
+
+private:
+	struct Sample {
+		uint32_t pc;
+		uint16_t pid;
+	};
+
+	/** Move the buffered samples into messages and publish the full ones. */
+	void Run() override;
+
+	void publish();
+
+	/** hrt callout, runs in interrupt context */
+	static void sample_trampoline(void *arg);
+	void sample();
+
+	struct hrt_call _call {};
+	const uint32_t _interval_us;
+
+	// single producer (timer interrupt), single consumer (Run()) ring buffer
+	Sample _ring[RING_SIZE] {};
+	px4::atomic<uint32_t> _head{0};
+	px4::atomic<uint32_t> _tail{0};
+
+	px4::atomic<uint32_t> _samples_taken{0};
+	px4::atomic<uint32_t> _samples_dropped{0};
+	uint32_t _samples_published{0};
+
+	int _task_pid{-1}; ///< pid of the last task that matched the name filter
+
+	profiler_samples_s _samples{};
+	uORB::PublicationQueued<profiler_samples_s> _samples_pub{ORB_ID(profiler_samples)};
+};
+
+Profiler::Profiler(const char *task, uint32_t interval_us) :
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default),
+	_interval_us(interval_us)
+{
+	if (task) {
+		strncpy(_samples.task, task, sizeof(_samples.task) - 1);
+	}
+
+	_samples.interval_us = _interval_us;
+}
+
+Profiler::~Profiler()
+{
+	hrt_cancel(&_call);
+	ScheduleClear();
+}
+
+void Profiler::start()
+{
+	hrt_call_every(&_call, _interval_us, _interval_us, &Profiler::sample_trampoline, this);
+
+	// drain the ring buffer well before it can fill up
+	ScheduleOnInterval(math::min(RING_SIZE / 4 * _interval_us, (uint32_t)100_ms));
+}
+
+void Profiler::sample_trampoline(void *arg)
+{
+	static_cast<Profiler *>(arg)->sample();
+}
+
+void Profiler::sample()
+{
+	const uint32_t *regs = (const uint32_t *)CURRENT_REGS;
+
+	if (regs == nullptr) {
+		// not called from an interrupt handler
+		return;
+	}
+
+	const struct tcb_s *tcb = sched_self();
+
+	if (_samples.task[0] != '\0' && tcb->pid != _task_pid) {
+#if CONFIG_TASK_NAME_SIZE > 0
+
+		if (strncmp(tcb->name, _samples.task, sizeof(_samples.task)) != 0) {
+			return;
+		}
+
+		_task_pid = tcb->pid;
+#else
+		return;
+#endif
+	}
+
+	_samples_taken.fetch_add(1);
+
+	const uint32_t head = _head.load();
+
+	if (head - _tail.load() >= RING_SIZE) {
+		_samples_dropped.fetch_add(1);
+		return;
+	}
+
+	_ring[head & (RING_SIZE - 1)] = Sample{regs[REG_PC], (uint16_t)tcb->pid};
+	_head.store(head + 1);
+}
+
+void Profiler::publish()
+{
+	_samples.dropped = _samples_dropped.load();
+	_samples.timestamp = hrt_absolute_time();
+	_samples_pub.publish(_samples);
+	_samples_published += _samples.count;
+	_samples.count = 0;
+}
+
+void Profiler::Run()
+{
+	if (should_exit()) {
+		hrt_cancel(&_call);
+		ScheduleClear();
+
+		if (_samples.count > 0) {
+			publish();
+		}
+
+		exit_and_cleanup();
+		return;
+	}
+
+	const uint32_t head = _head.load();
+	uint32_t tail = _tail.load();
+
+	while (tail != head) {
+		const Sample &s = _ring[tail & (RING_SIZE - 1)];
+		_samples.pc[_samples.count] = s.pc;
+		_samples.pid[_samples.count] = s.pid;
+		tail++;
+
+		if (++_samples.count == profiler_samples_s::NUM_SAMPLES) {
+			publish();
+		}
+	}
+
+	_tail.store(tail);
+}
+
+int Profiler::print_status()
+{
+	PX4_INFO("task: %s, interval: %u us", _samples.task[0] != '\0' ? _samples.task : "(all)", (unsigned)_interval_us);
+	PX4_INFO("samples taken: %u, published: %u, dropped: %u", (unsigned)_samples_taken.load(),
+		 (unsigned)_samples_published, (unsigned)_samples_dropped.load());
+	return 0;
+}
+
+int Profiler::task_spawn(int argc, char *argv[])
+{
+	const char *task = nullptr;
+	uint32_t interval_us = DEFAULT_INTERVAL_US;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "t:i:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 't':
+			task = myoptarg;
+			break;
+
+		case 'i':
+			interval_us = strtoul(myoptarg, nullptr, 10);
+			break;
+
+		default:
+			return print_usage("unrecognized flag");
+		}
+	}
+
+	if (interval_us < MIN_INTERVAL_US) {
+		PX4_ERR("interval must be at least %u us", (unsigned)MIN_INTERVAL_US);
+		return PX4_ERROR;
+	}
+
+	Profiler *obj = new Profiler(task, interval_us);
+
+	if (!obj) {
+		PX4_ERR("alloc failed");
+		return PX4_ERROR;
+	}
+
+	_object.store(obj);
+	_task_id = task_id_is_work_queue;
+
+	obj->start();
+
+	return PX4_OK;
+}
+
+int Profiler::print_usage(const char *reason)
+{
+	if (reason) {
+		PX4_ERR("%s\n", reason);
+	}
+
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Statistical sampling profiler. A high resolution timer callout records the program counter of the
+interrupted task into a ring buffer, which is drained on the LP work queue and published as
+`profiler_samples`. The topic is logged by default, so the samples end up in the ULog file (or
+are streamed over MAVLink with log streaming).
+
+Sampling can be restricted to a single task by name, e.g. a work queue thread. The default interval
+is a prime number of microseconds so that the samples do not alias with periodic tasks.
+
+The samples are symbolized on the host against the ELF file of the firmware:
+$ Tools/profiler_symbolize.py -e build/px4_fmu-v5_default/px4_fmu-v5_default.elf log.ulg
+
+### Examples
+Profile the rate controller work queue:
+$ profiler start -t wq:rate_ctrl
+$ profiler stop
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("profiler", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start sampling");
+	PRINT_MODULE_USAGE_PARAM_STRING('t', nullptr, nullptr, "Only sample this task (e.g. wq:rate_ctrl)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('i', DEFAULT_INTERVAL_US, MIN_INTERVAL_US, 100000, "Sampling interval in us", true);
+	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+	return 0;
+}
+
+int profiler_main(int argc, char *argv[])
+{
+	return Profiler::main(argc, argv);
+}
+
+} // namespace profiler
@@ -80,7 +80,7 @@
 
 #define REG_TO_BOOL(_reg) 	((bool)(_reg))
 
-#define PX4IO_PROTOCOL_VERSION		4
+#define PX4IO_PROTOCOL_VERSION		5
 
 /* maximum allowable sizes on this protocol version */
 #define PX4IO_PROTOCOL_MAX_CONTROL_COUNT	8	/**< The protocol does not support more than set here, individual units might support less - see PX4IO_P_CONFIG_CONTROL_COUNT */
@@ -171,6 +171,15 @@
 #define PX4IO_PAGE_PWM_INFO		7
 #define PX4IO_RATE_MAP_BASE			0	/* 0..CONFIG_ACTUATOR_COUNT bitmaps of PWM rate groups */
 
+/* combined poll page, everything the FMU polls every cycle in a single transfer */
+#define PX4IO_PAGE_POLL			8
+#define PX4IO_P_POLL_STATUS			0	/* PX4IO_PAGE_STATUS from PX4IO_P_STATUS_FLAGS to PX4IO_P_STATUS_MIXER */
+#define PX4IO_P_POLL_SERVOS			8	/* PX4IO_PAGE_SERVOS 0..PX4IO_P_POLL_SERVO_COUNT-1 */
+#define PX4IO_P_POLL_SERVO_COUNT		8
+#define PX4IO_P_POLL_RAW_RC			16	/* PX4IO_PAGE_RAW_RC_INPUT from PX4IO_P_RAW_RC_COUNT, with the first channels */
+#define PX4IO_P_POLL_RAW_RC_CHANNELS		9	/* further channels are read from PX4IO_PAGE_RAW_RC_INPUT */
+#define PX4IO_P_POLL_COUNT			(PX4IO_P_POLL_RAW_RC + PX4IO_P_RAW_RC_BASE + PX4IO_P_POLL_RAW_RC_CHANNELS)
+
 /* setup page */
 #define PX4IO_PAGE_SETUP		50
 #define PX4IO_P_SETUP_FEATURES			0
@@ -341,6 +350,10 @@ struct IOPacket {
 #error The max transfer length of the IO protocol must not be larger than the IO packet size
 #endif
 
+#if (PX4IO_P_POLL_COUNT * 2 > PX4IO_MAX_TRANSFER_LEN - 2)
+#error The poll page must fit into a single transfer
+#endif
+
 #define PKT_CODE_READ		0x00	/* FMU->IO read transaction */
 #define PKT_CODE_WRITE		0x40	/* FMU->IO write transaction */
 #define PKT_CODE_SUCCESS	0x00	/* IO->FMU success reply */
@@ -107,6 +107,10 @@ uint16_t 		r_page_actuators[PX4IO_SERVO_COUNT];
  */
 uint16_t		r_page_servos[PX4IO_SERVO_COUNT];
 
+#if PX4IO_SERVO_COUNT < PX4IO_P_POLL_SERVO_COUNT
+#error The poll page expects PX4IO_P_POLL_SERVO_COUNT servos
+#endif
+
 /**
  * PAGE 4
  *
@@ -963,6 +967,26 @@ registers_get(uint8_t page, uint8_t offset, uint16_t **values, unsigned *num_val
 		SELECT_PAGE(r_page_scratch);
 		break;
 
+	case PX4IO_PAGE_POLL: {
+			uint16_t *status;
+			unsigned status_count;
+
+			/* refresh the dynamic status registers */
+			registers_get(PX4IO_PAGE_STATUS, PX4IO_P_STATUS_FLAGS, &status, &status_count);
+
+			memset(r_page_scratch, 0, sizeof(r_page_scratch));
+			memcpy(&r_page_scratch[PX4IO_P_POLL_STATUS], status,
+			       (PX4IO_P_STATUS_MIXER - PX4IO_P_STATUS_FLAGS + 1) * sizeof(uint16_t));
+			memcpy(&r_page_scratch[PX4IO_P_POLL_SERVOS], r_page_servos,
+			       PX4IO_P_POLL_SERVO_COUNT * sizeof(uint16_t));
+			memcpy(&r_page_scratch[PX4IO_P_POLL_RAW_RC], r_page_raw_rc_input,
+			       (PX4IO_P_RAW_RC_BASE + PX4IO_P_POLL_RAW_RC_CHANNELS) * sizeof(uint16_t));
+
+			*values = &r_page_scratch[0];
+			*num_values = PX4IO_P_POLL_COUNT;
+		}
+		break;
+
 	/*
 	 * Pages that are just a straight read of the register state.
 	 */
@@ -46,9 +46,12 @@
 #include <px4_platform_common/tasks.h>
 #include <px4_platform_common/time.h>
 #include <px4_platform_common/shutdown.h>
+#include <lib/mathlib/mathlib.h>
 #include <lib/parameters/param.h>
 
+#include <algorithm>
 #include <cstring>
+#include <errno.h>
 #include <float.h>
 #include <fstream>
 #include <iostream>
@@ -58,11 +61,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string>
+#include <unistd.h>
 
 #include <logger/messages.h>
+#include <logger/ulog_delta.h>
 
 #include "Replay.hpp"
+#include "ReplayBatch.hpp"
 #include "ReplayEkf2.hpp"
+#include "ReplayExport.hpp"
+#include "ReplayFast.hpp"
 
 #define PARAMS_OVERRIDE_FILE PX4_ROOTFSDIR "/replay_params.txt"
 
@@ -91,6 +99,10 @@ Replay::~Replay()
 	}
 
 	_subscriptions.clear();
+
+	if (_checkpoint_file) {
+		fclose(_checkpoint_file);
+	}
 }
 
 void *
@@ -167,7 +179,7 @@ Replay::setUserParams(const char *filename)
 }
 
 bool
-Replay::readFileHeader(std::ifstream &file)
+Replay::readFileHeader(ReplayFile &file)
 {
 	file.seekg(0);
 	ulog_file_header_s msg_header;
@@ -191,7 +203,7 @@ Replay::readFileHeader(std::ifstream &file)
 }
 
 bool
-Replay::readFileDefinitions(std::ifstream &file)
+Replay::readFileDefinitions(ReplayFile &file)
 {
 	PX4_INFO("Applying params from ULog file...");
 
@@ -248,7 +260,7 @@ Replay::readFileDefinitions(std::ifstream &file)
 }
 
 bool
-Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
+Replay::readFlagBits(ReplayFile &file, uint16_t msg_size)
 {
 	if (msg_size != 40) {
 		PX4_ERR("unsupported message length for FLAG_BITS message (%i)", msg_size);
@@ -265,7 +277,7 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 	bool contains_appended_data = incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK;
 	bool has_unknown_incompat_bits = false;
 
-	if (incompat_flags[0] & ~0x1) {
+	if (incompat_flags[0] & ~(ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK | ULOG_INCOMPAT_FLAG0_DATA_DELTA_MASK)) {
 		has_unknown_incompat_bits = true;
 	}
 
@@ -295,7 +307,7 @@ Replay::readFlagBits(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readFormat(std::ifstream &file, uint16_t msg_size)
+Replay::readFormat(ReplayFile &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size + 1);
 	char *format = (char *)_read_buffer.data();
@@ -321,7 +333,7 @@ Replay::readFormat(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readAndAddSubscription(std::ifstream &file, uint16_t msg_size)
+Replay::readAndAddSubscription(ReplayFile &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size + 1);
 	char *message = (char *)_read_buffer.data();
@@ -469,11 +481,14 @@ Replay::findFieldOffset(const string &format, const string &field_name, int &off
 }
 
 bool
-Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position)
+Replay::readAndHandleAdditionalMessages(ReplayFile &file, std::streampos end_position)
 {
 	ulog_message_header_s message_header;
 
-	while (file.tellg() < end_position) {
+	while (_next_additional_message < _additional_message_index.size()
+	       && _additional_message_index[_next_additional_message] < (std::streamoff)end_position) {
+
+		file.seekg(_additional_message_index[_next_additional_message++]);
 		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
 
 		if (!file) {
@@ -492,8 +507,7 @@ Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_
 			readDropout(file, message_header.msg_size);
 			break;
 
-		default: //skip all others
-			file.seekg(message_header.msg_size, ios::cur);
+		default: //the index only contains the above
 			break;
 		}
 	}
@@ -502,7 +516,7 @@ Replay::readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_
 }
 
 bool
-Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
+Replay::readAndApplyParameter(ReplayFile &file, uint16_t msg_size)
 {
 	_read_buffer.reserve(msg_size);
 	uint8_t *message = (uint8_t *)_read_buffer.data();
@@ -544,7 +558,7 @@ Replay::readAndApplyParameter(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::readDropout(std::ifstream &file, uint16_t msg_size)
+Replay::readDropout(ReplayFile &file, uint16_t msg_size)
 {
 	uint16_t duration;
 	file.read((char *)&duration, sizeof(duration));
@@ -554,88 +568,184 @@ Replay::readDropout(std::ifstream &file, uint16_t msg_size)
 }
 
 bool
-Replay::nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id)
+Replay::nextDataMessage(ReplayFile &file, Subscription &subscription, int msg_id)
 {
-	ulog_message_header_s message_header;
-	file.seekg(subscription.next_read_pos);
-	//ignore the first message (it's data we already read)
-	file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
-
-	if (file) {
-		file.seekg(message_header.msg_size, ios::cur);
+	if (msg_id < 0 || msg_id >= (int)_data_message_index.size()) {
+		subscription.orb_meta = nullptr;
+		return addSubscriptionsUntil(file, _read_until_file_position);
 	}
 
-	uint16_t file_msg_id;
-	bool done = false;
+	// the first message after the stored position is the next one, the stored position is either the
+	// previous data message or the ADD_LOGGED_MSG of this subscription
+	const std::vector<std::streamoff> &offsets = _data_message_index[msg_id];
+	auto next = std::upper_bound(offsets.begin(), offsets.end(), (std::streamoff)subscription.next_read_pos);
 
-	while (file && !done) {
-		streampos cur_pos = file.tellg();
+	for (; next != offsets.end(); ++next) {
+		const std::streamoff cur_pos = *next;
+
+		if (!addSubscriptionsUntil(file, cur_pos)) {
+			return false;
+		}
+
+		ulog_message_header_s message_header;
+		uint16_t file_msg_id;
+		file.seekg(cur_pos);
 		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+		file.read((char *)&file_msg_id, sizeof(file_msg_id));
 
 		if (!file) {
-			break;
+			return false;
 		}
 
-		if (((streamoff)cur_pos) + ULOG_MSG_HEADER_LEN + message_header.msg_size > _read_until_file_position) {
-			file.setstate(std::ios::eofbit);
-			break;
+		if (subscription.data_valid) {
+			subscription.previous_data = subscription.data;
+		}
+
+		if (readDataMessage(file, subscription, message_header.msg_type, message_header.msg_size)) {
+			subscription.next_read_pos = cur_pos;
+			memcpy(&subscription.next_timestamp, subscription.data.data() + subscription.timestamp_offset,
+			       sizeof(subscription.next_timestamp));
+			return true;
+		}
+	}
+
+	// no more data messages for this subscription. Add the remaining subscriptions, as reading until
+	// the end of the file would have found them
+	subscription.orb_meta = nullptr;
+	return addSubscriptionsUntil(file, _read_until_file_position);
+}
+
+bool
+Replay::addSubscriptionsUntil(ReplayFile &file, std::streamoff end_position)
+{
+	while (_next_add_logged_msg < _add_logged_msg_index.size()
+	       && _add_logged_msg_index[_next_add_logged_msg] < end_position) {
+
+		// advance first: adding a subscription looks for its first data message, which gets back here
+		const std::streamoff pos = _add_logged_msg_index[_next_add_logged_msg++];
+
+		if (pos < (std::streamoff)_subscription_file_pos) {
+			continue; // already added
+		}
+
+		ulog_message_header_s message_header;
+		file.seekg(pos);
+		file.read((char *)&message_header, ULOG_MSG_HEADER_LEN);
+
+		if (!file || !readAndAddSubscription(file, message_header.msg_size)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+Replay::buildMessageIndex(const ReplayFile &file)
+{
+	const hrt_abstime start = hrt_absolute_time();
+	const uint8_t *data = file.data();
+	const int64_t end = math::min((int64_t)file.size(), _read_until_file_position);
+	int64_t pos = (std::streamoff)_data_section_start;
+	size_t num_data_messages = 0;
+
+	_data_message_index.clear();
+	_add_logged_msg_index.clear();
+	_additional_message_index.clear();
+	_next_add_logged_msg = 0;
+	_next_additional_message = 0;
+
+	while (pos + ULOG_MSG_HEADER_LEN <= end) {
+		ulog_message_header_s message_header;
+		memcpy(&message_header, data + pos, ULOG_MSG_HEADER_LEN);
+
+		if (pos + ULOG_MSG_HEADER_LEN + message_header.msg_size > end) {
+			break; // truncated message
 		}
 
 		switch (message_header.msg_type) {
 		case (int)ULogMessageType::ADD_LOGGED_MSG:
-			readAndAddSubscription(file, message_header.msg_size);
+			_add_logged_msg_index.push_back(pos);
 			break;
 
 		case (int)ULogMessageType::DATA:
-			file.read((char *)&file_msg_id, sizeof(file_msg_id));
-
-			if (file) {
-				if (msg_id == file_msg_id) {
-					if (message_header.msg_size == subscription.orb_meta->o_size_no_padding + 2) {
-						subscription.next_read_pos = cur_pos;
-						file.seekg(subscription.timestamp_offset, ios::cur);
-						file.read((char *)&subscription.next_timestamp, sizeof(subscription.next_timestamp));
-						done = true;
-
-					} else { //sanity check failed!
-						PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
-							subscription.orb_meta->o_name, message_header.msg_size,
-							subscription.orb_meta->o_size_no_padding + 2);
-						file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
-					}
+		case (int)ULogMessageType::DATA_DELTA:
+			if (message_header.msg_size >= sizeof(uint16_t)) {
+				uint16_t msg_id;
+				memcpy(&msg_id, data + pos + ULOG_MSG_HEADER_LEN, sizeof(msg_id));
 
-				} else { //not the one we are looking for
-					file.seekg(message_header.msg_size - sizeof(file_msg_id), ios::cur);
+				if (_data_message_index.size() <= msg_id) {
+					_data_message_index.resize(msg_id + 1);
 				}
+
+				_data_message_index[msg_id].push_back(pos);
+				++num_data_messages;
 			}
 
 			break;
 
-		case (int)ULogMessageType::REMOVE_LOGGED_MSG: //skip these
 		case (int)ULogMessageType::PARAMETER:
 		case (int)ULogMessageType::DROPOUT:
+			_additional_message_index.push_back(pos);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG:
 		case (int)ULogMessageType::INFO:
 		case (int)ULogMessageType::INFO_MULTIPLE:
 		case (int)ULogMessageType::SYNC:
 		case (int)ULogMessageType::LOGGING:
-			file.seekg(message_header.msg_size, ios::cur);
 			break;
 
 		default:
 			//this really should not happen
 			PX4_ERR("unknown log message type %i, size %i (offset %i)",
-				(int)message_header.msg_type, (int)message_header.msg_size, (int)file.tellg());
-			file.seekg(message_header.msg_size, ios::cur);
+				(int)message_header.msg_type, (int)message_header.msg_size, (int)pos);
 			break;
 		}
+
+		pos += ULOG_MSG_HEADER_LEN + message_header.msg_size;
 	}
 
-	if (file.eof()) { //no more data messages for this subscription
-		subscription.orb_meta = nullptr;
-		file.clear();
+	PX4_INFO("Indexed %zu data messages of %zu subscriptions (%.3lf s)", num_data_messages, _add_logged_msg_index.size(),
+		 (double)hrt_elapsed_time(&start) / 1.e6);
+}
+
+bool
+Replay::readDataMessage(ReplayFile &file, Subscription &subscription, uint8_t msg_type, uint16_t msg_size)
+{
+	const size_t data_size = subscription.orb_meta->o_size_no_padding;
+	const size_t payload_size = msg_size - sizeof(uint16_t); // without msg_id
+	subscription.data.resize(data_size);
+
+	if (msg_type == (int)ULogMessageType::DATA) {
+		if (payload_size != data_size) { //sanity check failed!
+			PX4_ERR("data message %s has wrong size %i (expected %i). Skipping",
+				subscription.orb_meta->o_name, msg_size, subscription.orb_meta->o_size_no_padding + 2);
+			file.seekg(payload_size, ios::cur);
+			return false;
+		}
+
+		file.read((char *)subscription.data.data(), data_size);
+		subscription.data_valid = file.good();
+		return subscription.data_valid;
 	}
 
-	return file.good();
+	// delta encoded against the previous message of this subscription
+	_read_buffer.reserve(payload_size);
+	file.read((char *)_read_buffer.data(), payload_size);
+
+	if (!file) {
+		return false;
+	}
+
+	if (!subscription.data_valid
+	    || !ulog_delta_decode(_read_buffer.data(), payload_size, subscription.data.data(), data_size)) {
+		PX4_ERR("delta data message %s cannot be decoded. Skipping", subscription.orb_meta->o_name);
+		subscription.data_valid = false;
+		return false;
+	}
+
+	return true;
 }
 
 const orb_metadata *
@@ -711,7 +821,7 @@ Replay::sizeOfFullType(const std::string &type_name_full)
 }
 
 bool
-Replay::readDefinitionsAndApplyParams(std::ifstream &file)
+Replay::readDefinitionsAndApplyParams(ReplayFile &file)
 {
 	// log reader currently assumes little endian
 	int num = 1;
@@ -744,17 +854,25 @@ Replay::readDefinitionsAndApplyParams(std::ifstream &file)
 void
 Replay::run()
 {
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
+	ReplayFile replay_file(_replay_file);
 
 	if (!readDefinitionsAndApplyParams(replay_file)) {
 		return;
 	}
 
-	onEnterMainLoop();
+	buildMessageIndex(replay_file);
 
-	_replay_start_time = hrt_absolute_time();
+	// seek target, relative to the start of the log
+	uint64_t seek_file_time = 0;
+	const char *seek_env = getenv(replay::ENV_SEEK);
 
-	PX4_INFO("Replay in progress...");
+	if (seek_env && strtod(seek_env, nullptr) > 0.) {
+		seek_file_time = _file_start_time + (uint64_t)(strtod(seek_env, nullptr) * 1e6);
+	}
+
+	const long checkpoint = openCheckpointFile(replay_file, seek_file_time);
+
+	onEnterMainLoop();
 
 	ulog_message_header_s message_header;
 	replay_file.seekg(_data_section_start);
@@ -767,40 +885,34 @@ Replay::run()
 		return;
 	}
 
+	if (seek_file_time > _file_start_time) {
+		seek(replay_file, seek_file_time, checkpoint);
+	}
+
+	_replay_start_time = hrt_absolute_time();
+
+	PX4_INFO("Replay in progress...");
+
 	//we update the timestamps from the file by a constant offset to match
 	//the current replay time
-	const uint64_t timestamp_offset = _replay_start_time - _file_start_time;
+	const uint64_t timestamp_offset = _replay_start_time - math::max(_file_start_time, seek_file_time);
 	uint32_t nr_published_messages = 0;
-	streampos last_additional_message_pos = _data_section_start;
+
+	if (seek_file_time > _file_start_time) {
+		publishSeekState(timestamp_offset);
+	}
 
 	while (!should_exit() && replay_file) {
 
-		//Find the next message to publish. Messages from different subscriptions don't need
-		//to be in chronological order, so we need to check all subscriptions
 		uint64_t next_file_time = 0;
-		int next_msg_id = -1;
-		bool first_time = true;
-
-		for (size_t i = 0; i < _subscriptions.size(); ++i) {
-			const Subscription *subscription = _subscriptions[i];
-
-			if (!subscription) {
-				continue;
-			}
-
-			if (subscription->orb_meta && !subscription->ignored) {
-				if (first_time || subscription->next_timestamp < next_file_time) {
-					first_time = false;
-					next_msg_id = (int)i;
-					next_file_time = subscription->next_timestamp;
-				}
-			}
-		}
+		const int next_msg_id = findNextSubscription(next_file_time);
 
 		if (next_msg_id == -1) {
 			break; //no active subscription anymore. We're done.
 		}
 
+		writeCheckpoint(next_file_time);
+
 		Subscription &sub = *_subscriptions[next_msg_id];
 
 		if (next_file_time == 0) {
@@ -809,16 +921,13 @@ Replay::run()
 			continue;
 		}
 
-		//handle additional messages between last and next published data
-		replay_file.seekg(last_additional_message_pos);
-		streampos next_additional_message_pos = sub.next_read_pos;
-		readAndHandleAdditionalMessages(replay_file, next_additional_message_pos);
-		last_additional_message_pos = next_additional_message_pos;
+		//handle additional messages before the next published data
+		readAndHandleAdditionalMessages(replay_file, sub.next_read_pos);
 
 		const uint64_t publish_timestamp = handleTopicDelay(next_file_time, timestamp_offset);
 
 		// It's time to publish
-		readTopicDataToBuffer(sub, replay_file);
+		readTopicDataToBuffer(sub);
 		memcpy(_read_buffer.data() + sub.timestamp_offset, &publish_timestamp, sizeof(uint64_t)); //adjust the timestamp
 
 		if (handleTopicUpdate(sub, _read_buffer.data(), replay_file)) {
@@ -846,6 +955,11 @@ Replay::run()
 		}
 	}
 
+	if (_checkpoint_file) {
+		fclose(_checkpoint_file);
+		_checkpoint_file = nullptr;
+	}
+
 	if (!should_exit()) {
 		PX4_INFO("Replay done (published %u msgs, %.3lf s)", nr_published_messages,
 			 (double)hrt_elapsed_time(&_replay_start_time) / 1.e6);
@@ -858,18 +972,280 @@ Replay::run()
 	onExitMainLoop();
 }
 
+int
+Replay::findNextSubscription(uint64_t &next_file_time) const
+{
+	//Find the next message to publish. Messages from different subscriptions don't need
+	//to be in chronological order, so we need to check all subscriptions
+	int next_msg_id = -1;
+	bool first_time = true;
+
+	for (size_t i = 0; i < _subscriptions.size(); ++i) {
+		const Subscription *subscription = _subscriptions[i];
+
+		if (!subscription) {
+			continue;
+		}
+
+		if (subscription->orb_meta && !subscription->ignored) {
+			if (first_time || subscription->next_timestamp < next_file_time) {
+				first_time = false;
+				next_msg_id = (int)i;
+				next_file_time = subscription->next_timestamp;
+			}
+		}
+	}
+
+	return next_msg_id;
+}
+
 void
-Replay::readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file)
+Replay::seek(ReplayFile &file, uint64_t seek_file_time, long checkpoint)
+{
+	const hrt_abstime start = hrt_absolute_time();
+
+	if (checkpoint >= 0) {
+		if (restoreCheckpoint(file, checkpoint)) {
+			PX4_INFO("restored checkpoint");
+
+		} else {
+			PX4_ERR("failed to restore checkpoint, seeking from the start");
+		}
+	}
+
+	// fast-forward: advance the subscriptions in publication order, without publishing
+	uint32_t nr_skipped_messages = 0;
+
+	while (!should_exit() && file) {
+		uint64_t next_file_time = 0;
+		const int next_msg_id = findNextSubscription(next_file_time);
+
+		if (next_msg_id == -1 || next_file_time >= seek_file_time) {
+			break;
+		}
+
+		writeCheckpoint(next_file_time);
+
+		Subscription &sub = *_subscriptions[next_msg_id];
+		readAndHandleAdditionalMessages(file, sub.next_read_pos);
+		nextDataMessage(file, sub, next_msg_id);
+		++nr_skipped_messages;
+	}
+
+	PX4_INFO("Seeked to %.3lf s (skipped %u msgs, %.3lf s)", (double)(seek_file_time - _file_start_time) / 1.e6,
+		 nr_skipped_messages, (double)hrt_elapsed_time(&start) / 1.e6);
+}
+
+void
+Replay::publishSeekState(uint64_t timestamp_offset)
+{
+	// publish the last message before the seek time of every topic, so that topics published
+	// at a low rate or only on change are available right away
+	for (Subscription *sub : _subscriptions) {
+		if (!sub || !sub->orb_meta || sub->ignored || sub->previous_data.size() != sub->orb_meta->o_size_no_padding) {
+			continue;
+		}
+
+		_read_buffer.reserve(sub->orb_meta->o_size);
+		memcpy(_read_buffer.data(), sub->previous_data.data(), sub->orb_meta->o_size_no_padding);
+
+		uint64_t timestamp;
+		memcpy(&timestamp, _read_buffer.data() + sub->timestamp_offset, sizeof(timestamp));
+		timestamp += timestamp_offset;
+		memcpy(_read_buffer.data() + sub->timestamp_offset, &timestamp, sizeof(timestamp));
+
+		publishTopic(*sub, _read_buffer.data());
+	}
+}
+
+long
+Replay::openCheckpointFile(const ReplayFile &file, uint64_t seek_file_time)
+{
+	const std::string file_name = std::string(_replay_file) + ".ckpt";
+	const CheckpointFileHeader expected_header{CHECKPOINT_MAGIC, CHECKPOINT_VERSION, file.size(), _file_start_time};
+	long checkpoint = -1;
+
+	_next_checkpoint_time = _file_start_time + CHECKPOINT_INTERVAL;
+	_checkpoint_file = fopen(file_name.c_str(), "r+b");
+
+	if (_checkpoint_file) {
+		CheckpointFileHeader header;
+
+		if (fread(&header, sizeof(header), 1, _checkpoint_file) == 1
+		    && memcmp(&header, &expected_header, sizeof(header)) == 0) {
+
+			// find the last checkpoint before the seek time, and the end of the last complete checkpoint
+			long offset = ftell(_checkpoint_file);
+			CheckpointHeader checkpoint_header;
+			std::vector<uint8_t> data;
+
+			while (fread(&checkpoint_header, sizeof(checkpoint_header), 1, _checkpoint_file) == 1) {
+				bool complete = true;
+
+				for (unsigned i = 0; i < checkpoint_header.num_subscriptions && complete; ++i) {
+					CheckpointSubscription checkpoint_sub;
+					complete = fread(&checkpoint_sub, sizeof(checkpoint_sub), 1, _checkpoint_file) == 1;
+					data.resize(checkpoint_sub.data_size + checkpoint_sub.previous_data_size);
+					complete = complete && fread(data.data(), 1, data.size(), _checkpoint_file) == data.size();
+				}
+
+				if (!complete) {
+					break;
+				}
+
+				if (checkpoint_header.file_time <= seek_file_time) {
+					checkpoint = offset;
+				}
+
+				_next_checkpoint_time = checkpoint_header.file_time + CHECKPOINT_INTERVAL;
+				offset = ftell(_checkpoint_file);
+			}
+
+			// drop a partially written checkpoint, new ones are appended
+			if (ftruncate(fileno(_checkpoint_file), offset) != 0) {
+				PX4_WARN("failed to truncate %s", file_name.c_str());
+			}
+
+			return checkpoint;
+		}
+
+		// written for another log, or by another version
+		fclose(_checkpoint_file);
+	}
+
+	_checkpoint_file = fopen(file_name.c_str(), "w+b");
+
+	if (!_checkpoint_file) {
+		PX4_WARN("cannot write checkpoints to %s (%i)", file_name.c_str(), errno);
+		return -1;
+	}
+
+	if (fwrite(&expected_header, sizeof(expected_header), 1, _checkpoint_file) != 1) {
+		fclose(_checkpoint_file);
+		_checkpoint_file = nullptr;
+	}
+
+	return -1;
+}
+
+void
+Replay::writeCheckpoint(uint64_t file_time)
+{
+	if (!_checkpoint_file || file_time < _next_checkpoint_time) {
+		return;
+	}
+
+	_next_checkpoint_time = file_time + CHECKPOINT_INTERVAL;
+
+	CheckpointHeader checkpoint_header{};
+	checkpoint_header.file_time = file_time;
+	checkpoint_header.subscription_file_pos = (std::streamoff)_subscription_file_pos;
+	checkpoint_header.additional_message_pos = _next_additional_message < _additional_message_index.size() ?
+			_additional_message_index[_next_additional_message] : _read_until_file_position;
+	checkpoint_header.next_add_logged_msg = _next_add_logged_msg;
+
+	for (const Subscription *sub : _subscriptions) {
+		if (sub) {
+			++checkpoint_header.num_subscriptions;
+		}
+	}
+
+	fseek(_checkpoint_file, 0, SEEK_END);
+	bool ok = fwrite(&checkpoint_header, sizeof(checkpoint_header), 1, _checkpoint_file) == 1;
+
+	for (size_t i = 0; i < _subscriptions.size() && ok; ++i) {
+		const Subscription *sub = _subscriptions[i];
+
+		if (!sub) {
+			continue;
+		}
+
+		CheckpointSubscription checkpoint_sub{};
+		checkpoint_sub.next_read_pos = (std::streamoff)sub->next_read_pos;
+		checkpoint_sub.next_timestamp = sub->next_timestamp;
+		checkpoint_sub.msg_id = i;
+		checkpoint_sub.data_size = sub->data.size();
+		checkpoint_sub.previous_data_size = sub->previous_data.size();
+		checkpoint_sub.valid = sub->orb_meta != nullptr;
+		checkpoint_sub.data_valid = sub->data_valid;
+
+		ok = fwrite(&checkpoint_sub, sizeof(checkpoint_sub), 1, _checkpoint_file) == 1
+		     && fwrite(sub->data.data(), 1, sub->data.size(), _checkpoint_file) == sub->data.size()
+		     && fwrite(sub->previous_data.data(), 1, sub->previous_data.size(), _checkpoint_file) == sub->previous_data.size();
+	}
+
+	if (!ok || fflush(_checkpoint_file) != 0) {
+		// an incomplete checkpoint is dropped when the file is opened the next time
+		PX4_WARN("failed to write checkpoint, disabling checkpoints");
+		fclose(_checkpoint_file);
+		_checkpoint_file = nullptr;
+	}
+}
+
+bool
+Replay::restoreCheckpoint(ReplayFile &file, long checkpoint)
+{
+	CheckpointHeader checkpoint_header;
+
+	if (fseek(_checkpoint_file, checkpoint, SEEK_SET) != 0
+	    || fread(&checkpoint_header, sizeof(checkpoint_header), 1, _checkpoint_file) != 1) {
+		return false;
+	}
+
+	// create the subscriptions that existed at the checkpoint
+	if (!addSubscriptionsUntil(file, checkpoint_header.subscription_file_pos)) {
+		return false;
+	}
+
+	for (unsigned i = 0; i < checkpoint_header.num_subscriptions; ++i) {
+		CheckpointSubscription checkpoint_sub;
+
+		if (fread(&checkpoint_sub, sizeof(checkpoint_sub), 1, _checkpoint_file) != 1) {
+			return false;
+		}
+
+		std::vector<uint8_t> data(checkpoint_sub.data_size);
+		std::vector<uint8_t> previous_data(checkpoint_sub.previous_data_size);
+
+		if (fread(data.data(), 1, data.size(), _checkpoint_file) != data.size()
+		    || fread(previous_data.data(), 1, previous_data.size(), _checkpoint_file) != previous_data.size()) {
+			return false;
+		}
+
+		Subscription *sub = checkpoint_sub.msg_id < _subscriptions.size() ? _subscriptions[checkpoint_sub.msg_id] : nullptr;
+
+		if (!sub || !sub->orb_meta) {
+			continue; // topic not replayed
+		}
+
+		sub->next_read_pos = checkpoint_sub.next_read_pos;
+		sub->next_timestamp = checkpoint_sub.next_timestamp;
+		sub->data = std::move(data);
+		sub->previous_data = std::move(previous_data);
+		sub->data_valid = checkpoint_sub.data_valid;
+
+		if (!checkpoint_sub.valid) {
+			sub->orb_meta = nullptr;
+		}
+	}
+
+	_next_add_logged_msg = math::max(_next_add_logged_msg, (size_t)checkpoint_header.next_add_logged_msg);
+
+	// apply the parameter changes before the checkpoint
+	return readAndHandleAdditionalMessages(file, checkpoint_header.additional_message_pos);
+}
+
+void
+Replay::readTopicDataToBuffer(const Subscription &sub)
 {
 	const size_t msg_read_size = sub.orb_meta->o_size_no_padding;
 	const size_t msg_write_size = sub.orb_meta->o_size;
 	_read_buffer.reserve(msg_write_size);
-	replay_file.seekg(sub.next_read_pos + (streamoff)(ULOG_MSG_HEADER_LEN + 2)); //skip header & msg id
-	replay_file.read((char *)_read_buffer.data(), msg_read_size);
+	memcpy(_read_buffer.data(), sub.data.data(), msg_read_size);
 }
 
 bool
-Replay::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+Replay::handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file)
 {
 	return publishTopic(sub, data);
 }
@@ -951,6 +1327,14 @@ Replay::custom_command(int argc, char *argv[])
 		return Replay::task_spawn(argc, argv);
 	}
 
+	if (!strcmp(argv[0], "batch")) {
+		return ReplayBatch::run(argc, argv);
+	}
+
+	if (!strcmp(argv[0], "export")) {
+		return ReplayExport::run(argc, argv);
+	}
+
 	return print_usage("unknown command");
 }
 
@@ -1002,7 +1386,7 @@ Replay::applyParams(bool quiet)
 		return -ENOMEM;
 	}
 
-	ifstream replay_file(_replay_file, ios::in | ios::binary);
+	ReplayFile replay_file(_replay_file);
 
 	if (!r->readDefinitionsAndApplyParams(replay_file)) {
 		ret = -1;
@@ -1025,6 +1409,10 @@ Replay::instantiate(int argc, char *argv[])
 		PX4_INFO("Ekf2 replay mode");
 		instance = new ReplayEkf2();
 
+	} else if (replay_mode && strcmp(replay_mode, "fast") == 0) {
+		PX4_INFO("Fast replay mode");
+		instance = new ReplayFast();
+
 	} else {
 		instance = new Replay();
 	}
@@ -1048,21 +1436,46 @@ There are 2 environment variables used for configuration: `replay`, which must b
 the log file to be replayed. The second is the mode, specified via `replay_mode`:
 - `replay_mode=ekf2`: specific EKF2 replay mode. It can only be used with the ekf2 module, but allows the replay
   to run as fast as possible.
+- `replay_mode=fast`: replays any module(s) running on work queues as fast as possible. After each published message
+  it waits until all work queues are idle. With the lockstep scheduler the system time follows the log time, which
+  makes the replay deterministic.
 - Generic otherwise: this can be used to replay any module(s), but the replay will be done with the same speed as the
   log was recorded.
 
+The replay can start at a later point in the log with `replay_seek=<seconds since log start>`. During replay,
+checkpoints of the replay state (file positions, decoded topic data and the last message of each topic) are written
+every 30 s to `<log file>.ckpt`, so a later seek restores the closest checkpoint and only fast-forwards from there.
+The last message before the seek time of every replayed topic is published when the replay starts. Modules like the
+estimator start from their initial state at the seek time, so seek some time before the event of interest.
+
 The module is typically used together with uORB publisher rules, to specify which messages should be replayed.
 The replay module will just publish all messages that are found in the log. It also applies the parameters from
 the log.
 
 The replay procedure is documented on the [System-wide Replay](https://dev.px4.io/master/en/debug/system_wide_replay.html)
 page.
+
+`replay batch <dir>` replays all .ulg files in a directory in EKF2 replay mode, several at a time. Each replay runs in
+its own px4 process with the working directory `<dir>/replay_batch/<log name>`, the estimator innovation statistics
+of all logs are collected in a summary CSV file.
+
+`replay export <file>` converts an ULog file into a columnar format: one file per topic instance
+(`<topic>.<multi_id>.col`) with one contiguous, 8 byte aligned array per field, and `schema.csv` with the type, number
+of rows and byte offset of each column. Nested types are flattened. This does not need the topics to be known to the
+build and does not publish anything.
 )DESCR_STR");
 
 	PRINT_MODULE_USAGE_NAME("replay", "system");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start replay, using log file from ENV variable 'replay'");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("trystart", "Same as 'start', but silently exit if no log file given");
 	PRINT_MODULE_USAGE_COMMAND_DESCR("tryapplyparams", "Try to apply the parameters from the log file");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("batch", "Replay all logs of a directory in EKF2 mode (POSIX only, blocking)");
+	PRINT_MODULE_USAGE_PARAM_INT('j', -1, 1, 64, "Number of parallel replays (default: number of CPUs)", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('o', nullptr, "<file>", "Summary file (default: <dir>/replay_summary.csv)", true);
+	PRINT_MODULE_USAGE_ARG("<dir>", "Directory with the .ulg files", false);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("export", "Convert a log file into a columnar format (blocking)");
+	PRINT_MODULE_USAGE_PARAM_STRING('o', nullptr, "<dir>", "Output directory (default: <log name>_columns)", true);
+	PRINT_MODULE_USAGE_ARG("<file>", "ULog file", false);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
 
 	return 0;
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <stdio.h>
 #include <fstream>
 #include <map>
 #include <vector>
@@ -40,6 +41,7 @@
 #include <string>
 
 #include "definitions.hpp"
+#include "ReplayFile.hpp"
 
 #include <px4_platform_common/module.h>
 #include <uORB/topics/uORBTopics.hpp>
@@ -51,9 +53,10 @@ namespace px4
 /**
  * @class Replay
  * Parses an ULog file and replays it in 'real-time'. The timestamp of each replayed message is offset
- * to match the starting time of replay. It keeps a stream for each subscription to find the next message
+ * to match the starting time of replay. It keeps a file position for each subscription to find the next message
  * to replay. This is necessary because data messages from different subscriptions don't need to be in
- * monotonic increasing order.
+ * monotonic increasing order. The file is memory-mapped and indexed once per message id, so finding the
+ * next message of a subscription does not scan over the messages of other topics.
  */
 class Replay : public ModuleBase<Replay>
 {
@@ -137,6 +140,10 @@ protected:
 		std::streampos next_read_pos;
 		uint64_t next_timestamp; ///< timestamp of the file
 
+		std::vector<uint8_t> data; ///< data of the message at next_read_pos (decoded)
+		std::vector<uint8_t> previous_data; ///< data of the message before next_read_pos (decoded), empty if none
+		bool data_valid = false; ///< false until the first (or after undecodable) data message
+
 		CompatBase *compat = nullptr;
 
 		// statistics
@@ -189,22 +196,28 @@ protected:
 	 * handle the publication of a topic update
 	 * @return true if published, false otherwise
 	 */
-	virtual bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file);
+	virtual bool handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file);
 
 	/**
-	 * read a topic from the file (offset given by the subscription) into _read_buffer
+	 * copy the data of the current message of a subscription (read by nextDataMessage()) into _read_buffer
 	 */
-	void readTopicDataToBuffer(const Subscription &sub, std::ifstream &replay_file);
+	void readTopicDataToBuffer(const Subscription &sub);
 
 	/**
 	 * Find next data message for this subscription, starting with the stored file offset.
 	 * Skip the first message, and if found, read the timestamp and store the new file offset.
-	 * This also takes care of new subscriptions and parameter updates. When reaching EOF,
-	 * the subscription is set to invalid.
+	 * This also takes care of new subscriptions. When reaching EOF, the subscription is set to invalid.
 	 * File seek position is arbitrary after this call.
 	 * @return false on file error
 	 */
-	bool nextDataMessage(std::ifstream &file, Subscription &subscription, int msg_id);
+	bool nextDataMessage(ReplayFile &file, Subscription &subscription, int msg_id);
+
+	/**
+	 * Read the payload of a data message (DATA or DATA_DELTA) after the msg_id into subscription.data.
+	 * File seek position is at the end of the message afterwards.
+	 * @return true if the data is valid
+	 */
+	bool readDataMessage(ReplayFile &file, Subscription &subscription, uint8_t msg_type, uint16_t msg_size);
 
 	std::vector<Subscription *> _subscriptions;
 	std::vector<uint8_t> _read_buffer;
@@ -222,36 +235,124 @@ private:
 
 	int64_t _read_until_file_position = 1ULL << 60; ///< read limit if log contains appended data
 
-	bool readFileHeader(std::ifstream &file);
+	std::vector<std::vector<std::streamoff>> _data_message_index; ///< file offsets of the data messages, per msg_id
+	std::vector<std::streamoff> _add_logged_msg_index; ///< file offsets of the ADD_LOGGED_MSG messages
+	std::vector<std::streamoff> _additional_message_index; ///< file offsets of the PARAMETER and DROPOUT messages
+	size_t _next_add_logged_msg = 0; ///< index into _add_logged_msg_index of the next subscription to add
+	size_t _next_additional_message = 0; ///< index into _additional_message_index of the next message to handle
+
+	static constexpr uint32_t CHECKPOINT_MAGIC = 0x50435250; ///< 'PRCP'
+	static constexpr uint32_t CHECKPOINT_VERSION = 1;
+	static constexpr uint64_t CHECKPOINT_INTERVAL = 30 * 1000 * 1000; ///< [us] log time between checkpoints
+
+	struct CheckpointFileHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t log_file_size; ///< a checkpoint file is only valid for the log it was written for
+		uint64_t log_start_time;
+	};
+
+	/** followed by num_subscriptions CheckpointSubscription */
+	struct CheckpointHeader {
+		uint64_t file_time; ///< next timestamp to publish
+		int64_t subscription_file_pos;
+		int64_t additional_message_pos; ///< first PARAMETER or DROPOUT message not handled yet
+		uint32_t next_add_logged_msg;
+		uint32_t num_subscriptions;
+	};
+
+	/** followed by data_size bytes of data and previous_data_size bytes of previous data */
+	struct CheckpointSubscription {
+		int64_t next_read_pos;
+		uint64_t next_timestamp;
+		uint16_t msg_id;
+		uint16_t data_size;
+		uint16_t previous_data_size;
+		uint8_t valid;
+		uint8_t data_valid;
+	};
+
+	FILE *_checkpoint_file = nullptr;
+	uint64_t _next_checkpoint_time = 0; ///< file time of the next checkpoint to write
+
+	bool readFileHeader(ReplayFile &file);
 
 	/**
 	 * Read definitions section: check formats, apply parameters and store
 	 * the start of the data section.
 	 * @return true on success
 	 */
-	bool readFileDefinitions(std::ifstream &file);
+	bool readFileDefinitions(ReplayFile &file);
 
 	///file parsing methods. They return false, when further parsing should be aborted.
-	bool readFormat(std::ifstream &file, uint16_t msg_size);
-	bool readAndAddSubscription(std::ifstream &file, uint16_t msg_size);
-	bool readFlagBits(std::ifstream &file, uint16_t msg_size);
+	bool readFormat(ReplayFile &file, uint16_t msg_size);
+	bool readAndAddSubscription(ReplayFile &file, uint16_t msg_size);
+	bool readFlagBits(ReplayFile &file, uint16_t msg_size);
 
 	/**
 	 * Read the file header and definitions sections. Apply the parameters from this section
 	 * and apply user-defined overridden parameters.
 	 * @return true on success
 	 */
-	bool readDefinitionsAndApplyParams(std::ifstream &file);
+	bool readDefinitionsAndApplyParams(ReplayFile &file);
+
+	/**
+	 * Build the message index of the data section in a single pass over the mapped file.
+	 */
+	void buildMessageIndex(const ReplayFile &file);
+
+	/**
+	 * Find the subscription with the next message to publish
+	 * @param next_file_time timestamp of that message
+	 * @return msg_id of the subscription, -1 if there is none
+	 */
+	int findNextSubscription(uint64_t &next_file_time) const;
+
+	/**
+	 * Fast-forward the subscriptions to the first messages at or after seek_file_time, without publishing.
+	 * Starts at a checkpoint if given.
+	 * @param checkpoint checkpoint file offset, -1 to seek from the start
+	 */
+	void seek(ReplayFile &file, uint64_t seek_file_time, long checkpoint);
+
+	/**
+	 * After a seek, publish the last message before the seek time of each topic
+	 */
+	void publishSeekState(uint64_t timestamp_offset);
+
+	/**
+	 * Open the checkpoint file of the replayed log for appending new checkpoints (it is created if it
+	 * does not exist or does not match the log), and find the last checkpoint at or before seek_file_time.
+	 * @return checkpoint file offset of that checkpoint, -1 if there is none
+	 */
+	long openCheckpointFile(const ReplayFile &file, uint64_t seek_file_time);
+
+	/**
+	 * Append a checkpoint of the current replay state, if the checkpoint interval has passed
+	 */
+	void writeCheckpoint(uint64_t file_time);
+
+	/**
+	 * Restore the replay state from a checkpoint
+	 * @return false on file error
+	 */
+	bool restoreCheckpoint(ReplayFile &file, long checkpoint);
+
+	/**
+	 * Add the subscriptions of all ADD_LOGGED_MSG messages before end_position that are not added yet.
+	 * @return false on file error
+	 */
+	bool addSubscriptionsUntil(ReplayFile &file, std::streamoff end_position);
 
 	/**
-	 * Read and handle additional messages starting at current file position, while position < end_position.
+	 * Read and handle the additional messages that are not handled yet, while position < end_position.
 	 * This handles dropout and parameter update messages.
 	 * We need to handle these separately, because they have no timestamp. We look at the file position instead.
 	 * @return false on file error
 	 */
-	bool readAndHandleAdditionalMessages(std::ifstream &file, std::streampos end_position);
-	bool readDropout(std::ifstream &file, uint16_t msg_size);
-	bool readAndApplyParameter(std::ifstream &file, uint16_t msg_size);
+	bool readAndHandleAdditionalMessages(ReplayFile &file, std::streampos end_position);
+	bool readDropout(ReplayFile &file, uint16_t msg_size);
+	bool readAndApplyParameter(ReplayFile &file, uint16_t msg_size);
 
 	static const orb_metadata *findTopic(const std::string &name);
 
@@ -0,0 +1,315 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ReplayBatch.hpp"
+#include "ReplayEkf2.hpp"
+#include "definitions.hpp"
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace px4
+{
+
+int
+ReplayBatch::run(int argc, char *argv[])
+{
+	int jobs_max = sysconf(_SC_NPROCESSORS_ONLN);
+	std::string summary_file;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "j:o:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'j':
+			jobs_max = strtol(myoptarg, nullptr, 10);
+			break;
+
+		case 'o':
+			summary_file = myoptarg;
+			break;
+
+		default:
+			return -1;
+		}
+	}
+
+	if (myoptind >= argc) {
+		PX4_ERR("no log directory given");
+		return -1;
+	}
+
+	jobs_max = std::max(jobs_max, 1);
+
+	const std::string directory = argv[myoptind];
+	const std::vector<std::string> logs = findLogs(directory);
+
+	if (logs.empty()) {
+		PX4_ERR("no .ulg files found in %s", directory.c_str());
+		return -1;
+	}
+
+	if (summary_file.empty()) {
+		summary_file = directory + "/replay_summary.csv";
+	}
+
+	// the replay processes run the same binary with the same startup files
+	char path[PATH_MAX];
+	const ssize_t len = readlink("/proc/self/exe", path, sizeof(path) - 1);
+	std::string binary = "px4"; // fall back to PATH, which contains the binary directory in the startup script
+
+	if (len > 0) {
+		path[len] = '\0';
+		binary = path;
+	}
+
+	if (!realpath("etc", path)) {
+		PX4_ERR("etc not found, 'replay batch' must run from the rootfs directory");
+		return -1;
+	}
+
+	const std::string data_path = path;
+
+	const std::string batch_dir = directory + "/replay_batch";
+	mkdir(batch_dir.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
+
+	std::vector<Job> jobs(logs.size());
+
+	for (size_t i = 0; i < logs.size(); ++i) {
+		std::string name = logs[i].substr(0, logs[i].rfind('.'));
+		jobs[i].log_file = directory + "/" + logs[i];
+		jobs[i].working_dir = batch_dir + "/" + name;
+		jobs[i].stats_file = jobs[i].working_dir + "/ekf2_stats.csv";
+	}
+
+	PX4_INFO("replaying %zu logs, %i in parallel", jobs.size(), jobs_max);
+
+	std::vector<bool> instance_used(jobs_max, false);
+	size_t next_job = 0;
+	size_t jobs_done = 0;
+	int running = 0;
+	int failed = 0;
+
+	while (jobs_done < jobs.size()) {
+
+		// start jobs until all instances are used
+		while (running < jobs_max && next_job < jobs.size()) {
+			Job &job = jobs[next_job++];
+			const int slot = std::find(instance_used.begin(), instance_used.end(), false) - instance_used.begin();
+			job.instance = INSTANCE_OFFSET + slot;
+
+			if (spawn(job, binary, data_path)) {
+				instance_used[slot] = true;
+				++running;
+
+			} else {
+				PX4_ERR("failed to start replay of %s", job.log_file.c_str());
+				++jobs_done;
+				++failed;
+			}
+		}
+
+		// the replays run in real time, not in (lockstep) simulation time
+		system_usleep(100000);
+
+		for (Job &job : jobs) {
+			int status;
+
+			if (job.pid > 0 && waitpid(job.pid, &status, WNOHANG) == job.pid) {
+				job.exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+				job.pid = -1;
+				instance_used[job.instance - INSTANCE_OFFSET] = false;
+				--running;
+				++jobs_done;
+
+				if (job.exit_status != 0) {
+					++failed;
+				}
+
+				PX4_INFO("[%zu/%zu] %s done (%i)", jobs_done, jobs.size(), job.log_file.c_str(), job.exit_status);
+			}
+		}
+	}
+
+	if (!writeSummary(jobs, summary_file)) {
+		return -1;
+	}
+
+	PX4_INFO("summary written to %s (%i failed)", summary_file.c_str(), failed);
+
+	return failed == 0 ? 0 : -1;
+}
+
+bool
+ReplayBatch::spawn(Job &job, const std::string &binary, const std::string &data_path)
+{
+	mkdir(job.working_dir.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
+	unlink(job.stats_file.c_str());
+
+	char log_path[PATH_MAX];
+
+	if (!realpath(job.log_file.c_str(), log_path)) {
+		return false;
+	}
+
+	// environment of this process, with the replay variables replaced
+	std::vector<std::string> env_strings;
+
+	for (char **env = environ; *env; ++env) {
+		const std::string var = *env;
+		const std::string name = var.substr(0, var.find('='));
+
+		if (name != replay::ENV_FILENAME && name != replay::ENV_MODE && name != replay::ENV_STATS) {
+			env_strings.push_back(var);
+		}
+	}
+
+	env_strings.push_back(std::string(replay::ENV_FILENAME) + "=" + log_path);
+	env_strings.push_back(std::string(replay::ENV_MODE) + "=ekf2");
+	env_strings.push_back(std::string(replay::ENV_STATS) + "=" + job.stats_file);
+
+	std::vector<char *> envp;
+
+	for (std::string &var : env_strings) {
+		envp.push_back(&var[0]);
+	}
+
+	envp.push_back(nullptr);
+
+	std::string instance = std::to_string(job.instance);
+	std::string output_file = job.working_dir + "/replay.txt";
+	std::string binary_arg = binary;
+	std::string working_dir = job.working_dir;
+	std::string data_path_arg = data_path;
+	char daemon_arg[] = "-d";
+	char instance_arg[] = "-i";
+	char working_dir_arg[] = "-w";
+	char *const args[] = {&binary_arg[0], daemon_arg, instance_arg, &instance[0], working_dir_arg, &working_dir[0],
+			      &data_path_arg[0], nullptr
+			     };
+
+	// the console output of each replay goes to its working directory
+	posix_spawn_file_actions_t file_actions;
+	posix_spawn_file_actions_init(&file_actions);
+	posix_spawn_file_actions_addopen(&file_actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+	posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, output_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+					 0644);
+	posix_spawn_file_actions_adddup2(&file_actions, STDOUT_FILENO, STDERR_FILENO);
+
+	const int ret = posix_spawnp(&job.pid, binary.c_str(), &file_actions, nullptr, args, envp.data());
+	posix_spawn_file_actions_destroy(&file_actions);
+
+	if (ret != 0) {
+		job.pid = -1;
+		return false;
+	}
+
+	return true;
+}
+
+bool
+ReplayBatch::writeSummary(const std::vector<Job> &jobs, const std::string &summary_file)
+{
+	FILE *summary = fopen(summary_file.c_str(), "w");
+
+	if (!summary) {
+		PX4_ERR("failed to open %s (%i)", summary_file.c_str(), errno);
+		return false;
+	}
+
+	fprintf(summary, "log,exit_status,%s\n", ReplayEkf2::STATISTICS_HEADER);
+
+	for (const Job &job : jobs) {
+		char line[512] {};
+		FILE *stats = fopen(job.stats_file.c_str(), "r");
+
+		if (stats) {
+			if (!fgets(line, sizeof(line), stats)) {
+				line[0] = '\0';
+			}
+
+			fclose(stats);
+		}
+
+		// strip the newline, a missing statistics file leaves the columns empty
+		line[strcspn(line, "\r\n")] = '\0';
+		fprintf(summary, "%s,%i,%s\n", job.log_file.c_str(), job.exit_status, line);
+	}
+
+	fclose(summary);
+	return true;
+}
+
+std::vector<std::string>
+ReplayBatch::findLogs(const std::string &directory)
+{
+	std::vector<std::string> logs;
+	DIR *dir = opendir(directory.c_str());
+
+	if (!dir) {
+		return logs;
+	}
+
+	struct dirent *entry;
+
+	while ((entry = readdir(dir)) != nullptr) {
+		const std::string name = entry->d_name;
+
+		if (name.size() > 4 && name.compare(name.size() - 4, 4, ".ulg") == 0) {
+			logs.push_back(name);
+		}
+	}
+
+	closedir(dir);
+	std::sort(logs.begin(), logs.end());
+	return logs;
+}
+
+} //namespace px4
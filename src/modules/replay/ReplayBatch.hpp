@@ -0,0 +1,88 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace px4
+{
+
+/**
+ * @class ReplayBatch
+ * Replays all ULog files of a directory in EKF2 replay mode, running several replays in parallel.
+ * Each replay is a separate px4 process (uORB is global to a process), started with its own
+ * instance and working directory. The processes write their estimator innovation statistics to a
+ * file, which are collected into a single summary file once all replays are done.
+ */
+class ReplayBatch
+{
+public:
+	/**
+	 * Run the batch replay (blocking)
+	 * @param argc, argv: arguments after 'batch'
+	 * @return 0 if all logs were replayed
+	 */
+	static int run(int argc, char *argv[]);
+
+private:
+	static constexpr int INSTANCE_OFFSET = 100; ///< px4 instance of the first replay process
+
+	struct Job {
+		std::string log_file;
+		std::string working_dir;
+		std::string stats_file;
+		pid_t pid{-1};
+		int instance{-1};
+		int exit_status{-1};
+	};
+
+	/**
+	 * Start the px4 process of a job
+	 * @return true on success
+	 */
+	static bool spawn(Job &job, const std::string &binary, const std::string &data_path);
+
+	/**
+	 * Write the summary of all jobs, in log file order
+	 * @return true on success
+	 */
+	static bool writeSummary(const std::vector<Job> &jobs, const std::string &summary_file);
+
+	static std::vector<std::string> findLogs(const std::string &directory);
+};
+
+} //namespace px4
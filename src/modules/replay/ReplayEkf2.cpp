@@ -34,6 +34,12 @@
 #include <drivers/drv_hrt.h>
 #include <px4_platform_common/defines.h>
 #include <px4_platform_common/posix.h>
+#include <lib/mathlib/mathlib.h>
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 // for ekf2 replay
 #include <uORB/topics/airspeed.h>
@@ -56,7 +62,7 @@ namespace px4
 {
 
 bool
-ReplayEkf2::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file)
+ReplayEkf2::handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file)
 {
 	if (sub.orb_meta == ORB_ID(ekf2_timestamps)) {
 		ekf2_timestamps_s ekf2_timestamps;
@@ -91,6 +97,8 @@ ReplayEkf2::handleTopicUpdate(Subscription &sub, void *data, std::ifstream &repl
 				// need to to an orb_copy so that poll will not return immediately
 				orb_copy(ORB_ID(vehicle_attitude), _vehicle_attitude_sub, &att);
 			}
+
+			updateInnovationStatistics();
 		}
 
 		return true;
@@ -136,7 +144,7 @@ ReplayEkf2::onSubscriptionAdded(Subscription &sub, uint16_t msg_id)
 }
 
 bool
-ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifstream &replay_file)
+ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, ReplayFile &replay_file)
 {
 	auto handle_sensor_publication = [&](int16_t timestamp_relative, uint16_t msg_id) {
 		if (timestamp_relative != ekf2_timestamps_s::RELATIVE_TIMESTAMP_INVALID) {
@@ -164,7 +172,7 @@ ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifs
 
 		} else {
 			// we should publish a topic, just publish the same again
-			readTopicDataToBuffer(*_subscriptions[_sensor_combined_msg_id], replay_file);
+			readTopicDataToBuffer(*_subscriptions[_sensor_combined_msg_id]);
 			publishTopic(*_subscriptions[_sensor_combined_msg_id], _read_buffer.data());
 		}
 	}
@@ -173,7 +181,7 @@ ReplayEkf2::publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifs
 }
 
 bool
-ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::ifstream &replay_file)
+ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, ReplayFile &replay_file)
 {
 	if (msg_id == msg_id_invalid) {
 		// could happen if a topic is not logged
@@ -198,7 +206,7 @@ ReplayEkf2::findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::if
 		return false;
 	}
 
-	readTopicDataToBuffer(sub, replay_file);
+	readTopicDataToBuffer(sub);
 	publishTopic(sub, _read_buffer.data());
 	return true;
 }
@@ -234,10 +242,76 @@ ReplayEkf2::onExitMainLoop()
 	print_sensor_statistics(_vehicle_magnetometer_msg_id, "vehicle_magnetometer");
 	print_sensor_statistics(_vehicle_visual_odometry_msg_id, "vehicle_visual_odometry");
 
+	writeInnovationStatistics();
+
 	orb_unsubscribe(_vehicle_attitude_sub);
 	_vehicle_attitude_sub = -1;
 }
 
+void
+ReplayEkf2::updateInnovationStatistics()
+{
+	estimator_innovations_s innovations;
+
+	if (_estimator_innovations_sub.update(&innovations)) {
+		InnovationStatistics *stats = _innovation_statistics;
+		stats[(int)Innovation::GpsHvel].update(innovations.gps_hvel[0]);
+		stats[(int)Innovation::GpsHvel].update(innovations.gps_hvel[1]);
+		stats[(int)Innovation::GpsVvel].update(innovations.gps_vvel);
+		stats[(int)Innovation::GpsHpos].update(innovations.gps_hpos[0]);
+		stats[(int)Innovation::GpsHpos].update(innovations.gps_hpos[1]);
+		stats[(int)Innovation::GpsVpos].update(innovations.gps_vpos);
+		stats[(int)Innovation::BaroVpos].update(innovations.baro_vpos);
+		stats[(int)Innovation::RngVpos].update(innovations.rng_vpos);
+
+		for (int i = 0; i < 3; i++) {
+			stats[(int)Innovation::MagField].update(innovations.mag_field[i]);
+		}
+
+		stats[(int)Innovation::Heading].update(innovations.heading);
+		stats[(int)Innovation::Airspeed].update(innovations.airspeed);
+		stats[(int)Innovation::Flow].update(innovations.flow[0]);
+		stats[(int)Innovation::Flow].update(innovations.flow[1]);
+		++_innovation_samples;
+	}
+
+	estimator_status_s status;
+
+	if (_estimator_status_sub.update(&status)) {
+		_vel_test_ratio_max = math::max(_vel_test_ratio_max, status.vel_test_ratio);
+		_pos_test_ratio_max = math::max(_pos_test_ratio_max, status.pos_test_ratio);
+		_hgt_test_ratio_max = math::max(_hgt_test_ratio_max, status.hgt_test_ratio);
+		_mag_test_ratio_max = math::max(_mag_test_ratio_max, status.mag_test_ratio);
+	}
+}
+
+void
+ReplayEkf2::writeInnovationStatistics()
+{
+	const char *stats_file = getenv(replay::ENV_STATS);
+
+	if (!stats_file) {
+		return;
+	}
+
+	FILE *file = fopen(stats_file, "w");
+
+	if (!file) {
+		PX4_ERR("failed to open %s (%i)", stats_file, errno);
+		return;
+	}
+
+	fprintf(file, "%u", (unsigned)_innovation_samples);
+
+	for (const InnovationStatistics &stats : _innovation_statistics) {
+		fprintf(file, ",%.6f", (double)stats.rms());
+	}
+
+	fprintf(file, ",%.4f,%.4f,%.4f,%.4f\n", (double)_vel_test_ratio_max, (double)_pos_test_ratio_max,
+		(double)_hgt_test_ratio_max, (double)_mag_test_ratio_max);
+	fclose(file);
+}
+
 uint64_t
 ReplayEkf2::handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset)
 {
@@ -35,6 +35,10 @@
 
 #include "Replay.hpp"
 
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/estimator_innovations.h>
+#include <uORB/topics/estimator_status.h>
+
 namespace px4
 {
 
@@ -45,6 +49,11 @@ namespace px4
 class ReplayEkf2 : public Replay
 {
 public:
+	/** columns of the innovation statistics written at the end of the replay (see replay::ENV_STATS) */
+	static constexpr const char *STATISTICS_HEADER = "innovation_samples,gps_hvel_rms,gps_vvel_rms,gps_hpos_rms,"
+			"gps_vpos_rms,baro_vpos_rms,rng_vpos_rms,mag_field_rms,heading_rms,airspeed_rms,flow_rms,"
+			"vel_test_ratio_max,pos_test_ratio_max,hgt_test_ratio_max,mag_test_ratio_max";
+
 protected:
 
 	void onEnterMainLoop() override;
@@ -59,13 +68,13 @@ protected:
 	 * @param replay_file file currently replayed (file seek position should be considered arbitrary after this call)
 	 * @return true if published, false otherwise
 	 */
-	bool handleTopicUpdate(Subscription &sub, void *data, std::ifstream &replay_file) override;
+	bool handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file) override;
 
 	void onSubscriptionAdded(Subscription &sub, uint16_t msg_id) override;
 
 private:
 
-	bool publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, std::ifstream &replay_file);
+	bool publishEkf2Topics(const ekf2_timestamps_s &ekf2_timestamps, ReplayFile &replay_file);
 
 	/**
 	 * find the next message for a subscription that matches a given timestamp and publish it
@@ -74,7 +83,47 @@ private:
 	 * @param replay_file file currently replayed (file seek position should be considered arbitrary after this call)
 	 * @return true if timestamp found and published
 	 */
-	bool findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, std::ifstream &replay_file);
+	bool findTimestampAndPublish(uint64_t timestamp, uint16_t msg_id, ReplayFile &replay_file);
+
+	/**
+	 * accumulate the estimator innovations and test ratios published since the last call
+	 */
+	void updateInnovationStatistics();
+
+	/**
+	 * write the innovation statistics as one line to the file given via replay::ENV_STATS (if set)
+	 */
+	void writeInnovationStatistics();
+
+	/** RMS of the non-zero (fused) innovations of one measurement type */
+	struct InnovationStatistics {
+		void update(float innovation)
+		{
+			if (PX4_ISFINITE(innovation) && fabsf(innovation) > 0.f) {
+				sum_squares += (double)innovation * innovation;
+				++count;
+			}
+		}
+
+		float rms() const { return count > 0 ? sqrt(sum_squares / count) : 0.f; }
+
+		double sum_squares{0.};
+		uint32_t count{0};
+	};
+
+	enum class Innovation {
+		GpsHvel, GpsVvel, GpsHpos, GpsVpos, BaroVpos, RngVpos, MagField, Heading, Airspeed, Flow, Count
+	};
+
+	InnovationStatistics _innovation_statistics[(int)Innovation::Count] {};
+	uint32_t _innovation_samples{0};
+	float _vel_test_ratio_max{0.f};
+	float _pos_test_ratio_max{0.f};
+	float _hgt_test_ratio_max{0.f};
+	float _mag_test_ratio_max{0.f};
+
+	uORB::Subscription _estimator_innovations_sub{ORB_ID(estimator_innovations)};
+	uORB::Subscription _estimator_status_sub{ORB_ID(estimator_status)};
 
 	int _vehicle_attitude_sub = -1;
 
@@ -0,0 +1,486 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ReplayExport.hpp"
+#include "ReplayFile.hpp"
+
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+
+#include <logger/messages.h>
+#include <logger/ulog_delta.h>
+
+#include <algorithm>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+namespace px4
+{
+
+int
+ReplayExport::run(int argc, char *argv[])
+{
+	const char *output_dir = nullptr;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "o:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'o':
+			output_dir = myoptarg;
+			break;
+
+		default:
+			PX4_ERR("unknown option");
+			return -1;
+		}
+	}
+
+	if (myoptind >= argc) {
+		PX4_ERR("missing log file");
+		return -1;
+	}
+
+	const std::string log_file = argv[myoptind];
+	std::string output = output_dir ? output_dir : log_file.substr(0, log_file.rfind('.')) + "_columns";
+
+	ReplayFile file(log_file.c_str());
+
+	if (!file.is_open()) {
+		PX4_ERR("Failed to open %s (%i)", log_file.c_str(), errno);
+		return -1;
+	}
+
+	ReplayExport exporter;
+
+	if (!exporter.readHeader(file) || !exporter.readDefinitions(file) || !exporter.readData(file)) {
+		PX4_ERR("Failed to parse %s", log_file.c_str());
+		return -1;
+	}
+
+	if (!exporter.write(output)) {
+		return -1;
+	}
+
+	PX4_INFO("Exported %s to %s", log_file.c_str(), output.c_str());
+	return 0;
+}
+
+bool
+ReplayExport::readHeader(ReplayFile &file)
+{
+	// log reader currently assumes little endian
+	int num = 1;
+
+	if (*(char *)&num != 1) {
+		PX4_ERR("Export only works on little endian!");
+		return false;
+	}
+
+	const uint8_t magic[] = {'U', 'L', 'o', 'g', 0x01, 0x12, 0x35};
+	ulog_file_header_s header;
+	file.seekg(0);
+	file.read((char *)&header, sizeof(header));
+
+	return file && memcmp(header.magic, magic, sizeof(magic)) == 0;
+}
+
+bool
+ReplayExport::readDefinitions(ReplayFile &file)
+{
+	const uint8_t *data = file.data();
+	const int64_t size = file.size();
+	int64_t pos = sizeof(ulog_file_header_s);
+
+	while (pos + ULOG_MSG_HEADER_LEN <= size) {
+		ulog_message_header_s header;
+		memcpy(&header, data + pos, ULOG_MSG_HEADER_LEN);
+		const uint8_t *payload = data + pos + ULOG_MSG_HEADER_LEN;
+
+		if (pos + ULOG_MSG_HEADER_LEN + header.msg_size > size) {
+			return false;
+		}
+
+		switch (header.msg_type) {
+		case (int)ULogMessageType::FORMAT: {
+				const std::string format((const char *)payload, header.msg_size);
+				const size_t colon = format.find(':');
+
+				if (colon != std::string::npos) {
+					_formats[format.substr(0, colon)] = format.substr(colon + 1);
+				}
+			}
+			break;
+
+		case (int)ULogMessageType::FLAG_BITS:
+			if (header.msg_size >= 40) {
+				const uint8_t *incompat_flags = payload + 8;
+
+				if (incompat_flags[0] & ULOG_INCOMPAT_FLAG0_DATA_APPENDED_MASK) {
+					uint64_t appended_offset;
+					memcpy(&appended_offset, payload + 16, sizeof(appended_offset));
+
+					if (appended_offset > 0) {
+						_data_end = appended_offset;
+					}
+				}
+			}
+
+			break;
+
+		case (int)ULogMessageType::ADD_LOGGED_MSG:
+			_data_start = pos;
+			return true;
+
+		default:
+			break;
+		}
+
+		pos += ULOG_MSG_HEADER_LEN + header.msg_size;
+	}
+
+	// no data
+	_data_start = pos;
+	return true;
+}
+
+bool
+ReplayExport::readData(ReplayFile &file)
+{
+	const uint8_t *data = file.data();
+	const int64_t end = std::min((int64_t)file.size(), _data_end);
+	int64_t pos = _data_start;
+
+	while (pos + ULOG_MSG_HEADER_LEN <= end) {
+		ulog_message_header_s header;
+		memcpy(&header, data + pos, ULOG_MSG_HEADER_LEN);
+		const uint8_t *payload = data + pos + ULOG_MSG_HEADER_LEN;
+
+		if (pos + ULOG_MSG_HEADER_LEN + header.msg_size > end) {
+			break; // truncated message
+		}
+
+		switch (header.msg_type) {
+		case (int)ULogMessageType::ADD_LOGGED_MSG:
+			addTopic(payload, header.msg_size);
+			break;
+
+		case (int)ULogMessageType::REMOVE_LOGGED_MSG:
+			if (header.msg_size >= sizeof(uint16_t)) {
+				uint16_t msg_id;
+				memcpy(&msg_id, payload, sizeof(msg_id));
+				auto topic = _topics.find(msg_id);
+
+				if (topic != _topics.end()) {
+					_removed_topics.push_back(std::move(topic->second));
+					_topics.erase(topic);
+				}
+			}
+
+			break;
+
+		case (int)ULogMessageType::DATA:
+		case (int)ULogMessageType::DATA_DELTA:
+			if (header.msg_size >= sizeof(uint16_t)) {
+				uint16_t msg_id;
+				memcpy(&msg_id, payload, sizeof(msg_id));
+				auto topic = _topics.find(msg_id);
+
+				if (topic != _topics.end()) {
+					addRow(topic->second, header.msg_type, payload + sizeof(uint16_t), header.msg_size - sizeof(uint16_t));
+				}
+			}
+
+			break;
+
+		default:
+			break;
+		}
+
+		pos += ULOG_MSG_HEADER_LEN + header.msg_size;
+	}
+
+	return true;
+}
+
+void
+ReplayExport::addTopic(const uint8_t *payload, size_t payload_size)
+{
+	if (payload_size < 3) {
+		return;
+	}
+
+	uint16_t msg_id;
+	memcpy(&msg_id, payload + 1, sizeof(msg_id));
+
+	auto previous = _topics.find(msg_id);
+
+	if (previous != _topics.end()) {
+		_removed_topics.push_back(std::move(previous->second));
+		_topics.erase(previous);
+	}
+
+	Topic &topic = _topics[msg_id];
+	topic.multi_id = payload[0];
+	topic.name.assign((const char *)payload + 3, strnlen((const char *)payload + 3, payload_size - 3));
+	topic.message_size = addColumns(topic, topic.name, "", 0, 0);
+
+	if (topic.message_size == 0) {
+		PX4_WARN("unknown format of %s, ignoring it", topic.name.c_str());
+		topic.columns.clear();
+	}
+
+	topic.message.resize(topic.message_size);
+}
+
+size_t
+ReplayExport::addColumns(Topic &topic, const std::string &format_name, const std::string &prefix, size_t offset,
+			 int depth)
+{
+	auto format = _formats.find(format_name);
+
+	if (format == _formats.end() || depth > 8) {
+		return 0;
+	}
+
+	const std::string &fields = format->second;
+	const size_t start_offset = offset;
+	size_t field_start = 0;
+	size_t field_end;
+
+	// fields have the form "<type>[<array size>] <name>;"
+	while ((field_end = fields.find(';', field_start)) != std::string::npos) {
+		const std::string field = fields.substr(field_start, field_end - field_start);
+		field_start = field_end + 1;
+
+		const size_t space = field.find(' ');
+
+		if (space == std::string::npos) {
+			return 0;
+		}
+
+		std::string type = field.substr(0, space);
+		const std::string name = field.substr(space + 1);
+		int array_size = 1;
+		const size_t bracket = type.find('[');
+
+		if (bracket != std::string::npos) {
+			array_size = atoi(type.c_str() + bracket + 1);
+			type = type.substr(0, bracket);
+		}
+
+		const size_t type_size = sizeOfBasicType(type);
+
+		if (type_size > 0) {
+			if (name.compare(0, 8, "_padding") != 0) {
+				Column column{};
+				column.name = prefix + name;
+				column.type = type;
+				column.offset = offset;
+				column.type_size = type_size;
+				column.array_size = array_size;
+				topic.columns.push_back(std::move(column));
+			}
+
+			offset += type_size * array_size;
+
+		} else {
+			// nested type, flattened per array element
+			for (int i = 0; i < array_size; i++) {
+				const std::string nested_prefix = prefix + name + (bracket != std::string::npos ? "[" + std::to_string(i) + "]" : "") + ".";
+				const size_t nested_size = addColumns(topic, type, nested_prefix, offset, depth + 1);
+
+				if (nested_size == 0) {
+					return 0;
+				}
+
+				offset += nested_size;
+			}
+		}
+	}
+
+	return offset - start_offset;
+}
+
+void
+ReplayExport::addRow(Topic &topic, uint8_t msg_type, const uint8_t *payload, size_t payload_size)
+{
+	if (topic.message_size == 0) {
+		return;
+	}
+
+	if (msg_type == (int)ULogMessageType::DATA) {
+		// the format size includes trailing padding fields, which are not logged
+		if (payload_size > topic.message_size) {
+			topic.errors++;
+			return;
+		}
+
+		memcpy(topic.message.data(), payload, payload_size);
+		topic.logged_size = payload_size;
+		topic.message_valid = true;
+
+	} else if (!topic.message_valid
+		   || !ulog_delta_decode(payload, payload_size, topic.message.data(), topic.logged_size)) {
+		// delta encoded against the previous message of this topic
+		topic.message_valid = false;
+		topic.errors++;
+		return;
+	}
+
+	for (Column &column : topic.columns) {
+		const size_t column_size = column.type_size * column.array_size;
+
+		if (column.offset + column_size <= topic.message_size) {
+			column.data.insert(column.data.end(), &topic.message[column.offset], &topic.message[column.offset] + column_size);
+		}
+	}
+
+	topic.rows++;
+}
+
+bool
+ReplayExport::write(const std::string &output_dir) const
+{
+	if (mkdir(output_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+		PX4_ERR("Failed to create %s (%i)", output_dir.c_str(), errno);
+		return false;
+	}
+
+	const std::string schema_file = output_dir + "/schema.csv";
+	FILE *schema = fopen(schema_file.c_str(), "w");
+
+	if (!schema) {
+		PX4_ERR("Failed to open %s (%i)", schema_file.c_str(), errno);
+		return false;
+	}
+
+	fprintf(schema, "file,column,type,array_size,rows,offset\n");
+
+	std::vector<const Topic *> topics;
+
+	for (const Topic &topic : _removed_topics) {
+		topics.push_back(&topic);
+	}
+
+	for (const auto &topic : _topics) {
+		topics.push_back(&topic.second);
+	}
+
+	std::map<std::string, int> file_names;
+	bool ret = true;
+
+	for (const Topic *topic : topics) {
+		if (topic->rows == 0) {
+			continue;
+		}
+
+		// a topic instance that was removed and added again gets a new file
+		std::string file_name = topic->name + "." + std::to_string(topic->multi_id);
+		const int count = file_names[file_name]++;
+
+		if (count > 0) {
+			file_name += "_" + std::to_string(count);
+		}
+
+		file_name += ".col";
+
+		const std::string path = output_dir + "/" + file_name;
+		FILE *fp = fopen(path.c_str(), "wb");
+
+		if (!fp) {
+			PX4_ERR("Failed to open %s (%i)", path.c_str(), errno);
+			ret = false;
+			break;
+		}
+
+		static constexpr uint8_t padding[8] {};
+		size_t offset = 0;
+
+		for (const Column &column : topic->columns) {
+			// align each column for direct memory mapping
+			const size_t padding_size = (8 - offset % 8) % 8;
+
+			if (fwrite(padding, 1, padding_size, fp) != padding_size
+			    || fwrite(column.data.data(), 1, column.data.size(), fp) != column.data.size()) {
+				PX4_ERR("Failed to write %s", path.c_str());
+				ret = false;
+				break;
+			}
+
+			offset += padding_size;
+			fprintf(schema, "%s,%s,%s,%i,%zu,%zu\n", file_name.c_str(), column.name.c_str(), column.type.c_str(),
+				column.array_size, column.data.size() / (column.type_size * column.array_size), offset);
+			offset += column.data.size();
+		}
+
+		fclose(fp);
+
+		if (topic->errors > 0) {
+			PX4_WARN("%s: %zu messages skipped", file_name.c_str(), topic->errors);
+		}
+
+		if (!ret) {
+			break;
+		}
+	}
+
+	fclose(schema);
+	return ret;
+}
+
+size_t
+ReplayExport::sizeOfBasicType(const std::string &type_name)
+{
+	if (type_name == "int8_t" || type_name == "uint8_t" || type_name == "char" || type_name == "bool") {
+		return 1;
+
+	} else if (type_name == "int16_t" || type_name == "uint16_t") {
+		return 2;
+
+	} else if (type_name == "int32_t" || type_name == "uint32_t" || type_name == "float") {
+		return 4;
+
+	} else if (type_name == "int64_t" || type_name == "uint64_t" || type_name == "double") {
+		return 8;
+	}
+
+	return 0;
+}
+
+} //namespace px4
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace px4
+{
+
+class ReplayFile;
+
+/**
+ * @class ReplayExport
+ * Converts an ULog file into a columnar format for analysis.
+ *
+ * Every logged topic instance is written to `<topic>.<multi_id>.col`, which contains one contiguous,
+ * little endian array per field (arrays of a basic type are stored row by row as fixed-size lists).
+ * Nested types are flattened into their fields (`<field>.<nested field>`). The columns are 8 byte
+ * aligned. `schema.csv` lists the file, name, type, array size, number of rows and byte offset of
+ * every column, so a column can be memory-mapped directly (e.g. numpy.memmap).
+ *
+ * The export only depends on the formats in the log, not on the topics known to this build.
+ */
+class ReplayExport
+{
+public:
+	/**
+	 * Run the export (blocking)
+	 * @param argc, argv: arguments after 'export'
+	 * @return 0 on success
+	 */
+	static int run(int argc, char *argv[]);
+
+private:
+	struct Column {
+		std::string name;
+		std::string type; ///< basic ULog type, e.g. float
+		size_t offset; ///< offset in the message
+		size_t type_size;
+		int array_size;
+		std::vector<uint8_t> data;
+	};
+
+	struct Topic {
+		std::string name;
+		uint8_t multi_id{0};
+		size_t message_size{0}; ///< size of the format (0: unknown format, ignored)
+		size_t logged_size{0}; ///< size of the logged messages without msg_id, without trailing padding
+		std::vector<Column> columns;
+		std::vector<uint8_t> message; ///< last decoded message, base for delta encoded messages
+		bool message_valid{false};
+		size_t rows{0};
+		size_t errors{0};
+	};
+
+	ReplayExport() = default;
+
+	bool readHeader(ReplayFile &file);
+	bool readDefinitions(ReplayFile &file);
+	bool readData(ReplayFile &file);
+
+	void addTopic(const uint8_t *payload, size_t payload_size);
+	void addRow(Topic &topic, uint8_t msg_type, const uint8_t *payload, size_t payload_size);
+
+	/**
+	 * Add the columns of a format, recursively for nested types
+	 * @return size of the format in bytes, 0 if a type is unknown
+	 */
+	size_t addColumns(Topic &topic, const std::string &format_name, const std::string &prefix, size_t offset, int depth);
+
+	bool write(const std::string &output_dir) const;
+
+	static size_t sizeOfBasicType(const std::string &type_name);
+
+	std::map<std::string, std::string> _formats; ///< fields per format name
+	std::map<uint16_t, Topic> _topics; ///< per msg_id, while the subscription is active
+	std::vector<Topic> _removed_topics; ///< topics of msg_ids that were removed or reused
+	int64_t _data_start{0};
+	int64_t _data_end{INT64_MAX}; ///< read limit if the log contains appended data
+};
+
+} //namespace px4
@@ -0,0 +1,111 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ReplayFast.hpp"
+
+#include <drivers/drv_hrt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+#include <px4_platform_common/time.h>
+
+#include <time.h>
+
+namespace px4
+{
+
+uint64_t
+ReplayFast::handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset)
+{
+	const uint64_t publish_timestamp = next_file_time + timestamp_offset;
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+	// advance the time instead of sleeping, then let the timer driven work run
+	if (publish_timestamp > hrt_absolute_time()) {
+		struct timespec ts;
+		abstime_to_ts(&ts, publish_timestamp);
+		px4_clock_settime(CLOCK_MONOTONIC, &ts);
+		waitForIdle();
+	}
+
+#endif // ENABLE_LOCKSTEP_SCHEDULER
+
+	return publish_timestamp;
+}
+
+bool
+ReplayFast::handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file)
+{
+	const bool published = publishTopic(sub, data);
+
+	if (published) {
+		waitForIdle();
+	}
+
+	return published;
+}
+
+void
+ReplayFast::waitForIdle()
+{
+	// wait in real time: with lockstep, hrt_absolute_time() and px4_usleep() follow the replayed time
+	struct timespec start;
+	system_clock_gettime(CLOCK_MONOTONIC, &start);
+
+	while (!WorkQueueManagerIdle()) {
+		system_usleep(10);
+
+		struct timespec now;
+		system_clock_gettime(CLOCK_MONOTONIC, &now);
+		const int64_t elapsed_us = (now.tv_sec - start.tv_sec) * 1000000LL + (now.tv_nsec - start.tv_nsec) / 1000;
+
+		if (elapsed_us > IDLE_TIMEOUT_US) {
+			// a work item that keeps rescheduling itself, continue anyway
+			if (_idle_timeouts++ == 0) {
+				PX4_WARN("work queues not idle after %.1f s", (double)IDLE_TIMEOUT_US / 1e6);
+			}
+
+			break;
+		}
+	}
+}
+
+void
+ReplayFast::onExitMainLoop()
+{
+	if (_idle_timeouts > 0) {
+		PX4_WARN("work queues were not idle %u times, the replay may not be deterministic", _idle_timeouts);
+	}
+}
+
+} //namespace px4
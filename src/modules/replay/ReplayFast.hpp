@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "Replay.hpp"
+
+namespace px4
+{
+
+/**
+ * @class ReplayFast
+ * Replays as fast as possible, for any chain of modules running on work queues. After each publication
+ * it waits until all work queues are idle, so every module has processed the data (and published its
+ * own results, which are processed as well) before the next message is published.
+ * With the lockstep scheduler the system time follows the log time, so timers and timeouts behave as
+ * during the flight and the replay is deterministic.
+ */
+class ReplayFast : public Replay
+{
+public:
+protected:
+
+	uint64_t handleTopicDelay(uint64_t next_file_time, uint64_t timestamp_offset) override;
+
+	bool handleTopicUpdate(Subscription &sub, void *data, ReplayFile &replay_file) override;
+
+	void onExitMainLoop() override;
+
+private:
+	static constexpr int64_t IDLE_TIMEOUT_US = 1000 * 1000; ///< [us, real time] max wait for the work queues
+
+	/**
+	 * wait (in real time) until all work queues are idle
+	 */
+	void waitForIdle();
+
+	uint32_t _idle_timeouts{0};
+};
+
+} //namespace px4
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "ReplayFile.hpp"
+
+#include <px4_platform_common/log.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace px4
+{
+
+bool
+ReplayFile::open(const char *file_name)
+{
+	close();
+
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0) {
+		PX4_ERR("open %s failed (%i)", file_name, errno);
+		return false;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		PX4_ERR("%s is empty", file_name);
+		::close(fd);
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping stays valid after closing the descriptor
+	::close(fd);
+
+	if (data == MAP_FAILED) {
+		PX4_ERR("mmap %s failed (%i)", file_name, errno);
+		return false;
+	}
+
+	_data = static_cast<const uint8_t *>(data);
+	_size = st.st_size;
+	_pos = 0;
+	clear();
+	return true;
+}
+
+void
+ReplayFile::close()
+{
+	if (_data) {
+		munmap(const_cast<uint8_t *>(_data), _size);
+		_data = nullptr;
+	}
+
+	_size = 0;
+	_pos = 0;
+}
+
+ReplayFile &
+ReplayFile::read(char *dst, std::streamsize count)
+{
+	if (_fail || count < 0) {
+		_fail = true;
+		return *this;
+	}
+
+	size_t n = count;
+
+	if (n > _size - _pos) {
+		n = _size - _pos;
+		_eof = true;
+		_fail = true;
+	}
+
+	memcpy(dst, _data + _pos, n);
+	_pos += n;
+	return *this;
+}
+
+ReplayFile &
+ReplayFile::seekg(std::streampos pos)
+{
+	_eof = false;
+
+	if (_fail) {
+		return *this;
+	}
+
+	const std::streamoff off = pos;
+
+	if (off < 0 || (size_t)off > _size) {
+		_fail = true;
+
+	} else {
+		_pos = off;
+	}
+
+	return *this;
+}
+
+ReplayFile &
+ReplayFile::seekg(std::streamoff off, std::ios_base::seekdir dir)
+{
+	const std::streamoff base = (dir == std::ios_base::cur) ? (std::streamoff)_pos :
+				    (dir == std::ios_base::end) ? (std::streamoff)_size : 0;
+	return seekg(std::streampos(base + off));
+}
+
+} //namespace px4
@@ -0,0 +1,109 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <ios>
+
+namespace px4
+{
+
+/**
+ * @class ReplayFile
+ * Read-only, memory-mapped ULog file. It provides the subset of the std::istream interface
+ * the replay parser uses (read, seekg, tellg and the state flags), but reads and seeks are plain
+ * memory accesses instead of buffered I/O calls. It also gives direct access to the mapped data,
+ * which is used to build the message index in a single pass over the file.
+ */
+class ReplayFile
+{
+public:
+	ReplayFile() = default;
+	explicit ReplayFile(const char *file_name) { open(file_name); }
+	~ReplayFile() { close(); }
+
+	ReplayFile(const ReplayFile &) = delete;
+	ReplayFile &operator=(const ReplayFile &) = delete;
+
+	/**
+	 * Map a file
+	 * @return true on success
+	 */
+	bool open(const char *file_name);
+
+	void close();
+
+	bool is_open() const { return _data != nullptr; }
+
+	/**
+	 * Copy count bytes from the current position and advance it.
+	 * Reading past the end copies the remaining bytes and sets eof and fail.
+	 */
+	ReplayFile &read(char *dst, std::streamsize count);
+
+	/** Set the absolute position. Clears eof, does nothing if fail is set. */
+	ReplayFile &seekg(std::streampos pos);
+
+	/** Set the position relative to the beginning or the current position. */
+	ReplayFile &seekg(std::streamoff off, std::ios_base::seekdir dir);
+
+	/** @return current position, or -1 if fail is set */
+	std::streampos tellg() const { return _fail ? std::streampos(-1) : std::streampos(_pos); }
+
+	bool good() const { return !_fail && !_eof; }
+	bool eof() const { return _eof; }
+	explicit operator bool() const { return !_fail; }
+
+	void clear() { _fail = false; _eof = false; }
+
+	void setstate(std::ios_base::iostate state)
+	{
+		_eof = _eof || (state & std::ios_base::eofbit);
+		_fail = _fail || (state & (std::ios_base::failbit | std::ios_base::badbit));
+	}
+
+	const uint8_t *data() const { return _data; }
+	size_t size() const { return _size; }
+
+private:
+	const uint8_t *_data{nullptr};
+	size_t _size{0};
+	size_t _pos{0};
+
+	bool _eof{false};
+	bool _fail{false};
+};
+
+} //namespace px4
@@ -40,6 +40,8 @@ namespace replay
 
 static const char __attribute__((unused)) *ENV_FILENAME = "replay"; ///< name for getenv()
 static const char __attribute__((unused)) *ENV_MODE = "replay_mode";  ///< name for getenv()
+static const char __attribute__((unused)) *ENV_SEEK = "replay_seek";  ///< name for getenv(), start time in seconds since log start
+static const char __attribute__((unused)) *ENV_STATS = "replay_stats";  ///< name for getenv(), ekf2 statistics output file
 
 
 } //namespace replay
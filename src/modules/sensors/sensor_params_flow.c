@@ -96,4 +96,20 @@ PARAM_DEFINE_FLOAT(SENS_FLOW_MAXHGT, 3.0f);
  * @decimal 2
  * @group Sensor Calibration
  */
-PARAM_DEFINE_FLOAT(SENS_FLOW_MAXR, 2.5f);
\ No newline at end of file
+PARAM_DEFINE_FLOAT(SENS_FLOW_MAXR, 2.5f);
+
+/**
+ * Optical flow publication rate
+ *
+ * Rate at which the SPI optical flow drivers (PMW3901, PAW3902) publish the flow,
+ * integrated over all motion bursts read from the sensor since the last publication.
+ * A lower rate gives the estimator fewer samples with a longer integration time.
+ *
+ * @unit Hz
+ * @min 10
+ * @max 100
+ * @decimal 0
+ * @reboot_required true
+ * @group Sensors
+ */
+PARAM_DEFINE_FLOAT(SENS_FLOW_RATE, 70.0f);
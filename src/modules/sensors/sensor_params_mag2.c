@@ -174,3 +174,135 @@ PARAM_DEFINE_FLOAT(CAL_MAG2_YCOMP, 0.0f);
 * @group Sensor Calibration
 */
 PARAM_DEFINE_FLOAT(CAL_MAG2_ZCOMP, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_XCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_YCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_ZCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_XCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_YCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_ZCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_XCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_YCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_ZCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_XCOMP4, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_YCOMP4, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG2_ZCOMP4, 0.0f);
@@ -174,3 +174,135 @@ PARAM_DEFINE_FLOAT(CAL_MAG3_YCOMP, 0.0f);
 * @group Sensor Calibration
 */
 PARAM_DEFINE_FLOAT(CAL_MAG3_ZCOMP, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_XCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_YCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 1 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_ZCOMP1, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_XCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_YCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 2 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_ZCOMP2, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_XCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_YCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 3 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_ZCOMP3, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* X component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_XCOMP4, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Y component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_YCOMP4, 0.0f);
+
+/**
+* Coefficient describing linear relationship between
+* Z component of magnetometer in body frame axis
+* and the current of motor 4 (esc_status), used if CAL_MAG_COMP_TYP is 4
+*
+* @unit G/kA
+* @category system
+* @group Sensor Calibration
+*/
+PARAM_DEFINE_FLOAT(CAL_MAG3_ZCOMP4, 0.0f);
@@ -61,22 +61,22 @@
 #include <uORB/PublicationMulti.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
-#include <uORB/topics/actuator_controls.h>
 #include <uORB/topics/airspeed.h>
 #include <uORB/topics/differential_pressure.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/sensor_preflight.h>
 #include <uORB/topics/vehicle_air_data.h>
 #include <uORB/topics/vehicle_control_mode.h>
-#include <uORB/topics/vehicle_magnetometer.h>
-#include <uORB/topics/battery_status.h>
 
 #include "parameters.h"
 #include "voted_sensors_update.h"
 #include "vehicle_acceleration/VehicleAcceleration.hpp"
 #include "vehicle_angular_velocity/VehicleAngularVelocity.hpp"
 #include "vehicle_air_data/VehicleAirData.hpp"
+#include "vehicle_gps_position/VehicleGPSPosition.hpp"
 #include "vehicle_imu/VehicleIMU.hpp"
+#include "vehicle_magnetometer/VehicleMagnetometer.hpp"
+#include "vehicle_obstacle_distance/VehicleObstacleDistance.hpp"
 
 using namespace sensors;
 using namespace time_literals;
@@ -115,22 +115,18 @@ private:
 
 	hrt_abstime     _last_config_update{0};
 	hrt_abstime     _sensor_combined_prev_timestamp{0};
-	hrt_abstime     _magnetometer_prev_timestamp{0};
 
 	sensor_combined_s _sensor_combined{};
 	sensor_preflight_s _sensor_preflight{};
 
-	uORB::Subscription	_actuator_ctrl_0_sub{ORB_ID(actuator_controls_0)};		/**< attitude controls sub */
 	uORB::Subscription	_diff_pres_sub{ORB_ID(differential_pressure)};			/**< raw differential pressure subscription */
 	uORB::Subscription	_parameter_update_sub{ORB_ID(parameter_update)};				/**< notification of parameter updates */
 	uORB::Subscription	_vcontrol_mode_sub{ORB_ID(vehicle_control_mode)};		/**< vehicle control mode subscription */
 	uORB::Subscription	_vehicle_air_data_sub{ORB_ID(vehicle_air_data)};
-	uORB::Subscription	_battery_status_sub{ORB_ID(battery_status), 0};		/**< battery_status instance 0 subscription */
 
 	uORB::Publication<airspeed_s>			_airspeed_pub{ORB_ID(airspeed)};			/**< airspeed */
 	uORB::Publication<sensor_combined_s>		_sensor_pub{ORB_ID(sensor_combined)};			/**< combined sensor data topic */
 	uORB::Publication<sensor_preflight_s>		_sensor_preflight_pub{ORB_ID(sensor_preflight)};		/**< sensor preflight topic */
-	uORB::Publication<vehicle_magnetometer_s>	_magnetometer_pub{ORB_ID(vehicle_magnetometer)};	/**< combined sensor data topic */
 
 	uORB::SubscriptionCallbackWorkItem _sensor_gyro_integrated_sub[GYRO_COUNT_MAX] {
 		{this, ORB_ID(sensor_gyro_integrated), 0},
@@ -138,15 +134,6 @@ private:
 		{this, ORB_ID(sensor_gyro_integrated), 2}
 	};
 
-	enum class MagCompensationType {
-		Disabled = 0,
-		Throttle,
-		Current_inst0,
-		Current_inst1
-	};
-
-	MagCompensationType _mag_comp_type{MagCompensationType::Disabled};
-
 	uint32_t _selected_sensor_device_id{0};
 	uint8_t _selected_sensor_sub_index{0};
 
@@ -171,6 +158,9 @@ private:
 	VehicleAcceleration	_vehicle_acceleration;
 	VehicleAngularVelocity	_vehicle_angular_velocity;
 	VehicleAirData          _vehicle_air_data;
+	VehicleGPSPosition      _vehicle_gps_position;
+	VehicleMagnetometer     _vehicle_magnetometer;
+	VehicleObstacleDistance _vehicle_obstacle_distance;
 
 	static constexpr int MAX_SENSOR_COUNT = 3;
 	VehicleIMU      *_vehicle_imu_list[MAX_SENSOR_COUNT] {};
@@ -221,6 +211,9 @@ Sensors::Sensors(bool hil_enabled) :
 	_vehicle_acceleration.Start();
 	_vehicle_angular_velocity.Start();
 	_vehicle_air_data.Start();
+	_vehicle_gps_position.Start();
+	_vehicle_magnetometer.Start();
+	_vehicle_obstacle_distance.Start();
 
 	InitializeVehicleIMU();
 }
@@ -230,6 +223,9 @@ Sensors::~Sensors()
 	_vehicle_acceleration.Stop();
 	_vehicle_angular_velocity.Stop();
 	_vehicle_air_data.Stop();
+	_vehicle_gps_position.Stop();
+	_vehicle_magnetometer.Stop();
+	_vehicle_obstacle_distance.Stop();
 
 	for (auto &i : _vehicle_imu_list) {
 		if (i != nullptr) {
@@ -474,42 +470,10 @@ void Sensors::Run()
 
 		if (_vcontrol_mode_sub.copy(&vcontrol_mode)) {
 			_armed = vcontrol_mode.flag_armed;
-			_voted_sensors_update.update_mag_comp_armed(_armed);
-		}
-
-		//check mag power compensation type (change battery current subscription instance if necessary)
-		if ((MagCompensationType)_parameters.mag_comp_type == MagCompensationType::Current_inst0
-		    && _mag_comp_type != MagCompensationType::Current_inst0) {
-			_battery_status_sub = uORB::Subscription{ORB_ID(battery_status), 0};
-		}
-
-		if ((MagCompensationType)_parameters.mag_comp_type == MagCompensationType::Current_inst1
-		    && _mag_comp_type != MagCompensationType::Current_inst1) {
-			_battery_status_sub = uORB::Subscription{ORB_ID(battery_status), 1};
-		}
-
-		_mag_comp_type = (MagCompensationType)_parameters.mag_comp_type;
-
-		//update power signal for mag compensation
-		if (_mag_comp_type == MagCompensationType::Throttle) {
-			actuator_controls_s controls {};
-
-			if (_actuator_ctrl_0_sub.update(&controls)) {
-				_voted_sensors_update.update_mag_comp_power(controls.control[actuator_controls_s::INDEX_THROTTLE]);
-			}
-
-		} else if (_mag_comp_type == MagCompensationType::Current_inst0
-			   || _mag_comp_type == MagCompensationType::Current_inst1) {
-			battery_status_s bat_stat {};
-
-			if (_battery_status_sub.update(&bat_stat)) {
-				_voted_sensors_update.update_mag_comp_power(bat_stat.current_a * 0.001f); //current in [kA]
-			}
 		}
 	}
 
-	vehicle_magnetometer_s magnetometer{};
-	_voted_sensors_update.sensorsPoll(_sensor_combined, magnetometer);
+	_voted_sensors_update.sensorsPoll(_sensor_combined);
 
 	// check analog airspeed
 	adc_poll();
@@ -542,15 +506,6 @@ void Sensors::Run()
 		}
 	}
 
-	if ((magnetometer.timestamp != 0) && (magnetometer.timestamp != _magnetometer_prev_timestamp)) {
-		_magnetometer_pub.publish(magnetometer);
-		_magnetometer_prev_timestamp = magnetometer.timestamp;
-
-		if (!_armed) {
-			_voted_sensors_update.calcMagInconsistency(_sensor_preflight);
-		}
-	}
-
 	if (_sensor_combined.timestamp != _sensor_combined_prev_timestamp) {
 
 		_voted_sensors_update.setRelativeTimestamps(_sensor_combined);
@@ -562,6 +517,7 @@ void Sensors::Run()
 		if (!_armed) {
 			_voted_sensors_update.calcAccelInconsistency(_sensor_preflight);
 			_voted_sensors_update.calcGyroInconsistency(_sensor_preflight);
+			_sensor_preflight.mag_inconsistency_angle = _vehicle_magnetometer.MagInconsistencyAngle();
 
 			_sensor_preflight.timestamp = hrt_absolute_time();
 			_sensor_preflight_pub.publish(_sensor_preflight);
@@ -652,6 +608,15 @@ int Sensors::print_status()
 	PX4_INFO_RAW("\n");
 	_vehicle_air_data.PrintStatus();
 
+	PX4_INFO_RAW("\n");
+	_vehicle_gps_position.PrintStatus();
+
+	PX4_INFO_RAW("\n");
+	_vehicle_magnetometer.PrintStatus();
+
+	PX4_INFO_RAW("\n");
+	_vehicle_obstacle_distance.PrintStatus();
+
 	PX4_INFO_RAW("\n");
 
 	for (auto &i : _vehicle_imu_list) {
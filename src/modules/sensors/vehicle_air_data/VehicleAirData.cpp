@@ -126,10 +126,82 @@ void VehicleAirData::ParametersUpdate()
 	}
 }
 
+void VehicleAirData::FilterUpdate(int instance, float pressure, const hrt_abstime &timestamp)
+{
+	// reject single sample outliers first, then low-pass the median output
+	const float pressure_median = _median_filter[instance].apply(pressure);
+
+	const float dt = (timestamp - _filter_timestamp[instance]) * 1e-6f;
+	const float cutoff_freq = _param_sens_baro_cutoff.get();
+
+	if ((_filter_timestamp[instance] == 0) || (timestamp <= _filter_timestamp[instance]) || (dt > 1.f)
+	    || (cutoff_freq <= 0.f) || !PX4_ISFINITE(_pressure_filtered[instance])) {
+
+		// (re)initialize or no low-pass filtering
+		_pressure_filtered[instance] = pressure_median;
+
+	} else {
+		// first order IIR, coefficient computed from the actual sample interval
+		const float tau = 1.f / (2.f * M_PI_F * cutoff_freq);
+		const float alpha = dt / (dt + tau);
+
+		_pressure_filtered[instance] += alpha * (pressure_median - _pressure_filtered[instance]);
+	}
+
+	_filter_timestamp[instance] = timestamp;
+}
+
+void VehicleAirData::PublishAirData(const sensor_baro_s &baro, float pressure_pa)
+{
+	// populate vehicle_air_data with primary baro and publish
+	vehicle_air_data_s out{};
+	out.timestamp_sample = baro.timestamp; // TODO: baro.timestamp_sample;
+	out.baro_device_id = baro.device_id;
+	out.baro_temp_celcius = baro.temperature;
+
+	// corrected (offset and scale) and filtered pressure in Pa
+	out.baro_pressure_pa = pressure_pa;
+
+	// calculate altitude using the hypsometric equation
+	static constexpr float T1 = 15.0f - CONSTANTS_ABSOLUTE_NULL_CELSIUS; // temperature at base height in Kelvin
+	static constexpr float a = -6.5f / 1000.0f; // temperature gradient in degrees per metre
+
+	// current pressure at MSL in kPa (QNH in hPa)
+	const float p1 = _param_sens_baro_qnh.get() * 0.1f;
+
+	// measured pressure in kPa
+	const float p = out.baro_pressure_pa * 0.001f;
+
+	/*
+	 * Solve:
+	 *
+	 *     /        -(aR / g)     \
+	 *    | (p / p1)          . T1 | - T1
+	 *     \                      /
+	 * h = -------------------------------  + h1
+	 *                   a
+	 */
+	out.baro_alt_meter = (((powf((p / p1), (-(a * CONSTANTS_AIR_GAS_CONST) / CONSTANTS_ONE_G))) * T1) - T1) / a;
+
+	// calculate air density
+	// estimate air density assuming typical 20degC ambient temperature
+	// TODO: use air temperature if available (differential pressure sensors)
+	static constexpr float pressure_to_density = 1.0f / (CONSTANTS_AIR_GAS_CONST * (20.0f -
+			CONSTANTS_ABSOLUTE_NULL_CELSIUS));
+
+	out.rho = pressure_to_density * out.baro_pressure_pa;
+
+	out.timestamp = hrt_absolute_time();
+	_vehicle_air_data_pub.publish(out);
+}
+
 void VehicleAirData::Run()
 {
 	perf_begin(_cycle_perf);
 
+	ParametersUpdate();
+	SensorCorrectionsUpdate();
+
 	bool updated[MAX_SENSOR_COUNT] {};
 
 	for (int uorb_index = 0; uorb_index < MAX_SENSOR_COUNT; uorb_index++) {
@@ -147,6 +219,9 @@ void VehicleAirData::Run()
 
 					_advertised[uorb_index] = true;
 
+					// every sample of every instance is filtered, not only the selected one
+					_sensor_sub[uorb_index].registerCallback();
+
 				} else {
 					_last_data[uorb_index].timestamp = hrt_absolute_time();
 				}
@@ -170,6 +245,8 @@ void VehicleAirData::Run()
 				float vect[3] {pressure_corrected, _last_data[uorb_index].temperature, 0.f};
 				_voter.put(uorb_index, _last_data[uorb_index].timestamp, vect, _last_data[uorb_index].error_count,
 					   _priority[uorb_index]);
+
+				FilterUpdate(uorb_index, pressure_corrected, _last_data[uorb_index].timestamp);
 			}
 		}
 	}
@@ -179,64 +256,25 @@ void VehicleAirData::Run()
 	_voter.get_best(hrt_absolute_time(), &best_index);
 
 	if (best_index >= 0) {
-		if (_selected_sensor_sub_index != best_index) {
-			// clear all registered callbacks
-			for (auto &sub : _sensor_sub) {
-				sub.unregisterCallback();
-			}
-
-			_selected_sensor_sub_index = best_index;
-			_sensor_sub[_selected_sensor_sub_index].registerCallback();
-		}
+		_selected_sensor_sub_index = best_index;
 	}
 
 	if ((_selected_sensor_sub_index >= 0) && updated[_selected_sensor_sub_index]) {
-		ParametersUpdate();
-		SensorCorrectionsUpdate();
-
 		const sensor_baro_s &baro = _last_data[_selected_sensor_sub_index];
 
-		// populate vehicle_air_data with primary baro and publish
-		vehicle_air_data_s out{};
-		out.timestamp_sample = baro.timestamp; // TODO: baro.timestamp_sample;
-		out.baro_device_id = baro.device_id;
-		out.baro_temp_celcius = baro.temperature;
-
-		// Convert from millibar to Pa and apply temperature compensation
-		out.baro_pressure_pa = (100.0f * baro.pressure - _offset[_selected_sensor_sub_index]) *
-				       _scale[_selected_sensor_sub_index];
-
-		// calculate altitude using the hypsometric equation
-		static constexpr float T1 = 15.0f - CONSTANTS_ABSOLUTE_NULL_CELSIUS; // temperature at base height in Kelvin
-		static constexpr float a = -6.5f / 1000.0f; // temperature gradient in degrees per metre
-
-		// current pressure at MSL in kPa (QNH in hPa)
-		const float p1 = _param_sens_baro_qnh.get() * 0.1f;
-
-		// measured pressure in kPa
-		const float p = out.baro_pressure_pa * 0.001f;
-
-		/*
-		 * Solve:
-		 *
-		 *     /        -(aR / g)     \
-		 *    | (p / p1)          . T1 | - T1
-		 *     \                      /
-		 * h = -------------------------------  + h1
-		 *                   a
-		 */
-		out.baro_alt_meter = (((powf((p / p1), (-(a * CONSTANTS_AIR_GAS_CONST) / CONSTANTS_ONE_G))) * T1) - T1) / a;
-
-		// calculate air density
-		// estimate air density assuming typical 20degC ambient temperature
-		// TODO: use air temperature if available (differential pressure sensors)
-		static constexpr float pressure_to_density = 1.0f / (CONSTANTS_AIR_GAS_CONST * (20.0f -
-				CONSTANTS_ABSOLUTE_NULL_CELSIUS));
-
-		out.rho = pressure_to_density * out.baro_pressure_pa;
-
-		out.timestamp = hrt_absolute_time();
-		_vehicle_air_data_pub.publish(out);
+		// decimate output to SENS_BARO_RATE, publish immediately after a sensor switch
+		const float rate = math::constrain(_param_sens_baro_rate.get(), 1.f, 200.f);
+		const hrt_abstime interval_us = 1e6f / rate;
+
+		const bool publish = (baro.device_id != _last_publication_device_id)
+				     || (baro.timestamp >= _last_publication_timestamp + interval_us)
+				     || (baro.timestamp < _last_publication_timestamp);
+
+		if (publish) {
+			PublishAirData(baro, _pressure_filtered[_selected_sensor_sub_index]);
+			_last_publication_timestamp = baro.timestamp;
+			_last_publication_device_id = baro.device_id;
+		}
 	}
 
 	// check failover and report
@@ -278,6 +316,9 @@ void VehicleAirData::PrintStatus()
 		PX4_INFO("selected barometer: %d (%d)", _last_data[_selected_sensor_sub_index].device_id, _selected_sensor_sub_index);
 	}
 
+	PX4_INFO("median window: %d, low-pass cutoff: %.1f Hz, output rate: %.1f Hz", MEDIAN_WINDOW,
+		 (double)_param_sens_baro_cutoff.get(), (double)_param_sens_baro_rate.get());
+
 	perf_print_counter(_cycle_perf);
 	_voter.print();
 }
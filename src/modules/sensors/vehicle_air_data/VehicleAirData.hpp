@@ -35,6 +35,7 @@
 
 #include <lib/ecl/validation/data_validator_group.h>
 #include <lib/mathlib/math/Limits.hpp>
+#include <lib/mathlib/math/filter/MedianFilter.hpp>
 #include <lib/matrix/matrix/math.hpp>
 #include <lib/perf/perf_counter.h>
 #include <lib/systemlib/mavlink_log.h>
@@ -68,10 +69,18 @@ private:
 	void ParametersUpdate();
 	void SensorCorrectionsUpdate();
 
+	void FilterUpdate(int instance, float pressure, const hrt_abstime &timestamp);
+	void PublishAirData(const sensor_baro_s &baro, float pressure_pa);
+
 	static constexpr int MAX_SENSOR_COUNT = 3;
 
+	// median window applied to every raw sample before the low-pass filter
+	static constexpr int MEDIAN_WINDOW = 5;
+
 	DEFINE_PARAMETERS(
-		(ParamFloat<px4::params::SENS_BARO_QNH>) _param_sens_baro_qnh
+		(ParamFloat<px4::params::SENS_BARO_QNH>) _param_sens_baro_qnh,
+		(ParamFloat<px4::params::SENS_BARO_RATE>) _param_sens_baro_rate,
+		(ParamFloat<px4::params::SENS_BARO_CUTOFF>) _param_sens_baro_cutoff
 	)
 
 	uORB::Publication<vehicle_air_data_s> _vehicle_air_data_pub{ORB_ID(vehicle_air_data)};
@@ -101,5 +110,12 @@ private:
 	int8_t _sensor_correction_index[MAX_SENSOR_COUNT] {-1, -1, -1};
 	uint8_t _priority[MAX_SENSOR_COUNT] {};
 
+	math::MedianFilter<float, MEDIAN_WINDOW> _median_filter[MAX_SENSOR_COUNT] {};
+	float _pressure_filtered[MAX_SENSOR_COUNT] {};
+	hrt_abstime _filter_timestamp[MAX_SENSOR_COUNT] {};
+
+	hrt_abstime _last_publication_timestamp{0};
+	uint32_t _last_publication_device_id{0};
+
 	int8_t _selected_sensor_sub_index{-1};
 };
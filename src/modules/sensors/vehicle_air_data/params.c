@@ -43,3 +43,34 @@
  *
  */
 PARAM_DEFINE_FLOAT(SENS_BARO_QNH, 1013.25f);
+
+/**
+ * Barometer output rate
+ *
+ * Every raw sample of every barometer is filtered (median of 5 followed by a
+ * first order low-pass), vehicle_air_data is then published at this reduced rate.
+ *
+ * @min 1
+ * @max 200
+ * @group Sensors
+ * @unit Hz
+ * @decimal 0
+ *
+ */
+PARAM_DEFINE_FLOAT(SENS_BARO_RATE, 20.0f);
+
+/**
+ * Barometer low-pass filter cutoff frequency
+ *
+ * Cutoff of the first order low-pass filter applied to the median filtered
+ * barometer pressure. Should be well below half of SENS_BARO_RATE.
+ * A value of 0 disables the low-pass filter (median filter only).
+ *
+ * @min 0
+ * @max 100
+ * @group Sensors
+ * @unit Hz
+ * @decimal 1
+ *
+ */
+PARAM_DEFINE_FLOAT(SENS_BARO_CUTOFF, 5.0f);
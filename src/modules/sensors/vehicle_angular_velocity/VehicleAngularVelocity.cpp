@@ -46,6 +46,9 @@ VehicleAngularVelocity::VehicleAngularVelocity() :
 	WorkItem(MODULE_NAME, px4::wq_configurations::rate_ctrl),
 	_corrections(this, SensorCorrections::SensorType::Gyroscope)
 {
+	// latency critical, run ahead of other work on the rate_ctrl queue
+	SetQueuePriority(200);
+
 	_lp_filter_velocity.set_cutoff_frequency(kInitialRateHz, _param_imu_gyro_cutoff.get());
 	_notch_filter_velocity.setParameters(kInitialRateHz, _param_imu_gyro_nf_freq.get(), _param_imu_gyro_nf_bw.get());
 
@@ -79,6 +82,10 @@ void VehicleAngularVelocity::Stop()
 		sub.unregisterCallback();
 	}
 
+	for (auto &sub : _sensor_fifo_sub) {
+		sub.unregisterCallback();
+	}
+
 	_sensor_selection_sub.unregisterCallback();
 
 	Deinit();
@@ -168,12 +175,19 @@ bool VehicleAngularVelocity::SensorSelectionUpdate(bool force)
 				sub.unregisterCallback();
 			}
 
+			for (auto &sub : _sensor_fifo_sub) {
+				sub.unregisterCallback();
+			}
+
 			for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
 				sensor_gyro_s report{};
 				_sensor_sub[i].copy(&report);
 
 				if ((report.device_id != 0) && (report.device_id == sensor_selection.gyro_device_id)) {
-					if (_sensor_sub[i].registerCallback()) {
+					// prefer the raw FIFO data if enabled and available, sensor_gyro otherwise
+					_fifo_available = _param_imu_gyro_fifo.get() && SelectFifo(report.device_id);
+
+					if (_fifo_available || _sensor_sub[i].registerCallback()) {
 						PX4_DEBUG("selected sensor changed %d -> %d", _selected_sensor_sub_index, i);
 
 						// record selected sensor (array index)
@@ -187,6 +201,7 @@ bool VehicleAngularVelocity::SensorSelectionUpdate(bool force)
 
 						// reset sample interval accumulator on sensor change
 						_timestamp_sample_last = 0;
+						_last_generation = 0;
 
 						return true;
 					}
@@ -202,6 +217,500 @@ bool VehicleAngularVelocity::SensorSelectionUpdate(bool force)
 	return false;
 }
 
+bool VehicleAngularVelocity::SelectFifo(uint32_t device_id)
+{
+	// the FIFO data is unrotated, the rotation is only published in sensor_gyro_status
+	bool rotation_found = false;
+
+	for (auto &status_sub : _sensor_status_sub) {
+		sensor_gyro_status_s status{};
+
+		if (status_sub.copy(&status) && (status.device_id == device_id)) {
+			_fifo_rotation = static_cast<enum Rotation>(status.rotation);
+			rotation_found = true;
+			break;
+		}
+	}
+
+	if (!rotation_found) {
+		return false;
+	}
+
+	for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+		sensor_gyro_fifo_s fifo{};
+
+		if (_sensor_fifo_sub[i].copy(&fifo) && (fifo.device_id == device_id) && _sensor_fifo_sub[i].registerCallback()) {
+			PX4_DEBUG("using sensor_gyro_fifo %d", i);
+			_selected_fifo_sub_index = i;
+
+			// force filter reset and offset update
+			_fifo_sample_rate = 0.f;
+			_fifo_offset_valid = false;
+			_fifo_last_timestamp_sample = 0;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void VehicleAngularVelocity::ResetFifoFilters(float sample_rate)
+{
+	PX4_DEBUG("resetting FIFO filters, sample rate: %.3f Hz -> %.3f Hz", (double)_fifo_sample_rate, (double)sample_rate);
+	_fifo_sample_rate = sample_rate;
+
+	for (int axis = 0; axis < 3; axis++) {
+		_lp_filter_velocity_fifo[axis].set_cutoff_frequency(_fifo_sample_rate, _param_imu_gyro_cutoff.get());
+		_lp_filter_velocity_fifo[axis].reset(_fifo_velocity_prev[axis]);
+
+		_notch_filter_velocity_fifo[axis].setParameters(_fifo_sample_rate, _param_imu_gyro_nf_freq.get(),
+				_param_imu_gyro_nf_bw.get());
+		_notch_filter_velocity_fifo[axis].reset(_fifo_velocity_prev[axis]);
+
+		_lp_filter_acceleration_fifo[axis].set_cutoff_frequency(_fifo_sample_rate, _param_imu_dgyro_cutoff.get());
+		_lp_filter_acceleration_fifo[axis].reset(0.f);
+	}
+
+	// reconfigured for the new sample rate with the next ESC or FFT update
+	DisableDynamicNotchEscRpm();
+	DisableDynamicNotchFFT();
+}
+
+void VehicleAngularVelocity::DisableDynamicNotchEscRpm()
+{
+	if (_dynamic_notch_esc_rpm_active > 0) {
+		for (auto &harmonic : _dynamic_notch_filter_esc_rpm) {
+			for (auto &esc : harmonic) {
+				for (auto &nf : esc) {
+					nf.setParameters(_fifo_sample_rate, 0.f, 0.f);
+				}
+			}
+		}
+
+		_dynamic_notch_esc_rpm_active = 0;
+	}
+}
+
+void VehicleAngularVelocity::UpdateDynamicNotchEscRpm(bool force)
+{
+	if (!_fifo_available || (_fifo_sample_rate <= 0.f) || !(_param_imu_gyro_dnf_en.get() & DynamicNotch::EscRpm)) {
+		DisableDynamicNotchEscRpm();
+		return;
+	}
+
+	esc_status_s esc_status;
+
+	if ((_esc_status_sub.updated() || force) && _esc_status_sub.copy(&esc_status)
+	    && (hrt_elapsed_time(&esc_status.timestamp) < DYNAMIC_NOTCH_FILTER_TIMEOUT)) {
+
+		const float bandwidth_hz = _param_imu_gyro_dnf_bw.get();
+		const float freq_min = math::max(_param_imu_gyro_dnf_min.get(), bandwidth_hz);
+		const float freq_max = 0.5f * _fifo_sample_rate - bandwidth_hz;
+		const int harmonics = math::constrain(_param_imu_gyro_dnf_hmc.get(), (int32_t)0, (int32_t)MAX_NUM_ESC_RPM_HARMONICS);
+
+		int active = 0;
+
+		for (int esc = 0; esc < MAX_NUM_ESC_RPM; esc++) {
+			const esc_report_s &esc_report = esc_status.esc[esc];
+
+			// only motors with recent RPM telemetry
+			const bool esc_valid = (esc < esc_status.esc_count) && (esc_report.esc_rpm != 0)
+					       && (hrt_elapsed_time(&esc_report.timestamp) < DYNAMIC_NOTCH_FILTER_TIMEOUT);
+
+			const float esc_hz = esc_valid ? fabsf((float)esc_report.esc_rpm) / 60.f : 0.f;
+
+			for (int harmonic = 0; harmonic < MAX_NUM_ESC_RPM_HARMONICS; harmonic++) {
+				const float frequency_hz = esc_hz * (harmonic + 1);
+				const bool enable = (harmonic < harmonics) && (frequency_hz > freq_min) && (frequency_hz < freq_max);
+
+				for (int axis = 0; axis < 3; axis++) {
+					auto &nf = _dynamic_notch_filter_esc_rpm[harmonic][esc][axis];
+
+					if (enable) {
+						const bool was_enabled = (nf.getNotchFreq() > 0.f);
+
+						// only update the coefficients if the frequency changed significantly
+						if (!was_enabled || (fabsf(nf.getNotchFreq() - frequency_hz) > 0.1f)
+						    || (fabsf(nf.getBandwidth() - bandwidth_hz) > 0.01f)) {
+
+							nf.setParameters(_fifo_sample_rate, frequency_hz, bandwidth_hz);
+
+							if (!was_enabled) {
+								nf.resetDF1(_fifo_velocity_prev[axis]);
+							}
+						}
+
+						active++;
+
+					} else if (nf.getNotchFreq() > 0.f) {
+						nf.setParameters(_fifo_sample_rate, 0.f, 0.f);
+					}
+				}
+			}
+		}
+
+		_dynamic_notch_esc_rpm_active = active;
+		_dynamic_notch_esc_rpm_last_update = esc_status.timestamp;
+
+	} else if (hrt_elapsed_time(&_dynamic_notch_esc_rpm_last_update) > DYNAMIC_NOTCH_FILTER_TIMEOUT) {
+		// RPM telemetry lost
+		DisableDynamicNotchEscRpm();
+	}
+}
+
+void VehicleAngularVelocity::DisableDynamicNotchFFT()
+{
+	if (_dynamic_notch_fft_active > 0) {
+		for (auto &peak : _dynamic_notch_filter_fft) {
+			for (auto &nf : peak) {
+				nf.setParameters(_fifo_sample_rate, 0.f, 0.f);
+			}
+		}
+
+		_dynamic_notch_fft_active = 0;
+	}
+}
+
+void VehicleAngularVelocity::UpdateDynamicNotchFFT(bool force)
+{
+	if (!_fifo_available || (_fifo_sample_rate <= 0.f) || !(_param_imu_gyro_dnf_en.get() & DynamicNotch::FFT)) {
+		DisableDynamicNotchFFT();
+		return;
+	}
+
+	sensor_gyro_fft_s sensor_gyro_fft;
+
+	if ((_sensor_gyro_fft_sub.updated() || force) && _sensor_gyro_fft_sub.copy(&sensor_gyro_fft)
+	    && (sensor_gyro_fft.device_id == _selected_sensor_device_id)
+	    && (hrt_elapsed_time(&sensor_gyro_fft.timestamp) < DYNAMIC_NOTCH_FILTER_TIMEOUT)) {
+
+		const float bandwidth_hz = _param_imu_gyro_dnf_bw.get();
+		const float freq_min = math::max(_param_imu_gyro_dnf_min.get(), bandwidth_hz);
+		const float freq_max = 0.5f * _fifo_sample_rate - bandwidth_hz;
+
+		const float *peak_frequencies[3] {sensor_gyro_fft.peak_frequencies_x, sensor_gyro_fft.peak_frequencies_y, sensor_gyro_fft.peak_frequencies_z};
+
+		int active = 0;
+
+		for (int peak = 0; peak < MAX_NUM_FFT_PEAKS; peak++) {
+			for (int axis = 0; axis < 3; axis++) {
+				auto &nf = _dynamic_notch_filter_fft[peak][axis];
+				const float frequency_hz = peak_frequencies[axis][peak];
+
+				if ((frequency_hz > freq_min) && (frequency_hz < freq_max)) {
+					const bool was_enabled = (nf.getNotchFreq() > 0.f);
+
+					// only update the coefficients if the frequency changed significantly
+					if (!was_enabled || (fabsf(nf.getNotchFreq() - frequency_hz) > 0.1f)
+					    || (fabsf(nf.getBandwidth() - bandwidth_hz) > 0.01f)) {
+
+						nf.setParameters(_fifo_sample_rate, frequency_hz, bandwidth_hz);
+
+						if (!was_enabled) {
+							nf.resetDF1(_fifo_velocity_prev[axis]);
+						}
+					}
+
+					active++;
+
+				} else if (nf.getNotchFreq() > 0.f) {
+					nf.setParameters(_fifo_sample_rate, 0.f, 0.f);
+				}
+			}
+		}
+
+		_dynamic_notch_fft_active = active;
+		_dynamic_notch_fft_last_update = sensor_gyro_fft.timestamp;
+
+	} else if (hrt_elapsed_time(&_dynamic_notch_fft_last_update) > DYNAMIC_NOTCH_FILTER_TIMEOUT) {
+		// FFT data lost or stale
+		DisableDynamicNotchFFT();
+	}
+}
+
+bool VehicleAngularVelocity::ConvertFifo(const sensor_gyro_fifo_s &fifo, FifoBlock &block)
+{
+	const int N = fifo.samples;
+
+	if ((fifo.dt <= 0.f) || (N < 1) || (N > FIFO_SIZE_MAX)) {
+		return false;
+	}
+
+	block.timestamp_sample = fifo.timestamp_sample;
+	block.dt = fifo.dt;
+	block.scale = fifo.scale;
+	block.samples = N;
+
+	// copy the raw samples to float blocks (one per axis), which are then filtered in place
+	const int16_t *raw_data_array[3] {fifo.x, fifo.y, fifo.z};
+
+	for (int axis = 0; axis < 3; axis++) {
+		float sum = 0.f;
+
+		for (int n = 0; n < N; n++) {
+			block.data[axis][n] = raw_data_array[axis][n];
+			sum += block.data[axis][n];
+		}
+
+		block.average[axis] = sum / N;
+	}
+
+	return true;
+}
+
+void VehicleAngularVelocity::ProcessFifo()
+{
+	bool updated = false;
+	float scale = 0.f;
+	Vector3f angular_velocity_raw;
+	Vector3f angular_acceleration_raw;
+
+	uORB::SubscriptionCallbackWorkItem &fifo_sub = _sensor_fifo_sub[_selected_fifo_sub_index];
+
+	// process all outstanding messages, read in place from the uORB queue instead of copying every message
+	while (fifo_sub.updated()) {
+		FifoBlock block;
+		bool block_valid = false;
+
+		{
+			const uORB::BorrowedMessage<sensor_gyro_fifo_s> borrowed = fifo_sub.borrow<sensor_gyro_fifo_s>();
+
+			if (borrowed.get() == nullptr) {
+				break;
+			}
+
+			block_valid = ConvertFifo(*borrowed.get(), block);
+
+			if (!borrowed.valid()) {
+				// overwritten by the driver while in use, redo with a consistent copy
+				sensor_gyro_fifo_s sensor_fifo_data;
+				block_valid = fifo_sub.copy(&sensor_fifo_data) && ConvertFifo(sensor_fifo_data, block);
+			}
+		}
+
+		CheckMissedSamples(fifo_sub.get_last_generation());
+
+		if (!block_valid) {
+			continue;
+		}
+
+		const int N = block.samples;
+		float (&data)[3][FIFO_SIZE_MAX] = block.data;
+
+		// reset filters on first use, if the sample rate changed by more than 1% or the parameters changed
+		const float sample_rate = 1.e6f / block.dt;
+
+		if ((fabsf(sample_rate - _fifo_sample_rate) / sample_rate > 0.01f)
+		    || (fabsf(_lp_filter_velocity_fifo[0].get_cutoff_freq() - _param_imu_gyro_cutoff.get()) > 0.01f)
+		    || (fabsf(_notch_filter_velocity_fifo[0].getNotchFreq() - _param_imu_gyro_nf_freq.get()) > 0.01f)
+		    || (fabsf(_notch_filter_velocity_fifo[0].getBandwidth() - _param_imu_gyro_nf_bw.get()) > 0.01f)
+		    || (fabsf(_lp_filter_acceleration_fifo[0].get_cutoff_freq() - _param_imu_dgyro_cutoff.get()) > 0.01f)) {
+
+			for (int axis = 0; axis < 3; axis++) {
+				_fifo_velocity_prev[axis] = data[axis][0];
+			}
+
+			ResetFifoFilters(sample_rate);
+		}
+
+		const float dt_inv = sample_rate;
+		const bool notch_enabled = (_notch_filter_velocity_fifo[0].getNotchFreq() > 0.f);
+
+		float *const data_axis[3] {data[0], data[1], data[2]};
+
+		_fifo_last_average = Vector3f{block.average};
+
+		// all filters below process the three axes interleaved
+
+		// dynamic notch filters (motor RPM harmonics), same frequency on every axis
+		if (_dynamic_notch_esc_rpm_active > 0) {
+			for (auto &harmonic : _dynamic_notch_filter_esc_rpm) {
+				for (auto &esc : harmonic) {
+					if (esc[0].getNotchFreq() > 0.f) {
+						math::NotchFilterArray<float>::applyDF1(esc, data_axis, N);
+					}
+				}
+			}
+		}
+
+		// dynamic notch filters (FFT peaks), a disabled axis passes through unchanged
+		if (_dynamic_notch_fft_active > 0) {
+			for (auto &peak : _dynamic_notch_filter_fft) {
+				if ((peak[0].getNotchFreq() > 0.f) || (peak[1].getNotchFreq() > 0.f) || (peak[2].getNotchFreq() > 0.f)) {
+					math::NotchFilterArray<float>::applyDF1(peak, data_axis, N);
+				}
+			}
+		}
+
+		if (notch_enabled) {
+			math::NotchFilterArray<float>::apply(_notch_filter_velocity_fifo, data_axis, N);
+		}
+
+		// the rate controller runs on every sample (IMU_GYRO_FIFO_RC), which needs the calibration offset
+		const bool publish_block = _param_imu_gyro_fifo_rc.get() && _fifo_offset_valid;
+
+		// low-pass filter the whole block, keep the last output
+		float angular_velocity_last[3];
+		float velocity[3][FIFO_SIZE_MAX];
+
+		if (publish_block) {
+			// keep every filtered sample, the notched block is still needed for the derivative
+			float *const velocity_axis[3] {velocity[0], velocity[1], velocity[2]};
+
+			for (int axis = 0; axis < 3; axis++) {
+				memcpy(velocity[axis], data[axis], N * sizeof(float));
+			}
+
+			math::LowPassFilter2pArray::applyInPlace(_lp_filter_velocity_fifo, velocity_axis, N);
+
+			for (int axis = 0; axis < 3; axis++) {
+				angular_velocity_last[axis] = velocity[axis][N - 1];
+			}
+
+		} else {
+			math::LowPassFilter2pArray::apply(_lp_filter_velocity_fifo, data_axis, N, angular_velocity_last);
+		}
+
+		// differentiate angular velocity (after notch filter) in place, the velocity block isn't needed anymore
+		for (int axis = 0; axis < 3; axis++) {
+			for (int n = 0; n < N; n++) {
+				const float velocity = data[axis][n];
+				data[axis][n] = (velocity - _fifo_velocity_prev[axis]) * dt_inv;
+				_fifo_velocity_prev[axis] = velocity;
+			}
+		}
+
+		float angular_acceleration_last[3];
+
+		if (publish_block) {
+			math::LowPassFilter2pArray::applyInPlace(_lp_filter_acceleration_fifo, data_axis, N);
+
+			for (int axis = 0; axis < 3; axis++) {
+				angular_acceleration_last[axis] = data[axis][N - 1];
+			}
+
+			PublishFifo(block, velocity, data);
+
+		} else {
+			math::LowPassFilter2pArray::apply(_lp_filter_acceleration_fifo, data_axis, N, angular_acceleration_last);
+		}
+
+		angular_acceleration_raw = Vector3f{angular_acceleration_last};
+		angular_velocity_raw = Vector3f{angular_velocity_last};
+
+		_fifo_last_timestamp_sample = block.timestamp_sample;
+		_timestamp_sample_prev = block.timestamp_sample;
+		_update_rate_hz = sample_rate;
+		scale = block.scale;
+		updated = true;
+	}
+
+	if (!updated) {
+		return;
+	}
+
+	UpdateFifoOffset(scale);
+
+	if (!_fifo_offset_valid) {
+		return;
+	}
+
+	Vector3f angular_velocity{angular_velocity_raw};
+	Vector3f angular_acceleration{angular_acceleration_raw};
+	CorrectFifo(scale, angular_velocity, angular_acceleration);
+
+	_angular_velocity_prev = angular_velocity;
+	_angular_acceleration_prev = angular_acceleration;
+
+	Publish(angular_velocity, angular_acceleration, _fifo_last_timestamp_sample);
+}
+
+void VehicleAngularVelocity::CorrectFifo(float scale, Vector3f &angular_velocity, Vector3f &angular_acceleration) const
+{
+	// apply the driver rotation, scale and calibration offset, like PX4Gyroscope does for sensor_gyro
+	rotate_3f(_fifo_rotation, angular_velocity(0), angular_velocity(1), angular_velocity(2));
+	rotate_3f(_fifo_rotation, angular_acceleration(0), angular_acceleration(1), angular_acceleration(2));
+
+	const Vector3f angular_velocity_calibrated{angular_velocity * scale - _fifo_offset};
+
+	// correct for thermal errors and in-run bias errors, only the rotation and scale apply to the derivative
+	angular_velocity = _corrections.Correct(angular_velocity_calibrated) - _bias;
+	angular_acceleration = _corrections.Correct(angular_acceleration * scale) - _corrections.Correct(Vector3f{0.f, 0.f, 0.f});
+}
+
+void VehicleAngularVelocity::PublishFifo(const FifoBlock &block, const float (&velocity)[3][FIFO_SIZE_MAX],
+		const float (&acceleration)[3][FIFO_SIZE_MAX])
+{
+	vehicle_angular_velocity_fifo_s fifo{};
+	fifo.timestamp_sample = block.timestamp_sample;
+	fifo.dt = block.dt;
+	fifo.samples = block.samples;
+
+	for (int n = 0; n < block.samples; n++) {
+		Vector3f angular_velocity{velocity[0][n], velocity[1][n], velocity[2][n]};
+		Vector3f angular_acceleration{acceleration[0][n], acceleration[1][n], acceleration[2][n]};
+		CorrectFifo(block.scale, angular_velocity, angular_acceleration);
+
+		fifo.x[n] = angular_velocity(0);
+		fifo.y[n] = angular_velocity(1);
+		fifo.z[n] = angular_velocity(2);
+		fifo.accel_x[n] = angular_acceleration(0);
+		fifo.accel_y[n] = angular_acceleration(1);
+		fifo.accel_z[n] = angular_acceleration(2);
+	}
+
+	fifo.timestamp = hrt_absolute_time();
+	_vehicle_angular_velocity_fifo_pub.publish(fifo);
+}
+
+void VehicleAngularVelocity::UpdateFifoOffset(float scale)
+{
+	// sensor_gyro is published by the driver from the same FIFO samples (averaged) right before sensor_gyro_fifo,
+	// the difference to the averaged FIFO data gives the calibration offset applied by the driver
+	sensor_gyro_s sensor_gyro;
+
+	if (_sensor_sub[_selected_sensor_sub_index].update(&sensor_gyro)
+	    && (sensor_gyro.timestamp_sample == _fifo_last_timestamp_sample)) {
+
+		float x = _fifo_last_average(0);
+		float y = _fifo_last_average(1);
+		float z = _fifo_last_average(2);
+		rotate_3f(_fifo_rotation, x, y, z);
+
+		_fifo_offset = Vector3f{x, y, z} * scale - Vector3f{sensor_gyro.x, sensor_gyro.y, sensor_gyro.z};
+		_fifo_offset_valid = true;
+	}
+}
+
+void VehicleAngularVelocity::Publish(const Vector3f &angular_velocity, const Vector3f &angular_acceleration,
+				     const hrt_abstime &timestamp_sample)
+{
+	if (_publish_rate_limit_hz > 0.f) {
+		const uint64_t interval = 1e6f / _publish_rate_limit_hz;
+
+		if (hrt_elapsed_time(&_last_publish) < interval) {
+			return;
+		}
+	}
+
+	// Publish vehicle_angular_acceleration
+	vehicle_angular_acceleration_s v_angular_acceleration;
+	v_angular_acceleration.timestamp_sample = timestamp_sample;
+	angular_acceleration.copyTo(v_angular_acceleration.xyz);
+	v_angular_acceleration.timestamp = hrt_absolute_time();
+	_vehicle_angular_acceleration_pub.publish(v_angular_acceleration);
+
+	// Publish vehicle_angular_velocity
+	vehicle_angular_velocity_s v_angular_velocity;
+	v_angular_velocity.timestamp_sample = timestamp_sample;
+	angular_velocity.copyTo(v_angular_velocity.xyz);
+	v_angular_velocity.timestamp = hrt_absolute_time();
+	_vehicle_angular_velocity_pub.publish(v_angular_velocity);
+
+	_last_publish = v_angular_velocity.timestamp_sample;
+}
+
 void VehicleAngularVelocity::ParametersUpdate(bool force)
 {
 	// Check if parameters have changed
@@ -210,10 +719,84 @@ void VehicleAngularVelocity::ParametersUpdate(bool force)
 		parameter_update_s param_update;
 		_params_sub.copy(&param_update);
 
+		const bool fifo_enabled_prev = _param_imu_gyro_fifo.get();
+
 		updateParams();
 
 		_corrections.ParametersUpdate();
+
+		if (_param_imu_gyro_fifo.get() != fifo_enabled_prev) {
+			// select the sensor again to switch between sensor_gyro and sensor_gyro_fifo
+			_selected_sensor_device_id = 0;
+		}
+
+		// start from the configured maximum, UpdateRateLimit() steps down if necessary
+		_publish_rate_limit_hz = math::max(_param_imu_gyro_rate_max.get(), 0);
+		_rate_limit_headroom_count = 0;
+	}
+}
+
+void VehicleAngularVelocity::CheckMissedSamples(unsigned generation)
+{
+	// the subscription skips ahead if the work queue fell behind the sensor (queue overrun)
+	if ((_last_generation != 0) && (generation > _last_generation + 1)) {
+		_missed_samples += generation - _last_generation - 1;
+		_missed_samples_total += generation - _last_generation - 1;
+	}
+
+	_last_generation = generation;
+}
+
+void VehicleAngularVelocity::UpdateRateLimit()
+{
+	cpuload_s cpuload;
+
+	if ((_param_imu_gyro_rate_min.get() <= 0) || !_cpuload_sub.update(&cpuload)) {
+		return;
+	}
+
+	// upper limit IMU_GYRO_RATEMAX (if set), never above the sensor rate
+	float rate_max = _update_rate_hz;
+
+	if (_param_imu_gyro_rate_max.get() > 0) {
+		rate_max = math::min(rate_max, (float)_param_imu_gyro_rate_max.get());
+	}
+
+	const float rate_min = math::min((float)_param_imu_gyro_rate_min.get(), rate_max);
+	const float cpu_max = _param_imu_gyro_cpu_max.get();
+
+	float rate = (_publish_rate_limit_hz > 0.f) ? _publish_rate_limit_hz : rate_max;
+
+	if ((cpuload.load > cpu_max) || (_missed_samples > 0)) {
+		// overloaded, step down immediately
+		rate *= 0.8f;
+		_rate_limit_headroom_count = 0;
+
+	} else if (cpuload.load < cpu_max - 0.1f) {
+		// step up slowly once there has been headroom for a while
+		if (++_rate_limit_headroom_count >= 5) {
+			rate *= 1.1f;
+			_rate_limit_headroom_count = 0;
+		}
+
+	} else {
+		_rate_limit_headroom_count = 0;
+	}
+
+	rate = math::constrain(rate, rate_min, rate_max);
+
+	if ((_param_imu_gyro_rate_max.get() <= 0) && (rate >= _update_rate_hz)) {
+		// back at the full sensor rate
+		rate = 0.f;
+	}
+
+	if (fabsf(rate - _publish_rate_limit_hz) > FLT_EPSILON) {
+		PX4_DEBUG("rate limit %.1f Hz -> %.1f Hz (load %.2f, missed %d)", (double)_publish_rate_limit_hz, (double)rate,
+			  (double)cpuload.load, (int)_missed_samples);
+		_publish_rate_limit_hz = rate;
 	}
+
+	_missed_samples = 0;
 }
 
 void VehicleAngularVelocity::Run()
@@ -224,6 +807,14 @@ void VehicleAngularVelocity::Run()
 	_corrections.SensorCorrectionsUpdate(selection_updated);
 	SensorBiasUpdate(selection_updated);
 	ParametersUpdate();
+	UpdateRateLimit();
+
+	if (_fifo_available) {
+		UpdateDynamicNotchEscRpm();
+		UpdateDynamicNotchFFT();
+		ProcessFifo();
+		return;
+	}
 
 	bool sensor_updated = _sensor_sub[_selected_sensor_sub_index].updated();
 
@@ -236,6 +827,8 @@ void VehicleAngularVelocity::Run()
 		if (_sensor_sub[_selected_sensor_sub_index].copy(&sensor_data)) {
 
 			if (sensor_updated) {
+				CheckMissedSamples(_sensor_sub[_selected_sensor_sub_index].get_last_generation());
+
 				// collect sample interval average for filters
 				if ((_timestamp_sample_last > 0) && (sensor_data.timestamp_sample > _timestamp_sample_last)) {
 					_interval_sum += (sensor_data.timestamp_sample - _timestamp_sample_last);
@@ -276,33 +869,22 @@ void VehicleAngularVelocity::Run()
 			sensor_updated = _sensor_sub[_selected_sensor_sub_index].updated();
 
 			if (!sensor_updated) {
-				bool publish = true;
-
-				if (_param_imu_gyro_rate_max.get() > 0) {
-					const uint64_t interval = 1e6f / _param_imu_gyro_rate_max.get();
-
-					if (hrt_elapsed_time(&_last_publish) < interval) {
-						publish = false;
-					}
-				}
-
-				if (publish) {
-					// Publish vehicle_angular_acceleration
-					vehicle_angular_acceleration_s v_angular_acceleration;
-					v_angular_acceleration.timestamp_sample = sensor_data.timestamp_sample;
-					angular_acceleration.copyTo(v_angular_acceleration.xyz);
-					v_angular_acceleration.timestamp = hrt_absolute_time();
-					_vehicle_angular_acceleration_pub.publish(v_angular_acceleration);
-
-					// Publish vehicle_angular_velocity
-					vehicle_angular_velocity_s v_angular_velocity;
-					v_angular_velocity.timestamp_sample = sensor_data.timestamp_sample;
-					angular_velocity.copyTo(v_angular_velocity.xyz);
-					v_angular_velocity.timestamp = hrt_absolute_time();
-					_vehicle_angular_velocity_pub.publish(v_angular_velocity);
-
-					_last_publish = v_angular_velocity.timestamp_sample;
-					return;
+				Publish(angular_velocity, angular_acceleration, sensor_data.timestamp_sample);
+
+				if (_param_imu_gyro_fifo_rc.get()) {
+					// no FIFO data available, keep the rate controller (IMU_GYRO_FIFO_RC) running with single sample blocks
+					vehicle_angular_velocity_fifo_s fifo{};
+					fifo.timestamp_sample = sensor_data.timestamp_sample;
+					fifo.dt = dt * 1e6f;
+					fifo.samples = 1;
+					fifo.x[0] = angular_velocity(0);
+					fifo.y[0] = angular_velocity(1);
+					fifo.z[0] = angular_velocity(2);
+					fifo.accel_x[0] = angular_acceleration(0);
+					fifo.accel_y[0] = angular_acceleration(1);
+					fifo.accel_z[0] = angular_acceleration(2);
+					fifo.timestamp = hrt_absolute_time();
+					_vehicle_angular_velocity_fifo_pub.publish(fifo);
 				}
 			}
 		}
@@ -314,7 +896,20 @@ void VehicleAngularVelocity::PrintStatus()
 	PX4_INFO("selected sensor: %d (%d)", _selected_sensor_device_id, _selected_sensor_sub_index);
 	PX4_INFO("bias: [%.3f %.3f %.3f]", (double)_bias(0), (double)_bias(1), (double)_bias(2));
 
-	PX4_INFO("sample rate: %.3f Hz", (double)_update_rate_hz);
+	PX4_INFO("sample rate: %.3f Hz%s", (double)_update_rate_hz, _fifo_available ? " (FIFO)" : "");
+
+	if (_param_imu_gyro_rate_min.get() > 0) {
+		PX4_INFO("publication rate limit: %.1f Hz (min %d Hz), missed samples: %d", (double)_publish_rate_limit_hz,
+			 (int)_param_imu_gyro_rate_min.get(), (int)_missed_samples_total);
+	}
+
+	if (_dynamic_notch_esc_rpm_active > 0) {
+		PX4_INFO("dynamic notch filters (ESC RPM): %d", _dynamic_notch_esc_rpm_active / 3);
+	}
+
+	if (_dynamic_notch_fft_active > 0) {
+		PX4_INFO("dynamic notch filters (FFT): %d (all axes)", _dynamic_notch_fft_active);
+	}
 
 	_corrections.PrintStatus();
 }
@@ -35,10 +35,13 @@
 
 #include <sensor_corrections/SensorCorrections.hpp>
 
+#include <lib/conversion/rotation.h>
 #include <lib/mathlib/math/Limits.hpp>
 #include <lib/matrix/matrix/math.hpp>
+#include <lib/mathlib/math/filter/LowPassFilter2pArray.hpp>
 #include <lib/mathlib/math/filter/LowPassFilter2pVector3f.hpp>
 #include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/mathlib/math/filter/NotchFilterArray.hpp>
 #include <px4_platform_common/log.h>
 #include <px4_platform_common/module_params.h>
 #include <px4_platform_common/px4_config.h>
@@ -46,12 +49,18 @@
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
 #include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/cpuload.h>
+#include <uORB/topics/esc_status.h>
 #include <uORB/topics/estimator_sensor_bias.h>
 #include <uORB/topics/parameter_update.h>
 #include <uORB/topics/sensor_gyro.h>
+#include <uORB/topics/sensor_gyro_fifo.h>
+#include <uORB/topics/sensor_gyro_fft.h>
+#include <uORB/topics/sensor_gyro_status.h>
 #include <uORB/topics/sensor_selection.h>
 #include <uORB/topics/vehicle_angular_acceleration.h>
 #include <uORB/topics/vehicle_angular_velocity.h>
+#include <uORB/topics/vehicle_angular_velocity_fifo.h>
 
 namespace sensors
 {
@@ -73,16 +82,54 @@ private:
 
 	void CheckFilters();
 	void ParametersUpdate(bool force = false);
+	void Publish(const matrix::Vector3f &angular_velocity, const matrix::Vector3f &angular_acceleration,
+		     const hrt_abstime &timestamp_sample);
 	void SensorBiasUpdate(bool force = false);
 	bool SensorSelectionUpdate(bool force = false);
 
+	// runtime publication rate limit (IMU_GYRO_RATEMIN), stepped with the CPU headroom
+	void CheckMissedSamples(unsigned generation);
+	void UpdateRateLimit();
+
+	// full rate processing of sensor_gyro_fifo (IMU_GYRO_FIFO)
+	static constexpr int FIFO_SIZE_MAX = sizeof(sensor_gyro_fifo_s::x) / sizeof(sensor_gyro_fifo_s::x[0]);
+
+	// the parts of a sensor_gyro_fifo message used for filtering, raw samples already converted to float blocks
+	struct FifoBlock {
+		hrt_abstime timestamp_sample;
+		float dt;
+		float scale;
+		int samples;
+		float data[3][FIFO_SIZE_MAX];
+		float average[3];
+	};
+
+	static bool ConvertFifo(const sensor_gyro_fifo_s &fifo, FifoBlock &block);
+	void CorrectFifo(float scale, matrix::Vector3f &angular_velocity, matrix::Vector3f &angular_acceleration) const;
+	bool SelectFifo(uint32_t device_id);
+	void ProcessFifo();
+	void PublishFifo(const FifoBlock &block, const float (&velocity)[3][FIFO_SIZE_MAX],
+			 const float (&acceleration)[3][FIFO_SIZE_MAX]);
+	void ResetFifoFilters(float sample_rate);
+	void UpdateFifoOffset(float scale);
+
+	// dynamic notch filters (IMU_GYRO_DNF_EN), only applied to the FIFO data
+	void DisableDynamicNotchEscRpm();
+	void UpdateDynamicNotchEscRpm(bool force = false);
+	void DisableDynamicNotchFFT();
+	void UpdateDynamicNotchFFT(bool force = false);
+
 	static constexpr int MAX_SENSOR_COUNT = 3;
 
 	uORB::Publication<vehicle_angular_acceleration_s> _vehicle_angular_acceleration_pub{ORB_ID(vehicle_angular_acceleration)};
 	uORB::Publication<vehicle_angular_velocity_s> _vehicle_angular_velocity_pub{ORB_ID(vehicle_angular_velocity)};
+	uORB::Publication<vehicle_angular_velocity_fifo_s> _vehicle_angular_velocity_fifo_pub{ORB_ID(vehicle_angular_velocity_fifo)};
 
+	uORB::Subscription _cpuload_sub{ORB_ID(cpuload)};
+	uORB::Subscription _esc_status_sub{ORB_ID(esc_status)};
 	uORB::Subscription _estimator_sensor_bias_sub{ORB_ID(estimator_sensor_bias)};
 	uORB::Subscription _params_sub{ORB_ID(parameter_update)};
+	uORB::Subscription _sensor_gyro_fft_sub{ORB_ID(sensor_gyro_fft)};
 
 	uORB::SubscriptionCallbackWorkItem _sensor_selection_sub{this, ORB_ID(sensor_selection)};
 	uORB::SubscriptionCallbackWorkItem _sensor_sub[MAX_SENSOR_COUNT] {
@@ -91,6 +138,18 @@ private:
 		{this, ORB_ID(sensor_gyro), 2}
 	};
 
+	uORB::SubscriptionCallbackWorkItem _sensor_fifo_sub[MAX_SENSOR_COUNT] {
+		{this, ORB_ID(sensor_gyro_fifo), 0},
+		{this, ORB_ID(sensor_gyro_fifo), 1},
+		{this, ORB_ID(sensor_gyro_fifo), 2}
+	};
+
+	uORB::Subscription _sensor_status_sub[MAX_SENSOR_COUNT] {
+		{ORB_ID(sensor_gyro_status), 0},
+		{ORB_ID(sensor_gyro_status), 1},
+		{ORB_ID(sensor_gyro_status), 2}
+	};
+
 	SensorCorrections _corrections;
 
 	matrix::Vector3f _bias{0.f, 0.f, 0.f};
@@ -103,6 +162,12 @@ private:
 	static constexpr const float kInitialRateHz{1000.0f}; /**< sensor update rate used for initialization */
 	float _update_rate_hz{kInitialRateHz}; /**< current rate-controller loop update rate in [Hz] */
 
+	float _publish_rate_limit_hz{0.f}; ///< current publication rate limit, 0 if not limited
+	unsigned _last_generation{0}; ///< last processed generation of the selected subscription
+	uint32_t _missed_samples{0}; ///< samples dropped since the last rate limit update
+	uint32_t _missed_samples_total{0};
+	int _rate_limit_headroom_count{0}; ///< consecutive cpuload updates with CPU headroom
+
 	// angular velocity filters
 	math::LowPassFilter2pVector3f _lp_filter_velocity{kInitialRateHz, 30.0f};
 	math::NotchFilter<matrix::Vector3f> _notch_filter_velocity{};
@@ -112,8 +177,46 @@ private:
 
 	float _filter_sample_rate{kInitialRateHz};
 
+	// full rate FIFO filters (per axis), operating on raw sensor data
+	math::LowPassFilter2pArray _lp_filter_velocity_fifo[3] {{kInitialRateHz, 30.0f}, {kInitialRateHz, 30.0f}, {kInitialRateHz, 30.0f}};
+	math::NotchFilterArray<float> _notch_filter_velocity_fifo[3] {};
+	math::LowPassFilter2pArray _lp_filter_acceleration_fifo[3] {{kInitialRateHz, 30.0f}, {kInitialRateHz, 30.0f}, {kInitialRateHz, 30.0f}};
+
+	enum DynamicNotch {
+		EscRpm = 1,
+		FFT    = 2,
+	};
+
+	static constexpr int MAX_NUM_ESC_RPM = sizeof(esc_status_s::esc) / sizeof(esc_status_s::esc[0]);
+	static constexpr int MAX_NUM_ESC_RPM_HARMONICS = 3;
+	static constexpr hrt_abstime DYNAMIC_NOTCH_FILTER_TIMEOUT{1000000}; ///< 1 s
+
+	// one notch per motor and harmonic, coefficients are updated in place (Direct Form I)
+	math::NotchFilterArray<float> _dynamic_notch_filter_esc_rpm[MAX_NUM_ESC_RPM_HARMONICS][MAX_NUM_ESC_RPM][3] {};
+	hrt_abstime _dynamic_notch_esc_rpm_last_update{0};
+	int _dynamic_notch_esc_rpm_active{0}; ///< number of enabled (per axis) notch filters
+
+	static constexpr int MAX_NUM_FFT_PEAKS = sizeof(sensor_gyro_fft_s::peak_frequencies_x) / sizeof(
+				sensor_gyro_fft_s::peak_frequencies_x[0]);
+
+	// one notch per FFT peak, each axis tracks its own peaks
+	math::NotchFilterArray<float> _dynamic_notch_filter_fft[MAX_NUM_FFT_PEAKS][3] {};
+	hrt_abstime _dynamic_notch_fft_last_update{0};
+	int _dynamic_notch_fft_active{0}; ///< number of enabled (per axis) notch filters
+
+	float _fifo_sample_rate{0.f};
+	float _fifo_velocity_prev[3] {}; ///< last notched raw sample, for the derivative
+
+	enum Rotation _fifo_rotation {ROTATION_NONE}; ///< driver rotation, FIFO data is published unrotated
+	matrix::Vector3f _fifo_offset{0.f, 0.f, 0.f}; ///< driver calibration offset, FIFO data is published uncalibrated
+	matrix::Vector3f _fifo_last_average{0.f, 0.f, 0.f};
+	hrt_abstime _fifo_last_timestamp_sample{0};
+	bool _fifo_offset_valid{false};
+	bool _fifo_available{false};
+
 	uint32_t _selected_sensor_device_id{0};
 	uint8_t _selected_sensor_sub_index{0};
+	uint8_t _selected_fifo_sub_index{0};
 
 	hrt_abstime _timestamp_sample_last{0};
 	float _interval_sum{0.f};
@@ -124,6 +227,14 @@ private:
 		(ParamFloat<px4::params::IMU_GYRO_NF_FREQ>) _param_imu_gyro_nf_freq,
 		(ParamFloat<px4::params::IMU_GYRO_NF_BW>) _param_imu_gyro_nf_bw,
 		(ParamInt<px4::params::IMU_GYRO_RATEMAX>) _param_imu_gyro_rate_max,
+		(ParamInt<px4::params::IMU_GYRO_RATEMIN>) _param_imu_gyro_rate_min,
+		(ParamFloat<px4::params::IMU_GYRO_CPUMAX>) _param_imu_gyro_cpu_max,
+		(ParamBool<px4::params::IMU_GYRO_FIFO>) _param_imu_gyro_fifo,
+		(ParamBool<px4::params::IMU_GYRO_FIFO_RC>) _param_imu_gyro_fifo_rc,
+		(ParamInt<px4::params::IMU_GYRO_DNF_EN>) _param_imu_gyro_dnf_en,
+		(ParamInt<px4::params::IMU_GYRO_DNF_HMC>) _param_imu_gyro_dnf_hmc,
+		(ParamFloat<px4::params::IMU_GYRO_DNF_BW>) _param_imu_gyro_dnf_bw,
+		(ParamFloat<px4::params::IMU_GYRO_DNF_MIN>) _param_imu_gyro_dnf_min,
 
 		(ParamFloat<px4::params::IMU_DGYRO_CUTOFF>) _param_imu_dgyro_cutoff
 	)
@@ -102,6 +102,118 @@ PARAM_DEFINE_FLOAT(IMU_GYRO_CUTOFF, 30.0f);
 */
 PARAM_DEFINE_INT32(IMU_GYRO_RATEMAX, 0);
 
+/**
+* Gyro control data minimum publication rate (runtime rate adaption)
+*
+* If set, the gyro control data publication rate is adapted at runtime between this
+* minimum and IMU_GYRO_RATEMAX (or the native sensor sample rate if IMU_GYRO_RATEMAX is 0).
+* The rate is stepped down immediately when the CPU load exceeds IMU_GYRO_CPUMAX or gyro samples
+* are dropped because the work queue fell behind, and stepped up slowly while there is CPU headroom.
+*
+* Set to 0 to disable and publish at the fixed IMU_GYRO_RATEMAX.
+*
+* @min 0
+* @max 2000
+* @value 0 0 (disabled)
+* @value 250 250 Hz
+* @value 400 400 Hz
+* @unit Hz
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_RATEMIN, 0);
+
+/**
+* Gyro control data rate adaption CPU load threshold
+*
+* CPU load above which the gyro control data publication rate is reduced (see IMU_GYRO_RATEMIN).
+* The rate is only increased again once the load is 0.1 below this threshold.
+*
+* @min 0.3
+* @max 1.0
+* @decimal 2
+* @increment 0.05
+* @unit norm
+* @group Sensors
+*/
+PARAM_DEFINE_FLOAT(IMU_GYRO_CPUMAX, 0.8f);
+
+/**
+* Filter the full rate gyro FIFO data
+*
+* If enabled and the selected gyro publishes its raw FIFO samples (sensor_gyro_fifo),
+* the notch and low pass filters (IMU_GYRO_NF_FREQ, IMU_GYRO_CUTOFF, IMU_DGYRO_CUTOFF)
+* run on every raw sample at the native sensor rate instead of the averaged sensor_gyro data,
+* which reduces aliasing and filter phase lag.
+*
+* @boolean
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_FIFO, 0);
+
+/**
+* Run the rate controller on every gyro FIFO sample
+*
+* Requires the full rate gyro FIFO data (IMU_GYRO_FIFO).
+* If enabled, every filtered FIFO sample is published in blocks (vehicle_angular_velocity_fifo)
+* and the multicopter rate controller runs one control step per sample (4-8 kHz),
+* processing a whole block per wakeup. The actuator controls are published once per block
+* with the result of the last sample.
+*
+* @boolean
+* @reboot_required true
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_FIFO_RC, 0);
+
+/**
+* IMU gyro dynamic notch filtering
+*
+* Enable bank of dynamically updating notch filters.
+* Requires the full rate gyro FIFO data (IMU_GYRO_FIFO) and either ESC RPM feedback (esc_status)
+* or the onboard gyro FFT (IMU_GYRO_FFT_EN).
+*
+* @min 0
+* @max 3
+* @bit 0 ESC RPM
+* @bit 1 FFT
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_DNF_EN, 0);
+
+/**
+* IMU gyro dynamic notch filter harmonics
+*
+* ESC RPM number of harmonics (multiples of RPM) for ESC RPM dynamic notch filtering.
+*
+* @min 1
+* @max 3
+* @group Sensors
+*/
+PARAM_DEFINE_INT32(IMU_GYRO_DNF_HMC, 3);
+
+/**
+* IMU gyro dynamic notch filter bandwidth
+*
+* Bandwidth per notch filter when using dynamic notch filtering (ESC RPM or FFT).
+*
+* @min 5
+* @max 30
+* @unit Hz
+* @group Sensors
+*/
+PARAM_DEFINE_FLOAT(IMU_GYRO_DNF_BW, 15.0f);
+
+/**
+* IMU gyro dynamic notch filter minimum frequency
+*
+* Minimum notch filter frequency in Hz, below it the dynamic notch filters are disabled.
+*
+* @min 0
+* @unit Hz
+* @group Sensors
+*/
+PARAM_DEFINE_FLOAT(IMU_GYRO_DNF_MIN, 25.0f);
+
 /**
 * Cutoff frequency for angular acceleration (D-Term filter)
 *
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/vehicle_gps_position.h>
+
+/**
+ * Selects or blends the GPS receivers (sensor_gps) into a single vehicle_gps_position,
+ * running only when GPS data arrives.
+ */
+class VehicleGPSPosition : public ModuleParams, public px4::ScheduledWorkItem
+{
+public:
+
+	VehicleGPSPosition();
+	~VehicleGPSPosition() override;
+
+	bool Start();
+	void Stop();
+
+	void PrintStatus();
+
+private:
+	void Run() override;
+
+	void ParametersUpdate();
+	void Publish(const vehicle_gps_position_s &gps, uint8_t selected);
+
+	/*
+	 * Update the internal state estimate for a blended GPS solution that is a weighted average of the phsyical
+	 * receiver solutions. This internal state cannot be used directly by estimators because if physical receivers
+	 * have significant position differences, variation in receiver estimated accuracy will cause undesirable
+	 * variation in the position solution.
+	 */
+	bool BlendGpsData();
+
+	/*
+	 * Calculate internal states used to blend GPS data from multiple receivers using the blend weights.
+	 * States are written to _gps_state and _gps_blended_state class variables
+	 */
+	void UpdateGpsBlendStates();
+
+	/*
+	 * The location in _gps_blended_state will move around as the relative accuracy changes.
+	 * To mitigate this effect a low-pass filtered offset from each GPS location to the blended location is
+	 * calculated.
+	 */
+	void UpdateGpsOffsets();
+
+	/*
+	 * Apply the steady state physical receiver offsets calculated by UpdateGpsOffsets().
+	 */
+	void ApplyGpsOffsets();
+
+	/*
+	 * Calculate GPS output that is a blend of the offset corrected physical receiver data
+	 */
+	void CalcGpsBlendOutput();
+
+	// defines used to specify the mask position for use of different accuracy metrics in the GPS blending algorithm
+	static constexpr int32_t BLEND_MASK_USE_SPD_ACC = 1;
+	static constexpr int32_t BLEND_MASK_USE_HPOS_ACC = 2;
+	static constexpr int32_t BLEND_MASK_USE_VPOS_ACC = 4;
+
+	// max number of GPS receivers supported and 0 base instance used to access virtual 'blended' GPS solution
+	static constexpr int GPS_MAX_RECEIVERS = 2;
+	static constexpr int GPS_BLENDED_INSTANCE = 2;
+
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::SENS_GPS_MASK>) _param_sens_gps_mask,
+		(ParamFloat<px4::params::SENS_GPS_TAU>) _param_sens_gps_tau
+	)
+
+	uORB::Publication<vehicle_gps_position_s> _vehicle_gps_position_pub{ORB_ID(vehicle_gps_position)};
+
+	uORB::Subscription _params_sub{ORB_ID(parameter_update)};
+
+	uORB::SubscriptionCallbackWorkItem _sensor_gps_sub[GPS_MAX_RECEIVERS] {
+		{this, ORB_ID(sensor_gps), 0},
+		{this, ORB_ID(sensor_gps), 1}
+	};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": gps cycle")};
+
+	vehicle_gps_position_s _gps_state[GPS_MAX_RECEIVERS] {}; ///< internal state data for the physical GPS
+	vehicle_gps_position_s _gps_blended_state{};		///< internal state data for the blended GPS
+	vehicle_gps_position_s _gps_output[GPS_MAX_RECEIVERS + 1] {}; ///< output state data for the physical and blended GPS
+	matrix::Vector2f _NE_pos_offset_m[GPS_MAX_RECEIVERS] {}; ///< Filtered North,East position offset from GPS instance to blended solution in _output_state.location (m)
+	float _hgt_offset_mm[GPS_MAX_RECEIVERS] {};	///< Filtered height offset from GPS instance relative to blended solution in _output_state.location (mm)
+	float _blend_weights[GPS_MAX_RECEIVERS] {};	///< blend weight for each GPS. The blend weights must sum to 1.0 across all instances.
+	uint64_t _time_prev_us[GPS_MAX_RECEIVERS] {};	///< the previous value of time_us for that GPS instance - used to detect new data.
+	uint8_t _gps_best_index{0};			///< index of the physical receiver with the lowest reported error
+	uint8_t _gps_select_index{0};			///< 0 = GPS1, 1 = GPS2, 2 = blended
+	uint8_t _gps_time_ref_index{0};			///< index of the receiver that is used as the timing reference for the blending update
+	uint8_t _gps_oldest_index{0};			///< index of the physical receiver with the oldest data
+	uint8_t _gps_newest_index{0};			///< index of the physical receiver with the newest data
+	uint8_t _gps_slowest_index{0};			///< index of the physical receiver with the slowest update rate
+	float _gps_dt[GPS_MAX_RECEIVERS] {};		///< average time step in seconds.
+	bool  _gps_new_output_data{false};		///< true if there is new output data for the EKF
+};
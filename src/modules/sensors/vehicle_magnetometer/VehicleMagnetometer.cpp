@@ -0,0 +1,526 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#include "VehicleMagnetometer.hpp"
+
+#include <drivers/drv_mag.h>
+#include <lib/conversion/rotation.h>
+#include <lib/parameters/param.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/posix.h>
+
+using namespace matrix;
+using namespace time_literals;
+
+static constexpr uint32_t SENSOR_TIMEOUT{300_ms};
+
+// CAL_MAGx_ROT value marking an internal magnetometer (uses the board rotation)
+static constexpr int32_t MAG_ROT_VAL_INTERNAL{-1};
+
+VehicleMagnetometer::VehicleMagnetometer() :
+	ModuleParams(nullptr),
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::navigation_and_controllers)
+{
+	_voter.set_timeout(SENSOR_TIMEOUT);
+	_voter.set_equal_value_threshold(1000);
+
+	ParametersUpdate(true);
+}
+
+VehicleMagnetometer::~VehicleMagnetometer()
+{
+	Stop();
+
+	perf_free(_cycle_perf);
+}
+
+bool VehicleMagnetometer::Start()
+{
+	ScheduleNow();
+
+	return true;
+}
+
+void VehicleMagnetometer::Stop()
+{
+	Deinit();
+
+	// clear all registered callbacks
+	for (auto &sub : _sensor_sub) {
+		sub.unregisterCallback();
+	}
+}
+
+void VehicleMagnetometer::ParametersUpdate(bool force)
+{
+	// Check if parameters have changed, calibrations are only applied while disarmed
+	if ((_params_sub.updated() && !_armed) || force) {
+		// clear update
+		parameter_update_s param_update;
+		_params_sub.copy(&param_update);
+
+		updateParams();
+
+		// fine tune the board rotation
+		const Dcmf board_rotation_offset(Eulerf(
+				math::radians(_param_sens_board_x_off.get()),
+				math::radians(_param_sens_board_y_off.get()),
+				math::radians(_param_sens_board_z_off.get())));
+
+		_board_rotation = board_rotation_offset * get_rot_matrix((enum Rotation)_param_sens_board_rot.get());
+
+		for (int uorb_index = 0; uorb_index < MAX_SENSOR_COUNT; uorb_index++) {
+			CalibrationUpdate(uorb_index);
+		}
+	}
+}
+
+void VehicleMagnetometer::CalibrationUpdate(int uorb_index)
+{
+	// initialize with the board rotation in case there is no calibration data available
+	_rotation[uorb_index] = _board_rotation;
+	_mag_compensator.set_coefficients(uorb_index, MagCompensator::Coefficients{});
+	_enabled[uorb_index] = true;
+
+	if (_device_id[uorb_index] == 0) {
+		// no data published yet
+		return;
+	}
+
+	// find the driver handle that matches the device id
+	// (the DevHandle method does not work on POSIX, the id comes from the topic)
+	int fd = -1;
+	char str[30] {};
+
+	for (unsigned driver_index = 0; driver_index < MAX_SENSOR_COUNT; ++driver_index) {
+
+		(void)sprintf(str, "%s%u", MAG_BASE_DEVICE_PATH, driver_index);
+
+		fd = px4_open(str, O_RDWR);
+
+		if (fd < 0) {
+			/* the driver is not running, continue with the next */
+			continue;
+		}
+
+		uint32_t driver_device_id = (uint32_t)px4_ioctl(fd, DEVIOCGDEVICEID, 0);
+
+		if (driver_device_id == _device_id[uorb_index]) {
+			break; // we found the matching driver
+
+		} else {
+			px4_close(fd);
+			fd = -1;
+		}
+	}
+
+	/* run through all stored calibrations */
+	for (unsigned i = 0; i < MAX_SENSOR_COUNT; i++) {
+		bool failed = false;
+
+		(void)sprintf(str, "CAL_MAG%u_ID", i);
+		int32_t device_id = 0;
+		failed = failed || (PX4_OK != param_get(param_find(str), &device_id));
+
+		(void)sprintf(str, "CAL_MAG%u_EN", i);
+		int32_t device_enabled = 1;
+		failed = failed || (PX4_OK != param_get(param_find(str), &device_enabled));
+
+		if (failed || ((uint32_t)device_id != _device_id[uorb_index])) {
+			continue;
+		}
+
+		/* the calibration is for this device, apply it */
+		_enabled[uorb_index] = (device_enabled == 1);
+
+		// the mags that were published after the initial parameter update
+		// would be given the priority even if disabled. Reset it to 0 in this case
+		if (!_enabled[uorb_index]) {
+			_priority[uorb_index] = ORB_PRIO_UNINITIALIZED;
+		}
+
+		// throttle-/current-based power compensation, one column per power input
+		MagCompensator::Coefficients power_compensation{};
+
+		if ((MagCompensationType)_param_cal_mag_comp_typ.get() == MagCompensationType::Current_motors) {
+			for (unsigned motor = 0; motor < MagCompensator::POWER_COUNT_MAX; motor++) {
+				(void)sprintf(str, "CAL_MAG%u_XCOMP%u", i, motor + 1);
+				param_get(param_find(str), &power_compensation(0, motor));
+
+				(void)sprintf(str, "CAL_MAG%u_YCOMP%u", i, motor + 1);
+				param_get(param_find(str), &power_compensation(1, motor));
+
+				(void)sprintf(str, "CAL_MAG%u_ZCOMP%u", i, motor + 1);
+				param_get(param_find(str), &power_compensation(2, motor));
+			}
+
+		} else {
+			(void)sprintf(str, "CAL_MAG%u_XCOMP", i);
+			param_get(param_find(str), &power_compensation(0, 0));
+
+			(void)sprintf(str, "CAL_MAG%u_YCOMP", i);
+			param_get(param_find(str), &power_compensation(1, 0));
+
+			(void)sprintf(str, "CAL_MAG%u_ZCOMP", i);
+			param_get(param_find(str), &power_compensation(2, 0));
+		}
+
+		_mag_compensator.set_coefficients(uorb_index, power_compensation);
+
+		mag_calibration_s mscale{};
+
+		(void)sprintf(str, "CAL_MAG%u_XOFF", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.x_offset));
+
+		(void)sprintf(str, "CAL_MAG%u_YOFF", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.y_offset));
+
+		(void)sprintf(str, "CAL_MAG%u_ZOFF", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.z_offset));
+
+		(void)sprintf(str, "CAL_MAG%u_XSCALE", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.x_scale));
+
+		(void)sprintf(str, "CAL_MAG%u_YSCALE", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.y_scale));
+
+		(void)sprintf(str, "CAL_MAG%u_ZSCALE", i);
+		failed = failed || (PX4_OK != param_get(param_find(str), &mscale.z_scale));
+
+		(void)sprintf(str, "CAL_MAG%u_ROT", i);
+		int32_t mag_rot = 0;
+		param_get(param_find(str), &mag_rot);
+
+		if (_external[uorb_index]) {
+
+			/* check if this mag is still set as internal, otherwise leave untouched */
+			if (mag_rot < 0) {
+				/* it was marked as internal, change to external with no rotation */
+				mag_rot = 0;
+				param_set_no_notification(param_find(str), &mag_rot);
+			}
+
+		} else {
+			/* mag is internal - reset param to -1 to indicate internal mag */
+			if (mag_rot != MAG_ROT_VAL_INTERNAL) {
+				mag_rot = MAG_ROT_VAL_INTERNAL;
+				param_set_no_notification(param_find(str), &mag_rot);
+			}
+		}
+
+		/* now get the mag rotation */
+		if (mag_rot >= 0) {
+			// Set external magnetometers to use the parameter value
+			_rotation[uorb_index] = get_rot_matrix((enum Rotation)mag_rot);
+
+		} else {
+			// Set internal magnetometers to use the board rotation
+			_rotation[uorb_index] = _board_rotation;
+		}
+
+		if (failed || (fd < 0) || (px4_ioctl(fd, MAGIOCSSCALE, (long unsigned int)&mscale) != 0)) {
+			PX4_ERR("FAILED APPLYING mag CAL #%u", i);
+		}
+
+		break;
+	}
+
+	if (fd >= 0) {
+		px4_close(fd);
+	}
+}
+
+void VehicleMagnetometer::MagCompensationUpdate()
+{
+	vehicle_control_mode_s vehicle_control_mode;
+
+	if (_vehicle_control_mode_sub.update(&vehicle_control_mode)) {
+		_armed = vehicle_control_mode.flag_armed;
+		_mag_compensator.update_armed_flag(_armed);
+	}
+
+	const MagCompensationType mag_comp_type = (MagCompensationType)_param_cal_mag_comp_typ.get();
+
+	// change battery current subscription instance if necessary
+	if (mag_comp_type != _mag_comp_type) {
+		if (mag_comp_type == MagCompensationType::Current_inst0) {
+			_battery_status_sub = uORB::Subscription{ORB_ID(battery_status), 0};
+
+		} else if (mag_comp_type == MagCompensationType::Current_inst1) {
+			_battery_status_sub = uORB::Subscription{ORB_ID(battery_status), 1};
+		}
+
+		_mag_comp_type = mag_comp_type;
+	}
+
+	// update power signal for mag compensation
+	if (_mag_comp_type == MagCompensationType::Throttle) {
+		actuator_controls_s controls;
+
+		if (_actuator_controls_0_sub.update(&controls)) {
+			_mag_compensator.update_power(controls.control[actuator_controls_s::INDEX_THROTTLE]);
+		}
+
+	} else if (_mag_comp_type == MagCompensationType::Current_inst0
+		   || _mag_comp_type == MagCompensationType::Current_inst1) {
+
+		battery_status_s bat_stat;
+
+		if (_battery_status_sub.update(&bat_stat)) {
+			_mag_compensator.update_power(bat_stat.current_a * 0.001f); // current in [kA]
+		}
+
+	} else if (_mag_comp_type == MagCompensationType::Current_motors) {
+		esc_status_s esc_status;
+
+		if (_esc_status_sub.update(&esc_status)) {
+			MagCompensator::Power current{};
+
+			for (int motor = 0; motor < math::min((int)esc_status.esc_count, MagCompensator::POWER_COUNT_MAX); motor++) {
+				if (esc_status.esc_online_flags & (1 << motor)) {
+					current(motor) = esc_status.esc[motor].esc_current * 0.001f; // current in [kA]
+				}
+			}
+
+			_mag_compensator.update_power(current);
+		}
+	}
+}
+
+void VehicleMagnetometer::Run()
+{
+	perf_begin(_cycle_perf);
+
+	MagCompensationUpdate();
+	ParametersUpdate();
+
+	bool updated[MAX_SENSOR_COUNT] {};
+
+	for (int uorb_index = 0; uorb_index < MAX_SENSOR_COUNT; uorb_index++) {
+
+		if (!_advertised[uorb_index]) {
+			// use data's timestamp to throttle advertisement checks
+			if (hrt_elapsed_time(&_timestamp[uorb_index]) > 1_s) {
+				if (_sensor_sub[uorb_index].advertised()) {
+					if (uorb_index > 0) {
+						/* the first always exists, but for each further sensor, add a new validator */
+						if (!_voter.add_new_validator()) {
+							PX4_ERR("failed to add validator for sensor_mag:%i", uorb_index);
+						}
+					}
+
+					_advertised[uorb_index] = true;
+
+				} else {
+					_timestamp[uorb_index] = hrt_absolute_time();
+				}
+			}
+
+		} else {
+			sensor_mag_s report;
+
+			if (_sensor_sub[uorb_index].update(&report)) {
+
+				if (report.device_id != _device_id[uorb_index]) {
+					// first data (or a new device) on this instance, look up its calibration
+					_device_id[uorb_index] = report.device_id;
+					_external[uorb_index] = report.is_external;
+					CalibrationUpdate(uorb_index);
+				}
+
+				if (!_enabled[uorb_index]) {
+					continue;
+				}
+
+				if (_priority[uorb_index] == 0) {
+					// set initial priority
+					_priority[uorb_index] = _sensor_sub[uorb_index].get_priority();
+				}
+
+				Vector3f vect{report.x, report.y, report.z};
+
+				// throttle-/current-based mag compensation
+				_mag_compensator.calculate_mag_corrected(uorb_index, vect);
+
+				_last_data[uorb_index] = _rotation[uorb_index] * vect;
+				_timestamp[uorb_index] = report.timestamp;
+
+				float data[3];
+				_last_data[uorb_index].copyTo(data);
+				_voter.put(uorb_index, report.timestamp, data, report.error_count, _priority[uorb_index]);
+
+				updated[uorb_index] = true;
+			}
+		}
+	}
+
+	// check for the current best sensor
+	int best_index = -1;
+	_voter.get_best(hrt_absolute_time(), &best_index);
+
+	if (best_index >= 0) {
+		if (_selected_sensor_sub_index != best_index) {
+			// clear all registered callbacks
+			for (auto &sub : _sensor_sub) {
+				sub.unregisterCallback();
+			}
+
+			_selected_sensor_sub_index = best_index;
+			_sensor_sub[_selected_sensor_sub_index].registerCallback();
+		}
+	}
+
+	if ((_selected_sensor_sub_index >= 0) && updated[_selected_sensor_sub_index]) {
+		// populate vehicle_magnetometer with the selected mag and publish
+		vehicle_magnetometer_s out{};
+		out.timestamp = _timestamp[_selected_sensor_sub_index];
+		out.device_id = _device_id[_selected_sensor_sub_index];
+		_last_data[_selected_sensor_sub_index].copyTo(out.magnetometer_ga);
+
+		_vehicle_magnetometer_pub.publish(out);
+
+		if (!_armed) {
+			MagInconsistencyUpdate();
+		}
+	}
+
+	CheckFailover();
+
+	// reschedule timeout
+	ScheduleDelayed(100_ms);
+
+	perf_end(_cycle_perf);
+}
+
+void VehicleMagnetometer::CheckFailover()
+{
+	if (_last_failover_count != _voter.failover_count()) {
+		uint32_t flags = _voter.failover_state();
+		int failover_index = _voter.failover_index();
+
+		if (flags == DataValidator::ERROR_FLAG_NO_ERROR) {
+			if (failover_index != -1) {
+				// we switched due to a non-critical reason. No need to panic.
+				PX4_INFO("sensor_mag switch from #%i", failover_index);
+			}
+
+		} else {
+			if (failover_index != -1) {
+				mavlink_log_emergency(&_mavlink_log_pub, "Mag #%i fail: %s%s%s%s%s!",
+						      failover_index,
+						      ((flags & DataValidator::ERROR_FLAG_NO_DATA) ? " OFF" : ""),
+						      ((flags & DataValidator::ERROR_FLAG_STALE_DATA) ? " STALE" : ""),
+						      ((flags & DataValidator::ERROR_FLAG_TIMEOUT) ? " TIMEOUT" : ""),
+						      ((flags & DataValidator::ERROR_FLAG_HIGH_ERRCOUNT) ? " ERR CNT" : ""),
+						      ((flags & DataValidator::ERROR_FLAG_HIGH_ERRDENSITY) ? " ERR DNST" : ""));
+
+				// reduce priority of failed sensor to the minimum
+				_priority[failover_index] = ORB_PRIO_MIN;
+
+				int ctr_valid = 0;
+
+				for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+					if (_enabled[i] && (_priority[i] > ORB_PRIO_MIN)) {
+						ctr_valid++;
+					}
+				}
+
+				if (ctr_valid < 2) {
+					subsystem_info_s info{};
+
+					if (ctr_valid == 0) {
+						// Zero valid sensors remain! Set even the primary sensor health to false
+						info.subsystem_type = subsystem_info_s::SUBSYSTEM_TYPE_MAG;
+
+					} else {
+						// One valid sensor remains, set secondary sensor health to false
+						info.subsystem_type = subsystem_info_s::SUBSYSTEM_TYPE_MAG2;
+					}
+
+					info.timestamp = hrt_absolute_time();
+					info.present = true;
+					info.enabled = true;
+					info.ok = false;
+
+					_subsystem_info_pub.publish(info);
+				}
+			}
+		}
+
+		_last_failover_count = _voter.failover_count();
+	}
+}
+
+void VehicleMagnetometer::MagInconsistencyUpdate()
+{
+	const Vector3f &primary_mag = _last_data[_selected_sensor_sub_index]; // primary mag field vector
+	float mag_angle_diff_max = 0.f; // the maximum angle difference
+	unsigned check_index = 0; // the number of sensors the primary has been checked against
+
+	// Check each sensor against the primary
+	for (int i = 0; i < MAX_SENSOR_COUNT; i++) {
+		// check that the sensor we are checking against is not the same as the primary
+		if (_enabled[i] && (_priority[i] > 0) && (i != _selected_sensor_sub_index)) {
+			// calculate angle to 3D magnetic field vector of the primary sensor
+			const float angle_error = AxisAnglef(Quatf(_last_data[i], primary_mag)).angle();
+
+			// complementary filter to not fail/pass on single outliers
+			_mag_angle_diff[check_index] *= 0.95f;
+			_mag_angle_diff[check_index] += 0.05f * angle_error;
+
+			mag_angle_diff_max = math::max(mag_angle_diff_max, _mag_angle_diff[check_index]);
+
+			// increment the check index
+			check_index++;
+		}
+
+		// check to see if the maximum number of checks has been reached and break
+		if (check_index >= 2) {
+			break;
+		}
+	}
+
+	// will be zero if there is only one magnetometer and hence nothing to compare
+	_mag_angle_diff_max = mag_angle_diff_max;
+}
+
+void VehicleMagnetometer::PrintStatus()
+{
+	if (_selected_sensor_sub_index >= 0) {
+		PX4_INFO("selected magnetometer: %d (%d)", _device_id[_selected_sensor_sub_index], _selected_sensor_sub_index);
+	}
+
+	perf_print_counter(_cycle_perf);
+	_voter.print();
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+#pragma once
+
+#include <lib/ecl/validation/data_validator_group.h>
+#include <lib/mag_compensation/MagCompensation.hpp>
+#include <lib/mathlib/math/Limits.hpp>
+#include <lib/matrix/matrix/math.hpp>
+#include <lib/perf/perf_counter.h>
+#include <lib/systemlib/mavlink_log.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/actuator_controls.h>
+#include <uORB/topics/battery_status.h>
+#include <uORB/topics/esc_status.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/sensor_mag.h>
+#include <uORB/topics/subsystem_info.h>
+#include <uORB/topics/vehicle_control_mode.h>
+#include <uORB/topics/vehicle_magnetometer.h>
+
+class VehicleMagnetometer : public ModuleParams, public px4::ScheduledWorkItem
+{
+public:
+
+	VehicleMagnetometer();
+	~VehicleMagnetometer() override;
+
+	bool Start();
+	void Stop();
+
+	void PrintStatus();
+
+	/**
+	 * Filtered maximum angle (rad) between the field vectors of the selected and any other magnetometer,
+	 * only updated while disarmed. Zero if there is only one magnetometer.
+	 */
+	float MagInconsistencyAngle() const { return _mag_angle_diff_max; }
+
+private:
+	void Run() override;
+
+	void CalibrationUpdate(int uorb_index);
+	void CheckFailover();
+	void MagCompensationUpdate();
+	void MagInconsistencyUpdate();
+	void ParametersUpdate(bool force = false);
+
+	static constexpr int MAX_SENSOR_COUNT = 4;
+
+	enum class MagCompensationType {
+		Disabled = 0,
+		Throttle,
+		Current_inst0,
+		Current_inst1,
+		Current_motors
+	};
+
+	DEFINE_PARAMETERS(
+		(ParamInt<px4::params::CAL_MAG_COMP_TYP>) _param_cal_mag_comp_typ,
+		(ParamInt<px4::params::SENS_BOARD_ROT>) _param_sens_board_rot,
+		(ParamFloat<px4::params::SENS_BOARD_X_OFF>) _param_sens_board_x_off,
+		(ParamFloat<px4::params::SENS_BOARD_Y_OFF>) _param_sens_board_y_off,
+		(ParamFloat<px4::params::SENS_BOARD_Z_OFF>) _param_sens_board_z_off
+	)
+
+	uORB::Publication<vehicle_magnetometer_s> _vehicle_magnetometer_pub{ORB_ID(vehicle_magnetometer)};
+	uORB::PublicationQueued<subsystem_info_s> _subsystem_info_pub{ORB_ID(subsystem_info)};
+
+	uORB::Subscription _actuator_controls_0_sub{ORB_ID(actuator_controls_0)};
+	uORB::Subscription _battery_status_sub{ORB_ID(battery_status), 0};
+	uORB::Subscription _esc_status_sub{ORB_ID(esc_status)};
+	uORB::Subscription _params_sub{ORB_ID(parameter_update)};
+	uORB::Subscription _vehicle_control_mode_sub{ORB_ID(vehicle_control_mode)};
+
+	uORB::SubscriptionCallbackWorkItem _sensor_sub[MAX_SENSOR_COUNT] {
+		{this, ORB_ID(sensor_mag), 0},
+		{this, ORB_ID(sensor_mag), 1},
+		{this, ORB_ID(sensor_mag), 2},
+		{this, ORB_ID(sensor_mag), 3}
+	};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": mag cycle")};
+
+	orb_advert_t _mavlink_log_pub{nullptr};
+
+	static_assert(MAX_SENSOR_COUNT <= MagCompensator::MAG_COUNT_MAX, "MagCompensator supports fewer magnetometers");
+	MagCompensator _mag_compensator{this};
+	MagCompensationType _mag_comp_type{MagCompensationType::Disabled};
+
+	DataValidatorGroup _voter{1};
+	unsigned _last_failover_count{0};
+
+	matrix::Dcmf _board_rotation{};
+
+	matrix::Dcmf _rotation[MAX_SENSOR_COUNT] {};
+
+	matrix::Vector3f _last_data[MAX_SENSOR_COUNT] {}; /**< rotated and compensated field of each instance (Ga) */
+	hrt_abstime _timestamp[MAX_SENSOR_COUNT] {};
+	uint32_t _device_id[MAX_SENSOR_COUNT] {};
+	bool _external[MAX_SENSOR_COUNT] {};
+
+	bool _advertised[MAX_SENSOR_COUNT] {};
+	bool _enabled[MAX_SENSOR_COUNT] {true, true, true, true};
+	uint8_t _priority[MAX_SENSOR_COUNT] {};
+
+	int8_t _selected_sensor_sub_index{-1};
+
+	bool _armed{false};
+
+	float _mag_angle_diff[2] {};			/**< filtered mag angle differences between sensor instances (rad) */
+	float _mag_angle_diff_max{0.f};
+};
@@ -0,0 +1,241 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#include "VehicleObstacleDistance.hpp"
+
+#include <lib/mathlib/mathlib.h>
+
+using namespace matrix;
+using namespace time_literals;
+
+static constexpr hrt_abstime SENSOR_TIMEOUT{500_ms};
+
+VehicleObstacleDistance::VehicleObstacleDistance() :
+	ModuleParams(nullptr),
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::navigation_and_controllers)
+{
+	_obstacle_distance.frame = obstacle_distance_s::MAV_FRAME_BODY_FRD;
+	_obstacle_distance.increment = BIN_INCREMENT_DEG;
+	_obstacle_distance.angle_offset = 0.f;
+}
+
+VehicleObstacleDistance::~VehicleObstacleDistance()
+{
+	Stop();
+
+	perf_free(_cycle_perf);
+}
+
+bool VehicleObstacleDistance::Start()
+{
+	const float rate_hz = _param_sens_obst_rate.get();
+
+	if (rate_hz > 0.f) {
+		ScheduleOnInterval(1e6f / math::constrain(rate_hz, 1.f, 50.f));
+	}
+
+	return true;
+}
+
+void VehicleObstacleDistance::Stop()
+{
+	Deinit();
+}
+
+void VehicleObstacleDistance::ParametersUpdate()
+{
+	// Check if parameters have changed
+	if (_params_sub.updated()) {
+		// clear update
+		parameter_update_s param_update;
+		_params_sub.copy(&param_update);
+
+		updateParams();
+	}
+}
+
+void VehicleObstacleDistance::Run()
+{
+	perf_begin(_cycle_perf);
+
+	ParametersUpdate();
+
+	vehicle_attitude_s vehicle_attitude;
+
+	if (_vehicle_attitude_sub.update(&vehicle_attitude)) {
+		_attitude = Quatf(vehicle_attitude.q);
+	}
+
+	// start over every cycle, only the latest reading of each sensor is used
+	_obstacle_distance.timestamp = 0;
+	_obstacle_distance.min_distance = UINT16_MAX;
+	_obstacle_distance.max_distance = 0;
+
+	for (int i = 0; i < BIN_COUNT; i++) {
+		_obstacle_distance.distances[i] = UINT16_MAX;
+		_bin_sensor_range[i] = 0;
+	}
+
+	const hrt_abstime now = hrt_absolute_time();
+	uint8_t sensor_count = 0;
+
+	for (auto &sub : _distance_sensor_sub) {
+		distance_sensor_s distance_sensor;
+
+		// consider only instances with recent data and orientations useful for collision prevention
+		if (sub.copy(&distance_sensor)
+		    && (now < distance_sensor.timestamp + SENSOR_TIMEOUT)
+		    && (distance_sensor.orientation != distance_sensor_s::ROTATION_DOWNWARD_FACING)
+		    && (distance_sensor.orientation != distance_sensor_s::ROTATION_UPWARD_FACING)) {
+
+			_obstacle_distance.timestamp = math::max(_obstacle_distance.timestamp, distance_sensor.timestamp);
+			_obstacle_distance.max_distance = math::max(_obstacle_distance.max_distance,
+							  (uint16_t)(distance_sensor.max_distance * 100.f));
+			_obstacle_distance.min_distance = math::min(_obstacle_distance.min_distance,
+							  (uint16_t)(distance_sensor.min_distance * 100.f));
+
+			AddDistanceSensor(distance_sensor, _attitude);
+			sensor_count++;
+		}
+	}
+
+	_sensor_count = sensor_count;
+
+	if (sensor_count > 0) {
+		_obstacle_distance_pub.publish(_obstacle_distance);
+	}
+
+	perf_end(_cycle_perf);
+}
+
+void VehicleObstacleDistance::AddDistanceSensor(const distance_sensor_s &distance_sensor, const Quatf &attitude)
+{
+	// clamp at maximum sensor range
+	float distance_reading = math::min(distance_sensor.current_distance, distance_sensor.max_distance);
+
+	// discard values below min range
+	if (distance_reading <= distance_sensor.min_distance) {
+		return;
+	}
+
+	const float sensor_yaw_body_rad = SensorYawOffset(distance_sensor);
+	const float sensor_yaw_body_deg = math::degrees(wrap_2pi(sensor_yaw_body_rad));
+	const float half_fov_deg = math::degrees(distance_sensor.h_fov / 2.f);
+
+	// calculate the field of view boundary bin indices
+	int lower_bound = (int)floorf((sensor_yaw_body_deg - half_fov_deg) / BIN_INCREMENT_DEG);
+	int upper_bound = (int)floorf((sensor_yaw_body_deg + half_fov_deg) / BIN_INCREMENT_DEG);
+
+	// floor values above zero, ceil values below zero
+	if (lower_bound < 0) { lower_bound++; }
+
+	if (upper_bound < 0) { upper_bound++; }
+
+	// project the reading into the horizontal plane, using the pitch in the sensor direction
+	Quatf attitude_sensor_frame = attitude;
+	attitude_sensor_frame.rotate(Vector3f(0.f, 0.f, sensor_yaw_body_rad));
+
+	if (distance_reading < distance_sensor.max_distance) {
+		distance_reading *= cosf(Eulerf(attitude_sensor_frame).theta());
+	}
+
+	const uint16_t sensor_range_cm = static_cast<uint16_t>(100.f * distance_sensor.max_distance + 0.5f);
+	const uint16_t reading_cm = static_cast<uint16_t>(100.f * distance_reading + 0.5f);
+
+	for (int bin = lower_bound; bin <= upper_bound; bin++) {
+		int wrapped_bin = bin % BIN_COUNT;
+
+		if (wrapped_bin < 0) {
+			wrapped_bin += BIN_COUNT;
+		}
+
+		if (EnterData(wrapped_bin, sensor_range_cm, reading_cm)) {
+			_obstacle_distance.distances[wrapped_bin] = reading_cm;
+			_bin_sensor_range[wrapped_bin] = sensor_range_cm;
+		}
+	}
+}
+
+bool VehicleObstacleDistance::EnterData(int bin, uint16_t sensor_range_cm, uint16_t reading_cm) const
+{
+	const uint16_t bin_distance = _obstacle_distance.distances[bin];
+	const uint16_t bin_range = _bin_sensor_range[bin];
+
+	// same rules as CollisionPrevention::_enterData(), use the reading if:
+	// 1. it is in range, and the bin contains a valid reading of a sensor with the same or a longer range
+	// 2. it is in range, and the bin reading is out of range (or empty)
+	// 3. it is out of range, the bin reading as well and this is the sensor with the longest range
+	// 4. it is out of range, and the bin contains a valid reading of a sensor with the same range
+	if (reading_cm < sensor_range_cm) {
+		return (bin_distance >= bin_range) || (sensor_range_cm <= bin_range);
+
+	} else {
+		return ((bin_distance >= bin_range) && (sensor_range_cm >= bin_range))
+		       || ((bin_distance < bin_range) && (sensor_range_cm == bin_range));
+	}
+}
+
+float VehicleObstacleDistance::SensorYawOffset(const distance_sensor_s &distance_sensor)
+{
+	switch (distance_sensor.orientation) {
+	case distance_sensor_s::ROTATION_YAW_45: return M_PI_F / 4.f;
+
+	case distance_sensor_s::ROTATION_YAW_90: return M_PI_F / 2.f;
+
+	case distance_sensor_s::ROTATION_YAW_135: return 3.f * M_PI_F / 4.f;
+
+	case distance_sensor_s::ROTATION_YAW_180: return M_PI_F;
+
+	case distance_sensor_s::ROTATION_YAW_225: return -3.f * M_PI_F / 4.f;
+
+	case distance_sensor_s::ROTATION_YAW_270: return -M_PI_F / 2.f;
+
+	case distance_sensor_s::ROTATION_YAW_315: return -M_PI_F / 4.f;
+
+	case distance_sensor_s::ROTATION_CUSTOM: return Eulerf(Quatf(distance_sensor.q)).psi();
+
+	default: return 0.f;
+	}
+}
+
+void VehicleObstacleDistance::PrintStatus()
+{
+	if (_param_sens_obst_rate.get() > 0.f) {
+		PX4_INFO("obstacle distance: %d distance sensors binned at %.1f Hz", _sensor_count,
+			 (double)_param_sens_obst_rate.get());
+		perf_print_counter(_cycle_perf);
+
+	} else {
+		PX4_INFO("obstacle distance: disabled");
+	}
+}
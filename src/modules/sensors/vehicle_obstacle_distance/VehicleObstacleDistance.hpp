@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <drivers/drv_hrt.h>
+#include <lib/matrix/matrix/math.hpp>
+#include <lib/perf/perf_counter.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module_params.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/topics/distance_sensor.h>
+#include <uORB/topics/obstacle_distance.h>
+#include <uORB/topics/parameter_update.h>
+#include <uORB/topics/vehicle_attitude.h>
+
+/**
+ * Bins the horizontal distance sensors (distance_sensor) into a single body frame
+ * obstacle_distance_rangefinder at a fixed rate (SENS_OBST_RATE), so that consumers like
+ * collision prevention process one message per cycle instead of every sensor sample.
+ */
+class VehicleObstacleDistance : public ModuleParams, public px4::ScheduledWorkItem
+{
+public:
+
+	VehicleObstacleDistance();
+	~VehicleObstacleDistance() override;
+
+	bool Start();
+	void Stop();
+
+	void PrintStatus();
+
+private:
+	void Run() override;
+
+	void ParametersUpdate();
+
+	/**
+	 * Enter the reading of a distance sensor into all bins of its field of view.
+	 */
+	void AddDistanceSensor(const distance_sensor_s &distance_sensor, const matrix::Quatf &attitude);
+
+	/**
+	 * Decide if a reading replaces the current content of a bin (preferring valid readings
+	 * and among those the ones from sensors with a shorter range).
+	 */
+	bool EnterData(int bin, uint16_t sensor_range_cm, uint16_t reading_cm) const;
+
+	static float SensorYawOffset(const distance_sensor_s &distance_sensor);
+
+	static constexpr int MAX_SENSOR_COUNT = 4;
+
+	static constexpr int BIN_COUNT = sizeof(obstacle_distance_s::distances) / sizeof(obstacle_distance_s::distances[0]);
+	static constexpr int BIN_INCREMENT_DEG = 360 / BIN_COUNT;
+	static_assert(360 % BIN_COUNT == 0, "the bins must cover 360 degrees evenly");
+
+	DEFINE_PARAMETERS(
+		(ParamFloat<px4::params::SENS_OBST_RATE>) _param_sens_obst_rate
+	)
+
+	uORB::Publication<obstacle_distance_s> _obstacle_distance_pub{ORB_ID(obstacle_distance_rangefinder)};
+
+	uORB::Subscription _params_sub{ORB_ID(parameter_update)};
+	uORB::Subscription _vehicle_attitude_sub{ORB_ID(vehicle_attitude)};
+
+	uORB::Subscription _distance_sensor_sub[MAX_SENSOR_COUNT] {
+		{ORB_ID(distance_sensor), 0},
+		{ORB_ID(distance_sensor), 1},
+		{ORB_ID(distance_sensor), 2},
+		{ORB_ID(distance_sensor), 3}
+	};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": obstacle distance cycle")};
+
+	obstacle_distance_s _obstacle_distance{};
+	uint16_t _bin_sensor_range[BIN_COUNT] {};	///< range of the sensor the bin reading comes from [cm]
+
+	matrix::Quatf _attitude{};
+
+	uint8_t _sensor_count{0};			///< sensors used in the last cycle
+};
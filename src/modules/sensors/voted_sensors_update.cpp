@@ -45,7 +45,6 @@
 #include <conversion/rotation.h>
 #include <ecl/geo/geo.h>
 
-#define MAG_ROT_VAL_INTERNAL		-1
 #define CAL_ERROR_APPLY_CAL_MSG "FAILED APPLYING %s CAL #%u"
 
 using namespace sensors;
@@ -53,7 +52,7 @@ using namespace matrix;
 using math::radians;
 
 VotedSensorsUpdate::VotedSensorsUpdate(const Parameters &parameters, bool hil_enabled)
-	: ModuleParams(nullptr), _parameters(parameters), _hil_enabled(hil_enabled), _mag_compensator(this)
+	: ModuleParams(nullptr), _parameters(parameters), _hil_enabled(hil_enabled)
 {
 	for (unsigned i = 0; i < 3; i++) {
 		_corrections.gyro_scale_0[i] = 1.0f;
@@ -64,8 +63,7 @@ VotedSensorsUpdate::VotedSensorsUpdate(const Parameters &parameters, bool hil_en
 		_corrections.accel_scale_2[i] = 1.0f;
 	}
 
-	_mag.voter.set_timeout(300000);
-	_mag.voter.set_equal_value_threshold(1000);
+	correctionsUpdate();
 
 	if (_hil_enabled) { // HIL has less accurate timing so increase the timeouts a bit
 		_gyro.voter.set_timeout(500000);
@@ -89,7 +87,6 @@ void VotedSensorsUpdate::initializeSensors()
 {
 	initSensorClass(_gyro, GYRO_COUNT_MAX);
 	initSensorClass(_accel, ACCEL_COUNT_MAX);
-	initSensorClass(_mag, MAG_COUNT_MAX);
 }
 
 void VotedSensorsUpdate::parametersUpdate()
@@ -99,10 +96,7 @@ void VotedSensorsUpdate::parametersUpdate()
 
 	_board_rotation = board_rotation_offset * get_rot_matrix((enum Rotation)_parameters.board_rotation);
 
-	// initialze all mag rotations with the board rotation in case there is no calibration data available
-	for (int topic_instance = 0; topic_instance < MAG_COUNT_MAX; ++topic_instance) {
-		_mag_rotation[topic_instance] = _board_rotation;
-	}
+	correctionsUpdate();
 
 	updateParams();
 
@@ -309,164 +303,46 @@ void VotedSensorsUpdate::parametersUpdate()
 			(void)param_set(param_find(str), &device_id);
 		}
 	}
+}
 
-	/* run through all mag sensors
-	 * Because we store the device id in _mag_device_id, we need to get the id via uorb topic since
-	 * the DevHandle method does not work on POSIX.
-	 */
+void VotedSensorsUpdate::correctionsUpdate()
+{
+	const float *accel_offsets[] {_corrections.accel_offset_0, _corrections.accel_offset_1, _corrections.accel_offset_2};
+	const float *accel_scales[] {_corrections.accel_scale_0, _corrections.accel_scale_1, _corrections.accel_scale_2};
 
-	/* first we have to reset all possible mags, since we are looping through the uORB instances instead of the drivers,
-	 * and not all uORB instances have to be published yet at the initial call of parametersUpdate()
-	 */
-	for (int i = 0; i < MAG_COUNT_MAX; i++) {
-		_mag.enabled[i] = true;
+	for (int i = 0; i < ACCEL_COUNT_MAX; i++) {
+		_accel_correction[i] = _board_rotation * diag(Vector3f{accel_scales[i]});
+		_accel_correction_offset[i] = _accel_correction[i] * Vector3f{accel_offsets[i]};
 	}
 
-	for (int topic_instance = 0; topic_instance < MAG_COUNT_MAX
-	     && topic_instance < _mag.subscription_count; ++topic_instance) {
-
-		sensor_mag_s report{};
-
-		if (!_mag.subscription[topic_instance].copy(&report)) {
-			continue;
-		}
-
-		uint32_t topic_device_id = report.device_id;
-		bool is_external = report.is_external;
-		_mag_device_id[topic_instance] = topic_device_id;
-
-		// find the driver handle that matches the topic_device_id
-		int fd = -1;
-		char str[30] {};
-
-		for (unsigned driver_index = 0; driver_index < MAG_COUNT_MAX; ++driver_index) {
-
-			(void)sprintf(str, "%s%u", MAG_BASE_DEVICE_PATH, driver_index);
-
-			fd = px4_open(str, O_RDWR);
-
-			if (fd < 0) {
-				/* the driver is not running, continue with the next */
-				continue;
-			}
-
-			uint32_t driver_device_id = (uint32_t)px4_ioctl(fd, DEVIOCGDEVICEID, 0);
-
-			if (driver_device_id == topic_device_id) {
-				break; // we found the matching driver
-
-			} else {
-				px4_close(fd);
-			}
-		}
-
-		bool config_ok = false;
-
-		/* run through all stored calibrations */
-		for (unsigned i = 0; i < MAG_COUNT_MAX; i++) {
-			/* initially status is ok per config */
-			failed = false;
-
-			(void)sprintf(str, "CAL_MAG%u_ID", i);
-			int32_t device_id = 0;
-			failed = failed || (PX4_OK != param_get(param_find(str), &device_id));
-
-			(void)sprintf(str, "CAL_MAG%u_EN", i);
-			int32_t device_enabled = 1;
-			failed = failed || (PX4_OK != param_get(param_find(str), &device_enabled));
-
-			if (failed) {
-				continue;
-			}
-
-			/* if the calibration is for this device, apply it */
-			if ((uint32_t)device_id == _mag_device_id[topic_instance]) {
-				_mag.enabled[topic_instance] = (device_enabled == 1);
-				_mag.power_compensation[topic_instance] = {_parameters.mag_comp_paramX[i], _parameters.mag_comp_paramY[i], _parameters.mag_comp_paramZ[i]};
-
-				// the mags that were published after the initial parameterUpdate
-				// would be given the priority even if disabled. Reset it to 0 in this case
-				if (!_mag.enabled[topic_instance]) {
-					_mag.priority[topic_instance] = ORB_PRIO_UNINITIALIZED;
-				}
-
-				mag_calibration_s mscale{};
-
-				(void)sprintf(str, "CAL_MAG%u_XOFF", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.x_offset));
-
-				(void)sprintf(str, "CAL_MAG%u_YOFF", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.y_offset));
-
-				(void)sprintf(str, "CAL_MAG%u_ZOFF", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.z_offset));
-
-				(void)sprintf(str, "CAL_MAG%u_XSCALE", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.x_scale));
-
-				(void)sprintf(str, "CAL_MAG%u_YSCALE", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.y_scale));
-
-				(void)sprintf(str, "CAL_MAG%u_ZSCALE", i);
-				failed = failed || (PX4_OK != param_get(param_find(str), &mscale.z_scale));
-
-				(void)sprintf(str, "CAL_MAG%u_ROT", i);
-				int32_t mag_rot = 0;
-				param_get(param_find(str), &mag_rot);
+	const float *gyro_offsets[] {_corrections.gyro_offset_0, _corrections.gyro_offset_1, _corrections.gyro_offset_2};
+	const float *gyro_scales[] {_corrections.gyro_scale_0, _corrections.gyro_scale_1, _corrections.gyro_scale_2};
 
-				if (is_external) {
-
-					/* check if this mag is still set as internal, otherwise leave untouched */
-					if (mag_rot < 0) {
-						/* it was marked as internal, change to external with no rotation */
-						mag_rot = 0;
-						param_set_no_notification(param_find(str), &mag_rot);
-					}
-
-				} else {
-					/* mag is internal - reset param to -1 to indicate internal mag */
-					if (mag_rot != MAG_ROT_VAL_INTERNAL) {
-						mag_rot = MAG_ROT_VAL_INTERNAL;
-						param_set_no_notification(param_find(str), &mag_rot);
-					}
-				}
-
-				/* now get the mag rotation */
-				if (mag_rot >= 0) {
-					// Set external magnetometers to use the parameter value
-					_mag_rotation[topic_instance] = get_rot_matrix((enum Rotation)mag_rot);
-
-				} else {
-					// Set internal magnetometers to use the board rotation
-					_mag_rotation[topic_instance] = _board_rotation;
-				}
-
-				if (failed) {
-					PX4_ERR(CAL_ERROR_APPLY_CAL_MSG, "mag", i);
-
-				} else {
-
-					/* apply new scaling and offsets */
-					config_ok = (px4_ioctl(fd, MAGIOCSSCALE, (long unsigned int)&mscale) == 0);
+	for (int i = 0; i < GYRO_COUNT_MAX; i++) {
+		_gyro_correction[i] = _board_rotation * diag(Vector3f{gyro_scales[i]});
+		_gyro_correction_offset[i] = _gyro_correction[i] * Vector3f{gyro_offsets[i]};
+	}
+}
 
-					if (!config_ok) {
-						PX4_ERR(CAL_ERROR_APPLY_CAL_MSG, "mag ", i);
-					}
-				}
+bool VotedSensorsUpdate::vote(SensorData &sensor, bool updated, int &best_index)
+{
+	// fallback rate if nothing is publishing, so that the voter still reports a loss of all sensors
+	static constexpr hrt_abstime VOTE_INTERVAL_MAX = 100000;
 
-				break;
-			}
-		}
+	const hrt_abstime now = hrt_absolute_time();
 
-		px4_close(fd);
+	if (updated || (now - sensor.last_vote > VOTE_INTERVAL_MAX)) {
+		sensor.voter.get_best(now, &best_index);
+		sensor.last_vote = now;
+		return true;
 	}
 
+	return false;
 }
 
 void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
 {
-	float *offsets[] = {_corrections.accel_offset_0, _corrections.accel_offset_1, _corrections.accel_offset_2 };
-	float *scales[] = {_corrections.accel_scale_0, _corrections.accel_scale_1, _corrections.accel_scale_2 };
+	bool updated = false;
 
 	for (int uorb_index = 0; uorb_index < _accel.subscription_count; uorb_index++) {
 
@@ -489,17 +365,12 @@ void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
 
 			// convert the delta velocities to an equivalent acceleration before application of corrections
 			const float dt_inv = 1.e6f / (float)accel_report.dt;
-			Vector3f accel_data = Vector3f{accel_report.delta_velocity} * dt_inv;
 
 			_last_sensor_data[uorb_index].accelerometer_integral_dt = accel_report.dt;
 
-			// apply temperature compensation
-			accel_data(0) = (accel_data(0) - offsets[uorb_index][0]) * scales[uorb_index][0]; // X
-			accel_data(1) = (accel_data(1) - offsets[uorb_index][1]) * scales[uorb_index][1]; // Y
-			accel_data(2) = (accel_data(2) - offsets[uorb_index][2]) * scales[uorb_index][2]; // Z
-
-			// rotate corrected measurements from sensor to body frame
-			accel_data = _board_rotation * accel_data;
+			// apply temperature compensation and rotate from sensor to body frame in one step
+			const Vector3f accel_data{_accel_correction[uorb_index] * (Vector3f{accel_report.delta_velocity} * dt_inv)
+						  - _accel_correction_offset[uorb_index]};
 
 			_last_sensor_data[uorb_index].accelerometer_m_s2[0] = accel_data(0);
 			_last_sensor_data[uorb_index].accelerometer_m_s2[1] = accel_data(1);
@@ -530,15 +401,16 @@ void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
 			_last_accel_timestamp[uorb_index] = accel_report.timestamp;
 			_accel.voter.put(uorb_index, accel_report.timestamp, _last_sensor_data[uorb_index].accelerometer_m_s2,
 					 accel_report.error_count, _accel.priority[uorb_index]);
+
+			updated = true;
 		}
 	}
 
 	// find the best sensor
-	int best_index;
-	_accel.voter.get_best(hrt_absolute_time(), &best_index);
+	int best_index = -1;
 
 	// write the best sensor data to the output variables
-	if (best_index >= 0) {
+	if (vote(_accel, updated, best_index) && (best_index >= 0)) {
 		raw.accelerometer_integral_dt = _last_sensor_data[best_index].accelerometer_integral_dt;
 		memcpy(&raw.accelerometer_m_s2, &_last_sensor_data[best_index].accelerometer_m_s2, sizeof(raw.accelerometer_m_s2));
 
@@ -557,8 +429,7 @@ void VotedSensorsUpdate::accelPoll(struct sensor_combined_s &raw)
 
 void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
 {
-	float *offsets[] = {_corrections.gyro_offset_0, _corrections.gyro_offset_1, _corrections.gyro_offset_2 };
-	float *scales[] = {_corrections.gyro_scale_0, _corrections.gyro_scale_1, _corrections.gyro_scale_2 };
+	bool updated = false;
 
 	for (int uorb_index = 0; uorb_index < _gyro.subscription_count; uorb_index++) {
 		sensor_gyro_integrated_s gyro_report;
@@ -580,17 +451,12 @@ void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
 
 			// convert the delta angles to an equivalent angular rate before application of corrections
 			const float dt_inv = 1.e6f / (float)gyro_report.dt;
-			Vector3f gyro_rate = Vector3f{gyro_report.delta_angle} * dt_inv;
 
 			_last_sensor_data[uorb_index].gyro_integral_dt = gyro_report.dt;
 
-			// apply temperature compensation
-			gyro_rate(0) = (gyro_rate(0) - offsets[uorb_index][0]) * scales[uorb_index][0]; // X
-			gyro_rate(1) = (gyro_rate(1) - offsets[uorb_index][1]) * scales[uorb_index][1]; // Y
-			gyro_rate(2) = (gyro_rate(2) - offsets[uorb_index][2]) * scales[uorb_index][2]; // Z
-
-			// rotate corrected measurements from sensor to body frame
-			gyro_rate = _board_rotation * gyro_rate;
+			// apply temperature compensation and rotate from sensor to body frame in one step
+			const Vector3f gyro_rate{_gyro_correction[uorb_index] * (Vector3f{gyro_report.delta_angle} * dt_inv)
+						 - _gyro_correction_offset[uorb_index]};
 
 			_last_sensor_data[uorb_index].gyro_rad[0] = gyro_rate(0);
 			_last_sensor_data[uorb_index].gyro_rad[1] = gyro_rate(1);
@@ -599,15 +465,16 @@ void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
 			_last_sensor_data[uorb_index].timestamp = gyro_report.timestamp_sample;
 			_gyro.voter.put(uorb_index, gyro_report.timestamp, _last_sensor_data[uorb_index].gyro_rad,
 					gyro_report.error_count, _gyro.priority[uorb_index]);
+
+			updated = true;
 		}
 	}
 
 	// find the best sensor
-	int best_index;
-	_gyro.voter.get_best(hrt_absolute_time(), &best_index);
+	int best_index = -1;
 
 	// write data for the best sensor to output variables
-	if (best_index >= 0) {
+	if (vote(_gyro, updated, best_index) && (best_index >= 0)) {
 		raw.timestamp = _last_sensor_data[best_index].timestamp;
 		raw.gyro_integral_dt = _last_sensor_data[best_index].gyro_integral_dt;
 		memcpy(&raw.gyro_rad, &_last_sensor_data[best_index].gyro_rad, sizeof(raw.gyro_rad));
@@ -623,49 +490,6 @@ void VotedSensorsUpdate::gyroPoll(struct sensor_combined_s &raw)
 	}
 }
 
-void VotedSensorsUpdate::magPoll(vehicle_magnetometer_s &magnetometer)
-{
-	for (int uorb_index = 0; uorb_index < _mag.subscription_count; uorb_index++) {
-		sensor_mag_s mag_report;
-
-		if (_mag.enabled[uorb_index] && _mag.subscription[uorb_index].update(&mag_report)) {
-
-			// First publication with data
-			if (_mag.priority[uorb_index] == 0) {
-				_mag.priority[uorb_index] = _mag.subscription[uorb_index].get_priority();
-			}
-
-			Vector3f vect(mag_report.x, mag_report.y, mag_report.z);
-
-			//throttle-/current-based mag compensation
-			_mag_compensator.calculate_mag_corrected(vect, _mag.power_compensation[uorb_index]);
-
-			vect = _mag_rotation[uorb_index] * vect;
-
-			_last_magnetometer[uorb_index].timestamp = mag_report.timestamp;
-			_last_magnetometer[uorb_index].magnetometer_ga[0] = vect(0);
-			_last_magnetometer[uorb_index].magnetometer_ga[1] = vect(1);
-			_last_magnetometer[uorb_index].magnetometer_ga[2] = vect(2);
-
-			_mag.voter.put(uorb_index, mag_report.timestamp, _last_magnetometer[uorb_index].magnetometer_ga, mag_report.error_count,
-				       _mag.priority[uorb_index]);
-		}
-	}
-
-	int best_index;
-	_mag.voter.get_best(hrt_absolute_time(), &best_index);
-
-	if (best_index >= 0) {
-		magnetometer = _last_magnetometer[best_index];
-		_mag.last_best_vote = (uint8_t)best_index;
-
-		if (_selection.mag_device_id != _mag_device_id[best_index]) {
-			_selection_changed = true;
-			_selection.mag_device_id = _mag_device_id[best_index];
-		}
-	}
-}
-
 bool VotedSensorsUpdate::checkFailover(SensorData &sensor, const char *sensor_name, const uint64_t type)
 {
 	if (sensor.last_failover_count != sensor.voter.failover_count() && !_hil_enabled) {
@@ -711,8 +535,6 @@ bool VotedSensorsUpdate::checkFailover(SensorData &sensor, const char *sensor_na
 						if (type == subsystem_info_s::SUBSYSTEM_TYPE_GYRO) { _info.subsystem_type = subsystem_info_s::SUBSYSTEM_TYPE_GYRO2; }
 
 						if (type == subsystem_info_s::SUBSYSTEM_TYPE_ACC) { _info.subsystem_type = subsystem_info_s::SUBSYSTEM_TYPE_ACC2; }
-
-						if (type == subsystem_info_s::SUBSYSTEM_TYPE_MAG) { _info.subsystem_type = subsystem_info_s::SUBSYSTEM_TYPE_MAG2; }
 					}
 
 					_info.timestamp = hrt_absolute_time();
@@ -773,17 +595,16 @@ void VotedSensorsUpdate::printStatus()
 	_gyro.voter.print();
 	PX4_INFO("accel status:");
 	_accel.voter.print();
-	PX4_INFO("mag status:");
-	_mag.voter.print();
 }
 
-void VotedSensorsUpdate::sensorsPoll(sensor_combined_s &raw, vehicle_magnetometer_s &magnetometer)
+void VotedSensorsUpdate::sensorsPoll(sensor_combined_s &raw)
 {
-	_corrections_sub.update(&_corrections);
+	if (_corrections_sub.update(&_corrections)) {
+		correctionsUpdate();
+	}
 
 	accelPoll(raw);
 	gyroPoll(raw);
-	magPoll(magnetometer);
 
 	// publish sensor selection if changed
 	if (_selection_changed) {
@@ -799,7 +620,6 @@ void VotedSensorsUpdate::checkFailover()
 {
 	checkFailover(_accel, "Accel", subsystem_info_s::SUBSYSTEM_TYPE_ACC);
 	checkFailover(_gyro, "Gyro", subsystem_info_s::SUBSYSTEM_TYPE_GYRO);
-	checkFailover(_mag, "Mag", subsystem_info_s::SUBSYSTEM_TYPE_MAG);
 }
 
 void VotedSensorsUpdate::setRelativeTimestamps(sensor_combined_s &raw)
@@ -909,47 +729,3 @@ void VotedSensorsUpdate::calcGyroInconsistency(sensor_preflight_s &preflt)
 	}
 }
 
-void VotedSensorsUpdate::calcMagInconsistency(sensor_preflight_s &preflt)
-{
-	Vector3f primary_mag(_last_magnetometer[_mag.last_best_vote].magnetometer_ga); // primary mag field vector
-	float mag_angle_diff_max = 0.0f; // the maximum angle difference
-	unsigned check_index = 0; // the number of sensors the primary has been checked against
-
-	// Check each sensor against the primary
-	for (int i = 0; i < _mag.subscription_count; i++) {
-		// check that the sensor we are checking against is not the same as the primary
-		if (_mag.enabled[i] && (_mag.priority[i] > 0) && (i != _mag.last_best_vote)) {
-			// calculate angle to 3D magnetic field vector of the primary sensor
-			Vector3f current_mag(_last_magnetometer[i].magnetometer_ga);
-			float angle_error = AxisAnglef(Quatf(current_mag, primary_mag)).angle();
-
-			// complementary filter to not fail/pass on single outliers
-			_mag_angle_diff[check_index] *= 0.95f;
-			_mag_angle_diff[check_index] += 0.05f * angle_error;
-
-			mag_angle_diff_max = math::max(mag_angle_diff_max, _mag_angle_diff[check_index]);
-
-			// increment the check index
-			check_index++;
-		}
-
-		// check to see if the maximum number of checks has been reached and break
-		if (check_index >= 2) {
-			break;
-		}
-	}
-
-	// get the vector length of the largest difference and write to the combined sensor struct
-	// will be zero if there is only one magnetometer and hence nothing to compare
-	preflt.mag_inconsistency_angle = mag_angle_diff_max;
-}
-
-void VotedSensorsUpdate::update_mag_comp_armed(bool armed)
-{
-	_mag_compensator.update_armed_flag(armed);
-}
-
-void VotedSensorsUpdate::update_mag_comp_power(float power)
-{
-	_mag_compensator.update_power(power);
-}
@@ -43,7 +43,6 @@
 
 #include <drivers/drv_accel.h>
 #include <drivers/drv_gyro.h>
-#include <drivers/drv_mag.h>
 #include <drivers/drv_hrt.h>
 
 #include <mathlib/mathlib.h>
@@ -51,7 +50,8 @@
 
 #include <lib/ecl/validation/data_validator.h>
 #include <lib/ecl/validation/data_validator_group.h>
-#include <lib/mag_compensation/MagCompensation.hpp>
+
+#include <px4_platform_common/module_params.h>
 
 #include <uORB/Publication.hpp>
 #include <uORB/Subscription.hpp>
@@ -61,7 +61,6 @@
 #include <uORB/topics/sensor_correction.h>
 #include <uORB/topics/sensor_gyro_integrated.h>
 #include <uORB/topics/sensor_selection.h>
-#include <uORB/topics/vehicle_magnetometer.h>
 #include <uORB/topics/subsystem_info.h>
 
 #include "common.h"
@@ -105,7 +104,7 @@ public:
 	/**
 	 * read new sensor data
 	 */
-	void sensorsPoll(sensor_combined_s &raw, vehicle_magnetometer_s &magnetometer);
+	void sensorsPoll(sensor_combined_s &raw);
 
 	/**
 	 * set the relative timestamps of each sensor timestamp, based on the last sensorsPoll,
@@ -130,22 +129,6 @@ public:
 	 */
 	void calcGyroInconsistency(sensor_preflight_s &preflt);
 
-	/**
-	 * Calculates the magnitude in Gauss of the largest difference between the primary and any other magnetometers
-	 */
-	void calcMagInconsistency(sensor_preflight_s &preflt);
-
-	/**
-	 * Update armed flag for mag compensation.
-	 */
-	void update_mag_comp_armed(bool armed);
-
-	/**
-	 * Update power signal for mag compensation.
-	 * power: either throttle value [0,1] or current measurement in [kA]
-	 */
-	void update_mag_comp_power(float power);
-
 private:
 
 	struct SensorData {
@@ -160,9 +143,22 @@ private:
 		uint8_t subscription_count{0};
 		bool enabled[SENSOR_COUNT_MAX] {true, true, true, true};
 		bool advertised[SENSOR_COUNT_MAX] {false, false, false, false};
-		matrix::Vector3f power_compensation[SENSOR_COUNT_MAX];
+		hrt_abstime last_vote{0}; /**< time of the last voter evaluation */
 	};
 
+	/**
+	 * Precompute the per instance thermal corrections combined with the board rotation,
+	 * call whenever the corrections or the board rotation change.
+	 */
+	void correctionsUpdate();
+
+	/**
+	 * Evaluate the voter and return the best instance, only if new data arrived or as a
+	 * periodic fallback so that timeouts are still detected if all sensors stop publishing.
+	 * @return true if the voter was evaluated
+	 */
+	bool vote(SensorData &sensor, bool updated, int &best_index);
+
 	void initSensorClass(SensorData &sensor_data, uint8_t sensor_count_max);
 
 	/**
@@ -181,14 +177,6 @@ private:
 	 */
 	void gyroPoll(sensor_combined_s &raw);
 
-	/**
-	 * Poll the magnetometer for updated data.
-	 *
-	 * @param raw	Combined sensor data structure into which
-	 *		data should be returned.
-	 */
-	void magPoll(vehicle_magnetometer_s &magnetometer);
-
 	/**
 	 * Check & handle failover of a sensor
 	 * @return true if a switch occured (could be for a non-critical reason)
@@ -197,7 +185,6 @@ private:
 
 	SensorData _accel{ORB_ID::sensor_accel_integrated};
 	SensorData _gyro{ORB_ID::sensor_gyro_integrated};
-	SensorData _mag{ORB_ID::sensor_mag};
 
 	orb_advert_t _mavlink_log_pub{nullptr};
 
@@ -208,10 +195,14 @@ private:
 	uORB::Subscription _corrections_sub{ORB_ID(sensor_correction)};
 
 	sensor_combined_s _last_sensor_data[SENSOR_COUNT_MAX] {};	/**< latest sensor data from all sensors instances */
-	vehicle_magnetometer_s _last_magnetometer[SENSOR_COUNT_MAX] {}; /**< latest sensor data from all sensors instances */
 
 	matrix::Dcmf _board_rotation {};		/**< rotation matrix for the orientation that the board is mounted */
-	matrix::Dcmf _mag_rotation[MAG_COUNT_MAX] {};	/**< rotation matrix for the orientation that the external mag0 is mounted */
+
+	/* per instance thermal scale and offset combined with the board rotation: corrected = M * raw - M * offset */
+	matrix::Matrix3f _accel_correction[ACCEL_COUNT_MAX] {};
+	matrix::Vector3f _accel_correction_offset[ACCEL_COUNT_MAX] {};
+	matrix::Matrix3f _gyro_correction[GYRO_COUNT_MAX] {};
+	matrix::Vector3f _gyro_correction_offset[GYRO_COUNT_MAX] {};
 
 	const Parameters &_parameters;
 	const bool _hil_enabled{false};			/**< is hardware-in-the-loop mode enabled? */
@@ -220,14 +211,9 @@ private:
 
 	float _accel_diff[3][2] {};			/**< filtered accel differences between IMU units (m/s/s) */
 	float _gyro_diff[3][2] {};			/**< filtered gyro differences between IMU uinits (rad/s) */
-	float _mag_angle_diff[2] {};			/**< filtered mag angle differences between sensor instances (Ga) */
-
-	/* Magnetometer interference compensation */
-	MagCompensator _mag_compensator;
 
 	uint32_t _accel_device_id[SENSOR_COUNT_MAX] {};	/**< accel driver device id for each uorb instance */
 	uint32_t _gyro_device_id[SENSOR_COUNT_MAX] {};	/**< gyro driver device id for each uorb instance */
-	uint32_t _mag_device_id[SENSOR_COUNT_MAX] {};	/**< mag driver device id for each uorb instance */
 
 	uint64_t _last_accel_timestamp[ACCEL_COUNT_MAX] {};	/**< latest full timestamp */
 
@@ -292,17 +292,106 @@ void Sih::equations_of_motion()
 		_w_B.setZero();
 		_grounded = true;
 
+	} else if (static_cast<Integrator>(_sih_integ.get()) == Integrator::RK4) {
+		const int steps = math::constrain((int)_sih_integ_steps.get(), 1, 10);
+
+		for (int i = 0; i < steps; i++) {
+			integrate_rk4(_dt / steps);
+		}
+
+		_grounded = false;
+
 	} else {
 		// integration: Euler forward
-		_p_I = _p_I + _p_I_dot * _dt;
-		_v_I = _v_I + _v_I_dot * _dt;
-		_q = _q + _q_dot * _dt; // as given in attitude_estimator_q_main.cpp
-		_q.normalize();
-		_w_B = _w_B + _w_B_dot * _dt;
+		const int steps = math::constrain((int)_sih_integ_steps.get(), 1, 10);
+		const float dt = _dt / steps;
+
+		for (int i = 0; i < steps; i++) {
+			if (i > 0) {
+				_C_IB = _q.to_dcm();
+				_Fa_I = -_KDV * _v_I;
+				_Ma_B = -_KDW * _w_B;
+				_p_I_dot = _v_I;
+				_v_I_dot = (_W_I + _Fa_I + _C_IB * _T_B) / _MASS;
+				_q_dot = _q.derivative1(_w_B);
+				_w_B_dot = _Im1 * (_Mt_B + _Ma_B - _w_B.cross(_I * _w_B));
+			}
+
+			_p_I = _p_I + _p_I_dot * dt;
+			_v_I = _v_I + _v_I_dot * dt;
+			_q = _q + _q_dot * dt; // as given in attitude_estimator_q_main.cpp
+			_q.normalize();
+			_w_B = _w_B + _w_B_dot * dt;
+		}
+
 		_grounded = false;
 	}
 }
 
+// state differential for the Runge-Kutta integration, the motor forces are held constant over the step
+void Sih::state_derivative(const float x[STATE_SIZE], float x_dot[STATE_SIZE]) const
+{
+	const Vector3f v_I(&x[3]);
+	Quatf q(&x[6]);
+	q.normalize();
+	const Vector3f w_B(&x[10]);
+
+	const Vector3f v_I_dot = (_W_I - _KDV * v_I + Dcmf(q) * _T_B) / _MASS;
+	const Quatf q_dot = q.derivative1(w_B);
+	const Vector3f w_B_dot = _Im1 * (_Mt_B - _KDW * w_B - w_B.cross(_I * w_B));
+
+	v_I.copyTo(&x_dot[0]);
+	v_I_dot.copyTo(&x_dot[3]);
+	q_dot.copyTo(&x_dot[6]);
+	w_B_dot.copyTo(&x_dot[10]);
+}
+
+// integrate one Runge-Kutta 4 step, the state is kept in flat arrays so the stage updates vectorize
+void Sih::integrate_rk4(float dt)
+{
+	float x[STATE_SIZE];
+	float x_tmp[STATE_SIZE];
+	float k1[STATE_SIZE];
+	float k2[STATE_SIZE];
+	float k3[STATE_SIZE];
+	float k4[STATE_SIZE];
+
+	_p_I.copyTo(&x[0]);
+	_v_I.copyTo(&x[3]);
+	_q.copyTo(&x[6]);
+	_w_B.copyTo(&x[10]);
+
+	state_derivative(x, k1);
+
+	for (int i = 0; i < STATE_SIZE; i++) {
+		x_tmp[i] = x[i] + 0.5f * dt * k1[i];
+	}
+
+	state_derivative(x_tmp, k2);
+
+	for (int i = 0; i < STATE_SIZE; i++) {
+		x_tmp[i] = x[i] + 0.5f * dt * k2[i];
+	}
+
+	state_derivative(x_tmp, k3);
+
+	for (int i = 0; i < STATE_SIZE; i++) {
+		x_tmp[i] = x[i] + dt * k3[i];
+	}
+
+	state_derivative(x_tmp, k4);
+
+	for (int i = 0; i < STATE_SIZE; i++) {
+		x[i] += dt / 6.0f * (k1[i] + 2.0f * k2[i] + 2.0f * k3[i] + k4[i]);
+	}
+
+	_p_I = Vector3f(&x[0]);
+	_v_I = Vector3f(&x[3]);
+	_q = Quatf(&x[6]);
+	_q.normalize();
+	_w_B = Vector3f(&x[10]);
+}
+
 // reconstruct the noisy sensor signals
 void Sih::reconstruct_sensors_signals()
 {
@@ -458,7 +547,8 @@ in order to incorporate the state estimator in the loop.
 ### Implementation
 The simulator implements the equations of motion using matrix algebra.
 Quaternion representation is used for the attitude.
-Forward Euler is used for integration.
+Forward Euler or Runge-Kutta 4 is used for integration (SIH_INTEG), optionally
+with several integration steps per loop (SIH_INTEG_STEPS).
 Most of the variables are declared global in the .hpp file to avoid stack overflow.
 
 
@@ -105,7 +105,7 @@ private:
 
 	// to publish the gps position
 	vehicle_gps_position_s				_vehicle_gps_pos{};
-	uORB::Publication<vehicle_gps_position_s>	_vehicle_gps_pos_pub{ORB_ID(vehicle_gps_position)};
+	uORB::Publication<vehicle_gps_position_s>	_vehicle_gps_pos_pub{ORB_ID(sensor_gps)};
 
 	// angular velocity groundtruth
 	vehicle_angular_velocity_s			_vehicle_angular_velocity_gt{};
@@ -128,12 +128,20 @@ private:
 	static constexpr float T1_K = T1_C - CONSTANTS_ABSOLUTE_NULL_CELSIUS;   // ground temperature in Kelvin
 	static constexpr float TEMP_GRADIENT  = -6.5f / 1000.0f;    // temperature gradient in degrees per metre
 	static constexpr hrt_abstime LOOP_INTERVAL = 4000;      // 4ms => 250 Hz real-time
+	static constexpr int STATE_SIZE = 13;                   // position (3), velocity (3), attitude (4), body rates (3)
+
+	enum class Integrator : int32_t {
+		EULER = 0,
+		RK4 = 1
+	};
 
 	void init_variables();
 	void init_sensors();
 	void read_motors();
 	void generate_force_and_torques();
 	void equations_of_motion();
+	void state_derivative(const float x[STATE_SIZE], float x_dot[STATE_SIZE]) const;
+	void integrate_rk4(float dt);
 	void reconstruct_sensors_signals();
 	void send_IMU();
 	void send_gps();
@@ -209,6 +217,8 @@ private:
 		(ParamFloat<px4::params::SIH_LOC_H0>) _sih_h0,
 		(ParamFloat<px4::params::SIH_LOC_MU_X>) _sih_mu_x,
 		(ParamFloat<px4::params::SIH_LOC_MU_Y>) _sih_mu_y,
-		(ParamFloat<px4::params::SIH_LOC_MU_Z>) _sih_mu_z
+		(ParamFloat<px4::params::SIH_LOC_MU_Z>) _sih_mu_z,
+		(ParamInt<px4::params::SIH_INTEG>) _sih_integ,
+		(ParamInt<px4::params::SIH_INTEG_STEPS>) _sih_integ_steps
 	)
 };
@@ -343,3 +343,30 @@ PARAM_DEFINE_FLOAT(SIH_LOC_MU_Y, -0.045f);
  * @group Simulation In Hardware
  */
 PARAM_DEFINE_FLOAT(SIH_LOC_MU_Z,  0.504f);
+
+/**
+ * Integration method
+ *
+ * Runge-Kutta 4 is more accurate for fast rotations and stiff
+ * vehicles, at about four times the computation of forward Euler.
+ *
+ * @value 0 Forward Euler
+ * @value 1 Runge-Kutta 4
+ * @reboot_required true
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_INTEG, 0);
+
+/**
+ * Number of integration steps per simulation loop
+ *
+ * The equations of motion are integrated with this many steps per
+ * simulation loop (250 Hz) with the motor signals held constant,
+ * e.g. 4 integrates at 1 kHz.
+ *
+ * @min 1
+ * @max 10
+ * @reboot_required true
+ * @group Simulation In Hardware
+ */
+PARAM_DEFINE_INT32(SIH_INTEG_STEPS, 1);
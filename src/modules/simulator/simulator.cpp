@@ -66,6 +66,15 @@ void Simulator::parameters_update(bool force)
 
 void Simulator::print_status()
 {
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+	if (_internal_clock) {
+		PX4_INFO("internal clock: time warp %.1f, %llu steps, %u idle timeouts", (double)_clock_time_warp,
+			 (unsigned long long)_clock_steps, _clock_idle_timeouts);
+	}
+
+#endif
+
 	PX4_INFO("accelerometer");
 	_px4_accel.print_status();
 
@@ -84,16 +93,35 @@ int Simulator::start(int argc, char *argv[])
 	_instance = new Simulator();
 
 	if (_instance) {
-		if (argc == 4 && strcmp(argv[2], "-u") == 0) {
-			_instance->set_ip(InternetProtocol::UDP);
-			_instance->set_port(atoi(argv[3]));
+		for (int i = 2; i + 1 < argc; i += 2) {
+			if (strcmp(argv[i], "-u") == 0) {
+				_instance->set_ip(InternetProtocol::UDP);
+				_instance->set_port(atoi(argv[i + 1]));
+
+			} else if (strcmp(argv[i], "-c") == 0) {
+				_instance->set_ip(InternetProtocol::TCP);
+				_instance->set_port(atoi(argv[i + 1]));
+
+			} else if (strcmp(argv[i], "-m") == 0) {
+				_instance->set_shm_name(argv[i + 1]);
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+			} else if (strcmp(argv[i], "-t") == 0) {
+				_instance->set_internal_clock(atof(argv[i + 1]));
+#endif
+			}
 		}
 
-		if (argc == 4 && strcmp(argv[2], "-c") == 0) {
-			_instance->set_ip(InternetProtocol::TCP);
-			_instance->set_port(atoi(argv[3]));
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+		if (_instance->_internal_clock) {
+			_instance->run_clock();
+			return 0;
 		}
 
+#endif
+
 		_instance->run();
 
 		return 0;
@@ -106,10 +134,12 @@ int Simulator::start(int argc, char *argv[])
 
 static void usage()
 {
-	PX4_INFO("Usage: simulator {start -[spt] [-u udp_port / -c tcp_port] |stop|status}");
+	PX4_INFO("Usage: simulator {start -[spt] [-u udp_port / -c tcp_port] [-m shm_name] |stop|status}");
 	PX4_INFO("Start simulator:     simulator start");
 	PX4_INFO("Connect using UDP: simulator start -u udp_port");
 	PX4_INFO("Connect using TCP: simulator start -c tcp_port");
+	PX4_INFO("Sensors and actuators on shared memory: simulator start -c tcp_port -m /px4_sim_0");
+	PX4_INFO("Internal clock (lockstep only), 0 runs as fast as possible: simulator start -t time_warp");
 }
 
 __BEGIN_DECLS
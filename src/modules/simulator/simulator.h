@@ -81,6 +81,8 @@
 #include <v2.0/mavlink_types.h>
 #include <lib/battery/battery.h>
 
+#include "simulator_shm.h"
+
 using namespace time_literals;
 
 //! Enumeration to use on the bitmask in HIL_SENSOR
@@ -125,6 +127,15 @@ public:
 
 	void set_ip(InternetProtocol ip) { _ip = ip; }
 	void set_port(unsigned port) { _port = port; }
+	void set_shm_name(const char *name) { strncpy(_shm_name, name, sizeof(_shm_name) - 1); }
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	/**
+	 * Use the internal clock instead of an external simulator (simulator_clock.cpp).
+	 * @param time_warp simulation time per real time, 0 to run each step as soon as everything is idle
+	 */
+	void set_internal_clock(float time_warp) { _internal_clock = true; _clock_time_warp = time_warp; }
+#endif
 
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	bool has_initialized() { return _has_initialized.load(); }
@@ -192,6 +203,17 @@ private:
 	hrt_abstime _last_sitl_timestamp{0};
 	hrt_abstime _last_battery_timestamp{0};
 
+	static constexpr int HIL_SENSOR_BATCH_MAX = 32; ///< maximum number of HIL_SENSOR messages handled per packet
+
+	mavlink_hil_sensor_t _hil_sensor_batch[HIL_SENSOR_BATCH_MAX] {};
+	int _hil_sensor_batch_count{0};
+
+	static constexpr int SHM_SPIN_COUNT = 1000; ///< yields without a sample before sleeping
+	static constexpr unsigned SHM_IDLE_SLEEP_US = 100;
+
+	char _shm_name[32] {}; ///< shared memory segment name, empty to use MAVLink only
+	simulator_shm_segment *_shm_segment{nullptr};
+
 	class SimulatorBattery : public Battery
 	{
 	public:
@@ -217,6 +239,7 @@ private:
 	} _battery;
 
 	void run();
+	void handle_hil_sensor_batch();
 	void handle_message(const mavlink_message_t *msg);
 	void handle_message_distance_sensor(const mavlink_message_t *msg);
 	void handle_message_hil_gps(const mavlink_message_t *msg);
@@ -239,6 +262,18 @@ private:
 
 	static void *sending_trampoline(void *);
 
+	// shared memory transport for sensors and actuators (simulator_shm.cpp)
+	int shm_open_segment();
+	void shm_receive();
+	void shm_send_controls(const mavlink_hil_actuator_controls_t &hil_act_control);
+
+	static void *shm_receiving_trampoline(void *);
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+	void run_clock();
+	void wait_for_idle();
+#endif
+
 	mavlink_hil_actuator_controls_t actuator_controls_from_outputs();
 
 
@@ -250,7 +285,7 @@ private:
 	uORB::Publication<input_rc_s>			_input_rc_pub{ORB_ID(input_rc)};
 
 	// HIL GPS
-	uORB::Publication<vehicle_gps_position_s>	_vehicle_gps_position_pub{ORB_ID(vehicle_gps_position)};
+	uORB::Publication<vehicle_gps_position_s>	_vehicle_gps_position_pub{ORB_ID(sensor_gps)};
 	std::default_random_engine _gen{};
 
 	// uORB subscription handlers
@@ -275,6 +310,15 @@ private:
 #if defined(ENABLE_LOCKSTEP_SCHEDULER)
 	px4::atomic<bool> _has_initialized {false};
 
+	// internal clock
+	static constexpr hrt_abstime CLOCK_STEP_US = 1000;
+	static constexpr int64_t CLOCK_IDLE_TIMEOUT_US = 1000000; ///< real time to wait for idle before stepping anyway
+
+	bool _internal_clock{false};
+	float _clock_time_warp{1.f};
+	uint64_t _clock_steps{0};
+	uint32_t _clock_idle_timeouts{0};
+
 	int _ekf2_timestamps_sub{-1};
 
 	enum class State {
@@ -0,0 +1,118 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file simulator_clock.cpp
+ *
+ * Internal lockstep clock, to run the stack without an external simulator
+ * (e.g. with sih providing the sensors) in real time, with a time warp, or as
+ * fast as possible.
+ */
+
+#include "simulator.h"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+#include <px4_platform_common/px4_work_queue/WorkQueueManager.hpp>
+
+#include <sched.h>
+
+#if defined(ENABLE_LOCKSTEP_SCHEDULER)
+
+static int64_t real_time_us()
+{
+	struct timespec ts;
+	system_clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+void Simulator::run_clock()
+{
+	if (_clock_time_warp > 0.f) {
+		PX4_INFO("Internal clock, time warp %.1f", (double)_clock_time_warp);
+
+	} else {
+		PX4_INFO("Internal clock, stepping when idle");
+	}
+
+	const int64_t start_us = real_time_us();
+	hrt_abstime time_us = 0;
+
+	while (true) {
+		time_us += CLOCK_STEP_US;
+
+		struct timespec ts;
+		abstime_to_ts(&ts, time_us);
+		px4_clock_settime(CLOCK_MONOTONIC, &ts);
+		_clock_steps++;
+
+		if (!_has_initialized.load()) {
+			_has_initialized.store(true);
+		}
+
+		if (_clock_time_warp > 0.f) {
+			// sleep in real time until the warped simulation time is reached
+			const int64_t wait_us = start_us + (int64_t)(time_us / _clock_time_warp) - real_time_us();
+
+			if (wait_us > 0) {
+				system_usleep(wait_us);
+			}
+
+		} else {
+			wait_for_idle();
+		}
+	}
+}
+
+void Simulator::wait_for_idle()
+{
+	// Everything woken up by the time step is done when the woken threads wait again
+	// and all work items they scheduled have run. Threads only woken by a publication
+	// (not by time) are covered if they are work items.
+	const int64_t start_us = real_time_us();
+
+	while (!(px4_lockstep_idle() && px4::WorkQueueManagerIdle())) {
+		sched_yield();
+
+		if (real_time_us() - start_us > CLOCK_IDLE_TIMEOUT_US) {
+			// a thread that keeps running (or blocks outside of the scheduler), step anyway
+			if (_clock_idle_timeouts++ == 0) {
+				PX4_WARN("not idle after %.1f s, the run may not be deterministic", (double)CLOCK_IDLE_TIMEOUT_US / 1e6);
+			}
+
+			break;
+		}
+	}
+}
+
+#endif // ENABLE_LOCKSTEP_SCHEDULER
@@ -67,7 +67,7 @@ static int openUart(const char *uart_name, int baud);
 #endif
 
 static int _fd;
-static unsigned char _buf[2048];
+static unsigned char _buf[4096];
 static sockaddr_in _srcaddr;
 static unsigned _addrlen = sizeof(_srcaddr);
 
@@ -182,11 +182,16 @@ void Simulator::send_controls()
 	if (_actuator_outputs.timestamp > 0) {
 		mavlink_hil_actuator_controls_t hil_act_control = actuator_controls_from_outputs();
 
+		PX4_DEBUG("sending controls t=%ld (%ld)", _actuator_outputs.timestamp, hil_act_control.time_usec);
+
+		if (_shm_segment != nullptr) {
+			shm_send_controls(hil_act_control);
+			return;
+		}
+
 		mavlink_message_t message{};
 		mavlink_msg_hil_actuator_controls_encode(_param_mav_sys_id.get(), _param_mav_comp_id.get(), &message, &hil_act_control);
 
-		PX4_DEBUG("sending controls t=%ld (%ld)", _actuator_outputs.timestamp, hil_act_control.time_usec);
-
 		send_mavlink_message(message);
 	}
 }
@@ -239,6 +244,17 @@ void Simulator::update_sensors(const hrt_abstime &time, const mavlink_hil_sensor
 
 void Simulator::handle_message(const mavlink_message_t *msg)
 {
+	if (_shm_segment != nullptr) {
+		// sensors are received on the shared memory thread
+		if (msg->msgid == MAVLINK_MSG_ID_HIL_SENSOR) {
+			return;
+		}
+
+	} else if (msg->msgid != MAVLINK_MSG_ID_HIL_SENSOR) {
+		// keep the order of the messages: pending sensor samples are older than anything that follows
+		handle_hil_sensor_batch();
+	}
+
 	switch (msg->msgid) {
 	case MAVLINK_MSG_ID_HIL_SENSOR:
 		handle_message_hil_sensor(msg);
@@ -322,29 +338,50 @@ void Simulator::handle_message_hil_gps(const mavlink_message_t *msg)
 
 void Simulator::handle_message_hil_sensor(const mavlink_message_t *msg)
 {
-	mavlink_hil_sensor_t imu;
-	mavlink_msg_hil_sensor_decode(msg, &imu);
+	// HIL_SENSOR messages received in the same packet are handled together, see handle_hil_sensor_batch()
+	if (_hil_sensor_batch_count >= HIL_SENSOR_BATCH_MAX) {
+		handle_hil_sensor_batch();
+	}
+
+	mavlink_msg_hil_sensor_decode(msg, &_hil_sensor_batch[_hil_sensor_batch_count++]);
+}
+
+void Simulator::handle_hil_sensor_batch()
+{
+	if (_hil_sensor_batch_count == 0) {
+		return;
+	}
+
+	hrt_abstime now_us = 0;
 
-	struct timespec ts;
-	abstime_to_ts(&ts, imu.time_usec);
-	px4_clock_settime(CLOCK_MONOTONIC, &ts);
+	// advance the time in one step per sample, so that the IMU rate is kept
+	// even if the simulator sends several samples per packet
+	for (int i = 0; i < _hil_sensor_batch_count; i++) {
+		const mavlink_hil_sensor_t &imu = _hil_sensor_batch[i];
 
-	hrt_abstime now_us = hrt_absolute_time();
+		struct timespec ts;
+		abstime_to_ts(&ts, imu.time_usec);
+		px4_clock_settime(CLOCK_MONOTONIC, &ts);
+
+		now_us = hrt_absolute_time();
 
 #if 0
-	// This is just for to debug missing HIL_SENSOR messages.
-	static hrt_abstime last_time = 0;
-	hrt_abstime diff = now_us - last_time;
-	float step = diff / 4000.0f;
+		// This is just for to debug missing HIL_SENSOR messages.
+		static hrt_abstime last_time = 0;
+		hrt_abstime diff = now_us - last_time;
+		float step = diff / 4000.0f;
 
-	if (step > 1.1f || step < 0.9f) {
-		PX4_INFO("HIL_SENSOR: imu time_usec: %lu, time_usec: %lu, diff: %lu, step: %.2f", imu.time_usec, now_us, diff, step);
-	}
+		if (step > 1.1f || step < 0.9f) {
+			PX4_INFO("HIL_SENSOR: imu time_usec: %lu, time_usec: %lu, diff: %lu, step: %.2f", imu.time_usec, now_us, diff, step);
+		}
 
-	last_time = now_us;
+		last_time = now_us;
 #endif
 
-	update_sensors(now_us, imu);
+		update_sensors(now_us, imu);
+	}
+
+	_hil_sensor_batch_count = 0;
 
 	static float battery_percentage = 1.0f;
 	static uint64_t last_integration_us = 0;
@@ -807,6 +844,12 @@ void Simulator::run()
 	_ekf2_timestamps_sub = orb_subscribe(ORB_ID(ekf2_timestamps));
 #endif
 
+	if (_shm_name[0] != '\0' && shm_open_segment() == 0) {
+		// receive sensors from the shared memory at the same priority as the sender thread
+		pthread_t shm_thread;
+		pthread_create(&shm_thread, &sender_thread_attr, Simulator::shm_receiving_trampoline, nullptr);
+	}
+
 	// got data from simulator, now activate the sending thread
 	pthread_create(&sender_thread, &sender_thread_attr, Simulator::sending_trampoline, nullptr);
 	pthread_attr_destroy(&sender_thread_attr);
@@ -843,6 +886,10 @@ void Simulator::run()
 						handle_message(&msg);
 					}
 				}
+
+				if (_shm_segment == nullptr) {
+					handle_hil_sensor_batch();
+				}
 			}
 		}
 
@@ -862,6 +909,10 @@ void Simulator::run()
 						handle_message(&msg);
 					}
 				}
+
+				if (_shm_segment == nullptr) {
+					handle_hil_sensor_batch();
+				}
 			}
 		}
 
@@ -0,0 +1,159 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file simulator_shm.cpp
+ *
+ * Shared memory transport for HIL_SENSOR and HIL_ACTUATOR_CONTROLS, see simulator_shm.h.
+ */
+
+#include "simulator.h"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+int Simulator::shm_open_segment()
+{
+	// always start from a clean segment
+	shm_unlink(_shm_name);
+
+	int fd = shm_open(_shm_name, O_CREAT | O_RDWR, 0644);
+
+	if (fd < 0) {
+		PX4_ERR("shm_open %s failed (%i)", _shm_name, errno);
+		return -1;
+	}
+
+	if (ftruncate(fd, sizeof(simulator_shm_segment)) != 0) {
+		PX4_ERR("ftruncate failed (%i)", errno);
+		::close(fd);
+		shm_unlink(_shm_name);
+		return -1;
+	}
+
+	void *mem = mmap(nullptr, sizeof(simulator_shm_segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (mem == MAP_FAILED) {
+		PX4_ERR("mmap failed (%i)", errno);
+		shm_unlink(_shm_name);
+		return -1;
+	}
+
+	_shm_segment = (simulator_shm_segment *)mem;
+	_shm_segment->version = SIMULATOR_SHM_VERSION;
+	_shm_segment->sensor_write = 0;
+	_shm_segment->sensor_read = 0;
+	_shm_segment->actuator_tag = 0;
+	__atomic_store_n(&_shm_segment->magic, SIMULATOR_SHM_MAGIC, __ATOMIC_RELEASE);
+
+	PX4_INFO("Simulator sensors and actuators on shared memory %s", _shm_name);
+
+	return 0;
+}
+
+void Simulator::shm_send_controls(const mavlink_hil_actuator_controls_t &hil_act_control)
+{
+	simulator_shm_actuator_controls controls{};
+	controls.time_usec = hil_act_control.time_usec;
+	controls.flags = hil_act_control.flags;
+	controls.mode = hil_act_control.mode;
+	memcpy(controls.controls, hil_act_control.controls, sizeof(controls.controls));
+
+	simulator_shm_write_actuator_controls(_shm_segment, &controls);
+}
+
+void *Simulator::shm_receiving_trampoline(void * /*unused*/)
+{
+	_instance->shm_receive();
+	return nullptr;
+}
+
+void Simulator::shm_receive()
+{
+#ifdef __PX4_DARWIN
+	pthread_setname_np("sim_shm");
+#else
+	pthread_setname_np(pthread_self(), "sim_shm");
+#endif
+
+	int idle_count = 0;
+
+	while (true) {
+		simulator_shm_sensor sample;
+
+		while (simulator_shm_pop_sensor(_shm_segment, &sample)) {
+			if (_hil_sensor_batch_count >= HIL_SENSOR_BATCH_MAX) {
+				handle_hil_sensor_batch();
+			}
+
+			mavlink_hil_sensor_t &imu = _hil_sensor_batch[_hil_sensor_batch_count++];
+			imu.time_usec = sample.time_usec;
+			imu.xacc = sample.xacc;
+			imu.yacc = sample.yacc;
+			imu.zacc = sample.zacc;
+			imu.xgyro = sample.xgyro;
+			imu.ygyro = sample.ygyro;
+			imu.zgyro = sample.zgyro;
+			imu.xmag = sample.xmag;
+			imu.ymag = sample.ymag;
+			imu.zmag = sample.zmag;
+			imu.abs_pressure = sample.abs_pressure;
+			imu.diff_pressure = sample.diff_pressure;
+			imu.pressure_alt = sample.pressure_alt;
+			imu.temperature = sample.temperature;
+			imu.fields_updated = sample.fields_updated;
+
+			idle_count = 0;
+		}
+
+		if (_hil_sensor_batch_count > 0) {
+			handle_hil_sensor_batch();
+
+		} else if (++idle_count < SHM_SPIN_COUNT) {
+			// spin while the simulator is stepping to keep the latency low
+			sched_yield();
+
+		} else {
+			// the simulator is paused or gone
+			system_usleep(SHM_IDLE_SLEEP_US);
+		}
+	}
+}
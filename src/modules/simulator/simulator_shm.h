@@ -0,0 +1,178 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file simulator_shm.h
+ *
+ * Layout of the POSIX shared memory segment used as an alternative to the
+ * MAVLink socket for the lockstep sensor and actuator exchange.
+ *
+ * This header is self-contained C so that simulators can include it directly:
+ * PX4 creates the segment given with `simulator start -m <name>`, the
+ * simulator opens it with shm_open(name, O_RDWR), mmap()s
+ * sizeof(struct simulator_shm_segment) bytes and waits for the magic.
+ *
+ * Sensor samples are passed through a single producer, single consumer queue
+ * written by the simulator, actuator controls through a single slot written
+ * by PX4 and tagged with (generation << 1) | busy (seqlock). All other
+ * messages (GPS, RC, ...) still go over the MAVLink connection.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define SIMULATOR_SHM_MAGIC		0x53345850u	/* "PX4S" */
+#define SIMULATOR_SHM_VERSION		1u
+
+#define SIMULATOR_SHM_SENSOR_QUEUE	32
+
+/** sensor sample, same fields and units as the MAVLink HIL_SENSOR message */
+struct simulator_shm_sensor {
+	uint64_t time_usec;
+	float xacc;
+	float yacc;
+	float zacc;
+	float xgyro;
+	float ygyro;
+	float zgyro;
+	float xmag;
+	float ymag;
+	float zmag;
+	float abs_pressure;
+	float diff_pressure;
+	float pressure_alt;
+	float temperature;
+	uint32_t fields_updated;
+};
+
+/** actuator controls, same fields and units as the MAVLink HIL_ACTUATOR_CONTROLS message */
+struct simulator_shm_actuator_controls {
+	uint64_t time_usec;
+	uint64_t flags;
+	float controls[16];
+	uint8_t mode;
+	uint8_t reserved[7];
+};
+
+struct simulator_shm_segment {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t sensor_write;			/**< number of sensor samples written by the simulator */
+	uint32_t sensor_read;			/**< number of sensor samples consumed by PX4 */
+	struct simulator_shm_sensor sensor[SIMULATOR_SHM_SENSOR_QUEUE];
+	uint32_t actuator_tag;			/**< (generation << 1) | busy of actuator_controls */
+	uint32_t reserved;
+	struct simulator_shm_actuator_controls actuator_controls;
+};
+
+/**
+ * Queue a sensor sample (simulator side).
+ * @return 1 on success, 0 if the queue is full
+ */
+static inline int simulator_shm_push_sensor(struct simulator_shm_segment *segment,
+		const struct simulator_shm_sensor *sample)
+{
+	const uint32_t write = __atomic_load_n(&segment->sensor_write, __ATOMIC_RELAXED);
+	const uint32_t read = __atomic_load_n(&segment->sensor_read, __ATOMIC_ACQUIRE);
+
+	if (write - read >= SIMULATOR_SHM_SENSOR_QUEUE) {
+		return 0;
+	}
+
+	segment->sensor[write % SIMULATOR_SHM_SENSOR_QUEUE] = *sample;
+	__atomic_store_n(&segment->sensor_write, write + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/**
+ * Take the oldest queued sensor sample (PX4 side).
+ * @return 1 if a sample was copied, 0 if the queue is empty
+ */
+static inline int simulator_shm_pop_sensor(struct simulator_shm_segment *segment, struct simulator_shm_sensor *sample)
+{
+	const uint32_t read = __atomic_load_n(&segment->sensor_read, __ATOMIC_RELAXED);
+	const uint32_t write = __atomic_load_n(&segment->sensor_write, __ATOMIC_ACQUIRE);
+
+	if (read == write) {
+		return 0;
+	}
+
+	*sample = segment->sensor[read % SIMULATOR_SHM_SENSOR_QUEUE];
+	__atomic_store_n(&segment->sensor_read, read + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/**
+ * Publish actuator controls (PX4 side).
+ */
+static inline void simulator_shm_write_actuator_controls(struct simulator_shm_segment *segment,
+		const struct simulator_shm_actuator_controls *controls)
+{
+	const uint32_t generation = (__atomic_load_n(&segment->actuator_tag, __ATOMIC_RELAXED) >> 1) + 1;
+
+	__atomic_store_n(&segment->actuator_tag, (generation << 1) | 1u, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	memcpy(&segment->actuator_controls, controls, sizeof(*controls));
+	__atomic_store_n(&segment->actuator_tag, generation << 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Copy the latest actuator controls if there are new ones (simulator side).
+ * @param generation the generation last seen by the caller (initialize with 0), updated on success
+ * @return 1 if new controls were copied, 0 otherwise
+ */
+static inline int simulator_shm_read_actuator_controls(const struct simulator_shm_segment *segment,
+		struct simulator_shm_actuator_controls *controls, uint32_t *generation)
+{
+	for (;;) {
+		const uint32_t tag = __atomic_load_n(&segment->actuator_tag, __ATOMIC_ACQUIRE);
+
+		if ((tag >> 1) == *generation) {
+			return 0;
+		}
+
+		if ((tag & 1u) == 0) {
+			memcpy(controls, &segment->actuator_controls, sizeof(*controls));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			if (__atomic_load_n(&segment->actuator_tag, __ATOMIC_RELAXED) == tag) {
+				*generation = tag >> 1;
+				return 1;
+			}
+		}
+
+		/* PX4 is writing, retry */
+	}
+}
@@ -366,6 +366,11 @@ int TemperatureCompensation::set_sensor_id(uint32_t device_id, int topic_instanc
 {
 	for (int i = 0; i < sensor_count_max; ++i) {
 		if (device_id == (uint32_t)sensor_cal_data[i].ID) {
+			if (sensor_data.device_mapping[topic_instance] != i) {
+				// force the offsets to be recomputed for the new mapping
+				sensor_data.last_temperature[topic_instance] = -100.0f;
+			}
+
 			sensor_data.device_mapping[topic_instance] = i;
 			return i;
 		}
@@ -389,6 +394,12 @@ int TemperatureCompensation::update_scales_and_offsets_gyro(int topic_instance,
 		return -1;
 	}
 
+	// Only recompute the offsets if the temperature delta is large enough to warrant a new publication,
+	//  the offsets and scales of the last publication remain valid otherwise
+	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) <= TEMPERATURE_UPDATE_THRESHOLD) {
+		return 1;
+	}
+
 	// Calculate and update the offsets
 	calc_thermal_offsets_3D(_parameters.gyro_cal_data[mapping], temperature, offsets);
 
@@ -397,13 +408,9 @@ int TemperatureCompensation::update_scales_and_offsets_gyro(int topic_instance,
 		scales[axis_index] = _parameters.gyro_cal_data[mapping].scale[axis_index];
 	}
 
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _gyro_data.last_temperature[topic_instance]) > 1.0f) {
-		_gyro_data.last_temperature[topic_instance] = temperature;
-		return 2;
-	}
+	_gyro_data.last_temperature[topic_instance] = temperature;
 
-	return 1;
+	return 2;
 }
 
 int TemperatureCompensation::update_scales_and_offsets_accel(int topic_instance, float temperature, float *offsets,
@@ -421,6 +428,12 @@ int TemperatureCompensation::update_scales_and_offsets_accel(int topic_instance,
 		return -1;
 	}
 
+	// Only recompute the offsets if the temperature delta is large enough to warrant a new publication,
+	//  the offsets and scales of the last publication remain valid otherwise
+	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) <= TEMPERATURE_UPDATE_THRESHOLD) {
+		return 1;
+	}
+
 	// Calculate and update the offsets
 	calc_thermal_offsets_3D(_parameters.accel_cal_data[mapping], temperature, offsets);
 
@@ -429,13 +442,9 @@ int TemperatureCompensation::update_scales_and_offsets_accel(int topic_instance,
 		scales[axis_index] = _parameters.accel_cal_data[mapping].scale[axis_index];
 	}
 
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _accel_data.last_temperature[topic_instance]) > 1.0f) {
-		_accel_data.last_temperature[topic_instance] = temperature;
-		return 2;
-	}
+	_accel_data.last_temperature[topic_instance] = temperature;
 
-	return 1;
+	return 2;
 }
 
 int TemperatureCompensation::update_scales_and_offsets_baro(int topic_instance, float temperature, float *offsets,
@@ -453,19 +462,21 @@ int TemperatureCompensation::update_scales_and_offsets_baro(int topic_instance,
 		return -1;
 	}
 
+	// Only recompute the offsets if the temperature delta is large enough to warrant a new publication,
+	//  the offsets and scales of the last publication remain valid otherwise
+	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) <= TEMPERATURE_UPDATE_THRESHOLD) {
+		return 1;
+	}
+
 	// Calculate and update the offsets
 	calc_thermal_offsets_1D(_parameters.baro_cal_data[mapping], temperature, *offsets);
 
 	// Update the scales
 	*scales = _parameters.baro_cal_data[mapping].scale;
 
-	// Check if temperature delta is large enough to warrant a new publication
-	if (fabsf(temperature - _baro_data.last_temperature[topic_instance]) > 1.0f) {
-		_baro_data.last_temperature[topic_instance] = temperature;
-		return 2;
-	}
+	_baro_data.last_temperature[topic_instance] = temperature;
 
-	return 1;
+	return 2;
 }
 
 void TemperatureCompensation::print_status()
@@ -60,6 +60,8 @@ static_assert(BARO_COUNT_MAX == 3, "BARO_COUNT_MAX must be 3 (if changed, add/re
 
 static constexpr uint8_t SENSOR_COUNT_MAX = 3;
 
+static constexpr float TEMPERATURE_UPDATE_THRESHOLD = 1.0f; ///< temperature change (deg C) to recompute the offsets
+
 /**
  ** class TemperatureCompensation
  * Applies temperature compensation to sensor data. Loads the parameters from PX4 param storage.
@@ -83,11 +85,12 @@ public:
 	 * @param topic_instance uORB topic instance
 	 * @param sensor_data input sensor data, output sensor data with applied corrections
 	 * @param temperature measured current temperature
-	 * @param offsets returns offsets that were applied (length = 3, except for baro), depending on return value
-	 * @param scales returns scales that were applied (length = 3), depending on return value
+	 * @param offsets returns offsets that were applied (length = 3, except for baro), only written if 2 is returned
+	 * @param scales returns scales that were applied (length = 3), only written if 2 is returned
 	 * @return -1: error: correction enabled, but no sensor mapping set (@see set_sendor_id_gyro)
 	 *         0: no changes (correction not enabled),
-	 *         1: corrections applied but no changes to offsets & scales,
+	 *         1: corrections applied but no changes to offsets & scales (temperature changed less than
+	 *            TEMPERATURE_UPDATE_THRESHOLD since the last update, the previous offsets & scales remain valid),
 	 *         2: corrections applied and offsets & scales updated
 	 */
 	int update_scales_and_offsets_gyro(int topic_instance, float temperature, float *offsets, float *scales);
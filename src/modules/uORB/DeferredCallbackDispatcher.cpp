@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file DeferredCallbackDispatcher.cpp
+ *
+ */
+
+#include "DeferredCallbackDispatcher.hpp"
+
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/sem.hpp>
+
+namespace uORB
+{
+
+px4::atomic<DeferredCallbackDispatcher *> DeferredCallbackDispatcher::_instance{nullptr};
+
+DeferredCallbackDispatcher *DeferredCallbackDispatcher::instance()
+{
+	DeferredCallbackDispatcher *dispatcher = _instance.load();
+
+	if (dispatcher == nullptr) {
+		// created on first use and never deleted, subscribers may hold indices at any time
+		DeferredCallbackDispatcher *new_dispatcher = new DeferredCallbackDispatcher();
+
+		if (_instance.compare_exchange(&dispatcher, new_dispatcher)) {
+			dispatcher = new_dispatcher;
+
+		} else {
+			// lost the race, dispatcher holds the winner
+			delete new_dispatcher;
+		}
+	}
+
+	return dispatcher;
+}
+
+DeferredCallbackDispatcher::DeferredCallbackDispatcher() :
+	px4::WorkItem("uorb_deferred", px4::wq_configurations::lp_default)
+{
+	px4_sem_init(&_lock, 0, 1);
+}
+
+DeferredCallbackDispatcher::~DeferredCallbackDispatcher()
+{
+	px4_sem_destroy(&_lock);
+}
+
+int DeferredCallbackDispatcher::register_item(px4::WorkItem *item)
+{
+	for (;;) {
+		uint32_t registered = _registered.load();
+
+		if (registered == UINT32_MAX) {
+			PX4_ERR("too many deferred callbacks");
+			return -1;
+		}
+
+		const int index = __builtin_ctz(~registered);
+
+		// claim the slot first, only the winner may write it
+		if (_registered.compare_exchange(&registered, registered | (1u << index))) {
+			_items[index].store(item);
+			return index;
+		}
+	}
+}
+
+void DeferredCallbackDispatcher::unregister_item(int index)
+{
+	if ((index >= 0) && (index < MAX_ITEMS)) {
+		// wait for a running dispatch, the item might be deleted after this returns
+		SmartLock smart_lock(_lock);
+
+		_items[index].store(nullptr);
+		_pending.fetch_and(~(1u << index));
+		_registered.fetch_and(~(1u << index));
+	}
+}
+
+void DeferredCallbackDispatcher::Run()
+{
+	SmartLock smart_lock(_lock);
+
+	// take the whole batch, new marks start the next one
+	const uint32_t pending = _pending.fetch_and(0) & _registered.load();
+
+	for (uint32_t mask = pending; mask != 0; mask &= mask - 1) {
+		px4::WorkItem *item = _items[__builtin_ctz(mask)].load();
+
+		// nullptr while a registration is still publishing the item
+		if (item != nullptr) {
+			item->ScheduleNow();
+		}
+	}
+}
+
+} // namespace uORB
@@ -0,0 +1,105 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file DeferredCallbackDispatcher.hpp
+ *
+ */
+
+#pragma once
+
+#include <px4_platform_common/atomic.h>
+#include <px4_platform_common/sem.h>
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+
+namespace uORB
+{
+
+/**
+ * Helper WorkItem waking low priority subscribers in batches.
+ *
+ * A publication only marks the WorkItem of a deferred subscriber as pending.
+ * The first pending mark schedules the dispatcher, which then schedules all
+ * pending WorkItems from its own (low priority) context. The publisher therefore
+ * pays at most one schedule operation per batch, independent of the number of
+ * deferred subscribers.
+ */
+class DeferredCallbackDispatcher : public px4::WorkItem
+{
+public:
+
+	static DeferredCallbackDispatcher *instance();
+
+	/**
+	 * Maximum number of WorkItems handled by the dispatcher.
+	 */
+	static constexpr uint8_t MAX_ITEMS = 32;
+
+	/**
+	 * Register a WorkItem.
+	 * @return the index to pass to set_pending(), or -1 if the table is full
+	 */
+	int register_item(px4::WorkItem *item);
+
+	/**
+	 * Unregister a WorkItem. Once this returns the dispatcher doesn't access it anymore.
+	 */
+	void unregister_item(int index);
+
+	/**
+	 * Mark a WorkItem pending (safe from any context, including the publisher's critical section).
+	 */
+	void set_pending(int index)
+	{
+		if (_pending.fetch_or(1u << index) == 0) {
+			// first pending item of this batch
+			ScheduleNow();
+		}
+	}
+
+private:
+	DeferredCallbackDispatcher();
+	~DeferredCallbackDispatcher() override;
+
+	void Run() override;
+
+	static px4::atomic<DeferredCallbackDispatcher *> _instance;
+
+	px4::atomic<px4::WorkItem *> _items[MAX_ITEMS] {};
+	px4::atomic<uint32_t> _registered{0};
+	px4::atomic<uint32_t> _pending{0};
+
+	px4_sem_t _lock; /**< serializes the dispatch with unregister_item() */
+};
+
+} // namespace uORB
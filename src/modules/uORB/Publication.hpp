@@ -72,6 +72,10 @@ protected:
 		}
 	}
 
+	void *loan_slot() { return advertised() ? static_cast<DeviceNode *>(_handle)->loan() : nullptr; }
+
+	bool commit_slot() { return advertised() && (static_cast<DeviceNode *>(_handle)->commit_loan() == PX4_OK); }
+
 	orb_advert_t _handle{nullptr};
 	const ORB_ID _orb_id;
 };
@@ -113,6 +117,28 @@ public:
 
 		return (DeviceNode::publish(get_topic(), _handle, &data) == PX4_OK);
 	}
+
+	/**
+	 * Loan the next queue slot to fill the message in place instead of publishing a copy.
+	 * Only available for large (seqlock) topics. Must be followed by commit(), the topic
+	 * can't be accessed by the caller in between.
+	 * @return pointer to the message or nullptr on failure
+	 */
+	T *loan()
+	{
+		static_assert(sizeof(T) > DeviceNode::SEQLOCK_MIN_SIZE, "loan() requires a seqlock topic");
+
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(loan_slot());
+	}
+
+	/**
+	 * Publish the message returned by loan()
+	 */
+	bool commit() { return commit_slot(); }
 };
 
 /**
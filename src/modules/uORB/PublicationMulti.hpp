@@ -94,6 +94,28 @@ public:
 		return (orb_publish(get_topic(), _handle, &data) == PX4_OK);
 	}
 
+	/**
+	 * Loan the next queue slot to fill the message in place instead of publishing a copy.
+	 * Only available for large (seqlock) topics. Must be followed by commit(), the topic
+	 * can't be accessed by the caller in between.
+	 * @return pointer to the message or nullptr on failure
+	 */
+	T *loan()
+	{
+		static_assert(sizeof(T) > DeviceNode::SEQLOCK_MIN_SIZE, "loan() requires a seqlock topic");
+
+		if (!advertised()) {
+			advertise();
+		}
+
+		return static_cast<T *>(loan_slot());
+	}
+
+	/**
+	 * Publish the message returned by loan()
+	 */
+	bool commit() { return commit_slot(); }
+
 protected:
 	const ORB_PRIO _priority;
 };
@@ -51,6 +51,33 @@ namespace uORB
 {
 
 class SubscriptionCallback;
+template<typename T, uint8_t N> class SubscriptionQueued;
+
+/**
+ * Read guard for a message borrowed in place from a seqlock topic.
+ * The publisher is never blocked, so valid() has to be checked after the
+ * data was used. If it returns false the message was overwritten meanwhile.
+ */
+template<typename T>
+class BorrowedMessage
+{
+public:
+	BorrowedMessage(const DeviceNode *node, const void *data, unsigned tag) :
+		_node(node),
+		_data(static_cast<const T *>(data)),
+		_tag(tag)
+	{
+	}
+
+	const T *get() const { return _data; }
+
+	bool valid() const { return (_data != nullptr) && _node->borrow_valid(_data, _tag); }
+
+private:
+	const DeviceNode *_node;
+	const T *_data;
+	const unsigned _tag;
+};
 
 // Base subscription wrapper class
 class Subscription
@@ -124,13 +151,30 @@ public:
 	 */
 	bool copy(void *dst) { return advertised() ? _node->copy(dst, _last_generation) : false; }
 
+	/**
+	 * Borrow the next update in place instead of copying it (large topics only).
+	 * The returned guard holds nullptr if there is no update.
+	 */
+	template<typename T>
+	BorrowedMessage<T> borrow()
+	{
+		static_assert(sizeof(T) > DeviceNode::SEQLOCK_MIN_SIZE, "borrow() requires a seqlock topic");
+
+		unsigned tag = 0;
+		const void *data = updated() ? _node->borrow(_last_generation, tag) : nullptr;
+
+		return BorrowedMessage<T>(_node, data, tag);
+	}
+
 	uint8_t		get_instance() const { return _instance; }
+	unsigned	get_last_generation() const { return _last_generation; }
 	orb_id_t	get_topic() const { return get_orb_meta(_orb_id); }
 	ORB_PRIO	get_priority() { return advertised() ? _node->get_priority() : ORB_PRIO_UNINITIALIZED; }
 
 protected:
 
 	friend class SubscriptionCallback;
+	template<typename T, uint8_t N> friend class SubscriptionQueued;
 
 	DeviceNode		*get_node() { return _node; }
 
@@ -39,14 +39,15 @@
 #pragma once
 
 #include <uORB/SubscriptionInterval.hpp>
-#include <containers/List.hpp>
+#include <uORB/DeferredCallbackDispatcher.hpp>
 #include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <px4_platform_common/trace.h>
 
 namespace uORB
 {
 
 // Subscription wrapper class with callbacks on new publications
-class SubscriptionCallback : public SubscriptionInterval, public ListNode<SubscriptionCallback *>
+class SubscriptionCallback : public SubscriptionInterval
 {
 public:
 	/**
@@ -73,8 +74,8 @@ public:
 			_registered = true;
 
 		} else {
-			// force topic creation by subscribing with old API
-			int fd = orb_subscribe_multi(_subscription.get_topic(), _subscription.get_instance());
+			// force topic creation (without advertising it)
+			Manager::get_instance()->orb_create_node(_subscription.get_topic(), _subscription.get_instance());
 
 			// try to register callback again
 			if (_subscription.subscribe()) {
@@ -82,8 +83,6 @@ public:
 					_registered = true;
 				}
 			}
-
-			orb_unsubscribe(fd);
 		}
 
 		return _registered;
@@ -129,6 +128,10 @@ public:
 	{
 		// schedule immediately if no interval, otherwise check time elapsed
 		if ((_interval_us == 0) || (hrt_elapsed_time_atomic(&_last_update) >= _interval_us)) {
+			if (px4::trace::recording.load()) {
+				px4::trace::record(px4::trace::Event::CallbackSchedule, get_topic()->o_name, _work_item->ItemName());
+			}
+
 			_work_item->ScheduleNow();
 		}
 	}
@@ -137,4 +140,60 @@ private:
 	px4::WorkItem *_work_item;
 };
 
+// Subscription with callback that schedules a low priority WorkItem in a batch via the DeferredCallbackDispatcher
+class SubscriptionCallbackWorkItemDeferred : public SubscriptionCallback
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param work_item The WorkItem that will be scheduled by the dispatcher on new publications.
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param instance The instance for multi sub.
+	 */
+	SubscriptionCallbackWorkItemDeferred(px4::WorkItem *work_item, const orb_metadata *meta, uint8_t instance = 0) :
+		SubscriptionCallback(meta, 0, instance),	// interval 0
+		_work_item(work_item)
+	{
+	}
+
+	virtual ~SubscriptionCallbackWorkItemDeferred()
+	{
+		unregisterCallback();
+
+		if (_dispatcher_index >= 0) {
+			DeferredCallbackDispatcher::instance()->unregister_item(_dispatcher_index);
+		}
+	}
+
+	bool registerCallback()
+	{
+		if (_dispatcher_index < 0) {
+			_dispatcher_index = DeferredCallbackDispatcher::instance()->register_item(_work_item);
+
+			if (_dispatcher_index < 0) {
+				return false;
+			}
+		}
+
+		return SubscriptionCallback::registerCallback();
+	}
+
+	void call() override
+	{
+		// only mark pending if no interval, otherwise check time elapsed
+		if ((_interval_us == 0) || (hrt_elapsed_time_atomic(&_last_update) >= _interval_us)) {
+			if (px4::trace::recording.load()) {
+				px4::trace::record(px4::trace::Event::CallbackSchedule, get_topic()->o_name, _work_item->ItemName());
+			}
+
+			DeferredCallbackDispatcher::instance()->set_pending(_dispatcher_index);
+		}
+	}
+
+private:
+	px4::WorkItem *_work_item;
+	int _dispatcher_index{-1};
+};
+
 } // namespace uORB
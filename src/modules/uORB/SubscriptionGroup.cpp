@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SubscriptionGroup.cpp
+ *
+ */
+
+#include "SubscriptionGroup.hpp"
+
+#include "uORBManager.hpp"
+
+namespace uORB
+{
+
+bool SubscriptionGroupBase::subscribe(DeviceNode *&node, unsigned &last_generation, ORB_ID id, uint8_t instance)
+{
+	if (node != nullptr) {
+		return true;
+	}
+
+	if (id == ORB_ID::INVALID) {
+		return false;
+	}
+
+	DeviceMaster *device_master = uORB::Manager::get_instance()->get_device_master();
+
+	if ((device_master == nullptr) || !device_master->deviceNodeExists(id, instance)) {
+		return false;
+	}
+
+	DeviceNode *device_node = device_master->getDeviceNode(get_orb_meta(id), instance);
+
+	if (device_node == nullptr) {
+		return false;
+	}
+
+	device_node->add_internal_subscriber();
+
+	// If there were any previous publications, allow the subscriber to read them
+	const unsigned curr_gen = device_node->published_message_count();
+	const uint8_t q_size = device_node->get_queue_size();
+
+	last_generation = (q_size < curr_gen) ? curr_gen - q_size : 0;
+	node = device_node;
+
+	return true;
+}
+
+void SubscriptionGroupBase::unsubscribe(DeviceNode *&node, unsigned &last_generation)
+{
+	if (node != nullptr) {
+		node->remove_internal_subscriber();
+	}
+
+	node = nullptr;
+	last_generation = 0;
+}
+
+} // namespace uORB
@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SubscriptionGroup.hpp
+ *
+ */
+
+#pragma once
+
+#include <uORB/uORB.h>
+#include <uORB/topics/uORBTopics.hpp>
+
+#include <px4_platform_common/defines.h>
+
+#include "uORBDeviceNode.hpp"
+
+namespace uORB
+{
+
+// Shared (non templated) parts of SubscriptionGroup
+class SubscriptionGroupBase
+{
+protected:
+
+	/**
+	 * Try to subscribe to a topic of the group.
+	 * @param node set to the DeviceNode on success
+	 * @param last_generation initialized from the queue of the node
+	 * @return true if subscribed
+	 */
+	static bool subscribe(DeviceNode *&node, unsigned &last_generation, ORB_ID id, uint8_t instance);
+
+	static void unsubscribe(DeviceNode *&node, unsigned &last_generation);
+};
+
+/**
+ * A group of up to 32 subscriptions that are checked for updates in a single pass.
+ *
+ * The DeviceNodes and generation counters of all topics are kept in contiguous arrays,
+ * updated() returns a bitmask of the updated topics (bit i set for the topic at index i)
+ * and caches it, so that a following update() of a topic doesn't check the node again.
+ */
+template<uint8_t N>
+class SubscriptionGroup : public SubscriptionGroupBase
+{
+	static_assert(N > 0 && N <= 32, "SubscriptionGroup supports 1 to 32 topics");
+
+public:
+
+	/**
+	 * Constructor
+	 *
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) of each topic (instance 0).
+	 */
+	template<typename... Metas>
+	SubscriptionGroup(Metas... meta) :
+		_orb_id{static_cast<ORB_ID>(static_cast<const orb_metadata *>(meta)->o_id)...}
+	{
+		static_assert(sizeof...(Metas) == N, "SubscriptionGroup: number of topics doesn't match N");
+	}
+
+	~SubscriptionGroup()
+	{
+		for (uint8_t i = 0; i < N; i++) {
+			unsubscribe(_node[i], _last_generation[i]);
+		}
+	}
+
+	// no copy, assignment, move, move assignment
+	SubscriptionGroup(const SubscriptionGroup &) = delete;
+	SubscriptionGroup &operator=(const SubscriptionGroup &) = delete;
+	SubscriptionGroup(SubscriptionGroup &&) = delete;
+	SubscriptionGroup &operator=(SubscriptionGroup &&) = delete;
+
+	/**
+	 * Check all topics for new updates.
+	 * @return bitmask of updated topics
+	 */
+	uint32_t updated()
+	{
+		uint32_t updated = 0;
+
+		for (uint8_t i = 0; i < N; i++) {
+			if ((_node[i] != nullptr) || subscribe(_node[i], _last_generation[i], _orb_id[i], 0)) {
+				if (_node[i]->published_message_count() != _last_generation[i]) {
+					updated |= (1u << i);
+				}
+			}
+		}
+
+		_updated = updated;
+
+		return updated;
+	}
+
+	/**
+	 * Check if a topic was updated in the last updated() pass.
+	 */
+	bool updated(uint8_t index) const { return _updated & (1u << index); }
+
+	/**
+	 * Copy the struct of a topic if it was updated in the last updated() pass.
+	 * @param index The index of the topic in the group.
+	 * @param dst The uORB message struct we are updating.
+	 */
+	bool update(uint8_t index, void *dst) { return updated(index) ? copy(index, dst) : false; }
+
+	/**
+	 * Copy the struct of a topic.
+	 * @param index The index of the topic in the group.
+	 * @param dst The uORB message struct we are updating.
+	 */
+	bool copy(uint8_t index, void *dst)
+	{
+		if ((index < N) && (_node[index] != nullptr) && _node[index]->copy(dst, _last_generation[index])) {
+			_updated &= ~(1u << index);
+			return true;
+		}
+
+		return false;
+	}
+
+	orb_id_t get_topic(uint8_t index) const { return (index < N) ? get_orb_meta(_orb_id[index]) : nullptr; }
+
+private:
+
+	DeviceNode *_node[N] {};
+	unsigned _last_generation[N] {};
+	const ORB_ID _orb_id[N];
+
+	uint32_t _updated{0}; ///< result of the last updated() pass
+};
+
+} // namespace uORB
@@ -132,9 +132,32 @@ public:
 		return false;
 	}
 
+	/**
+	 * Borrow the next update in place instead of copying it (large topics only).
+	 * The returned guard holds nullptr if there is no update.
+	 */
+	template<typename T>
+	BorrowedMessage<T> borrow()
+	{
+		if (!updated()) {
+			return BorrowedMessage<T>(nullptr, nullptr, 0);
+		}
+
+		BorrowedMessage<T> borrowed = _subscription.borrow<T>();
+
+		if (borrowed.get() != nullptr) {
+			const hrt_abstime now = hrt_absolute_time();
+			// shift last update time forward, but don't let it get further behind than the interval
+			_last_update = math::constrain(_last_update + _interval_us, now - _interval_us, now);
+		}
+
+		return borrowed;
+	}
+
 	bool		valid() const { return _subscription.valid(); }
 
 	uint8_t		get_instance() const { return _subscription.get_instance(); }
+	unsigned	get_last_generation() const { return _subscription.get_last_generation(); }
 	orb_id_t	get_topic() const { return _subscription.get_topic(); }
 	ORB_PRIO	get_priority() { return _subscription.get_priority(); }
 
@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file SubscriptionQueued.hpp
+ *
+ */
+
+#pragma once
+
+#include "SubscriptionCallback.hpp"
+
+#include <px4_platform_common/atomic.h>
+
+namespace uORB
+{
+
+/**
+ * Subscription with its own bounded ring of past messages.
+ *
+ * Every publication is copied into the ring from the publisher's context, so
+ * the subscriber gets all messages independent of the topic queue size
+ * (ORB_QUEUE_LENGTH). Only the consumers that need the full history pay the
+ * memory for it. If the ring is full new messages are dropped and counted.
+ *
+ * The ring is single producer (the publisher, serialized by the node) and
+ * single consumer (the owner calling pop()).
+ *
+ * The copy runs inside the node's callback loop, on NuttX with interrupts
+ * disabled, so the type is limited to small topics (MAX_MESSAGE_SIZE). Use a
+ * Subscription with a larger topic queue for anything bigger.
+ *
+ * @tparam T the topic type
+ * @tparam N ring size in messages, must be a power of 2
+ */
+template<typename T, uint8_t N>
+class SubscriptionQueued : public SubscriptionCallback
+{
+public:
+	static constexpr size_t MAX_MESSAGE_SIZE = 128;
+
+	static_assert((N > 0) && ((N & (N - 1)) == 0), "SubscriptionQueued size must be a power of 2");
+	static_assert(sizeof(T) <= MAX_MESSAGE_SIZE, "SubscriptionQueued is limited to small topics");
+
+	/**
+	 * Constructor
+	 *
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param instance The instance for multi sub.
+	 */
+	SubscriptionQueued(const orb_metadata *meta, uint8_t instance = 0) :
+		SubscriptionCallback(meta, 0, instance)	// interval 0
+	{
+	}
+
+	virtual ~SubscriptionQueued()
+	{
+		unregisterCallback();
+	}
+
+	/**
+	 * Start filling the ring. Messages still in the topic queue are included.
+	 */
+	bool registerCallback()
+	{
+		if (_subscription.subscribe()) {
+			_queued_generation = _subscription.get_last_generation();
+		}
+
+		return SubscriptionCallback::registerCallback();
+	}
+
+	void call() override
+	{
+		uORB::DeviceNode *node = _subscription.get_node();
+
+		if (node == nullptr) {
+			return;
+		}
+
+		unsigned head = _head.load();
+
+		for (;;) {
+			if (head - _tail.load() >= N) {
+				// ring full, skip to the latest message
+				const unsigned current_generation = node->published_message_count();
+				_dropped += current_generation - _queued_generation;
+				_queued_generation = current_generation;
+				break;
+			}
+
+			if (!node->copy_from_callback(&_ring[head % N], _queued_generation)) {
+				break;
+			}
+
+			_head.store(++head);
+		}
+	}
+
+	/**
+	 * Take the oldest message out of the ring.
+	 * @param dst The destination where the message will be copied.
+	 * @return true if there was a message.
+	 */
+	bool pop(T &dst)
+	{
+		const unsigned tail = _tail.load();
+
+		if (tail == _head.load()) {
+			return false;
+		}
+
+		dst = _ring[tail % N];
+		_tail.store(tail + 1);
+		return true;
+	}
+
+	/**
+	 * Number of messages in the ring.
+	 */
+	unsigned size() const { return _head.load() - _tail.load(); }
+
+	/**
+	 * Number of messages dropped because the ring was full.
+	 */
+	uint32_t dropped() const { return _dropped; }
+
+private:
+	T _ring[N] {};
+
+	px4::atomic<unsigned> _head{0};	// written by the publisher
+	px4::atomic<unsigned> _tail{0};	// written by the consumer
+
+	unsigned _queued_generation{0};	// generation of the next message to copy into the ring
+	uint32_t _dropped{0};
+};
+
+} // namespace uORB
@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+
+/**
+ * @file SubscriptionWait.hpp
+ *
+ * File descriptor free replacement for px4_poll() on orb_subscribe() handles.
+ */
+
+#pragma once
+
+#include "SubscriptionCallback.hpp"
+
+#include <errno.h>
+
+#include <px4_platform_common/sem.h>
+#include <px4_platform_common/time.h>
+
+namespace uORB
+{
+
+/**
+ * Lightweight wait object a thread blocks on until one of the subscriptions attached
+ * to it (SubscriptionCallbackWait) gets a new publication.
+ *
+ * Usage (instead of orb_subscribe() + px4_poll()):
+ *	uORB::WaitObject _wait;
+ *	uORB::SubscriptionCallbackWait _sensor_combined_sub{_wait, ORB_ID(sensor_combined)};
+ *
+ *	_sensor_combined_sub.registerCallback();
+ *
+ *	while (!should_exit()) {
+ *		if (_wait.wait(1_s)) { ... _sensor_combined_sub.update(&sensor_combined) ... }
+ *	}
+ */
+class WaitObject
+{
+public:
+	WaitObject()
+	{
+		px4_sem_init(&_sem, 0, 0);
+		px4_sem_setprotocol(&_sem, SEM_PRIO_NONE);
+	}
+
+	~WaitObject()
+	{
+		px4_sem_destroy(&_sem);
+	}
+
+	// no copy, assignment, move, move assignment
+	WaitObject(const WaitObject &) = delete;
+	WaitObject &operator=(const WaitObject &) = delete;
+	WaitObject(WaitObject &&) = delete;
+	WaitObject &operator=(WaitObject &&) = delete;
+
+	/**
+	 * Wake up the waiting thread (called from the publisher context).
+	 */
+	void notify()
+	{
+		// the count is only a wakeup flag: don't let it grow with every publication while the thread is busy
+		int value = 0;
+
+		if ((px4_sem_getvalue(&_sem, &value) == 0) && (value > 0)) {
+			return;
+		}
+
+		px4_sem_post(&_sem);
+	}
+
+	/**
+	 * Wait until one of the attached subscriptions got a new publication.
+	 * @param timeout_us The timeout in microseconds, or 0 to wait indefinitely.
+	 * @return true if notified, false on timeout or error
+	 */
+	bool wait(uint32_t timeout_us = 0)
+	{
+		if (timeout_us == 0) {
+			while (px4_sem_wait(&_sem) != 0) {
+				if (errno != EINTR) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		struct timespec abstime;
+#if defined(__PX4_NUTTX)
+		clock_gettime(CLOCK_REALTIME, &abstime);
+#else
+		// px4_sem_timedwait() uses the monotonic clock
+		px4_clock_gettime(CLOCK_MONOTONIC, &abstime);
+#endif
+		static constexpr unsigned billion = (1000 * 1000 * 1000);
+		uint64_t nsecs = abstime.tv_nsec + (uint64_t)timeout_us * 1000;
+		abstime.tv_sec += nsecs / billion;
+		nsecs -= (nsecs / billion) * billion;
+		abstime.tv_nsec = nsecs;
+
+		int ret;
+
+		while ((ret = px4_sem_timedwait(&_sem, &abstime)) != 0 && errno == EINTR) {}
+
+		return ret == 0;
+	}
+
+private:
+	px4_sem_t _sem;
+};
+
+// Subscription with callback that notifies a WaitObject
+class SubscriptionCallbackWait : public SubscriptionCallback
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param wait_object The WaitObject that will be notified on new publications.
+	 * @param meta The uORB metadata (usually from the ORB_ID() macro) for the topic.
+	 * @param interval_us The requested maximum update interval in microseconds.
+	 * @param instance The instance for multi sub.
+	 */
+	SubscriptionCallbackWait(WaitObject &wait_object, const orb_metadata *meta, uint32_t interval_us = 0,
+				 uint8_t instance = 0) :
+		SubscriptionCallback(meta, interval_us, instance),
+		_wait_object(wait_object)
+	{
+	}
+
+	virtual ~SubscriptionCallbackWait() = default;
+
+	void call() override
+	{
+		// notify immediately if no interval, otherwise check time elapsed
+		if ((_interval_us == 0) || (hrt_elapsed_time_atomic(&_last_update) >= _interval_us)) {
+			_wait_object.notify();
+		}
+	}
+
+private:
+	WaitObject &_wait_object;
+};
+
+} // namespace uORB
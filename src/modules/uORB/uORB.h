@@ -62,6 +62,11 @@ typedef const struct orb_metadata *orb_id_t;
  */
 #define ORB_MULTI_MAX_INSTANCES	4 // This must be < 10 (because it's the last char of the node path)
 
+/**
+ * Topics larger than this (in bytes) use the lock-free (seqlock) publish/copy path
+ */
+#define ORB_SEQLOCK_MIN_SIZE	64
+
 /**
  * Topic priority.
  * Relevant for multi-topics / topic groups
@@ -144,6 +144,18 @@ public:
 
 	virtual int16_t send_message(const char *messageName, int32_t length, uint8_t *data) = 0;
 
+	/**
+	 * @brief Sends the data message of a topic instance over the communication link.
+	 * Channels keyed by the message name only can keep the default, which ignores the instance.
+	 * @param instance
+	 * 	The multi-instance index of the topic.
+	 * @return see send_message()
+	 */
+	virtual int16_t send_message(const char *messageName, uint8_t instance, int32_t length, uint8_t *data)
+	{
+		return send_message(messageName, length, data);
+	}
+
 };
 
 /**
@@ -116,8 +116,13 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 			return -ENOMEM;
 		}
 
+#ifdef ORB_NO_VFS
+		/* no device file: the node list is the only registry */
+		ret = (getDeviceNodeLocked(meta, group_tries) != nullptr) ? -EEXIST : PX4_OK;
+#else
 		/* initialise the node - this may fail if e.g. a node with this name already exists */
 		ret = node->init();
+#endif /* ORB_NO_VFS */
 
 		/* if init failed, discard the node and its name */
 		if (ret != PX4_OK) {
@@ -162,8 +167,10 @@ int uORB::DeviceMaster::advertise(const struct orb_metadata *meta, bool is_adver
 				node->mark_as_advertised();
 			}
 
-			// add to the node map.
+			// add to the node map and the index, the node is only marked as existing once it can be found.
 			_node_list.add(node);
+			node->set_next_instance(_node_index[(uint8_t)node->id()]);
+			_node_index[(uint8_t)node->id()] = node;
 			_node_exists[node->get_instance()].set((uint8_t)node->id(), true);
 		}
 
@@ -184,6 +191,10 @@ void uORB::DeviceMaster::printStatistics(bool reset)
 	PX4_INFO("Statistics, since last output (%i ms):", (int)((current_time - _last_statistics_output) / 1000));
 	_last_statistics_output = current_time;
 
+#ifdef ORB_STATIC_ARENA
+	PX4_INFO("static topic arena: %zu bytes", orb_static_arena_size());
+#endif /* ORB_STATIC_ARENA */
+
 	PX4_INFO("TOPIC, NR LOST MSGS");
 	bool had_print = false;
 
@@ -208,13 +219,29 @@ void uORB::DeviceMaster::printStatistics(bool reset)
 			had_print = true;
 		}
 
+		cur_node = cur_node->next;
+	}
+
+	if (!had_print) {
+		PX4_INFO("No lost messages");
+	}
+
+	PX4_INFO("TOPIC, SUBSCRIBER FAN-OUT");
+	had_print = false;
+	cur_node = first_node;
+
+	while (cur_node) {
+		if (cur_node->node->print_fanout_statistics(reset)) {
+			had_print = true;
+		}
+
 		DeviceNodeStatisticsData *prev = cur_node;
 		cur_node = cur_node->next;
 		delete prev;
 	}
 
 	if (!had_print) {
-		PX4_INFO("No lost messages");
+		PX4_INFO("No subscriber notifications");
 	}
 }
 
@@ -293,26 +320,43 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 {
 	bool print_active_only = true;
 	bool only_once = false; // if true, run only once, then exit
+	bool print_latency = false; // if true, print the latency instrumentation instead of the rates
 
 	if (topic_filter && num_filters > 0) {
 		bool show_all = false;
+		int num_flags = 0;
 
 		for (int i = 0; i < num_filters; ++i) {
 			if (!strcmp("-a", topic_filter[i])) {
 				show_all = true;
+				num_flags++;
 
 			} else if (!strcmp("-1", topic_filter[i])) {
 				only_once = true;
+				num_flags++;
+
+			} else if (!strcmp("-l", topic_filter[i])) {
+				print_latency = true;
+				num_flags++;
 			}
 		}
 
-		print_active_only = only_once ? (num_filters == 1) : false; // print non-active if -a or some filter given
+		print_active_only = !show_all && (num_filters == num_flags); // print non-active if -a or some filter given
 
 		if (show_all || print_active_only) {
 			num_filters = 0;
 		}
 	}
 
+#ifndef ORB_INSTRUMENTATION
+
+	if (print_latency) {
+		PX4_WARN("latency instrumentation not available (build with UORB_INSTRUMENTATION)");
+		print_latency = false;
+	}
+
+#endif /* ORB_INSTRUMENTATION */
+
 	PX4_INFO_RAW("\033[2J\n"); //clear screen
 
 	lock();
@@ -404,12 +448,39 @@ void uORB::DeviceMaster::showTop(char **topic_filter, int num_filters)
 			}
 
 			PX4_INFO_RAW(CLEAR_LINE "update: 1s, num topics: %i\n", num_topics);
-			PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #LOST #Q SIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+
+			if (print_latency) {
+				PX4_INFO_RAW(CLEAR_LINE "%-*s INST RATE #Q QMAX  LAG   <50us  <100us  <200us  <500us    <1ms    <2ms    <5ms   >=5ms\n",
+					     (int)max_topic_name_length - 2, "TOPIC NAME");
+
+			} else {
+				PX4_INFO_RAW(CLEAR_LINE "%-*s INST #SUB RATE #LOST #Q SIZE\n", (int)max_topic_name_length - 2, "TOPIC NAME");
+			}
+
 			cur_node = first_node;
 
 			while (cur_node) {
 
 				if (!print_active_only || (cur_node->pub_msg_delta > 0 && cur_node->node->subscriber_count() > 0)) {
+#ifdef ORB_INSTRUMENTATION
+
+					if (print_latency) {
+						const uint32_t *histogram = cur_node->node->latency_histogram();
+
+						PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %2i %4i %4i %7u %7u %7u %7u %7u %7u %7u %7u\n",
+							     (int)max_topic_name_length,
+							     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
+							     cur_node->pub_msg_delta, cur_node->node->get_queue_size(),
+							     (int)cur_node->node->queue_depth_max(), (int)cur_node->node->callback_lag_max(),
+							     (unsigned)histogram[0], (unsigned)histogram[1], (unsigned)histogram[2], (unsigned)histogram[3],
+							     (unsigned)histogram[4], (unsigned)histogram[5], (unsigned)histogram[6], (unsigned)histogram[7]);
+
+						cur_node = cur_node->next;
+						continue;
+					}
+
+#endif /* ORB_INSTRUMENTATION */
+
 					PX4_INFO_RAW(CLEAR_LINE "%-*s %2i %4i %4i %5i %2i %4i \n", (int)max_topic_name_length,
 						     cur_node->node->get_meta()->o_name, (int)cur_node->node->get_instance(),
 						     (int)cur_node->node->subscriber_count(), cur_node->pub_msg_delta,
@@ -485,19 +556,24 @@ uORB::DeviceNode *uORB::DeviceMaster::getDeviceNode(const struct orb_metadata *m
 		return nullptr;
 	}
 
-	lock();
-	uORB::DeviceNode *node = getDeviceNodeLocked(meta, instance);
-	unlock();
-
 	//We can safely return the node that can be used by any thread, because
 	//a DeviceNode never gets deleted.
-	return node;
+	return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
 }
 
 uORB::DeviceNode *uORB::DeviceMaster::getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance)
 {
-	for (uORB::DeviceNode *node : _node_list) {
-		if ((strcmp(node->get_name(), meta->o_name) == 0) && (node->get_instance() == instance)) {
+	return findDeviceNode(static_cast<ORB_ID>(meta->o_id), instance);
+}
+
+uORB::DeviceNode *uORB::DeviceMaster::findDeviceNode(ORB_ID id, const uint8_t instance) const
+{
+	if ((id == ORB_ID::INVALID) || ((size_t)id >= ORB_TOPICS_COUNT)) {
+		return nullptr;
+	}
+
+	for (uORB::DeviceNode *node = _node_index[(uint8_t)id]; node != nullptr; node = node->next_instance()) {
+		if (node->get_instance() == instance) {
 			return node;
 		}
 	}
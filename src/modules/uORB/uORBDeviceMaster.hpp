@@ -111,15 +111,28 @@ private:
 	friend class uORB::Manager;
 
 	/**
-	 * Find a node give its name.
+	 * Find a node given its ORB_ID and instance.
 	 * _lock must already be held when calling this.
 	 * @return node if exists, nullptr otherwise
 	 */
 	uORB::DeviceNode *getDeviceNodeLocked(const struct orb_metadata *meta, const uint8_t instance);
 
+	/**
+	 * Lookup a node in the ORB_ID index, does not require _lock.
+	 * @return node if exists, nullptr otherwise
+	 */
+	uORB::DeviceNode *findDeviceNode(ORB_ID id, const uint8_t instance) const;
+
 	List<uORB::DeviceNode *> _node_list;
 	AtomicBitset<ORB_TOPICS_COUNT> _node_exists[ORB_MULTI_MAX_INSTANCES];
 
+	/**
+	 * Nodes indexed by ORB_ID. Each entry is the head of the chain of instances of that topic
+	 * (see DeviceNode::next_instance()). Entries are only ever added and a node is
+	 * never deleted, so the index can be read without holding _lock.
+	 */
+	uORB::DeviceNode *_node_index[ORB_TOPICS_COUNT] {};
+
 	hrt_abstime       _last_statistics_output;
 
 	px4_sem_t	_lock; /**< lock to protect access to all class members (also for derived classes) */
@@ -38,10 +38,16 @@
 
 #include "SubscriptionCallback.hpp"
 
+#include <px4_platform_common/trace.h>
+
 #ifdef ORB_COMMUNICATOR
 #include "uORBCommunicator.hpp"
 #endif /* ORB_COMMUNICATOR */
 
+#ifdef ORB_STATIC_ARENA
+#include <new>
+#endif /* ORB_STATIC_ARENA */
+
 uORB::DeviceNode::SubscriberData *uORB::DeviceNode::filp_to_sd(cdev::file_t *filp)
 {
 #ifndef __PX4_NUTTX
@@ -60,13 +66,19 @@ uORB::DeviceNode::DeviceNode(const struct orb_metadata *meta, const uint8_t inst
 	_meta(meta),
 	_priority(priority),
 	_instance(instance),
-	_queue_size(queue_size)
+	_queue_size(queue_size),
+	_seqlock(meta->o_size > SEQLOCK_MIN_SIZE)
 {
 }
 
 uORB::DeviceNode::~DeviceNode()
 {
-	delete[] _data;
+	if (!_static_buffer) {
+		delete[] _data;
+		delete[] _slot_tag;
+	}
+
+	delete[] _callbacks;
 
 	CDev::unregister_driver_and_memory();
 }
@@ -171,17 +183,230 @@ uORB::DeviceNode::copy_locked(void *dst, unsigned &generation)
 	return updated;
 }
 
+const uint8_t *
+uORB::DeviceNode::seqlock_slot(unsigned generation, unsigned &read_generation, unsigned &tag,
+			       unsigned &current_generation) const
+{
+	current_generation = _generation.load();
+	read_generation = generation;
+
+	if (current_generation == 0) {
+		// nothing published yet, slot 0 may be busy with the first publication
+		return nullptr;
+	}
+
+	if (current_generation > read_generation + _queue_size) {
+		// Reader is too far behind: some messages are lost
+		read_generation = current_generation - _queue_size;
+	}
+
+	if ((current_generation == read_generation) && (read_generation > 0)) {
+		// nothing new published yet, return the previous message
+		--read_generation;
+	}
+
+	const unsigned slot = read_generation % buffer_slots();
+	tag = read_generation << 1;
+
+	if (_slot_tag[slot].load() != tag) {
+		// the publisher lapped us
+		return nullptr;
+	}
+
+	return _data + (_meta->o_size * slot);
+}
+
+void
+uORB::DeviceNode::seqlock_advance(unsigned &generation, unsigned read_generation, unsigned current_generation)
+{
+	if (read_generation > generation) {
+		_lost_messages += read_generation - generation;
+	}
+
+	generation = (read_generation < current_generation) ? read_generation + 1 : read_generation;
+}
+
+bool
+uORB::DeviceNode::copy_seqlock(void *dst, unsigned &generation, bool may_block)
+{
+	if ((dst == nullptr) || (_data == nullptr)) {
+		return false;
+	}
+
+	unsigned read_generation;
+	unsigned current_generation;
+	unsigned tag;
+
+	for (int attempt = 0; attempt < SEQLOCK_RETRIES; attempt++) {
+		const uint8_t *slot = seqlock_slot(generation, read_generation, tag, current_generation);
+
+		if (current_generation == 0) {
+			return false;
+		}
+
+		if (slot != nullptr) {
+			memcpy(dst, slot, _meta->o_size);
+
+			if (borrow_valid(slot, tag)) {
+				seqlock_advance(generation, read_generation, current_generation);
+				return true;
+			}
+		}
+
+		// the publisher lapped us while copying, retry with the latest generation
+	}
+
+	if (!may_block) {
+		// the generation is unchanged, the message is picked up with the next call
+		return false;
+	}
+
+	// Publishers kept overwriting the slot, e.g. we preempted one in the middle of a write.
+	// Publishers write under the lock, so the slot is stable while we hold it.
+	lock();
+
+	const uint8_t *slot = seqlock_slot(generation, read_generation, tag, current_generation);
+
+	if (slot != nullptr) {
+		memcpy(dst, slot, _meta->o_size);
+		seqlock_advance(generation, read_generation, current_generation);
+	}
+
+	unlock();
+
+	return slot != nullptr;
+}
+
+const void *
+uORB::DeviceNode::borrow(unsigned &generation, unsigned &tag)
+{
+	if (!_seqlock || (_data == nullptr)) {
+		return nullptr;
+	}
+
+	for (int attempt = 0; attempt < SEQLOCK_RETRIES; attempt++) {
+		unsigned read_generation;
+		unsigned current_generation;
+		const uint8_t *slot = seqlock_slot(generation, read_generation, tag, current_generation);
+
+		if (current_generation == 0) {
+			return nullptr;
+		}
+
+		if (slot != nullptr) {
+			seqlock_advance(generation, read_generation, current_generation);
+			return slot;
+		}
+	}
+
+	// publishers kept overwriting the slot, the generation is unchanged so the caller can try again later
+	return nullptr;
+}
+
+bool
+uORB::DeviceNode::borrow_valid(const void *data, unsigned tag) const
+{
+	if ((data == nullptr) || (_slot_tag == nullptr)) {
+		return false;
+	}
+
+	const unsigned slot = ((const uint8_t *)data - _data) / _meta->o_size;
+
+	// the data reads must complete before the tag is checked again
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+	return _slot_tag[slot].load() == tag;
+}
+
 bool
 uORB::DeviceNode::copy(void *dst, unsigned &generation)
 {
+#ifdef ORB_INSTRUMENTATION
+	const unsigned pending = _generation.load() - generation;
+#endif /* ORB_INSTRUMENTATION */
+
+	bool updated;
+
+	if (_seqlock) {
+		updated = copy_seqlock(dst, generation);
+
+	} else {
+		ATOMIC_ENTER;
+
+		updated = copy_locked(dst, generation);
+
+		ATOMIC_LEAVE;
+	}
+
+#ifdef ORB_INSTRUMENTATION
+
+	if (updated) {
+		record_copy(pending);
+	}
+
+#endif /* ORB_INSTRUMENTATION */
+
+	return updated;
+}
+
+bool
+uORB::DeviceNode::copy_from_callback(void *dst, unsigned &generation)
+{
+	if (generation == _generation.load()) {
+		return false;
+	}
+
+	return _seqlock ? copy_seqlock(dst, generation, false) : copy_locked(dst, generation);
+}
+
+#ifdef ORB_INSTRUMENTATION
+constexpr uint16_t uORB::DeviceNode::LATENCY_BUCKET_LIMITS_US[];
+
+void
+uORB::DeviceNode::record_copy(unsigned pending)
+{
+	if (pending > _queue_depth_max) {
+		_queue_depth_max = (pending > UINT8_MAX) ? UINT8_MAX : pending;
+	}
+
+	const unsigned generation = _generation.load();
+
+	// only the first subscriber copying the latest message counts
+	if ((pending > 0) && (generation != _first_consumed_generation)) {
+		_first_consumed_generation = generation;
+
+		const hrt_abstime latency = hrt_elapsed_time(&_publish_timestamp);
+
+		uint8_t bucket = 0;
+
+		while ((bucket < LATENCY_BUCKETS - 1) && (latency >= LATENCY_BUCKET_LIMITS_US[bucket])) {
+			bucket++;
+		}
+
+		_latency_histogram[bucket]++;
+	}
+}
+
+unsigned
+uORB::DeviceNode::callback_lag_max()
+{
+	unsigned lag_max = 0;
+
 	ATOMIC_ENTER;
 
-	bool updated = copy_locked(dst, generation);
+	for (unsigned i = 0; i < _callbacks_count; i++) {
+		const unsigned lag = published_message_count() - _callbacks[i]->get_last_generation();
+
+		if (lag > lag_max) {
+			lag_max = lag;
+		}
+	}
 
 	ATOMIC_LEAVE;
 
-	return updated;
+	return lag_max;
 }
+#endif /* ORB_INSTRUMENTATION */
 
 ssize_t
 uORB::DeviceNode::read(cdev::file_t *filp, char *buffer, size_t buflen)
@@ -198,6 +423,17 @@ uORB::DeviceNode::read(cdev::file_t *filp, char *buffer, size_t buflen)
 
 	SubscriberData *sd = (SubscriberData *)filp_to_sd(filp);
 
+	if (_seqlock) {
+		// the subscriber state is only accessed by the file handle owner
+		if (sd->update_interval) {
+			sd->update_interval->last_update = hrt_absolute_time();
+		}
+
+		copy_seqlock(buffer, sd->generation);
+
+		return _meta->o_size;
+	}
+
 	/*
 	 * Perform an atomic copy & state update
 	 */
@@ -226,7 +462,18 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	 * if it has not yet been allocated.
 	 *
 	 * Note that filp will usually be NULL.
+	 *
+	 * Seqlock nodes serialize publishers with the node lock and therefore
+	 * can only be published from thread context.
 	 */
+#ifdef __PX4_NUTTX
+
+	if (_seqlock && up_interrupt_context()) {
+		return -EPERM;
+	}
+
+#endif /* __PX4_NUTTX */
+
 	if (nullptr == _data) {
 
 #ifdef __PX4_NUTTX
@@ -234,14 +481,7 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		if (!up_interrupt_context()) {
 #endif /* __PX4_NUTTX */
 
-			lock();
-
-			/* re-check size */
-			if (nullptr == _data) {
-				_data = new uint8_t[_meta->o_size * _queue_size];
-			}
-
-			unlock();
+			allocate_buffer();
 
 #ifdef __PX4_NUTTX
 		}
@@ -259,16 +499,99 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 		return -EIO;
 	}
 
-	/* Perform an atomic copy. */
-	ATOMIC_ENTER;
-	/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
-	unsigned generation = _generation.fetch_add(1);
+	if (_seqlock) {
+		memcpy(seqlock_begin_write(), buffer, _meta->o_size);
+		seqlock_end_write();
+
+	} else {
+		/* Perform an atomic copy. */
+		ATOMIC_ENTER;
+		/* wrap-around happens after ~49 days, assuming a publisher rate of 1 kHz */
+		unsigned generation = _generation.fetch_add(1);
+
+		memcpy(_data + (_meta->o_size * (generation % _queue_size)), buffer, _meta->o_size);
+
+		ATOMIC_LEAVE;
+	}
+
+	notify_subscribers();
+
+	return _meta->o_size;
+}
+
+bool
+uORB::DeviceNode::allocate_buffer()
+{
+	if (_data != nullptr) {
+		return true;
+	}
+
+	lock();
+
+	/* re-check size */
+#ifdef ORB_STATIC_ARENA
+
+	if ((nullptr == _data) && (_slot_tag == nullptr)) {
+		// same layout as reserved by orb_static_arena(): slot tags followed by the data slots
+		const size_t tags_size = _seqlock ? ((sizeof(px4::atomic<unsigned>) * buffer_slots() + 7u) & ~static_cast<size_t>(7u)) : 0;
+		uint8_t *arena = static_cast<uint8_t *>(orb_static_arena(static_cast<ORB_ID>(_meta->o_id), _instance,
+						 tags_size + _meta->o_size * buffer_slots()));
+
+		if (arena != nullptr) {
+			if (_seqlock) {
+				_slot_tag = reinterpret_cast<px4::atomic<unsigned> *>(arena);
+
+				for (unsigned i = 0; i < buffer_slots(); i++) {
+					new (&_slot_tag[i]) px4::atomic<unsigned>(0);
+				}
+			}
+
+			_data = arena + tags_size;
+			_static_buffer = true;
+		}
+
+		// otherwise (e.g. a larger queue than ORB_QUEUE_LENGTH) fall back to the heap
+	}
+
+#endif /* ORB_STATIC_ARENA */
+
+	if (nullptr == _data) {
+		if (_seqlock && (_slot_tag == nullptr)) {
+			_slot_tag = new px4::atomic<unsigned>[buffer_slots()];
+		}
+
+		if (!_seqlock || _slot_tag) {
+			_data = new uint8_t[_meta->o_size * buffer_slots()];
+		}
+	}
+
+	unlock();
+
+	return _data != nullptr;
+}
+
+void
+uORB::DeviceNode::notify_subscribers()
+{
+#ifdef ORB_INSTRUMENTATION
+	const bool measure = true;
+#else
+	const bool measure = (_generation.load() % FANOUT_SAMPLE_INTERVAL) == 0;
+#endif /* ORB_INSTRUMENTATION */
 
-	memcpy(_data + (_meta->o_size * (generation % _queue_size)), buffer, _meta->o_size);
+	const hrt_abstime start = measure ? hrt_absolute_time() : 0;
+
+#ifdef ORB_INSTRUMENTATION
+	_publish_timestamp = start;
+#endif /* ORB_INSTRUMENTATION */
+
+	px4::trace::event(px4::trace::Event::Publish, _meta->o_name);
 
 	// callbacks
-	for (auto item : _callbacks) {
-		item->call();
+	ATOMIC_ENTER;
+
+	for (unsigned i = 0; i < _callbacks_count; i++) {
+		_callbacks[i]->call();
 	}
 
 	ATOMIC_LEAVE;
@@ -276,7 +599,77 @@ uORB::DeviceNode::write(cdev::file_t *filp, const char *buffer, size_t buflen)
 	/* notify any poll waiters */
 	poll_notify(POLLIN);
 
-	return _meta->o_size;
+	if (measure) {
+		_fanout_time_us = hrt_elapsed_time(&start);
+
+		if (_fanout_time_us > _fanout_time_max_us) {
+			_fanout_time_max_us = _fanout_time_us;
+		}
+	}
+}
+
+uint8_t *
+uORB::DeviceNode::seqlock_begin_write()
+{
+	lock();
+
+	const unsigned generation = _generation.load();
+	const unsigned slot = generation % buffer_slots();
+
+	// mark the slot busy until seqlock_end_write()
+	_slot_tag[slot].store((generation << 1) | 1);
+
+	// keep the data writes from becoming visible before the busy tag
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	return _data + (_meta->o_size * slot);
+}
+
+void
+uORB::DeviceNode::seqlock_end_write()
+{
+	const unsigned generation = _generation.load();
+	const unsigned slot = generation % buffer_slots();
+
+	// the slot is complete, only now make the new generation visible
+	_slot_tag[slot].store(generation << 1);
+	_generation.store(generation + 1);
+
+	unlock();
+}
+
+void *
+uORB::DeviceNode::loan()
+{
+	if (!_seqlock || !allocate_buffer()) {
+		return nullptr;
+	}
+
+	return seqlock_begin_write();
+}
+
+int
+uORB::DeviceNode::commit_loan()
+{
+	seqlock_end_write();
+
+	notify_subscribers();
+
+#ifdef ORB_COMMUNICATOR
+	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
+
+	if (ch != nullptr) {
+		const unsigned slot = (_generation.load() - 1) % buffer_slots();
+
+		if (ch->send_message(_meta->o_name, _instance, _meta->o_size, _data + (_meta->o_size * slot)) != 0) {
+			PX4_ERR("Error Sending [%s] topic data over comm_channel", _meta->o_name);
+			return PX4_ERROR;
+		}
+	}
+
+#endif /* ORB_COMMUNICATOR */
+
+	return PX4_OK;
 }
 
 int
@@ -396,7 +789,7 @@ uORB::DeviceNode::publish(const orb_metadata *meta, orb_advert_t handle, const v
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (ch != nullptr) {
-		if (ch->send_message(meta->o_name, meta->o_size, (uint8_t *)data) != 0) {
+		if (ch->send_message(meta->o_name, devnode->_instance, meta->o_size, (uint8_t *)data) != 0) {
 			PX4_ERR("Error Sending [%s] topic data over comm_channel", meta->o_name);
 			return PX4_ERROR;
 		}
@@ -572,7 +965,7 @@ int16_t uORB::DeviceNode::process_add_subscription(int32_t rateInHz)
 	uORBCommunicator::IChannel *ch = uORB::Manager::get_instance()->get_uorb_communicator();
 
 	if (_data != nullptr && ch != nullptr) { // _data will not be null if there is a publisher.
-		ch->send_message(_meta->o_name, _meta->o_size, _data);
+		ch->send_message(_meta->o_name, _instance, _meta->o_size, _data);
 	}
 
 	return PX4_OK;
@@ -626,29 +1019,99 @@ int uORB::DeviceNode::update_queue_size(unsigned int queue_size)
 bool
 uORB::DeviceNode::register_callback(uORB::SubscriptionCallback *callback_sub)
 {
-	if (callback_sub != nullptr) {
-		ATOMIC_ENTER;
+	if (callback_sub == nullptr) {
+		return false;
+	}
+
+	for (;;) {
+		uint16_t size = 0;
 
-		// prevent duplicate registrations
-		for (auto existing_callbacks : _callbacks) {
-			if (callback_sub == existing_callbacks) {
+		{
+			ATOMIC_ENTER;
+
+			// prevent duplicate registrations
+			for (unsigned i = 0; i < _callbacks_count; i++) {
+				if (_callbacks[i] == callback_sub) {
+					ATOMIC_LEAVE;
+					return true;
+				}
+			}
+
+			if (_callbacks_count < _callbacks_size) {
+				_callbacks[_callbacks_count++] = callback_sub;
 				ATOMIC_LEAVE;
 				return true;
 			}
+
+			size = _callbacks_size;
+
+			ATOMIC_LEAVE;
 		}
 
-		_callbacks.add(callback_sub);
-		ATOMIC_LEAVE;
-		return true;
-	}
+		// the table is full, grow it outside of the critical section
+		const uint16_t new_size = (size == 0) ? 4 : size * 2;
+		uORB::SubscriptionCallback **callbacks = new uORB::SubscriptionCallback *[new_size];
 
-	return false;
+		if (callbacks == nullptr) {
+			PX4_ERR("%s: callback registration failed", _meta->o_name);
+			return false;
+		}
+
+		{
+			ATOMIC_ENTER;
+
+			if (_callbacks_size == size) {
+				// nobody else grew it in the meantime, swap the tables
+				for (unsigned i = 0; i < _callbacks_count; i++) {
+					callbacks[i] = _callbacks[i];
+				}
+
+				uORB::SubscriptionCallback **previous = _callbacks;
+				_callbacks = callbacks;
+				_callbacks_size = new_size;
+				callbacks = previous;
+			}
+
+			ATOMIC_LEAVE;
+		}
+
+		// the replaced (or unused) table, nobody iterates it outside of the critical section
+		delete[] callbacks;
+	}
 }
 
 void
 uORB::DeviceNode::unregister_callback(uORB::SubscriptionCallback *callback_sub)
 {
 	ATOMIC_ENTER;
-	_callbacks.remove(callback_sub);
+
+	for (unsigned i = 0; i < _callbacks_count; i++) {
+		if (_callbacks[i] == callback_sub) {
+			// keep the table dense, the order doesn't matter
+			_callbacks[i] = _callbacks[--_callbacks_count];
+			_callbacks[_callbacks_count] = nullptr;
+			break;
+		}
+	}
+
 	ATOMIC_LEAVE;
 }
+
+bool
+uORB::DeviceNode::print_fanout_statistics(bool reset)
+{
+	const unsigned callbacks = callback_count();
+
+	if ((callbacks == 0) && (_fanout_time_max_us == 0)) {
+		return false;
+	}
+
+	PX4_INFO("%s: %i callbacks, fan-out %i us (max %i us)", _meta->o_name, callbacks, (int)_fanout_time_us,
+		 (int)_fanout_time_max_us);
+
+	if (reset) {
+		_fanout_time_max_us = 0;
+	}
+
+	return true;
+}
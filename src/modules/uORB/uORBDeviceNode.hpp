@@ -175,6 +175,17 @@ public:
 	 */
 	int update_queue_size(unsigned int queue_size);
 
+	/**
+	 * update_queue_size() taking the node lock (for the advertiser, instead of the ORBIOCSETQUEUESIZE ioctl).
+	 */
+	int set_queue_size(unsigned int queue_size)
+	{
+		lock();
+		int ret = update_queue_size(queue_size);
+		unlock();
+		return ret;
+	}
+
 	/**
 	 * Print statistics (nr of lost messages)
 	 * @param reset if true, reset statistics afterwards
@@ -201,6 +212,12 @@ public:
 	ORB_PRIO get_priority() const { return (ORB_PRIO)_priority; }
 	void set_priority(ORB_PRIO priority) { _priority = priority; }
 
+	/**
+	 * Next instance of the same topic in the DeviceMaster ORB_ID index.
+	 */
+	DeviceNode *next_instance() const { return _next_instance; }
+	void set_next_instance(DeviceNode *node) { _next_instance = node; }
+
 	/**
 	 * Copies data and the corresponding generation
 	 * from a node to the buffer provided.
@@ -214,12 +231,96 @@ public:
 	 */
 	bool copy(void *dst, unsigned &generation);
 
-	// add item to list of work items to schedule on node update
+	/**
+	 * Copy the message following generation from within SubscriptionCallback::call(),
+	 * where the node is already locked (ATOMIC_ENTER) by the publisher.
+	 *
+	 * @return bool
+	 *   Returns true if there was a message newer than generation.
+	 */
+	bool copy_from_callback(void *dst, unsigned &generation);
+
+	/**
+	 * Return true if this node uses the lock-free (seqlock) publish/copy path.
+	 */
+	bool is_seqlock() const { return _seqlock; }
+
+	/**
+	 * Loan the next queue slot to a publisher so the message can be filled in place
+	 * (seqlock nodes only). The node lock is held until commit_loan() is called,
+	 * so the caller must not access this node in the meantime.
+	 *
+	 * @return pointer to the slot, or nullptr if the node can't be loaned
+	 */
+	void *loan();
+
+	/**
+	 * Publish the slot returned by a previous successful loan().
+	 * @return PX4_OK on success
+	 */
+	int commit_loan();
+
+	/**
+	 * Borrow the message following generation in place instead of copying it
+	 * (seqlock nodes only). A publisher may overwrite the slot while it's borrowed,
+	 * borrow_valid() must be checked after the data was used.
+	 *
+	 * @param generation
+	 *   The last generation seen, updated to the borrowed one.
+	 * @param tag
+	 *   Returns the slot tag to pass to borrow_valid().
+	 * @return pointer to the message or nullptr if nothing was published yet or
+	 *   publishers kept overwriting the slot (try again later)
+	 */
+	const void *borrow(unsigned &generation, unsigned &tag);
+
+	/**
+	 * Check that a borrowed message wasn't overwritten in the meantime.
+	 */
+	bool borrow_valid(const void *data, unsigned tag) const;
+
+	/**
+	 * Topics larger than this (in bytes) use the seqlock path, smaller ones are
+	 * cheaper to copy with interrupts disabled.
+	 */
+	static constexpr uint16_t SEQLOCK_MIN_SIZE = ORB_SEQLOCK_MIN_SIZE;
+
+	// add item to the callback registry of work items to schedule on node update
 	bool register_callback(SubscriptionCallback *callback_sub);
 
-	// remove item from list of work items
+	// remove item from the callback registry
 	void unregister_callback(SubscriptionCallback *callback_sub);
 
+	/**
+	 * Print the number of callbacks and the subscriber notification (fan-out) time.
+	 * @param reset if true, reset the maximum afterwards
+	 * @return true if printed something, false otherwise (if nobody is notified)
+	 */
+	bool print_fanout_statistics(bool reset);
+
+	unsigned callback_count() const { return _callbacks_count; }
+
+#ifdef ORB_INSTRUMENTATION
+	/**
+	 * Number of buckets of the publish to first consume latency histogram
+	 * and the upper limits of all but the last one (in microseconds).
+	 */
+	static constexpr uint8_t LATENCY_BUCKETS = 8;
+	static constexpr uint16_t LATENCY_BUCKET_LIMITS_US[LATENCY_BUCKETS - 1] {50, 100, 200, 500, 1000, 2000, 5000};
+
+	const uint32_t *latency_histogram() const { return _latency_histogram; }
+
+	/**
+	 * High-water mark of unread messages seen by any subscriber.
+	 */
+	uint8_t queue_depth_max() const { return _queue_depth_max; }
+
+	/**
+	 * Maximum number of messages the callback subscribers are behind.
+	 */
+	unsigned callback_lag_max();
+#endif /* ORB_INSTRUMENTATION */
+
 protected:
 
 	px4_pollevent_t poll_state(cdev::file_t *filp) override;
@@ -241,6 +342,63 @@ private:
 	 */
 	bool copy_locked(void *dst, unsigned &generation);
 
+	/**
+	 * Lock-free variant of copy_locked() used for seqlock nodes. The slot tag is
+	 * validated before and after the copy and the copy is retried if a publisher
+	 * overwrote the slot in the meantime. After SEQLOCK_RETRIES attempts the copy
+	 * is done under the publisher lock, so a reader that preempted a publisher
+	 * (e.g. on a single core) can't spin forever.
+	 *
+	 * @param may_block
+	 *   false inside ATOMIC_ENTER (callback loop): give up instead of taking the lock
+	 */
+	bool copy_seqlock(void *dst, unsigned &generation, bool may_block = true);
+
+	static constexpr int SEQLOCK_RETRIES = 3;
+
+	/**
+	 * Without ORB_INSTRUMENTATION only every n-th publication measures its fan-out time,
+	 * to keep the timer reads off the publish path.
+	 */
+	static constexpr unsigned FANOUT_SAMPLE_INTERVAL = 64;
+
+	/**
+	 * Find the slot holding the message following generation on a seqlock node.
+	 * @return the slot or nullptr if nothing was published yet (current_generation 0)
+	 *   or it's currently being overwritten
+	 */
+	const uint8_t *seqlock_slot(unsigned generation, unsigned &read_generation, unsigned &tag,
+				    unsigned &current_generation) const;
+
+	/**
+	 * Advance the generation of a seqlock reader after a successful read.
+	 */
+	void seqlock_advance(unsigned &generation, unsigned read_generation, unsigned current_generation);
+
+	/**
+	 * Start/finish publishing into the next slot of a seqlock node. Publishers are
+	 * serialized with the node lock, subscribers are never blocked.
+	 */
+	uint8_t *seqlock_begin_write();
+	void seqlock_end_write();
+
+	/**
+	 * Allocate the message buffer if needed (thread context only).
+	 * @return true if the buffer is available
+	 */
+	bool allocate_buffer();
+
+	/**
+	 * Run the registered callbacks and notify the poll waiters after a publication.
+	 */
+	void notify_subscribers();
+
+	/**
+	 * Number of allocated buffer slots. Seqlock nodes use one spare slot so that
+	 * the slot being written is never the newest one a subscriber can read.
+	 */
+	unsigned buffer_slots() const { return _seqlock ? _queue_size + 1 : _queue_size; }
+
 	struct UpdateIntervalData {
 		uint64_t last_update{0}; /**< time at which the last update was provided, used when update_interval is nonzero */
 		unsigned interval{0}; /**< if nonzero minimum interval between updates */
@@ -254,19 +412,40 @@ private:
 	};
 
 	const orb_metadata *_meta; /**< object metadata information */
+	DeviceNode *_next_instance{nullptr}; /**< next instance of this topic in the DeviceMaster index */
 
 	uint8_t     *_data{nullptr};   /**< allocated object buffer */
 	px4::atomic<unsigned>  _generation{0};  /**< object generation count */
-	List<uORB::SubscriptionCallback *>	_callbacks;
+	px4::atomic<unsigned> *_slot_tag{nullptr}; /**< per slot (generation << 1) | busy, seqlock nodes only */
+	uORB::SubscriptionCallback **_callbacks{nullptr}; /**< callback table, grown on registration */
+	uint16_t _callbacks_size{0}; /**< allocated entries of _callbacks */
+	uint16_t _callbacks_count{0}; /**< used entries of _callbacks, kept dense (protected by ATOMIC_ENTER) */
 
 	// statistics
 	uint32_t _lost_messages = 0; /**< nr of lost messages for all subscribers. If two subscribers lose the same
 					message, it is counted as two. */
+	uint32_t _fanout_time_us{0}; /**< last measured time spent notifying callbacks and poll waiters */
+	uint32_t _fanout_time_max_us{0}; /**< maximum measured time spent notifying callbacks and poll waiters */
+
+#ifdef ORB_INSTRUMENTATION
+	hrt_abstime _publish_timestamp{0}; /**< time of the last publication */
+	unsigned _first_consumed_generation{0}; /**< last generation whose first copy was recorded */
+	uint32_t _latency_histogram[LATENCY_BUCKETS] {}; /**< publish to first consume latency */
+	uint8_t _queue_depth_max{0};
+
+	/**
+	 * Record the queue depth and first consume latency after a subscriber copied.
+	 * @param pending number of unread messages of the subscriber before the copy
+	 */
+	void record_copy(unsigned pending);
+#endif /* ORB_INSTRUMENTATION */
 
 	ORB_PRIO _priority;  /**< priority of the topic */
 	const uint8_t _instance; /**< orb multi instance identifier */
 	bool _advertised{false};  /**< has ever been advertised (not necessarily published data yet) */
 	uint8_t _queue_size; /**< maximum number of elements in the queue */
+	const bool _seqlock; /**< lock-free publish/copy (large topics) instead of disabling interrupts */
+	bool _static_buffer{false}; /**< _data and _slot_tag live in the static arena (ORB_STATIC_ARENA) */
 	int8_t _subscriber_count{0};
 
 	inline static SubscriberData    *filp_to_sd(cdev::file_t *filp);
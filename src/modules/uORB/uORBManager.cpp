@@ -167,6 +167,24 @@ int uORB::Manager::orb_exists(const struct orb_metadata *meta, int instance)
 	return ret;
 }
 
+int uORB::Manager::orb_create_node(const struct orb_metadata *meta, int instance)
+{
+	if ((meta == nullptr) || (instance < 0) || (instance > (ORB_MULTI_MAX_INSTANCES - 1))) {
+		return PX4_ERROR;
+	}
+
+	if (get_device_master()) {
+		// as a subscriber: an existing node is reused, otherwise an unadvertised one is created
+		int inst = instance;
+
+		if (_device_master->advertise(meta, false, &inst, ORB_PRIO_DEFAULT) == PX4_OK) {
+			return PX4_OK;
+		}
+	}
+
+	return PX4_ERROR;
+}
+
 orb_advert_t uORB::Manager::orb_advertise_multi(const struct orb_metadata *meta, const void *data, int *instance,
 		ORB_PRIO priority, unsigned int queue_size)
 {
@@ -194,33 +212,40 @@ orb_advert_t uORB::Manager::orb_advertise_multi(const struct orb_metadata *meta,
 
 #endif /* ORB_USE_PUBLISHER_RULES */
 
-	/* open the node as an advertiser */
-	int fd = node_open(meta, true, instance, priority);
+	if (meta == nullptr) {
+		return nullptr;
+	}
+
+	/* advertise the node directly (creating it if necessary), the advertiser handle is the node itself */
+	uORB::DeviceNode *node = nullptr;
 
-	if (fd == PX4_ERROR) {
-		PX4_ERR("%s advertise failed (%i)", meta->o_name, errno);
+	if (get_device_master()) {
+		int ret = _device_master->advertise(meta, true, instance, priority);
+
+		if (ret == PX4_OK) {
+			node = _device_master->getDeviceNode(meta, (instance != nullptr) ? *instance : 0);
+
+		} else {
+			PX4_ERR("%s advertise failed (%i)", meta->o_name, ret);
+			return nullptr;
+		}
+	}
+
+	if (node == nullptr) {
+		PX4_ERR("%s advertise failed", meta->o_name);
 		return nullptr;
 	}
 
 	/* Set the queue size. This must be done before the first publication; thus it fails if
 	 * this is not the first advertiser.
 	 */
-	int result = px4_ioctl(fd, ORBIOCSETQUEUESIZE, (unsigned long)queue_size);
+	int result = node->set_queue_size(queue_size);
 
 	if (result < 0 && queue_size > 1) {
 		PX4_WARN("orb_advertise_multi: failed to set queue size");
 	}
 
-	/* get the advertiser handle and close the node */
-	orb_advert_t advertiser;
-
-	result = px4_ioctl(fd, ORBIOCGADVERTISER, (unsigned long)&advertiser);
-	px4_close(fd);
-
-	if (result == PX4_ERROR) {
-		PX4_WARN("px4_ioctl ORBIOCGADVERTISER failed. fd = %d", fd);
-		return nullptr;
-	}
+	orb_advert_t advertiser = (orb_advert_t)node;
 
 #ifdef ORB_COMMUNICATOR
 	// For remote systems call over and inform them
@@ -339,6 +364,13 @@ int uORB::Manager::node_open(const struct orb_metadata *meta, bool advertiser, i
 		return PX4_ERROR;
 	}
 
+#ifdef ORB_NO_VFS
+	// topics are not registered as device files, only the fd-less API (uORB::Subscription*) is available
+	PX4_ERR("%s: file descriptor API not available", meta->o_name);
+	errno = ENOTSUP;
+	return PX4_ERROR;
+#endif /* ORB_NO_VFS */
+
 	/* if we have an instance and are an advertiser, we will generate a new node and set the instance,
 	 * so we do not need to open here */
 	if (!instance || !advertiser) {
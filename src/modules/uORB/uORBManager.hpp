@@ -308,6 +308,17 @@ public:
 	 */
 	int  orb_exists(const struct orb_metadata *meta, int instance);
 
+	/**
+	 * Create the node of a topic instance if it doesn't exist yet, without advertising it.
+	 * This lets a subscription (e.g. with a callback) attach before the first advertiser,
+	 * without opening a file descriptor.
+	 *
+	 * @param meta    ORB topic metadata.
+	 * @param instance  ORB instance
+	 * @return    OK if the node exists now, PX4_ERROR otherwise.
+	 */
+	int  orb_create_node(const struct orb_metadata *meta, int instance);
+
 	/**
 	 * Return the priority of the topic
 	 *
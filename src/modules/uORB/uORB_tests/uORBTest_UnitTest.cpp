@@ -208,7 +208,19 @@ int uORBTest::UnitTest::test()
 		return ret;
 	}
 
-	return test_queue_poll_notify();
+	ret = test_queue_poll_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	ret = test_queue_wait_notify();
+
+	if (ret != OK) {
+		return ret;
+	}
+
+	return test_queued_subscription();
 }
 
 int uORBTest::UnitTest::test_unadvertise()
@@ -823,6 +835,64 @@ int uORBTest::UnitTest::test_queue_poll_notify()
 	return test_note("PASS orb queuing (poll & notify), got %i messages", next_expected_val);
 }
 
+int uORBTest::UnitTest::test_queue_wait_notify()
+{
+	test_note("Testing orb queuing (wait object & notify)");
+
+	uORB::WaitObject wait;
+	uORB::SubscriptionCallbackWait sub{wait, ORB_ID(orb_test_medium_queue_poll)};
+	orb_test_medium_s t{};
+
+	if (!sub.registerCallback()) {
+		return test_fail("registerCallback failed");
+	}
+
+	// skip what the previous test published
+	while (sub.update(&t)) {}
+
+	_thread_should_exit = false;
+
+	char *const args[1] = { nullptr };
+	int pubsub_task = px4_task_spawn_cmd("uorb_test_queue",
+					     SCHED_DEFAULT,
+					     SCHED_PRIORITY_MIN + 5,
+					     3000,
+					     (px4_main_t)&uORBTest::UnitTest::pub_test_queue_entry,
+					     args);
+
+	if (pubsub_task < 0) {
+		return test_fail("failed launching task");
+	}
+
+	int next_expected_val = 0;
+
+	while (!_thread_should_exit) {
+
+		if (!wait.wait(500 * 1000)) {
+			if (_thread_should_exit) {
+				break;
+			}
+
+			return test_fail("wait timeout");
+		}
+
+		// one notification can stand for several publications
+		while (sub.update(&t)) {
+			if (next_expected_val != t.val) {
+				return test_fail("copy mismatch: %d expected %d", t.val, next_expected_val);
+			}
+
+			++next_expected_val;
+		}
+	}
+
+	if (_num_messages_sent != next_expected_val) {
+		return test_fail("number of sent and received messages mismatch (sent: %i, received: %i)",
+				 _num_messages_sent, next_expected_val);
+	}
+
+	return test_note("PASS orb queuing (wait object & notify), got %i messages", next_expected_val);
+}
 
 int uORBTest::UnitTest::test_fail(const char *fmt, ...)
 {
@@ -856,3 +926,65 @@ int uORBTest::UnitTest::pubsubtest_threadEntry(int argc, char *argv[])
 	uORBTest::UnitTest &t = uORBTest::UnitTest::instance();
 	return t.pubsublatency_main();
 }
+
+int uORBTest::UnitTest::test_queued_subscription()
+{
+	test_note("Testing queued subscription");
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+	uORB::SubscriptionQueued<orb_test_medium_s, 8> sub{ORB_ID(orb_test_medium)};
+	orb_test_medium_s t{};
+	orb_test_medium_s u{};
+
+	// make sure the topic exists, then flush what the previous tests published
+	t.val = -1;
+	pub.publish(t);
+
+	if (!sub.registerCallback()) {
+		return test_fail("registerCallback failed");
+	}
+
+	pub.publish(t);
+
+	while (sub.pop(u)) {}
+
+	// the topic queue length is 1, the subscriber still gets every message
+	for (int i = 0; i < 5; ++i) {
+		t.val = i;
+		pub.publish(t);
+	}
+
+	for (int i = 0; i < 5; ++i) {
+		if (!sub.pop(u)) {
+			return test_fail("message %i missing", i);
+		}
+
+		if (u.val != i) {
+			return test_fail("got wrong message (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	if (sub.pop(u)) {
+		return test_fail("spurious message");
+	}
+
+	test_note("  Testing overflow...");
+	const int overflow_by = 3;
+
+	for (int i = 0; i < 8 + overflow_by; ++i) {
+		t.val = i;
+		pub.publish(t);
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		if (!sub.pop(u) || (u.val != i)) {
+			return test_fail("got wrong message (got %i, should be %i)", u.val, i);
+		}
+	}
+
+	if ((int)sub.dropped() != overflow_by) {
+		return test_fail("dropped %i, expected %i", (int)sub.dropped(), overflow_by);
+	}
+
+	return test_note("PASS queued subscription");
+}
@@ -35,6 +35,9 @@
 #define _uORBTest_UnitTest_hpp_
 
 #include <uORB/uORB.h>
+#include <uORB/Publication.hpp>
+#include <uORB/SubscriptionQueued.hpp>
+#include <uORB/SubscriptionWait.hpp>
 #include <uORB/topics/orb_test.h>
 #include <uORB/topics/orb_test_medium.h>
 #include <uORB/topics/orb_test_large.h>
@@ -99,6 +102,8 @@ private:
 	static int pub_test_queue_entry(int argc, char *argv[]);
 	int pub_test_queue_main();
 	int test_queue_poll_notify();
+	int test_queue_wait_notify();
+	int test_queued_subscription();
 	volatile int _num_messages_sent = 0;
 
 	int test_fail(const char *fmt, ...);
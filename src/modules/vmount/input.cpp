@@ -43,7 +43,7 @@
 namespace vmount
 {
 
-int InputBase::update(unsigned int timeout_ms, ControlData **control_data, bool already_active)
+int InputBase::update(ControlData **control_data, bool already_active)
 {
 	if (!_initialized) {
 		int ret = initialize();
@@ -60,7 +60,7 @@ int InputBase::update(unsigned int timeout_ms, ControlData **control_data, bool
 		return 0;
 	}
 
-	return update_impl(timeout_ms, control_data, already_active);
+	return update_impl(control_data, already_active);
 }
 
 void InputBase::control_data_set_lon_lat(double lon, double lat, float altitude, float roll_angle,
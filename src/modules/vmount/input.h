@@ -55,8 +55,8 @@ public:
 	virtual ~InputBase() {}
 
 	/**
-	 * Wait for an input update, with a timeout.
-	 * @param timeout_ms timeout in ms
+	 * Check for an input update (non-blocking). Inputs register uORB callbacks on the
+	 * work item of the driver, so it is scheduled on new input data.
 	 * @param control_data unchanged on error. On success it is nullptr if no new
 	 *                     data is available, otherwise set to an object.
 	 *                     If it is set, the returned object will not be changed for
@@ -67,13 +67,13 @@ public:
 	 *                       change is necessary such as big stick movement for RC.
 	 * @return 0 on success, <0 otherwise
 	 */
-	virtual int update(unsigned int timeout_ms, ControlData **control_data, bool already_active);
+	virtual int update(ControlData **control_data, bool already_active);
 
 	/** report status to stdout */
 	virtual void print_status() = 0;
 
 protected:
-	virtual int update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active) = 0;
+	virtual int update_impl(ControlData **control_data, bool already_active) = 0;
 
 	virtual int initialize() { return 0; }
 
@@ -46,124 +46,98 @@
 #include <drivers/drv_hrt.h>
 #include <lib/parameters/param.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/posix.h>
 #include <errno.h>
 #include <math.h>
 
 namespace vmount
 {
 
-InputMavlinkROI::~InputMavlinkROI()
+InputMavlinkROI::InputMavlinkROI(px4::WorkItem *work_item)
+	: _vehicle_roi_sub(work_item, ORB_ID(vehicle_roi)),
+	  _position_setpoint_triplet_sub(work_item, ORB_ID(position_setpoint_triplet))
 {
-	if (_vehicle_roi_sub >= 0) {
-		orb_unsubscribe(_vehicle_roi_sub);
-	}
-
-	if (_position_setpoint_triplet_sub >= 0) {
-		orb_unsubscribe(_position_setpoint_triplet_sub);
-	}
 }
 
 int InputMavlinkROI::initialize()
 {
-	_vehicle_roi_sub = orb_subscribe(ORB_ID(vehicle_roi));
-
-	if (_vehicle_roi_sub < 0) {
-		return -errno;
+	if (!_vehicle_roi_sub.registerCallback()) {
+		return -ENOENT;
 	}
 
-	_position_setpoint_triplet_sub = orb_subscribe(ORB_ID(position_setpoint_triplet));
-
-	if (_position_setpoint_triplet_sub < 0) {
-		return -errno;
+	if (!_position_setpoint_triplet_sub.registerCallback()) {
+		return -ENOENT;
 	}
 
 	return 0;
 }
 
-int InputMavlinkROI::update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active)
+int InputMavlinkROI::update_impl(ControlData **control_data, bool already_active)
 {
 	// already_active is unused, we don't care what happened previously.
 
 	// Default to no change, set if we receive anything.
 	*control_data = nullptr;
 
-	const int num_poll = 2;
-	px4_pollfd_struct_t polls[num_poll];
-	polls[0].fd = 		_vehicle_roi_sub;
-	polls[0].events = 	POLLIN;
-	polls[1].fd = 		_position_setpoint_triplet_sub;
-	polls[1].events = 	POLLIN;
-
-	int ret = px4_poll(polls, num_poll, timeout_ms);
+	vehicle_roi_s vehicle_roi;
 
-	if (ret < 0) {
-		return -errno;
-	}
+	if (_vehicle_roi_sub.update(&vehicle_roi)) {
+		_control_data.gimbal_shutter_retract = false;
 
-	if (ret == 0) {
-		// Timeout, _control_data is already null
+		if (vehicle_roi.mode == vehicle_roi_s::ROI_NONE) {
 
-	} else {
-		if (polls[0].revents & POLLIN) {
-			vehicle_roi_s vehicle_roi;
-			orb_copy(ORB_ID(vehicle_roi), _vehicle_roi_sub, &vehicle_roi);
+			_control_data.type = ControlData::Type::Neutral;
+			*control_data = &_control_data;
 
-			_control_data.gimbal_shutter_retract = false;
+		} else if (vehicle_roi.mode == vehicle_roi_s::ROI_WPNEXT) {
+			_control_data.type = ControlData::Type::LonLat;
 
-			if (vehicle_roi.mode == vehicle_roi_s::ROI_NONE) {
+			position_setpoint_triplet_s position_setpoint_triplet;
 
-				_control_data.type = ControlData::Type::Neutral;
-				*control_data = &_control_data;
+			if (_position_setpoint_triplet_sub.copy(&position_setpoint_triplet)) {
+				_read_control_data_from_position_setpoint(position_setpoint_triplet);
+			}
 
-			} else if (vehicle_roi.mode == vehicle_roi_s::ROI_WPNEXT) {
-				_control_data.type = ControlData::Type::LonLat;
-				_read_control_data_from_position_setpoint_sub();
-				_control_data.type_data.lonlat.pitch_fixed_angle = -10.f;
+			_control_data.type_data.lonlat.pitch_fixed_angle = -10.f;
 
-				_control_data.type_data.lonlat.roll_angle = vehicle_roi.roll_offset;
-				_control_data.type_data.lonlat.pitch_angle_offset = vehicle_roi.pitch_offset;
-				_control_data.type_data.lonlat.yaw_angle_offset = vehicle_roi.yaw_offset;
+			_control_data.type_data.lonlat.roll_angle = vehicle_roi.roll_offset;
+			_control_data.type_data.lonlat.pitch_angle_offset = vehicle_roi.pitch_offset;
+			_control_data.type_data.lonlat.yaw_angle_offset = vehicle_roi.yaw_offset;
 
-				*control_data = &_control_data;
+			*control_data = &_control_data;
 
-			} else if (vehicle_roi.mode == vehicle_roi_s::ROI_LOCATION) {
-				control_data_set_lon_lat(vehicle_roi.lon, vehicle_roi.lat, vehicle_roi.alt);
+		} else if (vehicle_roi.mode == vehicle_roi_s::ROI_LOCATION) {
+			control_data_set_lon_lat(vehicle_roi.lon, vehicle_roi.lat, vehicle_roi.alt);
 
-				*control_data = &_control_data;
+			*control_data = &_control_data;
 
-			} else if (vehicle_roi.mode == vehicle_roi_s::ROI_TARGET) {
-				//TODO is this even suported?
-			}
+		} else if (vehicle_roi.mode == vehicle_roi_s::ROI_TARGET) {
+			//TODO is this even suported?
+		}
 
-			_cur_roi_mode = vehicle_roi.mode;
+		_cur_roi_mode = vehicle_roi.mode;
 
-			//set all other control data fields to defaults
-			for (int i = 0; i < 3; ++i) {
-				_control_data.stabilize_axis[i] = false;
-			}
+		//set all other control data fields to defaults
+		for (int i = 0; i < 3; ++i) {
+			_control_data.stabilize_axis[i] = false;
 		}
+	}
 
-		// check whether the position setpoint got updated
-		if (polls[1].revents & POLLIN) {
-			if (_cur_roi_mode == vehicle_roi_s::ROI_WPNEXT) {
-				_read_control_data_from_position_setpoint_sub();
-				*control_data = &_control_data;
+	// check whether the position setpoint got updated (always consume the update)
+	position_setpoint_triplet_s position_setpoint_triplet;
 
-			} else { // must do an orb_copy() in *every* case
-				position_setpoint_triplet_s position_setpoint_triplet;
-				orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub, &position_setpoint_triplet);
-			}
+	if (_position_setpoint_triplet_sub.update(&position_setpoint_triplet)) {
+		if (_cur_roi_mode == vehicle_roi_s::ROI_WPNEXT) {
+			_read_control_data_from_position_setpoint(position_setpoint_triplet);
+			*control_data = &_control_data;
 		}
 	}
 
 	return 0;
 }
 
-void InputMavlinkROI::_read_control_data_from_position_setpoint_sub()
+void InputMavlinkROI::_read_control_data_from_position_setpoint(const position_setpoint_triplet_s
+		&position_setpoint_triplet)
 {
-	position_setpoint_triplet_s position_setpoint_triplet;
-	orb_copy(ORB_ID(position_setpoint_triplet), _position_setpoint_triplet_sub, &position_setpoint_triplet);
 	_control_data.type_data.lonlat.lon = position_setpoint_triplet.current.lon;
 	_control_data.type_data.lonlat.lat = position_setpoint_triplet.current.lat;
 	_control_data.type_data.lonlat.altitude = position_setpoint_triplet.current.alt;
@@ -175,8 +149,9 @@ void InputMavlinkROI::print_status()
 }
 
 
-InputMavlinkCmdMount::InputMavlinkCmdMount(bool stabilize)
-	: _stabilize {stabilize, stabilize, stabilize}
+InputMavlinkCmdMount::InputMavlinkCmdMount(px4::WorkItem *work_item, bool stabilize)
+	: _vehicle_command_sub(work_item, ORB_ID(vehicle_command)),
+	  _stabilize {stabilize, stabilize, stabilize}
 {
 	param_t handle = param_find("MAV_SYS_ID");
 
@@ -191,168 +166,122 @@ InputMavlinkCmdMount::InputMavlinkCmdMount(bool stabilize)
 	}
 }
 
-InputMavlinkCmdMount::~InputMavlinkCmdMount()
-{
-	if (_vehicle_command_sub >= 0) {
-		orb_unsubscribe(_vehicle_command_sub);
-	}
-}
-
 int InputMavlinkCmdMount::initialize()
 {
-	if ((_vehicle_command_sub = orb_subscribe(ORB_ID(vehicle_command))) < 0) {
-		return -errno;
+	if (!_vehicle_command_sub.registerCallback()) {
+		return -ENOENT;
 	}
 
-	// rate-limit inputs to 100Hz. If we don't do this and the output is configured to mavlink mode,
-	// it will publish vehicle_command's as well, causing the input poll() in here to return
-	// immediately, which in turn will cause an output update and thus a busy loop.
-	orb_set_interval(_vehicle_command_sub, 10);
-
 	return 0;
 }
 
 
-int InputMavlinkCmdMount::update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active)
+int InputMavlinkCmdMount::update_impl(ControlData **control_data, bool already_active)
 {
 	// Default to notify that there was no change.
 	*control_data = nullptr;
 
-	const int num_poll = 1;
-	px4_pollfd_struct_t polls[num_poll];
-	polls[0].fd = 		_vehicle_command_sub;
-	polls[0].events = 	POLLIN;
-
-	int poll_timeout = (int)timeout_ms;
-
-	bool exit_loop = false;
+	vehicle_command_s vehicle_command;
 
-	while (!exit_loop && poll_timeout >= 0) {
-		hrt_abstime poll_start = hrt_absolute_time();
+	// handle all queued commands, if there are several for us the last one takes effect
+	while (_vehicle_command_sub.update(&vehicle_command)) {
+		// Process only if the command is for us or for anyone (component id 0).
+		const bool sysid_correct = (vehicle_command.target_system == _mav_sys_id);
+		const bool compid_correct = ((vehicle_command.target_component == _mav_comp_id) ||
+					     (vehicle_command.target_component == 0));
 
-		int ret = px4_poll(polls, num_poll, poll_timeout);
-
-		if (ret < 0) {
-			return -errno;
+		if (!sysid_correct || !compid_correct) {
+			continue;
 		}
 
-		poll_timeout -= (hrt_absolute_time() - poll_start) / 1000;
+		for (int i = 0; i < 3; ++i) {
+			_control_data.stabilize_axis[i] = _stabilize[i];
+		}
 
-		// if we get a command that we need to handle, we exit the loop, otherwise we poll until we reach the timeout
-		exit_loop = true;
+		_control_data.gimbal_shutter_retract = false;
 
-		if (ret == 0) {
-			// Timeout control_data already null.
+		if (vehicle_command.command == vehicle_command_s::VEHICLE_CMD_DO_MOUNT_CONTROL) {
 
-		} else {
-			if (polls[0].revents & POLLIN) {
-				vehicle_command_s vehicle_command;
-				orb_copy(ORB_ID(vehicle_command), _vehicle_command_sub, &vehicle_command);
+			switch ((int)vehicle_command.param7) {
+			case vehicle_command_s::VEHICLE_MOUNT_MODE_RETRACT:
+				_control_data.gimbal_shutter_retract = true;
 
-				// Process only if the command is for us or for anyone (component id 0).
-				const bool sysid_correct = (vehicle_command.target_system == _mav_sys_id);
-				const bool compid_correct = ((vehicle_command.target_component == _mav_comp_id) ||
-							     (vehicle_command.target_component == 0));
+			/* FALLTHROUGH */
 
-				if (!sysid_correct || !compid_correct) {
-					exit_loop = false;
-					continue;
-				}
+			case vehicle_command_s::VEHICLE_MOUNT_MODE_NEUTRAL:
+				_control_data.type = ControlData::Type::Neutral;
 
-				for (int i = 0; i < 3; ++i) {
-					_control_data.stabilize_axis[i] = _stabilize[i];
+				*control_data = &_control_data;
+				break;
+
+			case vehicle_command_s::VEHICLE_MOUNT_MODE_MAVLINK_TARGETING:
+				_control_data.type = ControlData::Type::Angle;
+				_control_data.type_data.angle.frames[0] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
+				_control_data.type_data.angle.frames[1] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
+				_control_data.type_data.angle.frames[2] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
+				// vmount spec has roll on channel 0, MAVLink spec has pitch on channel 0
+				_control_data.type_data.angle.angles[0] = vehicle_command.param2 * M_DEG_TO_RAD_F;
+				// vmount spec has pitch on channel 1, MAVLink spec has roll on channel 1
+				_control_data.type_data.angle.angles[1] = vehicle_command.param1 * M_DEG_TO_RAD_F;
+				// both specs have yaw on channel 2
+				_control_data.type_data.angle.angles[2] = vehicle_command.param3 * M_DEG_TO_RAD_F;
+
+				// We expect angle of [-pi..+pi]. If the input range is [0..2pi] we can fix that.
+				if (_control_data.type_data.angle.angles[2] > M_PI_F) {
+					_control_data.type_data.angle.angles[2] -= 2 * M_PI_F;
 				}
 
-				_control_data.gimbal_shutter_retract = false;
-
-				if (vehicle_command.command == vehicle_command_s::VEHICLE_CMD_DO_MOUNT_CONTROL) {
-
-					switch ((int)vehicle_command.param7) {
-					case vehicle_command_s::VEHICLE_MOUNT_MODE_RETRACT:
-						_control_data.gimbal_shutter_retract = true;
-
-					/* FALLTHROUGH */
-
-					case vehicle_command_s::VEHICLE_MOUNT_MODE_NEUTRAL:
-						_control_data.type = ControlData::Type::Neutral;
-
-						*control_data = &_control_data;
-						break;
-
-					case vehicle_command_s::VEHICLE_MOUNT_MODE_MAVLINK_TARGETING:
-						_control_data.type = ControlData::Type::Angle;
-						_control_data.type_data.angle.frames[0] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
-						_control_data.type_data.angle.frames[1] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
-						_control_data.type_data.angle.frames[2] = ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
-						// vmount spec has roll on channel 0, MAVLink spec has pitch on channel 0
-						_control_data.type_data.angle.angles[0] = vehicle_command.param2 * M_DEG_TO_RAD_F;
-						// vmount spec has pitch on channel 1, MAVLink spec has roll on channel 1
-						_control_data.type_data.angle.angles[1] = vehicle_command.param1 * M_DEG_TO_RAD_F;
-						// both specs have yaw on channel 2
-						_control_data.type_data.angle.angles[2] = vehicle_command.param3 * M_DEG_TO_RAD_F;
-
-						// We expect angle of [-pi..+pi]. If the input range is [0..2pi] we can fix that.
-						if (_control_data.type_data.angle.angles[2] > M_PI_F) {
-							_control_data.type_data.angle.angles[2] -= 2 * M_PI_F;
-						}
-
-						*control_data = &_control_data;
-						break;
-
-					case vehicle_command_s::VEHICLE_MOUNT_MODE_RC_TARGETING:
-						break;
-
-					case vehicle_command_s::VEHICLE_MOUNT_MODE_GPS_POINT:
-						control_data_set_lon_lat((double)vehicle_command.param6, (double)vehicle_command.param5, vehicle_command.param4);
-
-						*control_data = &_control_data;
-						break;
-					}
+				*control_data = &_control_data;
+				break;
 
-					_ack_vehicle_command(&vehicle_command);
+			case vehicle_command_s::VEHICLE_MOUNT_MODE_RC_TARGETING:
+				break;
 
-				} else if (vehicle_command.command == vehicle_command_s::VEHICLE_CMD_DO_MOUNT_CONFIGURE) {
-					_stabilize[0] = (int)(vehicle_command.param2 + 0.5f) == 1;
-					_stabilize[1] = (int)(vehicle_command.param3 + 0.5f) == 1;
-					_stabilize[2] = (int)(vehicle_command.param4 + 0.5f) == 1;
+			case vehicle_command_s::VEHICLE_MOUNT_MODE_GPS_POINT:
+				control_data_set_lon_lat((double)vehicle_command.param6, (double)vehicle_command.param5, vehicle_command.param4);
 
-					const int params[] = {
-						(int)((float)vehicle_command.param5 + 0.5f),
-						(int)((float)vehicle_command.param6 + 0.5f),
-						(int)(vehicle_command.param7 + 0.5f)
-					};
+				*control_data = &_control_data;
+				break;
+			}
 
-					for (int i = 0; i < 3; ++i) {
+			_ack_vehicle_command(&vehicle_command);
 
-						if (params[i] == 0) {
-							_control_data.type_data.angle.frames[i] =
-								ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
+		} else if (vehicle_command.command == vehicle_command_s::VEHICLE_CMD_DO_MOUNT_CONFIGURE) {
+			_stabilize[0] = (int)(vehicle_command.param2 + 0.5f) == 1;
+			_stabilize[1] = (int)(vehicle_command.param3 + 0.5f) == 1;
+			_stabilize[2] = (int)(vehicle_command.param4 + 0.5f) == 1;
 
-						} else if (params[i] == 1) {
-							_control_data.type_data.angle.frames[i] =
-								ControlData::TypeData::TypeAngle::Frame::AngularRate;
+			const int params[] = {
+				(int)((float)vehicle_command.param5 + 0.5f),
+				(int)((float)vehicle_command.param6 + 0.5f),
+				(int)(vehicle_command.param7 + 0.5f)
+			};
 
-						} else if (params[i] == 2) {
-							_control_data.type_data.angle.frames[i] =
-								ControlData::TypeData::TypeAngle::Frame::AngleAbsoluteFrame;
+			for (int i = 0; i < 3; ++i) {
 
-						} else {
-							// Not supported, fallback to body angle.
-							_control_data.type_data.angle.frames[i] =
-								ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
-						}
-					}
+				if (params[i] == 0) {
+					_control_data.type_data.angle.frames[i] =
+						ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
 
-					_control_data.type = ControlData::Type::Neutral; //always switch to neutral position
+				} else if (params[i] == 1) {
+					_control_data.type_data.angle.frames[i] =
+						ControlData::TypeData::TypeAngle::Frame::AngularRate;
 
-					*control_data = &_control_data;
-					_ack_vehicle_command(&vehicle_command);
+				} else if (params[i] == 2) {
+					_control_data.type_data.angle.frames[i] =
+						ControlData::TypeData::TypeAngle::Frame::AngleAbsoluteFrame;
 
 				} else {
-					exit_loop = false;
+					// Not supported, fallback to body angle.
+					_control_data.type_data.angle.frames[i] =
+						ControlData::TypeData::TypeAngle::Frame::AngleBodyFrame;
 				}
 			}
 
+			_control_data.type = ControlData::Type::Neutral; //always switch to neutral position
+
+			*control_data = &_control_data;
+			_ack_vehicle_command(&vehicle_command);
 		}
 	}
 
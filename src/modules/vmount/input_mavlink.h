@@ -43,6 +43,10 @@
 #include "input_rc.h"
 #include <cstdint>
 
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/position_setpoint_triplet.h>
 #include <uORB/topics/vehicle_command.h>
 #include <uORB/topics/vehicle_roi.h>
 
@@ -55,20 +59,23 @@ namespace vmount
 class InputMavlinkROI : public InputBase
 {
 public:
-	InputMavlinkROI() = default;
-	virtual ~InputMavlinkROI();
+	/**
+	 * @param work_item work item scheduled on new vehicle_roi and position_setpoint_triplet data
+	 */
+	InputMavlinkROI(px4::WorkItem *work_item);
+	virtual ~InputMavlinkROI() = default;
 
 	virtual void print_status();
 
 protected:
-	virtual int update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active);
+	virtual int update_impl(ControlData **control_data, bool already_active);
 	virtual int initialize();
 
 private:
-	void _read_control_data_from_position_setpoint_sub();
+	void _read_control_data_from_position_setpoint(const position_setpoint_triplet_s &position_setpoint_triplet);
 
-	int _vehicle_roi_sub = -1;
-	int _position_setpoint_triplet_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _vehicle_roi_sub;
+	uORB::SubscriptionCallbackWorkItem _position_setpoint_triplet_sub;
 	uint8_t _cur_roi_mode = vehicle_roi_s::ROI_NONE;
 };
 
@@ -80,19 +87,23 @@ private:
 class InputMavlinkCmdMount : public InputBase
 {
 public:
-	InputMavlinkCmdMount(bool stabilize);
-	virtual ~InputMavlinkCmdMount();
+	/**
+	 * @param work_item work item scheduled on new vehicle_command data
+	 * @param stabilize
+	 */
+	InputMavlinkCmdMount(px4::WorkItem *work_item, bool stabilize);
+	virtual ~InputMavlinkCmdMount() = default;
 
 	virtual void print_status();
 
 protected:
-	virtual int update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active);
+	virtual int update_impl(ControlData **control_data, bool already_active);
 	virtual int initialize();
 
 private:
 	void _ack_vehicle_command(vehicle_command_s *cmd);
 
-	int _vehicle_command_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _vehicle_command_sub;
 	bool _stabilize[3] = { false, false, false };
 
 	int32_t _mav_sys_id{1}; ///< our mavlink system id
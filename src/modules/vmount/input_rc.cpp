@@ -41,7 +41,6 @@
 
 #include <math.h>
 #include <errno.h>
-#include <px4_platform_common/posix.h>
 #include <px4_platform_common/defines.h>
 
 
@@ -49,65 +48,45 @@ namespace vmount
 {
 
 
-InputRC::InputRC(bool do_stabilization, int aux_channel_roll, int aux_channel_pitch, int aux_channel_yaw)
-	: _do_stabilization(do_stabilization)
+InputRC::InputRC(px4::WorkItem *work_item, bool do_stabilization, int aux_channel_roll, int aux_channel_pitch,
+		 int aux_channel_yaw)
+	: _do_stabilization(do_stabilization),
+	  _manual_control_setpoint_sub(work_item, ORB_ID(manual_control_setpoint))
 {
 	_aux_channels[0] = aux_channel_roll;
 	_aux_channels[1] = aux_channel_pitch;
 	_aux_channels[2] = aux_channel_yaw;
 }
 
-InputRC::~InputRC()
-{
-	if (_manual_control_setpoint_sub >= 0) {
-		orb_unsubscribe(_manual_control_setpoint_sub);
-	}
-}
-
 int InputRC::initialize()
 {
-	_manual_control_setpoint_sub = orb_subscribe(ORB_ID(manual_control_setpoint));
-
-	if (_manual_control_setpoint_sub < 0) {
-		return -errno;
+	if (!_manual_control_setpoint_sub.registerCallback()) {
+		return -ENOENT;
 	}
 
 	return 0;
 }
 
-int InputRC::update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active)
+int InputRC::update_impl(ControlData **control_data, bool already_active)
 {
 	// Default to no change signalled by NULL.
 	*control_data = nullptr;
 
-	px4_pollfd_struct_t polls[1];
-	polls[0].fd = 		_manual_control_setpoint_sub;
-	polls[0].events = 	POLLIN;
-
-	int ret = px4_poll(polls, 1, timeout_ms);
-
-	if (ret < 0) {
-		return -errno;
-	}
+	manual_control_setpoint_s manual_control_setpoint;
 
-	if (ret == 0) {
-		// Timeout, leave NULL
-	} else {
-		if (polls[0].revents & POLLIN) {
-			// Only if there was a change, we update the control data, otherwise leave it NULL.
-			if (_read_control_data_from_subscription(_control_data, already_active)) {
-				*control_data = &_control_data;
-			}
+	if (_manual_control_setpoint_sub.update(&manual_control_setpoint)) {
+		// Only if there was a change, we update the control data, otherwise leave it NULL.
+		if (_read_control_data_from_subscription(manual_control_setpoint, _control_data, already_active)) {
+			*control_data = &_control_data;
 		}
 	}
 
 	return 0;
 }
 
-bool InputRC::_read_control_data_from_subscription(ControlData &control_data, bool already_active)
+bool InputRC::_read_control_data_from_subscription(const manual_control_setpoint_s &manual_control_setpoint,
+		ControlData &control_data, bool already_active)
 {
-	manual_control_setpoint_s manual_control_setpoint;
-	orb_copy(ORB_ID(manual_control_setpoint), _manual_control_setpoint_sub, &manual_control_setpoint);
 	control_data.type = ControlData::Type::Angle;
 
 	float new_aux_values[3];
@@ -40,6 +40,8 @@
 #pragma once
 
 #include "input.h"
+#include <px4_platform_common/px4_work_queue/WorkItem.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/manual_control_setpoint.h>
 
 namespace vmount
@@ -57,33 +59,34 @@ class InputRC : public InputBase
 public:
 
 	/**
+	 * @param work_item          work item scheduled on new manual_control_setpoint data
 	 * @param do_stabilization
 	 * @param aux_channel_roll   which aux channel to use for roll (set to 0 to use a fixed angle of 0)
 	 * @param aux_channel_pitch
 	 * @param aux_channel_yaw
 	 */
-	InputRC(bool do_stabilization, int aux_channel_roll, int aux_channel_pitch, int aux_channel_yaw);
-	virtual ~InputRC();
+	InputRC(px4::WorkItem *work_item, bool do_stabilization, int aux_channel_roll, int aux_channel_pitch,
+		int aux_channel_yaw);
+	virtual ~InputRC() = default;
 
 	virtual void print_status();
 
 protected:
-	virtual int update_impl(unsigned int timeout_ms, ControlData **control_data, bool already_active);
+	virtual int update_impl(ControlData **control_data, bool already_active);
 	virtual int initialize();
 
 	/**
 	 * @return true if there was a change in control data
 	 */
-	virtual bool _read_control_data_from_subscription(ControlData &control_data, bool already_active);
-
-	int _get_subscription_fd() const { return _manual_control_setpoint_sub; }
+	virtual bool _read_control_data_from_subscription(const manual_control_setpoint_s &manual_control_setpoint,
+			ControlData &control_data, bool already_active);
 
 	float _get_aux_value(const manual_control_setpoint_s &manual_control_setpoint, int channel_idx);
 
 private:
 	const bool _do_stabilization;
 	int _aux_channels[3];
-	int _manual_control_setpoint_sub = -1;
+	uORB::SubscriptionCallbackWorkItem _manual_control_setpoint_sub;
 
 	bool _first_time = true;
 	float _last_set_aux_values[3] = {};
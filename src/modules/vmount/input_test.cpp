@@ -59,7 +59,7 @@ bool InputTest::finished()
 	return true; /* only a single-shot test (for now) */
 }
 
-int InputTest::update(unsigned int timeout_ms, ControlData **control_data, bool already_active)
+int InputTest::update(ControlData **control_data, bool already_active)
 {
 	//we directly override the update() here, since we don't need the initialization from the base class
 
@@ -45,16 +45,13 @@
 
 #include <math.h>
 #include <stdlib.h>
-#include <stdio.h>
-#include <stdbool.h>
 #include <string.h>
-#include <sys/types.h>
-#include <fcntl.h>
-#include <unistd.h>
-#include <systemlib/err.h>
 #include <lib/parameters/param.h>
+#include <lib/perf/perf_counter.h>
 #include <px4_platform_common/defines.h>
-#include <px4_platform_common/tasks.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
 
 #include "input_mavlink.h"
 #include "input_rc.h"
@@ -62,27 +59,15 @@
 #include "output_rc.h"
 #include "output_mavlink.h"
 
-#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/vehicle_attitude.h>
 
-#include <px4_platform_common/px4_config.h>
-#include <px4_platform_common/module.h>
-
+using namespace time_literals;
 using namespace vmount;
 
-/* thread state */
-static volatile bool thread_should_exit = false;
-static volatile bool thread_running = false;
-
 static constexpr int input_objs_len_max = 3;
 
-struct ThreadData {
-	InputBase *input_objs[input_objs_len_max] = {nullptr, nullptr, nullptr};
-	int input_objs_len = 0;
-	OutputBase *output_obj = nullptr;
-};
-static volatile ThreadData *g_thread_data = nullptr;
-
 struct Parameters {
 	int32_t mnt_mode_in;
 	int32_t mnt_mode_out;
@@ -146,388 +131,423 @@ struct ParameterHandles {
 };
 
 
-/* functions */
-static void usage();
 static void update_params(ParameterHandles &param_handles, Parameters &params, bool &got_changes);
 static bool get_params(ParameterHandles &param_handles, Parameters &params);
 
-static int vmount_thread_main(int argc, char *argv[]);
 extern "C" __EXPORT int vmount_main(int argc, char *argv[]);
 
-static int vmount_thread_main(int argc, char *argv[])
+/**
+ ** class VMount
+ * Runs on a work queue, scheduled by new input data (uORB callbacks of the inputs) and
+ * attitude updates. All inputs are read in one run and the output is updated once.
+ */
+class VMount : public ModuleBase<VMount>, public px4::ScheduledWorkItem
 {
-	ParameterHandles param_handles;
-	Parameters params {};
-	OutputConfig output_config;
-	ThreadData thread_data;
-
-	InputTest *test_input = nullptr;
-
-#ifdef __PX4_NUTTX
-	/* the NuttX optarg handler does not
-	 * ignore argv[0] like the POSIX handler
-	 * does, nor does it deal with non-flag
-	 * verbs well. So we Remove the application
-	 * name and the verb.
+public:
+	/**
+	 * @param test_input fixed test input (ownership is transferred), or nullptr to use the configured inputs
 	 */
-	argc -= 1;
-	argv += 1;
-#endif
+	VMount(InputTest *test_input);
+	~VMount() override;
 
-	if (argc > 0 && !strcmp(argv[0], "test")) {
-		PX4_INFO("Starting in test mode");
+	/** @see ModuleBase */
+	static int task_spawn(int argc, char *argv[]);
 
-		const char *axis_names[3] = {"roll", "pitch", "yaw"};
-		float angles[3] = { 0.f, 0.f, 0.f };
+	/** @see ModuleBase */
+	static int custom_command(int argc, char *argv[]);
 
-		if (argc == 3) {
-			bool found_axis = false;
+	/** @see ModuleBase */
+	static int print_usage(const char *reason = nullptr);
 
-			for (int i = 0 ; i < 3; ++i) {
-				if (!strcmp(argv[1], axis_names[i])) {
-					long angle_deg = strtol(argv[2], nullptr, 0);
-					angles[i] = (float)angle_deg;
-					found_axis = true;
-				}
-			}
+	/** @see ModuleBase::print_status() */
+	int print_status() override;
 
-			if (!found_axis) {
-				usage();
-				return -1;
-			}
+	/** @see ModuleBase::request_stop(), schedules the exit (there might be no regular input data) */
+	void request_stop() override;
 
-			test_input = new InputTest(angles[0], angles[1], angles[2]);
+	bool init();
 
-			if (!test_input) {
-				PX4_ERR("memory allocation failed");
-				return -1;
-			}
+private:
+	static int start_instance(InputTest *test_input);
 
-		} else {
-			usage();
-			return -1;
-		}
-	}
+	void Run() override;
+
+	/** create the input and output objects according to the parameters */
+	bool create_inputs_outputs();
+	void delete_inputs_outputs();
+
+	static constexpr uint32_t OUTPUT_UPDATE_INTERVAL_MAX{50_ms}; ///< output update interval without new input data
+	static constexpr uint32_t ATTITUDE_UPDATE_INTERVAL{20_ms}; ///< rate limit for output updates triggered by attitude
+
+	uORB::SubscriptionCallbackWorkItem _parameter_update_sub{this, ORB_ID(parameter_update)};
+	uORB::SubscriptionCallbackWorkItem _vehicle_attitude_sub{this, ORB_ID(vehicle_attitude)};
+
+	ParameterHandles _param_handles{};
+	Parameters _params{};
+	OutputConfig _output_config{};
+
+	InputBase *_input_objs[input_objs_len_max] {nullptr, nullptr, nullptr};
+	int _input_objs_len{0};
+	OutputBase *_output_obj{nullptr};
+	InputTest *_test_input{nullptr};
+
+	ControlData *_control_data{nullptr};
+	int _last_active{-1};
+	hrt_abstime _last_output_update{0};
+
+	perf_counter_t _cycle_perf{perf_alloc(PC_ELAPSED, MODULE_NAME": cycle")};
+};
 
-	if (!get_params(param_handles, params)) {
+VMount::VMount(InputTest *test_input) :
+	ScheduledWorkItem(MODULE_NAME, px4::wq_configurations::lp_default),
+	_test_input(test_input)
+{
+}
+
+VMount::~VMount()
+{
+	delete_inputs_outputs();
+	delete _test_input;
+	perf_free(_cycle_perf);
+}
+
+bool VMount::init()
+{
+	if (!get_params(_param_handles, _params)) {
 		PX4_ERR("could not get mount parameters!");
-		delete test_input;
-		return -1;
+		return false;
 	}
 
-	uORB::Subscription parameter_update_sub{ORB_ID(parameter_update)};
-	thread_running = true;
-	ControlData *control_data = nullptr;
-	g_thread_data = &thread_data;
+	if (!_parameter_update_sub.registerCallback()) {
+		PX4_ERR("parameter_update callback registration failed");
+		return false;
+	}
 
-	int last_active = -1;
+	// the attitude only triggers updates for stabilization, the inputs trigger on new data themselves
+	_vehicle_attitude_sub.set_interval_us(ATTITUDE_UPDATE_INTERVAL);
+	_vehicle_attitude_sub.registerCallback();
 
-	while (!thread_should_exit) {
+	ScheduleNow();
+	return true;
+}
 
-		if (!thread_data.input_objs[0] && (params.mnt_mode_in >= 0 || test_input)) { //need to initialize
+bool VMount::create_inputs_outputs()
+{
+	_output_config.gimbal_normal_mode_value = _params.mnt_ob_norm_mode;
+	_output_config.gimbal_retracted_mode_value = _params.mnt_ob_lock_mode;
+	_output_config.pitch_scale = 1.0f / ((_params.mnt_range_pitch / 2.0f) * M_DEG_TO_RAD_F);
+	_output_config.roll_scale = 1.0f / ((_params.mnt_range_roll / 2.0f) * M_DEG_TO_RAD_F);
+	_output_config.yaw_scale = 1.0f / ((_params.mnt_range_yaw / 2.0f) * M_DEG_TO_RAD_F);
+	_output_config.pitch_offset = _params.mnt_off_pitch * M_DEG_TO_RAD_F;
+	_output_config.roll_offset = _params.mnt_off_roll * M_DEG_TO_RAD_F;
+	_output_config.yaw_offset = _params.mnt_off_yaw * M_DEG_TO_RAD_F;
+	_output_config.mavlink_sys_id = _params.mnt_mav_sysid;
+	_output_config.mavlink_comp_id = _params.mnt_mav_compid;
+
+	bool alloc_failed = false;
+	_input_objs_len = 1;
+
+	if (_test_input) {
+		_input_objs[0] = _test_input;
+
+	} else {
+		switch (_params.mnt_mode_in) {
+		case 0:
+
+			// Automatic
+			_input_objs[0] = new InputMavlinkCmdMount(this, _params.mnt_do_stab);
+			_input_objs[1] = new InputMavlinkROI(this);
+
+			// RC is on purpose last here so that if there are any mavlink
+			// messages, they will take precedence over RC.
+			// This logic is done further below while update() is called.
+			_input_objs[2] = new InputRC(this, _params.mnt_do_stab, _params.mnt_man_roll, _params.mnt_man_pitch,
+						     _params.mnt_man_yaw);
+			_input_objs_len = 3;
 
-			output_config.gimbal_normal_mode_value = params.mnt_ob_norm_mode;
-			output_config.gimbal_retracted_mode_value = params.mnt_ob_lock_mode;
-			output_config.pitch_scale = 1.0f / ((params.mnt_range_pitch / 2.0f) * M_DEG_TO_RAD_F);
-			output_config.roll_scale = 1.0f / ((params.mnt_range_roll / 2.0f) * M_DEG_TO_RAD_F);
-			output_config.yaw_scale = 1.0f / ((params.mnt_range_yaw / 2.0f) * M_DEG_TO_RAD_F);
-			output_config.pitch_offset = params.mnt_off_pitch * M_DEG_TO_RAD_F;
-			output_config.roll_offset = params.mnt_off_roll * M_DEG_TO_RAD_F;
-			output_config.yaw_offset = params.mnt_off_yaw * M_DEG_TO_RAD_F;
-			output_config.mavlink_sys_id = params.mnt_mav_sysid;
-			output_config.mavlink_comp_id = params.mnt_mav_compid;
+			break;
 
-			bool alloc_failed = false;
-			thread_data.input_objs_len = 1;
+		case 1: //RC
+			_input_objs[0] = new InputRC(this, _params.mnt_do_stab, _params.mnt_man_roll, _params.mnt_man_pitch,
+						     _params.mnt_man_yaw);
+			break;
 
-			if (test_input) {
-				thread_data.input_objs[0] = test_input;
+		case 2: //MAVLINK_ROI
+			_input_objs[0] = new InputMavlinkROI(this);
+			break;
 
-			} else {
-				switch (params.mnt_mode_in) {
-				case 0:
+		case 3: //MAVLINK_DO_MOUNT
+			_input_objs[0] = new InputMavlinkCmdMount(this, _params.mnt_do_stab);
+			break;
 
-					// Automatic
-					thread_data.input_objs[0] = new InputMavlinkCmdMount(params.mnt_do_stab);
-					thread_data.input_objs[1] = new InputMavlinkROI();
+		default:
+			PX4_ERR("invalid input mode %i", _params.mnt_mode_in);
+			break;
+		}
+	}
 
-					// RC is on purpose last here so that if there are any mavlink
-					// messages, they will take precedence over RC.
-					// This logic is done further below while update() is called.
-					thread_data.input_objs[2] = new InputRC(params.mnt_do_stab, params.mnt_man_roll, params.mnt_man_pitch,
-										params.mnt_man_yaw);
-					thread_data.input_objs_len = 3;
+	for (int i = 0; i < _input_objs_len; ++i) {
+		if (!_input_objs[i]) {
+			alloc_failed = true;
+		}
+	}
 
-					break;
+	switch (_params.mnt_mode_out) {
+	case 0: //AUX
+		_output_obj = new OutputRC(_output_config);
 
-				case 1: //RC
-					thread_data.input_objs[0] = new InputRC(params.mnt_do_stab, params.mnt_man_roll, params.mnt_man_pitch,
-										params.mnt_man_yaw);
-					break;
+		if (!_output_obj) { alloc_failed = true; }
 
-				case 2: //MAVLINK_ROI
-					thread_data.input_objs[0] = new InputMavlinkROI();
-					break;
+		break;
 
-				case 3: //MAVLINK_DO_MOUNT
-					thread_data.input_objs[0] = new InputMavlinkCmdMount(params.mnt_do_stab);
-					break;
+	case 1: //MAVLINK
+		_output_obj = new OutputMavlink(_output_config);
 
-				default:
-					PX4_ERR("invalid input mode %i", params.mnt_mode_in);
-					break;
-				}
-			}
+		if (!_output_obj) { alloc_failed = true; }
 
-			for (int i = 0; i < thread_data.input_objs_len; ++i) {
-				if (!thread_data.input_objs[i]) {
-					alloc_failed = true;
-				}
-			}
+		break;
 
-			switch (params.mnt_mode_out) {
-			case 0: //AUX
-				thread_data.output_obj = new OutputRC(output_config);
+	default:
+		PX4_ERR("invalid output mode %i", _params.mnt_mode_out);
+		return false;
+	}
 
-				if (!thread_data.output_obj) { alloc_failed = true; }
+	if (alloc_failed) {
+		PX4_ERR("memory allocation failed");
+		return false;
+	}
 
-				break;
+	int ret = _output_obj->initialize();
 
-			case 1: //MAVLINK
-				thread_data.output_obj = new OutputMavlink(output_config);
+	if (ret) {
+		PX4_ERR("failed to initialize output mode (%i)", ret);
+		return false;
+	}
 
-				if (!thread_data.output_obj) { alloc_failed = true; }
+	return true;
+}
 
-				break;
+void VMount::delete_inputs_outputs()
+{
+	for (int i = 0; i < input_objs_len_max; ++i) {
+		if (_input_objs[i] != _test_input) {
+			delete _input_objs[i];
+		}
 
-			default:
-				PX4_ERR("invalid output mode %i", params.mnt_mode_out);
-				thread_should_exit = true;
-				break;
-			}
+		_input_objs[i] = nullptr;
+	}
 
-			if (alloc_failed) {
-				thread_data.input_objs_len = 0;
-				PX4_ERR("memory allocation failed");
-				thread_should_exit = true;
-			}
+	_input_objs_len = 0;
+	_last_active = -1;
+	_control_data = nullptr;
 
-			if (thread_should_exit) {
-				break;
-			}
+	delete _output_obj;
+	_output_obj = nullptr;
+}
 
-			int ret = thread_data.output_obj->initialize();
+void VMount::request_stop()
+{
+	ModuleBase::request_stop();
+	ScheduleNow();
+}
 
-			if (ret) {
-				PX4_ERR("failed to initialize output mode (%i)", ret);
-				thread_should_exit = true;
-				break;
-			}
+void VMount::Run()
+{
+	if (should_exit()) {
+		ScheduleClear();
+		_parameter_update_sub.unregisterCallback();
+		_vehicle_attitude_sub.unregisterCallback();
+		delete_inputs_outputs();
+		exit_and_cleanup();
+		return;
+	}
+
+	perf_begin(_cycle_perf);
+
+	// check for parameter updates
+	if (_parameter_update_sub.updated()) {
+		// clear update
+		parameter_update_s pupdate;
+		_parameter_update_sub.copy(&pupdate);
+
+		// update parameters from storage
+		bool updated = false;
+		update_params(_param_handles, _params, updated);
+
+		if (updated) {
+			//re-init objects
+			delete_inputs_outputs();
 		}
+	}
 
-		if (thread_data.input_objs_len > 0) {
+	if (!_input_objs[0] && (_params.mnt_mode_in >= 0 || _test_input)) { //need to initialize
+		if (!create_inputs_outputs()) {
+			delete_inputs_outputs();
+			request_stop();
+			perf_end(_cycle_perf);
+			return;
+		}
+	}
 
-			//get input: we cannot make the timeout too large, because the output needs to update
-			//periodically for stabilization and angle updates.
+	if (_input_objs_len > 0) {
 
-			for (int i = 0; i < thread_data.input_objs_len; ++i) {
+		// read all inputs (non-blocking), they scheduled this run on new data
 
-				bool already_active = (last_active == i);
+		for (int i = 0; i < _input_objs_len; ++i) {
 
-				ControlData *control_data_to_check = nullptr;
-				unsigned int poll_timeout = already_active ? 50 : 0; // poll only on active input to reduce latency
-				int ret = thread_data.input_objs[i]->update(poll_timeout, &control_data_to_check, already_active);
+			bool already_active = (_last_active == i);
 
-				if (ret) {
-					PX4_ERR("failed to read input %i (ret: %i)", i, ret);
-					continue;
-				}
+			ControlData *control_data_to_check = nullptr;
+			int ret = _input_objs[i]->update(&control_data_to_check, already_active);
 
-				if (control_data_to_check != nullptr || already_active) {
-					control_data = control_data_to_check;
-					last_active = i;
-				}
+			if (ret) {
+				PX4_ERR("failed to read input %i (ret: %i)", i, ret);
+				continue;
 			}
 
-			//update output
-			int ret = thread_data.output_obj->update(control_data);
+			if (control_data_to_check != nullptr || already_active) {
+				_control_data = control_data_to_check;
+				_last_active = i;
+			}
+		}
+
+		// update the output once for all inputs: on a new command, for stabilization on new attitude data,
+		// or at least every OUTPUT_UPDATE_INTERVAL_MAX (angular rate commands, position updates)
+		vehicle_attitude_s attitude;
+		const bool attitude_updated = _vehicle_attitude_sub.update(&attitude);
+
+		if (_control_data || attitude_updated
+		    || hrt_elapsed_time(&_last_output_update) >= OUTPUT_UPDATE_INTERVAL_MAX) {
+
+			int ret = _output_obj->update(_control_data);
 
 			if (ret) {
 				PX4_ERR("failed to write output (%i)", ret);
-				break;
+				request_stop();
+				perf_end(_cycle_perf);
+				return;
 			}
 
 			//only publish the mount orientation if the mode is not mavlink
 			//if the gimbal speaks mavlink it publishes its own orientation
-			if (params.mnt_mode_out != 1) { // 1 = MAVLINK
-				thread_data.output_obj->publish();
+			if (_params.mnt_mode_out != 1) { // 1 = MAVLINK
+				_output_obj->publish();
 			}
 
-
-		} else {
-			//wait for parameter changes. We still need to wake up regularily to check for thread exit requests
-			px4_usleep(1e6);
+			_last_output_update = hrt_absolute_time();
 		}
 
-		if (test_input && test_input->finished()) {
-			thread_should_exit = true;
-			break;
-		}
+		if (_test_input && _test_input->finished()) {
+			request_stop();
 
-		// check for parameter updates
-		if (parameter_update_sub.updated()) {
-			// clear update
-			parameter_update_s pupdate;
-			parameter_update_sub.copy(&pupdate);
-
-			// update parameters from storage
-			bool updated = false;
-			update_params(param_handles, params, updated);
-
-			if (updated) {
-				//re-init objects
-				for (int i = 0; i < input_objs_len_max; ++i) {
-					if (thread_data.input_objs[i]) {
-						delete (thread_data.input_objs[i]);
-						thread_data.input_objs[i] = nullptr;
-					}
-				}
-
-				thread_data.input_objs_len = 0;
-
-				last_active = -1;
-
-				if (thread_data.output_obj) {
-					delete (thread_data.output_obj);
-					thread_data.output_obj = nullptr;
-				}
-			}
+		} else {
+			// fallback if no input or attitude data arrives
+			ScheduleDelayed(OUTPUT_UPDATE_INTERVAL_MAX);
 		}
 	}
 
-	g_thread_data = nullptr;
-
-	for (int i = 0; i < input_objs_len_max; ++i) {
-		if (thread_data.input_objs[i]) {
-			delete (thread_data.input_objs[i]);
-			thread_data.input_objs[i] = nullptr;
-		}
-	}
+	perf_end(_cycle_perf);
+}
 
-	thread_data.input_objs_len = 0;
+int VMount::start_instance(InputTest *test_input)
+{
+	VMount *instance = new VMount(test_input);
 
-	if (thread_data.output_obj) {
-		delete (thread_data.output_obj);
-		thread_data.output_obj = nullptr;
-	}
+	if (instance) {
+		_object.store(instance);
+		_task_id = task_id_is_work_queue;
 
-	thread_running = false;
-	return 0;
-}
+		if (instance->init()) {
+			return PX4_OK;
+		}
 
-/**
- * The main command function.
- * Processes command line arguments and starts the daemon.
- */
-int vmount_main(int argc, char *argv[])
-{
-	if (argc < 2) {
-		PX4_ERR("missing command");
-		usage();
-		return -1;
+	} else {
+		PX4_ERR("alloc failed");
+		delete test_input;
 	}
 
-	const bool found_start = !strcmp(argv[1], "start");
-	const bool found_test = !strcmp(argv[1], "test");
+	delete instance;
+	_object.store(nullptr);
+	_task_id = -1;
 
-	if (found_start || found_test) {
+	return PX4_ERROR;
+}
 
-		/* this is not an error */
-		if (thread_running) {
-			if (found_start) {
-				PX4_WARN("mount driver already running");
-				return 0;
+int VMount::task_spawn(int argc, char *argv[])
+{
+	return start_instance(nullptr);
+}
 
-			} else {
-				PX4_WARN("mount driver already running, run vmount stop before 'vmount test'");
-				return 1;
-			}
+int VMount::custom_command(int argc, char *argv[])
+{
+	if (!strcmp(argv[0], "test")) {
+		if (is_running()) {
+			PX4_WARN("mount driver already running, run vmount stop before 'vmount test'");
+			return 1;
 		}
 
-		thread_should_exit = false;
-		int vmount_task = px4_task_spawn_cmd("vmount",
-						     SCHED_DEFAULT,
-						     SCHED_PRIORITY_DEFAULT,
-						     1900,
-						     vmount_thread_main,
-						     (char *const *)argv + 1);
+		const char *axis_names[3] = {"roll", "pitch", "yaw"};
+		float angles[3] = { 0.f, 0.f, 0.f };
 
-		int counter = 0;
+		if (argc != 3) {
+			return print_usage("missing axis or angle");
+		}
 
-		while (!thread_running && vmount_task >= 0) {
-			px4_usleep(5000);
+		bool found_axis = false;
 
-			if (++counter >= 100) {
-				break;
+		for (int i = 0 ; i < 3; ++i) {
+			if (!strcmp(argv[1], axis_names[i])) {
+				long angle_deg = strtol(argv[2], nullptr, 0);
+				angles[i] = (float)angle_deg;
+				found_axis = true;
 			}
 		}
 
-		if (vmount_task < 0) {
-			PX4_ERR("failed to start");
-			return -1;
-		}
-
-		return counter < 100 || thread_should_exit ? 0 : -1;
-	}
-
-	if (!strcmp(argv[1], "stop")) {
-
-		/* this is not an error */
-		if (!thread_running) {
-			PX4_WARN("mount driver not running");
-			return 0;
+		if (!found_axis) {
+			return print_usage("invalid axis");
 		}
 
-		thread_should_exit = true;
+		InputTest *test_input = new InputTest(angles[0], angles[1], angles[2]);
 
-		while (thread_running) {
-			px4_usleep(100000);
+		if (!test_input) {
+			PX4_ERR("memory allocation failed");
+			return -1;
 		}
 
-		return 0;
+		PX4_INFO("Starting in test mode");
+		return start_instance(test_input);
 	}
 
-	if (!strcmp(argv[1], "status")) {
-		if (thread_running && g_thread_data) {
-
-			for (int i = 0; i < g_thread_data->input_objs_len; ++i) {
-				g_thread_data->input_objs[i]->print_status();
-			}
-
-			if (g_thread_data->input_objs_len == 0) {
-				PX4_INFO("Input: None");
-			}
+	return print_usage("unknown command");
+}
 
-			if (g_thread_data->output_obj) {
-				g_thread_data->output_obj->print_status();
+int VMount::print_status()
+{
+	for (int i = 0; i < _input_objs_len; ++i) {
+		_input_objs[i]->print_status();
+	}
 
-			} else {
-				PX4_INFO("Output: None");
-			}
+	if (_input_objs_len == 0) {
+		PX4_INFO("Input: None");
+	}
 
-		} else {
-			PX4_INFO("not running");
-		}
+	if (_output_obj) {
+		_output_obj->print_status();
 
-		return 0;
+	} else {
+		PX4_INFO("Output: None");
 	}
 
-	PX4_ERR("unrecognized command");
-	usage();
-	return -1;
+	perf_print_counter(_cycle_perf);
+	return 0;
+}
+
+int vmount_main(int argc, char *argv[])
+{
+	return VMount::main(argc, argv);
 }
 
-void update_params(ParameterHandles &param_handles, Parameters &params, bool &got_changes)
+static void update_params(ParameterHandles &param_handles, Parameters &params, bool &got_changes)
 {
 	Parameters prev_params = params;
 	param_get(param_handles.mnt_mode_in, &params.mnt_mode_in);
@@ -550,7 +570,7 @@ void update_params(ParameterHandles &param_handles, Parameters &params, bool &go
 	got_changes = prev_params != params;
 }
 
-bool get_params(ParameterHandles &param_handles, Parameters &params)
+static bool get_params(ParameterHandles &param_handles, Parameters &params)
 {
 	param_handles.mnt_mode_in = param_find("MNT_MODE_IN");
 	param_handles.mnt_mode_out = param_find("MNT_MODE_OUT");
@@ -593,8 +613,12 @@ bool get_params(ParameterHandles &param_handles, Parameters &params)
 	return true;
 }
 
-static void usage()
+int VMount::print_usage(const char *reason)
 {
+	if (reason) {
+		PX4_WARN("%s\n", reason);
+	}
+
 	PRINT_MODULE_DESCRIPTION(
 		R"DESCR_STR(
 ### Description
@@ -608,6 +632,9 @@ Each method is implemented in its own class, and there is a common base class fo
 They are connected via an API, defined by the `ControlData` data structure. This makes sure that each input method
 can be used with each output method and new inputs/outputs can be added with minimal effort.
 
+The driver runs on a work queue. It is scheduled by new data of the inputs and by attitude updates
+(for stabilization), reads all inputs and then updates the output once.
+
 ### Examples
 Test the output by setting a fixed yaw angle (and the other axes to 0):
 $ vmount stop
@@ -619,4 +646,6 @@ $ vmount test yaw 30
 	PRINT_MODULE_USAGE_COMMAND_DESCR("test", "Test the output: set a fixed angle for one axis (vmount must not be running)");
 	PRINT_MODULE_USAGE_ARG("roll|pitch|yaw <angle>", "Specify an axis and an angle in degrees", false);
 	PRINT_MODULE_USAGE_DEFAULT_COMMANDS();
+
+	return 0;
 }
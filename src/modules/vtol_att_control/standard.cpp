@@ -80,8 +80,6 @@ Standard::parameters_update()
 	param_get(_params_handles_standard.back_trans_ramp, &v);
 	_params_standard.back_trans_ramp = math::constrain(v, 0.0f, _params->back_trans_duration);
 
-	_airspeed_trans_blend_margin = _params->transition_airspeed - _params->airspeed_blend;
-
 	/* pitch setpoint offset */
 	param_get(_params_handles_standard.pitch_setpoint_offset, &v);
 	_params_standard.pitch_setpoint_offset = math::radians(v);
@@ -235,6 +233,8 @@ void Standard::update_transition_state()
 	// copy virtual attitude setpoint to real attitude setpoint
 	memcpy(_v_att_sp, _mc_virtual_att_sp, sizeof(vehicle_attitude_setpoint_s));
 
+	_fw_rate_gain = 1.0f;
+
 	if (_vtol_schedule.flight_mode == vtol_mode::TRANSITION_TO_FW) {
 		if (_params_standard.pusher_ramp_dt <= 0.0f) {
 			// just set the final target throttle value
@@ -246,14 +246,13 @@ void Standard::update_transition_state()
 		}
 
 		// do blending of mc and fw controls if a blending airspeed has been provided and the minimum transition time has passed
-		if (_airspeed_trans_blend_margin > 0.0f &&
+		if (_transition_schedule.valid() &&
 		    PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s) &&
 		    _airspeed_validated->equivalent_airspeed_m_s > 0.0f &&
 		    _airspeed_validated->equivalent_airspeed_m_s >= _params->airspeed_blend &&
 		    time_since_trans_start > _params->front_trans_time_min) {
 
-			mc_weight = 1.0f - fabsf(_airspeed_validated->equivalent_airspeed_m_s - _params->airspeed_blend) /
-				    _airspeed_trans_blend_margin;
+			mc_weight = _transition_schedule.mc_weight(_airspeed_validated->equivalent_airspeed_m_s);
 			// time based blending when no airspeed sensor is set
 
 		} else if (_params->airspeed_disabled || !PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s)) {
@@ -262,6 +261,11 @@ void Standard::update_transition_state()
 
 		}
 
+		if (_transition_schedule.valid() && !_params->airspeed_disabled
+		    && PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s)) {
+			_fw_rate_gain = _transition_schedule.fw_rate_gain(_airspeed_validated->equivalent_airspeed_m_s);
+		}
+
 		// ramp up FW_PSP_OFF
 		_v_att_sp->pitch_body = _params_standard.pitch_setpoint_offset * (1.0f - mc_weight);
 
@@ -360,16 +364,19 @@ void Standard::fill_actuator_outputs()
 	_actuators_out_1->timestamp_sample = _actuators_fw_in->timestamp_sample;
 
 	if (_vtol_schedule.flight_mode != vtol_mode::MC_MODE) {
+		// during a front transition the fw rate control outputs are scaled with airspeed
+		const float fw_rate_gain = _vtol_schedule.flight_mode == vtol_mode::TRANSITION_TO_FW ? _fw_rate_gain : 1.0f;
+
 		// roll
 		_actuators_out_1->control[actuator_controls_s::INDEX_ROLL] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_ROLL];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_ROLL] * fw_rate_gain;
 
 		// pitch
 		_actuators_out_1->control[actuator_controls_s::INDEX_PITCH] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_PITCH];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_PITCH] * fw_rate_gain;
 		// yaw
 		_actuators_out_1->control[actuator_controls_s::INDEX_YAW] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_YAW];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_YAW] * fw_rate_gain;
 
 		_actuators_out_1->control[actuator_controls_s::INDEX_AIRBRAKES] = _reverse_output;
 
@@ -96,7 +96,6 @@ private:
 
 	float _pusher_throttle{0.0f};
 	float _reverse_output{0.0f};
-	float _airspeed_trans_blend_margin{0.0f};
 
 	void parameters_update() override;
 };
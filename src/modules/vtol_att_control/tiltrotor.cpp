@@ -298,6 +298,7 @@ void Tiltrotor::update_transition_state()
 		// at low speeds give full weight to MC
 		_mc_roll_weight = 1.0f;
 		_mc_yaw_weight = 1.0f;
+		_fw_rate_gain = 1.0f;
 
 		// reduce MC controls once the plane has picked up speed
 		if (!_params->airspeed_disabled && PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s) &&
@@ -305,10 +306,12 @@ void Tiltrotor::update_transition_state()
 			_mc_yaw_weight = 0.0f;
 		}
 
-		if (!_params->airspeed_disabled && PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s) &&
-		    _airspeed_validated->equivalent_airspeed_m_s >= _params->airspeed_blend) {
-			_mc_roll_weight = 1.0f - (_airspeed_validated->equivalent_airspeed_m_s - _params->airspeed_blend) /
-					  (_params->transition_airspeed - _params->airspeed_blend);
+		if (!_params->airspeed_disabled && PX4_ISFINITE(_airspeed_validated->equivalent_airspeed_m_s)) {
+			_fw_rate_gain = _transition_schedule.fw_rate_gain(_airspeed_validated->equivalent_airspeed_m_s);
+
+			if (_airspeed_validated->equivalent_airspeed_m_s >= _params->airspeed_blend) {
+				_mc_roll_weight = _transition_schedule.mc_weight(_airspeed_validated->equivalent_airspeed_m_s);
+			}
 		}
 
 		// without airspeed do timed weight changes
@@ -438,12 +441,15 @@ void Tiltrotor::fill_actuator_outputs()
 		_actuators_out_1->control[actuator_controls_s::INDEX_YAW] = 0.0f;
 
 	} else {
+		// during the first part of a front transition the fw rate control outputs are scaled with airspeed
+		const float fw_rate_gain = _vtol_schedule.flight_mode == vtol_mode::TRANSITION_FRONT_P1 ? _fw_rate_gain : 1.0f;
+
 		_actuators_out_1->control[actuator_controls_s::INDEX_ROLL] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_ROLL];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_ROLL] * fw_rate_gain;
 		_actuators_out_1->control[actuator_controls_s::INDEX_PITCH] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_PITCH];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_PITCH] * fw_rate_gain;
 		_actuators_out_1->control[actuator_controls_s::INDEX_YAW] =
-			_actuators_fw_in->control[actuator_controls_s::INDEX_YAW];
+			_actuators_fw_in->control[actuator_controls_s::INDEX_YAW] * fw_rate_gain;
 	}
 }
 
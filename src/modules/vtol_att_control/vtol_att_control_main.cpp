@@ -97,6 +97,8 @@ VtolAttitudeControl::VtolAttitudeControl() :
 	_params_handles.vt_forward_thrust_enable_mode = param_find("VT_FWD_THRUST_EN");
 	_params_handles.mpc_land_alt1 = param_find("MPC_LAND_ALT1");
 	_params_handles.mpc_land_alt2 = param_find("MPC_LAND_ALT2");
+	_params_handles.blend_shape = param_find("VT_BLEND_SHAPE");
+	_params_handles.fw_rate_gain_blend = param_find("VT_FW_RATE_GAIN");
 
 	_params_handles.down_pitch_max = param_find("VT_DWN_PITCH_MAX");
 	_params_handles.forward_thrust_scale = param_find("VT_FWD_THRUST_SC");
@@ -321,10 +323,15 @@ VtolAttitudeControl::parameters_update()
 	param_get(_params_handles.vt_forward_thrust_enable_mode, &_params.vt_forward_thrust_enable_mode);
 	param_get(_params_handles.mpc_land_alt1, &_params.mpc_land_alt1);
 	param_get(_params_handles.mpc_land_alt2, &_params.mpc_land_alt2);
+	param_get(_params_handles.blend_shape, &_params.blend_shape);
+
+	param_get(_params_handles.fw_rate_gain_blend, &v);
+	_params.fw_rate_gain_blend = math::constrain(v, 0.0f, 1.0f);
 
 	// update the parameters of the instances of base VtolType
 	if (_vtol_type != nullptr) {
 		_vtol_type->parameters_update();
+		_vtol_type->update_transition_schedule();
 	}
 
 	return OK;
@@ -188,6 +188,35 @@ PARAM_DEFINE_FLOAT(VT_ARSP_BLEND, 8.0f);
  */
 PARAM_DEFINE_FLOAT(VT_ARSP_TRANS, 10.0f);
 
+/**
+ * Transition blending shape
+ *
+ * Shape of the multicopter control weight between the blending airspeed (VT_ARSP_BLEND)
+ * and the transition airspeed (VT_ARSP_TRANS) during a front transition.
+ * Smooth avoids the steps in the rate of change of the weight at both ends of the blending.
+ *
+ * @value 0 Linear
+ * @value 1 Smooth
+ * @group VTOL Attitude Control
+ */
+PARAM_DEFINE_INT32(VT_BLEND_SHAPE, 0);
+
+/**
+ * Fixed wing rate control gain at the blending airspeed
+ *
+ * Scales the fixed wing rate control outputs during a front transition. The gain
+ * is applied at the blending airspeed (VT_ARSP_BLEND) and raised to 1 at the
+ * transition airspeed (VT_ARSP_TRANS) with the blending shape (VT_BLEND_SHAPE).
+ * Only used with an airspeed measurement, 1 disables the scaling.
+ *
+ * @min 0.0
+ * @max 1.0
+ * @increment 0.05
+ * @decimal 2
+ * @group VTOL Attitude Control
+ */
+PARAM_DEFINE_FLOAT(VT_FW_RATE_GAIN, 1.0f);
+
 /**
  * Front transition timeout
  *
@@ -526,3 +526,64 @@ float VtolType::pusher_assist()
 	return forward_thrust;
 
 }
+
+void VtolType::update_transition_schedule()
+{
+	_transition_schedule.update(_params->airspeed_blend, _params->transition_airspeed,
+				    (TransitionSchedule::Shape)_params->blend_shape, _params->fw_rate_gain_blend);
+
+	if (!_transition_schedule_printed) {
+		_transition_schedule.print();
+		_transition_schedule_printed = true;
+	}
+}
+
+void TransitionSchedule::update(float airspeed_blend, float airspeed_transition, Shape shape,
+				float fw_rate_gain_blend)
+{
+	if (airspeed_transition <= airspeed_blend) {
+		// no blending: hold the mc weight and fw rate gain
+		_airspeed_scale = 0.0f;
+
+		for (int i = 0; i < NUM_POINTS; i++) {
+			_mc_weight[i] = 1.0f;
+			_fw_rate_gain[i] = 1.0f;
+		}
+
+		return;
+	}
+
+	_airspeed_blend = airspeed_blend;
+	_airspeed_scale = (NUM_POINTS - 1) / (airspeed_transition - airspeed_blend);
+
+	for (int i = 0; i < NUM_POINTS; i++) {
+		const float x = (float)i / (NUM_POINTS - 1);
+		const float blend = (shape == Shape::SMOOTH) ? x * x * (3.0f - 2.0f * x) : x;
+
+		_mc_weight[i] = 1.0f - blend;
+		_fw_rate_gain[i] = fw_rate_gain_blend + (1.0f - fw_rate_gain_blend) * blend;
+	}
+}
+
+float TransitionSchedule::interpolate(const float table[NUM_POINTS], float airspeed) const
+{
+	const float x = math::constrain((airspeed - _airspeed_blend) * _airspeed_scale, 0.0f, (float)(NUM_POINTS - 1));
+	const int index = math::min((int)x, NUM_POINTS - 2);
+
+	return table[index] + (x - index) * (table[index + 1] - table[index]);
+}
+
+void TransitionSchedule::print() const
+{
+	if (!valid()) {
+		PX4_INFO("transition schedule: no airspeed blending");
+		return;
+	}
+
+	PX4_INFO("transition schedule (airspeed [m/s]: mc weight, fw rate gain):");
+
+	for (int i = 0; i < NUM_POINTS; i++) {
+		PX4_INFO("%6.2f: %.3f, %.3f", (double)(_airspeed_blend + i / _airspeed_scale), (double)_mc_weight[i],
+			 (double)_fw_rate_gain[i]);
+	}
+}
@@ -79,6 +79,44 @@ struct Params {
 	int vt_forward_thrust_enable_mode;
 	float mpc_land_alt1;
 	float mpc_land_alt2;
+	int32_t blend_shape;		// shape of the mc weight over airspeed during a front transition
+	float fw_rate_gain_blend;	// gain of the fw rate control outputs at the blending airspeed
+};
+
+/**
+ * Front transition blending over airspeed, precomputed from the parameters.
+ *
+ * Between the blending and the transition airspeed the mc weight and the gain of
+ * the fw rate control outputs are interpolated from a table, outside of it the
+ * end values are held.
+ */
+class TransitionSchedule
+{
+public:
+	static constexpr int NUM_POINTS = 9;
+
+	enum class Shape : int32_t {
+		LINEAR = 0,
+		SMOOTH		// smoothstep, no weight rate step at the start and end of the blending
+	};
+
+	void update(float airspeed_blend, float airspeed_transition, Shape shape, float fw_rate_gain_blend);
+
+	/** @return false if blending over airspeed is disabled */
+	bool valid() const { return _airspeed_scale > 0.f; }
+
+	float mc_weight(float airspeed) const { return interpolate(_mc_weight, airspeed); }
+	float fw_rate_gain(float airspeed) const { return interpolate(_fw_rate_gain, airspeed); }
+
+	void print() const;
+
+private:
+	float interpolate(const float table[NUM_POINTS], float airspeed) const;
+
+	float _airspeed_blend{0.f};
+	float _airspeed_scale{0.f};		// table index per m/s
+	float _mc_weight[NUM_POINTS] {};
+	float _fw_rate_gain[NUM_POINTS] {};
 };
 
 // Has to match 1:1 msg/vtol_vehicle_status.msg
@@ -190,6 +228,11 @@ public:
 
 	virtual void parameters_update() = 0;
 
+	/**
+	 * Recompute the front transition schedule from the parameters (printed once at startup).
+	 */
+	void update_transition_schedule();
+
 protected:
 	VtolAttitudeControl *_attc;
 	mode _vtol_mode;
@@ -223,6 +266,11 @@ protected:
 	float _mc_throttle_weight = 1.0f;	// weight for multicopter throttle command. Used to avoid
 
 	// motors spinning up or cutting too fast when doing transitions.
+	float _fw_rate_gain = 1.0f;		// gain for the fixed wing rate control outputs during a front transition
+
+	TransitionSchedule _transition_schedule;
+	bool _transition_schedule_printed = false;
+
 	float _thrust_transition = 0.0f;	// thrust value applied during a front transition (tailsitter & tiltrotor only)
 
 	float _ra_hrate = 0.0f;			// rolling average on height rate for quadchute condition
@@ -0,0 +1,123 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file irqstat.cpp
+ *
+ * Print the interrupt latency statistics: longest critical section and
+ * slowest interrupt handlers.
+ */
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+
+#include <string.h>
+
+#if !defined(PX4_IRQ_MONITOR)
+#error "irqstat requires CONFIG_SCHED_CRITMONITOR or CONFIG_SCHED_IRQMONITOR"
+#endif
+
+static constexpr int MAX_IRQS = 20;
+
+static void	usage();
+
+extern "C" {
+	__EXPORT int irqstat_main(int argc, char *argv[]);
+}
+
+int
+irqstat_main(int argc, char *argv[])
+{
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset") == 0) {
+			px4_irqmon_reset();
+			return 0;
+		}
+
+		usage();
+		return 1;
+	}
+
+	irq_monitor_csection_s csection;
+	px4_irqmon_csection(&csection);
+
+	PX4_INFO_RAW("critical sections: %u, longest: %u us, entered at 0x%08x\n", (unsigned)csection.count,
+		     (unsigned)csection.max_us, (unsigned)csection.max_caller);
+
+	irq_monitor_irq_s irqs[MAX_IRQS];
+	const int num_irqs = px4_irqmon_slowest_irqs(irqs, MAX_IRQS);
+
+	if (num_irqs == 0) {
+#if !defined(CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER)
+		PX4_INFO_RAW("handler durations require CONFIG_SCHED_INSTRUMENTATION_IRQHANDLER\n");
+#endif
+		return 0;
+	}
+
+	PX4_INFO_RAW("\n IRQ    HANDLER      COUNT  MAX [us]  AVG [us]\n");
+
+	for (int i = 0; i < num_irqs; i++) {
+		PX4_INFO_RAW("%4u 0x%08x %10u %9u %9u\n", (unsigned)irqs[i].irq, (unsigned)irqs[i].handler,
+			     (unsigned)irqs[i].count, (unsigned)irqs[i].max_us, (unsigned)irqs[i].avg_us);
+	}
+
+	return 0;
+}
+
+static void
+usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+
+Command-line tool to show the interrupt latency statistics since boot or the last reset:
+the longest section with interrupts disabled (entered via px4_enter_critical_section(), which includes
+the ATOMIC sections of uORB and the hrt) with the address of its call site, and the slowest interrupt handlers.
+The addresses can be resolved with `arm-none-eabi-addr2line -e <firmware.elf>`.
+
+Only available on builds with CONFIG_SCHED_CRITMONITOR or CONFIG_SCHED_IRQMONITOR (e.g. px4_fmu-v5_critmonitor).
+The same statistics are published by load_mon as `irq_stats`.
+
+### Examples
+
+Measure for 10 seconds:
+$ irqstat reset
+$ sleep 10
+$ irqstat
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("irqstat", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the statistics");
+}
@@ -0,0 +1,191 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file memtrack.cpp
+ *
+ * Print the heap fragmentation and the heap allocations per task, including
+ * the allocations done while armed.
+ */
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform/malloc_tracker.h>
+
+#include <malloc.h>
+#include <string.h>
+
+#include <nuttx/sched.h>
+
+extern "C" FAR struct tcb_s *sched_gettcb(pid_t pid);
+
+static void	usage();
+
+extern "C" {
+	__EXPORT int memtrack_main(int argc, char *argv[]);
+}
+
+static void
+print_heap()
+{
+	struct mallinfo mem;
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	mem = mallinfo();
+#else
+	(void)mallinfo(&mem);
+#endif /* CONFIG_CAN_PASS_STRUCTS */
+
+	// fragmentation: how much of the free memory is not usable for an allocation of the largest free block size
+	const float fragmentation = mem.fordblks > 0 ? 100.f * (1.f - (float)mem.mxordblk / mem.fordblks) : 0.f;
+
+	PX4_INFO_RAW("heap: %i B total, %i B used, %i B free in %i blocks, largest free block: %i B (fragmentation: %.1f%%)\n",
+		     mem.arena, mem.uordblks, mem.fordblks, mem.ordblks, mem.mxordblk, (double)fragmentation);
+}
+
+#if defined(PX4_MALLOC_TRACKER)
+static void
+task_name(pid_t pid, char *name, size_t size)
+{
+	strncpy(name, "(exited)", size);
+
+#if CONFIG_TASK_NAME_SIZE > 0
+	sched_lock();
+	FAR struct tcb_s *tcb = sched_gettcb(pid);
+
+	if (tcb) {
+		strncpy(name, tcb->name, size);
+	}
+
+	sched_unlock();
+#endif
+
+	name[size - 1] = '\0';
+}
+
+static void
+print_tracker()
+{
+	static constexpr int MAX_TASKS = CONFIG_MAX_TASKS;
+
+	malloc_tracker_task_s *tasks = new malloc_tracker_task_s[MAX_TASKS];
+
+	if (!tasks) {
+		PX4_ERR("alloc failed");
+		return;
+	}
+
+	const int num_tasks = px4_malloc_tracker_tasks(tasks, MAX_TASKS);
+	char name[24];
+
+	PX4_INFO_RAW("\n PID NAME                       ALLOCS     FREES  FAILED      BYTES  MAX SIZE  ARMED\n");
+
+	for (int i = 0; i < num_tasks; i++) {
+		task_name(tasks[i].pid, name, sizeof(name));
+		PX4_INFO_RAW("%4i %-24s %9u %9u %7u %10llu %9u %6u\n", (int)tasks[i].pid, name, (unsigned)tasks[i].allocs,
+			     (unsigned)tasks[i].frees, (unsigned)tasks[i].failed, (unsigned long long)tasks[i].bytes,
+			     (unsigned)tasks[i].max_size, (unsigned)tasks[i].armed_allocs);
+	}
+
+	delete[] tasks;
+
+	malloc_tracker_alloc_s allocs[MALLOC_TRACKER_ARMED_ALLOCS];
+	const int num_allocs = px4_malloc_tracker_armed_allocs(allocs, MALLOC_TRACKER_ARMED_ALLOCS);
+
+	PX4_INFO_RAW("\nallocations while armed: %u\n", (unsigned)px4_malloc_tracker_armed_count());
+
+	if (num_allocs > 0) {
+		PX4_INFO_RAW("\n TIME [s]  PID NAME                       SIZE  CALLER\n");
+
+		for (int i = 0; i < num_allocs; i++) {
+			task_name(allocs[i].pid, name, sizeof(name));
+			PX4_INFO_RAW("%9.3f %4i %-24s %6u  0x%08x\n", (double)(allocs[i].timestamp / 1e6), (int)allocs[i].pid, name,
+				     (unsigned)allocs[i].size, (unsigned)allocs[i].caller);
+		}
+	}
+}
+#endif /* PX4_MALLOC_TRACKER */
+
+int
+memtrack_main(int argc, char *argv[])
+{
+	if (argc > 1) {
+#if defined(PX4_MALLOC_TRACKER)
+
+		if (strcmp(argv[1], "reset") == 0) {
+			px4_malloc_tracker_reset();
+			return 0;
+		}
+
+#endif
+		usage();
+		return 1;
+	}
+
+	print_heap();
+
+#if defined(PX4_MALLOC_TRACKER)
+	print_tracker();
+#else
+	PX4_INFO_RAW("per task allocation tracking requires a build with the MALLOC_TRACKER board option\n");
+#endif
+
+	return 0;
+}
+
+static void
+usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+
+Command-line tool to show the heap usage and fragmentation (free memory that is not part of the largest free block),
+and on builds with the MALLOC_TRACKER board option (e.g. px4_fmu-v5_stackcheck) the heap allocations of each task since
+boot or the last reset.
+
+Allocations while armed are counted separately (the armed state is updated by load_mon) and the most recent ones are
+listed with the address of the call site, which can be resolved with `arm-none-eabi-addr2line -e <firmware.elf>`.
+Flight code should not allocate while armed.
+
+### Examples
+
+Check for allocations during a flight:
+$ memtrack reset
+$ memtrack
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("memtrack", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("reset", "Reset the allocation statistics");
+}
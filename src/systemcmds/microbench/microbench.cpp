@@ -0,0 +1,635 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file microbench.cpp
+ *
+ * Microbenchmarks of flight critical subsystems with machine readable output
+ * and comparison against a baseline, to catch performance regressions per board.
+ */
+
+#include <drivers/drv_hrt.h>
+#include <lib/ecl/EKF/ekf.h>
+#include <lib/ecl/geo/geo.h>
+#include <lib/mathlib/math/filter/LowPassFilter2p.hpp>
+#include <lib/mathlib/math/filter/LowPassFilter2pVector3f.hpp>
+#include <lib/mathlib/math/filter/NotchFilter.hpp>
+#include <lib/mathlib/math/filter/NotchFilterArray.hpp>
+#include <lib/mixer/MixerGroup.hpp>
+#include <lib/parameters/param.h>
+#include <lib/perf/perf_counter.h>
+#include <modules/dataman/dataman.h>
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/micro_hal.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/px4_work_queue/ScheduledWorkItem.hpp>
+#include <uORB/Publication.hpp>
+#include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionCallback.hpp>
+#include <uORB/topics/orb_test.h>
+#include <uORB/topics/orb_test_large.h>
+#include <uORB/topics/orb_test_medium.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __PX4_NUTTX
+#include <nuttx/irq.h>
+#endif
+
+extern "C" __EXPORT int microbench_main(int argc, char *argv[]);
+
+namespace microbench
+{
+
+static constexpr int MAX_RESULTS = 64;
+static constexpr int FILTER_BLOCK_SIZE = 32;
+
+struct Result {
+	const char *suite;
+	const char *name;
+	unsigned iterations;
+	float avg_us;
+	float min_us;
+	float max_us;
+};
+
+static Result results[MAX_RESULTS];
+static int num_results;
+static int iterations;
+
+/**
+ * Measure op() and store the result.
+ * @param critical run with interrupts disabled (NuttX), only for code that does not block
+ */
+template<typename Op>
+static void measure(const char *suite, const char *name, bool critical, Op op)
+{
+	if (num_results >= MAX_RESULTS) {
+		PX4_ERR("too many results");
+		return;
+	}
+
+	perf_counter_t perf = perf_alloc(PC_ELAPSED_CYCLES, name);
+
+	if (perf == nullptr) {
+		return;
+	}
+
+	px4_usleep(1000);
+
+	for (int i = 0; i < iterations; i++) {
+#ifdef __PX4_NUTTX
+		irqstate_t flags = 0;
+
+		if (critical) {
+			flags = px4_enter_critical_section();
+		}
+
+#endif
+
+		perf_begin(perf);
+		op();
+		perf_end(perf);
+
+#ifdef __PX4_NUTTX
+
+		if (critical) {
+			px4_leave_critical_section(flags);
+		}
+
+#endif
+	}
+
+	perf_counter_stats stats;
+	perf_get_stats(perf, &stats);
+	perf_free(perf);
+
+	Result &result = results[num_results++];
+	result.suite = suite;
+	result.name = name;
+	result.iterations = stats.event_count;
+	result.avg_us = stats.avg_us;
+	result.min_us = stats.min_us;
+	result.max_us = stats.max_us;
+}
+
+static float control_values[4] {0.1f, -0.2f, 0.05f, 0.6f};
+
+static int mixer_callback(uintptr_t handle, uint8_t control_group, uint8_t control_index, float &control)
+{
+	if (control_group != 0 || control_index >= sizeof(control_values) / sizeof(control_values[0])) {
+		return -1;
+	}
+
+	control = control_values[control_index];
+	return 0;
+}
+
+static void bench_mixer()
+{
+	static constexpr const char *mixers[][2] {
+		{"quad_x", "R: 4x 10000 10000 10000 0\n"},
+		{"hexa_x", "R: 6x 10000 10000 10000 0\n"},
+		{"simple x4", "M: 1\nS: 0 0 10000 10000 0 -10000 10000\n"
+			      "M: 1\nS: 0 1 10000 10000 0 -10000 10000\n"
+			      "M: 1\nS: 0 2 10000 10000 0 -10000 10000\n"
+			      "M: 1\nS: 0 3 10000 10000 0 -10000 10000\n"},
+	};
+
+	for (const auto &mixer : mixers) {
+		MixerGroup *group = new MixerGroup();
+
+		if (group == nullptr) {
+			return;
+		}
+
+		unsigned buflen = strlen(mixer[1]);
+
+		if (group->load_from_buf(mixer_callback, 0, mixer[1], buflen) == 0) {
+			float outputs[16];
+			measure("mixer", mixer[0], true, [&]() { group->mix(outputs, 16); });
+
+		} else {
+			PX4_ERR("failed to load mixer %s", mixer[0]);
+		}
+
+		delete group;
+	}
+}
+
+static void bench_filter()
+{
+	volatile float input = 0.3f;
+	volatile float output;
+
+	math::LowPassFilter2p lpf{8000.f, 30.f};
+	measure("filter", "lpf2p", true, [&]() { output = lpf.apply(input); });
+
+	math::NotchFilter<float> notch{};
+	notch.setParameters(8000.f, 200.f, 20.f);
+	measure("filter", "notch", true, [&]() { const float sample = input; output = notch.apply(sample); });
+
+	math::LowPassFilter2pVector3f lpf_vector{8000.f, 30.f};
+	const matrix::Vector3f input_vector{0.1f, 0.2f, 0.3f};
+	measure("filter", "lpf2p vector3f", true, [&]() { output = lpf_vector.apply(input_vector)(0); });
+
+	float block[FILTER_BLOCK_SIZE];
+
+	for (int i = 0; i < FILTER_BLOCK_SIZE; i++) {
+		block[i] = 0.01f * i;
+	}
+
+	math::NotchFilterArray<float> notch_array{};
+	notch_array.setParameters(8000.f, 200.f, 20.f);
+	measure("filter", "notch array 32", true, [&]() { notch_array.apply(block, FILTER_BLOCK_SIZE); });
+
+	(void)output;
+}
+
+static void bench_ekf()
+{
+	Ekf *ekf = new Ekf();
+
+	if (ekf == nullptr) {
+		return;
+	}
+
+	// feed a vehicle at rest until the filter is initialised and converged a bit
+	static constexpr uint64_t IMU_DT_US = 4000;
+	uint64_t time_us = 1000000;
+
+	imuSample imu_sample{};
+	imu_sample.delta_ang_dt = IMU_DT_US * 1e-6f;
+	imu_sample.delta_vel_dt = IMU_DT_US * 1e-6f;
+	imu_sample.delta_vel = matrix::Vector3f{0.f, 0.f, -CONSTANTS_ONE_G * imu_sample.delta_vel_dt};
+
+	auto step = [&]() {
+		time_us += IMU_DT_US;
+		imu_sample.time_us = time_us;
+		ekf->setIMUData(imu_sample);
+
+		if ((time_us / IMU_DT_US) % 5 == 0) {
+			magSample mag_sample{};
+			mag_sample.mag = matrix::Vector3f{0.2f, 0.f, 0.4f};
+			mag_sample.time_us = time_us;
+			ekf->setMagData(mag_sample);
+
+			const baroSample baro_sample{100.f, time_us};
+			ekf->setBaroData(baro_sample);
+		}
+
+		ekf->update();
+	};
+
+	for (int i = 0; i < 2500; i++) {
+		step();
+	}
+
+	measure("ekf", "update", false, step);
+
+	delete ekf;
+}
+
+static void bench_param()
+{
+	volatile param_t handle = PARAM_INVALID;
+	measure("param", "find", false, [&]() { handle = param_find("SYS_AUTOSTART"); });
+
+	int32_t value = 0;
+	measure("param", "get", false, [&]() { param_get(handle, &value); });
+}
+
+static void bench_dataman()
+{
+	mission_s mission{};
+
+	if (dm_read(DM_KEY_MISSION_STATE, 0, &mission, sizeof(mission_s)) < 0) {
+		PX4_WARN("dataman not available, skipping");
+		return;
+	}
+
+	measure("dataman", "read mission state", false, [&]() { dm_read(DM_KEY_MISSION_STATE, 0, &mission, sizeof(mission_s)); });
+
+	mission_item_s mission_item{};
+	measure("dataman", "read mission item", false, [&]() {
+		dm_read(DM_KEY_WAYPOINTS_OFFBOARD_0, 0, &mission_item, sizeof(mission_item_s));
+	});
+}
+
+/** counts the callbacks on orb_test_medium publications */
+class CountingCallback : public uORB::SubscriptionCallback
+{
+public:
+	CountingCallback() : SubscriptionCallback(ORB_ID(orb_test_medium)) {}
+
+	void call() override { _calls++; }
+
+private:
+	volatile unsigned _calls{0};
+};
+
+/** publishes orb_test_medium periodically from a work queue to create contention */
+class Contender : public px4::ScheduledWorkItem
+{
+public:
+	Contender(const px4::wq_config_t &config) : ScheduledWorkItem("microbench_contender", config) {}
+
+	void Run() override { _pub.publish(_data); }
+
+private:
+	uORB::Publication<orb_test_medium_s> _pub{ORB_ID(orb_test_medium)};
+	orb_test_medium_s _data{};
+};
+
+static void bench_uorb()
+{
+	static constexpr int SWEEP_MAX = 16;
+	static constexpr int sweep[] {1, 4, 16};
+
+	// publication cost vs message size
+	{
+		uORB::Publication<orb_test_s> pub{ORB_ID(orb_test)};
+		orb_test_s data{};
+		measure("uorb", "publish small", true, [&]() { pub.publish(data); });
+	}
+
+	{
+		uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+		orb_test_medium_s data{};
+		measure("uorb", "publish medium", true, [&]() { pub.publish(data); });
+	}
+
+	{
+		uORB::Publication<orb_test_large_s> pub{ORB_ID(orb_test_large)};
+		orb_test_large_s data{};
+		measure("uorb", "publish large", true, [&]() { pub.publish(data); });
+	}
+
+	uORB::Publication<orb_test_medium_s> pub{ORB_ID(orb_test_medium)};
+	orb_test_medium_s data{};
+
+	// publication and copy by every subscriber
+	{
+		static constexpr const char *names[] {"publish+copy 1 subscriber", "publish+copy 4 subscribers", "publish+copy 16 subscribers"};
+		uORB::Subscription *subs[SWEEP_MAX] {};
+
+		for (int i = 0; i < SWEEP_MAX; i++) {
+			subs[i] = new uORB::Subscription(ORB_ID(orb_test_medium));
+		}
+
+		for (unsigned n = 0; n < sizeof(sweep) / sizeof(sweep[0]); n++) {
+			measure("uorb", names[n], true, [&]() {
+				pub.publish(data);
+
+				for (int i = 0; i < sweep[n]; i++) {
+					if (subs[i]) {
+						subs[i]->update(&data);
+					}
+				}
+			});
+		}
+
+		for (int i = 0; i < SWEEP_MAX; i++) {
+			delete subs[i];
+		}
+	}
+
+	// publication cost vs number of registered callbacks
+	{
+		static constexpr const char *names[] {"publish 1 callback", "publish 4 callbacks", "publish 16 callbacks"};
+		CountingCallback *callbacks[SWEEP_MAX] {};
+		int registered = 0;
+
+		for (unsigned n = 0; n < sizeof(sweep) / sizeof(sweep[0]); n++) {
+			for (; registered < sweep[n]; registered++) {
+				callbacks[registered] = new CountingCallback();
+
+				if (callbacks[registered]) {
+					callbacks[registered]->registerCallback();
+				}
+			}
+
+			measure("uorb", names[n], true, [&]() { pub.publish(data); });
+		}
+
+		for (int i = 0; i < registered; i++) {
+			delete callbacks[i];
+		}
+	}
+
+	// queued topics: publish a full queue and drain it
+	{
+		uORB::Publication<orb_test_medium_s, 4> pub_queue4{ORB_ID(orb_test_medium_queue)};
+		uORB::Subscription sub_queue4{ORB_ID(orb_test_medium_queue)};
+		pub_queue4.advertise();
+		sub_queue4.subscribe();
+
+		measure("uorb", "publish+drain queue 4", true, [&]() {
+			for (int i = 0; i < 4; i++) {
+				pub_queue4.publish(data);
+			}
+
+			while (sub_queue4.update(&data)) {}
+		});
+
+		uORB::Publication<orb_test_medium_s, 16> pub_queue16{ORB_ID(orb_test_medium_queue_poll)};
+		uORB::Subscription sub_queue16{ORB_ID(orb_test_medium_queue_poll)};
+		pub_queue16.advertise();
+		sub_queue16.subscribe();
+
+		measure("uorb", "publish+drain queue 16", true, [&]() {
+			for (int i = 0; i < 16; i++) {
+				pub_queue16.publish(data);
+			}
+
+			while (sub_queue16.update(&data)) {}
+		});
+	}
+
+	// contention: other work queues publish to the same topic every 100 us
+	{
+		Contender *contenders[2] {new Contender(px4::wq_configurations::test1), new Contender(px4::wq_configurations::test2)};
+
+		for (Contender *contender : contenders) {
+			if (contender) {
+				contender->ScheduleOnInterval(100);
+			}
+		}
+
+		measure("uorb", "publish contended 2 work queues", false, [&]() { pub.publish(data); });
+
+		for (Contender *contender : contenders) {
+			if (contender) {
+				contender->ScheduleClear();
+			}
+		}
+
+		// let a running cycle finish
+		px4_usleep(10000);
+
+		for (Contender *contender : contenders) {
+			delete contender;
+		}
+	}
+}
+
+struct Suite {
+	const char *name;
+	void (*run)();
+};
+
+static constexpr Suite suites[] {
+	{"mixer", bench_mixer},
+	{"filter", bench_filter},
+	{"ekf", bench_ekf},
+	{"param", bench_param},
+	{"dataman", bench_dataman},
+	{"uorb", bench_uorb},
+};
+
+static void print_results(FILE *fp)
+{
+	fprintf(fp, "suite,name,iterations,avg_us,min_us,max_us\n");
+
+	for (int i = 0; i < num_results; i++) {
+		const Result &r = results[i];
+		fprintf(fp, "%s,%s,%u,%.3f,%.3f,%.3f\n", r.suite, r.name, r.iterations, (double)r.avg_us, (double)r.min_us,
+			(double)r.max_us);
+	}
+}
+
+/**
+ * Compare the averages against a baseline file in the output format.
+ * @return number of regressions, -1 on error
+ */
+static int compare_baseline(const char *baseline_file, float tolerance)
+{
+	FILE *fp = fopen(baseline_file, "r");
+
+	if (fp == nullptr) {
+		PX4_ERR("failed to open %s", baseline_file);
+		return -1;
+	}
+
+	printf("suite,name,avg_us,baseline_avg_us,change_percent,result\n");
+
+	int regressions = 0;
+	char line[128];
+
+	while (fgets(line, sizeof(line), fp)) {
+		char *save = nullptr;
+		const char *suite = strtok_r(line, ",", &save);
+		const char *name = strtok_r(nullptr, ",", &save);
+		strtok_r(nullptr, ",", &save); // iterations
+		const char *avg = strtok_r(nullptr, ",", &save);
+
+		if (suite == nullptr || name == nullptr || avg == nullptr || strcmp(suite, "suite") == 0) {
+			continue;
+		}
+
+		const float baseline_avg = strtof(avg, nullptr);
+
+		for (int i = 0; i < num_results; i++) {
+			const Result &r = results[i];
+
+			if (strcmp(r.suite, suite) == 0 && strcmp(r.name, name) == 0 && baseline_avg > 0.f) {
+				const float change = (r.avg_us / baseline_avg - 1.f) * 100.f;
+				const bool regression = change > tolerance;
+				regressions += regression;
+				printf("%s,%s,%.3f,%.3f,%.1f,%s\n", r.suite, r.name, (double)r.avg_us, (double)baseline_avg, (double)change,
+				       regression ? "REGRESSION" : "OK");
+			}
+		}
+	}
+
+	fclose(fp);
+	return regressions;
+}
+
+static void usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+Microbenchmarks of mixers, filters, the EKF update, parameter access, dataman and uORB.
+
+The uORB suite sweeps the message size, the number of subscribers, registered callbacks and the queue depth, and
+measures publications while two other work queues publish to the same topic.
+
+The results are printed as CSV (times in us, measured with the CPU cycle counter where available). A result file can
+be used as baseline for later runs (e.g. per board in hardware-in-the-loop CI): the command then fails if the average
+time of a benchmark increased by more than the tolerance.
+
+### Examples
+$ microbench -o /fs/microsd/microbench.csv
+$ microbench -b /fs/microsd/microbench.csv -t 10 mixer filter
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME_SIMPLE("microbench", "command");
+	PRINT_MODULE_USAGE_PARAM_INT('n', 100, 1, 100000, "Number of iterations per benchmark", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('o', nullptr, "<file>", "Write the results to a CSV file", true);
+	PRINT_MODULE_USAGE_PARAM_STRING('b', nullptr, "<file>", "Compare against a baseline CSV file", true);
+	PRINT_MODULE_USAGE_PARAM_FLOAT('t', 20.f, 0.f, 1000.f, "Allowed increase of the average time in percent", true);
+	PRINT_MODULE_USAGE_ARG("mixer|filter|ekf|param|dataman|uorb", "Benchmark suites to run (default: all)", true);
+}
+
+} // namespace microbench
+
+using namespace microbench;
+
+int microbench_main(int argc, char *argv[])
+{
+	const char *output_file = nullptr;
+	const char *baseline_file = nullptr;
+	float tolerance = 20.f;
+	iterations = 100;
+
+	int myoptind = 1;
+	int ch;
+	const char *myoptarg = nullptr;
+
+	while ((ch = px4_getopt(argc, argv, "n:o:b:t:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			iterations = strtol(myoptarg, nullptr, 0);
+			break;
+
+		case 'o':
+			output_file = myoptarg;
+			break;
+
+		case 'b':
+			baseline_file = myoptarg;
+			break;
+
+		case 't':
+			tolerance = strtof(myoptarg, nullptr);
+			break;
+
+		default:
+			usage();
+			return -1;
+		}
+	}
+
+	if (iterations <= 0) {
+		PX4_ERR("invalid argument");
+		return -1;
+	}
+
+	num_results = 0;
+
+	for (const Suite &suite : suites) {
+		bool selected = (myoptind >= argc);
+
+		for (int i = myoptind; i < argc; i++) {
+			selected |= (strcmp(argv[i], suite.name) == 0);
+		}
+
+		if (selected) {
+			suite.run();
+		}
+	}
+
+	print_results(stdout);
+
+	if (output_file) {
+		FILE *fp = fopen(output_file, "w");
+
+		if (fp == nullptr) {
+			PX4_ERR("failed to open %s", output_file);
+			return -1;
+		}
+
+		print_results(fp);
+		fclose(fp);
+	}
+
+	if (baseline_file) {
+		const int regressions = compare_baseline(baseline_file, tolerance);
+
+		if (regressions != 0) {
+			if (regressions > 0) {
+				PX4_ERR("%i regression(s)", regressions);
+			}
+
+			return 1;
+		}
+	}
+
+	return 0;
+}
@@ -39,52 +39,124 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <unistd.h>
 
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/getopt.h>
 #include <px4_platform_common/log.h>
+#include <px4_platform_common/time.h>
 
 #include <drivers/drv_hrt.h>
 
+/** latency histogram with power of 2 buckets: < 0.125 ms, < 0.25 ms, ..., < 256 ms, >= 256 ms */
+#define LATENCY_BUCKETS 13
+#define LATENCY_FIRST_BUCKET_US 125
+
+struct latency_hist_s {
+	uint32_t buckets[LATENCY_BUCKETS];
+	uint32_t count;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+/** concurrent reader thread state */
+struct reader_s {
+	pthread_t thread;
+	int fd;
+	int block_size;
+	uint8_t *block;
+	volatile bool should_exit;
+	bool error;
+	uint64_t bytes;
+	struct latency_hist_s hist;
+};
+
 static void	usage(void);
 
-/** sequential write speed test */
-static void	write_test(int fd, uint8_t *block, int block_size);
+/** sequential write speed test, returns the average speed in KB/s (< 0 on error) */
+static double	write_test(int fd, uint8_t *block, int block_size, struct latency_hist_s *write_hist,
+			   struct latency_hist_s *fsync_hist);
+
+/** rate limited write test mirroring the logger: fixed data rate, fsync every second */
+static int	rate_test(int fd, uint8_t *block, int block_size, int rate_kb_s, struct latency_hist_s *write_hist,
+			  struct latency_hist_s *fsync_hist);
+
+/** test all combinations of a set of block sizes and alignments */
+static int	sweep_test(void);
 
 /**
  * Measure the time for fsync.
  * @param fd
+ * @param hist histogram to add the time to (may be NULL)
  * @return time in ms
  */
-static inline unsigned int time_fsync(int fd);
+static inline unsigned int time_fsync(int fd, struct latency_hist_s *hist);
+
+static int	open_bench_file(int file_offset, uint8_t *block);
+
+static int	reader_start(struct reader_s *reader, int block_size);
+static void	reader_stop(struct reader_s *reader);
+static void	*reader_thread(void *arg);
+
+static void	latency_add(struct latency_hist_s *hist, uint32_t us);
+static uint32_t	latency_percentile_us(const struct latency_hist_s *hist, double percentile);
+static void	latency_print(const char *name, const struct latency_hist_s *hist);
 
 __EXPORT int	sd_bench_main(int argc, char *argv[]);
 
 static const char *BENCHMARK_FILE = PX4_STORAGEDIR"/benchmark.tmp";
+static const char *BENCHMARK_READ_FILE = PX4_STORAGEDIR"/benchmark_read.tmp";
+
+static const int READ_FILE_SIZE = 512 * 1024; ///< size of the file read by the concurrent reader [bytes]
 
 static int num_runs; ///< number of runs
 static int run_duration; ///< duration of a single run [ms]
 static bool synchronized; ///< call fsync after each block?
 
 static void
-usage()
+usage(void)
 {
-	PRINT_MODULE_DESCRIPTION("Test the speed of an SD Card");
+	PRINT_MODULE_DESCRIPTION(
+		"### Description\n"
+		"Test the speed of an SD Card.\n"
+		"\n"
+		"Besides the throughput it reports a latency histogram of the individual writes and of fsync, which is\n"
+		"what matters for logging: the logger buffer must be able to hold the data produced during the longest stall.\n"
+		"\n"
+		"With -R the writes are paced to a fixed data rate and fsync is called every second, like the logger does,\n"
+		"and the buffer size needed for that rate is reported. -c adds a concurrent reader (e.g. log download during\n"
+		"logging). -S runs a sweep over block sizes, file offset alignments and buffer alignments.\n"
+		"\n"
+		"### Examples\n"
+		"Qualify a card for logging at 200 KB/s with a concurrent reader:\n"
+		"$ sd_bench -R 200 -c -d 10000\n");
 
 	PRINT_MODULE_USAGE_NAME_SIMPLE("sd_bench", "command");
 	PRINT_MODULE_USAGE_PARAM_INT('b', 4096, 1, 1000000, "Block size for each read/write", true);
 	PRINT_MODULE_USAGE_PARAM_INT('r', 5, 1, 1000, "Number of runs", true);
 	PRINT_MODULE_USAGE_PARAM_INT('d', 2000, 1, 100000, "Duration of a run in ms", true);
 	PRINT_MODULE_USAGE_PARAM_FLAG('s', "Call fsync after each block (default=at end of each run)", true);
+	PRINT_MODULE_USAGE_PARAM_INT('a', 0, 0, 4095, "Offset of the blocks in the file (misalignment) in bytes", true);
+	PRINT_MODULE_USAGE_PARAM_INT('m', 0, 0, 63, "Offset of the data buffer in memory (misalignment) in bytes", true);
+	PRINT_MODULE_USAGE_PARAM_INT('R', 0, 0, 100000, "Write at this rate in KB/s with fsync every second (logger pattern)",
+				     true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('c', "Read another file concurrently", true);
+	PRINT_MODULE_USAGE_PARAM_FLAG('S', "Sweep block sizes and alignments (one run each)", true);
 }
 
 int
 sd_bench_main(int argc, char *argv[])
 {
 	int block_size = 4096;
+	int file_offset = 0;
+	int memory_offset = 0;
+	int rate_kb_s = 0;
+	bool concurrent_read = false;
+	bool sweep = false;
 	int myoptind = 1;
 	int ch;
 	const char *myoptarg = NULL;
@@ -92,7 +164,7 @@ sd_bench_main(int argc, char *argv[])
 	num_runs = 5;
 	run_duration = 2000;
 
-	while ((ch = px4_getopt(argc, argv, "b:r:d:s", &myoptind, &myoptarg)) != EOF) {
+	while ((ch = px4_getopt(argc, argv, "b:r:d:sa:m:R:cS", &myoptind, &myoptarg)) != EOF) {
 		switch (ch) {
 		case 'b':
 			block_size = strtol(myoptarg, NULL, 0);
@@ -110,6 +182,26 @@ sd_bench_main(int argc, char *argv[])
 			synchronized = true;
 			break;
 
+		case 'a':
+			file_offset = strtol(myoptarg, NULL, 0);
+			break;
+
+		case 'm':
+			memory_offset = strtol(myoptarg, NULL, 0);
+			break;
+
+		case 'R':
+			rate_kb_s = strtol(myoptarg, NULL, 0);
+			break;
+
+		case 'c':
+			concurrent_read = true;
+			break;
+
+		case 'S':
+			sweep = true;
+			break;
+
 		default:
 			usage();
 			return -1;
@@ -117,49 +209,116 @@ sd_bench_main(int argc, char *argv[])
 		}
 	}
 
-	if (block_size <= 0 || num_runs <= 0) {
+	if (block_size <= 0 || num_runs <= 0 || file_offset < 0 || memory_offset < 0 || rate_kb_s < 0) {
 		PX4_ERR("invalid argument");
 		return -1;
 	}
 
-	int bench_fd = open(BENCHMARK_FILE, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
-
-	if (bench_fd < 0) {
-		PX4_ERR("Can't open benchmark file %s", BENCHMARK_FILE);
-		return -1;
+	if (sweep) {
+		return sweep_test();
 	}
 
 	//create some data block
-	uint8_t *block = (uint8_t *)malloc(block_size);
+	uint8_t *buffer = (uint8_t *)malloc(block_size + memory_offset);
 
-	if (!block) {
+	if (!buffer) {
 		PX4_ERR("Failed to allocate memory block");
-		close(bench_fd);
 		return -1;
 	}
 
+	uint8_t *block = buffer + memory_offset;
+
 	for (int i = 0; i < block_size; ++i) {
 		block[i] = (uint8_t)i;
 	}
 
-	PX4_INFO("Using block size = %i bytes, sync=%i", block_size, (int)synchronized);
-	write_test(bench_fd, block, block_size);
+	int bench_fd = open_bench_file(file_offset, block);
+
+	if (bench_fd < 0) {
+		free(buffer);
+		return -1;
+	}
+
+	struct reader_s reader;
+
+	if (concurrent_read && reader_start(&reader, block_size) != 0) {
+		free(buffer);
+		close(bench_fd);
+		unlink(BENCHMARK_FILE);
+		return -1;
+	}
+
+	PX4_INFO("Using block size = %i bytes, sync=%i, file offset=%i, memory offset=%i", block_size, (int)synchronized,
+		 file_offset, memory_offset);
+
+	struct latency_hist_s write_hist;
+	struct latency_hist_s fsync_hist;
+	memset(&write_hist, 0, sizeof(write_hist));
+	memset(&fsync_hist, 0, sizeof(fsync_hist));
+
+	int ret = 0;
+
+	if (rate_kb_s > 0) {
+		ret = rate_test(bench_fd, block, block_size, rate_kb_s, &write_hist, &fsync_hist);
+
+	} else if (write_test(bench_fd, block, block_size, &write_hist, &fsync_hist) < 0.) {
+		ret = -1;
+	}
+
+	if (concurrent_read) {
+		reader_stop(&reader);
+	}
+
+	if (ret == 0) {
+		latency_print("write", &write_hist);
+		latency_print("fsync", &fsync_hist);
 
-	free(block);
+		if (concurrent_read) {
+			latency_print("concurrent read", &reader.hist);
+		}
+	}
+
+	free(buffer);
 	close(bench_fd);
 	unlink(BENCHMARK_FILE);
 
-	return 0;
+	return ret;
 }
 
-unsigned int time_fsync(int fd)
+int open_bench_file(int file_offset, uint8_t *block)
+{
+	int fd = open(BENCHMARK_FILE, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("Can't open benchmark file %s", BENCHMARK_FILE);
+		return -1;
+	}
+
+	// shift all following writes relative to the sectors
+	if (file_offset > 0 && write(fd, block, file_offset) != file_offset) {
+		PX4_ERR("Write error");
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+unsigned int time_fsync(int fd, struct latency_hist_s *hist)
 {
 	hrt_abstime fsync_start = hrt_absolute_time();
 	fsync(fd);
-	return hrt_elapsed_time(&fsync_start) / 1000;
+	const uint32_t fsync_time_us = hrt_elapsed_time(&fsync_start);
+
+	if (hist) {
+		latency_add(hist, fsync_time_us);
+	}
+
+	return fsync_time_us / 1000;
 }
 
-void write_test(int fd, uint8_t *block, int block_size)
+double write_test(int fd, uint8_t *block, int block_size, struct latency_hist_s *write_hist,
+		  struct latency_hist_s *fsync_hist)
 {
 	PX4_INFO("");
 	PX4_INFO("Testing Sequential Write Speed...");
@@ -176,7 +335,9 @@ void write_test(int fd, uint8_t *block, int block_size)
 
 			hrt_abstime write_start = hrt_absolute_time();
 			size_t written = write(fd, block, block_size);
-			unsigned int write_time = hrt_elapsed_time(&write_start) / 1000;
+			const uint32_t write_time_us = hrt_elapsed_time(&write_start);
+			unsigned int write_time = write_time_us / 1000;
+			latency_add(write_hist, write_time_us);
 
 			if (write_time > max_write_time) {
 				max_write_time = write_time;
@@ -184,11 +345,11 @@ void write_test(int fd, uint8_t *block, int block_size)
 
 			if ((int)written != block_size) {
 				PX4_ERR("Write error");
-				return;
+				return -1.;
 			}
 
 			if (synchronized) {
-				fsync_time += time_fsync(fd);
+				fsync_time += time_fsync(fd, fsync_hist);
 			}
 
 			++num_blocks;
@@ -197,7 +358,7 @@ void write_test(int fd, uint8_t *block, int block_size)
 		//Note: if testing a slow device (SD Card) and the OS buffers a lot (eg. Linux),
 		//fsync can take really long, and it looks like the process hangs. But it does
 		//not and the reported result will still be correct.
-		fsync_time += time_fsync(fd);
+		fsync_time += time_fsync(fd, fsync_hist);
 
 		//report
 		double elapsed = hrt_elapsed_time(&start) / 1.e6;
@@ -209,5 +370,327 @@ void write_test(int fd, uint8_t *block, int block_size)
 		total_blocks += num_blocks;
 	}
 
-	PX4_INFO("  Avg   : %8.2lf KB/s", (double)block_size * total_blocks / total_elapsed / 1024.);
+	const double avg = (double)block_size * total_blocks / total_elapsed / 1024.;
+	PX4_INFO("  Avg   : %8.2lf KB/s", avg);
+	return avg;
+}
+
+int rate_test(int fd, uint8_t *block, int block_size, int rate_kb_s, struct latency_hist_s *write_hist,
+	      struct latency_hist_s *fsync_hist)
+{
+	PX4_INFO("");
+	PX4_INFO("Testing Writes at %i KB/s (fsync every %s)...", rate_kb_s, synchronized ? "block" : "second");
+
+	const double us_per_byte = 1.e6 / (rate_kb_s * 1024.);
+	uint32_t total_max_lag_us = 0;
+
+	for (int run = 0; run < num_runs; ++run) {
+		const hrt_abstime start = hrt_absolute_time();
+		hrt_abstime last_fsync = start;
+		uint64_t bytes = 0;
+		uint32_t max_lag_us = 0;
+		unsigned int max_write_time = 0;
+		unsigned int max_fsync_time = 0;
+
+		while ((int64_t)hrt_elapsed_time(&start) < run_duration * 1000) {
+
+			// wait until the data of this block has been produced
+			const hrt_abstime due = start + (hrt_abstime)(bytes * us_per_byte);
+			hrt_abstime now = hrt_absolute_time();
+
+			if (now < due) {
+				px4_usleep(due - now);
+			}
+
+			hrt_abstime write_start = hrt_absolute_time();
+			size_t written = write(fd, block, block_size);
+			const uint32_t write_time_us = hrt_elapsed_time(&write_start);
+			latency_add(write_hist, write_time_us);
+
+			if (write_time_us / 1000 > max_write_time) {
+				max_write_time = write_time_us / 1000;
+			}
+
+			if ((int)written != block_size) {
+				PX4_ERR("Write error");
+				return -1;
+			}
+
+			now = hrt_absolute_time();
+
+			if (synchronized || now - last_fsync > 1000000) {
+				const unsigned int fsync_time = time_fsync(fd, fsync_hist);
+
+				if (fsync_time > max_fsync_time) {
+					max_fsync_time = fsync_time;
+				}
+
+				last_fsync = now;
+			}
+
+			bytes += block_size;
+
+			// how far behind the data producer are we? The logger buffer needs to hold that
+			now = hrt_absolute_time();
+			const hrt_abstime next_due = start + (hrt_abstime)(bytes * us_per_byte);
+
+			if (now > next_due && now - next_due > max_lag_us) {
+				max_lag_us = now - next_due;
+			}
+		}
+
+		time_fsync(fd, fsync_hist);
+
+		double elapsed = hrt_elapsed_time(&start) / 1.e6;
+		PX4_INFO("  Run %2i: %8.2lf KB/s, max write: %i ms, max fsync: %i ms, max lag: %i ms", run,
+			 bytes / elapsed / 1024., max_write_time, max_fsync_time, (int)(max_lag_us / 1000));
+
+		if (max_lag_us > total_max_lag_us) {
+			total_max_lag_us = max_lag_us;
+		}
+	}
+
+	// data produced during the longest lag plus the block being written
+	const double buffer_kb = total_max_lag_us / us_per_byte / 1024. + block_size / 1024.;
+	PX4_INFO("  Logger buffer needed for %i KB/s: %.1lf KB (max lag %i ms)", rate_kb_s, buffer_kb,
+		 (int)(total_max_lag_us / 1000));
+	return 0;
+}
+
+int sweep_test(void)
+{
+	static const int block_sizes[] = {512, 1024, 2048, 4096, 8192, 16384, 32768};
+	static const int offsets[][2] = {{0, 0}, {1, 0}, {0, 1}}; // {file offset, memory offset}
+	const int max_block_size = block_sizes[sizeof(block_sizes) / sizeof(block_sizes[0]) - 1];
+
+	uint8_t *buffer = (uint8_t *)malloc(max_block_size + 1);
+
+	if (!buffer) {
+		PX4_ERR("Failed to allocate memory block");
+		return -1;
+	}
+
+	for (int i = 0; i < max_block_size + 1; ++i) {
+		buffer[i] = (uint8_t)i;
+	}
+
+	const int runs = num_runs;
+	num_runs = 1;
+
+	// the tests print their own progress; collect the summary and print it at the end
+	double speed[sizeof(block_sizes) / sizeof(block_sizes[0])][sizeof(offsets) / sizeof(offsets[0])];
+	uint32_t p99_us[sizeof(block_sizes) / sizeof(block_sizes[0])][sizeof(offsets) / sizeof(offsets[0])];
+	uint32_t max_us[sizeof(block_sizes) / sizeof(block_sizes[0])][sizeof(offsets) / sizeof(offsets[0])];
+	int ret = 0;
+
+	for (unsigned b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]) && ret == 0; ++b) {
+		for (unsigned o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o) {
+			uint8_t *block = buffer + offsets[o][1];
+			int fd = open_bench_file(offsets[o][0], block);
+
+			if (fd < 0) {
+				ret = -1;
+				break;
+			}
+
+			struct latency_hist_s write_hist;
+			memset(&write_hist, 0, sizeof(write_hist));
+			PX4_INFO("block size %i, file offset %i, memory offset %i", block_sizes[b], offsets[o][0], offsets[o][1]);
+			speed[b][o] = write_test(fd, block, block_sizes[b], &write_hist, NULL);
+			p99_us[b][o] = latency_percentile_us(&write_hist, 0.99);
+			max_us[b][o] = write_hist.max_us;
+
+			close(fd);
+			unlink(BENCHMARK_FILE);
+
+			if (speed[b][o] < 0.) {
+				ret = -1;
+				break;
+			}
+		}
+	}
+
+	num_runs = runs;
+	free(buffer);
+
+	if (ret != 0) {
+		return ret;
+	}
+
+	PX4_INFO("");
+	PX4_INFO_RAW("  block  file off  mem off      KB/s  p99 [ms]  max [ms]\n");
+
+	for (unsigned b = 0; b < sizeof(block_sizes) / sizeof(block_sizes[0]); ++b) {
+		for (unsigned o = 0; o < sizeof(offsets) / sizeof(offsets[0]); ++o) {
+			PX4_INFO_RAW("  %5i  %8i  %7i  %8.1lf  %8.2lf  %8.2lf\n", block_sizes[b], offsets[o][0], offsets[o][1],
+				     speed[b][o], p99_us[b][o] / 1000., max_us[b][o] / 1000.);
+		}
+	}
+
+	return 0;
+}
+
+int reader_start(struct reader_s *reader, int block_size)
+{
+	memset(reader, 0, sizeof(*reader));
+	reader->block_size = block_size;
+	reader->block = (uint8_t *)malloc(block_size);
+
+	if (!reader->block) {
+		PX4_ERR("Failed to allocate memory block");
+		return -1;
+	}
+
+	// create the file to read
+	int fd = open(BENCHMARK_READ_FILE, O_CREAT | O_WRONLY | O_TRUNC, PX4_O_MODE_666);
+
+	if (fd < 0) {
+		PX4_ERR("Can't open benchmark file %s", BENCHMARK_READ_FILE);
+		free(reader->block);
+		return -1;
+	}
+
+	memset(reader->block, 0x55, block_size);
+
+	for (int size = 0; size < READ_FILE_SIZE; size += block_size) {
+		if (write(fd, reader->block, block_size) != block_size) {
+			PX4_ERR("Write error");
+			close(fd);
+			free(reader->block);
+			return -1;
+		}
+	}
+
+	fsync(fd);
+	close(fd);
+
+	reader->fd = open(BENCHMARK_READ_FILE, O_RDONLY);
+
+	if (reader->fd < 0) {
+		PX4_ERR("Can't open benchmark file %s", BENCHMARK_READ_FILE);
+		free(reader->block);
+		return -1;
+	}
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, PX4_STACK_ADJUSTED(1500));
+	int ret = pthread_create(&reader->thread, &attr, reader_thread, reader);
+	pthread_attr_destroy(&attr);
+
+	if (ret != 0) {
+		PX4_ERR("Failed to start the reader thread (%i)", ret);
+		close(reader->fd);
+		free(reader->block);
+		return -1;
+	}
+
+	return 0;
+}
+
+void reader_stop(struct reader_s *reader)
+{
+	reader->should_exit = true;
+	pthread_join(reader->thread, NULL);
+
+	if (reader->error) {
+		PX4_ERR("Read error");
+	}
+
+	PX4_INFO("  Concurrent read: %llu KB", (unsigned long long)(reader->bytes / 1024));
+
+	close(reader->fd);
+	free(reader->block);
+	unlink(BENCHMARK_READ_FILE);
+}
+
+void *reader_thread(void *arg)
+{
+	struct reader_s *reader = (struct reader_s *)arg;
+
+	while (!reader->should_exit) {
+		hrt_abstime read_start = hrt_absolute_time();
+		ssize_t num_read = read(reader->fd, reader->block, reader->block_size);
+		latency_add(&reader->hist, hrt_elapsed_time(&read_start));
+
+		if (num_read < 0) {
+			reader->error = true;
+			break;
+
+		} else if (num_read < reader->block_size) {
+			// start over at the end of the file
+			lseek(reader->fd, 0, SEEK_SET);
+		}
+
+		reader->bytes += num_read;
+	}
+
+	return NULL;
+}
+
+void latency_add(struct latency_hist_s *hist, uint32_t us)
+{
+	int bucket = 0;
+
+	while (bucket < LATENCY_BUCKETS - 1 && us >= ((uint32_t)LATENCY_FIRST_BUCKET_US << bucket)) {
+		++bucket;
+	}
+
+	hist->buckets[bucket]++;
+	hist->count++;
+	hist->total_us += us;
+
+	if (us > hist->max_us) {
+		hist->max_us = us;
+	}
+}
+
+uint32_t latency_percentile_us(const struct latency_hist_s *hist, double percentile)
+{
+	const uint32_t rank = (uint32_t)(percentile * hist->count);
+	uint32_t count = 0;
+
+	for (int bucket = 0; bucket < LATENCY_BUCKETS - 1; ++bucket) {
+		count += hist->buckets[bucket];
+
+		if (count > rank) {
+			// upper bound of the bucket
+			const uint32_t upper = (uint32_t)LATENCY_FIRST_BUCKET_US << bucket;
+			return upper < hist->max_us ? upper : hist->max_us;
+		}
+	}
+
+	return hist->max_us;
+}
+
+void latency_print(const char *name, const struct latency_hist_s *hist)
+{
+	if (hist->count == 0) {
+		return;
+	}
+
+	PX4_INFO("");
+	PX4_INFO("%s latency: avg %.2lf ms, p50 < %.2lf ms, p90 < %.2lf ms, p99 < %.2lf ms, max %.2lf ms (%u samples)", name,
+		 hist->total_us / 1000. / hist->count,
+		 latency_percentile_us(hist, 0.5) / 1000., latency_percentile_us(hist, 0.9) / 1000.,
+		 latency_percentile_us(hist, 0.99) / 1000., hist->max_us / 1000., (unsigned)hist->count);
+
+	uint32_t cumulative = 0;
+
+	for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket) {
+		if (hist->buckets[bucket] == 0) {
+			continue;
+		}
+
+		cumulative += hist->buckets[bucket];
+
+		if (bucket < LATENCY_BUCKETS - 1) {
+			PX4_INFO_RAW("    < %7.3lf ms: %8u %6.2lf%% %6.2lf%%\n", (LATENCY_FIRST_BUCKET_US << bucket) / 1000.,
+				     (unsigned)hist->buckets[bucket], 100. * hist->buckets[bucket] / hist->count, 100. * cumulative / hist->count);
+
+		} else {
+			PX4_INFO_RAW("    >=%7.3lf ms: %8u %6.2lf%% %6.2lf%%\n", (LATENCY_FIRST_BUCKET_US << (bucket - 1)) / 1000.,
+				     (unsigned)hist->buckets[bucket], 100. * hist->buckets[bucket] / hist->count, 100. * cumulative / hist->count);
+		}
+	}
 }
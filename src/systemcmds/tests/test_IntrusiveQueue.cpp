@@ -52,6 +52,7 @@ public:
 	bool test_push_duplicate();
 	bool test_remove();
 	bool test_reinsert();
+	bool test_insert_after();
 
 };
 
@@ -62,6 +63,7 @@ bool IntrusiveQueueTest::run_tests()
 	ut_run_test(test_push_duplicate);
 	ut_run_test(test_remove);
 	ut_run_test(test_reinsert);
+	ut_run_test(test_insert_after);
 
 	return (_tests_failed == 0);
 }
@@ -383,4 +385,53 @@ bool IntrusiveQueueTest::test_reinsert()
 	return true;
 }
 
+bool IntrusiveQueueTest::test_insert_after()
+{
+	IntrusiveQueue<testContainer *> q1;
+
+	testContainer *t[5];
+
+	for (int i = 0; i < 5; i++) {
+		t[i] = new testContainer();
+		t[i]->i = i;
+	}
+
+	// insert into empty queue at the front: 1
+	q1.insert_after(nullptr, t[1]);
+	ut_compare("size 1", q1.size(), 1);
+	ut_assert_true(q1.front() == t[1]);
+	ut_assert_true(q1.back() == t[1]);
+
+	// insert after tail: 1 3
+	q1.insert_after(t[1], t[3]);
+	ut_assert_true(q1.back() == t[3]);
+
+	// insert at the front: 0 1 3
+	q1.insert_after(nullptr, t[0]);
+	ut_assert_true(q1.front() == t[0]);
+
+	// insert in the middle: 0 1 2 3
+	q1.insert_after(t[1], t[2]);
+
+	// push still appends at the back: 0 1 2 3 4
+	q1.push(t[4]);
+
+	// duplicate insert is rejected
+	q1.insert_after(nullptr, t[2]);
+	q1.insert_after(nullptr, t[4]);
+	ut_compare("size 5", q1.size(), 5);
+
+	// verify order
+	for (int i = 0; i < 5; i++) {
+		testContainer *node = q1.pop();
+		ut_assert_true(node != nullptr);
+		ut_compare("order", node->i, i);
+		delete node;
+	}
+
+	ut_assert_true(q1.empty());
+
+	return true;
+}
+
 ut_declare_test_c(test_IntrusiveQueue, IntrusiveQueueTest)
@@ -44,6 +44,8 @@
 #include <math.h>
 
 #include <drivers/drv_hrt.h>
+#include <lib/mathlib/math/filter/LowPassFilter2pArray.hpp>
+#include <lib/mathlib/math/filter/NotchFilterArray.hpp>
 #include <perf/perf_counter.h>
 #include <px4_platform_common/px4_config.h>
 #include <px4_platform_common/micro_hal.h>
@@ -104,6 +106,8 @@ private:
 	bool time_32bit_integers();
 	bool time_64bit_integers();
 
+	bool time_filters();
+
 	void reset();
 
 	volatile float f32;
@@ -138,6 +142,7 @@ bool MicroBenchMath::run_tests()
 	ut_run_test(time_16bit_integers);
 	ut_run_test(time_32bit_integers);
 	ut_run_test(time_64bit_integers);
+	ut_run_test(time_filters);
 
 	return (_tests_failed == 0);
 }
@@ -269,4 +274,68 @@ bool MicroBenchMath::time_64bit_integers()
 	return true;
 }
 
+static constexpr int FILTER_BLOCK_SIZE = 32; // sensor_gyro_fifo_s samples
+
+static float filter_data[3][FILTER_BLOCK_SIZE];
+static float *const filter_data_axis[3] {filter_data[0], filter_data[1], filter_data[2]};
+
+static math::NotchFilterArray<float> notch_filters[3];
+static math::LowPassFilter2pArray lp_filters[3] {{8000.f, 30.f}, {8000.f, 30.f}, {8000.f, 30.f}};
+
+static void notch_per_axis()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		notch_filters[axis].apply(filter_data[axis], FILTER_BLOCK_SIZE);
+	}
+}
+
+static void notch_df1_per_axis()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		notch_filters[axis].applyDF1(filter_data[axis], FILTER_BLOCK_SIZE);
+	}
+}
+
+static float lpf_per_axis()
+{
+	float output = 0.f;
+
+	for (int axis = 0; axis < 3; axis++) {
+		output += lp_filters[axis].apply(filter_data[axis], FILTER_BLOCK_SIZE);
+	}
+
+	return output;
+}
+
+static float lpf_interleaved()
+{
+	float output[3];
+	math::LowPassFilter2pArray::apply(lp_filters, filter_data_axis, FILTER_BLOCK_SIZE, output);
+	return output[0] + output[1] + output[2];
+}
+
+bool MicroBenchMath::time_filters()
+{
+	for (int axis = 0; axis < 3; axis++) {
+		notch_filters[axis].setParameters(8000.f, 150.f, 20.f);
+		notch_filters[axis].reset(0.f);
+		notch_filters[axis].resetDF1(0.f);
+
+		for (int n = 0; n < FILTER_BLOCK_SIZE; n++) {
+			filter_data[axis][n] = random(-1000.f, 1000.f);
+		}
+	}
+
+	// 3 axes x 32 samples, one axis after the other vs all axes interleaved
+	PERF("notch x3 per axis", notch_per_axis(), 100);
+	PERF("notch x3 interleaved", math::NotchFilterArray<float>::apply(notch_filters, filter_data_axis, FILTER_BLOCK_SIZE), 100);
+	PERF("notch DF1 x3 per axis", notch_df1_per_axis(), 100);
+	PERF("notch DF1 x3 interleaved", math::NotchFilterArray<float>::applyDF1(notch_filters, filter_data_axis,
+			FILTER_BLOCK_SIZE), 100);
+	PERF("lpf2p x3 per axis", f32_out = lpf_per_axis(), 100);
+	PERF("lpf2p x3 interleaved", f32_out = lpf_interleaved(), 100);
+
+	return true;
+}
+
 } // namespace MicroBenchMath
@@ -105,6 +105,7 @@ private:
 	bool loadQuadTest();
 	bool loadComplexTest();
 	bool loadAllTest();
+	bool compiledPlanTest();
 	bool load_mixer(const char *filename, unsigned expected_count, bool verbose = false);
 	bool load_mixer(const char *filename, const char *buf, unsigned loaded, unsigned expected_count,
 			const unsigned chunk_size, bool verbose);
@@ -120,6 +121,7 @@ bool MixerTest::run_tests()
 	ut_run_test(loadVTOL2Test);
 	ut_run_test(loadComplexTest);
 	ut_run_test(loadAllTest);
+	ut_run_test(compiledPlanTest);
 	ut_run_test(mixerTest);
 
 	return (_tests_failed == 0);
@@ -152,6 +154,41 @@ bool MixerTest::loadComplexTest()
 	return load_mixer(MIXER_PATH(complex_test.mix), 8);
 }
 
+bool MixerTest::compiledPlanTest()
+{
+	if (!load_mixer(MIXER_PATH(complex_test.mix), 8)) {
+		return false;
+	}
+
+	should_prearm = false;
+
+	for (unsigned i = 0; i < output_max; i++) {
+		actuator_controls[i] = 0.9f - 0.25f * i;
+	}
+
+	/* mix through the control callback first */
+	float outputs_list[output_max] {};
+	const unsigned count_list = mixer_group.mix(outputs_list, output_max);
+
+	ut_assert("compile mixer group", mixer_group.compile(actuator_controls, 1, output_max));
+
+	/* the compiled plan needs to produce the same outputs */
+	float outputs_plan[output_max] {};
+	const unsigned count_plan = mixer_group.mix(outputs_plan, output_max);
+
+	ut_compare("compiled output count", count_plan, count_list);
+
+	for (unsigned i = 0; i < count_list; i++) {
+		ut_compare_float("compiled output", outputs_plan[i], outputs_list[i], 6);
+	}
+
+	/* resetting the group drops the plan */
+	mixer_group.reset();
+	ut_compare("reset mixer group", mixer_group.mix(outputs_plan, output_max), 0);
+
+	return true;
+}
+
 bool MixerTest::loadAllTest()
 {
 	PX4_INFO("Testing all mixers in %s", MIXER_ONBOARD_PATH);
@@ -0,0 +1,231 @@
+/****************************************************************************
+ *
+ *   Copyright (c) 2020 PX4 Development Team. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name PX4 nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/**
+ * @file trace_main.cpp
+ *
+ * Record work queue and uORB execution traces and export them as Chrome/Perfetto JSON.
+ */
+
+#include <px4_platform_common/px4_config.h>
+#include <px4_platform_common/defines.h>
+#include <px4_platform_common/getopt.h>
+#include <px4_platform_common/log.h>
+#include <px4_platform_common/module.h>
+#include <px4_platform_common/trace.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static constexpr unsigned DEFAULT_NUM_RECORDS = 1000;
+
+static constexpr int TID_PUBLISH = 1;
+static constexpr int TID_CALLBACK = 2;
+static constexpr int TID_WORK_QUEUE_FIRST = 3;
+static constexpr int MAX_WORK_QUEUES = 32;
+
+static void	usage();
+
+extern "C" {
+	__EXPORT int trace_main(int argc, char *argv[]);
+}
+
+static void write_thread_name(FILE *file, int tid, const char *name, bool &first)
+{
+	fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+		first ? "" : ",", tid, name);
+	first = false;
+}
+
+static int dump(const char *path)
+{
+	px4::trace::stop();
+
+	FILE *file = fopen(path, "w");
+
+	if (file == nullptr) {
+		PX4_ERR("failed to open %s", path);
+		return 1;
+	}
+
+	// work queue names are mapped to thread ids by pointer (they point to the static queue configurations)
+	const char *work_queues[MAX_WORK_QUEUES] {};
+	int num_work_queues = 0;
+	bool first = true;
+
+	fprintf(file, "{\"traceEvents\":[");
+	write_thread_name(file, TID_PUBLISH, "uORB publish", first);
+	write_thread_name(file, TID_CALLBACK, "uORB callbacks", first);
+
+	const unsigned count = px4::trace::count();
+	px4::trace::Record record;
+
+	for (unsigned i = 0; i < count; i++) {
+		if (!px4::trace::get(i, record)) {
+			break;
+		}
+
+		switch (record.event) {
+		case px4::trace::Event::WorkItemStart:
+		case px4::trace::Event::WorkItemStop: {
+				int tid = -1;
+
+				for (int wq = 0; wq < num_work_queues; wq++) {
+					if (work_queues[wq] == record.context) {
+						tid = TID_WORK_QUEUE_FIRST + wq;
+						break;
+					}
+				}
+
+				if (tid < 0) {
+					if (num_work_queues >= MAX_WORK_QUEUES) {
+						continue;
+					}
+
+					work_queues[num_work_queues] = record.context;
+					tid = TID_WORK_QUEUE_FIRST + num_work_queues++;
+					write_thread_name(file, tid, record.context, first);
+				}
+
+				fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+					record.name, (record.event == px4::trace::Event::WorkItemStart) ? 'B' : 'E',
+					(unsigned long long)record.timestamp, tid);
+			}
+			break;
+
+		case px4::trace::Event::Publish:
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%d}",
+				record.name, (unsigned long long)record.timestamp, TID_PUBLISH);
+			break;
+
+		case px4::trace::Event::CallbackSchedule:
+			fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,\"tid\":%d,"
+				"\"args\":{\"item\":\"%s\"}}",
+				record.name, (unsigned long long)record.timestamp, TID_CALLBACK, record.context);
+			break;
+		}
+	}
+
+	fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	fclose(file);
+
+	PX4_INFO("wrote %u records to %s (%u overwritten)", count, path, px4::trace::overwritten());
+
+	return 0;
+}
+
+int
+trace_main(int argc, char *argv[])
+{
+	if (argc < 2) {
+		usage();
+		return 1;
+	}
+
+	int myoptind = 2;
+	int ch;
+	const char *myoptarg = nullptr;
+	unsigned num_records = DEFAULT_NUM_RECORDS;
+	const char *path = PX4_STORAGEDIR "/trace.json";
+
+	while ((ch = px4_getopt(argc, argv, "n:f:", &myoptind, &myoptarg)) != EOF) {
+		switch (ch) {
+		case 'n':
+			num_records = strtoul(myoptarg, nullptr, 10);
+			break;
+
+		case 'f':
+			path = myoptarg;
+			break;
+
+		default:
+			usage();
+			return 1;
+		}
+	}
+
+	if (!strcmp(argv[1], "start")) {
+		if (!px4::trace::start(num_records)) {
+			PX4_ERR("failed to allocate %u records", num_records);
+			return 1;
+		}
+
+		return 0;
+
+	} else if (!strcmp(argv[1], "stop")) {
+		px4::trace::stop();
+		return 0;
+
+	} else if (!strcmp(argv[1], "status")) {
+		PX4_INFO("%s, %u records (%u overwritten)", px4::trace::recording.load() ? "recording" : "stopped",
+			 px4::trace::count(), px4::trace::overwritten());
+		return 0;
+
+	} else if (!strcmp(argv[1], "dump")) {
+		return dump(path);
+	}
+
+	usage();
+	return 1;
+}
+
+static void
+usage()
+{
+	PRINT_MODULE_DESCRIPTION(
+		R"DESCR_STR(
+### Description
+
+Record an execution trace of work queue items (start/stop), uORB publications and
+uORB callback scheduling into a ring buffer in RAM, and export it as Chrome trace JSON.
+The file can be opened with chrome://tracing or https://ui.perfetto.dev.
+
+Recording is off by default. While enabled, each event costs a timestamp and a few stores.
+
+### Examples
+
+Trace for a second and write the result to the SD card:
+$ trace start -n 2000
+$ sleep 1
+$ trace dump
+)DESCR_STR");
+
+	PRINT_MODULE_USAGE_NAME("trace", "system");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("start", "Start recording (clears previous records)");
+	PRINT_MODULE_USAGE_PARAM_INT('n', DEFAULT_NUM_RECORDS, 1, 100000, "Ring buffer size (records)", true);
+	PRINT_MODULE_USAGE_COMMAND_DESCR("stop", "Stop recording");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("status", "Print recording status");
+	PRINT_MODULE_USAGE_COMMAND_DESCR("dump", "Stop recording and write the trace as Chrome JSON");
+	PRINT_MODULE_USAGE_PARAM_STRING('f', nullptr, "<file>", "Output file (default: trace.json in the storage directory)", true);
+}
@@ -138,41 +138,26 @@ Module::Module(int example_param, bool example_flag)
 void Module::run()
 {
 	// Example: run the loop synchronized to the sensor_combined topic publication
-	int sensor_combined_sub = orb_subscribe(ORB_ID(sensor_combined));
-
-	px4_pollfd_struct_t fds[1];
-	fds[0].fd = sensor_combined_sub;
-	fds[0].events = POLLIN;
+	_sensor_combined_sub.registerCallback();
 
 	// initialize parameters
 	parameters_update(true);
 
 	while (!should_exit()) {
 
-		// wait for up to 1000ms for data
-		int pret = px4_poll(fds, (sizeof(fds) / sizeof(fds[0])), 1000);
-
-		if (pret == 0) {
-			// Timeout: let the loop run anyway, don't do `continue` here
+		// wait for up to 1000ms for data (on timeout let the loop run anyway)
+		_wait.wait(1000 * 1000);
 
-		} else if (pret < 0) {
-			// this is undesirable but not much we can do
-			PX4_ERR("poll error %d, %d", pret, errno);
-			px4_usleep(50000);
-			continue;
+		sensor_combined_s sensor_combined;
 
-		} else if (fds[0].revents & POLLIN) {
-
-			struct sensor_combined_s sensor_combined;
-			orb_copy(ORB_ID(sensor_combined), sensor_combined_sub, &sensor_combined);
+		if (_sensor_combined_sub.update(&sensor_combined)) {
 			// TODO: do something with the data...
-
 		}
 
 		parameters_update();
 	}
 
-	orb_unsubscribe(sensor_combined_sub);
+	_sensor_combined_sub.unregisterCallback();
 }
 
 void Module::parameters_update(bool force)
@@ -36,7 +36,9 @@
 #include <px4_platform_common/module.h>
 #include <px4_platform_common/module_params.h>
 #include <uORB/Subscription.hpp>
+#include <uORB/SubscriptionWait.hpp>
 #include <uORB/topics/parameter_update.h>
+#include <uORB/topics/sensor_combined.h>
 
 extern "C" __EXPORT int module_main(int argc, char *argv[]);
 
@@ -82,6 +84,8 @@ private:
 	)
 
 	// Subscriptions
+	uORB::WaitObject	_wait;
+	uORB::SubscriptionCallbackWait	_sensor_combined_sub{_wait, ORB_ID(sensor_combined)};
 	uORB::Subscription	_parameter_update_sub{ORB_ID(parameter_update)};
 
 };